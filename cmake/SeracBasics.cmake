@@ -27,6 +27,10 @@ else()
 endif()
 option(SERAC_ENABLE_CODE_CHECKS "Enable Serac's code checks" ${_enable_serac_code_checks})
 
+option(SERAC_ENABLE_64BIT_INDICES
+       "Use 64-bit indices for the local nonzero entries of assembled gradients (for ranks with more than 2^32)"
+       OFF)
+
 #------------------------------------------------------------------------------
 # Profiling options
 #------------------------------------------------------------------------------
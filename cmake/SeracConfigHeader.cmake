@@ -56,6 +56,15 @@ if(CMAKE_BUILD_TYPE MATCHES "(Debug|RelWithDebInfo)")
 endif()
 
 
+#------------------------------------------------------------------------------
+# Index widths
+#------------------------------------------------------------------------------
+set(SERAC_USE_64BIT_INDICES FALSE)
+if(SERAC_ENABLE_64BIT_INDICES)
+    set(SERAC_USE_64BIT_INDICES TRUE)
+endif()
+
+
 #------------------------------------------------------------------------------
 # General Build Info
 #------------------------------------------------------------------------------
@@ -0,0 +1,175 @@
+#!/bin/sh
+"exec" "python3" "-u" "-B" "$0" "$@"
+##############################################################################
+# Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+# other Serac Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: (BSD-3-Clause)
+##############################################################################
+
+import argparse
+import json
+import os
+import sys
+
+
+# This script compares the Caliper region timings of Serac's benchmarks against a baseline.
+# Each profile is a Caliper "hatchet-region-profile" written in the json-split format, named
+# after the benchmark executable that produced it (e.g. benchmark_solid.json). The script fails
+# if any region that took at least --min-time seconds in the baseline is now slower than the
+# baseline by more than the threshold. With --update, the baseline is (re)written instead.
+#
+# Baseline file format:
+#    {
+#        "threshold": 0.1,                      // optional, the relative slowdown that fails the check
+#        "benchmarks": {
+#            "benchmark_solid": {
+#                "main/neohookean p=1 3D tensor n=4 r=0/forward": 12.3,   // inclusive seconds
+#                ...
+#            }
+#        }
+#    }
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Compare benchmark timings against a baseline")
+
+    parser.add_argument("--baseline", type=str, required=True,
+                        help="Path to baseline timings file")
+    parser.add_argument("--threshold", type=float, default=None,
+                        help="Relative slowdown beyond which a region fails (default: baseline's, or 0.1)")
+    parser.add_argument("--min-time", type=float, default=0.05,
+                        help="Regions faster than this in the baseline (in seconds) are too noisy to check")
+    parser.add_argument("--update", action="store_true",
+                        help="Write the given profiles to the baseline file, instead of comparing")
+    parser.add_argument("profiles", type=str, nargs="+",
+                        help="Caliper json-split region profiles, one per benchmark")
+
+    args = parser.parse_args()
+
+    for path in args.profiles:
+        if not os.path.isfile(path):
+            print("ERROR: Given profile does not exist: {0}".format(path))
+            sys.exit(1)
+    if not args.update and not os.path.isfile(args.baseline):
+        print("ERROR: Given baseline does not exist: {0}".format(args.baseline))
+        print("       Record one on the reference machine with 'make benchmark_baseline'")
+        sys.exit(1)
+
+    print("------- Given Options -------")
+    print("Baseline file: {0}".format(args.baseline))
+    print("Threshold:     {0}".format(args.threshold))
+    print("Minimum time:  {0}".format(args.min_time))
+    print("Update:        {0}".format(args.update))
+    print("-----------------------------")
+
+    return args
+
+
+# Returns a dictionary of the inclusive time of each region in a json-split profile,
+# keyed by the region's path (its name and the names of its parents, joined by "/")
+def read_region_times(path):
+    with open(path, "r") as f:
+        profile = json.load(f)
+
+    nodes = profile["nodes"]
+    columns = profile["columns"]
+
+    def node_path(i):
+        names = []
+        while i is not None:
+            names.append(nodes[i]["label"])
+            i = nodes[i].get("parent")
+        return "/".join(reversed(names))
+
+    path_column = columns.index("path")
+    if "time (inc)" in columns:
+        time_column, inclusive = columns.index("time (inc)"), True
+    else:
+        time_column, inclusive = columns.index("time"), False
+
+    times = {}
+    for row in profile["data"]:
+        node = row[path_column]
+        seconds = float(row[time_column])
+
+        # exclusive times are added to every ancestor of the region as well
+        while node is not None:
+            key = node_path(node)
+            times[key] = times.get(key, 0.0) + seconds
+            node = None if inclusive else nodes[node].get("parent")
+
+    return times
+
+
+# Name of the benchmark that wrote a profile, e.g. "benchmark_solid" for ".../benchmark_solid.json"
+def benchmark_name(path):
+    return os.path.splitext(os.path.basename(path))[0]
+
+
+# Compares the regions of one benchmark and returns the number of regressions
+def compare(name, baseline_times, test_times, threshold, min_time):
+    regressions = 0
+    for region, baseline_time in sorted(baseline_times.items()):
+        if region not in test_times:
+            print("WARNING: {0}: region '{1}' is missing from the test profile".format(name, region))
+            continue
+        if baseline_time < min_time:
+            continue
+
+        test_time = test_times[region]
+        change = test_time / baseline_time - 1.0
+        status = "ok"
+        if change > threshold:
+            status = "REGRESSION"
+            regressions += 1
+        print("{0:<11} {1}: {2}  {3:.4f}s -> {4:.4f}s ({5:+.1f}%)"
+              .format(status, name, region, baseline_time, test_time, 100.0 * change))
+
+    for region in sorted(set(test_times) - set(baseline_times)):
+        print("WARNING: {0}: region '{1}' has no baseline".format(name, region))
+
+    return regressions
+
+
+def main():
+    args = parse_args()
+
+    profiles = {benchmark_name(path): read_region_times(path) for path in args.profiles}
+
+    if args.update:
+        baseline = {"benchmarks": {}}
+        if os.path.isfile(args.baseline):
+            with open(args.baseline, "r") as f:
+                baseline = json.load(f)
+        if args.threshold is not None:
+            baseline["threshold"] = args.threshold
+        baseline.setdefault("benchmarks", {}).update(profiles)
+
+        with open(args.baseline, "w") as f:
+            json.dump(baseline, f, indent=4, sort_keys=True)
+        print("Updated baseline for: {0}".format(", ".join(sorted(profiles))))
+        return
+
+    with open(args.baseline, "r") as f:
+        baseline = json.load(f)
+
+    threshold = args.threshold
+    if threshold is None:
+        threshold = baseline.get("threshold", 0.1)
+
+    regressions = 0
+    for name, test_times in sorted(profiles.items()):
+        if name not in baseline["benchmarks"]:
+            print("WARNING: {0} has no baseline, skipping".format(name))
+            continue
+        regressions += compare(name, baseline["benchmarks"][name], test_times, threshold, args.min_time)
+
+    if regressions > 0:
+        print("ERROR: {0} region(s) slowed down by more than {1:.1f}%".format(regressions, 100.0 * threshold))
+        sys.exit(1)
+
+    print("Success: no regions slowed down by more than {0:.1f}%".format(100.0 * threshold))
+
+
+if __name__ == "__main__":
+    main()
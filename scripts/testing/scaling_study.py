@@ -0,0 +1,200 @@
+#!/bin/sh
+"exec" "python3" "-u" "-B" "$0" "$@"
+##############################################################################
+# Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+# other Serac Project Developers. See the top-level COPYRIGHT file for details.
+#
+# SPDX-License-Identifier: (BSD-3-Clause)
+##############################################################################
+
+import argparse
+import json
+import os
+import socket
+import subprocess
+import sys
+
+from check_benchmarks import read_region_times
+
+
+# This script runs a strong and weak scaling study of benchmark_solid over numbers of ranks and
+# parallel refinement levels, and tabulates the time and parallel efficiency of each phase.
+#
+# The MPI launcher comes from the machine profile in ats-config/ (the one named after $SYS_TYPE,
+# or after the host name without its trailing digits), e.g.
+#    {
+#        "CUDA": false,
+#        "launcher": "srun -n {ranks}"     // optional, "mpirun -np {ranks}" by default
+#    }
+#
+# Every run writes a Caliper "hatchet-region-profile" named after its case, rank count and
+# refinement level. A phase's time is the inclusive time of the regions with the phase's names
+# (those nested in a region of the same phase are only counted once), so phases can overlap:
+# e.g. assembly includes the element kernels it runs.
+#
+# Strong scaling compares the runs of one refinement level: efficiency = T(p0) p0 / (T(p) p).
+# Weak scaling compares the runs with the same number of elements per rank, as each refinement
+# multiplies the elements by 2^dim: efficiency = T(p0) / T(p).
+
+# The names of the Caliper regions (SERAC_MARK_FUNCTION uses the function name) of each phase
+phases = {
+    "functional": ["operator()", "evaluateInto", "ActionOfGradient", "ActionOfGradientTranspose"],
+    "assembly": ["assembleValues", "assembleTrueDofs"],
+    "amg setup": ["setPreconditioner"],
+    "krylov solve": ["solveLinearSystem"],
+    "io": ["outputStateToDisk", "saveSummary"],
+}
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Run a strong and weak scaling study of the solid benchmarks")
+
+    parser.add_argument("--benchmark", type=str, required=True,
+                        help="Path to the benchmark_solid executable")
+    parser.add_argument("--machine-dir", type=str, required=True,
+                        help="Directory of the machine profiles (ats-config)")
+    parser.add_argument("--machine", type=str, default=None,
+                        help="Name of the machine profile (default: $SYS_TYPE, or the host name)")
+    parser.add_argument("--output", type=str, default="scaling",
+                        help="Directory of the profiles and tables")
+    parser.add_argument("--ranks", type=int, nargs="+", default=[1, 2, 4, 8],
+                        help="Numbers of MPI ranks")
+    parser.add_argument("--refinements", type=int, nargs="+", default=[0, 1],
+                        help="Numbers of uniform parallel refinements")
+    parser.add_argument("--cases", type=str, nargs="+", default=["neohookean"],
+                        help="Benchmark cases to run")
+    parser.add_argument("--dim", type=int, default=3, choices=[2, 3],
+                        help="Spatial dimension of the benchmarks")
+    parser.add_argument("--tables-only", action="store_true",
+                        help="Tabulate the profiles of an earlier study, without running it")
+
+    args = parser.parse_args()
+
+    if not os.path.isfile(args.benchmark) and not args.tables_only:
+        print("ERROR: Given benchmark does not exist: {0}".format(args.benchmark))
+        sys.exit(1)
+
+    print("------- Given Options -------")
+    print("Benchmark:     {0}".format(args.benchmark))
+    print("Machine dir:   {0}".format(args.machine_dir))
+    print("Output:        {0}".format(args.output))
+    print("Ranks:         {0}".format(args.ranks))
+    print("Refinements:   {0}".format(args.refinements))
+    print("Cases:         {0}".format(args.cases))
+    print("-----------------------------")
+
+    return args
+
+
+# Returns the machine profile, see the description above
+def read_machine(machine_dir, machine):
+    if machine is None:
+        machine = os.environ.get("SYS_TYPE", socket.gethostname().rstrip("1234567890"))
+
+    path = os.path.join(machine_dir, machine + ".json")
+    if not os.path.isfile(path):
+        print("ERROR: No machine profile for '{0}': {1}".format(machine, path))
+        print("       Create one, or pick one with --machine")
+        sys.exit(1)
+
+    with open(path, "r") as f:
+        profile = json.load(f)
+    profile.setdefault("launcher", "mpirun -np {ranks}")
+    print("Machine:       {0} (launcher: {1})".format(machine, profile["launcher"]))
+    return profile
+
+
+def profile_path(output, case, ranks, refinements):
+    return os.path.join(output, "{0}_np{1}_r{2}.json".format(case, ranks, refinements))
+
+
+def run(args, machine, case, ranks, refinements):
+    profile = profile_path(args.output, case, ranks, refinements)
+    command = machine["launcher"].format(ranks=ranks).split()
+    command += [args.benchmark, "--case", case, "--dim", str(args.dim), "--refinements", str(refinements)]
+
+    env = dict(os.environ)
+    env["CALI_CONFIG"] = "hatchet-region-profile,output={0}".format(profile)
+
+    print("Running: {0}".format(" ".join(command)))
+    if subprocess.call(command, env=env) != 0:
+        print("ERROR: Benchmark failed: {0}".format(" ".join(command)))
+        sys.exit(1)
+
+
+# Returns the time of each phase (and the total) of a profile
+def phase_times(path):
+    region_times = read_region_times(path)
+
+    times = {"total": sum(t for region, t in region_times.items() if "/" not in region)}
+    for phase, names in phases.items():
+        times[phase] = 0.0
+        for region, t in region_times.items():
+            labels = region.split("/")
+            if labels[-1] in names and not any(label in names for label in labels[:-1]):
+                times[phase] += t
+    return times
+
+
+def print_table(title, runs, efficiency):
+    columns = ["total"] + list(phases)
+    print("")
+    print(title)
+    print("{0:>6} {1:>4}".format("ranks", "ref") + "".join(" {0:>22}".format(c) for c in columns))
+
+    p0, r0, times0 = runs[0]
+    for p, r, times in runs:
+        row = "{0:>6} {1:>4}".format(p, r)
+        for c in columns:
+            if times[c] > 0.0 and times0[c] > 0.0:
+                row += " {0:>12.4f}s ({1:>5.1f}%)".format(times[c], 100.0 * efficiency(p0, times0[c], p, times[c]))
+            else:
+                row += " {0:>22}".format("-")
+        print(row)
+
+
+def main():
+    args = parse_args()
+    machine = read_machine(args.machine_dir, args.machine)
+
+    if not os.path.isdir(args.output):
+        os.makedirs(args.output)
+
+    for case in args.cases:
+        for refinements in args.refinements:
+            for ranks in args.ranks:
+                if not args.tables_only:
+                    run(args, machine, case, ranks, refinements)
+
+    for case in args.cases:
+        times = {}
+        for refinements in args.refinements:
+            for ranks in args.ranks:
+                path = profile_path(args.output, case, ranks, refinements)
+                if os.path.isfile(path):
+                    times[(ranks, refinements)] = phase_times(path)
+                else:
+                    print("WARNING: Missing profile: {0}".format(path))
+
+        def strong(p0, t0, p, t):
+            return t0 * p0 / (t * p)
+
+        def weak(p0, t0, p, t):
+            return t0 / t
+
+        for refinements in args.refinements:
+            runs = [(p, r, t) for (p, r), t in sorted(times.items()) if r == refinements]
+            if len(runs) > 1:
+                print_table("Strong scaling: {0}, {1} refinement(s)".format(case, refinements), runs, strong)
+
+        # each refinement multiplies the number of elements by 2^dim
+        elements_per_rank = {}
+        for (p, r), t in sorted(times.items()):
+            elements_per_rank.setdefault((2 ** args.dim) ** r / p, []).append((p, r, t))
+        for per_rank, runs in sorted(elements_per_rank.items()):
+            if len(runs) > 1:
+                print_table("Weak scaling: {0}, {1:g}x the base elements per rank".format(case, per_rank), runs, weak)
+
+
+if __name__ == "__main__":
+    main()
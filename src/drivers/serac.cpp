@@ -12,6 +12,7 @@
  * The purpose of this code is to act as a proxy app for nonlinear implicit mechanics codes at LLNL.
  */
 
+#include <cmath>
 #include <fstream>
 #include <iostream>
 #include <memory>
@@ -21,6 +22,7 @@
 #include "mfem.hpp"
 
 #include "serac/infrastructure/about.hpp"
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/infrastructure/cli.hpp"
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/input.hpp"
@@ -60,6 +62,10 @@ void defineInputFileSchema(axom::inlet::Inlet& inlet)
   auto& thermal_solver_table = inlet.addStruct("heat_transfer", "Heat transfer module");
   HeatTransferInputOptions::defineInputFileSchema(thermal_solver_table);
 
+  // The output cadence and visualization options
+  auto& output_table = inlet.addStruct("output", "Output cadence and visualization options");
+  OutputOptions::defineInputFileSchema(output_table);
+
   // The thermal solid options
   auto& thermal_solid_solver_table = inlet.addStruct("thermal_solid", "Thermal solid module");
   ThermomechanicsInputOptions::defineInputFileSchema(thermal_solid_solver_table);
@@ -255,7 +261,7 @@ int main(int argc, char* argv[])
   // TODO: add option for just version and a longer for about?
   bool print_version = cli_opts.find("version") != cli_opts.end();
   if (print_version) {
-    SLIC_INFO(serac::about());
+    SLIC_INFO_ROOT(serac::about());
     serac::exitGracefully();
   }
 
@@ -263,6 +269,11 @@ int main(int argc, char* argv[])
   serac::printRunInfo();
   serac::cli::printGiven(cli_opts);
 
+  // Optionally share the cores of each node between its ranks, and pin their threads (no-op if OpenMP is not enabled)
+  if (cli_opts.find("pin-threads") != cli_opts.end()) {
+    serac::accelerator::initializeHostThreads(MPI_COMM_WORLD, true);
+  }
+
   // Read input file
   std::string input_file_path = "";
   auto        search          = cli_opts.find("input-file");
@@ -319,12 +330,12 @@ int main(int argc, char* argv[])
   if (cli_opts.find("print-unused") != cli_opts.end()) {
     const std::vector<std::string> all_unexpected_names = inlet.unexpectedNames();
     if (all_unexpected_names.size() != 0) {
-      SLIC_INFO("Printing unused entries in input file:");
+      SLIC_INFO_ROOT("Printing unused entries in input file:");
       for (auto& x : all_unexpected_names) {
-        SLIC_INFO("  " << x);
+        SLIC_INFO_ROOT("  " << x);
       }
     } else {
-      SLIC_INFO("No unused entries in input file.");
+      SLIC_INFO_ROOT("No unused entries in input file.");
     }
     serac::exitGracefully();
   }
@@ -346,8 +357,16 @@ int main(int argc, char* argv[])
     // Build the mesh
     auto mesh_options = inlet["main_mesh"].get<serac::mesh::InputOptions>();
     if (const auto file_opts = std::get_if<serac::mesh::FileInputOptions>(&mesh_options.extra_options)) {
-      file_opts->absolute_mesh_file_name =
-          serac::input::findMeshFilePath(file_opts->relative_mesh_file_name, input_file_path);
+      if (file_opts->parallel_read == serac::mesh::ParallelRead::Partitioned) {
+        // locate the partitions through the first one, then keep their common prefix
+        const std::string first_partition = ".000000";
+        file_opts->absolute_mesh_file_name =
+            serac::input::findMeshFilePath(file_opts->relative_mesh_file_name + first_partition, input_file_path);
+        file_opts->absolute_mesh_file_name.resize(file_opts->absolute_mesh_file_name.size() - first_partition.size());
+      } else {
+        file_opts->absolute_mesh_file_name =
+            serac::input::findMeshFilePath(file_opts->relative_mesh_file_name, input_file_path);
+      }
     }
     auto mesh = serac::mesh::buildParallelMesh(mesh_options);
     serac::StateManager::setMesh(std::move(mesh), mesh_tag);
@@ -383,42 +402,68 @@ int main(int argc, char* argv[])
   auto main_physics = createPhysics(dim, order, solid_mechanics_options, heat_transfer_options, thermomechanics_options,
                                     mesh_tag, cycle, t);
 
+  // Predict the memory and time of the remaining cycles without allocating or solving them
+  if (cli_opts.find("plan") != cli_opts.end()) {
+    int num_cycles = static_cast<int>(std::ceil((t_final - t) / dt - 1e-8));
+    SLIC_INFO_ROOT(axom::fmt::format("Planning {} cycles", num_cycles));
+    serac::printRunPlan(main_physics->plan(num_cycles));
+    serac::exitGracefully();
+  }
+
   // Complete the solver setup
   main_physics->completeSetup();
 
+  if (inlet.isUserProvided("output")) {
+    main_physics->setOutputOptions(inlet["output"].get<serac::OutputOptions>());
+  }
+
+  // Optionally overlap writing the output files with the next timesteps
+  if (cli_opts.find("async-output") != cli_opts.end()) {
+    main_physics->setAsynchronousOutput(true);
+  }
+
   main_physics->initializeSummary(datastore, t_final, dt);
 
+  // Flushing the messages held by the logger is collective, so it can be done less often than every cycle
+  if (auto interval = cli_opts.find("log-flush-interval"); interval != cli_opts.end()) {
+    serac::logger::setFlushInterval(std::stoi(interval->second));
+  }
+
   // Enter the time step loop.
   bool last_step = false;
   while (!last_step) {
-    // Flush all messages held by the logger
-    serac::logger::flush();
+    // Flush the messages held by the logger, if due
+    serac::logger::flushIfDue(cycle);
+
+    // Compute the real timestep. This may be less than dt for the last timestep, and physics modules with adaptive
+    // time stepping may choose a different one.
+    double dt_real = std::min(main_physics->suggestedTimestep(dt), t_final - t);
 
-    // Compute the real timestep. This may be less than dt for the last timestep.
-    double dt_real = std::min(dt, t_final - t);
+    // Solve the physics module appropriately
+    main_physics->advanceTimestep(dt_real);
 
-    // Compute current time
-    t = t + dt_real;
+    // Compute current time, from the step that was actually taken
+    t = main_physics->time();
 
     // Print the timestep information
     SLIC_INFO_ROOT("step " << cycle << ", t = " << t);
 
-    // Solve the physics module appropriately
-    main_physics->advanceTimestep(dt_real);
+    // Determine if this is the last timestep
+    last_step = (t >= t_final - 1e-8 * dt);
 
-    // Output a visualization file
-    main_physics->outputStateToDisk(paraview_output_dir);
+    // Output a visualization file when the output cadence is due, and always at the last timestep
+    main_physics->writeOutput(paraview_output_dir, last_step);
 
     // Save curve data to Sidre datastore to be output later
     main_physics->saveSummary(datastore, t);
 
-    // Determine if this is the last timestep
-    last_step = (t >= t_final - 1e-8 * dt);
-
     // Increment cycle
     cycle++;
   }
 
+  // Finish writing the output files of the last step
+  main_physics->waitForOutput();
+
   // Output summary file (basic run info and curve data)
   serac::output::outputSummary(datastore, output_directory);
 
@@ -6,10 +6,31 @@
 
 #include "serac/infrastructure/accelerator.hpp"
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "mfem.hpp"
 
+#ifdef SERAC_USE_CUDA
+#include <cuda_runtime.h>
+#endif
+
+#if defined(SERAC_USE_RAJA) && defined(RAJA_ENABLE_OPENMP)
+#include <omp.h>
+#endif
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef SERAC_USE_UMPIRE
+#include "umpire/ResourceManager.hpp"
+#include "umpire/strategy/QuickPool.hpp"
+#endif
+
 #include "serac/infrastructure/logger.hpp"
 
 namespace serac {
@@ -19,6 +40,11 @@ namespace accelerator {
 // Restrict global to this file only
 namespace {
 std::unique_ptr<mfem::Device> device;
+
+#ifdef SERAC_USE_UMPIRE
+/// @brief the Umpire allocator ids of the pools for each ExecutionSpace, or -1 if they haven't been created
+int pool_ids[] = {-1, -1, -1};
+#endif
 }  // namespace
 
 void initializeDevice()
@@ -36,6 +62,157 @@ void terminateDevice()
   device.reset();
 }
 
+void initializeMemoryPools([[maybe_unused]] bool pin_host_memory)
+{
+#ifdef SERAC_USE_UMPIRE
+  SLIC_ERROR_ROOT_IF(pool_ids[0] != -1, "serac::accelerator::initializeMemoryPools cannot be called more than once");
+
+  auto& rm        = umpire::ResourceManager::getInstance();
+  auto  make_pool = [&rm](const std::string& resource) {
+    return rm.makeAllocator<umpire::strategy::QuickPool>("SERAC_" + resource + "_POOL", rm.getAllocator(resource))
+        .getId();
+  };
+
+#ifdef SERAC_USE_CUDA
+  pool_ids[int(ExecutionSpace::CPU)]     = make_pool(pin_host_memory ? "PINNED" : "HOST");
+  pool_ids[int(ExecutionSpace::GPU)]     = make_pool("DEVICE");
+  pool_ids[int(ExecutionSpace::Dynamic)] = make_pool("UM");
+#else
+  // every execution space is the host
+  int host_pool = make_pool("HOST");
+  for (auto& id : pool_ids) {
+    id = host_pool;
+  }
+#endif
+
+  axom::setDefaultAllocator(pool_ids[int(ExecutionSpace::CPU)]);
+#endif
+}
+
+void initializeHostThreads([[maybe_unused]] MPI_Comm comm, [[maybe_unused]] bool pin_threads)
+{
+#if defined(SERAC_USE_RAJA) && defined(RAJA_ENABLE_OPENMP)
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int node_rank, node_size;
+  MPI_Comm_rank(node_comm, &node_rank);
+  MPI_Comm_size(node_comm, &node_size);
+
+  // the cores this rank may run on, which are all of the cores of the node unless the launcher bound it
+  std::vector<int> cores;
+  bool             bound = false;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+    for (int c = 0; c < CPU_SETSIZE; c++) {
+      if (CPU_ISSET(c, &allowed)) {
+        cores.push_back(c);
+      }
+    }
+  }
+
+  // a rank was bound if it may run on fewer cores than the ranks of its node together
+  cpu_set_t node_allowed;
+  CPU_ZERO(&node_allowed);
+  constexpr int words = int(sizeof(cpu_set_t) / sizeof(unsigned long));
+  MPI_Allreduce(&allowed, &node_allowed, words, MPI_UNSIGNED_LONG, MPI_BOR, node_comm);
+  bound = !cores.empty() && int(cores.size()) < CPU_COUNT(&node_allowed);
+#endif
+  MPI_Comm_free(&node_comm);
+
+  int num_cores = cores.empty() ? omp_get_num_procs() : int(cores.size());
+
+  // ranks that weren't bound share the cores of their node
+  int first_core = 0;
+  int share      = num_cores;
+  if (!bound) {
+    share      = std::max(1, num_cores / node_size);
+    first_core = (node_rank * share) % num_cores;
+  }
+
+  if (std::getenv("OMP_NUM_THREADS") == nullptr) {
+    omp_set_num_threads(share);
+  }
+
+#ifdef __linux__
+  // OpenMP keeps the same threads for later parallel regions, so they stay pinned
+  if (pin_threads && !cores.empty() && std::getenv("OMP_PROC_BIND") == nullptr) {
+#pragma omp parallel
+    {
+      cpu_set_t core;
+      CPU_ZERO(&core);
+      CPU_SET(cores[std::size_t((first_core + omp_get_thread_num() % share) % num_cores)], &core);
+      sched_setaffinity(0, sizeof(core), &core);
+    }
+  }
+#endif
+
+  SLIC_INFO_ROOT(axom::fmt::format("Using {} OpenMP threads per rank", numHostThreads()));
+#endif
+}
+
+int numHostThreads()
+{
+#if defined(SERAC_USE_RAJA) && defined(RAJA_ENABLE_OPENMP)
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+void forall_tasks(const std::vector<std::function<void()>>& tasks)
+{
+#if defined(SERAC_USE_RAJA) && defined(RAJA_ENABLE_OPENMP)
+  // a single task keeps the threads for its own loops
+  if (tasks.size() > 1) {
+#pragma omp parallel
+#pragma omp single
+    for (std::size_t i = 0; i < tasks.size(); i++) {
+#pragma omp task firstprivate(i)
+      tasks[i]();
+    }
+    return;
+  }
+#endif
+
+  for (const auto& task : tasks) {
+    task();
+  }
+}
+
+namespace detail {
+
+std::shared_ptr<void> allocate(ExecutionSpace exec, std::size_t bytes)
+{
+#ifdef SERAC_USE_UMPIRE
+  if (int id = pool_ids[int(exec)]; id != -1) {
+    auto allocator = umpire::ResourceManager::getInstance().getAllocator(id);
+    return std::shared_ptr<void>(allocator.allocate(bytes), [allocator](void* ptr) mutable {
+      allocator.deallocate(ptr);
+    });
+  }
+#endif
+
+#ifdef SERAC_USE_CUDA
+  if (exec == ExecutionSpace::GPU) {
+    void* ptr = nullptr;
+    cudaMalloc(&ptr, bytes);
+    return std::shared_ptr<void>(ptr, [](void* p) { cudaFree(p); });
+  }
+
+  if (exec == ExecutionSpace::Dynamic) {
+    void* ptr = nullptr;
+    cudaMallocManaged(&ptr, bytes);
+    return std::shared_ptr<void>(ptr, [](void* p) { cudaFree(p); });
+  }
+#endif
+
+  return std::shared_ptr<void>(::operator new(bytes), [](void* p) { ::operator delete(p); });
+}
+
+}  // namespace detail
+
 }  // namespace accelerator
 
 }  // namespace serac
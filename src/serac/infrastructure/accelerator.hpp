@@ -50,9 +50,19 @@
 #define SERAC_SUPPRESS_NVCC_HOSTDEVICE_WARNING
 #endif
 
+#include <functional>
 #include <memory>
+#include <new>
+#include <vector>
 
 #include "axom/core.hpp"
+#include "mpi.h"
+
+#include "serac/serac_config.hpp"
+
+#ifdef SERAC_USE_RAJA
+#include "RAJA/RAJA.hpp"
+#endif
 
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/profiling.hpp"
@@ -198,6 +208,67 @@ void initializeDevice();
  */
 void terminateDevice();
 
+/**
+ * @brief Creates the memory pools that make_shared_array() allocates from, in builds with Umpire
+ *
+ * Each ExecutionSpace gets an Umpire QuickPool: host memory for ExecutionSpace::CPU, and device and
+ * unified memory for ExecutionSpace::GPU and ExecutionSpace::Dynamic in CUDA builds. The host pool is also
+ * made axom's default allocator, so axom::Arrays that don't specify a memory space (e.g. the values in
+ * QuadratureData) are allocated from it too. Before this is called (or in builds without Umpire),
+ * make_shared_array() allocates directly from the system.
+ *
+ * @param pin_host_memory whether the host pool uses page-locked memory, which makes host<->device
+ * transfers faster. This has no effect in builds without CUDA.
+ *
+ * @note This function should only be called once
+ */
+void initializeMemoryPools(bool pin_host_memory = false);
+
+/**
+ * @brief Divides the cores of each node between the MPI ranks on it, and sets up the OpenMP threads that
+ * forall_host() distributes host loops across
+ *
+ * Each rank gets an equal share of the cores it may run on (all of the ranks on a node share its cores, unless the
+ * launcher already bound each rank to fewer cores than the ranks of the node may use together), and uses one thread
+ * per core of its share unless OMP_NUM_THREADS is set. With @a pin_threads, each thread is then pinned to one of the
+ * cores, so that it stays on the NUMA node of the memory it first touched (see make_shared_array()). This has no
+ * effect in builds without OpenMP.
+ *
+ * serac::initialize() doesn't call this, so the OpenMP runtime is left alone unless the application opts in (the
+ * serac driver does with --pin-threads). It must be called by every rank of @a comm.
+ *
+ * @param comm the communicator of the ranks
+ * @param pin_threads whether to pin each thread to a core. Threads are never pinned when OMP_PROC_BIND is set, which
+ * leaves their placement to the OpenMP runtime.
+ */
+void initializeHostThreads(MPI_Comm comm, bool pin_threads = false);
+
+/// @brief the number of threads that forall_host() distributes host loops across
+int numHostThreads();
+
+/**
+ * @brief run independent tasks concurrently on the host threads (as OpenMP tasks), or one after another in builds
+ * without OpenMP
+ *
+ * The tasks are started in order, so the longest ones should go first. The forall_host() loops inside a task run on
+ * the thread of that task, so this is for tasks that are each too small to keep all of the threads busy.
+ *
+ * @param tasks the tasks, which must not write to any memory location that another task reads or writes
+ */
+void forall_tasks(const std::vector<std::function<void()>>& tasks);
+
+namespace detail {
+
+/**
+ * @brief allocate (uninitialized) memory for one of the execution spaces, from its pool if there is one
+ * @param exec where the memory should be accessible
+ * @param bytes how many bytes to allocate
+ * @return the memory, which is returned to where it was allocated from when the last reference is released
+ */
+std::shared_ptr<void> allocate(ExecutionSpace exec, std::size_t bytes);
+
+}  // namespace detail
+
 #if defined(__CUDACC__)
 
 /**
@@ -248,29 +319,160 @@ inline std::string getCUDAMemInfoString()
 
 #endif
 
+/**
+ * @brief the RAJA execution policy used by forall_host()
+ *
+ * @note when serac is built with RAJA and OpenMP, host loops are distributed across the
+ * available OpenMP threads (controlled by e.g. OMP_NUM_THREADS), otherwise they execute serially
+ */
+#if defined(SERAC_USE_RAJA) && defined(RAJA_ENABLE_OPENMP)
+using host_threaded_policy = RAJA::omp_parallel_for_exec;
+#elif defined(SERAC_USE_RAJA)
+using host_threaded_policy = RAJA::seq_exec;
+#endif
+
+/**
+ * @brief execute `body(i)` for each `i` in [0, n) on the host, distributing the iterations
+ * across threads when available.
+ *
+ * @tparam index_type the integral type used to index the loop iterations
+ * @tparam lambda the type of the loop body
+ * @param n the number of iterations
+ * @param body a callable object invoked as `body(i)`
+ *
+ * @note the iterations may execute concurrently and in any order, so `body` must not write to
+ * any memory location that is also written by another iteration
+ */
+template <typename index_type, typename lambda>
+void forall_host(index_type n, lambda&& body)
+{
+#ifdef SERAC_USE_RAJA
+  RAJA::forall<host_threaded_policy>(RAJA::TypedRangeSegment<index_type>(0, n), std::forward<lambda>(body));
+#else
+  for (index_type i = 0; i < n; i++) {
+    body(i);
+  }
+#endif
+}
+
+/**
+ * @brief execute `body(i)` for each `i` in [0, n) in the execution space @a exec: on the device for
+ * ExecutionSpace::GPU in CUDA builds with RAJA, and on the host (see forall_host()) otherwise
+ *
+ * @tparam exec where the iterations execute
+ * @tparam index_type the integral type used to index the loop iterations
+ * @tparam lambda the type of the loop body
+ * @param n the number of iterations
+ * @param body a callable object invoked as `body(i)`
+ *
+ * @note like forall_host(), the iterations may execute concurrently and in any order. On the device, `body` must be
+ * a SERAC_HOST_DEVICE lambda that captures by value, and only accesses memory of the execution space @a exec
+ */
+template <ExecutionSpace exec, typename index_type, typename lambda>
+void forall(index_type n, lambda&& body)
+{
+#if defined(__CUDACC__) && defined(SERAC_USE_RAJA)
+  if constexpr (exec == ExecutionSpace::GPU) {
+    RAJA::forall<RAJA::cuda_exec<256>>(RAJA::TypedRangeSegment<index_type>(0, n), std::forward<lambda>(body));
+  } else {
+    forall_host(n, std::forward<lambda>(body));
+  }
+#else
+  forall_host(n, std::forward<lambda>(body));
+#endif
+}
+
+/**
+ * @brief copy host values into a new array in the memory of the execution space @a exec
+ * @tparam exec the memory space where the copy lives
+ * @tparam T the type of the values
+ * @param values the values to copy
+ */
+template <ExecutionSpace exec, typename T>
+ExecArray<T, 1, exec> make_exec_array(const std::vector<T>& values)
+{
+  ExecArray<T, 1, exec> array(static_cast<axom::IndexType>(values.size()));
+  if (!values.empty()) {
+    axom::copy(array.data(), values.data(), values.size() * sizeof(T));
+  }
+  return array;
+}
+
 /**
  * @brief create shared_ptr to an array of `n` values of type `T`, either on the host or device
  * @tparam T the type of the value to be stored in the array
  * @tparam exec the memory space where the data lives
  * @param n how many entries to allocate in the array
+ *
+ * @note the memory comes from the pools created by initializeMemoryPools(), if they exist. Values
+ * in host-accessible memory are value-initialized by forall_host(), so that each page is first touched by (and placed
+ * on the NUMA node of) the thread that processes the same entries in the kernels, and device values are left
+ * uninitialized.
  */
 template <ExecutionSpace exec, typename T>
 std::shared_ptr<T[]> make_shared_array(std::size_t n)
 {
-  if constexpr (exec == ExecutionSpace::CPU) {
+  // the pools only guarantee the alignment of operator new
+  if constexpr (exec != ExecutionSpace::GPU && alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
     return std::shared_ptr<T[]>(new T[n]);
-  }
+  } else {
+    std::shared_ptr<void> memory = detail::allocate(exec, n * sizeof(T));
+    T*                    data   = static_cast<T*>(memory.get());
 
-#if defined(__CUDACC__)
-  if constexpr (exec == ExecutionSpace::GPU) {
-    T* data;
-    cudaMalloc(&data, sizeof(T) * n);
-    auto deleter = [](T* ptr) { cudaFree(ptr); };
-    return std::shared_ptr<T[]>(data, deleter);
+    if constexpr (exec == ExecutionSpace::GPU) {
+      return std::shared_ptr<T[]>(memory, data);
+    } else {
+      forall_host(n, [data](std::size_t i) { new (data + i) T(); });
+      if constexpr (std::is_trivially_destructible_v<T>) {
+        return std::shared_ptr<T[]>(memory, data);
+      } else {
+        return std::shared_ptr<T[]>(data, [memory, n](T* ptr) { std::destroy_n(ptr, n); });
+      }
+    }
   }
-#endif
 }
 
+/**
+ * @brief an array of `n` values of type `T` that is only allocated the first time it is accessed,
+ * and can be deallocated (and later reallocated) on request
+ * @tparam exec the memory space where the data lives
+ * @tparam T the type of the value to be stored in the array
+ */
+template <ExecutionSpace exec, typename T>
+class LazyArray {
+public:
+  /**
+   * @brief create an array of `n` values that doesn't allocate its memory yet
+   * @param n how many entries to allocate in the array
+   */
+  LazyArray(std::size_t n) : n_(n) {}
+
+  /// @brief return a pointer to the values, allocating them first if necessary
+  T* get()
+  {
+    if (data_ == nullptr && n_ > 0) {
+      data_ = make_shared_array<exec, T>(n_);
+    }
+    return data_.get();
+  }
+
+  /// @brief free the underlying memory, a subsequent call to get() will allocate new (uninitialized) values
+  void release() { data_.reset(); }
+
+  /// @brief whether or not the underlying memory is currently allocated
+  bool allocated() const { return data_ != nullptr; }
+
+  /// @brief the number of bytes currently allocated for the values
+  std::size_t bytes() const { return allocated() ? n_ * sizeof(T) : 0; }
+
+private:
+  /// @brief how many values are in the array
+  std::size_t n_;
+
+  /// @brief the values themselves, or nullptr if they haven't been allocated
+  std::shared_ptr<T[]> data_;
+};
+
 /**
  * @brief create shared_ptr to an array of `n` values of type `T`, either on the host or device
  * @tparam T the type of the value to be stored in the array
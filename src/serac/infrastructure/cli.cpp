@@ -36,6 +36,16 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
   app.add_option("-o, --output-directory", output_directory, "Directory to put outputted files");
   bool enable_paraview{false};
   app.add_flag("-p, --paraview", enable_paraview, "Enable ParaView output");
+  bool async_output{false};
+  app.add_flag("-a, --async-output", async_output, "Write output files in the background while the next steps compute");
+  bool pin_threads{false};
+  app.add_flag("--pin-threads", pin_threads, "Share the cores of each node between its ranks and pin their threads");
+  int  log_flush_interval;
+  auto log_flush_opt = app.add_option("-l, --log-flush-interval", log_flush_interval,
+                                      "Cycles between the collective flushes of logged warnings and debug messages");
+  log_flush_opt->check(axom::CLI::PositiveNumber);
+  bool plan{false};
+  app.add_flag("--plan", plan, "Prints the planned memory and time of the simulation before allocating it, then exits");
   bool print_unused{false};
   app.add_flag("-u, --print-unused", print_unused, "Prints unused entries in input file, then exits");
   bool version{false};
@@ -74,6 +84,9 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
     if (create_input_file_docs) {
       cli_opts.insert({"create-input-file-docs", {}});
     }
+    if (plan) {
+      cli_opts.insert({"plan", {}});
+    }
     if (print_unused) {
       cli_opts.insert({"print-unused", {}});
     }
@@ -86,6 +99,15 @@ std::unordered_map<std::string, std::string> defineAndParse(int argc, char* argv
       cli_opts.insert({"paraview", {}});
       cli_opts.insert({"paraview-directory", output_directory + "_paraview"});
     }
+    if (async_output) {
+      cli_opts.insert({"async-output", {}});
+    }
+    if (pin_threads) {
+      cli_opts.insert({"pin-threads", {}});
+    }
+    if (log_flush_opt->count() > 0) {
+      cli_opts["log-flush-interval"] = std::to_string(log_flush_interval);
+    }
   }
 
   return cli_opts;
@@ -109,10 +131,14 @@ void printGiven(std::unordered_map<std::string, std::string>& cli_opts)
   // Create options map
   // clang-format off
   std::vector<std::pair<std::string, std::string>> opts_output_map{
+    {"async-output", "Asynchronous output"},
     {"create-input-file-docs", "Create Input File Docs"},
     {"input-file", "Input File"},
+    {"log-flush-interval", "Log Flush Interval"},
     {"output-directory", "Output Directory"},
     {"paraview", "Enable ParaView output"},
+    {"pin-threads", "Pin OpenMP threads"},
+    {"plan", "Print the run plan"},
     {"restart-cycle", "Restart Cycle"},
     {"version", "Print version"}};
   // clang-format on
@@ -0,0 +1,76 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/ensemble.hpp"
+
+#include <algorithm>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+Ensemble::Ensemble(int num_cases, int num_groups, MPI_Comm comm)
+    : num_cases_(num_cases), num_groups_(num_groups), comm_(comm)
+{
+  int rank, size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  SLIC_ERROR_ROOT_IF(num_cases < 0, "The number of load cases must be non-negative");
+  SLIC_ERROR_ROOT_IF(num_groups < 1 || num_groups > size,
+                     axom::fmt::format("An ensemble on {} ranks can't be split into {} groups", size, num_groups));
+
+  // consecutive ranks are usually on the same node, so they make up each group
+  group_ = static_cast<int>((static_cast<long>(rank) * num_groups) / size);
+  MPI_Comm_split(comm_, group_, rank, &group_comm_);
+
+  for (int c = group_; c < num_cases_; c += num_groups_) {
+    cases_.push_back(c);
+  }
+}
+
+Ensemble::~Ensemble() { MPI_Comm_free(&group_comm_); }
+
+std::vector<std::vector<double>> Ensemble::run(const std::function<std::vector<double>(int)>& solve) const
+{
+  int group_rank;
+  MPI_Comm_rank(group_comm_, &group_rank);
+
+  std::vector<std::vector<double>> results(static_cast<size_t>(num_cases_));
+  for (int c : cases_) {
+    results[static_cast<size_t>(c)] = solve(c);
+  }
+
+  // only the first rank of each group contributes its results, which are then summed over the whole ensemble
+  std::vector<int> sizes(static_cast<size_t>(num_cases_), 0);
+  if (group_rank == 0) {
+    for (int c : cases_) {
+      sizes[static_cast<size_t>(c)] = static_cast<int>(results[static_cast<size_t>(c)].size());
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, sizes.data(), num_cases_, MPI_INT, MPI_SUM, comm_);
+
+  std::vector<int> offsets(static_cast<size_t>(num_cases_) + 1, 0);
+  for (size_t c = 0; c < sizes.size(); c++) {
+    offsets[c + 1] = offsets[c] + sizes[c];
+  }
+
+  std::vector<double> values(static_cast<size_t>(offsets.back()), 0.0);
+  if (group_rank == 0) {
+    for (int c : cases_) {
+      const auto& result = results[static_cast<size_t>(c)];
+      std::copy(result.begin(), result.end(), values.begin() + offsets[static_cast<size_t>(c)]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, values.data(), offsets.back(), MPI_DOUBLE, MPI_SUM, comm_);
+
+  for (size_t c = 0; c < results.size(); c++) {
+    results[c].assign(values.begin() + offsets[c], values.begin() + offsets[c + 1]);
+  }
+  return results;
+}
+
+}  // namespace serac
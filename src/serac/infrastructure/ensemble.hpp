@@ -0,0 +1,111 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file ensemble.hpp
+ *
+ * @brief Running the load cases of an ensemble concurrently on groups of ranks, or in turn on all of them
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include "mpi.h"
+
+namespace serac {
+
+/**
+ * @brief Splits a communicator into groups of ranks, and distributes the load cases of an ensemble over them
+ *
+ * Each group solves its cases in turn, so everything that is set up once per group (the mesh, the physics modules,
+ * and the element restrictions, geometric factors and gradient lookup tables shared through shared_setup) is reused
+ * by all of its cases. With one group, every case is solved in turn on all of the ranks.
+ *
+ * @code{.cpp}
+ * Ensemble ensemble(num_cases, num_groups);
+ *
+ * // one mesh and one physics module on the ranks of each group
+ * auto mesh = mesh::refineAndDistribute(std::move(serial_mesh), 0, 0, ensemble.comm());
+ * ...
+ * auto results = ensemble.run([&](int load_case) {
+ *   solid.resetStates();
+ *   solid.setTraction(tractions[load_case]);
+ *   solid.advanceTimestep(1.0);
+ *   return std::vector<double>{compliance(solid)};
+ * });
+ * @endcode
+ */
+class Ensemble {
+public:
+  /**
+   * @brief Split @a comm into @a num_groups groups of consecutive ranks
+   *
+   * @param num_cases The number of load cases
+   * @param num_groups The number of groups, which must not be more than the number of ranks
+   * @param comm The communicator of all of the ranks
+   *
+   * @note case c is solved by group c % num_groups
+   */
+  Ensemble(int num_cases, int num_groups, MPI_Comm comm = MPI_COMM_WORLD);
+
+  /// @brief Free the communicator of this rank's group
+  ~Ensemble();
+
+  /// @brief Ensembles own a communicator, so they are not copyable
+  Ensemble(const Ensemble&) = delete;
+
+  /// @brief Ensembles own a communicator, so they are not copyable
+  Ensemble& operator=(const Ensemble&) = delete;
+
+  /// @brief The communicator of this rank's group, on which its meshes and physics modules should be built
+  MPI_Comm comm() const { return group_comm_; }
+
+  /// @brief The index of this rank's group
+  int group() const { return group_; }
+
+  /// @brief The number of groups
+  int numGroups() const { return num_groups_; }
+
+  /// @brief The number of load cases
+  int numCases() const { return num_cases_; }
+
+  /// @brief The load cases solved by this rank's group, in increasing order
+  const std::vector<int>& cases() const { return cases_; }
+
+  /**
+   * @brief Solve each of this group's load cases in turn, and share the results of every case with every rank
+   *
+   * @param solve Called as solve(load_case) on every rank of the group, returning the results of the case (e.g.
+   * quantities of interest), which must be the same on every rank of the group
+   * @return The results of every load case, by case
+   *
+   * @note this is collective over the communicator of the whole ensemble
+   */
+  std::vector<std::vector<double>> run(const std::function<std::vector<double>(int)>& solve) const;
+
+private:
+  /// The number of load cases
+  int num_cases_;
+
+  /// The number of groups
+  int num_groups_;
+
+  /// The communicator of all of the ranks
+  MPI_Comm comm_;
+
+  /// The communicator of this rank's group
+  MPI_Comm group_comm_;
+
+  /// The index of this rank's group
+  int group_;
+
+  /// The load cases of this rank's group
+  std::vector<int> cases_;
+};
+
+}  // namespace serac
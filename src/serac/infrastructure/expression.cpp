@@ -0,0 +1,385 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/expression.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <map>
+#include <stdexcept>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// the number of points that each instruction is applied to at a time
+constexpr std::size_t chunk_size = 64;
+
+}  // namespace
+
+/**
+ * expression := term (('+' | '-') term)*
+ * term       := unary (('*' | '/') unary)*
+ * unary      := ('-' | '+') unary | power
+ * power      := primary ('^' unary)?
+ * primary    := number | variable | function '(' expression (',' expression)? ')' | '(' expression ')'
+ */
+class Expression::Parser {
+public:
+  Parser(const std::string& source, std::vector<Instruction>& program) : source_(source), program_(program) {}
+
+  void parse()
+  {
+    expression();
+    skipSpaces();
+    if (position_ != source_.size()) {
+      fail("unexpected characters");
+    }
+  }
+
+private:
+  void expression()
+  {
+    term();
+    while (accept('+') || accept('-')) {
+      char op = source_[position_ - 1];
+      term();
+      emit(op == '+' ? Op::Add : Op::Subtract);
+    }
+  }
+
+  void term()
+  {
+    unary();
+    while (accept('*') || accept('/')) {
+      char op = source_[position_ - 1];
+      unary();
+      emit(op == '*' ? Op::Multiply : Op::Divide);
+    }
+  }
+
+  void unary()
+  {
+    if (accept('-')) {
+      unary();
+      emit(Op::Negate);
+    } else if (accept('+')) {
+      unary();
+    } else {
+      power();
+    }
+  }
+
+  void power()
+  {
+    primary();
+    if (accept('^')) {
+      unary();
+      emit(Op::Power);
+    }
+  }
+
+  void primary()
+  {
+    skipSpaces();
+    if (position_ == source_.size()) {
+      fail("unexpected end");
+    }
+
+    char c = source_[position_];
+    if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+      std::size_t length = 0;
+      double      value  = 0.0;
+      try {
+        value = std::stod(source_.substr(position_), &length);
+      } catch (const std::logic_error&) {
+        fail("invalid number");
+      }
+      position_ += length;
+      program_.push_back({Op::Constant, value});
+      return;
+    }
+
+    if (accept('(')) {
+      expression();
+      expect(')');
+      return;
+    }
+
+    if (!std::isalpha(static_cast<unsigned char>(c))) {
+      fail("unexpected character");
+    }
+
+    std::size_t begin = position_;
+    while (position_ < source_.size() &&
+           (std::isalnum(static_cast<unsigned char>(source_[position_])) || source_[position_] == '_')) {
+      position_++;
+    }
+    std::string name = source_.substr(begin, position_ - begin);
+
+    static const std::map<std::string, Op> variables = {{"x", Op::X}, {"y", Op::Y}, {"z", Op::Z}, {"t", Op::T}};
+    if (variables.count(name)) {
+      emit(variables.at(name));
+      return;
+    }
+    if (name == "pi") {
+      program_.push_back({Op::Constant, M_PI});
+      return;
+    }
+
+    static const std::map<std::string, Op> unary_functions = {
+        {"sin", Op::Sin},   {"cos", Op::Cos},   {"tan", Op::Tan},   {"asin", Op::Asin}, {"acos", Op::Acos},
+        {"atan", Op::Atan}, {"sinh", Op::Sinh}, {"cosh", Op::Cosh}, {"tanh", Op::Tanh}, {"exp", Op::Exp},
+        {"log", Op::Log},   {"sqrt", Op::Sqrt}, {"abs", Op::Abs},   {"floor", Op::Floor}, {"ceil", Op::Ceil}};
+    static const std::map<std::string, Op> binary_functions = {
+        {"atan2", Op::Atan2}, {"pow", Op::Power}, {"min", Op::Min}, {"max", Op::Max}};
+
+    if (unary_functions.count(name)) {
+      expect('(');
+      expression();
+      expect(')');
+      emit(unary_functions.at(name));
+    } else if (binary_functions.count(name)) {
+      expect('(');
+      expression();
+      expect(',');
+      expression();
+      expect(')');
+      emit(binary_functions.at(name));
+    } else {
+      fail("unknown variable or function '" + name + "'");
+    }
+  }
+
+  void emit(Op op) { program_.push_back({op, 0.0}); }
+
+  void skipSpaces()
+  {
+    while (position_ < source_.size() && std::isspace(static_cast<unsigned char>(source_[position_]))) {
+      position_++;
+    }
+  }
+
+  bool accept(char c)
+  {
+    skipSpaces();
+    if (position_ < source_.size() && source_[position_] == c) {
+      position_++;
+      return true;
+    }
+    return false;
+  }
+
+  void expect(char c)
+  {
+    if (!accept(c)) {
+      fail(std::string("expected '") + c + "'");
+    }
+  }
+
+  void fail(const std::string& message) const
+  {
+    SLIC_ERROR_ROOT(axom::fmt::format("Invalid expression '{}': {} at position {}", source_, message, position_));
+  }
+
+  const std::string&        source_;
+  std::vector<Instruction>& program_;
+  std::size_t               position_ = 0;
+};
+
+Expression::Expression(const std::string& source) : source_(source)
+{
+  Parser(source_, program_).parse();
+
+  // the depth of the stack after each instruction, which only consumes the values of its operands
+  std::size_t depth = 0;
+  for (const auto& instruction : program_) {
+    switch (instruction.op) {
+      case Op::Constant:
+      case Op::X:
+      case Op::Y:
+      case Op::Z:
+      case Op::T:
+        depth++;
+        break;
+      case Op::Add:
+      case Op::Subtract:
+      case Op::Multiply:
+      case Op::Divide:
+      case Op::Power:
+      case Op::Atan2:
+      case Op::Min:
+      case Op::Max:
+        depth--;
+        break;
+      default:
+        break;
+    }
+    stack_size_ = std::max(stack_size_, depth);
+  }
+}
+
+bool Expression::dependsOnTime() const
+{
+  return std::any_of(program_.begin(), program_.end(), [](const Instruction& i) { return i.op == Op::T; });
+}
+
+double Expression::operator()(const mfem::Vector& x, double t) const
+{
+  double value;
+  evaluate(x.GetData(), x.Size(), 1, t, &value);
+  return value;
+}
+
+void Expression::evaluate(const double* coordinates, int dim, std::size_t num_points, double t, double* values,
+                          std::size_t stride) const
+{
+  std::vector<double> stack(stack_size_ * chunk_size);
+
+  for (std::size_t begin = 0; begin < num_points; begin += chunk_size) {
+    std::size_t n   = std::min(chunk_size, num_points - begin);
+    double*     top = stack.data();  // one past the chunk on the top of the stack
+
+    // the operands of an instruction are the chunks on the top of the stack, and its result replaces them
+    auto unary = [&](auto f) {
+      double* a = top - chunk_size;
+      for (std::size_t i = 0; i < n; i++) a[i] = f(a[i]);
+    };
+    auto binary = [&](auto f) {
+      double* a = top - 2 * chunk_size;
+      double* b = top - chunk_size;
+      for (std::size_t i = 0; i < n; i++) a[i] = f(a[i], b[i]);
+      top = b;
+    };
+
+    for (const auto& instruction : program_) {
+      switch (instruction.op) {
+        case Op::Constant:
+          std::fill(top, top + n, instruction.value);
+          top += chunk_size;
+          break;
+        case Op::X:
+        case Op::Y:
+        case Op::Z: {
+          int component = static_cast<int>(instruction.op) - static_cast<int>(Op::X);
+          for (std::size_t i = 0; i < n; i++) {
+            top[i] = (component < dim) ? coordinates[(begin + i) * std::size_t(dim) + std::size_t(component)] : 0.0;
+          }
+          top += chunk_size;
+          break;
+        }
+        case Op::T:
+          std::fill(top, top + n, t);
+          top += chunk_size;
+          break;
+        case Op::Add:
+          binary([](double a, double b) { return a + b; });
+          break;
+        case Op::Subtract:
+          binary([](double a, double b) { return a - b; });
+          break;
+        case Op::Multiply:
+          binary([](double a, double b) { return a * b; });
+          break;
+        case Op::Divide:
+          binary([](double a, double b) { return a / b; });
+          break;
+        case Op::Power:
+          binary([](double a, double b) { return std::pow(a, b); });
+          break;
+        case Op::Atan2:
+          binary([](double a, double b) { return std::atan2(a, b); });
+          break;
+        case Op::Min:
+          binary([](double a, double b) { return std::min(a, b); });
+          break;
+        case Op::Max:
+          binary([](double a, double b) { return std::max(a, b); });
+          break;
+        case Op::Negate:
+          unary([](double a) { return -a; });
+          break;
+        case Op::Sin:
+          unary([](double a) { return std::sin(a); });
+          break;
+        case Op::Cos:
+          unary([](double a) { return std::cos(a); });
+          break;
+        case Op::Tan:
+          unary([](double a) { return std::tan(a); });
+          break;
+        case Op::Asin:
+          unary([](double a) { return std::asin(a); });
+          break;
+        case Op::Acos:
+          unary([](double a) { return std::acos(a); });
+          break;
+        case Op::Atan:
+          unary([](double a) { return std::atan(a); });
+          break;
+        case Op::Sinh:
+          unary([](double a) { return std::sinh(a); });
+          break;
+        case Op::Cosh:
+          unary([](double a) { return std::cosh(a); });
+          break;
+        case Op::Tanh:
+          unary([](double a) { return std::tanh(a); });
+          break;
+        case Op::Exp:
+          unary([](double a) { return std::exp(a); });
+          break;
+        case Op::Log:
+          unary([](double a) { return std::log(a); });
+          break;
+        case Op::Sqrt:
+          unary([](double a) { return std::sqrt(a); });
+          break;
+        case Op::Abs:
+          unary([](double a) { return std::abs(a); });
+          break;
+        case Op::Floor:
+          unary([](double a) { return std::floor(a); });
+          break;
+        case Op::Ceil:
+          unary([](double a) { return std::ceil(a); });
+          break;
+      }
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+      values[(begin + i) * stride] = stack[i];
+    }
+  }
+}
+
+double ExpressionCoefficient::Eval(mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip)
+{
+  mfem::Vector x;
+  T.Transform(ip, x);
+  return expression_(x, GetTime());
+}
+
+VectorExpressionCoefficient::VectorExpressionCoefficient(std::vector<Expression> components)
+    : mfem::VectorCoefficient(static_cast<int>(components.size())), components_(std::move(components))
+{
+}
+
+void VectorExpressionCoefficient::Eval(mfem::Vector& V, mfem::ElementTransformation& T,
+                                       const mfem::IntegrationPoint& ip)
+{
+  mfem::Vector x;
+  T.Transform(ip, x);
+  V.SetSize(vdim);
+  for (int i = 0; i < vdim; i++) {
+    V(i) = components_[static_cast<std::size_t>(i)](x, GetTime());
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,157 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file expression.hpp
+ *
+ * @brief Arithmetic expressions of space and time from input decks, compiled for evaluation in batches of points
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief An arithmetic expression of the coordinates x, y, z and the time t, compiled from a string into a small
+ * stack program that is evaluated for batches of points at a time, without going through an interpreter
+ *
+ * The expressions are made of numbers, the variables x, y, z and t, the constant pi, the operators + - * / and ^
+ * (power, which is right-associative and binds tighter than unary minus, so -x^2 is -(x^2)), parentheses, and the
+ * functions sin, cos, tan, asin, acos, atan, sinh, cosh, tanh, exp, log, sqrt, abs, floor, ceil (of one argument),
+ * and atan2, pow, min, max (of two arguments). E.g. "0.1 * sin(pi * x) * min(t, 1)".
+ *
+ * Anything else (e.g. conditionals, or functions of other quantities) has to stay a Lua function.
+ */
+class Expression {
+public:
+  /**
+   * @brief compile @a source
+   * @note malformed expressions (or unknown variables and functions) are errors
+   */
+  explicit Expression(const std::string& source);
+
+  /// @brief the expression it was compiled from
+  const std::string& source() const { return source_; }
+
+  /// @brief whether the expression depends on the time
+  bool dependsOnTime() const;
+
+  /**
+   * @brief evaluate the expression at a single point
+   * @param x the coordinates of the point (the ones past its size are 0)
+   * @param t the time
+   */
+  double operator()(const mfem::Vector& x, double t) const;
+
+  /**
+   * @brief evaluate the expression at a batch of points, each instruction for a chunk of points at a time
+   *
+   * @param coordinates the coordinates of the points, point by point (i.e. x0, y0, z0, x1, y1, ...)
+   * @param dim the number of coordinates of each point (the ones past it are 0)
+   * @param num_points the number of points
+   * @param t the time
+   * @param values the value at each point, @a stride apart
+   * @param stride the distance between the value of consecutive points, e.g. the number of components of the values
+   * of a vector-valued function, when this is one of its components
+   */
+  void evaluate(const double* coordinates, int dim, std::size_t num_points, double t, double* values,
+                std::size_t stride = 1) const;
+
+private:
+  /// the instructions of the stack program
+  enum class Op : uint8_t
+  {
+    Constant,
+    X,
+    Y,
+    Z,
+    T,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+    Negate,
+    Sin,
+    Cos,
+    Tan,
+    Asin,
+    Acos,
+    Atan,
+    Sinh,
+    Cosh,
+    Tanh,
+    Exp,
+    Log,
+    Sqrt,
+    Abs,
+    Floor,
+    Ceil,
+    Atan2,
+    Min,
+    Max
+  };
+
+  /// an instruction, and the value it pushes (for Op::Constant)
+  struct Instruction {
+    Op     op;     ///< what the instruction does
+    double value;  ///< the value of a constant
+  };
+
+  /// the recursive descent parser that compiles the source
+  class Parser;
+
+  /// the expression it was compiled from
+  std::string source_;
+
+  /// the instructions of the stack program, in postfix order
+  std::vector<Instruction> program_;
+
+  /// the largest number of intermediate values on the stack
+  std::size_t stack_size_ = 0;
+};
+
+/// @brief a scalar mfem::Coefficient evaluating an Expression at the physical coordinates of each point
+class ExpressionCoefficient : public mfem::Coefficient {
+public:
+  /// @brief a coefficient evaluating @a expression
+  explicit ExpressionCoefficient(Expression expression) : expression_(std::move(expression)) {}
+
+  /// @brief the expression, e.g. to evaluate it for many points at once with Expression::evaluate()
+  const Expression& expression() const { return expression_; }
+
+  /// @brief evaluate the expression at the physical coordinates of @a ip
+  double Eval(mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override;
+
+private:
+  /// the expression
+  Expression expression_;
+};
+
+/// @brief an mfem::VectorCoefficient evaluating an Expression for each component at the physical coordinates of a point
+class VectorExpressionCoefficient : public mfem::VectorCoefficient {
+public:
+  /// @brief a coefficient evaluating @a components
+  explicit VectorExpressionCoefficient(std::vector<Expression> components);
+
+  /// @brief the expression of each component
+  const std::vector<Expression>& components() const { return components_; }
+
+  /// @brief evaluate the expressions at the physical coordinates of @a ip
+  void Eval(mfem::Vector& V, mfem::ElementTransformation& T, const mfem::IntegrationPoint& ip) override;
+
+private:
+  /// the expression of each component
+  std::vector<Expression> components_;
+};
+
+}  // namespace serac
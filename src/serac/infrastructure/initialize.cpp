@@ -39,8 +39,9 @@ std::pair<int, int> getMPIInfo(MPI_Comm comm)
 
 std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm)
 {
-  // Initialize MPI.
-  if (MPI_Init(&argc, &argv) != MPI_SUCCESS) {
+  // Initialize MPI, with the thread support needed for asynchronous output if the implementation provides it
+  int provided = MPI_THREAD_SINGLE;
+  if (MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided) != MPI_SUCCESS) {
     std::cerr << "Failed to initialize MPI" << std::endl;
     serac::exitGracefully(true);
   }
@@ -62,6 +63,9 @@ std::pair<int, int> initialize(int argc, char* argv[], MPI_Comm comm)
   mfem::Sundials::Init();
 #endif
 
+  // Route the allocations of performance-critical buffers through memory pools (no-op if Umpire is not enabled)
+  accelerator::initializeMemoryPools();
+
   // Initialize GPU (no-op if not enabled/available)
   // TODO for some reason this causes errors on Lassen. We need to look into this ASAP.
   // accelerator::initializeDevice();
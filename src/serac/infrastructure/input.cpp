@@ -11,6 +11,7 @@
 
 #include "axom/core.hpp"
 
+#include "serac/infrastructure/expression.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/numerics/solver_config.hpp"
@@ -110,7 +111,7 @@ void BoundaryConditionInputOptions::defineInputFileSchema(axom::inlet::Container
 
 bool CoefficientInputOptions::isVector() const
 {
-  return vector_function || vector_constant || (!vector_pw_const.empty());
+  return vector_function || !vector_expression.empty() || vector_constant || (!vector_pw_const.empty());
 }
 
 std::unique_ptr<mfem::VectorCoefficient> CoefficientInputOptions::constructVector(const int dim) const
@@ -119,6 +120,14 @@ std::unique_ptr<mfem::VectorCoefficient> CoefficientInputOptions::constructVecto
 
   if (vector_function) {
     return std::make_unique<mfem::VectorFunctionCoefficient>(dim, vector_function);
+  } else if (!vector_expression.empty()) {
+    // The components that aren't given (e.g. z in 3D) are 0
+    std::vector<Expression> components;
+    for (int i = 0; i < std::max(dim, static_cast<int>(vector_expression.size())); i++) {
+      components.emplace_back(i < static_cast<int>(vector_expression.size()) ? vector_expression[std::size_t(i)]
+                                                                               : std::string("0"));
+    }
+    return std::make_unique<VectorExpressionCoefficient>(std::move(components));
   } else if (vector_constant) {
     return std::make_unique<mfem::VectorConstantCoefficient>(*vector_constant);
   } else if (!vector_pw_const.empty()) {
@@ -159,6 +168,8 @@ std::unique_ptr<mfem::Coefficient> CoefficientInputOptions::constructScalar() co
 
   if (scalar_function) {
     return std::make_unique<mfem::FunctionCoefficient>(scalar_function);
+  } else if (scalar_expression) {
+    return std::make_unique<ExpressionCoefficient>(Expression(*scalar_expression));
   } else if (scalar_constant) {
     return std::make_unique<mfem::ConstantCoefficient>(*scalar_constant);
   } else if (!scalar_pw_const.empty()) {
@@ -196,6 +207,14 @@ void CoefficientInputOptions::defineInputFileSchema(axom::inlet::Container& cont
   container.addFunction("scalar_function", axom::inlet::FunctionTag::Double,
                         {axom::inlet::FunctionTag::Vector, axom::inlet::FunctionTag::Double},
                         "The function to use for an mfem::FunctionCoefficient");
+  container.addString("scalar_expression",
+                      "An arithmetic expression of x, y, z and t to use as the coefficient, e.g. 'sin(pi * x) * t'");
+  auto& expression_container = container.addStruct(
+      "vector_expression", "The arithmetic expressions of x, y, z and t of each component to use as the coefficient");
+  expression_container.addString("x", "x-component of vector");
+  expression_container.addString("y", "y-component of vector");
+  expression_container.addString("z", "z-component of vector");
+
   container.addInt("component", "The vector component to which the scalar coefficient should be applied");
 
   container.addDouble("constant", "The constant scalar value to use as the coefficient");
@@ -271,6 +290,19 @@ serac::input::CoefficientInputOptions FromInlet<serac::input::CoefficientInputOp
     coefficient_definitions++;
   }
 
+  if (base.contains("scalar_expression")) {
+    result.scalar_expression = base["scalar_expression"].get<std::string>();
+    coefficient_definitions++;
+  }
+
+  if (base.contains("vector_expression")) {
+    for (const char* component : {"x", "y", "z"}) {
+      if (!base["vector_expression"].contains(component)) break;
+      result.vector_expression.push_back(base["vector_expression"][component].get<std::string>());
+    }
+    coefficient_definitions++;
+  }
+
   if (base.contains("constant")) {
     result.scalar_constant = base["constant"];
     coefficient_definitions++;
@@ -292,7 +324,7 @@ serac::input::CoefficientInputOptions FromInlet<serac::input::CoefficientInputOp
   }
 
   // If scalar valued, check of a component
-  if (result.scalar_constant || result.scalar_function || !result.scalar_pw_const.empty()) {
+  if (result.scalar_constant || result.scalar_function || result.scalar_expression || !result.scalar_pw_const.empty()) {
     // If component input exists, set it in the option struct
     if (base.contains("component")) {
       result.component = base["component"];
@@ -301,7 +333,8 @@ serac::input::CoefficientInputOptions FromInlet<serac::input::CoefficientInputOp
 
   SLIC_ERROR_ROOT_IF(coefficient_definitions > 1,
                      "Coefficient has multiple definitions. Please use only one of (constant, vector_constant, "
-                     "piecewise_constant, vector_piecewise_constant, scalar_function, vector_function");
+                     "piecewise_constant, vector_piecewise_constant, scalar_function, vector_function, "
+                     "scalar_expression, vector_expression)");
   SLIC_ERROR_ROOT_IF(coefficient_definitions == 0, "Coefficient definition does not contain known type.");
 
   return result;
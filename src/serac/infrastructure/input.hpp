@@ -15,6 +15,7 @@
 #include <string>
 #include <variant>
 #include <optional>
+#include <vector>
 
 #include "mfem.hpp"
 #include "axom/inlet.hpp"
@@ -107,6 +108,17 @@ struct CoefficientInputOptions {
    */
   VecFunc vector_function;
 
+  /**
+   * @brief The arithmetic expression of x, y, z and t of a scalar coefficient, evaluated without Lua
+   * @see serac::Expression
+   */
+  std::optional<std::string> scalar_expression;
+
+  /**
+   * @brief The arithmetic expression of x, y, z and t of each component of a vector coefficient
+   */
+  std::vector<std::string> vector_expression;
+
   /**
    * @brief The scalar constant associated with the coefficient
    */
@@ -11,6 +11,11 @@
 
 namespace serac::logger {
 
+namespace {
+/// The number of cycles between the flushes of flushIfDue()
+int flush_interval = 1;
+}  // namespace
+
 bool initialize(MPI_Comm comm)
 {
   namespace slic = axom::slic;
@@ -53,7 +58,9 @@ bool initialize(MPI_Comm comm)
 
     const int RLIMIT = 8;
 
-    i_logstream  = new slic::LumberjackStream(&std::cout, comm, RLIMIT, i_format_string);
+    // Info messages are almost all logged on the root rank only, so they are written right away rather than
+    // aggregated by Lumberjack, whose flushes are collective
+    i_logstream  = new slic::GenericOutputStream(&std::cout, i_format_string);
     d_logstream  = new slic::LumberjackStream(&std::cout, comm, RLIMIT, d_format_string);
     we_logstream = new slic::LumberjackStream(&std::cerr, comm, RLIMIT, we_format_string);
   } else {
@@ -88,4 +95,17 @@ void finalize() { axom::slic::finalize(); }
 
 void flush() { axom::slic::flushStreams(); }
 
+void setFlushInterval(int cycles)
+{
+  SLIC_ERROR_ROOT_IF(cycles < 1, axom::fmt::format("The logger flush interval must be at least 1, got {}", cycles));
+  flush_interval = cycles;
+}
+
+void flushIfDue(int cycle)
+{
+  if (cycle % flush_interval == 0) {
+    flush();
+  }
+}
+
 }  // namespace serac::logger
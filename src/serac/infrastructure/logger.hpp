@@ -26,6 +26,10 @@ namespace serac::logger {
  * and tells SLIC how to format the messages.  This function also creates different
  * logging streams if you are running serial or parallel.
  *
+ * In parallel, debug messages, warnings and errors are aggregated across ranks, so they are only written
+ * by the (collective) flush(). Info messages are written by each rank as soon as they are logged, so
+ * SLIC_INFO_ROOT messages never wait for a flush.
+ *
  * @param[in] comm MPI communicator that the logger will use
  */
 bool initialize(MPI_Comm comm);
@@ -46,4 +50,20 @@ void finalize();
  */
 void flush();
 
+/**
+ * @brief Sets how often flushIfDue() flushes the messages held by the logger
+ *
+ * @param[in] cycles Flush every this many cycles, 1 flushes every cycle
+ */
+void setFlushInterval(int cycles);
+
+/**
+ * @brief Flushes messages currently held by the logger, if the interval set by setFlushInterval() is due at a cycle
+ *
+ * This skips the collective flush() on most cycles of a long time loop. Every rank must call it with the same cycle.
+ *
+ * @param[in] cycle The current simulation cycle
+ */
+void flushIfDue(int cycle);
+
 }  // namespace serac::logger
@@ -0,0 +1,173 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace serac::memory {
+
+std::size_t bytes(const mfem::Vector& v) { return v.OwnsData() ? std::size_t(v.Capacity()) * sizeof(double) : 0; }
+
+std::size_t bytes(const mfem::SparseMatrix& A)
+{
+  if (!A.Finalized()) {
+    return 0;
+  }
+
+  std::size_t nnz = std::size_t(A.NumNonZeroElems());
+
+  std::size_t graph  = A.OwnsGraph() ? (std::size_t(A.Height()) + 1 + nnz) * sizeof(int) : 0;
+  std::size_t values = A.OwnsData() ? nnz * sizeof(double) : 0;
+  return graph + values;
+}
+
+std::size_t bytes(const mfem::HypreParMatrix& A)
+{
+  auto csr_bytes = [](hypre_CSRMatrix* block) {
+    auto nnz  = std::size_t(hypre_CSRMatrixNumNonzeros(block));
+    auto rows = std::size_t(hypre_CSRMatrixNumRows(block));
+    return (rows + 1 + nnz) * sizeof(HYPRE_Int) + nnz * sizeof(HYPRE_Complex);
+  };
+
+  hypre_ParCSRMatrix* matrix = A;
+
+  hypre_CSRMatrix* offd   = hypre_ParCSRMatrixOffd(matrix);
+  std::size_t      colmap = std::size_t(hypre_CSRMatrixNumCols(offd)) * sizeof(HYPRE_BigInt);
+  return csr_bytes(hypre_ParCSRMatrixDiag(matrix)) + csr_bytes(offd) + colmap;
+}
+
+void add(Usage& usage, const std::string& prefix, const Usage& nested)
+{
+  for (const auto& [name, nbytes] : nested) {
+    usage[prefix + "/" + name] += nbytes;
+  }
+}
+
+std::size_t total(const Usage& usage)
+{
+  std::size_t sum = 0;
+  for (const auto& [name, nbytes] : usage) {
+    sum += nbytes;
+  }
+  return sum;
+}
+
+std::size_t residentBytes()
+{
+#if defined(__linux__)
+  // the second entry of statm is the resident set size, in pages
+  std::ifstream statm("/proc/self/statm");
+  std::size_t   pages = 0, resident = 0;
+  if (statm >> pages >> resident) {
+    return resident * std::size_t(sysconf(_SC_PAGESIZE));
+  }
+#endif
+  return 0;
+}
+
+std::size_t peakResidentBytes()
+{
+#if defined(__unix__) || defined(__APPLE__)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+    // macOS reports the high-water mark in bytes, Linux in kilobytes
+    return std::size_t(usage.ru_maxrss);
+#else
+    return std::size_t(usage.ru_maxrss) * 1024;
+#endif
+  }
+#endif
+  return 0;
+}
+
+std::size_t availableBytes(MPI_Comm comm)
+{
+  std::size_t available = 0;
+#if defined(__linux__)
+  // e.g. "MemAvailable:   16230472 kB"
+  std::ifstream meminfo("/proc/meminfo");
+  std::string   line;
+  while (std::getline(meminfo, line)) {
+    if (line.rfind("MemAvailable:", 0) == 0) {
+      std::istringstream fields(line.substr(13));
+      std::size_t        kilobytes = 0;
+      if (fields >> kilobytes) {
+        available = kilobytes * 1024;
+      }
+      break;
+    }
+  }
+#endif
+
+  MPI_Comm node;
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+  int ranks_on_node = 1;
+  MPI_Comm_size(node, &ranks_on_node);
+  MPI_Comm_free(&node);
+
+  return available / std::size_t(ranks_on_node);
+}
+
+std::map<std::string, Statistics> reduce(const Usage& usage, MPI_Comm comm)
+{
+  int num_ranks;
+  MPI_Comm_size(comm, &num_ranks);
+
+  // ranks may not have the same components (e.g. one without boundary elements), so the names are gathered first
+  std::string names;
+  for (const auto& [name, _] : usage) {
+    names += name + '\n';
+  }
+
+  int              length = int(names.size());
+  std::vector<int> lengths(std::size_t(num_ranks));
+  MPI_Allgather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, comm);
+
+  std::vector<int> offsets(std::size_t(num_ranks) + 1, 0);
+  for (std::size_t r = 0; r < std::size_t(num_ranks); r++) {
+    offsets[r + 1] = offsets[r] + lengths[r];
+  }
+
+  std::string all_names(std::size_t(offsets.back()), '\0');
+  MPI_Allgatherv(names.data(), length, MPI_CHAR, all_names.data(), lengths.data(), offsets.data(), MPI_CHAR, comm);
+
+  std::set<std::string> components;
+  for (std::size_t begin = 0, end = 0; (end = all_names.find('\n', begin)) != std::string::npos; begin = end + 1) {
+    components.insert(all_names.substr(begin, end - begin));
+  }
+
+  std::vector<double> local;
+  local.reserve(components.size());
+  for (const auto& name : components) {
+    auto it = usage.find(name);
+    local.push_back(it == usage.end() ? 0.0 : double(it->second));
+  }
+
+  int                 n = int(local.size());
+  std::vector<double> mins(local.size()), maxs(local.size()), sums(local.size());
+  MPI_Allreduce(local.data(), mins.data(), n, MPI_DOUBLE, MPI_MIN, comm);
+  MPI_Allreduce(local.data(), maxs.data(), n, MPI_DOUBLE, MPI_MAX, comm);
+  MPI_Allreduce(local.data(), sums.data(), n, MPI_DOUBLE, MPI_SUM, comm);
+
+  std::map<std::string, Statistics> statistics;
+  std::size_t                       i = 0;
+  for (const auto& name : components) {
+    statistics[name] = Statistics{mins[i], maxs[i], sums[i] / num_ranks};
+    i++;
+  }
+  return statistics;
+}
+
+}  // namespace serac::memory
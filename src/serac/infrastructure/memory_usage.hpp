@@ -0,0 +1,101 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file memory_usage.hpp
+ *
+ * @brief Functions for accounting for the memory used by the components of a simulation
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mfem.hpp"
+#include "mpi.h"
+
+/**
+ * @brief Memory accounting helper functions
+ */
+namespace serac::memory {
+
+/**
+ * @brief The bytes used by each component of a simulation on this rank, by name
+ *
+ * Names are paths like "residual/gradient_lookup_tables", so that the usage of nested objects can be merged with
+ * add() under a common prefix.
+ */
+using Usage = std::map<std::string, std::size_t>;
+
+/// @brief The bytes used by a component, over all of the ranks
+struct Statistics {
+  /// The smallest number of bytes used by a rank
+  double min = 0.0;
+  /// The largest number of bytes used by a rank
+  double max = 0.0;
+  /// The average number of bytes used by a rank
+  double avg = 0.0;
+};
+
+/// @brief The bytes allocated for the values of a std::vector
+template <typename T>
+std::size_t bytes(const std::vector<T>& v)
+{
+  return v.capacity() * sizeof(T);
+}
+
+/// @brief The bytes allocated for the values of a vector, or 0 if it doesn't own them
+std::size_t bytes(const mfem::Vector& v);
+
+/// @brief The bytes allocated for the row offsets, column indices and values of a sparse matrix that owns them
+std::size_t bytes(const mfem::SparseMatrix& A);
+
+/// @brief The bytes allocated for the diag and offd blocks and the column map of a parallel matrix
+std::size_t bytes(const mfem::HypreParMatrix& A);
+
+/**
+ * @brief Add the usage of a nested object to another, prefixing the names of its components
+ *
+ * @param[inout] usage The usage to add to
+ * @param prefix The name the components of @a nested are filed under, e.g. "residual"
+ * @param nested The usage of the nested object
+ */
+void add(Usage& usage, const std::string& prefix, const Usage& nested);
+
+/// @brief The sum of the bytes of every component
+std::size_t total(const Usage& usage);
+
+/// @brief The resident set size of this process in bytes, or 0 where it can't be queried
+std::size_t residentBytes();
+
+/// @brief The high-water mark of the resident set size of this process in bytes, or 0 where it can't be queried
+std::size_t peakResidentBytes();
+
+/**
+ * @brief The memory available to each rank of a node: the available memory of the node (MemAvailable, which includes
+ * the caches the kernel can reclaim) divided among the ranks of @a comm that share it, or 0 where it can't be queried
+ *
+ * @note This is a collective operation
+ */
+std::size_t availableBytes(MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Compute the minimum, maximum and average of each component over the ranks of a communicator
+ *
+ * Components that a rank doesn't have count as 0 bytes on that rank.
+ *
+ * @param usage The usage of this rank
+ * @param comm The communicator to reduce over
+ * @return The statistics of each component of any of the ranks
+ *
+ * @note This is a collective operation
+ */
+std::map<std::string, Statistics> reduce(const Usage& usage, MPI_Comm comm = MPI_COMM_WORLD);
+
+}  // namespace serac::memory
@@ -45,4 +45,62 @@ void outputSummary(const axom::sidre::DataStore& datastore, const std::string& o
   datastore.getRoot()->getGroup("serac_summary")->save(path, file_format_string);
 }
 
+AsyncWriter::AsyncWriter() : thread_([this]() { run(); }) {}
+
+AsyncWriter::~AsyncWriter()
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  condition_.notify_all();
+  thread_.join();
+}
+
+void AsyncWriter::submit(std::function<void()> write)
+{
+  wait();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ = std::move(write);
+    busy_    = true;
+  }
+  condition_.notify_all();
+}
+
+void AsyncWriter::wait()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  condition_.wait(lock, [this]() { return !busy_; });
+}
+
+void AsyncWriter::run()
+{
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    condition_.wait(lock, [this]() { return pending_ || stop_; });
+    if (!pending_) {
+      return;
+    }
+
+    auto write = std::move(pending_);
+    pending_   = nullptr;
+
+    lock.unlock();
+    write();
+    lock.lock();
+
+    busy_ = false;
+    condition_.notify_all();
+  }
+}
+
+bool supportsAsynchronousWrites()
+{
+  int provided = MPI_THREAD_SINGLE;
+  MPI_Query_thread(&provided);
+  return provided == MPI_THREAD_MULTIPLE;
+}
+
 }  // namespace serac::output
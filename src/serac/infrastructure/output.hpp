@@ -12,7 +12,11 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "axom/sidre.hpp"
 
@@ -42,4 +46,67 @@ enum class FileFormat
 void outputSummary(const axom::sidre::DataStore& datastore, const std::string& output_directory,
                    const FileFormat file_format = FileFormat::JSON);
 
+/**
+ * @brief A background thread that performs one output write at a time, so that writing files overlaps computation
+ *
+ * The data written must be staged (copied out of the live simulation fields) before it is submitted, and must not be
+ * modified until the write finishes, which is ensured by calling wait() (or submit(), which waits) before staging
+ * the next output.
+ *
+ * @note Writes that communicate (e.g. parallel Sidre output) require MPI to be initialized with
+ * MPI_THREAD_MULTIPLE, see supportsAsynchronousWrites().
+ */
+class AsyncWriter {
+public:
+  /// @brief Start the background thread
+  AsyncWriter();
+
+  /// @brief Finish the pending write, if any, and stop the background thread
+  ~AsyncWriter();
+
+  /// @brief Deleted copy constructor
+  AsyncWriter(const AsyncWriter&) = delete;
+
+  /// @brief Deleted copy assignment
+  AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+  /**
+   * @brief Wait for the previous write to finish, then start a new one in the background
+   *
+   * @param write The write to perform on the background thread
+   */
+  void submit(std::function<void()> write);
+
+  /// @brief Block until the pending write, if any, has finished
+  void wait();
+
+private:
+  /// @brief The loop run by the background thread
+  void run();
+
+  /// @brief Guards the members below
+  std::mutex mutex_;
+
+  /// @brief Signals a submitted or finished write
+  std::condition_variable condition_;
+
+  /// @brief The write that has been submitted but not started
+  std::function<void()> pending_;
+
+  /// @brief Whether a write is submitted or in progress
+  bool busy_ = false;
+
+  /// @brief Whether the background thread should exit
+  bool stop_ = false;
+
+  /// @brief The background thread, started last so that the members above are initialized
+  std::thread thread_;
+};
+
+/**
+ * @brief Whether MPI was initialized with the thread support needed to write in the background while other MPI
+ * communication is in progress
+ */
+bool supportsAsynchronousWrites();
+
 }  // namespace serac::output
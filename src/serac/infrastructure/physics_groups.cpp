@@ -0,0 +1,80 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/physics_groups.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+PhysicsGroups::PhysicsGroups(const std::vector<double>& weights, MPI_Comm comm) : comm_(comm)
+{
+  int rank, size;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Comm_size(comm_, &size);
+
+  int num_groups = static_cast<int>(weights.size());
+  SLIC_ERROR_ROOT_IF(num_groups < 1 || num_groups > size,
+                     axom::fmt::format("{} ranks can't be split into {} physics groups", size, num_groups));
+  SLIC_ERROR_ROOT_IF(std::any_of(weights.begin(), weights.end(), [](double w) { return !(w > 0.0); }),
+                     "The weights of the physics groups must be positive");
+
+  // every group gets one rank, and the rest are shared out in proportion to the weights, with the ranks left over
+  // from rounding down going to the largest remainders
+  double              total_weight = std::accumulate(weights.begin(), weights.end(), 0.0);
+  std::vector<int>    num_ranks(weights.size(), 1);
+  std::vector<double> remainders(weights.size());
+  int                 unassigned = size - num_groups;
+  for (size_t g = 0; g < weights.size(); g++) {
+    double share = (size - num_groups) * weights[g] / total_weight;
+    num_ranks[g] += static_cast<int>(std::floor(share));
+    remainders[g] = share - std::floor(share);
+    unassigned -= static_cast<int>(std::floor(share));
+  }
+
+  std::vector<size_t> order(weights.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return remainders[a] > remainders[b]; });
+  for (int i = 0; i < unassigned; i++) {
+    num_ranks[order[static_cast<size_t>(i)]]++;
+  }
+
+  // consecutive ranks are usually on the same node, so they make up each group
+  first_ranks_.assign(weights.size() + 1, 0);
+  std::partial_sum(num_ranks.begin(), num_ranks.end(), first_ranks_.begin() + 1);
+  auto next_group = std::upper_bound(first_ranks_.begin(), first_ranks_.end(), rank);
+  group_          = static_cast<int>(next_group - first_ranks_.begin()) - 1;
+  MPI_Comm_split(comm_, group_, rank, &group_comm_);
+}
+
+PhysicsGroups::~PhysicsGroups() { MPI_Comm_free(&group_comm_); }
+
+std::vector<double> PhysicsGroups::share(int from_group, const std::vector<double>& values) const
+{
+  SLIC_ERROR_ROOT_IF(from_group < 0 || from_group >= numGroups(),
+                     axom::fmt::format("There is no physics group {}", from_group));
+
+  int size;
+  MPI_Comm_size(comm_, &size);
+
+  int count = (group_ == from_group) ? static_cast<int>(values.size()) : 0;
+
+  std::vector<int> counts(static_cast<size_t>(size));
+  MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, comm_);
+
+  std::vector<int> offsets(static_cast<size_t>(size) + 1, 0);
+  std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+  std::vector<double> shared(static_cast<size_t>(offsets.back()));
+  MPI_Allgatherv(values.data(), count, MPI_DOUBLE, shared.data(), counts.data(), offsets.data(), MPI_DOUBLE, comm_);
+  return shared;
+}
+
+}  // namespace serac
@@ -0,0 +1,121 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file physics_groups.hpp
+ *
+ * @brief Advancing loosely coupled physics modules concurrently on disjoint groups of ranks
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mpi.h"
+
+namespace serac {
+
+/**
+ * @brief Splits a communicator into disjoint groups of ranks, one for each of a few loosely coupled physics modules,
+ * so that the modules advance concurrently instead of in turn on all of the ranks
+ *
+ * Every rank builds the mesh and the physics module of its own group only (on comm()), so each module only scales to
+ * the ranks of its group. The groups only synchronize when they exchange their coupling fields or quantities, see
+ * share().
+ *
+ * @code{.cpp}
+ * // a quarter of the ranks for the heat transfer, the rest for the (more expensive) solid mechanics
+ * PhysicsGroups groups({1.0, 3.0});
+ * constexpr int thermal_group = 0, solid_group = 1;
+ *
+ * std::unique_ptr<HeatTransfer<p, dim>> thermal;
+ * std::unique_ptr<SolidMechanics<p, dim>> solid;
+ * if (groups.group() == thermal_group) {
+ *   StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(thermal_mesh), 0, 0, groups.comm()), "thermal");
+ *   thermal = std::make_unique<HeatTransfer<p, dim>>(..., "thermal");
+ * } else {
+ *   StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(solid_mesh), 0, 0, groups.comm()), "solid");
+ *   solid = std::make_unique<SolidMechanics<p, dim>>(..., "solid");
+ * }
+ *
+ * for (int cycle = 0; cycle < num_cycles; cycle++) {
+ *   // the modules advance at the same time, on their own ranks
+ *   std::vector<double> interface_temperature, interface_force;
+ *   if (thermal) {
+ *     thermal->advanceTimestep(dt);
+ *     interface_temperature = averageTemperatures(*thermal);
+ *   } else {
+ *     solid->advanceTimestep(dt);
+ *     interface_force = reactionForces(*solid);
+ *   }
+ *
+ *   // the synchronization point, where each module receives the coupling values of the other
+ *   interface_temperature = groups.share(thermal_group, interface_temperature);
+ *   interface_force       = groups.share(solid_group, interface_force);
+ * }
+ * @endcode
+ */
+class PhysicsGroups {
+public:
+  /**
+   * @brief Split @a comm into groups of consecutive ranks, with numbers of ranks in proportion to @a weights
+   *
+   * @param weights The (positive) relative cost of the module of each group, e.g. its number of dofs
+   * @param comm The communicator of all of the ranks, which must have at least one rank for every group
+   *
+   * @note Every group gets at least one rank
+   */
+  PhysicsGroups(const std::vector<double>& weights, MPI_Comm comm = MPI_COMM_WORLD);
+
+  /// @brief Free the communicator of this rank's group
+  ~PhysicsGroups();
+
+  /// @brief PhysicsGroups own a communicator, so they are not copyable
+  PhysicsGroups(const PhysicsGroups&) = delete;
+
+  /// @brief PhysicsGroups own a communicator, so they are not copyable
+  PhysicsGroups& operator=(const PhysicsGroups&) = delete;
+
+  /// @brief The communicator of this rank's group, on which its mesh and physics module should be built
+  MPI_Comm comm() const { return group_comm_; }
+
+  /// @brief The index of this rank's group
+  int group() const { return group_; }
+
+  /// @brief The number of groups
+  int numGroups() const { return static_cast<int>(first_ranks_.size()) - 1; }
+
+  /// @brief The number of ranks of group @a g
+  int numRanks(int g) const { return first_ranks_[static_cast<size_t>(g + 1)] - first_ranks_[static_cast<size_t>(g)]; }
+
+  /**
+   * @brief Share the coupling values of group @a from_group with every rank
+   *
+   * @param from_group The group whose values are shared
+   * @param values This rank's part of the values on the ranks of @a from_group (e.g. its true dofs of a field, or
+   * a few quantities on its first rank and nothing on the others), and ignored on the other ranks
+   * @return The parts of the values of every rank of @a from_group, one after the other in the order of their ranks
+   *
+   * @note this is collective over the communicator of all of the groups, so it is the synchronization point of the
+   * concurrent modules
+   */
+  std::vector<double> share(int from_group, const std::vector<double>& values) const;
+
+private:
+  /// The communicator of all of the ranks
+  MPI_Comm comm_;
+
+  /// The communicator of this rank's group
+  MPI_Comm group_comm_;
+
+  /// The index of this rank's group
+  int group_;
+
+  /// The first rank (of comm_) of each group, and the number of ranks after the last one
+  std::vector<int> first_ranks_;
+};
+
+}  // namespace serac
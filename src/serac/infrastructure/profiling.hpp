@@ -112,6 +112,49 @@ void initialize([[maybe_unused]] MPI_Comm comm = MPI_COMM_WORLD, [[maybe_unused]
  */
 void finalize();
 
+/**
+ * @brief Attaches a numeric attribute (e.g. an element count or a flop estimate) to the enclosing Caliper regions,
+ * for the lifetime of this object. Does nothing when Serac has not been configured with Caliper.
+ */
+class ScopedAttribute {
+public:
+  /**
+   * @brief Begin the attribute
+   * @param name The name of the attribute, which must outlive this object
+   * @param value The value of the attribute
+   */
+  ScopedAttribute([[maybe_unused]] const char* name, [[maybe_unused]] double value)
+#ifdef SERAC_USE_CALIPER
+      : name_(name)
+  {
+    cali_begin_double_byname(name, value);
+  }
+#else
+  {
+  }
+#endif
+
+  /// @brief End the attribute
+  ~ScopedAttribute()
+  {
+#ifdef SERAC_USE_CALIPER
+    cali_end_byname(name_);
+#endif
+  }
+
+  /// @brief Attributes are tied to a scope, so they can't be copied
+  ScopedAttribute(const ScopedAttribute&) = delete;
+
+  /// @brief Attributes are tied to a scope, so they can't be copied
+  ScopedAttribute& operator=(const ScopedAttribute&) = delete;
+
+private:
+#ifdef SERAC_USE_CALIPER
+  /// The name of the attribute
+  const char* name_;
+#endif
+};
+
 /// Produces a string by applying << to all arguments
 template <typename... T>
 std::string concat(T... args)
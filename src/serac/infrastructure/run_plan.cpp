@@ -0,0 +1,42 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/run_plan.hpp"
+
+#include <vector>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+void printRunPlan(const RunPlan& plan, MPI_Comm comm)
+{
+  memory::Usage bytes = plan.bytes;
+  bytes["total"]      = memory::total(plan.bytes);
+
+  auto statistics = memory::reduce(bytes, comm);
+
+  SLIC_INFO_ROOT("Planned memory per rank (MiB, max / avg):");
+  for (const auto& [name, stats] : statistics) {
+    constexpr double MiB = 1024.0 * 1024.0;
+    SLIC_INFO_ROOT(axom::fmt::format("  {:<48} {:>12.2f} / {:.2f}", name, stats.max / MiB, stats.avg / MiB));
+  }
+
+  // every rank plans the same phases
+  std::vector<double> seconds;
+  for (const auto& [phase, time] : plan.seconds) {
+    seconds.push_back(time);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, seconds.data(), int(seconds.size()), MPI_DOUBLE, MPI_MAX, comm);
+
+  SLIC_INFO_ROOT("Planned time (seconds, slowest rank):");
+  std::size_t i = 0;
+  for (const auto& [phase, time] : plan.seconds) {
+    SLIC_INFO_ROOT(axom::fmt::format("  {:<48} {:>12.3g}", phase, seconds[i++]));
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,75 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file run_plan.hpp
+ *
+ * @brief The predicted memory and time of a simulation, computed before it allocates its large buffers or solves
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#include "mpi.h"
+
+#include "serac/infrastructure/memory_usage.hpp"
+
+namespace serac {
+
+/**
+ * @brief The rates of a rank, and the few properties of the solve, that the time estimates of a RunPlan are based on
+ *
+ * The defaults are those of a single core of a recent CPU. They can be calibrated from the functional benchmarks
+ * (e.g. physics/benchmarks/benchmark_kernels), whose Caliper profiles place each kernel on a roofline with their
+ * "functional.flops" and "functional.bytes" attributes, see KernelAnnotation.
+ */
+struct CostModel {
+  /// The sustained floating point operations per second of a rank
+  double flops_per_second = 1.0e10;
+
+  /// The sustained memory bandwidth of a rank, in bytes per second
+  double bytes_per_second = 1.0e10;
+
+  /// The number of Newton iterations assumed for each cycle of a nonlinear solve
+  double newton_iterations = 3.0;
+
+  /**
+   * @brief The bytes of an algebraic multigrid preconditioner per byte of the matrix it is built from (i.e. its
+   * operator complexity), or 0 for solvers without one
+   */
+  double preconditioner_complexity = 1.5;
+
+  /// @brief The time of a kernel on this roofline, i.e. the longer of its compute and memory times
+  double seconds(double flops, double bytes) const
+  {
+    return std::max(flops / flops_per_second, bytes / bytes_per_second);
+  }
+};
+
+/// @brief The predicted memory and time of a simulation on this rank
+struct RunPlan {
+  /// The bytes each component will use on this rank by name, with the names of BasePhysics::memoryUsage()
+  memory::Usage bytes;
+
+  /// The seconds each phase of the run will take on this rank by name, e.g. "residual_evaluation"
+  std::map<std::string, double> seconds;
+};
+
+/**
+ * @brief Log the largest and average bytes of each component of a plan and their total over the ranks, and the
+ * largest time of each phase
+ *
+ * @param plan The plan of this rank
+ * @param comm The communicator to reduce over
+ *
+ * @note This is a collective operation
+ */
+void printRunPlan(const RunPlan& plan, MPI_Comm comm = MPI_COMM_WORLD);
+
+}  // namespace serac
@@ -0,0 +1,52 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/shared_memory.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+NodeSharedMemory::NodeSharedMemory(std::size_t bytes, MPI_Comm comm) : bytes_(bytes)
+{
+  MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm_);
+  MPI_Comm_rank(node_comm_, &node_rank_);
+
+  // only the writer allocates, the other ranks of the node map its memory
+  MPI_Aint local_bytes = writer() ? MPI_Aint(bytes) : 0;
+  int      error       = MPI_Win_allocate_shared(local_bytes, 1, MPI_INFO_NULL, node_comm_, &data_, &window_);
+  SLIC_ERROR_IF(error != MPI_SUCCESS, axom::fmt::format("Could not allocate {} bytes of node shared memory", bytes));
+
+  if (!writer()) {
+    MPI_Aint size;
+    int      displacement_unit;
+    MPI_Win_shared_query(window_, 0, &size, &displacement_unit, &data_);
+  }
+
+  // the memory is accessed with plain loads and stores, which a passive target epoch covers for the whole lifetime
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, window_);
+}
+
+NodeSharedMemory::~NodeSharedMemory()
+{
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized) return;
+
+  MPI_Win_unlock_all(window_);
+  MPI_Win_free(&window_);
+  MPI_Comm_free(&node_comm_);
+}
+
+void NodeSharedMemory::publish()
+{
+  // the writer's stores are made visible before the barrier, and the readers synchronize their view after it
+  MPI_Win_sync(window_);
+  MPI_Barrier(node_comm_);
+  MPI_Win_sync(window_);
+}
+
+}  // namespace serac
@@ -0,0 +1,126 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file shared_memory.hpp
+ *
+ * @brief Immutable data that the ranks of a node keep a single copy of, in an MPI-3 shared memory window
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "mpi.h"
+
+namespace serac {
+
+/**
+ * @brief A block of memory shared by the ranks of a communicator that are on the same node
+ *
+ * The first rank of each node allocates the memory (with MPI_Win_allocate_shared), and the others map it. It is
+ * meant for large read-only data that every rank would otherwise replicate: the writer() fills it in, and publish()
+ * makes it visible to the other ranks on the node.
+ *
+ * @note Creating, publishing and destroying the memory are collective operations over the communicator
+ */
+class NodeSharedMemory {
+public:
+  /**
+   * @brief Allocate the memory for a node
+   *
+   * @param bytes The size of the memory, which must be the same on every rank
+   * @param comm The communicator to share the memory within the nodes of
+   */
+  NodeSharedMemory(std::size_t bytes, MPI_Comm comm);
+
+  NodeSharedMemory(const NodeSharedMemory&)            = delete;
+  NodeSharedMemory& operator=(const NodeSharedMemory&) = delete;
+
+  /// @brief Free the window, unless MPI has been finalized already
+  ~NodeSharedMemory();
+
+  /// @brief Whether this rank is the one that fills in the memory of its node
+  bool writer() const { return node_rank_ == 0; }
+
+  /// @brief Make what the writer() wrote visible to the other ranks of the node, which wait for it
+  void publish();
+
+  /// @brief The memory
+  void* data() const { return data_; }
+
+  /// @brief The size of the memory, in bytes
+  std::size_t bytes() const { return bytes_; }
+
+private:
+  /// The ranks of the communicator on this node
+  MPI_Comm node_comm_ = MPI_COMM_NULL;
+
+  /// The window of the memory
+  MPI_Win window_ = MPI_WIN_NULL;
+
+  /// The rank of this process on its node
+  int node_rank_ = 0;
+
+  /// The memory, mapped in this process
+  void* data_ = nullptr;
+
+  /// The size of the memory, in bytes
+  std::size_t bytes_ = 0;
+};
+
+/**
+ * @brief An array shared by the ranks on a node, see NodeSharedMemory
+ *
+ * Copies of the array refer to the same memory, and the last copy on each rank frees it.
+ *
+ * @tparam T The type of the values, which must be trivially copyable
+ */
+template <typename T>
+class NodeSharedArray {
+public:
+  /// @brief An empty array
+  NodeSharedArray() = default;
+
+  /**
+   * @brief Allocate an array for each node
+   *
+   * @param size The number of values, which must be the same on every rank
+   * @param comm The communicator to share the array within the nodes of
+   */
+  NodeSharedArray(std::size_t size, MPI_Comm comm)
+      : memory_(std::make_shared<NodeSharedMemory>(size * sizeof(T), comm)), size_(size)
+  {
+  }
+
+  /// @brief Whether this rank is the one that fills in the array of its node
+  bool writer() const { return memory_ && memory_->writer(); }
+
+  /// @brief Make the values written by the writer() visible to the other ranks of the node
+  void publish()
+  {
+    if (memory_) memory_->publish();
+  }
+
+  /// @brief The values, which only the writer() may modify before publish()
+  T* data() const { return memory_ ? static_cast<T*>(memory_->data()) : nullptr; }
+
+  /// @brief The number of values
+  std::size_t size() const { return size_; }
+
+  /// @brief The value at index @a i
+  const T& operator[](std::size_t i) const { return data()[i]; }
+
+private:
+  /// The memory of this node
+  std::shared_ptr<NodeSharedMemory> memory_;
+
+  /// The number of values
+  std::size_t size_ = 0;
+};
+
+}  // namespace serac
@@ -0,0 +1,73 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+
+#include "serac/infrastructure/output.hpp"
+
+namespace serac {
+
+TEST(AsyncWriter, WritesInOrderAndOneAtATime)
+{
+  std::vector<int> written;
+  std::atomic<int> in_progress{0};
+  std::atomic<int> max_in_progress{0};
+
+  {
+    output::AsyncWriter writer;
+    for (int i = 0; i < 5; i++) {
+      writer.submit([&, i]() {
+        max_in_progress = std::max(max_in_progress.load(), ++in_progress);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        written.push_back(i);
+        in_progress--;
+      });
+    }
+    // the destructor finishes the last write
+  }
+
+  EXPECT_EQ(written, (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(max_in_progress, 1);
+}
+
+TEST(AsyncWriter, WaitBlocksUntilTheWriteFinishes)
+{
+  output::AsyncWriter writer;
+  std::atomic<bool>   done{false};
+
+  writer.submit([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    done = true;
+  });
+  writer.wait();
+
+  EXPECT_TRUE(done);
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
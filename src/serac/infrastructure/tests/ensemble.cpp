@@ -0,0 +1,70 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/ensemble.hpp"
+
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/mesh/mesh_utils_base.hpp"
+
+namespace serac {
+
+TEST(Ensemble, GroupsSolveTheirOwnCases)
+{
+  int num_ranks;
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+  constexpr int num_cases = 7;
+
+  for (int num_groups = 1; num_groups <= num_ranks; num_groups++) {
+    Ensemble ensemble(num_cases, num_groups);
+
+    int group_size;
+    MPI_Comm_size(ensemble.comm(), &group_size);
+    EXPECT_GE(group_size, num_ranks / num_groups);
+
+    for (int c : ensemble.cases()) {
+      EXPECT_EQ(c % num_groups, ensemble.group());
+    }
+
+    // the mesh is distributed once over each group, and reused by all of its cases
+    auto mesh = mesh::refineAndDistribute(mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL), 0, 0,
+                                          ensemble.comm());
+
+    auto results = ensemble.run([&](int load_case) {
+      // a collective reduction over the group, whose result doesn't depend on how the group is partitioned
+      int num_elements = mesh->GetNE();
+      MPI_Allreduce(MPI_IN_PLACE, &num_elements, 1, MPI_INT, MPI_SUM, ensemble.comm());
+      return std::vector<double>(static_cast<size_t>(load_case % 3 + 1), 10.0 * load_case + num_elements);
+    });
+
+    ASSERT_EQ(results.size(), std::size_t(num_cases));
+    for (int c = 0; c < num_cases; c++) {
+      EXPECT_EQ(results[static_cast<size_t>(c)], std::vector<double>(static_cast<size_t>(c % 3 + 1), 10.0 * c + 16));
+    }
+  }
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
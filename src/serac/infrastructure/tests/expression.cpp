@@ -0,0 +1,102 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/expression.hpp"
+
+#include <cmath>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+using namespace serac;
+
+class SlicErrorException : public std::exception {};
+
+TEST(Expression, Precedence)
+{
+  mfem::Vector x(2);
+  x(0) = 2.0;
+  x(1) = 3.0;
+
+  EXPECT_DOUBLE_EQ(Expression("1 + 2 * x")(x, 0.0), 5.0);
+  EXPECT_DOUBLE_EQ(Expression("(1 + 2) * x")(x, 0.0), 6.0);
+  EXPECT_DOUBLE_EQ(Expression("x - y - 1")(x, 0.0), -2.0);
+  EXPECT_DOUBLE_EQ(Expression("y / x / 2")(x, 0.0), 0.75);
+  EXPECT_DOUBLE_EQ(Expression("-x^2")(x, 0.0), -4.0);
+  EXPECT_DOUBLE_EQ(Expression("x^y^2")(x, 0.0), 512.0);
+  EXPECT_DOUBLE_EQ(Expression("2^-1")(x, 0.0), 0.5);
+  EXPECT_DOUBLE_EQ(Expression("1.5e1 + z")(x, 0.0), 15.0);
+}
+
+TEST(Expression, Functions)
+{
+  mfem::Vector x(3);
+  x(0) = 0.25;
+  x(1) = -2.0;
+  x(2) = 4.0;
+
+  EXPECT_DOUBLE_EQ(Expression("sin(pi * x) * t")(x, 2.0), std::sin(M_PI * 0.25) * 2.0);
+  EXPECT_DOUBLE_EQ(Expression("sqrt(z) + abs(y)")(x, 0.0), 4.0);
+  EXPECT_DOUBLE_EQ(Expression("atan2(y, z)")(x, 0.0), std::atan2(-2.0, 4.0));
+  EXPECT_DOUBLE_EQ(Expression("min(t, 1) + max(x, y) + pow(z, 0.5)")(x, 3.0), 3.25);
+  EXPECT_DOUBLE_EQ(Expression("exp(log(z)) + floor(y / 3) + ceil(x)")(x, 0.0), 4.0);
+
+  EXPECT_TRUE(Expression("x * t").dependsOnTime());
+  EXPECT_FALSE(Expression("x * y").dependsOnTime());
+}
+
+TEST(Expression, EvaluatesBatches)
+{
+  // more points than are evaluated in each chunk, and not a multiple of it
+  const std::size_t   num_points = 150;
+  const int           dim        = 2;
+  std::vector<double> coordinates(num_points * dim);
+  for (std::size_t i = 0; i < num_points; i++) {
+    coordinates[i * dim]     = 0.01 * double(i);
+    coordinates[i * dim + 1] = 1.0 - 0.02 * double(i);
+  }
+
+  // every other entry, as the first component of a vector-valued function
+  Expression          expression("x * y + cos(t * x) - z");
+  std::vector<double> values(2 * num_points, -1.0);
+  expression.evaluate(coordinates.data(), dim, num_points, 1.5, values.data(), 2);
+
+  for (std::size_t i = 0; i < num_points; i++) {
+    mfem::Vector x(&coordinates[i * dim], dim);
+    double       expected = x(0) * x(1) + std::cos(1.5 * x(0));
+    EXPECT_DOUBLE_EQ(values[2 * i], expected);
+    EXPECT_DOUBLE_EQ(expression(x, 1.5), expected);
+    EXPECT_EQ(values[2 * i + 1], -1.0);
+  }
+}
+
+TEST(Expression, InvalidExpressions)
+{
+  axom::slic::setAbortFunction([]() { throw SlicErrorException{}; });
+  axom::slic::setAbortOnError(true);
+
+  for (const char* source : {"", "1 +", "(x", "x y", "sin x", "foo(x)", "w", "atan2(x)", "x $ 2", "."}) {
+    EXPECT_THROW(Expression{source}, SlicErrorException) << source;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 #include "mfem.hpp"
 
+#include "serac/infrastructure/expression.hpp"
 #include "serac/infrastructure/input.hpp"
 
 class SlicErrorException : public std::exception {};
@@ -90,6 +91,40 @@ TEST_F(InputTest, CoefBuildScalar)
   EXPECT_NO_THROW(coef_opts.constructScalar());
 }
 
+TEST_F(InputTest, CoefBuildExpressions)
+{
+  reader_->parseString(
+      "scalar = { scalar_expression = 'y * 2 + z * t', component = 1 }\n"
+      "vector = { vector_expression = { x = 'y * 2', y = '-x' } }");
+  auto& scalar_table = inlet_->addStruct("scalar");
+  auto& vector_table = inlet_->addStruct("vector");
+  input::CoefficientInputOptions::defineInputFileSchema(scalar_table);
+  input::CoefficientInputOptions::defineInputFileSchema(vector_table);
+
+  auto scalar_opts = scalar_table.get<input::CoefficientInputOptions>();
+  EXPECT_EQ(scalar_opts.component, 1);
+  EXPECT_FALSE(scalar_opts.isVector());
+  auto vector_opts = vector_table.get<input::CoefficientInputOptions>();
+  EXPECT_TRUE(vector_opts.isVector());
+
+  // both evaluate without going through Lua
+  auto scalar_coef = scalar_opts.constructScalar();
+  auto vector_coef = vector_opts.constructVector(3);
+  ASSERT_NE(dynamic_cast<ExpressionCoefficient*>(scalar_coef.get()), nullptr);
+  ASSERT_NE(dynamic_cast<VectorExpressionCoefficient*>(vector_coef.get()), nullptr);
+  EXPECT_EQ(vector_coef->GetVDim(), 3);
+
+  mfem::Vector x(3);
+  x(0) = 1;
+  x(1) = 2;
+  x(2) = 3;
+  EXPECT_DOUBLE_EQ(dynamic_cast<ExpressionCoefficient&>(*scalar_coef).expression()(x, 0.5), 5.5);
+  const auto& components = dynamic_cast<VectorExpressionCoefficient&>(*vector_coef).components();
+  EXPECT_DOUBLE_EQ(components[0](x, 0.0), 4.0);
+  EXPECT_DOUBLE_EQ(components[1](x, 0.0), -1.0);
+  EXPECT_DOUBLE_EQ(components[2](x, 0.0), 0.0);
+}
+
 TEST_F(InputTest, CoefBuildConstantScalar)
 {
   reader_->parseString("coef_opts = { constant = 2.5 }");
@@ -0,0 +1,80 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/physics_groups.hpp"
+
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/mesh/mesh_utils_base.hpp"
+
+namespace serac {
+
+TEST(PhysicsGroups, RanksInProportionToWeights)
+{
+  int num_ranks;
+  MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+  ASSERT_EQ(num_ranks, 4);
+
+  PhysicsGroups uneven({1.0, 3.0});
+  EXPECT_EQ(uneven.numGroups(), 2);
+  EXPECT_EQ(uneven.numRanks(0), 1);
+  EXPECT_EQ(uneven.numRanks(1), 3);
+
+  // every group gets a rank, however light it is
+  PhysicsGroups light({1.0, 1.0e-6, 1.0});
+  EXPECT_EQ(light.numRanks(0) + light.numRanks(2), 3);
+  EXPECT_EQ(light.numRanks(1), 1);
+
+  int group_size;
+  MPI_Comm_size(uneven.comm(), &group_size);
+  EXPECT_EQ(group_size, uneven.numRanks(uneven.group()));
+}
+
+TEST(PhysicsGroups, GroupsShareTheirCouplingValues)
+{
+  PhysicsGroups groups({1.0, 1.0});
+
+  int group_rank;
+  MPI_Comm_rank(groups.comm(), &group_rank);
+
+  // each group "solves" on its own mesh, and contributes one value per rank
+  auto mesh =
+      mesh::refineAndDistribute(mfem::Mesh::MakeCartesian2D(4, 4 * (groups.group() + 1), mfem::Element::QUADRILATERAL),
+                                0, 0, groups.comm());
+  int num_elements = mesh->GetNE();
+  MPI_Allreduce(MPI_IN_PLACE, &num_elements, 1, MPI_INT, MPI_SUM, groups.comm());
+
+  std::vector<double> values = {double(num_elements), double(group_rank)};
+  for (int g = 0; g < groups.numGroups(); g++) {
+    auto shared = groups.share(g, values);
+    ASSERT_EQ(shared.size(), 2 * std::size_t(groups.numRanks(g)));
+    for (int r = 0; r < groups.numRanks(g); r++) {
+      EXPECT_EQ(shared[2 * std::size_t(r)], 16.0 * (g + 1));
+      EXPECT_EQ(shared[2 * std::size_t(r) + 1], double(r));
+    }
+  }
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,73 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/infrastructure/shared_memory.hpp"
+
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/physics/materials/solid_material.hpp"
+
+namespace serac {
+
+TEST(NodeSharedArray, EveryRankOfANodeSeesTheValuesOfItsWriter)
+{
+  constexpr std::size_t size = 1000;
+
+  NodeSharedArray<double> array(size, MPI_COMM_WORLD);
+  ASSERT_EQ(array.size(), size);
+  if (array.writer()) {
+    for (std::size_t i = 0; i < size; i++) {
+      array.data()[i] = 0.5 * double(i);
+    }
+  }
+  array.publish();
+
+  for (std::size_t i = 0; i < size; i++) {
+    EXPECT_EQ(array[i], 0.5 * double(i));
+  }
+
+  // exactly one rank per node writes
+  MPI_Comm node_comm;
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+  int writers = array.writer() ? 1 : 0;
+  MPI_Allreduce(MPI_IN_PLACE, &writers, 1, MPI_INT, MPI_SUM, node_comm);
+  EXPECT_EQ(writers, 1);
+  MPI_Comm_free(&node_comm);
+}
+
+TEST(NodeSharedArray, SharedHardeningTablesInterpolateTheSame)
+{
+  solid_mechanics::PowerLawHardening law{.sigma_y = 1.0, .n = 2.0, .eps0 = 0.01};
+
+  solid_mechanics::TabulatedHardening<solid_mechanics::PowerLawHardening> table(law, 1.0, 1e-8);
+  auto                                                                    shared = table;
+  shared.shareWithinNode();
+
+  for (double eqps : {0.0, 1e-4, 0.0123, 0.3, 0.77, 1.0}) {
+    EXPECT_EQ(shared(eqps), table(eqps));
+  }
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
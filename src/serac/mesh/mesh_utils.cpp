@@ -6,11 +6,17 @@
 
 #include "serac/mesh/mesh_utils.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
 #include <fstream>
+#include <limits>
+#include <sstream>
 
 #include "axom/core.hpp"
 #include "axom/fmt.hpp"
 
+#include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/terminator.hpp"
 
@@ -402,6 +408,15 @@ void InputOptions::defineInputFileSchema(axom::inlet::Container& container)
 
   // `file` type mesh options
   container.addString("mesh", "Path to Mesh file");
+  container
+      .addString("parallel_read",
+                 "How the ranks read the mesh file: all_ranks, root_scatter (only rank 0 reads), or partitioned "
+                 "(the mesh path is the prefix of per-rank files)")
+      .defaultValue("all_ranks")
+      .validValues({"all_ranks", "root_scatter", "partitioned"});
+  container.addString("cache_directory",
+                      "Directory where the refined partitions of the mesh file are cached, to be read directly by "
+                      "later runs with the same mesh, number of ranks and refinement levels");
 
   // `box` type mesh generation options
   auto& elements = container.addStruct("elements");
@@ -416,6 +431,11 @@ void InputOptions::defineInputFileSchema(axom::inlet::Container& container)
   size.addDouble("y", "Size in the y-dimension");
   size.addDouble("z", "Size in the z-dimension");
 
+  container
+      .addBool("distributed",
+               "Whether each rank generates only its own block of a box mesh, instead of partitioning a serial mesh")
+      .defaultValue(false);
+
   // `ball` and `disk` mesh generation options
   container.addInt("approx_elements", "Approximate number of elements in an n-ball mesh");
 }
@@ -427,10 +447,39 @@ std::unique_ptr<mfem::ParMesh> buildParallelMesh(const InputOptions& options, co
   if (const auto file_opts = std::get_if<FileInputOptions>(&options.extra_options)) {
     SLIC_ERROR_ROOT_IF(file_opts->absolute_mesh_file_name.empty(),
                        "Absolute path to mesh file was not configured, did you forget to call findMeshFilePath?");
-    serial_mesh.emplace(buildMeshFromFile(file_opts->absolute_mesh_file_name));
+    switch (file_opts->parallel_read) {
+      case ParallelRead::RootScatter:
+        if (!file_opts->cache_directory.empty()) {
+          return buildCachedParallelMesh(file_opts->absolute_mesh_file_name, file_opts->cache_directory,
+                                         options.ser_ref_levels, options.par_ref_levels, ParallelRead::RootScatter,
+                                         comm);
+        }
+        return buildParallelMeshFromRoot(file_opts->absolute_mesh_file_name, options.ser_ref_levels,
+                                         options.par_ref_levels, comm);
+      case ParallelRead::Partitioned:
+        SLIC_ERROR_ROOT_IF(options.ser_ref_levels > 0, "Serial refinement is not possible for partitioned meshes");
+        return buildPartitionedMesh(file_opts->absolute_mesh_file_name, options.par_ref_levels, comm);
+      case ParallelRead::AllRanks:
+        if (!file_opts->cache_directory.empty()) {
+          return buildCachedParallelMesh(file_opts->absolute_mesh_file_name, file_opts->cache_directory,
+                                         options.ser_ref_levels, options.par_ref_levels, ParallelRead::AllRanks, comm);
+        }
+        serial_mesh.emplace(buildMeshFromFile(file_opts->absolute_mesh_file_name));
+        break;
+    }
   } else if (const auto box_opts = std::get_if<BoxInputOptions>(&options.extra_options)) {
     const auto& elems = box_opts->elements;
     const auto& sizes = box_opts->overall_size;
+    if (box_opts->distributed) {
+      // uniform refinement of a box gives the box with twice as many elements in each direction
+      const int scale = 1 << options.ser_ref_levels;
+      if (elems.size() == 2) {
+        return buildDistributedRectangleMesh(scale * elems.at(0), scale * elems.at(1), sizes.at(0), sizes.at(1),
+                                             options.par_ref_levels, comm);
+      }
+      return buildDistributedCuboidMesh(scale * elems.at(0), scale * elems.at(1), scale * elems.at(2), sizes.at(0),
+                                        sizes.at(1), sizes.at(2), options.par_ref_levels, comm);
+    }
     if (elems.size() == 2) {
       serial_mesh.emplace(buildRectangleMesh(elems.at(0), elems.at(1), sizes.at(0), sizes.at(1)));
     } else {
@@ -449,6 +498,122 @@ std::unique_ptr<mfem::ParMesh> buildParallelMesh(const InputOptions& options, co
   return refineAndDistribute(std::move(*serial_mesh), options.ser_ref_levels, options.par_ref_levels, comm);
 }
 
+mfem::Mesh reorderAlongHilbertCurve(mfem::Mesh&& serial_mesh)
+{
+  SLIC_ERROR_ROOT_IF(serial_mesh.NURBSext != nullptr, "Hilbert curve reordering is not supported for NURBS meshes");
+
+  mfem::Array<int> ordering;
+  serial_mesh.GetHilbertElementOrdering(ordering);
+
+  // renumbering the vertices as well means the dofs of the finite element spaces are reordered too
+  serial_mesh.ReorderElements(ordering, true);
+
+  return std::move(serial_mesh);
+}
+
+/// @brief Applies the parallel refinement and prepares a newly constructed parallel mesh for use
+mfem::Mesh reorderByReverseCuthillMcKee(mfem::Mesh&& serial_mesh)
+{
+  SLIC_ERROR_ROOT_IF(serial_mesh.NURBSext != nullptr, "Cuthill-McKee reordering is not supported for NURBS meshes");
+
+  const mfem::Table& neighbors = serial_mesh.ElementToElementTable();
+  const int          n         = serial_mesh.GetNE();
+  auto               by_degree = [&](int a, int b) { return neighbors.RowSize(a) < neighbors.RowSize(b); };
+
+  std::vector<bool> visited(static_cast<size_t>(n));
+
+  // the last level of a breadth-first search from an element, and the number of levels after the first
+  auto last_level = [&](int start) {
+    std::fill(visited.begin(), visited.end(), false);
+    visited[static_cast<size_t>(start)] = true;
+
+    std::vector<int> current{start}, next;
+    for (int depth = 0;; depth++) {
+      next.clear();
+      for (int e : current) {
+        for (int j = 0; j < neighbors.RowSize(e); j++) {
+          int neighbor = neighbors.GetRow(e)[j];
+          if (!visited[static_cast<size_t>(neighbor)]) {
+            visited[static_cast<size_t>(neighbor)] = true;
+            next.push_back(neighbor);
+          }
+        }
+      }
+      if (next.empty()) {
+        return std::pair{current, depth};
+      }
+      current.swap(next);
+    }
+  };
+
+  std::vector<int>  order;
+  std::vector<bool> numbered(static_cast<size_t>(n), false);
+  std::vector<int>  unnumbered;
+  order.reserve(static_cast<size_t>(n));
+  for (int seed = 0; seed < n; seed++) {
+    if (numbered[static_cast<size_t>(seed)]) {
+      continue;
+    }
+
+    // each connected component is numbered from a pseudo-peripheral element (George and Liu): the end of a
+    // breadth-first search with the most levels, found by restarting from the farthest elements
+    int start              = seed;
+    auto [farthest, depth] = last_level(start);
+    while (true) {
+      int candidate                              = *std::min_element(farthest.begin(), farthest.end(), by_degree);
+      auto [candidate_farthest, candidate_depth] = last_level(candidate);
+      if (candidate_depth <= depth) {
+        break;
+      }
+      start    = candidate;
+      farthest = candidate_farthest;
+      depth    = candidate_depth;
+    }
+
+    // Cuthill-McKee: breadth-first, visiting the neighbors of each element in order of increasing degree
+    std::size_t head = order.size();
+    order.push_back(start);
+    numbered[static_cast<size_t>(start)] = true;
+    while (head < order.size()) {
+      int e = order[head++];
+      unnumbered.clear();
+      for (int j = 0; j < neighbors.RowSize(e); j++) {
+        int neighbor = neighbors.GetRow(e)[j];
+        if (!numbered[static_cast<size_t>(neighbor)]) {
+          numbered[static_cast<size_t>(neighbor)] = true;
+          unnumbered.push_back(neighbor);
+        }
+      }
+      std::stable_sort(unnumbered.begin(), unnumbered.end(), by_degree);
+      order.insert(order.end(), unnumbered.begin(), unnumbered.end());
+    }
+  }
+
+  // the new index of each element, in the reverse of the Cuthill-McKee order
+  mfem::Array<int> ordering(n);
+  for (int i = 0; i < n; i++) {
+    ordering[order[static_cast<size_t>(i)]] = n - 1 - i;
+  }
+
+  // renumbering the vertices as well means the dofs of the finite element spaces are reordered too
+  serial_mesh.ReorderElements(ordering, true);
+
+  return std::move(serial_mesh);
+}
+
+std::unique_ptr<mfem::ParMesh> finalizeParallelMesh(std::unique_ptr<mfem::ParMesh> parallel_mesh,
+                                                    const int                       refine_parallel)
+{
+  for (int lev = 0; lev < refine_parallel; lev++) {
+    parallel_mesh->UniformRefinement();
+  }
+
+  parallel_mesh->EnsureNodes();
+  parallel_mesh->ExchangeFaceNbrData();
+
+  return parallel_mesh;
+}
+
 std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, const int refine_serial,
                                                    const int refine_parallel, const MPI_Comm comm)
 {
@@ -458,15 +623,759 @@ std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, con
   }
 
   // Then create the parallel mesh and apply parallel refinement
-  auto parallel_mesh = std::make_unique<mfem::ParMesh>(comm, serial_mesh);
+  return finalizeParallelMesh(std::make_unique<mfem::ParMesh>(comm, serial_mesh), refine_parallel);
+}
+
+std::vector<std::unique_ptr<mfem::ParMesh>> refineAndDistributeHierarchy(mfem::Mesh&& serial_mesh,
+                                                                         const int    refine_serial,
+                                                                         const int    refine_parallel,
+                                                                         const MPI_Comm comm)
+{
+  std::vector<std::unique_ptr<mfem::ParMesh>> levels;
+  levels.push_back(refineAndDistribute(std::move(serial_mesh), refine_serial, 0, comm));
+
   for (int lev = 0; lev < refine_parallel; lev++) {
-    parallel_mesh->UniformRefinement();
+    // refining a copy keeps the transforms from the previous level
+    auto finer = std::make_unique<mfem::ParMesh>(*levels.back());
+    finer->UniformRefinement();
+    finer->ExchangeFaceNbrData();
+    levels.push_back(std::move(finer));
   }
 
-  parallel_mesh->EnsureNodes();
-  parallel_mesh->ExchangeFaceNbrData();
+  return levels;
+}
 
-  return parallel_mesh;
+/// @brief The number of blocks of ranks in each direction of a Cartesian decomposition with the smallest interfaces
+std::array<int, 3> cartesianBlocks(const std::array<int, 3>& elements, const int dim, const int num_procs)
+{
+  std::array<int, 3> best{0, 0, 0};
+  double             best_area = std::numeric_limits<double>::max();
+
+  for (int px = 1; px <= num_procs; px++) {
+    for (int py = 1; py <= num_procs / px; py++) {
+      const int pz = num_procs / (px * py);
+      if (px * py * pz != num_procs || (dim == 2 && pz != 1)) {
+        continue;
+      }
+      std::array<int, 3> blocks{px, py, pz};
+
+      bool   fits = true;
+      double area = 0.0;
+      for (int d = 0; d < dim; d++) {
+        fits = fits && blocks[d] <= elements[d];
+
+        // the number of interface faces (or edges) normal to direction d
+        double faces = blocks[d] - 1;
+        for (int e = 0; e < dim; e++) {
+          faces *= (e == d) ? 1.0 : elements[e];
+        }
+        area += faces;
+      }
+
+      if (fits && area < best_area) {
+        best      = blocks;
+        best_area = area;
+      }
+    }
+  }
+
+  return best;
+}
+
+/**
+ * @brief Generates the block of a Cartesian mesh owned by one rank, in the format read by the mfem::ParMesh stream
+ * constructor
+ *
+ * The vertices, elements and boundary elements are those of mfem::Mesh::MakeCartesian2D/3D restricted to the block.
+ * Every entity on the boundary of the block is shared by the ranks whose (closed) blocks contain it, and each rank
+ * lists the shared entities of a group in the same (lexicographic) order.
+ */
+std::string cartesianMeshPartition(const std::array<int, 3>& elements, const std::array<double, 3>& size,
+                                   const int dim, const int num_procs, const int rank)
+{
+  const std::array<int, 3> blocks = cartesianBlocks(elements, dim, num_procs);
+  SLIC_ERROR_ROOT_IF(blocks[0] == 0, axom::fmt::format("The box can't be split into {} blocks of ranks with at least "
+                                                       "one element in each direction",
+                                                       num_procs));
+
+  // the first element of block b in direction d
+  auto start = [&](int d, int b) { return static_cast<int>((static_cast<long>(b) * elements[d]) / blocks[d]); };
+
+  // the block in direction d of element i
+  auto block_of_element = [&](int d, int i) {
+    int b = static_cast<int>((static_cast<long>(i) * blocks[d]) / elements[d]);
+    while (start(d, b + 1) <= i) {
+      b++;
+    }
+    while (start(d, b) > i) {
+      b--;
+    }
+    return b;
+  };
+
+  std::array<int, 3> block{rank % blocks[0], (rank / blocks[0]) % blocks[1], rank / (blocks[0] * blocks[1])};
+  std::array<int, 3> lo{0, 0, 0}, hi{0, 0, 0}, nodes{1, 1, 1};
+  for (int d = 0; d < dim; d++) {
+    lo[d]    = start(d, block[d]);
+    hi[d]    = start(d, block[d] + 1);
+    nodes[d] = hi[d] - lo[d] + 1;
+  }
+
+  // the local index of the vertex with global indices (i, j, k)
+  auto vertex = [&](int i, int j, int k) { return (i - lo[0]) + nodes[0] * ((j - lo[1]) + nodes[1] * (k - lo[2])); };
+
+  // the sorted ranks whose blocks contain the entity at the vertex (i, j, k) that spans one element in each
+  // direction of the mask
+  auto ranks_of = [&](const std::array<int, 3>& v, const std::array<bool, 3>& spans) {
+    std::array<std::vector<int>, 3> candidates;
+    for (int d = 0; d < 3; d++) {
+      if (d >= dim) {
+        candidates[d] = {0};
+      } else if (spans[d]) {
+        candidates[d] = {block_of_element(d, v[d])};
+      } else {
+        if (v[d] > 0) {
+          candidates[d].push_back(block_of_element(d, v[d] - 1));
+        }
+        if (v[d] < elements[d] && (candidates[d].empty() || candidates[d].back() != block_of_element(d, v[d]))) {
+          candidates[d].push_back(block_of_element(d, v[d]));
+        }
+      }
+    }
+
+    std::vector<int> ranks;
+    for (int bz : candidates[2]) {
+      for (int by : candidates[1]) {
+        for (int bx : candidates[0]) {
+          ranks.push_back(bx + blocks[0] * (by + blocks[1] * bz));
+        }
+      }
+    }
+    std::sort(ranks.begin(), ranks.end());
+    return ranks;
+  };
+
+  // the groups of ranks that share entities with this rank, the first of which is this rank alone
+  std::vector<std::vector<int>>                groups{{rank}};
+  std::vector<std::vector<int>>                shared_vertices(1);
+  std::vector<std::vector<std::array<int, 2>>> shared_edges(1);
+  std::vector<std::vector<std::array<int, 4>>> shared_faces(1);
+
+  // the index of the group of the given ranks, which is added if it is new
+  auto group_of = [&](const std::vector<int>& ranks) {
+    auto it = std::find(groups.begin(), groups.end(), ranks);
+    if (it == groups.end()) {
+      groups.push_back(ranks);
+      shared_vertices.emplace_back();
+      shared_edges.emplace_back();
+      shared_faces.emplace_back();
+      return groups.size() - 1;
+    }
+    return static_cast<std::size_t>(it - groups.begin());
+  };
+
+  // every entity that starts at vertex v and spans the directions in the mask
+  auto for_each_entity = [&](const std::array<bool, 3>& spans, auto&& f) {
+    for (int k = lo[2]; k <= hi[2] - spans[2]; k++) {
+      for (int j = lo[1]; j <= hi[1] - spans[1]; j++) {
+        for (int i = lo[0]; i <= hi[0] - spans[0]; i++) {
+          f(std::array<int, 3>{i, j, k});
+        }
+      }
+    }
+  };
+
+  auto offset = [](std::array<int, 3> v, int d, int amount = 1) {
+    v[static_cast<std::size_t>(d)] += amount;
+    return v;
+  };
+  auto local = [&](const std::array<int, 3>& v) { return vertex(v[0], v[1], v[2]); };
+
+  for_each_entity({false, false, false}, [&](const std::array<int, 3>& v) {
+    auto ranks = ranks_of(v, {false, false, false});
+    if (ranks.size() > 1) {
+      shared_vertices[group_of(ranks)].push_back(local(v));
+    }
+  });
+
+  for (int d = 0; d < dim; d++) {
+    std::array<bool, 3> spans{d == 0, d == 1, d == 2};
+    for_each_entity(spans, [&](const std::array<int, 3>& v) {
+      auto ranks = ranks_of(v, spans);
+      if (ranks.size() > 1) {
+        shared_edges[group_of(ranks)].push_back({local(v), local(offset(v, d))});
+      }
+    });
+  }
+
+  if (dim == 3) {
+    for (int d = 0; d < 3; d++) {
+      // the face normal to direction d
+      int                 a = (d + 1) % 3, b = (d + 2) % 3;
+      std::array<bool, 3> spans{d != 0, d != 1, d != 2};
+      for_each_entity(spans, [&](const std::array<int, 3>& v) {
+        auto ranks = ranks_of(v, spans);
+        if (ranks.size() > 1) {
+          shared_faces[group_of(ranks)].push_back(
+              {local(v), local(offset(v, a)), local(offset(offset(v, a), b)), local(offset(v, b))});
+        }
+      });
+    }
+  }
+
+  std::ostringstream stream;
+  stream.precision(16);
+
+  stream << "MFEM mesh v1.0\n\ndimension\n" << dim << "\n\nelements\n";
+  stream << (hi[0] - lo[0]) * (hi[1] - lo[1]) * (dim == 3 ? hi[2] - lo[2] : 1) << "\n";
+  for_each_entity({true, true, dim == 3}, [&](const std::array<int, 3>& v) {
+    auto [i, j, k] = v;
+    if (dim == 2) {
+      stream << "1 " << mfem::Geometry::SQUARE << " " << vertex(i, j, 0) << " " << vertex(i + 1, j, 0) << " "
+             << vertex(i + 1, j + 1, 0) << " " << vertex(i, j + 1, 0) << "\n";
+    } else {
+      stream << "1 " << mfem::Geometry::CUBE;
+      for (int kk : {k, k + 1}) {
+        stream << " " << vertex(i, j, kk) << " " << vertex(i + 1, j, kk) << " " << vertex(i + 1, j + 1, kk) << " "
+               << vertex(i, j + 1, kk);
+      }
+      stream << "\n";
+    }
+  });
+
+  // the boundary elements, with the attributes and orientations of mfem::Mesh::MakeCartesian2D/3D
+  std::ostringstream boundary;
+  int                num_boundary = 0;
+  auto               add_boundary = [&](int attribute, std::initializer_list<int> vertices) {
+    boundary << attribute << " " << (dim == 2 ? mfem::Geometry::SEGMENT : mfem::Geometry::SQUARE);
+    for (int v : vertices) {
+      boundary << " " << v;
+    }
+    boundary << "\n";
+    num_boundary++;
+  };
+
+  const int nx = elements[0], ny = elements[1], nz = elements[2];
+  if (dim == 2) {
+    for (int i = lo[0]; i < hi[0]; i++) {
+      if (lo[1] == 0) {
+        add_boundary(1, {vertex(i, 0, 0), vertex(i + 1, 0, 0)});
+      }
+      if (hi[1] == ny) {
+        add_boundary(3, {vertex(i + 1, ny, 0), vertex(i, ny, 0)});
+      }
+    }
+    for (int j = lo[1]; j < hi[1]; j++) {
+      if (hi[0] == nx) {
+        add_boundary(2, {vertex(nx, j, 0), vertex(nx, j + 1, 0)});
+      }
+      if (lo[0] == 0) {
+        add_boundary(4, {vertex(0, j + 1, 0), vertex(0, j, 0)});
+      }
+    }
+  } else {
+    for (int j = lo[1]; j < hi[1]; j++) {
+      for (int i = lo[0]; i < hi[0]; i++) {
+        if (lo[2] == 0) {
+          add_boundary(1, {vertex(i, j, 0), vertex(i, j + 1, 0), vertex(i + 1, j + 1, 0), vertex(i + 1, j, 0)});
+        }
+        if (hi[2] == nz) {
+          add_boundary(6, {vertex(i, j, nz), vertex(i + 1, j, nz), vertex(i + 1, j + 1, nz), vertex(i, j + 1, nz)});
+        }
+      }
+    }
+    for (int k = lo[2]; k < hi[2]; k++) {
+      for (int i = lo[0]; i < hi[0]; i++) {
+        if (lo[1] == 0) {
+          add_boundary(2, {vertex(i, 0, k), vertex(i + 1, 0, k), vertex(i + 1, 0, k + 1), vertex(i, 0, k + 1)});
+        }
+        if (hi[1] == ny) {
+          add_boundary(4, {vertex(i, ny, k), vertex(i, ny, k + 1), vertex(i + 1, ny, k + 1), vertex(i + 1, ny, k)});
+        }
+      }
+      for (int j = lo[1]; j < hi[1]; j++) {
+        if (hi[0] == nx) {
+          add_boundary(3, {vertex(nx, j, k), vertex(nx, j + 1, k), vertex(nx, j + 1, k + 1), vertex(nx, j, k + 1)});
+        }
+        if (lo[0] == 0) {
+          add_boundary(5, {vertex(0, j, k), vertex(0, j, k + 1), vertex(0, j + 1, k + 1), vertex(0, j + 1, k)});
+        }
+      }
+    }
+  }
+  stream << "\nboundary\n" << num_boundary << "\n" << boundary.str();
+
+  stream << "\nvertices\n" << nodes[0] * nodes[1] * nodes[2] << "\n" << dim << "\n";
+  for_each_entity({false, false, false}, [&](const std::array<int, 3>& v) {
+    for (int d = 0; d < dim; d++) {
+      stream << (d > 0 ? " " : "") << v[static_cast<std::size_t>(d)] * size[static_cast<std::size_t>(d)] /
+                                          elements[static_cast<std::size_t>(d)];
+    }
+    stream << "\n";
+  });
+
+  stream << "\nmfem_serial_mesh_end\n\ncommunication_groups\nnumber_of_groups " << groups.size() << "\n\n";
+  stream << "# number of entities in each group, followed by group ids in group\n";
+  for (const auto& group : groups) {
+    stream << group.size();
+    for (int r : group) {
+      stream << " " << r;
+    }
+    stream << "\n";
+  }
+
+  std::size_t total_vertices = 0, total_edges = 0, total_faces = 0;
+  for (std::size_t g = 0; g < groups.size(); g++) {
+    total_vertices += shared_vertices[g].size();
+    total_edges += shared_edges[g].size();
+    total_faces += shared_faces[g].size();
+  }
+  stream << "\ntotal_shared_vertices " << total_vertices << "\ntotal_shared_edges " << total_edges << "\n";
+  if (dim == 3) {
+    stream << "total_shared_faces " << total_faces << "\n";
+  }
+
+  for (std::size_t g = 1; g < groups.size(); g++) {
+    stream << "\n#group " << g << "\nshared_vertices " << shared_vertices[g].size() << "\n";
+    for (int v : shared_vertices[g]) {
+      stream << v << "\n";
+    }
+    stream << "shared_edges " << shared_edges[g].size() << "\n";
+    for (const auto& e : shared_edges[g]) {
+      stream << e[0] << " " << e[1] << "\n";
+    }
+    if (dim == 3) {
+      stream << "shared_faces " << shared_faces[g].size() << "\n";
+      for (const auto& f : shared_faces[g]) {
+        stream << mfem::Geometry::SQUARE << " " << f[0] << " " << f[1] << " " << f[2] << " " << f[3] << "\n";
+      }
+    }
+  }
+  stream << "\nmfem_mesh_end\n";
+
+  return stream.str();
+}
+
+std::unique_ptr<mfem::ParMesh> buildParallelMeshFromRoot(const std::string& mesh_file, const int refine_serial,
+                                                         const int refine_parallel, const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  // rank 0 serializes every partition in the format read by the mfem::ParMesh stream constructor
+  std::string partition;
+  if (rank == 0) {
+    mfem::Mesh serial_mesh = buildMeshFromFile(mesh_file);
+    for (int lev = 0; lev < refine_serial; lev++) {
+      serial_mesh.UniformRefinement();
+    }
+
+    mfem::MeshPartitioner partitioner(serial_mesh, num_procs);
+    for (int part = num_procs - 1; part >= 0; part--) {
+      mfem::MeshPart mesh_part;
+      partitioner.ExtractPart(part, mesh_part);
+      std::ostringstream stream;
+      mesh_part.Print(stream);
+      partition = stream.str();
+
+      if (part > 0) {
+        SLIC_ERROR_IF(partition.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                      "Mesh partition is too large to send");
+        int size = static_cast<int>(partition.size());
+        MPI_Send(&size, 1, MPI_INT, part, 0, comm);
+        MPI_Send(partition.data(), size, MPI_CHAR, part, 1, comm);
+      }
+    }
+  } else {
+    int size = 0;
+    MPI_Recv(&size, 1, MPI_INT, 0, 0, comm, MPI_STATUS_IGNORE);
+    partition.resize(static_cast<std::size_t>(size));
+    MPI_Recv(partition.data(), size, MPI_CHAR, 0, 1, comm, MPI_STATUS_IGNORE);
+  }
+
+  std::istringstream stream(partition);
+  partition.clear();
+  partition.shrink_to_fit();
+  return finalizeParallelMesh(std::make_unique<mfem::ParMesh>(comm, stream), refine_parallel);
+}
+
+std::unique_ptr<mfem::ParMesh> buildPartitionedMesh(const std::string& mesh_prefix, const int refine_parallel,
+                                                    const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  std::string partition_file = mfem::MakeParFilename(mesh_prefix + ".", rank, "", 6);
+  SLIC_INFO_ROOT(axom::fmt::format("Opening {} mesh partitions: '{}'", num_procs, partition_file));
+
+  std::ifstream stream(partition_file);
+  SLIC_ERROR_IF(!stream, axom::fmt::format("Can not open mesh partition file: '{0}'", partition_file));
+
+  // rank r reads partition r, so fail if there are partitions left over as well
+  if (rank == 0) {
+    std::string extra_partition = mfem::MakeParFilename(mesh_prefix + ".", num_procs, "", 6);
+    SLIC_ERROR_IF(axom::utilities::filesystem::pathExists(extra_partition),
+                  axom::fmt::format("Mesh '{}' has more partitions than the {} ranks reading it", mesh_prefix,
+                                    num_procs));
+  }
+
+  return finalizeParallelMesh(std::make_unique<mfem::ParMesh>(comm, stream), refine_parallel);
+}
+
+void writePartitionedMesh(const mfem::ParMesh& mesh, const std::string& mesh_prefix)
+{
+  std::string   partition_file = mfem::MakeParFilename(mesh_prefix + ".", mesh.GetMyRank(), "", 6);
+  std::ofstream stream(partition_file);
+  SLIC_ERROR_IF(!stream, axom::fmt::format("Can not open mesh partition file: '{0}'", partition_file));
+  stream.precision(16);
+  mesh.ParPrint(stream);
+}
+
+namespace {
+
+/// @brief the 64-bit FNV-1a hash of the contents of a file
+std::uint64_t hashFile(const std::string& filename)
+{
+  std::ifstream stream(filename, std::ios::binary);
+  SLIC_ERROR_IF(!stream, axom::fmt::format("Can not open mesh file: '{0}'", filename));
+
+  std::uint64_t     hash = 14695981039346656037ull;
+  std::vector<char> buffer(1 << 20);
+  while (stream) {
+    stream.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    for (std::streamsize i = 0; i < stream.gcount(); i++) {
+      hash = (hash ^ static_cast<unsigned char>(buffer[static_cast<std::size_t>(i)])) * 1099511628211ull;
+    }
+  }
+  return hash;
+}
+
+}  // namespace
+
+std::unique_ptr<mfem::ParMesh> buildCachedParallelMesh(const std::string& mesh_file, const std::string& cache_directory,
+                                                       const int refine_serial, const int refine_parallel,
+                                                       const ParallelRead parallel_read, const MPI_Comm comm)
+{
+  SLIC_ERROR_ROOT_IF(parallel_read == ParallelRead::Partitioned, "Partitioned meshes are already cached");
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  // only rank 0 reads the file to hash it, and checks whether the last partition (written last) is complete
+  std::uint64_t hash = rank == 0 ? hashFile(mesh_file) : 0;
+  MPI_Bcast(&hash, 1, MPI_UINT64_T, 0, comm);
+
+  std::string stem   = mesh_file.substr(mesh_file.find_last_of('/') + 1);
+  std::string prefix = axom::utilities::filesystem::joinPath(
+      cache_directory, axom::fmt::format("{}.{:016x}.np{}.rs{}.rp{}", stem, hash, num_procs, refine_serial,
+                                         refine_parallel));
+  std::string complete_file = prefix + ".complete";
+
+  int cached = rank == 0 && axom::utilities::filesystem::pathExists(complete_file);
+  MPI_Bcast(&cached, 1, MPI_INT, 0, comm);
+  if (cached) {
+    SLIC_INFO_ROOT(axom::fmt::format("Reading cached mesh partitions of '{}'", mesh_file));
+    return buildPartitionedMesh(prefix, 0, comm);
+  }
+
+  std::unique_ptr<mfem::ParMesh> mesh;
+  if (parallel_read == ParallelRead::RootScatter) {
+    mesh = buildParallelMeshFromRoot(mesh_file, refine_serial, refine_parallel, comm);
+  } else {
+    mesh = refineAndDistribute(buildMeshFromFile(mesh_file), refine_serial, refine_parallel, comm);
+  }
+
+  if (rank == 0) {
+    axom::utilities::filesystem::makeDirsForPath(cache_directory);
+  }
+  MPI_Barrier(comm);
+  writePartitionedMesh(*mesh, prefix);
+
+  // the cache is only used once every partition has been written, so an interrupted run doesn't leave a broken one
+  MPI_Barrier(comm);
+  if (rank == 0) {
+    std::ofstream complete(complete_file);
+    SLIC_ERROR_IF(!complete, axom::fmt::format("Can not write mesh cache file: '{0}'", complete_file));
+  }
+  SLIC_INFO_ROOT(axom::fmt::format("Cached the mesh partitions of '{}' in '{}'", mesh_file, cache_directory));
+
+  return mesh;
+}
+
+std::unique_ptr<mfem::ParMesh> buildDistributedRectangleMesh(int elements_in_x, int elements_in_y, double size_x,
+                                                             double size_y, const int refine_parallel,
+                                                             const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  std::istringstream stream(
+      cartesianMeshPartition({elements_in_x, elements_in_y, 0}, {size_x, size_y, 0.0}, 2, num_procs, rank));
+  return finalizeParallelMesh(std::make_unique<mfem::ParMesh>(comm, stream), refine_parallel);
+}
+
+std::unique_ptr<mfem::ParMesh> buildDistributedCuboidMesh(int elements_in_x, int elements_in_y, int elements_in_z,
+                                                          double size_x, double size_y, double size_z,
+                                                          const int refine_parallel, const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  std::istringstream stream(cartesianMeshPartition({elements_in_x, elements_in_y, elements_in_z},
+                                                   {size_x, size_y, size_z}, 3, num_procs, rank));
+  return finalizeParallelMesh(std::make_unique<mfem::ParMesh>(comm, stream), refine_parallel);
+}
+
+std::vector<int> weightedPartitioning(mfem::Mesh& serial_mesh, const int num_parts,
+                                      const mfem::Vector& element_weights)
+{
+  const int num_elements = serial_mesh.GetNE();
+  SLIC_ERROR_ROOT_IF(element_weights.Size() != num_elements,
+                     axom::fmt::format("Expected {} element weights, got {}", num_elements, element_weights.Size()));
+  SLIC_ERROR_ROOT_IF(num_parts < 1, "The number of parts must be positive");
+
+  const double* weights = element_weights.HostRead();
+  double        total   = 0.0;
+  for (int e = 0; e < num_elements; e++) {
+    SLIC_ERROR_ROOT_IF(!(weights[e] > 0.0), "Element weights must be positive");
+    total += weights[e];
+  }
+
+  // ordering[e] is the position of element e along the curve
+  mfem::Array<int> ordering;
+  serial_mesh.GetHilbertElementOrdering(ordering);
+  std::vector<int> curve(static_cast<std::size_t>(num_elements));
+  for (int e = 0; e < num_elements; e++) {
+    curve[static_cast<std::size_t>(ordering[e])] = e;
+  }
+
+  // each element goes to the part containing the middle of its weight along the curve
+  std::vector<int> partitioning(static_cast<std::size_t>(num_elements));
+  double           preceding = 0.0;
+  for (int e : curve) {
+    int part = static_cast<int>((preceding + 0.5 * weights[e]) / total * num_parts);
+    partitioning[static_cast<std::size_t>(e)] = std::min(part, num_parts - 1);
+    preceding += weights[e];
+  }
+
+  return partitioning;
+}
+
+std::unique_ptr<mfem::ParMesh> distributeWithWeights(mfem::Mesh&& serial_mesh, const mfem::Vector& element_weights,
+                                                     const int refine_parallel, const MPI_Comm comm)
+{
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  auto partitioning = weightedPartitioning(serial_mesh, num_procs, element_weights);
+  return finalizeParallelMesh(std::make_unique<mfem::ParMesh>(comm, serial_mesh, partitioning.data()),
+                              refine_parallel);
+}
+
+std::pair<std::unique_ptr<mfem::ParMesh>, Redistribution> rebalance(const mfem::ParMesh& mesh,
+                                                                    const mfem::Vector&  element_costs)
+{
+  MPI_Comm comm          = mesh.GetComm();
+  auto [num_procs, rank] = getMPIInfo(comm);
+
+  SLIC_ERROR_IF(element_costs.Size() != mesh.GetNE(),
+                axom::fmt::format("Expected {} element costs, got {}", mesh.GetNE(), element_costs.Size()));
+
+  // every rank needs the same serial mesh to construct its partition of the rebalanced mesh
+  std::string serialized;
+  {
+    mfem::Mesh gathered = mesh.GetSerialMesh(0);
+    if (rank == 0) {
+      std::ostringstream stream;
+      stream.precision(std::numeric_limits<double>::max_digits10);
+      gathered.Print(stream);
+      serialized = stream.str();
+    }
+  }
+
+  SLIC_ERROR_IF(serialized.size() > static_cast<std::size_t>(std::numeric_limits<int>::max()),
+                "Mesh is too large to broadcast");
+  int size = static_cast<int>(serialized.size());
+  MPI_Bcast(&size, 1, MPI_INT, 0, comm);
+  serialized.resize(static_cast<std::size_t>(size));
+  MPI_Bcast(serialized.data(), size, MPI_CHAR, 0, comm);
+
+  Redistribution redistribution;
+  {
+    // the elements are read exactly as they were printed, so that fields can be gathered onto this mesh
+    constexpr int      generate_edges  = 1;
+    constexpr int      refine          = 0;
+    constexpr bool     fix_orientation = false;
+    std::istringstream stream(serialized);
+    redistribution.serial_mesh = std::make_unique<mfem::Mesh>(stream, generate_edges, refine, fix_orientation);
+  }
+  serialized.clear();
+  serialized.shrink_to_fit();
+
+  // the serial mesh holds the elements of each rank in turn
+  std::vector<int> counts(static_cast<std::size_t>(num_procs));
+  int              local_count = mesh.GetNE();
+  MPI_Allgather(&local_count, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+
+  std::vector<int> offsets(static_cast<std::size_t>(num_procs), 0);
+  for (std::size_t p = 1; p < counts.size(); p++) {
+    offsets[p] = offsets[p - 1] + counts[p - 1];
+  }
+
+  const int num_elements = redistribution.serial_mesh->GetNE();
+  SLIC_ERROR_IF(offsets.back() + counts.back() != num_elements, "Gathered mesh does not match the parallel mesh");
+
+  redistribution.previous_ranks.resize(static_cast<std::size_t>(num_elements));
+  for (int p = 0; p < num_procs; p++) {
+    auto begin = redistribution.previous_ranks.begin() + offsets[static_cast<std::size_t>(p)];
+    std::fill(begin, begin + counts[static_cast<std::size_t>(p)], p);
+  }
+
+  mfem::Vector costs(num_elements);
+  MPI_Allgatherv(element_costs.HostRead(), local_count, MPI_DOUBLE, costs.HostWrite(), counts.data(), offsets.data(),
+                 MPI_DOUBLE, comm);
+
+  redistribution.ranks = weightedPartitioning(*redistribution.serial_mesh, num_procs, costs);
+
+  auto rebalanced = finalizeParallelMesh(
+      std::make_unique<mfem::ParMesh>(comm, *redistribution.serial_mesh, redistribution.ranks.data()), 0);
+
+  return {std::move(rebalanced), std::move(redistribution)};
+}
+
+std::unique_ptr<mfem::ParGridFunction> redistributeField(const mfem::ParGridFunction& field, mfem::ParMesh& mesh,
+                                                         const Redistribution& redistribution)
+{
+  const mfem::ParFiniteElementSpace& space = *field.ParFESpace();
+  MPI_Comm                           comm  = space.GetComm();
+  auto [num_procs, rank]                   = getMPIInfo(comm);
+
+  mfem::FiniteElementSpace serial_space(redistribution.serial_mesh.get(), space.FEColl(), space.GetVDim(),
+                                        space.GetOrdering());
+  mfem::GridFunction       serial_field(&serial_space);
+
+  // the field is gathered onto rank 0, then shared with every rank to extract its new partition
+  auto gathered = field.GetSerialGridFunction(0, serial_space);
+  if (rank == 0) {
+    serial_field = *gathered;
+  }
+  MPI_Bcast(serial_field.HostReadWrite(), serial_field.Size(), MPI_DOUBLE, 0, comm);
+
+  return std::make_unique<mfem::ParGridFunction>(&mesh, &serial_field, redistribution.ranks.data());
+}
+
+namespace {
+
+/// copies fields onto an identical copy of their mesh, so that they are interpolated when the copy is adapted
+std::vector<std::unique_ptr<mfem::ParGridFunction>> copyFields(
+    const std::vector<const mfem::ParGridFunction*>& fields, mfem::ParMesh& mesh)
+{
+  std::vector<std::unique_ptr<mfem::ParGridFunction>> copies;
+  for (auto* field : fields) {
+    const mfem::ParFiniteElementSpace& space = *field->ParFESpace();
+
+    auto* fec  = mfem::FiniteElementCollection::New(space.FEColl()->Name());
+    auto  copy = std::make_unique<mfem::ParGridFunction>(
+        new mfem::ParFiniteElementSpace(&mesh, fec, space.GetVDim(), space.GetOrdering()));
+    copy->MakeOwner(fec);
+    *copy = *field;
+    copies.push_back(std::move(copy));
+  }
+  return copies;
+}
+
+void updateFields(std::vector<std::unique_ptr<mfem::ParGridFunction>>& fields)
+{
+  for (auto& field : fields) {
+    field->ParFESpace()->Update();
+    field->Update();
+    field->ParFESpace()->UpdatesFinished();
+  }
+}
+
+/// the reference coordinates of the vertices of an element, one column per vertex
+mfem::DenseMatrix referenceVertices(mfem::Geometry::Type geom)
+{
+  const mfem::IntegrationRule* vertices = mfem::Geometries.GetVertices(geom);
+  const int                    dim      = mfem::Geometry::Dimension[geom];
+
+  mfem::DenseMatrix coordinates(dim, vertices->GetNPoints());
+  for (int v = 0; v < vertices->GetNPoints(); v++) {
+    vertices->IntPoint(v).Get(coordinates.GetColumn(v), dim);
+  }
+  return coordinates;
+}
+
+}  // namespace
+
+Adaptation refine(const mfem::ParMesh& mesh, const mfem::Vector& element_errors, double threshold,
+                  const std::vector<const mfem::ParGridFunction*>& fields, int nc_limit)
+{
+  SLIC_ERROR_IF(element_errors.Size() != mesh.GetNE(),
+                axom::fmt::format("Expected {} element errors, got {}", mesh.GetNE(), element_errors.Size()));
+
+  // mfem::Mesh::MeshGenerator() flags meshes with quadrilaterals or hexahedra with the second bit
+  SLIC_ERROR_ROOT_IF(!mesh.Nonconforming() && (mesh.MeshGenerator() & 2),
+                     "Meshes of quadrilaterals or hexahedra must be nonconforming to be refined, call "
+                     "mfem::Mesh::EnsureNCMesh() on the serial mesh before distributing it");
+
+  mfem::Array<int> marked;
+  const double*    errors = element_errors.HostRead();
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    if (errors[e] > threshold) {
+      marked.Append(e);
+    }
+  }
+
+  int num_marked = 0;
+  int local_size = marked.Size();
+  MPI_Allreduce(&local_size, &num_marked, 1, MPI_INT, MPI_SUM, mesh.GetComm());
+
+  // the index of each element among the previous elements of the same geometry
+  std::vector<int>                                geometry_ids(static_cast<std::size_t>(mesh.GetNE()));
+  std::array<int, mfem::Geometry::NUM_GEOMETRIES> counts{};
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    geometry_ids[static_cast<std::size_t>(e)] = counts[static_cast<std::size_t>(mesh.GetElementGeometry(e))]++;
+  }
+
+  Adaptation adaptation;
+  adaptation.mesh   = std::make_unique<mfem::ParMesh>(mesh);
+  adaptation.fields = copyFields(fields, *adaptation.mesh);
+
+  if (num_marked == 0) {
+    for (int e = 0; e < mesh.GetNE(); e++) {
+      adaptation.parents.push_back(geometry_ids[static_cast<std::size_t>(e)]);
+      adaptation.embeddings.push_back(referenceVertices(mesh.GetElementGeometry(e)));
+    }
+    return adaptation;
+  }
+
+  constexpr int automatic = -1;
+  adaptation.mesh->GeneralRefinement(marked, automatic, nc_limit);
+  updateFields(adaptation.fields);
+
+  const mfem::CoarseFineTransformations& transforms = adaptation.mesh->GetRefinementTransforms();
+  for (int e = 0; e < adaptation.mesh->GetNE(); e++) {
+    const auto& embedding = transforms.embeddings[e];
+    adaptation.parents.push_back(geometry_ids[static_cast<std::size_t>(embedding.parent)]);
+    adaptation.embeddings.push_back(
+        transforms.point_matrices[adaptation.mesh->GetElementGeometry(e)](static_cast<int>(embedding.matrix)));
+  }
+
+  return adaptation;
+}
+
+Adaptation derefine(const mfem::ParMesh& mesh, const mfem::Vector& element_errors, double threshold,
+                    const std::vector<const mfem::ParGridFunction*>& fields, int nc_limit)
+{
+  SLIC_ERROR_IF(element_errors.Size() != mesh.GetNE(),
+                axom::fmt::format("Expected {} element errors, got {}", mesh.GetNE(), element_errors.Size()));
+  SLIC_ERROR_ROOT_IF(!mesh.Nonconforming(), "Only nonconforming meshes can be derefined");
+
+  Adaptation adaptation;
+  adaptation.mesh   = std::make_unique<mfem::ParMesh>(mesh);
+  adaptation.fields = copyFields(fields, *adaptation.mesh);
+
+  // the errors of sibling elements are summed
+  constexpr int sum = 1;
+  if (adaptation.mesh->DerefineByError(element_errors, threshold, nc_limit, sum)) {
+    updateFields(adaptation.fields);
+  }
+
+  return adaptation;
 }
 
 }  // namespace mesh
@@ -501,7 +1410,9 @@ serac::mesh::InputOptions FromInlet<serac::mesh::InputOptions>::operator()(const
       overall_size = std::vector<double>(elements.size(), 1.);
     }
 
-    return {serac::mesh::BoxInputOptions{elements, overall_size}, ser_ref, par_ref};
+    bool distributed = base["distributed"];
+
+    return {serac::mesh::BoxInputOptions{elements, overall_size, distributed}, ser_ref, par_ref};
   } else if (mesh_type == "disk" || mesh_type == "ball") {
     int approx_elements = base["approx_elements"];
     int dim             = 3;
@@ -510,8 +1421,19 @@ serac::mesh::InputOptions FromInlet<serac::mesh::InputOptions>::operator()(const
     }
     return {serac::mesh::NBallInputOptions{approx_elements, dim}, ser_ref, par_ref};
   } else if (mesh_type == "file") {  // This is for file-based meshes
-    std::string mesh_path = base["mesh"];
-    return {serac::mesh::FileInputOptions{mesh_path}, ser_ref, par_ref};
+    std::string mesh_path     = base["mesh"];
+    std::string parallel_read = base["parallel_read"];
+
+    serac::mesh::FileInputOptions file_options{mesh_path};
+    if (parallel_read == "root_scatter") {
+      file_options.parallel_read = serac::mesh::ParallelRead::RootScatter;
+    } else if (parallel_read == "partitioned") {
+      file_options.parallel_read = serac::mesh::ParallelRead::Partitioned;
+    }
+    if (base.contains("cache_directory")) {
+      file_options.cache_directory = base["cache_directory"].get<std::string>();
+    }
+    return {file_options, ser_ref, par_ref};
   }
 
   // If it reaches here, we haven't found a supported type
@@ -14,7 +14,9 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <variant>
+#include <vector>
 #include "mfem.hpp"
 
 #include "serac/infrastructure/input.hpp"
@@ -143,6 +145,16 @@ mfem::Mesh buildRingMesh(int radial_refinement, double inner_radius, double oute
  */
 namespace mesh {
 
+/**
+ * @brief How the ranks read a mesh file into a parallel mesh
+ */
+enum class ParallelRead
+{
+  AllRanks,     ///< Every rank reads the whole serial mesh, then keeps its partition
+  RootScatter,  ///< Only rank 0 reads and partitions the serial mesh, then sends each rank its partition
+  Partitioned   ///< Every rank reads its own partition from a pre-partitioned mesh, see writePartitionedMesh()
+};
+
 /**
  * @brief Input options for meshes read from files
  *
@@ -164,6 +176,19 @@ struct FileInputOptions {
    * @brief The absolute path for the mesh file, intended to be populated by the user directly
    */
   mutable std::string absolute_mesh_file_name{};
+
+  /**
+   * @brief How the ranks read the mesh file
+   *
+   * @note For ParallelRead::Partitioned, the file names are the prefix of the per-rank partition files
+   */
+  ParallelRead parallel_read = ParallelRead::AllRanks;
+
+  /**
+   * @brief The directory where the refined partitions of the mesh are cached for later runs, or empty for no cache,
+   * see buildCachedParallelMesh()
+   */
+  std::string cache_directory{};
 };
 
 /**
@@ -189,6 +214,11 @@ struct BoxInputOptions {
    *
    */
   std::vector<double> overall_size;
+
+  /**
+   * @brief Whether every rank generates only its own block of the box, see buildDistributedCuboidMesh()
+   */
+  bool distributed = false;
 };
 
 /**
@@ -207,6 +237,40 @@ struct NBallInputOptions {
   int dimension;
 };
 
+/**
+ * @brief Renumbers the elements (and vertices) of a serial mesh so that they follow a Hilbert space-filling curve
+ *
+ * Meshes exported from CAD tools often have essentially random element orderings, so successive elements
+ * touch dofs that are far apart in memory. After this renumbering, neighboring elements (and the dofs
+ * that finite element spaces number from their vertices) are close together, which improves cache reuse
+ * in element gather/scatter operations and element kernels. Partitioning the reordered mesh with
+ * refineAndDistribute() preserves this locality on each rank.
+ *
+ * @param[in] serial_mesh The serial mesh to reorder (after any serial refinement)
+ *
+ * @return The reordered mesh
+ */
+mfem::Mesh reorderAlongHilbertCurve(mfem::Mesh&& serial_mesh);
+
+/**
+ * @brief Renumbers the elements (and vertices) of a serial mesh in reverse Cuthill-McKee order
+ *
+ * The elements are numbered breadth-first through their face neighbors, starting from a pseudo-peripheral element,
+ * and the vertices in the order they are first used by the renumbered elements. This keeps the dofs coupled by each
+ * element close together, so the assembled matrices have a small bandwidth, which speeds up their products and
+ * (especially) incomplete factorizations like Preconditioner::HypreILU. reorderAlongHilbertCurve() gives similar
+ * locality in the element kernels, but not a banded matrix.
+ *
+ * @param[in] serial_mesh The serial mesh to reorder (after any serial refinement)
+ *
+ * @return The reordered mesh
+ *
+ * @note mfem numbers the dofs of a space from the mesh entities, so this is how the local dof numbering (and the
+ * ElementRestriction and prolongation that follow it) is changed. Partitioning the reordered mesh with
+ * refineAndDistribute() keeps the relative order of the elements and vertices on each rank.
+ */
+mfem::Mesh reorderByReverseCuthillMcKee(mfem::Mesh&& serial_mesh);
+
 /**
  * @brief Finalizes a serial mesh into a refined parallel mesh
  *
@@ -223,6 +287,278 @@ struct NBallInputOptions {
 std::unique_ptr<mfem::ParMesh> refineAndDistribute(mfem::Mesh&& serial_mesh, const int refine_serial = 0,
                                                    const int refine_parallel = 0, const MPI_Comm comm = MPI_COMM_WORLD);
 
+/**
+ * @brief Finalizes a serial mesh into a hierarchy of uniformly refined parallel meshes
+ *
+ * Every level is a refinement of a copy of the previous one, so the refinement transforms between consecutive
+ * levels are available (e.g. for the transfer operators of geometric multigrid). The finest level is the mesh that
+ * refineAndDistribute() would construct with the same arguments.
+ *
+ * @param[in] serial_mesh The "base" serial mesh
+ * @param[in] refine_serial The number of serial refinements, applied before the coarsest level is distributed
+ * @param[in] refine_parallel The number of parallel refinements, i.e. the number of levels minus one
+ * @param[in] comm The MPI communicator
+ *
+ * @return The meshes of every level, coarsest first
+ */
+std::vector<std::unique_ptr<mfem::ParMesh>> refineAndDistributeHierarchy(mfem::Mesh&& serial_mesh,
+                                                                         const int refine_serial = 0,
+                                                                         const int refine_parallel = 0,
+                                                                         const MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Constructs a parallel mesh from a file that is only read on rank 0
+ *
+ * Rank 0 reads, refines and partitions the serial mesh, then sends every other rank only its own partition, so that
+ * the other ranks never hold the serial mesh. This gives the same partitioning as refineAndDistribute().
+ *
+ * @param[in] mesh_file The mesh file to open on rank 0
+ * @param[in] refine_serial The number of serial refinements
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator
+ *
+ * @return A unique_ptr containing the constructed mesh
+ */
+std::unique_ptr<mfem::ParMesh> buildParallelMeshFromRoot(const std::string& mesh_file, const int refine_serial = 0,
+                                                         const int     refine_parallel = 0,
+                                                         const MPI_Comm comm           = MPI_COMM_WORLD);
+
+/**
+ * @brief Constructs a parallel mesh from per-rank partition files, without any serial mesh
+ *
+ * Rank r reads the mfem parallel mesh file `<mesh_prefix>.<r>`, with the rank zero-padded to six digits, as written by
+ * writePartitionedMesh() or mfem::ParMesh::ParPrint(). The number of ranks must match the number of partitions.
+ *
+ * @param[in] mesh_prefix The common prefix of the partition files
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator
+ *
+ * @return A unique_ptr containing the constructed mesh
+ */
+std::unique_ptr<mfem::ParMesh> buildPartitionedMesh(const std::string& mesh_prefix, const int refine_parallel = 0,
+                                                    const MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Writes the partition of a parallel mesh owned by each rank, to be read by buildPartitionedMesh()
+ *
+ * @param[in] mesh The parallel mesh
+ * @param[in] mesh_prefix The common prefix of the partition files
+ *
+ * @note This is a collective function.
+ */
+void writePartitionedMesh(const mfem::ParMesh& mesh, const std::string& mesh_prefix);
+
+/**
+ * @brief Constructs a parallel mesh from a file, reusing the refined partitions written by an earlier run
+ *
+ * The first run reads, refines and partitions the mesh file as @a parallel_read asks, then writes the partition of
+ * every rank to @a cache_directory (see writePartitionedMesh()). Later runs with the same file contents, number of
+ * ranks and refinement levels instead read those partitions directly, each rank parsing only its own, which skips
+ * the parsing of the whole serial mesh, its refinement and its partitioning.
+ *
+ * @param[in] mesh_file The mesh file
+ * @param[in] cache_directory The directory of the cached partitions, which is created if needed
+ * @param[in] refine_serial The number of serial refinements
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] parallel_read How the ranks read the mesh file when it isn't cached yet
+ * @param[in] comm The MPI communicator
+ *
+ * @return A unique_ptr containing the constructed mesh
+ *
+ * @note The cached partitions are named after the mesh file, a hash of its contents, the number of ranks and the
+ * refinement levels, so a modified mesh file is cached again rather than read stale
+ */
+std::unique_ptr<mfem::ParMesh> buildCachedParallelMesh(const std::string& mesh_file, const std::string& cache_directory,
+                                                       const int refine_serial = 0, const int refine_parallel = 0,
+                                                       const ParallelRead parallel_read = ParallelRead::AllRanks,
+                                                       const MPI_Comm     comm          = MPI_COMM_WORLD);
+
+/**
+ * @brief Constructs the same rectangle as buildRectangleMesh() as a parallel mesh, without any serial mesh
+ *
+ * The ranks are arranged in a Cartesian grid of blocks of elements, and every rank generates only its own block along
+ * with the entities it shares with the neighboring blocks. This avoids building and partitioning the whole serial mesh
+ * on every rank, so the memory and time of the setup no longer grow with the global mesh.
+ *
+ * @param[in] elements_in_x the number of elements in the x-direction
+ * @param[in] elements_in_y the number of elements in the y-direction
+ * @param[in] size_x Overall size in the x-direction
+ * @param[in] size_y Overall size in the y-direction
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator
+ *
+ * @return A unique_ptr containing the constructed mesh
+ *
+ * @note The number of elements in each direction must be at least the number of blocks of ranks in that direction
+ */
+std::unique_ptr<mfem::ParMesh> buildDistributedRectangleMesh(int elements_in_x, int elements_in_y, double size_x = 1.,
+                                                             double size_y = 1., const int refine_parallel = 0,
+                                                             const MPI_Comm comm = MPI_COMM_WORLD);
+
+/**
+ * @brief Constructs the same cuboid as buildCuboidMesh() as a parallel mesh, without any serial mesh
+ *
+ * @param[in] elements_in_x the number of elements in the x-direction
+ * @param[in] elements_in_y the number of elements in the y-direction
+ * @param[in] elements_in_z the number of elements in the z-direction
+ * @param[in] size_x Overall size in the x-direction
+ * @param[in] size_y Overall size in the y-direction
+ * @param[in] size_z Overall size in the z-direction
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator
+ *
+ * @return A unique_ptr containing the constructed mesh
+ *
+ * @see buildDistributedRectangleMesh()
+ */
+std::unique_ptr<mfem::ParMesh> buildDistributedCuboidMesh(int elements_in_x, int elements_in_y, int elements_in_z,
+                                                          double size_x = 1., double size_y = 1., double size_z = 1.,
+                                                          const int      refine_parallel = 0,
+                                                          const MPI_Comm comm            = MPI_COMM_WORLD);
+
+/**
+ * @brief Partitions the elements of a serial mesh into pieces of equal total weight
+ *
+ * The elements are ordered along a Hilbert space-filling curve, which is then cut into contiguous pieces, so
+ * each part is compact and neighboring parts share few faces.
+ *
+ * @param[in] serial_mesh The serial mesh to partition
+ * @param[in] num_parts The number of parts
+ * @param[in] element_weights The (positive) weight of each element, e.g. its computational cost
+ *
+ * @return The part of each element
+ */
+std::vector<int> weightedPartitioning(mfem::Mesh& serial_mesh, const int num_parts,
+                                      const mfem::Vector& element_weights);
+
+/**
+ * @brief Distributes a serial mesh so that the total element weight of each rank is about the same
+ *
+ * @param[in] serial_mesh The serial mesh
+ * @param[in] element_weights The (positive) weight of each element of the serial mesh
+ * @param[in] refine_parallel The number of parallel refinements
+ * @param[in] comm The MPI communicator
+ *
+ * @return A unique_ptr containing the constructed mesh
+ *
+ * @see weightedPartitioning()
+ */
+std::unique_ptr<mfem::ParMesh> distributeWithWeights(mfem::Mesh&& serial_mesh, const mfem::Vector& element_weights,
+                                                     const int      refine_parallel = 0,
+                                                     const MPI_Comm comm            = MPI_COMM_WORLD);
+
+/**
+ * @brief Describes how rebalance() moved the elements of a parallel mesh between the ranks
+ *
+ * The elements are numbered globally in the order of the gathered serial mesh: the elements of rank 0 in their
+ * local order, then those of rank 1, and so on.
+ */
+struct Redistribution {
+  /// The gathered serial mesh, which every rank holds
+  std::unique_ptr<mfem::Mesh> serial_mesh;
+
+  /// The rank that owned each element before the rebalance
+  std::vector<int> previous_ranks;
+
+  /// The rank that owns each element after the rebalance
+  std::vector<int> ranks;
+};
+
+/**
+ * @brief Repartitions a parallel mesh so that the total cost of the elements of each rank is about the same
+ *
+ * The mesh is gathered onto every rank and partitioned with weightedPartitioning(). Like ParallelRead::AllRanks,
+ * this briefly holds the whole serial mesh on every rank.
+ *
+ * @param[in] mesh The parallel mesh to rebalance
+ * @param[in] element_costs The cost of each local element, e.g. from Functional::elementCosts()
+ *
+ * @return The rebalanced mesh, and the redistribution used to move fields onto it with redistributeField()
+ *
+ * @note This is a collective function.
+ */
+std::pair<std::unique_ptr<mfem::ParMesh>, Redistribution> rebalance(const mfem::ParMesh& mesh,
+                                                                    const mfem::Vector&  element_costs);
+
+/**
+ * @brief Moves the values of a grid function onto a mesh returned by rebalance()
+ *
+ * @param[in] field The grid function on the mesh before the rebalance
+ * @param[in] mesh The rebalanced mesh
+ * @param[in] redistribution The redistribution returned by rebalance()
+ *
+ * @return The same field on the rebalanced mesh, which owns its finite element space
+ *
+ * @note This is a collective function.
+ */
+std::unique_ptr<mfem::ParGridFunction> redistributeField(const mfem::ParGridFunction& field, mfem::ParMesh& mesh,
+                                                         const Redistribution& redistribution);
+
+/**
+ * @brief The result of an adaptive refinement or derefinement of a parallel mesh
+ *
+ * Refinement keeps every element on its rank, so each element of the refined mesh lies inside one element of the
+ * previous mesh on the same rank.
+ */
+struct Adaptation {
+  /// The adapted mesh
+  std::unique_ptr<mfem::ParMesh> mesh;
+
+  /// The fields interpolated onto the adapted mesh, in the order they were given. Each owns its finite element space.
+  std::vector<std::unique_ptr<mfem::ParGridFunction>> fields;
+
+  /**
+   * For each element of a refined mesh, the index of the element of the previous mesh it lies in, counted among the
+   * elements of the same geometry. Empty after a derefinement.
+   */
+  std::vector<int> parents;
+
+  /**
+   * For each element of a refined mesh, the reference coordinates of its vertices within its parent element (one
+   * column per vertex). Empty after a derefinement.
+   */
+  std::vector<mfem::DenseMatrix> embeddings;
+};
+
+/**
+ * @brief Refines the elements of a parallel mesh whose error exceeds a threshold
+ *
+ * Hexahedral and quadrilateral meshes are refined nonconformingly, so they must already be nonconforming, i.e.
+ * mfem::Mesh::EnsureNCMesh() was called on the serial mesh before it was distributed. Simplex meshes that are
+ * not nonconforming are refined conformingly by bisection.
+ *
+ * @param[in] mesh The parallel mesh to refine, which is left unchanged
+ * @param[in] element_errors The error indicator of each local element, e.g. from mfem::KellyErrorEstimator
+ * @param[in] threshold The elements with a larger error are refined
+ * @param[in] fields The fields to interpolate onto the refined mesh
+ * @param[in] nc_limit The largest number of refinement levels between neighbouring elements, or 0 for no limit
+ *
+ * @return The refined mesh and fields, and where each refined element came from
+ *
+ * @note This is a collective function.
+ */
+Adaptation refine(const mfem::ParMesh& mesh, const mfem::Vector& element_errors, double threshold,
+                  const std::vector<const mfem::ParGridFunction*>& fields = {}, int nc_limit = 0);
+
+/**
+ * @brief Coarsens the groups of refined elements of a nonconforming parallel mesh whose error is below a threshold
+ *
+ * A group of sibling elements is replaced by its parent when the sum of their errors is below the threshold.
+ * mfem may move the coarsened elements between the ranks, so only fields are transferred.
+ *
+ * @param[in] mesh The nonconforming parallel mesh to coarsen, which is left unchanged
+ * @param[in] element_errors The error indicator of each local element
+ * @param[in] threshold The largest error of a coarsened group of elements
+ * @param[in] fields The fields to interpolate onto the coarsened mesh
+ * @param[in] nc_limit The largest number of refinement levels between neighbouring elements, or 0 for no limit
+ *
+ * @return The coarsened mesh and fields
+ *
+ * @note This is a collective function.
+ */
+Adaptation derefine(const mfem::ParMesh& mesh, const mfem::Vector& element_errors, double threshold,
+                    const std::vector<const mfem::ParGridFunction*>& fields = {}, int nc_limit = 0);
+
 }  // namespace mesh
 
 }  // namespace serac
@@ -4,7 +4,10 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <algorithm>
 #include <fstream>
+#include <numeric>
+#include <random>
 
 #include <gtest/gtest.h>
 #include "mfem.hpp"
@@ -23,6 +26,255 @@ TEST(Mesh, LoadExodus)
   MPI_Barrier(MPI_COMM_WORLD);
 }
 
+TEST(Mesh, ReorderAlongHilbertCurve)
+{
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/patch3D_tets_and_hexes.mesh";
+
+  auto original = buildMeshFromFile(mesh_file);
+  original.UniformRefinement();
+
+  auto reordered = mesh::reorderAlongHilbertCurve(mfem::Mesh(original));
+
+  // same mesh, different numbering
+  EXPECT_EQ(original.GetNE(), reordered.GetNE());
+  EXPECT_EQ(original.GetNV(), reordered.GetNV());
+  EXPECT_EQ(original.GetNBE(), reordered.GetNBE());
+
+  double original_volume  = 0.0;
+  double reordered_volume = 0.0;
+  for (int e = 0; e < original.GetNE(); e++) {
+    original_volume += original.GetElementVolume(e);
+    reordered_volume += reordered.GetElementVolume(e);
+  }
+  EXPECT_NEAR(original_volume, reordered_volume, 1.0e-12 * original_volume);
+
+  auto pmesh = mesh::refineAndDistribute(std::move(reordered));
+  EXPECT_GT(pmesh->GetNE(), 0);
+}
+
+// the largest difference between the vertex numbers of an element
+int vertexBandwidth(const mfem::Mesh& mesh)
+{
+  int              bandwidth = 0;
+  mfem::Array<int> vertices;
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    mesh.GetElementVertices(e, vertices);
+    bandwidth = std::max(bandwidth, vertices.Max() - vertices.Min());
+  }
+  return bandwidth;
+}
+
+TEST(Mesh, ReorderByReverseCuthillMcKee)
+{
+  auto shuffled = mfem::Mesh::MakeCartesian2D(20, 20, mfem::Element::QUADRILATERAL);
+
+  // start from a random numbering, like the ones of some mesh generators
+  std::vector<int> permutation(static_cast<size_t>(shuffled.GetNE()));
+  std::iota(permutation.begin(), permutation.end(), 0);
+  std::shuffle(permutation.begin(), permutation.end(), std::mt19937(1));
+  mfem::Array<int> ordering(permutation.data(), shuffled.GetNE());
+  shuffled.ReorderElements(ordering, true);
+
+  int shuffled_bandwidth = vertexBandwidth(shuffled);
+
+  auto reordered = mesh::reorderByReverseCuthillMcKee(mfem::Mesh(shuffled));
+  EXPECT_EQ(shuffled.GetNE(), reordered.GetNE());
+  EXPECT_EQ(shuffled.GetNV(), reordered.GetNV());
+  EXPECT_EQ(shuffled.GetNBE(), reordered.GetNBE());
+
+  // a 20 x 20 grid numbered along its diagonals has a bandwidth of about 2 * 21
+  EXPECT_LT(vertexBandwidth(reordered), 60);
+  EXPECT_LT(vertexBandwidth(reordered), shuffled_bandwidth / 4);
+
+  auto pmesh = mesh::refineAndDistribute(std::move(reordered));
+  EXPECT_GT(pmesh->GetNE(), 0);
+}
+
+TEST(Mesh, ParallelReadModes)
+{
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/patch3D_tets_and_hexes.mesh";
+
+  auto reference = mesh::refineAndDistribute(buildMeshFromFile(mesh_file), 1);
+
+  // only rank 0 reads the file
+  auto scattered = mesh::buildParallelMeshFromRoot(mesh_file, 1);
+  EXPECT_EQ(reference->GetGlobalNE(), scattered->GetGlobalNE());
+
+  // every rank reads its own partition
+  std::string prefix = "patch3D_partitioned";
+  mesh::writePartitionedMesh(*scattered, prefix);
+  MPI_Barrier(MPI_COMM_WORLD);
+  auto partitioned = mesh::buildPartitionedMesh(prefix);
+  EXPECT_EQ(scattered->GetNE(), partitioned->GetNE());
+  EXPECT_EQ(reference->GetGlobalNE(), partitioned->GetGlobalNE());
+
+  // through the input options
+  mesh::InputOptions options{mesh::FileInputOptions{mesh_file}, 1, 0};
+  std::get<mesh::FileInputOptions>(options.extra_options).absolute_mesh_file_name = mesh_file;
+  std::get<mesh::FileInputOptions>(options.extra_options).parallel_read            = mesh::ParallelRead::RootScatter;
+  EXPECT_EQ(reference->GetGlobalNE(), mesh::buildParallelMesh(options)->GetGlobalNE());
+}
+
+TEST(Mesh, CachedPartitions)
+{
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/patch3D_tets_and_hexes.mesh";
+
+  auto reference = mesh::refineAndDistribute(buildMeshFromFile(mesh_file), 1, 1);
+
+  // the first call caches the partitions (unless an earlier run did), and the second one reads them
+  auto first  = mesh::buildCachedParallelMesh(mesh_file, "mesh_cache", 1, 1);
+  auto second = mesh::buildCachedParallelMesh(mesh_file, "mesh_cache", 1, 1);
+  for (const auto* mesh : {first.get(), second.get()}) {
+    EXPECT_EQ(reference->GetNE(), mesh->GetNE());
+    EXPECT_EQ(reference->GetGlobalNE(), mesh->GetGlobalNE());
+    EXPECT_EQ(reference->GetNSharedFaces(), mesh->GetNSharedFaces());
+  }
+
+  double reference_volume = 0.0;
+  double cached_volume    = 0.0;
+  for (int e = 0; e < reference->GetNE(); e++) {
+    reference_volume += reference->GetElementVolume(e);
+    cached_volume += second->GetElementVolume(e);
+  }
+  EXPECT_NEAR(reference_volume, cached_volume, 1.0e-12 * reference_volume);
+}
+
+TEST(Mesh, DistributedBoxes)
+{
+  auto shared_dofs = [](mfem::ParMesh& pmesh) {
+    mfem::H1_FECollection       fec(2, pmesh.Dimension());
+    mfem::ParFiniteElementSpace space(&pmesh, &fec);
+    return space.GlobalTrueVSize();
+  };
+
+  auto boundary_area = [](mfem::ParMesh& pmesh, int attribute) {
+    double area = 0.0;
+    for (int be = 0; be < pmesh.GetNBE(); be++) {
+      if (pmesh.GetBdrAttribute(be) != attribute) {
+        continue;
+      }
+      auto*       T  = pmesh.GetBdrElementTransformation(be);
+      const auto& ir = mfem::IntRules.Get(T->GetGeometryType(), 1);
+      for (int q = 0; q < ir.GetNPoints(); q++) {
+        T->SetIntPoint(&ir.IntPoint(q));
+        area += ir.IntPoint(q).weight * T->Weight();
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &area, 1, MPI_DOUBLE, MPI_SUM, pmesh.GetComm());
+    return area;
+  };
+
+  auto rectangle   = mesh::refineAndDistribute(buildRectangleMesh(5, 3, 2.0, 1.0));
+  auto distributed = mesh::buildDistributedRectangleMesh(5, 3, 2.0, 1.0);
+  EXPECT_EQ(rectangle->GetGlobalNE(), distributed->GetGlobalNE());
+  EXPECT_EQ(shared_dofs(*rectangle), shared_dofs(*distributed));
+  for (int attribute = 1; attribute <= 4; attribute++) {
+    EXPECT_NEAR(boundary_area(*rectangle, attribute), boundary_area(*distributed, attribute), 1.0e-12);
+  }
+
+  auto cuboid = mesh::refineAndDistribute(buildCuboidMesh(4, 3, 2, 1.0, 2.0, 3.0), 1);
+  distributed = mesh::buildDistributedCuboidMesh(4, 3, 2, 1.0, 2.0, 3.0, 1);
+  EXPECT_EQ(cuboid->GetGlobalNE(), distributed->GetGlobalNE());
+  EXPECT_EQ(shared_dofs(*cuboid), shared_dofs(*distributed));
+  for (int attribute = 1; attribute <= 6; attribute++) {
+    EXPECT_NEAR(boundary_area(*cuboid, attribute), boundary_area(*distributed, attribute), 1.0e-12);
+  }
+
+  // through the input options, where serial refinement doubles the number of elements instead
+  mesh::InputOptions options{mesh::BoxInputOptions{{4, 3, 2}, {1.0, 2.0, 3.0}, true}, 1, 0};
+  EXPECT_EQ(cuboid->GetGlobalNE(), mesh::buildParallelMesh(options)->GetGlobalNE());
+}
+
+TEST(Mesh, WeightedRebalance)
+{
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/patch3D_tets_and_hexes.mesh";
+
+  auto serial_mesh = buildMeshFromFile(mesh_file);
+  serial_mesh.UniformRefinement();
+
+  // the first element is as expensive as all of the others together
+  mfem::Vector weights(serial_mesh.GetNE());
+  weights    = 1.0;
+  weights[0] = serial_mesh.GetNE() - 1.0;
+
+  auto partitioning = mesh::weightedPartitioning(serial_mesh, 2, weights);
+  int  alone        = 0;
+  for (int part : partitioning) {
+    alone += (part == partitioning[0]);
+  }
+  EXPECT_EQ(alone, 1);
+
+  auto pmesh = mesh::refineAndDistribute(std::move(serial_mesh));
+
+  // a smooth field survives the rebalance exactly
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+  mfem::ParGridFunction       field(&space);
+  mfem::FunctionCoefficient   quadratic([](const mfem::Vector& x) { return x(0) * x(0) + x(1) * x(2); });
+  field.ProjectCoefficient(quadratic);
+
+  // elements at the bottom of the patch are twice as expensive
+  mfem::Vector costs(pmesh->GetNE());
+  for (int e = 0; e < pmesh->GetNE(); e++) {
+    mfem::Vector center;
+    pmesh->GetElementCenter(e, center);
+    costs[e] = (center(2) < 0.5) ? 2.0 : 1.0;
+  }
+
+  auto [rebalanced, redistribution] = mesh::rebalance(*pmesh, costs);
+  EXPECT_EQ(rebalanced->GetGlobalNE(), pmesh->GetGlobalNE());
+
+  auto moved = mesh::redistributeField(field, *rebalanced, redistribution);
+  EXPECT_NEAR(moved->ComputeL2Error(quadratic), 0.0, 1.0e-10);
+}
+
+TEST(Mesh, AdaptiveRefinement)
+{
+  std::string mesh_file = std::string(SERAC_REPO_DIR) + "/data/meshes/beam-hex.mesh";
+
+  auto serial_mesh = buildMeshFromFile(mesh_file);
+  serial_mesh.EnsureNCMesh();
+  auto pmesh = mesh::refineAndDistribute(std::move(serial_mesh));
+
+  // a quadratic field survives refinement and derefinement exactly
+  mfem::H1_FECollection       fec(2, pmesh->Dimension());
+  mfem::ParFiniteElementSpace space(pmesh.get(), &fec);
+  mfem::ParGridFunction       field(&space);
+  mfem::FunctionCoefficient   quadratic([](const mfem::Vector& x) { return x(0) * x(0) + x(1) * x(2); });
+  field.ProjectCoefficient(quadratic);
+
+  // refine the elements close to the support
+  mfem::Vector errors(pmesh->GetNE());
+  for (int e = 0; e < pmesh->GetNE(); e++) {
+    mfem::Vector center;
+    pmesh->GetElementCenter(e, center);
+    errors[e] = (center(0) < 2.0) ? 1.0 : 0.0;
+  }
+
+  auto refinement = mesh::refine(*pmesh, errors, 0.5, {&field});
+  EXPECT_GT(refinement.mesh->GetGlobalNE(), pmesh->GetGlobalNE());
+  EXPECT_EQ(refinement.parents.size(), static_cast<std::size_t>(refinement.mesh->GetNE()));
+  EXPECT_NEAR(refinement.fields[0]->ComputeL2Error(quadratic), 0.0, 1.0e-10);
+
+  // the refined elements cover the same domain
+  double volume = 0.0;
+  for (int e = 0; e < refinement.mesh->GetNE(); e++) {
+    volume += refinement.mesh->GetElementVolume(e);
+  }
+  double previous_volume = 0.0;
+  for (int e = 0; e < pmesh->GetNE(); e++) {
+    previous_volume += pmesh->GetElementVolume(e);
+  }
+  EXPECT_NEAR(volume, previous_volume, 1.0e-12 * previous_volume);
+
+  // coarsen everything back
+  mfem::Vector no_errors(refinement.mesh->GetNE());
+  no_errors       = 0.0;
+  auto coarsening = mesh::derefine(*refinement.mesh, no_errors, 1.0, {refinement.fields[0].get()});
+  EXPECT_EQ(coarsening.mesh->GetGlobalNE(), pmesh->GetGlobalNE());
+  EXPECT_NEAR(coarsening.fields[0]->ComputeL2Error(quadratic), 0.0, 1.0e-10);
+}
+
 }  // namespace serac
 
 //------------------------------------------------------------------------------
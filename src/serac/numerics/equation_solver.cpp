@@ -6,38 +6,153 @@
 
 #include "serac/numerics/equation_solver.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
 #include <iomanip>
 #include <sstream>
 #include <ios>
 #include <iostream>
+#include <numeric>
 
 #include "serac/infrastructure/logger.hpp"
 #include "serac/infrastructure/terminator.hpp"
+#include "serac/numerics/fixed_point_acceleration.hpp"
+#include "serac/numerics/static_condensation.hpp"
 #include "serac/serac_config.hpp"
 #include "serac/infrastructure/profiling.hpp"
 
 namespace serac {
 
+/**
+ * @brief Chooses the relative tolerance ("forcing term") of each linear solve in an inexact Newton method, following
+ * S. C. Eisenstat and H. F. Walker, "Choosing the forcing terms in an inexact Newton method", SISC 17(1), 1996
+ */
+struct InexactNewtonTolerance {
+  /// the strategy used to update the forcing term
+  ForcingTerm strategy;
+  /// the tightest tolerance allowed
+  double eta_min;
+  /// the loosest tolerance allowed
+  double eta_max;
+  /// the tolerance for the next linear solve
+  double eta = eta_min;
+
+  /// whether the forcing terms change between iterations
+  bool adaptive() const { return strategy != ForcingTerm::Fixed; }
+
+  /// choose the tolerance of the first linear solve
+  void reset() { eta = adaptive() ? std::max(eta_min, std::min(eta_max, 0.5)) : eta_min; }
+
+  /**
+   * @brief choose the tolerance of the next linear solve, after a Newton step
+   *
+   * @param norm the residual norm after the step, ||F(x_{k+1})||
+   * @param norm_prev the residual norm before the step, ||F(x_k)||
+   * @param linear_model_norm the norm of the last linear solve's residual, ||F(x_k) + J(x_k) s_k|| (choice 1 only)
+   * @param norm_goal the residual norm that the nonlinear solve is trying to reach
+   */
+  void update(double norm, double norm_prev, double linear_model_norm, double norm_goal)
+  {
+    if (!adaptive() || norm_prev <= 0.0) return;
+
+    double next, safeguard;
+    if (strategy == ForcingTerm::EisenstatWalker1) {
+      constexpr double alpha = 1.618033988749895;  // (1 + sqrt(5)) / 2
+      next                   = std::abs(norm - linear_model_norm) / norm_prev;
+      safeguard              = std::pow(eta, alpha);
+    } else {
+      constexpr double gamma = 0.9;
+      constexpr double alpha = 2.0;
+      next                   = gamma * std::pow(norm / norm_prev, alpha);
+      safeguard              = gamma * std::pow(eta, alpha);
+    }
+
+    // don't let the tolerance drop too quickly, unless the previous one was already small
+    if (safeguard > 0.1) {
+      next = std::max(next, safeguard);
+    }
+
+    // and don't solve more accurately than needed to reach the nonlinear tolerance
+    if (norm > 0.0) {
+      next = std::max(next, 0.5 * norm_goal / norm);
+    }
+
+    eta = std::max(eta_min, std::min(eta_max, next));
+  }
+};
+
+/// Adds the wall time of its own lifetime, in seconds, to a running total
+struct WallTimer {
+  /// the total to add to
+  double& total;
+  /// the time the timer was created
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  /// add the elapsed time to the total
+  ~WallTimer() { total += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); }
+};
+
+/// Base class of the nonlinear solvers that record a SolverTelemetry of each solve
+class TelemetrySource {
+public:
+  /// destructor
+  virtual ~TelemetrySource() = default;
+
+  /// the telemetry of the last call to Mult
+  mutable SolverTelemetry telemetry;
+};
+
 /// Newton solver with a 2-way line-search.  Reverts to regular Newton if max_line_search_iterations is set to 0.
-class NewtonSolver : public mfem::NewtonSolver {
+class NewtonSolver : public mfem::NewtonSolver, public TelemetrySource {
 protected:
   /// initial solution vector to do line-search off of
   mutable mfem::Vector x0;
   /// nonlinear solver options
   NonlinearSolverOptions nonlinear_options;
+  /// the number of linear solves that have used the current Jacobian, or -1 if there isn't one
+  mutable int jacobian_age = -1;
+  /// the operator that the current Jacobian was computed from
+  mutable const mfem::Operator* jacobian_oper = nullptr;
+  /// whether the caller has declared the current Jacobian exact for the next solve, see setJacobianCurrent()
+  bool jacobian_current = false;
+  /// whether the Jacobian will probably be assembled at the point of the residual being evaluated, see
+  /// jacobianExpected()
+  mutable bool jacobian_expected = false;
+  /// the relative tolerance of each linear solve
+  mutable InexactNewtonTolerance linear_tolerance;
+  /// scratch space for the residual of the linearized system
+  mutable mfem::Vector linear_residual;
 
 public:
   /// constructor
-  NewtonSolver(const NonlinearSolverOptions& nonlinear_opts) : nonlinear_options(nonlinear_opts) {}
+  NewtonSolver(const NonlinearSolverOptions& nonlinear_opts, const LinearSolverOptions& linear_opts)
+      : nonlinear_options(nonlinear_opts),
+        linear_tolerance{nonlinear_opts.forcing_term, linear_opts.relative_tol, nonlinear_opts.max_forcing_term}
+  {
+  }
 
 #ifdef MFEM_USE_MPI
   /// parallel constructor
-  NewtonSolver(MPI_Comm comm_, const NonlinearSolverOptions& nonlinear_opts)
-      : mfem::NewtonSolver(comm_), nonlinear_options(nonlinear_opts)
+  NewtonSolver(MPI_Comm comm_, const NonlinearSolverOptions& nonlinear_opts, const LinearSolverOptions& linear_opts)
+      : mfem::NewtonSolver(comm_),
+        nonlinear_options(nonlinear_opts),
+        linear_tolerance{nonlinear_opts.forcing_term, linear_opts.relative_tol, nonlinear_opts.max_forcing_term}
   {
   }
 #endif
 
+  /// @brief declare whether the current Jacobian and preconditioner are still exact for the next solve
+  void setJacobianCurrent(bool current) { jacobian_current = current; }
+
+  /**
+   * @brief whether the Jacobian will probably be assembled at the point of the residual being evaluated, so that the
+   * operator may compute its derivatives along with the residual
+   * @note this doesn't account for a Jacobian declared current by the operator itself, see setJacobianCurrent()
+   */
+  bool jacobianExpected() const { return jacobian_expected; }
+
   /// Evaluate the residual, put in rOut and return its norm.
   double evaluateNorm(const mfem::Vector& x, mfem::Vector& rOut) const
   {
@@ -56,6 +171,8 @@ public:
   void assembleJacobian(const mfem::Vector& x) const
   {
     SERAC_MARK_FUNCTION;
+    WallTimer timer{telemetry.assembly_time};
+    telemetry.jacobian_assemblies++;
     grad = &oper->GetGradient(x);
   }
 
@@ -63,6 +180,8 @@ public:
   void setPreconditioner() const
   {
     SERAC_MARK_FUNCTION;
+    WallTimer timer{telemetry.preconditioner_time};
+    telemetry.preconditioner_setups++;
     prec->SetOperator(*grad);
   }
 
@@ -70,7 +189,104 @@ public:
   void solveLinearSystem(const mfem::Vector& r_, mfem::Vector& c_) const
   {
     SERAC_MARK_FUNCTION;
+    WallTimer timer{telemetry.linear_solve_time};
+    auto*     iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec);
+    if (iterative_solver && linear_tolerance.adaptive()) {
+      iterative_solver->SetRelTol(linear_tolerance.eta);
+    }
     prec->Mult(r_, c_);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
+    telemetry.linear_solves++;
+    if (iterative_solver) {
+      telemetry.linear_iterations += iterative_solver->GetNumIterations();
+    }
+  }
+
+  /// the norm of the residual of the linearized system, ||F(x_i) - DF(x_i) c||
+  double linearModelNorm(const mfem::Vector& r_, const mfem::Vector& c_) const
+  {
+    linear_residual.SetSize(r_.Size());
+    grad->Mult(c_, linear_residual);
+    linear_residual -= r_;
+    return Norm(linear_residual);
+  }
+
+  /**
+   * @brief decide whether the Jacobian and preconditioner have to be recomputed for Newton iteration `it`
+   *
+   * @param it the Newton iteration number
+   * @param rate the ratio of the residual norms of the last iteration, ||r_{k}|| / ||r_{k-1}||
+   */
+  bool needsNewJacobian(int it, double rate) const
+  {
+    if (jacobian_age < 0 || jacobian_oper != oper) return true;
+    if (it == 0) return !(nonlinear_options.reuse_jacobian_across_solves || jacobian_current);
+    return (jacobian_age >= nonlinear_options.max_jacobian_reuse) || (rate > nonlinear_options.jacobian_reuse_rate);
+  }
+
+  /**
+   * @brief shorten a rejected step x = x0 - c by minimizing models of the merit function phi(s) = 0.5 ||r(x0 - s c)||^2
+   *
+   * The first cutback minimizes the quadratic through phi(0), phi'(0) and phi(1), and later ones the cubic through
+   * phi(0), phi'(0) and the last two trial values (see Dennis and Schnabel, "Numerical Methods for Unconstrained
+   * Optimization and Nonlinear Equations", section 6.3.2). Each new step is kept within [0.1, 0.5] of the previous one.
+   *
+   * @param norm0 the residual norm at x0
+   * @param slope phi'(0)
+   * @param[in,out] norm the residual norm at the current trial step, and at the accepted one on output
+   * @param[in,out] stepScale the current trial step, and the accepted one on output
+   * @param[in,out] x the current trial iterate, and the accepted one on output
+   * @return the number of cutbacks taken
+   */
+  int interpolatingLineSearch(double norm0, double slope, double& norm, double& stepScale, mfem::Vector& x) const
+  {
+    constexpr double sufficient_decrease = 1.0e-4;
+
+    const double phi0 = 0.5 * norm0 * norm0;
+
+    double phi            = 0.5 * norm * norm;
+    double previous_scale = 0.0;
+    double previous_phi   = 0.0;
+
+    int ls_iter = 0;
+    for (; ls_iter < nonlinear_options.max_line_search_iterations; ++ls_iter) {
+      if (phi <= phi0 + sufficient_decrease * stepScale * slope) {
+        break;
+      }
+
+      double next = 0.5 * stepScale;
+      if (slope < 0.0 && std::isfinite(phi)) {
+        if (ls_iter == 0) {
+          next = -slope * stepScale * stepScale / (2.0 * (phi - phi0 - slope * stepScale));
+        } else {
+          // the cubic phi0 + slope s + b s^2 + a s^3 through the last two trial steps
+          const double s1 = stepScale;
+          const double s2 = previous_scale;
+          const double d1 = phi - phi0 - slope * s1;
+          const double d2 = previous_phi - phi0 - slope * s2;
+          const double a  = (d1 / (s1 * s1) - d2 / (s2 * s2)) / (s1 - s2);
+          const double b  = (-s2 * d1 / (s1 * s1) + s1 * d2 / (s2 * s2)) / (s1 - s2);
+          if (a == 0.0) {
+            next = -slope / (2.0 * b);
+          } else {
+            const double discriminant = b * b - 3.0 * a * slope;
+            next = discriminant >= 0.0 ? (-b + std::sqrt(discriminant)) / (3.0 * a) : 0.5 * stepScale;
+          }
+        }
+        if (!std::isfinite(next)) {
+          next = 0.5 * stepScale;
+        }
+      }
+
+      previous_scale = stepScale;
+      previous_phi   = phi;
+      stepScale      = std::clamp(next, 0.1 * stepScale, 0.5 * stepScale);
+
+      add(x0, -stepScale, c, x);
+      norm = evaluateNorm(x, r);
+      phi  = 0.5 * norm * norm;
+    }
+
+    return ls_iter;
   }
 
   /// @overload
@@ -82,7 +298,11 @@ public:
     using real_t = mfem::real_t;
 
     real_t norm, norm_goal;
-    norm = initial_norm = evaluateNorm(x, r);
+
+    // the operator may still declare the current Jacobian exact while it evaluates this residual
+    jacobian_expected = jacobian_age < 0 || jacobian_oper != oper || !nonlinear_options.reuse_jacobian_across_solves;
+    norm              = initial_norm = evaluateNorm(x, r);
+    jacobian_expected = false;
 
     if (print_options.first_and_last && !print_options.iterations) {
       mfem::out << "Newton iteration " << std::setw(3) << 0 << " : ||r|| = " << std::setw(13) << norm << "...\n";
@@ -91,9 +311,15 @@ public:
     norm_goal            = std::max(rel_tol * initial_norm, abs_tol);
     prec->iterative_mode = false;
 
+    real_t rate = 0.0;
+
+    telemetry = SolverTelemetry{};
+    linear_tolerance.reset();
+
     int it = 0;
     for (; true; it++) {
       MFEM_ASSERT(mfem::IsFinite(norm), "norm = " << norm);
+      telemetry.residual_norms.push_back(norm);
       if (print_options.iterations) {
         mfem::out << "Newton iteration " << std::setw(3) << it << " : ||r|| = " << std::setw(13) << norm;
         if (it > 0) {
@@ -112,18 +338,70 @@ public:
 
       real_t norm_nm1 = norm;
 
-      assembleJacobian(x);
-      setPreconditioner();
+      // the residual is always exact, but the Jacobian and preconditioner may be
+      // reused from earlier iterations (see NonlinearSolverOptions::max_jacobian_reuse)
+      if (needsNewJacobian(it, rate)) {
+        assembleJacobian(x);
+        setPreconditioner();
+        jacobian_age  = 0;
+        jacobian_oper = oper;
+      }
       solveLinearSystem(r, c);
+      jacobian_age++;
+
+      // a linear residual vanishes after the first update, up to the accuracy of the linear solve
+      // (see NonlinearSolverOptions::linear), so its norm is only estimated
+      if (nonlinear_options.linear) {
+        x.Add(-1.0, c);
+        auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec);
+        converged              = !iterative_solver || iterative_solver->GetConverged();
+        norm                   = iterative_solver ? iterative_solver->GetFinalNorm() : 0.0;
+        telemetry.residual_norms.push_back(norm);
+        it++;
+        break;
+      }
+
+      // only the first Eisenstat-Walker choice needs to know how accurate the linear model was
+      real_t linear_model_norm = 0.0;
+      if (linear_tolerance.strategy == ForcingTerm::EisenstatWalker1) {
+        linear_model_norm = linearModelNorm(r, c);
+      }
 
       // there must be a better way to do this?
       x0.SetSize(x.Size());
       x0 = 0.0;
       x0.Add(1.0, x);
 
-      real_t stepScale = 1.0;
+      const bool interpolating = nonlinear_options.max_line_search_iterations > 0 &&
+                                 nonlinear_options.line_search_method == LineSearchMethod::Interpolation;
+
+      // the slope of the merit function 0.5 ||r(x0 - s c)||^2 at s = 0 is -r . (J c)
+      real_t merit_slope = 0.0;
+      if (interpolating) {
+        linear_residual.SetSize(r.Size());
+        grad->Mult(c, linear_residual);
+        merit_slope = -Dot(r, linear_residual);
+      }
+
+      // the next Jacobian is assembled at the full step (unless it is cut back) once the current one is too old, but
+      // whether it is also replaced for a slow rate of convergence isn't known until the residual has been evaluated
+      real_t stepScale  = 1.0;
+      jacobian_expected = jacobian_age >= nonlinear_options.max_jacobian_reuse;
       add(x0, -stepScale, c, x);
-      norm = evaluateNorm(x, r);
+      norm              = evaluateNorm(x, r);
+      jacobian_expected = false;
+
+      if (interpolating) {
+        int ls_iter = interpolatingLineSearch(norm_nm1, merit_slope, norm, stepScale, x);
+        telemetry.line_search_cutbacks += ls_iter;
+        if (ls_iter && print_options.iterations) {
+          mfem::out << "Number of line search steps taken = " << ls_iter << std::endl;
+        }
+
+        rate = norm / norm_nm1;
+        linear_tolerance.update(norm, norm_nm1, linear_model_norm, norm_goal);
+        continue;
+      }
 
       const int               max_ls_iters = nonlinear_options.max_line_search_iterations;
       static constexpr real_t reduction    = 0.5;
@@ -167,6 +445,7 @@ public:
         }
       }
 
+      telemetry.line_search_cutbacks += ls_iter_sum;
       if (ls_iter_sum) {
         if (print_options.iterations) {
           mfem::out << "Number of line search steps taken = " << ls_iter_sum << std::endl;
@@ -177,11 +456,24 @@ public:
                     << std::endl;
         }
       }
+
+      rate = norm / norm_nm1;
+      linear_tolerance.update(norm, norm_nm1, linear_model_norm, norm_goal);
+    }
+
+    // leave the linear solver with its original tolerance
+    if (linear_tolerance.adaptive()) {
+      if (auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec)) {
+        iterative_solver->SetRelTol(linear_tolerance.eta_min);
+      }
     }
 
     final_iter = it;
     final_norm = norm;
 
+    telemetry.nonlinear_iterations = it;
+    telemetry.converged            = converged;
+
     if (print_options.summary || (!converged && print_options.warnings) || print_options.first_and_last) {
       mfem::out << "Newton: Number of iterations: " << final_iter << '\n' << "   ||r|| = " << final_norm << '\n';
     }
@@ -191,6 +483,129 @@ public:
   }
 };
 
+/**
+ * @brief Newton's method with Anderson acceleration
+ *
+ * The (possibly modified, see NonlinearSolverOptions::max_jacobian_reuse) Newton update is treated as the fixed-point
+ * map g(x) = x - J^{-1} F(x), and each new iterate is the Anderson mixing of the last anderson_depth of them. An
+ * iterate that does not reduce the residual norm is replaced by the plain Newton update, and the mixing history is
+ * restarted.
+ */
+class AndersonNewtonSolver : public NewtonSolver {
+protected:
+  /// the Anderson mixing of the Newton updates
+  mutable FixedPointAccelerator accelerator;
+  /// the plain Newton update of the current iterate
+  mutable mfem::Vector newton_update;
+
+public:
+  /// parallel constructor
+  AndersonNewtonSolver(MPI_Comm comm_, const NonlinearSolverOptions& nonlinear_opts,
+                       const LinearSolverOptions& linear_opts)
+      : NewtonSolver(comm_, nonlinear_opts, linear_opts),
+        accelerator(FixedPointAcceleration::Anderson, 1.0, nonlinear_opts.anderson_depth, comm_)
+  {
+  }
+
+  /// @overload
+  void Mult(const mfem::Vector&, mfem::Vector& x) const
+  {
+    MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
+    MFEM_ASSERT(prec != NULL, "the Solver is not set (use SetSolver).");
+
+    using real_t = mfem::real_t;
+
+    real_t norm = initial_norm = evaluateNorm(x, r);
+    real_t norm_goal           = std::max(rel_tol * initial_norm, abs_tol);
+    prec->iterative_mode       = false;
+
+    real_t rate = 0.0;
+
+    telemetry = SolverTelemetry{};
+    linear_tolerance.reset();
+    accelerator.reset();
+
+    int it = 0;
+    for (; true; it++) {
+      MFEM_ASSERT(mfem::IsFinite(norm), "norm = " << norm);
+      telemetry.residual_norms.push_back(norm);
+      if (print_options.iterations) {
+        mfem::out << "Anderson-Newton iteration " << std::setw(3) << it << " : ||r|| = " << std::setw(13) << norm;
+        if (it > 0) {
+          mfem::out << ", ||r||/||r_0|| = " << std::setw(13) << norm / initial_norm;
+        }
+        mfem::out << '\n';
+      }
+
+      if (norm <= norm_goal && it >= nonlinear_options.min_iterations) {
+        converged = true;
+        break;
+      } else if (it >= max_iter) {
+        converged = false;
+        break;
+      }
+
+      real_t norm_nm1 = norm;
+
+      if (needsNewJacobian(it, rate)) {
+        assembleJacobian(x);
+        setPreconditioner();
+        jacobian_age  = 0;
+        jacobian_oper = oper;
+      }
+      solveLinearSystem(r, c);
+      jacobian_age++;
+
+      real_t linear_model_norm = 0.0;
+      if (linear_tolerance.strategy == ForcingTerm::EisenstatWalker1) {
+        linear_model_norm = linearModelNorm(r, c);
+      }
+
+      // g(x) = x - J^{-1} F(x)
+      newton_update.SetSize(x.Size());
+      subtract(x, c, newton_update);
+
+      accelerator.update(x, newton_update);
+      norm = evaluateNorm(x, r);
+
+      // safeguard: fall back to the plain Newton update if mixing made things worse
+      if (!(norm < norm_nm1)) {
+        if (print_options.iterations) {
+          mfem::out << "Anderson mixing rejected, restarting from the Newton update" << std::endl;
+        }
+        x    = newton_update;
+        norm = evaluateNorm(x, r);
+        accelerator.reset();
+        telemetry.line_search_cutbacks++;
+      }
+
+      rate = norm / norm_nm1;
+      linear_tolerance.update(norm, norm_nm1, linear_model_norm, norm_goal);
+    }
+
+    // leave the linear solver with its original tolerance
+    if (linear_tolerance.adaptive()) {
+      if (auto* iterative_solver = dynamic_cast<mfem::IterativeSolver*>(prec)) {
+        iterative_solver->SetRelTol(linear_tolerance.eta_min);
+      }
+    }
+
+    final_iter = it;
+    final_norm = norm;
+
+    telemetry.nonlinear_iterations = it;
+    telemetry.converged            = converged;
+
+    if (print_options.summary || (!converged && print_options.warnings) || print_options.first_and_last) {
+      mfem::out << "Anderson-Newton: Number of iterations: " << final_iter << '\n' << "   ||r|| = " << final_norm
+                << '\n';
+    }
+    if (!converged && (print_options.summary || print_options.warnings)) {
+      mfem::out << "Anderson-Newton: No convergence!\n";
+    }
+  }
+};
+
 /// Internal structure for storing trust region settings
 struct TrustRegionSettings {
   /// cg tol
@@ -219,17 +634,22 @@ struct TrustRegionResults {
   TrustRegionResults(int size)
   {
     z.SetSize(size);
+    zPred.SetSize(size);
     d.SetSize(size);
     Pr.SetSize(size);
     Hd.SetSize(size);
+    Hz.SetSize(size);
     cauchyPoint.SetSize(size);
+    HcauchyPoint.SetSize(size);
   }
 
   /// resets trust region results for a new outer iteration
   void reset()
   {
-    z           = 0.0;
-    cauchyPoint = 0.0;
+    z            = 0.0;
+    Hz           = 0.0;
+    cauchyPoint  = 0.0;
+    HcauchyPoint = 0.0;
   }
 
   /// enumerates the possible final status of the trust region steps
@@ -242,14 +662,20 @@ struct TrustRegionResults {
 
   /// step direction
   mfem::Vector z;
+  /// candidate step direction of the next CG iteration
+  mfem::Vector zPred;
   /// incrementalCG direction
   mfem::Vector d;
   /// preconditioned residual
   mfem::Vector Pr;
   /// action of hessian on direction d
   mfem::Vector Hd;
+  /// action of hessian on the step direction z, accumulated alongside z by CG
+  mfem::Vector Hz;
   /// cauchy point
   mfem::Vector cauchyPoint;
+  /// action of hessian on the cauchy point
+  mfem::Vector HcauchyPoint;
   /// specifies if step is interior, exterior, negative curvature, etc.
   Status interiorStatus = Status::Interior;
   /// iteration counter
@@ -273,8 +699,14 @@ void print_trust_region_info(double realObjective, double modelObjective, size_t
  * Methods by Conn, Gould, and Toint). One important difference is we do not compute an explicit energy.  Instead we
  * rely on an incremental work approximation: 0.5 (f^n + f^{n+1}) dot (u^{n+1} - u^n).  While less theoretically sound,
  * it appears to be very effective in practice.
+ *
+ * Each outer iteration applies the Hessian once to compute the Cauchy point and once per CG iteration. The action of
+ * the Hessian on the CG solution is accumulated alongside it, so steps rejected by the trust region are re-solved for
+ * a smaller radius (along the dogleg path between the Cauchy point and the CG solution) without any further Hessian
+ * applications. The Hessian is only ever applied through its action, so it may be the unassembled gradient returned
+ * by a matrix-free physics module, as long as the preconditioner accepts it.
  */
-class TrustRegion : public mfem::NewtonSolver {
+class TrustRegion : public mfem::NewtonSolver, public TelemetrySource {
 protected:
   /// predicted solution
   mutable mfem::Vector xPred;
@@ -290,38 +722,39 @@ protected:
   /// handle to the preconditioner used by the trust region, it ignores the linear solver as a SPD preconditioner is
   /// currently required
   Solver& trPrecond;
+  /// the relative tolerance of the trust region subproblem's CG solves
+  mutable InexactNewtonTolerance trust_region_tolerance;
 
 public:
 #ifdef MFEM_USE_MPI
   /// constructor
   TrustRegion(MPI_Comm comm_, const NonlinearSolverOptions& nonlinear_opts, const LinearSolverOptions& linear_opts,
               Solver& tPrec)
-      : mfem::NewtonSolver(comm_), nonlinear_options(nonlinear_opts), linear_options(linear_opts), trPrecond(tPrec)
+      : mfem::NewtonSolver(comm_),
+        nonlinear_options(nonlinear_opts),
+        linear_options(linear_opts),
+        trPrecond(tPrec),
+        trust_region_tolerance{nonlinear_opts.forcing_term, 1.0e-3, nonlinear_opts.max_forcing_term}
   {
+    // without an adaptive forcing term, the subproblems are solved to 1e-3 of the current residual
+    trust_region_tolerance.reset();
   }
 #endif
 
-  /// finds tau s.t. (z + tau*d)^2 = trSize^2
-  void project_to_boundary_with_coefs(mfem::Vector& z, const mfem::Vector& d, double trSize, double zz, double zd,
-                                      double dd) const
+  /// finds tau s.t. (z + tau*d)^2 = trSize^2, given zz = z.z, zd = z.d and dd = d.d
+  double boundary_step_length(double trSize, double zz, double zd, double dd) const
   {
-    double tau = (std::sqrt((trSize * trSize - zz) * dd + zd * zd) - zd) / dd;
-    z.Add(tau, d);
+    return (std::sqrt((trSize * trSize - zz) * dd + zd * zd) - zd) / dd;
   }
 
-  /// finds tau s.t. (z + tau*(y-z))^2 = trSize^2
-  void project_to_boundary_between_with_coefs(mfem::Vector& z, const mfem::Vector& y, double trSize, double zz,
-                                              double zy, double yy) const
-  {
-    double dd  = yy - 2 * zy + zz;
-    double zd  = zy - zz;
-    double tau = (std::sqrt((trSize * trSize - zz) * dd + zd * zd) - zd) / dd;
-    z.Add(-tau, z);
-    z.Add(tau, y);
-  }
-
-  /// take a dogleg step in direction s, solution norm must be within trSize
-  void dogleg_step(const mfem::Vector& cp, const mfem::Vector& newtonP, double trSize, mfem::Vector& s) const
+  /**
+   * @brief take a dogleg step in direction s, solution norm must be within trSize
+   *
+   * The step is a combination of the cauchy point and the newton point, so its hessian action Hs is the same
+   * combination of their hessian actions, Hcp and HnewtonP.
+   */
+  void dogleg_step(const mfem::Vector& cp, const mfem::Vector& newtonP, const mfem::Vector& Hcp,
+                   const mfem::Vector& HnewtonP, double trSize, mfem::Vector& s, mfem::Vector& Hs) const
   {
     SERAC_MARK_FUNCTION;
     // MRT, could optimize some of these eventually, compute on the outside and save
@@ -329,21 +762,28 @@ public:
     double nn = Dot(newtonP, newtonP);
     double tt = trSize * trSize;
 
-    s = 0.0;
+    // s = a * cp + b * newtonP
+    double a = 0.0;
+    double b = 0.0;
     if (cc >= tt) {
-      add(s, std::sqrt(tt / cc), cp, s);
+      a = std::sqrt(tt / cc);
     } else if (cc > nn) {
       if (print_options.warnings) {
         mfem::out << "cp outside newton, preconditioner likely inaccurate\n";
       }
-      add(s, 1.0, cp, s);
+      a = 1.0;
     } else if (nn > tt) {  // on the dogleg (we have nn >= cc, and tt >= cc)
-      add(s, 1.0, cp, s);
-      double cn = Dot(cp, newtonP);
-      project_to_boundary_between_with_coefs(s, newtonP, trSize, cc, cn, nn);
+      // move from cp towards newtonP until reaching the boundary
+      double cn  = Dot(cp, newtonP);
+      double tau = boundary_step_length(trSize, cc, cn - cc, nn - 2 * cn + cc);
+      a          = 1.0 - tau;
+      b          = tau;
     } else {
-      s = newtonP;
+      b = 1.0;
     }
+
+    add(a, cp, b, newtonP, s);
+    add(a, Hcp, b, HnewtonP, Hs);
   }
 
   /// Minimize quadratic sub-problem given residual vector, the action of the stiffness and a preconditioner
@@ -358,10 +798,12 @@ public:
     results.cgIterationsCount = 0;
 
     auto& z      = results.z;
+    auto& zPred  = results.zPred;
     auto& cgIter = results.cgIterationsCount;
     auto& d      = results.d;
     auto& Pr     = results.Pr;
     auto& Hd     = results.Hd;
+    auto& Hz     = results.Hz;
 
     const double cgTolSquared = settings.cgTol * settings.cgTol;
 
@@ -375,6 +817,7 @@ public:
     add(d, -1.0, Pr, d);  // d = -Pr
 
     z          = 0.0;
+    Hz         = 0.0;
     double zz  = 0.;
     double rPr = Dot(rCurrent, Pr);
     double zd  = 0.0;
@@ -385,25 +828,21 @@ public:
       const double curvature = Dot(d, Hd);
       const double alphaCg   = rPr / curvature;
 
-      auto& zPred = Hd;  // re-use Hd, this is where bugs come from
       add(z, alphaCg, d, zPred);
       double zzNp1 = Dot(zPred, zPred);  // can optimize this eventually
 
-      if (curvature <= 0) {
-        // mfem::out << "negative curvature found.\n";
-        project_to_boundary_with_coefs(z, d, trSize, zz, zd, dd);
-        results.interiorStatus = TrustRegionResults::Status::NegativeCurvature;
-        return;
-      } else if (zzNp1 > (trSize * trSize)) {
-        // mfem::out << "step outside trust region.\n";
-        project_to_boundary_with_coefs(z, d, trSize, zz, zd, dd);
-        results.interiorStatus = TrustRegionResults::Status::OnBoundary;
+      if (curvature <= 0 || zzNp1 > (trSize * trSize)) {
+        // mfem::out << "negative curvature found, or step outside trust region.\n";
+        double tau = boundary_step_length(trSize, zz, zd, dd);
+        z.Add(tau, d);
+        Hz.Add(tau, Hd);
+        results.interiorStatus = curvature <= 0 ? TrustRegionResults::Status::NegativeCurvature
+                                                : TrustRegionResults::Status::OnBoundary;
         return;
       }
 
       z = zPred;
-
-      hess_vec_func(d, Hd);
+      Hz.Add(alphaCg, Hd);
       add(rCurrent, alphaCg, Hd, rCurrent);
 
       precond(rCurrent, Pr);
@@ -427,6 +866,8 @@ public:
   void assemble_jacobian(const mfem::Vector& x) const
   {
     SERAC_MARK_FUNCTION;
+    WallTimer timer{telemetry.assembly_time};
+    telemetry.jacobian_assemblies++;
     grad = &oper->GetGradient(x);
   }
 
@@ -477,6 +918,9 @@ public:
     scratch.SetSize(X.Size());
     scratch = 0.0;
 
+    telemetry = SolverTelemetry{};
+    trust_region_tolerance.reset();
+
     TrustRegionResults  trResults(X.Size());
     TrustRegionSettings settings;
     settings.maxCgIterations = static_cast<size_t>(linear_options.max_iterations);
@@ -487,6 +931,7 @@ public:
     int it = 0;
     for (; true; it++) {
       MFEM_ASSERT(mfem::IsFinite(norm), "norm = " << norm);
+      telemetry.residual_norms.push_back(norm);
       if (print_options.iterations) {
         mfem::out << "Newton iteration " << std::setw(3) << it << " : ||r|| = " << std::setw(13) << norm;
         if (it > 0) {
@@ -507,6 +952,8 @@ public:
 
       if (it == 0 || (trResults.cgIterationsCount >= settings.maxCgIterations ||
                       cumulativeCgIters >= settings.maxCumulativeIteration)) {
+        WallTimer timer{telemetry.preconditioner_time};
+        telemetry.preconditioner_setups++;
         trPrecond.SetOperator(*grad);
         cumulativeCgIters = 0;
         if (print_options.iterations) {
@@ -526,10 +973,12 @@ public:
       if (gKg > 0) {
         const double alphaCp = -Dot(r, r) / gKg;
         add(trResults.cauchyPoint, alphaCp, r, trResults.cauchyPoint);
+        trResults.HcauchyPoint.Set(alphaCp, trResults.Hd);
         cauchyPointNormSquared = Dot(trResults.cauchyPoint, trResults.cauchyPoint);
       } else {
         const double alphaTr = -trSize / std::sqrt(Dot(r, r));
         add(trResults.cauchyPoint, alphaTr, r, trResults.cauchyPoint);
+        trResults.HcauchyPoint.Set(alphaTr, trResults.Hd);
         if (print_options.iterations) {
           mfem::out << "Negative curvature un-preconditioned cauchy point direction found."
                     << "\n";
@@ -542,14 +991,25 @@ public:
                     << std::sqrt(cauchyPointNormSquared) << "\n";
         }
         trResults.cauchyPoint *= (trSize / std::sqrt(cauchyPointNormSquared));
+        trResults.HcauchyPoint *= (trSize / std::sqrt(cauchyPointNormSquared));
         trResults.z                 = trResults.cauchyPoint;
+        trResults.Hz                = trResults.HcauchyPoint;
         trResults.cgIterationsCount = 1;
         trResults.interiorStatus    = TrustRegionResults::Status::OnBoundary;
       } else {
-        settings.cgTol = std::max(0.2 * norm_goal, 1e-3 * norm);
+        WallTimer timer{telemetry.linear_solve_time};
+        settings.cgTol = std::max(0.2 * norm_goal, trust_region_tolerance.eta * norm);
         solve_trust_region_minimization(r, scratch, hess_vec_func, precond_func, settings, trSize, trResults);
       }
       cumulativeCgIters += trResults.cgIterationsCount;
+      telemetry.linear_solves++;
+      telemetry.linear_iterations += static_cast<int>(trResults.cgIterationsCount);
+
+      // remember the residual before the step, for updating the forcing term
+      real_t norm_prev = norm;
+      if (trust_region_tolerance.strategy == ForcingTerm::EisenstatWalker1) {
+        scratch = r;
+      }
 
       bool happyAboutTrSize = false;
       int  lineSearchIter   = 0;
@@ -558,9 +1018,9 @@ public:
         auto& d  = trResults.d;   // reuse, dangerous!
         auto& Hd = trResults.Hd;  // reuse, dangerous!
 
-        dogleg_step(trResults.cauchyPoint, trResults.z, trSize, d);
+        // no new hessian applications are needed for a smaller trust region
+        dogleg_step(trResults.cauchyPoint, trResults.z, trResults.HcauchyPoint, trResults.Hz, trSize, d, Hd);
 
-        hess_vec_func(d, Hd);
         double dHd            = Dot(d, Hd);
         double modelObjective = Dot(r, d) + 0.5 * dHd;
 
@@ -622,11 +1082,27 @@ public:
           break;
         }
       }
+
+      // every trust region after the first one tried is a cutback
+      telemetry.line_search_cutbacks += lineSearchIter - 1;
+
+      if (happyAboutTrSize) {
+        // the residual of the quadratic model at the accepted step, ||r + J d||
+        real_t linear_model_norm = 0.0;
+        if (trust_region_tolerance.strategy == ForcingTerm::EisenstatWalker1) {
+          scratch += trResults.Hd;
+          linear_model_norm = Norm(scratch);
+        }
+        trust_region_tolerance.update(norm, norm_prev, linear_model_norm, norm_goal);
+      }
     }
 
     final_iter = it;
     final_norm = norm;
 
+    telemetry.nonlinear_iterations = it;
+    telemetry.converged            = converged;
+
     if (print_options.summary || (!converged && print_options.warnings) || print_options.first_and_last) {
       mfem::out << "Newton: Number of iterations: " << final_iter << '\n' << "   ||r|| = " << final_norm << '\n';
     }
@@ -640,9 +1116,30 @@ EquationSolver::EquationSolver(NonlinearSolverOptions nonlinear_opts, LinearSolv
 {
   auto [lin_solver, preconditioner] = buildLinearSolverAndPreconditioner(lin_opts, comm);
 
-  lin_solver_     = std::move(lin_solver);
-  preconditioner_ = std::move(preconditioner);
-  nonlin_solver_  = buildNonlinearSolver(nonlinear_opts, lin_opts, *preconditioner_, comm);
+  // the linear solver (and its preconditioner) is then given the condensed systems
+  if (lin_opts.static_condensation) {
+    SLIC_ERROR_ROOT_IF(lin_opts.matrix_free, "Static condensation assembles its condensed systems, so it can't be "
+                                             "combined with matrix-free linear solves");
+
+    auto condensed = std::make_unique<StaticCondensationSolver>(std::move(lin_solver), comm);
+    condensed->SetRelTol(lin_opts.relative_tol);
+    condensed->SetAbsTol(lin_opts.absolute_tol);
+    condensed->SetMaxIter(lin_opts.max_iterations);
+    lin_solver = std::move(condensed);
+  }
+
+  lin_solver_          = std::move(lin_solver);
+  preconditioner_      = std::move(preconditioner);
+  nonlin_solver_       = buildNonlinearSolver(nonlinear_opts, lin_opts, *preconditioner_, comm);
+  matrix_free_         = lin_opts.matrix_free;
+  static_condensation_ = lin_opts.static_condensation;
+  linear_              = nonlinear_opts.linear;
+
+  bool diagonal_preconditioner = (lin_opts.preconditioner == Preconditioner::Jacobi) ||
+                                 (lin_opts.preconditioner == Preconditioner::Chebyshev) ||
+                                 (lin_opts.preconditioner == Preconditioner::GeometricMultigrid) ||
+                                 (lin_opts.preconditioner == Preconditioner::PMultigrid);
+  preconditioner_uses_diagonal_ = lin_opts.matrix_free && diagonal_preconditioner;
 }
 
 EquationSolver::EquationSolver(std::unique_ptr<mfem::NewtonSolver> nonlinear_solver,
@@ -668,13 +1165,744 @@ void EquationSolver::setOperator(const mfem::Operator& op)
   }
 }
 
+void EquationSolver::setJacobianCurrent(bool current)
+{
+  if (auto* newton = dynamic_cast<NewtonSolver*>(nonlin_solver_.get())) {
+    newton->setJacobianCurrent(current);
+  }
+}
+
+bool EquationSolver::jacobianExpected() const
+{
+  auto* newton = dynamic_cast<const NewtonSolver*>(nonlin_solver_.get());
+  return newton && newton->jacobianExpected();
+}
+
 void EquationSolver::solve(mfem::Vector& x) const
 {
   mfem::Vector zero(x);
   zero = 0.0;
-  // KINSOL does not handle non-zero RHS, so we enforce that the RHS
-  // of the nonlinear system is zero
-  nonlin_solver_->Mult(zero, x);
+  SolverTelemetry telemetry;
+  {
+    WallTimer timer{telemetry.solve_time};
+    // KINSOL does not handle non-zero RHS, so we enforce that the RHS
+    // of the nonlinear system is zero
+    nonlin_solver_->Mult(zero, x);
+  }
+
+  if (auto* source = dynamic_cast<const TelemetrySource*>(nonlin_solver_.get())) {
+    double solve_time    = telemetry.solve_time;
+    telemetry            = source->telemetry;
+    telemetry.solve_time = solve_time;
+  } else {
+    telemetry.nonlinear_iterations = nonlin_solver_->GetNumIterations();
+    telemetry.converged            = nonlin_solver_->GetConverged();
+    telemetry.residual_norms       = {nonlin_solver_->GetInitialNorm(), nonlin_solver_->GetFinalNorm()};
+  }
+  telemetry_ = std::move(telemetry);
+}
+
+void ChebyshevPreconditioner::Mult(const mfem::Vector& input, mfem::Vector& output) const
+{
+  SLIC_ERROR_ROOT_IF(!smoother_, "Operator must be set prior to applying the Chebyshev preconditioner");
+  smoother_->Mult(input, output);
+}
+
+void ChebyshevPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  height = op.Height();
+  width  = op.Width();
+
+  diagonal_.SetSize(op.Height());
+  op.AssembleDiagonal(diagonal_);
+
+  // essential boundary conditions are expected to be handled by the operator itself
+  mfem::Array<int> no_essential_dofs;
+  smoother_ = std::make_unique<mfem::OperatorChebyshevSmoother>(op, diagonal_, no_essential_dofs, order_, comm_);
+}
+
+void GeometricMultigridPreconditioner::setCoarseLevels(std::unique_ptr<mfem::HypreParMatrix>        coarsest,
+                                                       const mfem::ParFiniteElementSpace&           coarsest_space,
+                                                       std::vector<std::unique_ptr<mfem::Operator>> operators,
+                                                       std::vector<std::unique_ptr<mfem::Operator>> prolongations,
+                                                       std::vector<mfem::Array<int>>                essential_dofs)
+{
+  SLIC_ERROR_ROOT_IF(prolongations.size() != operators.size() + 1,
+                     "Geometric multigrid needs one prolongation per coarse level");
+  SLIC_ERROR_ROOT_IF(essential_dofs.size() != prolongations.size(),
+                     "Geometric multigrid needs the essential dofs of every coarse level");
+
+  coarsest_      = std::move(coarsest);
+  coarse_solver_ = std::make_unique<mfem::HypreBoomerAMG>(*coarsest_);
+  coarse_solver_->SetPrintLevel(print_level_);
+  if (coarsest_space.GetVDim() > 1) {
+    bool by_nodes = (coarsest_space.GetOrdering() == mfem::Ordering::byNODES);
+    coarse_solver_->SetSystemsOptions(coarsest_space.GetVDim(), by_nodes);
+  }
+
+  intermediate_operators_ = std::move(operators);
+  intermediate_smoothers_.clear();
+  for (auto& op : intermediate_operators_) {
+    intermediate_smoothers_.push_back(std::make_unique<ChebyshevPreconditioner>(order_, comm_));
+    intermediate_smoothers_.back()->SetOperator(*op);
+  }
+
+  prolongations_  = std::move(prolongations);
+  essential_dofs_ = std::move(essential_dofs);
+}
+
+void GeometricMultigridPreconditioner::Mult(const mfem::Vector& input, mfem::Vector& output) const
+{
+  SLIC_ERROR_ROOT_IF(!finest_, "Operator must be set prior to applying the geometric multigrid preconditioner");
+
+  auto num_levels = static_cast<std::size_t>(numLevels());
+  if (residuals_.size() != num_levels) {
+    residuals_.resize(num_levels);
+    coarse_rhs_.resize(num_levels);
+    corrections_.resize(num_levels);
+  }
+
+  cycle(num_levels - 1, input, output);
+}
+
+void GeometricMultigridPreconditioner::cycle(std::size_t level, const mfem::Vector& rhs, mfem::Vector& solution) const
+{
+  solution.SetSize(rhs.Size());
+
+  if (level == 0 && coarsest_) {
+    coarse_solver_->Mult(rhs, solution);
+    return;
+  }
+
+  bool                     finest   = (level == residuals_.size() - 1);
+  const mfem::Operator&    op       = finest ? *finest_ : *intermediate_operators_[level - 1];
+  ChebyshevPreconditioner& smoother = finest ? *finest_smoother_ : *intermediate_smoothers_[level - 1];
+
+  // pre-smoothing, from a zero initial guess
+  smoother.Mult(rhs, solution);
+  if (level == 0) {
+    return;
+  }
+
+  // coarse grid correction
+  auto& residual = residuals_[level];
+  residual.SetSize(rhs.Size());
+  op.Mult(solution, residual);
+  subtract(rhs, residual, residual);
+
+  auto& prolongation = *prolongations_[level - 1];
+  auto& coarse_rhs   = coarse_rhs_[level];
+  coarse_rhs.SetSize(prolongation.Width());
+  prolongation.MultTranspose(residual, coarse_rhs);
+  coarse_rhs.SetSubVector(essential_dofs_[level - 1], 0.0);
+
+  auto& correction = corrections_[level];
+  cycle(level - 1, coarse_rhs, correction);
+  prolongation.AddMult(correction, solution);
+
+  // post-smoothing
+  op.Mult(solution, residual);
+  subtract(rhs, residual, residual);
+  auto& smoothed = coarse_rhs_[level];
+  smoothed.SetSize(rhs.Size());
+  smoother.Mult(residual, smoothed);
+  solution += smoothed;
+}
+
+void GeometricMultigridPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  height = op.Height();
+  width  = op.Width();
+
+  finest_ = &op;
+  if (!finest_smoother_) {
+    finest_smoother_ = std::make_unique<ChebyshevPreconditioner>(order_, comm_);
+  }
+  finest_smoother_->SetOperator(op);
+}
+
+void LORPreconditioner::setLowOrderOperator(std::unique_ptr<mfem::HypreParMatrix> low_order, int vdim, bool by_nodes)
+{
+  low_order_ = std::move(low_order);
+  amg_       = std::make_unique<mfem::HypreBoomerAMG>(*low_order_);
+  amg_->SetPrintLevel(print_level_);
+  if (vdim > 1) {
+    amg_->SetSystemsOptions(vdim, by_nodes);
+  }
+}
+
+void LORPreconditioner::Mult(const mfem::Vector& input, mfem::Vector& output) const
+{
+  SLIC_ERROR_ROOT_IF(!amg_, "The low-order refined operator must be set prior to applying the LOR preconditioner");
+  amg_->Mult(input, output);
+}
+
+void LORPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  SLIC_ERROR_ROOT_IF(low_order_ && (low_order_->Height() != op.Height()),
+                     "The low-order refined operator does not match the size of the high-order operator");
+  height = op.Height();
+  width  = op.Width();
+}
+
+void BlockSchurPreconditioner::Mult(const mfem::Vector& input, mfem::Vector& output) const
+{
+  SLIC_ERROR_ROOT_IF(!amg_, "Operator must be set prior to applying the block Schur complement preconditioner");
+  if (block_preconditioner_) {
+    block_preconditioner_->Mult(input, output);
+  } else {
+    amg_->Mult(input, output);
+  }
+}
+
+void BlockSchurPreconditioner::SetOperator(const mfem::Operator& op)
+{
+  height = op.Height();
+  width  = op.Width();
+
+  block_preconditioner_.reset();
+  schur_solver_.reset();
+  schur_complement_.reset();
+
+  auto* block_operator = dynamic_cast<const mfem::BlockOperator*>(&op);
+  if (!block_operator) {
+    auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+    SLIC_ERROR_ROOT_IF(!matrix, "The block Schur complement preconditioner requires assembled matrices");
+    amg_ = std::make_unique<mfem::HypreBoomerAMG>(*matrix);
+    amg_->SetPrintLevel(print_level_);
+    return;
+  }
+
+  SLIC_ERROR_ROOT_IF(block_operator->NumRowBlocks() != 2 || block_operator->NumColBlocks() != 2,
+                     "The block Schur complement preconditioner requires a 2x2 block operator");
+
+  auto block = [block_operator](int i, int j) -> const mfem::HypreParMatrix* {
+    if (block_operator->IsZeroBlock(i, j)) {
+      return nullptr;
+    }
+    auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&block_operator->GetBlock(i, j));
+    SLIC_ERROR_ROOT_IF(!matrix, "The block Schur complement preconditioner requires HypreParMatrix blocks");
+    return matrix;
+  };
+
+  const auto* A  = block(0, 0);
+  const auto* Bt = block(0, 1);
+  const auto* B  = block(1, 0);
+  const auto* C  = block(1, 1);
+  SLIC_ERROR_ROOT_IF(!A, "The block Schur complement preconditioner requires a nonzero first diagonal block");
+
+  amg_ = std::make_unique<mfem::HypreBoomerAMG>(*A);
+  amg_->SetPrintLevel(print_level_);
+
+  // S = C - B diag(A)^{-1} B^T
+  if (B && Bt) {
+    mfem::Vector diagonal;
+    A->GetDiag(diagonal);
+
+    mfem::HypreParMatrix scaled_Bt(*Bt);
+    scaled_Bt.InvScaleRows(diagonal);
+
+    std::unique_ptr<mfem::HypreParMatrix> coupling(mfem::ParMult(B, &scaled_Bt, true));
+    if (C) {
+      schur_complement_.reset(mfem::Add(1.0, *C, -1.0, *coupling));
+    } else {
+      *coupling *= -1.0;
+      schur_complement_ = std::move(coupling);
+    }
+  } else {
+    SLIC_ERROR_ROOT_IF(!C, "The block Schur complement preconditioner requires a nonsingular Schur complement");
+    schur_complement_ = std::make_unique<mfem::HypreParMatrix>(*C);
+  }
+
+  // the Schur complement is indefinite in general, so it is not a good candidate for AMG
+  schur_solver_ = std::make_unique<mfem::HypreSmoother>(*schur_complement_, mfem::HypreSmoother::Jacobi);
+
+  offsets_              = block_operator->RowOffsets();
+  block_preconditioner_ = std::make_unique<mfem::BlockLowerTriangularPreconditioner>(offsets_);
+  block_preconditioner_->SetDiagonalBlock(0, amg_.get());
+  block_preconditioner_->SetDiagonalBlock(1, schur_solver_.get());
+  if (B) {
+    block_preconditioner_->SetBlock(1, 0, const_cast<mfem::HypreParMatrix*>(B));
+  }
+}
+
+void ReusablePreconditioner::SetOperator(const mfem::Operator& op)
+{
+  if (&op == op_ && reuse_count_ < max_reuse_) {
+    reuse_count_++;
+    return;
+  }
+
+  height = op.Height();
+  width  = op.Width();
+
+  preconditioner_->SetOperator(op);
+  op_          = &op;
+  reuse_count_ = 0;
+  num_setups_++;
+}
+
+void PipelinedCGSolver::precondition(const mfem::Vector& input, mfem::Vector& output) const
+{
+  if (prec) {
+    prec->Mult(input, output);
+  } else {
+    output = input;
+  }
+}
+
+void PipelinedCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  const int n = b.Size();
+
+  // r: residual, u = M r, w = A u, and the auxiliary recurrences
+  // z = A q, q = M s, s = A p of the pipelined method
+  mfem::Vector r(n), u(n), w(n), m(n), An(n), z(n), q(n), s(n), p(n);
+
+  if (iterative_mode) {
+    oper->Mult(x, r);
+    subtract(b, r, r);
+  } else {
+    x = 0.0;
+    r = b;
+  }
+  precondition(r, u);
+  oper->Mult(u, w);
+
+  z = 0.0;
+  q = 0.0;
+  s = 0.0;
+  p = 0.0;
+
+  double gamma_old = 1.0;
+  double alpha_old = 1.0;
+  double stop      = 0.0;
+
+  converged  = false;
+  final_iter = max_iter;
+
+  for (int i = 0;; i++) {
+    double      local[2] = {r * u, w * u};
+    double      global[2];
+    MPI_Request request;
+    MPI_Iallreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, comm_, &request);
+
+    // overlap the reduction with the preconditioner and operator applications
+    precondition(w, m);
+    oper->Mult(m, An);
+
+    MPI_Wait(&request, MPI_STATUS_IGNORE);
+    double gamma = global[0];
+    double delta = global[1];
+
+    final_norm = std::sqrt(std::abs(gamma));
+    if (i == 0) {
+      initial_norm = final_norm;
+      stop         = std::max(rel_tol * initial_norm, abs_tol);
+    }
+
+    if (print_options.iterations) {
+      mfem::out << "   Iteration : " << std::setw(3) << i << "  (B r, r) = " << gamma << '\n';
+    }
+
+    if (final_norm <= stop) {
+      converged  = true;
+      final_iter = i;
+      break;
+    }
+
+    if (i >= max_iter) {
+      break;
+    }
+
+    double beta  = (i == 0) ? 0.0 : gamma / gamma_old;
+    double alpha = (i == 0) ? gamma / delta : gamma / (delta - beta * gamma / alpha_old);
+
+    add(An, beta, z, z);
+    add(m, beta, q, q);
+    add(w, beta, s, s);
+    add(u, beta, p, p);
+
+    x.Add(alpha, p);
+    r.Add(-alpha, s);
+    u.Add(-alpha, q);
+    w.Add(-alpha, z);
+
+    gamma_old = gamma;
+    alpha_old = alpha;
+  }
+
+  if (print_options.summary || (print_options.warnings && !converged)) {
+    mfem::out << "Pipelined PCG: Number of iterations: " << final_iter << '\n';
+  }
+}
+
+namespace {
+
+/// @brief the lower triangular cholesky factor L of a symmetric matrix G = L L^T, or false if G isn't positive definite
+bool cholesky(const mfem::DenseMatrix& G, mfem::DenseMatrix& L)
+{
+  const int n = G.Height();
+  L.SetSize(n);
+  L = 0.0;
+  for (int j = 0; j < n; j++) {
+    double d = G(j, j);
+    for (int k = 0; k < j; k++) {
+      d -= L(j, k) * L(j, k);
+    }
+    if (d <= 1.0e-12 * std::abs(G(j, j)) || d <= 0.0) return false;
+    L(j, j) = std::sqrt(d);
+    for (int i = j + 1; i < n; i++) {
+      double v = G(i, j);
+      for (int k = 0; k < j; k++) {
+        v -= L(i, k) * L(j, k);
+      }
+      L(i, j) = v / L(j, j);
+    }
+  }
+  return true;
+}
+
+/// @brief the eigenvalues and (column) eigenvectors of a small symmetric matrix, by cyclic Jacobi rotations
+void symmetricEigensystem(mfem::DenseMatrix C, mfem::Vector& eigenvalues, mfem::DenseMatrix& eigenvectors)
+{
+  const int n = C.Height();
+  eigenvectors.SetSize(n);
+  eigenvectors = 0.0;
+  for (int i = 0; i < n; i++) {
+    eigenvectors(i, i) = 1.0;
+  }
+
+  for (int sweep = 0; sweep < 100; sweep++) {
+    double off = 0.0, total = 0.0;
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        total += C(i, j) * C(i, j);
+        if (i != j) off += C(i, j) * C(i, j);
+      }
+    }
+    if (off <= 1.0e-28 * total) break;
+
+    for (int p = 0; p < n; p++) {
+      for (int q = p + 1; q < n; q++) {
+        if (C(p, q) == 0.0) continue;
+        double theta = (C(q, q) - C(p, p)) / (2.0 * C(p, q));
+        double t     = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        double c     = 1.0 / std::sqrt(t * t + 1.0);
+        double s     = t * c;
+        for (int k = 0; k < n; k++) {
+          double ckp = C(k, p), ckq = C(k, q);
+          C(k, p)    = c * ckp - s * ckq;
+          C(k, q)    = s * ckp + c * ckq;
+        }
+        for (int k = 0; k < n; k++) {
+          double cpk = C(p, k), cqk = C(q, k);
+          C(p, k)    = c * cpk - s * cqk;
+          C(q, k)    = s * cpk + c * cqk;
+        }
+        for (int k = 0; k < n; k++) {
+          double vkp = eigenvectors(k, p), vkq = eigenvectors(k, q);
+          eigenvectors(k, p) = c * vkp - s * vkq;
+          eigenvectors(k, q) = s * vkp + c * vkq;
+        }
+      }
+    }
+  }
+
+  eigenvalues.SetSize(n);
+  for (int i = 0; i < n; i++) {
+    eigenvalues(i) = C(i, i);
+  }
+}
+
+/// @brief the matrix of inner products of two lists of vectors, summed over the ranks of comm
+mfem::DenseMatrix gram(const std::vector<const mfem::Vector*>& U, const std::vector<const mfem::Vector*>& V,
+                       MPI_Comm comm)
+{
+  const int         m = static_cast<int>(U.size());
+  const int         n = static_cast<int>(V.size());
+  mfem::DenseMatrix G(m, n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      G(i, j) = (*U[i]) * (*V[j]);
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, G.Data(), m * n, MPI_DOUBLE, MPI_SUM, comm);
+  return G;
+}
+
+}  // namespace
+
+void RecyclingCGSolver::precondition(const mfem::Vector& input, mfem::Vector& output) const
+{
+  if (prec) {
+    prec->Mult(input, output);
+  } else {
+    output = input;
+  }
+}
+
+void RecyclingCGSolver::SetOperator(const mfem::Operator& op)
+{
+  mfem::IterativeSolver::SetOperator(op);
+  image_is_stale_ = true;
+}
+
+void RecyclingCGSolver::updateImage() const
+{
+  if (!image_is_stale_) return;
+  image_is_stale_ = false;
+
+  const int k = static_cast<int>(W_.size());
+  if (k == 0) return;
+
+  std::vector<const mfem::Vector*> W(W_.size()), AW(W_.size());
+  AW_.resize(W_.size());
+  for (int i = 0; i < k; i++) {
+    AW_[size_t(i)].SetSize(W_[size_t(i)].Size());
+    oper->Mult(W_[size_t(i)], AW_[size_t(i)]);
+    W[size_t(i)]  = &W_[size_t(i)];
+    AW[size_t(i)] = &AW_[size_t(i)];
+  }
+
+  // W := W L^{-T}, where W^T A W = L L^T, makes the subspace A-orthonormal for the new operator
+  mfem::DenseMatrix L;
+  if (!cholesky(gram(W, AW, comm_), L)) {
+    W_.clear();
+    AW_.clear();
+    return;
+  }
+
+  for (int j = 0; j < k; j++) {
+    for (int i = 0; i < j; i++) {
+      W_[size_t(j)].Add(-L(j, i), W_[size_t(i)]);
+      AW_[size_t(j)].Add(-L(j, i), AW_[size_t(i)]);
+    }
+    W_[size_t(j)] /= L(j, j);
+    AW_[size_t(j)] /= L(j, j);
+  }
+}
+
+void RecyclingCGSolver::updateSubspace(const std::vector<mfem::Vector>& P, const std::vector<mfem::Vector>& AP) const
+{
+  std::vector<const mfem::Vector*> Z, AZ;
+  for (std::size_t i = 0; i < W_.size(); i++) {
+    Z.push_back(&W_[i]);
+    AZ.push_back(&AW_[i]);
+  }
+  for (std::size_t i = 0; i < P.size(); i++) {
+    Z.push_back(&P[i]);
+    AZ.push_back(&AP[i]);
+  }
+
+  const int n = static_cast<int>(Z.size());
+  const int k = std::min(recycle_dimension_, n);
+  if (k == 0) return;
+
+  // Rayleigh-Ritz on span{Z}: the smallest eigenvalues of A are the largest of Z^T Z y = lambda Z^T A Z y.
+  // Z^T A Z is close to the identity, since the search directions are A-normalized and A-orthogonal to W.
+  mfem::DenseMatrix L;
+  if (!cholesky(gram(Z, AZ, comm_), L)) return;
+
+  // C = L^{-1} (Z^T Z) L^{-T}
+  mfem::DenseMatrix C = gram(Z, Z, comm_);
+  for (int col = 0; col < n; col++) {
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < i; j++) C(i, col) -= L(i, j) * C(j, col);
+      C(i, col) /= L(i, i);
+    }
+  }
+  for (int row = 0; row < n; row++) {
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < i; j++) C(row, i) -= L(i, j) * C(row, j);
+      C(row, i) /= L(i, i);
+    }
+  }
+
+  mfem::Vector      lambda;
+  mfem::DenseMatrix V;
+  symmetricEigensystem(C, lambda, V);
+
+  std::vector<int> order(size_t(n));
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return lambda(a) > lambda(b); });
+
+  // the coefficients Y = L^{-T} V of the Ritz vectors, which are A-orthonormal: Y^T (Z^T A Z) Y = I
+  std::vector<mfem::Vector> W(size_t(k)), AW(size_t(k));
+  for (int j = 0; j < k; j++) {
+    mfem::Vector y(n);
+    for (int i = n - 1; i >= 0; i--) {
+      double v = V(i, order[size_t(j)]);
+      for (int l = i + 1; l < n; l++) v -= L(l, i) * y(l);
+      y(i) = v / L(i, i);
+    }
+
+    W[size_t(j)].SetSize(Z[0]->Size());
+    AW[size_t(j)].SetSize(Z[0]->Size());
+    W[size_t(j)]  = 0.0;
+    AW[size_t(j)] = 0.0;
+    for (int i = 0; i < n; i++) {
+      W[size_t(j)].Add(y(i), *Z[size_t(i)]);
+      AW[size_t(j)].Add(y(i), *AZ[size_t(i)]);
+    }
+  }
+
+  W_  = std::move(W);
+  AW_ = std::move(AW);
+}
+
+void RecyclingCGSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  updateImage();
+
+  const int         n = b.Size();
+  const std::size_t k = W_.size();
+
+  mfem::Vector r(n), z(n), p(n), Ap(n);
+  if (iterative_mode) {
+    oper->Mult(x, r);
+    subtract(b, r, r);
+  } else {
+    x = 0.0;
+    r = b;
+  }
+
+  // start from the Galerkin projection onto the recycled subspace, so that W^T r = 0
+  if (k > 0) {
+    std::vector<double> c(k);
+    for (std::size_t i = 0; i < k; i++) c[i] = W_[i] * r;
+    MPI_Allreduce(MPI_IN_PLACE, c.data(), int(k), MPI_DOUBLE, MPI_SUM, comm_);
+    for (std::size_t i = 0; i < k; i++) {
+      x.Add(c[i], W_[i]);
+      r.Add(-c[i], AW_[i]);
+    }
+  }
+
+  // (r, z) and the coefficients (A W)^T z of the deflation, in a single reduction
+  std::vector<double> reduced(k + 1);
+  auto                reduce = [&]() {
+    reduced[0] = r * z;
+    for (std::size_t i = 0; i < k; i++) reduced[i + 1] = AW_[i] * z;
+    MPI_Allreduce(MPI_IN_PLACE, reduced.data(), int(k + 1), MPI_DOUBLE, MPI_SUM, comm_);
+    return reduced[0];
+  };
+
+  // the new search direction z + beta p, made A-orthogonal to W
+  auto deflate = [&]() {
+    for (std::size_t i = 0; i < k; i++) p.Add(-reduced[i + 1], W_[i]);
+  };
+
+  precondition(r, z);
+  double gamma = reduce();
+  p            = z;
+  deflate();
+
+  initial_norm = std::sqrt(std::abs(gamma));
+  final_norm   = initial_norm;
+  double stop  = std::max(rel_tol * initial_norm, abs_tol);
+
+  std::vector<mfem::Vector> P, AP;
+  const std::size_t         max_stored = 2 * std::size_t(std::max(recycle_dimension_, 0));
+
+  converged = false;
+  for (int i = 0;; i++) {
+    final_iter = i;
+    if (final_norm <= stop) {
+      converged = true;
+      break;
+    }
+    if (i >= max_iter) break;
+
+    oper->Mult(p, Ap);
+    double pAp = Dot(p, Ap);
+    if (pAp <= 0.0) {
+      SLIC_WARNING_ROOT("Recycling CG: operator is not positive definite");
+      break;
+    }
+
+    if (P.size() < max_stored) {
+      P.emplace_back(p);
+      AP.emplace_back(Ap);
+      P.back() /= std::sqrt(pAp);
+      AP.back() /= std::sqrt(pAp);
+    }
+
+    double alpha = gamma / pAp;
+    x.Add(alpha, p);
+    r.Add(-alpha, Ap);
+
+    precondition(r, z);
+    double gamma_new = reduce();
+    final_norm       = std::sqrt(std::abs(gamma_new));
+
+    if (print_options.iterations) {
+      mfem::out << "   Iteration : " << std::setw(3) << i + 1 << "  (B r, r) = " << gamma_new << '\n';
+    }
+
+    add(z, gamma_new / gamma, p, p);
+    deflate();
+    gamma = gamma_new;
+  }
+
+  if (print_options.summary || (print_options.warnings && !converged)) {
+    mfem::out << "Recycling PCG: Number of iterations: " << final_iter << ", recycled dimension: " << k << '\n';
+  }
+
+  if (recycle_dimension_ > 0) {
+    updateSubspace(P, AP);
+  }
+}
+
+SparsityPattern::SparsityPattern(const mfem::HypreParMatrix& A) : initialized_(true)
+{
+  A.HostRead();
+
+  hypre_ParCSRMatrix* a = A;
+  sizes_ = {A.Height(), A.Width(), A.M(), A.N()};
+
+  int k = 0;
+  for (hypre_CSRMatrix* block : {hypre_ParCSRMatrixDiag(a), hypre_ParCSRMatrixOffd(a)}) {
+    auto rows = hypre_CSRMatrixNumRows(block);
+    auto nnz  = hypre_CSRMatrixNumNonzeros(block);
+    csr_[k++].assign(hypre_CSRMatrixI(block), hypre_CSRMatrixI(block) + rows + 1);
+    csr_[k++].assign(hypre_CSRMatrixJ(block), hypre_CSRMatrixJ(block) + nnz);
+  }
+
+  auto num_cols_offd = hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(a));
+  col_map_offd_.assign(hypre_ParCSRMatrixColMapOffd(a), hypre_ParCSRMatrixColMapOffd(a) + num_cols_offd);
+}
+
+bool SparsityPattern::matches(const mfem::HypreParMatrix& A) const
+{
+  auto local_match = [&]() {
+    if (!initialized_) return false;
+
+    hypre_ParCSRMatrix* a = A;
+    if (sizes_ != std::array<HYPRE_BigInt, 4>{A.Height(), A.Width(), A.M(), A.N()}) return false;
+
+    int k = 0;
+    for (hypre_CSRMatrix* block : {hypre_ParCSRMatrixDiag(a), hypre_ParCSRMatrixOffd(a)}) {
+      auto rows = hypre_CSRMatrixNumRows(block);
+      auto nnz  = hypre_CSRMatrixNumNonzeros(block);
+      if (csr_[k].size() != std::size_t(rows + 1) || csr_[k + 1].size() != std::size_t(nnz) ||
+          !std::equal(csr_[k].begin(), csr_[k].end(), hypre_CSRMatrixI(block)) ||
+          !std::equal(csr_[k + 1].begin(), csr_[k + 1].end(), hypre_CSRMatrixJ(block))) {
+        return false;
+      }
+      k += 2;
+    }
+
+    auto num_cols_offd = hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(a));
+    return col_map_offd_.size() == std::size_t(num_cols_offd) &&
+           std::equal(col_map_offd_.begin(), col_map_offd_.end(), hypre_ParCSRMatrixColMapOffd(a));
+  };
+
+  A.HostRead();
+
+  // the factorization is collective, so every rank has to agree on whether it can be reused
+  int match = local_match();
+  MPI_Allreduce(MPI_IN_PLACE, &match, 1, MPI_INT, MPI_LAND, A.GetComm());
+  return match;
 }
 
 void SuperLUSolver::Mult(const mfem::Vector& input, mfem::Vector& output) const
@@ -730,17 +1958,31 @@ void SuperLUSolver::SetOperator(const mfem::Operator& op)
   if (block_operator) {
     auto monolithic_mat = buildMonolithicMatrix(*block_operator);
 
-    superlu_mat_ = std::make_unique<mfem::SuperLURowLocMatrix>(*monolithic_mat);
+    setMatrix(*monolithic_mat);
   } else {
     // If this is not a block system, check that the input operator is a HypreParMatrix as expected
     auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
 
     SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with SuperLU");
 
-    superlu_mat_ = std::make_unique<mfem::SuperLURowLocMatrix>(*matrix);
+    setMatrix(*matrix);
   }
+}
 
+void SuperLUSolver::setMatrix(const mfem::HypreParMatrix& matrix)
+{
+  bool same_pattern = pattern_.matches(matrix);
+
+  superlu_mat_ = std::make_unique<mfem::SuperLURowLocMatrix>(matrix);
+
+  // the permutations and symbolic factorization only depend on the sparsity pattern (and for the
+  // row permutation, weakly on the values), so Newton iterations only need a numeric refactorization
+  superlu_solver_.SetFact(same_pattern ? mfem::superlu::SamePattern_SameRowPerm : mfem::superlu::DOFACT);
   superlu_solver_.SetOperator(*superlu_mat_);
+
+  if (!same_pattern) {
+    pattern_ = SparsityPattern(matrix);
+  }
 }
 
 #ifdef MFEM_USE_STRUMPACK
@@ -762,17 +2004,95 @@ void StrumpackSolver::SetOperator(const mfem::Operator& op)
   if (block_operator) {
     auto monolithic_mat = buildMonolithicMatrix(*block_operator);
 
-    strumpack_mat_ = std::make_unique<mfem::STRUMPACKRowLocMatrix>(*monolithic_mat);
+    setMatrix(*monolithic_mat);
   } else {
     // If this is not a block system, check that the input operator is a HypreParMatrix as expected
     auto* matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
 
     SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with Strumpack");
 
-    strumpack_mat_ = std::make_unique<mfem::STRUMPACKRowLocMatrix>(*matrix);
+    setMatrix(*matrix);
   }
+}
+
+void StrumpackSolver::setMatrix(const mfem::HypreParMatrix& matrix)
+{
+  bool same_pattern = pattern_.matches(matrix);
+
+  strumpack_mat_ = std::make_unique<mfem::STRUMPACKRowLocMatrix>(matrix);
 
+  // with an unchanged pattern, STRUMPACK only updates the matrix values and skips the reordering
+  strumpack_solver_.SetReorderingReuse(same_pattern);
   strumpack_solver_.SetOperator(*strumpack_mat_);
+
+  if (!same_pattern) {
+    pattern_ = SparsityPattern(matrix);
+  }
+}
+
+#endif
+
+#ifdef MFEM_USE_PETSC
+
+PetscPCSolver::PetscPCSolver(bool bddc, MPI_Comm comm) : bddc_(bddc), comm_(comm)
+{
+  PetscBool initialized = PETSC_FALSE;
+  PetscInitialized(&initialized);
+  if (!initialized) {
+    mfem::MFEMInitializePetsc();
+  }
+}
+
+void PetscPCSolver::setOptions(const std::string& options, const std::string& prefix)
+{
+  prefix_ = prefix;
+  if (options.empty()) {
+    return;
+  }
+
+  PetscErrorCode error = 0;
+  if (!prefix.empty()) {
+    error = PetscOptionsPrefixPush(nullptr, prefix.c_str());
+  }
+  error = error ? error : PetscOptionsInsertString(nullptr, options.c_str());
+  if (!prefix.empty()) {
+    error = error ? error : PetscOptionsPrefixPop(nullptr);
+  }
+  SLIC_ERROR_ROOT_IF(error, axom::fmt::format("Invalid PETSc options: '{0}'", options));
+}
+
+void PetscPCSolver::Mult(const mfem::Vector& input, mfem::Vector& output) const
+{
+  SLIC_ERROR_ROOT_IF(!preconditioner_, "Operator must be set prior to applying a PETSc preconditioner");
+
+  preconditioner_->Mult(input, output);
+}
+
+void PetscPCSolver::SetOperator(const mfem::Operator& op)
+{
+  height = op.Height();
+  width  = op.Width();
+
+  // block systems are preconditioned as a single matrix, which fieldsplit preconditioners can split up again
+  std::unique_ptr<mfem::HypreParMatrix> monolithic;
+  const auto*                           matrix = dynamic_cast<const mfem::HypreParMatrix*>(&op);
+  if (auto* block_operator = dynamic_cast<const mfem::BlockOperator*>(&op)) {
+    monolithic = buildMonolithicMatrix(*block_operator);
+    matrix     = monolithic.get();
+  }
+  SLIC_ERROR_ROOT_IF(!matrix, "Matrix must be an assembled HypreParMatrix for use with PETSc preconditioners");
+
+  // the preconditioner keeps a reference to its matrix, so it is released first
+  preconditioner_.reset();
+  auto format   = bddc_ ? mfem::Operator::PETSC_MATIS : mfem::Operator::PETSC_MATAIJ;
+  petsc_matrix_ = std::make_unique<mfem::PetscParMatrix>(matrix, format);
+
+  if (bddc_) {
+    preconditioner_ = std::make_unique<mfem::PetscBDDCSolver>(comm_, *petsc_matrix_, mfem::PetscBDDCSolverParams{},
+                                                              prefix_);
+  } else {
+    preconditioner_ = std::make_unique<mfem::PetscPreconditioner>(comm_, *petsc_matrix_, prefix_);
+  }
 }
 
 #endif
@@ -783,17 +2103,25 @@ std::unique_ptr<mfem::NewtonSolver> buildNonlinearSolver(const NonlinearSolverOp
 {
   std::unique_ptr<mfem::NewtonSolver> nonlinear_solver;
 
+  SLIC_ERROR_ROOT_IF(nonlinear_opts.linear && nonlinear_opts.nonlin_solver != NonlinearSolver::Newton &&
+                         nonlinear_opts.nonlin_solver != NonlinearSolver::NewtonLineSearch,
+                     "Linear problems are only supported by the Newton and NewtonLineSearch solvers");
+
   if (nonlinear_opts.nonlin_solver == NonlinearSolver::Newton) {
     SLIC_ERROR_ROOT_IF(nonlinear_opts.min_iterations != 0 || nonlinear_opts.max_line_search_iterations != 0,
                        "Newton's method does not support nonzero min_iterations or max_line_search_iterations");
-    nonlinear_solver = std::make_unique<NewtonSolver>(comm, nonlinear_opts);
+    nonlinear_solver = std::make_unique<NewtonSolver>(comm, nonlinear_opts, linear_opts);
     // nonlinear_solver = std::make_unique<mfem::NewtonSolver>(comm);
   } else if (nonlinear_opts.nonlin_solver == NonlinearSolver::LBFGS) {
     SLIC_ERROR_ROOT_IF(nonlinear_opts.min_iterations != 0 || nonlinear_opts.max_line_search_iterations != 0,
                        "LBFGS does not support nonzero min_iterations or max_line_search_iterations");
     nonlinear_solver = std::make_unique<mfem::LBFGSSolver>(comm);
   } else if (nonlinear_opts.nonlin_solver == NonlinearSolver::NewtonLineSearch) {
-    nonlinear_solver = std::make_unique<NewtonSolver>(comm, nonlinear_opts);
+    nonlinear_solver = std::make_unique<NewtonSolver>(comm, nonlinear_opts, linear_opts);
+  } else if (nonlinear_opts.nonlin_solver == NonlinearSolver::AndersonNewton) {
+    SLIC_ERROR_ROOT_IF(nonlinear_opts.max_line_search_iterations != 0,
+                       "Anderson-accelerated Newton does not support nonzero max_line_search_iterations");
+    nonlinear_solver = std::make_unique<AndersonNewtonSolver>(comm, nonlinear_opts, linear_opts);
   } else if (nonlinear_opts.nonlin_solver == NonlinearSolver::TrustRegion) {
     nonlinear_solver = std::make_unique<TrustRegion>(comm, nonlinear_opts, linear_opts, prec);
   }
@@ -843,7 +2171,24 @@ std::unique_ptr<mfem::NewtonSolver> buildNonlinearSolver(const NonlinearSolverOp
 std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLinearSolverAndPreconditioner(
     LinearSolverOptions linear_opts, MPI_Comm comm)
 {
-  auto preconditioner = buildPreconditioner(linear_opts.preconditioner, linear_opts.preconditioner_print_level, comm);
+  if (linear_opts.matrix_free) {
+    bool direct = (linear_opts.linear_solver == LinearSolver::SuperLU) ||
+                  (linear_opts.linear_solver == LinearSolver::Strumpack);
+    SLIC_ERROR_ROOT_IF(direct, "Matrix-free linear solves require an iterative linear solver");
+
+    bool assembled_preconditioner = (linear_opts.preconditioner != Preconditioner::Jacobi) &&
+                                    (linear_opts.preconditioner != Preconditioner::Chebyshev) &&
+                                    (linear_opts.preconditioner != Preconditioner::GeometricMultigrid) &&
+                                    (linear_opts.preconditioner != Preconditioner::PMultigrid) &&
+                                    (linear_opts.preconditioner != Preconditioner::LOR) &&
+                                    (linear_opts.preconditioner != Preconditioner::None);
+    SLIC_ERROR_ROOT_IF(
+        assembled_preconditioner,
+        "Matrix-free linear solves require the Jacobi, Chebyshev, GeometricMultigrid, PMultigrid, LOR, or None "
+        "preconditioner");
+  }
+
+  auto preconditioner = buildPreconditioner(linear_opts, comm);
 
   if (linear_opts.linear_solver == LinearSolver::SuperLU) {
     auto lin_solver = std::make_unique<SuperLUSolver>(linear_opts.print_level, comm);
@@ -865,6 +2210,12 @@ std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLin
     case LinearSolver::CG:
       iter_lin_solver = std::make_unique<mfem::CGSolver>(comm);
       break;
+    case LinearSolver::PipelinedCG:
+      iter_lin_solver = std::make_unique<PipelinedCGSolver>(comm);
+      break;
+    case LinearSolver::RecyclingCG:
+      iter_lin_solver = std::make_unique<RecyclingCGSolver>(comm, linear_opts.recycle_dimension);
+      break;
     case LinearSolver::GMRES:
       iter_lin_solver = std::make_unique<mfem::GMRESSolver>(comm);
       break;
@@ -967,6 +2318,35 @@ std::unique_ptr<mfem::Solver> buildPreconditioner(Preconditioner preconditioner,
     ilu_preconditioner->SetLevelOfFill(1);
     ilu_preconditioner->SetPrintLevel(print_level);
     preconditioner_solver = std::move(ilu_preconditioner);
+  } else if (preconditioner == Preconditioner::Jacobi) {
+    preconditioner_solver = std::make_unique<mfem::OperatorJacobiSmoother>();
+  } else if (preconditioner == Preconditioner::Chebyshev) {
+    constexpr int chebyshev_order = 2;
+    preconditioner_solver         = std::make_unique<ChebyshevPreconditioner>(chebyshev_order, comm);
+  } else if (preconditioner == Preconditioner::GeometricMultigrid) {
+    constexpr int chebyshev_order = 2;
+    preconditioner_solver = std::make_unique<GeometricMultigridPreconditioner>(chebyshev_order, print_level, comm);
+  } else if (preconditioner == Preconditioner::PMultigrid) {
+    constexpr int chebyshev_order = 2;
+    preconditioner_solver = std::make_unique<PMultigridPreconditioner>(chebyshev_order, print_level, comm);
+  } else if (preconditioner == Preconditioner::LOR) {
+    preconditioner_solver = std::make_unique<LORPreconditioner>(print_level);
+  } else if (preconditioner == Preconditioner::BlockSchur) {
+    preconditioner_solver = std::make_unique<BlockSchurPreconditioner>(print_level);
+  } else if (preconditioner == Preconditioner::SuperLU) {
+    preconditioner_solver = std::make_unique<SuperLUSolver>(print_level, comm);
+  } else if (preconditioner == Preconditioner::Strumpack) {
+#ifdef MFEM_USE_STRUMPACK
+    preconditioner_solver = std::make_unique<StrumpackSolver>(print_level, comm);
+#else
+    SLIC_ERROR_ROOT("Strumpack preconditioner requested in a build without Strumpack");
+#endif
+  } else if (preconditioner == Preconditioner::PetscBDDC || preconditioner == Preconditioner::Petsc) {
+#ifdef MFEM_USE_PETSC
+    preconditioner_solver = std::make_unique<PetscPCSolver>(preconditioner == Preconditioner::PetscBDDC, comm);
+#else
+    SLIC_ERROR_ROOT("PETSc preconditioner requested in a build without PETSc");
+#endif
   } else if (preconditioner == Preconditioner::AMGX) {
 #ifdef MFEM_USE_AMGX
     preconditioner_solver = buildAMGX(AMGXOptions{}, comm);
@@ -980,6 +2360,99 @@ std::unique_ptr<mfem::Solver> buildPreconditioner(Preconditioner preconditioner,
   return preconditioner_solver;
 }
 
+std::unique_ptr<mfem::Solver> buildPreconditioner(const LinearSolverOptions& linear_opts, MPI_Comm comm)
+{
+  auto preconditioner = buildPreconditioner(linear_opts.preconditioner, linear_opts.preconditioner_print_level, comm);
+
+  if (auto* amg = dynamic_cast<mfem::HypreBoomerAMG*>(preconditioner.get())) {
+    if (linear_opts.amg_aggressive_coarsening_levels > 0) {
+      amg->SetAggressiveCoarsening(linear_opts.amg_aggressive_coarsening_levels);
+    }
+  }
+
+#ifdef MFEM_USE_PETSC
+  if (auto* petsc = dynamic_cast<PetscPCSolver*>(preconditioner.get())) {
+    petsc->setOptions(linear_opts.petsc_options, linear_opts.petsc_prefix);
+  }
+#endif
+
+  if (preconditioner && linear_opts.max_preconditioner_reuse > 0) {
+    return std::make_unique<ReusablePreconditioner>(std::move(preconditioner), linear_opts.max_preconditioner_reuse);
+  }
+
+  return preconditioner;
+}
+
+RigidBodyModes::RigidBodyModes(mfem::ParFiniteElementSpace& space)
+{
+  const int dim = space.GetParMesh()->SpaceDimension();
+  SLIC_ERROR_ROOT_IF(space.GetVDim() != dim, "rigid body modes are only defined for displacement-like spaces");
+
+  // the rotations about each coordinate axis (just the one about z in 2D)
+  std::vector<std::function<void(const mfem::Vector&, mfem::Vector&)>> rotations;
+  if (dim == 2) {
+    rotations.push_back([](const mfem::Vector& x, mfem::Vector& u) {
+      u(0) = -x(1);
+      u(1) = x(0);
+    });
+  } else {
+    rotations.push_back([](const mfem::Vector& x, mfem::Vector& u) {
+      u(0) = 0.0;
+      u(1) = -x(2);
+      u(2) = x(1);
+    });
+    rotations.push_back([](const mfem::Vector& x, mfem::Vector& u) {
+      u(0) = x(2);
+      u(1) = 0.0;
+      u(2) = -x(0);
+    });
+    rotations.push_back([](const mfem::Vector& x, mfem::Vector& u) {
+      u(0) = -x(1);
+      u(1) = x(0);
+      u(2) = 0.0;
+    });
+  }
+
+  mfem::ParGridFunction mode(&space);
+  for (auto& rotation : rotations) {
+    mfem::VectorFunctionCoefficient coefficient(dim, rotation);
+    mode.ProjectCoefficient(coefficient);
+
+    modes_.emplace_back(space.NewTrueDofVector());
+    mode.ParallelProject(*modes_.back());
+    handles_.push_back(*modes_.back());
+  }
+}
+
+std::unique_ptr<RigidBodyModes> setElasticityOptions(mfem::HypreBoomerAMG& amg, mfem::ParFiniteElementSpace& space)
+{
+  const int dim = space.GetVDim();
+  amg.SetSystemsOptions(dim, space.GetOrdering() == mfem::Ordering::byNODES);
+
+  auto modes = std::make_unique<RigidBodyModes>(space);
+
+  // the options recommended for elasticity in mfem::HypreBoomerAMG::SetElasticityOptions
+  constexpr int nodal                 = 4;
+  constexpr int nodal_diag            = 1;
+  constexpr int relax_coarse          = 8;
+  constexpr int interp_vec_variant    = 2;
+  constexpr int q_max                 = 4;
+  constexpr int smooth_interp_vectors = 1;
+
+  HYPRE_Solver solver = amg;
+  HYPRE_BoomerAMGSetAggNumLevels(solver, 0);
+  HYPRE_BoomerAMGSetStrongThreshold(solver, 0.5);
+  HYPRE_BoomerAMGSetNodal(solver, nodal);
+  HYPRE_BoomerAMGSetNodalDiag(solver, nodal_diag);
+  HYPRE_BoomerAMGSetCycleRelaxType(solver, relax_coarse, 3);
+  HYPRE_BoomerAMGSetInterpVecVariant(solver, interp_vec_variant);
+  HYPRE_BoomerAMGSetInterpVecQMax(solver, q_max);
+  HYPRE_BoomerAMGSetSmoothInterpVectors(solver, smooth_interp_vectors);
+  HYPRE_BoomerAMGSetInterpVectors(solver, modes->size(), modes->data());
+
+  return modes;
+}
+
 void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
 {
   auto& linear_container = container.addStruct("linear", "Linear Equation Solver Parameters");
@@ -1002,9 +2475,22 @@ void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
   iterative_container.addDouble("abs_tol", "Absolute tolerance for the linear solve.").defaultValue(1.0e-8);
   iterative_container.addInt("max_iter", "Maximum iterations for the linear solve.").defaultValue(5000);
   iterative_container.addInt("print_level", "Linear print level.").defaultValue(0);
-  iterative_container.addString("solver_type", "Solver type (gmres|minres|cg).").defaultValue("gmres");
-  iterative_container.addString("prec_type", "Preconditioner type (JacobiSmoother|L1JacobiSmoother|AMG|ILU).")
+  iterative_container.addString("solver_type", "Solver type (gmres|minres|cg|pipelinedcg|recyclingcg).")
+      .defaultValue("gmres");
+  iterative_container
+      .addString("prec_type",
+                 "Preconditioner type "
+                 "(JacobiSmoother|L1JacobiSmoother|AMG|ILU|GaussSeidel|Jacobi|Chebyshev|GeometricMultigrid|"
+                 "PMultigrid|LOR|BlockSchur|SuperLU|Strumpack|PetscBDDC|Petsc).")
       .defaultValue("JacobiSmoother");
+  iterative_container
+      .addString("petsc_options", "Options of the PETSc preconditioners, in PETSc's command line format.")
+      .defaultValue("");
+  iterative_container.addString("petsc_prefix", "Prefix of the PETSc preconditioner options.").defaultValue("");
+  iterative_container.addBool("matrix_free", "Keep the linearized operator unassembled.").defaultValue(false);
+  iterative_container
+      .addBool("static_condensation", "Eliminate the element-interior dofs from the linearized operator.")
+      .defaultValue(false);
 
   auto& direct_container = linear_container.addStruct("direct_options", "Direct solver parameters");
   direct_container.addInt("print_level", "Linear print level.").defaultValue(0);
@@ -1015,7 +2501,8 @@ void EquationSolver::defineInputFileSchema(axom::inlet::Container& container)
   nonlinear_container.addDouble("abs_tol", "Absolute tolerance for the Newton solve.").defaultValue(1.0e-4);
   nonlinear_container.addInt("max_iter", "Maximum iterations for the Newton solve.").defaultValue(500);
   nonlinear_container.addInt("print_level", "Nonlinear print level.").defaultValue(0);
-  nonlinear_container.addString("solver_type", "Solver type (Newton|KINFullStep|KINLineSearch)").defaultValue("Newton");
+  nonlinear_container.addString("solver_type", "Solver type (Newton|AndersonNewton|KINFullStep|KINLineSearch)")
+      .defaultValue("Newton");
 }
 
 }  // namespace serac
@@ -1040,11 +2527,19 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
   options.absolute_tol    = config["abs_tol"];
   options.max_iterations  = config["max_iter"];
   options.print_level     = config["print_level"];
-  std::string solver_type = config["solver_type"];
+  options.matrix_free         = config["matrix_free"];
+  options.static_condensation = config["static_condensation"];
+  options.petsc_options       = config["petsc_options"].get<std::string>();
+  options.petsc_prefix        = config["petsc_prefix"].get<std::string>();
+  std::string solver_type     = config["solver_type"];
   if (solver_type == "gmres") {
     options.linear_solver = serac::LinearSolver::GMRES;
   } else if (solver_type == "cg") {
     options.linear_solver = serac::LinearSolver::CG;
+  } else if (solver_type == "pipelinedcg") {
+    options.linear_solver = serac::LinearSolver::PipelinedCG;
+  } else if (solver_type == "recyclingcg") {
+    options.linear_solver = serac::LinearSolver::RecyclingCG;
   } else {
     std::string msg = axom::fmt::format("Unknown Linear solver type given: '{0}'", solver_type);
     SLIC_ERROR_ROOT(msg);
@@ -1064,6 +2559,26 @@ serac::LinearSolverOptions FromInlet<serac::LinearSolverOptions>::operator()(con
 #endif
   } else if (prec_type == "GaussSeidel") {
     options.preconditioner = serac::Preconditioner::HypreGaussSeidel;
+  } else if (prec_type == "Jacobi") {
+    options.preconditioner = serac::Preconditioner::Jacobi;
+  } else if (prec_type == "Chebyshev") {
+    options.preconditioner = serac::Preconditioner::Chebyshev;
+  } else if (prec_type == "GeometricMultigrid") {
+    options.preconditioner = serac::Preconditioner::GeometricMultigrid;
+  } else if (prec_type == "PMultigrid") {
+    options.preconditioner = serac::Preconditioner::PMultigrid;
+  } else if (prec_type == "LOR") {
+    options.preconditioner = serac::Preconditioner::LOR;
+  } else if (prec_type == "BlockSchur") {
+    options.preconditioner = serac::Preconditioner::BlockSchur;
+  } else if (prec_type == "SuperLU") {
+    options.preconditioner = serac::Preconditioner::SuperLU;
+  } else if (prec_type == "Strumpack") {
+    options.preconditioner = serac::Preconditioner::Strumpack;
+  } else if (prec_type == "PetscBDDC") {
+    options.preconditioner = serac::Preconditioner::PetscBDDC;
+  } else if (prec_type == "Petsc") {
+    options.preconditioner = serac::Preconditioner::Petsc;
   } else {
     std::string msg = axom::fmt::format("Unknown preconditioner type given: '{0}'", prec_type);
     SLIC_ERROR_ROOT(msg);
@@ -1082,6 +2597,8 @@ serac::NonlinearSolverOptions FromInlet<serac::NonlinearSolverOptions>::operator
   const std::string solver_type = base["solver_type"];
   if (solver_type == "Newton") {
     options.nonlin_solver = serac::NonlinearSolver::Newton;
+  } else if (solver_type == "AndersonNewton") {
+    options.nonlin_solver = serac::NonlinearSolver::AndersonNewton;
   } else if (solver_type == "KINFullStep") {
     options.nonlin_solver = serac::NonlinearSolver::KINFullStep;
   } else if (solver_type == "KINLineSearch") {
@@ -12,9 +12,11 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <optional>
 #include <variant>
+#include <vector>
 
 #include "mfem.hpp"
 
@@ -23,6 +25,40 @@
 
 namespace serac {
 
+/**
+ * @brief What the last nonlinear solve of an EquationSolver did, and where its time went
+ *
+ * The counters and times are filled in by serac's own nonlinear solvers (Newton, Anderson-Newton and the trust
+ * region). Other solvers, like KINSOL or PETSc SNES, only report the iteration count, the residual norms and the
+ * total time.
+ */
+struct SolverTelemetry {
+  /// the number of nonlinear iterations taken
+  int nonlinear_iterations = 0;
+  /// the number of line search (or trust region) cutbacks, over all nonlinear iterations
+  int line_search_cutbacks = 0;
+  /// the number of times the Jacobian was assembled
+  int jacobian_assemblies = 0;
+  /// the number of preconditioner setups
+  int preconditioner_setups = 0;
+  /// the number of linear solves
+  int linear_solves = 0;
+  /// the number of Krylov iterations, over all linear solves
+  int linear_iterations = 0;
+  /// whether the nonlinear solve converged
+  bool converged = false;
+  /// the wall time spent assembling Jacobians, in seconds
+  double assembly_time = 0.0;
+  /// the wall time spent setting up the preconditioner, in seconds
+  double preconditioner_time = 0.0;
+  /// the wall time spent in linear solves, in seconds
+  double linear_solve_time = 0.0;
+  /// the wall time of the whole nonlinear solve, in seconds
+  double solve_time = 0.0;
+  /// the residual norm of each nonlinear iterate, starting from the initial guess
+  std::vector<double> residual_norms;
+};
+
 /**
  * @brief This class manages the objects typically required to solve a nonlinear set of equations arising from
  * discretization of a PDE of the form F(x) = 0. Specifically, it has
@@ -80,6 +116,22 @@ public:
    */
   void solve(mfem::Vector& x) const;
 
+  /**
+   * Declares whether the Jacobian and preconditioner from the last solve are still exact for the next one, e.g.
+   * because the residual is linear and its coefficients are unchanged, so that its first Newton iteration reuses them
+   * @param[in] current Whether the first iteration of the next solve may skip assembling the Jacobian
+   * @note This only affects NonlinearSolver::Newton, NewtonLineSearch and AndersonNewton, and later iterations still
+   * assemble a new Jacobian when one is needed
+   */
+  void setJacobianCurrent(bool current);
+
+  /**
+   * Whether the nonlinear solver will probably assemble the Jacobian at the point of the residual it is evaluating,
+   * so that the operator may compute (and keep) the derivatives of the residual along with its value
+   * @note This is only ever true during residual evaluations of NonlinearSolver::Newton and NewtonLineSearch
+   */
+  bool jacobianExpected() const;
+
   /**
    * Returns the underlying solver object
    * @return A non-owning reference to the underlying nonlinear solver
@@ -114,6 +166,37 @@ public:
    */
   const mfem::Solver& preconditioner() const { return *preconditioner_; }
 
+  /**
+   * Returns the iteration counts, timings and residual history of the last call to solve()
+   * @return A reference to the telemetry of the last solve
+   */
+  const SolverTelemetry& telemetry() const { return telemetry_; }
+
+  /**
+   * Returns whether the linearized operators should be left unassembled
+   * @return true if the linear solver options requested a matrix-free linear solve
+   */
+  bool matrixFree() const { return matrix_free_; }
+
+  /**
+   * Returns whether the preconditioner of matrix-free linear solves is built from the diagonal of the linearized
+   * operators (i.e. the Jacobi, Chebyshev and multigrid preconditioners, whose smoothers scale by it)
+   * @return true if the linearized operators have to provide mfem::Operator::AssembleDiagonal()
+   */
+  bool preconditionerUsesDiagonal() const { return preconditioner_uses_diagonal_; }
+
+  /**
+   * Returns whether the element-interior dofs of the linearized operators should be eliminated
+   * @return true if the linear solver options requested static condensation, see StaticCondensationSolver
+   */
+  bool staticCondensation() const { return static_condensation_; }
+
+  /**
+   * Returns whether the residual was declared linear, see NonlinearSolverOptions::linear
+   * @return true if each solve is a single linear solve, and the Jacobian may be reused while it is unchanged
+   */
+  bool linear() const { return linear_; }
+
   /**
    * Input file parameters specific to this class
    **/
@@ -141,6 +224,176 @@ private:
    * before SetSolver
    */
   bool nonlin_solver_set_solver_called_ = false;
+
+  /**
+   * @brief Whether the linearized operators should be left unassembled
+   * @see LinearSolverOptions::matrix_free
+   */
+  bool matrix_free_ = false;
+
+  /**
+   * @brief Whether the preconditioner of matrix-free linear solves uses the diagonal of the linearized operators
+   * @see preconditionerUsesDiagonal()
+   */
+  bool preconditioner_uses_diagonal_ = false;
+
+  /**
+   * @brief Whether the element-interior dofs of the linearized operators should be eliminated
+   * @see LinearSolverOptions::static_condensation
+   */
+  bool static_condensation_ = false;
+
+  /**
+   * @brief Whether the residual was declared linear
+   * @see NonlinearSolverOptions::linear
+   */
+  bool linear_ = false;
+
+  /**
+   * @brief The telemetry of the last call to solve()
+   */
+  mutable SolverTelemetry telemetry_;
+};
+
+/**
+ * @brief The pipelined preconditioned conjugate gradient method of Ghysels and Vanroose
+ *
+ * Mathematically equivalent to mfem::CGSolver, but each iteration needs a single global reduction (of the
+ * inner products of the next step), which is started with a nonblocking MPI_Iallreduce and completes while the
+ * preconditioner and operator are applied. This hides the reduction latency on large numbers of ranks, at the
+ * cost of a few more vector updates per iteration and a slightly less stable recurrence.
+ *
+ * Convergence is measured in the preconditioned norm sqrt(r . M r), the same as mfem::CGSolver.
+ */
+class PipelinedCGSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Construct the solver
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  explicit PipelinedCGSolver(MPI_Comm comm) : mfem::IterativeSolver(comm), comm_(comm) {}
+
+  /**
+   * @brief Solve A x = b
+   * @param[in] b the right hand side
+   * @param[inout] x the solution, and the initial guess if iterative_mode is set
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /// @brief apply the preconditioner (or the identity, if there is none)
+  void precondition(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /// @brief The MPI communicator used for the reductions
+  MPI_Comm comm_;
+};
+
+/**
+ * @brief A deflated preconditioned conjugate gradient method that recycles a subspace between solves
+ *
+ * The solver keeps an A-orthonormal basis W of approximate eigenvectors of the smallest eigenvalues of the operator
+ * (Ritz vectors, from the previous subspace and the first search directions of the previous solve). Each solve
+ * starts from the Galerkin projection of the initial guess onto W, and keeps its search directions A-orthogonal to W,
+ * which removes those eigenvalues from the convergence rate. This pays off for sequences of nearly identical
+ * operators, e.g. Newton iterations and quasi-static load steps. When the operator changes, A W is recomputed
+ * (one operator application per basis vector) and W is re-orthonormalized.
+ *
+ * See Saad, Yeung, Erhel and Guyomarc'h, "A deflated version of the conjugate gradient algorithm" (2000).
+ */
+class RecyclingCGSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Construct the solver
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   * @param[in] recycle_dimension The number of vectors kept between solves
+   */
+  RecyclingCGSolver(MPI_Comm comm, int recycle_dimension)
+      : mfem::IterativeSolver(comm), comm_(comm), recycle_dimension_(recycle_dimension)
+  {
+  }
+
+  /**
+   * @brief Set the operator, marking the image A W of the recycled subspace as out of date
+   * @param[in] op the new operator, which must be symmetric positive definite
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Solve A x = b, then update the recycled subspace
+   * @param[in] b the right hand side
+   * @param[inout] x the solution, and the initial guess if iterative_mode is set
+   */
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+  /// @brief The number of vectors currently in the recycled subspace
+  int recycledDimension() const { return static_cast<int>(W_.size()); }
+
+private:
+  /// @brief apply the preconditioner (or the identity, if there is none)
+  void precondition(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /// @brief recompute A W for a new operator, and make W A-orthonormal again
+  void updateImage() const;
+
+  /**
+   * @brief replace W by the Ritz vectors of the smallest eigenvalues in span{W, P}
+   * @param P the (A-normalized) search directions of the last solve
+   * @param AP the operator applied to each of the search directions
+   */
+  void updateSubspace(const std::vector<mfem::Vector>& P, const std::vector<mfem::Vector>& AP) const;
+
+  /// @brief The MPI communicator used for the reductions
+  MPI_Comm comm_;
+
+  /// @brief The number of vectors kept between solves
+  int recycle_dimension_;
+
+  /// @brief The recycled subspace, A-orthonormal for the current operator unless image_is_stale_
+  mutable std::vector<mfem::Vector> W_;
+
+  /// @brief The operator applied to each vector of the recycled subspace
+  mutable std::vector<mfem::Vector> AW_;
+
+  /// @brief Whether the operator changed since AW_ was computed
+  mutable bool image_is_stale_ = false;
+};
+
+/**
+ * @brief The parallel distribution and sparsity pattern of a HypreParMatrix
+ *
+ * The direct solvers keep the pattern of the last matrix they factored, so that the matrices of later Newton
+ * iterations (which usually have the same pattern) can reuse its reordering and symbolic factorization.
+ */
+class SparsityPattern {
+public:
+  /// @brief An empty pattern, which doesn't match any matrix
+  SparsityPattern() = default;
+
+  /**
+   * @brief Record the pattern of a matrix
+   * @param A the matrix
+   */
+  explicit SparsityPattern(const mfem::HypreParMatrix& A);
+
+  /**
+   * @brief Whether a matrix has this distribution and sparsity pattern on every rank
+   * @param A the matrix to compare
+   * @note this is collective over the matrix's communicator
+   */
+  bool matches(const mfem::HypreParMatrix& A) const;
+
+private:
+  /// @brief Whether a pattern has been recorded
+  bool initialized_ = false;
+
+  /// @brief The local and global sizes of the matrix
+  std::array<HYPRE_BigInt, 4> sizes_{};
+
+  /// @brief The row offsets and column indices of the diagonal and off-diagonal blocks
+  std::array<std::vector<HYPRE_Int>, 4> csr_;
+
+  /// @brief The global column of each off-diagonal column
+  std::vector<HYPRE_BigInt> col_map_offd_;
 };
 
 /**
@@ -176,16 +429,24 @@ public:
    * @pre This operator must be an assembled HypreParMatrix or a BlockOperator
    * with all blocks either null or HypreParMatrixs for compatibility with
    * SuperLU
+   * @note If the matrix has the same sparsity pattern as the previous one, the column and row permutations and
+   * the symbolic factorization are reused (SamePattern_SameRowPerm), and only the numeric factorization is redone
    */
   void SetOperator(const mfem::Operator& op);
 
 private:
+  /// @brief Factor a matrix, reusing the symbolic factorization of the previous one when possible
+  void setMatrix(const mfem::HypreParMatrix& matrix);
+
   /**
    * @brief The owner of the SuperLU matrix for the gradient, stored
    * as a member variable for lifetime purposes
    */
   mutable std::unique_ptr<mfem::SuperLURowLocMatrix> superlu_mat_;
 
+  /// @brief The sparsity pattern of the last factored matrix
+  SparsityPattern pattern_;
+
   /**
    * @brief The underlying MFEM-based SuperLU solver. It requires a special
    * SuperLU matrix type which we store in this object. This enables compatibility
@@ -194,6 +455,316 @@ private:
   mfem::SuperLUSolver superlu_solver_;
 };
 
+/**
+ * @brief A wrapper class for using the MFEM Chebyshev smoother as a preconditioner for operators that
+ * are not assembled, but can compute their diagonal (see mfem::Operator::AssembleDiagonal)
+ */
+class ChebyshevPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a wrapper over an mfem::OperatorChebyshevSmoother
+   * @param[in] order The order of the Chebyshev polynomial
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  ChebyshevPreconditioner(int order, MPI_Comm comm) : order_(order), comm_(comm) {}
+
+  /**
+   * @brief Apply the smoother, y = P x
+   *
+   * @param input The input vector
+   * @param output The output vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /**
+   * @brief Set the underlying operator, recomputing its diagonal and spectral estimates
+   *
+   * @param op The operator to precondition
+   */
+  void SetOperator(const mfem::Operator& op);
+
+private:
+  /// @brief The order of the Chebyshev polynomial
+  int order_;
+
+  /// @brief The MPI communicator used for the power iteration eigenvalue estimate
+  MPI_Comm comm_;
+
+  /// @brief The diagonal of the current operator, referenced by the smoother
+  mfem::Vector diagonal_;
+
+  /// @brief The underlying MFEM-based Chebyshev smoother, rebuilt every time the operator changes
+  std::unique_ptr<mfem::OperatorChebyshevSmoother> smoother_;
+};
+
+/**
+ * @brief A multigrid V-cycle over a hierarchy of coarser discretizations, e.g. on uniformly refined meshes
+ *
+ * The finest level uses the operator given to SetOperator(), which only needs to compute its action and diagonal,
+ * so it can be left unassembled. Every level but the coarsest is smoothed with ChebyshevPreconditioner, and the
+ * coarsest is solved with BoomerAMG. The coarser levels are provided by the physics module with setCoarseLevels();
+ * until then, this is a Chebyshev smoother of the finest level.
+ */
+class GeometricMultigridPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a V-cycle without coarse levels
+   * @param[in] chebyshev_order The order of the Chebyshev smoothers
+   * @param[in] print_level The print level of the coarse BoomerAMG solve
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  GeometricMultigridPreconditioner(int chebyshev_order, int print_level, MPI_Comm comm)
+      : order_(chebyshev_order), print_level_(print_level), comm_(comm)
+  {
+  }
+
+  /**
+   * @brief Set the levels coarser than the one given to SetOperator()
+   *
+   * @param[in] coarsest The assembled operator of the coarsest level, with its essential dofs eliminated
+   * @param[in] coarsest_space The finite element space of the coarsest level
+   * @param[in] operators The operators of the intermediate levels, coarsest first, with their essential dofs
+   * constrained (e.g. by mfem::ConstrainedOperator)
+   * @param[in] prolongations The true dof prolongations from each level to the next finer one, coarsest first
+   * @param[in] essential_dofs The essential true dofs of each coarse level, coarsest first
+   */
+  void setCoarseLevels(std::unique_ptr<mfem::HypreParMatrix>        coarsest,
+                       const mfem::ParFiniteElementSpace&           coarsest_space,
+                       std::vector<std::unique_ptr<mfem::Operator>> operators,
+                       std::vector<std::unique_ptr<mfem::Operator>> prolongations,
+                       std::vector<mfem::Array<int>>                essential_dofs);
+
+  /**
+   * @brief Apply one V-cycle from a zero initial guess, y = P x
+   *
+   * @param input The input vector
+   * @param output The output vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /**
+   * @brief Set the operator of the finest level, recomputing its smoother
+   *
+   * @param op The operator to precondition
+   */
+  void SetOperator(const mfem::Operator& op);
+
+  /// @brief The number of levels, including the finest
+  int numLevels() const { return static_cast<int>(prolongations_.size()) + 1; }
+
+private:
+  /// @brief Apply a V-cycle from the given level down, from a zero initial guess
+  void cycle(std::size_t level, const mfem::Vector& rhs, mfem::Vector& solution) const;
+
+  /// @brief The order of the Chebyshev smoothers
+  int order_;
+
+  /// @brief The print level of the coarse BoomerAMG solve
+  int print_level_;
+
+  /// @brief The MPI communicator used by the vectors in the solve
+  MPI_Comm comm_;
+
+  /// @brief The assembled operator of the coarsest level
+  std::unique_ptr<mfem::HypreParMatrix> coarsest_;
+
+  /// @brief The solver of the coarsest level
+  std::unique_ptr<mfem::HypreBoomerAMG> coarse_solver_;
+
+  /// @brief The operators of the intermediate levels, coarsest first
+  std::vector<std::unique_ptr<mfem::Operator>> intermediate_operators_;
+
+  /// @brief The smoothers of the intermediate levels, coarsest first
+  std::vector<std::unique_ptr<ChebyshevPreconditioner>> intermediate_smoothers_;
+
+  /// @brief The operator given to SetOperator()
+  const mfem::Operator* finest_ = nullptr;
+
+  /// @brief The smoother of the finest level
+  std::unique_ptr<ChebyshevPreconditioner> finest_smoother_;
+
+  /// @brief The prolongations from each level to the next finer one, coarsest first
+  std::vector<std::unique_ptr<mfem::Operator>> prolongations_;
+
+  /// @brief The essential true dofs of each coarse level, coarsest first
+  std::vector<mfem::Array<int>> essential_dofs_;
+
+  /// @brief Work vectors for the residual, coarse right hand side and coarse correction of each level
+  mutable std::vector<mfem::Vector> residuals_, coarse_rhs_, corrections_;
+};
+
+/**
+ * @brief A multigrid V-cycle whose coarse levels are the lower polynomial orders of the finest space on the same mesh
+ *
+ * It only differs from GeometricMultigridPreconditioner in which coarse levels the physics modules give to it.
+ */
+class PMultigridPreconditioner : public GeometricMultigridPreconditioner {
+public:
+  using GeometricMultigridPreconditioner::GeometricMultigridPreconditioner;
+};
+
+/**
+ * @brief BoomerAMG on the p = 1 operator of the low-order refined (LOR) discretization of a high-order space
+ *
+ * The LOR operator is spectrally equivalent to the high-order one, and far sparser to assemble. It is provided by the
+ * physics module with setLowOrderOperator(), so the high-order operator given to SetOperator() is only used for its
+ * size and can be left unassembled.
+ */
+class LORPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a preconditioner without a low-order operator
+   * @param[in] print_level The print level of BoomerAMG
+   */
+  LORPreconditioner(int print_level) : print_level_(print_level) {}
+
+  /**
+   * @brief Set the assembled low-order operator, on the true dofs of the high-order space
+   *
+   * @param[in] low_order The low-order operator, with its essential dofs eliminated
+   * @param[in] vdim The number of components of the space
+   * @param[in] by_nodes Whether the components of the space are ordered by nodes (rather than interleaved)
+   */
+  void setLowOrderOperator(std::unique_ptr<mfem::HypreParMatrix> low_order, int vdim, bool by_nodes = true);
+
+  /**
+   * @brief Apply a V-cycle of BoomerAMG on the low-order operator, y = P x
+   *
+   * @param input The input vector
+   * @param output The output vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /**
+   * @brief Set the high-order operator, whose size must match the low-order one
+   *
+   * @param op The operator to precondition
+   */
+  void SetOperator(const mfem::Operator& op);
+
+private:
+  /// @brief The print level of BoomerAMG
+  int print_level_;
+
+  /// @brief The assembled low-order operator
+  std::unique_ptr<mfem::HypreParMatrix> low_order_;
+
+  /// @brief BoomerAMG, set up on the low-order operator
+  std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+};
+
+/**
+ * @brief A block preconditioner for 2x2 saddle-point systems, like those of Lagrange multiplier contact
+ *
+ * For the block operator [A B^T; B C], BoomerAMG is applied to A and Jacobi to the (assembled) approximate Schur
+ * complement S = C - B diag(A)^{-1} B^T, in a block lower triangular sweep. All of the blocks must be HypreParMatrix
+ * or zero. Operators that are assembled matrices rather than block operators are preconditioned with BoomerAMG.
+ */
+class BlockSchurPreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs the preconditioner
+   * @param[in] print_level The print level of BoomerAMG
+   */
+  BlockSchurPreconditioner(int print_level) : print_level_(print_level) {}
+
+  /**
+   * @brief Apply the preconditioner, y = P x
+   *
+   * @param input The input vector
+   * @param output The output vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /**
+   * @brief Set the block operator, recomputing BoomerAMG and the approximate Schur complement
+   *
+   * @param op The operator to precondition
+   */
+  void SetOperator(const mfem::Operator& op);
+
+private:
+  /// @brief The print level of BoomerAMG
+  int print_level_;
+
+  /// @brief The offsets of the blocks, referenced by the block preconditioner
+  mfem::Array<int> offsets_;
+
+  /// @brief BoomerAMG on the first diagonal block
+  std::unique_ptr<mfem::HypreBoomerAMG> amg_;
+
+  /// @brief The approximate Schur complement
+  std::unique_ptr<mfem::HypreParMatrix> schur_complement_;
+
+  /// @brief Jacobi on the approximate Schur complement
+  std::unique_ptr<mfem::HypreSmoother> schur_solver_;
+
+  /// @brief The block lower triangular sweep, when the operator is a block operator
+  std::unique_ptr<mfem::BlockLowerTriangularPreconditioner> block_preconditioner_;
+};
+
+/**
+ * @brief A wrapper class that reuses the setup of another preconditioner (e.g. an AMG hierarchy) across a
+ * limited number of updates to its operator
+ *
+ * @note reuse only happens when SetOperator() is called again with the same operator object (i.e. one whose
+ * values have been updated in place, like the Jacobians reassembled by the physics modules). A different
+ * operator object always rebuilds the underlying preconditioner, so it never refers to a deleted operator.
+ */
+class ReusablePreconditioner : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a wrapper over an existing preconditioner
+   * @param[in] preconditioner The preconditioner whose setup will be reused
+   * @param[in] max_reuse The maximum number of consecutive SetOperator() calls that may skip the setup
+   */
+  ReusablePreconditioner(std::unique_ptr<mfem::Solver> preconditioner, int max_reuse)
+      : preconditioner_(std::move(preconditioner)), max_reuse_(max_reuse)
+  {
+  }
+
+  /**
+   * @brief Apply the underlying preconditioner, y = P x
+   *
+   * @param input The input vector
+   * @param output The output vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const { preconditioner_->Mult(input, output); }
+
+  /**
+   * @brief Set the underlying operator, only redoing the setup of the preconditioner if the operator object has
+   * changed, or it has already been reused `max_reuse` times
+   *
+   * @param op The operator to precondition
+   */
+  void SetOperator(const mfem::Operator& op);
+
+  /// @brief Make the next call to SetOperator() redo the setup of the underlying preconditioner
+  void forceRebuild() { op_ = nullptr; }
+
+  /// @brief Returns the underlying preconditioner
+  mfem::Solver& underlying() { return *preconditioner_; }
+
+  /// @brief Returns the number of times the setup of the underlying preconditioner has been done
+  int numSetups() const { return num_setups_; }
+
+private:
+  /// @brief The preconditioner whose setup is being reused
+  std::unique_ptr<mfem::Solver> preconditioner_;
+
+  /// @brief The maximum number of consecutive SetOperator() calls that may skip the setup
+  int max_reuse_;
+
+  /// @brief The number of SetOperator() calls that have skipped the setup since it was last done
+  int reuse_count_ = 0;
+
+  /// @brief The number of times the setup of the underlying preconditioner has been done
+  int num_setups_ = 0;
+
+  /// @brief The operator that the underlying preconditioner was last set up with
+  const mfem::Operator* op_ = nullptr;
+};
+
 #ifdef MFEM_USE_STRUMPACK
 /**
  * @brief A wrapper class for using the MFEM Strumpack solver with a HypreParMatrix
@@ -229,16 +800,23 @@ public:
    *
    * @param op The matrix operator to factorize with Strumpack
    * @pre This operator must be an assembled HypreParMatrix for compatibility with Strumpack
+   * @note If the matrix has the same sparsity pattern as the previous one, its reordering is reused
    */
   void SetOperator(const mfem::Operator& op);
 
 private:
+  /// @brief Factor a matrix, reusing the reordering of the previous one when possible
+  void setMatrix(const mfem::HypreParMatrix& matrix);
+
   /**
    * @brief The owner of the Strumpack matrix for the gradient, stored
    * as a member variable for lifetime purposes
    */
   mutable std::unique_ptr<mfem::STRUMPACKRowLocMatrix> strumpack_mat_;
 
+  /// @brief The sparsity pattern of the last factored matrix
+  SparsityPattern pattern_;
+
   /**
    * @brief The underlying MFEM-based Strumpack solver. It requires a special
    * Strumpack matrix type which we store in this object. This enables compatibility
@@ -249,6 +827,64 @@ private:
 
 #endif
 
+#ifdef MFEM_USE_PETSC
+/**
+ * @brief A wrapper for using a PETSc preconditioner (PC), e.g. BDDC or GAMG, with a HypreParMatrix
+ *
+ * Each new operator is converted to a PETSc matrix, in PETSc's unassembled (MATIS) format for BDDC, and the
+ * preconditioner is rebuilt from PETSc's options database, see LinearSolverOptions::petsc_options.
+ */
+class PetscPCSolver : public mfem::Solver {
+public:
+  /**
+   * @brief Constructs a wrapper over an mfem::PetscPreconditioner, initializing PETSc if that hasn't been done yet
+   * @param[in] bddc Whether the preconditioner is BDDC, rather than the one chosen by the options database
+   * @param[in] comm The MPI communicator used by the vectors and matrices in the solve
+   */
+  PetscPCSolver(bool bddc, MPI_Comm comm);
+
+  /**
+   * @brief Add options to PETSc's options database, for the preconditioners built by the following SetOperator()s
+   *
+   * @param options The options, in PETSc's command line format
+   * @param prefix The prefix of the options (and of the preconditioner)
+   */
+  void setOptions(const std::string& options, const std::string& prefix);
+
+  /**
+   * @brief Apply the preconditioner
+   *
+   * @param input The input vector
+   * @param output The output vector
+   */
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const;
+
+  /**
+   * @brief Build the preconditioner of a new matrix
+   *
+   * @param op The matrix operator to precondition
+   * @pre This operator must be an assembled HypreParMatrix, or a BlockOperator of them
+   */
+  void SetOperator(const mfem::Operator& op);
+
+private:
+  /// @brief Whether the preconditioner is BDDC
+  bool bddc_;
+
+  /// @brief The MPI communicator used by the vectors and matrices in the solve
+  MPI_Comm comm_;
+
+  /// @brief The prefix of the preconditioner's options
+  std::string prefix_;
+
+  /// @brief The PETSc copy of the last matrix
+  std::unique_ptr<mfem::PetscParMatrix> petsc_matrix_;
+
+  /// @brief The underlying PETSc preconditioner
+  std::unique_ptr<mfem::PetscPreconditioner> preconditioner_;
+};
+#endif
+
 /**
  * @brief Build a nonlinear solver using the nonlinear option struct
  *
@@ -283,6 +919,59 @@ std::pair<std::unique_ptr<mfem::Solver>, std::unique_ptr<mfem::Solver>> buildLin
 std::unique_ptr<mfem::Solver> buildPreconditioner(Preconditioner preconditioner, int print_level = 0,
                                                   [[maybe_unused]] MPI_Comm comm = MPI_COMM_WORLD);
 
+/**
+ * @brief Build a preconditioner from a linear options struct, including its setup reuse and AMG options
+ *
+ * @param linear_opts The options to configure the preconditioner
+ * @param comm The communicator for the underlying operator and HypreParVectors
+ * @return A constructed preconditioner based on the input options, wrapped in a ReusablePreconditioner
+ * if linear_opts.max_preconditioner_reuse > 0
+ */
+std::unique_ptr<mfem::Solver> buildPreconditioner(const LinearSolverOptions& linear_opts, MPI_Comm comm);
+
+/**
+ * @brief The rotational rigid body modes of a vector H1 space, computed from its mesh coordinates
+ *
+ * These are the near null space vectors that BoomerAMG interpolates exactly for elasticity (the translations are
+ * already reproduced by its systems interpolation). hypre keeps pointers to them, so they must outlive the AMG
+ * preconditioner they are given to.
+ */
+class RigidBodyModes {
+public:
+  /// @brief Compute the rigid body rotations (about the origin) of @a space: one in 2D, and three in 3D
+  explicit RigidBodyModes(mfem::ParFiniteElementSpace& space);
+
+  /// @brief The number of modes
+  int size() const { return static_cast<int>(handles_.size()); }
+
+  /// @brief The true dof vectors of the modes
+  const mfem::HypreParVector& operator[](int i) const { return *modes_[static_cast<size_t>(i)]; }
+
+  /// @brief The hypre vectors of the modes, in the form taken by HYPRE_BoomerAMGSetInterpVectors
+  HYPRE_ParVector* data() { return handles_.data(); }
+
+private:
+  /// The true dof vectors of the modes
+  std::vector<std::unique_ptr<mfem::HypreParVector>> modes_;
+
+  /// The underlying hypre vectors of modes_
+  std::vector<HYPRE_ParVector> handles_;
+};
+
+/**
+ * @brief Configure a BoomerAMG preconditioner for the elasticity system of the vector H1 space @a space
+ *
+ * This sets the number of functions (and, for byNODES spaces, their ordering), uses nodal coarsening, and gives
+ * hypre the rigid body modes of the space to interpolate. This is mfem::HypreBoomerAMG::SetElasticityOptions without
+ * its interpolation refinement, which segfaulted in HYPRE_BoomerAMGSetInterpRefine as of hypre v2.26.0. Like it, this
+ * turns off aggressive coarsening.
+ *
+ * @param amg The preconditioner to configure
+ * @param space The space of the displacement field
+ * @return The rigid body modes given to @a amg, which must be kept alive as long as it is used
+ */
+std::unique_ptr<RigidBodyModes> setElasticityOptions(mfem::HypreBoomerAMG& amg, mfem::ParFiniteElementSpace& space);
+
 #ifdef MFEM_USE_AMGX
 /**
  * @brief Build an AMGX preconditioner
@@ -0,0 +1,119 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/fixed_point_acceleration.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+FixedPointAccelerator::FixedPointAccelerator(FixedPointAcceleration method, double relaxation, int depth,
+                                             MPI_Comm comm)
+    : method_(method), relaxation_(relaxation), depth_(depth), comm_(comm), omega_(relaxation)
+{
+  SLIC_ERROR_ROOT_IF(relaxation <= 0.0, "Fixed-point relaxation factors must be positive");
+  SLIC_ERROR_ROOT_IF(method == FixedPointAcceleration::Anderson && depth < 1,
+                     "Anderson mixing requires a depth of at least one previous iterate");
+}
+
+void FixedPointAccelerator::reset()
+{
+  omega_        = relaxation_;
+  has_previous_ = false;
+  delta_x_.clear();
+  delta_r_.clear();
+}
+
+void FixedPointAccelerator::update(mfem::Vector& x, const mfem::Vector& g)
+{
+  residual_.SetSize(x.Size());
+  subtract(g, x, residual_);
+
+  switch (method_) {
+    case FixedPointAcceleration::None:
+      x.Add(relaxation_, residual_);
+      break;
+    case FixedPointAcceleration::Aitken:
+      aitkenUpdate(x);
+      break;
+    case FixedPointAcceleration::Anderson:
+      andersonUpdate(x);
+      break;
+  }
+}
+
+void FixedPointAccelerator::aitkenUpdate(mfem::Vector& x)
+{
+  if (has_previous_) {
+    // omega_k = -omega_{k-1} * (r_{k-1} . (r_k - r_{k-1})) / |r_k - r_{k-1}|^2
+    mfem::Vector delta_r(residual_);
+    delta_r -= previous_residual_;
+
+    const double denominator = mfem::InnerProduct(comm_, delta_r, delta_r);
+    if (denominator > 0.0) {
+      omega_ = -omega_ * mfem::InnerProduct(comm_, previous_residual_, delta_r) / denominator;
+    }
+  }
+
+  previous_residual_ = residual_;
+  has_previous_      = true;
+
+  x.Add(omega_, residual_);
+}
+
+void FixedPointAccelerator::andersonUpdate(mfem::Vector& x)
+{
+  if (has_previous_) {
+    mfem::Vector delta_r(residual_);
+    delta_r -= previous_residual_;
+
+    // a repeated residual carries no information, and would make the least squares problem singular
+    if (mfem::InnerProduct(comm_, delta_r, delta_r) > 0.0) {
+      mfem::Vector delta_x(x);
+      delta_x -= previous_x_;
+
+      if (static_cast<int>(delta_r_.size()) == depth_) {
+        delta_x_.erase(delta_x_.begin());
+        delta_r_.erase(delta_r_.begin());
+      }
+      delta_x_.push_back(std::move(delta_x));
+      delta_r_.push_back(std::move(delta_r));
+    }
+  }
+
+  previous_x_        = x;
+  previous_residual_ = residual_;
+  has_previous_      = true;
+
+  const int m = static_cast<int>(delta_r_.size());
+
+  // gamma = argmin |r - sum_i gamma_i delta_r_i|, from the normal equations
+  mfem::Vector gamma(m);
+  if (m > 0) {
+    mfem::DenseMatrix normal_matrix(m);
+    mfem::Vector      rhs(m);
+    for (int i = 0; i < m; i++) {
+      const auto& delta_r_i = delta_r_[static_cast<size_t>(i)];
+      for (int j = 0; j <= i; j++) {
+        normal_matrix(i, j) = normal_matrix(j, i) =
+            mfem::InnerProduct(comm_, delta_r_i, delta_r_[static_cast<size_t>(j)]);
+      }
+      rhs(i) = mfem::InnerProduct(comm_, delta_r_i, residual_);
+    }
+
+    mfem::DenseMatrixInverse inverse(normal_matrix);
+    inverse.Mult(rhs, gamma);
+  }
+
+  // x_{k+1} = x_k + beta r_k - sum_i gamma_i (delta_x_i + beta delta_r_i)
+  x.Add(relaxation_, residual_);
+  for (int i = 0; i < m; i++) {
+    x.Add(-gamma(i), delta_x_[static_cast<size_t>(i)]);
+    x.Add(-gamma(i) * relaxation_, delta_r_[static_cast<size_t>(i)]);
+  }
+}
+
+}  // namespace serac
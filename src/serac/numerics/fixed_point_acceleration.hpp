@@ -0,0 +1,94 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file fixed_point_acceleration.hpp
+ *
+ * @brief Relaxation and mixing schemes for accelerating fixed-point iterations x = g(x)
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/solver_config.hpp"
+
+namespace serac {
+
+/**
+ * @brief Computes successive iterates of a fixed-point iteration x = g(x), with optional acceleration
+ *
+ * This is intended for partitioned (staggered) multiphysics coupling, where g is one pass through the
+ * solves of each module and x is a field exchanged between them.
+ */
+class FixedPointAccelerator {
+public:
+  /**
+   * @brief Construct a fixed-point accelerator
+   *
+   * @param method The acceleration method
+   * @param relaxation The relaxation factor of the first iteration (and of every iteration for constant relaxation
+   * and Anderson mixing)
+   * @param depth The number of previous iterates used by Anderson mixing
+   * @param comm The MPI communicator of the iterates
+   */
+  FixedPointAccelerator(FixedPointAcceleration method, double relaxation, int depth, MPI_Comm comm);
+
+  /// @brief Forget the previous iterates, e.g. at the beginning of a new timestep
+  void reset();
+
+  /**
+   * @brief Compute the next iterate
+   *
+   * @param[in,out] x The current iterate on input, and the next iterate on output
+   * @param[in] g The value of g(x) at the current iterate
+   */
+  void update(mfem::Vector& x, const mfem::Vector& g);
+
+private:
+  /// @brief Aitken relaxation: x += omega * r, with omega chosen from the last two residuals
+  void aitkenUpdate(mfem::Vector& x);
+
+  /// @brief Anderson mixing: the combination of previous iterates with the least residual, plus a relaxed residual
+  void andersonUpdate(mfem::Vector& x);
+
+  /// The acceleration method
+  FixedPointAcceleration method_;
+
+  /// The constant (or initial) relaxation factor
+  double relaxation_;
+
+  /// The maximum number of previous iterates kept by Anderson mixing
+  int depth_;
+
+  /// The MPI communicator of the iterates
+  MPI_Comm comm_;
+
+  /// The current Aitken relaxation factor
+  double omega_;
+
+  /// Whether the previous iterate and residual are available
+  bool has_previous_ = false;
+
+  /// The residual g(x) - x at the current iterate
+  mfem::Vector residual_;
+
+  /// The residual at the previous iterate
+  mfem::Vector previous_residual_;
+
+  /// The previous iterate
+  mfem::Vector previous_x_;
+
+  /// Differences between consecutive iterates, used by Anderson mixing
+  std::vector<mfem::Vector> delta_x_;
+
+  /// Differences between consecutive residuals, used by Anderson mixing
+  std::vector<mfem::Vector> delta_r_;
+};
+
+}  // namespace serac
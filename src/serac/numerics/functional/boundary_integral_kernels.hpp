@@ -8,6 +8,7 @@
 #include <array>
 
 #include "serac/serac_config.hpp"
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/quadrature_data.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
 
@@ -178,7 +179,10 @@ void evaluation_kernel_impl(trial_element_type trial_elements, test_element, dou
       reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  //
+  // note: each element writes to its own block of the E-vector (and its own q-function derivatives),
+  // so the elements can be processed concurrently without any synchronization
+  accelerator::forall_host(num_elements, [&](uint32_t e) {
     // load the jacobians and positions for each quadrature point in this element
     auto J_e = J[e];
     auto x_e = x[e];
@@ -201,7 +205,53 @@ void evaluation_kernel_impl(trial_element_type trial_elements, test_element, dou
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(get_value(qf_outputs), rule, &r[elements[e]]);
+  });
+}
+
+/**
+ * @brief evaluate a boundary integral for several sets of inputs in one pass over the elements
+ *
+ * The jacobians and positions of each element are loaded once, and shared by the evaluations of every set of inputs.
+ *
+ * @param inputs the values of every trial argument (E-vectors), for each set of inputs
+ * @param outputs the E-vector that the values of the integral are added to, for each set of inputs
+ */
+template <int Q, mfem::Geometry::Type geom, typename test_element, typename trial_element_type, typename lambda_type,
+          int... indices>
+void batched_evaluation_kernel_impl(trial_element_type trial_elements, test_element, double t,
+                                    const std::vector<std::vector<const double*>>& inputs,
+                                    const std::vector<double*>& outputs, const double* positions,
+                                    const double* jacobians, lambda_type qf, const int* elements,
+                                    uint32_t num_elements, camp::int_seq<int, indices...>)
+{
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians);
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  using input_type = tuple<const typename decltype(type<indices>(trial_elements))::dof_type*...>;
+
+  std::size_t             num_vectors = outputs.size();
+  std::vector<input_type> u(num_vectors);
+  for (std::size_t c = 0; c < num_vectors; c++) {
+    u[c] = {reinterpret_cast<std::decay_t<decltype(get<indices>(u[c]))>>(inputs[c][indices])...};
   }
+
+  accelerator::forall_host(num_elements, [&](uint32_t e) {
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    for (std::size_t c = 0; c < num_vectors; c++) {
+      [[maybe_unused]] tuple qf_inputs = {
+          get<indices>(trial_elements).interpolate(get<indices>(u[c])[elements[e]], rule)...};
+
+      auto qf_outputs = batch_apply_qf(qf, t, x_e, J_e, get<indices>(qf_inputs)...);
+
+      auto r = reinterpret_cast<typename test_element::dof_type*>(outputs[c]);
+      test_element::integrate(get_value(qf_outputs), rule, &r[elements[e]]);
+    }
+  });
 }
 
 //clang-format off
@@ -264,7 +314,7 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
     // (batch) interpolate each quadrature point's value
     auto qf_inputs = trial_element::interpolate(du[elements[e]], rule);
 
@@ -273,7 +323,82 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(qf_outputs, rule, &dr[elements[e]]);
-  }
+  });
+}
+
+//clang-format off
+template <typename X, typename S, typename T>
+SERAC_HOST_DEVICE auto transpose_chain_rule(const S& dfdx, const T& dy)
+{
+  using X0 = std::decay_t<decltype(serac::get<0>(X{}))>;
+  using X1 = std::decay_t<decltype(serac::get<1>(X{}))>;
+  return serac::tuple{serac::transpose_chain_rule<X0>(serac::get<0>(serac::get<0>(dfdx)), dy),
+                      serac::transpose_chain_rule<X1>(serac::get<1>(serac::get<0>(dfdx)), dy)};
+}
+//clang-format on
+
+/**
+ * @brief The kernel template used to create the transpose of the directional derivative kernels,
+ * i.e. the vector-jacobian products used by adjoint and sensitivity calculations
+ *
+ * Boundary q-functions only have a source term, so only the values of the test functions are
+ * interpolated at each quadrature point.
+ *
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam geom The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[in] dR The full set of per-element values in the test space (primary input)
+ * @param[inout] dU The full set of per-element values in the trial space (primary output)
+ * @param[in] qf_derivatives The address at which derivatives of the q-function with
+ * respect to its arguments are stored
+ * @param[in] elements The indices of the elements to integrate over
+ * @param[in] num_elements The number of elements in the domain
+ */
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+void action_of_gradient_transpose_kernel(const double* dR, double* dU, derivatives_type* qf_derivatives,
+                                         const int* elements, std::size_t num_elements)
+{
+  using test_element  = finite_element<geom, test>;
+  using trial_element = finite_element<geom, trial>;
+
+  constexpr bool                                  is_QOI = (test::family == Family::QOI);
+  constexpr int                                   nqp    = num_quadrature_points(geom, Q);
+  auto                                            dr     = reinterpret_cast<const typename test_element::dof_type*>(dR);
+  auto                                            du     = reinterpret_cast<typename trial_element::dof_type*>(dU);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  using trial_input = std::decay_t<decltype(trial_element::interpolate(typename trial_element::dof_type{}, rule)[0])>;
+
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    // the values of the test functions at each quadrature point (a QoI has a single value per element)
+    auto test_values = [&]() {
+      if constexpr (is_QOI) {
+        return dr[elements[e]];
+      } else {
+        return test_element::interpolate(dr[elements[e]], rule);
+      }
+    }();
+
+    auto value_at_qpt = [&](int q) {
+      if constexpr (is_QOI) {
+        return test_values;
+      } else {
+        return get<0>(test_values[q]);
+      }
+    };
+
+    using output_type = decltype(transpose_chain_rule<trial_input>(derivatives_type{}, value_at_qpt(0)));
+    tensor<output_type, nqp> qf_outputs{};
+    for (int q = 0; q < nqp; q++) {
+      qf_outputs[q] = transpose_chain_rule<trial_input>(qf_derivatives[e * nqp + uint32_t(q)], value_at_qpt(q));
+    }
+
+    // (batch) integrate against the trial-space basis functions
+    trial_element::integrate(qf_outputs, rule, &du[elements[e]]);
+  });
 }
 
 /**
@@ -309,7 +434,7 @@ void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, d
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
     auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(elements[e], 0, 0));
 
     tensor<derivatives_type, nquad> derivatives{};
@@ -321,7 +446,58 @@ void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, d
       auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
       test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
     }
-  }
+  });
+}
+
+/**
+ * @brief The base kernel template used to compute only the diagonal entries of the element gradient
+ * matrices, without storing the element matrices themselves
+ *
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space (must be the same as the test space)
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[inout] dE E-vector storing the diagonal entries of each element matrix, the values computed here are added
+ * to its existing contents
+ * @param[in] qf_derivatives pointer to data describing the derivatives of the q-function with respect to its arguments
+ * @param[in] elements the indices of the elements to process
+ * @param[in] num_elements The number of elements in the mesh
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
+void element_diagonal_kernel(double* dE, derivatives_type* qf_derivatives, const int* elements,
+                             std::size_t num_elements)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+  constexpr int ndof  = trial_element::ndof;
+  constexpr int ncomp = trial_element::components;
+
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  // for each element in the domain
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    double* diagonal = dE + std::size_t(elements[e]) * ndof * ncomp;
+
+    tensor<derivatives_type, nquad> derivatives{};
+    for (int q = 0; q < nquad; q++) {
+      derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
+    }
+
+    // compute one column of the element matrix at a time (for each trial component),
+    // and only keep the entry that lies on the diagonal
+    for (int J = 0; J < ndof; J++) {
+      typename test_element::dof_type column[ncomp]{};
+      auto                            source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+      test_element::integrate(source_and_flux, rule, column);
+      for (int c = 0; c < ncomp; c++) {
+        diagonal[c * ndof + J] += reinterpret_cast<const double*>(&column[c])[c * ndof + J];
+      }
+    }
+  });
 }
 
 template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type,
@@ -333,7 +509,19 @@ auto evaluation_kernel(signature s, lambda_type qf, const double* positions, con
   auto test_element   = get_test_element<geom>(s);
   return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool /* update state */) {
     evaluation_kernel_impl<wrt, Q, geom>(trial_elements, test_element, time, inputs, outputs, positions, jacobians, qf,
-                                         qf_derivatives.get(), elements, num_elements, s.index_seq);
+                                         qf_derivatives->get(), elements, num_elements, s.index_seq);
+  };
+}
+
+template <int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type>
+auto batched_evaluation_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                               const int* elements, uint32_t num_elements)
+{
+  auto trial_elements = trial_elements_tuple<geom>(s);
+  auto test_element   = get_test_element<geom>(s);
+  return [=](double time, const std::vector<std::vector<const double*>>& inputs, const std::vector<double*>& outputs) {
+    batched_evaluation_kernel_impl<Q, geom>(trial_elements, test_element, time, inputs, outputs, positions, jacobians,
+                                            qf, elements, num_elements, s.index_seq);
   };
 }
 
@@ -344,7 +532,19 @@ std::function<void(const double*, double*)> jacobian_vector_product_kernel(
   return [=](const double* du, double* dr) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives.get(), elements, num_elements);
+    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives->get(), elements, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(const double*, double*)> vector_jacobian_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+{
+  return [=](const double* dr, double* du) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    action_of_gradient_transpose_kernel<Q, geom, test_space, trial_space>(dr, du, qf_derivatives->get(), elements,
+                                                                          num_elements);
   };
 }
 
@@ -355,7 +555,19 @@ std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradi
   return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives.get(), elements, num_elements);
+    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives->get(), elements, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(double*)> element_diagonal_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     const int* elements, uint32_t num_elements)
+{
+  return [=](double* diagonal_E) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    element_diagonal_kernel<geom, test_space, trial_space, Q>(diagonal_E, qf_derivatives->get(), elements,
+                                                              num_elements);
   };
 }
 
@@ -0,0 +1,351 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file derivative_storage.hpp
+ *
+ * @brief The layouts used to store the q-function derivatives at each quadrature point, between the evaluation
+ * of a Functional and the actions of (or assembly of) its gradient
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/tuple.hpp"
+
+namespace serac {
+
+/**
+ * @brief the number of rows of a block of q-function derivatives, viewed as a square matrix that can be
+ * stored as its upper triangle, or 0 for blocks that are stored as-is
+ *
+ * The blocks that can be symmetric are d(source)/d(value), e.g. tensor<double, c, c> for c components
+ * (or a double for a single component), and d(flux)/d(gradient), e.g. tensor<double, c, dim, c, dim>
+ * (or tensor<double, dim, dim> for a single component)
+ */
+template <typename T>
+struct symmetric_block_rows {
+  static constexpr int value = 0;  ///< blocks that aren't square matrices are stored as-is
+};
+
+/// @overload
+template <int m>
+struct symmetric_block_rows<tensor<double, m, m>> {
+  static constexpr int value = m;  ///< the number of rows of the block
+};
+
+/// @overload
+template <int m, int n>
+struct symmetric_block_rows<tensor<double, m, n, m, n>> {
+  static constexpr int value = m * n;  ///< the number of rows of the block
+};
+
+/**
+ * @brief store the symmetric part of a block of q-function derivatives as its upper triangle, in row-major order
+ * @note blocks that aren't square matrices (including zero blocks) are returned unmodified
+ */
+template <typename T>
+SERAC_HOST_DEVICE auto pack_symmetric(const T& A)
+{
+  constexpr int n = symmetric_block_rows<T>::value;
+  if constexpr (n > 0) {
+    // the derivative tensors are contiguous arrays of doubles, so they can be viewed as a square matrix
+    const double*                   a = reinterpret_cast<const double*>(&A);
+    tensor<double, n * (n + 1) / 2> packed{};
+    int                             k = 0;
+    for (int i = 0; i < n; i++) {
+      for (int j = i; j < n; j++) {
+        packed[k++] = 0.5 * (a[i * n + j] + a[j * n + i]);
+      }
+    }
+    return packed;
+  } else {
+    return A;
+  }
+}
+
+/// @brief the inverse of pack_symmetric(), for a block of q-function derivatives of type T
+template <typename T, typename P>
+SERAC_HOST_DEVICE T unpack_symmetric(const P& packed)
+{
+  constexpr int n = symmetric_block_rows<T>::value;
+  if constexpr (n > 0) {
+    T       A{};
+    double* a = reinterpret_cast<double*>(&A);
+    int     k = 0;
+    for (int i = 0; i < n; i++) {
+      for (int j = i; j < n; j++) {
+        a[i * n + j] = a[j * n + i] = packed[k++];
+      }
+    }
+    return A;
+  } else {
+    return packed;
+  }
+}
+
+/**
+ * @brief the q-function derivatives at a quadrature point, where the d(source)/d(value) and d(flux)/d(gradient)
+ * blocks are symmetric, so only their upper triangles are stored
+ *
+ * e.g. for elasticity in 3D, the d(flux)/d(gradient) block takes 45 doubles instead of 81.
+ *
+ * @tparam T the type of the q-function derivatives, see qfunction_has_symmetric_derivative
+ */
+template <typename T>
+struct SymmetricDerivative;
+
+/// @overload
+template <typename S0, typename S1, typename F0, typename F1>
+struct SymmetricDerivative<tuple<tuple<S0, S1>, tuple<F0, F1>>> {
+  using type = tuple<tuple<S0, S1>, tuple<F0, F1>>;  ///< the type of the unpacked derivatives
+
+  decltype(pack_symmetric(S0{})) source_value;     ///< d(source)/d(value), packed
+  S1                             source_gradient;  ///< d(source)/d(gradient)
+  F0                             flux_value;       ///< d(flux)/d(value)
+  decltype(pack_symmetric(F1{})) flux_gradient;    ///< d(flux)/d(gradient), packed
+};
+
+/**
+ * @brief the number of doubles in the blocks of q-function derivatives of type T that aren't structurally zero,
+ * or -1 if T has blocks of other types
+ *
+ * The derivative types come from make_dual_wrt(), which seeds each component of the differentiated argument
+ * with its own one-hot gradient, so the derivatives w.r.t. components a q-function doesn't use (e.g. the
+ * displacement value, for pure elasticity) are `zero` at compile time.
+ */
+template <typename T>
+struct nonzero_entries {
+  static constexpr int value = -1;  ///< blocks of other types are stored as-is
+};
+
+/// @overload
+template <>
+struct nonzero_entries<zero> {
+  static constexpr int value = 0;  ///< structurally zero blocks are not stored
+};
+
+/// @overload
+template <>
+struct nonzero_entries<double> {
+  static constexpr int value = 1;  ///< a single derivative
+};
+
+/// @overload
+template <int... n>
+struct nonzero_entries<tensor<double, n...>> {
+  static constexpr int value = (n * ...);  ///< a dense block
+};
+
+/// @overload
+template <typename... T>
+struct nonzero_entries<tuple<T...>> {
+  static constexpr int value =
+      ((nonzero_entries<T>::value < 0) || ...) ? -1 : (nonzero_entries<T>::value + ... + 0);  ///< all the blocks
+};
+
+/**
+ * @brief the q-function derivatives at a quadrature point, without their structurally zero blocks
+ *
+ * `zero` blocks still take up (padded) space as members of a tuple, e.g. the derivatives of a heat flux
+ * q-function in 2D, tuple<tuple<double, zero>, tuple<zero, tensor<double, 2, 2>>>, take 56 bytes instead of 40.
+ *
+ * @tparam T the type of the q-function derivatives
+ */
+template <typename T>
+struct CompactDerivative {
+  using type = T;  ///< the type of the unpacked derivatives
+
+  tensor<double, nonzero_entries<T>::value> values;  ///< the nonzero blocks of the derivatives, in order
+};
+
+/**
+ * @brief the q-function derivatives at a quadrature point, without their structurally zero blocks, rounded to
+ * single precision
+ *
+ * The derivatives are converted back to double when they are loaded, so the actions of the gradient still do their
+ * arithmetic in double, but their storage (and the memory traffic of each action) is halved. The gradient is then
+ * only accurate to about 1e-7, which is plenty for the Krylov iterations of an inexact Newton method, whose
+ * residuals are still evaluated in double. Note that assembled gradients (and their diagonals) are rounded too.
+ *
+ * @tparam T the type of the q-function derivatives, see qfunction_has_single_precision_derivative
+ */
+template <typename T>
+struct SinglePrecisionDerivative {
+  using type = T;  ///< the type of the unpacked derivatives
+
+  tensor<float, nonzero_entries<T>::value> values;  ///< the nonzero blocks of the derivatives, in order
+};
+
+/// @cond
+namespace detail {
+
+template <typename T, typename V>
+SERAC_HOST_DEVICE void gather_nonzero_blocks(const T& block, V*& values)
+{
+  if constexpr (is_tuple<T>{}) {
+    for_constexpr<tuple_size<T>::value>([&](auto i) { gather_nonzero_blocks(get<i>(block), values); });
+  } else if constexpr (nonzero_entries<T>::value > 0) {
+    const double* b = reinterpret_cast<const double*>(&block);
+    for (int i = 0; i < nonzero_entries<T>::value; i++) {
+      *values++ = V(b[i]);
+    }
+  }
+}
+
+template <typename T, typename V>
+SERAC_HOST_DEVICE void scatter_nonzero_blocks(T& block, const V*& values)
+{
+  if constexpr (is_tuple<T>{}) {
+    for_constexpr<tuple_size<T>::value>([&](auto i) { scatter_nonzero_blocks(get<i>(block), values); });
+  } else if constexpr (nonzero_entries<T>::value > 0) {
+    double* b = reinterpret_cast<double*>(&block);
+    for (int i = 0; i < nonzero_entries<T>::value; i++) {
+      b[i] = double(*values++);
+    }
+  }
+}
+
+}  // namespace detail
+/// @endcond
+
+/// @brief the type used to store q-function derivatives of type T
+template <typename T, bool symmetric, typename = void>
+struct derivative_storage {
+  using type = T;  ///< derivatives are stored as-is by default
+};
+
+/// @overload
+template <typename T>
+struct derivative_storage<T, false,
+                          std::enable_if_t<(nonzero_entries<T>::value > 0) &&
+                                           (sizeof(T) > sizeof(double) * std::size_t(nonzero_entries<T>::value))>> {
+  using type = CompactDerivative<T>;  ///< derivatives with structurally zero blocks are stored without them
+};
+
+/// @overload
+template <typename S0, typename S1, typename F0, typename F1>
+struct derivative_storage<tuple<tuple<S0, S1>, tuple<F0, F1>>, true> {
+  using type = SymmetricDerivative<tuple<tuple<S0, S1>, tuple<F0, F1>>>;  ///< the symmetric blocks are packed
+};
+
+/**
+ * @brief the type used to store q-function derivatives of type T in single precision, see SinglePrecisionDerivative
+ *
+ * Derivatives with blocks of other types than double tensors aren't rounded, and are stored as derivative_storage
+ * would. Packing symmetric blocks isn't combined with rounding, so @a symmetric only matters for those.
+ */
+template <typename T, bool symmetric, typename = void>
+struct single_precision_derivative_storage {
+  using type = typename derivative_storage<T, symmetric>::type;  ///< derivatives that can't be rounded
+};
+
+/// @overload
+template <typename T, bool symmetric>
+struct single_precision_derivative_storage<T, symmetric, std::enable_if_t<(nonzero_entries<T>::value > 0)>> {
+  using type = SinglePrecisionDerivative<T>;  ///< the nonzero blocks, in single precision
+};
+
+/// @brief the type of the q-function derivatives read back from storage of type T
+template <typename T>
+struct unpacked_derivative {
+  using type = T;  ///< derivatives stored as-is
+};
+
+/// @overload
+template <typename T>
+struct unpacked_derivative<SymmetricDerivative<T>> {
+  using type = T;  ///< derivatives with packed symmetric blocks
+};
+
+/// @overload
+template <typename T>
+struct unpacked_derivative<CompactDerivative<T>> {
+  using type = T;  ///< derivatives without their structurally zero blocks
+};
+
+/// @overload
+template <typename T>
+struct unpacked_derivative<SinglePrecisionDerivative<T>> {
+  using type = T;  ///< derivatives in single precision
+};
+
+/// @brief write the q-function derivatives at a quadrature point to their storage
+template <typename S, typename T>
+SERAC_HOST_DEVICE void store_derivative(S& slot, const T& value)
+{
+  slot = value;
+}
+
+/// @overload
+template <typename S, typename T>
+SERAC_HOST_DEVICE void store_derivative(SymmetricDerivative<S>& slot, const T& value)
+{
+  slot.source_value    = pack_symmetric(get<0>(get<0>(value)));
+  slot.source_gradient = get<1>(get<0>(value));
+  slot.flux_value      = get<0>(get<1>(value));
+  slot.flux_gradient   = pack_symmetric(get<1>(get<1>(value)));
+}
+
+/// @overload
+template <typename S, typename T>
+SERAC_HOST_DEVICE void store_derivative(CompactDerivative<S>& slot, const T& value)
+{
+  double* values = &slot.values[0];
+  detail::gather_nonzero_blocks(value, values);
+}
+
+/// @overload
+template <typename S, typename T>
+SERAC_HOST_DEVICE void store_derivative(SinglePrecisionDerivative<S>& slot, const T& value)
+{
+  float* values = &slot.values[0];
+  detail::gather_nonzero_blocks(value, values);
+}
+
+/// @brief read the q-function derivatives at a quadrature point from their storage
+template <typename S>
+SERAC_HOST_DEVICE const S& load_derivative(const S& slot)
+{
+  return slot;
+}
+
+/// @overload
+template <typename S>
+SERAC_HOST_DEVICE S load_derivative(const SymmetricDerivative<S>& slot)
+{
+  using source_type = std::decay_t<decltype(get<0>(S{}))>;
+  using flux_type   = std::decay_t<decltype(get<1>(S{}))>;
+  using S0          = std::decay_t<decltype(get<0>(source_type{}))>;
+  using F1          = std::decay_t<decltype(get<1>(flux_type{}))>;
+  return S{source_type{unpack_symmetric<S0>(slot.source_value), slot.source_gradient},
+           flux_type{slot.flux_value, unpack_symmetric<F1>(slot.flux_gradient)}};
+}
+
+/// @overload
+template <typename S>
+SERAC_HOST_DEVICE S load_derivative(const CompactDerivative<S>& slot)
+{
+  S             value{};
+  const double* values = &slot.values[0];
+  detail::scatter_nonzero_blocks(value, values);
+  return value;
+}
+
+/// @overload
+template <typename S>
+SERAC_HOST_DEVICE S load_derivative(const SinglePrecisionDerivative<S>& slot)
+{
+  S            value{};
+  const float* values = &slot.values[0];
+  detail::scatter_nonzero_blocks(value, values);
+  return value;
+}
+
+}  // namespace serac
@@ -257,10 +257,10 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
   template <typename in_t, int q>
   static auto batch_apply_shape_fn(int j, tensor<in_t, q * q * q> input, const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool                     apply_weights = false;
+    static constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
 
     // figure out which node and which direction
     // correspond to the dof index "j"
@@ -287,6 +287,28 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
         break;
     }
 
+    // shape function j is phi(x, y, z) * e_dir, where phi is a product of 1D polynomials: Gauss-Legendre
+    // along the direction `dir` and Gauss-Lobatto along the other two. Its curl, grad(phi) x e_dir, only
+    // has components along the other two directions a1, a2:
+    //
+    //   curl[a1] = d(phi)/d(a2), curl[a2] = -d(phi)/d(a1)
+    //
+    // so we tabulate the 1D factors (and their derivatives) along each axis once, rather than
+    // re-deriving them at every quadrature point
+    const int node[3] = {jx, jy, jz};
+
+    tensor<double, 3, q> b{};
+    tensor<double, 3, q> g{};
+    for (int axis = 0; axis < 3; axis++) {
+      for (int i = 0; i < q; i++) {
+        b(axis, i) = (axis == dir) ? B1(i, node[axis]) : B2(i, node[axis]);
+        g(axis, i) = (axis == dir) ? 0.0 : G2(i, node[axis]);
+      }
+    }
+
+    const int a1 = (dir + 1) % 3;
+    const int a2 = (dir + 2) % 3;
+
     using source_t = decltype(dot(get<0>(get<0>(in_t{})), vec3{}) + dot(get<1>(get<0>(in_t{})), vec3{}));
     using flux_t   = decltype(dot(get<0>(get<1>(in_t{})), vec3{}) + dot(get<1>(get<1>(in_t{})), vec3{}));
 
@@ -295,28 +317,14 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
     for (int qz = 0; qz < q; qz++) {
       for (int qy = 0; qy < q; qy++) {
         for (int qx = 0; qx < q; qx++) {
+          const int qpt[3] = {qx, qy, qz};
+
           tensor<double, 3> phi_j{};
           tensor<double, 3> curl_phi_j{};
 
-          switch (dir) {
-            case 0:
-              phi_j[0]      = B1(qx, jx) * B2(qy, jy) * B2(qz, jz);
-              curl_phi_j[1] = B1(qx, jx) * B2(qy, jy) * G2(qz, jz);
-              curl_phi_j[2] = -B1(qx, jx) * G2(qy, jy) * B2(qz, jz);
-              break;
-
-            case 1:
-              curl_phi_j[0] = -B2(qx, jx) * B1(qy, jy) * G2(qz, jz);
-              phi_j[1]      = B2(qx, jx) * B1(qy, jy) * B2(qz, jz);
-              curl_phi_j[2] = G2(qx, jx) * B1(qy, jy) * B2(qz, jz);
-              break;
-
-            case 2:
-              curl_phi_j[0] = B2(qx, jx) * G2(qy, jy) * B1(qz, jz);
-              curl_phi_j[1] = -G2(qx, jx) * B2(qy, jy) * B1(qz, jz);
-              phi_j[2]      = B2(qx, jx) * B2(qy, jy) * B1(qz, jz);
-              break;
-          }
+          phi_j[dir]     = b(0, qx) * b(1, qy) * b(2, qz);
+          curl_phi_j[a1] = b(dir, qpt[dir]) * b(a1, qpt[a1]) * g(a2, qpt[a2]);
+          curl_phi_j[a2] = -b(dir, qpt[dir]) * g(a1, qpt[a1]) * b(a2, qpt[a2]);
 
           int   Q   = (qz * q + qy) * q + qx;
           auto& d00 = get<0>(get<0>(input(Q)));
@@ -335,10 +343,10 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
   template <int q>
   SERAC_HOST_DEVICE static auto interpolate(const dof_type& element_values, const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool                     apply_weights = false;
+    static constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
 
     tensor<tensor<double, q, q, q>, 3> value{};
     tensor<tensor<double, q, q, q>, 3> curl{};
@@ -398,10 +406,10 @@ struct finite_element<mfem::Geometry::CUBE, Hcurl<p>> {
                                           const TensorProductQuadratureRule<q>&, dof_type* element_residual,
                                           [[maybe_unused]] int step = 1)
   {
-    constexpr bool                     apply_weights = true;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool                     apply_weights = true;
+    static constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
 
     tensor<double, 3, q, q, q> source{};
     tensor<double, 3, q, q, q> flux{};
@@ -66,7 +66,8 @@ struct finite_element<g, QOI> {
       }
     }
 
-    if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON) {
+    if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON ||
+                  geometry == mfem::Geometry::PRISM) {
       static constexpr auto wts = GaussLegendreWeights<q, geometry>();
       for (int k = 0; k < leading_dimension(wts); k++) {
         element_total[0] += qf_output[k] * wts[k];
@@ -121,7 +122,8 @@ struct finite_element<g, QOI> {
         }
       }
 
-      if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON) {
+      if constexpr (geometry == mfem::Geometry::TRIANGLE || geometry == mfem::Geometry::TETRAHEDRON ||
+                  geometry == mfem::Geometry::PRISM) {
         static constexpr auto wts = GaussLegendreWeights<q, geometry>();
         for (int k = 0; k < leading_dimension(wts); k++) {
           element_total[j * step] += reinterpret_cast<const double*>(&get<0>(qf_output[k]))[j] * wts[k];
@@ -245,10 +245,10 @@ struct finite_element<mfem::Geometry::SQUARE, Hcurl<p> > {
   template <typename in_t, int q>
   static auto batch_apply_shape_fn(int j, tensor<in_t, q * q> input, const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool                     apply_weights = false;
+    static constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
 
     int jx, jy;
     int dir = j / ((p + 1) * p);
@@ -287,10 +287,10 @@ struct finite_element<mfem::Geometry::SQUARE, Hcurl<p> > {
   template <int q>
   SERAC_HOST_DEVICE static auto interpolate(const dof_type& element_values, const TensorProductQuadratureRule<q>&)
   {
-    constexpr bool                     apply_weights = false;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool                     apply_weights = false;
+    static constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
 
     tensor<double, 2, q, q> value{};
     tensor<double, q, q>    curl{};
@@ -327,10 +327,10 @@ struct finite_element<mfem::Geometry::SQUARE, Hcurl<p> > {
                                           const TensorProductQuadratureRule<q>&, dof_type* element_residual,
                                           [[maybe_unused]] int step = 1)
   {
-    constexpr bool                     apply_weights = true;
-    constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
-    constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
+    static constexpr bool                     apply_weights = true;
+    static constexpr tensor<double, q, p>     B1            = calculate_B1<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> B2            = calculate_B2<apply_weights, q>();
+    static constexpr tensor<double, q, p + 1> G2            = calculate_G2<apply_weights, q>();
 
     tensor<double, 2, q, q> source{};
     tensor<double, q, q>    flux{};
@@ -335,19 +335,64 @@ struct finite_element<mfem::Geometry::TETRAHEDRON, H1<p, c> > {
     return output;
   }
 
+  /**
+   * @brief B(i, j) is the jth shape function evaluated at the ith quadrature point
+   *
+   * @tparam apply_weights optionally multiply the rows of B by the associated quadrature weight
+   * @tparam q a parameter that controls the number of quadrature points
+   *
+   * @note this is evaluated at compile time, so the kernels below only look up the values
+   */
+  template <bool apply_weights, int q>
+  static constexpr auto calculate_B()
+  {
+    constexpr auto                  xi      = GaussLegendreNodes<q, mfem::Geometry::TETRAHEDRON>();
+    [[maybe_unused]] constexpr auto weights = GaussLegendreWeights<q, mfem::Geometry::TETRAHEDRON>();
+
+    tensor<double, nqpts(q), ndof> B{};
+    for (int i = 0; i < nqpts(q); i++) {
+      B[i] = shape_functions(xi[i]);
+      if constexpr (apply_weights) B[i] = B[i] * weights[i];
+    }
+    return B;
+  }
+
+  /**
+   * @brief G(i, j) is the gradient of the jth shape function evaluated at the ith quadrature point
+   *
+   * @tparam apply_weights optionally multiply the rows of G by the associated quadrature weight
+   * @tparam q a parameter that controls the number of quadrature points
+   *
+   * @note this is evaluated at compile time, so the kernels below only look up the values
+   */
+  template <bool apply_weights, int q>
+  static constexpr auto calculate_G()
+  {
+    constexpr auto                  xi      = GaussLegendreNodes<q, mfem::Geometry::TETRAHEDRON>();
+    [[maybe_unused]] constexpr auto weights = GaussLegendreWeights<q, mfem::Geometry::TETRAHEDRON>();
+
+    tensor<double, nqpts(q), ndof, dim> G{};
+    for (int i = 0; i < nqpts(q); i++) {
+      G[i] = shape_function_gradients(xi[i]);
+      if constexpr (apply_weights) G[i] = G[i] * weights[i];
+    }
+    return G;
+  }
+
   template <typename in_t, int q>
   static auto batch_apply_shape_fn(int j, tensor<in_t, nqpts(q)> input, const TensorProductQuadratureRule<q>&)
   {
     using source_t = decltype(get<0>(get<0>(in_t{})) + dot(get<1>(get<0>(in_t{})), tensor<double, dim>{}));
     using flux_t   = decltype(get<0>(get<1>(in_t{})) + dot(get<1>(get<1>(in_t{})), tensor<double, dim>{}));
 
-    constexpr auto xi = GaussLegendreNodes<q, mfem::Geometry::TETRAHEDRON>();
+    static constexpr auto B = calculate_B<false, q>();
+    static constexpr auto G = calculate_G<false, q>();
 
     tensor<tuple<source_t, flux_t>, nqpts(q)> output;
 
     for (int i = 0; i < nqpts(q); i++) {
-      double              phi_j      = shape_function(xi[i], j);
-      tensor<double, dim> dphi_j_dxi = shape_function_gradient(xi[i], j);
+      double              phi_j      = B(i, j);
+      tensor<double, dim> dphi_j_dxi = G[i][j];
 
       auto& d00 = get<0>(get<0>(input(i)));
       auto& d01 = get<1>(get<0>(input(i)));
@@ -363,7 +408,8 @@ struct finite_element<mfem::Geometry::TETRAHEDRON, H1<p, c> > {
   template <int q>
   SERAC_HOST_DEVICE static auto interpolate(const tensor<double, c, ndof>& X, const TensorProductQuadratureRule<q>&)
   {
-    constexpr auto xi = GaussLegendreNodes<q, mfem::Geometry::TETRAHEDRON>();
+    static constexpr auto B = calculate_B<false, q>();
+    static constexpr auto G = calculate_G<false, q>();
 
     // transpose the quadrature data into a flat tensor of tuples
     union {
@@ -371,12 +417,11 @@ struct finite_element<mfem::Geometry::TETRAHEDRON, H1<p, c> > {
       tensor<qf_input_type, nqpts(q)>                                     flattened;
     } output{};
 
-    for (int i = 0; i < c; i++) {
-      for (int j = 0; j < nqpts(q); j++) {
-        for (int k = 0; k < ndof; k++) {
-          get<VALUE>(output.unflattened[j])[i] += X(i, k) * shape_function(xi[j], k);
-          get<GRADIENT>(output.unflattened[j])[i] += X(i, k) * shape_function_gradient(xi[j], k);
-        }
+    // the values and gradients of each component are small dense products with the tabulated basis
+    for (int j = 0; j < nqpts(q); j++) {
+      for (int i = 0; i < c; i++) {
+        get<VALUE>(output.unflattened[j])[i]    = dot(B[j], X[i]);
+        get<GRADIENT>(output.unflattened[j])[i] = dot(X[i], G[j]);
       }
     }
 
@@ -395,16 +440,15 @@ struct finite_element<mfem::Geometry::TETRAHEDRON, H1<p, c> > {
     using source_component_type = std::conditional_t<is_zero<source_type>{}, zero, double>;
     using flux_component_type   = std::conditional_t<is_zero<flux_type>{}, zero, tensor<double, dim> >;
 
-    constexpr int  ntrial              = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
-    constexpr auto integration_points  = GaussLegendreNodes<q, mfem::Geometry::TETRAHEDRON>();
-    constexpr auto integration_weights = GaussLegendreWeights<q, mfem::Geometry::TETRAHEDRON>();
+    constexpr int ntrial = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
+
+    // note: the quadrature weights are folded into these tables
+    static constexpr auto B = calculate_B<true, q>();
+    static constexpr auto G = calculate_G<true, q>();
 
     for (int j = 0; j < ntrial; j++) {
       for (int i = 0; i < c; i++) {
         for (int Q = 0; Q < nqpts(q); Q++) {
-          tensor<double, dim> xi = integration_points[Q];
-          double              wt = integration_weights[Q];
-
           source_component_type source;
           if constexpr (!is_zero<source_type>{}) {
             source = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
@@ -417,10 +461,7 @@ struct finite_element<mfem::Geometry::TETRAHEDRON, H1<p, c> > {
             }
           }
 
-          for (int k = 0; k < ndof; k++) {
-            element_residual[j * step](i, k) +=
-                (source * shape_function(xi, k) + dot(flux, shape_function_gradient(xi, k))) * wt;
-          }
+          element_residual[j * step][i] += source * B[Q] + dot(G[Q], flux);
         }
       }
     }
@@ -0,0 +1,194 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file wedge_H1.inl
+ *
+ * @brief Specialization of finite_element for H1 on wedge (triangular prism) geometry
+ */
+
+// this specialization defines the linear shape functions (and their gradients) on a wedge,
+// i.e. the product of the linear triangle basis in (xi[0], xi[1]) and the linear segment basis in xi[2]
+//
+// note: mfem assumes the parent element domain is the convex hull of
+// {{0,0,0}, {1,0,0}, {0,1,0}, {0,0,1}, {1,0,1}, {0,1,1}}, and numbers the nodes in that order
+// for additional information on the finite_element concept requirements, see finite_element.hpp
+//
+// only p == 1 is implemented, so finite_element<mfem::Geometry::PRISM, H1<p, c> > is left undefined for p > 1
+// (see has_finite_element in finite_element.hpp)
+/// @cond
+template <int c>
+struct finite_element<mfem::Geometry::PRISM, H1<1, c> > {
+  static constexpr auto geometry   = mfem::Geometry::PRISM;
+  static constexpr auto family     = Family::H1;
+  static constexpr int  components = c;
+  static constexpr int  dim        = 3;
+  static constexpr int  n          = 2;
+  static constexpr int  ndof       = 6;
+  static constexpr int  order      = 1;
+  static constexpr int  nqpts(int q) { return num_quadrature_points(mfem::Geometry::PRISM, q); }
+
+  static constexpr int VALUE = 0, GRADIENT = 1;
+  static constexpr int SOURCE = 0, FLUX = 1;
+
+  using residual_type =
+      typename std::conditional<components == 1, tensor<double, ndof>, tensor<double, ndof, components> >::type;
+
+  using dof_type = tensor<double, c, ndof>;
+
+  using value_type = typename std::conditional<components == 1, double, tensor<double, components> >::type;
+  using derivative_type =
+      typename std::conditional<components == 1, tensor<double, dim>, tensor<double, components, dim> >::type;
+  using qf_input_type = tuple<value_type, derivative_type>;
+
+  SERAC_HOST_DEVICE static constexpr double shape_function(tensor<double, dim> xi, int i)
+  {
+    switch (i) {
+      case 0:
+        return (1 - xi[0] - xi[1]) * (1 - xi[2]);
+      case 1:
+        return xi[0] * (1 - xi[2]);
+      case 2:
+        return xi[1] * (1 - xi[2]);
+      case 3:
+        return (1 - xi[0] - xi[1]) * xi[2];
+      case 4:
+        return xi[0] * xi[2];
+      case 5:
+        return xi[1] * xi[2];
+    }
+    return 0.0;
+  }
+
+  SERAC_HOST_DEVICE static constexpr tensor<double, dim> shape_function_gradient(tensor<double, dim> xi, int i)
+  {
+    switch (i) {
+      case 0:
+        return {-(1 - xi[2]), -(1 - xi[2]), -(1 - xi[0] - xi[1])};
+      case 1:
+        return {1 - xi[2], 0, -xi[0]};
+      case 2:
+        return {0, 1 - xi[2], -xi[1]};
+      case 3:
+        return {-xi[2], -xi[2], 1 - xi[0] - xi[1]};
+      case 4:
+        return {xi[2], 0, xi[0]};
+      case 5:
+        return {0, xi[2], xi[1]};
+    }
+    return {};
+  }
+
+  SERAC_HOST_DEVICE static constexpr tensor<double, ndof> shape_functions(tensor<double, dim> xi)
+  {
+    tensor<double, ndof> output{};
+    for (int i = 0; i < ndof; i++) {
+      output[i] = shape_function(xi, i);
+    }
+    return output;
+  }
+
+  SERAC_HOST_DEVICE static constexpr tensor<double, ndof, dim> shape_function_gradients(tensor<double, dim> xi)
+  {
+    tensor<double, ndof, dim> output{};
+    for (int i = 0; i < ndof; i++) {
+      output[i] = shape_function_gradient(xi, i);
+    }
+    return output;
+  }
+
+  template <typename in_t, int q>
+  static auto batch_apply_shape_fn(int j, tensor<in_t, nqpts(q)> input, const TensorProductQuadratureRule<q>&)
+  {
+    using source_t = decltype(get<0>(get<0>(in_t{})) + dot(get<1>(get<0>(in_t{})), tensor<double, dim>{}));
+    using flux_t   = decltype(get<0>(get<1>(in_t{})) + dot(get<1>(get<1>(in_t{})), tensor<double, dim>{}));
+
+    constexpr auto xi = GaussLegendreNodes<q, mfem::Geometry::PRISM>();
+
+    tensor<tuple<source_t, flux_t>, nqpts(q)> output;
+
+    for (int i = 0; i < nqpts(q); i++) {
+      double              phi_j      = shape_function(xi[i], j);
+      tensor<double, dim> dphi_j_dxi = shape_function_gradient(xi[i], j);
+
+      auto& d00 = get<0>(get<0>(input(i)));
+      auto& d01 = get<1>(get<0>(input(i)));
+      auto& d10 = get<0>(get<1>(input(i)));
+      auto& d11 = get<1>(get<1>(input(i)));
+
+      output[i] = {d00 * phi_j + dot(d01, dphi_j_dxi), d10 * phi_j + dot(d11, dphi_j_dxi)};
+    }
+
+    return output;
+  }
+
+  template <int q>
+  SERAC_HOST_DEVICE static auto interpolate(const tensor<double, c, ndof>& X, const TensorProductQuadratureRule<q>&)
+  {
+    constexpr auto xi = GaussLegendreNodes<q, mfem::Geometry::PRISM>();
+
+    // transpose the quadrature data into a flat tensor of tuples
+    union {
+      tensor<tuple<tensor<double, c>, tensor<double, c, dim> >, nqpts(q)> unflattened;
+      tensor<qf_input_type, nqpts(q)>                                     flattened;
+    } output{};
+
+    for (int i = 0; i < c; i++) {
+      for (int j = 0; j < nqpts(q); j++) {
+        for (int k = 0; k < ndof; k++) {
+          get<VALUE>(output.unflattened[j])[i] += X(i, k) * shape_function(xi[j], k);
+          get<GRADIENT>(output.unflattened[j])[i] += X(i, k) * shape_function_gradient(xi[j], k);
+        }
+      }
+    }
+
+    return output.flattened;
+  }
+
+  template <typename source_type, typename flux_type, int q>
+  SERAC_HOST_DEVICE static void integrate(const tensor<tuple<source_type, flux_type>, nqpts(q)>& qf_output,
+                                          const TensorProductQuadratureRule<q>&,
+                                          tensor<double, c, ndof>* element_residual, int step = 1)
+  {
+    if constexpr (is_zero<source_type>{} && is_zero<flux_type>{}) {
+      return;
+    }
+
+    using source_component_type = std::conditional_t<is_zero<source_type>{}, zero, double>;
+    using flux_component_type   = std::conditional_t<is_zero<flux_type>{}, zero, tensor<double, dim> >;
+
+    constexpr int  ntrial              = std::max(size(source_type{}), size(flux_type{}) / dim) / c;
+    constexpr auto integration_points  = GaussLegendreNodes<q, mfem::Geometry::PRISM>();
+    constexpr auto integration_weights = GaussLegendreWeights<q, mfem::Geometry::PRISM>();
+
+    for (int j = 0; j < ntrial; j++) {
+      for (int i = 0; i < c; i++) {
+        for (int Q = 0; Q < nqpts(q); Q++) {
+          tensor<double, dim> xi = integration_points[Q];
+          double              wt = integration_weights[Q];
+
+          source_component_type source;
+          if constexpr (!is_zero<source_type>{}) {
+            source = reinterpret_cast<const double*>(&get<SOURCE>(qf_output[Q]))[i * ntrial + j];
+          }
+
+          flux_component_type flux;
+          if constexpr (!is_zero<flux_type>{}) {
+            for (int k = 0; k < dim; k++) {
+              flux[k] = reinterpret_cast<const double*>(&get<FLUX>(qf_output[Q]))[(i * dim + k) * ntrial + j];
+            }
+          }
+
+          for (int k = 0; k < ndof; k++) {
+            element_residual[j * step](i, k) +=
+                (source * shape_function(xi, k) + dot(flux, shape_function_gradient(xi, k))) * wt;
+          }
+        }
+      }
+    }
+  }
+};
+/// @endcond
@@ -7,13 +7,40 @@
 
 #include "mfem.hpp"
 
+#include "serac/serac_config.hpp"
 #include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
 
 #include "serac/numerics/functional/integral.hpp"
 #include "serac/numerics/functional/element_restriction.hpp"
 
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
 namespace serac {
 
+/**
+ * @brief the type of the indices of the local nonzero entries of an assembled gradient, see
+ * GradientAssemblyLookupTables
+ *
+ * These are 32-bit unless Serac is configured with SERAC_ENABLE_64BIT_INDICES, for ranks with more than 2^32 local
+ * nonzero entries. The rows and columns are the L-vector dofs, whose number is limited by mfem::Vector anyway.
+ */
+#ifdef SERAC_USE_64BIT_INDICES
+using nonzero_index = uint64_t;
+#else
+using nonzero_index = uint32_t;
+#endif
+
+/// how the gradient of a Functional finds the nonzero entry that each entry of its element matrices is added to
+enum class GradientLookup
+{
+  Precomputed,  ///< from the contributions of every element matrix entry, kept by the lookup tables (fastest)
+  BinarySearch  ///< by a binary search of the columns of each entry's row, keeping only the sparsity pattern
+};
+
 /**
  * @brief a (poorly named) tuple of quantities used to discover the sparsity
  * pattern associated with element and boundary element matrices.
@@ -60,13 +87,13 @@ inline bool operator!=(const ElemInfo& x, const ElemInfo& y)
  */
 struct SignedIndex {
   /// the actual index of some quantity
-  uint32_t index_;
+  nonzero_index index_;
 
   /// whether or not the value associated with this index is positive or negative
   int sign_;
 
-  /// the implicit conversion to int extracts only the index
-  operator uint32_t() { return index_; }
+  /// the implicit conversion to an integer extracts only the index
+  operator nonzero_index() { return index_; }
 };
 
 /**
@@ -77,7 +104,7 @@ struct SignedIndex {
  */
 inline SignedIndex decodeSignedIndex(int i)
 {
-  return SignedIndex{static_cast<uint32_t>((i >= 0) ? i : -1 - i), (i >= 0) ? 1 : -1};
+  return SignedIndex{static_cast<nonzero_index>((i >= 0) ? i : -1 - i), (i >= 0) ? 1 : -1};
 }
 
 /**
@@ -90,6 +117,20 @@ inline bool isHcurl(const mfem::ParFiniteElementSpace& fes)
   return (fes.FEColl()->GetContType() == mfem::FiniteElementCollection::TANGENTIAL);
 }
 
+/**
+ * @brief return whether or not two finite element spaces number their degrees of freedom identically
+ * (i.e. they are the same space, or are defined by the same finite element collection on the same mesh)
+ *
+ * @param a the first finite element space
+ * @param b the second finite element space
+ */
+inline bool haveSameDofLayout(const mfem::ParFiniteElementSpace& a, const mfem::ParFiniteElementSpace& b)
+{
+  if (&a == &b) return true;
+  return (a.GetParMesh() == b.GetParMesh()) && (a.GetVDim() == b.GetVDim()) && (a.GetOrdering() == b.GetOrdering()) &&
+         (std::string(a.FEColl()->Name()) == b.FEColl()->Name());
+}
+
 /**
  * @brief return whether or not the underlying function space is L2 or not
  *
@@ -238,136 +279,744 @@ struct DofNumbering {
   CPUArray<SignedIndex, 2> bdr_element_dofs_;
 };
 
+/**
+ * @brief the parts of GradientAssemblyLookupTables that the nonzero entries of the sparse matrix are gathered from, as
+ * raw pointers into either the tables themselves or copies of them in device memory, see gatherNonzeros()
+ */
+struct GradientGatherTables {
+  const std::size_t*                         contribution_offsets;    ///< see GradientAssemblyLookupTables
+  const uint32_t*                            contributions;           ///< see GradientAssemblyLookupTables
+  const std::size_t*                         element_matrix_offsets;  ///< see GradientAssemblyLookupTables
+  const std::pair<uint32_t, uint32_t>*       element_matrix_nodes;    ///< see GradientAssemblyLookupTables
+  const std::pair<std::size_t, std::size_t>* element_matrix_strides;  ///< see GradientAssemblyLookupTables
+  const nonzero_index*                       row_ptr;                 ///< see GradientAssemblyLookupTables
+  const nonzero_index*                       block_row_ptr;           ///< see GradientAssemblyLookupTables
+  nonzero_index                              nnz;                     ///< the number of nonzero entries
+  uint32_t                                   num_test_nodes;          ///< the number of rows of blocks
+  uint32_t                                   test_components;         ///< see GradientAssemblyLookupTables
+  uint32_t                                   trial_components;        ///< see GradientAssemblyLookupTables
+  bool                                       blocked;                 ///< see GradientAssemblyLookupTables::blocked()
+  bool test_by_nodes;   ///< whether the test space orders its vdofs mfem::Ordering::byNODES
+  bool trial_by_nodes;  ///< whether the trial space orders its vdofs mfem::Ordering::byNODES
+};
+
 /**
  * @brief this object figures out the sparsity pattern associated with a finite element discretization
  *   of the given test and trial function spaces, and records which nonzero each element "stiffness"
  *   matrix maps to, to facilitate assembling the element matrices into the global sparse matrix. e.g.
  *
- *   element_nonzero_LUT(e, i, j) says where (in the global sparse matrix)
- *   to put the (i,j) component of the matrix associated with element element matrix `e`
+ *   element_nonzero_LUT[type][geom][(e * trial_vdofs + i) * test_vdofs + j] says where (in the global
+ *   sparse matrix) to put the (i,j) component of the matrix associated with element `e`, and with
+ *   which sign.
  *
  * Note: due to an internal inconsistency between mfem::FiniteElementSpace and mfem::FaceRestriction,
  *    we choose to use the Restriction operator as the "source of truth", since we are also using its
  *    convention for quadrature point numbering.
  */
 struct GradientAssemblyLookupTables {
-  /// @brief a type for representing a nonzero entry in a sparse matrix
-  struct Entry {
-    uint32_t row;     ///< row value for this nonzero Entry
-    uint32_t column;  ///< column value for this nonzero Entry
-
-    /// operator< is used when sorting `Entry`. Lexicographical ordering
-    bool operator<(const Entry& other) const
-    {
-      return (row < other.row) || ((row == other.row) && (column < other.column));
-    }
-
-    /// operator== is required for use in `std::unordered_map`
-    bool operator==(const Entry& other) const { return (row == other.row && column == other.column); }
-
-    /// hash functor required for use in `std::unordered_map`
-    struct Hasher {
-      /// @brief a hash function implementation for `Entry`
-      std::size_t operator()(const Entry& k) const
-      {
-        std::size_t seed = std::hash<uint32_t>()(k.row);
-        seed ^= std::hash<uint32_t>()(k.column) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
-        return seed;
-      }
-    };
-  };
-
   /**
-   * @param block_test_dofs object containing information about dofs for the test space
-   * @param block_trial_dofs object containing information about dofs for the trial space
+   * @param test_restrictions the dofs of the test space, for each kind of domain
+   * @param trial_restrictions the dofs of the trial space, for each kind of domain
    *
    * @brief create lookup tables describing which degrees of freedom
-   * correspond to each domain/boundary element
+   * correspond to each domain/boundary element and interior face
+   *
+   * @param lookup whether to keep the contributions of every element matrix entry to the nonzero entries, or only
+   * the sparsity pattern (which takes much less memory, but slower assemblies), see GradientLookup
+   *
+   * @note restrictions that were never built (e.g. for interior faces, when the Functional has no interior face
+   * integrals) have no geometries, and don't contribute to the sparsity pattern
    */
-  GradientAssemblyLookupTables(const serac::BlockElementRestriction& block_test_dofs,
-                               const serac::BlockElementRestriction& block_trial_dofs)
+  GradientAssemblyLookupTables(
+      const std::array<const serac::BlockElementRestriction*, Domain::num_types>& test_restrictions,
+      const std::array<const serac::BlockElementRestriction*, Domain::num_types>& trial_restrictions,
+      GradientLookup lookup_method = GradientLookup::Precomputed)
+      : lookup(lookup_method)
   {
-    // we start by having each element and boundary element emit the (i,j) entry that it
-    // touches in the global "stiffness matrix", and also keep track of some metadata about
-    // which element and which dof are associated with that particular nonzero entry
-    for (const auto& [geometry, trial_dofs] : block_trial_dofs.restrictions) {
-      const auto& test_dofs = block_test_dofs.restrictions.at(geometry);
-
-      std::vector<DoF> test_vdofs(test_dofs.nodes_per_elem * test_dofs.components);
-      std::vector<DoF> trial_vdofs(trial_dofs.nodes_per_elem * trial_dofs.components);
-
-      auto num_elements = static_cast<uint32_t>(trial_dofs.num_elements);
-      for (uint32_t e = 0; e < num_elements; e++) {
-        for (uint64_t i = 0; i < uint64_t(test_dofs.dof_info.shape()[1]); i++) {
-          auto test_dof = test_dofs.dof_info(e, i);
-
-          for (uint64_t j = 0; j < uint64_t(trial_dofs.dof_info.shape()[1]); j++) {
-            auto trial_dof = trial_dofs.dof_info(e, j);
-
-            for (uint64_t k = 0; k < test_dofs.components; k++) {
-              uint32_t test_global_id = uint32_t(test_dofs.GetVDof(test_dof, k).index());
-              for (uint64_t l = 0; l < trial_dofs.components; l++) {
-                uint32_t trial_global_id                  = uint32_t(trial_dofs.GetVDof(trial_dof, l).index());
-                nz_LUT[{test_global_id, trial_global_id}] = 0;  // just store the keys initially
-              }
-            }
-          }
+    // `element_nonzero_LUT[type][geom]` holds the index of the `col_ind` / `value` CSR arrays (and the sign)
+    // for every entry of every element matrix of the given domain type and geometry (or the index of the
+    // `block_col_ind` array for every node-node block, see blocked())
+    std::map<mfem::Geometry::Type, std::vector<SignedIndex>> element_nonzero_LUT[Domain::num_types];
+
+    // calls f(test_dofs, trial_dofs, slots) for each pair of restrictions that contribute to the matrix
+    auto for_each_block = [&](auto&& f) {
+      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+        for (const auto& [geometry, test_dofs] : test_restrictions[type]->restrictions) {
+          if (trial_restrictions[type]->restrictions.count(geometry) == 0) continue;
+          f(test_dofs, trial_restrictions[type]->restrictions.at(geometry), element_nonzero_LUT[type][geometry]);
         }
       }
-    }
-    std::vector<Entry> entries(nz_LUT.size());
+    };
 
-    uint32_t count = 0;
-    for (auto [key, value] : nz_LUT) {
-      entries[count++] = key;
+    // vector-valued spaces couple every component of a test node to every component of the trial nodes of its
+    // elements, so their nonzero entries are looked up for each node-node block instead (see blocked())
+    bool first_block = true;
+    bool uniform     = true;
+    for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto&) {
+      if (first_block) {
+        test_components  = uint32_t(test_dofs.components);
+        trial_components = uint32_t(trial_dofs.components);
+        num_test_nodes   = uint32_t(test_dofs.num_nodes);
+        num_trial_nodes  = uint32_t(trial_dofs.num_nodes);
+        test_ordering    = test_dofs.ordering;
+        trial_ordering   = trial_dofs.ordering;
+        first_block      = false;
+      }
+      uniform = uniform && test_components == test_dofs.components && trial_components == trial_dofs.components &&
+                num_test_nodes == test_dofs.num_nodes && num_trial_nodes == trial_dofs.num_nodes &&
+                test_ordering == test_dofs.ordering && trial_ordering == trial_dofs.ordering;
+    });
+    if (!uniform) {
+      test_components  = 1;
+      trial_components = 1;
     }
 
-    std::sort(entries.begin(), entries.end());
+    auto num_rows = static_cast<uint32_t>(test_restrictions[Domain::Type::Elements]->LSize());
+    if (blocked()) {
+      numberBlockNonzeros(for_each_block, num_rows);
+    } else {
+      numberNonzeros(for_each_block, num_rows);
+    }
 
-    nnz = static_cast<uint32_t>(nz_LUT.size());
-    row_ptr.resize(static_cast<size_t>(block_test_dofs.LSize() + 1));
-    col_ind.resize(nnz);
+    // finally, that map is inverted to list the element matrix entries that contribute to each nonzero (or each
+    // block of them). Assembly then computes every nonzero independently (a gather, rather than a scatter-add),
+    // so it can run in parallel without atomics or element coloring
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      for (const auto& [geometry, slots] : element_nonzero_LUT[type]) {
+        const auto& test_dofs  = test_restrictions[type]->restrictions.at(geometry);
+        const auto& trial_dofs = trial_restrictions[type]->restrictions.at(geometry);
+        auto        test_npe   = std::size_t(test_dofs.nodes_per_elem);
+        auto        trial_npe  = std::size_t(trial_dofs.nodes_per_elem);
+        element_matrix_blocks.push_back({type, geometry});
+        element_matrix_strides.push_back({test_npe, trial_npe * test_npe * test_components});
+        element_matrix_nodes.push_back({uint32_t(test_npe), uint32_t(trial_npe)});
+        element_matrix_offsets.push_back(element_matrix_offsets.back() + slots.size());
+      }
+    }
 
-    row_ptr[0] = 0;
-    col_ind[0] = int(entries[0].column);
+    if (lookup == GradientLookup::BinarySearch) return;
 
-    for (uint32_t i = 1; i < nnz; i++) {
-      nz_LUT[entries[i]] = i;
-      col_ind[i]         = int(entries[i].column);
+    SLIC_ERROR_IF(element_matrix_offsets.back() > std::size_t(sign_bit),
+                  axom::fmt::format("The element matrices have {} entries (or node-node blocks) that contribute to "
+                                    "the local gradient, more than its lookup tables can address, so it must use "
+                                    "GradientLookup::BinarySearch (or more ranks) instead",
+                                    element_matrix_offsets.back()));
 
-      // if the new entry has a different row, then the row_ptr offsets must be set as well
-      for (uint32_t j = entries[i - 1].row; j < entries[i].row; j++) {
-        row_ptr[j + 1] = int(i);
+    std::size_t num_lookups = blocked() ? block_col_ind.size() : std::size_t(nnz);
+    contribution_offsets.assign(num_lookups + 1, 0);
+    for (const auto& [type, geometry] : element_matrix_blocks) {
+      for (const auto& slot : element_nonzero_LUT[type].at(geometry)) {
+        contribution_offsets[slot.index_ + 1]++;
       }
     }
+    std::partial_sum(contribution_offsets.begin(), contribution_offsets.end(), contribution_offsets.begin());
+
+    // the blocks are visited in order, so the contributions to each nonzero are sorted by block (and position)
+    contributions.resize(contribution_offsets.back());
+    std::vector<std::size_t> position(contribution_offsets.begin(), contribution_offsets.end() - 1);
+    for (std::size_t block = 0; block < element_matrix_blocks.size(); block++) {
+      const auto& [type, geometry] = element_matrix_blocks[block];
+      const auto& slots            = element_nonzero_LUT[type].at(geometry);
+      for (std::size_t k = 0; k < slots.size(); k++) {
+        auto entry = uint32_t(element_matrix_offsets[block] + k);
+        contributions[position[slots[k].index_]++] = (slots[k].sign_ < 0) ? (entry | sign_bit) : entry;
+      }
+    }
+  }
+
+  /// @brief the bit of the packed `contributions` that is set for the entries subtracted from the sparse matrix
+  static constexpr uint32_t sign_bit = uint32_t(1) << 31;
 
-    row_ptr.back() = static_cast<int>(nnz);
+  /**
+   * @brief the offset into the flattened element matrices of one of the `element_matrix_blocks` of the first test and
+   * trial components of the node-node block at @a position of that block, for blocked() tables
+   *
+   * @param position the position of the entry among that block's, i.e. the packed index minus the block's offset
+   * @param nodes the number of test and trial nodes of each element of that block, see element_matrix_nodes
+   * @param test_components the number of components of the test space, see blocked()
+   * @param trial_components the number of components of the trial space, see blocked()
+   */
+  SERAC_HOST_DEVICE static std::size_t elementMatrixIndex(std::size_t position, std::pair<uint32_t, uint32_t> nodes,
+                                                          uint32_t test_components, uint32_t trial_components)
+  {
+    // the node-node blocks are ordered by (element, trial node, test node)
+    std::size_t test_npe  = nodes.first;
+    std::size_t trial_npe = nodes.second;
+    std::size_t e         = position / (trial_npe * test_npe);
+    std::size_t i         = (position / test_npe) % trial_npe;
+    std::size_t j         = position % test_npe;
+    return (e * trial_npe * trial_components + i) * test_npe * test_components + j;
   }
 
   /**
    * @brief return the index (into the nonzero entries) corresponding to entry (i,j)
    * @param i the row
    * @param j the column
+   *
+   * @note this performs a binary search over the (sorted) column indices of row i,
+   * assembly should use the precomputed `contributions` instead
    */
-  uint32_t operator()(int i, int j) const { return nz_LUT.at({uint32_t(i), uint32_t(j)}); }
+  nonzero_index operator()(int i, int j) const
+  {
+    auto row_begin = col_ind.begin() + static_cast<std::ptrdiff_t>(row_ptr[uint32_t(i)]);
+    auto row_end   = col_ind.begin() + static_cast<std::ptrdiff_t>(row_ptr[uint32_t(i) + 1]);
+    auto it        = std::lower_bound(row_begin, row_end, j);
+    SLIC_ERROR_IF(it == row_end || *it != j, "requested entry is not part of the sparsity pattern");
+    return static_cast<nonzero_index>(it - col_ind.begin());
+  }
+
+  /**
+   * @brief whether the nonzero entries are looked up for each block of test components x trial components entries
+   * that couple a test node to a trial node, rather than for each entry
+   *
+   * This is the case for vector-valued spaces (e.g. the displacements of solid mechanics), which couple every
+   * component of a test node to every component of the trial nodes of its elements. So their sparsity pattern is
+   * found by node, and their `contributions` list the element matrix blocks (rather than entries) that contribute to
+   * each nonzero block, which takes test_components * trial_components times fewer lookups and less memory.
+   */
+  bool blocked() const { return test_components * trial_components > 1; }
+
+  /// @brief the row of the sparse matrix of component @a c of test node @a n
+  uint32_t testRow(uint32_t n, uint32_t c) const
+  {
+    return (test_ordering == mfem::Ordering::byNODES) ? c * num_test_nodes + n : n * test_components + c;
+  }
+
+  /**
+   * @brief the nonzero entry of test component @a ct and trial component @a cr of the nonzero block @a k of test node
+   * @a n, for blocked() tables
+   */
+  nonzero_index blockEntry(uint32_t n, nonzero_index k, uint32_t ct, uint32_t cr) const
+  {
+    nonzero_index blocks = block_row_ptr[n + 1] - block_row_ptr[n];
+    nonzero_index q      = k - block_row_ptr[n];
+    return row_ptr[testRow(n, ct)] + ((trial_ordering == mfem::Ordering::byNODES) ? cr * blocks + q
+                                                                                   : q * trial_components + cr);
+  }
+
+  /// @brief raw pointers to the tables that assembly gathers the nonzero entries from, see gatherNonzeros()
+  GradientGatherTables gatherTables() const
+  {
+    return {contribution_offsets.data(),
+            contributions.data(),
+            element_matrix_offsets.data(),
+            element_matrix_nodes.data(),
+            element_matrix_strides.data(),
+            row_ptr.data(),
+            block_row_ptr.data(),
+            nnz,
+            num_test_nodes,
+            test_components,
+            trial_components,
+            blocked(),
+            test_ordering == mfem::Ordering::byNODES,
+            trial_ordering == mfem::Ordering::byNODES};
+  }
+
+  /// @brief the number of bytes allocated for the tables
+  std::size_t bytes() const
+  {
+    return memory::bytes(row_ptr) + memory::bytes(col_ind) + memory::bytes(element_matrix_blocks) +
+           memory::bytes(contribution_offsets) + memory::bytes(contributions) + memory::bytes(element_matrix_strides) +
+           memory::bytes(element_matrix_nodes) + memory::bytes(element_matrix_offsets) + memory::bytes(block_row_ptr) +
+           memory::bytes(block_col_ind);
+  }
+
+  /// @brief the sizes of the tables (and of the sparse matrix they describe) that the constructor builds, see plan()
+  struct Sizes {
+    std::size_t rows            = 0;     ///< the number of rows of the sparse matrix
+    std::size_t nnz             = 0;     ///< the number of nonzero entries of the sparse matrix
+    std::size_t element_entries = 0;     ///< the number of entries of all the element matrices
+    std::size_t blocks          = 0;     ///< the number of element_matrix_blocks
+    std::size_t block_size      = 1;     ///< the number of entries of each node-node block, see blocked()
+    std::size_t block_rows      = 0;     ///< the number of rows of blocks, for blocked() tables
+    bool        precomputed     = true;  ///< whether the contributions are kept, see GradientLookup
+
+    /// @brief the number of bytes the tables take, see GradientAssemblyLookupTables::bytes()
+    std::size_t bytes() const
+    {
+      std::size_t lookups = nnz / block_size;
+      std::size_t pattern = (rows + 1) * sizeof(nonzero_index) + nnz * sizeof(int);
+      if (block_size > 1) {
+        pattern += (block_rows + 1) * sizeof(nonzero_index) + lookups * sizeof(int);
+      }
+      pattern += blocks * (sizeof(std::pair<Domain::Type, mfem::Geometry::Type>) +
+                           sizeof(std::pair<std::size_t, std::size_t>) + sizeof(std::pair<uint32_t, uint32_t>)) +
+                 (blocks + 1) * sizeof(std::size_t);
+      if (!precomputed) {
+        return pattern;
+      }
+      return pattern + (lookups + 1) * sizeof(std::size_t) + element_entries / block_size * sizeof(uint32_t);
+    }
+  };
+
+  /**
+   * @brief the sizes of the tables that the constructor would build from the same restrictions, without building them
+   *
+   * The columns of each row are counted by node rather than by dof, using the elements that touch each test node, so
+   * this only needs memory proportional to the number of element nodes (rather than to the number of element matrix
+   * entries, like the constructor does).
+   */
+  static Sizes plan(const std::array<const serac::BlockElementRestriction*, Domain::num_types>& test_restrictions,
+                    const std::array<const serac::BlockElementRestriction*, Domain::num_types>& trial_restrictions,
+                    GradientLookup lookup_method = GradientLookup::Precomputed)
+  {
+    // the pairs of restrictions that contribute to the matrix, as in the constructor
+    std::vector<std::pair<const ElementRestriction*, const ElementRestriction*>> blocks;
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      for (const auto& [geometry, test_dofs] : test_restrictions[type]->restrictions) {
+        if (trial_restrictions[type]->restrictions.count(geometry) == 0) continue;
+        blocks.push_back({&test_dofs, &trial_restrictions[type]->restrictions.at(geometry)});
+      }
+    }
+
+    Sizes sizes;
+    sizes.rows        = test_restrictions[Domain::Type::Elements]->LSize();
+    sizes.blocks      = blocks.size();
+    sizes.precomputed = (lookup_method == GradientLookup::Precomputed);
+    if (blocks.empty()) return sizes;
+
+    // the (block, element) pairs that touch each test node, bucketed by node
+    std::size_t num_test_nodes  = 0;
+    std::size_t num_trial_nodes = 0;
+    bool        uniform         = true;
+    for (const auto& [test_dofs, trial_dofs] : blocks) {
+      num_test_nodes  = std::max(num_test_nodes, std::size_t(test_dofs->num_nodes));
+      num_trial_nodes = std::max(num_trial_nodes, std::size_t(trial_dofs->num_nodes));
+      sizes.element_entries += test_dofs->num_elements * test_dofs->nodes_per_elem * test_dofs->components *
+                               trial_dofs->nodes_per_elem * trial_dofs->components;
+      uniform = uniform && test_dofs->components == blocks[0].first->components &&
+                trial_dofs->components == blocks[0].second->components &&
+                test_dofs->num_nodes == blocks[0].first->num_nodes &&
+                trial_dofs->num_nodes == blocks[0].second->num_nodes &&
+                test_dofs->ordering == blocks[0].first->ordering && trial_dofs->ordering == blocks[0].second->ordering;
+    }
+
+    // the constructor looks up blocks of vector-valued spaces, see blocked()
+    if (uniform && blocks[0].first->components * blocks[0].second->components > 1) {
+      sizes.block_size = blocks[0].first->components * blocks[0].second->components;
+      sizes.block_rows = num_test_nodes;
+    }
+
+    std::vector<std::size_t> node_offsets(num_test_nodes + 1, 0);
+    for (const auto& [test_dofs, trial_dofs] : blocks) {
+      for (uint32_t e = 0; e < uint32_t(test_dofs->num_elements); e++) {
+        for (uint32_t j = 0; j < uint32_t(test_dofs->nodes_per_elem); j++) {
+          node_offsets[test_dofs->dof_info(e, j).index() + 1]++;
+        }
+      }
+    }
+    std::partial_sum(node_offsets.begin(), node_offsets.end(), node_offsets.begin());
+
+    std::vector<std::pair<uint32_t, uint32_t>> node_elements(node_offsets.back());
+    {
+      std::vector<std::size_t> position(node_offsets.begin(), node_offsets.end() - 1);
+      for (uint32_t b = 0; b < uint32_t(blocks.size()); b++) {
+        const ElementRestriction& test_dofs = *blocks[b].first;
+        for (uint32_t e = 0; e < uint32_t(test_dofs.num_elements); e++) {
+          for (uint32_t j = 0; j < uint32_t(test_dofs.nodes_per_elem); j++) {
+            node_elements[position[test_dofs.dof_info(e, j).index()]++] = {b, e};
+          }
+        }
+      }
+    }
+
+    // every component of a test node is coupled to every component of the trial nodes of its elements
+    auto components = std::size_t(blocks[0].first->components * blocks[0].second->components);
+    std::vector<std::size_t> last_row(num_trial_nodes, std::numeric_limits<std::size_t>::max());
+    for (std::size_t r = 0; r < num_test_nodes; r++) {
+      std::size_t columns = 0;
+      for (std::size_t k = node_offsets[r]; k < node_offsets[r + 1]; k++) {
+        const ElementRestriction& trial_dofs = *blocks[node_elements[k].first].second;
+        for (uint32_t i = 0; i < uint32_t(trial_dofs.nodes_per_elem); i++) {
+          auto column = trial_dofs.dof_info(node_elements[k].second, i).index();
+          if (last_row[column] != r) {
+            last_row[column] = r;
+            columns++;
+          }
+        }
+      }
+      sizes.nnz += columns * components;
+    }
+
+    return sizes;
+  }
+
+  /// @brief how assembly finds the nonzero entries of the element matrix entries
+  GradientLookup lookup;
 
   /// @brief how many nonzero entries appear in the sparse matrix
-  uint32_t nnz;
+  nonzero_index nnz;
 
   /**
    * @brief array holding the offsets for a given row of the sparse matrix
    * i.e. row r corresponds to the indices [row_ptr[r], row_ptr[r+1])
    */
-  std::vector<int> row_ptr;
+  std::vector<nonzero_index> row_ptr;
 
   /// @brief array holding the column associated with each nonzero entry
   std::vector<int> col_ind;
 
+  /// @brief the (domain type, geometry) of each group of element matrices that contributes to the sparse matrix
+  std::vector<std::pair<Domain::Type, mfem::Geometry::Type>> element_matrix_blocks;
+
+  /**
+   * @brief the element matrix entries that contribute to nonzero k are
+   * `contributions[contribution_offsets[k]]`, ..., `contributions[contribution_offsets[k+1] - 1]`
+   */
+  std::vector<std::size_t> contribution_offsets;
+
+  /**
+   * @brief every entry of every element matrix, grouped by the nonzero entry it contributes to (empty for
+   * GradientLookup::BinarySearch)
+   *
+   * Each entry is packed into 32 bits: its position among the entries of all the `element_matrix_blocks` (see
+   * element_matrix_offsets), and the sign with which it is added to the sparse matrix in the sign_bit. The entries
+   * that contribute to each nonzero are sorted by position, so their blocks can be found with a single pass over
+   * element_matrix_offsets.
+   *
+   * @note for blocked() tables, these are the node-node blocks of every element matrix, grouped by the nonzero block
+   * they contribute to, and each one only points at the entry of the first test and trial components of its block
+   * (see elementMatrixIndex())
+   */
+  std::vector<uint32_t> contributions;
+
+  /**
+   * @brief the offsets between the element matrix entries of consecutive test components, and of consecutive trial
+   * components, of each of the `element_matrix_blocks`, see blocked()
+   */
+  std::vector<std::pair<std::size_t, std::size_t>> element_matrix_strides;
+
+  /// @brief the number of test nodes and of trial nodes of the elements of each of the `element_matrix_blocks`
+  std::vector<std::pair<uint32_t, uint32_t>> element_matrix_nodes;
+
+  /**
+   * @brief the packed `contributions` of `element_matrix_blocks[b]` are the positions in
+   * [element_matrix_offsets[b], element_matrix_offsets[b+1]), see contributions
+   */
+  std::vector<std::size_t> element_matrix_offsets{0};
+
+  /// @brief the number of components of the test space (or 1, for tables that aren't blocked())
+  uint32_t test_components = 1;
+
+  /// @brief the number of components of the trial space (or 1, for tables that aren't blocked())
+  uint32_t trial_components = 1;
+
+  /// @brief the number of test nodes, i.e. of rows of blocks
+  uint32_t num_test_nodes = 0;
+
+  /// @brief the number of trial nodes, i.e. of columns of blocks
+  uint32_t num_trial_nodes = 0;
+
+  /// @brief how the test space orders its vdofs
+  mfem::Ordering::Type test_ordering = mfem::Ordering::byNODES;
+
+  /// @brief how the trial space orders its vdofs
+  mfem::Ordering::Type trial_ordering = mfem::Ordering::byNODES;
+
+  /**
+   * @brief for blocked() tables, the nonzero blocks of test node n are
+   * `block_row_ptr[n]`, ..., `block_row_ptr[n+1] - 1`
+   */
+  std::vector<nonzero_index> block_row_ptr;
+
+  /// @brief the trial node of each nonzero block, for blocked() tables
+  std::vector<int> block_col_ind;
+
+private:
   /**
-   * @brief `nz_LUT` returns the index of the `col_ind` / `value` CSR arrays
-   * corresponding to the (i,j) entry
+   * @brief number the nonzero entries of the sparse matrix, and find the one of every entry of every element matrix
+   *
+   * @param for_each_block calls f(test_dofs, trial_dofs, slots) for each pair of restrictions, see the constructor
+   * @param num_rows the number of rows of the sparse matrix
    */
-  std::unordered_map<Entry, uint32_t, Entry::Hasher> nz_LUT;
+  template <typename ForEachBlock>
+  void numberNonzeros(const ForEachBlock& for_each_block, uint32_t num_rows)
+  {
+    // we start by having each element and boundary element emit the column of each (i,j) entry
+    // it touches in the global "stiffness matrix", bucketed by row (i.e. a counting sort)
+    std::vector<std::size_t> row_offsets(num_rows + 1, 0);
+    for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto&) {
+      auto num_trial_vdofs = uint32_t(trial_dofs.nodes_per_elem * trial_dofs.components);
+      for (uint32_t e = 0; e < uint32_t(test_dofs.num_elements); e++) {
+        for (uint32_t j = 0; j < uint32_t(test_dofs.nodes_per_elem * test_dofs.components); j++) {
+          row_offsets[elementVDof(test_dofs, e, j).index() + 1] += num_trial_vdofs;
+        }
+      }
+    });
+    std::partial_sum(row_offsets.begin(), row_offsets.end(), row_offsets.begin());
+
+    std::vector<uint32_t> columns(row_offsets.back());
+    {
+      std::vector<std::size_t> position(row_offsets.begin(), row_offsets.end() - 1);
+      for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto&) {
+        for (uint32_t e = 0; e < uint32_t(test_dofs.num_elements); e++) {
+          for (uint32_t j = 0; j < uint32_t(test_dofs.nodes_per_elem * test_dofs.components); j++) {
+            auto row = elementVDof(test_dofs, e, j).index();
+            for (uint32_t i = 0; i < uint32_t(trial_dofs.nodes_per_elem * trial_dofs.components); i++) {
+              columns[position[row]++] = uint32_t(elementVDof(trial_dofs, e, i).index());
+            }
+          }
+        }
+      });
+    }
+
+    // then, each row is sorted and deduplicated independently
+    std::vector<uint32_t> row_nnz(num_rows);
+    accelerator::forall_host(num_rows, [&](uint32_t r) {
+      auto row_begin = columns.begin() + static_cast<std::ptrdiff_t>(row_offsets[r]);
+      auto row_end   = columns.begin() + static_cast<std::ptrdiff_t>(row_offsets[r + 1]);
+      std::sort(row_begin, row_end);
+      row_nnz[r] = static_cast<uint32_t>(std::unique(row_begin, row_end) - row_begin);
+    });
+
+    // the number of nonzero entries is checked in a wider type, since it's the first thing to overflow on
+    // ranks with many dofs (e.g. ~10^7 dofs of a cubic elasticity problem already have ~10^10 nonzero entries)
+    row_ptr.resize(num_rows + 1);
+    row_ptr[0] = 0;
+    for (uint32_t r = 0; r < num_rows; r++) {
+      row_ptr[r + 1] = row_ptr[r] + row_nnz[r];
+      SLIC_ERROR_IF(row_ptr[r + 1] < row_ptr[r],
+                    "The local gradient has too many nonzero entries to index, configure Serac with "
+                    "SERAC_ENABLE_64BIT_INDICES=ON or use more ranks");
+    }
+
+    nnz = row_ptr.back();
+    col_ind.resize(nnz);
+    accelerator::forall_host(num_rows, [&](uint32_t r) {
+      for (uint32_t k = 0; k < row_nnz[r]; k++) {
+        col_ind[row_ptr[r] + k] = static_cast<int>(columns[row_offsets[r] + k]);
+      }
+    });
+
+    // tables that only keep the sparsity pattern are done
+    if (lookup == GradientLookup::BinarySearch) return;
+
+    // now that the nonzero entries are numbered, we find where each entry of every element matrix
+    // lands in the CSR values array.
+    //
+    // note: the element gradient kernels write their output transposed (row-major storage),
+    // so this loop order matches the memory layout of K_elem(e, i, j) in Gradient::assemble()
+    for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto& slots) {
+      auto num_test_vdofs  = uint32_t(test_dofs.nodes_per_elem * test_dofs.components);
+      auto num_trial_vdofs = uint32_t(trial_dofs.nodes_per_elem * trial_dofs.components);
+      slots.resize(test_dofs.num_elements * num_trial_vdofs * num_test_vdofs);
+
+      accelerator::forall_host(uint32_t(test_dofs.num_elements), [&](uint32_t e) {
+        std::size_t index = std::size_t(e) * num_trial_vdofs * num_test_vdofs;
+        for (uint32_t i = 0; i < num_trial_vdofs; i++) {
+          DoF trial_vdof = elementVDof(trial_dofs, e, i);
+          for (uint32_t j = 0; j < num_test_vdofs; j++) {
+            DoF test_vdof  = elementVDof(test_dofs, e, j);
+            slots[index++] = SignedIndex{(*this)(int(test_vdof.index()), int(trial_vdof.index())),
+                                         test_vdof.sign() * trial_vdof.sign()};
+          }
+        }
+      });
+    });
+  }
+
+  /**
+   * @brief number the nonzero node-node blocks and the entries of the sparse matrix, and find the block of every
+   * block of every element matrix, see blocked()
+   *
+   * @param for_each_block calls f(test_dofs, trial_dofs, slots) for each pair of restrictions, see the constructor
+   * @param num_rows the number of rows of the sparse matrix
+   */
+  template <typename ForEachBlock>
+  void numberBlockNonzeros(const ForEachBlock& for_each_block, uint32_t num_rows)
+  {
+    // as for scalar entries, the elements emit the trial node of each block they touch, bucketed by test node
+    std::vector<std::size_t> row_offsets(num_test_nodes + 1, 0);
+    for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto&) {
+      for (uint32_t e = 0; e < uint32_t(test_dofs.num_elements); e++) {
+        for (uint32_t j = 0; j < uint32_t(test_dofs.nodes_per_elem); j++) {
+          row_offsets[test_dofs.dof_info(e, j).index() + 1] += trial_dofs.nodes_per_elem;
+        }
+      }
+    });
+    std::partial_sum(row_offsets.begin(), row_offsets.end(), row_offsets.begin());
+
+    std::vector<uint32_t> columns(row_offsets.back());
+    {
+      std::vector<std::size_t> position(row_offsets.begin(), row_offsets.end() - 1);
+      for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto&) {
+        for (uint32_t e = 0; e < uint32_t(test_dofs.num_elements); e++) {
+          for (uint32_t j = 0; j < uint32_t(test_dofs.nodes_per_elem); j++) {
+            auto row = test_dofs.dof_info(e, j).index();
+            for (uint32_t i = 0; i < uint32_t(trial_dofs.nodes_per_elem); i++) {
+              columns[position[row]++] = uint32_t(trial_dofs.dof_info(e, i).index());
+            }
+          }
+        }
+      });
+    }
+
+    std::vector<uint32_t> row_blocks(num_test_nodes);
+    accelerator::forall_host(num_test_nodes, [&](uint32_t n) {
+      auto row_begin = columns.begin() + static_cast<std::ptrdiff_t>(row_offsets[n]);
+      auto row_end   = columns.begin() + static_cast<std::ptrdiff_t>(row_offsets[n + 1]);
+      std::sort(row_begin, row_end);
+      row_blocks[n] = static_cast<uint32_t>(std::unique(row_begin, row_end) - row_begin);
+    });
+
+    block_row_ptr.resize(num_test_nodes + 1);
+    block_row_ptr[0] = 0;
+    for (uint32_t n = 0; n < num_test_nodes; n++) {
+      block_row_ptr[n + 1] = block_row_ptr[n] + row_blocks[n];
+    }
+    block_col_ind.resize(block_row_ptr.back());
+    accelerator::forall_host(num_test_nodes, [&](uint32_t n) {
+      for (uint32_t k = 0; k < row_blocks[n]; k++) {
+        block_col_ind[block_row_ptr[n] + k] = static_cast<int>(columns[row_offsets[n] + k]);
+      }
+    });
+
+    // every row of the sparse matrix has every component of the trial nodes of its test node's blocks
+    std::vector<uint32_t> row_nnz(num_rows, 0);
+    for (uint32_t n = 0; n < num_test_nodes; n++) {
+      for (uint32_t c = 0; c < test_components; c++) {
+        row_nnz[testRow(n, c)] = row_blocks[n] * trial_components;
+      }
+    }
+
+    row_ptr.resize(num_rows + 1);
+    row_ptr[0] = 0;
+    for (uint32_t r = 0; r < num_rows; r++) {
+      row_ptr[r + 1] = row_ptr[r] + row_nnz[r];
+      SLIC_ERROR_IF(row_ptr[r + 1] < row_ptr[r],
+                    "The local gradient has too many nonzero entries to index, configure Serac with "
+                    "SERAC_ENABLE_64BIT_INDICES=ON or use more ranks");
+    }
+
+    // the columns of each row are the trial vdofs of its blocks, in increasing order (see blockEntry())
+    nnz = row_ptr.back();
+    col_ind.resize(nnz);
+    accelerator::forall_host(num_test_nodes, [&](uint32_t n) {
+      for (uint32_t ct = 0; ct < test_components; ct++) {
+        for (nonzero_index k = block_row_ptr[n]; k < block_row_ptr[n + 1]; k++) {
+          for (uint32_t cr = 0; cr < trial_components; cr++) {
+            auto column = uint32_t(block_col_ind[k]);
+            col_ind[blockEntry(n, k, ct, cr)] =
+                int((trial_ordering == mfem::Ordering::byNODES) ? cr * num_trial_nodes + column
+                                                                 : column * trial_components + cr);
+          }
+        }
+      }
+    });
+
+    if (lookup == GradientLookup::BinarySearch) return;
+
+    // the block of each (test node, trial node) pair of every element, ordered like the element matrix entries
+    for_each_block([&](const ElementRestriction& test_dofs, const ElementRestriction& trial_dofs, auto& slots) {
+      auto test_npe  = uint32_t(test_dofs.nodes_per_elem);
+      auto trial_npe = uint32_t(trial_dofs.nodes_per_elem);
+      slots.resize(test_dofs.num_elements * trial_npe * test_npe);
+
+      accelerator::forall_host(uint32_t(test_dofs.num_elements), [&](uint32_t e) {
+        std::size_t index = std::size_t(e) * trial_npe * test_npe;
+        for (uint32_t i = 0; i < trial_npe; i++) {
+          DoF trial_node = trial_dofs.dof_info(e, i);
+          for (uint32_t j = 0; j < test_npe; j++) {
+            DoF  test_node = test_dofs.dof_info(e, j);
+            auto row       = test_node.index();
+            auto row_begin = block_col_ind.begin() + static_cast<std::ptrdiff_t>(block_row_ptr[row]);
+            auto row_end   = block_col_ind.begin() + static_cast<std::ptrdiff_t>(block_row_ptr[row + 1]);
+            auto it        = std::lower_bound(row_begin, row_end, int(trial_node.index()));
+            slots[index++] = SignedIndex{static_cast<nonzero_index>(it - block_col_ind.begin()),
+                                         test_node.sign() * trial_node.sign()};
+          }
+        }
+      });
+    });
+  }
+
+  /// @brief equivalent to the `v`th entry of dofs.GetElementVDofs(e, ...), without the temporary array
+  static DoF elementVDof(const ElementRestriction& dofs, uint32_t e, uint32_t v)
+  {
+    return dofs.GetVDof(dofs.dof_info(e, v % dofs.nodes_per_elem), v / dofs.nodes_per_elem);
+  }
 };
 
+/**
+ * @brief compute the values of the nonzero entries of a sparse matrix from its precomputed contributions, in the
+ * execution space @a exec
+ *
+ * Each nonzero entry (or node-node block, for blocked tables) gathers its own contributions from the element
+ * matrices, so the entries are computed concurrently without any synchronization.
+ *
+ * @param tables the lookup tables, in the memory of @a exec
+ * @param K the element matrices of each of the `element_matrix_blocks` (or nullptr for blocks without element
+ * matrices, whose entries contribute nothing), in the memory of @a exec
+ * @param permutation for transposed assemblies, which nonzero entry of the untransposed matrix each nonzero entry of
+ * the transpose is, or nullptr otherwise
+ * @param untransposed storage for the values of the untransposed matrix of transposed assemblies with blocked tables,
+ * which are permuted afterwards
+ * @param values the values of the nonzero entries, in the order of the lookup tables' nonzero entries
+ */
+template <ExecutionSpace exec>
+void gatherNonzeros(GradientGatherTables tables, const double* const* K, const nonzero_index* permutation,
+                    double* untransposed, double* values)
+{
+  constexpr uint32_t sign_bit = GradientAssemblyLookupTables::sign_bit;
+
+  if (!tables.blocked) {
+    accelerator::forall<exec>(tables.nnz, [=] SERAC_HOST_DEVICE(nonzero_index k) {
+      nonzero_index source = permutation ? permutation[k] : k;
+
+      // the contributions are sorted by position, so the block each one belongs to only moves forward
+      double      sum   = 0.0;
+      std::size_t block = 0;
+      for (std::size_t c = tables.contribution_offsets[source]; c < tables.contribution_offsets[source + 1]; c++) {
+        std::size_t position = tables.contributions[c] & ~sign_bit;
+        while (position >= tables.element_matrix_offsets[block + 1]) block++;
+        if (K[block]) {
+          double entry = K[block][position - tables.element_matrix_offsets[block]];
+          sum += (tables.contributions[c] & sign_bit) ? -entry : entry;
+        }
+      }
+      values[k] = sum;
+    });
+    return;
+  }
+
+  // blocked tables gather all the entries of a nonzero node-node block from the same element matrix blocks, and the
+  // transpose is permuted from the gathered values afterwards
+  double* target = permutation ? untransposed : values;
+  accelerator::forall<exec>(tables.num_test_nodes, [=] SERAC_HOST_DEVICE(uint32_t n) {
+    nonzero_index blocks = tables.block_row_ptr[n + 1] - tables.block_row_ptr[n];
+    for (nonzero_index k = tables.block_row_ptr[n]; k < tables.block_row_ptr[n + 1]; k++) {
+      for (uint32_t ct = 0; ct < tables.test_components; ct++) {
+        for (uint32_t cr = 0; cr < tables.trial_components; cr++) {
+          double      sum   = 0.0;
+          std::size_t block = 0;
+          for (std::size_t c = tables.contribution_offsets[k]; c < tables.contribution_offsets[k + 1]; c++) {
+            std::size_t position = tables.contributions[c] & ~sign_bit;
+            while (position >= tables.element_matrix_offsets[block + 1]) block++;
+            if (K[block]) {
+              const auto& [test_stride, trial_stride] = tables.element_matrix_strides[block];
+              std::size_t index = GradientAssemblyLookupTables::elementMatrixIndex(
+                  position - tables.element_matrix_offsets[block], tables.element_matrix_nodes[block],
+                  tables.test_components, tables.trial_components);
+              double entry = K[block][index + ct * test_stride + cr * trial_stride];
+              sum += (tables.contributions[c] & sign_bit) ? -entry : entry;
+            }
+          }
+
+          // the nonzero entry of these components of the block, see GradientAssemblyLookupTables::blockEntry()
+          nonzero_index q   = k - tables.block_row_ptr[n];
+          uint32_t      row = tables.test_by_nodes ? ct * tables.num_test_nodes + n : n * tables.test_components + ct;
+          target[tables.row_ptr[row] + (tables.trial_by_nodes ? cr * blocks + q : q * tables.trial_components + cr)] =
+              sum;
+        }
+      }
+    }
+  });
+
+  if (permutation) {
+    accelerator::forall<exec>(tables.nnz,
+                              [=] SERAC_HOST_DEVICE(nonzero_index k) { values[k] = untransposed[permutation[k]]; });
+  }
+}
+
 }  // namespace serac
@@ -27,6 +27,8 @@
 
 #include "serac/numerics/functional/domain.hpp"
 
+#include <algorithm>
+
 namespace serac {
 
 /**
@@ -240,10 +242,11 @@ static Domain domain_of_elems(const mfem::Mesh&
   mfem::Vector vertices;
   mesh.GetVertices(vertices);
 
-  int tri_id  = 0;
-  int quad_id = 0;
-  int tet_id  = 0;
-  int hex_id  = 0;
+  int tri_id   = 0;
+  int quad_id  = 0;
+  int tet_id   = 0;
+  int hex_id   = 0;
+  int prism_id = 0;
 
   // elements that satisfy the predicate are added to the domain
   int num_elems = mesh.GetNE();
@@ -279,6 +282,13 @@ static Domain domain_of_elems(const mfem::Mesh&
           tet_id++;
         }
         break;
+      case 6:
+        if (add) {
+          output.prism_ids_.push_back(prism_id);
+          output.mfem_prism_ids_.push_back(i);
+        }
+        prism_id++;
+        break;
       case 8:
         if (add) {
           output.hex_ids_.push_back(hex_id);
@@ -395,7 +405,7 @@ mfem::Array<int> Domain::dof_list(mfem::FiniteElementSpace* fes) const
     GetDofs = [&](int i, mfem::Array<int>& vdofs) { return fes->GetElementDofs(i, vdofs); };
   }
 
-  if (type_ == Type::BoundaryElements) {
+  if (type_ == Type::BoundaryElements || type_ == Type::InteriorFaces) {
     GetDofs = [&](int i, mfem::Array<int>& vdofs) { return fes->GetFaceDofs(i, vdofs); };
   }
 
@@ -442,6 +452,13 @@ mfem::Array<int> Domain::dof_list(mfem::FiniteElementSpace* fes) const
         dof_ids.insert(elem_dofs[i]);
       }
     }
+
+    for (auto elem_id : mfem_prism_ids_) {
+      GetDofs(elem_id, elem_dofs);
+      for (int i = 0; i < elem_dofs.Size(); i++) {
+        dof_ids.insert(elem_dofs[i]);
+      }
+    }
   }
 
   mfem::Array<int> uniq_dof_ids(int(dof_ids.size()));
@@ -462,10 +479,11 @@ Domain EntireDomain(const mfem::Mesh& mesh)
 {
   Domain output{mesh, mesh.SpaceDimension() /* elems can be 2 or 3 dimensional */};
 
-  int tri_id  = 0;
-  int quad_id = 0;
-  int tet_id  = 0;
-  int hex_id  = 0;
+  int tri_id   = 0;
+  int quad_id  = 0;
+  int tet_id   = 0;
+  int hex_id   = 0;
+  int prism_id = 0;
 
   // faces that satisfy the predicate are added to the domain
   int num_elems = mesh.GetNE();
@@ -475,15 +493,23 @@ Domain EntireDomain(const mfem::Mesh& mesh)
     switch (geom) {
       case mfem::Geometry::TRIANGLE:
         output.tri_ids_.push_back(tri_id++);
+        output.mfem_tri_ids_.push_back(i);
         break;
       case mfem::Geometry::SQUARE:
         output.quad_ids_.push_back(quad_id++);
+        output.mfem_quad_ids_.push_back(i);
         break;
       case mfem::Geometry::TETRAHEDRON:
         output.tet_ids_.push_back(tet_id++);
+        output.mfem_tet_ids_.push_back(i);
         break;
       case mfem::Geometry::CUBE:
         output.hex_ids_.push_back(hex_id++);
+        output.mfem_hex_ids_.push_back(i);
+        break;
+      case mfem::Geometry::PRISM:
+        output.prism_ids_.push_back(prism_id++);
+        output.mfem_prism_ids_.push_back(i);
         break;
       default:
         SLIC_ERROR("unsupported element type");
@@ -511,12 +537,15 @@ Domain EntireBoundary(const mfem::Mesh& mesh)
     switch (geom) {
       case mfem::Geometry::SEGMENT:
         output.edge_ids_.push_back(edge_id++);
+        output.mfem_edge_ids_.push_back(f);
         break;
       case mfem::Geometry::TRIANGLE:
         output.tri_ids_.push_back(tri_id++);
+        output.mfem_tri_ids_.push_back(f);
         break;
       case mfem::Geometry::SQUARE:
         output.quad_ids_.push_back(quad_id++);
+        output.mfem_quad_ids_.push_back(f);
         break;
       default:
         SLIC_ERROR("unsupported element type");
@@ -527,6 +556,139 @@ Domain EntireBoundary(const mfem::Mesh& mesh)
   return output;
 }
 
+Domain EntireInteriorFaces(const mfem::Mesh& mesh)
+{
+  Domain output{mesh, mesh.SpaceDimension() - 1, Domain::Type::InteriorFaces};
+
+  int edge_id = 0;
+  int tri_id  = 0;
+  int quad_id = 0;
+
+  for (int f = 0; f < mesh.GetNumFaces(); f++) {
+    // discard boundary faces, and faces whose other element belongs to another processor
+    if (!detail::is_local_interior_face(mesh, f)) continue;
+
+    auto geom = mesh.GetFaceGeometry(f);
+
+    switch (geom) {
+      case mfem::Geometry::SEGMENT:
+        output.edge_ids_.push_back(edge_id++);
+        output.mfem_edge_ids_.push_back(f);
+        break;
+      case mfem::Geometry::TRIANGLE:
+        output.tri_ids_.push_back(tri_id++);
+        output.mfem_tri_ids_.push_back(f);
+        break;
+      case mfem::Geometry::SQUARE:
+        output.quad_ids_.push_back(quad_id++);
+        output.mfem_quad_ids_.push_back(f);
+        break;
+      default:
+        SLIC_ERROR("unsupported element type");
+        break;
+    }
+  }
+
+  return output;
+}
+
+Domain elementsTouching(const Domain& boundary)
+{
+  SLIC_ERROR_IF(boundary.type_ != Domain::Type::BoundaryElements, "elementsTouching() requires a boundary domain");
+
+  const mfem::Mesh& mesh = boundary.mesh_;
+
+  std::vector<char> on_boundary(static_cast<std::size_t>(mesh.GetNV()));
+  for (auto geom : {mfem::Geometry::SEGMENT, mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE}) {
+    for (int f : boundary.ids(geom).second) {
+      mfem::Array<int> vertices;
+      mesh.GetFaceVertices(f, vertices);
+      for (int v : vertices) {
+        on_boundary[static_cast<std::size_t>(v)] = 1;
+      }
+    }
+  }
+
+  Domain output{mesh, mesh.SpaceDimension() /* elems can be 2 or 3 dimensional */};
+
+  int count[mfem::Geometry::NUM_GEOMETRIES]{};
+  for (int i = 0; i < mesh.GetNE(); i++) {
+    auto geom = mesh.GetElementGeometry(i);
+
+    mfem::Array<int> vertices;
+    mesh.GetElementVertices(i, vertices);
+    auto touches = [&](int v) { return on_boundary[static_cast<std::size_t>(v)] != 0; };
+    if (std::any_of(vertices.begin(), vertices.end(), touches)) {
+      auto [ids, mfem_ids] = output.ids(geom);
+      ids.push_back(count[geom]);
+      mfem_ids.push_back(i);
+    }
+    count[geom]++;
+  }
+
+  return output;
+}
+
+AttributeIndex::AttributeIndex(const mfem::Mesh& mesh) : mesh_(mesh)
+{
+  int count[mfem::Geometry::NUM_GEOMETRIES]{};
+  for (int i = 0; i < mesh.GetNE(); i++) {
+    auto geom = mesh.GetElementGeometry(i);
+    elements_[mesh.GetAttribute(i)].push_back({geom, count[geom]++, i});
+  }
+
+  mfem::Array<int> face_id_to_bdr_id = mesh.GetFaceToBdrElMap();
+
+  int boundary_count[mfem::Geometry::NUM_GEOMETRIES]{};
+  for (int f = 0; f < mesh.GetNumFaces(); f++) {
+    if (mesh.GetFaceInformation(f).IsInterior()) continue;
+
+    auto geom   = mesh.GetFaceGeometry(f);
+    int  bdr_id = face_id_to_bdr_id[f];
+    int  attr   = (bdr_id >= 0) ? mesh.GetBdrAttribute(bdr_id) : -1;
+    boundary_elements_[attr].push_back({geom, boundary_count[geom]++, f});
+  }
+}
+
+Domain AttributeIndex::collect(Domain output, const std::map<int, std::vector<Entity>>& index,
+                               const std::set<int>& attributes)
+{
+  for (int attr : attributes) {
+    auto entities = index.find(attr);
+    if (entities == index.end()) continue;
+
+    for (const auto& entity : entities->second) {
+      auto [ids, mfem_ids] = output.ids(entity.geometry);
+      ids.push_back(entity.id);
+      mfem_ids.push_back(entity.mfem_id);
+    }
+  }
+
+  // the entities of each attribute are already sorted, as are the ids of each geometry
+  // (in the same order as the mfem ids), so only combining several attributes needs sorting
+  if (attributes.size() > 1) {
+    for (auto geom : {mfem::Geometry::SEGMENT, mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
+                      mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM}) {
+      auto [ids, mfem_ids] = output.ids(geom);
+      std::sort(ids.begin(), ids.end());
+      std::sort(mfem_ids.begin(), mfem_ids.end());
+    }
+  }
+
+  return output;
+}
+
+Domain AttributeIndex::elements(const std::set<int>& attributes) const
+{
+  return collect(Domain{mesh_, mesh_.SpaceDimension()}, elements_, attributes);
+}
+
+Domain AttributeIndex::boundaryElements(const std::set<int>& attributes) const
+{
+  return collect(Domain{mesh_, mesh_.SpaceDimension() - 1, Domain::Type::BoundaryElements}, boundary_elements_,
+                 attributes);
+}
+
 /// @cond
 using c_iter = std::vector<int>::const_iterator;
 using b_iter = std::back_insert_iterator<std::vector<int>>;
@@ -550,25 +712,24 @@ Domain set_operation(set_op op, const Domain& a, const Domain& b)
 {
   assert(&a.mesh_ == &b.mesh_);
   assert(a.dim_ == b.dim_);
+  SLIC_ERROR_IF(a.type_ != b.type_, "Set operations require domains of the same type");
 
-  Domain output{a.mesh_, a.dim_};
+  Domain output{a.mesh_, a.dim_, a.type_};
 
   if (output.dim_ == 0) {
     output.vertex_ids_ = set_operation(op, a.vertex_ids_, b.vertex_ids_);
   }
 
-  if (output.dim_ == 1) {
-    output.edge_ids_ = set_operation(op, a.edge_ids_, b.edge_ids_);
-  }
-
-  if (output.dim_ == 2) {
-    output.tri_ids_  = set_operation(op, a.tri_ids_, b.tri_ids_);
-    output.quad_ids_ = set_operation(op, a.quad_ids_, b.quad_ids_);
-  }
+  // within a geometry, the mfem ids increase with the domain ids, so the same operation applies to both lists
+  for (auto geom : {mfem::Geometry::SEGMENT, mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
+                    mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM}) {
+    auto [a_ids, a_mfem_ids] = a.ids(geom);
+    auto [b_ids, b_mfem_ids] = b.ids(geom);
+    if (a_ids.empty() && b_ids.empty()) continue;
 
-  if (output.dim_ == 3) {
-    output.tet_ids_ = set_operation(op, a.tet_ids_, b.tet_ids_);
-    output.hex_ids_ = set_operation(op, a.hex_ids_, b.hex_ids_);
+    auto [ids, mfem_ids] = output.ids(geom);
+    ids                  = set_operation(op, a_ids, b_ids);
+    mfem_ids             = set_operation(op, a_mfem_ids, b_mfem_ids);
   }
 
   return output;
@@ -6,9 +6,15 @@
 
 #pragma once
 
+#include <map>
+#include <set>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include "mfem.hpp"
 
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/logger.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 
 namespace serac {
@@ -23,10 +29,11 @@ struct Domain {
   enum Type
   {
     Elements,
-    BoundaryElements
+    BoundaryElements,
+    InteriorFaces
   };
 
-  static constexpr int num_types = 2;  ///< the number of entries in the Type enum
+  static constexpr int num_types = 3;  ///< the number of entries in the Type enum
 
   /// @brief the underyling mesh for this domain
   const mfem::Mesh& mesh_;
@@ -34,7 +41,7 @@ struct Domain {
   /// @brief the geometric dimension of the domain
   int dim_;
 
-  /// @brief whether the elements in this domain are on the boundary or not
+  /// @brief whether the elements in this domain are elements, boundary elements or interior faces
   Type type_;
 
   /// note: only lists with appropriate dimension (see dim_) will be populated
@@ -50,12 +57,14 @@ struct Domain {
   std::vector<int> quad_ids_;
   std::vector<int> tet_ids_;
   std::vector<int> hex_ids_;
+  std::vector<int> prism_ids_;
 
   std::vector<int> mfem_edge_ids_;
   std::vector<int> mfem_tri_ids_;
   std::vector<int> mfem_quad_ids_;
   std::vector<int> mfem_tet_ids_;
   std::vector<int> mfem_hex_ids_;
+  std::vector<int> mfem_prism_ids_;
   /// @endcond
 
   Domain(const mfem::Mesh& m, int d, Type type = Domain::Type::Elements) : mesh_(m), dim_(d), type_(type) {}
@@ -117,6 +126,95 @@ struct Domain {
   /// @overload
   static Domain ofBoundaryElements(const mfem::Mesh& mesh, std::function<bool(std::vector<vec3>, int)> func);
 
+  /**
+   * @brief create a domain from some subset of the edges in an mfem::Mesh, without allocating per edge
+   *
+   * @tparam dim the spatial dimension of the mesh, e.g. `Domain::ofEdges<3>(mesh, predicate)`
+   * @param mesh the entire mesh
+   * @param predicate called as `predicate(X, attr)`, where X is the `tensor<double, 2, dim>` of vertex coordinates
+   * of an edge and attr is its boundary attribute (or -1, if it has none)
+   *
+   * @note the predicate may be evaluated concurrently (see forall_host), so it must not modify shared state
+   */
+  template <int dim, typename Predicate>
+  static Domain ofEdges(const mfem::Mesh& mesh, Predicate&& predicate);
+
+  /**
+   * @brief create a domain from some subset of the faces in an mfem::Mesh, without allocating per face
+   *
+   * @tparam dim the spatial dimension of the mesh
+   * @param mesh the entire mesh
+   * @param predicate called as `predicate(X, attr)`, where X is the `tensor<double, n, dim>` of the coordinates of
+   * the n vertices of a face and attr is its attribute (or -1, if it has none). It must accept the tensors of
+   * every face geometry in the mesh, e.g. by taking `const auto&`.
+   *
+   * @note the predicate may be evaluated concurrently (see forall_host), so it must not modify shared state
+   */
+  template <int dim, typename Predicate>
+  static Domain ofFaces(const mfem::Mesh& mesh, Predicate&& predicate);
+
+  /**
+   * @brief create a domain from some subset of the elements in an mfem::Mesh, without allocating per element
+   *
+   * @tparam dim the spatial dimension of the mesh
+   * @param mesh the entire mesh
+   * @param predicate called as `predicate(X, attr)`, where X is the `tensor<double, n, dim>` of the coordinates of
+   * the n vertices of an element and attr is its attribute. It must accept the tensors of every element geometry
+   * in the mesh, e.g. by taking `const auto&`.
+   *
+   * @note the predicate may be evaluated concurrently (see forall_host), so it must not modify shared state
+   */
+  template <int dim, typename Predicate>
+  static Domain ofElements(const mfem::Mesh& mesh, Predicate&& predicate);
+
+  /**
+   * @brief create a domain from some subset of the boundary elements in an mfem::Mesh, without allocating per
+   * boundary element
+   *
+   * @tparam dim the spatial dimension of the mesh
+   * @param mesh the entire mesh
+   * @param predicate called as `predicate(X, attr)`, see ofFaces()
+   *
+   * @note the predicate may be evaluated concurrently (see forall_host), so it must not modify shared state
+   */
+  template <int dim, typename Predicate>
+  static Domain ofBoundaryElements(const mfem::Mesh& mesh, Predicate&& predicate);
+
+  /**
+   * @brief create a domain from some subset of the interior faces (the faces shared by two elements) of an
+   * mfem::Mesh, e.g. for the jump terms of discontinuous Galerkin methods
+   *
+   * @tparam dim the spatial dimension of the mesh
+   * @param mesh the entire mesh
+   * @param predicate called as `predicate(X, attr)`, see ofFaces(). Interior faces have no attribute, so attr is -1.
+   *
+   * @note faces on the boundary between two processors aren't included, since only one of their elements is local
+   * @note the predicate may be evaluated concurrently (see forall_host), so it must not modify shared state
+   */
+  template <int dim, typename Predicate>
+  static Domain ofInteriorFaces(const mfem::Mesh& mesh, Predicate&& predicate);
+
+  /// @brief get the lists of (domain, mfem) ids of the entities with a given geometry
+  std::pair<std::vector<int>&, std::vector<int>&> ids(mfem::Geometry::Type geom)
+  {
+    if (geom == mfem::Geometry::SEGMENT) return {edge_ids_, mfem_edge_ids_};
+    if (geom == mfem::Geometry::TRIANGLE) return {tri_ids_, mfem_tri_ids_};
+    if (geom == mfem::Geometry::SQUARE) return {quad_ids_, mfem_quad_ids_};
+    if (geom == mfem::Geometry::TETRAHEDRON) return {tet_ids_, mfem_tet_ids_};
+    if (geom == mfem::Geometry::CUBE) return {hex_ids_, mfem_hex_ids_};
+    if (geom == mfem::Geometry::PRISM) return {prism_ids_, mfem_prism_ids_};
+
+    SLIC_ERROR("unsupported element type");
+    exit(1);
+  }
+
+  /// @overload
+  std::pair<const std::vector<int>&, const std::vector<int>&> ids(mfem::Geometry::Type geom) const
+  {
+    auto [domain_ids, mfem_ids] = const_cast<Domain&>(*this).ids(geom);
+    return {domain_ids, mfem_ids};
+  }
+
   /// @brief get elements by geometry type
   const std::vector<int>& get(mfem::Geometry::Type geom) const
   {
@@ -126,6 +224,7 @@ struct Domain {
     if (geom == mfem::Geometry::SQUARE) return quad_ids_;
     if (geom == mfem::Geometry::TETRAHEDRON) return tet_ids_;
     if (geom == mfem::Geometry::CUBE) return hex_ids_;
+    if (geom == mfem::Geometry::PRISM) return prism_ids_;
 
     exit(1);
   }
@@ -134,12 +233,278 @@ struct Domain {
   mfem::Array<int> dof_list(mfem::FiniteElementSpace* fes) const;
 };
 
+namespace detail {
+
+/// @brief the coordinates of the n vertices of a mesh entity, from mfem's [x1, x2, ..., y1, y2, ...] layout
+template <int n, int dim>
+tensor<double, n, dim> gather_vertices(const mfem::Vector& coordinates, int num_vertices, const int* vertex_ids)
+{
+  tensor<double, n, dim> X;
+  for (int v = 0; v < n; v++) {
+    for (int j = 0; j < dim; j++) {
+      X[v][j] = coordinates[j * num_vertices + vertex_ids[v]];
+    }
+  }
+  return X;
+}
+
+/// @brief evaluate a predicate on the vertex coordinates of a mesh entity with n vertices
+template <int n, int dim, typename Predicate>
+bool evaluate_on_vertices(Predicate& predicate, const mfem::Vector& coordinates, int num_vertices,
+                          const int* vertex_ids, int attr)
+{
+  if constexpr (std::is_invocable_r_v<bool, Predicate&, const tensor<double, n, dim>&, int>) {
+    return predicate(gather_vertices<n, dim>(coordinates, num_vertices, vertex_ids), attr);
+  } else {
+    SLIC_ERROR("domain predicate can't be evaluated on entities with " << n << " vertices");
+    return false;
+  }
+}
+
+/**
+ * @brief evaluate a predicate on the mesh entities [0, n) and add the ones that satisfy it to a domain
+ *
+ * @param output the domain to add to
+ * @param n the number of mesh entities
+ * @param predicate called with the tensor of vertex coordinates and the attribute of each entity
+ * @param entity returns the geometry, vertex ids and attribute of a mesh entity, or mfem::Geometry::INVALID
+ * for entities that don't belong in this kind of domain (e.g. interior faces, for boundary elements)
+ */
+template <int dim, typename Predicate, typename Entity>
+void select_entities(Domain& output, int n, Predicate& predicate, const Entity& entity)
+{
+  SLIC_ERROR_IF(output.mesh_.SpaceDimension() != dim, "domain predicate doesn't match the dimension of the mesh");
+
+  mfem::Vector coordinates;
+  output.mesh_.GetVertices(coordinates);
+  const int num_vertices = output.mesh_.GetNV();
+
+  std::vector<mfem::Geometry::Type> geometry(static_cast<std::size_t>(n));
+  std::vector<char>                 selected(static_cast<std::size_t>(n));
+
+  forall_host(n, [&](int i) {
+    auto [geom, vertex_ids, attr] = entity(i);
+
+    bool add = false;
+    switch (geom) {
+      case mfem::Geometry::SEGMENT:
+        add = evaluate_on_vertices<2, dim>(predicate, coordinates, num_vertices, vertex_ids, attr);
+        break;
+      case mfem::Geometry::TRIANGLE:
+        add = evaluate_on_vertices<3, dim>(predicate, coordinates, num_vertices, vertex_ids, attr);
+        break;
+      case mfem::Geometry::SQUARE:
+      case mfem::Geometry::TETRAHEDRON:
+        add = evaluate_on_vertices<4, dim>(predicate, coordinates, num_vertices, vertex_ids, attr);
+        break;
+      case mfem::Geometry::PRISM:
+        add = evaluate_on_vertices<6, dim>(predicate, coordinates, num_vertices, vertex_ids, attr);
+        break;
+      case mfem::Geometry::CUBE:
+        add = evaluate_on_vertices<8, dim>(predicate, coordinates, num_vertices, vertex_ids, attr);
+        break;
+      default:
+        break;
+    }
+
+    geometry[static_cast<std::size_t>(i)] = geom;
+    selected[static_cast<std::size_t>(i)] = add;
+  });
+
+  // the ids of each geometry are numbered consecutively, in the order of the mesh entities
+  int count[mfem::Geometry::NUM_GEOMETRIES]{};
+  for (int i = 0; i < n; i++) {
+    auto geom = geometry[static_cast<std::size_t>(i)];
+    if (geom == mfem::Geometry::INVALID) continue;
+
+    if (selected[static_cast<std::size_t>(i)]) {
+      auto [ids, mfem_ids] = output.ids(geom);
+      ids.push_back(count[geom]);
+      mfem_ids.push_back(i);
+    }
+    count[geom]++;
+  }
+}
+
+/// @brief the vertex ids and attribute of a mesh entity, see select_entities()
+struct EntityInfo {
+  mfem::Geometry::Type geometry;    ///< the geometry of the entity
+  const int*           vertex_ids;  ///< the ids of its vertices
+  int                  attr;        ///< its attribute
+};
+
+/// @brief the attribute of the boundary element on face f, or -1 if there isn't one
+inline int face_attribute(const mfem::Mesh& mesh, const mfem::Array<int>& face_id_to_bdr_id, int f)
+{
+  int bdr_id = face_id_to_bdr_id[f];
+  return (bdr_id >= 0) ? mesh.GetBdrAttribute(bdr_id) : -1;
+}
+
+/// @brief whether face f is shared by two elements on this processor
+inline bool is_local_interior_face(const mfem::Mesh& mesh, int f)
+{
+  auto info = mesh.GetFaceInformation(f);
+  return info.IsInterior() && info.IsLocal();
+}
+
+}  // namespace detail
+
+template <int dim, typename Predicate>
+Domain Domain::ofEdges(const mfem::Mesh& mesh, Predicate&& predicate)
+{
+  Domain output{mesh, 1 /* edges are 1-dimensional */};
+
+  // build mfem's edge-to-vertex table before it is read concurrently
+  const mfem::Table* edge_vertices = mesh.GetEdgeVertexTable();
+
+  mfem::Array<int> face_id_to_bdr_id;
+  if constexpr (dim == 2) {
+    face_id_to_bdr_id = mesh.GetFaceToBdrElMap();
+  }
+
+  detail::select_entities<dim>(output, mesh.GetNEdges(), predicate, [&](int i) {
+    int attr = -1;
+    if constexpr (dim == 2) {
+      attr = detail::face_attribute(mesh, face_id_to_bdr_id, i);
+    }
+    return detail::EntityInfo{mfem::Geometry::SEGMENT, edge_vertices->GetRow(i), attr};
+  });
+
+  return output;
+}
+
+template <int dim, typename Predicate>
+Domain Domain::ofFaces(const mfem::Mesh& mesh, Predicate&& predicate)
+{
+  Domain output{mesh, 2 /* faces are 2-dimensional */};
+
+  if constexpr (dim == 2) {
+    detail::select_entities<dim>(output, mesh.GetNE(), predicate, [&](int i) {
+      const mfem::Element* element = mesh.GetElement(i);
+      return detail::EntityInfo{element->GetGeometryType(), element->GetVertices(), element->GetAttribute()};
+    });
+  } else {
+    mfem::Array<int> face_id_to_bdr_id = mesh.GetFaceToBdrElMap();
+    detail::select_entities<dim>(output, mesh.GetNumFaces(), predicate, [&](int f) {
+      const mfem::Element* face = mesh.GetFace(f);
+      return detail::EntityInfo{face->GetGeometryType(), face->GetVertices(),
+                                detail::face_attribute(mesh, face_id_to_bdr_id, f)};
+    });
+  }
+
+  return output;
+}
+
+template <int dim, typename Predicate>
+Domain Domain::ofElements(const mfem::Mesh& mesh, Predicate&& predicate)
+{
+  Domain output{mesh, dim /* elems can be 2 or 3 dimensional */};
+
+  detail::select_entities<dim>(output, mesh.GetNE(), predicate, [&](int i) {
+    const mfem::Element* element = mesh.GetElement(i);
+    return detail::EntityInfo{element->GetGeometryType(), element->GetVertices(), element->GetAttribute()};
+  });
+
+  return output;
+}
+
+template <int dim, typename Predicate>
+Domain Domain::ofBoundaryElements(const mfem::Mesh& mesh, Predicate&& predicate)
+{
+  Domain output{mesh, dim - 1, Domain::Type::BoundaryElements};
+
+  mfem::Array<int> face_id_to_bdr_id = mesh.GetFaceToBdrElMap();
+
+  detail::select_entities<dim>(output, mesh.GetNumFaces(), predicate, [&](int f) {
+    // interior faces aren't boundary elements
+    if (mesh.GetFaceInformation(f).IsInterior()) {
+      return detail::EntityInfo{mfem::Geometry::INVALID, nullptr, -1};
+    }
+    const mfem::Element* face = mesh.GetFace(f);
+    return detail::EntityInfo{face->GetGeometryType(), face->GetVertices(),
+                              detail::face_attribute(mesh, face_id_to_bdr_id, f)};
+  });
+
+  return output;
+}
+
+template <int dim, typename Predicate>
+Domain Domain::ofInteriorFaces(const mfem::Mesh& mesh, Predicate&& predicate)
+{
+  Domain output{mesh, dim - 1, Domain::Type::InteriorFaces};
+
+  detail::select_entities<dim>(output, mesh.GetNumFaces(), predicate, [&](int f) {
+    if (!detail::is_local_interior_face(mesh, f)) {
+      return detail::EntityInfo{mfem::Geometry::INVALID, nullptr, -1};
+    }
+    const mfem::Element* face = mesh.GetFace(f);
+    return detail::EntityInfo{face->GetGeometryType(), face->GetVertices(), -1};
+  });
+
+  return output;
+}
+
+/**
+ * @brief an index of the elements and boundary elements of a mesh by attribute, so that the domains of
+ * some attributes are built in O(size of the domain), rather than by scanning the whole mesh
+ *
+ * @note building the index takes one pass over the mesh, so one index should be kept per mesh
+ * and reused for all of its attribute domains
+ */
+class AttributeIndex {
+public:
+  /// @brief index the elements and boundary elements of a mesh
+  explicit AttributeIndex(const mfem::Mesh& mesh);
+
+  /**
+   * @brief the domain of the elements with any of the given attributes
+   * @note equivalent to the union of Domain::ofElements(mesh, by_attr<dim>(attr)) over the attributes
+   */
+  Domain elements(const std::set<int>& attributes) const;
+
+  /**
+   * @brief the domain of the boundary elements with any of the given attributes
+   * @note equivalent to the union of Domain::ofBoundaryElements(mesh, by_attr<dim>(attr)) over the attributes
+   */
+  Domain boundaryElements(const std::set<int>& attributes) const;
+
+private:
+  /// @brief where a mesh entity goes in a Domain
+  struct Entity {
+    mfem::Geometry::Type geometry;  ///< the geometry of the entity
+    int                  id;        ///< its index among the entities of that geometry
+    int                  mfem_id;   ///< its index in the mfem::Mesh
+  };
+
+  /// @brief add the entities with the given attributes to a domain
+  static Domain collect(Domain output, const std::map<int, std::vector<Entity>>& index,
+                        const std::set<int>& attributes);
+
+  /// @brief the mesh
+  const mfem::Mesh& mesh_;
+
+  /// @brief the elements with each attribute, in the order of the mesh
+  std::map<int, std::vector<Entity>> elements_;
+
+  /// @brief the boundary elements with each attribute, in the order of the mesh faces
+  std::map<int, std::vector<Entity>> boundary_elements_;
+};
+
 /// @brief constructs a domain from all the elements in a mesh
 Domain EntireDomain(const mfem::Mesh& mesh);
 
 /// @brief constructs a domain from all the boundary elements in a mesh
 Domain EntireBoundary(const mfem::Mesh& mesh);
 
+/// @brief constructs a domain from all the interior faces in a mesh, see Domain::ofInteriorFaces()
+Domain EntireInteriorFaces(const mfem::Mesh& mesh);
+
+/**
+ * @brief constructs a domain from the elements that have a vertex on a boundary domain, e.g. the band of elements
+ * whose integrals depend on the positions of the nodes on a surface
+ */
+Domain elementsTouching(const Domain& boundary);
+
 /// @brief create a new domain that is the union of `a` and `b`
 Domain operator|(const Domain& a, const Domain& b);
 
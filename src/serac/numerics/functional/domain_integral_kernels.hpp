@@ -8,12 +8,22 @@
 #include "serac/serac_config.hpp"
 #include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/quadrature_data.hpp"
+#include "serac/numerics/functional/simd.hpp"
+#include "serac/numerics/functional/derivative_storage.hpp"
 #include "serac/numerics/functional/function_signature.hpp"
+#include "serac/numerics/functional/geometric_factors.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/element_restriction.hpp"
 #include "RAJA/RAJA.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 namespace serac {
 
@@ -125,11 +135,35 @@ SERAC_HOST_DEVICE auto batch_apply_qf_no_qdata(const lambda& qf, double t, const
 
 template <typename lambda, int dim, int n, typename qpt_data_type, typename... T>
 SERAC_HOST_DEVICE auto batch_apply_qf(const lambda& qf, double t, const tensor<double, dim, n>& x,
-                                      const tensor<double, dim, dim, n>& J, qpt_data_type* qpt_data, bool update_state,
-                                      const T&... inputs)
+                                      const tensor<double, dim, dim, n>& J, QuadratureDataView<qpt_data_type>& qpt_data,
+                                      uint32_t e, bool update_state, const T&... inputs)
 {
   using position_t  = serac::tuple<tensor<double, dim>, tensor<double, dim, dim>>;
-  using return_type = decltype(qf(double{}, position_t{}, qpt_data[0], T{}[0]...));
+  using return_type = decltype(qf(double{}, position_t{}, std::declval<qpt_data_type&>(), T{}[0]...));
+
+  if constexpr (qfunction_is_batched<lambda>::value) {
+    tensor<position_t, n>    positions{};
+    tensor<qpt_data_type, n> qdata{};
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          get<1>(positions[i])[j][k] = J(k, j, i);
+        }
+        get<0>(positions[i])[j] = x(j, i);
+      }
+      qdata[i] = qpt_data.load(e, uint32_t(i));
+    }
+    tensor<return_type, n> outputs = qf.batch(t, positions, qdata, inputs...);
+    for (int i = 0; i < n; i++) {
+      if (update_state) {
+        qpt_data.store(e, uint32_t(i), qdata[i]);
+      } else {
+        qpt_data.stage(e, uint32_t(i), qdata[i]);
+      }
+    }
+    return outputs;
+  }
+
   tensor<return_type, n> outputs{};
   for (int i = 0; i < n; i++) {
     tensor<double, dim>      x_q;
@@ -140,30 +174,213 @@ SERAC_HOST_DEVICE auto batch_apply_qf(const lambda& qf, double t, const tensor<d
       }
       x_q[j] = x(j, i);
     }
-    auto qdata = qpt_data[i];
+    auto qdata = qpt_data.load(e, uint32_t(i));
     outputs[i] = qf(t, serac::tuple{x_q, J_q}, qdata, inputs[i]...);
     if (update_state) {
-      qpt_data[i] = qdata;
+      qpt_data.store(e, uint32_t(i), qdata);
+    } else {
+      qpt_data.stage(e, uint32_t(i), qdata);
     }
   }
   return outputs;
 }
 
+/**
+ * @brief the values (and derivatives) at each quadrature point of the arguments of a domain integral whose inputs
+ * don't change between evaluations, so that they are only interpolated and mapped to the physical element once,
+ * see Integral::CacheArgument()
+ */
+struct CachedInputs {
+  /// @brief create storage for the values of @a num_args arguments, none of which are cached
+  CachedInputs(std::size_t num_args)
+      : enabled(num_args, false), valid(num_args, false), values(num_args), bytes(num_args, 0)
+  {
+  }
+
+  /// @brief stop caching the values of argument @a i, and free them
+  void disable(std::size_t i)
+  {
+    enabled[i] = false;
+    valid[i]   = false;
+    values[i].reset();
+    bytes[i] = 0;
+  }
+
+  /// @brief whether the values of each argument are cached
+  std::vector<bool> enabled;
+
+  /// @brief whether the cached values of each argument are those of its current inputs
+  std::vector<bool> valid;
+
+  /// @brief the cached values of each argument (one array per argument, allocated on first use), or nullptr
+  std::vector<std::shared_ptr<void>> values;
+
+  /// @brief the number of bytes allocated for the cached values of each argument
+  std::vector<std::size_t> bytes;
+};
+
+/// @cond
+namespace detail {
+
+/**
+ * @brief decide whether trial argument i can skip interpolation, either because the q-function never reads it,
+ * or because all of its values on the specified elements are zero (e.g. the acceleration in a quasi-static
+ * problem, or the shape displacement of an undeformed mesh). In both cases, the q-function can be given
+ * zero-valued inputs instead, with identical results.
+ */
+template <typename lambda_type, int i, typename dof_type>
+bool can_skip_interpolation(const dof_type* dofs, const int* elements, uint32_t num_elements)
+{
+  if constexpr (!qfunction_reads_argument<lambda_type, i>::value) {
+    return true;
+  } else {
+    constexpr uint32_t values_per_elem = sizeof(dof_type) / sizeof(double);
+    const double*      values          = reinterpret_cast<const double*>(dofs);
+    for (uint32_t e = 0; e < num_elements; e++) {
+      const double* element_values = values + uint32_t(elements[e]) * values_per_elem;
+      for (uint32_t k = 0; k < values_per_elem; k++) {
+        if (element_values[k] != 0.0) return false;
+      }
+    }
+    return true;
+  }
+}
+
+/// @brief interpolate an element's values at each quadrature point, or just return zeros if `skip` is true
+template <typename element_type, typename dof_type, typename rule_type>
+SERAC_HOST_DEVICE auto interpolate_unless(bool skip, element_type element, const dof_type& dofs, const rule_type& rule)
+{
+  using value_type = decltype(element.interpolate(dofs, rule));
+  if (skip) return value_type{};
+  return value_type(element.interpolate(dofs, rule));
+}
+
+/**
+ * @brief the array of cached values for trial argument @a i, or nullptr if its values aren't cached (the
+ * argument being differentiated is never cached, since its values are promoted to dual numbers)
+ */
+template <typename value_type>
+value_type* cached_values(CachedInputs* cache, uint32_t i, bool differentiated, uint32_t num_elements)
+{
+  if (cache == nullptr || differentiated || !cache->enabled[i]) return nullptr;
+
+  if (cache->values[i] == nullptr) {
+    auto values      = accelerator::make_shared_array<ExecutionSpace::CPU, value_type>(num_elements);
+    cache->values[i] = std::shared_ptr<void>(values, values.get());
+    cache->valid[i]  = false;
+    cache->bytes[i]  = num_elements * sizeof(value_type);
+  }
+
+  return static_cast<value_type*>(cache->values[i].get());
+}
+
+/**
+ * @brief the values of a trial argument at each quadrature point of element @a e, on the physical element
+ *
+ * The argument being differentiated is promoted to dual numbers, and is mapped to the physical element even when
+ * its values are skipped, so that its derivatives are taken w.r.t. the physical coordinates. The values of other
+ * arguments are read from @a cache when it holds them, and written to it otherwise.
+ */
+template <bool differentiated, typename element_type, typename dof_type, typename rule_type, typename J_type,
+          typename value_type>
+SERAC_HOST_DEVICE auto physical_values(bool skip, element_type element, const dof_type& dofs, const rule_type& rule,
+                                       const J_type& J_e, value_type* cache, bool cache_valid, uint32_t e)
+{
+  if constexpr (differentiated) {
+    auto values = promote_each_to_dual_when<true>(interpolate_unless(skip, element, dofs, rule));
+    parent_to_physical<element_type::family>(values, J_e);
+    return values;
+  } else {
+    if (cache && cache_valid) return cache[e];
+
+    value_type values = interpolate_unless(skip, element, dofs, rule);
+    if (!skip) {
+      parent_to_physical<element_type::family>(values, J_e);
+    }
+    if (cache) {
+      cache[e] = values;
+    }
+    return values;
+  }
+}
+
+}  // namespace detail
+/// @endcond
+
+/**
+ * @brief read-only access to the jacobians of a domain of elements, in the layout of GeometricFactors::J
+ *
+ * When every element is affine, the jacobians are stored once per element rather than at each quadrature point
+ * (see GeometricFactors::affine), and are expanded to the quadrature points as they are read.
+ */
+template <mfem::Geometry::Type geom, int Q>
+struct jacobian_view {
+  /// @brief the jacobians of one element, at each quadrature point
+  using element_type = typename batched_jacobian<geom, Q>::type;
+
+  static constexpr int dim           = dimension_of(geom);            ///< the dimension of the elements
+  static constexpr int qpts_per_elem = num_quadrature_points(geom, Q);  ///< the number of quadrature points
+
+  const double* values;  ///< the jacobians
+  bool          affine;  ///< whether `values` stores one jacobian per element
+
+  /// @brief the jacobians of element `e` at each quadrature point
+  SERAC_HOST_DEVICE element_type operator[](uint32_t e) const
+  {
+    if (!affine) return reinterpret_cast<const element_type*>(values)[e];
+
+    element_type J_e{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int q = 0; q < qpts_per_elem; q++) {
+          J_e(i, j, q) = values[(int(e) * dim + i) * dim + j];
+        }
+      }
+    }
+    return J_e;
+  }
+
+  /// @brief one entry of the jacobian of element `e` at quadrature point `q`
+  SERAC_HOST_DEVICE double operator()(uint32_t e, int i, int j, int q) const
+  {
+    if (!affine) return values[((int(e) * dim + i) * dim + j) * qpts_per_elem + q];
+    return values[(int(e) * dim + i) * dim + j];
+  }
+};
+
+/// @brief the jacobians stored in a GeometricFactors, see jacobian_view, on the device if @a on_device is set
+template <mfem::Geometry::Type geom, int Q>
+jacobian_view<geom, Q> jacobians_of(const GeometricFactors& geometry, bool on_device = false)
+{
+  if (on_device) return {mfem::Read(geometry.J.GetMemory(), geometry.J.Size()), geometry.affine};
+  return {geometry.J.Read(), geometry.affine};
+}
+
+/**
+ * @brief evaluate a domain integral (and optionally store the q-function derivatives) on a range of its elements
+ *
+ * @param inputs the E-vectors of every trial argument
+ * @param outputs the E-vector that the values of the integral are added to
+ * @param elements the index in the E-vectors of each element in the range
+ * @param num_elements the number of elements in the range
+ * @param first the position of the first element of the range in the domain of the integral, which is used to index
+ * the positions, jacobians, state, q-function derivatives, element costs and cached values of each element
+ */
 template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test_element,
           typename trial_element_tuple, typename lambda_type, typename state_type, typename derivative_type,
           int... indices>
 void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, double t,
                             const std::vector<const double*>& inputs, double* outputs, const double* positions,
-                            const double* jacobians, lambda_type qf,
-                            [[maybe_unused]] axom::ArrayView<state_type, 2> qf_state,
+                            jacobian_view<geom, Q> J, lambda_type qf,
+                            [[maybe_unused]] QuadratureDataView<state_type> qf_state,
                             [[maybe_unused]] derivative_type* qf_derivatives, const int* elements,
-                            uint32_t num_elements, bool update_state, camp::int_seq<int, indices...>)
+                            uint32_t num_elements, uint32_t first, bool update_state, double* element_costs,
+                            [[maybe_unused]] CachedInputs* cache, camp::int_seq<int, indices...>)
 {
   // mfem provides this information as opaque arrays of doubles,
   // so we reinterpret the pointer with
   auto                           r = reinterpret_cast<typename test_element::dof_type*>(outputs);
   auto                           x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
-  auto                           J = reinterpret_cast<const typename batched_jacobian<geom, Q>::type*>(jacobians);
   TensorProductQuadratureRule<Q> rule{};
 
   [[maybe_unused]] auto qpts_per_elem = num_quadrature_points(geom, Q);
@@ -171,20 +388,37 @@ void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, do
   [[maybe_unused]] tuple u = {
       reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
 
+  // arguments that are never read (or are zero everywhere on this domain) have zero values at every
+  // quadrature point, so they don't need to be interpolated or mapped to the physical element
+  [[maybe_unused]] std::array<bool, sizeof...(indices)> skip{
+      detail::can_skip_interpolation<lambda_type, indices>(get<indices>(u), elements, num_elements)...};
+
+  // the values of arguments that don't change between evaluations are interpolated in the
+  // first evaluation after they are cached, and read back in the evaluations after that
+  [[maybe_unused]] tuple cached = {detail::cached_values<decltype(detail::interpolate_unless(
+      false, get<indices>(trial_elements), get<indices>(u)[0], rule))>(cache, indices, indices == differentiation_index,
+                                                                       num_elements)...};
+  [[maybe_unused]] std::array<bool, sizeof...(indices)> cache_valid{(cache && cache->valid[indices])...};
+
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; ++e) {
+  //
+  // note: each element writes to its own block of the E-vector (and its own q-function derivatives / state),
+  // so the elements can be processed concurrently without any synchronization
+  accelerator::forall_host(num_elements, [&](uint32_t i) {
+    auto start = (element_costs) ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+
+    // the position of this element in the domain
+    uint32_t e = first + i;
+
     // load the jacobians and positions for each quadrature point in this element
     auto J_e = J[e];
     auto x_e = x[e];
 
-    //[[maybe_unused]] static constexpr trial_element_tuple trial_element_tuple{};
-    // batch-calculate values / derivatives of each trial space, at each quadrature point
-    [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
-        get<indices>(trial_elements).interpolate(get<indices>(u)[elements[e]], rule))...};
-
-    // use J_e to transform values / derivatives on the parent element
-    // to the to the corresponding values / derivatives on the physical element
-    (parent_to_physical<get<indices>(trial_elements).family>(get<indices>(qf_inputs), J_e), ...);
+    // batch-calculate values / derivatives of each trial space at each quadrature point,
+    // and transform them to the corresponding values / derivatives on the physical element
+    [[maybe_unused]] tuple qf_inputs = {detail::physical_values<indices == differentiation_index>(
+        skip[indices], get<indices>(trial_elements), get<indices>(u)[elements[i]], rule, J_e, get<indices>(cached),
+        cache_valid[indices], e)...};
 
     // (batch) evalute the q-function at each quadrature point
     //
@@ -195,7 +429,7 @@ void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, do
       if constexpr (std::is_same_v<state_type, Nothing>) {
         return batch_apply_qf_no_qdata(qf, t, x_e, J_e, get<indices>(qf_inputs)...);
       } else {
-        return batch_apply_qf(qf, t, x_e, J_e, &qf_state(e, 0), update_state, get<indices>(qf_inputs)...);
+        return batch_apply_qf(qf, t, x_e, J_e, qf_state, e, update_state, get<indices>(qf_inputs)...);
       }
     }();
 
@@ -208,15 +442,426 @@ void evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, do
     // won't need to be applied in the action_of_gradient and element_gradient kernels
     if constexpr (differentiation_index != serac::NO_DIFFERENTIATION) {
       for (int q = 0; q < leading_dimension(qf_outputs); q++) {
-        qf_derivatives[e * uint32_t(qpts_per_elem) + uint32_t(q)] = get_gradient(qf_outputs[q]);
+        store_derivative(qf_derivatives[e * uint32_t(qpts_per_elem) + uint32_t(q)], get_gradient(qf_outputs[q]));
       }
     }
 
     // (batch) integrate the material response against the test-space basis functions
+    test_element::integrate(get_value(qf_outputs), rule, &r[elements[i]]);
+
+    if (element_costs) {
+      element_costs[e] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+  });
+
+  ((get<indices>(cached) ? void(cache->valid[indices] = true) : void()), ...);
+
+  return;
+}
+
+/**
+ * @brief evaluate a domain integral (and optionally store the q-function derivatives) in the execution space
+ * @a exec, e.g. on the device
+ *
+ * This is evaluation_kernel_impl() without its host-side refinements: every argument is interpolated (zero-valued
+ * ones included) and none of their values are cached, elements aren't timed, and there is no quadrature point
+ * state. The q-function must be callable from @a exec.
+ *
+ * @param inputs the E-vectors of every trial argument, in the memory of @a exec
+ * @param outputs the E-vector that the values of the integral are added to, in the memory of @a exec
+ * @param elements the index in the E-vectors of each element, in the memory of @a exec
+ * @param num_elements the number of elements
+ */
+template <ExecutionSpace exec, uint32_t differentiation_index, int Q, mfem::Geometry::Type geom,
+          typename test_element, typename trial_element_tuple, typename lambda_type, typename derivative_type,
+          int... indices>
+void device_evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, double t,
+                                   const std::vector<const double*>& inputs, double* outputs,
+                                   const double* positions, jacobian_view<geom, Q> J, lambda_type qf,
+                                   [[maybe_unused]] derivative_type* qf_derivatives, const int* elements,
+                                   uint32_t num_elements, camp::int_seq<int, indices...>)
+{
+  auto                           r = reinterpret_cast<typename test_element::dof_type*>(outputs);
+  auto                           x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
+  TensorProductQuadratureRule<Q> rule{};
+
+  [[maybe_unused]] tuple u = {
+      reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
+
+  // physical_values() is given an empty cache for each argument, which only serves to name the type of its values
+  [[maybe_unused]] tuple no_cache = {static_cast<decltype(detail::interpolate_unless(
+      false, get<indices>(trial_elements), get<indices>(u)[0], rule))*>(nullptr)...};
+
+  // each element writes to its own block of the E-vector (and its own q-function derivatives)
+  accelerator::forall<exec>(num_elements, [=] SERAC_HOST_DEVICE(uint32_t e) {
+    constexpr uint32_t qpts_per_elem = num_quadrature_points(geom, Q);
+
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    [[maybe_unused]] tuple qf_inputs = {detail::physical_values<indices == differentiation_index>(
+        false, get<indices>(trial_elements), get<indices>(u)[elements[e]], rule, J_e, get<indices>(no_cache), false,
+        e)...};
+
+    auto qf_outputs = batch_apply_qf_no_qdata(qf, t, x_e, J_e, get<indices>(qf_inputs)...);
+
+    physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+    if constexpr (differentiation_index != serac::NO_DIFFERENTIATION) {
+      for (int q = 0; q < leading_dimension(qf_outputs); q++) {
+        store_derivative(qf_derivatives[e * qpts_per_elem + uint32_t(q)], get_gradient(qf_outputs[q]));
+      }
+    }
+
     test_element::integrate(get_value(qf_outputs), rule, &r[elements[e]]);
+  });
+}
+
+/**
+ * @brief evaluate a domain integral for several sets of inputs in one pass over the elements
+ *
+ * The jacobians and positions of each element are loaded once, and shared by the evaluations of every set of
+ * inputs. There are no q-function derivatives to store, and the state is read, but never updated.
+ *
+ * @param inputs the values of every trial argument (E-vectors), for each set of inputs
+ * @param outputs the E-vector that the values of the integral are added to, for each set of inputs
+ */
+template <int Q, mfem::Geometry::Type geom, typename test_element, typename trial_element_tuple, typename lambda_type,
+          typename state_type, int... indices>
+void batched_evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, double t,
+                                    const std::vector<std::vector<const double*>>& inputs,
+                                    const std::vector<double*>& outputs, const double* positions,
+                                    jacobian_view<geom, Q> J, lambda_type qf,
+                                    [[maybe_unused]] QuadratureDataView<state_type> qf_state, const int* elements,
+                                    uint32_t num_elements, camp::int_seq<int, indices...>)
+{
+  using input_type = tuple<const typename decltype(type<indices>(trial_elements))::dof_type*...>;
+
+  auto                           x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
+  TensorProductQuadratureRule<Q> rule{};
+
+  std::size_t num_vectors = outputs.size();
+
+  std::vector<input_type>                           u(num_vectors);
+  std::vector<std::array<bool, sizeof...(indices)>> skip(num_vectors);
+  for (std::size_t c = 0; c < num_vectors; c++) {
+    u[c]    = {reinterpret_cast<std::decay_t<decltype(get<indices>(u[c]))>>(inputs[c][indices])...};
+    skip[c] = {detail::can_skip_interpolation<lambda_type, indices>(get<indices>(u[c]), elements, num_elements)...};
   }
 
-  return;
+  accelerator::forall_host(num_elements, [&](uint32_t e) {
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    for (std::size_t c = 0; c < num_vectors; c++) {
+      [[maybe_unused]] tuple qf_inputs = {detail::interpolate_unless(skip[c][indices], get<indices>(trial_elements),
+                                                                     get<indices>(u[c])[elements[e]], rule)...};
+
+      (skip[c][indices] ? void()
+                        : parent_to_physical<get<indices>(trial_elements).family>(get<indices>(qf_inputs), J_e),
+       ...);
+
+      auto qf_outputs = [&]() {
+        if constexpr (std::is_same_v<state_type, Nothing>) {
+          return batch_apply_qf_no_qdata(qf, t, x_e, J_e, get<indices>(qf_inputs)...);
+        } else {
+          return batch_apply_qf(qf, t, x_e, J_e, qf_state, e, false, get<indices>(qf_inputs)...);
+        }
+      }();
+
+      physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+      auto r = reinterpret_cast<typename test_element::dof_type*>(outputs[c]);
+      test_element::integrate(get_value(qf_outputs), rule, &r[elements[e]]);
+    }
+  });
+}
+
+/// @cond
+namespace detail {
+
+/// @brief combine a value and a direction into a dual number, whose gradient is the directional derivative
+SERAC_HOST_DEVICE inline auto make_directional_dual(double x, double dx) { return dual<double>{x, dx}; }
+
+/// @overload
+template <typename T, int n0, int... n>
+SERAC_HOST_DEVICE auto make_directional_dual(const tensor<T, n0, n...>& x, const tensor<T, n0, n...>& dx);
+
+/// @overload
+template <typename... T, int... i>
+SERAC_HOST_DEVICE auto make_directional_dual(const tuple<T...>& x, const tuple<T...>& dx,
+                                             std::integer_sequence<int, i...>)
+{
+  return tuple{make_directional_dual(get<i>(x), get<i>(dx))...};
+}
+
+/// @overload
+template <typename... T>
+SERAC_HOST_DEVICE auto make_directional_dual(const tuple<T...>& x, const tuple<T...>& dx)
+{
+  return make_directional_dual(x, dx, std::make_integer_sequence<int, int(sizeof...(T))>{});
+}
+
+template <typename T, int n0, int... n>
+SERAC_HOST_DEVICE auto make_directional_dual(const tensor<T, n0, n...>& x, const tensor<T, n0, n...>& dx)
+{
+  // tensors of doubles become tensors of duals, tensors of (e.g. value and gradient) tuples become tensors of tuples
+  using element_type = decltype(make_directional_dual(x[0], dx[0]));
+  using return_type  = std::conditional_t<sizeof...(n) == 0, tensor<element_type, n0>, tensor<dual<double>, n0, n...>>;
+  return_type output{};
+  for (int i = 0; i < n0; i++) {
+    output[i] = make_directional_dual(x[i], dx[i]);
+  }
+  return output;
+}
+
+/// @brief combine the values and direction of the argument being differentiated, and leave the others as-is
+template <bool seed, typename T, typename D>
+SERAC_HOST_DEVICE auto seed_direction_when(const T& x, [[maybe_unused]] const D& dx)
+{
+  if constexpr (seed) {
+    return make_directional_dual(x, dx);
+  } else {
+    return x;
+  }
+}
+
+}  // namespace detail
+/// @endcond
+
+/**
+ * @brief compute the jacobian-vector product of a domain integral by re-evaluating the q-function, with the
+ * argument being differentiated seeded by the direction at each quadrature point
+ *
+ * Unlike evaluation_kernel_impl() followed by action_of_gradient_kernel(), there are no q-function derivatives
+ * to store. The state is read, but never updated.
+ *
+ * @param inputs the values of every trial argument (E-vectors) where the gradient is evaluated
+ * @param direction the direction (E-vector) of the argument being differentiated
+ * @param outputs the E-vector that the directional derivative is added to
+ */
+template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test_element,
+          typename trial_element_tuple, typename lambda_type, typename state_type, int... indices>
+void recomputed_jvp_kernel_impl(trial_element_tuple trial_elements, test_element, double t,
+                                const std::vector<const double*>& inputs, const double* direction, double* outputs,
+                                const double* positions, jacobian_view<geom, Q> J, lambda_type qf,
+                                [[maybe_unused]] QuadratureDataView<state_type> qf_state, const int* elements,
+                                uint32_t num_elements, camp::int_seq<int, indices...>)
+{
+  constexpr int which    = int(differentiation_index);
+  constexpr int num_qpts = num_quadrature_points(geom, Q);
+
+  using direction_element = decltype(type<which>(trial_elements));
+
+  auto                           r  = reinterpret_cast<typename test_element::dof_type*>(outputs);
+  auto                           x  = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
+  auto                           du = reinterpret_cast<const typename direction_element::dof_type*>(direction);
+  TensorProductQuadratureRule<Q> rule{};
+
+  [[maybe_unused]] tuple u = {
+      reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
+
+  [[maybe_unused]] std::array<bool, sizeof...(indices)> skip{
+      detail::can_skip_interpolation<lambda_type, indices>(get<indices>(u), elements, num_elements)...};
+
+  accelerator::forall_host(num_elements, [&](uint32_t e) {
+    auto J_e = J[e];
+    auto x_e = x[e];
+
+    auto du_q = get<which>(trial_elements).interpolate(du[elements[e]], rule);
+
+    [[maybe_unused]] tuple qf_inputs = {detail::seed_direction_when<indices == which>(
+        detail::interpolate_unless(skip[indices], get<indices>(trial_elements), get<indices>(u)[elements[e]], rule),
+        du_q)...};
+
+    ((skip[indices] && indices != which)
+         ? void()
+         : parent_to_physical<get<indices>(trial_elements).family>(get<indices>(qf_inputs), J_e),
+     ...);
+
+    auto qf_outputs = [&]() {
+      if constexpr (std::is_same_v<state_type, Nothing>) {
+        return batch_apply_qf_no_qdata(qf, t, x_e, J_e, get<indices>(qf_inputs)...);
+      } else {
+        return batch_apply_qf(qf, t, x_e, J_e, qf_state, e, false, get<indices>(qf_inputs)...);
+      }
+    }();
+
+    physical_to_parent<test_element::family>(qf_outputs, J_e);
+
+    tensor<decltype(get_gradient(qf_outputs[0])), num_qpts> directional_derivatives{};
+    for (int q = 0; q < num_qpts; q++) {
+      directional_derivatives[q] = get_gradient(qf_outputs[q]);
+    }
+
+    test_element::integrate(directional_derivatives, rule, &r[elements[e]]);
+  });
+}
+
+/// @cond
+namespace detail {
+
+/// @brief the type T, with each double replaced by a simd<double, W> pack
+template <typename T, int W>
+struct packed {
+  using type = T;
+};
+
+template <int W>
+struct packed<double, W> {
+  using type = simd<double, W>;
+};
+
+template <typename T, int... n, int W>
+struct packed<tensor<T, n...>, W> {
+  using type = tensor<typename packed<T, W>::type, n...>;
+};
+
+template <typename... T, int W>
+struct packed<serac::tuple<T...>, W> {
+  using type = serac::tuple<typename packed<T, W>::type...>;
+};
+
+template <int W>
+SERAC_HOST_DEVICE void set_lane(simd<double, W>& packed_value, int lane, double value)
+{
+  packed_value[lane] = value;
+}
+
+SERAC_HOST_DEVICE inline void set_lane(zero&, int, zero) {}
+
+template <typename S, typename T, int m, int... n>
+SERAC_HOST_DEVICE void set_lane(tensor<S, m, n...>& packed_value, int lane, const tensor<T, m, n...>& value)
+{
+  for (int i = 0; i < m; i++) {
+    set_lane(packed_value[i], lane, value[i]);
+  }
+}
+
+template <int W>
+SERAC_HOST_DEVICE double get_lane(const simd<double, W>& packed_value, int lane)
+{
+  return packed_value[lane];
+}
+
+SERAC_HOST_DEVICE inline double get_lane(double value, int) { return value; }
+
+SERAC_HOST_DEVICE inline zero get_lane(zero, int) { return zero{}; }
+
+template <typename T, int m, int... n>
+SERAC_HOST_DEVICE auto get_lane(const tensor<T, m, n...>& packed_value, int lane)
+{
+  using lane_type = decltype(get_lane(T{}, 0));
+  tensor<lane_type, m, n...> value{};
+  for (int i = 0; i < m; i++) {
+    value[i] = get_lane(packed_value[i], lane);
+  }
+  return value;
+}
+
+template <typename... T, int... i>
+SERAC_HOST_DEVICE auto get_lane(const serac::tuple<T...>& packed_value, int lane, std::integer_sequence<int, i...>)
+{
+  return serac::tuple{get_lane(serac::get<i>(packed_value), lane)...};
+}
+
+template <typename... T>
+SERAC_HOST_DEVICE auto get_lane(const serac::tuple<T...>& packed_value, int lane)
+{
+  return get_lane(packed_value, lane, std::make_integer_sequence<int, int(sizeof...(T))>{});
+}
+
+/// @brief gather the values of trial argument i at quadrature point q of each lane's element into one pack
+template <int i, int W, typename element_inputs_type>
+SERAC_HOST_DEVICE auto pack_lanes(const element_inputs_type (&lane_inputs)[W], int q)
+{
+  using value_type = std::decay_t<decltype(serac::get<i>(lane_inputs[0])[q])>;
+  typename packed<value_type, W>::type packed_value{};
+  for (int lane = 0; lane < W; lane++) {
+    set_lane(packed_value, lane, serac::get<i>(lane_inputs[lane])[q]);
+  }
+  return packed_value;
+}
+
+}  // namespace detail
+/// @endcond
+
+/**
+ * @brief evaluate a q-function on W elements at a time, by calling it with simd<double, W> packs
+ * of the W elements' values at each quadrature point
+ *
+ * @note this version is used in place of evaluation_kernel_impl() for residual evaluations
+ * of q-functions without quadrature data that opt in through qfunction_simd_width
+ */
+template <int W, int Q, mfem::Geometry::Type geom, typename test_element, typename trial_element_tuple,
+          typename lambda_type, int... indices>
+void simd_evaluation_kernel_impl(trial_element_tuple trial_elements, test_element, double t,
+                                 const std::vector<const double*>& inputs, double* outputs, const double* positions,
+                                 jacobian_view<geom, Q> J, lambda_type qf, const int* elements, uint32_t num_elements,
+                                 camp::int_seq<int, indices...>)
+{
+  constexpr int dim           = dimension_of(geom);
+  constexpr int qpts_per_elem = num_quadrature_points(geom, Q);
+
+  auto                           r = reinterpret_cast<typename test_element::dof_type*>(outputs);
+  auto                           x = reinterpret_cast<const typename batched_position<geom, Q>::type*>(positions);
+  TensorProductQuadratureRule<Q> rule{};
+
+  tuple u = {reinterpret_cast<const typename decltype(type<indices>(trial_elements))::dof_type*>(inputs[indices])...};
+
+  std::array<bool, sizeof...(indices)> skip{
+      detail::can_skip_interpolation<lambda_type, indices>(get<indices>(u), elements, num_elements)...};
+
+  // interpolate the trial spaces on one element, and map them to the physical element
+  auto element_inputs = [&](uint32_t e) {
+    tuple qf_inputs = {
+        detail::interpolate_unless(skip[indices], get<indices>(trial_elements), get<indices>(u)[elements[e]], rule)...};
+    (skip[indices] ? void() : parent_to_physical<get<indices>(trial_elements).family>(get<indices>(qf_inputs), J[e]),
+     ...);
+    return qf_inputs;
+  };
+
+  using element_inputs_type = decltype(element_inputs(0));
+  using position_type       = serac::tuple<tensor<double, dim>, tensor<double, dim, dim>>;
+  using output_type = decltype(qf(double{}, position_type{}, get<indices>(element_inputs_type{})[0]...));
+
+  // the last batch is padded by repeating its final element, and the padding's results are discarded
+  constexpr uint32_t width       = uint32_t(W);
+  uint32_t           num_batches = (num_elements + width - 1) / width;
+  accelerator::forall_host(num_batches, [&](uint32_t b) {
+    uint32_t num_lanes = std::min(width, num_elements - b * width);
+
+    uint32_t            lane_elements[W];
+    element_inputs_type lane_inputs[W];
+    for (int lane = 0; lane < W; lane++) {
+      lane_elements[lane] = b * width + std::min(uint32_t(lane), num_lanes - 1);
+      lane_inputs[lane]   = (uint32_t(lane) < num_lanes) ? element_inputs(lane_elements[lane]) : lane_inputs[0];
+    }
+
+    tensor<output_type, qpts_per_elem> lane_outputs[W];
+    for (int q = 0; q < qpts_per_elem; q++) {
+      typename detail::packed<position_type, W>::type X_q{};
+      for (int lane = 0; lane < W; lane++) {
+        const auto& x_e = x[lane_elements[lane]];
+        for (int j = 0; j < dim; j++) {
+          for (int k = 0; k < dim; k++) {
+            get<1>(X_q)[j][k][lane] = J(lane_elements[lane], k, j, q);
+          }
+          get<0>(X_q)[j][lane] = x_e(j, q);
+        }
+      }
+
+      auto output = qf(t, X_q, detail::pack_lanes<indices>(lane_inputs, q)...);
+      for (int lane = 0; lane < W; lane++) {
+        lane_outputs[lane][q] = detail::get_lane(output, lane);
+      }
+    }
+
+    for (uint32_t lane = 0; lane < num_lanes; lane++) {
+      physical_to_parent<test_element::family>(lane_outputs[lane], J[lane_elements[lane]]);
+      test_element::integrate(lane_outputs[lane], rule, &r[elements[lane_elements[lane]]]);
+    }
+  });
 }
 
 //clang-format off
@@ -240,10 +885,11 @@ SERAC_HOST_DEVICE auto chain_rule(const S& dfdx, const T& dx)
 template <bool is_QOI, typename derivative_type, int n, typename T>
 SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, const tensor<T, n>& inputs)
 {
-  using return_type = decltype(chain_rule<is_QOI>(derivative_type{}, T{}));
+  using unpacked_type = typename unpacked_derivative<derivative_type>::type;
+  using return_type   = decltype(chain_rule<is_QOI>(unpacked_type{}, T{}));
   tensor<return_type, n> outputs{};
   for (int i = 0; i < n; i++) {
-    outputs[i] = chain_rule<is_QOI>(qf_derivatives[i], inputs[i]);
+    outputs[i] = chain_rule<is_QOI>(load_derivative(qf_derivatives[i]), inputs[i]);
   }
   return outputs;
 }
@@ -260,6 +906,7 @@ SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, c
  * and are erased through the @p std::function members of @p DomainIntegral
  * @tparam g The shape of the element (only quadrilateral and hexahedron are supported at present)
  * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam exec where the kernel runs, which is where @p dU, @p dR, the derivatives and the elements must be stored
  * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
  *
  * @note lambda does not appear as a template argument, as the directional derivative is
@@ -274,7 +921,8 @@ SERAC_HOST_DEVICE auto batch_apply_chain_rule(derivative_type* qf_derivatives, c
  * @param[in] num_elements The number of elements in the mesh
  */
 
-template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, ExecutionSpace exec = ExecutionSpace::CPU,
+          typename derivatives_type>
 void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, const int* elements,
                                std::size_t num_elements)
 {
@@ -291,7 +939,7 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
   constexpr TensorProductQuadratureRule<Q> rule{};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
+  accelerator::forall<exec>(uint32_t(num_elements), [=] SERAC_HOST_DEVICE(uint32_t e) {
     // (batch) interpolate each quadrature point's value
     auto qf_inputs = trial_element::interpolate(du[elements[e]], rule);
 
@@ -300,6 +948,374 @@ void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* q
 
     // (batch) integrate the material response against the test-space basis functions
     test_element::integrate(qf_outputs, rule, &dr[elements[e]]);
+  });
+}
+
+/// @brief the elements of a domain integral, grouped so that the elements of each group don't share any test dofs
+struct ElementColoring {
+  /// the gather indices of the test space restriction that the coloring was computed for
+  const int* test_ids = nullptr;
+
+  /// the positions (in the integral's list of elements) of the elements of each color
+  std::vector<std::vector<uint32_t>> colors;
+};
+
+/**
+ * @brief a version of action_of_gradient_kernel() that reads the element values directly from the L-vector, and
+ * scatter-adds the element residuals directly into the L-vector, so that no E-vectors are needed
+ *
+ * The elements of each color are processed concurrently, since they don't share any dofs of the test space.
+ *
+ * @param[in] dU the L-vector of the trial space (primary input)
+ * @param[inout] dR the L-vector of the test space (primary output)
+ * @param[in] qf_derivatives the derivatives of the q-function at each quadrature point
+ * @param[in] elements the indices of the elements in the domain
+ * @param[in] trial_restriction the restriction operator of the trial space, for this element geometry
+ * @param[in] test_restriction the restriction operator of the test space, for this element geometry
+ * @param[in] coloring the elements of the domain, grouped by color, see ElementRestriction::ColorElements()
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+void fused_action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives,
+                                     const int* elements, const ElementRestriction& trial_restriction,
+                                     const ElementRestriction& test_restriction, const ElementColoring& coloring)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+  using trial_dofs    = typename trial_element::dof_type;
+  using test_dofs     = typename test_element::dof_type;
+
+  constexpr int  num_qpts     = num_quadrature_points(g, Q);
+  constexpr auto trial_values = sizeof(trial_dofs) / sizeof(double);
+  constexpr auto test_values  = sizeof(test_dofs) / sizeof(double);
+
+  const int*                               trial_ids = trial_restriction.gather_ids.data();
+  const int*                               test_ids  = test_restriction.gather_ids.data();
+  constexpr TensorProductQuadratureRule<Q> rule{};
+
+  for (const auto& color : coloring.colors) {
+    accelerator::forall_host(uint32_t(color.size()), [&](uint32_t c) {
+      uint32_t e = color[c];
+
+      // gather the element values from the L-vector
+      trial_dofs du;
+      auto       du_values = reinterpret_cast<double*>(&du);
+      const int* du_ids    = trial_ids + std::size_t(elements[e]) * trial_values;
+      for (std::size_t k = 0; k < trial_values; k++) {
+        du_values[k] = dU[du_ids[k]];
+      }
+
+      auto qf_inputs  = trial_element::interpolate(du, rule);
+      auto qf_outputs = batch_apply_chain_rule<false>(qf_derivatives + e * num_qpts, qf_inputs);
+
+      test_dofs dr{};
+      test_element::integrate(qf_outputs, rule, &dr);
+
+      // scatter-add the element residual into the L-vector
+      auto       dr_values = reinterpret_cast<const double*>(&dr);
+      const int* dr_ids    = test_ids + std::size_t(elements[e]) * test_values;
+      for (std::size_t k = 0; k < test_values; k++) {
+        dR[dr_ids[k]] += dr_values[k];
+      }
+    });
+  }
+}
+
+//clang-format off
+template <bool is_QOI, typename X, typename S, typename T>
+SERAC_HOST_DEVICE auto transpose_chain_rule(const S& dfdx, const T& dy)
+{
+  using X0 = std::decay_t<decltype(serac::get<0>(X{}))>;
+  using X1 = std::decay_t<decltype(serac::get<1>(X{}))>;
+
+  if constexpr (is_QOI) {
+    return serac::tuple{serac::transpose_chain_rule<X0>(serac::get<0>(dfdx), dy),
+                        serac::transpose_chain_rule<X1>(serac::get<1>(dfdx), dy)};
+  }
+
+  if constexpr (!is_QOI) {
+    return serac::tuple{serac::transpose_chain_rule<X0>(serac::get<0>(serac::get<0>(dfdx)), serac::get<0>(dy)) +
+                            serac::transpose_chain_rule<X0>(serac::get<0>(serac::get<1>(dfdx)), serac::get<1>(dy)),
+                        serac::transpose_chain_rule<X1>(serac::get<1>(serac::get<0>(dfdx)), serac::get<0>(dy)) +
+                            serac::transpose_chain_rule<X1>(serac::get<1>(serac::get<1>(dfdx)), serac::get<1>(dy))};
+  }
+}
+//clang-format on
+
+/**
+ * @brief The kernel template used to create the transpose of the directional derivative kernels,
+ * i.e. the vector-jacobian products used by adjoint and sensitivity calculations
+ *
+ * The test-space values are interpolated at each quadrature point, multiplied by the transpose of the
+ * stored q-function derivatives, and then integrated against the trial-space basis functions. This computes
+ * the same values as the transpose of the assembled gradient, without forming it.
+ *
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[in] dR The full set of per-element values in the test space (primary input)
+ * @param[inout] dU The full set of per-element values in the trial space (primary output)
+ * @param[in] qf_derivatives The address at which derivatives of the q-function with
+ * respect to its arguments are stored
+ * @param[in] elements The indices of the elements to integrate over
+ * @param[in] num_elements The number of elements in the domain
+ */
+template <int Q, mfem::Geometry::Type g, typename test, typename trial, typename derivatives_type>
+void action_of_gradient_transpose_kernel(const double* dR, double* dU, derivatives_type* qf_derivatives,
+                                         const int* elements, std::size_t num_elements)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr bool is_QOI   = (test::family == Family::QOI);
+  constexpr int  num_qpts = num_quadrature_points(g, Q);
+
+  auto                                     dr = reinterpret_cast<const typename test_element::dof_type*>(dR);
+  auto                                     du = reinterpret_cast<typename trial_element::dof_type*>(dU);
+  constexpr TensorProductQuadratureRule<Q> rule{};
+
+  using unpacked_type = typename unpacked_derivative<derivatives_type>::type;
+  using trial_input   = std::decay_t<decltype(trial_element::interpolate(typename trial_element::dof_type{}, rule)[0])>;
+
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    // the test-space values at each quadrature point (a QoI has a single value per element)
+    auto test_values = [&]() {
+      if constexpr (is_QOI) {
+        return dr[elements[e]];
+      } else {
+        return test_element::interpolate(dr[elements[e]], rule);
+      }
+    }();
+
+    auto at_qpt = [&](int q) -> decltype(auto) {
+      if constexpr (is_QOI) {
+        return test_values;
+      } else {
+        return test_values[q];
+      }
+    };
+
+    using output_type = decltype(transpose_chain_rule<is_QOI, trial_input>(unpacked_type{}, at_qpt(0)));
+    tensor<output_type, num_qpts> qf_outputs{};
+    for (int q = 0; q < num_qpts; q++) {
+      qf_outputs[q] =
+          transpose_chain_rule<is_QOI, trial_input>(load_derivative(qf_derivatives[e * num_qpts + q]), at_qpt(q));
+    }
+
+    // (batch) integrate against the trial-space basis functions
+    trial_element::integrate(qf_outputs, rule, &du[elements[e]]);
+  });
+}
+
+/// @brief read entry @p i of a block of q-function derivatives, treating blocks that are identically zero as 0.0
+template <typename T>
+SERAC_HOST_DEVICE constexpr double flat_entry(const T& block, int i)
+{
+  if constexpr (is_zero<T>{}) {
+    return 0.0;
+  } else {
+    return reinterpret_cast<const double*>(&block)[i];
+  }
+}
+
+/**
+ * @brief the derivative of the (H1) q-function output for test component @p i with respect to
+ * trial component @p j, where a (b) = 0 selects the test (trial) value and a (b) = k + 1 selects
+ * its derivative in the k^{th} parent coordinate
+ *
+ * @note the flat indices follow the same layout that finite_element::integrate() uses for the
+ * outputs of finite_element::batch_apply_shape_fn()
+ */
+template <int dim, int trial_components, typename derivatives_type>
+SERAC_HOST_DEVICE double derivative_entry(const derivatives_type& d, int a, int b, int i, int j)
+{
+  constexpr int cu = trial_components;
+  if (a == 0 && b == 0) return flat_entry(get<0>(get<0>(d)), i * cu + j);
+  if (a == 0) return flat_entry(get<1>(get<0>(d)), (i * cu + j) * dim + (b - 1));
+  if (b == 0) return flat_entry(get<0>(get<1>(d)), (i * dim + (a - 1)) * cu + j);
+  return flat_entry(get<1>(get<1>(d)), ((i * dim + (a - 1)) * cu + j) * dim + (b - 1));
+}
+
+/**
+ * @brief Compute one H1 x H1 element gradient matrix on a quadrilateral or hexahedron by sum factorization
+ *
+ * Rather than forming one column of the element matrix at a time, the quadrature-point derivatives
+ * (the "D" in B^T D B) are contracted against the 1D test and trial shape functions one direction at a time:
+ *
+ *   K(i, I; j, J) = sum_q T_x(qx, Ix) U_x(qx, Jx) T_y(qy, Iy) U_y(qy, Jy) [T_z(qz, Iz) U_z(qz, Jz)] D(q; i, j)
+ *
+ * where T and U are the 1D test (weighted) and trial shape function values or derivatives, depending on which
+ * block of D is being integrated. Blocks with the same choice of T and U in the last direction share their final
+ * contraction, and blocks whose derivative type is identically zero are skipped at compile time.
+ *
+ * @tparam test_element the test finite element (H1, quadrilateral or hexahedron)
+ * @tparam trial_element the trial finite element (H1, same geometry as @p test_element)
+ * @tparam q the number of quadrature points per direction
+ *
+ * @param[in] derivatives the q-function derivatives at each quadrature point of this element
+ * @param[inout] K the element matrix, stored as K[trial vdof][test vdof], the values computed here are added to
+ * its existing contents
+ */
+template <typename test_element, typename trial_element, int q, typename derivatives_type>
+void tensor_product_element_gradient(const derivatives_type* derivatives, double* K)
+{
+  constexpr int dim        = trial_element::dim;
+  constexpr int nt         = test_element::n;
+  constexpr int nu         = trial_element::n;
+  constexpr int ct         = test_element::components;
+  constexpr int cu         = trial_element::components;
+  constexpr int test_vdofs = ct * test_element::ndof;
+
+  static_assert(test_element::dim == dim, "test and trial elements must have the same geometry");
+
+  // as in integrate(), the test functions carry the quadrature weights
+  static constexpr auto Bt = test_element::template calculate_B<true, q>();
+  static constexpr auto Gt = test_element::template calculate_G<true, q>();
+  static constexpr auto Bu = trial_element::template calculate_B<false, q>();
+  static constexpr auto Gu = trial_element::template calculate_G<false, q>();
+
+  using d00_type = std::decay_t<decltype(get<0>(get<0>(derivatives[0])))>;
+  using d01_type = std::decay_t<decltype(get<1>(get<0>(derivatives[0])))>;
+  using d10_type = std::decay_t<decltype(get<0>(get<1>(derivatives[0])))>;
+  using d11_type = std::decay_t<decltype(get<1>(get<1>(derivatives[0])))>;
+
+  constexpr bool nonzero[2][2] = {{!is_zero<d00_type>{}, !is_zero<d01_type>{}},
+                                  {!is_zero<d10_type>{}, !is_zero<d11_type>{}}};
+
+  for (int i = 0; i < ct; i++) {
+    for (int j = 0; j < cu; j++) {
+      if constexpr (dim == 2) {
+        // A1(qy, Ix, Jx) := T_x(qx, Ix) * U_x(qx, Jx) * D(qy, qx), grouped by the choice of T_y, U_y
+        tensor<double, q, nt, nu> A1[2][2]{};
+        bool                      used[2][2]{};
+
+        for (int a = 0; a <= dim; a++) {
+          for (int b = 0; b <= dim; b++) {
+            if (!nonzero[a > 0][b > 0]) continue;
+
+            const auto& Tx  = (a == 1) ? Gt : Bt;
+            const auto& Ux  = (b == 1) ? Gu : Bu;
+            auto&       A1y = A1[a == 2][b == 2];
+            used[a == 2][b == 2] = true;
+
+            for (int qy = 0; qy < q; qy++) {
+              for (int qx = 0; qx < q; qx++) {
+                double D = derivative_entry<dim, cu>(derivatives[qy * q + qx], a, b, i, j);
+                for (int Ix = 0; Ix < nt; Ix++) {
+                  for (int Jx = 0; Jx < nu; Jx++) {
+                    A1y(qy, Ix, Jx) += Tx(qx, Ix) * Ux(qx, Jx) * D;
+                  }
+                }
+              }
+            }
+          }
+        }
+
+        // K(i, Iy, Ix; j, Jy, Jx) += T_y(qy, Iy) * U_y(qy, Jy) * A1(qy, Ix, Jx)
+        for (int ty = 0; ty < 2; ty++) {
+          for (int uy = 0; uy < 2; uy++) {
+            if (!used[ty][uy]) continue;
+
+            const auto& Ty = ty ? Gt : Bt;
+            const auto& Uy = uy ? Gu : Bu;
+            for (int Jy = 0; Jy < nu; Jy++) {
+              for (int Jx = 0; Jx < nu; Jx++) {
+                double* K_row = K + (j * nu * nu + Jy * nu + Jx) * test_vdofs + i * nt * nt;
+                for (int Iy = 0; Iy < nt; Iy++) {
+                  for (int Ix = 0; Ix < nt; Ix++) {
+                    double sum = 0.0;
+                    for (int qy = 0; qy < q; qy++) {
+                      sum += Ty(qy, Iy) * Uy(qy, Jy) * A1[ty][uy](qy, Ix, Jx);
+                    }
+                    K_row[Iy * nt + Ix] += sum;
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+
+      if constexpr (dim == 3) {
+        // A2(qz, Iy, Jy, Ix, Jx) := T_y(qy, Iy) * U_y(qy, Jy) * T_x(qx, Ix) * U_x(qx, Jx) * D(qz, qy, qx),
+        // grouped by the choice of T_z, U_z
+        tensor<double, q, nt, nu, nt, nu> A2[2][2]{};
+        bool                              used[2][2]{};
+
+        for (int a = 0; a <= dim; a++) {
+          for (int b = 0; b <= dim; b++) {
+            if (!nonzero[a > 0][b > 0]) continue;
+
+            const auto& Tx  = (a == 1) ? Gt : Bt;
+            const auto& Ux  = (b == 1) ? Gu : Bu;
+            const auto& Ty  = (a == 2) ? Gt : Bt;
+            const auto& Uy  = (b == 2) ? Gu : Bu;
+            auto&       A2z = A2[a == 3][b == 3];
+            used[a == 3][b == 3] = true;
+
+            // A1(qz, qy, Ix, Jx) := T_x(qx, Ix) * U_x(qx, Jx) * D(qz, qy, qx)
+            tensor<double, q, q, nt, nu> A1{};
+            for (int qz = 0; qz < q; qz++) {
+              for (int qy = 0; qy < q; qy++) {
+                for (int qx = 0; qx < q; qx++) {
+                  double D = derivative_entry<dim, cu>(derivatives[(qz * q + qy) * q + qx], a, b, i, j);
+                  for (int Ix = 0; Ix < nt; Ix++) {
+                    for (int Jx = 0; Jx < nu; Jx++) {
+                      A1(qz, qy, Ix, Jx) += Tx(qx, Ix) * Ux(qx, Jx) * D;
+                    }
+                  }
+                }
+              }
+            }
+
+            for (int qz = 0; qz < q; qz++) {
+              for (int qy = 0; qy < q; qy++) {
+                for (int Iy = 0; Iy < nt; Iy++) {
+                  for (int Jy = 0; Jy < nu; Jy++) {
+                    double w = Ty(qy, Iy) * Uy(qy, Jy);
+                    for (int Ix = 0; Ix < nt; Ix++) {
+                      for (int Jx = 0; Jx < nu; Jx++) {
+                        A2z(qz, Iy, Jy, Ix, Jx) += w * A1(qz, qy, Ix, Jx);
+                      }
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+
+        // K(i, Iz, Iy, Ix; j, Jz, Jy, Jx) += T_z(qz, Iz) * U_z(qz, Jz) * A2(qz, Iy, Jy, Ix, Jx)
+        for (int tz = 0; tz < 2; tz++) {
+          for (int uz = 0; uz < 2; uz++) {
+            if (!used[tz][uz]) continue;
+
+            const auto& Tz = tz ? Gt : Bt;
+            const auto& Uz = uz ? Gu : Bu;
+            for (int Jz = 0; Jz < nu; Jz++) {
+              for (int Jy = 0; Jy < nu; Jy++) {
+                for (int Jx = 0; Jx < nu; Jx++) {
+                  double* K_row = K + (j * nu * nu * nu + (Jz * nu + Jy) * nu + Jx) * test_vdofs + i * nt * nt * nt;
+                  for (int Iz = 0; Iz < nt; Iz++) {
+                    for (int Iy = 0; Iy < nt; Iy++) {
+                      for (int Ix = 0; Ix < nt; Ix++) {
+                        double sum = 0.0;
+                        for (int qz = 0; qz < q; qz++) {
+                          sum += Tz(qz, Iz) * Uz(qz, Jz) * A2[tz][uz](qz, Iy, Jy, Ix, Jx);
+                        }
+                        K_row[(Iz * nt + Iy) * nt + Ix] += sum;
+                      }
+                    }
+                  }
+                }
+              }
+            }
+          }
+        }
+      }
+    }
   }
 }
 
@@ -331,47 +1347,196 @@ void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, d
   // quantities of interest have no flux term, so we pad the derivative
   // tuple with a "zero" type in the second position to treat it like the standard case
   constexpr bool is_QOI        = test::family == Family::QOI;
-  using padded_derivative_type = std::conditional_t<is_QOI, tuple<derivatives_type, zero>, derivatives_type>;
+  using unpacked_type          = typename unpacked_derivative<derivatives_type>::type;
+  using padded_derivative_type = std::conditional_t<is_QOI, tuple<unpacked_type, zero>, unpacked_type>;
+
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+
+  // H1 x H1 on quadrilaterals and hexahedra can exploit the tensor-product structure of both bases
+  constexpr bool sum_factorize = (g == mfem::Geometry::SQUARE || g == mfem::Geometry::CUBE) &&
+                                 (test::family == Family::H1) && (trial::family == Family::H1);
+
+  if constexpr (sum_factorize) {
+    accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+      if constexpr (std::is_same_v<unpacked_type, derivatives_type>) {
+        tensor_product_element_gradient<test_element, trial_element, Q>(qf_derivatives + e * nquad,
+                                                                         &dK(elements[e], 0, 0));
+      } else {
+        tensor<unpacked_type, nquad> derivatives{};
+        for (int q = 0; q < nquad; q++) {
+          derivatives[q] = load_derivative(qf_derivatives[e * nquad + uint32_t(q)]);
+        }
+        tensor_product_element_gradient<test_element, trial_element, Q>(&derivatives[0], &dK(elements[e], 0, 0));
+      }
+    });
+  } else {
+    static constexpr TensorProductQuadratureRule<Q> rule{};
+
+    // for each element in the domain
+    accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+      auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(elements[e], 0, 0));
 
+      tensor<padded_derivative_type, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        if constexpr (is_QOI) {
+          get<0>(derivatives(q)) = load_derivative(qf_derivatives[e * nquad + uint32_t(q)]);
+        } else {
+          derivatives(q) = load_derivative(qf_derivatives[e * nquad + uint32_t(q)]);
+        }
+      }
+
+      for (int J = 0; J < trial_element::ndof; J++) {
+        auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+        test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+      }
+    });
+  }
+}
+
+/**
+ * @brief The base kernel template used to compute only the diagonal entries of the element gradient
+ * matrices, without storing the element matrices themselves
+ *
+ * @tparam g The shape of the element
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space (must be the same as the test space)
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[inout] dE E-vector storing the diagonal entries of each element matrix, the values computed here are added
+ * to its existing contents
+ * @param[in] qf_derivatives pointer to data describing the derivatives of the q-function with respect to its arguments
+ * @param[in] elements the indices of the elements to process
+ * @param[in] num_elements The number of elements in the mesh
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
+void element_diagonal_kernel(double* dE, derivatives_type* qf_derivatives, const int* elements,
+                             std::size_t num_elements)
+{
   using test_element  = finite_element<g, test>;
   using trial_element = finite_element<g, trial>;
 
   constexpr int nquad = num_quadrature_points(g, Q);
+  constexpr int ndof  = trial_element::ndof;
+  constexpr int ncomp = trial_element::components;
 
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
   // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
-    auto* output_ptr = reinterpret_cast<typename test_element::dof_type*>(&dK(elements[e], 0, 0));
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    double* diagonal = dE + std::size_t(elements[e]) * ndof * ncomp;
 
-    tensor<padded_derivative_type, nquad> derivatives{};
+    tensor<typename unpacked_derivative<derivatives_type>::type, nquad> derivatives{};
     for (int q = 0; q < nquad; q++) {
-      if constexpr (is_QOI) {
-        get<0>(derivatives(q)) = qf_derivatives[e * nquad + uint32_t(q)];
-      } else {
-        derivatives(q) = qf_derivatives[e * nquad + uint32_t(q)];
-      }
+      derivatives(q) = load_derivative(qf_derivatives[e * nquad + uint32_t(q)]);
     }
 
-    for (int J = 0; J < trial_element::ndof; J++) {
-      auto source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
-      test_element::integrate(source_and_flux, rule, output_ptr + J, trial_element::ndof);
+    // compute one column of the element matrix at a time (for each trial component),
+    // and only keep the entry that lies on the diagonal
+    for (int J = 0; J < ndof; J++) {
+      typename test_element::dof_type column[ncomp]{};
+      auto                            source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+      test_element::integrate(source_and_flux, rule, column);
+      for (int c = 0; c < ncomp; c++) {
+        diagonal[c * ndof + J] += reinterpret_cast<const double*>(&column[c])[c * ndof + J];
+      }
     }
-  }
+  });
 }
 
 template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type, typename state_type,
           typename derivative_type>
-auto evaluation_kernel(signature s, const lambda_type& qf, const double* positions, const double* jacobians,
+auto evaluation_kernel(signature s, const lambda_type& qf, const GeometricFactors& geometry,
                        std::shared_ptr<QuadratureData<state_type>> qf_state,
-                       std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+                       std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements,
+                       std::shared_ptr<std::vector<double>> element_costs, std::shared_ptr<CachedInputs> cache)
 {
-  auto trial_elements = trial_elements_tuple<geom>(s);
-  auto test_element   = get_test_element<geom>(s);
-  return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool update_state) {
+  // the geometric factors are read when the kernel is called, since GeometricFactors::update() can change them
+  auto                    trial_elements = trial_elements_tuple<geom>(s);
+  auto                    test_element   = get_test_element<geom>(s);
+  const GeometricFactors* gf             = &geometry;
+  return [=](double time, const std::vector<const double*>& inputs, double* outputs,
+             [[maybe_unused]] bool update_state) {
+    // q-functions that opt in to batched evaluation are evaluated on several elements at once, when possible
+    constexpr int simd_width = qfunction_simd_width<lambda_type>::value;
+    if constexpr (simd_width > 1 && wrt == NO_DIFFERENTIATION && std::is_same_v<state_type, Nothing>) {
+      domain_integral::simd_evaluation_kernel_impl<simd_width, Q, geom>(
+          trial_elements, test_element, time, inputs, outputs, gf->X.Read(), jacobians_of<geom, Q>(*gf), qf, elements,
+          num_elements, s.index_seq);
+    } else {
+      // elements are only timed while element_costs has room for them, see Integral::RecordElementCosts()
+      double* costs = element_costs->empty() ? nullptr : element_costs->data();
+      domain_integral::evaluation_kernel_impl<wrt, Q, geom>(
+          trial_elements, test_element, time, inputs, outputs, gf->X.Read(), jacobians_of<geom, Q>(*gf), qf,
+          (*qf_state)[geom], qf_derivatives->get(), elements, num_elements, 0, update_state, costs, cache.get(),
+          s.index_seq);
+    }
+  };
+}
+
+/**
+ * @brief create the kernel that evaluates a domain integral on a range of its elements at a time, whose values are
+ * gathered into (and scatter-added from) tile-sized E-vectors, see Integral::TiledMult()
+ *
+ * @note the values of unchanging arguments aren't cached, since the kernel only sees one tile at a time
+ */
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type, typename state_type,
+          typename derivative_type>
+auto tiled_evaluation_kernel(signature s, const lambda_type& qf, const GeometricFactors& geometry,
+                             std::shared_ptr<QuadratureData<state_type>> qf_state,
+                             std::shared_ptr<derivative_type> qf_derivatives,
+                             std::shared_ptr<std::vector<double>> element_costs)
+{
+  auto                    trial_elements = trial_elements_tuple<geom>(s);
+  auto                    test_element   = get_test_element<geom>(s);
+  const GeometricFactors* gf             = &geometry;
+
+  // the elements of each tile are stored consecutively in the tile E-vectors
+  auto tile_ids = std::make_shared<std::vector<int>>();
+  return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool update_state,
+             uint32_t first, uint32_t num_elements) {
+    if (tile_ids->size() < num_elements) {
+      tile_ids->resize(num_elements);
+      std::iota(tile_ids->begin(), tile_ids->end(), 0);
+    }
+    double* costs = element_costs->empty() ? nullptr : element_costs->data();
     domain_integral::evaluation_kernel_impl<wrt, Q, geom>(
-        trial_elements, test_element, time, inputs, outputs, positions, jacobians, qf, (*qf_state)[geom],
-        qf_derivatives.get(), elements, num_elements, update_state, s.index_seq);
+        trial_elements, test_element, time, inputs, outputs, gf->X.Read(), jacobians_of<geom, Q>(*gf), qf,
+        (*qf_state)[geom], qf_derivatives->get(), tile_ids->data(), num_elements, first, update_state, costs,
+        nullptr, s.index_seq);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type, typename state_type>
+auto recomputed_jvp_kernel(signature s, const lambda_type& qf, const GeometricFactors& geometry,
+                           std::shared_ptr<QuadratureData<state_type>> qf_state, const int* elements,
+                           uint32_t num_elements)
+{
+  auto                    trial_elements = trial_elements_tuple<geom>(s);
+  auto                    test_element   = get_test_element<geom>(s);
+  const GeometricFactors* gf             = &geometry;
+  return [=](double time, const std::vector<const double*>& inputs, const double* direction, double* outputs) {
+    domain_integral::recomputed_jvp_kernel_impl<wrt, Q, geom>(
+        trial_elements, test_element, time, inputs, direction, outputs, gf->X.Read(), jacobians_of<geom, Q>(*gf), qf,
+        (*qf_state)[geom], elements, num_elements, s.index_seq);
+  };
+}
+
+template <int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type, typename state_type>
+auto batched_evaluation_kernel(signature s, const lambda_type& qf, const GeometricFactors& geometry,
+                               std::shared_ptr<QuadratureData<state_type>> qf_state, const int* elements,
+                               uint32_t num_elements)
+{
+  auto                    trial_elements = trial_elements_tuple<geom>(s);
+  auto                    test_element   = get_test_element<geom>(s);
+  const GeometricFactors* gf             = &geometry;
+  return [=](double time, const std::vector<std::vector<const double*>>& inputs, const std::vector<double*>& outputs) {
+    domain_integral::batched_evaluation_kernel_impl<Q, geom>(trial_elements, test_element, time, inputs, outputs,
+                                                             gf->X.Read(), jacobians_of<geom, Q>(*gf), qf,
+                                                             (*qf_state)[geom], elements, num_elements, s.index_seq);
   };
 }
 
@@ -382,7 +1547,76 @@ std::function<void(const double*, double*)> jacobian_vector_product_kernel(
   return [=](const double* du, double* dr) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives.get(), elements, num_elements);
+    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives->get(), elements, num_elements);
+  };
+}
+
+/**
+ * @brief create the kernels that evaluate a domain integral, and its jacobian-vector products, in the execution space
+ * @a exec, see device_evaluation_kernel_impl()
+ *
+ * @param elements the index in the E-vectors of each element, in the memory of @a exec. It is shared by the kernels,
+ * which keep it alive.
+ * @return the evaluation kernel, and the jacobian-vector product kernel
+ */
+template <ExecutionSpace exec, uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type,
+          typename derivative_type>
+auto device_kernels(signature s, const lambda_type& qf, const GeometricFactors& geometry,
+                    std::shared_ptr<derivative_type> qf_derivatives, std::shared_ptr<ExecArray<int, 1, exec>> elements)
+{
+  auto                    trial_elements = trial_elements_tuple<geom>(s);
+  auto                    test_element   = get_test_element<geom>(s);
+  const GeometricFactors* gf             = &geometry;
+  constexpr bool          on_device      = (exec == ExecutionSpace::GPU);
+
+  auto evaluation = [=](double time, const std::vector<const double*>& inputs, double* outputs, bool) {
+    domain_integral::device_evaluation_kernel_impl<exec, wrt, Q, geom>(
+        trial_elements, test_element, time, inputs, outputs, mfem::Read(gf->X.GetMemory(), gf->X.Size(), on_device),
+        jacobians_of<geom, Q>(*gf, on_device), qf, qf_derivatives->get(), elements->data(),
+        uint32_t(elements->size()), s.index_seq);
+  };
+
+  std::function<void(const double*, double*)> jvp;
+  if constexpr (wrt != NO_DIFFERENTIATION) {
+    jvp = [=](const double* du, double* dr) {
+      using test_space  = typename signature::return_type;
+      using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+      action_of_gradient_kernel<Q, geom, test_space, trial_space, exec>(du, dr, qf_derivatives->get(),
+                                                                        elements->data(), elements->size());
+    };
+  }
+
+  return std::pair{evaluation, jvp};
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(const double*, double*, const ElementRestriction&, const ElementRestriction&)>
+fused_jacobian_vector_product_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements,
+                                     uint32_t num_elements)
+{
+  // the coloring is computed the first time the kernel is called (and again if the test space restriction changes)
+  auto coloring = std::make_shared<ElementColoring>();
+  return [=](const double* du, double* dr, const ElementRestriction& trial, const ElementRestriction& test) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    if (coloring->test_ids != test.gather_ids.data()) {
+      coloring->test_ids = test.gather_ids.data();
+      coloring->colors   = test.ColorElements(elements, num_elements);
+    }
+    fused_action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives->get(), elements, trial,
+                                                                      test, *coloring);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(const double*, double*)> vector_jacobian_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+{
+  return [=](const double* dr, double* du) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    action_of_gradient_transpose_kernel<Q, geom, test_space, trial_space>(dr, du, qf_derivatives->get(), elements,
+                                                                          num_elements);
   };
 }
 
@@ -393,7 +1627,19 @@ std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradi
   return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
     using test_space  = typename signature::return_type;
     using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
-    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives.get(), elements, num_elements);
+    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives->get(), elements, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(double*)> element_diagonal_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     const int* elements, uint32_t num_elements)
+{
+  return [=](double* diagonal_E) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    element_diagonal_kernel<geom, test_space, trial_space, Q>(diagonal_E, qf_derivatives->get(), elements,
+                                                              num_elements);
   };
 }
 
@@ -1,7 +1,14 @@
 #include "serac/numerics/functional/element_restriction.hpp"
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
 #include "mfem.hpp"
 
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/functional/geometry.hpp"
 
 std::vector<std::vector<int> > lexicographic_permutations(int p)
@@ -59,6 +66,12 @@ std::vector<std::vector<int> > lexicographic_permutations(int p)
     output[mfem::Geometry::Type::CUBE] = native_to_lex;
   }
 
+  // the linear wedge's vertices are already in lexicographic order (the triangle vertices, then the triangle
+  // vertices again at xi[2] == 1), and higher order wedges are not implemented
+  if (p == 1) {
+    output[mfem::Geometry::Type::PRISM] = {0, 1, 2, 3, 4, 5};
+  }
+
   // other geometries are not defined, as they are not currently used
 
   return output;
@@ -236,6 +249,8 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetElementRestriction(const mfem::F
     // mfem returns the H1 dofs in "native" order, so we need
     // to apply the native-to-lexicographic permutation
     if (isH1(*fes)) {
+      SLIC_ERROR_IF(lex_perm[uint32_t(geom)].empty(),
+                    axom::fmt::format("H1 elements of order {} are not supported on this geometry", p));
       for (int k = 0; k < dofs.Size(); k++) {
         elem_dofs.push_back({uint64_t(dofs[lex_perm[uint32_t(geom)][uint32_t(k)]])});
       }
@@ -299,6 +314,9 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
     if (faceinfo.IsInterior() && type == FaceType::BOUNDARY) continue;
     if (faceinfo.IsBoundary() && type == FaceType::INTERIOR) continue;
 
+    // faces shared with another processor only have one local element, so they can't be two-sided
+    if (faceinfo.IsInterior() && !faceinfo.IsLocal() && type == FaceType::INTERIOR) continue;
+
     // mfem doesn't provide this connectivity info for DG spaces directly,
     // so we have to get at it indirectly in several steps:
     if (isDG(*fes)) {
@@ -306,6 +324,14 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
       mfem::Array<int> elem_ids;
       face_to_elem->GetRow(f, elem_ids);
 
+      // 2. for each of those elements, find the local side `i` that is face `f`, and its orientation
+      struct Side {
+        int elem;
+        int i;
+        int orientation;
+      };
+      std::vector<Side> sides;
+
       for (auto elem : elem_ids) {
         // 2a. get the list of faces (and their orientations) that belong to that element ...
         mfem::Array<int> elem_side_ids, orientations;
@@ -331,12 +357,6 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
           if (elem_side_ids[i] == f) break;
         }
 
-        // 3. get the dofs for the entire element
-        mfem::Array<int> elem_dof_ids;
-        fes->GetElementDofs(elem, elem_dof_ids);
-
-        mfem::Geometry::Type elem_geom = mesh->GetElementGeometry(elem);
-
         // mfem uses different conventions for boundary element orientations in 2D and 3D.
         // In 2D, mfem's official edge orientations on the boundary will always be a mix of
         // CW and CCW, so we have to discard mfem's orientation information in order
@@ -345,15 +365,31 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
         // In 3D, mfem does use a consistently CCW winding for boundary faces (I think).
         int orientation = (mesh->Dimension() == 2 && type == FaceType::BOUNDARY) ? 0 : orientations[i];
 
-        // 4. extract only the dofs that correspond to side `i`
-        for (auto k : face_perm(orientation)) {
-          face_dofs.push_back(uint64_t(elem_dof_ids[local_face_dofs[uint32_t(elem_geom)](i, k)]));
-        }
+        sides.push_back(Side{elem, i, orientation});
 
         // boundary faces only belong to 1 element, so we exit early
         if (type == FaceType::BOUNDARY) break;
       }
 
+      // the element that traverses the face's vertices in order (orientation 0) is the one that the face normal
+      // points out of, so it goes first: interior faces store their traces as [side 1, side 2], with the normal
+      // pointing from side 1 into side 2
+      std::stable_sort(sides.begin(), sides.end(),
+                       [](const Side& a, const Side& b) { return (a.orientation == 0) > (b.orientation == 0); });
+
+      for (const auto& side : sides) {
+        // 3. get the dofs for the entire element
+        mfem::Array<int> elem_dof_ids;
+        fes->GetElementDofs(side.elem, elem_dof_ids);
+
+        mfem::Geometry::Type elem_geom = mesh->GetElementGeometry(side.elem);
+
+        // 4. extract only the dofs that correspond to side `i`
+        for (auto k : face_perm(side.orientation)) {
+          face_dofs.push_back(uint64_t(elem_dof_ids[local_face_dofs[uint32_t(elem_geom)](side.i, k)]));
+        }
+      }
+
       // H1 and Hcurl spaces are more straight-forward, since
       // we can use FiniteElementSpace::GetFaceDofs() directly
     } else {
@@ -389,6 +425,17 @@ axom::Array<DoF, 2, axom::MemorySpace::Host> GetFaceDofs(const mfem::FiniteEleme
 
 namespace serac {
 
+namespace {
+
+/// the method of every ElementRestriction's scatter-adds, see setScatterMethod()
+ScatterMethod scatter_method = ScatterMethod::OwnerComputes;
+
+}  // namespace
+
+void setScatterMethod(ScatterMethod method) { scatter_method = method; }
+
+ScatterMethod scatterMethod() { return scatter_method; }
+
 ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type elem_geom)
 {
   dof_info = GetElementRestriction(fes, elem_geom);
@@ -401,6 +448,10 @@ ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem
   num_elements   = uint64_t(dof_info.shape()[0]);
   nodes_per_elem = uint64_t(dof_info.shape()[1]);
   esize          = num_elements * nodes_per_elem * components;
+
+  ComputeGatherIndices();
+  LabelSharedElements(fes);
+  ComputeTranspose();
 }
 
 ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem::Geometry::Type face_geom,
@@ -416,6 +467,10 @@ ElementRestriction::ElementRestriction(const mfem::FiniteElementSpace* fes, mfem
   num_elements   = uint64_t(dof_info.shape()[0]);
   nodes_per_elem = uint64_t(dof_info.shape()[1]);
   esize          = num_elements * nodes_per_elem * components;
+
+  ComputeGatherIndices();
+  LabelSharedElements(fes);
+  ComputeTranspose();
 }
 
 uint64_t ElementRestriction::ESize() const { return esize; }
@@ -440,30 +495,277 @@ void ElementRestriction::GetElementVDofs(int i, std::vector<DoF>& vdofs) const
   }
 }
 
-void ElementRestriction::Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector) const
+void ElementRestriction::ComputeGatherIndices()
 {
+  gather_ids.resize(esize);
   for (uint64_t i = 0; i < num_elements; i++) {
     for (uint64_t c = 0; c < components; c++) {
       for (uint64_t j = 0; j < nodes_per_elem; j++) {
-        uint64_t E_id       = (i * components + c) * nodes_per_elem + j;
-        uint64_t L_id       = GetVDof(dof_info(i, j), c).index();
-        E_vector[int(E_id)] = L_vector[int(L_id)];
+        uint64_t E_id    = (i * components + c) * nodes_per_elem + j;
+        gather_ids[E_id] = int(GetVDof(dof_info(i, j), c).index());
       }
     }
   }
 }
 
-void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const
+void ElementRestriction::LabelSharedElements(const mfem::FiniteElementSpace* fes)
 {
+  shared_elements.clear();
+  interior_elements.clear();
+
+  // the ldofs in groups other than 0 (the group of just this rank) are the ones shared with other ranks
+  std::vector<bool> is_shared(lsize, false);
+  if (auto pfes = dynamic_cast<const mfem::ParFiniteElementSpace*>(fes)) {
+    const mfem::Table& group_ldof = pfes->GroupComm().GroupLDofTable();
+    for (int g = 1; g < group_ldof.Size(); g++) {
+      for (int k = 0; k < group_ldof.RowSize(g); k++) {
+        is_shared[uint64_t(group_ldof.GetRow(g)[k])] = true;
+      }
+    }
+  }
+
+  uint64_t values_per_elem = nodes_per_elem * components;
   for (uint64_t i = 0; i < num_elements; i++) {
-    for (uint64_t c = 0; c < components; c++) {
-      for (uint64_t j = 0; j < nodes_per_elem; j++) {
-        uint64_t E_id = (i * components + c) * nodes_per_elem + j;
-        uint64_t L_id = GetVDof(dof_info(i, j), c).index();
-        L_vector[int(L_id)] += E_vector[int(E_id)];
+    bool shared = false;
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      shared = shared || is_shared[uint64_t(gather_ids[k])];
+    }
+    (shared ? shared_elements : interior_elements).push_back(i);
+  }
+}
+
+void ElementRestriction::ComputeTranspose()
+{
+  is_shared.assign(num_elements, 0);
+  for (uint64_t i : shared_elements) {
+    is_shared[i] = 1;
+  }
+
+  // counting the slots of each dof, and then filling them in E-vector order, leaves each dof's slots sorted
+  transpose.offsets.assign(lsize + 1, 0);
+  for (uint64_t k = 0; k < esize; k++) {
+    transpose.offsets[uint64_t(gather_ids[k]) + 1]++;
+  }
+  std::partial_sum(transpose.offsets.begin(), transpose.offsets.end(), transpose.offsets.begin());
+
+  transpose.slots.resize(esize);
+  std::vector<uint64_t> position(transpose.offsets.begin(), transpose.offsets.end() - 1);
+  for (uint64_t k = 0; k < esize; k++) {
+    transpose.slots[position[uint64_t(gather_ids[k])]++] = k;
+  }
+}
+
+void ElementRestriction::Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector) const
+{
+  const double* L   = L_vector.HostRead();
+  double*       E   = E_vector.HostWrite();
+  const int*    ids = gather_ids.data();
+
+  // each element writes only to its own entries of the E-vector, so the gather can be threaded
+  uint64_t values_per_elem = nodes_per_elem * components;
+  serac::accelerator::forall_host(num_elements, [=](uint64_t i) {
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      E[k] = L[ids[k]];
+    }
+  });
+}
+
+void ElementRestriction::FirstTouch(mfem::Vector& E_vector) const
+{
+  double* E = E_vector.HostWrite();
+
+  uint64_t values_per_elem = nodes_per_elem * components;
+  serac::accelerator::forall_host(num_elements, [=](uint64_t i) {
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      E[k] = 0.0;
+    }
+  });
+}
+
+void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const
+{
+  const double* E   = E_vector.HostRead();
+  double*       L   = L_vector.HostReadWrite();
+  const int*    ids = gather_ids.data();
+
+  if (scatter_method == ScatterMethod::OwnerComputes) {
+    const uint64_t* offsets = transpose.offsets.data();
+    const uint64_t* slots   = transpose.slots.data();
+
+    // each dof sums its own slots, in the same order as the serial loop below
+    serac::accelerator::forall_host(lsize, [=](uint64_t d) {
+      double sum = L[d];
+      for (uint64_t j = offsets[d]; j < offsets[d + 1]; j++) {
+        sum += E[slots[j]];
       }
+      L[d] = sum;
+    });
+    return;
+  }
+
+  // note: neighboring elements share dofs, so this loop is left serial to avoid write conflicts in the L-vector
+  for (uint64_t k = 0; k < esize; k++) {
+    L[ids[k]] += E[k];
+  }
+}
+
+void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector, ElementSubset subset) const
+{
+  if (subset == ElementSubset::All) {
+    ScatterAdd(E_vector, L_vector);
+    return;
+  }
+
+  if (scatter_method == ScatterMethod::OwnerComputes) {
+    ScatterAddSlots(E_vector.HostRead(), L_vector.HostReadWrite(), is_shared.data(),
+                    uint8_t(subset == ElementSubset::Shared));
+    return;
+  }
+
+  ScatterAdd(E_vector, L_vector, (subset == ElementSubset::Shared) ? shared_elements : interior_elements);
+}
+
+void ElementRestriction::Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector,
+                                const std::vector<uint64_t>& elements) const
+{
+  const double*   L    = L_vector.HostRead();
+  double*         E    = E_vector.HostReadWrite();
+  const int*      ids  = gather_ids.data();
+  const uint64_t* list = elements.data();
+
+  uint64_t values_per_elem = nodes_per_elem * components;
+  serac::accelerator::forall_host(elements.size(), [=](std::size_t e) {
+    uint64_t i = list[e];
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      E[k] = L[ids[k]];
+    }
+  });
+}
+
+void ElementRestriction::ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector,
+                                    const std::vector<uint64_t>& elements) const
+{
+  const double* E   = E_vector.HostRead();
+  double*       L   = L_vector.HostReadWrite();
+  const int*    ids = gather_ids.data();
+
+  if (scatter_method == ScatterMethod::OwnerComputes &&
+      elements.size() * uint64_t(serac::accelerator::numHostThreads()) >= num_elements) {
+    std::vector<uint8_t> selected(num_elements, 0);
+    for (uint64_t i : elements) {
+      selected[i] = 1;
+    }
+    ScatterAddSlots(E, L, selected.data(), 1);
+    return;
+  }
+
+  // note: neighboring elements share dofs, so this loop is left serial to avoid write conflicts in the L-vector
+  uint64_t values_per_elem = nodes_per_elem * components;
+  for (uint64_t i : elements) {
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      L[ids[k]] += E[k];
+    }
+  }
+}
+
+void ElementRestriction::ScatterAddSlots(const double* E, double* L, const uint8_t* labels, uint8_t label) const
+{
+  const uint64_t* offsets         = transpose.offsets.data();
+  const uint64_t* slots           = transpose.slots.data();
+  uint64_t        values_per_elem = nodes_per_elem * components;
+  serac::accelerator::forall_host(lsize, [=](uint64_t d) {
+    double sum = L[d];
+    for (uint64_t j = offsets[d]; j < offsets[d + 1]; j++) {
+      if (labels[slots[j] / values_per_elem] == label) {
+        sum += E[slots[j]];
+      }
+    }
+    L[d] = sum;
+  });
+}
+
+void ElementRestriction::GatherElements(const double* L, double* E, const int* elements, uint32_t n) const
+{
+  const int* ids = gather_ids.data();
+
+  uint64_t values_per_elem = nodes_per_elem * components;
+  serac::accelerator::forall_host(n, [=](uint32_t e) {
+    const int* element_ids = ids + uint64_t(elements[e]) * values_per_elem;
+    for (uint64_t k = 0; k < values_per_elem; k++) {
+      E[e * values_per_elem + k] = L[element_ids[k]];
+    }
+  });
+}
+
+void ElementRestriction::ScatterAddElements(const double* E, double* L, const int* elements, uint32_t n) const
+{
+  const int* ids = gather_ids.data();
+
+  // note: neighboring elements share dofs, so this loop is left serial to avoid write conflicts in the L-vector
+  uint64_t values_per_elem = nodes_per_elem * components;
+  for (uint32_t e = 0; e < n; e++) {
+    const int* element_ids = ids + uint64_t(elements[e]) * values_per_elem;
+    for (uint64_t k = 0; k < values_per_elem; k++) {
+      L[element_ids[k]] += E[e * values_per_elem + k];
+    }
+  }
+}
+
+std::vector<std::vector<uint32_t>> ElementRestriction::ColorElements(const int* elements, uint32_t n) const
+{
+  uint64_t values_per_elem = nodes_per_elem * components;
+
+  // the elements (positions in `elements`) that touch each dof, as a compressed sparse row array
+  std::vector<uint32_t> offsets(lsize + 1, 0);
+  for (uint32_t e = 0; e < n; e++) {
+    uint64_t i = uint64_t(elements[e]);
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      offsets[uint64_t(gather_ids[k]) + 1]++;
+    }
+  }
+  for (uint64_t d = 0; d < lsize; d++) {
+    offsets[d + 1] += offsets[d];
+  }
+
+  std::vector<uint32_t> neighbors(offsets.back());
+  std::vector<uint32_t> count(lsize, 0);
+  for (uint32_t e = 0; e < n; e++) {
+    uint64_t i = uint64_t(elements[e]);
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      uint64_t d                       = uint64_t(gather_ids[k]);
+      neighbors[offsets[d] + count[d]] = e;
+      count[d]++;
+    }
+  }
+
+  // greedily give each element the first color not already taken by an element it shares a dof with
+  std::vector<uint32_t>              color(n, std::numeric_limits<uint32_t>::max());
+  std::vector<uint32_t>              taken_by;
+  std::vector<std::vector<uint32_t>> colors;
+  for (uint32_t e = 0; e < n; e++) {
+    uint64_t i = uint64_t(elements[e]);
+    for (uint64_t k = i * values_per_elem; k < (i + 1) * values_per_elem; k++) {
+      uint64_t d = uint64_t(gather_ids[k]);
+      for (uint32_t j = offsets[d]; j < offsets[d + 1]; j++) {
+        if (color[neighbors[j]] < taken_by.size()) {
+          taken_by[color[neighbors[j]]] = e;
+        }
+      }
+    }
+
+    uint32_t c = 0;
+    while (c < taken_by.size() && taken_by[c] == e) {
+      c++;
     }
+    if (c == taken_by.size()) {
+      taken_by.push_back(n);
+      colors.emplace_back();
+    }
+    color[e] = c;
+    colors[c].push_back(e);
   }
+
+  return colors;
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -479,7 +781,7 @@ BlockElementRestriction::BlockElementRestriction(const mfem::FiniteElementSpace*
   }
 
   if (dim == 3) {
-    for (auto geom : {mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE}) {
+    for (auto geom : {mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM}) {
       restrictions[geom] = ElementRestriction(fes, geom);
     }
   }
@@ -508,31 +810,104 @@ mfem::Array<int> BlockElementRestriction::bOffsets() const
 {
   mfem::Array<int> offsets(mfem::Geometry::NUM_GEOMETRIES + 1);
 
-  offsets[0] = 0;
+  // the element indices are 64-bit, but mfem::BlockVector's offsets (and the sizes of mfem::Vectors) are not
+  uint64_t total = 0;
+  offsets[0]     = 0;
   for (int i = 0; i < mfem::Geometry::NUM_GEOMETRIES; i++) {
     auto g = mfem::Geometry::Type(i);
     if (restrictions.count(g) > 0) {
-      offsets[g + 1] = offsets[g] + int(restrictions.at(g).ESize());
-    } else {
-      offsets[g + 1] = offsets[g];
+      total += restrictions.at(g).ESize();
     }
-    // std::cout << g << " " << offsets[g+1] << std::endl;
+    SLIC_ERROR_IF(total > uint64_t(std::numeric_limits<int>::max()),
+                  axom::fmt::format("The E-vector has {} values, which is more than an mfem::Vector can hold", total));
+    offsets[g + 1] = int(total);
   }
   return offsets;
 };
 
 void BlockElementRestriction::Gather(const mfem::Vector& L_vector, mfem::BlockVector& E_block_vector) const
 {
-  for (auto [geom, restriction] : restrictions) {
+  SERAC_MARK_FUNCTION;
+  for (const auto& [geom, restriction] : restrictions) {
     restriction.Gather(L_vector, E_block_vector.GetBlock(geom));
   }
 }
 
 void BlockElementRestriction::ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector) const
 {
-  for (auto [geom, restriction] : restrictions) {
+  SERAC_MARK_FUNCTION;
+  for (const auto& [geom, restriction] : restrictions) {
     restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector);
   }
 }
 
+void BlockElementRestriction::FirstTouch(mfem::BlockVector& E_block_vector) const
+{
+  for (const auto& [geom, restriction] : restrictions) {
+    restriction.FirstTouch(E_block_vector.GetBlock(geom));
+  }
+}
+
+ElementSelection BlockElementRestriction::Select(const std::map<mfem::Geometry::Type, std::vector<int>>& elements) const
+{
+  ElementSelection selection;
+  for (const auto& [geom, restriction] : restrictions) {
+    if (elements.count(geom) == 0) continue;
+
+    std::vector<uint64_t> selected(elements.at(geom).begin(), elements.at(geom).end());
+    std::sort(selected.begin(), selected.end());
+    selected.erase(std::unique(selected.begin(), selected.end()), selected.end());
+
+    if (selected.size() == restriction.num_elements) {
+      selection.complete.insert(geom);
+      continue;
+    }
+
+    for (uint64_t i : selected) {
+      bool shared = std::binary_search(restriction.shared_elements.begin(), restriction.shared_elements.end(), i);
+      (shared ? selection.shared[geom] : selection.interior[geom]).push_back(i);
+    }
+    selection.elements[geom] = std::move(selected);
+  }
+  return selection;
+}
+
+void BlockElementRestriction::Gather(const mfem::Vector& L_vector, mfem::BlockVector& E_block_vector,
+                                     const ElementSelection& selection) const
+{
+  SERAC_MARK_FUNCTION;
+  for (const auto& [geom, restriction] : restrictions) {
+    if (selection.complete.count(geom) > 0) {
+      restriction.Gather(L_vector, E_block_vector.GetBlock(geom));
+    } else if (selection.elements.count(geom) > 0) {
+      restriction.Gather(L_vector, E_block_vector.GetBlock(geom), selection.elements.at(geom));
+    }
+  }
+}
+
+void BlockElementRestriction::ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector,
+                                         const ElementSelection& selection, ElementSubset subset) const
+{
+  SERAC_MARK_FUNCTION;
+  const auto& selected = (subset == ElementSubset::All)      ? selection.elements
+                         : (subset == ElementSubset::Shared) ? selection.shared
+                                                             : selection.interior;
+  for (const auto& [geom, restriction] : restrictions) {
+    if (selection.complete.count(geom) > 0) {
+      restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector, subset);
+    } else if (selected.count(geom) > 0) {
+      restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector, selected.at(geom));
+    }
+  }
+}
+
+void BlockElementRestriction::ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector,
+                                         ElementSubset subset) const
+{
+  SERAC_MARK_FUNCTION;
+  for (const auto& [geom, restriction] : restrictions) {
+    restriction.ScatterAdd(E_block_vector.GetBlock(geom), L_vector, subset);
+  }
+}
+
 }  // namespace serac
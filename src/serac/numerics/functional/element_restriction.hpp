@@ -1,5 +1,7 @@
 #pragma once
 
+#include <map>
+#include <set>
 #include <vector>
 
 #include "mfem.hpp"
@@ -27,6 +29,21 @@ enum class FaceType
   INTERIOR
 };
 
+/// which elements an ElementRestriction operation should be applied to
+enum class ElementSubset
+{
+  All,       ///< every element
+  Shared,    ///< only the elements that touch a dof shared with another rank
+  Interior   ///< only the elements that don't touch any dofs shared with another rank
+};
+
+/// how an ElementRestriction scatter-adds the contributions of the elements that share a dof into an L-vector
+enum class ScatterMethod
+{
+  Serial,        ///< element by element, on a single thread
+  OwnerComputes  ///< dof by dof, with the threads of forall_host(), each summing its slots of the transposed map
+};
+
 /// a struct of metadata (index, sign, orientation) associated with a degree of freedom
 struct DoF {
   // sam: I wanted to use a bitfield for this type, but a 10+ year-old GCC bug
@@ -141,6 +158,31 @@ struct Array2D {
 
 namespace serac {
 
+/**
+ * @brief choose how the scatter-adds of every ElementRestriction are computed from now on
+ *
+ * Both methods are deterministic, and add the contributions to each dof in the same (element) order, so their
+ * results are bitwise identical (for lists of elements, as long as the list is sorted). Short lists of elements are
+ * always scatter-added serially, see ElementRestriction::ScatterAdd().
+ */
+void setScatterMethod(ScatterMethod method);
+
+/// @brief how scatter-adds are computed, see setScatterMethod()
+ScatterMethod scatterMethod();
+
+/**
+ * @brief the transpose of an ElementRestriction: the (element, local node) slots of the E-vector that contribute to
+ * each L-vector dof, as a compressed sparse row array
+ */
+struct ScatterMap {
+  /// the slots of dof `d` are `slots[offsets[d]]`, ..., `slots[offsets[d + 1] - 1]`
+  std::vector<uint64_t> offsets;
+
+  /// the E-vector indices of the slots (so the element of slot `k` is `k / (nodes_per_elem * components)`), in
+  /// increasing order for each dof
+  std::vector<uint64_t> slots;
+};
+
 /// a more complete version of mfem::ElementRestriction that works with {H1, Hcurl, L2} spaces (including on the
 /// boundary)
 struct ElementRestriction {
@@ -176,6 +218,53 @@ struct ElementRestriction {
   /// "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the "L-vector"
   void ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector) const;
 
+  /**
+   * @brief zero a newly allocated E-vector an element at a time, with the same threads (see forall_host()) that
+   * gather into it and evaluate its elements later
+   *
+   * @note the memory of the E-vector is placed on the NUMA nodes of the threads that first write to it
+   */
+  void FirstTouch(mfem::Vector& E_vector) const;
+
+  /// @overload that only scatter-adds the contributions from the specified subset of elements
+  void ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector, ElementSubset subset) const;
+
+  /// @overload that only gathers the values of the listed elements, into their usual places in the E-vector
+  void Gather(const mfem::Vector& L_vector, mfem::Vector& E_vector, const std::vector<uint64_t>& elements) const;
+
+  /**
+   * @overload that only scatter-adds the contributions from the listed elements
+   *
+   * @note with ScatterMethod::OwnerComputes, lists of at least `num_elements / numHostThreads()` elements are
+   * scatter-added with the transposed restriction, which visits the slots of every element. Shorter lists are
+   * scatter-added serially.
+   */
+  void ScatterAdd(const mfem::Vector& E_vector, mfem::Vector& L_vector, const std::vector<uint64_t>& elements) const;
+
+  /**
+   * @brief gather the values of a list of elements, which are stored consecutively in @a E
+   *
+   * @param L the L-vector values
+   * @param E (output) the values of each element in the list, in order
+   * @param elements the indices of the elements
+   * @param n the number of elements in the list
+   */
+  void GatherElements(const double* L, double* E, const int* elements, uint32_t n) const;
+
+  /// @brief scatter-add the values of a list of elements, stored consecutively in @a E, see GatherElements()
+  void ScatterAddElements(const double* E, double* L, const int* elements, uint32_t n) const;
+
+  /**
+   * @brief group a list of elements into "colors", so that no two elements of the same color share a dof
+   *
+   * @param elements the indices of the elements to color
+   * @param n the number of elements in the list
+   * @return the positions (in `elements`) of the elements of each color
+   *
+   * @note the elements of each color can scatter-add their contributions directly into an L-vector concurrently
+   */
+  std::vector<std::vector<uint32_t>> ColorElements(const int* elements, uint32_t n) const;
+
   /// the size of the "E-vector"
   uint64_t esize;
 
@@ -199,6 +288,58 @@ struct ElementRestriction {
 
   /// whether the underlying dofs are arranged "byNodes" or "byVDim"
   mfem::Ordering::Type ordering;
+
+  /**
+   * @brief the L-vector index of each entry of the E-vector (i.e. `dof_info` with the components expanded and the
+   * sign/orientation information stripped), so that Gather() and ScatterAdd() are just indexed copies
+   */
+  std::vector<int> gather_ids;
+
+  /**
+   * @brief the elements that touch at least one dof shared with another rank (i.e. whose
+   * contributions take part in the parallel reduction), in increasing order
+   */
+  std::vector<uint64_t> shared_elements;
+
+  /// the elements that only touch dofs that aren't shared with other ranks, in increasing order
+  std::vector<uint64_t> interior_elements;
+
+  /// whether each element is one of the `shared_elements`
+  std::vector<uint8_t> is_shared;
+
+  /// the transposed restriction, with which the scatter-adds of ScatterMethod::OwnerComputes are computed
+  ScatterMap transpose;
+
+private:
+  /// populate `gather_ids` from `dof_info`
+  void ComputeGatherIndices();
+
+  /// populate `shared_elements` and `interior_elements` (every element is interior for serial spaces)
+  void LabelSharedElements(const mfem::FiniteElementSpace* fes);
+
+  /// populate `transpose` and `is_shared` from `gather_ids` and `shared_elements`
+  void ComputeTranspose();
+
+  /// scatter-add the slots of the elements whose entry in @a labels is @a label, with the transposed restriction
+  void ScatterAddSlots(const double* E, double* L, const uint8_t* labels, uint8_t label) const;
+};
+
+/**
+ * @brief the elements of each geometry of a BlockElementRestriction that some integrals are evaluated on, so that
+ * their gathers and scatter-adds can skip the other elements, see BlockElementRestriction::Select()
+ */
+struct ElementSelection {
+  /// the geometries whose elements are all selected, which use the operations on every element instead
+  std::set<mfem::Geometry::Type> complete;
+
+  /// the selected elements of each of the other geometries, in increasing order
+  std::map<mfem::Geometry::Type, std::vector<uint64_t>> elements;
+
+  /// the selected elements of each of the other geometries that touch a dof shared with another rank
+  std::map<mfem::Geometry::Type, std::vector<uint64_t>> shared;
+
+  /// the selected elements of each of the other geometries that don't touch any dofs shared with another rank
+  std::map<mfem::Geometry::Type, std::vector<uint64_t>> interior;
 };
 
 /**
@@ -231,6 +372,30 @@ struct BlockElementRestriction {
   /// "E->L" in mfem parlance, each element scatter-adds its local vector into the appropriate place in the "L-vector"
   void ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector) const;
 
+  /// @brief zero a newly allocated E-vector an element at a time, see ElementRestriction::FirstTouch()
+  void FirstTouch(mfem::BlockVector& E_block_vector) const;
+
+  /**
+   * @brief select the elements of each geometry that some integrals are evaluated on, see ElementSelection
+   *
+   * @param elements the elements of each geometry (e.g. those of the domains of the integrals), which may be listed
+   * more than once. Geometries that aren't listed have no selected elements.
+   *
+   * @note the selected elements are split into shared and interior ones with the dofs of this restriction, but the
+   * selection can also be used with other restrictions of the same elements when that split isn't needed
+   */
+  ElementSelection Select(const std::map<mfem::Geometry::Type, std::vector<int>>& elements) const;
+
+  /// @overload that only gathers the values of the selected elements, see Select()
+  void Gather(const mfem::Vector& L_vector, mfem::BlockVector& E_block_vector, const ElementSelection& selection) const;
+
+  /// @overload that only scatter-adds the contributions from the selected elements (of the given subset), see Select()
+  void ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector, const ElementSelection& selection,
+                  ElementSubset subset = ElementSubset::All) const;
+
+  /// @overload that only scatter-adds the contributions from the specified subset of elements
+  void ScatterAdd(const mfem::BlockVector& E_block_vector, mfem::Vector& L_vector, ElementSubset subset) const;
+
   /// the individual ElementRestriction operators for each element geometry
   std::map<mfem::Geometry::Type, ElementRestriction> restrictions;
 };
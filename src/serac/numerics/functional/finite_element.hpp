@@ -82,6 +82,13 @@ struct batched_jacobian<mfem::Geometry::TETRAHEDRON, q> {
   using type = tensor<double, 3, 3, (q * (q + 1) * (q + 2)) / 6>;
 };
 
+/// @overload
+template <int q>
+struct batched_jacobian<mfem::Geometry::PRISM, q> {
+  /// the data layout for this geometry and quadrature rule
+  using type = tensor<double, 3, 3, (q * (q + 1)) / 2 * q>;
+};
+
 /**
  * @brief this struct is used to look up mfem's memory layout of the
  * quadrature point position vectors
@@ -120,6 +127,13 @@ struct batched_position<mfem::Geometry::TETRAHEDRON, q> {
   using type = tensor<double, 3, (q * (q + 1) * (q + 2)) / 6>;
 };
 
+/// @overload
+template <int q>
+struct batched_position<mfem::Geometry::PRISM, q> {
+  /// the data layout for this geometry and quadrature rule
+  using type = tensor<double, 3, (q * (q + 1)) / 2 * q>;
+};
+
 /// @overload
 template <int q>
 struct batched_position<mfem::Geometry::SEGMENT, q> {
@@ -367,6 +381,37 @@ struct finite_element;
 #include "detail/hexahedron_Hcurl.inl"
 #include "detail/hexahedron_L2.inl"
 
+#include "detail/wedge_H1.inl"
+
 #include "detail/qoi.inl"
 
+/**
+ * @brief true if finite_element<g, space> is implemented, e.g. wedges only have linear H1 elements
+ * @tparam g the element geometry
+ * @tparam space the function space, e.g. H1<1, 3>
+ */
+template <mfem::Geometry::Type g, typename space, typename = void>
+struct has_finite_element : std::false_type {
+};
+
+/// @overload
+template <mfem::Geometry::Type g, typename space>
+struct has_finite_element<g, space, std::void_t<decltype(finite_element<g, space>::ndof)>> : std::true_type {
+};
+
+/**
+ * @brief true if the test space and every trial space of an integrand's signature have elements of geometry g
+ * @tparam g the element geometry
+ * @tparam signature the function signature test(trials...)
+ */
+template <mfem::Geometry::Type g, typename signature>
+struct supports_geometry;
+
+/// @overload
+template <mfem::Geometry::Type g, typename test, typename... trials>
+struct supports_geometry<g, test(trials...)> {
+  /// whether kernels can be generated for elements of geometry g
+  static constexpr bool value = has_finite_element<g, test>::value && (has_finite_element<g, trials>::value && ...);
+};
+
 }  // namespace serac
@@ -1,10 +1,80 @@
 #pragma once
+#include <type_traits>
 #include <camp/camp.hpp>
 #include "serac/numerics/functional/finite_element.hpp"
 
 template <typename T>
 struct FunctionSignature;
 
+/**
+ * @brief whether or not a q-function reads its i-th trial argument
+ *
+ * By default, every argument is assumed to be read. A q-function type can declare arguments that it never reads
+ * (e.g. an acceleration that is only passed along for dynamic problems) by implementing
+ * `static constexpr bool reads_argument(int i)`. Those arguments are not interpolated, and the q-function
+ * is given zero values for them instead.
+ */
+template <typename qfunction_type, int i, typename = void>
+struct qfunction_reads_argument : std::true_type {};
+
+/// @overload
+template <typename qfunction_type, int i>
+struct qfunction_reads_argument<qfunction_type, i, std::void_t<decltype(qfunction_type::reads_argument(i))>>
+    : std::integral_constant<bool, qfunction_type::reads_argument(i)> {};
+
+/**
+ * @brief whether or not the derivatives of a q-function w.r.t. its i-th trial argument are symmetric
+ *
+ * By default, the derivatives are assumed to have no structure. A q-function type whose linearization is
+ * self-adjoint w.r.t. some of its arguments (e.g. the tangent of a hyperelastic material w.r.t. the displacement)
+ * can declare so by implementing `static constexpr bool symmetric_derivative(int i)`. When the i-th trial space
+ * is also the test space, only the upper triangles of the d(source)/d(value) and d(flux)/d(gradient) blocks are
+ * stored, see SymmetricDerivative.
+ */
+template <typename qfunction_type, int i, typename = void>
+struct qfunction_has_symmetric_derivative : std::false_type {};
+
+/// @overload
+template <typename qfunction_type, int i>
+struct qfunction_has_symmetric_derivative<qfunction_type, i,
+                                          std::void_t<decltype(qfunction_type::symmetric_derivative(i))>>
+    : std::integral_constant<bool, qfunction_type::symmetric_derivative(i)> {};
+
+/**
+ * @brief whether or not the derivatives of a q-function w.r.t. its i-th trial argument can be stored in single
+ * precision
+ *
+ * By default, the derivatives are stored in double precision. A q-function type whose gradient is only used
+ * approximately (e.g. in the Krylov iterations of an inexact Newton method) can halve the memory and bandwidth of its
+ * gradient actions by implementing `static constexpr bool single_precision_derivative(int i)`, see
+ * SinglePrecisionDerivative.
+ */
+template <typename qfunction_type, int i, typename = void>
+struct qfunction_has_single_precision_derivative : std::false_type {};
+
+/// @overload
+template <typename qfunction_type, int i>
+struct qfunction_has_single_precision_derivative<
+    qfunction_type, i, std::void_t<decltype(qfunction_type::single_precision_derivative(i))>>
+    : std::integral_constant<bool, qfunction_type::single_precision_derivative(i)> {};
+
+/**
+ * @brief whether or not a q-function with quadrature data is evaluated on all of an element's quadrature points at once
+ *
+ * By default, q-functions are evaluated one quadrature point at a time. A q-function type can opt in to batched
+ * evaluation by declaring `static constexpr bool batched = true;`, in which case it must also implement
+ * `batch(t, positions, states, inputs...)`, where each argument after the time is a tensor with one entry per
+ * quadrature point, and return a tensor of the q-function outputs at each quadrature point. This lets expensive
+ * per-point work that only some points need (e.g. return maps) be gathered and done together.
+ */
+template <typename qfunction_type, typename = void>
+struct qfunction_is_batched : std::false_type {};
+
+/// @overload
+template <typename qfunction_type>
+struct qfunction_is_batched<qfunction_type, std::void_t<decltype(qfunction_type::batched)>>
+    : std::integral_constant<bool, qfunction_type::batched> {};
+
 /**
  * @brief a type that encodes information about a function signature (return type, input types)
  * @tparam output_type the function signature's return type
@@ -15,6 +15,8 @@
 #include "mfem.hpp"
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/quadrature.hpp"
 #include "serac/numerics/functional/finite_element.hpp"
@@ -23,10 +25,21 @@
 #include "serac/numerics/functional/differentiate_wrt.hpp"
 
 #include "serac/numerics/functional/element_restriction.hpp"
+#include "serac/numerics/functional/split_prolongation.hpp"
+#include "serac/numerics/functional/shared_setup.hpp"
 
 #include "serac/numerics/functional/domain.hpp"
 
+#include <algorithm>
 #include <array>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <set>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace serac {
@@ -35,6 +48,22 @@ template <int... i>
 struct DependsOn {
 };
 
+/**
+ * @brief Compile-time tag that overrides the number of quadrature points per dimension used by one integral
+ * of a Functional, e.g. to integrate a small region more accurately than the rest of the domain
+ * @tparam q the number of quadrature points per dimension (1 through 4)
+ */
+template <int q>
+struct QuadratureOrder {
+};
+
+/// @brief the ways a (mass) matrix can be approximated by a diagonal one, see Functional::Gradient::lumpedDiagonal()
+enum class LumpingMethod
+{
+  RowSum,  ///< each diagonal entry is the sum of its row
+  HRZ      ///< the consistent diagonal, scaled to preserve the total (Hinton, Rock and Zienkiewicz)
+};
+
 /**
  * @brief given a list of types, this function returns the index that corresponds to the type `dual_vector`.
  *
@@ -69,6 +98,26 @@ struct Index {
   constexpr operator int() { return ind; }
 };
 
+/**
+ * @brief the integrand of a separable load, f(x) g(t): the user's integrand f is multiplied by a value of the time
+ * function g that is set before each evaluation, see Functional::AddSeparableDomainIntegral()
+ */
+template <typename lambda>
+struct TimeScaledIntegrand {
+  /// @brief the integrand f, which must not depend on the time
+  lambda integrand;
+
+  /// @brief the value of g(t) at the time of the current evaluation
+  std::shared_ptr<const double> scale;
+
+  /// @brief the integrand f, times g(t)
+  template <typename... T>
+  SERAC_HOST_DEVICE auto operator()(double t, T... args) const
+  {
+    return (*scale) * integrand(t, args...);
+  }
+};
+
 /// function for verifying that the mesh has been fully initialized
 inline void check_for_missing_nodal_gridfunc(const mfem::Mesh& mesh)
 {
@@ -87,13 +136,13 @@ inline void check_for_missing_nodal_gridfunc(const mfem::Mesh& mesh)
   }
 }
 
-/// function for verifying that there are no unsupported element types in the mesh
+/// function for verifying that there are no unsupported element types in the mesh (wedges are checked per-integral)
 inline void check_for_unsupported_elements(const mfem::Mesh& mesh)
 {
   int num_elements = mesh.GetNE();
   for (int e = 0; e < num_elements; e++) {
     auto type = mesh.GetElementType(e);
-    if (type == mfem::Element::POINT || type == mfem::Element::WEDGE || type == mfem::Element::PYRAMID) {
+    if (type == mfem::Element::POINT || type == mfem::Element::PYRAMID) {
       SLIC_ERROR_ROOT("Mesh contains unsupported element type");
     }
   }
@@ -105,15 +154,17 @@ inline void check_for_unsupported_elements(const mfem::Mesh& mesh)
  *
  * @tparam function_space a tag type containing the kind of function space and polynomial order
  * @param mesh the mesh on which the space is defined
+ * @param ordering how the components of a vector-valued space are laid out: all of the values of each component in
+ * turn (byNODES), or the components of each node together (byVDIM, which e.g. gives hypre's nodal AMG the block
+ * structure of each node)
  * @return a pair containing the new finite element space and associated finite element collection
  */
 template <typename function_space>
 inline std::pair<std::unique_ptr<mfem::ParFiniteElementSpace>, std::unique_ptr<mfem::FiniteElementCollection>>
-generateParFiniteElementSpace(mfem::ParMesh* mesh)
+generateParFiniteElementSpace(mfem::ParMesh* mesh, mfem::Ordering::Type ordering = mfem::Ordering::byNODES)
 {
   const int                                      dim = mesh->Dimension();
   std::unique_ptr<mfem::FiniteElementCollection> fec;
-  const auto                                     ordering = mfem::Ordering::byNODES;
 
   switch (function_space::family) {
     case Family::H1:
@@ -140,6 +191,75 @@ generateParFiniteElementSpace(mfem::ParMesh* mesh)
   return std::pair(std::move(fes), std::move(fec));
 }
 
+/// @brief return whether or not two parallel matrices have the same distribution and sparsity pattern
+inline bool haveSameSparsity(const mfem::HypreParMatrix& A, const mfem::HypreParMatrix& B)
+{
+  hypre_ParCSRMatrix* a = A;
+  hypre_ParCSRMatrix* b = B;
+  if (A.Height() != B.Height() || A.Width() != B.Width() ||
+      hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(a)) != hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(b))) {
+    return false;
+  }
+
+  auto num_cols_offd = hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(a));
+  if (!std::equal(hypre_ParCSRMatrixColMapOffd(a), hypre_ParCSRMatrixColMapOffd(a) + num_cols_offd,
+                  hypre_ParCSRMatrixColMapOffd(b))) {
+    return false;
+  }
+
+  for (auto [x, y] : {std::pair{hypre_ParCSRMatrixDiag(a), hypre_ParCSRMatrixDiag(b)},
+                      std::pair{hypre_ParCSRMatrixOffd(a), hypre_ParCSRMatrixOffd(b)}}) {
+    auto rows = hypre_CSRMatrixNumRows(x);
+    auto nnz  = hypre_CSRMatrixNumNonzeros(x);
+    if (rows != hypre_CSRMatrixNumRows(y) || nnz != hypre_CSRMatrixNumNonzeros(y) ||
+        !std::equal(hypre_CSRMatrixI(x), hypre_CSRMatrixI(x) + rows + 1, hypre_CSRMatrixI(y)) ||
+        !std::equal(hypre_CSRMatrixJ(x), hypre_CSRMatrixJ(x) + nnz, hypre_CSRMatrixJ(y))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief overwrite the values of a parallel matrix with those of a newly assembled one
+ *
+ * @param[inout] K the matrix to overwrite. If K is empty, or K_new has a different sparsity pattern,
+ * K is replaced by K_new instead
+ * @param[in] K_new the newly assembled matrix
+ *
+ * @return true if K's storage was preserved (so K still points to the same matrix object)
+ */
+inline bool refillOrReplace(std::unique_ptr<mfem::HypreParMatrix>& K, std::unique_ptr<mfem::HypreParMatrix> K_new)
+{
+  if (K && haveSameSparsity(*K, *K_new)) {
+    hypre_ParCSRMatrix* dst = *K;
+    hypre_ParCSRMatrix* src = *K_new;
+    K->HostReadWrite();
+    K_new->HostRead();
+    for (auto [d, s] : {std::pair{hypre_ParCSRMatrixDiag(dst), hypre_ParCSRMatrixDiag(src)},
+                        std::pair{hypre_ParCSRMatrixOffd(dst), hypre_ParCSRMatrixOffd(src)}}) {
+      std::copy_n(hypre_CSRMatrixData(s), hypre_CSRMatrixNumNonzeros(s), hypre_CSRMatrixData(d));
+    }
+    return true;
+  }
+
+  K = std::move(K_new);
+  return false;
+}
+
+/**
+ * @brief The memory type of the L- and E-vector workspaces for kernels that run in a given execution space
+ *
+ * Kernels in the GPU execution space read and write their workspaces on the device, so those live in device memory.
+ * Everything else (including the tiled evaluation path, which only runs on the host) uses host memory.
+ */
+template <ExecutionSpace exec>
+mfem::MemoryType workspace_memory_type()
+{
+  return (exec == ExecutionSpace::GPU) ? mfem::Device::GetMemoryType() : mfem::Device::GetHostMemoryType();
+}
+
 /// @cond
 template <typename T, ExecutionSpace exec = serac::default_execution_space>
 class Functional;
@@ -219,47 +339,66 @@ public:
              std::array<const mfem::ParFiniteElementSpace*, num_trial_spaces> trial_fes)
       : update_qdata_(false), test_space_(test_fes), trial_space_(trial_fes)
   {
-    auto mem_type = mfem::Device::GetMemoryType();
+    auto mem_type = workspace_memory_type<exec>();
 
-    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
       input_E_[type].resize(num_trial_spaces);
     }
 
     for (uint32_t i = 0; i < num_trial_spaces; i++) {
       P_trial_[i] = trial_space_[i]->GetProlongationMatrix();
 
-      input_L_[i].SetSize(P_trial_[i]->Height(), mfem::Device::GetMemoryType());
+      prolongation_[i] = SplitProlongation(trial_space_[i]);
+
+      input_L_[i].SetSize(P_trial_[i]->Height(), mem_type);
 
       // L->E
       for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
         if (type == Domain::Type::Elements) {
-          G_trial_[type][i] = BlockElementRestriction(trial_fes[i]);
+          G_trial_[type][i] = shared_setup::restriction(trial_fes[i]);
         } else {
-          G_trial_[type][i] = BlockElementRestriction(trial_fes[i], FaceType::BOUNDARY);
+          G_trial_[type][i] = shared_setup::restriction(trial_fes[i], FaceType::BOUNDARY);
         }
 
         // note: we have to use "Update" here, as mfem::BlockVector's
         // copy assignment ctor (operator=) doesn't let you make changes
         // to the block size
-        input_E_[type][i].Update(G_trial_[type][i].bOffsets(), mem_type);
+        input_E_[type][i].Update(G_trial_[type][i]->bOffsets(), mem_type);
+        G_trial_[type][i]->FirstTouch(input_E_[type][i]);
       }
+
+      // the two-sided face restrictions are built when the first interior face integral is added
+      G_trial_[Domain::Type::InteriorFaces][i] = shared_setup::empty_restriction();
     }
 
     for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
       if (type == Domain::Type::Elements) {
-        G_test_[type] = BlockElementRestriction(test_fes);
+        G_test_[type] = shared_setup::restriction(test_fes);
       } else {
-        G_test_[type] = BlockElementRestriction(test_fes, FaceType::BOUNDARY);
+        G_test_[type] = shared_setup::restriction(test_fes, FaceType::BOUNDARY);
       }
 
-      output_E_[type].Update(G_test_[type].bOffsets(), mem_type);
+      output_E_[type].Update(G_test_[type]->bOffsets(), mem_type);
+      G_test_[type]->FirstTouch(output_E_[type]);
     }
 
+    G_test_[Domain::Type::InteriorFaces] = shared_setup::empty_restriction();
+
     P_test_ = test_space_->GetProlongationMatrix();
 
+    test_prolongation_ = SplitProlongation(test_space_);
+
+    // the arguments of the tiled evaluations never change, so they are only built once. Those evaluations are the
+    // host path of domain integrals (see Integral::CanTile()), whatever the execution space of the other kernels
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      tiled_input_L_.push_back(&input_L_[i]);
+      tiled_restrictions_.push_back(G_trial_[Domain::Type::Elements][i].get());
+    }
+
     output_L_.SetSize(P_test_->Height(), mem_type);
 
-    output_T_.SetSize(test_fes->GetTrueVSize(), mem_type);
+    // the T-vectors are exchanged with the solvers, so they are allocated where those expect them
+    output_T_.SetSize(test_fes->GetTrueVSize(), mfem::Device::GetMemoryType());
 
     // gradient objects depend on some member variables in
     // Functional, so we initialize the gradient objects last
@@ -283,6 +422,26 @@ public:
   template <int dim, int... args, typename Integrand, typename qpt_data_type = Nothing>
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const Integrand& integrand, mfem::Mesh& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain, qdata);
+  }
+
+  /// @overload
+  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, Domain& domain,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain, qdata);
+  }
+
+  /**
+   * @brief Adds a domain integral term that uses @a q quadrature points per dimension, rather than
+   * the default of max(test::order, trials::order...) + 1
+   * @note any quadrature data must be sized for num_quadrature_points(geom, q) points per element
+   */
+  template <int dim, int... args, int q, typename Integrand, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const Integrand& integrand,
+                         mfem::Mesh& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.GetNE() == 0) return;
 
@@ -292,14 +451,14 @@ public:
     check_for_missing_nodal_gridfunc(domain);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(EntireDomain(domain), integrand, qdata, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeDomainIntegral<signature, q, dim, exec>(EntireDomain(domain), integrand, qdata,
+                                                                     std::vector<uint32_t>{args...}));
   }
 
   /// @overload
-  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
-  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, Domain& domain,
-                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                         Domain& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.mesh_.GetNE() == 0) return;
 
@@ -310,7 +469,7 @@ public:
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
     integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+        MakeDomainIntegral<signature, q, dim, exec>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -324,6 +483,17 @@ public:
    */
   template <int dim, int... args, typename Integrand>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const Integrand& integrand, mfem::Mesh& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain);
+  }
+
+  /**
+   * @brief Adds a boundary integral term that uses @a q quadrature points per dimension, rather than
+   * the default of max(test::order, trials::order...) + 1
+   */
+  template <int dim, int... args, int q, typename Integrand>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const Integrand& integrand,
+                           mfem::Mesh& domain)
   {
     auto num_bdr_elements = domain.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -331,13 +501,21 @@ public:
     check_for_missing_nodal_gridfunc(domain);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeBoundaryIntegral<signature, Q, dim>(EntireBoundary(domain), integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeBoundaryIntegral<signature, q, dim, exec>(EntireBoundary(domain), integrand,
+                                                                       std::vector<uint32_t>{args...}));
   }
 
   /// @overload
   template <int dim, int... args, typename lambda>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, const Domain& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain);
+  }
+
+  /// @overload
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                           const Domain& domain)
   {
     auto num_bdr_elements = domain.mesh_.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -347,7 +525,112 @@ public:
     check_for_missing_nodal_gridfunc(domain.mesh_);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim>(domain, integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(
+        MakeBoundaryIntegral<signature, q, dim, exec>(domain, integrand, std::vector<uint32_t>{args...}));
+  }
+
+  /**
+   * @brief Adds a separable load f(x) g(t) over a domain, e.g. a body force with a fixed distribution that is ramped
+   * up in time
+   *
+   * The values of such a load don't change between evaluations while the arguments it depends on are frozen (see
+   * freezeArgument(), e.g. the shape displacement and parameters during a solve), so it is only integrated once, with
+   * g = 1, and that L-vector is then scaled by g(t) in every evaluation. Otherwise, it is integrated as usual with
+   * f(x) g(t) as its integrand.
+   *
+   * @param[in] integrand f, a domain integrand as in AddDomainIntegral(), which must not depend on the time
+   * @param[in] time_scale g, the time function of the load
+   * @param[in] domain The domain on which to evaluate the integral
+   *
+   * @note the load is integrated again after the arguments it depends on change, or the mesh moves (updateGeometry())
+   */
+  template <int dim, int... args, typename lambda>
+  void AddSeparableDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand,
+                                  std::function<double(double)> time_scale, Domain& domain)
+  {
+    auto        scale         = std::make_shared<double>(1.0);
+    std::size_t num_integrals = integrals_.size();
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, TimeScaledIntegrand<lambda>{integrand, scale}, domain);
+    if (integrals_.size() > num_integrals) {
+      integrals_.back().MakeSeparable(std::move(time_scale), scale);
+    }
+  }
+
+  /**
+   * @brief Adds a separable load f(x) g(t) over a boundary, e.g. a traction with a fixed distribution that is ramped
+   * up in time, see AddSeparableDomainIntegral()
+   *
+   * @param[in] integrand f, a boundary integrand as in AddBoundaryIntegral(), which must not depend on the time
+   * @param[in] time_scale g, the time function of the load
+   * @param[in] domain The domain on which to evaluate the integral
+   */
+  template <int dim, int... args, typename lambda>
+  void AddSeparableBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand,
+                                    std::function<double(double)> time_scale, const Domain& domain)
+  {
+    auto        scale         = std::make_shared<double>(1.0);
+    std::size_t num_integrals = integrals_.size();
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, TimeScaledIntegrand<lambda>{integrand, scale},
+                        domain);
+    if (integrals_.size() > num_integrals) {
+      integrals_.back().MakeSeparable(std::move(time_scale), scale);
+    }
+  }
+
+  /**
+   * @brief Adds an integral over the interior faces of a mesh, e.g. the jump and penalty terms of a discontinuous
+   * Galerkin method
+   *
+   * @tparam dim The dimension of the faces
+   * @tparam args The indices of the trial spaces the integral depends on
+   * @param[in] integrand The quadrature function, called as `integrand(t, tuple{x, J}, tuple{u1, u2}...)`, which
+   * returns tuple{r1, r2}: the sources for the test functions of each side of the face. Side 1 is the element that
+   * the face normal (computed from J) points out of.
+   * @param[in] domain The interior faces to evaluate the integral on
+   *
+   * @note the test and trial spaces must be L2, and faces shared with other ranks are not included
+   */
+  template <int dim, int... args, typename lambda>
+  void AddInteriorFaceIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, const Domain& domain)
+  {
+    AddInteriorFaceIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain);
+  }
+
+  /// @overload
+  template <int dim, int... args, int q, typename lambda>
+  void AddInteriorFaceIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                               const Domain& domain)
+  {
+    SLIC_ERROR_ROOT_IF(dim != domain.dim_, "invalid domain of integration for interior face integral");
+    SLIC_ERROR_ROOT_IF(domain.type_ != Domain::Type::InteriorFaces,
+                       "interior face integrals must be evaluated over a domain of interior faces");
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      SLIC_ERROR_ROOT_IF(lookup_tables_[i] != nullptr,
+                         "interior face integrals must be added before the gradient is first assembled");
+    }
+
+    check_for_missing_nodal_gridfunc(domain.mesh_);
+
+    // the two-sided face restrictions are only built for Functionals that need them
+    if (G_test_[Domain::Type::InteriorFaces]->restrictions.empty()) {
+      auto mem_type = workspace_memory_type<exec>();
+      for (uint32_t i = 0; i < num_trial_spaces; i++) {
+        auto& G_trial = G_trial_[Domain::Type::InteriorFaces][i];
+        G_trial       = shared_setup::restriction(trial_space_[i], FaceType::INTERIOR);
+        input_E_[Domain::Type::InteriorFaces][i].Update(G_trial->bOffsets(), mem_type);
+        G_trial->FirstTouch(input_E_[Domain::Type::InteriorFaces][i]);
+        gathered_[Domain::Type::InteriorFaces][i] = false;
+      }
+
+      G_test_[Domain::Type::InteriorFaces] = shared_setup::restriction(test_space_, FaceType::INTERIOR);
+      output_E_[Domain::Type::InteriorFaces].Update(G_test_[Domain::Type::InteriorFaces]->bOffsets(), mem_type);
+      G_test_[Domain::Type::InteriorFaces]->FirstTouch(output_E_[Domain::Type::InteriorFaces]);
+    }
+
+    using signature = test(decltype(serac::type<args>(trial_spaces))...);
+    integrals_.push_back(
+        MakeInteriorFaceIntegral<signature, q, dim, exec>(domain, integrand, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -402,7 +685,10 @@ public:
    */
   void ActionOfGradient(const mfem::Vector& input_T, mfem::Vector& output_T, uint32_t which) const
   {
-    P_trial_[which]->Mult(input_T, input_L_[which]);
+    SERAC_MARK_FUNCTION;
+    prolongation_[which].Begin(input_T, input_L_[which]);
+    prolongation_[which].Finish();
+    invalidateInputs(which);
 
     output_L_ = 0.0;
 
@@ -411,69 +697,148 @@ public:
     bool already_computed[Domain::num_types]{};  // default initializes to `false`
 
     for (auto& integral : integrals_) {
-      auto type = integral.domain_.type_;
+      auto type      = integral.domain_.type_;
+      bool recompute = recompute_derivatives_ && integral.CanRecomputeGradient();
+
+      // domain integrals gather from and scatter-add to the L-vectors directly, so they don't need the E-vectors
+      if (!recompute && integral.CanFuseGradient()) {
+        integral.GradientMult(input_L_[which], output_L_, which, *G_trial_[type][which], *G_test_[type]);
+        continue;
+      }
 
       if (!already_computed[type]) {
-        G_trial_[type][which].Gather(input_L_[which], input_E_[type][which]);
+        allocateElementVectors(type);
+        G_trial_[type][which]->Gather(input_L_[which], input_E_[type][which], selection(type));
+        output_E_[type]        = 0.0;
         already_computed[type] = true;
       }
 
-      integral.GradientMult(input_E_[type][which], output_E_[type], which);
+      // each integral accumulates its contributions into the E-vector for its kind of domain
+      if (recompute) {
+        integral.RecomputedGradientMult(linearization_time_, linearization_E_, input_E_[type][which], output_E_[type],
+                                        which);
+      } else {
+        integral.GradientMult(input_E_[type][which], output_E_[type], which);
+      }
+    }
 
-      // scatter-add to compute residuals on the local processor
-      G_test_[type].ScatterAdd(output_E_[type], output_L_);
+    // scatter-add to compute residuals on the local processor (once per kind of domain, rather than once per integral)
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      if (already_computed[type]) {
+        G_test_[type]->ScatterAdd(output_E_[type], output_L_, selection(type));
+      }
     }
 
     // scatter-add to compute global residuals
-    P_test_->MultTranspose(output_L_, output_T);
+    test_prolongation_.FinishTranspose(output_L_, output_T);
   }
 
   /**
-   * @brief this function lets the user evaluate the serac::Functional with the given trial space values
+   * @brief this function computes the action of the transpose of the gradient of `serac::Functional::operator()`,
+   * i.e. the vector-jacobian product used by adjoint and sensitivity calculations, without assembling the gradient
    *
-   * note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
-   * arguments may be a dual_vector, to indicate that Functional::operator() should not only evaluate the
-   * element calculations, but also differentiate them w.r.t. the specified dual_vector argument
+   * @param input_T the T-vector (in the test space) to apply the transpose of the gradient to
+   * @param output_T the T-vector (in trial space `which`) where the resulting values are stored
+   * @param which describes which trial space the gradient is taken with respect to
    *
-   * @tparam T the types of the arguments passed in
-   * @param t the time
-   * @param args the trial space dofs used to carry out the calculation,
-   *  at most one of which may be of the type `differentiate_wrt_this(mfem::Vector)`
+   * @note the q-function derivatives must already have been computed (i.e. by evaluating the Functional with
+   * `differentiate_wrt()` on that argument)
    */
-  template <uint32_t wrt, typename... T>
-  typename operator_paren_return<wrt>::type operator()(DifferentiateWRT<wrt>, double t, const T&... args)
+  void ActionOfGradientTranspose(const mfem::Vector& input_T, mfem::Vector& output_T, uint32_t which) const
   {
-    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+    SERAC_MARK_FUNCTION;
+    SLIC_ERROR_ROOT_IF(recompute_derivatives_, "Transposed gradients require stored q-function derivatives");
 
-    // get the values for each local processor
-    for (uint32_t i = 0; i < num_trial_spaces; i++) {
-      P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+    test_prolongation_.Begin(input_T, output_L_);
+    test_prolongation_.Finish();
+
+    input_L_[which] = 0.0;
+    invalidateInputs(which);
+
+    // this is used to mark when gather operations have been performed,
+    // to avoid doing them more than once per kind of domain
+    bool already_computed[Domain::num_types]{};  // default initializes to `false`
+
+    for (auto& integral : integrals_) {
+      auto type = integral.domain_.type_;
+
+      if (!already_computed[type]) {
+        allocateElementVectors(type);
+        G_test_[type]->Gather(output_L_, output_E_[type], selection(type));
+        input_E_[type][which]  = 0.0;
+        already_computed[type] = true;
+      }
+
+      // each integral accumulates its contributions into the trial space E-vector for its kind of domain
+      integral.GradientMultTranspose(output_E_[type], input_E_[type][which], which);
     }
 
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      if (already_computed[type]) {
+        G_trial_[type][which]->ScatterAdd(input_E_[type][which], input_L_[which], selection(type));
+      }
+    }
+
+    prolongation_[which].FinishTranspose(input_L_[which], output_T);
+  }
+
+  /**
+   * @brief compute the diagonal of the gradient, without assembling the sparse matrix
+   *
+   * @param[out] output_T The diagonal entries, one for each true dof of the test space
+   * @param[in] which describes which trial space the gradient is taken with respect to
+   *
+   * @note the trial space `which` must be the same as the test space, and the q-function
+   * derivatives must already have been computed (i.e. by evaluating the Functional with
+   * `differentiate_wrt()` on that argument)
+   */
+  void AssembleGradientDiagonal(mfem::Vector& output_T, uint32_t which) const
+  {
+    SERAC_MARK_FUNCTION;
+    SLIC_ERROR_ROOT_IF(recompute_derivatives_, "Gradient diagonals require stored q-function derivatives");
+
     output_L_ = 0.0;
 
-    // this is used to mark when operations have been performed,
-    // to avoid doing them more than once
-    bool already_computed[Domain::num_types][num_trial_spaces]{};  // default initializes to `false`
+    bool has_output[Domain::num_types]{};  // default initializes to `false`
+
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      allocateElementVectors(type);
+      output_E_[type] = 0.0;
+    }
 
     for (auto& integral : integrals_) {
       auto type = integral.domain_.type_;
+      integral.ComputeElementDiagonal(output_E_[type], which);
+      has_output[type] = true;
+    }
 
-      for (auto i : integral.active_trial_spaces_) {
-        if (!already_computed[type][i]) {
-          G_trial_[type][i].Gather(input_L_[i], input_E_[type][i]);
-          already_computed[type][i] = true;
-        }
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      if (has_output[type]) {
+        G_test_[type]->ScatterAdd(output_E_[type], output_L_, selection(type));
       }
+    }
 
-      integral.Mult(t, input_E_[type], output_E_[type], wrt, update_qdata_);
+    test_prolongation_.FinishTranspose(output_L_, output_T);
+  }
 
-      // scatter-add to compute residuals on the local processor
-      G_test_[type].ScatterAdd(output_E_[type], output_L_);
-    }
+  /**
+   * @brief this function lets the user evaluate the serac::Functional with the given trial space values
+   *
+   * note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
+   * arguments may be a dual_vector, to indicate that Functional::operator() should not only evaluate the
+   * element calculations, but also differentiate them w.r.t. the specified dual_vector argument
+   *
+   * @tparam T the types of the arguments passed in
+   * @param t the time
+   * @param args the trial space dofs used to carry out the calculation,
+   *  at most one of which may be of the type `differentiate_wrt_this(mfem::Vector)`
+   */
+  template <uint32_t wrt, typename... T>
+  typename operator_paren_return<wrt>::type operator()(DifferentiateWRT<wrt>, double t, const T&... args)
+  {
+    SERAC_MARK_FUNCTION;
 
-    // scatter-add to compute global residuals
-    P_test_->MultTranspose(output_L_, output_T_);
+    evaluate(DifferentiateWRT<wrt>{}, output_T_, t, args...);
 
     if constexpr (wrt != NO_DIFFERENTIATION) {
       // if the user has indicated they'd like to evaluate and differentiate w.r.t.
@@ -510,166 +875,1849 @@ public:
   }
 
   /**
-   * @brief A flag to update the quadrature data for this operator following the computation
+   * @brief evaluate the Functional, writing the result directly into @a output_T rather than into
+   * the vector that operator() returns a reference to
    *
-   * Typically this is set to false during nonlinear solution iterations and is set to true for the
-   * final pass once equilibrium is found.
+   * This avoids copying the result when the caller owns the destination, e.g. the residual vector of a nonlinear
+   * solver. No derivatives are computed.
    *
-   * @param update_flag A flag to update the related quadrature data
+   * @param output_T the true dof values of the result, which must already have the size of the test space
+   * @param t the time
+   * @param args the trial space dofs used to carry out the calculation
    */
-  void updateQdata(bool update_flag) { update_qdata_ = update_flag; }
+  template <typename... T>
+  void evaluateInto(mfem::Vector& output_T, double t, const T&... args)
+  {
+    static_assert((std::is_same_v<T, differentiate_wrt_this> + ...) == 0,
+                  "Error: Functional::evaluateInto() does not compute derivatives");
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::evaluateInto() must take exactly as many arguments as trial spaces");
 
-private:
-  /// @brief flag for denoting when a residual evaluation should update the material state buffers
-  bool update_qdata_;
+    SERAC_MARK_FUNCTION;
+
+    SLIC_ERROR_IF(output_T.Size() != output_T_.Size(), "Functional::evaluateInto(): output vector has the wrong size");
+
+    evaluate(DifferentiateWRT<NO_DIFFERENTIATION>{}, output_T, t, args...);
+  }
 
   /**
-   * @brief mfem::Operator representing the gradient matrix that
-   * can compute the action of the gradient (with operator()),
-   * or assemble the sparse matrix representation through implicit conversion to mfem::HypreParMatrix *
+   * @brief evaluate the Functional for several sets of arguments in one pass over the mesh
+   *
+   * Each argument is either an mfem::DenseMatrix, whose columns are that argument's trial space dofs for each
+   * evaluation, or an mfem::Vector that is shared by every evaluation. The geometric factors of each element are
+   * loaded once for all of the evaluations, and the shared arguments are only restricted to the elements once.
+   *
+   * e.g. the residuals of several perturbed displacements, at a fixed parameter:
+   * @code{.cpp}
+   * mfem::DenseMatrix displacements(U.Size(), 4);  // one displacement per column
+   * const mfem::DenseMatrix& residuals = residual.EvaluateBatch(t, displacements, parameter);
+   * @endcode
+   *
+   * @param t the time
+   * @param args the trial space dofs used to carry out the calculation
+   * @return the values of the Functional, one column for each column of the arguments
+   *
+   * @note no derivatives are computed, and the quadrature point data is not updated
    */
-  class Gradient : public mfem::Operator {
-  public:
-    /**
-     * @brief Constructs a Gradient wrapper that references a parent @p Functional
-     * @param[in] f The @p Functional to use for gradient calculations
-     */
-    Gradient(Functional<test(trials...), exec>& f, uint32_t which = 0)
-        : mfem::Operator(f.test_space_->GetTrueVSize(), f.trial_space_[which]->GetTrueVSize()),
-          form_(f),
-          lookup_tables(f.G_test_[Domain::Type::Elements], f.G_trial_[Domain::Type::Elements][which]),
-          which_argument(which),
-          test_space_(f.test_space_),
-          trial_space_(f.trial_space_[which]),
-          df_(f.test_space_->GetTrueVSize())
-    {
-    }
+  template <typename... T>
+  const mfem::DenseMatrix& EvaluateBatch(double t, const T&... args)
+  {
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::EvaluateBatch() must take exactly as many arguments as trial spaces");
+    static_assert(((std::is_same_v<T, mfem::DenseMatrix> || std::is_base_of_v<mfem::Vector, T>)&&...),
+                  "Error: Functional::EvaluateBatch() only takes mfem::DenseMatrix and mfem::Vector arguments");
 
-    /**
-     * @brief implement that action of the gradient: df := df_dx * dx
-     * @param[in] dx a small perturbation in the trial space
-     * @param[in] df the resulting small perturbation in the residuals
-     */
-    virtual void Mult(const mfem::Vector& dx, mfem::Vector& df) const override
-    {
-      form_.ActionOfGradient(dx, df, which_argument);
+    auto block_of = [](const auto& arg) -> const mfem::DenseMatrix* {
+      if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, mfem::DenseMatrix>) {
+        return &arg;
+      } else {
+        return nullptr;
+      }
+    };
+    auto vector_of = [](const auto& arg) -> const mfem::Vector* {
+      if constexpr (std::is_same_v<std::decay_t<decltype(arg)>, mfem::DenseMatrix>) {
+        return nullptr;
+      } else {
+        return &static_cast<const mfem::Vector&>(arg);
+      }
+    };
+    const mfem::DenseMatrix* blocks[]  = {block_of(args)...};
+    const mfem::Vector*      vectors[] = {vector_of(args)...};
+
+    int num_vectors = 1;
+    for (auto* block : blocks) {
+      if (block) {
+        num_vectors = block->Width();
+        break;
+      }
     }
 
-    /// @brief syntactic sugar:  df_dx.Mult(dx, df)  <=>  mfem::Vector df = df_dx(dx);
-    mfem::Vector& operator()(const mfem::Vector& dx)
-    {
-      form_.ActionOfGradient(dx, df_, which_argument);
-      return df_;
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      if (blocks[i]) {
+        SLIC_ERROR_ROOT_IF(blocks[i]->Width() != num_vectors,
+                           "Error: the arguments of Functional::EvaluateBatch() must have the same number of columns");
+        SLIC_ERROR_ROOT_IF(blocks[i]->Height() != P_trial_[i]->Width(),
+                           "Error: Functional::EvaluateBatch() arguments must have a true dof vector in each column");
+      }
     }
 
-    /// @brief assemble element matrices and form an mfem::HypreParMatrix
-    std::unique_ptr<mfem::HypreParMatrix> assemble()
-    {
-      // the CSR graph (sparsity pattern) is reusable, so we cache
-      // that and ask mfem to not free that memory in ~SparseMatrix()
-      constexpr bool sparse_matrix_frees_graph_ptrs = false;
-
-      // the CSR values are NOT reusable, so we pass ownership of
-      // them to the mfem::SparseMatrix, to be freed in ~SparseMatrix()
-      constexpr bool sparse_matrix_frees_values_ptr = true;
-
-      constexpr bool col_ind_is_sorted = true;
+    auto mem_type = workspace_memory_type<exec>();
 
-      double* values = new double[lookup_tables.nnz]{};
+    // which trial spaces are used on each kind of domain, and which kinds of domain have integrals
+    bool needed[Domain::num_types][num_trial_spaces]{};
+    bool has_output[Domain::num_types]{};
+    for (auto& integral : integrals_) {
+      for (auto i : integral.active_trial_spaces_) {
+        needed[integral.domain_.type_][i] = true;
+      }
+      has_output[integral.domain_.type_] = true;
+    }
+
+    // the E-vectors of each argument: one for each column, or just one for the arguments shared by every column
+    std::vector<mfem::BlockVector> batch_input_E[Domain::num_types][num_trial_spaces];
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      invalidateInputs(i);
+
+      int num_columns = blocks[i] ? num_vectors : 1;
+      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+        batch_input_E[type][i].reserve(std::size_t(num_columns));
+      }
+
+      for (int c = 0; c < num_columns; c++) {
+        if (blocks[i]) {
+          mfem::Vector column(const_cast<double*>(blocks[i]->GetColumn(c)), blocks[i]->Height());
+          prolongation_[i].Begin(column, input_L_[i]);
+        } else {
+          prolongation_[i].Begin(*vectors[i], input_L_[i]);
+        }
+        prolongation_[i].Finish();
+
+        for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+          if (needed[type][i]) {
+            batch_input_E[type][i].emplace_back(G_trial_[type][i]->bOffsets(), mem_type);
+            G_trial_[type][i]->Gather(input_L_[i], batch_input_E[type][i].back());
+          }
+        }
+      }
+    }
+
+    std::vector<mfem::BlockVector> batch_output_E[Domain::num_types];
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      if (has_output[type]) {
+        batch_output_E[type].reserve(std::size_t(num_vectors));
+        for (int c = 0; c < num_vectors; c++) {
+          batch_output_E[type].emplace_back(G_test_[type]->bOffsets(), mem_type);
+          batch_output_E[type].back() = 0.0;
+        }
+      }
+    }
+
+    for (auto& integral : integrals_) {
+      auto type = integral.domain_.type_;
+
+      if (integral.IsSeparable()) {
+        integral.SetTime(t);
+      }
+
+      std::vector<std::vector<const mfem::BlockVector*>> inputs(std::size_t(num_vectors));
+      for (std::size_t c = 0; c < inputs.size(); c++) {
+        inputs[c].resize(num_trial_spaces, nullptr);
+        for (auto i : integral.active_trial_spaces_) {
+          inputs[c][i] = &batch_input_E[type][i][blocks[i] ? c : 0];
+        }
+      }
+
+      integral.BatchMult(t, inputs, batch_output_E[type]);
+    }
+
+    batch_output_T_.SetSize(output_T_.Size(), num_vectors);
+    for (int c = 0; c < num_vectors; c++) {
+      output_L_ = 0.0;
+      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+        if (has_output[type]) {
+          G_test_[type]->ScatterAdd(batch_output_E[type][std::size_t(c)], output_L_);
+        }
+      }
+
+      mfem::Vector column(batch_output_T_.GetColumn(c), batch_output_T_.Height());
+      test_prolongation_.FinishTranspose(output_L_, column);
+    }
+
+    return batch_output_T_;
+  }
+
+  /**
+   * @brief A flag to update the quadrature data for this operator following the computation
+   *
+   * Typically this is set to false during nonlinear solution iterations and is set to true for the
+   * final pass once equilibrium is found.
+   *
+   * @param update_flag A flag to update the related quadrature data
+   */
+  void updateQdata(bool update_flag) { update_qdata_ = update_flag; }
+
+  /**
+   * @brief choose whether the gradients of the domain integrals re-evaluate their q-functions in every action,
+   * instead of storing the q-function derivatives at each quadrature point
+   *
+   * When enabled, differentiating the Functional only keeps a copy of its inputs (E-vectors), and each action of
+   * the gradient evaluates the q-functions at those inputs with dual numbers seeded by the direction. This trades
+   * flops for memory (and memory bandwidth). Gradients computed this way can't be assembled into sparse matrices,
+   * and are always taken about the most recent evaluation with differentiation.
+   *
+   * @param recompute whether to re-evaluate the q-functions in the action of the gradient
+   */
+  void recomputeDerivatives(bool recompute) { recompute_derivatives_ = recompute; }
+
+  /**
+   * @brief choose whether the kernels of different integrals and element geometries run concurrently
+   *
+   * Normally, each integral evaluates its element geometries one after another, and the integrals run in the order
+   * they were added, with the threads (see accelerator::forall_host()) dividing up the elements of each kernel. When
+   * enabled, the kernels that write to different blocks of the E-vectors (e.g. a material model on the elements and
+   * a traction on the boundary, or the hexahedra and the wedges of a mixed mesh) instead run as concurrent tasks, see
+   * accelerator::forall_tasks(). This helps when the domains are each too small to keep all of the threads busy.
+   *
+   * @param concurrent whether the kernels of different integrals and geometries run concurrently
+   *
+   * @note domain integrals that are evaluated a tile at a time (see setElementTileSize()) still run one after another
+   */
+  void concurrentIntegrals(bool concurrent) { concurrent_integrals_ = concurrent; }
+
+  /**
+   * @brief evaluate the domain integrals a tile of elements at a time
+   *
+   * Each tile of elements is gathered, evaluated and scatter-added before moving on to the next one, so the element
+   * values of the domain integrals only take up tile-sized E-vectors (which can stay in cache), rather than ones for
+   * the whole mesh. The E-vectors of the whole mesh are released, and only allocated again by the operations that
+   * still need them: ActionOfGradientTranspose(), AssembleGradientDiagonal(), and gradients that recompute the
+   * q-function derivatives (see recomputeDerivatives()). The action of the gradient of a domain integral doesn't
+   * use E-vectors either way.
+   *
+   * @param tile_size the number of elements in each tile, or 0 to evaluate each domain integral in one pass
+   *
+   * @note the q-function values of frozen arguments aren't cached in the tiled evaluations, see
+   * cacheFrozenArguments()
+   */
+  void setElementTileSize(uint32_t tile_size)
+  {
+    tile_size_          = tile_size;
+    autotune_tile_size_ = false;
+    if (tile_size_ > 0) {
+      releaseElementVectors();
+    }
+  }
+
+  /**
+   * @brief evaluate the domain integrals a tile of elements at a time, like setElementTileSize(), with the number of
+   * elements in each tile chosen separately for each kernel (element geometry, spaces, quadrature rule and q-function)
+   *
+   * The first evaluations of each kernel time a few different tile sizes, and the rest use the fastest one, see
+   * TileSizeTuner. When @a filename is given, kernels that have been tuned before (by any run that saved into the same
+   * file) start with their saved tile size, and the tile sizes of all the kernels are saved into it once they have
+   * been tuned.
+   *
+   * @param filename the file that the tuned tile sizes are read from and saved into, or empty to tune every run
+   *
+   * @note each rank tunes its own tile sizes, and the ones of rank 0 are saved
+   */
+  void autotuneElementTileSize(const std::string& filename = "")
+  {
+    tile_size_          = 0;
+    autotune_tile_size_ = true;
+    tile_size_file_     = filename;
+    tile_sizes_saved_   = false;
+    releaseElementVectors();
+
+    if (!tile_size_file_.empty()) {
+      auto saved = readTileSizes(tile_size_file_);
+      for (auto& integral : integrals_) {
+        for (auto& [geometry, tuner] : integral.tile_tuners_) {
+          if (saved.count(tuner.key()) > 0) {
+            tuner.settle(saved.at(tuner.key()));
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief choose whether a trial space argument keeps the same value over the following evaluations
+   *
+   * While an argument is frozen, operator() and evaluateInto() reuse its local (L-vector) and element (E-vector)
+   * values from the first evaluation after it was frozen, rather than prolongating and gathering the vector that is
+   * passed in each time. This skips the halo exchange and gathers of inputs that are fixed during e.g. a nonlinear
+   * solve, like the shape displacement or parameters.
+   *
+   * @param which the index of the trial space argument
+   * @param frozen whether the argument's values should be reused
+   *
+   * @note the argument must be unfrozen (or frozen again) before it is evaluated with a different value
+   */
+  void freezeArgument(uint32_t which, bool frozen)
+  {
+    frozen_[which] = frozen;
+    invalidateInputs(which);
+    for (auto& integral : integrals_) {
+      integral.CacheArgument(which, frozen && cache_frozen_arguments_);
+    }
+  }
+
+  /**
+   * @brief choose whether the domain integrals also keep the values of frozen arguments at each quadrature point
+   * (see freezeArgument()), so that they are only interpolated and mapped to the physical elements once
+   *
+   * This saves the interpolation of e.g. the shape displacement and parameters in each evaluation of a nonlinear
+   * solve, at the cost of storing their values and derivatives at every quadrature point.
+   *
+   * @param cache whether to cache the quadrature point values of frozen arguments
+   */
+  void cacheFrozenArguments(bool cache)
+  {
+    cache_frozen_arguments_ = cache;
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      for (auto& integral : integrals_) {
+        integral.CacheArgument(i, frozen_[i] && cache);
+      }
+    }
+  }
+
+  /**
+   * @brief choose how assembled gradients find the nonzero entry of each element matrix entry, e.g. to fall back to
+   * GradientLookup::BinarySearch when the precomputed contributions of every element matrix entry take too much
+   * memory (about 24 bytes per element matrix entry, several times the sparse matrix itself)
+   *
+   * With GradientLookup::BinarySearch, the lookup tables only keep the sparsity pattern, and each assembly finds the
+   * nonzero entry of every element matrix entry by a binary search of the columns of its row, adding them up one
+   * element at a time on a single thread.
+   *
+   * @param lookup the method used by the gradients with respect to every trial argument
+   *
+   * @note lookup tables already built with the other method are released, and rebuilt by the next assembly
+   */
+  void setGradientLookup(GradientLookup lookup)
+  {
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      if (lookup_tables_[i] != nullptr && lookup_tables_[i]->lookup != lookup) {
+        lookup_tables_[i] = nullptr;
+      }
+    }
+    gradient_lookup_ = lookup;
+  }
+
+  /**
+   * @brief free the memory used to store q-function derivatives with respect to a given trial space
+   * @param which the index of the trial space whose derivatives are no longer needed
+   *
+   * @note this memory is allocated again the next time the Functional is differentiated with respect
+   * to that trial space, so gradients obtained before calling this must not be used afterwards
+   */
+  void releaseDerivatives(uint32_t which)
+  {
+    for (auto& integral : integrals_) {
+      integral.ReleaseDerivatives(which);
+    }
+  }
+
+  /**
+   * @brief the gradient with respect to a given trial space, linearized about the arguments of the most recent
+   * evaluation that was differentiated with respect to it
+   * @param which the index of the trial space
+   *
+   * @note this is the same object that the differentiated evaluations return, so a caller that has kept the arguments
+   * of such an evaluation can use its gradient again without re-evaluating the q-functions
+   */
+  Gradient& gradient(uint32_t which) { return grad_[which]; }
+
+  /**
+   * @brief update the integrals after the nodes of the mesh have moved (e.g. for shape optimization or ALE),
+   * instead of building a new Functional
+   *
+   * Only the positions and jacobians of the elements with a node that moved are recomputed. The q-function
+   * derivatives stored by earlier evaluations are not, so the next evaluation should be differentiated
+   * before the gradient is used again.
+   */
+  void updateGeometry()
+  {
+    for (auto& integral : integrals_) {
+      integral.UpdateGeometry(*integral.domain_.mesh_.GetNodes());
+      integral.InvalidateSeparableLoad();
+    }
+  }
+
+  /// @brief the number of integrals added to this Functional, e.g. to index the wave speeds of stableTimestep()
+  std::size_t numIntegrals() const { return integrals_.size(); }
+
+  /**
+   * @brief estimate the critical timestep of explicit time integration, min(h / c) over every element
+   *
+   * The element sizes h come from the jacobians already stored at each quadrature point (see
+   * GeometricFactors::minElementSize()), so this is cheap enough to call every step, and only requires
+   * one reduction across the processors.
+   *
+   * @param wave_speeds the wave speed c of the material in each integral, in the order the integrals were added.
+   * Integrals with no (or a nonpositive) wave speed, e.g. sources or boundary integrals, do not contribute.
+   * @return the estimated critical timestep, or the largest double if no integral contributes
+   */
+  double stableTimestep(const std::vector<double>& wave_speeds) const
+  {
+    double local_dt = std::numeric_limits<double>::max();
+    for (std::size_t i = 0; i < std::min(wave_speeds.size(), integrals_.size()); i++) {
+      const Integral& integral = integrals_[i];
+      if (wave_speeds[i] <= 0.0 || integral.domain_.type_ != Domain::Type::Elements) continue;
+
+      for (const auto& [geom, gf] : integral.geometric_factors_) {
+        local_dt = std::min(local_dt, gf->minElementSize(geom) / wave_speeds[i]);
+      }
+    }
+
+    double dt = local_dt;
+    MPI_Allreduce(&local_dt, &dt, 1, MPI_DOUBLE, MPI_MIN, test_space_->GetComm());
+    return dt;
+  }
+
+  /**
+   * @brief start or stop timing the evaluation of each element in the domain integrals, see elementCosts()
+   *
+   * @param enable whether to time the elements from now on. The times recorded so far are discarded either way.
+   */
+  void recordElementCosts(bool enable)
+  {
+    for (auto& integral : integrals_) {
+      integral.RecordElementCosts(enable);
+    }
+  }
+
+  /**
+   * @brief return the total time (in seconds) spent evaluating each element of the mesh since
+   * recordElementCosts() was last called, summed over the domain integrals
+   *
+   * The times include both residual and gradient evaluations, so elements with expensive q-functions
+   * (e.g. plastic return mapping) are more costly than others. They can be used as the element weights of
+   * mesh::rebalance().
+   */
+  mfem::Vector elementCosts() const
+  {
+    const mfem::Mesh& mesh = *test_space_->GetMesh();
+
+    // the integrals number the elements of each geometry in the order they appear in the mesh
+    std::map<mfem::Geometry::Type, std::vector<int> > elements_by_geometry;
+    for (int e = 0; e < mesh.GetNE(); e++) {
+      elements_by_geometry[mesh.GetElementGeometry(e)].push_back(e);
+    }
+
+    mfem::Vector costs(mesh.GetNE());
+    costs = 0.0;
+    for (const auto& integral : integrals_) {
+      for (const auto& [geom, element_costs] : integral.element_costs_) {
+        const std::vector<int>& ids = integral.domain_.get(geom);
+        for (std::size_t i = 0; i < element_costs->size(); i++) {
+          costs[elements_by_geometry[geom][std::size_t(ids[i])]] += (*element_costs)[i];
+        }
+      }
+    }
+    return costs;
+  }
+
+  /**
+   * @brief the number of bytes of memory used by this Functional on this rank, by component
+   *
+   * The components are the positions and jacobians at the quadrature points ("geometric_factors"), the stored
+   * q-function derivatives ("qfunction_derivatives"), the cached quadrature point values of frozen arguments
+   * ("cached_inputs"), the sparsity patterns and lookup tables of the gradients
+   * ("gradient_lookup_tables"), the element and sparse matrices cached by the gradients ("gradient_matrices") and
+   * the element vectors of the inputs and outputs ("element_vectors"). Quadrature data is owned by the caller,
+   * see QuadratureData::bytes(). Geometric factors and lookup tables shared with other Functionals (see
+   * shared_setup) are counted by each of them.
+   */
+  memory::Usage memoryUsage() const
+  {
+    memory::Usage usage;
+
+    // integrals on the same elements may share their geometric factors
+    std::set<const GeometricFactors*> geometric_factors;
+    for (const auto& integral : integrals_) {
+      for (const auto& [geom, gf] : integral.geometric_factors_) {
+        if (geometric_factors.insert(gf.get()).second) {
+          usage["geometric_factors"] += gf->bytes();
+        }
+      }
+      usage["qfunction_derivatives"] += integral.DerivativeBytes();
+      usage["cached_inputs"] += integral.CachedInputBytes();
+    }
+
+    // the lookup tables may be shared by several trial arguments
+    std::set<const GradientAssemblyLookupTables*> lookup_tables;
+    for (const auto& tables : lookup_tables_) {
+      if (tables && lookup_tables.insert(tables.get()).second) {
+        usage["gradient_lookup_tables"] += tables->bytes();
+      }
+    }
+
+    for (const auto& gradient : grad_) {
+      usage["gradient_matrices"] += gradient.bytes();
+    }
+
+    std::size_t element_vectors = 0;
+    for (uint32_t type = 0; type < Domain::num_types; type++) {
+      for (const auto& input : input_E_[type]) {
+        element_vectors += memory::bytes(input);
+      }
+      element_vectors += memory::bytes(output_E_[type]);
+    }
+    for (const auto& input : linearization_E_) {
+      element_vectors += memory::bytes(input);
+    }
+    usage["element_vectors"] = element_vectors;
+
+    return usage;
+  }
+
+  /**
+   * @brief the number of bytes of memory this Functional will use on this rank by component (see memoryUsage()), once
+   * its gradient w.r.t. argument @a wrt has been evaluated and assembled, without allocating any of it
+   *
+   * The q-function derivatives are sized exactly, and so is the sparsity pattern of the gradient (see
+   * GradientAssemblyLookupTables::plan()). The sparse matrix held by hypre is estimated from its number of nonzero
+   * entries, and the matrix returned to the caller by assemble() isn't counted.
+   */
+  memory::Usage plannedMemoryUsage(uint32_t wrt) const
+  {
+    memory::Usage usage = memoryUsage();
+
+    std::size_t derivatives = 0;
+    for (const auto& integral : integrals_) {
+      derivatives += integral.PlannedDerivativeBytes(wrt);
+    }
+    usage["qfunction_derivatives"] = std::max(usage["qfunction_derivatives"], derivatives);
+
+    if (lookup_tables_[wrt] != nullptr && grad_[wrt].bytes() > 0) {
+      return usage;
+    }
+
+    auto sizes = plannedGradientSizes(wrt);
+
+    if (lookup_tables_[wrt] == nullptr) {
+      usage["gradient_lookup_tables"] += sizes.bytes();
+    }
+
+    // the copies of the sparsity pattern and values for mfem and hypre, and the element matrices, see Gradient::bytes()
+    if (grad_[wrt].bytes() == 0) {
+      usage["gradient_matrices"] += 2 * (sizes.rows + 1) * sizeof(int) + 2 * sizes.nnz * sizeof(int) +
+                                    3 * sizes.nnz * sizeof(double) + sizes.nnz * sizeof(nonzero_index) +
+                                    sizes.blocks * sizeof(double*) + sizes.element_entries * sizeof(double);
+    }
+
+    return usage;
+  }
+
+  /**
+   * @brief the sizes of the sparsity pattern and lookup tables of the gradient w.r.t. trial argument @a wrt, without
+   * building them (see GradientAssemblyLookupTables::plan()), or those already built
+   */
+  GradientAssemblyLookupTables::Sizes plannedGradientSizes(uint32_t wrt) const
+  {
+    if (lookup_tables_[wrt] != nullptr) {
+      const auto& tables = *lookup_tables_[wrt];
+      std::size_t block_size = tables.test_components * tables.trial_components;
+      return {tables.row_ptr.size() - 1,
+              tables.nnz,
+              tables.contributions.size() * block_size,
+              tables.element_matrix_blocks.size(),
+              block_size,
+              tables.blocked() ? tables.num_test_nodes : 0,
+              tables.lookup == GradientLookup::Precomputed};
+    }
+
+    std::array<const BlockElementRestriction*, Domain::num_types> test_restrictions;
+    std::array<const BlockElementRestriction*, Domain::num_types> trial_restrictions;
+    for (std::size_t type = 0; type < Domain::num_types; type++) {
+      test_restrictions[type]  = G_test_[type].get();
+      trial_restrictions[type] = G_trial_[type][wrt].get();
+    }
+    return GradientAssemblyLookupTables::plan(test_restrictions, trial_restrictions, gradient_lookup_);
+  }
+
+  /**
+   * @brief the estimated floating point operations and bytes moved by an evaluation of every integral, see
+   * KernelCounts. Only the `elements`, `flops` and `bytes` are summed, the other counts are per element.
+   */
+  KernelCounts kernelCounts() const
+  {
+    KernelCounts total;
+    for (const auto& integral : integrals_) {
+      for (const auto& [geometry, gf] : integral.geometric_factors_) {
+        const KernelCounts& counts = integral.counts(geometry);
+        total.elements += counts.elements;
+        total.flops += counts.flops;
+        total.bytes += counts.bytes;
+      }
+    }
+    return total;
+  }
+
+private:
+  /**
+   * @brief evaluate the Functional (and store the derivatives needed by the gradient w.r.t. argument @a wrt),
+   * writing the result to @a output_T
+   */
+  template <uint32_t wrt, typename... T>
+  void evaluate(DifferentiateWRT<wrt>, mfem::Vector& output_T, double t, const T&... args)
+  {
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+
+    // get the values for each local processor: the halo exchange for every trial space is posted up front,
+    // but we only wait for it to complete right before the first integral that needs those values
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      // frozen arguments keep the values from the evaluation where they were last prolongated
+      if (frozen_[i] && prolongated_[i]) continue;
+
+      // the exchanges of a finite element space are matched by the order they are posted in, so earlier
+      // arguments from the same finite element space have to finish first
+      for (uint32_t j = 0; j < i; j++) {
+        if (prolongation_[j].communicator && prolongation_[j].communicator == prolongation_[i].communicator) {
+          prolongation_[j].Finish();
+        }
+      }
+
+      SERAC_MARK_SCOPE("prolongation");
+      prolongation_[i].Begin(*input_T[i], input_L_[i]);
+      invalidateInputs(i);
+      prolongated_[i] = true;
+
+      // separable loads that depend on this argument have to be integrated again
+      for (auto& integral : integrals_) {
+        if (integral.UsesArgument(i)) {
+          integral.InvalidateSeparableLoad();
+        }
+      }
+
+      // the quadrature point values of a frozen argument are cached again from its new inputs
+      if (frozen_[i] && cache_frozen_arguments_) {
+        for (auto& integral : integrals_) {
+          integral.CacheArgument(i, true);
+        }
+      }
+    }
+
+    output_L_ = 0.0;
+
+    // this is used to mark which kinds of domains have integrals that contributed to output_E_
+    bool has_output[Domain::num_types]{};  // default initializes to `false`
+
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      output_E_[type] = 0.0;
+    }
+
+    // the kernels of each block of the E-vectors, when the integrals run concurrently
+    std::map<std::pair<Domain::Type, mfem::Geometry::Type>, KernelChain> chains;
+
+    for (auto& integral : integrals_) {
+      auto type = integral.domain_.type_;
+
+      // the derivative kernels are created the first time an argument is differentiated
+      integral.GenerateDerivativeKernels(wrt);
+
+      // separable loads that are not differentiated, and whose arguments are all frozen, are only integrated once
+      if (integral.IsSeparable()) {
+        integral.SetTime(t);
+        if (std::all_of(integral.active_trial_spaces_.begin(), integral.active_trial_spaces_.end(),
+                        [this](uint32_t i) { return frozen_[i] && i != wrt; })) {
+          if (!integral.HasSeparableLoad()) {
+            integrateSeparableLoad(integral, t);
+          }
+          output_L_.Add(integral.time_scale_(t), integral.separable_L_);
+          continue;
+        }
+      }
+
+      // Integrals whose gradients re-evaluate the q-function don't need to store its derivatives
+      bool recompute = recompute_derivatives_ && integral.CanRecomputeGradient();
+
+      // domain integrals can be evaluated a tile of elements at a time, straight from and into the L-vectors.
+      // Integrals whose gradients are recomputed need the E-vectors of their linearization point, though
+      if ((tile_size_ > 0 || autotune_tile_size_) && integral.CanTile() && !recompute) {
+        for (auto i : integral.active_trial_spaces_) {
+          SERAC_MARK_SCOPE("prolongation");
+          prolongation_[i].Finish();
+        }
+        integral.TiledMult(t, tiled_input_L_, output_L_, wrt, update_qdata_, tile_size_, tiled_restrictions_,
+                           *G_test_[type], tile_E_);
+        continue;
+      }
+
+      // each gather is done at most once per evaluation (or once while its argument is frozen)
+      allocateElementVectors(type);
+      for (auto i : integral.active_trial_spaces_) {
+        if (!gathered_[type][i]) {
+          SERAC_MARK_SCOPE("prolongation");
+          prolongation_[i].Finish();
+          G_trial_[type][i]->Gather(input_L_[i], input_E_[type][i], selection(type));
+          gathered_[type][i] = true;
+        }
+      }
+
+      // each integral accumulates its contributions into the E-vector for its kind of domain. With concurrent
+      // integrals, the kernels that add into the same block (kind of domain and geometry) are chained together, and
+      // the chains run once every input has been gathered
+      uint32_t which = recompute ? NO_DIFFERENTIATION : wrt;
+      if (concurrent_integrals_) {
+        for (auto& [geometry, task] : integral.MultTasks(t, input_E_[type], output_E_[type], which, update_qdata_)) {
+          auto& chain = chains[{type, geometry}];
+          chain.flops += integral.counts(geometry).flops;
+          chain.kernels.push_back(std::move(task));
+        }
+      } else {
+        integral.Mult(t, input_E_[type], output_E_[type], which, update_qdata_);
+      }
+      has_output[type] = true;
+    }
+
+    if (!chains.empty()) {
+      SERAC_MARK_SCOPE("concurrent integrals");
+      runKernelChains(chains);
+    }
+
+    // arguments that no integral depended on still need to complete their exchanges
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      prolongation_[i].Finish();
+    }
+
+    if (autotune_tile_size_) {
+      saveTileSizes();
+    }
+
+    if constexpr (wrt != NO_DIFFERENTIATION) {
+      // ActionOfGradient() overwrites input_E_, so the linearization point is kept separately
+      if (recompute_derivatives_) {
+        linearization_time_ = t;
+        linearization_E_    = input_E_[Domain::Type::Elements];
+      }
+    }
+
+    SERAC_MARK_BEGIN("scatter");
+
+    // scatter-add to compute residuals on the local processor (once per kind of domain, rather than once per integral).
+    // The elements that touch dofs shared with other ranks go first, so that the reduction of those values
+    // can be posted while the contributions from the interior elements are scatter-added
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      if (has_output[type]) {
+        G_test_[type]->ScatterAdd(output_E_[type], output_L_, selection(type), ElementSubset::Shared);
+      }
+    }
+
+    test_prolongation_.BeginTranspose(output_L_);
+
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      if (has_output[type]) {
+        G_test_[type]->ScatterAdd(output_E_[type], output_L_, selection(type), ElementSubset::Interior);
+      }
+    }
+
+    // scatter-add to compute global residuals
+    test_prolongation_.FinishTranspose(output_L_, output_T);
+
+    SERAC_MARK_END("scatter");
+  }
+
+  /**
+   * @brief integrate a separable load with a time scale of one into its own L-vector, see
+   * AddSeparableDomainIntegral()
+   */
+  void integrateSeparableLoad(Integral& integral, double t)
+  {
+    SERAC_MARK_SCOPE("separable load");
+
+    auto type = integral.domain_.type_;
+    allocateElementVectors(type);
+    for (auto i : integral.active_trial_spaces_) {
+      if (!gathered_[type][i]) {
+        prolongation_[i].Finish();
+        G_trial_[type][i]->Gather(input_L_[i], input_E_[type][i], selection(type));
+        gathered_[type][i] = true;
+      }
+    }
+
+    mfem::BlockVector load_E(G_test_[type]->bOffsets(), workspace_memory_type<exec>());
+    load_E = 0.0;
+
+    integral.SetScale(1.0);
+    integral.Mult(t, input_E_[type], load_E, NO_DIFFERENTIATION, false);
+    integral.SetTime(t);
+
+    integral.separable_L_.SetSize(output_L_.Size());
+    integral.separable_L_ = 0.0;
+    G_test_[type]->ScatterAdd(load_E, integral.separable_L_, selection(type));
+  }
+
+  /// @brief the kernels that add into the same block of the E-vectors, in the order of their integrals, and
+  /// their estimated floating point operations, see concurrentIntegrals()
+  struct KernelChain {
+    /// @brief the estimated floating point operations of the kernels
+    double flops = 0.0;
+
+    /// @brief the kernels, which run one after another
+    std::vector<std::function<void()>> kernels;
+  };
+
+  /// @brief run the chains of kernels collected by an evaluation concurrently, see concurrentIntegrals()
+  void runKernelChains(const std::map<std::pair<Domain::Type, mfem::Geometry::Type>, KernelChain>& chains) const
+  {
+    // the most expensive chains are started first, so that the cheap ones fill in around them
+    std::vector<const KernelChain*> order;
+    for (const auto& [block, chain] : chains) {
+      order.push_back(&chain);
+    }
+    std::stable_sort(order.begin(), order.end(), [](auto a, auto b) { return a->flops > b->flops; });
+
+    std::vector<std::function<void()>> tasks;
+    for (const KernelChain* chain : order) {
+      tasks.push_back([chain]() {
+        for (const auto& kernel : chain->kernels) {
+          kernel();
+        }
+      });
+    }
+    accelerator::forall_tasks(tasks);
+  }
+
+  /**
+   * @brief the elements of a kind of domain that the integrals are evaluated on, which are the only ones that are
+   * gathered and scatter-added, see BlockElementRestriction::Select()
+   *
+   * The integrals on a small part of the mesh or boundary (e.g. a traction on one face of a part) only ever read and
+   * write the E-vector values of their own elements, so the values of the other elements are left at zero.
+   */
+  const ElementSelection& selection(Domain::Type type) const
+  {
+    // the selections are made again whenever integrals were added since they were last made
+    if (selected_integrals_ != integrals_.size()) {
+      constexpr mfem::Geometry::Type geometries[] = {mfem::Geometry::SEGMENT,     mfem::Geometry::TRIANGLE,
+                                                     mfem::Geometry::SQUARE,      mfem::Geometry::TETRAHEDRON,
+                                                     mfem::Geometry::CUBE,        mfem::Geometry::PRISM};
+
+      std::map<mfem::Geometry::Type, std::vector<int>> elements[Domain::num_types];
+      for (const auto& integral : integrals_) {
+        auto& selected = elements[integral.domain_.type_];
+        for (auto geom : geometries) {
+          const auto& ids = integral.domain_.get(geom);
+          if (!ids.empty()) {
+            selected[geom].insert(selected[geom].end(), ids.begin(), ids.end());
+          }
+        }
+      }
+
+      for (auto t : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+        selections_[t] = G_test_[t]->Select(elements[t]);
+      }
+      selected_integrals_ = integrals_.size();
+    }
+    return selections_[type];
+  }
+
+  /// @brief release the E-vectors of the elements, which the tiled evaluations of domain integrals don't need
+  void releaseElementVectors()
+  {
+    if (element_vectors_released_) return;
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      input_E_[Domain::Type::Elements][i].Destroy();
+      gathered_[Domain::Type::Elements][i] = false;
+    }
+    output_E_[Domain::Type::Elements].Destroy();
+    element_vectors_released_ = true;
+  }
+
+  /// @brief save the tuned tile sizes into the file given to autotuneElementTileSize(), once every kernel is tuned
+  void saveTileSizes() const
+  {
+    if (tile_size_file_.empty() || tile_sizes_saved_) return;
+
+    std::map<std::string, uint32_t> tile_sizes;
+    for (auto& integral : integrals_) {
+      for (auto& [geometry, tuner] : integral.tile_tuners_) {
+        if (!tuner.tuned()) return;
+        tile_sizes[tuner.key()] = tuner.tileSize();
+      }
+    }
+
+    // the file may also hold the tile sizes of other kernels, which are kept
+    int rank;
+    MPI_Comm_rank(test_space_->GetComm(), &rank);
+    if (rank == 0) {
+      auto saved = readTileSizes(tile_size_file_);
+      for (auto& [key, tile_size] : tile_sizes) {
+        saved[key] = tile_size;
+      }
+      writeTileSizes(tile_size_file_, saved);
+    }
+    tile_sizes_saved_ = true;
+  }
+
+  /// @brief allocate the E-vectors for a kind of domain again, if they were released by setElementTileSize()
+  void allocateElementVectors(Domain::Type type) const
+  {
+    if (type != Domain::Type::Elements || !element_vectors_released_) return;
+
+    auto mem_type = workspace_memory_type<exec>();
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      input_E_[type][i].Update(G_trial_[type][i]->bOffsets(), mem_type);
+      G_trial_[type][i]->FirstTouch(input_E_[type][i]);
+      gathered_[type][i] = false;
+    }
+    output_E_[type].Update(G_test_[type]->bOffsets(), mem_type);
+    G_test_[type]->FirstTouch(output_E_[type]);
+    element_vectors_released_ = false;
+  }
+
+  /// @brief mark the L-vector and E-vectors of trial space argument @a which as no longer holding its input values
+  void invalidateInputs(uint32_t which) const
+  {
+    prolongated_[which] = false;
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements, Domain::Type::InteriorFaces}) {
+      gathered_[type][which] = false;
+    }
+  }
+
+  /**
+   * @brief return the sparsity pattern and element-to-nonzero lookup tables for the gradient w.r.t. trial argument
+   * `which`, building them if necessary
+   */
+  const GradientAssemblyLookupTables& gradientLookupTables(uint32_t which)
+  {
+    // arguments (of this or other Functionals) with equivalent trial spaces share the same restrictions,
+    // so they also share the lookup tables
+    if (lookup_tables_[which] == nullptr) {
+      std::array<const BlockElementRestriction*, Domain::num_types> test_restrictions;
+      std::array<const BlockElementRestriction*, Domain::num_types> trial_restrictions;
+      for (std::size_t type = 0; type < Domain::num_types; type++) {
+        test_restrictions[type]  = G_test_[type].get();
+        trial_restrictions[type] = G_trial_[type][which].get();
+      }
+      lookup_tables_[which] = shared_setup::lookup_tables(test_restrictions, trial_restrictions, gradient_lookup_);
+    }
+
+    return *lookup_tables_[which];
+  }
+
+  /// @brief flag for denoting when a residual evaluation should update the material state buffers
+  bool update_qdata_;
+
+  /**
+   * @brief mfem::Operator representing the gradient matrix that
+   * can compute the action of the gradient (with operator()),
+   * or assemble the sparse matrix representation through implicit conversion to mfem::HypreParMatrix *
+   */
+  class Gradient : public mfem::Operator {
+  public:
+    /**
+     * @brief Constructs a Gradient wrapper that references a parent @p Functional
+     * @param[in] f The @p Functional to use for gradient calculations
+     */
+    Gradient(Functional<test(trials...), exec>& f, uint32_t which = 0)
+        : mfem::Operator(f.test_space_->GetTrueVSize(), f.trial_space_[which]->GetTrueVSize()),
+          form_(f),
+          which_argument(which),
+          test_space_(f.test_space_),
+          trial_space_(f.trial_space_[which]),
+          df_(f.test_space_->GetTrueVSize())
+    {
+    }
+
+    /**
+     * @brief Copies reference the same @p Functional, but don't share the cached element and sparse matrices,
+     * which are rebuilt on their first assembly
+     * @param[in] other The gradient to copy
+     */
+    Gradient(const Gradient& other) : Gradient(other.form_, other.which_argument) {}
+
+    /**
+     * @brief implement that action of the gradient: df := df_dx * dx
+     * @param[in] dx a small perturbation in the trial space
+     * @param[in] df the resulting small perturbation in the residuals
+     */
+    virtual void Mult(const mfem::Vector& dx, mfem::Vector& df) const override
+    {
+      form_.ActionOfGradient(dx, df, which_argument);
+    }
+
+    /**
+     * @brief implement the action of the transpose of the gradient: dx := transpose(df_dx) * df
+     * @param[in] df a small perturbation in the test space, e.g. an adjoint solution
+     * @param[out] dx the resulting perturbation in the trial space, e.g. a sensitivity
+     */
+    virtual void MultTranspose(const mfem::Vector& df, mfem::Vector& dx) const override
+    {
+      form_.ActionOfGradientTranspose(df, dx, which_argument);
+    }
+
+    /**
+     * @brief compute the diagonal of the gradient matrix without assembling it, e.g. for Jacobi preconditioning
+     * @param[out] diag the diagonal entries, one for each true dof
+     */
+    virtual void AssembleDiagonal(mfem::Vector& diag) const override
+    {
+      form_.AssembleGradientDiagonal(diag, which_argument);
+    }
+
+    /**
+     * @brief compute a lumped (diagonal) approximation of the gradient matrix without assembling it, e.g. the
+     * lumped mass of explicit dynamics or mass-scaled preconditioning
+     *
+     * The row sums are the action of the gradient on a vector of ones. HRZ lumping scales the consistent diagonal
+     * so that its total matches the total of the row sums, which keeps the masses positive for higher order elements
+     * (unlike row-sum lumping). For vector-valued spaces, the scaling is shared by all of the components.
+     *
+     * @param method how the diagonal is formed
+     * @return the lumped diagonal, one entry for each true dof
+     */
+    mfem::Vector lumpedDiagonal(LumpingMethod method = LumpingMethod::RowSum) const
+    {
+      SLIC_ERROR_ROOT_IF(trial_space_ != test_space_, "Lumped diagonals are only defined for square blocks");
+
+      mfem::Vector ones(width);
+      ones = 1.0;
+
+      mfem::Vector row_sums(height);
+      Mult(ones, row_sums);
+      if (method == LumpingMethod::RowSum) {
+        return row_sums;
+      }
+
+      mfem::Vector diag(height);
+      AssembleDiagonal(diag);
+
+      MPI_Comm comm       = test_space_->GetComm();
+      double   total      = mfem::InnerProduct(comm, row_sums, ones);
+      double   diag_total = mfem::InnerProduct(comm, diag, ones);
+      SLIC_ERROR_ROOT_IF(diag_total <= 0.0, "HRZ lumping requires a positive diagonal");
+
+      diag *= total / diag_total;
+      return diag;
+    }
+
+    /// @brief syntactic sugar:  df_dx.Mult(dx, df)  <=>  mfem::Vector df = df_dx(dx);
+    mfem::Vector& operator()(const mfem::Vector& dx)
+    {
+      form_.ActionOfGradient(dx, df_, which_argument);
+      return df_;
+    }
+
+    /// @brief the number of bytes allocated for the element and sparse matrices cached by earlier assemblies
+    std::size_t bytes() const
+    {
+      std::size_t total = memory::bytes(row_ptr_copy_) + memory::bytes(col_ind_copy_) + memory::bytes(values_) +
+                          memory::bytes(local_values_) + memory::bytes(element_gradient_ptrs_) +
+                          memory::bytes(transpose_permutation_) + memory::bytes(hypre_permutation_) +
+                          memory::bytes(test_tdofs_) + memory::bytes(trial_tdofs_) + true_dof_refills_[0].bytes() +
+                          true_dof_refills_[1].bytes();
+
+      // J_local_ only wraps the copies above, but A_local_ has its own storage
+      if (A_local_) {
+        total += memory::bytes(*A_local_);
+      }
+
+      if (device_tables_) {
+        total += device_tables_->bytes();
+      }
+
+      for (const auto& per_geometry : element_gradients_) {
+        for (const auto& [geometry, K_elem] : per_geometry) {
+          total += std::size_t(K_elem.size()) * sizeof(double);
+        }
+      }
+
+      return total;
+    }
+
+    /**
+     * @brief assemble element matrices and form an mfem::HypreParMatrix
+     *
+     * For conforming H1 and L2 spaces, the local entries are added straight into the rows and columns of their true
+     * dofs (see assembleTrueDofs()). Otherwise, the true dof matrix is the triple product R^T A P of the local matrix
+     * A and the spaces' prolongations.
+     */
+    std::unique_ptr<mfem::HypreParMatrix> assemble()
+    {
+      SLIC_ERROR_ROOT_IF(form_.recompute_derivatives_, "Assembling a gradient requires stored q-function derivatives");
+
+      if (assemblesTrueDofsDirectly()) {
+        return assembleTrueDofs(assembleValues());
+      }
+
+      auto* A = assembleLocal();
+      auto* R = form_.test_space_->Dof_TrueDof_Matrix();
+      auto* P = trial_space_->Dof_TrueDof_Matrix();
+
+      return std::unique_ptr<mfem::HypreParMatrix>(mfem::RAP(R, A, P));
+    };
+
+    /**
+     * @brief assemble element matrices into a matrix previously returned by assemble()
+     *
+     * @param[inout] K the matrix to overwrite. If K is empty, or the newly assembled matrix
+     * has a different sparsity pattern, K is replaced instead
+     *
+     * @note the first assembly into K forms the true dof matrix, and records where each value of the local matrix
+     * goes in it (see planTrueDofRefill()). Later assemblies into the same K only refill its values in place, without
+     * the triple product (or IJ assembly) and its temporaries.
+     */
+    void reassembleInto(std::unique_ptr<mfem::HypreParMatrix>& K)
+    {
+      SLIC_ERROR_ROOT_IF(form_.recompute_derivatives_, "Assembling a gradient requires stored q-function derivatives");
 
-      std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients[Domain::num_types];
+      reassembleTrueDofsInto(K, false);
+    }
+
+    /**
+     * @brief assemble the transpose of the gradient, without forming the gradient itself, e.g. for adjoint solves
+     *
+     * @param[inout] K_T the matrix to overwrite, see reassembleInto()
+     *
+     * @note this requires the trial space to be the test space, so that the sparsity pattern is symmetric
+     * and the transpose can be assembled from the same (block-diagonal) local matrix, with its values permuted.
+     * Unlike mfem::HypreParMatrix::Transpose(), this needs no more communication than the assembly itself.
+     */
+    void reassembleTransposeInto(std::unique_ptr<mfem::HypreParMatrix>& K_T)
+    {
+      SLIC_ERROR_ROOT_IF(form_.recompute_derivatives_, "Assembling a gradient requires stored q-function derivatives");
+      SLIC_ERROR_ROOT_IF(trial_space_ != test_space_, "Transposed gradients can only be assembled for square blocks");
+
+      reassembleTrueDofsInto(K_T, true);
+    }
+
+    friend auto assemble(Gradient& g) { return g.assemble(); }
+
+    /// @brief assemble element matrices into an existing mfem::HypreParMatrix, see Gradient::reassembleInto()
+    friend void assemble(Gradient& g, std::unique_ptr<mfem::HypreParMatrix>& K) { g.reassembleInto(K); }
+
+    /// @brief assemble the transpose of the gradient into an existing mfem::HypreParMatrix, see
+    /// Gradient::reassembleTransposeInto()
+    friend void assembleTranspose(Gradient& g, std::unique_ptr<mfem::HypreParMatrix>& K_T)
+    {
+      g.reassembleTransposeInto(K_T);
+    }
+
+    /**
+     * @brief compute the element matrices, and pass each one to @a f, without assembling them
+     *
+     * @param f called as f(test_vdofs, trial_vdofs, K_e) for each element, with the local vdofs (as mfem::Array<int>)
+     * of the rows and columns of its element matrix K_e (as mfem::DenseMatrix), e.g. see StaticCondensation
+     *
+     * @note the element matrices of all the integrals of a kind of domain (e.g. all the domain integrals) over an
+     * element are added together before it is passed to @a f
+     */
+    template <typename F>
+    void forEachElementMatrix(F&& f)
+    {
+      SLIC_ERROR_ROOT_IF(form_.recompute_derivatives_, "Assembling a gradient requires stored q-function derivatives");
+
+      computeElementGradients();
+
+      mfem::Array<int>  test_vdofs, trial_vdofs;
+      mfem::DenseMatrix K_e;
+      for (int type = 0; type < Domain::num_types; type++) {
+        for (const auto& [geom, K_geom] : element_gradients_[type]) {
+          const auto& test_dofs  = form_.G_test_[type]->restrictions.at(geom);
+          const auto& trial_dofs = form_.G_trial_[type][which_argument]->restrictions.at(geom);
+          auto        test_npe   = test_dofs.nodes_per_elem;
+          auto        trial_npe  = trial_dofs.nodes_per_elem;
+          auto        num_test   = test_npe * test_dofs.components;
+          auto        num_trial  = trial_npe * trial_dofs.components;
+
+          test_vdofs.SetSize(int(num_test));
+          trial_vdofs.SetSize(int(num_trial));
+          K_e.SetSize(int(num_test), int(num_trial));
+
+          const double* K_block = K_geom.data();
+
+          for (uint64_t e = 0; e < test_dofs.num_elements; e++) {
+            for (uint64_t i = 0; i < num_trial; i++) {
+              DoF trial_vdof      = trial_dofs.GetVDof(trial_dofs.dof_info(e, i % trial_npe), i / trial_npe);
+              trial_vdofs[int(i)] = int(trial_vdof.index());
+              for (uint64_t j = 0; j < num_test; j++) {
+                DoF test_vdof       = test_dofs.GetVDof(test_dofs.dof_info(e, j % test_npe), j / test_npe);
+                test_vdofs[int(j)]  = int(test_vdof.index());
+                double sign         = test_vdof.sign() * trial_vdof.sign();
+                K_e(int(j), int(i)) = sign * K_block[(e * num_trial + i) * num_test + j];
+              }
+            }
+            f(test_vdofs, trial_vdofs, K_e);
+          }
+        }
+      }
+    }
+
+  private:
+    /// @brief compute the element matrices of every integral into element_gradients_
+    void computeElementGradients()
+    {
+      // the element matrices are allocated on the first assembly, and zeroed (rather than reallocated) after that
+      bool zeroed[Domain::num_types]{};
 
       for (auto& integral : form_.integrals_) {
-        auto& K_elem             = element_gradients[integral.domain_.type_];
-        auto& test_restrictions  = form_.G_test_[integral.domain_.type_].restrictions;
-        auto& trial_restrictions = form_.G_trial_[integral.domain_.type_][which_argument].restrictions;
+        auto  type               = integral.domain_.type_;
+        auto& K_elem             = element_gradients_[type];
+        auto& test_restrictions  = form_.G_test_[type]->restrictions;
+        auto& trial_restrictions = form_.G_trial_[type][which_argument]->restrictions;
 
         if (K_elem.empty()) {
           for (auto& [geom, test_restriction] : test_restrictions) {
-            auto& trial_restriction = trial_restrictions[geom];
+            const auto& trial_restriction = trial_restrictions.at(geom);
 
             K_elem[geom] = ExecArray<double, 3, exec>(test_restriction.num_elements,
                                                       trial_restriction.nodes_per_elem * trial_restriction.components,
                                                       test_restriction.nodes_per_elem * test_restriction.components);
+          }
+        }
 
-            detail::zero_out(K_elem[geom]);
+        if (!zeroed[type]) {
+          for (auto& [geom, K_geom] : K_elem) {
+            detail::zero_out(K_geom);
           }
+          zeroed[type] = true;
         }
 
         integral.ComputeElementGradients(K_elem, which_argument);
       }
+    }
 
-      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
-        auto& K_elem             = element_gradients[type];
-        auto& test_restrictions  = form_.G_test_[type].restrictions;
-        auto& trial_restrictions = form_.G_trial_[type][which_argument].restrictions;
-
-        if (!K_elem.empty()) {
-          for (auto [geom, elem_matrices] : K_elem) {
-            std::vector<DoF> test_vdofs(test_restrictions[geom].nodes_per_elem * test_restrictions[geom].components);
-            std::vector<DoF> trial_vdofs(trial_restrictions[geom].nodes_per_elem * trial_restrictions[geom].components);
-
-            for (axom::IndexType e = 0; e < elem_matrices.shape()[0]; e++) {
-              test_restrictions[geom].GetElementVDofs(e, test_vdofs);
-              trial_restrictions[geom].GetElementVDofs(e, trial_vdofs);
-
-              for (uint32_t i = 0; i < uint32_t(elem_matrices.shape()[1]); i++) {
-                int col = int(trial_vdofs[i].index());
-
-                for (uint32_t j = 0; j < uint32_t(elem_matrices.shape()[2]); j++) {
-                  int row = int(test_vdofs[j].index());
-
-                  int sign = test_vdofs[j].sign() * trial_vdofs[i].sign();
-
-                  // note: col / row appear backwards here, because the element matrix kernel
-                  //       is actually transposed, as a result of being row-major storage.
-                  //
-                  //       This is kind of confusing, and will be fixed in a future refactor
-                  //       of the element gradient kernel implementation
-                  [[maybe_unused]] auto nz = lookup_tables(row, col);
-                  values[lookup_tables(row, col)] += sign * elem_matrices(e, i, j);
-                }
+    /**
+     * @brief whether the true dof matrix can be assembled without the triple product R^T A P
+     *
+     * That is the case when every local dof is a copy of a single true dof: on conforming meshes, for spaces
+     * without orientation-dependent signs (i.e. not Hcurl or Hdiv).
+     */
+    bool assemblesTrueDofsDirectly() const
+    {
+      for (const auto* space : {test_space_, trial_space_}) {
+        auto continuity = space->FEColl()->GetContType();
+        if (space->Nonconforming() || (continuity != mfem::FiniteElementCollection::CONTINUOUS &&
+                                       continuity != mfem::FiniteElementCollection::DISCONTINUOUS)) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// @brief the global true dof of each local dof of @a space, see assemblesTrueDofsDirectly()
+    static std::vector<HYPRE_BigInt> globalTrueDofs(const mfem::ParFiniteElementSpace& space)
+    {
+      // the global numbers of true dofs owned by other ranks are only known once the prolongation has been built
+      space.Dof_TrueDof_Matrix();
+
+      std::vector<HYPRE_BigInt> tdofs(std::size_t(space.GetVSize()));
+      for (int i = 0; i < space.GetVSize(); i++) {
+        tdofs[std::size_t(i)] = space.GetGlobalTDofNumber(i);
+      }
+      return tdofs;
+    }
+
+    /**
+     * @brief refill the values of a true dof matrix assembled earlier in place, or form it (and plan its later
+     * refills) if there is none, see reassembleInto() and reassembleTransposeInto()
+     *
+     * @param[inout] K the matrix to overwrite
+     * @param transposed whether to assemble the transpose of the gradient instead
+     */
+    void reassembleTrueDofsInto(std::unique_ptr<mfem::HypreParMatrix>& K, bool transposed)
+    {
+      TrueDofRefill& refill = true_dof_refills_[transposed];
+
+      // the refills communicate, so either every rank refills its matrix or they all form theirs again
+      int refillable = K && refill.matches(*K);
+      MPI_Allreduce(MPI_IN_PLACE, &refillable, 1, MPI_INT, MPI_LAND, test_space_->GetComm());
+      if (refillable) {
+        refillTrueDofs(refill, assembleValues(transposed), *K);
+        return;
+      }
+
+      if (assemblesTrueDofsDirectly()) {
+        refillOrReplace(K, assembleTrueDofs(assembleValues(transposed)));
+      } else {
+        auto* A = assembleLocal(transposed);
+        auto* R = test_space_->Dof_TrueDof_Matrix();
+        auto* P = trial_space_->Dof_TrueDof_Matrix();
+        refillOrReplace(K, std::unique_ptr<mfem::HypreParMatrix>(mfem::RAP(R, A, P)));
+      }
+
+      refill = planTrueDofRefill(*K);
+    }
+
+    /// @brief the (global true dof, weight) pairs that each local dof of a space is interpolated from
+    struct ProlongationRows {
+      std::vector<HYPRE_Int>    offsets;  ///< the pairs of local dof i are [offsets[i], offsets[i+1])
+      std::vector<HYPRE_BigInt> tdofs;    ///< the global true dof of each pair
+      std::vector<double>       weights;  ///< the weight of each pair
+    };
+
+    /// @brief the rows of the prolongation (the mfem::ParFiniteElementSpace::Dof_TrueDof_Matrix()) of @a space
+    static ProlongationRows prolongationRows(const mfem::ParFiniteElementSpace& space)
+    {
+      mfem::HypreParMatrix* P = space.Dof_TrueDof_Matrix();
+      P->HostRead();
+
+      hypre_ParCSRMatrix* matrix    = *P;
+      hypre_CSRMatrix*    diag      = hypre_ParCSRMatrixDiag(matrix);
+      hypre_CSRMatrix*    offd      = hypre_ParCSRMatrixOffd(matrix);
+      HYPRE_BigInt        col_begin = hypre_ParCSRMatrixFirstColDiag(matrix);
+      HYPRE_BigInt*       col_map   = hypre_ParCSRMatrixColMapOffd(matrix);
+
+      ProlongationRows rows;
+      auto             num_rows = std::size_t(hypre_CSRMatrixNumRows(diag));
+      rows.offsets.resize(num_rows + 1, 0);
+      for (std::size_t i = 0; i < num_rows; i++) {
+        for (HYPRE_Int k = hypre_CSRMatrixI(diag)[i]; k < hypre_CSRMatrixI(diag)[i + 1]; k++) {
+          rows.tdofs.push_back(col_begin + hypre_CSRMatrixJ(diag)[k]);
+          rows.weights.push_back(hypre_CSRMatrixData(diag)[k]);
+        }
+        for (HYPRE_Int k = hypre_CSRMatrixI(offd)[i]; k < hypre_CSRMatrixI(offd)[i + 1]; k++) {
+          rows.tdofs.push_back(col_map[hypre_CSRMatrixJ(offd)[k]]);
+          rows.weights.push_back(hypre_CSRMatrixData(offd)[k]);
+        }
+        rows.offsets[i + 1] = HYPRE_Int(rows.tdofs.size());
+      }
+      return rows;
+    }
+
+    /**
+     * @brief where each value of the local matrix is added into a true dof matrix formed earlier, so that later
+     * assemblies can refill that matrix's values in place, see planTrueDofRefill()
+     *
+     * Each entry of K is addressed by its position in the data of K's diagonal block, followed by the data of its
+     * off-diagonal block.
+     */
+    struct TrueDofRefill {
+      /// @brief whether @a K is the matrix this plan was made for, with the same structure
+      bool matches(const mfem::HypreParMatrix& K) const
+      {
+        const hypre_ParCSRMatrix* k = K;
+        return matrix == &K && csr == k && diag_nnz == hypre_CSRMatrixNumNonzeros(hypre_ParCSRMatrixDiag(k)) &&
+               offd_nnz == hypre_CSRMatrixNumNonzeros(hypre_ParCSRMatrixOffd(k)) &&
+               offd_cols == hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(k));
+      }
+
+      /// @brief the number of bytes allocated for the plan
+      std::size_t bytes() const
+      {
+        return memory::bytes(offsets) + memory::bytes(sources) + memory::bytes(weights) + memory::bytes(send_ranks) +
+               memory::bytes(send_offsets) + memory::bytes(send_sources) + memory::bytes(send_weights) +
+               memory::bytes(send_buffer) + memory::bytes(receive_ranks) + memory::bytes(receive_offsets) +
+               memory::bytes(receive_destinations) + memory::bytes(receive_buffer);
+      }
+
+      const mfem::HypreParMatrix* matrix    = nullptr;  ///< the matrix the plan was made for
+      const hypre_ParCSRMatrix*   csr       = nullptr;  ///< the hypre storage of that matrix
+      HYPRE_Int                   diag_nnz  = 0;        ///< the number of entries of its diagonal block
+      HYPRE_Int                   offd_nnz  = 0;        ///< the number of entries of its off-diagonal block
+      HYPRE_Int                   offd_cols = 0;        ///< the number of columns of its off-diagonal block
+
+      /**
+       * @brief the local nonzero entries (and their weights) added into entry d of K, among the rows this rank owns,
+       * are sources[offsets[d]], ..., sources[offsets[d+1] - 1]
+       */
+      std::vector<std::size_t>   offsets;
+      std::vector<nonzero_index> sources;  ///< see offsets
+      std::vector<double>        weights;  ///< see offsets, or empty if every weight is 1
+
+      std::vector<int>           send_ranks;    ///< the ranks that own rows this rank's local matrix contributes to
+      std::vector<std::size_t>   send_offsets;  ///< where the values sent to each of send_ranks start in send_buffer
+      std::vector<nonzero_index> send_sources;  ///< the local nonzero entry of each value sent
+      std::vector<double>        send_weights;  ///< the weight of each value sent, or empty if every weight is 1
+      std::vector<double>        send_buffer;   ///< the values sent by each refill
+
+      std::vector<int>         receive_ranks;         ///< the ranks whose local matrices contribute to this rank's rows
+      std::vector<std::size_t> receive_offsets;       ///< where the values of each of receive_ranks start
+      std::vector<std::size_t> receive_destinations;  ///< the entry of K that each received value is added into
+      std::vector<double>      receive_buffer;        ///< the values received by each refill
+    };
+
+    /**
+     * @brief record where each value of the local matrix goes in the true dof matrix @a K (R^T A P), for
+     * refillTrueDofs()
+     *
+     * The local nonzero entry (i, j) is added into entry (t, s) of K with weight R(i, t) P(j, s), for each true dof
+     * t that local test dof i is interpolated from, and each s of local trial dof j. Contributions to the rows of
+     * other ranks are sent to them, which find their entries of K once here, so later refills only send the values.
+     *
+     * @param K a true dof matrix formed from the same lookup tables
+     */
+    TrueDofRefill planTrueDofRefill(mfem::HypreParMatrix& K)
+    {
+      SERAC_MARK_FUNCTION;
+
+      constexpr int plan_tag = 4171;
+
+      const auto& lookup_tables = form_.gradientLookupTables(which_argument);
+
+      MPI_Comm comm = test_space_->GetComm();
+      int      rank, num_ranks;
+      MPI_Comm_rank(comm, &rank);
+      MPI_Comm_size(comm, &num_ranks);
+
+      K.HostRead();
+      hypre_ParCSRMatrix* matrix = K;
+      hypre_CSRMatrix*    diag   = hypre_ParCSRMatrixDiag(matrix);
+      hypre_CSRMatrix*    offd   = hypre_ParCSRMatrixOffd(matrix);
+
+      TrueDofRefill refill;
+      refill.matrix    = &K;
+      refill.csr       = matrix;
+      refill.diag_nnz  = hypre_CSRMatrixNumNonzeros(diag);
+      refill.offd_nnz  = hypre_CSRMatrixNumNonzeros(offd);
+      refill.offd_cols = hypre_CSRMatrixNumCols(offd);
+
+      // the entries of each row of K, sorted by global column, to find the entry of each contribution
+      HYPRE_BigInt  row_begin = hypre_ParCSRMatrixFirstRowIndex(matrix);
+      HYPRE_BigInt  col_begin = hypre_ParCSRMatrixFirstColDiag(matrix);
+      HYPRE_BigInt* col_map   = hypre_ParCSRMatrixColMapOffd(matrix);
+      auto          num_rows  = std::size_t(hypre_CSRMatrixNumRows(diag));
+
+      std::vector<std::size_t> row_entries(num_rows + 1, 0);
+      for (std::size_t r = 0; r < num_rows; r++) {
+        row_entries[r + 1] = row_entries[r] + std::size_t(hypre_CSRMatrixI(diag)[r + 1] - hypre_CSRMatrixI(diag)[r] +
+                                                          hypre_CSRMatrixI(offd)[r + 1] - hypre_CSRMatrixI(offd)[r]);
+      }
+      std::vector<std::pair<HYPRE_BigInt, std::size_t>> entries(row_entries.back());
+      accelerator::forall_host(num_rows, [&](std::size_t r) {
+        std::size_t n = row_entries[r];
+        for (HYPRE_Int k = hypre_CSRMatrixI(diag)[r]; k < hypre_CSRMatrixI(diag)[r + 1]; k++) {
+          entries[n++] = {col_begin + hypre_CSRMatrixJ(diag)[k], std::size_t(k)};
+        }
+        for (HYPRE_Int k = hypre_CSRMatrixI(offd)[r]; k < hypre_CSRMatrixI(offd)[r + 1]; k++) {
+          entries[n++] = {col_map[hypre_CSRMatrixJ(offd)[k]], std::size_t(refill.diag_nnz + k)};
+        }
+        std::sort(entries.begin() + std::ptrdiff_t(row_entries[r]), entries.begin() + std::ptrdiff_t(n));
+      });
+
+      auto entry = [&](HYPRE_BigInt row, HYPRE_BigInt col) {
+        auto r     = std::size_t(row - row_begin);
+        auto begin = entries.begin() + std::ptrdiff_t(row_entries[r]);
+        auto end   = entries.begin() + std::ptrdiff_t(row_entries[r + 1]);
+        auto it    = std::lower_bound(begin, end, std::pair{col, std::size_t(0)});
+        SLIC_ERROR_IF(it == end || it->first != col, "A contribution to the true dof matrix is not part of its "
+                                                     "sparsity pattern");
+        return it->second;
+      };
+
+      // the first row of each rank, to find the owners of the rows of other ranks
+      std::vector<HYPRE_BigInt> row_offsets(std::size_t(num_ranks) + 1);
+      MPI_Allgather(&row_begin, 1, HYPRE_MPI_BIG_INT, row_offsets.data(), 1, HYPRE_MPI_BIG_INT, comm);
+      row_offsets[std::size_t(num_ranks)] = hypre_ParCSRMatrixGlobalNumRows(matrix);
+
+      // every contribution of a local nonzero entry to an entry of K: {entry, source, weight} for those in the rows
+      // of this rank, and {row, column} (with their sources and weights) for each of the other ranks
+      std::vector<std::tuple<std::size_t, nonzero_index, double>> local;
+      std::map<int, std::vector<HYPRE_BigInt>>                    sent_entries;
+      std::map<int, std::vector<std::pair<nonzero_index, double>>> sent_sources;
+
+      ProlongationRows test_rows  = prolongationRows(*test_space_);
+      ProlongationRows trial_rows = prolongationRows(*trial_space_);
+      for (std::size_t i = 0; i < lookup_tables.row_ptr.size() - 1; i++) {
+        for (nonzero_index k = lookup_tables.row_ptr[i]; k < lookup_tables.row_ptr[i + 1]; k++) {
+          auto j = std::size_t(lookup_tables.col_ind[k]);
+          for (auto a = test_rows.offsets[i]; a < test_rows.offsets[i + 1]; a++) {
+            for (auto b = trial_rows.offsets[j]; b < trial_rows.offsets[j + 1]; b++) {
+              HYPRE_BigInt row    = test_rows.tdofs[std::size_t(a)];
+              HYPRE_BigInt col    = trial_rows.tdofs[std::size_t(b)];
+              double       weight = test_rows.weights[std::size_t(a)] * trial_rows.weights[std::size_t(b)];
+              if (row_begin <= row && row < row_offsets[std::size_t(rank) + 1]) {
+                local.push_back({entry(row, col), k, weight});
+              } else {
+                auto next  = std::upper_bound(row_offsets.begin(), row_offsets.end(), row);
+                auto owner = int(next - row_offsets.begin()) - 1;
+                sent_entries[owner].insert(sent_entries[owner].end(), {row, col});
+                sent_sources[owner].push_back({k, weight});
               }
             }
           }
         }
       }
 
-      // Copy the column indices to an auxilliary array as MFEM can mutate these during HypreParMatrix construction
-      col_ind_copy_ = lookup_tables.col_ind;
+      auto unit = [](double weight) { return weight == 1.0; };
 
-      auto J_local =
-          mfem::SparseMatrix(lookup_tables.row_ptr.data(), col_ind_copy_.data(), values, form_.output_L_.Size(),
-                             form_.input_L_[which_argument].Size(), sparse_matrix_frees_graph_ptrs,
-                             sparse_matrix_frees_values_ptr, col_ind_is_sorted);
+      // the contributions to this rank's rows are grouped by entry, so that refills gather each entry independently
+      std::size_t num_entries = std::size_t(refill.diag_nnz + refill.offd_nnz);
+      refill.offsets.assign(num_entries + 1, 0);
+      for (const auto& [d, k, weight] : local) {
+        refill.offsets[d + 1]++;
+      }
+      std::partial_sum(refill.offsets.begin(), refill.offsets.end(), refill.offsets.begin());
+      bool unit_weights = std::all_of(local.begin(), local.end(), [&](const auto& c) { return unit(std::get<2>(c)); });
+      refill.sources.resize(local.size());
+      refill.weights.resize(unit_weights ? 0 : local.size());
+      {
+        std::vector<std::size_t> position(refill.offsets.begin(), refill.offsets.end() - 1);
+        for (const auto& [d, k, weight] : local) {
+          if (!unit_weights) {
+            refill.weights[position[d]] = weight;
+          }
+          refill.sources[position[d]++] = k;
+        }
+      }
 
-      auto* R = form_.test_space_->Dof_TrueDof_Matrix();
+      // each rank learns how many contributions every other one sends it, and which of its entries they go into
+      std::vector<int> send_counts(std::size_t(num_ranks), 0);
+      std::vector<int> receive_counts(std::size_t(num_ranks), 0);
+      for (const auto& [owner, sources] : sent_sources) {
+        send_counts[std::size_t(owner)] = int(sources.size());
+      }
+      MPI_Alltoall(send_counts.data(), 1, MPI_INT, receive_counts.data(), 1, MPI_INT, comm);
+
+      bool unit_send_weights = true;
+      refill.send_offsets.push_back(0);
+      for (const auto& [owner, sources] : sent_sources) {
+        refill.send_ranks.push_back(owner);
+        refill.send_offsets.push_back(refill.send_offsets.back() + sources.size());
+        for (const auto& [k, weight] : sources) {
+          refill.send_sources.push_back(k);
+          refill.send_weights.push_back(weight);
+          unit_send_weights = unit_send_weights && unit(weight);
+        }
+      }
+      if (unit_send_weights) {
+        refill.send_weights.clear();
+      }
+      refill.send_buffer.resize(refill.send_sources.size());
+
+      refill.receive_offsets.push_back(0);
+      for (int r = 0; r < num_ranks; r++) {
+        if (receive_counts[std::size_t(r)] > 0) {
+          refill.receive_ranks.push_back(r);
+          refill.receive_offsets.push_back(refill.receive_offsets.back() + std::size_t(receive_counts[std::size_t(r)]));
+        }
+      }
+      refill.receive_buffer.resize(refill.receive_offsets.back());
+
+      std::vector<HYPRE_BigInt> received_entries(2 * refill.receive_offsets.back());
+      std::vector<MPI_Request>  requests;
+      for (std::size_t n = 0; n < refill.receive_ranks.size(); n++) {
+        requests.emplace_back();
+        MPI_Irecv(&received_entries[2 * refill.receive_offsets[n]],
+                  int(2 * (refill.receive_offsets[n + 1] - refill.receive_offsets[n])), HYPRE_MPI_BIG_INT,
+                  refill.receive_ranks[n], plan_tag, comm, &requests.back());
+      }
+      for (auto& [owner, rows_and_cols] : sent_entries) {
+        requests.emplace_back();
+        MPI_Isend(rows_and_cols.data(), int(rows_and_cols.size()), HYPRE_MPI_BIG_INT, owner, plan_tag, comm,
+                  &requests.back());
+      }
+      MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
 
-      auto* A =
-          new mfem::HypreParMatrix(test_space_->GetComm(), test_space_->GlobalVSize(), trial_space_->GlobalVSize(),
-                                   test_space_->GetDofOffsets(), trial_space_->GetDofOffsets(), &J_local);
+      refill.receive_destinations.resize(refill.receive_offsets.back());
+      for (std::size_t m = 0; m < refill.receive_destinations.size(); m++) {
+        refill.receive_destinations[m] = entry(received_entries[2 * m], received_entries[2 * m + 1]);
+      }
 
-      auto* P = trial_space_->Dof_TrueDof_Matrix();
+      return refill;
+    }
 
-      std::unique_ptr<mfem::HypreParMatrix> K(mfem::RAP(R, A, P));
+    /**
+     * @brief overwrite the values of a true dof matrix with those of the local matrix, see planTrueDofRefill()
+     *
+     * @param refill the plan made for @a K
+     * @param values the values of the local matrix, in the order of the lookup tables' nonzero entries
+     * @param[inout] K the matrix to refill
+     */
+    void refillTrueDofs(TrueDofRefill& refill, const double* values, mfem::HypreParMatrix& K)
+    {
+      SERAC_MARK_FUNCTION;
 
-      delete A;
+      constexpr int refill_tag = 4172;
 
-      return K;
-    };
+      MPI_Comm comm = test_space_->GetComm();
 
-    friend auto assemble(Gradient& g) { return g.assemble(); }
+      // the contributions to the rows of other ranks are sent first, and added in after the local ones
+      std::vector<MPI_Request> requests;
+      for (std::size_t n = 0; n < refill.receive_ranks.size(); n++) {
+        requests.emplace_back();
+        MPI_Irecv(&refill.receive_buffer[refill.receive_offsets[n]],
+                  int(refill.receive_offsets[n + 1] - refill.receive_offsets[n]), MPI_DOUBLE, refill.receive_ranks[n],
+                  refill_tag, comm, &requests.back());
+      }
+      for (std::size_t m = 0; m < refill.send_sources.size(); m++) {
+        double weight         = refill.send_weights.empty() ? 1.0 : refill.send_weights[m];
+        refill.send_buffer[m] = weight * values[refill.send_sources[m]];
+      }
+      for (std::size_t n = 0; n < refill.send_ranks.size(); n++) {
+        requests.emplace_back();
+        MPI_Isend(&refill.send_buffer[refill.send_offsets[n]], int(refill.send_offsets[n + 1] - refill.send_offsets[n]),
+                  MPI_DOUBLE, refill.send_ranks[n], refill_tag, comm, &requests.back());
+      }
 
-  private:
-    /// @brief The "parent" @p Functional to calculate gradients with
-    Functional<test(trials...), exec>& form_;
+      K.HostReadWrite();
+      hypre_ParCSRMatrix* matrix    = K;
+      double*             diag_data = hypre_CSRMatrixData(hypre_ParCSRMatrixDiag(matrix));
+      double*             offd_data = hypre_CSRMatrixData(hypre_ParCSRMatrixOffd(matrix));
+      auto                diag_nnz  = std::size_t(refill.diag_nnz);
+      auto data = [&](std::size_t d) -> double& { return (d < diag_nnz) ? diag_data[d] : offd_data[d - diag_nnz]; };
+
+      accelerator::forall_host(refill.offsets.size() - 1, [&](std::size_t d) {
+        double sum = 0.0;
+        for (std::size_t m = refill.offsets[d]; m < refill.offsets[d + 1]; m++) {
+          sum += (refill.weights.empty() ? 1.0 : refill.weights[m]) * values[refill.sources[m]];
+        }
+        data(d) = sum;
+      });
+
+      MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+      for (std::size_t m = 0; m < refill.receive_destinations.size(); m++) {
+        data(refill.receive_destinations[m]) += refill.receive_buffer[m];
+      }
+    }
+
+    /**
+     * @brief form the true dof matrix by adding each entry of the local matrix into the row and column of its
+     * true dofs through hypre's IJ interface, which sends the rows of true dofs owned by other ranks to them
+     *
+     * Compared to R^T A P, this skips the parallel matrix-matrix products and their temporaries, and the local
+     * matrix is never made into an mfem::SparseMatrix (so it can have more than INT_MAX nonzero entries).
+     *
+     * @param values the values of the local matrix, in the order of the lookup tables' nonzero entries
+     */
+    std::unique_ptr<mfem::HypreParMatrix> assembleTrueDofs(const double* values)
+    {
+      SERAC_MARK_FUNCTION;
+
+      const auto& lookup_tables = form_.gradientLookupTables(which_argument);
+
+      if (test_tdofs_.empty()) {
+        test_tdofs_  = globalTrueDofs(*test_space_);
+        trial_tdofs_ = globalTrueDofs(*trial_space_);
+      }
+
+      HYPRE_BigInt row_begin = test_space_->GetMyTDofOffset();
+      HYPRE_BigInt row_end   = row_begin + test_space_->GetTrueVSize();
+      HYPRE_BigInt col_begin = trial_space_->GetMyTDofOffset();
+      HYPRE_BigInt col_end   = col_begin + trial_space_->GetTrueVSize();
+
+      HYPRE_IJMatrix ij;
+      HYPRE_IJMatrixCreate(test_space_->GetComm(), row_begin, row_end - 1, col_begin, col_end - 1, &ij);
+      HYPRE_IJMatrixSetObjectType(ij, HYPRE_PARCSR);
+
+      // the local rows of each owned true dof bound (most of) its length, and the other local rows are sent away
+      std::vector<HYPRE_Int> row_sizes(std::size_t(row_end - row_begin), 0);
+      HYPRE_Int              off_rank_entries = 0;
+      for (std::size_t r = 0; r < test_tdofs_.size(); r++) {
+        auto entries = HYPRE_Int(lookup_tables.row_ptr[r + 1] - lookup_tables.row_ptr[r]);
+        if (row_begin <= test_tdofs_[r] && test_tdofs_[r] < row_end) {
+          row_sizes[std::size_t(test_tdofs_[r] - row_begin)] += entries;
+        } else {
+          off_rank_entries += entries;
+        }
+      }
+      HYPRE_IJMatrixSetRowSizes(ij, row_sizes.data());
+      HYPRE_IJMatrixSetMaxOffProcElmts(ij, off_rank_entries);
+      HYPRE_IJMatrixInitialize(ij);
+
+      std::vector<HYPRE_BigInt> cols;
+      for (std::size_t r = 0; r < test_tdofs_.size(); r++) {
+        nonzero_index begin = lookup_tables.row_ptr[r];
+        auto          ncols = HYPRE_Int(lookup_tables.row_ptr[r + 1] - begin);
+        if (ncols == 0) {
+          continue;
+        }
+
+        cols.resize(std::size_t(ncols));
+        for (std::size_t k = 0; k < cols.size(); k++) {
+          cols[k] = trial_tdofs_[std::size_t(lookup_tables.col_ind[begin + k])];
+        }
+        HYPRE_IJMatrixAddToValues(ij, 1, &ncols, &test_tdofs_[r], cols.data(), values + begin);
+      }
+      HYPRE_IJMatrixAssemble(ij);
+
+      // keep the ParCSR matrix when destroying the IJ interface to it, like mfem does
+      hypre_ParCSRMatrix* K;
+      HYPRE_IJMatrixGetObject(ij, reinterpret_cast<void**>(&K));
+      HYPRE_IJMatrixSetObjectType(ij, -1);
+      HYPRE_IJMatrixDestroy(ij);
+
+      // hypre's smoothers expect the diagonal entry of each row first
+      if (test_space_ == trial_space_) {
+        hypre_CSRMatrixReorder(hypre_ParCSRMatrixDiag(K));
+      }
+
+      return std::make_unique<mfem::HypreParMatrix>(K);
+    }
+
+    /**
+     * @brief compute the element matrices, and gather them into the values of the local matrix
+     *
+     * @param transposed whether to write the values of the transpose instead, see reassembleTransposeInto()
+     * @return the values, in the order of the lookup tables' nonzero entries
+     */
+    const double* assembleValues(bool transposed = false)
+    {
+      SERAC_MARK_FUNCTION;
+
+      const auto& lookup_tables = form_.gradientLookupTables(which_argument);
+
+      values_.resize(lookup_tables.nnz);
+      double* values = values_.data();
+
+      computeElementGradients();
+
+      // kinds of domains without any integrals have no element matrices, and contribute nothing
+      if (element_gradient_ptrs_.empty()) {
+        for (const auto& [type, geom] : lookup_tables.element_matrix_blocks) {
+          const auto& K_elem = element_gradients_[type];
+          element_gradient_ptrs_.push_back(K_elem.count(geom) ? K_elem.at(geom).data() : nullptr);
+        }
+      }
+      const double* const* K = element_gradient_ptrs_.data();
+
+      // the pattern is symmetric, so entry (i, j) of the transpose is found at entry (j, i)
+      if (transposed && transpose_permutation_.empty()) {
+        transpose_permutation_.resize(lookup_tables.nnz);
+        for (int row = 0; row < int(lookup_tables.row_ptr.size()) - 1; row++) {
+          for (nonzero_index k = lookup_tables.row_ptr[uint32_t(row)]; k < lookup_tables.row_ptr[uint32_t(row) + 1];
+               k++) {
+            transpose_permutation_[k] = lookup_tables(lookup_tables.col_ind[k], row);
+          }
+        }
+      }
+
+      // without precomputed contributions, each element matrix entry is added to the nonzero entry found by a
+      // binary search of its row, one element at a time
+      if (lookup_tables.lookup == GradientLookup::BinarySearch) {
+        SLIC_ERROR_IF(exec == ExecutionSpace::GPU,
+                      "GradientLookup::BinarySearch assembles the element matrices on the host, so it isn't available "
+                      "for functionals that execute on the device");
+
+        const auto* permutation = transposed ? transpose_permutation_.data() : nullptr;
+        untransposed_values_.resize(transposed ? lookup_tables.nnz : 0);
+        double* target = transposed ? untransposed_values_.data() : values;
+        std::fill(target, target + lookup_tables.nnz, 0.0);
+
+        for (std::size_t block = 0; block < lookup_tables.element_matrix_blocks.size(); block++) {
+          if (!K[block]) continue;
+
+          const auto& [type, geom] = lookup_tables.element_matrix_blocks[block];
+          const auto& test_dofs    = form_.G_test_[type]->restrictions.at(geom);
+          const auto& trial_dofs   = form_.G_trial_[type][which_argument]->restrictions.at(geom);
+          auto        test_npe     = test_dofs.nodes_per_elem;
+          auto        trial_npe    = trial_dofs.nodes_per_elem;
+          auto        num_test     = test_npe * test_dofs.components;
+          auto        num_trial    = trial_npe * trial_dofs.components;
+
+          const double* K_block = K[block];
+          for (uint64_t e = 0; e < test_dofs.num_elements; e++) {
+            for (uint64_t i = 0; i < num_trial; i++) {
+              DoF trial_vdof = trial_dofs.GetVDof(trial_dofs.dof_info(e, i % trial_npe), i / trial_npe);
+              for (uint64_t j = 0; j < num_test; j++) {
+                DoF  test_vdof = test_dofs.GetVDof(test_dofs.dof_info(e, j % test_npe), j / test_npe);
+                auto k         = lookup_tables(int(test_vdof.index()), int(trial_vdof.index()));
+                target[k] += test_vdof.sign() * trial_vdof.sign() * K_block[(e * num_trial + i) * num_test + j];
+              }
+            }
+          }
+        }
+
+        if (transposed) {
+          accelerator::forall_host(lookup_tables.nnz, [&](nonzero_index k) { values[k] = target[permutation[k]]; });
+        }
+        return values;
+      }
+
+      // with precomputed contributions, each nonzero entry gathers its own contributions from the element matrices.
+      // Functionals that execute on the device gather there, from copies of the lookup tables, and only the values
+      // are copied back to the host
+      if constexpr (exec == ExecutionSpace::GPU) {
+        if (device_tables_ == nullptr) {
+          device_tables_ = std::make_unique<DeviceTables>(lookup_tables, element_gradient_ptrs_);
+        }
+        if (transposed && device_tables_->transpose_permutation.empty()) {
+          device_tables_->transpose_permutation = accelerator::make_exec_array<exec>(transpose_permutation_);
+          device_tables_->untransposed_values   = ExecArray<double, 1, exec>(axom::IndexType(lookup_tables.nnz));
+        }
+        DeviceTables& device = *device_tables_;
+        gatherNonzeros<exec>(device.view(lookup_tables.gatherTables()), device.element_gradients.data(),
+                             transposed ? device.transpose_permutation.data() : nullptr,
+                             device.untransposed_values.data(), device.values.data());
+        axom::copy(values, device.values.data(), lookup_tables.nnz * sizeof(double));
+      } else {
+        untransposed_values_.resize(transposed && lookup_tables.blocked() ? lookup_tables.nnz : 0);
+        gatherNonzeros<exec>(lookup_tables.gatherTables(), K, transposed ? transpose_permutation_.data() : nullptr,
+                             untransposed_values_.data(), values);
+      }
+
+      return values;
+    }
 
     /**
-     * @brief this object has lookup tables for where to place each
-     *   element and boundary element gradient contribution in the global
-     *   sparse matrix
+     * @brief assemble element matrices into the (block-diagonal) parallel matrix of local dofs
+     *
+     * The first call creates the local mfem::SparseMatrix and mfem::HypreParMatrix, subsequent
+     * calls only overwrite their values, since the sparsity pattern never changes.
+     *
+     * @param transposed whether to write the values of the transpose instead, see reassembleTransposeInto()
      */
-    GradientAssemblyLookupTables lookup_tables;
+    mfem::HypreParMatrix* assembleLocal(bool transposed = false)
+    {
+      // the CSR graph (sparsity pattern) and values are reusable, so we cache
+      // them and ask mfem to not free that memory in ~SparseMatrix()
+      constexpr bool sparse_matrix_frees_graph_ptrs = false;
+      constexpr bool sparse_matrix_frees_values_ptr = false;
+
+      constexpr bool col_ind_is_sorted = true;
+
+      const auto&   lookup_tables = form_.gradientLookupTables(which_argument);
+      const double* values        = assembleValues(transposed);
+
+      if (A_local_ == nullptr) {
+        // the lookup tables may have 64-bit indices (see nonzero_index), but mfem's local sparse matrices don't
+        SLIC_ERROR_IF(lookup_tables.nnz > nonzero_index(std::numeric_limits<int>::max()),
+                      axom::fmt::format("The local gradient has {} nonzero entries, which is more than an "
+                                        "mfem::SparseMatrix can hold, so it must be applied matrix-free (or on more "
+                                        "ranks) instead",
+                                        lookup_tables.nnz));
+
+        // note: depending on the memory configuration, hypre may alias (and reorder) these arrays,
+        // so they are kept separate from the assembly buffer above
+        row_ptr_copy_.resize(lookup_tables.row_ptr.size());
+        for (std::size_t r = 0; r < row_ptr_copy_.size(); r++) {
+          row_ptr_copy_[r] = static_cast<int>(lookup_tables.row_ptr[r]);
+        }
+        col_ind_copy_ = lookup_tables.col_ind;
+        local_values_ = values_;
+
+        J_local_ = std::make_unique<mfem::SparseMatrix>(
+            row_ptr_copy_.data(), col_ind_copy_.data(), local_values_.data(), form_.output_L_.Size(),
+            form_.input_L_[which_argument].Size(), sparse_matrix_frees_graph_ptrs, sparse_matrix_frees_values_ptr,
+            col_ind_is_sorted);
+
+        A_local_ = std::make_unique<mfem::HypreParMatrix>(test_space_->GetComm(), test_space_->GlobalVSize(),
+                                                          trial_space_->GlobalVSize(), test_space_->GetDofOffsets(),
+                                                          trial_space_->GetDofOffsets(), J_local_.get());
+
+        // hypre may reorder the entries of each row (e.g. moving the diagonal to the front),
+        // so record where each of our nonzero entries ended up
+        A_local_->HostRead();
+        hypre_CSRMatrix* diag = hypre_ParCSRMatrixDiag(static_cast<hypre_ParCSRMatrix*>(*A_local_));
+        HYPRE_Int*       I    = hypre_CSRMatrixI(diag);
+        HYPRE_Int*       J    = hypre_CSRMatrixJ(diag);
+        hypre_permutation_.resize(lookup_tables.nnz);
+        for (int row = 0; row < hypre_CSRMatrixNumRows(diag); row++) {
+          for (HYPRE_Int k = I[row]; k < I[row + 1]; k++) {
+            hypre_permutation_[lookup_tables(row, int(J[k]))] = nonzero_index(k);
+          }
+        }
+      } else {
+        A_local_->HostReadWrite();
+        double* data = hypre_CSRMatrixData(hypre_ParCSRMatrixDiag(static_cast<hypre_ParCSRMatrix*>(*A_local_)));
+        for (nonzero_index k = 0; k < lookup_tables.nnz; k++) {
+          data[hypre_permutation_[k]] = values[k];
+        }
+      }
+
+      return A_local_.get();
+    }
+
+    /// @brief The "parent" @p Functional to calculate gradients with
+    Functional<test(trials...), exec>& form_;
+
+    /// @brief Copy of the row offsets for sparse matrix assembly (mfem::SparseMatrix requires a mutable pointer)
+    std::vector<int> row_ptr_copy_;
 
     /**
      * @brief Copy of the column indices for sparse matrix assembly
@@ -677,6 +2725,106 @@ private:
      */
     std::vector<int> col_ind_copy_;
 
+    /// @brief storage for the values of the local sparse matrix, reused between assemblies
+    std::vector<double> values_;
+
+    /// @brief the values of the untransposed local sparse matrix during transposed assemblies with blocked tables
+    std::vector<double> untransposed_values_;
+
+    /// @brief copy of the values used to create J_local_
+    /// @note like col_ind_copy_, these may be mutated by MFEM during HypreParMatrix construction
+    std::vector<double> local_values_;
+
+    /// @brief the local (L-vector to L-vector) sparse matrix, created on the first assembly
+    std::unique_ptr<mfem::SparseMatrix> J_local_;
+
+    /// @brief block-diagonal parallel matrix wrapping J_local_, created on the first assembly
+    std::unique_ptr<mfem::HypreParMatrix> A_local_;
+
+    /// @brief the element matrices of each kind of domain and element geometry, allocated on the first assembly
+    std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients_[Domain::num_types];
+
+    /// @brief the data of the element matrices, in the order of the lookup tables' element_matrix_blocks
+    std::vector<const double*> element_gradient_ptrs_;
+
+    /// @brief the nonzero entry (j, i) for each nonzero entry (i, j), created on the first transposed assembly
+    std::vector<nonzero_index> transpose_permutation_;
+
+    /// @brief copies of the lookup tables (and of the buffers) that assembly gathers from and into on the device
+    struct DeviceTables {
+      /**
+       * @brief copy the lookup tables that gatherNonzeros() reads into device memory
+       * @param tables the lookup tables
+       * @param element_gradients the (device) data of the element matrices of each of the tables' element_matrix_blocks
+       */
+      DeviceTables(const GradientAssemblyLookupTables& tables, const std::vector<const double*>& element_gradients)
+          : contribution_offsets(accelerator::make_exec_array<exec>(tables.contribution_offsets)),
+            contributions(accelerator::make_exec_array<exec>(tables.contributions)),
+            element_matrix_offsets(accelerator::make_exec_array<exec>(tables.element_matrix_offsets)),
+            element_matrix_nodes(accelerator::make_exec_array<exec>(tables.element_matrix_nodes)),
+            element_matrix_strides(accelerator::make_exec_array<exec>(tables.element_matrix_strides)),
+            row_ptr(accelerator::make_exec_array<exec>(tables.row_ptr)),
+            block_row_ptr(accelerator::make_exec_array<exec>(tables.block_row_ptr)),
+            element_gradients(accelerator::make_exec_array<exec>(element_gradients)),
+            values(axom::IndexType(tables.nnz))
+      {
+      }
+
+      /// @brief the @a host tables, with their pointers replaced by those of the device copies
+      GradientGatherTables view(GradientGatherTables host) const
+      {
+        host.contribution_offsets   = contribution_offsets.data();
+        host.contributions          = contributions.data();
+        host.element_matrix_offsets = element_matrix_offsets.data();
+        host.element_matrix_nodes   = element_matrix_nodes.data();
+        host.element_matrix_strides = element_matrix_strides.data();
+        host.row_ptr                = row_ptr.data();
+        host.block_row_ptr          = block_row_ptr.data();
+        return host;
+      }
+
+      /// @brief the number of bytes allocated for the copies
+      std::size_t bytes() const
+      {
+        return std::size_t(contribution_offsets.size()) * sizeof(std::size_t) +
+               std::size_t(contributions.size()) * sizeof(uint32_t) +
+               std::size_t(element_matrix_offsets.size()) * sizeof(std::size_t) +
+               std::size_t(element_matrix_nodes.size()) * sizeof(std::pair<uint32_t, uint32_t>) +
+               std::size_t(element_matrix_strides.size()) * sizeof(std::pair<std::size_t, std::size_t>) +
+               std::size_t(row_ptr.size() + block_row_ptr.size() + transpose_permutation.size()) *
+                   sizeof(nonzero_index) +
+               std::size_t(element_gradients.size()) * sizeof(const double*) +
+               std::size_t(values.size() + untransposed_values.size()) * sizeof(double);
+      }
+
+      ExecArray<std::size_t, 1, exec>                         contribution_offsets;    ///< see the lookup tables
+      ExecArray<uint32_t, 1, exec>                            contributions;           ///< see the lookup tables
+      ExecArray<std::size_t, 1, exec>                         element_matrix_offsets;  ///< see the lookup tables
+      ExecArray<std::pair<uint32_t, uint32_t>, 1, exec>       element_matrix_nodes;    ///< see the lookup tables
+      ExecArray<std::pair<std::size_t, std::size_t>, 1, exec> element_matrix_strides;  ///< see the lookup tables
+      ExecArray<nonzero_index, 1, exec>                       row_ptr;                 ///< see the lookup tables
+      ExecArray<nonzero_index, 1, exec>                       block_row_ptr;           ///< see the lookup tables
+      ExecArray<const double*, 1, exec> element_gradients;      ///< see element_gradient_ptrs_
+      ExecArray<nonzero_index, 1, exec> transpose_permutation;  ///< see transpose_permutation_
+      ExecArray<double, 1, exec>        values;                 ///< the gathered values, copied to values_
+      ExecArray<double, 1, exec>        untransposed_values;    ///< see untransposed_values_
+    };
+
+    /// @brief the device copies of the lookup tables, created on the first assembly of functionals on the device
+    std::unique_ptr<DeviceTables> device_tables_;
+
+    /// @brief the position in A_local_'s hypre storage of each nonzero entry of J_local_
+    std::vector<nonzero_index> hypre_permutation_;
+
+    /// @brief the plans for refilling the true dof matrices of the gradient and its transpose, see planTrueDofRefill()
+    TrueDofRefill true_dof_refills_[2];
+
+    /// @brief the global true dof of each local test dof, for assembleTrueDofs()
+    std::vector<HYPRE_BigInt> test_tdofs_;
+
+    /// @brief the global true dof of each local trial dof, for assembleTrueDofs()
+    std::vector<HYPRE_BigInt> trial_tdofs_;
+
     /**
      * @brief this member variable tells us which argument the associated Functional this gradient
      *  corresponds to:
@@ -711,31 +2859,112 @@ private:
    */
   const mfem::Operator* P_trial_[num_trial_spaces];
 
+  /// @brief the trial spaces' prolongation operators, split so that their halo exchanges can overlap with other work
+  mutable SplitProlongation prolongation_[num_trial_spaces];
+
   /// @brief The input set of local DOF values (i.e., on the current rank)
   mutable mfem::Vector input_L_[num_trial_spaces];
 
-  BlockElementRestriction G_trial_[Domain::num_types][num_trial_spaces];
+  /// @brief the L->E restrictions of each trial space and kind of domain, shared with other Functionals (see
+  /// shared_setup::restriction()). Interior face restrictions are empty until an interior face integral is added.
+  std::shared_ptr<const BlockElementRestriction> G_trial_[Domain::num_types][num_trial_spaces];
 
   mutable std::vector<mfem::BlockVector> input_E_[Domain::num_types];
 
+  /// @brief whether each argument is frozen, see freezeArgument()
+  bool frozen_[num_trial_spaces]{};
+
+  /// @brief whether the quadrature point values of frozen arguments are cached, see cacheFrozenArguments()
+  bool cache_frozen_arguments_ = false;
+
+  /// @brief whether input_L_ holds the values of each argument from the most recent evaluation
+  mutable bool prolongated_[num_trial_spaces]{};
+
+  /// @brief whether input_E_ holds the gathered values of each argument from the most recent evaluation
+  mutable bool gathered_[Domain::num_types][num_trial_spaces]{};
+
   std::vector<Integral> integrals_;
 
   mutable mfem::BlockVector output_E_[Domain::num_types];
 
-  BlockElementRestriction G_test_[Domain::num_types];
+  /// @brief the E->L restrictions of the test space for each kind of domain, see G_trial_
+  std::shared_ptr<const BlockElementRestriction> G_test_[Domain::num_types];
 
   /// @brief The output set of local DOF values (i.e., on the current rank)
   mutable mfem::Vector output_L_;
 
   const mfem::Operator* P_test_;
 
+  /// @brief the test space's prolongation operator, split so that its reduction can overlap with other work
+  mutable SplitProlongation test_prolongation_;
+
   /// @brief The set of true DOF values, a reference to this member is returned by @p operator()
   mutable mfem::Vector output_T_;
 
+  /// @brief The true DOF values of each evaluation, a reference to this member is returned by EvaluateBatch()
+  mfem::DenseMatrix batch_output_T_;
+
+  /**
+   * @brief lookup tables for where to place each element and boundary element gradient
+   *   contribution in the global sparse matrix, for each trial argument. These are created
+   *   on the first assembly and shared with other arguments and Functionals with equivalent restrictions
+   */
+  std::shared_ptr<const GradientAssemblyLookupTables> lookup_tables_[num_trial_spaces];
+
+  /// @brief how the gradients find the nonzero entries of the element matrix entries, see setGradientLookup()
+  GradientLookup gradient_lookup_ = GradientLookup::Precomputed;
+
   /// @brief The objects representing the gradients w.r.t. each input argument of the Functional
   mutable std::vector<Gradient> grad_;
+
+  /// @brief whether the gradients re-evaluate the q-functions of domain integrals, see recomputeDerivatives()
+  bool recompute_derivatives_ = false;
+
+  /// @brief the time of the most recent evaluation with differentiation, when recomputing derivatives
+  double linearization_time_ = 0.0;
+
+  /// @brief the inputs (E-vectors) of the most recent evaluation with differentiation, when recomputing derivatives
+  std::vector<mfem::BlockVector> linearization_E_;
+
+  /// @brief the number of elements in each tile of the domain integral evaluations (0 for none), see
+  /// setElementTileSize()
+  uint32_t tile_size_ = 0;
+
+  /// @brief the elements of each kind of domain that the integrals are evaluated on, see selection()
+  mutable ElementSelection selections_[Domain::num_types];
+
+  /// @brief the number of integrals when selections_ was last made, see selection()
+  mutable std::size_t selected_integrals_ = 0;
+
+  /// @brief whether the kernels of different integrals and geometries run concurrently, see concurrentIntegrals()
+  bool concurrent_integrals_ = false;
+
+  /// @brief whether the number of elements in each tile is tuned separately for each kernel, see
+  /// autotuneElementTileSize()
+  bool autotune_tile_size_ = false;
+
+  /// @brief the file that the tuned tile sizes are read from and saved into, if any
+  std::string tile_size_file_;
+
+  /// @brief whether the tuned tile sizes have been saved into tile_size_file_
+  mutable bool tile_sizes_saved_ = false;
+
+  /// @brief the tile-sized E-vectors of the tiled evaluations of domain integrals, which Integral::TiledMult() only
+  /// reads and writes on the host
+  mutable std::vector<mfem::Vector> tile_E_;
+
+  /// @brief the L-vector of each trial space, as passed to Integral::TiledMult() in every tiled evaluation, which reads
+  /// them on the host
+  std::vector<const mfem::Vector*> tiled_input_L_;
+
+  /// @brief the element restriction of each trial space, as passed to Integral::TiledMult() in every tiled evaluation
+  std::vector<const BlockElementRestriction*> tiled_restrictions_;
+
+  /// @brief whether the E-vectors of the elements were released by setElementTileSize()
+  mutable bool element_vectors_released_ = false;
 };
 
 }  // namespace serac
 
 #include "functional_qoi.inl"
+#include "functional_multiple_tests.inl"
@@ -0,0 +1,449 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file functional_multiple_tests.inl
+ *
+ * @brief a specialization of serac::Functional with several test spaces, for evaluating coupled residuals together
+ */
+
+namespace serac {
+
+namespace detail {
+
+/// @brief the type of the entries of a q-function output: `zero`, double, a dual number, or a tensor of them
+template <typename T>
+struct entry_type {
+  using type = T;  ///< the output itself is a scalar
+};
+
+/// @overload
+template <typename T, int... n>
+struct entry_type<tensor<T, n...>> {
+  using type = T;  ///< the type of the entries of the tensor
+};
+
+/**
+ * @brief stacks the q-function outputs of several H1 test spaces into the output of a single H1 space with all of
+ * their components, e.g. a scalar source and a vector source into one vector, or a heat flux and a stress into the
+ * rows of one matrix
+ *
+ * @tparam tests the test spaces, in the order of their components in the stacked output
+ */
+template <typename... tests>
+struct stacked_test_spaces {
+  /// @brief the number of components of each test space
+  static constexpr int num_components[] = {tests::components...};
+
+  /// @brief the number of components of all of the test spaces together
+  static constexpr int components = (tests::components + ...);
+
+  /// @brief the first component of the @a k-th test space in the stacked output
+  template <int k>
+  static constexpr int offset()
+  {
+    int total = 0;
+    for (int i = 0; i < k; i++) {
+      total += num_components[i];
+    }
+    return total;
+  }
+
+  /// @brief write the source of a test space with @a c components into entries [first, first + c) of @a stacked
+  template <int first, int c, typename S, typename T>
+  SERAC_HOST_DEVICE static void insert_source(tensor<S, components>& stacked, const T& source)
+  {
+    if constexpr (!is_zero<T>{}) {
+      if constexpr (c == 1) {
+        stacked[first] = source;
+      } else {
+        for (int i = 0; i < c; i++) {
+          stacked[first + i] = source[i];
+        }
+      }
+    }
+  }
+
+  /// @brief write the flux of a test space with @a c components into rows [first, first + c) of @a stacked
+  template <int first, int c, typename S, int dim, typename T>
+  SERAC_HOST_DEVICE static void insert_flux(tensor<S, components, dim>& stacked, const T& flux)
+  {
+    if constexpr (!is_zero<T>{}) {
+      for (int j = 0; j < dim; j++) {
+        if constexpr (c == 1) {
+          stacked[first][j] = flux[j];
+        } else {
+          for (int i = 0; i < c; i++) {
+            stacked[first + i][j] = flux[i][j];
+          }
+        }
+      }
+    }
+  }
+
+  /// @brief stack the sources (or boundary integrand values) of each test space
+  template <typename... T, int... k>
+  SERAC_HOST_DEVICE static auto sources(const serac::tuple<T...>& values, std::integer_sequence<int, k...>)
+  {
+    using entries = decltype((std::declval<typename entry_type<T>::type>() + ...));
+    if constexpr (is_zero<entries>{}) {
+      return zero{};
+    } else {
+      tensor<entries, components> stacked{};
+      (insert_source<offset<k>(), num_components[k]>(stacked, get<k>(values)), ...);
+      return stacked;
+    }
+  }
+
+  /// @brief stack the fluxes of each test space
+  template <int dim, typename... T, int... k>
+  SERAC_HOST_DEVICE static auto fluxes(const serac::tuple<T...>& values, std::integer_sequence<int, k...>)
+  {
+    using entries = decltype((std::declval<typename entry_type<T>::type>() + ...));
+    if constexpr (is_zero<entries>{}) {
+      return zero{};
+    } else {
+      tensor<entries, components, dim> stacked{};
+      (insert_flux<offset<k>(), num_components[k]>(stacked, get<k>(values)), ...);
+      return stacked;
+    }
+  }
+
+  /// @brief stack the {source, flux} outputs of a domain integrand, one for each test space
+  template <int dim, typename... T, int... k>
+  SERAC_HOST_DEVICE static auto domain_output(const serac::tuple<T...>& per_test, std::integer_sequence<int, k...> seq)
+  {
+    static_assert(sizeof...(T) == sizeof...(tests), "domain integrands must return one {source, flux} per test space");
+    return serac::tuple{sources(serac::tuple{get<0>(get<k>(per_test))...}, seq),
+                        fluxes<dim>(serac::tuple{get<1>(get<k>(per_test))...}, seq)};
+  }
+
+  /// @brief stack the outputs of a boundary integrand, one for each test space
+  template <typename... T>
+  SERAC_HOST_DEVICE static auto boundary_output(const serac::tuple<T...>& per_test)
+  {
+    static_assert(sizeof...(T) == sizeof...(tests), "boundary integrands must return one value per test space");
+    return sources(per_test, std::make_integer_sequence<int, int(sizeof...(tests))>{});
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief A Functional with several test spaces, e.g. the coupled thermal and mechanical residuals of
+ * thermomechanics, which are evaluated together in a single pass over the elements
+ *
+ * Each q-function returns one output for each test space, so a material model that both residuals depend on is
+ * only evaluated once per quadrature point:
+ * @code{.cpp}
+ * Functional<tuple<H1<p>, H1<p, dim>>(H1<p>, H1<p, dim>)> residual({&thermal_fes, &solid_fes},
+ *                                                                 {&thermal_fes, &solid_fes});
+ * residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1>{}, [](double t, auto X, auto T, auto u) {
+ *   auto [heat_source, heat_flux, stress] = material(T, u);
+ *   return serac::tuple{serac::tuple{heat_source, heat_flux}, serac::tuple{zero{}, stress}};
+ * }, mesh);
+ *
+ * mfem::BlockVector& r = residual(t, T, u);                    // one block for each test space
+ * auto [r, dr_dT]      = residual(t, differentiate_wrt(T), u);
+ * auto [J_TT, J_uT]    = assemble(dr_dT);                     // one block of the Jacobian for each test space
+ * @endcode
+ *
+ * Boundary integrands return one value for each test space, in the same way.
+ *
+ * The test spaces are stacked into a single H1 space with all of their components, so they must be H1 spaces of
+ * the same order, ordered by nodes, on the same mesh. The true dofs of that space are the true dofs of each test
+ * space in turn, so the residual is evaluated without any copies or permutations. Each gradient is assembled once
+ * for all of the test spaces, and then split into the blocks of each test space.
+ *
+ * @tparam tests The spaces of test functions to use
+ * @tparam trials The spaces of trial functions to use
+ * @tparam exec whether to carry out calculations on CPU or GPU
+ */
+template <typename... tests, typename... trials, ExecutionSpace exec>
+class Functional<serac::tuple<tests...>(trials...), exec> {
+  static constexpr uint32_t num_test_spaces  = sizeof...(tests);
+  static constexpr uint32_t num_trial_spaces = sizeof...(trials);
+  static constexpr int      order            = std::max({tests::order...});
+
+  static_assert(num_test_spaces > 1, "Functionals with a single test space are not written with a tuple");
+  static_assert(((tests::family == Family::H1) && ...), "Functionals with several test spaces only support H1");
+  static_assert(((tests::order == order) && ...), "The test spaces of a Functional must have the same order");
+
+  using stack = detail::stacked_test_spaces<tests...>;
+
+  /// @brief the test space of the underlying Functional, with the components of all of the test spaces
+  using stacked_test = H1<order, stack::components>;
+
+public:
+  /**
+   * @brief the gradient w.r.t. one of the trial spaces, whose action maps to (and whose assembly is split into)
+   * the blocks of each test space
+   */
+  class Gradient : public mfem::Operator {
+  public:
+    /// @brief point to the gradient of the underlying Functional, after it has been evaluated
+    template <typename gradient_type>
+    void bind(gradient_type& df, const std::array<mfem::HypreParMatrix*, num_test_spaces>& selections)
+    {
+      height     = df.Height();
+      width      = df.Width();
+      df_        = &df;
+      assemble_  = [&df]() { return df.assemble(); };
+      selection_ = selections;
+    }
+
+    /// @brief the action of the gradient on @a dx, with the blocks of each test space in @a df, see offsets()
+    void Mult(const mfem::Vector& dx, mfem::Vector& df) const override { df_->Mult(dx, df); }
+
+    /// @brief the action of the transpose of the gradient
+    void MultTranspose(const mfem::Vector& df, mfem::Vector& dx) const override { df_->MultTranspose(df, dx); }
+
+    /// @brief assemble the gradient, and return its block for each test space
+    std::array<std::unique_ptr<mfem::HypreParMatrix>, num_test_spaces> assemble()
+    {
+      SLIC_ERROR_ROOT_IF(!df_, "Gradients can only be assembled after they are evaluated");
+
+      auto stacked = assemble_();
+
+      // each block is the product of a selection of the stacked rows with the stacked gradient
+      std::array<std::unique_ptr<mfem::HypreParMatrix>, num_test_spaces> blocks;
+      for (uint32_t k = 0; k < num_test_spaces; k++) {
+        blocks[k].reset(mfem::ParMult(selection_[k], stacked.get(), true));
+      }
+      return blocks;
+    }
+
+    /// @brief assemble the blocks of the gradient for each test space, see Gradient::assemble()
+    friend auto assemble(Gradient& g) { return g.assemble(); }
+
+  private:
+    /// @brief the gradient of the underlying Functional
+    mfem::Operator* df_ = nullptr;
+
+    /// @brief assembles the gradient of the underlying Functional
+    std::function<std::unique_ptr<mfem::HypreParMatrix>()> assemble_;
+
+    /// @brief the rows of the stacked test space that belong to each test space
+    std::array<mfem::HypreParMatrix*, num_test_spaces> selection_{};
+  };
+
+private:
+  // clang-format off
+  template <uint32_t i>
+  struct operator_paren_return {
+    using type = typename std::conditional<
+        i == NO_DIFFERENTIATION,                     // if `i` indicates that we want to skip differentiation
+        mfem::BlockVector&,                          // we just return the value
+        serac::tuple<mfem::BlockVector&, Gradient&>  // otherwise we return the value and the derivative w.r.t arg `i`
+        >::type;
+  };
+  // clang-format on
+
+public:
+  /**
+   * @brief Constructs using @p mfem::ParFiniteElementSpace objects corresponding to the test/trial spaces
+   * @param[in] test_fes The test spaces, which must share their mesh and finite element collection
+   * @param[in] trial_fes The trial spaces
+   */
+  Functional(std::array<const mfem::ParFiniteElementSpace*, num_test_spaces>  test_fes,
+             std::array<const mfem::ParFiniteElementSpace*, num_trial_spaces> trial_fes)
+      : offsets_(int(num_test_spaces) + 1)
+  {
+    auto* mesh = test_fes[0]->GetParMesh();
+    auto* fec  = test_fes[0]->FEColl();
+
+    offsets_[0] = 0;
+    for (uint32_t k = 0; k < num_test_spaces; k++) {
+      SLIC_ERROR_ROOT_IF(test_fes[k]->GetParMesh() != mesh || std::string(test_fes[k]->FEColl()->Name()) != fec->Name(),
+                         "The test spaces of a Functional must share their mesh and finite element collection");
+      SLIC_ERROR_ROOT_IF(test_fes[k]->GetVDim() != stack::num_components[k] ||
+                             test_fes[k]->GetOrdering() != mfem::Ordering::byNODES,
+                         "The test spaces of a Functional must match their tags, and be ordered by nodes");
+      offsets_[k + 1] = offsets_[k] + test_fes[k]->GetTrueVSize();
+    }
+
+    stacked_fes_ =
+        std::make_unique<mfem::ParFiniteElementSpace>(mesh, fec, stack::components, mfem::Ordering::byNODES);
+    SLIC_ERROR_ROOT_IF(stacked_fes_->GetTrueVSize() != offsets_[num_test_spaces],
+                       "The true dofs of the stacked test space do not match those of the test spaces");
+
+    functional_ = std::make_unique<Functional<stacked_test(trials...), exec>>(stacked_fes_.get(), trial_fes);
+
+    // the matrices that select the rows of each test space from the stacked rows, which are all local
+    for (uint32_t k = 0; k < num_test_spaces; k++) {
+      int rows = offsets_[k + 1] - offsets_[k];
+
+      selection_diag_[k] = std::make_unique<mfem::SparseMatrix>(rows, stacked_fes_->GetTrueVSize());
+      for (int r = 0; r < rows; r++) {
+        selection_diag_[k]->Set(r, offsets_[k] + r, 1.0);
+      }
+      selection_diag_[k]->Finalize();
+
+      selection_[k] = std::make_unique<mfem::HypreParMatrix>(
+          mesh->GetComm(), test_fes[k]->GlobalTrueVSize(), stacked_fes_->GlobalTrueVSize(),
+          test_fes[k]->GetTrueDofOffsets(), stacked_fes_->GetTrueDofOffsets(), selection_diag_[k].get());
+    }
+
+    grad_.resize(num_trial_spaces);
+  }
+
+  /**
+   * @brief Adds a domain integral term to the weak formulation of the PDE
+   *
+   * @param[in] integrand The user-provided quadrature function, which returns a serac::tuple of {source, flux}
+   * for each test space (see @p Integral for the arguments)
+   * @param[in] domain The domain on which to evaluate the integral
+   * @param[inout] qdata The data for each quadrature point
+   *
+   * @see Functional::AddDomainIntegral
+   */
+  template <int dim, int... args, typename lambda, typename domain_type, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, domain_type& domain,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    constexpr int q = std::max({tests::order..., trials::order...}) + 1;
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<q>{}, integrand, domain, qdata);
+  }
+
+  /// @brief Adds a domain integral term that uses @a q quadrature points per dimension, see AddDomainIntegral()
+  template <int dim, int... args, int q, typename lambda, typename domain_type, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                         domain_type& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    constexpr auto seq = std::make_integer_sequence<int, int(num_test_spaces)>{};
+    if constexpr (std::is_same_v<qpt_data_type, Nothing>) {
+      functional_->AddDomainIntegral(
+          Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<q>{},
+          [integrand, seq](double t, auto x, auto... qfunc_args) {
+            return stack::template domain_output<dim>(integrand(t, x, qfunc_args...), seq);
+          },
+          domain, qdata);
+    } else {
+      functional_->AddDomainIntegral(
+          Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<q>{},
+          [integrand, seq](double t, auto x, auto& state, auto... qfunc_args) {
+            return stack::template domain_output<dim>(integrand(t, x, state, qfunc_args...), seq);
+          },
+          domain, qdata);
+    }
+  }
+
+  /**
+   * @brief Adds a boundary integral term to the weak formulation of the PDE
+   *
+   * @param[in] integrand The user-provided quadrature function, which returns a serac::tuple of one value for each
+   * test space (see @p Integral for the arguments)
+   * @param[in] domain The domain on which to evaluate the integral
+   *
+   * @see Functional::AddBoundaryIntegral
+   */
+  template <int dim, int... args, typename lambda, typename domain_type>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, domain_type& domain)
+  {
+    functional_->AddBoundaryIntegral(
+        Dimension<dim>{}, DependsOn<args...>{},
+        [integrand](double t, auto x, auto... qfunc_args) {
+          return stack::boundary_output(integrand(t, x, qfunc_args...));
+        },
+        domain);
+  }
+
+  /**
+   * @brief evaluate the residuals of every test space, and optionally their derivatives w.r.t. one argument
+   *
+   * @param t the time
+   * @param args the trial space dofs used to carry out the calculation,
+   *  at most one of which may be of the type `differentiate_wrt_this(mfem::Vector)`
+   *
+   * @return the residuals, with one block for each test space, or a tuple of them and the Gradient
+   */
+  template <uint32_t wrt, typename... T>
+  typename operator_paren_return<wrt>::type operator()(DifferentiateWRT<wrt>, double t, const T&... args)
+  {
+    if constexpr (wrt == NO_DIFFERENTIATION) {
+      mfem::Vector& value = (*functional_)(DifferentiateWRT<wrt>{}, t, args...);
+      output_.Update(value.GetData(), offsets_);
+      return output_;
+    }
+    if constexpr (wrt != NO_DIFFERENTIATION) {
+      auto value_and_gradient = (*functional_)(DifferentiateWRT<wrt>{}, t, args...);
+      output_.Update(get<0>(value_and_gradient).GetData(), offsets_);
+      grad_[wrt].bind(get<1>(value_and_gradient), selections());
+      return {output_, grad_[wrt]};
+    }
+  }
+
+  /// @overload
+  template <typename... T>
+  auto operator()(double t, const T&... args)
+  {
+    constexpr int num_differentiated_arguments = (std::is_same_v<T, differentiate_wrt_this> + ...);
+    static_assert(num_differentiated_arguments <= 1,
+                  "Error: Functional::operator() can only differentiate w.r.t. 1 argument a time");
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: Functional::operator() must take exactly as many arguments as trial spaces");
+
+    [[maybe_unused]] constexpr uint32_t i = index_of_differentiation<T...>();
+
+    return (*this)(DifferentiateWRT<i>{}, t, args...);
+  }
+
+  /// @brief evaluate the residuals of every test space into @a output_T, see Functional::evaluateInto()
+  template <typename... T>
+  void evaluateInto(mfem::Vector& output_T, double t, const T&... args)
+  {
+    functional_->evaluateInto(output_T, t, args...);
+  }
+
+  /// @brief the offsets of the true dofs of each test space in the residual
+  const mfem::Array<int>& offsets() const { return offsets_; }
+
+  /// @brief A flag to update the quadrature data for this operator following the computation
+  void updateQdata(bool update_flag) { functional_->updateQdata(update_flag); }
+
+  /// @brief update the integrals after the mesh nodes have moved, see Functional::updateGeometry()
+  void updateGeometry() { functional_->updateGeometry(); }
+
+  /// @brief the number of integrals added to this Functional
+  std::size_t numIntegrals() const { return functional_->numIntegrals(); }
+
+  /// @brief the bytes of memory used on this rank by component, see Functional::memoryUsage()
+  memory::Usage memoryUsage() const { return functional_->memoryUsage(); }
+
+private:
+  /// @brief the selection matrices of each test space, see Gradient::assemble()
+  std::array<mfem::HypreParMatrix*, num_test_spaces> selections() const
+  {
+    std::array<mfem::HypreParMatrix*, num_test_spaces> pointers;
+    for (uint32_t k = 0; k < num_test_spaces; k++) {
+      pointers[k] = selection_[k].get();
+    }
+    return pointers;
+  }
+
+  /// @brief the space with the components of all of the test spaces
+  std::unique_ptr<mfem::ParFiniteElementSpace> stacked_fes_;
+
+  /// @brief the Functional with the stacked test space that evaluates all of the integrals
+  std::unique_ptr<Functional<stacked_test(trials...), exec>> functional_;
+
+  /// @brief the offsets of the true dofs of each test space in the stacked true dofs
+  mfem::Array<int> offsets_;
+
+  /// @brief a view of the residual of the underlying Functional, split into the blocks of each test space
+  mfem::BlockVector output_;
+
+  /// @brief the local parts of the selection matrices, which outlive the matrices that refer to them
+  std::array<std::unique_ptr<mfem::SparseMatrix>, num_test_spaces> selection_diag_;
+
+  /// @brief the matrices that select the rows of each test space from the stacked rows
+  std::array<std::unique_ptr<mfem::HypreParMatrix>, num_test_spaces> selection_;
+
+  /// @brief the gradients w.r.t. each trial space
+  std::vector<Gradient> grad_;
+};
+
+}  // namespace serac
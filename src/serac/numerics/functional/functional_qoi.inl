@@ -87,7 +87,7 @@ public:
   {
     auto* mesh = trial_fes[0]->GetMesh();
 
-    auto mem_type = mfem::Device::GetMemoryType();
+    auto mem_type = workspace_memory_type<exec>();
 
     for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
       input_E_[type].resize(num_trial_spaces);
@@ -96,19 +96,19 @@ public:
     for (uint32_t i = 0; i < num_trial_spaces; i++) {
       P_trial_[i] = trial_space_[i]->GetProlongationMatrix();
 
-      input_L_[i].SetSize(P_trial_[i]->Height(), mfem::Device::GetMemoryType());
+      input_L_[i].SetSize(P_trial_[i]->Height(), mem_type);
 
       for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
         if (type == Domain::Type::Elements) {
-          G_trial_[type][i] = BlockElementRestriction(trial_fes[i]);
+          G_trial_[type][i] = shared_setup::restriction(trial_fes[i]);
         } else {
-          G_trial_[type][i] = BlockElementRestriction(trial_fes[i], FaceType::BOUNDARY);
+          G_trial_[type][i] = shared_setup::restriction(trial_fes[i], FaceType::BOUNDARY);
         }
 
         // note: we have to use "Update" here, as mfem::BlockVector's
         // copy assignment ctor (operator=) doesn't let you make changes
         // to the block size
-        input_E_[type][i].Update(G_trial_[type][i].bOffsets(), mem_type);
+        input_E_[type][i].Update(G_trial_[type][i]->bOffsets(), mem_type);
       }
     }
 
@@ -159,6 +159,26 @@ public:
   template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, mfem::Mesh& mesh,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, mesh, qdata);
+  }
+
+  /// @overload
+  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, Domain& domain,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain, qdata);
+  }
+
+  /**
+   * @brief Adds a domain integral term that uses @a q quadrature points per dimension, rather than
+   * the default of max(test::order, trials::order...) + 1
+   * @note any quadrature data must be sized for num_quadrature_points(geom, q) points per element
+   */
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                         mfem::Mesh& mesh, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (mesh.GetNE() == 0) return;
 
@@ -168,14 +188,14 @@ public:
     check_for_missing_nodal_gridfunc(mesh);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(EntireDomain(mesh), integrand, qdata, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeDomainIntegral<signature, q, dim, exec>(EntireDomain(mesh), integrand, qdata,
+                                                                     std::vector<uint32_t>{args...}));
   }
 
   /// @overload
-  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
-  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, Domain& domain,
-                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                         Domain& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
     if (domain.mesh_.GetNE() == 0) return;
 
@@ -186,7 +206,7 @@ public:
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
     integrals_.push_back(
-        MakeDomainIntegral<signature, Q, dim>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+        MakeDomainIntegral<signature, q, dim, exec>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -202,6 +222,24 @@ public:
    */
   template <int dim, int... args, typename lambda, typename qpt_data_type = void>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, mfem::Mesh& mesh)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, mesh);
+  }
+
+  /// @overload
+  template <int dim, int... args, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, const Domain& domain)
+  {
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain);
+  }
+
+  /**
+   * @brief Adds a boundary integral term that uses @a q quadrature points per dimension, rather than
+   * the default of max(test::order, trials::order...) + 1
+   */
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                           mfem::Mesh& mesh)
   {
     auto num_bdr_elements = mesh.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -209,13 +247,14 @@ public:
     check_for_missing_nodal_gridfunc(mesh);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(
-        MakeBoundaryIntegral<signature, Q, dim>(EntireBoundary(mesh), integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(MakeBoundaryIntegral<signature, q, dim, exec>(EntireBoundary(mesh), integrand,
+                                                                       std::vector<uint32_t>{args...}));
   }
 
   /// @overload
-  template <int dim, int... args, typename lambda>
-  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, const Domain& domain)
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                           const Domain& domain)
   {
     auto num_bdr_elements = domain.mesh_.GetNBE();
     if (num_bdr_elements == 0) return;
@@ -225,7 +264,8 @@ public:
     check_for_missing_nodal_gridfunc(domain.mesh_);
 
     using signature = test(decltype(serac::type<args>(trial_spaces))...);
-    integrals_.push_back(MakeBoundaryIntegral<signature, Q, dim>(domain, integrand, std::vector<uint32_t>{args...}));
+    integrals_.push_back(
+        MakeBoundaryIntegral<signature, q, dim, exec>(domain, integrand, std::vector<uint32_t>{args...}));
   }
 
   /**
@@ -289,18 +329,27 @@ public:
     // to avoid doing them more than once per trial space
     bool already_computed[Domain::num_types]{};  // default initializes to `false`
 
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+      output_E_[type] = 0.0;
+    }
+
     for (auto& integral : integrals_) {
       auto type = integral.domain_.type_;
 
       if (!already_computed[type]) {
-        G_trial_[type][which].Gather(input_L_[which], input_E_[type][which]);
+        G_trial_[type][which]->Gather(input_L_[which], input_E_[type][which]);
         already_computed[type] = true;
       }
 
+      // each integral accumulates its contributions into the E-vector for its kind of domain
       integral.GradientMult(input_E_[type][which], output_E_[type], which);
+    }
 
-      // scatter-add to compute residuals on the local processor
-      G_test_.ScatterAdd(output_E_[type], output_L_);
+    // scatter-add to compute residuals on the local processor (once per kind of domain, rather than once per integral)
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+      if (already_computed[type]) {
+        G_test_.ScatterAdd(output_E_[type], output_L_);
+      }
     }
 
     // scatter-add to compute global residuals
@@ -335,21 +384,37 @@ public:
     // to avoid doing them more than once
     bool already_computed[Domain::num_types][num_trial_spaces]{};  // default initializes to `false`
 
+    // this is used to mark which kinds of domains have integrals that contributed to output_E_
+    bool has_output[Domain::num_types]{};  // default initializes to `false`
+
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+      output_E_[type] = 0.0;
+    }
+
     for (auto& integral : integrals_) {
       auto type = integral.domain_.type_;
 
       for (auto i : integral.active_trial_spaces_) {
         if (!already_computed[type][i]) {
-          G_trial_[type][i].Gather(input_L_[i], input_E_[type][i]);
+          G_trial_[type][i]->Gather(input_L_[i], input_E_[type][i]);
           already_computed[type][i] = true;
         }
       }
 
+      // the derivative kernels are created the first time an argument is differentiated
+      integral.GenerateDerivativeKernels(wrt);
+
+      // each integral accumulates its contributions into the E-vector for its kind of domain
       const bool update_state = false;
       integral.Mult(t, input_E_[type], output_E_[type], wrt, update_state);
+      has_output[type] = true;
+    }
 
-      // scatter-add to compute residuals on the local processor
-      G_test_.ScatterAdd(output_E_[type], output_L_);
+    // scatter-add to compute residuals on the local processor (once per kind of domain, rather than once per integral)
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+      if (has_output[type]) {
+        G_test_.ScatterAdd(output_E_[type], output_L_);
+      }
     }
 
     // scatter-add to compute global residuals
@@ -431,7 +496,7 @@ private:
 
       for (auto& integral : form_.integrals_) {
         auto& K_elem             = element_gradients[integral.domain_.type_];
-        auto& trial_restrictions = form_.G_trial_[integral.domain_.type_][which_argument].restrictions;
+        auto& trial_restrictions = form_.G_trial_[integral.domain_.type_][which_argument]->restrictions;
 
         if (K_elem.empty()) {
           for (auto& [geom, trial_restriction] : trial_restrictions) {
@@ -447,7 +512,7 @@ private:
 
       for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
         auto& K_elem             = element_gradients[type];
-        auto& trial_restrictions = form_.G_trial_[type][which_argument].restrictions;
+        auto& trial_restrictions = form_.G_trial_[type][which_argument]->restrictions;
 
         if (!K_elem.empty()) {
           for (auto [geom, elem_matrices] : K_elem) {
@@ -503,7 +568,8 @@ private:
   /// @brief The input set of local DOF values (i.e., on the current rank)
   mutable mfem::Vector input_L_[num_trial_spaces];
 
-  BlockElementRestriction G_trial_[Domain::num_types][num_trial_spaces];
+  /// @brief the L->E restrictions of each trial space and kind of domain, see shared_setup::restriction()
+  std::shared_ptr<const BlockElementRestriction> G_trial_[Domain::num_types][num_trial_spaces];
 
   mutable std::vector<mfem::BlockVector> input_E_[Domain::num_types];
 
@@ -1,4 +1,12 @@
 #include "serac/numerics/functional/geometric_factors.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
 #include "serac/numerics/functional/finite_element.hpp"
 
 namespace serac {
@@ -9,13 +17,14 @@ namespace serac {
  * @tparam function_space the polynomial order and kind of function space used to interpolate
  * @tparam geom the element geometry
  * @param positions_q (output) the positions for each quadrature point
- * @param jacobians_q (output) the jacobians for each quadrature point
+ * @param jacobians_q (output) the jacobians for each quadrature point of the elements in `which`, in that order
  * @param positions_e (input) the "e-vector" of position data
  * @param elements (input) the list of element indices that are part of this domain
+ * @param which (input) the positions in `elements` of the elements to compute the factors of
  */
 template <int Q, mfem::Geometry::Type geom, typename function_space>
 void compute_geometric_factors(mfem::Vector& positions_q, mfem::Vector& jacobians_q, const mfem::Vector& positions_e,
-                               const std::vector<int>& elements)
+                               const std::vector<int>& elements, const std::vector<uint32_t>& which)
 {
   static constexpr TensorProductQuadratureRule<Q> rule{};
 
@@ -31,10 +40,11 @@ void compute_geometric_factors(mfem::Vector& positions_q, mfem::Vector& jacobian
   auto J_q = reinterpret_cast<jacobian_type*>(jacobians_q.ReadWrite());
   auto X   = reinterpret_cast<const typename element_type::dof_type*>(positions_e.Read());
 
-  std::size_t num_elements = elements.size();
+  // for each of the requested elements in the domain. Each element writes only to its own factors, so this is
+  // threaded, which also places X_q and J_q on the NUMA nodes of the threads that process their elements later
+  accelerator::forall_host(uint32_t(which.size()), [&](uint32_t k) {
+    uint32_t e = which[k];
 
-  // for each element in the domain
-  for (uint32_t e = 0; e < num_elements; e++) {
     // load the positions for the nodes in this element
     auto X_e = X[elements[e]];
 
@@ -47,49 +57,76 @@ void compute_geometric_factors(mfem::Vector& positions_q, mfem::Vector& jacobian
       for (int i = 0; i < spatial_dim; i++) {
         X_q[e](i, q) = value[i];
         if constexpr (std::is_same_v<decltype(value), decltype(gradient)>) {
-          J_q[e](0, i, q) = gradient[i];
+          J_q[k](0, i, q) = gradient[i];
         }
         if constexpr (!std::is_same_v<decltype(value), decltype(gradient)>) {
           for (int j = 0; j < geometry_dim; j++) {
-            J_q[e](j, i, q) = gradient(i, j);
+            J_q[k](j, i, q) = gradient(i, j);
           }
         }
       }
     }
-  }
+  });
 }
 
-GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g)
+/**
+ * @brief the smallest distance between opposite faces of the parallelepipeds spanned by the jacobians
+ * @tparam dim the dimension of the elements and the space they are embedded in
+ * @param jacobians the jacobians at each quadrature point, in the layout of GeometricFactors::J
+ * @param qpts_per_elem the number of quadrature points per element
+ * @param num_elements the number of elements
+ */
+template <int dim>
+double min_element_size(const mfem::Vector& jacobians, int qpts_per_elem, std::size_t num_elements)
 {
-  auto* nodes = d.mesh_.GetNodes();
-  auto* fes   = nodes->FESpace();
+  const double* J_q = jacobians.HostRead();
 
-  auto         restriction = serac::ElementRestriction(fes, g);
-  mfem::Vector X_e(int(restriction.ESize()));
-  restriction.Gather(*nodes, X_e);
+  double h = std::numeric_limits<double>::max();
+  for (std::size_t e = 0; e < num_elements; e++) {
+    for (int q = 0; q < qpts_per_elem; q++) {
+      tensor<double, dim, dim> J{};
+      for (int i = 0; i < dim; i++) {
+        for (int j = 0; j < dim; j++) {
+          J(i, j) = J_q[(int(e) * dim * dim + j * dim + i) * qpts_per_elem + q];
+        }
+      }
 
-  // assumes all elements are the same order
-  int p = fes->GetElementOrder(0);
+      // the rows of inv(J) are the gradients of the reference coordinates
+      auto dxi_dx = inv(J);
+      for (int i = 0; i < dim; i++) {
+        h = std::min(h, 1.0 / norm(dxi_dx[i]));
+      }
+    }
+  }
+  return h;
+}
 
-  int spatial_dim   = d.mesh_.SpaceDimension();
-  int geometry_dim  = dimension_of(g);
-  int qpts_per_elem = num_quadrature_points(g, q);
+double GeometricFactors::minElementSize(mfem::Geometry::Type elem_geom) const
+{
+  if (num_elements == 0) return std::numeric_limits<double>::max();
 
-  if (g == mfem::Geometry::TRIANGLE) elements = d.tri_ids_;
-  if (g == mfem::Geometry::SQUARE) elements = d.quad_ids_;
-  if (g == mfem::Geometry::TETRAHEDRON) elements = d.tet_ids_;
-  if (g == mfem::Geometry::CUBE) elements = d.hex_ids_;
+  int dim           = dimension_of(elem_geom);
+  int qpts_per_elem = J.Size() / (int(num_elements) * dim * dim);
 
-  num_elements = elements.size();
+  if (dim == 2) return min_element_size<2>(J, qpts_per_elem, num_elements);
+  if (dim == 3) return min_element_size<3>(J, qpts_per_elem, num_elements);
 
-  X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
-  J = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim * geometry_dim);
+  SLIC_ERROR("minElementSize() is only implemented for 2D and 3D domains of elements");
+  return 0.0;
+}
 
-#define DISPATCH_KERNEL(GEOM, P, Q)                                                                           \
-  if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                                        \
-    compute_geometric_factors<Q, mfem::Geometry::GEOM, H1<P, dimension_of(mfem::Geometry::GEOM)> >(X, J, X_e, \
-                                                                                                   elements); \
-    return;                                                                                                   \
+/**
+ * @brief select the kernel computing the geometric factors of domain-type elements
+ * @param g the element geometry
+ * @param p the polynomial order of the mesh nodes
+ * @param q a parameter controlling the number of quadrature points per element
+ * @return the kernel, or nullptr if that combination isn't supported
+ */
+GeometricFactors::kernel_type domain_kernel(mfem::Geometry::Type g, int p, int q)
+{
+#define DISPATCH_KERNEL(GEOM, P, Q)                                                                        \
+  if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                                     \
+    return compute_geometric_factors<Q, mfem::Geometry::GEOM, H1<P, dimension_of(mfem::Geometry::GEOM)> >; \
   }
 
   DISPATCH_KERNEL(TRIANGLE, 1, 1);
@@ -132,41 +169,28 @@ GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type
   DISPATCH_KERNEL(CUBE, 3, 3);
   DISPATCH_KERNEL(CUBE, 3, 4);
 
+  DISPATCH_KERNEL(PRISM, 1, 1);
+  DISPATCH_KERNEL(PRISM, 1, 2);
+  DISPATCH_KERNEL(PRISM, 1, 3);
+  DISPATCH_KERNEL(PRISM, 1, 4);
+
 #undef DISPATCH_KERNEL
 
-  std::cout << "should never be reached " << std::endl;
+  return nullptr;
 }
 
-GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g, FaceType type)
+/**
+ * @brief select the kernel computing the geometric factors of face-type elements
+ * @param g the face geometry
+ * @param p the polynomial order of the mesh nodes
+ * @param q a parameter controlling the number of quadrature points per element
+ * @return the kernel, or nullptr if that combination isn't supported
+ */
+GeometricFactors::kernel_type boundary_kernel(mfem::Geometry::Type g, int p, int q)
 {
-  auto* nodes = d.mesh_.GetNodes();
-  auto* fes   = nodes->FESpace();
-
-  auto         restriction = serac::ElementRestriction(fes, g, type);
-  mfem::Vector X_e(int(restriction.ESize()));
-  restriction.Gather(*nodes, X_e);
-
-  // assumes all elements are the same order
-  int p = fes->GetElementOrder(0);
-
-  int spatial_dim   = d.mesh_.SpaceDimension();
-  int geometry_dim  = dimension_of(g);
-  int qpts_per_elem = num_quadrature_points(g, q);
-
-  // NB: we only want the number of elements with the specified
-  // geometry, which is not the same as mesh->GetNE() in general
-  elements = d.get(g);
-
-  num_elements = std::size_t(elements.size());
-
-  X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
-  J = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim * geometry_dim);
-
-#define DISPATCH_KERNEL(GEOM, P, Q)                                                                               \
-  if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                                            \
-    compute_geometric_factors<Q, mfem::Geometry::GEOM, H1<P, dimension_of(mfem::Geometry::GEOM) + 1> >(X, J, X_e, \
-                                                                                                       elements); \
-    return;                                                                                                       \
+#define DISPATCH_KERNEL(GEOM, P, Q)                                                                            \
+  if (g == mfem::Geometry::GEOM && p == P && q == Q) {                                                         \
+    return compute_geometric_factors<Q, mfem::Geometry::GEOM, H1<P, dimension_of(mfem::Geometry::GEOM) + 1> >; \
   }
 
   DISPATCH_KERNEL(SEGMENT, 1, 1);
@@ -216,7 +240,181 @@ GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type
 
 #undef DISPATCH_KERNEL
 
-  std::cout << "should never be reached" << std::endl;
+  return nullptr;
+}
+
+GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g)
+{
+  auto* nodes = d.mesh_.GetNodes();
+  auto* fes   = nodes->FESpace();
+
+  restriction_ = serac::ElementRestriction(fes, g);
+
+  // assumes all elements are the same order
+  int p = fes->GetElementOrder(0);
+
+  if (g == mfem::Geometry::TRIANGLE) elements = d.tri_ids_;
+  if (g == mfem::Geometry::SQUARE) elements = d.quad_ids_;
+  if (g == mfem::Geometry::TETRAHEDRON) elements = d.tet_ids_;
+  if (g == mfem::Geometry::CUBE) elements = d.hex_ids_;
+  if (g == mfem::Geometry::PRISM) elements = d.prism_ids_;
+
+  initialize(*nodes, d.mesh_.SpaceDimension(), dimension_of(g), num_quadrature_points(g, q), domain_kernel(g, p, q),
+             true);
+}
+
+GeometricFactors::GeometricFactors(const Domain& d, int q, mfem::Geometry::Type g, FaceType type)
+{
+  auto* nodes = d.mesh_.GetNodes();
+  auto* fes   = nodes->FESpace();
+
+  // the restriction of discontinuous nodes to an interior face has both elements' copies of the face nodes
+  SLIC_ERROR_IF(type == FaceType::INTERIOR && isDG(*fes),
+                "interior face geometric factors require continuous mesh nodes");
+
+  restriction_ = serac::ElementRestriction(fes, g, type);
+
+  // assumes all elements are the same order
+  int p = fes->GetElementOrder(0);
+
+  // NB: we only want the number of elements with the specified
+  // geometry, which is not the same as mesh->GetNE() in general
+  elements = d.get(g);
+
+  initialize(*nodes, d.mesh_.SpaceDimension(), dimension_of(g), num_quadrature_points(g, q),
+             boundary_kernel(g, p, q), false);
+}
+
+void GeometricFactors::initialize(const mfem::Vector& nodes, int spatial_dim, int geometry_dim, int qpts_per_elem,
+                                  kernel_type kernel, bool compress_affine)
+{
+  num_elements      = elements.size();
+  kernel_           = kernel;
+  jacobian_entries_ = spatial_dim * geometry_dim;
+  qpts_per_elem_    = qpts_per_elem;
+
+  positions_e_.SetSize(int(restriction_.ESize()));
+  restriction_.Gather(nodes, positions_e_);
+
+  X = mfem::Vector(int(num_elements) * qpts_per_elem * spatial_dim);
+  J = mfem::Vector(int(num_elements) * qpts_per_elem * jacobian_entries_);
+
+  if (kernel_ == nullptr) {
+    std::cout << "should never be reached" << std::endl;
+    return;
+  }
+
+  recomputed_.resize(num_elements);
+  for (uint32_t e = 0; e < num_elements; e++) {
+    recomputed_[e] = e;
+  }
+  kernel_(X, J, positions_e_, elements, recomputed_);
+
+  // affine elements have the same jacobian at every quadrature point, so it only needs to be stored once
+  const int     block    = qpts_per_elem_ * jacobian_entries_;
+  const double* J_values = J.HostRead();
+  if (compress_affine && num_elements > 0) {
+    affine = true;
+    for (std::size_t e = 0; e < num_elements && affine; e++) {
+      affine = isAffine(J_values + int(e) * block);
+    }
+  }
+
+  if (affine) {
+    mfem::Vector compressed(int(num_elements) * jacobian_entries_);
+    for (int e = 0; e < int(num_elements); e++) {
+      for (int c = 0; c < jacobian_entries_; c++) {
+        compressed[e * jacobian_entries_ + c] = J_values[(e * jacobian_entries_ + c) * qpts_per_elem_];
+      }
+    }
+    J.Swap(compressed);
+  }
+}
+
+bool GeometricFactors::isAffine(const double* J_e) const
+{
+  double scale = 0.0;
+  for (int i = 0; i < qpts_per_elem_ * jacobian_entries_; i++) {
+    scale = std::max(scale, std::abs(J_e[i]));
+  }
+
+  for (int c = 0; c < jacobian_entries_; c++) {
+    for (int q = 1; q < qpts_per_elem_; q++) {
+      if (std::abs(J_e[c * qpts_per_elem_ + q] - J_e[c * qpts_per_elem_]) > 1.0e-12 * scale) return false;
+    }
+  }
+  return true;
+}
+
+void GeometricFactors::expandJacobians()
+{
+  const double* J_values = J.HostRead();
+
+  mfem::Vector expanded(int(num_elements) * qpts_per_elem_ * jacobian_entries_);
+  for (int e = 0; e < int(num_elements); e++) {
+    for (int c = 0; c < jacobian_entries_; c++) {
+      for (int q = 0; q < qpts_per_elem_; q++) {
+        expanded[(e * jacobian_entries_ + c) * qpts_per_elem_ + q] = J_values[e * jacobian_entries_ + c];
+      }
+    }
+  }
+
+  J.Swap(expanded);
+  affine = false;
+}
+
+std::size_t GeometricFactors::update(const mfem::Vector& nodes)
+{
+  if (num_elements == 0 || kernel_ == nullptr) return 0;
+
+  updated_positions_e_.SetSize(positions_e_.Size());
+  restriction_.Gather(nodes, updated_positions_e_);
+
+  // only the elements with a node that moved need new factors
+  const double*     old_X = positions_e_.HostRead();
+  const double*     new_X = updated_positions_e_.HostRead();
+  const std::size_t n     = std::size_t(restriction_.nodes_per_elem * restriction_.components);
+
+  recomputed_.clear();
+  for (uint32_t e = 0; e < num_elements; e++) {
+    std::size_t offset = std::size_t(elements[e]) * n;
+    if (!std::equal(new_X + offset, new_X + offset + n, old_X + offset)) {
+      recomputed_.push_back(e);
+    }
+  }
+
+  positions_e_.Swap(updated_positions_e_);
+  if (recomputed_.empty()) return 0;
+
+  const int block = qpts_per_elem_ * jacobian_entries_;
+  updated_jacobians_.SetSize(int(recomputed_.size()) * block);
+  kernel_(X, updated_jacobians_, positions_e_, elements, recomputed_);
+
+  // elements can stop being affine when their nodes move, e.g. hexahedra that are no longer parallelepipeds
+  const double* computed = updated_jacobians_.HostRead();
+  for (std::size_t k = 0; k < recomputed_.size() && affine; k++) {
+    if (!isAffine(computed + int(k) * block)) expandJacobians();
+  }
+
+  double* J_values = J.HostReadWrite();
+  for (std::size_t k = 0; k < recomputed_.size(); k++) {
+    int e = int(recomputed_[k]);
+    if (affine) {
+      for (int c = 0; c < jacobian_entries_; c++) {
+        J_values[e * jacobian_entries_ + c] = computed[int(k) * block + c * qpts_per_elem_];
+      }
+    } else {
+      std::copy(computed + int(k) * block, computed + int(k + 1) * block, J_values + e * block);
+    }
+  }
+
+  return recomputed_.size();
+}
+
+std::size_t GeometricFactors::bytes() const
+{
+  return memory::bytes(X) + memory::bytes(J) + memory::bytes(positions_e_) + memory::bytes(updated_positions_e_) +
+         memory::bytes(updated_jacobians_) + memory::bytes(elements) + memory::bytes(recomputed_);
 }
 
 }  // namespace serac
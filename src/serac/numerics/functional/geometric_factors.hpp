@@ -38,6 +38,37 @@ struct GeometricFactors {
    */
   GeometricFactors(const Domain& domain, int q, mfem::Geometry::Type elem_geom, FaceType type);
 
+  /**
+   * @brief the smallest element size over all quadrature points of a domain of elements
+   *
+   * At each quadrature point, the size is the smallest distance between opposite faces of the parallelepiped
+   * spanned by the columns of the jacobian, i.e. 1 / max_i |grad xi_i|. This is the length that controls the
+   * critical timestep of explicit time integration.
+   *
+   * @param elem_geom the element geometry these factors were computed for
+   * @return the smallest size, or the largest double if there are no elements
+   */
+  double minElementSize(mfem::Geometry::Type elem_geom) const;
+
+  /**
+   * @brief recompute the positions and jacobians after the mesh nodes have moved, e.g. for shape optimization
+   * or ALE, without rebuilding the element restriction
+   *
+   * Only the elements with at least one node that moved are recomputed, and X and J are updated in place.
+   * J can go back to storing the jacobians at each quadrature point, if an affine element stops being affine.
+   *
+   * @param nodes the new mesh nodes, in the finite element space of the nodes these factors were computed from
+   * @return the number of elements whose factors were recomputed
+   */
+  std::size_t update(const mfem::Vector& nodes);
+
+  /// @brief the number of bytes allocated for the positions, jacobians and the scratch space of update()
+  std::size_t bytes() const;
+
+  /// @brief the signature of the kernels that compute the factors of some of the elements
+  using kernel_type = void (*)(mfem::Vector&, mfem::Vector&, const mfem::Vector&, const std::vector<int>&,
+                               const std::vector<uint32_t>&);
+
   // descriptions copied from mfem
 
   /// Mapped (physical) coordinates of all quadrature points.
@@ -54,14 +85,60 @@ struct GeometricFactors {
       - NQ = number of quadrature points per element,
       - SDIM = space dimension of the mesh = mesh.SpaceDimension(),
       - DIM = dimension of the mesh = mesh.Dimension(), and
-      - NE = number of elements in the mesh. */
+      - NE = number of elements in the mesh.
+
+      When every element of the domain is affine (see `affine`), the jacobian is the same at each of its
+      quadrature points, so only one is stored per element, i.e. the layout is (SDIM x DIM x NE). */
   mfem::Vector J;
 
+  /**
+   * @brief whether every element of the domain is affine (e.g. linear simplices, or parallelepipeds), so that
+   * J stores one jacobian per element
+   * @note only domains of elements are checked, the jacobians of boundary elements are always stored at each
+   * quadrature point
+   */
+  bool affine = false;
+
   /// @brief list of element indices that are part of the associated domain
   std::vector<int> elements;
 
   /// the number of elements in the domain
   std::size_t num_elements;
+
+private:
+  /// @brief allocate X and J, and compute them for every element, compressing J if every element is affine
+  void initialize(const mfem::Vector& nodes, int spatial_dim, int geometry_dim, int qpts_per_elem, kernel_type kernel,
+                  bool compress_affine);
+
+  /// @brief whether the jacobians of one element (in the uncompressed layout) are the same at each quadrature point
+  bool isAffine(const double* J_e) const;
+
+  /// @brief go back to storing the jacobians at each quadrature point
+  void expandJacobians();
+
+  /// @brief the number of entries of each jacobian
+  int jacobian_entries_ = 0;
+
+  /// @brief the number of quadrature points per element
+  int qpts_per_elem_ = 0;
+
+  /// @brief gathers the mesh nodes of each element
+  ElementRestriction restriction_;
+
+  /// @brief the "E-vector" of the mesh nodes the factors were last computed from
+  mfem::Vector positions_e_;
+
+  /// @brief scratch storage for the gathered nodes in update()
+  mfem::Vector updated_positions_e_;
+
+  /// @brief scratch storage for the jacobians of the elements recomputed in update()
+  mfem::Vector updated_jacobians_;
+
+  /// @brief the positions in `elements` of the elements recomputed by the last update()
+  std::vector<uint32_t> recomputed_;
+
+  /// @brief the kernel for this geometry, order and quadrature rule, or nullptr if unsupported
+  kernel_type kernel_ = nullptr;
 };
 
 }  // namespace serac
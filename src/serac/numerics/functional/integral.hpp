@@ -7,23 +7,109 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <typeinfo>
 
 #include "mfem.hpp"
 
 #include "serac/infrastructure/accelerator.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/numerics/functional/geometric_factors.hpp"
+#include "serac/numerics/functional/shared_setup.hpp"
+#include "serac/numerics/functional/tile_size_tuner.hpp"
 #include "serac/numerics/functional/function_signature.hpp"
 #include "serac/numerics/functional/domain_integral_kernels.hpp"
 #include "serac/numerics/functional/boundary_integral_kernels.hpp"
+#include "serac/numerics/functional/interior_face_integral_kernels.hpp"
 #include "serac/numerics/functional/differentiate_wrt.hpp"
 
 namespace serac {
 
+/// @brief the sizes and estimated costs of the kernels of an Integral over one element geometry
+struct KernelCounts {
+  /// @brief the number of elements
+  uint32_t elements = 0;
+
+  /// @brief the number of quadrature points per element
+  uint32_t quadrature_points = 0;
+
+  /// @brief the number of dofs per element, summed over the test space and the trial spaces
+  uint32_t dofs = 0;
+
+  /**
+   * @brief an estimate of the floating point operations of an evaluation, counting a dense interpolation of the
+   * values and derivatives of the inputs and integration of the outputs, but not the q-function itself
+   */
+  double flops = 0.0;
+
+  /// @brief an estimate of the bytes moved by an evaluation: the element inputs, outputs and geometric factors
+  double bytes = 0.0;
+};
+
+/**
+ * @brief the Caliper attributes of a kernel launch, which are attached to the enclosing regions while it is alive
+ *
+ * Together with the region of each kernel (named after its geometry), this lets a Caliper profile place the kernels
+ * on a roofline, e.g. by dividing the sum of "functional.flops" by the time spent in each region.
+ */
+class KernelAnnotation {
+public:
+  /// @brief begin the attributes of a kernel with the given counts
+  explicit KernelAnnotation(const KernelCounts& counts)
+      : elements_("functional.elements", counts.elements),
+        quadrature_points_("functional.quadrature_points", counts.quadrature_points),
+        dofs_("functional.dofs", counts.dofs),
+        flops_("functional.flops", counts.flops),
+        bytes_("functional.bytes", counts.bytes)
+  {
+  }
+
+private:
+  /// @brief the number of elements
+  profiling::ScopedAttribute elements_;
+  /// @brief the number of quadrature points per element
+  profiling::ScopedAttribute quadrature_points_;
+  /// @brief the number of dofs per element
+  profiling::ScopedAttribute dofs_;
+  /// @brief the estimated floating point operations
+  profiling::ScopedAttribute flops_;
+  /// @brief the estimated bytes moved
+  profiling::ScopedAttribute bytes_;
+};
+
+/**
+ * @brief estimate the sizes and costs of the kernels of an integral over one element geometry, see KernelCounts
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @param num_elements the number of elements of this geometry in the domain
+ */
+template <mfem::Geometry::Type geom, int Q, typename test, typename... trials>
+KernelCounts estimate_kernel_counts(uint32_t num_elements)
+{
+  constexpr double dim        = dimension_of(geom);
+  constexpr double qpts       = num_quadrature_points(geom, Q);
+  constexpr double test_dofs  = finite_element<geom, test>::ndof * finite_element<geom, test>::components;
+  constexpr double trial_dofs =
+      (0.0 + ... + (finite_element<geom, trials>::ndof * finite_element<geom, trials>::components));
+
+  KernelCounts counts;
+  counts.elements          = num_elements;
+  counts.quadrature_points = uint32_t(qpts);
+  counts.dofs              = uint32_t(test_dofs + trial_dofs);
+  counts.flops             = 2.0 * num_elements * qpts * (dim + 1) * (test_dofs + trial_dofs);
+  counts.bytes = sizeof(double) * num_elements * (trial_dofs + 2 * test_dofs + qpts * (dim + dim * dim));
+  return counts;
+}
+
 /// @brief a class for representing a Integral calculations and their derivatives
 struct Integral {
   /// @brief the number of different kinds of integration domains
-  static constexpr std::size_t num_types = 2;
+  static constexpr std::size_t num_types = Domain::num_types;
 
   /**
    * @brief Construct an "empty" Integral object, whose kernels are to be initialized later
@@ -39,14 +125,48 @@ struct Integral {
   {
     std::size_t num_trial_spaces = trial_space_indices.size();
     evaluation_with_AD_.resize(num_trial_spaces);
+    tiled_evaluation_with_AD_.resize(num_trial_spaces);
     jvp_.resize(num_trial_spaces);
+    fused_jvp_.resize(num_trial_spaces);
+    vjp_.resize(num_trial_spaces);
+    recomputed_jvp_.resize(num_trial_spaces);
     element_gradient_.resize(num_trial_spaces);
+    element_diagonal_.resize(num_trial_spaces);
+    release_derivatives_.resize(num_trial_spaces);
+    derivative_bytes_.resize(num_trial_spaces);
+    planned_derivative_bytes_.resize(num_trial_spaces, 0);
+    derivative_kernel_generators_.resize(num_trial_spaces);
 
     for (uint32_t i = 0; i < num_trial_spaces; i++) {
       functional_to_integral_index_[active_trial_spaces_[i]] = i;
     }
   }
 
+  /**
+   * @brief create the kernels that store and use the q-function derivatives with respect to a trial space, if
+   * they haven't been created already. Until then, an Integral only has the kernels that evaluate it without
+   * differentiation, so no setup work is done for arguments that are never differentiated.
+   *
+   * @param differentiation_index the index of the trial space, in the numbering of the Functional
+   */
+  void GenerateDerivativeKernels(uint32_t differentiation_index)
+  {
+    if (!HasPendingDerivativeKernels(differentiation_index)) return;
+
+    auto& generators = derivative_kernel_generators_[functional_to_integral_index_.at(differentiation_index)];
+    for (auto& generate : generators) {
+      generate(*this);
+    }
+    generators.clear();
+  }
+
+  /// @brief whether the derivative kernels for a trial space still have to be created, see GenerateDerivativeKernels()
+  bool HasPendingDerivativeKernels(uint32_t differentiation_index) const
+  {
+    if (functional_to_integral_index_.count(differentiation_index) == 0) return false;
+    return !derivative_kernel_generators_[functional_to_integral_index_.at(differentiation_index)].empty();
+  }
+
   /**
    * @brief evaluate the integral, optionally storing q-function derivatives with respect to
    *        a specific trial space.
@@ -55,7 +175,8 @@ struct Integral {
    * @param input_E a collection (one for each trial space) of block vectors (block index corresponds to the element
    * geometry) containing input values for each element.
    * @param output_E a block vector (block index corresponds to the element geometry) of the output values for each
-   * element.
+   * element. The values computed by this integral are added to the existing contents of output_E, so that
+   * several integrals can accumulate into the same E-vector before a single scatter-add.
    * @param differentiation_index a non-negative value indicates differentiation with respect to the trial space with
    * that index. A value of -1 indicates no differentiation will occur.
    * @param update_state whether or not to store the updated state values computed in the q-function. For plasticity and
@@ -65,18 +186,155 @@ struct Integral {
   void Mult(double t, const std::vector<mfem::BlockVector>& input_E, mfem::BlockVector& output_E,
             uint32_t differentiation_index, bool update_state) const
   {
-    output_E = 0.0;
+    bool with_AD =
+        (functional_to_integral_index_.count(differentiation_index) > 0 && differentiation_index != NO_DIFFERENTIATION);
+    SLIC_ERROR_IF(with_AD && HasPendingDerivativeKernels(differentiation_index),
+                  "GenerateDerivativeKernels() must be called before differentiating w.r.t. an argument");
+    auto& kernels =
+        (with_AD) ? evaluation_with_AD_[functional_to_integral_index_.at(differentiation_index)] : evaluation_;
+    SERAC_MARK_SCOPE("Integral::Mult");
+    for (auto& [geometry, func] : kernels) {
+      SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+      KernelAnnotation annotation(counts(geometry));
+      input_ptrs_.resize(active_trial_spaces_.size());
+      for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
+        input_ptrs_[i] = ReadBlock(input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry));
+      }
+      func(t, input_ptrs_, ReadWriteBlock(output_E.GetBlock(geometry)), update_state);
+    }
+  }
 
+  /**
+   * @brief the evaluations of this integral over each element geometry, like Mult(), as separate tasks that can
+   * run concurrently with each other (and with the tasks of other integrals), see Functional::concurrentIntegrals()
+   *
+   * The arguments are the same as for Mult(). The task of each geometry only writes to the block of @a output_E for
+   * that geometry, so tasks that add into the same block (e.g. of two integrals over the same elements) must not run
+   * at the same time.
+   *
+   * @return the task of each element geometry, which must run before @a input_E and @a output_E change size
+   */
+  std::map<mfem::Geometry::Type, std::function<void()>> MultTasks(
+      double t, const std::vector<mfem::BlockVector>& input_E, mfem::BlockVector& output_E,
+      uint32_t differentiation_index, bool update_state) const
+  {
     bool with_AD =
         (functional_to_integral_index_.count(differentiation_index) > 0 && differentiation_index != NO_DIFFERENTIATION);
+    SLIC_ERROR_IF(with_AD && HasPendingDerivativeKernels(differentiation_index),
+                  "GenerateDerivativeKernels() must be called before differentiating w.r.t. an argument");
     auto& kernels =
         (with_AD) ? evaluation_with_AD_[functional_to_integral_index_.at(differentiation_index)] : evaluation_;
+
+    std::map<mfem::Geometry::Type, std::function<void()>> tasks;
     for (auto& [geometry, func] : kernels) {
+      // the tasks run on other threads, so they get their own lists of inputs
       std::vector<const double*> inputs(active_trial_spaces_.size());
       for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
-        inputs[i] = input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry).Read();
+        inputs[i] = ReadBlock(input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry));
       }
-      func(t, inputs, output_E.GetBlock(geometry).ReadWrite(), update_state);
+      double* output  = ReadWriteBlock(output_E.GetBlock(geometry));
+      tasks[geometry] = [&func = func, t, inputs, output, update_state]() { func(t, inputs, output, update_state); };
+    }
+    return tasks;
+  }
+
+  /// @brief whether this integral can be evaluated a tile of elements at a time, see TiledMult()
+  bool CanTile() const { return domain_.type_ == Domain::Type::Elements && !on_device_; }
+
+  /**
+   * @brief evaluate the integral a tile of elements at a time, gathering the values of each tile from the L-vectors
+   * and scatter-adding its contributions into the output L-vector before moving on to the next tile, so that only
+   * tile-sized E-vectors are needed
+   *
+   * @param t the time
+   * @param input_L the L-vectors of every trial space, in the numbering of the Functional
+   * @param output_L the L-vector of the test space, that the values of this integral are added to
+   * @param differentiation_index the trial space to store the q-function derivatives with respect to, as for Mult()
+   * @param update_state whether or not to store the updated state values computed in the q-function, as for Mult()
+   * @param tile_size the (maximum) number of elements in each tile, or 0 to use (and tune) the tile size of each
+   * element type chosen by its TileSizeTuner
+   * @param G_trial the restriction operators of every trial space, in the numbering of the Functional
+   * @param G_test the restriction operators of the test space
+   * @param tile_E the workspace for the tile E-vectors (one for each trial space of this integral, and one for the
+   * test space), which is resized as needed
+   */
+  void TiledMult(double t, const std::vector<const mfem::Vector*>& input_L, mfem::Vector& output_L,
+                 uint32_t differentiation_index, bool update_state, uint32_t tile_size,
+                 const std::vector<const BlockElementRestriction*>& G_trial, const BlockElementRestriction& G_test,
+                 std::vector<mfem::Vector>& tile_E) const
+  {
+    bool with_AD =
+        (functional_to_integral_index_.count(differentiation_index) > 0 && differentiation_index != NO_DIFFERENTIATION);
+    SLIC_ERROR_IF(with_AD && HasPendingDerivativeKernels(differentiation_index),
+                  "GenerateDerivativeKernels() must be called before differentiating w.r.t. an argument");
+    auto& kernels = (with_AD) ? tiled_evaluation_with_AD_[functional_to_integral_index_.at(differentiation_index)]
+                              : tiled_evaluation_;
+    SERAC_MARK_SCOPE("Integral::TiledMult");
+
+    std::size_t num_inputs = active_trial_spaces_.size();
+    tile_E.resize(num_inputs + 1);
+    input_ptrs_.resize(num_inputs);
+    for (auto& [geometry, func] : kernels) {
+      SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+      KernelAnnotation annotation(counts(geometry));
+
+      const auto&    test_restriction = G_test.restrictions.at(geometry);
+      const int*     elements         = &domain_.get(geometry)[0];
+      const uint32_t num_elements     = uint32_t(domain_.get(geometry).size());
+      mfem::Vector&  output_E         = tile_E[num_inputs];
+      const uint64_t test_values      = test_restriction.nodes_per_elem * test_restriction.components;
+
+      TileSizeTuner* tuner             = (tile_size == 0) ? &tile_tuners_.at(geometry) : nullptr;
+      const uint32_t elements_per_tile = tuner ? tuner->tileSize() : tile_size;
+      auto           start             = std::chrono::steady_clock::now();
+
+      for (uint32_t first = 0; first < num_elements; first += elements_per_tile) {
+        uint32_t count = std::min(elements_per_tile, num_elements - first);
+
+        for (std::size_t i = 0; i < num_inputs; i++) {
+          const auto& restriction = G_trial[active_trial_spaces_[i]]->restrictions.at(geometry);
+          tile_E[i].SetSize(int(count * restriction.nodes_per_elem * restriction.components));
+          restriction.GatherElements(input_L[active_trial_spaces_[i]]->HostRead(), tile_E[i].HostWrite(),
+                                     elements + first, count);
+          input_ptrs_[i] = tile_E[i].HostRead();
+        }
+
+        output_E.SetSize(int(count * test_values));
+        output_E = 0.0;
+        func(t, input_ptrs_, output_E.HostReadWrite(), update_state, first, count);
+        test_restriction.ScatterAddElements(output_E.HostRead(), output_L.HostReadWrite(), elements + first, count);
+      }
+
+      if (tuner) {
+        tuner->record(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the integral for several sets of inputs in one pass over the elements, see
+   * Functional::EvaluateBatch()
+   *
+   * @param t the time
+   * @param input_E for each set of inputs, the block vectors (block index corresponds to the element geometry) of
+   * each trial space, in the numbering of the Functional
+   * @param output_E for each set of inputs, a block vector that the values computed by this integral are added to
+   */
+  void BatchMult(double t, const std::vector<std::vector<const mfem::BlockVector*>>& input_E,
+                 std::vector<mfem::BlockVector>& output_E) const
+  {
+    SERAC_MARK_SCOPE("Integral::BatchMult");
+    for (auto& [geometry, func] : batched_evaluation_) {
+      SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+      std::vector<std::vector<const double*>> inputs(output_E.size());
+      std::vector<double*>                    outputs(output_E.size());
+      for (std::size_t c = 0; c < output_E.size(); c++) {
+        for (auto i : active_trial_spaces_) {
+          inputs[c].push_back(input_E[c][i]->GetBlock(geometry).Read());
+        }
+        outputs[c] = output_E[c].GetBlock(geometry).ReadWrite();
+      }
+      func(t, inputs, outputs);
     }
   }
 
@@ -86,22 +344,108 @@ struct Integral {
    * @param input_E a block vector (block index corresponds to the element geometry) of a specific trial space element
    * values
    * @param output_E a block vector (block index corresponds to the element geometry) of the output values for each
-   * element.
+   * element. Like Mult(), the directional derivative is added to the existing contents of output_E.
    * @param differentiation_index a non-negative value indicates directional derivative with respect to the trial space
    * with that index.
    */
   void GradientMult(const mfem::BlockVector& input_E, mfem::BlockVector& output_E, uint32_t differentiation_index) const
   {
-    output_E = 0.0;
-
     // if this integral actually depends on the specified variable
     if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      SERAC_MARK_SCOPE("Integral::GradientMult");
       for (auto& [geometry, func] : jvp_[functional_to_integral_index_.at(differentiation_index)]) {
+        SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+        KernelAnnotation annotation(counts(geometry));
+        func(ReadBlock(input_E.GetBlock(geometry)), ReadWriteBlock(output_E.GetBlock(geometry)));
+      }
+    }
+  }
+
+  /// @brief whether this integral has kernels for the @overload of GradientMult() on L-vectors
+  bool CanFuseGradient() const { return domain_.type_ == Domain::Type::Elements && !on_device_; }
+
+  /**
+   * @overload that reads the trial space values directly from an L-vector, and scatter-adds the directional
+   * derivative directly into an L-vector, rather than going through E-vectors, see CanFuseGradient()
+   *
+   * @param input_L the L-vector of a specific trial space
+   * @param output_L the L-vector of the test space, that the directional derivative is added to
+   * @param differentiation_index the index of the trial space being differentiated
+   * @param G_trial the restriction operators of the trial space
+   * @param G_test the restriction operators of the test space
+   */
+  void GradientMult(const mfem::Vector& input_L, mfem::Vector& output_L, uint32_t differentiation_index,
+                    const BlockElementRestriction& G_trial, const BlockElementRestriction& G_test) const
+  {
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      SERAC_MARK_SCOPE("Integral::GradientMult");
+      const double* dU = input_L.HostRead();
+      double*       dR = output_L.HostReadWrite();
+      for (auto& [geometry, func] : fused_jvp_[functional_to_integral_index_.at(differentiation_index)]) {
+        SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+        KernelAnnotation annotation(counts(geometry));
+        func(dU, dR, G_trial.restrictions.at(geometry), G_test.restrictions.at(geometry));
+      }
+    }
+  }
+
+  /**
+   * @brief evaluate the (transposed) vector-jacobian(with respect to some trial space) product of this integral
+   *
+   * @param input_E a block vector (block index corresponds to the element geometry) of the test space element values
+   * @param output_E a block vector (block index corresponds to the element geometry) of the trial space element
+   * values. Like GradientMult(), the product is added to the existing contents of output_E.
+   * @param differentiation_index the index of the trial space being differentiated
+   */
+  void GradientMultTranspose(const mfem::BlockVector& input_E, mfem::BlockVector& output_E,
+                             uint32_t differentiation_index) const
+  {
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      SERAC_MARK_SCOPE("Integral::GradientMultTranspose");
+      for (auto& [geometry, func] : vjp_[functional_to_integral_index_.at(differentiation_index)]) {
+        SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+        KernelAnnotation annotation(counts(geometry));
         func(input_E.GetBlock(geometry).Read(), output_E.GetBlock(geometry).ReadWrite());
       }
     }
   }
 
+  /// @brief whether GradientMult() can be replaced by RecomputedGradientMult(), i.e. for domain integrals
+  bool CanRecomputeGradient() const { return domain_.type_ == Domain::Type::Elements && !on_device_; }
+
+  /**
+   * @brief evaluate the jacobian(with respect to some trial space)-vector product of this integral, by re-evaluating
+   * the q-function rather than using stored q-function derivatives
+   *
+   * @param t the time
+   * @param input_E a collection (one for each trial space) of block vectors of the input values for each element,
+   * where the jacobian is evaluated
+   * @param direction_E a block vector of a specific trial space element values, to apply the jacobian to
+   * @param output_E a block vector of the output values for each element. Like Mult(), the directional derivative is
+   * added to the existing contents of output_E.
+   * @param differentiation_index the index of the trial space being differentiated
+   */
+  void RecomputedGradientMult(double t, const std::vector<mfem::BlockVector>& input_E,
+                              const mfem::BlockVector& direction_E, mfem::BlockVector& output_E,
+                              uint32_t differentiation_index) const
+  {
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      SERAC_MARK_SCOPE("Integral::RecomputedGradientMult");
+      for (auto& [geometry, func] : recomputed_jvp_[functional_to_integral_index_.at(differentiation_index)]) {
+        SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+        KernelAnnotation annotation(counts(geometry));
+        input_ptrs_.resize(active_trial_spaces_.size());
+        for (std::size_t i = 0; i < active_trial_spaces_.size(); i++) {
+          input_ptrs_[i] = input_E[uint32_t(active_trial_spaces_[i])].GetBlock(geometry).Read();
+        }
+        func(t, input_ptrs_, direction_E.GetBlock(geometry).Read(), output_E.GetBlock(geometry).ReadWrite());
+      }
+    }
+  }
+
   /**
    * @brief evaluate the jacobian (with respect to some trial space) of this integral
    *
@@ -114,12 +458,198 @@ struct Integral {
   {
     // if this integral actually depends on the specified variable
     if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      SERAC_MARK_SCOPE("Integral::ComputeElementGradients");
       for (auto& [geometry, func] : element_gradient_[functional_to_integral_index_.at(differentiation_index)]) {
+        SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
         func(view(K_e[geometry]));
       }
     }
   }
 
+  /**
+   * @brief evaluate the diagonal entries of the element jacobians (with respect to some trial space) of this integral
+   *
+   * @param diagonal_E a block vector (block index corresponds to the element geometry) of the diagonal entries of each
+   * element jacobian. Like Mult(), the values are added to the existing contents of diagonal_E.
+   * @param differentiation_index the index of the trial space being differentiated
+   */
+  void ComputeElementDiagonal(mfem::BlockVector& diagonal_E, uint32_t differentiation_index) const
+  {
+    // if this integral actually depends on the specified variable
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      SERAC_MARK_SCOPE("Integral::ComputeElementDiagonal");
+      for (auto& [geometry, func] : element_diagonal_[functional_to_integral_index_.at(differentiation_index)]) {
+        SERAC_MARK_SCOPE(mfem::Geometry::Name[geometry]);
+        func(diagonal_E.GetBlock(geometry).ReadWrite());
+      }
+    }
+  }
+
+  /**
+   * @brief free the memory used to store q-function derivatives with respect to a specific trial space
+   *
+   * @param differentiation_index the index of the trial space whose derivatives are no longer needed
+   *
+   * @note the memory is reallocated the next time this integral is evaluated with differentiation
+   * enabled for that trial space. Until then, GradientMult() and ComputeElementGradients() must not be
+   * called for that trial space.
+   */
+  void ReleaseDerivatives(uint32_t differentiation_index)
+  {
+    if (functional_to_integral_index_.count(differentiation_index) > 0) {
+      for (auto& [geometry, release] : release_derivatives_[functional_to_integral_index_.at(differentiation_index)]) {
+        release();
+      }
+    }
+  }
+
+  /// @brief the number of bytes currently allocated for the q-function derivatives, over all trial spaces
+  std::size_t DerivativeBytes() const
+  {
+    std::size_t total = 0;
+    for (const auto& per_geometry : derivative_bytes_) {
+      for (const auto& [geometry, nbytes] : per_geometry) {
+        total += nbytes();
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief the number of bytes the q-function derivatives with respect to a trial space take once they are allocated,
+   * whether they have been already or not
+   *
+   * @param differentiation_index the index of the trial space, in the numbering of the Functional
+   */
+  std::size_t PlannedDerivativeBytes(uint32_t differentiation_index) const
+  {
+    auto index = functional_to_integral_index_.find(differentiation_index);
+    return (index == functional_to_integral_index_.end()) ? 0 : planned_derivative_bytes_[index->second];
+  }
+
+  /// @brief the number of bytes allocated for the positions and jacobians of every element geometry
+  std::size_t GeometricFactorBytes() const
+  {
+    std::size_t total = 0;
+    for (const auto& [geometry, gf] : geometric_factors_) {
+      total += gf->bytes();
+    }
+    return total;
+  }
+
+  /**
+   * @brief start or stop timing the evaluation of each element, e.g. to estimate the cost of each element for a
+   * weighted repartitioning of the mesh
+   *
+   * @param enable whether to time the elements from now on. The times recorded so far are discarded either way.
+   *
+   * @note elements evaluated several at a time (see qfunction_simd_width) are not timed
+   */
+  void RecordElementCosts(bool enable)
+  {
+    for (auto& [geometry, costs] : element_costs_) {
+      costs->assign(enable ? std::size_t(geometric_factors_.at(geometry)->num_elements) : 0, 0.0);
+    }
+  }
+
+  /**
+   * @brief recompute the positions and jacobians at each quadrature point after the mesh nodes have moved,
+   * see GeometricFactors::update()
+   *
+   * @param nodes the new mesh nodes
+   */
+  void UpdateGeometry(const mfem::Vector& nodes)
+  {
+    // note: the factors may be shared with other integrals, which then also see the new geometry
+    for (auto& [geometry, gf] : geometric_factors_) {
+      gf->update(nodes);
+    }
+
+    // the cached values were mapped to the physical elements with the old jacobians
+    for (auto& [geometry, cache] : cached_inputs_) {
+      cache->valid.assign(cache->valid.size(), false);
+    }
+  }
+
+  /**
+   * @brief choose whether the values of a trial space argument at each quadrature point are interpolated once and
+   * reused in later evaluations, rather than interpolated in every evaluation. Calling this again (with
+   * @a cache = true) discards the values cached so far, e.g. when the argument's inputs have changed.
+   *
+   * @param functional_index the index of the argument, in the numbering of the Functional
+   * @param cache whether to cache the argument's values
+   *
+   * @note only domain integrals cache their inputs, and not while the argument is being differentiated
+   */
+  void CacheArgument(uint32_t functional_index, bool cache)
+  {
+    if (functional_to_integral_index_.count(functional_index) == 0) return;
+
+    uint32_t i = functional_to_integral_index_.at(functional_index);
+    for (auto& [geometry, cached] : cached_inputs_) {
+      if (cache) {
+        cached->enabled[i] = true;
+        cached->valid[i]   = false;
+      } else {
+        cached->disable(i);
+      }
+    }
+  }
+
+  /// @brief the number of bytes allocated for cached quadrature point values of the arguments, see CacheArgument()
+  std::size_t CachedInputBytes() const
+  {
+    std::size_t total = 0;
+    for (const auto& [geometry, cache] : cached_inputs_) {
+      for (auto nbytes : cache->bytes) {
+        total += nbytes;
+      }
+    }
+    return total;
+  }
+
+  /// @brief whether this integral depends on a trial space, in the numbering of the Functional
+  bool UsesArgument(uint32_t functional_index) const
+  {
+    return functional_to_integral_index_.count(functional_index) != 0;
+  }
+
+  /**
+   * @brief make this integral a separable load f(x) g(t), whose integrand (f, wrapped by a TimeScaledIntegrand) is
+   * multiplied by @a scale
+   *
+   * @param time_scale g, the time function of the load
+   * @param scale the value that the integrand is multiplied by, see SetTime()
+   */
+  void MakeSeparable(std::function<double(double)> time_scale, std::shared_ptr<double> scale)
+  {
+    time_scale_ = std::move(time_scale);
+    scale_      = std::move(scale);
+  }
+
+  /// @brief whether this integral is a separable load, see MakeSeparable()
+  bool IsSeparable() const { return bool(time_scale_); }
+
+  /// @brief multiply the integrand of a separable load by g(t) in the following evaluations
+  void SetTime(double t) { *scale_ = time_scale_(t); }
+
+  /// @brief multiply the integrand of a separable load by @a scale in the following evaluations
+  void SetScale(double scale) { *scale_ = scale; }
+
+  /// @brief whether separable_L_ holds the integral of the load with a time scale of one
+  bool HasSeparableLoad() const { return separable_L_.Size() > 0; }
+
+  /// @brief discard separable_L_, e.g. after the inputs of the load or the mesh nodes have changed
+  void InvalidateSeparableLoad() { separable_L_.Destroy(); }
+
+  /// @brief the sizes and estimated costs of the kernels of the given geometry, see KernelCounts
+  const KernelCounts& counts(mfem::Geometry::Type geometry) const
+  {
+    static const KernelCounts none{};
+    auto                      it = kernel_counts_.find(geometry);
+    return (it == kernel_counts_.end()) ? none : it->second;
+  }
+
   /// @brief information about which elements to integrate over
   Domain domain_;
 
@@ -132,21 +662,76 @@ struct Integral {
   /// @brief kernels for integral evaluation + derivative w.r.t. specified argument over each type of element
   std::vector<std::map<mfem::Geometry::Type, eval_func> > evaluation_with_AD_;
 
+  /// @brief signature of the kernels that evaluate the integral for several sets of inputs, see BatchMult()
+  using batched_eval_func =
+      std::function<void(double, const std::vector<std::vector<const double*>>&, const std::vector<double*>&)>;
+
+  /// @brief kernels for integral evaluation of several sets of inputs over each type of element
+  std::map<mfem::Geometry::Type, batched_eval_func> batched_evaluation_;
+
+  /// @brief signature of the integral evaluation kernels on a range (tile) of elements, see TiledMult()
+  using tiled_eval_func =
+      std::function<void(double, const std::vector<const double*>&, double*, bool, uint32_t, uint32_t)>;
+
+  /// @brief kernels for integral evaluation a tile of elements at a time, over each type of element
+  std::map<mfem::Geometry::Type, tiled_eval_func> tiled_evaluation_;
+
+  /// @brief kernels for integral evaluation + derivative w.r.t. specified argument, a tile of elements at a time
+  std::vector<std::map<mfem::Geometry::Type, tiled_eval_func> > tiled_evaluation_with_AD_;
+
+  /// @brief the tuners of the number of elements in each tile, for each element type, see TiledMult()
+  mutable std::map<mfem::Geometry::Type, TileSizeTuner> tile_tuners_;
+
   /// @brief signature of element jvp kernel
   using jacobian_vector_product_func = std::function<void(const double*, double*)>;
 
   /// @brief kernels for jacobian-vector product of integral calculation
   std::vector<std::map<mfem::Geometry::Type, jacobian_vector_product_func> > jvp_;
 
+  /// @brief signature of the element jvp kernels that read from and write to L-vectors directly
+  using fused_jacobian_vector_product_func =
+      std::function<void(const double*, double*, const ElementRestriction&, const ElementRestriction&)>;
+
+  /// @brief kernels for jacobian-vector products that read from and write to L-vectors directly
+  std::vector<std::map<mfem::Geometry::Type, fused_jacobian_vector_product_func> > fused_jvp_;
+
+  /// @brief kernels for the transposed (vector-jacobian) products of integral calculation
+  std::vector<std::map<mfem::Geometry::Type, jacobian_vector_product_func> > vjp_;
+
+  /// @brief signature of the jvp kernels that re-evaluate the q-function, see RecomputedGradientMult()
+  using recomputed_jvp_func = std::function<void(double, const std::vector<const double*>&, const double*, double*)>;
+
+  /// @brief kernels for jacobian-vector products that re-evaluate the q-function
+  std::vector<std::map<mfem::Geometry::Type, recomputed_jvp_func> > recomputed_jvp_;
+
   /// @brief signature of element gradient kernel
   using grad_func = std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)>;
 
   /// @brief kernels for calculation of element jacobians
   std::vector<std::map<mfem::Geometry::Type, grad_func> > element_gradient_;
 
+  /// @brief signature of element diagonal kernel
+  using diagonal_func = std::function<void(double*)>;
+
+  /// @brief kernels for calculation of the diagonal entries of element jacobians
+  std::vector<std::map<mfem::Geometry::Type, diagonal_func> > element_diagonal_;
+
+  /// @brief callbacks that free the q-function derivative storage for each trial space and element type
+  std::vector<std::map<mfem::Geometry::Type, std::function<void()> > > release_derivatives_;
+
+  /// @brief callbacks that return the bytes allocated for the q-function derivatives of each trial space and element
+  /// type
+  std::vector<std::map<mfem::Geometry::Type, std::function<std::size_t()> > > derivative_bytes_;
+
+  /// @brief the bytes of the q-function derivatives of each trial space once allocated, see PlannedDerivativeBytes()
+  std::vector<std::size_t> planned_derivative_bytes_;
+
   /// @brief a list of the trial spaces that take part in this integrand
   std::vector<uint32_t> active_trial_spaces_;
 
+  /// @brief the E-vector data of each active trial space, kept between evaluations so that they don't allocate
+  mutable std::vector<const double*> input_ptrs_;
+
   /**
    * @brief a way of translating between the indices used by `Functional` and `Integral` to refer to the same
    *        trial space.
@@ -163,15 +748,132 @@ struct Integral {
    */
   std::map<uint32_t, uint32_t> functional_to_integral_index_;
 
-  /// @brief the spatial positions and jacobians (dx_dxi) for each element type and quadrature point
-  std::map<mfem::Geometry::Type, GeometricFactors> geometric_factors_;
+  /// @brief the time function g of a separable load f(x) g(t), or empty for other integrals, see MakeSeparable()
+  std::function<double(double)> time_scale_;
+
+  /// @brief the value that the integrand of a separable load is multiplied by
+  std::shared_ptr<double> scale_;
+
+  /// @brief the L-vector of a separable load with a time scale of one, while its inputs don't change
+  mfem::Vector separable_L_;
+
+  /**
+   * @brief the spatial positions and jacobians (dx_dxi) for each element type and quadrature point, shared with
+   * other integrals on the same elements and quadrature rule (see shared_setup::geometric_factors())
+   */
+  std::map<mfem::Geometry::Type, std::shared_ptr<GeometricFactors>> geometric_factors_;
+
+  /**
+   * @brief the total time (in seconds) spent evaluating each element of the domain, for each element type,
+   * or empty vectors when elements are not being timed (see RecordElementCosts())
+   */
+  std::map<mfem::Geometry::Type, std::shared_ptr<std::vector<double> > > element_costs_;
+
+  /// @brief the sizes and estimated costs of the kernels of each element type, attached to their Caliper regions
+  std::map<mfem::Geometry::Type, KernelCounts> kernel_counts_;
+
+  /// @brief the quadrature point values of the arguments of a domain integral, for each element type
+  std::map<mfem::Geometry::Type, std::shared_ptr<domain_integral::CachedInputs> > cached_inputs_;
+
+  /// @brief whether the kernels run outside the host, which only implements Mult() and GradientMult() on E-vectors
+  bool on_device_ = false;
+
+  /// @brief the values of an E-vector block, in the memory the kernels of this integral read them from
+  const double* ReadBlock(const mfem::Vector& block) const
+  {
+    return mfem::Read(block.GetMemory(), block.Size(), on_device_);
+  }
+
+  /// @brief the values of an E-vector block, in the memory the kernels of this integral add their outputs to
+  double* ReadWriteBlock(mfem::Vector& block) const
+  {
+    return mfem::ReadWrite(block.GetMemory(), block.Size(), on_device_);
+  }
+
+  /// @brief for each trial space, the functions that create its derivative kernels (one per element type), or
+  /// nothing if they have already been created, see GenerateDerivativeKernels()
+  std::vector<std::vector<std::function<void(Integral&)> > > derivative_kernel_generators_;
 };
 
+/**
+ * @brief function to generate the kernels of an `Integral` object of type "Domain" that run in the execution space
+ * @a exec (e.g. on the device), with a specific element type
+ *
+ * Only Integral::Mult() and Integral::GradientMult() are implemented there, see
+ * domain_integral::device_kernels(). The other kernels report an error, and the integral opts out of tiling,
+ * fusing and recomputing its gradient, see Integral::on_device_.
+ *
+ * @tparam geom the element geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
+ * @param s an object used to pass around test/trial information
+ * @param integral the Integral object to initialize
+ * @param qf the quadrature function, which must be callable in @a exec
+ */
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type>
+void generate_device_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& qf)
+{
+  GeometricFactors& gf           = *integral.geometric_factors_[geom];
+  const uint32_t    num_elements = uint32_t(gf.num_elements);
+  integral.on_device_            = true;
+
+  // the element ids are copied to the memory of exec once, and shared by every kernel
+  auto elements =
+      std::make_shared<ExecArray<int, 1, exec> >(accelerator::make_exec_array<exec>(integral.domain_.get(geom)));
+
+  auto dummy_derivatives     = std::make_shared<accelerator::LazyArray<exec, zero> >(0);
+  integral.evaluation_[geom] =
+      domain_integral::device_kernels<exec, NO_DIFFERENTIATION, Q, geom>(s, qf, gf, dummy_derivatives, elements).first;
+  integral.batched_evaluation_[geom] = [](double, const std::vector<std::vector<const double*> >&,
+                                          const std::vector<double*>&) {
+    SLIC_ERROR("evaluating several sets of inputs at once is only implemented on the host");
+  };
+
+  constexpr std::size_t                 num_args = s.num_args;
+  [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
+
+  std::shared_ptr<GeometricFactors> factors = integral.geometric_factors_[geom];
+  for_constexpr<num_args>([&](auto index) {
+    using trial_type      = typename std::tuple_element<index, std::tuple<trials...> >::type;
+    using derivative_type = decltype(domain_integral::get_derivative_type<index, dim, trials...>(qf, Nothing{}));
+    constexpr bool symmetric =
+        qfunction_has_symmetric_derivative<lambda_type, index>::value && std::is_same_v<test, trial_type>;
+    using double_storage = typename derivative_storage<derivative_type, symmetric>::type;
+    using single_storage = typename single_precision_derivative_storage<derivative_type, symmetric>::type;
+    using stored_type    = std::conditional_t<qfunction_has_single_precision_derivative<lambda_type, index>::value,
+                                           single_storage, double_storage>;
+    integral.planned_derivative_bytes_[index] += sizeof(stored_type) * num_elements * num_quadrature_points(geom, Q);
+
+    integral.derivative_kernel_generators_[index].push_back([=](Integral& self) {
+      using storage_type = accelerator::LazyArray<exec, stored_type>;
+      auto ptr           = std::make_shared<storage_type>(num_elements * num_quadrature_points(geom, Q));
+      self.release_derivatives_[index][geom] = [ptr]() { ptr->release(); };
+      self.derivative_bytes_[index][geom]    = [ptr]() { return ptr->bytes(); };
+
+      auto [evaluation, jvp] = domain_integral::device_kernels<exec, index, Q, geom>(s, qf, *factors, ptr, elements);
+      self.evaluation_with_AD_[index][geom] = evaluation;
+      self.jvp_[index][geom]                = jvp;
+
+      self.vjp_[index][geom] = [](const double*, double*) {
+        SLIC_ERROR("vector-jacobian products are only implemented on the host");
+      };
+      self.element_gradient_[index][geom] = [](ExecArrayView<double, 3, ExecutionSpace::CPU>) {
+        SLIC_ERROR("element gradients are only implemented on the host");
+      };
+      self.element_diagonal_[index][geom] = [](double*) {
+        SLIC_ERROR("element jacobian diagonals are only implemented on the host");
+      };
+    });
+  });
+}
+
 /**
  * @brief function to generate kernels held by an `Integral` object of type "Domain", with a specific element type
  *
  * @tparam geom the element geometry
  * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
  * @tparam test the kind of test functions used in the integral
  * @tparam trials the trial space(s) of the integral's inputs
  * @tparam lambda_type a callable object that implements the q-function concept
@@ -181,43 +883,108 @@ struct Integral {
  * @param qf the quadrature function
  * @param qdata the values of any quadrature point data for the material
  */
-template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type,
-          typename qpt_data_type>
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type, typename qpt_data_type>
 void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& qf,
                       std::shared_ptr<QuadratureData<qpt_data_type> > qdata)
 {
-  integral.geometric_factors_[geom] = GeometricFactors(integral.domain_, Q, geom);
-  GeometricFactors& gf              = integral.geometric_factors_[geom];
+  static_assert(exec == ExecutionSpace::CPU || std::is_same_v<qpt_data_type, Nothing>,
+                "domain integrals with quadrature point data are only implemented on the host");
+
+  integral.geometric_factors_[geom] = shared_setup::geometric_factors(integral.domain_, Q, geom);
+  GeometricFactors& gf              = *integral.geometric_factors_[geom];
   if (gf.num_elements == 0) return;
 
-  const double*  positions        = gf.X.Read();
-  const double*  jacobians        = gf.J.Read();
   const int*     elements         = &integral.domain_.get(geom)[0];
   const uint32_t num_elements     = uint32_t(gf.num_elements);
   const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
 
-  std::shared_ptr<zero> dummy_derivatives;
+  integral.kernel_counts_[geom] = estimate_kernel_counts<geom, Q, test, trials...>(num_elements);
+
+  if constexpr (exec != ExecutionSpace::CPU) {
+    generate_device_kernels<geom, Q, exec>(s, integral, qf);
+    return;
+  }
+
+  // the evaluations with and without derivatives add to the same element times
+  auto costs                    = std::make_shared<std::vector<double> >();
+  integral.element_costs_[geom] = costs;
+
+  // the evaluations with and without derivatives also share the cached values of unchanging arguments
+  auto cache                    = std::make_shared<domain_integral::CachedInputs>(s.num_args);
+  integral.cached_inputs_[geom] = cache;
+
+  auto dummy_derivatives = std::make_shared<accelerator::LazyArray<exec, zero> >(0);
   integral.evaluation_[geom] = domain_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
-      s, qf, positions, jacobians, qdata, dummy_derivatives, elements, num_elements);
+      s, qf, gf, qdata, dummy_derivatives, elements, num_elements, costs, cache);
+  integral.batched_evaluation_[geom] =
+      domain_integral::batched_evaluation_kernel<Q, geom>(s, qf, gf, qdata, elements, num_elements);
+  integral.tiled_evaluation_[geom] = domain_integral::tiled_evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
+      s, qf, gf, qdata, dummy_derivatives, costs);
+
+  // the tuned tile sizes are saved by kernel, which is identified by its spaces, quadrature rule and q-function
+  std::string key = std::string(mfem::Geometry::Name[geom]) + " Q=" + std::to_string(Q) + " " +
+                    typeid(s).name() + " " + typeid(lambda_type).name();
+  integral.tile_tuners_.emplace(geom, TileSizeTuner(key, num_elements));
 
   constexpr std::size_t                 num_args = s.num_args;
   [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
+
+  std::shared_ptr<GeometricFactors> factors = integral.geometric_factors_[geom];
   for_constexpr<num_args>([&](auto index) {
-    // allocate memory for the derivatives of the q-function at each quadrature point
-    //
-    // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
-    // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
-    // that of the DomainIntegral that allocated it.
+    // Note: when the derivatives are symmetric, only their upper triangles are stored, see SymmetricDerivative,
+    // and q-functions can opt in to storing them in single precision, see SinglePrecisionDerivative
+    using trial_type      = typename std::tuple_element<index, std::tuple<trials...> >::type;
     using derivative_type = decltype(domain_integral::get_derivative_type<index, dim, trials...>(qf, qpt_data_type{}));
-    auto ptr = accelerator::make_shared_array<ExecutionSpace::CPU, derivative_type>(num_elements * qpts_per_element);
+    constexpr bool symmetric =
+        qfunction_has_symmetric_derivative<lambda_type, index>::value && std::is_same_v<test, trial_type>;
+    using double_storage = typename derivative_storage<derivative_type, symmetric>::type;
+    using single_storage = typename single_precision_derivative_storage<derivative_type, symmetric>::type;
+    using stored_type    = std::conditional_t<qfunction_has_single_precision_derivative<lambda_type, index>::value,
+                                           single_storage, double_storage>;
+    integral.planned_derivative_bytes_[index] += sizeof(stored_type) * num_elements * qpts_per_element;
+
+    // the kernels that use the q-function derivatives w.r.t. this argument are only created if it is
+    // actually differentiated, see Integral::GenerateDerivativeKernels()
+    integral.derivative_kernel_generators_[index].push_back([=](Integral& self) {
+      // create (but don't allocate yet) storage for the derivatives of the q-function at each quadrature point.
+      // The memory is allocated the first time the q-function is differentiated w.r.t. this argument,
+      // and can be freed afterwards with Integral::ReleaseDerivatives()
+      //
+      // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
+      // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
+      // that of the DomainIntegral that allocated it.
+      using storage_type = accelerator::LazyArray<exec, stored_type>;
+      auto ptr           = std::make_shared<storage_type>(num_elements * qpts_per_element);
+      self.release_derivatives_[index][geom] = [ptr]() { ptr->release(); };
+      self.derivative_bytes_[index][geom]    = [ptr]() { return ptr->bytes(); };
+
+      self.evaluation_with_AD_[index][geom] = domain_integral::evaluation_kernel<index, Q, geom>(
+          s, qf, *factors, qdata, ptr, elements, num_elements, costs, cache);
+      self.tiled_evaluation_with_AD_[index][geom] =
+          domain_integral::tiled_evaluation_kernel<index, Q, geom>(s, qf, *factors, qdata, ptr, costs);
 
-    integral.evaluation_with_AD_[index][geom] = domain_integral::evaluation_kernel<index, Q, geom>(
-        s, qf, positions, jacobians, qdata, ptr, elements, num_elements);
+      self.jvp_[index][geom] =
+          domain_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.fused_jvp_[index][geom] =
+          domain_integral::fused_jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.vjp_[index][geom] =
+          domain_integral::vector_jacobian_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.recomputed_jvp_[index][geom] =
+          domain_integral::recomputed_jvp_kernel<index, Q, geom>(s, qf, *factors, qdata, elements, num_elements);
+      self.element_gradient_[index][geom] =
+          domain_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
 
-    integral.jvp_[index][geom] =
-        domain_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
-    integral.element_gradient_[index][geom] =
-        domain_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      // element diagonals are only defined when the trial space matches the test space
+      if constexpr (std::is_same_v<test, trial_type>) {
+        self.element_diagonal_[index][geom] =
+            domain_integral::element_diagonal_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      } else {
+        self.element_diagonal_[index][geom] = [](double*) {
+          SLIC_ERROR("element jacobian diagonals require the trial space to match the test space");
+        };
+      }
+    });
   });
 }
 
@@ -227,6 +994,7 @@ void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral,
  * @tparam s a function signature type containing test/trial space informationa type containing a function signature
  * @tparam Q a parameter that controls the number of quadrature points
  * @tparam dim the dimension of the domain
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
  * @tparam lambda_type a callable object that implements the q-function concept
  * @tparam qpt_data_type any quadrature point data needed by the material model
  * @param domain the domain of integration
@@ -235,7 +1003,8 @@ void generate_kernels(FunctionSignature<test(trials...)> s, Integral& integral,
  * @param argument_indices the indices of trial space arguments used in the Integral
  * @return Integral the initialized `Integral` object
  */
-template <typename s, int Q, int dim, typename lambda_type, typename qpt_data_type>
+template <typename s, int Q, int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda_type,
+          typename qpt_data_type>
 Integral MakeDomainIntegral(const Domain& domain, const lambda_type& qf,
                             std::shared_ptr<QuadratureData<qpt_data_type> > qdata,
                             std::vector<uint32_t>                           argument_indices)
@@ -247,13 +1016,21 @@ Integral MakeDomainIntegral(const Domain& domain, const lambda_type& qf,
   Integral integral(domain, argument_indices);
 
   if constexpr (dim == 2) {
-    generate_kernels<mfem::Geometry::TRIANGLE, Q>(signature, integral, qf, qdata);
-    generate_kernels<mfem::Geometry::SQUARE, Q>(signature, integral, qf, qdata);
+    generate_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf, qdata);
+    generate_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf, qdata);
   }
 
   if constexpr (dim == 3) {
-    generate_kernels<mfem::Geometry::TETRAHEDRON, Q>(signature, integral, qf, qdata);
-    generate_kernels<mfem::Geometry::CUBE, Q>(signature, integral, qf, qdata);
+    generate_kernels<mfem::Geometry::TETRAHEDRON, Q, exec>(signature, integral, qf, qdata);
+    generate_kernels<mfem::Geometry::CUBE, Q, exec>(signature, integral, qf, qdata);
+
+    // wedge elements are only implemented for some spaces (e.g. linear H1)
+    if constexpr (supports_geometry<mfem::Geometry::PRISM, s>::value) {
+      generate_kernels<mfem::Geometry::PRISM, Q, exec>(signature, integral, qf, qdata);
+    } else {
+      SLIC_ERROR_IF(!domain.get(mfem::Geometry::PRISM).empty(),
+                    "Error: the function spaces of this integral are not implemented on wedge elements");
+    }
   }
 
   return integral;
@@ -265,6 +1042,7 @@ Integral MakeDomainIntegral(const Domain& domain, const lambda_type& qf,
  *
  * @tparam geom the element geometry
  * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
  * @tparam test the kind of test functions used in the integral
  * @tparam trials the trial space(s) of the integral's inputs
  * @tparam lambda_type a callable object that implements the q-function concept
@@ -272,11 +1050,15 @@ Integral MakeDomainIntegral(const Domain& domain, const lambda_type& qf,
  * @param integral the Integral object to initialize
  * @param qf the quadrature function
  */
-template <mfem::Geometry::Type geom, int Q, typename test, typename... trials, typename lambda_type>
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type>
 void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& qf)
 {
-  integral.geometric_factors_[geom] = GeometricFactors(integral.domain_, Q, geom, FaceType::BOUNDARY);
-  GeometricFactors& gf              = integral.geometric_factors_[geom];
+  static_assert(exec == ExecutionSpace::CPU,
+                "boundary integral kernels are only implemented on the host so far, use ExecutionSpace::CPU");
+
+  integral.geometric_factors_[geom] = shared_setup::geometric_factors(integral.domain_, Q, geom, FaceType::BOUNDARY);
+  GeometricFactors& gf              = *integral.geometric_factors_[geom];
   if (gf.num_elements == 0) return;
 
   const double*  positions        = gf.X.Read();
@@ -285,28 +1067,56 @@ void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integr
   const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
   const int*     elements         = &gf.elements[0];
 
-  std::shared_ptr<zero> dummy_derivatives;
+  integral.kernel_counts_[geom] = estimate_kernel_counts<geom, Q, test, trials...>(num_elements);
+
+  auto dummy_derivatives = std::make_shared<accelerator::LazyArray<exec, zero> >(0);
   integral.evaluation_[geom] = boundary_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
       s, qf, positions, jacobians, dummy_derivatives, elements, num_elements);
+  integral.batched_evaluation_[geom] =
+      boundary_integral::batched_evaluation_kernel<Q, geom>(s, qf, positions, jacobians, elements, num_elements);
 
   constexpr std::size_t                 num_args = s.num_args;
   [[maybe_unused]] static constexpr int dim      = dimension_of(geom);
   for_constexpr<num_args>([&](auto index) {
-    // allocate memory for the derivatives of the q-function at each quadrature point
-    //
-    // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
-    // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
-    // that of the boundaryIntegral that allocated it.
     using derivative_type = decltype(boundary_integral::get_derivative_type<index, dim, trials...>(qf));
-    auto ptr = accelerator::make_shared_array<ExecutionSpace::CPU, derivative_type>(num_elements * qpts_per_element);
+    integral.planned_derivative_bytes_[index] += sizeof(derivative_type) * num_elements * qpts_per_element;
+
+    // the kernels that use the q-function derivatives w.r.t. this argument are only created if it is
+    // actually differentiated, see Integral::GenerateDerivativeKernels()
+    integral.derivative_kernel_generators_[index].push_back([=](Integral& self) {
+      // create (but don't allocate yet) storage for the derivatives of the q-function at each quadrature point.
+      // The memory is allocated the first time the q-function is differentiated w.r.t. this argument,
+      // and can be freed afterwards with Integral::ReleaseDerivatives()
+      //
+      // Note: ptrs' lifetime is managed in an unusual way! It is captured by-value in the
+      // action_of_gradient functor below to augment the reference count, and extend its lifetime to match
+      // that of the boundaryIntegral that allocated it.
+      using storage_type = accelerator::LazyArray<exec, derivative_type>;
+      auto ptr           = std::make_shared<storage_type>(num_elements * qpts_per_element);
+      self.release_derivatives_[index][geom] = [ptr]() { ptr->release(); };
+      self.derivative_bytes_[index][geom]    = [ptr]() { return ptr->bytes(); };
+
+      self.evaluation_with_AD_[index][geom] = boundary_integral::evaluation_kernel<index, Q, geom>(
+          s, qf, positions, jacobians, ptr, elements, num_elements);
 
-    integral.evaluation_with_AD_[index][geom] =
-        boundary_integral::evaluation_kernel<index, Q, geom>(s, qf, positions, jacobians, ptr, elements, num_elements);
+      self.jvp_[index][geom] =
+          boundary_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.vjp_[index][geom] =
+          boundary_integral::vector_jacobian_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.element_gradient_[index][geom] =
+          boundary_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
 
-    integral.jvp_[index][geom] =
-        boundary_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
-    integral.element_gradient_[index][geom] =
-        boundary_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      // element diagonals are only defined when the trial space matches the test space
+      using trial_type = typename std::tuple_element<index, std::tuple<trials...> >::type;
+      if constexpr (std::is_same_v<test, trial_type>) {
+        self.element_diagonal_[index][geom] =
+            boundary_integral::element_diagonal_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      } else {
+        self.element_diagonal_[index][geom] = [](double*) {
+          SLIC_ERROR("element jacobian diagonals require the trial space to match the test space");
+        };
+      }
+    });
   });
 }
 
@@ -316,6 +1126,7 @@ void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integr
  * @tparam s a function signature type containing test/trial space informationa type containing a function signature
  * @tparam Q a parameter that controls the number of quadrature points
  * @tparam dim the dimension of the domain
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
  * @tparam lambda_type a callable object that implements the q-function concept
  * @param domain the domain of integration
  * @param qf the quadrature function
@@ -324,7 +1135,7 @@ void generate_bdr_kernels(FunctionSignature<test(trials...)> s, Integral& integr
  *
  * @note this function is not meant to be called by users
  */
-template <typename s, int Q, int dim, typename lambda_type>
+template <typename s, int Q, int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda_type>
 Integral MakeBoundaryIntegral(const Domain& domain, const lambda_type& qf, std::vector<uint32_t> argument_indices)
 {
   FunctionSignature<s> signature;
@@ -335,12 +1146,138 @@ Integral MakeBoundaryIntegral(const Domain& domain, const lambda_type& qf, std::
   Integral integral(domain, argument_indices);
 
   if constexpr (dim == 1) {
-    generate_bdr_kernels<mfem::Geometry::SEGMENT, Q>(signature, integral, qf);
+    generate_bdr_kernels<mfem::Geometry::SEGMENT, Q, exec>(signature, integral, qf);
+  }
+
+  if constexpr (dim == 2) {
+    generate_bdr_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf);
+    generate_bdr_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf);
+  }
+
+  return integral;
+}
+
+/**
+ * @brief function to generate kernels held by an `Integral` object of type "InteriorFaces", with a specific face
+ * geometry
+ *
+ * @tparam geom the face geometry
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
+ * @tparam test the kind of test functions used in the integral
+ * @tparam trials the trial space(s) of the integral's inputs
+ * @tparam lambda_type a callable object that implements the q-function concept
+ * @param s an object used to pass around test/trial information
+ * @param integral the Integral object to initialize
+ * @param qf the quadrature function
+ */
+template <mfem::Geometry::Type geom, int Q, ExecutionSpace exec, typename test, typename... trials,
+          typename lambda_type>
+void generate_interior_face_kernels(FunctionSignature<test(trials...)> s, Integral& integral, const lambda_type& qf)
+{
+  static_assert(exec == ExecutionSpace::CPU,
+                "interior face integral kernels are only implemented on the host so far, use ExecutionSpace::CPU");
+
+  integral.geometric_factors_[geom] = shared_setup::geometric_factors(integral.domain_, Q, geom, FaceType::INTERIOR);
+  GeometricFactors& gf              = *integral.geometric_factors_[geom];
+  if (gf.num_elements == 0) return;
+
+  const double*  positions        = gf.X.Read();
+  const double*  jacobians        = gf.J.Read();
+  const uint32_t num_elements     = uint32_t(gf.num_elements);
+  const uint32_t qpts_per_element = num_quadrature_points(geom, Q);
+  const int*     elements         = &gf.elements[0];
+
+  // each face interpolates and integrates the dofs of both of its sides
+  KernelCounts counts = estimate_kernel_counts<geom, Q, test, trials...>(num_elements);
+  counts.dofs *= 2;
+  counts.flops *= 2.0;
+  integral.kernel_counts_[geom] = counts;
+
+  auto dummy_derivatives = std::make_shared<accelerator::LazyArray<exec, zero> >(0);
+  integral.evaluation_[geom] = interior_face_integral::evaluation_kernel<NO_DIFFERENTIATION, Q, geom>(
+      s, qf, positions, jacobians, dummy_derivatives, elements, num_elements);
+  integral.batched_evaluation_[geom] =
+      interior_face_integral::batched_evaluation_kernel<Q, geom>(s, qf, positions, jacobians, elements, num_elements);
+
+  constexpr std::size_t num_args = s.num_args;
+  for_constexpr<num_args>([&](auto index) {
+    using derivative_type = decltype(interior_face_integral::get_derivative_type<index, geom, trials...>(qf));
+    integral.planned_derivative_bytes_[index] += sizeof(derivative_type) * num_elements * qpts_per_element;
+
+    // the kernels that use the q-function derivatives w.r.t. this argument are only created if it is
+    // actually differentiated, see Integral::GenerateDerivativeKernels()
+    integral.derivative_kernel_generators_[index].push_back([=](Integral& self) {
+      // create (but don't allocate yet) storage for the derivatives of the q-function at each quadrature point,
+      // see generate_bdr_kernels()
+      using storage_type    = accelerator::LazyArray<exec, derivative_type>;
+      auto ptr              = std::make_shared<storage_type>(num_elements * qpts_per_element);
+      self.release_derivatives_[index][geom] = [ptr]() { ptr->release(); };
+      self.derivative_bytes_[index][geom]    = [ptr]() { return ptr->bytes(); };
+
+      self.evaluation_with_AD_[index][geom] = interior_face_integral::evaluation_kernel<index, Q, geom>(
+          s, qf, positions, jacobians, ptr, elements, num_elements);
+
+      self.jvp_[index][geom] =
+          interior_face_integral::jacobian_vector_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.vjp_[index][geom] =
+          interior_face_integral::vector_jacobian_product_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      self.element_gradient_[index][geom] =
+          interior_face_integral::element_gradient_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+
+      // element diagonals are only defined when the trial space matches the test space
+      using trial_type = typename std::tuple_element<index, std::tuple<trials...> >::type;
+      if constexpr (std::is_same_v<test, trial_type>) {
+        self.element_diagonal_[index][geom] =
+            interior_face_integral::element_diagonal_kernel<index, Q, geom>(s, ptr, elements, num_elements);
+      } else {
+        self.element_diagonal_[index][geom] = [](double*) {
+          SLIC_ERROR("element jacobian diagonals require the trial space to match the test space");
+        };
+      }
+    });
+  });
+}
+
+/**
+ * @brief function to generate kernels held by an `Integral` object of type "InteriorFaces", for all face geometries
+ *
+ * @tparam s a function signature type containing test/trial space information
+ * @tparam Q a parameter that controls the number of quadrature points
+ * @tparam dim the dimension of the faces
+ * @tparam exec where the q-function derivatives are stored and the kernels are executed
+ * @tparam lambda_type a callable object that implements the q-function concept
+ * @param domain the interior faces to integrate over
+ * @param qf the quadrature function
+ * @param argument_indices the indices of trial space arguments used in the Integral
+ * @return Integral the initialized `Integral` object
+ *
+ * @note this function is not meant to be called by users
+ */
+template <typename s, int Q, int dim, ExecutionSpace exec = ExecutionSpace::CPU, typename lambda_type>
+Integral MakeInteriorFaceIntegral(const Domain& domain, const lambda_type& qf, std::vector<uint32_t> argument_indices)
+{
+  FunctionSignature<s> signature;
+
+  using test_space = typename FunctionSignature<s>::return_type;
+  static_assert(test_space::family == Family::L2, "interior face integrals require an L2 test space");
+  for_constexpr<FunctionSignature<s>::num_args>([](auto i) {
+    using trial_space = typename std::tuple_element<i, typename FunctionSignature<s>::parameter_types>::type;
+    static_assert(trial_space::family == Family::L2, "interior face integrals require L2 trial spaces");
+  });
+
+  SLIC_ERROR_IF(domain.type_ != Domain::Type::InteriorFaces,
+                "Error: trying to evaluate an interior face integral over a domain that isn't made of interior faces");
+
+  Integral integral(domain, argument_indices);
+
+  if constexpr (dim == 1) {
+    generate_interior_face_kernels<mfem::Geometry::SEGMENT, Q, exec>(signature, integral, qf);
   }
 
   if constexpr (dim == 2) {
-    generate_bdr_kernels<mfem::Geometry::TRIANGLE, Q>(signature, integral, qf);
-    generate_bdr_kernels<mfem::Geometry::SQUARE, Q>(signature, integral, qf);
+    generate_interior_face_kernels<mfem::Geometry::TRIANGLE, Q, exec>(signature, integral, qf);
+    generate_interior_face_kernels<mfem::Geometry::SQUARE, Q, exec>(signature, integral, qf);
   }
 
   return integral;
@@ -0,0 +1,495 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file interior_face_integral_kernels.hpp
+ *
+ * @brief Kernels for integrals over the interior faces of a mesh, e.g. the jump terms of discontinuous Galerkin
+ * methods
+ *
+ * The E-vector of an interior face holds the traces of both of its elements, as [component][side][node] (see
+ * GetFaceDofs()). Side 1 is the element that the face normal points out of. Each side is interpolated and integrated
+ * with the (sum-factorized) kernels of the face's finite element, so these kernels only handle the coupling of the
+ * two sides at each quadrature point.
+ */
+#pragma once
+
+#include <array>
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/numerics/functional/quadrature_data.hpp"
+#include "serac/numerics/functional/differentiate_wrt.hpp"
+#include "serac/numerics/functional/boundary_integral_kernels.hpp"
+
+namespace serac {
+
+namespace interior_face_integral {
+
+/**
+ * @tparam geom the face geometry
+ * @tparam space the user-specified trial space
+ *
+ * @brief what is passed to an interior face q-function for the given trial space: its values on side 1 and side 2
+ * of the face
+ */
+template <mfem::Geometry::Type geom, typename space>
+struct QFunctionArgument {
+  /// the value of the trial space on each side of the face
+  using value_type = typename finite_element<geom, space>::value_type;
+
+  using type = serac::tuple<value_type, value_type>;  ///< what will be passed to the q-function
+};
+
+/// @brief the number of doubles in the E-vector of each interior face, for both sides
+template <typename element_type>
+constexpr std::size_t face_size = 2 * element_type::ndof * element_type::components;
+
+/// @brief copy the nodal values of one side of an interior face out of its (two-sided) E-vector entries
+template <typename element_type>
+SERAC_HOST_DEVICE auto load_side(const double* face_dofs, int side)
+{
+  constexpr int n = element_type::ndof;
+
+  typename element_type::dof_type u;
+  double*                         values = reinterpret_cast<double*>(&u);
+  for (int c = 0; c < element_type::components; c++) {
+    for (int k = 0; k < n; k++) {
+      values[c * n + k] = face_dofs[(c * 2 + side) * n + k];
+    }
+  }
+  return u;
+}
+
+/// @brief add the nodal values of one side of an interior face to its (two-sided) E-vector entries
+template <typename element_type>
+SERAC_HOST_DEVICE void add_side(const typename element_type::dof_type& r, double* face_dofs, int side)
+{
+  constexpr int n = element_type::ndof;
+
+  const double* values = reinterpret_cast<const double*>(&r);
+  for (int c = 0; c < element_type::components; c++) {
+    for (int k = 0; k < n; k++) {
+      face_dofs[(c * 2 + side) * n + k] += values[c * n + k];
+    }
+  }
+}
+
+/**
+ * @brief interpolate the values of both sides of an interior face at each quadrature point
+ *
+ * @param E the E-vector of interior face values
+ * @param face which face of the E-vector to interpolate
+ * @return a tensor of tuple{side 1 value, side 2 value}, one for each quadrature point
+ */
+template <typename element_type, int Q>
+SERAC_HOST_DEVICE auto interpolate_both_sides(const double* E, int face, const TensorProductQuadratureRule<Q>& rule)
+{
+  constexpr int nqp   = num_quadrature_points(element_type::geometry, Q);
+  const double* dofs  = E + std::size_t(face) * face_size<element_type>;
+  auto          side1 = element_type::interpolate(load_side<element_type>(dofs, 0), rule);
+  auto          side2 = element_type::interpolate(load_side<element_type>(dofs, 1), rule);
+
+  using value_type = std::decay_t<decltype(get<0>(side1[0]))>;
+  tensor<tuple<value_type, value_type>, nqp> values{};
+  for (int q = 0; q < nqp; q++) {
+    values[q] = tuple{get<0>(side1[q]), get<0>(side2[q])};
+  }
+  return values;
+}
+
+/**
+ * @brief integrate the sources on each side of an interior face against the test functions of that side, and add
+ * them to the E-vector
+ *
+ * @param sources a tensor of tuple{side 1 source, side 2 source}, one for each quadrature point
+ * @param E the E-vector of interior face values
+ * @param face which face of the E-vector to add to
+ */
+template <typename element_type, int Q, typename T, int nqp>
+SERAC_HOST_DEVICE void integrate_both_sides(const tensor<T, nqp>& sources, double* E, int face,
+                                            const TensorProductQuadratureRule<Q>& rule)
+{
+  double* dofs = E + std::size_t(face) * face_size<element_type>;
+  for_constexpr<2>([&](auto side) {
+    using source_type = std::decay_t<decltype(get_value(get<side>(T{})))>;
+    tensor<tuple<source_type, zero>, nqp> source_on_side{};
+    for (int q = 0; q < nqp; q++) {
+      get<0>(source_on_side[q]) = get_value(get<side>(sources[q]));
+    }
+
+    typename element_type::dof_type r{};
+    element_type::integrate(source_on_side, rule, &r);
+    add_side<element_type>(r, dofs, side);
+  });
+}
+
+/// @brief the jacobian of an interior face (embedded in 2D or 3D) at quadrature point q, as passed to the q-function
+template <int dim, typename jacobians_type>
+SERAC_HOST_DEVICE auto face_jacobian(const jacobians_type& jacobians, int q)
+{
+  if constexpr (dim == 2) {
+    return tensor<double, 2>{jacobians(0, 0, q), jacobians(0, 1, q)};
+  } else {
+    tensor<double, dim, dim - 1> J_q{};
+    for (int j = 0; j < dim; j++) {
+      for (int k = 0; k < dim - 1; k++) {
+        J_q(j, k) = jacobians(k, j, q);
+      }
+    }
+    return J_q;
+  }
+}
+
+/**
+ * @brief evaluate the q-function at each quadrature point of an interior face
+ *
+ * @return a tensor of tuple{side 1 source, side 2 source}, already scaled by the area of the face
+ */
+template <typename lambda, int dim, int n, typename jacobians_type, typename... T>
+SERAC_HOST_DEVICE auto batch_apply_qf(lambda qf, double t, const tensor<double, dim, n>& positions,
+                                      const jacobians_type& jacobians, const T&... inputs)
+{
+  using jacobian_type = decltype(face_jacobian<dim>(jacobians, 0));
+  using return_type   = decltype(qf(double{}, serac::tuple{tensor<double, dim>{}, jacobian_type{}}, T{}[0]...));
+  static_assert(serac::tuple_size<return_type>::value == 2,
+                "interior face q-functions must return tuple{side 1 source, side 2 source}");
+
+  tensor<return_type, n> outputs{};
+  for (int i = 0; i < n; i++) {
+    tensor<double, dim> x_q;
+    for (int j = 0; j < dim; j++) {
+      x_q[j] = positions(j, i);
+    }
+    auto   J_q   = face_jacobian<dim>(jacobians, i);
+    double scale = norm(cross(J_q));
+
+    auto sources = qf(t, serac::tuple{x_q, J_q}, inputs[i]...);
+    outputs[i]   = return_type{get<0>(sources) * scale, get<1>(sources) * scale};
+  }
+  return outputs;
+}
+
+/**
+ * @brief the type of the derivatives of an interior face q-function w.r.t. argument i, at one quadrature point:
+ * tuple{tuple{d(side 1 source)/d(side 1 value), d(side 1 source)/d(side 2 value)}, tuple{d(side 2 source)/...}}
+ */
+template <int i, mfem::Geometry::Type geom, typename... trials, typename lambda>
+auto get_derivative_type(lambda qf)
+{
+  constexpr int dim  = dimension_of(geom) + 1;
+  using qf_arguments = serac::tuple<typename QFunctionArgument<geom, trials>::type...>;
+  return get_gradient(
+      boundary_integral::apply_qf(qf, double{}, tensor<double, dim>{}, make_dual_wrt<i>(qf_arguments{})));
+};
+
+/// @trial_elements the element type for each trial space
+template <uint32_t differentiation_index, int Q, mfem::Geometry::Type geom, typename test_element,
+          typename trial_element_type, typename lambda_type, typename derivative_type, int... indices>
+void evaluation_kernel_impl(trial_element_type trial_elements, test_element, double t,
+                            const std::vector<const double*>& inputs, double* outputs, const double* positions,
+                            const double* jacobians, lambda_type qf, [[maybe_unused]] derivative_type* qf_derivatives,
+                            const int* elements, uint32_t num_elements, camp::int_seq<int, indices...>)
+{
+  constexpr int dim = dimension_of(geom) + 1;
+  constexpr int nqp = num_quadrature_points(geom, Q);
+  auto          J   = reinterpret_cast<const tensor<double, dim - 1, dim, nqp>*>(jacobians);
+  auto          x   = reinterpret_cast<const tensor<double, dim, nqp>*>(positions);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  // note: each face writes to its own block of the E-vector (and its own q-function derivatives),
+  // so the faces can be processed concurrently without any synchronization
+  accelerator::forall_host(num_elements, [&](uint32_t e) {
+    // batch-calculate the values of each trial space on both sides of the face, at each quadrature point
+    [[maybe_unused]] tuple qf_inputs = {promote_each_to_dual_when<indices == differentiation_index>(
+        interpolate_both_sides<decltype(type<indices>(trial_elements))>(inputs[indices], elements[e], rule))...};
+
+    // (batch) evalute the q-function at each quadrature point
+    auto qf_outputs = batch_apply_qf(qf, t, x[e], J[e], get<indices>(qf_inputs)...);
+
+    if constexpr (differentiation_index != serac::NO_DIFFERENTIATION) {
+      for (int q = 0; q < nqp; q++) {
+        qf_derivatives[e * nqp + uint32_t(q)] = get_gradient(qf_outputs[q]);
+      }
+    }
+
+    // (batch) integrate the sources against the test-space basis functions of each side
+    integrate_both_sides<test_element>(qf_outputs, outputs, elements[e], rule);
+  });
+}
+
+/// @brief the directional derivative of both sources, given the derivatives of the q-function and the inputs
+template <typename S, typename T>
+SERAC_HOST_DEVICE auto chain_rule(const S& dfdx, const T& dx)
+{
+  auto side = [&](const auto& df_side) {
+    return serac::chain_rule(get<0>(df_side), get<0>(dx)) + serac::chain_rule(get<1>(df_side), get<1>(dx));
+  };
+  return serac::tuple{side(get<0>(dfdx)), side(get<1>(dfdx))};
+}
+
+/**
+ * @brief The kernel template used to create the directional derivative kernels of interior face integrals
+ *
+ * @tparam Q parameter describing number of quadrature points (see num_quadrature_points() function for more details)
+ * @tparam geom The shape of the face
+ * @tparam test The type of the test function space
+ * @tparam trial The type of the trial function space
+ * @tparam derivatives_type Type representing the derivative of the q-function w.r.t. its input arguments
+ *
+ * @param[in] dU The full set of per-face trial space values, for both sides (primary input)
+ * @param[inout] dR The full set of per-face residuals, for both sides (primary output)
+ * @param[in] qf_derivatives The derivatives of the q-function at each quadrature point
+ * @param[in] elements The indices of the faces to integrate over
+ * @param[in] num_elements The number of faces in the domain
+ */
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+void action_of_gradient_kernel(const double* dU, double* dR, derivatives_type* qf_derivatives, const int* elements,
+                               std::size_t num_elements)
+{
+  using test_element  = finite_element<geom, test>;
+  using trial_element = finite_element<geom, trial>;
+
+  constexpr int                                   nqp = num_quadrature_points(geom, Q);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    auto du = interpolate_both_sides<trial_element>(dU, elements[e], rule);
+
+    using output_type = decltype(chain_rule(derivatives_type{}, du[0]));
+    tensor<output_type, nqp> qf_outputs{};
+    for (int q = 0; q < nqp; q++) {
+      qf_outputs[q] = chain_rule(qf_derivatives[e * nqp + uint32_t(q)], du[q]);
+    }
+
+    integrate_both_sides<test_element>(qf_outputs, dR, elements[e], rule);
+  });
+}
+
+/// @brief the vector-jacobian product for the values on both sides, given the derivatives of the q-function
+template <typename X, typename S, typename T>
+SERAC_HOST_DEVICE auto transpose_chain_rule(const S& dfdx, const T& dy)
+{
+  auto side = [&](auto input_side) {
+    return serac::transpose_chain_rule<X>(get<input_side>(get<0>(dfdx)), get<0>(dy)) +
+           serac::transpose_chain_rule<X>(get<input_side>(get<1>(dfdx)), get<1>(dy));
+  };
+  return serac::tuple{side(std::integral_constant<int, 0>{}), side(std::integral_constant<int, 1>{})};
+}
+
+/**
+ * @brief The kernel template used to create the transpose of the directional derivative kernels of interior face
+ * integrals, i.e. the vector-jacobian products used by adjoint and sensitivity calculations
+ *
+ * @param[in] dR The full set of per-face values in the test space, for both sides (primary input)
+ * @param[inout] dU The full set of per-face values in the trial space, for both sides (primary output)
+ * @param[in] qf_derivatives The derivatives of the q-function at each quadrature point
+ * @param[in] elements The indices of the faces to integrate over
+ * @param[in] num_elements The number of faces in the domain
+ */
+template <int Q, mfem::Geometry::Type geom, typename test, typename trial, typename derivatives_type>
+void action_of_gradient_transpose_kernel(const double* dR, double* dU, derivatives_type* qf_derivatives,
+                                         const int* elements, std::size_t num_elements)
+{
+  using test_element  = finite_element<geom, test>;
+  using trial_element = finite_element<geom, trial>;
+
+  constexpr int                                   nqp = num_quadrature_points(geom, Q);
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  using trial_value = typename QFunctionArgument<geom, trial>::value_type;
+
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    auto dr = interpolate_both_sides<test_element>(dR, elements[e], rule);
+
+    using output_type = decltype(transpose_chain_rule<trial_value>(derivatives_type{}, dr[0]));
+    tensor<output_type, nqp> qf_outputs{};
+    for (int q = 0; q < nqp; q++) {
+      qf_outputs[q] = transpose_chain_rule<trial_value>(qf_derivatives[e * nqp + uint32_t(q)], dr[q]);
+    }
+
+    // (batch) integrate against the trial-space basis functions of each side
+    integrate_both_sides<trial_element>(qf_outputs, dU, elements[e], rule);
+  });
+}
+
+/**
+ * @brief The kernel template used to compute the element gradient matrices of interior face integrals, which
+ * couple the dofs of both sides of each face
+ *
+ * @param[inout] dK 3-dimensional array storing the face gradient matrices, in the dof numbering of the two-sided
+ * face restrictions: (face, trial dof, test dof)
+ * @param[in] qf_derivatives The derivatives of the q-function at each quadrature point
+ * @param[in] elements The indices of the faces to integrate over
+ * @param[in] num_elements The number of faces in the domain
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
+void element_gradient_kernel(ExecArrayView<double, 3, ExecutionSpace::CPU> dK, derivatives_type* qf_derivatives,
+                             const int* elements, std::size_t num_elements)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+  constexpr int nt    = test_element::ndof;
+  constexpr int nu    = trial_element::ndof;
+  constexpr int ct    = test_element::components;
+  constexpr int cu    = trial_element::components;
+
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    int face = elements[e];
+
+    // the block of the face matrix that couples the trial functions of side `su` to the test functions of side `st`
+    for_constexpr<2, 2>([&](auto st, auto su) {
+      using block_type = decltype(get<su>(get<st>(derivatives_type{})));
+      tensor<tuple<tuple<block_type, zero>, zero>, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        get<0>(get<0>(derivatives(q))) = get<su>(get<st>(qf_derivatives[e * nquad + uint32_t(q)]));
+      }
+
+      for (int J = 0; J < nu; J++) {
+        typename test_element::dof_type column[cu]{};
+        auto                            source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+        test_element::integrate(source_and_flux, rule, column);
+
+        for (int ju = 0; ju < cu; ju++) {
+          const double* values = reinterpret_cast<const double*>(&column[ju]);
+          for (int it = 0; it < ct; it++) {
+            for (int k = 0; k < nt; k++) {
+              dK(face, (ju * 2 + su) * nu + J, (it * 2 + st) * nt + k) += values[it * nt + k];
+            }
+          }
+        }
+      }
+    });
+  });
+}
+
+/**
+ * @brief The kernel template used to compute only the diagonal entries of the face gradient matrices
+ *
+ * @param[inout] dE E-vector storing the diagonal entries of each face matrix, the values computed here are added
+ * to its existing contents
+ * @param[in] qf_derivatives The derivatives of the q-function at each quadrature point
+ * @param[in] elements The indices of the faces to process
+ * @param[in] num_elements The number of faces in the domain
+ */
+template <mfem::Geometry::Type g, typename test, typename trial, int Q, typename derivatives_type>
+void element_diagonal_kernel(double* dE, derivatives_type* qf_derivatives, const int* elements,
+                             std::size_t num_elements)
+{
+  using test_element  = finite_element<g, test>;
+  using trial_element = finite_element<g, trial>;
+
+  constexpr int nquad = num_quadrature_points(g, Q);
+  constexpr int ndof  = trial_element::ndof;
+  constexpr int ncomp = trial_element::components;
+
+  static constexpr TensorProductQuadratureRule<Q> rule{};
+
+  accelerator::forall_host(uint32_t(num_elements), [&](uint32_t e) {
+    double* diagonal = dE + std::size_t(elements[e]) * face_size<trial_element>;
+
+    // only the blocks that couple a side to itself have diagonal entries
+    for_constexpr<2>([&](auto side) {
+      using block_type = decltype(get<side>(get<side>(derivatives_type{})));
+      tensor<tuple<tuple<block_type, zero>, zero>, nquad> derivatives{};
+      for (int q = 0; q < nquad; q++) {
+        get<0>(get<0>(derivatives(q))) = get<side>(get<side>(qf_derivatives[e * nquad + uint32_t(q)]));
+      }
+
+      for (int J = 0; J < ndof; J++) {
+        typename test_element::dof_type column[ncomp]{};
+        auto                            source_and_flux = trial_element::batch_apply_shape_fn(J, derivatives, rule);
+        test_element::integrate(source_and_flux, rule, column);
+        for (int c = 0; c < ncomp; c++) {
+          diagonal[(c * 2 + side) * ndof + J] += reinterpret_cast<const double*>(&column[c])[c * ndof + J];
+        }
+      }
+    });
+  });
+}
+
+template <uint32_t wrt, int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type,
+          typename derivative_type>
+auto evaluation_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                       std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+{
+  auto trial_elements = trial_elements_tuple<geom>(s);
+  auto test_element   = get_test_element<geom>(s);
+  return [=](double time, const std::vector<const double*>& inputs, double* outputs, bool /* update state */) {
+    evaluation_kernel_impl<wrt, Q, geom>(trial_elements, test_element, time, inputs, outputs, positions, jacobians, qf,
+                                         qf_derivatives->get(), elements, num_elements, s.index_seq);
+  };
+}
+
+/// @brief evaluate an interior face integral for several sets of inputs, see Integral::BatchMult()
+template <int Q, mfem::Geometry::Type geom, typename signature, typename lambda_type>
+auto batched_evaluation_kernel(signature s, lambda_type qf, const double* positions, const double* jacobians,
+                               const int* elements, uint32_t num_elements)
+{
+  auto trial_elements = trial_elements_tuple<geom>(s);
+  auto test_element   = get_test_element<geom>(s);
+  return [=](double time, const std::vector<std::vector<const double*>>& inputs, const std::vector<double*>& outputs) {
+    for (std::size_t c = 0; c < outputs.size(); c++) {
+      evaluation_kernel_impl<NO_DIFFERENTIATION, Q, geom>(trial_elements, test_element, time, inputs[c], outputs[c],
+                                                          positions, jacobians, qf, static_cast<zero*>(nullptr),
+                                                          elements, num_elements, s.index_seq);
+    }
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(const double*, double*)> jacobian_vector_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+{
+  return [=](const double* du, double* dr) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    action_of_gradient_kernel<Q, geom, test_space, trial_space>(du, dr, qf_derivatives->get(), elements, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(const double*, double*)> vector_jacobian_product_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+{
+  return [=](const double* dr, double* du) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    action_of_gradient_transpose_kernel<Q, geom, test_space, trial_space>(dr, du, qf_derivatives->get(), elements,
+                                                                          num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(ExecArrayView<double, 3, ExecutionSpace::CPU>)> element_gradient_kernel(
+    signature, std::shared_ptr<derivative_type> qf_derivatives, const int* elements, uint32_t num_elements)
+{
+  return [=](ExecArrayView<double, 3, ExecutionSpace::CPU> K_elem) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    element_gradient_kernel<geom, test_space, trial_space, Q>(K_elem, qf_derivatives->get(), elements, num_elements);
+  };
+}
+
+template <int wrt, int Q, mfem::Geometry::Type geom, typename signature, typename derivative_type>
+std::function<void(double*)> element_diagonal_kernel(signature, std::shared_ptr<derivative_type> qf_derivatives,
+                                                     const int* elements, uint32_t num_elements)
+{
+  return [=](double* diagonal_E) {
+    using test_space  = typename signature::return_type;
+    using trial_space = typename std::tuple_element<wrt, typename signature::parameter_types>::type;
+    element_diagonal_kernel<geom, test_space, trial_space, Q>(diagonal_E, qf_derivatives->get(), elements,
+                                                              num_elements);
+  };
+}
+
+}  // namespace interior_face_integral
+
+}  // namespace serac
@@ -112,6 +112,21 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreNodes() {
 
   }
 
+  // a triangle rule in (xi[0], xi[1]) times a segment rule in xi[2], with the triangle points varying fastest
+  if constexpr (geom == mfem::Geometry::PRISM) {
+    constexpr auto triangle = GaussLegendreNodes<n, mfem::Geometry::TRIANGLE>();
+    constexpr auto segment  = GaussLegendreNodes<n, mfem::Geometry::SEGMENT>();
+    constexpr int  ntri     = n * (n + 1) / 2;
+
+    tensor<double, ntri * n, 3> output{};
+    for (int k = 0; k < n; k++) {
+      for (int i = 0; i < ntri; i++) {
+        output[k * ntri + i] = {triangle[i][0], triangle[i][1], segment[k]};
+      }
+    }
+    return output;
+  }
+
   if constexpr (geom == mfem::Geometry::TETRAHEDRON) {
     using output_t = tensor<double, (n * (n + 1) * (n + 2)) / 6, 3>;
     if constexpr (n == 1) {
@@ -311,6 +326,21 @@ SERAC_HOST_DEVICE constexpr auto GaussLegendreWeights()
     }
   }
 
+  // see GaussLegendreNodes() for the ordering of the points
+  if constexpr (geom == mfem::Geometry::PRISM) {
+    constexpr auto triangle = GaussLegendreWeights<n, mfem::Geometry::TRIANGLE>();
+    constexpr auto segment  = GaussLegendreWeights<n, mfem::Geometry::SEGMENT>();
+    constexpr int  ntri     = n * (n + 1) / 2;
+
+    tensor<double, ntri * n> output{};
+    for (int k = 0; k < n; k++) {
+      for (int i = 0; i < ntri; i++) {
+        output[k * ntri + i] = triangle[i] * segment[k];
+      }
+    }
+    return output;
+  }
+
   if constexpr (geom == mfem::Geometry::TETRAHEDRON) {
     using output_t = tensor< double, (n * (n + 1) * (n + 2)) / 6 >;
 
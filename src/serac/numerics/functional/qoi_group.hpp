@@ -0,0 +1,479 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file qoi_group.hpp
+ *
+ * @brief a collection of quantities of interest that are evaluated (and differentiated) together
+ */
+
+#pragma once
+
+#include "serac/numerics/functional/functional.hpp"
+
+namespace serac {
+
+/// @cond
+template <typename T, ExecutionSpace exec = serac::default_execution_space>
+class QoIGroup;
+/// @endcond
+
+/**
+ * @brief A set of scalar quantities of interest that share their trial spaces
+ *
+ * Evaluating N separate Functional<double(trials...)> objects prolongates and gathers the inputs N times, and
+ * does N reductions of a single value over the ranks. A QoIGroup does the prolongation and gather of each trial
+ * space once per evaluation, and sums all of the quantities over the ranks with a single MPI_Allreduce.
+ *
+ * Each integral is added to one of the quantities (by index), and a quantity may be made up of several integrals:
+ * @code{.cpp}
+ * QoIGroup<double(H1<1>)> qois({&fespace}, 2);
+ * qois.AddDomainIntegral(0, Dimension<3>{}, DependsOn<>{}, volume_integrand, mesh);
+ * qois.AddDomainIntegral(1, Dimension<3>{}, DependsOn<0>{}, energy_integrand, mesh);
+ * qois.AddBoundaryIntegral(1, Dimension<2>{}, DependsOn<0>{}, surface_energy_integrand, mesh);
+ *
+ * mfem::Vector values = qois(t, U);
+ * auto [values, dqois_dU] = qois(t, differentiate_wrt(U));
+ * auto gradients = assemble(dqois_dU);  // one T-vector per quantity
+ * @endcode
+ */
+template <typename... trials, ExecutionSpace exec>
+class QoIGroup<double(trials...), exec> {
+  using test = QOI;
+  static constexpr tuple<trials...> trial_spaces{};
+  static constexpr uint32_t         num_trial_spaces = sizeof...(trials);
+  static constexpr auto             Q                = std::max({test::order, trials::order...}) + 1;
+
+  class Gradient;
+
+  // clang-format off
+  template <uint32_t i>
+  struct operator_paren_return {
+    using type = typename std::conditional<
+        i == NO_DIFFERENTIATION,                // if `i` is greater than or equal to zero,
+        mfem::Vector&,                          // wise, we just return the values
+        serac::tuple<mfem::Vector&, Gradient&>  // otherwise, we return the values and the derivatives w.r.t arg `i`
+        >::type;
+  };
+  // clang-format on
+
+public:
+  /**
+   * @brief Constructs a group of quantities of interest
+   * @param[in] trial_fes The trial spaces
+   * @param[in] num_qois The number of quantities of interest in the group
+   */
+  QoIGroup(std::array<const mfem::ParFiniteElementSpace*, num_trial_spaces> trial_fes, uint32_t num_qois)
+      : trial_space_(trial_fes), num_qois_(num_qois), comm_(trial_fes[0]->GetParMesh()->GetComm())
+  {
+    SLIC_ERROR_ROOT_IF(num_qois == 0, "a QoIGroup must have at least one quantity of interest");
+
+    auto* mesh = trial_fes[0]->GetMesh();
+
+    auto mem_type = workspace_memory_type<exec>();
+
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+      input_E_[type].resize(num_trial_spaces);
+    }
+
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      P_trial_[i] = trial_space_[i]->GetProlongationMatrix();
+
+      input_L_[i].SetSize(P_trial_[i]->Height(), mem_type);
+
+      for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+        if (type == Domain::Type::Elements) {
+          G_trial_[type][i] = shared_setup::restriction(trial_fes[i]);
+        } else {
+          G_trial_[type][i] = shared_setup::restriction(trial_fes[i], FaceType::BOUNDARY);
+        }
+
+        input_E_[type][i].Update(G_trial_[type][i]->bOffsets(), mem_type);
+      }
+    }
+
+    for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+      std::array<uint32_t, mfem::Geometry::NUM_GEOMETRIES> counts{};
+      if (type == Domain::Type::Elements) {
+        counts = geometry_counts(*mesh);
+      } else {
+        counts = boundary_geometry_counts(*mesh);
+      }
+
+      mfem::Array<int> offsets(mfem::Geometry::NUM_GEOMETRIES + 1);
+      offsets[0] = 0;
+      for (int i = 0; i < mfem::Geometry::NUM_GEOMETRIES; i++) {
+        auto g         = mfem::Geometry::Type(i);
+        offsets[g + 1] = offsets[g] + int(counts[uint32_t(g)]);
+      }
+
+      output_E_[type].Update(offsets, mem_type);
+    }
+
+    output_L_.SetSize(int(num_qois), mem_type);
+    output_T_.SetSize(int(num_qois), mfem::Device::GetMemoryType());
+
+    // gradient objects depend on some member variables in
+    // QoIGroup, so we initialize the gradient objects last
+    // to ensure that those member variables are initialized first
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      grad_.emplace_back(*this, i);
+    }
+  }
+
+  /// @brief the number of quantities of interest in the group
+  uint32_t size() const { return num_qois_; }
+
+  /**
+   * @brief Adds a domain integral term to one of the quantities of interest
+   * @param[in] qoi the index of the quantity of interest that this integral contributes to
+   * @see Functional<double(trials...)>::AddDomainIntegral
+   */
+  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(uint32_t qoi, Dimension<dim>, DependsOn<args...>, const lambda& integrand, mfem::Mesh& mesh,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    if (mesh.GetNE() == 0) return;
+
+    Domain domain = EntireDomain(mesh);
+    AddDomainIntegral(qoi, Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain, qdata);
+  }
+
+  /// @overload
+  template <int dim, int... args, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(uint32_t qoi, Dimension<dim>, DependsOn<args...>, const lambda& integrand, Domain& domain,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    AddDomainIntegral(qoi, Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain, qdata);
+  }
+
+  /// @overload
+  template <int dim, int... args, int q, typename lambda, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(uint32_t qoi, Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>,
+                         const lambda& integrand, Domain& domain,
+                         std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    SLIC_ERROR_ROOT_IF(qoi >= num_qois_, "quantity of interest index out of range");
+
+    if (domain.mesh_.GetNE() == 0) return;
+
+    SLIC_ERROR_ROOT_IF(dim != domain.mesh_.Dimension(), "invalid mesh dimension for domain integral");
+
+    check_for_unsupported_elements(domain.mesh_);
+    check_for_missing_nodal_gridfunc(domain.mesh_);
+
+    using signature = test(decltype(serac::type<args>(trial_spaces))...);
+    integrals_.push_back(
+        MakeDomainIntegral<signature, q, dim, exec>(domain, integrand, qdata, std::vector<uint32_t>{args...}));
+    qoi_of_integral_.push_back(qoi);
+  }
+
+  /**
+   * @brief Adds a boundary integral term to one of the quantities of interest
+   * @param[in] qoi the index of the quantity of interest that this integral contributes to
+   * @see Functional<double(trials...)>::AddBoundaryIntegral
+   */
+  template <int dim, int... args, typename lambda>
+  void AddBoundaryIntegral(uint32_t qoi, Dimension<dim>, DependsOn<args...>, const lambda& integrand,
+                           mfem::Mesh& mesh)
+  {
+    if (mesh.GetNBE() == 0) return;
+
+    AddBoundaryIntegral(qoi, Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand,
+                        EntireBoundary(mesh));
+  }
+
+  /// @overload
+  template <int dim, int... args, typename lambda>
+  void AddBoundaryIntegral(uint32_t qoi, Dimension<dim>, DependsOn<args...>, const lambda& integrand,
+                           const Domain& domain)
+  {
+    AddBoundaryIntegral(qoi, Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain);
+  }
+
+  /// @overload
+  template <int dim, int... args, int q, typename lambda>
+  void AddBoundaryIntegral(uint32_t qoi, Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>,
+                           const lambda& integrand, const Domain& domain)
+  {
+    SLIC_ERROR_ROOT_IF(qoi >= num_qois_, "quantity of interest index out of range");
+
+    if (domain.mesh_.GetNBE() == 0) return;
+
+    SLIC_ERROR_ROOT_IF(dim != domain.dim_, "invalid domain of integration for boundary integral");
+
+    check_for_missing_nodal_gridfunc(domain.mesh_);
+
+    using signature = test(decltype(serac::type<args>(trial_spaces))...);
+    integrals_.push_back(
+        MakeBoundaryIntegral<signature, q, dim, exec>(domain, integrand, std::vector<uint32_t>{args...}));
+    qoi_of_integral_.push_back(qoi);
+  }
+
+  /**
+   * @brief this function computes the directional derivatives of every quantity of interest in the group
+   *
+   * @param input_T a T-vector to apply the action of gradient to
+   * @param which describes which trial space input_T corresponds to
+   * @return the directional derivative of each quantity of interest
+   */
+  mfem::Vector& ActionOfGradient(const mfem::Vector& input_T, uint32_t which) const
+  {
+    P_trial_[which]->Mult(input_T, input_L_[which]);
+
+    output_L_ = 0.0;
+
+    // this is used to mark when gather operations have been performed,
+    // to avoid doing them more than once per trial space
+    bool already_computed[Domain::num_types]{};  // default initializes to `false`
+
+    for (std::size_t k = 0; k < integrals_.size(); k++) {
+      auto& integral = integrals_[k];
+      auto  type     = integral.domain_.type_;
+
+      if (!already_computed[type]) {
+        G_trial_[type][which]->Gather(input_L_[which], input_E_[type][which]);
+        already_computed[type] = true;
+      }
+
+      output_E_[type] = 0.0;
+      integral.GradientMult(input_E_[type][which], output_E_[type], which);
+      output_L_[int(qoi_of_integral_[k])] += output_E_[type].Sum();
+    }
+
+    reduce();
+
+    return output_T_;
+  }
+
+  /**
+   * @brief evaluate every quantity of interest in the group with the given trial space values
+   *
+   * @param t the time
+   * @param args the input T-vectors
+   *
+   * note: it accepts exactly `num_trial_spaces` arguments of type mfem::Vector. Additionally, one of those
+   * arguments may be a dual_vector, to indicate that the quantities should also be differentiated
+   * w.r.t. that argument
+   */
+  template <uint32_t wrt, typename... T>
+  typename operator_paren_return<wrt>::type operator()(DifferentiateWRT<wrt>, double t, const T&... args)
+  {
+    const mfem::Vector* input_T[] = {&static_cast<const mfem::Vector&>(args)...};
+
+    // get the values for each local processor
+    for (uint32_t i = 0; i < num_trial_spaces; i++) {
+      P_trial_[i]->Mult(*input_T[i], input_L_[i]);
+    }
+
+    output_L_ = 0.0;
+
+    // this is used to mark when operations have been performed,
+    // to avoid doing them more than once
+    bool already_computed[Domain::num_types][num_trial_spaces]{};  // default initializes to `false`
+
+    for (std::size_t k = 0; k < integrals_.size(); k++) {
+      auto& integral = integrals_[k];
+      auto  type     = integral.domain_.type_;
+
+      for (auto i : integral.active_trial_spaces_) {
+        if (!already_computed[type][i]) {
+          G_trial_[type][i]->Gather(input_L_[i], input_E_[type][i]);
+          already_computed[type][i] = true;
+        }
+      }
+
+      // the derivative kernels are created the first time an argument is differentiated
+      integral.GenerateDerivativeKernels(wrt);
+
+      // the E-vector is shared by the integrals on the same kind of domain, so
+      // each integral's contribution is summed before the next one overwrites it
+      output_E_[type]         = 0.0;
+      const bool update_state = false;
+      integral.Mult(t, input_E_[type], output_E_[type], wrt, update_state);
+      output_L_[int(qoi_of_integral_[k])] += output_E_[type].Sum();
+    }
+
+    reduce();
+
+    if constexpr (wrt != NO_DIFFERENTIATION) {
+      return {output_T_, grad_[wrt]};
+    }
+
+    if constexpr (wrt == NO_DIFFERENTIATION) {
+      return output_T_;
+    }
+  }
+
+  /// @overload
+  template <typename... T>
+  auto operator()(double t, const T&... args)
+  {
+    // below we add 0 so the number of differentiated arguments defaults to 0 if trial spaces are not provided
+    constexpr int num_differentiated_arguments = (std::is_same_v<T, differentiate_wrt_this> + ... + 0);
+    static_assert(num_differentiated_arguments <= 1,
+                  "Error: QoIGroup::operator() can only differentiate w.r.t. 1 argument a time");
+    static_assert(sizeof...(T) == num_trial_spaces,
+                  "Error: QoIGroup::operator() must take exactly as many arguments as trial spaces");
+
+    [[maybe_unused]] constexpr uint32_t i = index_of_differentiation<T...>();
+
+    return (*this)(DifferentiateWRT<i>{}, t, args...);
+  }
+
+private:
+  /// @brief sum the values of each quantity of interest over the ranks, in a single reduction
+  void reduce() const
+  {
+    // const_cast to work around clang@14.0.6 compiler error:
+    //   "argument type 'const double *' doesn't match specified 'MPI' type tag that requires 'double *'"
+    MPI_Allreduce(const_cast<double*>(output_L_.HostRead()), output_T_.HostWrite(), int(num_qois_), MPI_DOUBLE,
+                  MPI_SUM, comm_);
+  }
+
+  /**
+   * @brief the derivatives of every quantity of interest in a @p QoIGroup w.r.t. one of its arguments
+   */
+  class Gradient {
+  public:
+    /**
+     * @brief Constructs a Gradient wrapper that references a parent @p QoIGroup
+     * @param[in] g The @p QoIGroup to use for gradient calculations
+     * @param[in] which The index of the argument to differentiate w.r.t.
+     */
+    Gradient(QoIGroup<double(trials...), exec>& g, uint32_t which = 0)
+        : group_(g), which_argument(which), gradient_L_(g.trial_space_[which]->GetVSize())
+    {
+    }
+
+    /// @brief the directional derivatives of the quantities of interest in the direction @a x
+    mfem::Vector& operator()(const mfem::Vector& x) const { return group_.ActionOfGradient(x, which_argument); }
+
+    /**
+     * @brief assemble the gradient of each quantity of interest
+     * @return one T-vector per quantity of interest, in the order of their indices
+     */
+    std::vector<std::unique_ptr<mfem::HypreParVector>> assemble()
+    {
+      std::vector<std::unique_ptr<mfem::HypreParVector>> gradients_T(group_.num_qois_);
+
+      std::map<mfem::Geometry::Type, ExecArray<double, 3, exec>> element_gradients[Domain::num_types];
+
+      for (uint32_t qoi = 0; qoi < group_.num_qois_; qoi++) {
+        // The mfem method ParFiniteElementSpace.NewTrueDofVector should really be marked const
+        gradients_T[qoi].reset(
+            const_cast<mfem::ParFiniteElementSpace*>(group_.trial_space_[which_argument])->NewTrueDofVector());
+
+        bool has_contributions[Domain::num_types]{};  // default initializes to `false`
+
+        for (std::size_t k = 0; k < group_.integrals_.size(); k++) {
+          if (group_.qoi_of_integral_[k] != qoi) continue;
+
+          auto& integral           = group_.integrals_[k];
+          auto  type               = integral.domain_.type_;
+          auto& K_elem             = element_gradients[type];
+          auto& trial_restrictions = group_.G_trial_[type][which_argument]->restrictions;
+
+          // the element gradient storage is allocated once, and reused by every quantity of interest
+          if (K_elem.empty()) {
+            for (auto& [geom, trial_restriction] : trial_restrictions) {
+              auto dofs_per_elem = trial_restriction.nodes_per_elem * trial_restriction.components;
+              K_elem[geom]       = ExecArray<double, 3, exec>(trial_restriction.num_elements, 1, dofs_per_elem);
+            }
+          }
+
+          if (!has_contributions[type]) {
+            for (auto& [geom, elem_matrices] : K_elem) {
+              detail::zero_out(elem_matrices);
+            }
+            has_contributions[type] = true;
+          }
+
+          integral.ComputeElementGradients(K_elem, which_argument);
+        }
+
+        gradient_L_ = 0.0;
+
+        for (auto type : {Domain::Type::Elements, Domain::Type::BoundaryElements}) {
+          if (!has_contributions[type]) continue;
+
+          auto& trial_restrictions = group_.G_trial_[type][which_argument]->restrictions;
+
+          for (auto& [geom, elem_matrices] : element_gradients[type]) {
+            std::vector<DoF> trial_vdofs(trial_restrictions[geom].nodes_per_elem * trial_restrictions[geom].components);
+
+            for (axom::IndexType e = 0; e < elem_matrices.shape()[0]; e++) {
+              trial_restrictions[geom].GetElementVDofs(e, trial_vdofs);
+
+              for (axom::IndexType j = 0; j < elem_matrices.shape()[2]; j++) {
+                int sign = trial_vdofs[uint32_t(j)].sign();
+                int col  = int(trial_vdofs[uint32_t(j)].index());
+                gradient_L_[col] += sign * elem_matrices(e, 0, j);
+              }
+            }
+          }
+        }
+
+        group_.P_trial_[which_argument]->MultTranspose(gradient_L_, *gradients_T[qoi]);
+      }
+
+      return gradients_T;
+    }
+
+    friend auto assemble(Gradient& g) { return g.assemble(); }
+
+  private:
+    /**
+     * @brief The "parent" @p QoIGroup to calculate gradients with
+     */
+    QoIGroup<double(trials...), exec>& group_;
+
+    uint32_t which_argument;
+
+    mfem::Vector gradient_L_;
+  };
+
+  /// @brief Manages DOFs for the trial space
+  std::array<const mfem::ParFiniteElementSpace*, num_trial_spaces> trial_space_;
+
+  /// @brief the number of quantities of interest in the group
+  uint32_t num_qois_;
+
+  /// @brief the communicator that the values are summed over
+  MPI_Comm comm_;
+
+  /**
+   * @brief Operator that converts true (global) DOF values to local (current rank) DOF values
+   * for the test space
+   */
+  const mfem::Operator* P_trial_[num_trial_spaces];
+
+  /// @brief The input set of local DOF values (i.e., on the current rank)
+  mutable mfem::Vector input_L_[num_trial_spaces];
+
+  /// @brief the L->E restrictions of each trial space and kind of domain, see shared_setup::restriction()
+  std::shared_ptr<const BlockElementRestriction> G_trial_[Domain::num_types][num_trial_spaces];
+
+  mutable std::vector<mfem::BlockVector> input_E_[Domain::num_types];
+
+  std::vector<Integral> integrals_;
+
+  /// @brief the index of the quantity of interest that each integral contributes to
+  std::vector<uint32_t> qoi_of_integral_;
+
+  mutable mfem::BlockVector output_E_[Domain::num_types];
+
+  /// @brief The values of each quantity of interest on the current rank
+  mutable mfem::Vector output_L_;
+
+  /// @brief The values of each quantity of interest summed over the ranks, a reference to this is returned
+  mutable mfem::Vector output_T_;
+
+  /// @brief The objects representing the gradients w.r.t. each input argument of the QoIGroup
+  mutable std::vector<Gradient> grad_;
+};
+
+}  // namespace serac
@@ -12,7 +12,10 @@
 
 #pragma once
 
+#include <utility>
+
 #include "tensor.hpp"
+#include "geometry.hpp"
 #include "polynomials.hpp"
 #include "finite_element.hpp"
 
@@ -78,4 +81,57 @@ SERAC_HOST_DEVICE constexpr auto GaussQuadratureRule()
   }
 }
 
+/// @cond
+namespace detail {
+
+template <mfem::Geometry::Type g, int Q>
+mfem::IntegrationRule quadrature_points()
+{
+  constexpr auto xi = [] {
+    if constexpr (g == mfem::Geometry::SQUARE || g == mfem::Geometry::CUBE) {
+      return GaussQuadratureRule<g, Q>().points;
+    } else {
+      return GaussLegendreNodes<Q, g>();
+    }
+  }();
+
+  mfem::IntegrationRule points(num_quadrature_points(g, Q));
+  for (int i = 0; i < points.GetNPoints(); i++) {
+    points.IntPoint(i).Set(&xi[i][0], dimension_of(g));
+  }
+  return points;
+}
+
+template <mfem::Geometry::Type g, int... Q>
+mfem::IntegrationRule quadrature_points(int num_points, std::integer_sequence<int, Q...>)
+{
+  mfem::IntegrationRule points;
+  ((num_points == num_quadrature_points(g, Q + 1) ? void(points = quadrature_points<g, Q + 1>()) : void()), ...);
+  return points;
+}
+
+}  // namespace detail
+/// @endcond
+
+/**
+ * @brief Returns the reference coordinates of the quadrature points of an element, in the order that
+ * QuadratureData stores their values
+ * @param g The shape of the element
+ * @param num_points The number of quadrature points of the element, see num_quadrature_points()
+ */
+inline mfem::IntegrationRule quadrature_points(mfem::Geometry::Type g, int num_points)
+{
+  constexpr auto rules = std::make_integer_sequence<int, 5>{};
+
+  mfem::IntegrationRule points;
+  if (g == mfem::Geometry::TRIANGLE) points = detail::quadrature_points<mfem::Geometry::TRIANGLE>(num_points, rules);
+  if (g == mfem::Geometry::SQUARE) points = detail::quadrature_points<mfem::Geometry::SQUARE>(num_points, rules);
+  if (g == mfem::Geometry::TETRAHEDRON) {
+    points = detail::quadrature_points<mfem::Geometry::TETRAHEDRON>(num_points, rules);
+  }
+  if (g == mfem::Geometry::CUBE) points = detail::quadrature_points<mfem::Geometry::CUBE>(num_points, rules);
+  if (g == mfem::Geometry::PRISM) points = detail::quadrature_points<mfem::Geometry::PRISM>(num_points, rules);
+  return points;
+}
+
 }  // namespace serac
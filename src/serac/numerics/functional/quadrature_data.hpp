@@ -12,6 +12,11 @@
 
 #pragma once
 
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
 #include "mfem.hpp"
 
 #include "axom/core.hpp"
@@ -45,6 +50,98 @@ struct Empty {};
 template <typename T>
 struct QuadratureData;
 
+/**
+ * @brief Customization point that selects how QuadratureData<T> lays out its values in memory
+ *
+ * By default, one complete `T` is stored per quadrature point (array-of-structs). If `fields()` returns
+ * a nonempty tuple of pointers-to-members, each of those members is instead stored in its own contiguous
+ * array (structure-of-arrays), so that kernels which only touch a few members stream through less memory.
+ * Every data member of `T` must be listed in that case, since members that are not listed are not stored.
+ *
+ * Types can opt in either by specializing this trait, or by providing a static member function
+ * with the same name and signature, e.g.
+ *
+ * @code{.cpp}
+ * struct State {
+ *   tensor<double, 3, 3> Fpinv;
+ *   double               accumulated_plastic_strain;
+ *
+ *   static constexpr auto quadrature_data_fields()
+ *   {
+ *     return std::tuple{&State::Fpinv, &State::accumulated_plastic_strain};
+ *   }
+ * };
+ * @endcode
+ */
+template <typename T, typename = void>
+struct quadrature_data_layout {
+  /// @brief the members of T to store separately (none, by default)
+  static constexpr auto fields() { return std::tuple<>{}; }
+};
+
+/// @overload
+template <typename T>
+struct quadrature_data_layout<T, std::void_t<decltype(T::quadrature_data_fields())> > {
+  /// @brief the members of T to store separately
+  static constexpr auto fields() { return T::quadrature_data_fields(); }
+};
+
+/**
+ * @brief Customization point that lists the members of T that are scratch values rather than state: hints that
+ * q-functions keep from one evaluation to the next (e.g. the initial guesses of their local solves)
+ *
+ * The scratch members are written back at every evaluation, including the ones that don't update (or only stage)
+ * the quadrature data. So they hold the values of the most recent evaluation, and must never change the result of
+ * a q-function, only how fast it gets there.
+ *
+ * Types can opt in either by specializing this trait, or by providing a static member function with the same name
+ * and signature, like quadrature_data_layout. With a structure-of-arrays layout the scratch members must also be
+ * listed in quadrature_data_layout::fields().
+ */
+template <typename T, typename = void>
+struct quadrature_scratch_layout {
+  /// @brief the scratch members of T (none, by default)
+  static constexpr auto fields() { return std::tuple<>{}; }
+};
+
+/// @overload
+template <typename T>
+struct quadrature_scratch_layout<T, std::void_t<decltype(T::quadrature_scratch_fields())> > {
+  /// @brief the scratch members of T
+  static constexpr auto fields() { return T::quadrature_scratch_fields(); }
+};
+
+/// @cond
+namespace detail {
+
+template <typename member_pointer>
+struct member_value;
+
+template <typename C, typename V>
+struct member_value<V C::*> {
+  using type = V;
+};
+
+template <typename fields>
+struct field_storage;
+
+template <typename... member_pointers>
+struct field_storage<std::tuple<member_pointers...> > {
+  using arrays = std::tuple<axom::Array<typename member_value<member_pointers>::type, 2>...>;
+  using views  = std::tuple<axom::ArrayView<typename member_value<member_pointers>::type, 2>...>;
+};
+
+}  // namespace detail
+/// @endcond
+
+/**
+ * @brief true if QuadratureData<T> stores the members of T in separate arrays
+ * @see quadrature_data_layout
+ */
+template <typename T>
+inline constexpr bool is_structure_of_arrays_v =
+    std::tuple_size_v<decltype(quadrature_data_layout<T>::fields())> > 0;
+
 }  // namespace serac
 
 // we define these specializations to make it so that materials
@@ -100,6 +197,165 @@ public:
 
 namespace serac {
 
+/**
+ * @brief A non-owning view of the quadrature point values of a single element geometry
+ *
+ * Kernels read a complete `T` at each quadrature point with load(), and write it back
+ * with store(), regardless of how QuadratureData<T> lays those values out in memory.
+ * Values that are not stored may be staged instead, see QuadratureData::stageTrialStates().
+ *
+ * @tparam T the data type stored at each quadrature point
+ */
+template <typename T>
+class QuadratureDataView {
+public:
+  /// @brief the type stored at each quadrature point
+  using value_type = T;
+
+  /// @brief the underlying per-geometry storage
+  using array_type =
+      std::conditional_t<is_structure_of_arrays_v<T>,
+                         typename detail::field_storage<decltype(quadrature_data_layout<T>::fields())>::arrays,
+                         axom::Array<T, 2> >;
+
+  /**
+   * @brief create a view of the values in @p array
+   * @param array the current values
+   * @param trial where stage() writes the trial values, or nullptr if they aren't staged
+   */
+  QuadratureDataView(array_type& array, array_type* trial = nullptr)
+      : views_(make_views(array)), trial_views_(make_views(trial ? *trial : array)), staged_(trial != nullptr)
+  {
+  }
+
+  /// @brief return a copy of the value at quadrature point @p q of element @p e
+  SERAC_HOST_DEVICE T load(uint32_t e, uint32_t q) const
+  {
+    if constexpr (is_structure_of_arrays_v<T>) {
+      T value{};
+      for_each_field(views_, [&](auto member, const auto& field) { value.*member = field(e, q); });
+      return value;
+    } else {
+      return views_(e, q);
+    }
+  }
+
+  /// @brief overwrite the value at quadrature point @p q of element @p e
+  SERAC_HOST_DEVICE void store(uint32_t e, uint32_t q, const T& value) { store(views_, e, q, value); }
+
+  /**
+   * @brief write the trial value at quadrature point @p q of element @p e, if trial values are staged, and its
+   * scratch members (see quadrature_scratch_layout) in any case
+   */
+  SERAC_HOST_DEVICE void stage(uint32_t e, uint32_t q, const T& value)
+  {
+    if (staged_) {
+      store(trial_views_, e, q, value);
+    }
+    if constexpr (std::tuple_size_v<decltype(quadrature_scratch_layout<T>::fields())> > 0) {
+      if constexpr (is_structure_of_arrays_v<T>) {
+        for_each_field(views_, [&](auto member, auto& field) {
+          if (is_scratch(member)) {
+            field(e, q) = value.*member;
+          }
+        });
+      } else {
+        std::apply([&](auto... members) { ((views_(e, q).*members = value.*members), ...); },
+                   quadrature_scratch_layout<T>::fields());
+      }
+    }
+  }
+
+private:
+  using view_type =
+      std::conditional_t<is_structure_of_arrays_v<T>,
+                         typename detail::field_storage<decltype(quadrature_data_layout<T>::fields())>::views,
+                         axom::ArrayView<T, 2> >;
+
+  /// @brief overwrite the value at quadrature point @p q of element @p e in @p views
+  SERAC_HOST_DEVICE static void store(view_type& views, uint32_t e, uint32_t q, const T& value)
+  {
+    if constexpr (is_structure_of_arrays_v<T>) {
+      for_each_field(views, [&](auto member, auto& field) { field(e, q) = value.*member; });
+    } else {
+      views(e, q) = value;
+    }
+  }
+
+  /// @brief whether @p member is one of the scratch members of T
+  template <typename member_pointer>
+  SERAC_HOST_DEVICE static constexpr bool is_scratch(member_pointer member)
+  {
+    return std::apply(
+        [member](auto... scratch) {
+          auto same = [member](auto other) {
+            if constexpr (std::is_same_v<decltype(other), member_pointer>) {
+              return member == other;
+            } else {
+              return false;
+            }
+          };
+          return (same(scratch) || ...);
+        },
+        quadrature_scratch_layout<T>::fields());
+  }
+
+  /// @brief create views of the values (or of each separately stored member) in @p array
+  static view_type make_views(array_type& array)
+  {
+    if constexpr (is_structure_of_arrays_v<T>) {
+      return std::apply([](auto&... field_arrays) { return view_type(field_arrays...); }, array);
+    } else {
+      return axom::ArrayView<T, 2>(array);
+    }
+  }
+
+  /// @brief call f(pointer to member, view of that member's values) for each separately stored member
+  template <typename views_type, typename func>
+  SERAC_HOST_DEVICE static void for_each_field(views_type& views, func&& f)
+  {
+    constexpr auto members = quadrature_data_layout<T>::fields();
+    for_each_field(views, f, members, std::make_index_sequence<std::tuple_size_v<decltype(members)> >{});
+  }
+
+  /// @overload
+  template <typename views_type, typename func, typename members_type, std::size_t... i>
+  SERAC_HOST_DEVICE static void for_each_field(views_type& views, func& f, const members_type& members,
+                                               std::index_sequence<i...>)
+  {
+    (f(std::get<i>(members), std::get<i>(views)), ...);
+  }
+
+  /// @brief views of the values (or of each separately stored member) of every quadrature point
+  view_type views_;
+
+  /// @brief views of the staged trial values, which alias views_ if they aren't staged
+  view_type trial_views_;
+
+  /// @brief whether stage() writes the trial values
+  bool staged_;
+};
+
+/// @cond
+template <>
+class QuadratureDataView<Nothing> {
+public:
+  using value_type = Nothing;
+  SERAC_HOST_DEVICE Nothing load(uint32_t, uint32_t) const { return Nothing{}; }
+  SERAC_HOST_DEVICE void    store(uint32_t, uint32_t, const Nothing&) {}
+  SERAC_HOST_DEVICE void    stage(uint32_t, uint32_t, const Nothing&) {}
+};
+
+template <>
+class QuadratureDataView<Empty> {
+public:
+  using value_type = Empty;
+  SERAC_HOST_DEVICE Empty load(uint32_t, uint32_t) const { return Empty{}; }
+  SERAC_HOST_DEVICE void  store(uint32_t, uint32_t, const Empty&) {}
+  SERAC_HOST_DEVICE void  stage(uint32_t, uint32_t, const Empty&) {}
+};
+/// @endcond
+
 /**
  * @brief A class for storing and access user-defined types at quadrature points
  *
@@ -107,12 +363,17 @@ namespace serac {
  *
  * @note users are not intended to create these objects directly, instead
  *       they should use the PhysicsModule::createQuadratureDataBuffer()
+ *
+ * @see quadrature_data_layout for how to store the members of T in separate arrays
  */
 template <typename T>
 struct QuadratureData {
   /// @brief a list of integers, one associated with each type of mfem::Geometry
   using geom_array_t = std::array<uint32_t, mfem::Geometry::NUM_GEOMETRIES>;
 
+  /// @brief the storage associated with a single element geometry
+  using array_type = typename QuadratureDataView<T>::array_type;
+
   /**
    * @brief Initialize a new quadrature data buffer, optionally with some initial value
    *
@@ -122,25 +383,112 @@ struct QuadratureData {
    */
   QuadratureData(geom_array_t elements, geom_array_t qpts_per_element, T value = T{})
   {
-    constexpr std::array geometries = {mfem::Geometry::SEGMENT, mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
-                                       mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE};
+    constexpr std::array geometries = {mfem::Geometry::SEGMENT,     mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
+                                       mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE,     mfem::Geometry::PRISM};
 
     for (auto geom : geometries) {
       if (elements[uint32_t(geom)] > 0) {
-        data[geom] = axom::Array<T, 2>(elements[uint32_t(geom)], qpts_per_element[uint32_t(geom)]);
-        data[geom].fill(value);
+        auto num_elements = elements[uint32_t(geom)];
+        auto num_qpts     = qpts_per_element[uint32_t(geom)];
+        if constexpr (is_structure_of_arrays_v<T>) {
+          std::apply(
+              [&](auto... members) {
+                data[geom] = array_type{
+                    initialized_array<typename detail::member_value<decltype(members)>::type>(
+                        num_elements, num_qpts, value.*members)...};
+              },
+              quadrature_data_layout<T>::fields());
+        } else {
+          data[geom] = initialized_array<T>(num_elements, num_qpts, value);
+        }
       }
     }
   }
 
   /**
-   * @brief return the 2D array of quadrature point values for elements of the specified geometry
+   * @brief return a view of the quadrature point values for elements of the specified geometry
    * @param geom which element geometry's data to return
    */
-  axom::ArrayView<T, 2> operator[](mfem::Geometry::Type geom) { return axom::ArrayView<T, 2>(data.at(geom)); }
+  QuadratureDataView<T> operator[](mfem::Geometry::Type geom)
+  {
+    return QuadratureDataView<T>(data[geom], staging ? &trial[geom] : nullptr);
+  }
 
-  /// @brief a 3D array indexed by (which geometry, which element, which quadrature point)
-  std::map<mfem::Geometry::Type, axom::Array<T, 2> > data;
+  /**
+   * @brief choose whether the following evaluations stage the values that their q-functions compute
+   *
+   * While staging, an evaluation that doesn't update the quadrature data (see Functional::updateQdata()) writes
+   * the new values to a separate buffer of trial values instead, which commitTrialStates() makes current. This lets
+   * the material state of a converged nonlinear solve be kept without evaluating the q-functions again.
+   *
+   * @param stage whether to stage the trial values
+   */
+  void stageTrialStates(bool stage)
+  {
+    if (stage && !has_trial) {
+      trial     = data;
+      has_trial = true;
+    }
+    staging = stage;
+  }
+
+  /**
+   * @brief make the trial values of the most recent staged evaluation current
+   * @return false (and nothing is changed) if no values have ever been staged
+   * @note only the values that were staged are meaningful afterwards, so every quadrature point that the q-functions
+   * update should have been staged by that evaluation
+   */
+  bool commitTrialStates()
+  {
+    if (!has_trial) {
+      return false;
+    }
+    std::swap(data, trial);
+    return true;
+  }
+
+  /// @brief the number of bytes allocated for the values of every geometry
+  std::size_t bytes() const
+  {
+    std::size_t total = 0;
+    for (const auto& array : data) {
+      if constexpr (is_structure_of_arrays_v<T>) {
+        std::apply([&](const auto&... fields) { ((total += field_bytes(fields)), ...); }, array);
+      } else {
+        total += field_bytes(array);
+      }
+    }
+    return has_trial ? 2 * total : total;
+  }
+
+  /// @brief the quadrature point values of each geometry, indexed by (which element, which quadrature point)
+  std::array<array_type, mfem::Geometry::NUM_GEOMETRIES> data;
+
+  /// @brief the staged trial values, see stageTrialStates()
+  std::array<array_type, mfem::Geometry::NUM_GEOMETRIES> trial;
+
+  /// @brief whether trial has been allocated
+  bool has_trial = false;
+
+  /// @brief whether evaluations currently stage their values in trial
+  bool staging = false;
+
+private:
+  /// @brief allocate a 2D array and fill it with @p value
+  template <typename V>
+  static axom::Array<V, 2> initialized_array(uint32_t num_elements, uint32_t num_qpts, const V& value)
+  {
+    axom::Array<V, 2> array(num_elements, num_qpts);
+    array.fill(value);
+    return array;
+  }
+
+  /// @brief the number of bytes allocated for a 2D array
+  template <typename V>
+  static std::size_t field_bytes(const axom::Array<V, 2>& array)
+  {
+    return std::size_t(array.capacity()) * sizeof(V);
+  }
 };
 
 /// @cond
@@ -150,7 +498,13 @@ struct QuadratureData<Nothing> {
 
   QuadratureData() {}
 
-  axom::ArrayView<Nothing, 2> operator[](mfem::Geometry::Type) { return axom::ArrayView<Nothing, 2>(data); }
+  QuadratureDataView<Nothing> operator[](mfem::Geometry::Type) { return QuadratureDataView<Nothing>{}; }
+
+  void stageTrialStates(bool) {}
+
+  bool commitTrialStates() { return true; }
+
+  std::size_t bytes() const { return 0; }
 
   axom::Array<Nothing, 2, axom::MemorySpace::Dynamic> data;
 };
@@ -161,7 +515,13 @@ struct QuadratureData<Empty> {
 
   QuadratureData() {}
 
-  axom::ArrayView<Empty, 2> operator[](mfem::Geometry::Type) { return axom::ArrayView<Empty, 2>(data); }
+  QuadratureDataView<Empty> operator[](mfem::Geometry::Type) { return QuadratureDataView<Empty>{}; }
+
+  void stageTrialStates(bool) {}
+
+  bool commitTrialStates() { return true; }
+
+  std::size_t bytes() const { return 0; }
 
   axom::Array<Empty, 2, axom::MemorySpace::Dynamic> data;
 };
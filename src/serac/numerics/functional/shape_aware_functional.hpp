@@ -302,6 +302,20 @@ class ShapeAwareFunctional<shape, test(trials...), exec> {
   /// @brief The number of input trial functions
   static constexpr uint32_t num_trial_spaces = sizeof...(trials);
 
+  /// @brief The default number of quadrature points per dimension, the same as the underlying Functional
+  static constexpr int Q = std::max({shape::order, test::order, trials::order...}) + 1;
+
+  /**
+   * @brief whether a q-function can skip the shape correction when the shape displacement is zero
+   *
+   * This requires the uncorrected q-function output to have the same type as the corrected one, which is not
+   * the case when differentiating w.r.t. the shape displacement. The flag is read on the host, so the check is
+   * only made for CPU execution.
+   */
+  template <typename corrected_type, typename uncorrected_type>
+  static constexpr bool fast_path_available =
+      exec == ExecutionSpace::CPU && std::is_same_v<corrected_type, uncorrected_type>;
+
 public:
   /**
    * @brief Constructs using @p mfem::ParFiniteElementSpace objects corresponding to the test/trial spaces
@@ -328,6 +342,8 @@ public:
     }
 
     functional_ = std::make_unique<Functional<test(shape, trials...), exec>>(test_fes, prepended_spaces);
+
+    comm_ = shape_fes->GetComm();
   }
 
   /**
@@ -354,6 +370,8 @@ public:
     }
 
     functional_ = std::make_unique<Functional<double(shape, trials...), exec>>(prepended_spaces);
+
+    comm_ = shape_fes->GetComm();
   }
 
   /**
@@ -376,34 +394,43 @@ public:
   void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, domain_type& domain,
                          std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
   {
-    if constexpr (std::is_same_v<qpt_data_type, Nothing>) {
-      functional_->AddDomainIntegral(
-          Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
-          [integrand](double time, auto x, auto shape_val, auto... qfunc_args) {
-            auto qfunc_tuple               = make_tuple(qfunc_args...);
-            auto reduced_trial_space_tuple = make_tuple(get<args>(trial_spaces)...);
-
-            detail::ShapeCorrection shape_correction(Dimension<dim>{}, shape_val);
+    AddDomainIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain, qdata);
+  }
 
-            auto unmodified_qf_return = detail::apply_shape_aware_qf_helper(
-                integrand, time, x, shape_val, reduced_trial_space_tuple, qfunc_tuple, shape_correction,
-                std::make_integer_sequence<int, sizeof...(qfunc_args)>{});
-            return shape_correction.modify_shape_aware_qf_return(test_space, unmodified_qf_return);
-          },
-          domain, qdata);
+  /**
+   * @brief Adds a domain integral term that uses @a q quadrature points per dimension, e.g. reduced integration
+   * for a volumetric or mass term, rather than the default of max(shape::order, test::order, trials::order...) + 1
+   * @note any quadrature data must be sized for num_quadrature_points(geom, q) points per element
+   */
+  template <int dim, int... args, int q, typename lambda, typename domain_type, typename qpt_data_type = Nothing>
+  void AddDomainIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                         domain_type& domain, std::shared_ptr<QuadratureData<qpt_data_type>> qdata = NoQData)
+  {
+    if constexpr (std::is_same_v<qpt_data_type, Nothing>) {
+      functional_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{}, QuadratureOrder<q>{},
+                                     shapeAwareDomainIntegrand<dim, args...>(integrand), domain, qdata);
     } else {
       functional_->AddDomainIntegral(
-          Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
-          [integrand](double time, auto x, auto& state, auto shape_val, auto... qfunc_args) {
-            auto qfunc_tuple               = make_tuple(qfunc_args...);
-            auto reduced_trial_space_tuple = make_tuple(get<args>(trial_spaces)...);
-
-            detail::ShapeCorrection shape_correction(Dimension<dim>{}, shape_val);
-
-            auto unmodified_qf_return = detail::apply_shape_aware_qf_helper_with_state(
-                integrand, time, x, state, shape_val, reduced_trial_space_tuple, qfunc_tuple, shape_correction,
-                std::make_integer_sequence<int, sizeof...(qfunc_args)>{});
-            return shape_correction.modify_shape_aware_qf_return(test_space, unmodified_qf_return);
+          Dimension<dim>{}, DependsOn<0, (args + 1)...>{}, QuadratureOrder<q>{},
+          [integrand, shape_is_zero = shape_is_zero_.get()](double time, auto x, auto& state, auto shape_val,
+                                                            auto... qfunc_args) {
+            auto shape_aware_qf_return = [&]() {
+              auto qfunc_tuple               = make_tuple(qfunc_args...);
+              auto reduced_trial_space_tuple = make_tuple(get<args>(trial_spaces)...);
+
+              detail::ShapeCorrection shape_correction(Dimension<dim>{}, shape_val);
+
+              auto unmodified_qf_return = detail::apply_shape_aware_qf_helper_with_state(
+                  integrand, time, x, state, shape_val, reduced_trial_space_tuple, qfunc_tuple, shape_correction,
+                  std::make_integer_sequence<int, sizeof...(qfunc_args)>{});
+              return shape_correction.modify_shape_aware_qf_return(test_space, unmodified_qf_return);
+            };
+
+            if constexpr (fast_path_available<decltype(shape_aware_qf_return()),
+                                              decltype(integrand(time, x, state, qfunc_args...))>) {
+              if (*shape_is_zero) return integrand(time, x, state, qfunc_args...);
+            }
+            return shape_aware_qf_return();
           },
           domain, qdata);
     }
@@ -426,14 +453,51 @@ public:
   template <int dim, int... args, typename lambda, typename domain_type>
   void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand, domain_type& domain)
   {
-    functional_->AddBoundaryIntegral(
-        Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
-        [integrand](double time, auto x, auto shape_val, auto... qfunc_args) {
-          auto unmodified_qf_return = integrand(time, x + shape_val, qfunc_args...);
-
-          return unmodified_qf_return * detail::compute_boundary_area_correction(x, shape_val);
-        },
-        domain);
+    AddBoundaryIntegral(Dimension<dim>{}, DependsOn<args...>{}, QuadratureOrder<Q>{}, integrand, domain);
+  }
+
+  /**
+   * @brief Adds a boundary integral term that uses @a q quadrature points per dimension, rather than
+   * the default of max(shape::order, test::order, trials::order...) + 1
+   */
+  template <int dim, int... args, int q, typename lambda, typename domain_type>
+  void AddBoundaryIntegral(Dimension<dim>, DependsOn<args...>, QuadratureOrder<q>, const lambda& integrand,
+                           domain_type& domain)
+  {
+    functional_->AddBoundaryIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{}, QuadratureOrder<q>{},
+                                     shapeAwareBoundaryIntegrand(integrand), domain);
+  }
+
+  /**
+   * @brief Adds a separable load f(x) g(t) over a domain, which is only integrated once while the shape displacement
+   * and the arguments it depends on are frozen, see Functional::AddSeparableDomainIntegral()
+   *
+   * @param[in] integrand f, a domain integrand as in AddDomainIntegral(), which must not depend on the time
+   * @param[in] time_scale g, the time function of the load
+   * @param[in] domain The domain on which to evaluate the integral
+   */
+  template <int dim, int... args, typename lambda>
+  void AddSeparableDomainIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand,
+                                  std::function<double(double)> time_scale, Domain& domain)
+  {
+    functional_->AddSeparableDomainIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
+                                            shapeAwareDomainIntegrand<dim, args...>(integrand), std::move(time_scale),
+                                            domain);
+  }
+
+  /**
+   * @brief Adds a separable load f(x) g(t) over a boundary, see AddSeparableDomainIntegral()
+   *
+   * @param[in] integrand f, a boundary integrand as in AddBoundaryIntegral(), which must not depend on the time
+   * @param[in] time_scale g, the time function of the load
+   * @param[in] domain The domain on which to evaluate the integral
+   */
+  template <int dim, int... args, typename lambda>
+  void AddSeparableBoundaryIntegral(Dimension<dim>, DependsOn<args...>, const lambda& integrand,
+                                    std::function<double(double)> time_scale, const Domain& domain)
+  {
+    functional_->AddSeparableBoundaryIntegral(Dimension<dim>{}, DependsOn<0, (args + 1)...>{},
+                                              shapeAwareBoundaryIntegrand(integrand), std::move(time_scale), domain);
   }
 
   /**
@@ -454,6 +518,7 @@ public:
   template <uint32_t wrt, typename... T>
   auto operator()(DifferentiateWRT<wrt>, double t, const T&... args)
   {
+    checkShapeDisplacement(args...);
     return (*functional_)(DifferentiateWRT<wrt>{}, t, args...);
   }
 
@@ -473,9 +538,24 @@ public:
   template <typename... T>
   auto operator()(double t, const T&... args)
   {
+    checkShapeDisplacement(args...);
     return (*functional_)(t, args...);
   }
 
+  /**
+   * @brief Evaluate the serac::ShapeAwareFunctional, writing the result directly into @a output_T
+   *
+   * @note The first argument after time in the argument list is always the shape displacement field.
+   *
+   * @see Functional::evaluateInto
+   */
+  template <typename... T>
+  void evaluateInto(mfem::Vector& output_T, double t, const T&... args)
+  {
+    checkShapeDisplacement(args...);
+    functional_->evaluateInto(output_T, t, args...);
+  }
+
   /**
    * @brief A flag to update the quadrature data for this operator following the computation
    *
@@ -486,9 +566,161 @@ public:
    */
   void updateQdata(bool update_flag) { functional_->updateQdata(update_flag); }
 
+  /**
+   * @brief free the memory used to store q-function derivatives with respect to a given argument
+   *
+   * @param which the index of the argument (where the shape displacement is argument 0)
+   */
+  void releaseDerivatives(uint32_t which) { functional_->releaseDerivatives(which); }
+
+  /**
+   * @brief the gradient with respect to a given argument, linearized about the arguments of the most recent evaluation
+   * that was differentiated with respect to it, see Functional::gradient()
+   *
+   * @param which the index of the argument (where the shape displacement is argument 0)
+   */
+  auto& gradient(uint32_t which) { return functional_->gradient(which); }
+
+  /**
+   * @brief choose whether the gradients re-evaluate the q-functions instead of storing their derivatives
+   *
+   * @param recompute whether to re-evaluate the q-functions in the action of the gradient, see
+   * Functional::recomputeDerivatives()
+   */
+  void recomputeDerivatives(bool recompute) { functional_->recomputeDerivatives(recompute); }
+
+  /// @brief Choose how the assembled gradients find their nonzero entries, see Functional::setGradientLookup()
+  void setGradientLookup(GradientLookup lookup) { functional_->setGradientLookup(lookup); }
+
+  /// @brief Evaluate the domain integrals a tile of elements at a time, see Functional::setElementTileSize()
+  void setElementTileSize(uint32_t tile_size) { functional_->setElementTileSize(tile_size); }
+
+  /// @brief Evaluate the domain integrals with tuned tile sizes, see Functional::autotuneElementTileSize()
+  void autotuneElementTileSize(const std::string& filename = "") { functional_->autotuneElementTileSize(filename); }
+
+  /// @brief Choose whether an argument keeps its value over the following evaluations, see Functional::freezeArgument()
+  void freezeArgument(uint32_t which, bool frozen) { functional_->freezeArgument(which, frozen); }
+
+  /// @brief Choose whether the quadrature point values of frozen arguments are cached, see
+  /// Functional::cacheFrozenArguments()
+  void cacheFrozenArguments(bool cache) { functional_->cacheFrozenArguments(cache); }
+
+  /// @brief update the integrals after the mesh nodes have moved, see Functional::updateGeometry()
+  void updateGeometry() { functional_->updateGeometry(); }
+
+  /// @brief the number of integrals added to this ShapeAwareFunctional
+  std::size_t numIntegrals() const { return functional_->numIntegrals(); }
+
+  /**
+   * @brief estimate the critical timestep of explicit time integration in the reference configuration
+   *
+   * @param wave_speeds the wave speed of the material in each integral, in the order the integrals were added
+   * @return the estimated critical timestep
+   *
+   * @see Functional::stableTimestep()
+   */
+  double stableTimestep(const std::vector<double>& wave_speeds) const
+  {
+    return functional_->stableTimestep(wave_speeds);
+  }
+
+  /// @brief start or stop timing each element, see Functional::recordElementCosts()
+  void recordElementCosts(bool enable) { functional_->recordElementCosts(enable); }
+
+  /// @brief the time spent evaluating each element, see Functional::elementCosts()
+  mfem::Vector elementCosts() const { return functional_->elementCosts(); }
+
+  /// @brief the bytes of memory used on this rank by component, see Functional::memoryUsage()
+  memory::Usage memoryUsage() const { return functional_->memoryUsage(); }
+
+  /// @brief the bytes of memory that will be used on this rank by component, see Functional::plannedMemoryUsage()
+  memory::Usage plannedMemoryUsage(uint32_t wrt) const { return functional_->plannedMemoryUsage(wrt); }
+
+  /// @brief the sizes of the gradient w.r.t. argument @a wrt, see Functional::plannedGradientSizes()
+  auto plannedGradientSizes(uint32_t wrt) const { return functional_->plannedGradientSizes(wrt); }
+
+  /// @brief the estimated costs of an evaluation, see Functional::kernelCounts()
+  KernelCounts kernelCounts() const { return functional_->kernelCounts(); }
+
+  /// @brief whether the shape displacement was zero on every rank in the most recent evaluation
+  bool shapeDisplacementIsZero() const { return *shape_is_zero_; }
+
 private:
+  /**
+   * @brief the integrand of the underlying Functional for a domain integrand (without quadrature data), which maps the
+   * integrand's inputs and outputs from the shape-displaced configuration
+   */
+  template <int dim, int... args, typename lambda>
+  auto shapeAwareDomainIntegrand(const lambda& integrand)
+  {
+    return [integrand, shape_is_zero = shape_is_zero_.get()](double time, auto x, auto shape_val, auto... qfunc_args) {
+      auto shape_aware_qf_return = [&]() {
+        auto qfunc_tuple               = make_tuple(qfunc_args...);
+        auto reduced_trial_space_tuple = make_tuple(get<args>(trial_spaces)...);
+
+        detail::ShapeCorrection shape_correction(Dimension<dim>{}, shape_val);
+
+        auto unmodified_qf_return = detail::apply_shape_aware_qf_helper(
+            integrand, time, x, shape_val, reduced_trial_space_tuple, qfunc_tuple, shape_correction,
+            std::make_integer_sequence<int, sizeof...(qfunc_args)>{});
+        return shape_correction.modify_shape_aware_qf_return(test_space, unmodified_qf_return);
+      };
+
+      // with a zero shape displacement the corrections are all identities, so skip them if we can
+      if constexpr (fast_path_available<decltype(shape_aware_qf_return()),
+                                        decltype(integrand(time, x, qfunc_args...))>) {
+        if (*shape_is_zero) return integrand(time, x, qfunc_args...);
+      }
+      return shape_aware_qf_return();
+    };
+  }
+
+  /**
+   * @brief the integrand of the underlying Functional for a boundary integrand, which is evaluated on the
+   * shape-displaced boundary
+   */
+  template <typename lambda>
+  auto shapeAwareBoundaryIntegrand(const lambda& integrand)
+  {
+    return [integrand, shape_is_zero = shape_is_zero_.get()](double time, auto x, auto shape_val, auto... qfunc_args) {
+      auto shape_aware_qf_return = [&]() {
+        auto unmodified_qf_return = integrand(time, x + shape_val, qfunc_args...);
+
+        return unmodified_qf_return * detail::compute_boundary_area_correction(x, shape_val);
+      };
+
+      if constexpr (fast_path_available<decltype(shape_aware_qf_return()),
+                                        decltype(integrand(time, x, qfunc_args...))>) {
+        if (*shape_is_zero) return integrand(time, x, qfunc_args...);
+      }
+      return shape_aware_qf_return();
+    };
+  }
+
+  /**
+   * @brief check whether the shape displacement is zero on every rank, e.g. in a forward analysis where it
+   * was never set, so that the q-functions can skip the shape corrections in this evaluation
+   *
+   * @param shape_displacement the shape displacement argument of the evaluation
+   */
+  template <typename... T>
+  void checkShapeDisplacement(const mfem::Vector& shape_displacement, const T&...)
+  {
+    if constexpr (exec == ExecutionSpace::CPU) {
+      int is_zero = (shape_displacement.Normlinf() == 0.0);
+      MPI_Allreduce(MPI_IN_PLACE, &is_zero, 1, MPI_INT, MPI_LAND, comm_);
+      *shape_is_zero_ = is_zero;
+    }
+  }
+
   /// @brief The underlying pure Functional object
   std::unique_ptr<Functional<test(shape, trials...), exec>> functional_;
+
+  /// @brief the communicator of the shape displacement space
+  MPI_Comm comm_;
+
+  /// @brief whether the shape displacement is zero, read by the q-functions (heap allocated so its address is stable)
+  std::unique_ptr<bool> shape_is_zero_ = std::make_unique<bool>(false);
 };
 
 }  // namespace serac
@@ -0,0 +1,144 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/shared_setup.hpp"
+
+#include <iterator>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "serac/numerics/functional/dof_numbering.hpp"
+
+namespace serac::shared_setup {
+
+namespace {
+
+/// the face type used in the keys of restrictions and geometric factors of domain-elements
+constexpr int no_face_type = -1;
+
+/// mesh, mesh sequence, vdim, ordering, finite element collection, face type
+using restriction_key = std::tuple<const mfem::Mesh*, long, int, int, std::string, int>;
+
+/// mesh, mesh sequence, face type, quadrature order, element geometry, elements
+using geometry_key = std::tuple<const mfem::Mesh*, long, int, int, int, std::vector<int>>;
+
+/// test restrictions, trial restrictions, lookup method
+using lookup_key = std::tuple<std::array<const BlockElementRestriction*, Domain::num_types>,
+                              std::array<const BlockElementRestriction*, Domain::num_types>, int>;
+
+std::map<restriction_key, std::weak_ptr<const BlockElementRestriction>> restrictions;
+std::map<geometry_key, std::weak_ptr<GeometricFactors>>                 factors;
+std::map<lookup_key, std::weak_ptr<const GradientAssemblyLookupTables>> tables;
+
+/// return the registered object for @a key if it is still in use, otherwise register a new one made by @a create
+template <typename key_type, typename T, typename callable>
+std::shared_ptr<T> find_or_create(std::map<key_type, std::weak_ptr<T>>& registry, const key_type& key,
+                                  callable create, bool& found)
+{
+  std::shared_ptr<T> shared = registry[key].lock();
+  found                     = (shared != nullptr);
+  if (!found) {
+    // drop the entries of objects that are no longer used before adding a new one
+    for (auto it = registry.begin(); it != registry.end();) {
+      it = it->second.expired() ? registry.erase(it) : std::next(it);
+    }
+    shared        = create();
+    registry[key] = shared;
+  }
+  return shared;
+}
+
+template <typename... T>
+std::shared_ptr<const BlockElementRestriction> shared_restriction(const mfem::FiniteElementSpace* fes, int face_type,
+                                                                  const T&... args)
+{
+  restriction_key key{fes->GetMesh(), fes->GetMesh()->GetSequence(), fes->GetVDim(), fes->GetOrdering(),
+                      fes->FEColl()->Name(), face_type};
+
+  bool found;
+  return find_or_create(
+      restrictions, key, [&]() { return std::make_shared<const BlockElementRestriction>(fes, args...); }, found);
+}
+
+template <typename... T>
+std::shared_ptr<GeometricFactors> shared_geometric_factors(const Domain& domain, int q, mfem::Geometry::Type geom,
+                                                           int face_type, const T&... args)
+{
+  geometry_key key{&domain.mesh_, domain.mesh_.GetSequence(), face_type, q, int(geom), domain.get(geom)};
+
+  bool found;
+  auto gf = find_or_create(
+      factors, key, [&]() { return std::make_shared<GeometricFactors>(domain, q, geom, args...); }, found);
+
+  // another Functional computed these factors, possibly before the mesh nodes last moved
+  if (found && gf->num_elements > 0) {
+    gf->update(*domain.mesh_.GetNodes());
+  }
+
+  return gf;
+}
+
+}  // namespace
+
+std::shared_ptr<const BlockElementRestriction> restriction(const mfem::FiniteElementSpace* fes)
+{
+  return shared_restriction(fes, no_face_type);
+}
+
+std::shared_ptr<const BlockElementRestriction> restriction(const mfem::FiniteElementSpace* fes, FaceType type)
+{
+  return shared_restriction(fes, int(type), type);
+}
+
+std::shared_ptr<const BlockElementRestriction> empty_restriction()
+{
+  static auto empty = std::make_shared<const BlockElementRestriction>();
+  return empty;
+}
+
+std::shared_ptr<GeometricFactors> geometric_factors(const Domain& domain, int q, mfem::Geometry::Type geom)
+{
+  return shared_geometric_factors(domain, q, geom, no_face_type);
+}
+
+std::shared_ptr<GeometricFactors> geometric_factors(const Domain& domain, int q, mfem::Geometry::Type geom,
+                                                    FaceType type)
+{
+  return shared_geometric_factors(domain, q, geom, int(type), type);
+}
+
+std::shared_ptr<const GradientAssemblyLookupTables> lookup_tables(
+    const std::array<const BlockElementRestriction*, Domain::num_types>& test_restrictions,
+    const std::array<const BlockElementRestriction*, Domain::num_types>& trial_restrictions, GradientLookup lookup)
+{
+  bool found;
+  return find_or_create(
+      tables, lookup_key{test_restrictions, trial_restrictions, int(lookup)},
+      [&]() {
+        return std::make_shared<const GradientAssemblyLookupTables>(test_restrictions, trial_restrictions, lookup);
+      },
+      found);
+}
+
+std::size_t size()
+{
+  std::size_t count = 0;
+  for (const auto& [key, entry] : restrictions) count += !entry.expired();
+  for (const auto& [key, entry] : factors) count += !entry.expired();
+  for (const auto& [key, entry] : tables) count += !entry.expired();
+  return count;
+}
+
+void clear()
+{
+  restrictions.clear();
+  factors.clear();
+  tables.clear();
+}
+
+}  // namespace serac::shared_setup
@@ -0,0 +1,82 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file shared_setup.hpp
+ *
+ * @brief a registry of the element restrictions, geometric factors and gradient lookup tables that are shared by
+ * every Functional on the same mesh and finite element spaces
+ */
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/functional/domain.hpp"
+#include "serac/numerics/functional/element_restriction.hpp"
+#include "serac/numerics/functional/geometric_factors.hpp"
+
+namespace serac {
+
+struct GradientAssemblyLookupTables;
+enum class GradientLookup;
+
+/**
+ * @brief Physics modules create several Functionals on the same mesh and spaces (e.g. the residual, mass and
+ * stiffness operators of SolidMechanics), which would otherwise each build their own copies of the structures below.
+ *
+ * The registry only holds weak references, so each structure is freed along with the last Functional that uses it.
+ * Element restrictions are shared between spaces with the same dof layout (see haveSameDofLayout()), even if they
+ * are different mfem::ParFiniteElementSpace objects.
+ */
+namespace shared_setup {
+
+/// @brief the BlockElementRestriction for all domain-elements of @a fes, see BlockElementRestriction
+std::shared_ptr<const BlockElementRestriction> restriction(const mfem::FiniteElementSpace* fes);
+
+/// @brief the BlockElementRestriction for all face-elements of @a fes, see BlockElementRestriction
+std::shared_ptr<const BlockElementRestriction> restriction(const mfem::FiniteElementSpace* fes, FaceType type);
+
+/// @brief a restriction with no geometries, for the kinds of domain that a Functional has no integrals on
+std::shared_ptr<const BlockElementRestriction> empty_restriction();
+
+/**
+ * @brief the GeometricFactors of the elements of @a domain with geometry @a geom, see GeometricFactors
+ *
+ * @note factors found in the registry are first updated to the current mesh nodes (see GeometricFactors::update()),
+ * in case the mesh has moved since they were computed
+ */
+std::shared_ptr<GeometricFactors> geometric_factors(const Domain& domain, int q, mfem::Geometry::Type geom);
+
+/// @overload for boundary elements or interior faces
+std::shared_ptr<GeometricFactors> geometric_factors(const Domain& domain, int q, mfem::Geometry::Type geom,
+                                                    FaceType type);
+
+/**
+ * @brief the sparsity pattern and element-to-nonzero lookup tables for a gradient, see GradientAssemblyLookupTables
+ *
+ * @note the restrictions are expected to come from restriction(), so that equivalent ones are the same object. Tables
+ * with different lookup methods aren't shared.
+ */
+std::shared_ptr<const GradientAssemblyLookupTables> lookup_tables(
+    const std::array<const BlockElementRestriction*, Domain::num_types>& test_restrictions,
+    const std::array<const BlockElementRestriction*, Domain::num_types>& trial_restrictions, GradientLookup lookup);
+
+/// @brief the number of structures in the registry that are still in use
+std::size_t size();
+
+/**
+ * @brief forget every registered structure, e.g. before the meshes are destroyed. Functionals that already use
+ * them are unaffected, but Functionals created afterwards don't share with them.
+ */
+void clear();
+
+}  // namespace shared_setup
+
+}  // namespace serac
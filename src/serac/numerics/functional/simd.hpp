@@ -0,0 +1,314 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file simd.hpp
+ *
+ * @brief This file contains the declaration of a fixed-width "pack of values" scalar type,
+ * used to evaluate q-functions on several elements at once
+ */
+
+#pragma once
+
+#include <cmath>
+#include <type_traits>
+
+#include "serac/infrastructure/accelerator.hpp"
+
+namespace serac {
+
+/**
+ * @brief A fixed-width pack of values, where every arithmetic operation is applied lane-by-lane
+ *
+ * When used as the scalar type of a tensor (e.g. `tensor< simd< double, 8 >, 3, 3 >`), one evaluation
+ * of a q-function written in terms of tensor operations performs W independent evaluations, with loops
+ * that the compiler can map directly onto vector instructions.
+ *
+ * @tparam T the type of each lane
+ * @tparam W the number of lanes
+ */
+template <typename T, int W>
+struct simd {
+  static constexpr int width = W;  ///< the number of lanes
+
+  T lanes[W];  ///< the values in each lane
+
+  /// @brief access the value in lane i
+  SERAC_HOST_DEVICE constexpr T& operator[](int i) { return lanes[i]; }
+
+  /// @brief access the value in lane i
+  SERAC_HOST_DEVICE constexpr const T& operator[](int i) const { return lanes[i]; }
+
+  /// @brief broadcast a scalar value to every lane
+  SERAC_HOST_DEVICE constexpr auto& operator=(T value)
+  {
+    for (int i = 0; i < W; i++) lanes[i] = value;
+    return *this;
+  }
+
+  /// @brief lane-wise compound addition
+  SERAC_HOST_DEVICE constexpr auto& operator+=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) lanes[i] += other.lanes[i];
+    return *this;
+  }
+
+  /// @brief lane-wise compound subtraction
+  SERAC_HOST_DEVICE constexpr auto& operator-=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) lanes[i] -= other.lanes[i];
+    return *this;
+  }
+
+  /// @brief lane-wise compound multiplication
+  SERAC_HOST_DEVICE constexpr auto& operator*=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) lanes[i] *= other.lanes[i];
+    return *this;
+  }
+
+  /// @brief lane-wise compound division
+  SERAC_HOST_DEVICE constexpr auto& operator/=(const simd& other)
+  {
+    for (int i = 0; i < W; i++) lanes[i] /= other.lanes[i];
+    return *this;
+  }
+};
+
+/** @brief class for checking if a type is a simd pack or not */
+template <typename T>
+struct is_simd {
+  static constexpr bool value = false;  ///< whether or not type T is a simd pack
+};
+
+/** @brief class for checking if a type is a simd pack or not */
+template <typename T, int W>
+struct is_simd<simd<T, W> > {
+  static constexpr bool value = true;  ///< whether or not type T is a simd pack
+};
+
+/// @cond
+namespace detail {
+
+template <typename T, int W, typename op>
+SERAC_HOST_DEVICE constexpr auto lanewise(const simd<T, W>& a, op f)
+{
+  simd<decltype(f(a[0])), W> c{};
+  for (int i = 0; i < W; i++) c[i] = f(a[i]);
+  return c;
+}
+
+template <typename T, int W, typename op>
+SERAC_HOST_DEVICE constexpr auto lanewise(const simd<T, W>& a, const simd<T, W>& b, op f)
+{
+  simd<decltype(f(a[0], b[0])), W> c{};
+  for (int i = 0; i < W; i++) c[i] = f(a[i], b[i]);
+  return c;
+}
+
+}  // namespace detail
+/// @endcond
+
+/// @brief the lane-wise sum of two packs
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto operator+(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return x + y; });
+}
+
+/// @brief the lane-wise difference of two packs
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto operator-(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return x - y; });
+}
+
+/// @brief the lane-wise product of two packs
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto operator*(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return x * y; });
+}
+
+/// @brief the lane-wise quotient of two packs
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto operator/(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return x / y; });
+}
+
+/// @brief lane-wise negation
+template <typename T, int W>
+SERAC_HOST_DEVICE constexpr auto operator-(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return -x; });
+}
+
+/// @brief add a scalar to every lane
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator+(const simd<T, W>& a, S b)
+{
+  return detail::lanewise(a, [b](T x) { return x + b; });
+}
+
+/// @brief add a scalar to every lane
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator+(S a, const simd<T, W>& b)
+{
+  return detail::lanewise(b, [a](T x) { return a + x; });
+}
+
+/// @brief subtract a scalar from every lane
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator-(const simd<T, W>& a, S b)
+{
+  return detail::lanewise(a, [b](T x) { return x - b; });
+}
+
+/// @brief subtract every lane from a scalar
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator-(S a, const simd<T, W>& b)
+{
+  return detail::lanewise(b, [a](T x) { return a - x; });
+}
+
+/// @brief multiply every lane by a scalar
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator*(const simd<T, W>& a, S b)
+{
+  return detail::lanewise(a, [b](T x) { return x * b; });
+}
+
+/// @brief multiply every lane by a scalar
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator*(S a, const simd<T, W>& b)
+{
+  return detail::lanewise(b, [a](T x) { return a * x; });
+}
+
+/// @brief divide every lane by a scalar
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator/(const simd<T, W>& a, S b)
+{
+  return detail::lanewise(a, [b](T x) { return x / b; });
+}
+
+/// @brief divide a scalar by every lane
+template <typename T, int W, typename S, typename = std::enable_if_t<std::is_arithmetic_v<S> > >
+SERAC_HOST_DEVICE constexpr auto operator/(S a, const simd<T, W>& b)
+{
+  return detail::lanewise(b, [a](T x) { return a / x; });
+}
+
+/// @brief lane-wise absolute value
+template <typename T, int W>
+SERAC_HOST_DEVICE auto abs(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::abs(x); });
+}
+
+/// @brief lane-wise square root
+template <typename T, int W>
+SERAC_HOST_DEVICE auto sqrt(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::sqrt(x); });
+}
+
+/// @brief lane-wise cube root
+template <typename T, int W>
+SERAC_HOST_DEVICE auto cbrt(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::cbrt(x); });
+}
+
+/// @brief lane-wise exponential
+template <typename T, int W>
+SERAC_HOST_DEVICE auto exp(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::exp(x); });
+}
+
+/// @brief lane-wise natural logarithm
+template <typename T, int W>
+SERAC_HOST_DEVICE auto log(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::log(x); });
+}
+
+/// @brief lane-wise log(1 + x)
+template <typename T, int W>
+SERAC_HOST_DEVICE auto log1p(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::log1p(x); });
+}
+
+/// @brief lane-wise cosine
+template <typename T, int W>
+SERAC_HOST_DEVICE auto cos(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::cos(x); });
+}
+
+/// @brief lane-wise sine
+template <typename T, int W>
+SERAC_HOST_DEVICE auto sin(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::sin(x); });
+}
+
+/// @brief lane-wise arctangent
+template <typename T, int W>
+SERAC_HOST_DEVICE auto atan(const simd<T, W>& a)
+{
+  return detail::lanewise(a, [](T x) { return std::atan(x); });
+}
+
+/// @brief raise each lane to the power @p b
+template <typename T, int W>
+SERAC_HOST_DEVICE auto pow(const simd<T, W>& a, double b)
+{
+  return detail::lanewise(a, [b](T x) { return std::pow(x, b); });
+}
+
+/// @brief raise each lane of @p a to the power in the same lane of @p b
+template <typename T, int W>
+SERAC_HOST_DEVICE auto pow(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return std::pow(x, y); });
+}
+
+/// @brief lane-wise maximum
+template <typename T, int W>
+SERAC_HOST_DEVICE auto max(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return (x > y) ? x : y; });
+}
+
+/// @brief lane-wise minimum
+template <typename T, int W>
+SERAC_HOST_DEVICE auto min(const simd<T, W>& a, const simd<T, W>& b)
+{
+  return detail::lanewise(a, b, [](T x, T y) { return (x < y) ? x : y; });
+}
+
+/**
+ * @brief how many elements to evaluate a q-function on at once
+ *
+ * By default, q-functions are evaluated one quadrature point at a time. A q-function type opts in to
+ * batched evaluation by declaring `static constexpr int simd_width = W;`, in which case it must also be
+ * callable with arguments whose scalar type is `simd<double, W>` (e.g. by being written generically in
+ * terms of tensor operations). Batched evaluation is currently only used for residual evaluations of
+ * q-functions without quadrature data.
+ */
+template <typename qfunction_type, typename = void>
+struct qfunction_simd_width : std::integral_constant<int, 1> {};
+
+/// @overload
+template <typename qfunction_type>
+struct qfunction_simd_width<qfunction_type, std::void_t<decltype(qfunction_type::simd_width)> >
+    : std::integral_constant<int, qfunction_type::simd_width> {};
+
+}  // namespace serac
@@ -0,0 +1,221 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/split_prolongation.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// the tags of the messages of the halo exchange and its transpose
+constexpr int exchange_tag           = 4162;
+constexpr int transpose_exchange_tag = 4163;
+
+}  // namespace
+
+SplitProlongation::PersistentExchange::~PersistentExchange()
+{
+  int finalized = 0;
+  MPI_Finalized(&finalized);
+  if (finalized) return;
+
+  for (auto* list : {&requests, &transpose_requests}) {
+    for (auto& request : *list) {
+      MPI_Request_free(&request);
+    }
+  }
+}
+
+SplitProlongation::SplitProlongation(const mfem::ParFiniteElementSpace* fes) : P(fes->GetProlongationMatrix())
+{
+  // mfem only uses a ConformingProlongationOperator (or a device-specific version of it) when every
+  // L-vector entry is either a copy of a local true dof, or a copy of a true dof owned by another rank.
+  // Anything else (e.g. the HypreParMatrix used on nonconforming meshes) is applied directly.
+  if (dynamic_cast<const mfem::ConformingProlongationOperator*>(P) == nullptr) {
+    return;
+  }
+
+  communicator = &fes->GroupComm();
+
+  // this mirrors how mfem::ConformingProlongationOperator determines which ldofs are not true dofs on this rank
+  const mfem::Table&         group_ldof = communicator->GroupLDofTable();
+  const mfem::GroupTopology& topology   = communicator->GetGroupTopology();
+  external_ldofs.Reserve(P->Height() - P->Width());
+  for (int g = 1; g < group_ldof.Size(); g++) {
+    if (!topology.IAmMaster(g)) {
+      external_ldofs.Append(group_ldof.GetRow(g), group_ldof.RowSize(g));
+    }
+  }
+  external_ldofs.Sort();
+
+  // the true dof of an ldof owned by this rank, i.e. its index with the external ldofs before it removed
+  auto tdof = [&](int ldof) {
+    return ldof - int(std::lower_bound(external_ldofs.begin(), external_ldofs.end(), ldof) - external_ldofs.begin());
+  };
+
+  // every member of a group of shared dofs knows the group by the id it has on its master rank, so listing the
+  // groups shared with each neighbor in the order of those ids makes the messages on both sides agree
+  int num_neighbors = topology.GetNumNeighbors();
+  std::vector<std::vector<std::pair<int, int>>> sent_groups(std::size_t(num_neighbors));
+  std::vector<std::vector<std::pair<int, int>>> received_groups(std::size_t(num_neighbors));
+  for (int g = 1; g < group_ldof.Size(); g++) {
+    if (topology.IAmMaster(g)) {
+      const int* members = topology.GetGroup(g);
+      for (int k = 0; k < topology.GetGroupSize(g); k++) {
+        if (members[k] != 0) {
+          sent_groups[std::size_t(members[k])].push_back({topology.GetGroupMasterGroup(g), g});
+        }
+      }
+    } else {
+      received_groups[std::size_t(topology.GetGroupMaster(g))].push_back({topology.GetGroupMasterGroup(g), g});
+    }
+  }
+
+  exchange_ = std::make_shared<PersistentExchange>();
+
+  // the offsets of the messages to (or from) each neighbor in the buffers, which must not move once the requests
+  // are created
+  std::vector<std::size_t> send_offsets(std::size_t(num_neighbors) + 1, 0);
+  std::vector<std::size_t> receive_offsets(std::size_t(num_neighbors) + 1, 0);
+  for (std::size_t n = 0; n < std::size_t(num_neighbors); n++) {
+    std::sort(sent_groups[n].begin(), sent_groups[n].end());
+    std::sort(received_groups[n].begin(), received_groups[n].end());
+    for (auto [master_group, g] : sent_groups[n]) {
+      for (int k = 0; k < group_ldof.RowSize(g); k++) {
+        exchange_->owned_tdofs.push_back(tdof(group_ldof.GetRow(g)[k]));
+      }
+    }
+    for (auto [master_group, g] : received_groups[n]) {
+      exchange_->received_ldofs.insert(exchange_->received_ldofs.end(), group_ldof.GetRow(g),
+                                       group_ldof.GetRow(g) + group_ldof.RowSize(g));
+    }
+    send_offsets[n + 1]    = exchange_->owned_tdofs.size();
+    receive_offsets[n + 1] = exchange_->received_ldofs.size();
+  }
+  exchange_->owned_values.resize(exchange_->owned_tdofs.size());
+  exchange_->received_values.resize(exchange_->received_ldofs.size());
+
+  MPI_Comm comm = topology.GetComm();
+  for (std::size_t n = 1; n < std::size_t(num_neighbors); n++) {
+    int rank = topology.GetNeighborRank(int(n));
+
+    // the halo exchange receives the values of the dofs a neighbor owns, and sends it the values of those it shares
+    // with this rank, while its transpose sends the contributions to the neighbor's dofs back, and receives theirs
+    if (int count = int(receive_offsets[n + 1] - receive_offsets[n]); count > 0) {
+      double* values = exchange_->received_values.data() + receive_offsets[n];
+      MPI_Request receive, send;
+      MPI_Recv_init(values, count, MPI_DOUBLE, rank, exchange_tag, comm, &receive);
+      MPI_Send_init(values, count, MPI_DOUBLE, rank, transpose_exchange_tag, comm, &send);
+      exchange_->requests.push_back(receive);
+      exchange_->transpose_requests.push_back(send);
+    }
+    if (int count = int(send_offsets[n + 1] - send_offsets[n]); count > 0) {
+      double* values = exchange_->owned_values.data() + send_offsets[n];
+      MPI_Request send, receive;
+      MPI_Send_init(values, count, MPI_DOUBLE, rank, exchange_tag, comm, &send);
+      MPI_Recv_init(values, count, MPI_DOUBLE, rank, transpose_exchange_tag, comm, &receive);
+      exchange_->requests.push_back(send);
+      exchange_->transpose_requests.push_back(receive);
+    }
+  }
+}
+
+void SplitProlongation::Begin(const mfem::Vector& x_T, mfem::Vector& y_L)
+{
+  SLIC_ERROR_IF(InProgress(), "SplitProlongation::Begin() called while a previous exchange is still in progress");
+
+  if (communicator == nullptr) {
+    P->Mult(x_T, y_L);
+    return;
+  }
+
+  const double* x = x_T.HostRead();
+  double*       y = y_L.HostWrite();
+
+  for (std::size_t k = 0; k < exchange_->owned_tdofs.size(); k++) {
+    exchange_->owned_values[k] = x[exchange_->owned_tdofs[k]];
+  }
+  MPI_Startall(int(exchange_->requests.size()), exchange_->requests.data());
+
+  // while that is in flight, copy the values of the dofs this rank owns,
+  // (the true dofs are the ldofs with the external entries removed)
+  int m = external_ldofs.Size();
+  int j = 0;
+  for (int i = 0; i < m; i++) {
+    int end = external_ldofs[i];
+    std::copy(x + j - i, x + end - i, y + j);
+    j = end + 1;
+  }
+  std::copy(x + j - m, x + P->Width(), y + j);
+
+  pending_output = y;
+}
+
+void SplitProlongation::Finish()
+{
+  if (pending_output == nullptr) return;
+
+  MPI_Waitall(int(exchange_->requests.size()), exchange_->requests.data(), MPI_STATUSES_IGNORE);
+  for (std::size_t k = 0; k < exchange_->received_ldofs.size(); k++) {
+    pending_output[exchange_->received_ldofs[k]] = exchange_->received_values[k];
+  }
+  pending_output = nullptr;
+}
+
+void SplitProlongation::BeginTranspose(const mfem::Vector& y_L)
+{
+  SLIC_ERROR_IF(InProgress(),
+                "SplitProlongation::BeginTranspose() called while a previous exchange is still in progress");
+
+  if (communicator == nullptr) return;
+
+  // the values of the shared dofs are copied into the send buffers here, so
+  // the other entries of y_L are free to change until FinishTranspose()
+  const double* y = y_L.HostRead();
+  for (std::size_t k = 0; k < exchange_->received_ldofs.size(); k++) {
+    exchange_->received_values[k] = y[exchange_->received_ldofs[k]];
+  }
+  MPI_Startall(int(exchange_->transpose_requests.size()), exchange_->transpose_requests.data());
+  transpose_in_progress = true;
+}
+
+void SplitProlongation::FinishTranspose(const mfem::Vector& y_L, mfem::Vector& x_T)
+{
+  if (communicator == nullptr) {
+    P->MultTranspose(y_L, x_T);
+    return;
+  }
+
+  if (!transpose_in_progress) {
+    BeginTranspose(y_L);
+  }
+
+  const double* y = y_L.HostRead();
+  double*       x = x_T.HostWrite();
+
+  int m = external_ldofs.Size();
+  int j = 0;
+  for (int i = 0; i < m; i++) {
+    int end = external_ldofs[i];
+    std::copy(y + j, y + end, x + j - i);
+    j = end + 1;
+  }
+  std::copy(y + j, y + P->Height(), x + j - m);
+
+  // the contributions from the other ranks that share a dof are summed into its true dof
+  MPI_Waitall(int(exchange_->transpose_requests.size()), exchange_->transpose_requests.data(), MPI_STATUSES_IGNORE);
+  for (std::size_t k = 0; k < exchange_->owned_tdofs.size(); k++) {
+    x[exchange_->owned_tdofs[k]] += exchange_->owned_values[k];
+  }
+  transpose_in_progress = false;
+}
+
+}  // namespace serac
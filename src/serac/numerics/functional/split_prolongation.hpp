@@ -0,0 +1,124 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file split_prolongation.hpp
+ *
+ * @brief a T-vector -> L-vector prolongation (and its transpose) whose halo exchange is split into separate
+ * "begin" and "finish" phases
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief Applies a parallel finite element space's prolongation operator (T-vector -> L-vector) in two phases,
+ * so that the communication of values owned by other ranks can overlap with other work.
+ *
+ * For conforming spaces, Begin() posts the (non-blocking) halo exchange and copies the values of the dofs owned
+ * by this rank directly out of the T-vector, and Finish() waits for the remaining values to arrive. For spaces
+ * whose prolongation can't be split this way (e.g. nonconforming meshes, where it is a general HypreParMatrix),
+ * Begin() just applies the prolongation operator and Finish() does nothing.
+ *
+ * The transpose (L-vector -> T-vector, summing the contributions to shared dofs) is split the same way:
+ * BeginTranspose() posts the reduction of the values of shared dofs, and FinishTranspose() copies the values
+ * of the dofs this rank owns and adds in the contributions received from other ranks.
+ *
+ * The messages to and from each neighboring rank are set up once, as persistent MPI requests on buffers that are
+ * reused by every exchange, so that repeated evaluations only pack, start and wait on them.
+ */
+struct SplitProlongation {
+  /// default ctor leaves this object uninitialized
+  SplitProlongation() {}
+
+  /// create a SplitProlongation for the given finite element space
+  SplitProlongation(const mfem::ParFiniteElementSpace* fes);
+
+  /**
+   * @brief start computing `y_L = P * x_T`
+   *
+   * @note the values of `y_L` that belong to other ranks are not available until Finish() is called, and
+   * `x_T` and `y_L` must not be modified or deallocated in the meantime
+   */
+  void Begin(const mfem::Vector& x_T, mfem::Vector& y_L);
+
+  /// wait for the halo exchange posted by Begin() to complete (does nothing if there isn't one in progress)
+  void Finish();
+
+  /**
+   * @brief start computing `x_T = P^T * y_L`
+   *
+   * @note only the values of `y_L` for dofs that are shared with other ranks have to be final when this is called,
+   * the rest may still be modified until FinishTranspose()
+   */
+  void BeginTranspose(const mfem::Vector& y_L);
+
+  /// complete the computation of `x_T = P^T * y_L` (posting the reduction first, if BeginTranspose() wasn't called)
+  void FinishTranspose(const mfem::Vector& y_L, mfem::Vector& x_T);
+
+  /// whether or not there is an exchange that has been posted, but not yet completed
+  bool InProgress() const { return (pending_output != nullptr) || transpose_in_progress; }
+
+  /// the prolongation operator of the finite element space
+  const mfem::Operator* P = nullptr;
+
+  /**
+   * @brief the communicator describing the dofs shared with other ranks, or nullptr if the prolongation can't be split.
+   *
+   * @note the messages of the exchanges of a finite element space are matched by the order they are posted in, so
+   * SplitProlongations for the same finite element space must not be "in progress" at the same time
+   */
+  const mfem::GroupCommunicator* communicator = nullptr;
+
+  /// the (sorted) L-vector indices of the dofs that are owned by other ranks
+  mfem::Array<int> external_ldofs;
+
+private:
+  /// @brief the persistent messages of the halo exchange and its transpose, and their buffers
+  struct PersistentExchange {
+    PersistentExchange() = default;
+    PersistentExchange(const PersistentExchange&) = delete;
+    PersistentExchange& operator=(const PersistentExchange&) = delete;
+
+    /// frees the persistent requests
+    ~PersistentExchange();
+
+    /// the true dofs owned by this rank that are sent to each neighbor (in the order of the messages)
+    std::vector<int> owned_tdofs;
+
+    /// the L-vector indices of the dofs owned by each neighbor that are received from them
+    std::vector<int> received_ldofs;
+
+    /// the values of owned_tdofs, sent by Begin() and received (from the ranks that share them) by FinishTranspose()
+    std::vector<double> owned_values;
+
+    /// the values of received_ldofs, received by Finish() and sent (to the ranks that own them) by BeginTranspose()
+    std::vector<double> received_values;
+
+    /// the receives and sends of the halo exchange
+    std::vector<MPI_Request> requests;
+
+    /// the receives and sends of its transpose
+    std::vector<MPI_Request> transpose_requests;
+  };
+
+  /// the halo exchange, shared by copies of this SplitProlongation
+  std::shared_ptr<PersistentExchange> exchange_;
+
+  /// the L-vector data that is waiting on values from the halo exchange
+  double* pending_output = nullptr;
+
+  /// whether a reduction has been posted by BeginTranspose(), but not completed by FinishTranspose()
+  bool transpose_in_progress = false;
+};
+
+}  // namespace serac
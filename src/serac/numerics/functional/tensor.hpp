@@ -707,10 +707,11 @@ SERAC_HOST_DEVICE constexpr auto inner(double A, double B) { return A * B; }
 template <typename S, typename T, int m, int n, int p>
 SERAC_HOST_DEVICE constexpr auto dot(const tensor<S, m, n>& A, const tensor<T, n, p>& B)
 {
+  // i-k-j loop order: the innermost loop is a unit-stride update of a row of AB, see contract()
   tensor<decltype(S{} * T{}), m, p> AB{};
   for (int i = 0; i < m; i++) {
-    for (int j = 0; j < p; j++) {
-      for (int k = 0; k < n; k++) {
+    for (int k = 0; k < n; k++) {
+      for (int j = 0; j < p; j++) {
         AB[i][j] = AB[i][j] + A[i][k] * B[k][j];
       }
     }
@@ -1335,33 +1336,33 @@ SERAC_HOST_DEVICE auto contract(const tensor<S, m, n...>& A, const tensor<T, p,
     if constexpr (d3 != 0) return tensor<U, d1, d2, d3>{};
   }();
 
+  // the contracted index is the middle loop, so that the innermost loop is a unit-stride update of the
+  // last index of C (with no loop-carried dependence, unlike an inner sum), which compilers can vectorize
+  // for both the fixed-size and the sum-factorization (p+1)x(q) cases. The terms of each entry of C are
+  // still accumulated in the same order.
   if constexpr (d3 == 0) {
     for (int i = 0; i < d1; i++) {
-      for (int j = 0; j < d2; j++) {
-        U sum{};
-        for (int k = 0; k < Adims[i1]; k++) {
-          if constexpr (i1 == 0 && i2 == 0) sum += A(k, j) * B(k, i);
-          if constexpr (i1 == 1 && i2 == 0) sum += A(i, k) * B(k, j);
-          if constexpr (i1 == 0 && i2 == 1) sum += A(k, j) * B(i, k);
-          if constexpr (i1 == 1 && i2 == 1) sum += A(i, k) * B(j, k);
+      for (int k = 0; k < Adims[i1]; k++) {
+        for (int j = 0; j < d2; j++) {
+          if constexpr (i1 == 0 && i2 == 0) C(i, j) += A(k, j) * B(k, i);
+          if constexpr (i1 == 1 && i2 == 0) C(i, j) += A(i, k) * B(k, j);
+          if constexpr (i1 == 0 && i2 == 1) C(i, j) += A(k, j) * B(i, k);
+          if constexpr (i1 == 1 && i2 == 1) C(i, j) += A(i, k) * B(j, k);
         }
-        C(i, j) = sum;
       }
     }
   } else {
     for (int i = 0; i < d1; i++) {
       for (int j = 0; j < d2; j++) {
-        for (int k = 0; k < d3; k++) {
-          U sum{};
-          for (int l = 0; l < Adims[i1]; l++) {
-            if constexpr (i1 == 0 && i2 == 0) sum += A(l, j, k) * B(l, i);
-            if constexpr (i1 == 1 && i2 == 0) sum += A(i, l, k) * B(l, j);
-            if constexpr (i1 == 2 && i2 == 0) sum += A(i, j, l) * B(l, k);
-            if constexpr (i1 == 0 && i2 == 1) sum += A(l, j, k) * B(i, l);
-            if constexpr (i1 == 1 && i2 == 1) sum += A(i, l, k) * B(j, l);
-            if constexpr (i1 == 2 && i2 == 1) sum += A(i, j, l) * B(k, l);
+        for (int l = 0; l < Adims[i1]; l++) {
+          for (int k = 0; k < d3; k++) {
+            if constexpr (i1 == 0 && i2 == 0) C(i, j, k) += A(l, j, k) * B(l, i);
+            if constexpr (i1 == 1 && i2 == 0) C(i, j, k) += A(i, l, k) * B(l, j);
+            if constexpr (i1 == 2 && i2 == 0) C(i, j, k) += A(i, j, l) * B(l, k);
+            if constexpr (i1 == 0 && i2 == 1) C(i, j, k) += A(l, j, k) * B(i, l);
+            if constexpr (i1 == 1 && i2 == 1) C(i, j, k) += A(i, l, k) * B(j, l);
+            if constexpr (i1 == 2 && i2 == 1) C(i, j, k) += A(i, j, l) * B(k, l);
           }
-          C(i, j, k) = sum;
         }
       }
     }
@@ -1840,6 +1841,41 @@ SERAC_HOST_DEVICE auto chain_rule(const tensor<double, m, n, p...>& df_dx, const
   return total;
 }
 
+/**
+ * @brief the transpose of chain_rule(): given a small change in the output of a function, f, compute the
+ * corresponding change in its input argument, i.e. dx := transpose(df_dx) * dy
+ *
+ * @tparam X the type of the input argument of f
+ * @param df_dx the derivative of f, with the indices of its output followed by the indices of its input
+ * @param dy a small change in the output of f
+ *
+ * @note the result is identically zero when either df_dx or dy is
+ */
+template <typename X, typename D, typename Y>
+SERAC_HOST_DEVICE auto transpose_chain_rule(const D& df_dx, const Y& dy)
+{
+  if constexpr (is_zero<D>{} || is_zero<Y>{}) {
+    return zero{};
+  } else {
+    constexpr int nx = sizeof(X) / sizeof(double);
+    constexpr int ny = sizeof(Y) / sizeof(double);
+    static_assert(sizeof(D) == sizeof(double) * nx * ny, "df_dx must have the indices of dy followed by those of dx");
+
+    // the derivatives are contiguous arrays of doubles, so they can be viewed as a (ny x nx) matrix
+    const double* d = reinterpret_cast<const double*>(&df_dx);
+    const double* y = reinterpret_cast<const double*>(&dy);
+
+    X       dx{};
+    double* x = reinterpret_cast<double*>(&dx);
+    for (int i = 0; i < ny; i++) {
+      for (int j = 0; j < nx; j++) {
+        x[j] += y[i] * d[i * nx + j];
+      }
+    }
+    return dx;
+  }
+}
+
 /**
  * @brief returns the total number of stored values in a tensor
  *
@@ -31,6 +31,16 @@ tensor<double, dim> average(std::vector<tensor<double, dim> >& positions)
   return total / double(positions.size());
 }
 
+template <int n, int dim>
+tensor<double, dim> average(const tensor<double, n, dim>& positions)
+{
+  tensor<double, dim> total{};
+  for (int i = 0; i < n; i++) {
+    total += positions[i];
+  }
+  return total / double(n);
+}
+
 TEST(domain, of_vertices)
 {
   {
@@ -336,6 +346,112 @@ TEST(domain, of_elements)
   }
 }
 
+void check_same_entities(const Domain& a, const Domain& b)
+{
+  EXPECT_EQ(a.dim_, b.dim_);
+  EXPECT_EQ(a.type_, b.type_);
+  for (auto geom : {mfem::Geometry::SEGMENT, mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
+                    mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE}) {
+    EXPECT_EQ(a.get(geom), b.get(geom));
+  }
+  EXPECT_EQ(a.mfem_edge_ids_, b.mfem_edge_ids_);
+  EXPECT_EQ(a.mfem_tri_ids_, b.mfem_tri_ids_);
+  EXPECT_EQ(a.mfem_quad_ids_, b.mfem_quad_ids_);
+  EXPECT_EQ(a.mfem_tet_ids_, b.mfem_tet_ids_);
+  EXPECT_EQ(a.mfem_hex_ids_, b.mfem_hex_ids_);
+}
+
+TEST(domain, fixed_size_predicates)
+{
+  {
+    auto mesh = import_mesh("patch3D_tets_and_hexes.mesh");
+
+    auto x_lt = [](double value) { return [value](const auto& X, int /* attr */) { return average(X)[0] < value; }; };
+
+    check_same_entities(Domain::ofElements<3>(mesh, x_lt(0.7)),
+                        Domain::ofElements(mesh, std::function([](std::vector<vec3> vertices, int) {
+                                             return average(vertices)[0] < 0.7;
+                                           })));
+
+    check_same_entities(Domain::ofFaces<3>(mesh, x_lt(0.5)),
+                        Domain::ofFaces(mesh, std::function([](std::vector<vec3> vertices, int) {
+                                          return average(vertices)[0] < 0.5;
+                                        })));
+
+    check_same_entities(Domain::ofBoundaryElements<3>(mesh, x_lt(0.5)),
+                        Domain::ofBoundaryElements(mesh, std::function([](std::vector<vec3> vertices, int) {
+                                                     return average(vertices)[0] < 0.5;
+                                                   })));
+
+    check_same_entities(
+        Domain::ofEdges<3>(mesh, [](const tensor<double, 2, 3>& X, int) { return average(X)[1] < 0.5; }),
+        Domain::ofEdges(mesh, std::function([](std::vector<vec3> x) { return average(x)[1] < 0.5; })));
+  }
+
+  {
+    auto mesh = import_mesh("patch2D_tris_and_quads.mesh");
+
+    auto y_lt = [](double value) { return [value](const auto& X, int /* attr */) { return average(X)[1] < value; }; };
+
+    check_same_entities(Domain::ofElements<2>(mesh, y_lt(0.45)),
+                        Domain::ofElements(mesh, std::function([](std::vector<vec2> vertices, int) {
+                                             return average(vertices)[1] < 0.45;
+                                           })));
+
+    check_same_entities(Domain::ofFaces<2>(mesh, y_lt(0.45)),
+                        Domain::ofFaces(mesh, std::function([](std::vector<vec2> vertices, int) {
+                                          return average(vertices)[1] < 0.45;
+                                        })));
+
+    check_same_entities(Domain::ofBoundaryElements<2>(mesh, y_lt(0.5)),
+                        Domain::ofBoundaryElements(mesh, std::function([](std::vector<vec2> vertices, int) {
+                                                     return average(vertices)[1] < 0.5;
+                                                   })));
+
+    // attributes are passed to the predicate too
+    check_same_entities(Domain::ofElements<2>(mesh, [](const auto&, int attr) { return attr == 1; }),
+                        Domain::ofElements(mesh, by_attr<2>(1)));
+  }
+}
+
+TEST(domain, attribute_index)
+{
+  for (auto filename : {"patch2D_tris_and_quads.mesh", "patch3D_tets_and_hexes.mesh"}) {
+    auto mesh = import_mesh(filename);
+    int  dim  = mesh.SpaceDimension();
+
+    AttributeIndex index(mesh);
+
+    auto elements_with = [&](int attr) {
+      return (dim == 2) ? Domain::ofElements(mesh, by_attr<2>(attr)) : Domain::ofElements(mesh, by_attr<3>(attr));
+    };
+
+    auto boundary_elements_with = [&](int attr) {
+      return (dim == 2) ? Domain::ofBoundaryElements(mesh, by_attr<2>(attr))
+                        : Domain::ofBoundaryElements(mesh, by_attr<3>(attr));
+    };
+
+    for (int attr = 1; attr <= mesh.attributes.Max(); attr++) {
+      check_same_entities(index.elements({attr}), elements_with(attr));
+    }
+
+    for (int attr = 1; attr <= mesh.bdr_attributes.Max(); attr++) {
+      check_same_entities(index.boundaryElements({attr}), boundary_elements_with(attr));
+    }
+
+    // several attributes, and the set operations on the domains they correspond to
+    check_same_entities(index.elements({1, 2}), elements_with(1) | elements_with(2));
+    check_same_entities(index.boundaryElements({1, 3}), boundary_elements_with(1) | boundary_elements_with(3));
+    check_same_entities(index.boundaryElements({1}), index.boundaryElements({1, 3}) - boundary_elements_with(3));
+    check_same_entities(index.elements({}), elements_with(1) & elements_with(2));
+
+    // an entire domain combines like any other
+    check_same_entities(EntireDomain(mesh) & elements_with(1), elements_with(1));
+    check_same_entities(EntireBoundary(mesh) - boundary_elements_with(1),
+                        EntireBoundary(mesh) - index.boundaryElements({1}));
+  }
+}
+
 int main(int argc, char* argv[])
 {
   int num_procs, myid;
@@ -42,6 +42,24 @@ struct TestThermalModelOne {
   }
 };
 
+// the same q-function, evaluated on 4 elements per call through simd<double, 4> arguments
+template <int dim>
+struct BatchedThermalModelOne : public TestThermalModelOne<dim> {
+  static constexpr int simd_width = 4;
+};
+
+// the same q-function, with an extra argument that it declares it never reads
+template <int dim>
+struct TestThermalModelWithUnusedArgument {
+  static constexpr bool reads_argument(int i) { return i != 1; }
+
+  template <typename P, typename Temp, typename Unused>
+  SERAC_HOST_DEVICE auto operator()(double t, P position, Temp temperature, Unused) const
+  {
+    return TestThermalModelOne<dim>{}(t, position, temperature);
+  }
+};
+
 struct TestThermalModelTwo {
   template <typename PositionType, typename TempType>
   SERAC_HOST_DEVICE auto operator()(double, PositionType position, TempType temperature) const
@@ -84,6 +102,287 @@ void thermal_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
   check_gradient(residual, t, U);
 }
 
+template <int p, int dim>
+void batched_evaluation_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector              U(fespace.TrueVSize());
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+  U_gf.GetTrueDofs(U);
+
+  using space = H1<p>;
+
+  Functional<space(space)> scalar_residual(&fespace, {&fespace});
+  scalar_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+
+  Functional<space(space)> batched_residual(&fespace, {&fespace});
+  batched_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, BatchedThermalModelOne<dim>{}, *mesh);
+
+  double       t = 0.0;
+  mfem::Vector r_scalar(scalar_residual(t, U));
+  mfem::Vector r_batched(batched_residual(t, U));
+
+  mfem::Vector diff(r_scalar);
+  diff -= r_batched;
+  EXPECT_LT(diff.Normlinf(), 1.0e-12 * r_scalar.Normlinf());
+
+  // evaluating into a caller-owned vector gives the same result as operator()
+  mfem::Vector r_into(fespace.TrueVSize());
+  scalar_residual.evaluateInto(r_into, t, U);
+  r_into -= r_scalar;
+  EXPECT_LT(r_into.Normlinf(), 1.0e-12 * r_scalar.Normlinf());
+}
+
+template <int p, int dim>
+void device_kernels_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector              U(fespace.TrueVSize());
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+  U_gf.GetTrueDofs(U);
+
+  using space = H1<p>;
+
+  Functional<space(space)> host_residual(&fespace, {&fespace});
+  host_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+
+  // this file isn't compiled with nvcc, so the kernels of the GPU execution space run on the host, through the same
+  // code paths. functional_device_kernels_cuda.cu runs them on the device, in CUDA builds
+  Functional<space(space), ExecutionSpace::GPU> device_residual(&fespace, {&fespace});
+  device_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+
+  double t = 0.0;
+
+  auto [r1, dr1] = host_residual(t, differentiate_wrt(U));
+  auto [r2, dr2] = device_residual(t, differentiate_wrt(U));
+
+  mfem::Vector diff(r1);
+  diff -= r2;
+  EXPECT_LT(diff.Normlinf(), 1.0e-12 * r1.Normlinf());
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize();
+
+  mfem::Vector ddiff(dr1(dU));
+  ddiff -= dr2(dU);
+  EXPECT_LT(ddiff.Normlinf(), 1.0e-12 * dr1(dU).Normlinf());
+
+  // evaluating without derivatives gives the same values
+  mfem::Vector r3(device_residual(t, U));
+  r3 -= r1;
+  EXPECT_LT(r3.Normlinf(), 1.0e-12 * r1.Normlinf());
+}
+
+template <int p, int dim>
+void unused_argument_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector              U(fespace.TrueVSize());
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+  U_gf.GetTrueDofs(U);
+
+  // the unused argument gets nonzero values, which must not affect the result
+  mfem::Vector V(fespace.TrueVSize());
+  V.Randomize();
+
+  using space = H1<p>;
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+
+  Functional<space(space, space)> residual_with_unused_argument(&fespace, {&fespace, &fespace});
+  residual_with_unused_argument.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1>{},
+                                                  TestThermalModelWithUnusedArgument<dim>{}, *mesh);
+
+  double t = 0.0;
+
+  auto [r1, dr1] = residual(t, differentiate_wrt(U));
+  auto [r2, dr2] = residual_with_unused_argument(t, differentiate_wrt(U), V);
+
+  mfem::Vector diff(r1);
+  diff -= r2;
+  EXPECT_LT(diff.Normlinf(), 1.0e-12 * r1.Normlinf());
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize();
+
+  mfem::Vector ddiff(dr1(dU));
+  ddiff -= dr2(dU);
+  EXPECT_LT(ddiff.Normlinf(), 1.0e-12 * dr1(dU).Normlinf());
+}
+
+template <int p, int dim>
+void frozen_argument_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize(1);
+
+  mfem::Vector V(U);
+  V *= 2.0;
+
+  using space = H1<p>;
+
+  double t = 0.0;
+
+  // with or without caching the quadrature point values of the frozen argument
+  for (bool cache : {false, true}) {
+    Functional<space(space)> residual(&fespace, {&fespace});
+    residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+    residual.cacheFrozenArguments(cache);
+
+    mfem::Vector r_U(residual(t, U));
+    mfem::Vector r_V(residual(t, V));
+
+    // a frozen argument keeps the value it had in the first evaluation after it was frozen
+    residual.freezeArgument(0, true);
+
+    mfem::Vector diff(residual(t, U));
+    diff -= r_U;
+    EXPECT_LT(diff.Normlinf(), 1.0e-12 * r_U.Normlinf());
+
+    diff = residual(t, V);
+    diff -= r_U;
+    EXPECT_LT(diff.Normlinf(), 1.0e-12 * r_U.Normlinf());
+
+    EXPECT_EQ(residual.memoryUsage()["cached_inputs"] > 0, cache);
+
+    // and uses the values that are passed in again once it is unfrozen
+    residual.freezeArgument(0, false);
+
+    diff = residual(t, V);
+    diff -= r_V;
+    EXPECT_LT(diff.Normlinf(), 1.0e-12 * r_V.Normlinf());
+  }
+}
+
+template <int p, int dim>
+void shared_setup_test_impl(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  auto fec = mfem::H1_FECollection(p, dim);
+
+  // two different spaces with the same dof layout, like the states of a physics module
+  mfem::ParFiniteElementSpace fespace1(mesh.get(), &fec);
+  mfem::ParFiniteElementSpace fespace2(mesh.get(), &fec);
+
+  mfem::Vector U(fespace1.TrueVSize());
+  U.Randomize(1);
+
+  using space = H1<p>;
+
+  double t = 0.0;
+
+  Functional<space(space)> residual1(&fespace1, {&fespace1});
+  residual1.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+  auto [r1, dr1] = residual1(t, differentiate_wrt(U));
+  auto K1        = assemble(dr1);
+
+  std::size_t num_shared = shared_setup::size();
+
+  Functional<space(space)> residual2(&fespace2, {&fespace2});
+  residual2.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalModelOne<dim>{}, *mesh);
+  auto [r2, dr2] = residual2(t, differentiate_wrt(U));
+  auto K2        = assemble(dr2);
+
+  // the second Functional reuses the restrictions, geometric factors and lookup tables of the first
+  EXPECT_EQ(shared_setup::size(), num_shared);
+
+  mfem::Vector diff(r2);
+  diff -= r1;
+  EXPECT_LT(diff.Normlinf(), 1.0e-12 * r1.Normlinf());
+
+  mfem::Vector K1U(U.Size());
+  mfem::Vector K2U(U.Size());
+  K1->Mult(U, K1U);
+  K2->Mult(U, K2U);
+  K2U -= K1U;
+  EXPECT_LT(K2U.Normlinf(), 1.0e-12 * K1U.Normlinf());
+}
+
+template <int p>
+void shared_setup_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    shared_setup_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    shared_setup_test_impl<p, 3>(mesh);
+  }
+}
+
+template <int p>
+void frozen_argument_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    frozen_argument_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    frozen_argument_test_impl<p, 3>(mesh);
+  }
+}
+
+template <int p>
+void device_kernels_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    device_kernels_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    device_kernels_test_impl<p, 3>(mesh);
+  }
+}
+
+template <int p>
+void unused_argument_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    unused_argument_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    unused_argument_test_impl<p, 3>(mesh);
+  }
+}
+
+template <int p>
+void batched_evaluation_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  if (mesh->Dimension() == 2) {
+    batched_evaluation_test_impl<p, 2>(mesh);
+  }
+
+  if (mesh->Dimension() == 3) {
+    batched_evaluation_test_impl<p, 3>(mesh);
+  }
+}
+
 template <int ptest, int ptrial>
 void thermal_test(std::string meshfile)
 {
@@ -109,6 +408,21 @@ TEST(basic, thermal_tets_and_hexes) { thermal_test<1, 1>("/data/meshes/patch3D_t
 TEST(mixed, thermal_tris_and_quads) { thermal_test<2, 1>("/data/meshes/patch2D_tris_and_quads.mesh"); }
 TEST(mixed, thermal_tets_and_hexes) { thermal_test<2, 1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
 
+TEST(batched, thermal_tris_and_quads) { batched_evaluation_test<2>("/data/meshes/patch2D_tris_and_quads.mesh"); }
+TEST(batched, thermal_tets_and_hexes) { batched_evaluation_test<1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+
+TEST(device_kernels, thermal_tris_and_quads) { device_kernels_test<2>("/data/meshes/patch2D_tris_and_quads.mesh"); }
+TEST(device_kernels, thermal_tets_and_hexes) { device_kernels_test<1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+
+TEST(unused_argument, thermal_tris_and_quads) { unused_argument_test<2>("/data/meshes/patch2D_tris_and_quads.mesh"); }
+TEST(unused_argument, thermal_tets_and_hexes) { unused_argument_test<1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+
+TEST(frozen_argument, thermal_tris_and_quads) { frozen_argument_test<2>("/data/meshes/patch2D_tris_and_quads.mesh"); }
+TEST(frozen_argument, thermal_tets_and_hexes) { frozen_argument_test<1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+
+TEST(shared_setup, thermal_tris_and_quads) { shared_setup_test<2>("/data/meshes/patch2D_tris_and_quads.mesh"); }
+TEST(shared_setup, thermal_tets_and_hexes) { shared_setup_test<1>("/data/meshes/patch3D_tets_and_hexes.mesh"); }
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -67,6 +67,31 @@ struct ElasticityTestModelOne {
   }
 };
 
+// a q-function with symmetric d(source)/du and d(flux)/d(du_dx), whose derivatives are stored packed
+template <int dim>
+struct SymmetricElasticityTestModel {
+  template <typename position_type, typename displacement_type>
+  SERAC_HOST_DEVICE auto operator()(double, position_type, displacement_type displacement) const
+  {
+    constexpr static auto d00 = make_tensor<dim, dim>([](int i, int j) { return i + j + 1.0; });
+    constexpr static auto a   = make_tensor<dim, dim>([](int i, int j) { return i + 3.0 * j + 1.0; });
+    constexpr static auto d11 =
+        make_tensor<dim, dim, dim, dim>([](int i, int j, int k, int l) { return a[i][j] * a[k][l]; });
+    auto [u, du_dx] = displacement;
+    auto source     = dot(d00, u);
+    auto flux       = double_dot(d11, du_dx) + du_dx;
+    return serac::tuple{source, flux};
+  }
+
+  static constexpr bool symmetric_derivative(int) { return true; }
+};
+
+// the same q-function, but with its derivatives stored in single precision
+template <int dim>
+struct SinglePrecisionElasticityTestModel : ElasticityTestModelOne<dim> {
+  static constexpr bool single_precision_derivative(int) { return true; }
+};
+
 template <int dim>
 struct ElasticityTestModelTwo {
   template <typename position_type, typename displacement_type>
@@ -78,6 +103,134 @@ struct ElasticityTestModelTwo {
   }
 };
 
+// pure elasticity: the flux only depends on the displacement gradient, and the source term is constant
+template <int dim>
+struct PureElasticityTestModel {
+  template <typename position_type, typename displacement_type>
+  SERAC_HOST_DEVICE auto operator()(double, position_type, displacement_type displacement) const
+  {
+    constexpr static auto d11 =
+        make_tensor<dim, dim, dim, dim>([](int i, int j, int k, int l) { return i - j + 2 * k - 3 * l + 1; });
+    auto [u, du_dx] = displacement;
+    auto source     = make_tensor<dim>([](int i) { return i + 1.0; });
+    auto flux       = double_dot(d11, du_dx);
+    return serac::tuple{source, flux};
+  }
+};
+
+// a density-weighted mass term
+template <int dim>
+struct MassTestModel {
+  template <typename position_type, typename displacement_type>
+  SERAC_HOST_DEVICE auto operator()(double, position_type, displacement_type displacement) const
+  {
+    auto [u, du_dx] = displacement;
+    return serac::tuple{2.0 * u, zero{}};
+  }
+};
+
+// compare the matrix-free diagonal of the gradient to the diagonal of the assembled matrix
+template <typename T>
+void check_diagonal(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  auto [value, dfdU] = f(t, differentiate_wrt(U));
+
+  mfem::Vector diagonal(U.Size());
+  dfdU.AssembleDiagonal(diagonal);
+
+  std::unique_ptr<mfem::HypreParMatrix> dfdU_matrix = assemble(dfdU);
+  mfem::Vector                          expected;
+  dfdU_matrix->GetDiag(expected);
+
+  mfem::Vector difference = diagonal;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+}
+
+template <int p, int dim>
+void symmetric_elasticity_test(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  using space = H1<p, dim>;
+
+  auto [fes, col] = generateParFiniteElementSpace<space>(mesh.get());
+
+  mfem::Vector U(fes->TrueVSize());
+  U.Randomize();
+
+  Functional<space(space)> residual(fes.get(), {fes.get()});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, SymmetricElasticityTestModel<dim>{}, *mesh);
+
+  double t = 0.0;
+  check_gradient(residual, t, U);
+  check_diagonal(residual, t, U);
+}
+
+template <int p, int dim>
+void pure_elasticity_test(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  using space = H1<p, dim>;
+
+  // the derivatives w.r.t. the (unused) displacement value are structurally zero, and aren't stored
+  using derivative_type =
+      decltype(domain_integral::get_derivative_type<0, dim, space>(PureElasticityTestModel<dim>{}, Nothing{}));
+  static_assert(std::is_same_v<derivative_type, tuple<zero, tuple<zero, tensor<double, dim, dim, dim, dim>>>>);
+  static_assert(sizeof(derivative_storage<derivative_type, false>::type) == sizeof(double) * dim * dim * dim * dim);
+
+  auto [fes, col] = generateParFiniteElementSpace<space>(mesh.get());
+
+  mfem::Vector U(fes->TrueVSize());
+  U.Randomize();
+
+  Functional<space(space)> residual(fes.get(), {fes.get()});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, PureElasticityTestModel<dim>{}, *mesh);
+
+  double t = 0.0;
+  check_gradient(residual, t, U);
+  check_diagonal(residual, t, U);
+}
+
+// the gradient actions with derivatives stored in single precision agree with those in double to single precision,
+// and take half the storage
+template <int p, int dim>
+void single_precision_test(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  using space = H1<p, dim>;
+
+  using derivative_type =
+      decltype(domain_integral::get_derivative_type<0, dim, space>(ElasticityTestModelOne<dim>{}, Nothing{}));
+  static_assert(sizeof(single_precision_derivative_storage<derivative_type, false>::type) ==
+                sizeof(derivative_storage<derivative_type, false>::type) / 2);
+
+  auto [fes, col] = generateParFiniteElementSpace<space>(mesh.get());
+
+  mfem::Vector U(fes->TrueVSize()), V(fes->TrueVSize());
+  U.Randomize(1);
+  V.Randomize(2);
+
+  Functional<space(space)> exact(fes.get(), {fes.get()});
+  exact.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, ElasticityTestModelOne<dim>{}, *mesh);
+
+  Functional<space(space)> rounded(fes.get(), {fes.get()});
+  rounded.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, SinglePrecisionElasticityTestModel<dim>{}, *mesh);
+
+  double t                           = 0.0;
+  auto [exact_value, exact_grad]     = exact(t, differentiate_wrt(U));
+  auto [rounded_value, rounded_grad] = rounded(t, differentiate_wrt(U));
+
+  // the residuals themselves are still evaluated in double
+  mfem::Vector difference = rounded_value;
+  difference -= exact_value;
+  EXPECT_EQ(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 0.0);
+
+  mfem::Vector exact_jvp   = exact_grad(V);
+  mfem::Vector rounded_jvp = rounded_grad(V);
+  difference               = rounded_jvp;
+  difference -= exact_jvp;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-6 * mfem::ParNormlp(exact_jvp, 2, MPI_COMM_WORLD));
+
+  EXPECT_EQ(2 * rounded.memoryUsage()["qfunction_derivatives"], exact.memoryUsage()["qfunction_derivatives"]);
+}
+
 template <int p, int dim>
 void weird_mixed_test(std::unique_ptr<mfem::ParMesh>& mesh)
 {
@@ -127,6 +280,105 @@ void elasticity_test(std::unique_ptr<mfem::ParMesh>& mesh)
 
   double t = 0.0;
   check_gradient(residual, t, U);
+  check_diagonal(residual, t, U);
+}
+
+// compare the lumped diagonals of a mass matrix to the row sums and diagonal of the assembled matrix
+template <int p, int dim>
+void lumped_mass_test(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  using space = H1<p, dim>;
+
+  auto [fes, col] = generateParFiniteElementSpace<space>(mesh.get());
+
+  mfem::Vector U(fes->TrueVSize());
+  U = 0.0;
+
+  Functional<space(space)> mass(fes.get(), {fes.get()});
+  mass.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, MassTestModel<dim>{}, *mesh);
+
+  double t       = 0.0;
+  auto [r, dfdU] = mass(t, differentiate_wrt(U));
+
+  std::unique_ptr<mfem::HypreParMatrix> M = assemble(dfdU);
+
+  mfem::Vector ones(U.Size());
+  ones = 1.0;
+
+  mfem::Vector expected(U.Size());
+  M->Mult(ones, expected);
+
+  mfem::Vector row_sums   = dfdU.lumpedDiagonal(LumpingMethod::RowSum);
+  mfem::Vector difference = row_sums;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+
+  // HRZ lumping preserves the total mass, and is proportional to the consistent diagonal
+  mfem::Vector hrz   = dfdU.lumpedDiagonal(LumpingMethod::HRZ);
+  double       total = mfem::InnerProduct(MPI_COMM_WORLD, expected, ones);
+  EXPECT_NEAR(mfem::InnerProduct(MPI_COMM_WORLD, hrz, ones), total, 1.0e-12 * total);
+
+  mfem::Vector diagonal;
+  M->GetDiag(diagonal);
+  for (int i = 0; i < hrz.Size(); i++) {
+    EXPECT_GT(hrz[i], 0.0);
+    EXPECT_NEAR(hrz[i] / diagonal[i], hrz[0] / diagonal[0], 1.0e-10);
+  }
+}
+
+// the residuals and gradients of the same fields in spaces with nodal and interleaved (byVDIM) orderings, which only
+// differ by a permutation of their dofs, are compared through their inner products with other fields
+template <int p, int dim>
+void interleaved_ordering_test(std::unique_ptr<mfem::ParMesh>& mesh)
+{
+  using space = H1<p, dim>;
+
+  auto [nodal_fes, nodal_col]             = generateParFiniteElementSpace<space>(mesh.get());
+  auto [interleaved_fes, interleaved_col] = generateParFiniteElementSpace<space>(mesh.get(), mfem::Ordering::byVDIM);
+
+  mfem::VectorFunctionCoefficient u_coef(dim, [](const mfem::Vector& x, mfem::Vector& u) {
+    for (int i = 0; i < u.Size(); i++) {
+      u[i] = std::sin(x[0] + i) * x[1] + 0.1 * i;
+    }
+  });
+  mfem::VectorFunctionCoefficient v_coef(dim, [](const mfem::Vector& x, mfem::Vector& v) {
+    for (int i = 0; i < v.Size(); i++) {
+      v[i] = std::cos(x[1] - i) + x[0] * x[0];
+    }
+  });
+
+  // the values, residual, gradient action and assembled gradient action for a space, tested with v
+  auto evaluate = [&](mfem::ParFiniteElementSpace& fes) {
+    mfem::ParGridFunction u_gf(&fes), v_gf(&fes);
+    u_gf.ProjectCoefficient(u_coef);
+    v_gf.ProjectCoefficient(v_coef);
+
+    mfem::Vector U(fes.TrueVSize()), V(fes.TrueVSize());
+    u_gf.ParallelProject(U);
+    v_gf.ParallelProject(V);
+
+    Functional<space(space)> residual(&fes, {&fes});
+    residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, ElasticityTestModelOne<dim>{}, *mesh);
+    residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, ElasticityTestModelTwo<dim>{}, *mesh);
+
+    auto [r, dfdU]      = residual(0.0, differentiate_wrt(U));
+    mfem::Vector dfdU_V = dfdU(V);
+
+    std::unique_ptr<mfem::HypreParMatrix> A = assemble(dfdU);
+    mfem::Vector                          A_V(V.Size());
+    A->Mult(V, A_V);
+
+    return std::array<double, 3>{mfem::InnerProduct(MPI_COMM_WORLD, r, V),
+                                 mfem::InnerProduct(MPI_COMM_WORLD, dfdU_V, V),
+                                 mfem::InnerProduct(MPI_COMM_WORLD, A_V, V)};
+  };
+
+  auto nodal       = evaluate(*nodal_fes);
+  auto interleaved = evaluate(*interleaved_fes);
+  for (std::size_t i = 0; i < nodal.size(); i++) {
+    EXPECT_NEAR(interleaved[i], nodal[i], 1.0e-12 * std::abs(nodal[i]));
+  }
+  EXPECT_NEAR(nodal[2], nodal[1], 1.0e-12 * std::abs(nodal[1]));
 }
 
 void test_suite(std::string meshfile)
@@ -137,6 +389,11 @@ void test_suite(std::string meshfile)
     constexpr int dim = 2;
     elasticity_test<1, dim>(mesh);
     elasticity_test<2, dim>(mesh);
+    symmetric_elasticity_test<2, dim>(mesh);
+    pure_elasticity_test<2, dim>(mesh);
+    single_precision_test<2, dim>(mesh);
+    lumped_mass_test<2, dim>(mesh);
+    interleaved_ordering_test<2, dim>(mesh);
     weird_mixed_test<1, dim>(mesh);
     weird_mixed_test<2, dim>(mesh);
   }
@@ -145,6 +402,11 @@ void test_suite(std::string meshfile)
     constexpr int dim = 3;
     elasticity_test<1, dim>(mesh);
     elasticity_test<2, dim>(mesh);
+    symmetric_elasticity_test<2, dim>(mesh);
+    pure_elasticity_test<2, dim>(mesh);
+    single_precision_test<2, dim>(mesh);
+    lumped_mass_test<2, dim>(mesh);
+    interleaved_ordering_test<2, dim>(mesh);
     weird_mixed_test<1, dim>(mesh);
     weird_mixed_test<2, dim>(mesh);
   }
@@ -0,0 +1,93 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/accelerator.hpp"
+#include "serac/mesh/mesh_utils_base.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+using namespace serac;
+
+// the domain kernels of the GPU execution space are compiled with nvcc here, so (unlike device_kernels in
+// functional_basic_h1_scalar.cpp) they run on the device, and are compared against the host kernels
+template <int dim>
+struct ThermalModel {
+  template <typename P, typename Temp>
+  SERAC_HOST_DEVICE auto operator()(double, P position, Temp temperature) const
+  {
+    auto [X, dX_dxi] = position;
+    auto [u, du_dx]  = temperature;
+    auto source      = u * u + X[0];
+    auto flux        = (1.0 + u * u) * du_dx;
+    return serac::tuple{source, flux};
+  }
+};
+
+template <int p, int dim>
+void device_vs_host_test(std::string meshfile)
+{
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR + meshfile), 1);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector              U(fespace.TrueVSize());
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+  U_gf.GetTrueDofs(U);
+
+  using space = H1<p>;
+
+  Functional<space(space)> host_residual(&fespace, {&fespace});
+  host_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, ThermalModel<dim>{}, *mesh);
+
+  Functional<space(space), ExecutionSpace::GPU> device_residual(&fespace, {&fespace});
+  device_residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, ThermalModel<dim>{}, *mesh);
+
+  double t = 0.0;
+
+  auto [r1, dr1] = host_residual(t, differentiate_wrt(U));
+  auto [r2, dr2] = device_residual(t, differentiate_wrt(U));
+
+  mfem::Vector diff(r1);
+  diff -= r2;
+  EXPECT_LT(diff.Normlinf(), 1.0e-12 * r1.Normlinf());
+
+  mfem::Vector dU(fespace.TrueVSize());
+  dU.Randomize();
+
+  mfem::Vector ddiff(dr1(dU));
+  ddiff -= dr2(dU);
+  EXPECT_LT(ddiff.Normlinf(), 1.0e-12 * dr1(dU).Normlinf());
+}
+
+TEST(device_kernels, thermal_quads) { device_vs_host_test<2, 2>("/data/meshes/patch2D_quads.mesh"); }
+TEST(device_kernels, thermal_hexes) { device_vs_host_test<1, 3>("/data/meshes/patch3D_hexes.mesh"); }
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  serac::accelerator::initializeDevice();
+
+  int result = RUN_ALL_TESTS();
+
+  serac::accelerator::terminateDevice();
+
+  MPI_Finalize();
+
+  return result;
+}
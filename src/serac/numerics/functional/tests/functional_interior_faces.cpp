@@ -0,0 +1,132 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+#include "serac/numerics/functional/tests/check_gradient.hpp"
+
+using namespace serac;
+
+constexpr int p = 1;
+
+using space = L2<p>;
+
+// a (nonlinear) penalty on the jump of the solution across each face
+struct jump_penalty {
+  template <typename X, typename U>
+  SERAC_HOST_DEVICE auto operator()(double, X, U u) const
+  {
+    auto jump = get<0>(u) - get<1>(u);
+    auto r    = k * jump + jump * jump * jump;
+    return serac::tuple{r, -r};
+  }
+
+  double k = 2.0;
+};
+
+std::unique_ptr<mfem::ParMesh> make_mesh(mfem::Element::Type element_type)
+{
+  constexpr int n = 4;
+
+  mfem::Mesh serial_mesh;
+  if (element_type == mfem::Element::QUADRILATERAL || element_type == mfem::Element::TRIANGLE) {
+    serial_mesh = mfem::Mesh::MakeCartesian2D(n, n, element_type, true, 1.0, 1.0);
+  } else {
+    serial_mesh = mfem::Mesh::MakeCartesian3D(n, n, n, element_type, 1.0, 1.0, 1.0);
+  }
+  serial_mesh.EnsureNodes();
+
+  auto mesh = std::make_unique<mfem::ParMesh>(MPI_COMM_WORLD, serial_mesh);
+  mesh->EnsureNodes();
+  return mesh;
+}
+
+template <int dim>
+void jump_penalty_test(mfem::ParMesh& mesh)
+{
+  auto                        fec = mfem::L2_FECollection(p, dim, mfem::BasisType::GaussLobatto);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddInteriorFaceIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, jump_penalty{}, EntireInteriorFaces(mesh));
+
+  // a constant field has no jumps
+  mfem::Vector U(fespace.TrueVSize());
+  U = 3.0;
+  EXPECT_LT(residual(0.0, U).Norml2(), 1.0e-12);
+
+  // the assembled gradient, its action, and finite differences should agree
+  U.Randomize(1);
+  check_gradient(residual, 0.0, U);
+}
+
+TEST(interior_faces, jump_penalty_quadrilaterals) { jump_penalty_test<2>(*make_mesh(mfem::Element::QUADRILATERAL)); }
+TEST(interior_faces, jump_penalty_triangles) { jump_penalty_test<2>(*make_mesh(mfem::Element::TRIANGLE)); }
+TEST(interior_faces, jump_penalty_hexahedra) { jump_penalty_test<3>(*make_mesh(mfem::Element::HEXAHEDRON)); }
+TEST(interior_faces, jump_penalty_tetrahedra) { jump_penalty_test<3>(*make_mesh(mfem::Element::TETRAHEDRON)); }
+
+// each face normal should point from side 1 into side 2: for a field equal to the x-coordinate of the
+// element centroids, (u2 - u1) * n_x is the (positive) distance between the centroids across faces normal to x
+TEST(interior_faces, normals_point_from_side_1_to_side_2)
+{
+  constexpr int n = 4;
+
+  auto                        mesh = make_mesh(mfem::Element::QUADRILATERAL);
+  auto                        fec  = mfem::L2_FECollection(p, 2, mfem::BasisType::GaussLobatto);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::ParGridFunction u(&fespace);
+  for (int e = 0; e < mesh->GetNE(); e++) {
+    mfem::Vector centroid;
+    mesh->GetElementCenter(e, centroid);
+
+    mfem::Array<int> dofs;
+    fespace.GetElementVDofs(e, dofs);
+    for (int k = 0; k < dofs.Size(); k++) {
+      u(dofs[k]) = centroid(0);
+    }
+  }
+
+  mfem::Vector U(fespace.TrueVSize());
+  u.GetTrueDofs(U);
+
+  Functional<space(space)> residual(&fespace, {&fespace});
+  residual.AddInteriorFaceIntegral(
+      Dimension<1>{}, DependsOn<0>{},
+      [](double, auto X, auto values) {
+        auto normal = normalize(cross(get<DERIVATIVE>(X)));
+        auto r      = (get<1>(values) - get<0>(values)) * normal[0];
+        return serac::tuple{r, 0.0 * r};
+      },
+      EntireInteriorFaces(*mesh));
+
+  // the L2 basis functions sum to one, so the sum of the residual is the integral of r over all the faces:
+  // (n - 1) columns of n faces normal to x, each of length 1 / n, with centroids 1 / n apart
+  double sum = residual(0.0, U).Sum();
+  EXPECT_NEAR(sum, double(n - 1) / double(n), 1.0e-12);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
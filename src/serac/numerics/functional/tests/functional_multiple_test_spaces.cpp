@@ -0,0 +1,148 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <gtest/gtest.h>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/tensor.hpp"
+
+using namespace serac;
+
+constexpr int p   = 2;
+constexpr int dim = 2;
+
+using thermal_space = H1<p>;
+using solid_space   = H1<p, dim>;
+
+// a thermoelastic material, whose outputs are shared by the thermal and mechanical residuals
+struct thermoelastic_material {
+  template <typename T, typename U>
+  SERAC_HOST_DEVICE auto operator()(T temperature, U displacement) const
+  {
+    auto [theta, dtheta_dX] = temperature;
+    auto [u, du_dX]         = displacement;
+    auto strain             = 0.5 * (du_dX + transpose(du_dX));
+    auto heat_source        = theta * tr(du_dX) + theta * theta;
+    auto heat_flux          = kappa * (1.0 + theta * theta) * dtheta_dX;
+    auto stress             = 2.0 * strain + tr(strain) * Identity<dim>() - alpha * theta * Identity<dim>();
+    return serac::tuple{heat_source, heat_flux, stress};
+  }
+
+  double kappa = 1.5;
+  double alpha = 0.3;
+};
+
+// the coupled residuals and their gradients should match those of a separate Functional for each test space
+TEST(FunctionalMultipleTestSpaces, CoupledThermoelasticity)
+{
+  constexpr int n = 4;
+
+  auto serial_mesh = mfem::Mesh::MakeCartesian2D(n, n, mfem::Element::QUADRILATERAL, true, 1.0, 1.0);
+  serial_mesh.EnsureNodes();
+  mfem::ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace thermal_fes(&mesh, &fec);
+  mfem::ParFiniteElementSpace solid_fes(&mesh, &fec, dim, mfem::Ordering::byNODES);
+
+  thermoelastic_material material{};
+
+  Functional<serac::tuple<thermal_space, solid_space>(thermal_space, solid_space)> coupled(
+      {&thermal_fes, &solid_fes}, {&thermal_fes, &solid_fes});
+  coupled.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0, 1>{},
+      [=](double /*t*/, auto /*X*/, auto temperature, auto displacement) {
+        auto [heat_source, heat_flux, stress] = material(temperature, displacement);
+        return serac::tuple{serac::tuple{heat_source, heat_flux}, serac::tuple{zero{}, stress}};
+      },
+      mesh);
+
+  Functional<thermal_space(thermal_space, solid_space)> thermal(&thermal_fes, {&thermal_fes, &solid_fes});
+  thermal.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0, 1>{},
+      [=](double /*t*/, auto /*X*/, auto temperature, auto displacement) {
+        auto [heat_source, heat_flux, stress] = material(temperature, displacement);
+        return serac::tuple{heat_source, heat_flux};
+      },
+      mesh);
+
+  Functional<solid_space(thermal_space, solid_space)> solid(&solid_fes, {&thermal_fes, &solid_fes});
+  solid.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0, 1>{},
+      [=](double /*t*/, auto /*X*/, auto temperature, auto displacement) {
+        auto [heat_source, heat_flux, stress] = material(temperature, displacement);
+        return serac::tuple{zero{}, stress};
+      },
+      mesh);
+
+  mfem::Vector T(thermal_fes.TrueVSize());
+  mfem::Vector U(solid_fes.TrueVSize());
+  T.Randomize(0);
+  U.Randomize(1);
+
+  constexpr double tol = 1.0e-12;
+
+  auto expect_near = [](const mfem::Vector& a, const mfem::Vector& b) {
+    mfem::Vector diff(a);
+    diff -= b;
+    EXPECT_LT(diff.Normlinf(), tol * (1.0 + b.Normlinf()));
+  };
+
+  // the residuals
+  mfem::BlockVector& r = coupled(0.0, T, U);
+  ASSERT_EQ(r.NumBlocks(), 2);
+  expect_near(r.GetBlock(0), thermal(0.0, T, U));
+  expect_near(r.GetBlock(1), solid(0.0, T, U));
+
+  // the assembled blocks of the gradient w.r.t. each trial space
+  auto check_gradient_blocks = [&](auto coupled_gradient, auto thermal_gradient, auto solid_gradient, int width) {
+    mfem::Vector dx(width);
+    dx.Randomize(2);
+
+    auto [J_thermal, J_solid] = assemble(get<1>(coupled_gradient));
+    auto J_thermal_expected   = assemble(get<1>(thermal_gradient));
+    auto J_solid_expected     = assemble(get<1>(solid_gradient));
+
+    mfem::Vector df_thermal(thermal_fes.TrueVSize()), df_thermal_expected(thermal_fes.TrueVSize());
+    mfem::Vector df_solid(solid_fes.TrueVSize()), df_solid_expected(solid_fes.TrueVSize());
+    J_thermal->Mult(dx, df_thermal);
+    J_thermal_expected->Mult(dx, df_thermal_expected);
+    J_solid->Mult(dx, df_solid);
+    J_solid_expected->Mult(dx, df_solid_expected);
+    expect_near(df_thermal, df_thermal_expected);
+    expect_near(df_solid, df_solid_expected);
+
+    // and the unassembled action, which maps to the blocks of each test space
+    mfem::BlockVector df(coupled.offsets());
+    get<1>(coupled_gradient).Mult(dx, df);
+    expect_near(df.GetBlock(0), df_thermal_expected);
+    expect_near(df.GetBlock(1), df_solid_expected);
+  };
+
+  check_gradient_blocks(coupled(0.0, differentiate_wrt(T), U), thermal(0.0, differentiate_wrt(T), U),
+                        solid(0.0, differentiate_wrt(T), U), thermal_fes.TrueVSize());
+  check_gradient_blocks(coupled(0.0, T, differentiate_wrt(U)), thermal(0.0, T, differentiate_wrt(U)),
+                        solid(0.0, T, differentiate_wrt(U)), solid_fes.TrueVSize());
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -43,6 +43,220 @@ struct hcurl_qfunction {
   }
 };
 
+// compare the action of the gradient from stored q-function derivatives to the one that re-evaluates the q-functions
+template <typename T>
+void check_recomputed_gradient(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  mfem::Vector dU(U.Size());
+  dU.Randomize(1);
+
+  auto [value, dfdU]    = f(t, differentiate_wrt(U));
+  mfem::Vector expected = dfdU(dU);
+
+  f.recomputeDerivatives(true);
+  auto [recomputed_value, recomputed_dfdU] = f(t, differentiate_wrt(U));
+  mfem::Vector recomputed                  = recomputed_dfdU(dU);
+  f.recomputeDerivatives(false);
+
+  mfem::Vector difference = recomputed;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+}
+
+// compare the matrix-free action of the transposed gradient (and the assembled transpose) to the assembled gradient
+template <typename T>
+void check_gradient_transpose(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  auto [value, dfdU] = f(t, differentiate_wrt(U));
+
+  mfem::Vector dR(dfdU.Height());
+  dR.Randomize(2);
+
+  mfem::Vector expected(dfdU.Width());
+  auto         dfdU_matrix = assemble(dfdU);
+  dfdU_matrix->MultTranspose(dR, expected);
+
+  // reassembling the gradient refills the same matrix
+  auto* gradient_storage = dfdU_matrix.get();
+  assemble(dfdU, dfdU_matrix);
+  EXPECT_EQ(gradient_storage, dfdU_matrix.get());
+
+  mfem::Vector matrix_free(dfdU.Width());
+  dfdU.MultTranspose(dR, matrix_free);
+
+  mfem::Vector difference = matrix_free;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+
+  // the transpose can also be assembled directly, into storage that is kept across assemblies
+  std::unique_ptr<mfem::HypreParMatrix> dfdU_transpose;
+  assembleTranspose(dfdU, dfdU_transpose);
+  auto* storage = dfdU_transpose.get();
+  assembleTranspose(dfdU, dfdU_transpose);
+  EXPECT_EQ(storage, dfdU_transpose.get());
+
+  mfem::Vector assembled_transpose(dfdU.Width());
+  dfdU_transpose->Mult(dR, assembled_transpose);
+
+  difference = assembled_transpose;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+
+  // later assemblies refill those matrices in place, and agree with new ones at another linearization point
+  mfem::Vector U_new = U;
+  U_new *= 1.5;
+  auto [value_new, dfdU_new] = f(t, differentiate_wrt(U_new));
+  assemble(dfdU_new, dfdU_matrix);
+  assembleTranspose(dfdU_new, dfdU_transpose);
+  EXPECT_EQ(gradient_storage, dfdU_matrix.get());
+  EXPECT_EQ(storage, dfdU_transpose.get());
+
+  auto         new_matrix = assemble(dfdU_new);
+  mfem::Vector dU(dfdU_new.Width());
+  dU.Randomize(3);
+  for (bool transposed : {false, true}) {
+    mfem::Vector refilled(dfdU_new.Height());
+    mfem::Vector assembled(dfdU_new.Height());
+    if (transposed) {
+      dfdU_transpose->Mult(dR, refilled);
+      new_matrix->MultTranspose(dR, assembled);
+    } else {
+      dfdU_matrix->Mult(dU, refilled);
+      new_matrix->Mult(dU, assembled);
+    }
+    refilled -= assembled;
+    EXPECT_LT(mfem::ParNormlp(refilled, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(assembled, 2, MPI_COMM_WORLD));
+  }
+}
+
+// compare the evaluations of several arguments in one pass over the mesh to separate evaluations
+template <typename T>
+void check_batched_evaluation(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  mfem::DenseMatrix Us(U.Size(), 3);
+  for (int c = 0; c < Us.Width(); c++) {
+    mfem::Vector column(Us.GetColumn(c), U.Size());
+    column.Randomize(c + 3);
+    column += U;
+  }
+
+  const mfem::DenseMatrix& values = f.EvaluateBatch(t, Us);
+
+  for (int c = 0; c < Us.Width(); c++) {
+    mfem::Vector column(Us.GetColumn(c), U.Size());
+    mfem::Vector expected = f(t, column);
+
+    mfem::Vector difference;
+    values.GetColumn(c, difference);
+    difference -= expected;
+    EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+  }
+}
+
+// compare the evaluations (and gradients) a tile of elements at a time to the ones over the whole mesh
+template <typename T>
+void check_tiled_evaluation(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  mfem::Vector dU(U.Size());
+  dU.Randomize(4);
+
+  auto [value, dfdU]             = f(t, differentiate_wrt(U));
+  mfem::Vector expected          = value;
+  mfem::Vector expected_gradient = dfdU(dU);
+
+  f.setElementTileSize(7);
+  auto [tiled_value, tiled_dfdU] = f(t, differentiate_wrt(U));
+  mfem::Vector tiled_gradient    = tiled_dfdU(dU);
+
+  mfem::Vector difference = tiled_value;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+
+  difference = tiled_gradient;
+  difference -= expected_gradient;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD),
+            1.0e-12 * mfem::ParNormlp(expected_gradient, 2, MPI_COMM_WORLD));
+
+  // the operations that still need the E-vectors of the whole mesh allocate them again
+  check_gradient_transpose(f, t, U);
+
+  // every tile size tried while tuning (and the one that is kept) gives the same values
+  std::string filename = "functional_nonlinear_tile_sizes.txt";
+  f.autotuneElementTileSize(filename);
+  for (int i = 0; i < 20; i++) {
+    difference = f(t, U);
+    difference -= expected;
+    EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+  EXPECT_FALSE(readTileSizes(filename).empty());
+
+  f.setElementTileSize(0);
+}
+
+// the serial and threaded scatter-adds sum the contributions to each dof in the same order, so they agree bitwise
+template <typename T>
+void check_scatter_methods(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  mfem::Vector dU(U.Size());
+  dU.Randomize(6);
+
+  setScatterMethod(ScatterMethod::Serial);
+  auto [serial_value, serial_dfdU] = f(t, differentiate_wrt(U));
+  mfem::Vector serial_gradient     = serial_dfdU(dU);
+
+  setScatterMethod(ScatterMethod::OwnerComputes);
+  auto [threaded_value, threaded_dfdU] = f(t, differentiate_wrt(U));
+  mfem::Vector threaded_gradient       = threaded_dfdU(dU);
+
+  for (int i = 0; i < serial_value.Size(); i++) {
+    EXPECT_EQ(serial_value(i), threaded_value(i));
+    EXPECT_EQ(serial_gradient(i), threaded_gradient(i));
+  }
+}
+
+// the binary search of each entry's row finds the same nonzero entries as the precomputed contributions
+template <typename T>
+void check_gradient_lookup(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  auto [precomputed_value, precomputed_dfdU]     = f(t, differentiate_wrt(U));
+  std::unique_ptr<mfem::HypreParMatrix> expected = assemble(precomputed_dfdU);
+
+  f.setGradientLookup(GradientLookup::BinarySearch);
+  auto [value, dfdU]                      = f(t, differentiate_wrt(U));
+  std::unique_ptr<mfem::HypreParMatrix> K = assemble(dfdU);
+  f.setGradientLookup(GradientLookup::Precomputed);
+
+  std::unique_ptr<mfem::HypreParMatrix> difference(mfem::Add(1.0, *K, -1.0, *expected));
+  EXPECT_LT(difference->FNorm(), 1.0e-12 * expected->FNorm());
+}
+
+template <typename T>
+void check_concurrent_integrals(Functional<T>& f, double t, const mfem::Vector& U)
+{
+  mfem::Vector dU(U.Size());
+  dU.Randomize(5);
+
+  auto [value, dfdU]             = f(t, differentiate_wrt(U));
+  mfem::Vector expected          = value;
+  mfem::Vector expected_gradient = dfdU(dU);
+
+  // the domain and boundary integrals add into different E-vectors, so they can run at the same time
+  f.concurrentIntegrals(true);
+  auto [concurrent_value, concurrent_dfdU] = f(t, differentiate_wrt(U));
+  mfem::Vector concurrent_gradient         = concurrent_dfdU(dU);
+  f.concurrentIntegrals(false);
+
+  mfem::Vector difference = concurrent_value;
+  difference -= expected;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD), 1.0e-12 * mfem::ParNormlp(expected, 2, MPI_COMM_WORLD));
+
+  difference = concurrent_gradient;
+  difference -= expected_gradient;
+  EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD),
+            1.0e-12 * mfem::ParNormlp(expected_gradient, 2, MPI_COMM_WORLD));
+}
+
 // this test sets up a toy "thermal" problem where the residual includes contributions
 // from a temperature-dependent source term and a temperature-gradient-dependent flux
 //
@@ -92,6 +306,13 @@ void functional_test(mfem::ParMesh& mesh, H1<p> test, H1<p> trial, Dimension<dim
 
   double t = 0.0;
   check_gradient(residual, t, U);
+  check_recomputed_gradient(residual, t, U);
+  check_gradient_transpose(residual, t, U);
+  check_batched_evaluation(residual, t, U);
+  check_tiled_evaluation(residual, t, U);
+  check_concurrent_integrals(residual, t, U);
+  check_scatter_methods(residual, t, U);
+  check_gradient_lookup(residual, t, U);
 
   serac::profiling::finalize();
 }
@@ -141,6 +362,13 @@ void functional_test(mfem::ParMesh& mesh, H1<p, dim> test, H1<p, dim> trial, Dim
 
   double t = 0.0;
   check_gradient(residual, t, U);
+  check_recomputed_gradient(residual, t, U);
+  check_gradient_transpose(residual, t, U);
+  check_batched_evaluation(residual, t, U);
+  check_tiled_evaluation(residual, t, U);
+  check_concurrent_integrals(residual, t, U);
+  check_scatter_methods(residual, t, U);
+  check_gradient_lookup(residual, t, U);
 
   serac::profiling::finalize();
 }
@@ -161,6 +389,76 @@ TEST(Elasticity, 3DLinear) { functional_test(*mesh3D, H1<1, 3>{}, H1<1, 3>{}, Di
 TEST(Elasticity, 3DQuadratic) { functional_test(*mesh3D, H1<2, 3>{}, H1<2, 3>{}, Dimension<3>{}); }
 TEST(Elasticity, 3DCubic) { functional_test(*mesh3D, H1<3, 3>{}, H1<3, 3>{}, Dimension<3>{}); }
 
+// a separable load f(x) g(t) is only integrated once, so its residuals are compared to those of the same load
+// written as an ordinary integrand, at a few different times
+TEST(SeparableLoads, MatchTheirIntegrands)
+{
+  constexpr int dim = 2;
+  using space       = H1<2>;
+
+  auto                        fec = mfem::H1_FECollection(2, dim);
+  mfem::ParFiniteElementSpace fespace(mesh2D.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U.Randomize();
+
+  Domain domain   = EntireDomain(*mesh2D);
+  Domain boundary = EntireBoundary(*mesh2D);
+
+  auto g = [](double t) { return t * t - 1.0; };
+
+  auto nonlinear = [](double /*t*/, auto /*x*/, auto temperature) {
+    auto [u, du_dX] = temperature;
+    return serac::tuple{a * u * u, b * du_dX};
+  };
+
+  Functional<space(space)> separable(&fespace, {&fespace});
+  separable.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, nonlinear, domain);
+  separable.AddSeparableDomainIntegral(
+      Dimension<dim>{}, DependsOn<>{},
+      [](double /*t*/, auto position) {
+        auto X = get<VALUE>(position);
+        return serac::tuple{X[0] * X[1], zero{}};
+      },
+      g, domain);
+  separable.AddSeparableBoundaryIntegral(
+      Dimension<dim - 1>{}, DependsOn<>{}, [](double /*t*/, auto position) { return get<VALUE>(position)[0]; }, g,
+      boundary);
+
+  Functional<space(space)> expected(&fespace, {&fespace});
+  expected.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, nonlinear, domain);
+  expected.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<>{},
+      [g](double t, auto position) {
+        auto X = get<VALUE>(position);
+        return serac::tuple{g(t) * X[0] * X[1], zero{}};
+      },
+      domain);
+  expected.AddBoundaryIntegral(
+      Dimension<dim - 1>{}, DependsOn<>{}, [g](double t, auto position) { return g(t) * get<VALUE>(position)[0]; },
+      boundary);
+
+  mfem::Vector dU(U.Size());
+  dU.Randomize(1);
+
+  for (double t : {0.0, 0.5, 2.0}) {
+    auto [value, dfdU]                   = separable(t, differentiate_wrt(U));
+    auto [expected_value, expected_dfdU] = expected(t, differentiate_wrt(U));
+
+    mfem::Vector difference = value;
+    difference -= expected_value;
+    EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD),
+              1.0e-12 * mfem::ParNormlp(expected_value, 2, MPI_COMM_WORLD));
+
+    mfem::Vector gradient          = dfdU(dU);
+    mfem::Vector expected_gradient = expected_dfdU(dU);
+    difference                     = gradient;
+    difference -= expected_gradient;
+    EXPECT_LT(mfem::ParNormlp(difference, 2, MPI_COMM_WORLD),
+              1.0e-12 * mfem::ParNormlp(expected_gradient, 2, MPI_COMM_WORLD));
+  }
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -14,6 +14,7 @@
 #include "serac/serac_config.hpp"
 #include "serac/mesh/mesh_utils_base.hpp"
 #include "serac/numerics/functional/functional.hpp"
+#include "serac/numerics/functional/qoi_group.hpp"
 #include "serac/numerics/functional/shape_aware_functional.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/infrastructure/profiling.hpp"
@@ -433,6 +434,144 @@ TEST(QoI, AddVolumeIntegral)
   delete tmp;
 }
 
+TEST(QoI, WedgeVolumeIntegral)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  mfem::Mesh    serial_mesh = mfem::Mesh::MakeCartesian3D(2, 3, 4, mfem::Element::WEDGE, 1.0, 2.0, 3.0);
+  mfem::ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  mfem::HypreParVector* tmp = fespace.NewTrueDofVector();
+  mfem::HypreParVector  U   = *tmp;
+  U                         = 0.0;
+
+  using trial_space = H1<p>;
+
+  Functional<double(trial_space)> measure({&fespace});
+  measure.AddVolumeIntegral(DependsOn<>{}, TrivialIntegrator{}, mesh);
+  EXPECT_NEAR(measure(t, U), 6.0, 1.0e-12);
+
+  // the x-moment of the box is exact with the linear wedge geometry
+  Functional<double(trial_space)> x_moment({&fespace});
+  x_moment.AddVolumeIntegral(DependsOn<>{}, ZeroIndexIntegrator{}, mesh);
+  EXPECT_NEAR(x_moment(t, U), 3.0, 1.0e-12);
+
+  delete tmp;
+}
+
+TEST(QoI, PerIntegralQuadratureOrder)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  mfem::Mesh    serial_mesh = mfem::Mesh::MakeCartesian3D(2, 2, 2, mfem::Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+  mfem::ParMesh mesh(MPI_COMM_WORLD, serial_mesh);
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  mfem::HypreParVector* tmp = fespace.NewTrueDofVector();
+  mfem::HypreParVector  U   = *tmp;
+  U                         = 0.0;
+
+  using trial_space = H1<p>;
+
+  auto x_squared = [](double /*t*/, auto position) {
+    auto x = get<VALUE>(position);
+    return x[0] * x[0];
+  };
+
+  // one point per element is the midpoint rule: (0.25^2 + 0.75^2) / 2
+  Functional<double(trial_space)> midpoint({&fespace});
+  midpoint.AddDomainIntegral(Dimension<dim>{}, DependsOn<>{}, QuadratureOrder<1>{}, x_squared, mesh);
+  EXPECT_NEAR(midpoint(t, U), 0.3125, 1.0e-12);
+
+  // integrals with different quadrature orders can be combined in the same Functional
+  Functional<double(trial_space)> combined({&fespace});
+  combined.AddDomainIntegral(Dimension<dim>{}, DependsOn<>{}, QuadratureOrder<1>{}, TrivialIntegrator{}, mesh);
+  combined.AddDomainIntegral(Dimension<dim>{}, DependsOn<>{}, QuadratureOrder<3>{}, x_squared, mesh);
+  EXPECT_NEAR(combined(t, U), 1.0 + 1.0 / 3.0, 1.0e-12);
+
+  delete tmp;
+}
+
+TEST(QoI, Group)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 3;
+
+  mfem::ParMesh& mesh = *mesh3D;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace(&mesh, &fec);
+
+  mfem::ParGridFunction     U_gf(&fespace);
+  mfem::FunctionCoefficient x_squared([](mfem::Vector x) { return x[0] * x[0]; });
+  U_gf.ProjectCoefficient(x_squared);
+
+  mfem::HypreParVector* tmp = fespace.NewTrueDofVector();
+  mfem::HypreParVector  U   = *tmp;
+  U_gf.GetTrueDofs(U);
+
+  using trial_space = H1<p>;
+
+  // the same quantities, evaluated separately
+  Functional<double(trial_space)> measure({&fespace});
+  measure.AddDomainIntegral(Dimension<dim>{}, DependsOn<>{}, TrivialIntegrator{}, mesh);
+
+  Functional<double(trial_space)> nonlinear({&fespace});
+  nonlinear.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, SineIntegrator{}, mesh);
+  nonlinear.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, CosineIntegrator{}, mesh);
+
+  Functional<double(trial_space)> boundary({&fespace});
+  boundary.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, CosineIntegrator{}, mesh);
+
+  // and together, with the integrals added in an interleaved order
+  QoIGroup<double(trial_space)> qois({&fespace}, 3);
+  qois.AddBoundaryIntegral(1, Dimension<dim - 1>{}, DependsOn<0>{}, CosineIntegrator{}, mesh);
+  qois.AddDomainIntegral(0, Dimension<dim>{}, DependsOn<>{}, TrivialIntegrator{}, mesh);
+  qois.AddBoundaryIntegral(2, Dimension<dim - 1>{}, DependsOn<0>{}, CosineIntegrator{}, mesh);
+  qois.AddDomainIntegral(1, Dimension<dim>{}, DependsOn<0>{}, SineIntegrator{}, mesh);
+
+  double expected[] = {measure(t, U), nonlinear(t, U), boundary(t, U)};
+
+  mfem::Vector values = qois(t, U);
+  ASSERT_EQ(values.Size(), 3);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(values[i], expected[i], 1.0e-12 * std::abs(expected[i]));
+  }
+
+  auto [values_too, dqois_dU] = qois(t, differentiate_wrt(U));
+  auto gradients              = assemble(dqois_dU);
+  ASSERT_EQ(gradients.size(), 3u);
+
+  auto [unused0, dmeasure_dU]   = measure(t, differentiate_wrt(U));
+  auto [unused1, dnonlinear_dU] = nonlinear(t, differentiate_wrt(U));
+  auto [unused2, dboundary_dU]  = boundary(t, differentiate_wrt(U));
+
+  std::unique_ptr<mfem::HypreParVector> expected_gradients[] = {assemble(dmeasure_dU), assemble(dnonlinear_dU),
+                                                               assemble(dboundary_dU)};
+
+  mfem::Vector dU(U.Size());
+  dU.Randomize(1);
+
+  mfem::Vector directional_derivatives = dqois_dU(dU);
+  for (int i = 0; i < 3; i++) {
+    mfem::Vector difference(*gradients[uint32_t(i)]);
+    difference -= *expected_gradients[i];
+    EXPECT_NEAR(difference.Norml2(), 0.0, 1.0e-12 * (1.0 + expected_gradients[i]->Norml2()));
+
+    double expected_derivative = mfem::InnerProduct(MPI_COMM_WORLD, *expected_gradients[i], dU);
+    EXPECT_NEAR(directional_derivatives[i], expected_derivative, 1.0e-10 * (1.0 + std::abs(expected_derivative)));
+  }
+
+  delete tmp;
+}
+
 TEST(QoI, UsingL2)
 {
   constexpr int p   = 1;
@@ -525,6 +664,13 @@ TEST(QoI, ShapeAndParameter)
 
   constexpr double expected_avg = 0.1;
   EXPECT_NEAR(average, expected_avg, 1.0e-14);
+
+  // the jacobian determinant of a trilinear element is integrated exactly by 2 points per dimension,
+  // so the reduced rule gives the same volume as the default of 3
+  qoi_type serac_reduced_volume(shape_fes, trial_fes);
+  serac_reduced_volume.AddDomainIntegral(serac::Dimension<dim>{}, serac::DependsOn<>{}, QuadratureOrder<2>{},
+                                         TrivialIntegrator{}, whole_mesh);
+  EXPECT_NEAR(serac_reduced_volume(t, *shape_displacement, *parameter), expected_vol, 3.0e-14);
 }
 
 TEST(QoI, ShapeAndParameterBoundary)
@@ -349,6 +349,67 @@ void functional_test_3D(mfem::ParMesh& mesh, double tolerance)
   EXPECT_NEAR(mfem::InnerProduct(ones, dr), 0.0, tolerance);
 }
 
+// with a zero shape displacement, the shape-aware residual and its gradient should match those of a plain Functional
+TEST(ShapeDerivative, ZeroShapeDisplacementFastPath)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec1 = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace1(mesh2D.get(), &fec1);
+
+  auto                        fec2 = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fespace2(mesh2D.get(), &fec2, dim);
+
+  auto diffusion = [](double, auto, auto temperature) {
+    auto [u, du_dx] = temperature;
+    return serac::tuple{u * u, (1.0 + u * u) * du_dx};
+  };
+
+  auto flux = [](double, auto, auto temperature) { return get<VALUE>(temperature); };
+
+  using shape_space = H1<p, dim>;
+
+  ShapeAwareFunctional<shape_space, H1<p>(H1<p>)> shape_aware(&fespace2, &fespace1, {&fespace1});
+  shape_aware.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, diffusion, *mesh2D);
+  shape_aware.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, flux, *mesh2D);
+
+  Functional<H1<p>(H1<p>)> plain(&fespace1, {&fespace1});
+  plain.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, diffusion, *mesh2D);
+  plain.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0>{}, flux, *mesh2D);
+
+  mfem::Vector U(fespace1.TrueVSize());
+  U.Randomize(3);
+
+  mfem::Vector dU(fespace1.TrueVSize());
+  dU.Randomize(4);
+
+  mfem::Vector shape_displacement(fespace2.TrueVSize());
+  shape_displacement = 0.0;
+
+  double t = 0.0;
+
+  auto [r, drdU]   = shape_aware(t, shape_displacement, differentiate_wrt(U));
+  auto [r0, dr0dU] = plain(t, differentiate_wrt(U));
+  EXPECT_TRUE(shape_aware.shapeDisplacementIsZero());
+
+  mfem::Vector difference = r;
+  difference -= r0;
+  EXPECT_LT(difference.Norml2(), 1.0e-12 * r0.Norml2());
+
+  difference = drdU(dU);
+  difference -= dr0dU(dU);
+  EXPECT_LT(difference.Norml2(), 1.0e-12 * dr0dU(dU).Norml2());
+
+  // the shape-aware path is taken again as soon as the shape displacement is nonzero
+  shape_displacement.Randomize(5);
+  shape_displacement *= 0.01;
+  difference = shape_aware(t, shape_displacement, U);
+  EXPECT_FALSE(shape_aware.shapeDisplacementIsZero());
+  difference -= r0;
+  EXPECT_GT(difference.Norml2(), 1.0e-8 * r0.Norml2());
+}
+
 TEST(ShapeDerivative, 2DLinear) { functional_test_2D<1>(*mesh2D, 3.0e-14); }
 TEST(ShapeDerivative, 2DQuadratic) { functional_test_2D<2>(*mesh2D, 3.0e-14); }
 
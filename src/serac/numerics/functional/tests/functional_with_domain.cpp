@@ -256,6 +256,45 @@ TEST(basic, partial_mesh_comparison_quads) { partial_mesh_comparison_test<1, 1>(
 TEST(basic, partial_mesh_comparison_tets) { partial_mesh_comparison_test<1, 1>("/data/meshes/beam-tet.mesh"); }
 TEST(basic, partial_mesh_comparison_hexes) { partial_mesh_comparison_test<1, 1>("/data/meshes/beam-hex.mesh"); }
 
+TEST(basic, element_costs)
+{
+  constexpr auto dim  = 3;
+  auto           mesh = mesh::refineAndDistribute(buildMeshFromFile(SERAC_REPO_DIR "/data/meshes/beam-hex.mesh"), 1);
+
+  auto                        fec = mfem::H1_FECollection(1, dim);
+  mfem::ParFiniteElementSpace fespace(mesh.get(), &fec);
+
+  mfem::Vector U(fespace.TrueVSize());
+  U = 1.0;
+
+  auto   on_left = [](std::vector<tensor<double, dim>> X, int /* attr */) { return average(X)[0] < 4.0; };
+  Domain left    = Domain::ofElements(*mesh, on_left);
+
+  Functional<H1<1>(H1<1>)> residual(&fespace, {&fespace});
+  residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, TestThermalIntegratorOne<dim>{}, left);
+
+  residual.recordElementCosts(true);
+  residual(0.0, U);
+  residual(DifferentiateWRT<0>{}, 0.0, U);
+
+  // only the elements that are integrated over have a cost
+  mfem::Vector costs = residual.elementCosts();
+  ASSERT_EQ(costs.Size(), mesh->GetNE());
+  for (int e = 0; e < mesh->GetNE(); e++) {
+    mfem::Vector center;
+    mesh->GetElementCenter(e, center);
+    if (center[0] < 4.0) {
+      EXPECT_GT(costs[e], 0.0);
+    } else {
+      EXPECT_EQ(costs[e], 0.0);
+    }
+  }
+
+  residual.recordElementCosts(false);
+  residual(0.0, U);
+  EXPECT_EQ(residual.elementCosts().Norml1(), 0.0);
+}
+
 TEST(qoi, partial_boundary)
 {
   constexpr auto dim  = 3;
@@ -46,7 +46,11 @@ TEST(geometric_factors, with_2D_domains)
     int              components_per_J = 4;
     int              qpts_per_elem    = (q * (q + 1)) / 2;
     int              num_elems        = 1;
-    EXPECT_EQ(gf.J.Size(), components_per_J * qpts_per_elem * num_elems);
+    EXPECT_EQ(gf.X.Size(), 2 * qpts_per_elem * num_elems);
+
+    // linear simplices are affine, so their jacobians are only stored once per element
+    EXPECT_TRUE(gf.affine);
+    EXPECT_EQ(gf.J.Size(), components_per_J * num_elems);
   }
 
   std::cout << std::endl;
@@ -56,7 +60,7 @@ TEST(geometric_factors, with_2D_domains)
     int              components_per_J = 4;
     int              qpts_per_elem    = q * q;
     int              num_elems        = 1;
-    EXPECT_EQ(gf.J.Size(), components_per_J * qpts_per_elem * num_elems);
+    EXPECT_EQ(gf.J.Size(), components_per_J * (gf.affine ? 1 : qpts_per_elem) * num_elems);
   }
 }
 
@@ -76,7 +80,11 @@ TEST(geometric_factors, with_3D_domains)
     int              components_per_J = 9;
     int              qpts_per_elem    = (q * (q + 1) * (q + 2)) / 6;
     int              num_elems        = 6;
-    EXPECT_EQ(gf.J.Size(), components_per_J * qpts_per_elem * num_elems);
+    EXPECT_EQ(gf.X.Size(), 3 * qpts_per_elem * num_elems);
+
+    // linear simplices are affine, so their jacobians are only stored once per element
+    EXPECT_TRUE(gf.affine);
+    EXPECT_EQ(gf.J.Size(), components_per_J * num_elems);
   }
 
   {
@@ -84,7 +92,57 @@ TEST(geometric_factors, with_3D_domains)
     int              components_per_J = 9;
     int              qpts_per_elem    = q * q * q;
     int              num_elems        = 1;
-    EXPECT_EQ(gf.J.Size(), components_per_J * qpts_per_elem * num_elems);
+    EXPECT_EQ(gf.J.Size(), components_per_J * (gf.affine ? 1 : qpts_per_elem) * num_elems);
+  }
+}
+
+TEST(geometric_factors, min_element_size)
+{
+  int q = 2;
+
+  {
+    // 0.5 x 0.5 squares
+    auto mesh = mfem::Mesh::MakeCartesian2D(4, 2, mfem::Element::QUADRILATERAL, true, 2.0, 1.0);
+    mesh.EnsureNodes();
+
+    GeometricFactors gf(EntireDomain(mesh), q, mfem::Geometry::SQUARE);
+    EXPECT_NEAR(gf.minElementSize(mfem::Geometry::SQUARE), 0.5, 1.0e-12);
+  }
+
+  {
+    // 0.5 x 0.5 x 0.25 boxes
+    auto mesh = mfem::Mesh::MakeCartesian3D(2, 2, 4, mfem::Element::HEXAHEDRON, 1.0, 1.0, 1.0);
+    mesh.EnsureNodes();
+
+    GeometricFactors gf(EntireDomain(mesh), q, mfem::Geometry::CUBE);
+    EXPECT_NEAR(gf.minElementSize(mfem::Geometry::CUBE), 0.25, 1.0e-12);
+  }
+}
+
+TEST(geometric_factors, update_after_moving_nodes)
+{
+  int q = 2;
+
+  auto mesh = mfem::Mesh::MakeCartesian2D(4, 2, mfem::Element::QUADRILATERAL, true, 2.0, 1.0);
+  mesh.EnsureNodes();
+
+  GeometricFactors gf(EntireDomain(mesh), q, mfem::Geometry::SQUARE);
+  EXPECT_TRUE(gf.affine);
+  EXPECT_EQ(gf.update(*mesh.GetNodes()), 0);
+
+  // the first component of the first node only belongs to the corner element,
+  // which is no longer a parallelogram afterwards
+  (*mesh.GetNodes())(0) -= 0.1;
+  EXPECT_EQ(gf.update(*mesh.GetNodes()), 1);
+  EXPECT_FALSE(gf.affine);
+
+  GeometricFactors expected(EntireDomain(mesh), q, mfem::Geometry::SQUARE);
+  ASSERT_EQ(gf.J.Size(), expected.J.Size());
+  for (int i = 0; i < gf.X.Size(); i++) {
+    EXPECT_NEAR(gf.X(i), expected.X(i), 1.0e-14);
+  }
+  for (int i = 0; i < gf.J.Size(); i++) {
+    EXPECT_NEAR(gf.J(i), expected.J(i), 1.0e-14);
   }
 }
 
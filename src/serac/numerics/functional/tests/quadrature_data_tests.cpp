@@ -0,0 +1,195 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <gtest/gtest.h>
+
+#include "serac/numerics/functional/tensor.hpp"
+#include "serac/numerics/functional/quadrature_data.hpp"
+
+using namespace serac;
+
+struct PlasticState {
+  tensor<double, 3, 3> Fpinv = DenseIdentity<3>();
+  double               eqps;
+};
+
+struct SplitPlasticState {
+  tensor<double, 3, 3> Fpinv = DenseIdentity<3>();
+  double               eqps;
+
+  static constexpr auto quadrature_data_fields()
+  {
+    return std::tuple{&SplitPlasticState::Fpinv, &SplitPlasticState::eqps};
+  }
+};
+
+struct WarmStartedPlasticState {
+  tensor<double, 3, 3> Fpinv = DenseIdentity<3>();
+  double               eqps;
+  double               guess;
+
+  static constexpr auto quadrature_scratch_fields() { return std::tuple{&WarmStartedPlasticState::guess}; }
+};
+
+struct SplitWarmStartedPlasticState {
+  tensor<double, 3, 3> Fpinv = DenseIdentity<3>();
+  double               eqps;
+  double               guess;
+
+  static constexpr auto quadrature_data_fields()
+  {
+    return std::tuple{&SplitWarmStartedPlasticState::Fpinv, &SplitWarmStartedPlasticState::eqps,
+                      &SplitWarmStartedPlasticState::guess};
+  }
+
+  static constexpr auto quadrature_scratch_fields() { return std::tuple{&SplitWarmStartedPlasticState::guess}; }
+};
+
+static_assert(!is_structure_of_arrays_v<PlasticState>);
+static_assert(is_structure_of_arrays_v<SplitPlasticState>);
+
+template <typename T>
+void check_load_and_store()
+{
+  typename QuadratureData<T>::geom_array_t elements{};
+  typename QuadratureData<T>::geom_array_t qpts_per_element{};
+  elements[mfem::Geometry::SQUARE]         = 3;
+  qpts_per_element[mfem::Geometry::SQUARE] = 4;
+
+  T initial_state{};
+  initial_state.eqps = 0.5;
+
+  QuadratureData<T> qdata(elements, qpts_per_element, initial_state);
+
+  auto view = qdata[mfem::Geometry::SQUARE];
+  for (uint32_t e = 0; e < 3; e++) {
+    for (uint32_t q = 0; q < 4; q++) {
+      T state = view.load(e, q);
+      EXPECT_EQ(state.eqps, 0.5);
+      EXPECT_EQ(norm(state.Fpinv - DenseIdentity<3>()), 0.0);
+
+      state.eqps        = e * 4 + q;
+      state.Fpinv[1][2] = e;
+      view.store(e, q, state);
+    }
+  }
+
+  // a new view refers to the same values
+  auto other_view = qdata[mfem::Geometry::SQUARE];
+  for (uint32_t e = 0; e < 3; e++) {
+    for (uint32_t q = 0; q < 4; q++) {
+      T state = other_view.load(e, q);
+      EXPECT_EQ(state.eqps, e * 4 + q);
+      EXPECT_EQ(state.Fpinv[1][2], e);
+      EXPECT_EQ(state.Fpinv[0][0], 1.0);
+    }
+  }
+}
+
+TEST(QuadratureData, ArrayOfStructsLoadAndStore) { check_load_and_store<PlasticState>(); }
+
+TEST(QuadratureData, StructureOfArraysLoadAndStore) { check_load_and_store<SplitPlasticState>(); }
+
+template <typename T>
+void check_stage_and_commit()
+{
+  typename QuadratureData<T>::geom_array_t elements{};
+  typename QuadratureData<T>::geom_array_t qpts_per_element{};
+  elements[mfem::Geometry::SQUARE]         = 2;
+  qpts_per_element[mfem::Geometry::SQUARE] = 4;
+
+  QuadratureData<T> qdata(elements, qpts_per_element);
+
+  // nothing is committed before any values are staged
+  EXPECT_FALSE(qdata.commitTrialStates());
+
+  for (double trial : {1.0, 2.0}) {
+    qdata.stageTrialStates(true);
+    auto view = qdata[mfem::Geometry::SQUARE];
+    for (uint32_t e = 0; e < 2; e++) {
+      for (uint32_t q = 0; q < 4; q++) {
+        T state    = view.load(e, q);
+        state.eqps = trial;
+        view.stage(e, q, state);
+      }
+    }
+    qdata.stageTrialStates(false);
+
+    // the staged values aren't visible until they are committed
+    EXPECT_EQ(qdata[mfem::Geometry::SQUARE].load(1, 3).eqps, 0.0);
+  }
+
+  // and staging is a no-op while it's disabled
+  qdata[mfem::Geometry::SQUARE].stage(0, 0, T{});
+
+  EXPECT_TRUE(qdata.commitTrialStates());
+  auto view = qdata[mfem::Geometry::SQUARE];
+  for (uint32_t e = 0; e < 2; e++) {
+    for (uint32_t q = 0; q < 4; q++) {
+      EXPECT_EQ(view.load(e, q).eqps, 2.0);
+    }
+  }
+}
+
+TEST(QuadratureData, ArrayOfStructsStageAndCommit) { check_stage_and_commit<PlasticState>(); }
+
+TEST(QuadratureData, StructureOfArraysStageAndCommit) { check_stage_and_commit<SplitPlasticState>(); }
+
+template <typename T>
+void check_scratch()
+{
+  typename QuadratureData<T>::geom_array_t elements{};
+  typename QuadratureData<T>::geom_array_t qpts_per_element{};
+  elements[mfem::Geometry::SQUARE]         = 2;
+  qpts_per_element[mfem::Geometry::SQUARE] = 4;
+
+  QuadratureData<T> qdata(elements, qpts_per_element);
+
+  // the scratch members are written back by evaluations that neither store nor stage, unlike the rest of the state
+  auto view = qdata[mfem::Geometry::SQUARE];
+  T    state{};
+  state.eqps  = 1.0;
+  state.guess = 2.0;
+  view.stage(1, 3, state);
+  EXPECT_EQ(view.load(1, 3).eqps, 0.0);
+  EXPECT_EQ(view.load(1, 3).guess, 2.0);
+  EXPECT_EQ(view.load(1, 2).guess, 0.0);
+
+  // and by staged evaluations, whose scratch members are current whether or not they are committed
+  qdata.stageTrialStates(true);
+  state.guess = 3.0;
+  qdata[mfem::Geometry::SQUARE].stage(1, 3, state);
+  qdata.stageTrialStates(false);
+  EXPECT_EQ(qdata[mfem::Geometry::SQUARE].load(1, 3).eqps, 0.0);
+  EXPECT_EQ(qdata[mfem::Geometry::SQUARE].load(1, 3).guess, 3.0);
+
+  EXPECT_TRUE(qdata.commitTrialStates());
+  EXPECT_EQ(qdata[mfem::Geometry::SQUARE].load(1, 3).eqps, 1.0);
+  EXPECT_EQ(qdata[mfem::Geometry::SQUARE].load(1, 3).guess, 3.0);
+}
+
+TEST(QuadratureData, ArrayOfStructsScratch) { check_scratch<WarmStartedPlasticState>(); }
+
+TEST(QuadratureData, StructureOfArraysScratch) { check_scratch<SplitWarmStartedPlasticState>(); }
+
+TEST(QuadratureData, StructureOfArraysStoresMembersContiguously)
+{
+  QuadratureData<SplitPlasticState>::geom_array_t elements{};
+  QuadratureData<SplitPlasticState>::geom_array_t qpts_per_element{};
+  elements[mfem::Geometry::CUBE]         = 2;
+  qpts_per_element[mfem::Geometry::CUBE] = 8;
+
+  QuadratureData<SplitPlasticState> qdata(elements, qpts_per_element);
+
+  auto& eqps = std::get<1>(qdata.data[mfem::Geometry::CUBE]);
+  EXPECT_EQ(eqps.size(), 16);
+  for (int i = 0; i < 16; i++) {
+    eqps.data()[i] = i;
+  }
+
+  auto view = qdata[mfem::Geometry::CUBE];
+  EXPECT_EQ(view.load(1, 3).eqps, 11.0);
+}
@@ -278,6 +278,54 @@ TEST(Tensor, Inverse4x4)
   EXPECT_LT(squared_norm(dot(A, invA) - Identity<4>()), tolerance);
 }
 
+// compare each contract<i1, i2> against the sum written out explicitly, for the (p+1) x q shapes of sum factorization
+TEST(Tensor, ContractMatchesExplicitSums)
+{
+  tensor<double, 2, 3>    A2{};
+  tensor<double, 2, 3, 4> A3{};
+  tensor<double, 3, 4>    B{};
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      A2(i, j) = 1.0 + i - 0.5 * j;
+      for (int k = 0; k < 4; k++) {
+        A3(i, j, k) = 0.25 * i * k - j + 2.0;
+      }
+    }
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 4; j++) {
+      B(i, j) = 0.5 * i + j * j - 1.0;
+    }
+  }
+  auto Bt = transpose(B);
+
+  auto C2 = contract<1, 0>(A2, B);
+  auto C3 = contract<1, 0>(A3, B);
+  auto D3 = contract<2, 1>(A3, B);
+  auto E2 = contract<1, 1>(A2, Bt);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 4; j++) {
+      double c2 = 0.0;
+      for (int l = 0; l < 3; l++) c2 += A2(i, l) * B(l, j);
+      EXPECT_DOUBLE_EQ(C2(i, j), c2);
+      EXPECT_DOUBLE_EQ(E2(i, j), c2);
+
+      for (int k = 0; k < 4; k++) {
+        double c3 = 0.0;
+        for (int l = 0; l < 3; l++) c3 += A3(i, l, k) * B(l, j);
+        EXPECT_DOUBLE_EQ(C3(i, j, k), c3);
+      }
+    }
+    for (int j = 0; j < 3; j++) {
+      for (int k = 0; k < 3; k++) {
+        double d3 = 0.0;
+        for (int l = 0; l < 4; l++) d3 += A3(i, j, l) * B(k, l);
+        EXPECT_DOUBLE_EQ(D3(i, j, k), d3);
+      }
+    }
+  }
+}
+
 TEST(Tensor, DerivativeOfInverse)
 {
   const tensor<double, 4, 4> A{{{2, 1, -1, 1}, {-3, -1, 2, 8}, {-2, 4, 2, 6}, {1, 1, 7, 2}}};
@@ -556,6 +604,27 @@ TEST(Tensor, LogDerivative)
   EXPECT_LT(norm(dlogA[0] - dlogA[2]), 1.0e-14);
 }
 
+TEST(Tensor, LogDerivativeWith2NearlyDegenerateEigenvalues)
+{
+  // the eigenvalue secant function must not lose accuracy when lam1 is close to lam2
+  const tensor               lambda{{2.2, 2.2 * (1.0 + 1.0e-9), 1.1}};
+  const tensor<double, 3, 3> Q{{{-0.928152308749236, -0.091036503308254, -0.360895617636},
+                                {0.238177386319198, 0.599832274220295, -0.763853896664712},
+                                {0.28601542687348, -0.794929932679048, -0.535052873762272}}};
+  auto                       A = dot(Q, dot(diag(lambda), transpose(Q)));
+
+  const tensor<double, 3, 3> dA{{{0.2, -0.4, -1.6}, {-0.4, 0.1, -1.7}, {-1.6, -1.7, 2.0}}};
+
+  tensor<dual<double>, 3, 3> Adual = make_tensor<3, 3>([&](int i, int j) { return dual<double>{A[i][j], dA[i][j]}; });
+
+  const double epsilon = 1.0e-5;
+
+  tensor<double, 3, 3> dlogA[2] = {(log_symm(A + epsilon * dA) - log_symm(A - epsilon * dA)) / (2 * epsilon),
+                                   get_gradient(log_symm(Adual))};
+
+  EXPECT_LT(norm(dlogA[0] - dlogA[1]), 1.0e-8);
+}
+
 TEST(Tensor, ExponentialTraceIdentity)
 {
   const tensor               lambda{{1.1, 2.6, 2.2}};
@@ -0,0 +1,70 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/functional/tile_size_tuner.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+TileSizeTuner::TileSizeTuner(std::string key, uint32_t num_elements) : key_(std::move(key))
+{
+  // tiles of more elements than the kernel has are all the same, so the candidates stop at a single tile
+  for (uint32_t tile_size : {16u, 64u, 256u, 1024u, 4096u}) {
+    candidates_.push_back(std::min(tile_size, std::max(num_elements, 1u)));
+    if (tile_size >= num_elements) break;
+  }
+  times_.resize(candidates_.size(), std::numeric_limits<double>::max());
+}
+
+void TileSizeTuner::record(double seconds)
+{
+  if (tuned()) return;
+
+  times_[next_] = std::min(times_[next_], seconds);
+  if (++evaluations_ < trials) return;
+
+  evaluations_ = 0;
+  if (++next_ == candidates_.size()) {
+    best_ = candidates_[std::size_t(std::min_element(times_.begin(), times_.end()) - times_.begin())];
+  }
+}
+
+void TileSizeTuner::settle(uint32_t tile_size)
+{
+  SLIC_ERROR_IF(tile_size == 0, "tile sizes must be positive");
+  best_ = tile_size;
+  next_ = candidates_.size();
+}
+
+std::map<std::string, uint32_t> readTileSizes(const std::string& filename)
+{
+  std::map<std::string, uint32_t> tile_sizes;
+
+  std::ifstream file(filename);
+  std::string   line;
+  while (std::getline(file, line)) {
+    auto separator = line.rfind('\t');
+    if (separator == std::string::npos) continue;
+    tile_sizes[line.substr(0, separator)] = uint32_t(std::stoul(line.substr(separator + 1)));
+  }
+  return tile_sizes;
+}
+
+void writeTileSizes(const std::string& filename, const std::map<std::string, uint32_t>& tile_sizes)
+{
+  std::ofstream file(filename);
+  SLIC_ERROR_IF(!file, axom::fmt::format("Can not open tile size file: '{0}'", filename));
+  for (const auto& [key, tile_size] : tile_sizes) {
+    file << key << '\t' << tile_size << '\n';
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,87 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file tile_size_tuner.hpp
+ *
+ * @brief choosing the number of elements in each tile of a tiled domain integral evaluation by timing them
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace serac {
+
+/**
+ * @brief times the tiled evaluations of a domain integral over one element geometry with a few different tile sizes
+ * on its first calls, and then sticks with the fastest one
+ *
+ * Each candidate tile size is used for a few evaluations in turn, and its time is the fastest of those, so that the
+ * first (cold) evaluation doesn't count against it.
+ */
+class TileSizeTuner {
+public:
+  /// @brief the number of evaluations that each candidate tile size is timed for
+  static constexpr int trials = 3;
+
+  /**
+   * @brief a tuner for the kernel described by @a key, over @a num_elements elements
+   *
+   * @param key a description of the kernel (its geometry, spaces, quadrature rule and q-function), with which the
+   * tuned tile sizes are saved, see writeTileSizes()
+   * @param num_elements the number of elements the kernel evaluates
+   */
+  TileSizeTuner(std::string key, uint32_t num_elements);
+
+  /// @brief the description of the tuned kernel
+  const std::string& key() const { return key_; }
+
+  /// @brief whether the fastest tile size has been found
+  bool tuned() const { return next_ == candidates_.size(); }
+
+  /// @brief the tile size to use for the next evaluation: the candidate being timed, or the fastest one once tuned
+  uint32_t tileSize() const { return tuned() ? best_ : candidates_[next_]; }
+
+  /// @brief record the time (in seconds) of an evaluation with tileSize()
+  void record(double seconds);
+
+  /// @brief stop tuning, and use @a tile_size from now on (e.g. one found by an earlier run)
+  void settle(uint32_t tile_size);
+
+private:
+  /// the description of the tuned kernel
+  std::string key_;
+
+  /// the tile sizes to time
+  std::vector<uint32_t> candidates_;
+
+  /// the fastest time of each candidate so far
+  std::vector<double> times_;
+
+  /// the candidate being timed
+  std::size_t next_ = 0;
+
+  /// the number of evaluations of the candidate being timed so far
+  int evaluations_ = 0;
+
+  /// the fastest tile size
+  uint32_t best_ = 0;
+};
+
+/**
+ * @brief read the tile sizes saved by writeTileSizes(), by kernel description
+ * @note a file that doesn't exist (yet) has no tile sizes
+ */
+std::map<std::string, uint32_t> readTileSizes(const std::string& filename);
+
+/// @brief save tuned tile sizes (see TileSizeTuner) by kernel description, one per line
+void writeTileSizes(const std::string& filename, const std::map<std::string, uint32_t>& tile_sizes);
+
+}  // namespace serac
@@ -3,6 +3,7 @@
 #include "serac/numerics/functional/tuple.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/dual.hpp"
+#include "serac/numerics/functional/simd.hpp"
 
 #include "mfem.hpp"
 
@@ -22,14 +23,14 @@ struct is_tensor_of_dual_number<tensor<dual<T>, n...>> {
 
 /**
  * @brief multiply a tensor by a scalar value
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] scale The scaling factor
  * @param[in] A The tensor to be scaled
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator*(S scale, const tensor<T, m, n...>& A)
 {
   tensor<decltype(S{} * T{}), m, n...> C{};
@@ -41,14 +42,14 @@ SERAC_HOST_DEVICE constexpr auto operator*(S scale, const tensor<T, m, n...>& A)
 
 /**
  * @brief multiply a tensor by a scalar value
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] A The tensor to be scaled
  * @param[in] scale The scaling factor
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator*(const tensor<T, m, n...>& A, S scale)
 {
   tensor<decltype(T{} * S{}), m, n...> C{};
@@ -60,14 +61,14 @@ SERAC_HOST_DEVICE constexpr auto operator*(const tensor<T, m, n...>& A, S scale)
 
 /**
  * @brief divide a scalar by each element in a tensor
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] scale The numerator
  * @param[in] A The tensor of denominators
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator/(S scale, const tensor<T, m, n...>& A)
 {
   tensor<decltype(S{} * T{}), n...> C{};
@@ -79,14 +80,14 @@ SERAC_HOST_DEVICE constexpr auto operator/(S scale, const tensor<T, m, n...>& A)
 
 /**
  * @brief divide a tensor by a scalar
- * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int) or a dual number
+ * @tparam S the scalar value type. Must be arithmetic (e.g. float, double, int), a dual number or a simd pack
  * @tparam T the underlying type of the tensor (righthand) argument
  * @tparam n integers describing the tensor shape
  * @param[in] A The tensor of numerators
  * @param[in] scale The denominator
  */
 template <typename S, typename T, int m, int... n,
-          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value>>
+          typename = std::enable_if_t<std::is_arithmetic_v<S> || is_dual_number<S>::value || is_simd<S>::value>>
 SERAC_HOST_DEVICE constexpr auto operator/(const tensor<T, m, n...>& A, S scale)
 {
   tensor<decltype(T{} * S{}), m, n...> C{};
@@ -676,6 +677,126 @@ auto solve_scalar_equation(const function& f, double x0, double lower_bound, dou
   }
 }
 
+/// @brief Solves a batch of independent nonlinear scalar equations in lockstep
+///
+/// @tparam n The capacity of the batch
+/// @tparam function Function object type for the nonlinear equations to solve
+/// @tparam ...ParamTypes Types of the (optional) parameters to the nonlinear function
+///
+/// @param f Nonlinear function, see @p solve_scalar_equation. Every equation uses the same function, with
+/// its own initial guess, bounds and parameters.
+/// @param x0 Initial guess of the root of each equation
+/// @param lower_bound Lower bound of the search interval of each equation
+/// @param upper_bound Upper bound of the search interval of each equation
+/// @param options Options controlling behavior of solver, shared by every equation
+/// @param count The number of equations in the batch, i.e. only the first @p count entries of the other
+/// arguments are used
+/// @param ...params Optional parameters of each equation
+///
+/// @return the result that @p solve_scalar_equation gives for each of the first @p count equations
+///
+/// This is intended for a compact work list, such as the return maps of the yielding quadrature points
+/// of an element. Each iteration takes the same safeguarded Newton or bisection step as
+/// @p solve_scalar_equation on every unconverged equation, with the choice of step written as a select,
+/// so the equations advance together and the loop only ends once all of them have converged.
+template <int n, typename function, typename... ParamTypes>
+auto solve_scalar_equations(const function& f, const tensor<double, n>& x0, const tensor<double, n>& lower_bound,
+                            const tensor<double, n>& upper_bound, ScalarSolverOptions options, int count,
+                            const tensor<ParamTypes, n>&... params)
+{
+  tensor<double, n> x{}, xl{}, xh{}, fval{}, df_dx{}, delta_x{}, delta_x_old{};
+  tensor<int, n>    iterations{};
+  tensor<bool, n>   converged{};
+
+  for (int j = 0; j < count; j++) {
+    double fl = f(lower_bound[j], get_value(params[j])...);
+    double fh = f(upper_bound[j], get_value(params[j])...);
+
+    SLIC_ERROR_ROOT_IF(fl * fh > 0, "solve_scalar_equations: root not bracketed by input bounds.");
+
+    // handle corner cases where one of the brackets is the root, and
+    // move initial guesses that are not between the brackets
+    bool outside = x0[j] < lower_bound[j] || x0[j] > upper_bound[j];
+    x[j]         = (fl == 0) ? lower_bound[j]
+                   : (fh == 0) ? upper_bound[j]
+                   : outside   ? 0.5 * (lower_bound[j] + upper_bound[j])
+                               : x0[j];
+    converged[j] = (fl == 0) || (fh == 0);
+
+    // orient search so that f(xl) < 0
+    xl[j] = (fl > 0) ? upper_bound[j] : lower_bound[j];
+    xh[j] = (fl > 0) ? lower_bound[j] : upper_bound[j];
+
+    delta_x_old[j] = std::abs(upper_bound[j] - lower_bound[j]);
+    delta_x[j]     = delta_x_old[j];
+
+    auto R   = f(make_dual(x[j]), get_value(params[j])...);
+    fval[j]  = get_value(R);
+    df_dx[j] = get_gradient(R);
+  }
+
+  for (unsigned int k = 0; k < options.max_iter; k++) {
+    bool all_converged = true;
+    for (int j = 0; j < count; j++) {
+      if (converged[j]) continue;
+
+      // use bisection if Newton oversteps brackets or is not decreasing sufficiently
+      bool bisect = (x[j] - xh[j]) * df_dx[j] - fval[j] > 0 || (x[j] - xl[j]) * df_dx[j] - fval[j] < 0 ||
+                    std::abs(2. * fval[j]) > std::abs(delta_x_old[j] * df_dx[j]);
+
+      double step    = bisect ? 0.5 * (xh[j] - xl[j]) : fval[j] / df_dx[j];
+      double x_new   = bisect ? xl[j] + step : x[j] - step;
+      bool   stalled = x_new == (bisect ? xl[j] : x[j]);
+
+      delta_x_old[j] = delta_x[j];
+      delta_x[j]     = step;
+      x[j]           = x_new;
+
+      // function and jacobian evaluation
+      auto R   = f(make_dual(x[j]), get_value(params[j])...);
+      fval[j]  = get_value(R);
+      df_dx[j] = get_gradient(R);
+
+      // convergence check
+      converged[j] = stalled || (std::abs(delta_x[j]) < options.xtol) || (std::abs(fval[j]) < options.rtol);
+
+      // maintain bracket on root
+      xl[j] = (fval[j] < 0) ? x[j] : xl[j];
+      xh[j] = (fval[j] < 0) ? xh[j] : x[j];
+
+      iterations[j]++;
+      all_converged = all_converged && converged[j];
+    }
+    if (all_converged) break;
+  }
+
+  // derivatives of each root w.r.t. its parameters, as in solve_scalar_equation
+  constexpr bool contains_duals =
+      (is_dual_number<ParamTypes>::value || ...) || (is_tensor_of_dual_number<ParamTypes>::value || ...);
+  auto result = [&](int j) {
+    if constexpr (contains_duals) {
+      auto [value, df] = f(x[j], params[j]...);
+      SolverStatus status{
+          .converged = converged[j], .iterations = static_cast<unsigned int>(iterations[j]), .residual = value};
+      return tuple{dual{x[j], -df / df_dx[j]}, status};
+    } else {
+      double       value = f(x[j], params[j]...);
+      SolverStatus status{
+          .converged = converged[j], .iterations = static_cast<unsigned int>(iterations[j]), .residual = value};
+      return tuple{x[j], status};
+    }
+  };
+
+  tensor<decltype(result(0)), n> results{};
+  for (int j = 0; j < count; j++) {
+    if (!converged[j]) {
+      SLIC_WARNING("solve_scalar_equations failed to converge in allotted iterations.");
+    }
+    results[j] = result(j);
+  }
+  return results;
+}
+
 /**
  * @brief Finds a root of a vector-valued nonlinear function
  *
@@ -801,8 +922,9 @@ SERAC_HOST_DEVICE tensor<int, 3> argsort(const tensor<T, 3>& v)
  */
 inline SERAC_HOST_DEVICE tuple<vec3, mat3> eig_symm(const mat3& A)
 {
-  // We know of optimizations for this routine. When this becomes the
-  // bottleneck, we can revisit. See OptimiSM for details.
+  // The branches of the original algorithm are written as selects, so that every quadrature point
+  // takes the same path (apart from multiples of the identity), and both candidates are computed
+  // where they are cheap.
 
   tensor<double, 3>    eta{};
   tensor<double, 3, 3> Q = DenseIdentity<3>();
@@ -812,34 +934,25 @@ inline SERAC_HOST_DEVICE tuple<vec3, mat3> eig_symm(const mat3& A)
   double J3    = det(A_dev);
 
   if (J2 > 0.0) {
-    // angle used to find eigenvalues
-    double tmp   = (0.5 * J3) * std::pow(3.0 / J2, 1.5);
+    // angle used to find eigenvalues, (3 / J2)^(3/2) without the call to pow()
+    double scale = 3.0 / J2;
+    double tmp   = (0.5 * J3) * scale * std::sqrt(scale);
     double alpha = std::acos(fmin(fmax(tmp, -1.0), 1.0)) / 3.0;
 
     // consider the most distinct eigenvalue first
-    if (6.0 * alpha < M_PI) {
-      eta[0] = 2 * std::sqrt(J2 / 3.0) * std::cos(alpha);
-    } else {
-      eta[0] = 2 * std::sqrt(J2 / 3.0) * std::cos(alpha + 2.0 * M_PI / 3.0);
-    }
+    eta[0] = 2 * std::sqrt(J2 / 3.0) * std::cos(alpha + ((6.0 * alpha < M_PI) ? 0.0 : 2.0 * M_PI / 3.0));
 
     // find the eigenvector for that eigenvalue
     mat3 r;
-
-    int    imax     = -1;
-    double norm_max = -1.0;
-
+    vec3 norms;
     for (int i = 0; i < 3; i++) {
       for (int j = 0; j < 3; j++) {
         r[i][j] = A_dev(j, i) - (i == j) * eta(0);
       }
-
-      double norm_r = norm(r[i]);
-      if (norm_max < norm_r) {
-        imax     = i;
-        norm_max = norm_r;
-      }
+      norms[i] = norm(r[i]);
     }
+    int imax = (norms[1] > norms[0]) ? 1 : 0;
+    imax     = (norms[2] > norms[imax]) ? 2 : imax;
 
     vec3 s0, s1, t1, t2, v0, v1, v2, w;
 
@@ -850,9 +963,6 @@ inline SERAC_HOST_DEVICE tuple<vec3, mat3> eig_symm(const mat3& A)
 
     // record the first eigenvector
     v0 = cross(s0, s1);
-    for (int i = 0; i < 3; i++) {
-      Q[i][0] = v0[i];
-    }
 
     // get the other two eigenvalues by solving the
     // remaining quadratic characteristic polynomial
@@ -869,30 +979,26 @@ inline SERAC_HOST_DEVICE tuple<vec3, mat3> eig_symm(const mat3& A)
     eta(1) = 0.5 * (A11 + A22) - delta;
     eta(2) = 0.5 * (A11 + A22) + delta;
 
-    // if the remaining eigenvalues are exactly the same
-    // then just use the basis for the orthogonal complement
-    // found earlier
-    if (fabs(delta) <= 1.0e-15) {
-      for (int i = 0; i < 3; i++) {
-        Q[i][1] = s0(i);
-        Q[i][2] = s1(i);
-      }
-
-      // otherwise compute the remaining eigenvectors
-    } else {
-      t1 = A_dev_s0 - eta(1) * s0;
-      t2 = A_dev_s1 - eta(1) * s1;
+    // compute the remaining eigenvectors
+    t1 = A_dev_s0 - eta(1) * s0;
+    t2 = A_dev_s1 - eta(1) * s1;
 
-      w = normalize((norm(t1) > norm(t2)) ? t1 : t2);
+    w  = normalize((norm(t1) > norm(t2)) ? t1 : t2);
+    v1 = normalize(cross(w, v0));
 
-      v1 = normalize(cross(w, v0));
-      for (int i = 0; i < 3; i++) Q[i][1] = v1(i);
+    // define the last eigenvector as
+    // the direction perpendicular to the
+    // first two directions
+    v2 = normalize(cross(v0, v1));
 
-      // define the last eigenvector as
-      // the direction perpendicular to the
-      // first two directions
-      v2 = normalize(cross(v0, v1));
-      for (int i = 0; i < 3; i++) Q[i][2] = v2(i);
+    // if the remaining eigenvalues are the same (relative to the spread of the
+    // eigenvalues), w is not well defined, so use the basis for the orthogonal
+    // complement found earlier instead
+    bool repeated = fabs(delta) <= 1.0e-14 * std::sqrt(J2);
+    for (int i = 0; i < 3; i++) {
+      Q[i][0] = v0[i];
+      Q[i][1] = repeated ? s0[i] : v1[i];
+      Q[i][2] = repeated ? s1[i] : v2[i];
     }
   }
   // eta are actually eigenvalues of A_dev, so
@@ -976,23 +1082,62 @@ auto symmetric_mat3_function(tensor<T, 3, 3> A, const Function& f, const EigvalS
   }
 }
 
-/// Helper function for defining the derivative
+/**
+ * @brief Helper function for defining the derivative
+ *
+ * The derivative of an isotropic function is diagonal in the eigenbasis of A: the perturbation dA is
+ * rotated into the eigenbasis, each of its components (a, b) is scaled by g(lambda_a, lambda_b), and
+ * the result is rotated back. This takes O(3^3) operations per gradient component rather than the
+ * O(3^6) of summing over every (i, j, k, l, a, b), and only evaluates g 9 times.
+ */
 template <typename Gradient, typename Function>
 SERAC_HOST_DEVICE constexpr auto symmetric_mat3_function_with_derivative(tensor<dual<Gradient>, 3, 3> A,
                                                                          tensor<double, 3, 3> f_A, vec3 lambda, mat3 Q,
                                                                          const Function& g)
 {
+  double G[3][3]{};
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      G[a][b] = g(lambda[a], lambda[b]);
+    }
+  }
+
+  // dA Q
+  Gradient dA_Q[3][3]{};
+  for (int k = 0; k < 3; k++) {
+    for (int b = 0; b < 3; b++) {
+      for (int l = 0; l < 3; l++) {
+        dA_Q[k][b] += Q[l][b] * A[k][l].gradient;
+      }
+    }
+  }
+
+  // G : (Q^T dA Q)
+  Gradient df_eig[3][3]{};
+  for (int a = 0; a < 3; a++) {
+    for (int b = 0; b < 3; b++) {
+      for (int k = 0; k < 3; k++) {
+        df_eig[a][b] += Q[k][a] * dA_Q[k][b];
+      }
+      df_eig[a][b] = G[a][b] * df_eig[a][b];
+    }
+  }
+
+  // Q (G : (Q^T dA Q))
+  Gradient Q_df_eig[3][3]{};
+  for (int i = 0; i < 3; i++) {
+    for (int b = 0; b < 3; b++) {
+      for (int a = 0; a < 3; a++) {
+        Q_df_eig[i][b] += Q[i][a] * df_eig[a][b];
+      }
+    }
+  }
+
   return make_tensor<3, 3>([&](int i, int j) {
     auto     value = f_A[i][j];
     Gradient gradient{};
-    for (int k = 0; k < 3; k++) {
-      for (int l = 0; l < 3; l++) {
-        for (int a = 0; a < 3; a++) {
-          for (int b = 0; b < 3; b++) {
-            gradient += g(lambda[a], lambda[b]) * Q[k][a] * Q[l][b] * Q[i][a] * Q[j][b] * A[k][l].gradient;
-          }
-        }
-      }
+    for (int b = 0; b < 3; b++) {
+      gradient += Q[j][b] * Q_df_eig[i][b];
     }
     return dual<Gradient>{value, gradient};
   });
@@ -1007,13 +1152,12 @@ SERAC_HOST_DEVICE constexpr auto symmetric_mat3_function_with_derivative(tensor<
 template <typename T>
 auto log_symm(tensor<T, 3, 3> A)
 {
+  // log(1 + z) / z, with z = lam1 / lam2 - 1, switches to its series near z = 0, where
+  // the direct expression suffers from cancellation
   auto g = [](double lam1, double lam2) {
-    if (lam1 == lam2) {
-      return 1 / lam1;
-    } else {
-      double y = lam1 / lam2;
-      return (std::log(y) / (y - 1.0)) / lam2;
-    }
+    double z      = (lam1 - lam2) / lam2;
+    double series = 1.0 - z * (0.5 - z * (1.0 / 3.0 - 0.25 * z));
+    return ((fabs(z) < 1.0e-4) ? series : std::log1p(z) / z) / lam2;
   };
   return symmetric_mat3_function(
       A, [](double x) { return std::log(x); }, g);
@@ -1028,13 +1172,12 @@ auto log_symm(tensor<T, 3, 3> A)
 template <typename T>
 auto exp_symm(tensor<T, 3, 3> A)
 {
+  // expm1(z) / z, with z = lam1 - lam2, switches to its series near z = 0, where the
+  // division is undefined
   auto g = [](double lam1, double lam2) {
-    if (lam1 == lam2) {
-      return std::exp(lam1);
-    } else {
-      double arg = lam1 - lam2;
-      return std::exp(lam2) * std::expm1(arg) / arg;
-    }
+    double z      = lam1 - lam2;
+    double series = 1.0 + z * (0.5 + z * (1.0 / 6.0 + z / 24.0));
+    return std::exp(lam2) * ((fabs(z) < 1.0e-4) ? series : std::expm1(z) / z);
   };
   return symmetric_mat3_function(
       A, [](double x) { return std::exp(x); }, g);
@@ -0,0 +1,211 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/modal_superposition.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#ifdef MFEM_USE_SLEPC
+#include "slepceps.h"
+#endif
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// @brief the inner products of @a x with each of @a shapes, summed over the ranks of @a comm
+std::vector<double> innerProducts(const std::vector<mfem::Vector>& shapes, const mfem::Vector& x, MPI_Comm comm)
+{
+  std::vector<double> products(shapes.size());
+  for (std::size_t i = 0; i < shapes.size(); i++) {
+    products[i] = shapes[i] * x;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, products.data(), static_cast<int>(products.size()), MPI_DOUBLE, MPI_SUM, comm);
+  return products;
+}
+
+#ifdef MFEM_USE_SLEPC
+/// @brief Initialize SLEPc (and PETSc), unless that has been done already
+void initializeSlepc()
+{
+  PetscBool initialized = PETSC_FALSE;
+  SlepcInitialized(&initialized);
+  if (!initialized) {
+    mfem::MFEMInitializeSlepc();
+  }
+}
+#endif
+
+}  // namespace
+
+#ifdef MFEM_USE_SLEPC
+
+VibrationModes lowestVibrationModes(const mfem::HypreParMatrix& K, const mfem::HypreParMatrix& M, int num_modes,
+                                    double tolerance)
+{
+  SLIC_ERROR_ROOT_IF(num_modes < 1, "At least one vibration mode must be computed");
+  initializeSlepc();
+
+  // K itself is singular for structures that are free to move rigidly, so the shift sits a little below 0, on the
+  // scale of the largest ratio of the diagonals of K and M (which is on the order of the largest eigenvalue)
+  mfem::Vector K_diagonal, M_diagonal;
+  K.GetDiag(K_diagonal);
+  M.GetDiag(M_diagonal);
+  double ratio = 0.0;
+  for (int i = 0; i < K_diagonal.Size(); i++) {
+    if (M_diagonal(i) > 0.0) {
+      ratio = std::max(ratio, K_diagonal(i) / M_diagonal(i));
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &ratio, 1, MPI_DOUBLE, MPI_MAX, K.GetComm());
+
+  mfem::PetscParMatrix K_petsc(&K, mfem::Operator::PETSC_MATAIJ);
+  mfem::PetscParMatrix M_petsc(&M, mfem::Operator::PETSC_MATAIJ);
+
+  mfem::SlepcEigenSolver eigensolver(K.GetComm());
+  eigensolver.SetNumModes(num_modes);
+  eigensolver.SetTol(tolerance);
+  eigensolver.SetWhichEigenpairs(mfem::SlepcEigenSolver::TARGET_REAL);
+  eigensolver.SetTarget(-1.0e-8 * std::max(ratio, 1.0));
+  eigensolver.SetSpectralTransformation(mfem::SlepcEigenSolver::SHIFT_INVERT);
+  eigensolver.SetOperators(K_petsc, M_petsc);
+  EPSSetProblemType(eigensolver, EPS_GHEP);
+  eigensolver.Solve();
+
+  int converged = eigensolver.GetNumConverged();
+  SLIC_ERROR_ROOT_IF(converged < num_modes,
+                     axom::fmt::format("Only {} of {} vibration modes converged", converged, num_modes));
+
+  std::vector<double>       eigenvalues(static_cast<size_t>(num_modes));
+  std::vector<mfem::Vector> shapes(static_cast<size_t>(num_modes));
+  mfem::Vector              M_shape(M.Height());
+  for (int i = 0; i < num_modes; i++) {
+    auto& shape = shapes[static_cast<size_t>(i)];
+    shape.SetSize(K.Height());
+    eigensolver.GetEigenvalue(static_cast<unsigned int>(i), eigenvalues[static_cast<size_t>(i)]);
+    eigensolver.GetEigenvector(static_cast<unsigned int>(i), shape);
+
+    // SLEPc already normalizes the shapes with M, but not necessarily to working precision
+    M.Mult(shape, M_shape);
+    shape /= std::sqrt(mfem::InnerProduct(K.GetComm(), shape, M_shape));
+  }
+
+  // the shapes in increasing order of their eigenvalues
+  std::vector<std::size_t> order(eigenvalues.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return eigenvalues[a] < eigenvalues[b]; });
+
+  VibrationModes modes;
+  for (auto i : order) {
+    modes.eigenvalues.push_back(eigenvalues[i]);
+    modes.shapes.push_back(std::move(shapes[i]));
+  }
+  return modes;
+}
+
+double largestEigenvalue(const mfem::HypreParMatrix& K, const mfem::HypreParMatrix& M, double tolerance)
+{
+  initializeSlepc();
+
+  mfem::PetscParMatrix K_petsc(&K, mfem::Operator::PETSC_MATAIJ);
+  mfem::PetscParMatrix M_petsc(&M, mfem::Operator::PETSC_MATAIJ);
+
+  mfem::SlepcEigenSolver eigensolver(K.GetComm());
+  eigensolver.SetNumModes(1);
+  eigensolver.SetTol(tolerance);
+  eigensolver.SetWhichEigenpairs(mfem::SlepcEigenSolver::LARGEST_REAL);
+  eigensolver.SetOperators(K_petsc, M_petsc);
+  EPSSetProblemType(eigensolver, EPS_GHEP);
+  eigensolver.Solve();
+
+  SLIC_ERROR_ROOT_IF(eigensolver.GetNumConverged() < 1, "The largest eigenvalue did not converge");
+
+  double lambda_max = 0.0;
+  eigensolver.GetEigenvalue(0, lambda_max);
+  return lambda_max;
+}
+
+#endif
+
+ModalIntegrator::ModalIntegrator(VibrationModes modes, MPI_Comm comm)
+    : modes_(std::move(modes)),
+      comm_(comm),
+      q_(modes_.shapes.size(), 0.0),
+      q_dot_(modes_.shapes.size(), 0.0),
+      p_(modes_.shapes.size(), 0.0)
+{
+  SLIC_ERROR_ROOT_IF(modes_.eigenvalues.size() != modes_.shapes.size(),
+                     "Every vibration mode needs an eigenvalue and a shape");
+}
+
+void ModalIntegrator::setState(const mfem::Operator& M, const mfem::Vector& u, const mfem::Vector& v)
+{
+  mfem::Vector M_x(M.Height());
+
+  M.Mult(u, M_x);
+  q_ = innerProducts(modes_.shapes, M_x, comm_);
+
+  M.Mult(v, M_x);
+  q_dot_ = innerProducts(modes_.shapes, M_x, comm_);
+}
+
+void ModalIntegrator::setLoad(const mfem::Vector& f) { p_ = innerProducts(modes_.shapes, f, comm_); }
+
+void ModalIntegrator::step(double dt, const mfem::Vector& f)
+{
+  std::vector<double> p_end = innerProducts(modes_.shapes, f, comm_);
+
+  for (std::size_t i = 0; i < q_.size(); i++) {
+    double lambda = modes_.eigenvalues[i];
+    double q0     = q_[i];
+    double v0     = q_dot_[i];
+    double p0     = p_[i];
+    double dp_dt  = (p_end[i] - p0) / dt;
+
+    // the modes of unconstrained rigid body motions, q'' = p(t)
+    if (lambda <= 1.0e-12 * std::max(1.0, modes_.eigenvalues.back())) {
+      q_[i]     = q0 + dt * (v0 + dt * (0.5 * p0 + dp_dt * dt / 6.0));
+      q_dot_[i] = v0 + dt * (p0 + 0.5 * dp_dt * dt);
+      continue;
+    }
+
+    // q(t) = A cos(w t) + B sin(w t) + p(t) / w^2, for a linearly varying load p(t)
+    double omega = std::sqrt(lambda);
+    double A     = q0 - p0 / lambda;
+    double B     = (v0 - dp_dt / lambda) / omega;
+    double c     = std::cos(omega * dt);
+    double s     = std::sin(omega * dt);
+
+    q_[i]     = A * c + B * s + p_end[i] / lambda;
+    q_dot_[i] = omega * (B * c - A * s) + dp_dt / lambda;
+  }
+
+  p_ = std::move(p_end);
+}
+
+void ModalIntegrator::acceleration(mfem::Vector& a) const
+{
+  std::vector<double> q_ddot(q_.size());
+  for (std::size_t i = 0; i < q_.size(); i++) {
+    q_ddot[i] = p_[i] - modes_.eigenvalues[i] * q_[i];
+  }
+  expand(q_ddot, a);
+}
+
+void ModalIntegrator::expand(const std::vector<double>& c, mfem::Vector& x) const
+{
+  x.SetSize(modes_.shapes.empty() ? 0 : modes_.shapes[0].Size());
+  x = 0.0;
+  for (std::size_t i = 0; i < c.size(); i++) {
+    x.Add(c[i], modes_.shapes[i]);
+  }
+}
+
+}  // namespace serac
@@ -0,0 +1,132 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file modal_superposition.hpp
+ *
+ * @brief Vibration modes of linear structural dynamics, and the exact integration of its response in modal
+ * coordinates
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/// @brief Vibration modes: the eigenpairs K phi = lambda M phi, with M-orthonormal mode shapes phi
+struct VibrationModes {
+  /// The eigenvalues lambda (the squares of the natural angular frequencies), in increasing order
+  std::vector<double> eigenvalues;
+
+  /// The mode shapes phi, as true dof vectors
+  std::vector<mfem::Vector> shapes;
+};
+
+#ifdef MFEM_USE_SLEPC
+/**
+ * @brief Compute the lowest vibration modes of a stiffness and mass matrix with SLEPc, initializing SLEPc if that
+ * hasn't been done yet
+ *
+ * This uses a shift-and-invert spectral transformation just below 0, so the stiffness matrix may be singular (e.g.
+ * for structures that are free to move rigidly) and so may the mass matrix.
+ *
+ * @param K The stiffness matrix, which must be symmetric positive semi-definite
+ * @param M The mass matrix, which must be symmetric positive semi-definite
+ * @param num_modes The number of modes to compute
+ * @param tolerance The relative tolerance of the eigenvalues
+ *
+ * @note Constrained dofs must be kept out of the lowest modes, e.g. by eliminating their rows and columns but keeping
+ * their diagonal entries, see SolidMechanics::useModalSuperposition()
+ */
+VibrationModes lowestVibrationModes(const mfem::HypreParMatrix& K, const mfem::HypreParMatrix& M, int num_modes,
+                                    double tolerance = 1.0e-10);
+
+/**
+ * @brief Compute the largest eigenvalue lambda_max of K phi = lambda M phi with SLEPc
+ *
+ * The central difference method is stable for steps up to 2 / sqrt(lambda_max) with this mass matrix.
+ */
+double largestEigenvalue(const mfem::HypreParMatrix& K, const mfem::HypreParMatrix& M, double tolerance = 1.0e-6);
+#endif
+
+/**
+ * @brief Integrates undamped linear dynamics M u'' + K u = f(t) in the coordinates of some of its vibration modes
+ *
+ * With u = sum_i q_i phi_i, every modal coordinate follows its own equation q_i'' + lambda_i q_i = phi_i^T f(t),
+ * which is integrated exactly for loads that vary linearly over each step. So the steps can be as large as the
+ * loads (and the output) allow, with no stability limit and no linear solves.
+ */
+class ModalIntegrator {
+public:
+  /**
+   * @brief An integrator, at rest, in the coordinates of @a modes
+   *
+   * @param modes The vibration modes
+   * @param comm The MPI communicator of the mode shapes
+   */
+  ModalIntegrator(VibrationModes modes, MPI_Comm comm);
+
+  /// @brief The vibration modes
+  const VibrationModes& modes() const { return modes_; }
+
+  /**
+   * @brief Project a displacement and velocity onto the modes, q = Phi^T M u
+   *
+   * @param M The mass matrix that the mode shapes are orthonormal with
+   * @param u The displacement
+   * @param v The velocity
+   *
+   * @note The components of @a u and @a v outside of the span of the modes are discarded
+   */
+  void setState(const mfem::Operator& M, const mfem::Vector& u, const mfem::Vector& v);
+
+  /**
+   * @brief Set the load at the start of the next step
+   * @param f The load (as a true dof vector)
+   */
+  void setLoad(const mfem::Vector& f);
+
+  /**
+   * @brief Advance the modal coordinates over a step, during which the load varies linearly to @a f
+   *
+   * @param dt The size of the step
+   * @param f The load at the end of the step (as a true dof vector)
+   */
+  void step(double dt, const mfem::Vector& f);
+
+  /// @brief The displacement u = Phi q
+  void displacement(mfem::Vector& u) const { expand(q_, u); }
+
+  /// @brief The velocity v = Phi q'
+  void velocity(mfem::Vector& v) const { expand(q_dot_, v); }
+
+  /// @brief The acceleration a = Phi (p - lambda q), with the modal loads p of the last set load
+  void acceleration(mfem::Vector& a) const;
+
+private:
+  /// @brief x = Phi c
+  void expand(const std::vector<double>& c, mfem::Vector& x) const;
+
+  /// The vibration modes
+  VibrationModes modes_;
+
+  /// The MPI communicator of the mode shapes
+  MPI_Comm comm_;
+
+  /// The modal displacements q
+  std::vector<double> q_;
+
+  /// The modal velocities q'
+  std::vector<double> q_dot_;
+
+  /// The modal loads at the start of the next step
+  std::vector<double> p_;
+};
+
+}  // namespace serac
@@ -6,8 +6,71 @@
 
 #include "serac/numerics/odes.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 namespace serac::mfem_ext {
 
+namespace {
+
+/**
+ * @brief Sets the essential boundary condition values at @a time, and their first (and second) time derivatives
+ *
+ * The derivatives come from the boundary conditions themselves where they are known (see
+ * BoundaryCondition::hasTimeDerivatives), and are otherwise approximated by central finite differences over
+ * \f$ [t - \epsilon, t + \epsilon] \f$, using @a U_minus and @a U_plus as work vectors.
+ *
+ * @param[in] bcs The boundary conditions
+ * @param[in] time The time at which to evaluate the boundary conditions
+ * @param[in] epsilon The step size of the finite difference approximations
+ * @param[out] U The prescribed values
+ * @param[out] dU_dt The first time derivatives of the prescribed values, if not null
+ * @param[out] d2U_dt2 The second time derivatives of the prescribed values, if not null
+ * @param U_minus A work vector
+ * @param U_plus A work vector
+ */
+void evaluateEssentialBCs(const BoundaryConditionManager& bcs, double time, double epsilon, mfem::Vector& U,
+                          mfem::Vector* dU_dt, mfem::Vector* d2U_dt2, mfem::Vector& U_minus, mfem::Vector& U_plus)
+{
+  const int order = d2U_dt2 ? 2 : (dU_dt ? 1 : 0);
+
+  U = 0.0;
+  if (dU_dt) {
+    *dU_dt = 0.0;
+  }
+  if (d2U_dt2) {
+    *d2U_dt2 = 0.0;
+  }
+
+  for (const auto& bc : bcs.essentials()) {
+    bc.setDofs(U, time);
+
+    if (order == 0) {
+      continue;
+    }
+
+    if (bc.hasTimeDerivatives(order)) {
+      bc.setDofTimeDerivative(*dU_dt, time, 1);
+      if (d2U_dt2) {
+        bc.setDofTimeDerivative(*d2U_dt2, time, 2);
+      }
+      continue;
+    }
+
+    // otherwise, use a 3-point stencil of times centered on the time of interest
+    bc.setDofs(U_minus, time - epsilon);
+    bc.setDofs(U_plus, time + epsilon);
+    for (int i : bc.getTrueDofList()) {
+      (*dU_dt)(i) = (U_plus(i) - U_minus(i)) / (2.0 * epsilon);
+      if (d2U_dt2) {
+        (*d2U_dt2)(i) = (U_minus(i) - 2.0 * U(i) + U_plus(i)) / (epsilon * epsilon);
+      }
+    }
+  }
+}
+
+}  // namespace
+
 SecondOrderODE::SecondOrderODE(int n, State&& state, const EquationSolver& solver, const BoundaryConditionManager& bcs)
     : mfem::SecondOrderTimeDependentOperator(n, 0.0), state_(std::move(state)), solver_(solver), bcs_(bcs), zero_(n)
 {
@@ -74,26 +137,86 @@ void SecondOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
   }
 }
 
+void SecondOrderODE::SetTimestepControl(const TimesteppingOptions& options, MPI_Comm comm)
+{
+  comm_ = comm;
+  if (options.adaptive) {
+    controller_ = std::make_unique<TimestepController>(options, 3);
+  } else {
+    controller_.reset();
+  }
+  suggested_dt_ = 0.0;
+}
+
 void SecondOrderODE::Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt)
+{
+  if (!controller_) {
+    StepOnce(x, dxdt, time, dt);
+    return;
+  }
+
+  u_start_       = x;
+  du_dt_start_   = dxdt;
+  d2u_dt2_start_ = state_.d2u_dt2;
+
+  const double time_start = time;
+  double       h          = std::min({dt, SuggestedTimestep(dt), controller_->options().max_dt});
+
+  for (int rejections = 0;; rejections++) {
+    converged_     = true;
+    time           = time_start;
+    double h_taken = h;
+    StepOnce(x, dxdt, time, h_taken);
+
+    double error_norm = 0.0;
+    if (converged_) {
+      // error ~ (u_{n+1} - (u_n + h v_n + h^2 / 2 a_n)) / 3
+      error_ = x;
+      error_ -= u_start_;
+      error_.Add(-h, du_dt_start_);
+      error_.Add(-0.5 * h * h, d2u_dt2_start_);
+      error_ *= 1.0 / 3.0;
+      error_.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+
+      error_norm = controller_->errorNorm(error_, u_start_, x, comm_);
+      if (error_norm <= 1.0) {
+        dt            = h;
+        suggested_dt_ = controller_->accept(h, error_norm);
+        return;
+      }
+    }
+
+    SLIC_ERROR_ROOT_IF(rejections >= controller_->options().max_rejections || h <= controller_->options().min_dt,
+                       axom::fmt::format("Adaptive time stepping failed at t = {} with dt = {}", time_start, h));
+
+    double retry = converged_ ? controller_->reject(h, error_norm) : controller_->rejectUnconverged(h);
+    SLIC_INFO_ROOT(axom::fmt::format("Rejected step at t = {} with dt = {} ({}), retrying with dt = {}", time_start,
+                                     h, converged_ ? "error too large" : "nonlinear solve failed", retry));
+    h = retry;
+
+    x              = u_start_;
+    dxdt           = du_dt_start_;
+    state_.d2u_dt2 = d2u_dt2_start_;
+    if (second_order_ode_solver_) {
+      second_order_ode_solver_->Init(*this);
+    } else if (first_order_system_ode_solver_) {
+      first_order_system_ode_solver_->Init(*this);
+    }
+  }
+}
+
+void SecondOrderODE::StepOnce(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt)
 {
   if (second_order_ode_solver_) {
     // if we used a 2nd order method
     second_order_ode_solver_->Step(x, dxdt, time, dt);
 
     if (enforcement_method_ == DirichletEnforcementMethod::FullControl) {
-      U_minus_ = 0.0;
-      U_       = 0.0;
-      U_plus_  = 0.0;
-      for (const auto& bc : bcs_.essentials()) {
-        bc.setDofs(U_minus_, t - epsilon);
-        bc.setDofs(U_, t);
-        bc.setDofs(U_plus_, t + epsilon);
-      }
+      evaluateEssentialBCs(bcs_, t, epsilon, U_, &dU_dt_, nullptr, U_minus_, U_plus_);
 
-      auto constrained_dofs = bcs_.allEssentialTrueDofs();
-      for (int i = 0; i < constrained_dofs.Size(); i++) {
+      for (int i : bcs_.allEssentialTrueDofs()) {
         x[i]    = U_[i];
-        dxdt[i] = (U_plus_[i] - U_minus_[i]) / (2.0 * epsilon);
+        dxdt[i] = dU_dt_[i];
       }
     }
 
@@ -160,73 +283,41 @@ void SecondOrderODE::Solve(const double time, const double c0, const double c1,
   state_.u     = u;
   state_.du_dt = du_dt;
 
-  // evaluate the constraint functions at a 3-point
-  // stencil of times centered on the time of interest
-  // in order to compute finite-difference approximations
-  // to the time derivatives that appear in the residual
-  U_minus_ = 0.0;
-  U_       = 0.0;
-  U_plus_  = 0.0;
-  for (const auto& bc : bcs_.essentials()) {
-    bc.setDofs(U_minus_, time - epsilon);
-    bc.setDofs(U_, time);
-    bc.setDofs(U_plus_, time + epsilon);
-  }
-
+  // evaluate the constraint functions, and the time derivatives of
+  // them that appear in the residual (see evaluateEssentialBCs)
   bool implicit = (c0 != 0.0 || c1 != 0.0);
-  if (implicit) {
-    if (enforcement_method_ == DirichletEnforcementMethod::DirectControl) {
-      // TODO: MFEM PR#3064 explicitly deleted the const vector operator-.  This
-      // is in active discusion and may be un-deleted. Original line commented.
-      // d2U_dt2_ = (U_ - u) / c0;
-      subtract(1.0 / c0, U_, u, d2U_dt2_);
-      dU_dt_ = du_dt;
-      U_     = u;
-    }
+  if (!implicit) {
+    evaluateEssentialBCs(bcs_, time, epsilon, U_, &dU_dt_, &d2U_dt2_, U_minus_, U_plus_);
+  } else if (enforcement_method_ == DirichletEnforcementMethod::DirectControl) {
+    evaluateEssentialBCs(bcs_, time, epsilon, U_, nullptr, nullptr, U_minus_, U_plus_);
+
+    // TODO: MFEM PR#3064 explicitly deleted the const vector operator-.  This
+    // is in active discusion and may be un-deleted. Original line commented.
+    // d2U_dt2_ = (U_ - u) / c0;
+    subtract(1.0 / c0, U_, u, d2U_dt2_);
+    dU_dt_ = du_dt;
+    U_     = u;
+  } else {
+    evaluateEssentialBCs(bcs_, time, epsilon, U_, &dU_dt_, nullptr, U_minus_, U_plus_);
 
-    if (enforcement_method_ == DirichletEnforcementMethod::RateControl) {
-      // d2U_dt2_ = ((U_plus_ - U_minus_) / (2.0 * epsilon) - du_dt) / c1;
-      subtract(U_plus_, U_minus_, d2U_dt2_);
-      d2U_dt2_ /= 2.0 * epsilon;
-      d2U_dt2_ -= du_dt;
-      d2U_dt2_ /= c1;
+    // d2U_dt2_ = (dU_dt_ - du_dt) / c1;
+    subtract(1.0 / c1, dU_dt_, du_dt, d2U_dt2_);
 
+    if (enforcement_method_ == DirichletEnforcementMethod::RateControl) {
       dU_dt_ = du_dt;
       U_     = u;
     }
 
     if (enforcement_method_ == DirichletEnforcementMethod::FullControl) {
-      // d2U_dt2_ = (U_minus_ - 2.0 * U_ + U_plus_) / (epsilon * epsilon);
-      add(1.0, U_minus_, -2.0, U_, d2U_dt2_);
-      d2U_dt2_ += U_plus_;
-      d2U_dt2_ /= epsilon * epsilon;
-
-      // d2U_dt2_ = ((U_plus_ - U_minus_) / (2.0 * epsilon) - du_dt) / c1;
-      subtract(U_plus_, U_minus_, d2U_dt2_);
-      d2U_dt2_ /= 2.0 * epsilon;
-      d2U_dt2_ -= du_dt;
-      d2U_dt2_ /= c1;
-
-      // dU_dt_   = (U_plus_ - U_minus_) / (2.0 * epsilon) - c1 * d2U_dt2_;
-      subtract(U_plus_, U_minus_, dU_dt_);
-      dU_dt_ /= 2.0 * epsilon;
+      // dU_dt_ = dU_dt_ - c1 * d2U_dt2_;
       dU_dt_.Add(-1.0 * c1, d2U_dt2_);
 
       // U_ = U_ - c0 * d2U_dt2_;
       U_.Add(-1.0 * c0, d2U_dt2_);
     }
-  } else {
-    // d2U_dt2_ = (U_minus_ - 2.0 * U_ + U_plus_) / (epsilon * epsilon);
-    add(1.0, U_minus_, -2.0, U_, d2U_dt2_);
-    d2U_dt2_ += U_plus_;
-    d2U_dt2_ /= epsilon * epsilon;
-
-    // dU_dt_   = (U_plus_ - U_minus_) / (2.0 * epsilon);
-    subtract(U_plus_, U_minus_, dU_dt_);
-    dU_dt_ /= 2.0 * epsilon;
   }
 
-  auto constrained_dofs = bcs_.allEssentialTrueDofs();
+  const auto& constrained_dofs = bcs_.allEssentialTrueDofs();
   state_.u.SetSubVector(constrained_dofs, 0.0);
   U_.SetSubVectorComplement(constrained_dofs, 0.0);
   state_.u += U_;
@@ -243,6 +334,7 @@ void SecondOrderODE::Solve(const double time, const double c0, const double c1,
 
   solver_.solve(d2u_dt2);
   SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+  converged_ = converged_ && solver_.nonlinearSolver().GetConverged();
 
   state_.d2u_dt2 = d2u_dt2;
 }
@@ -293,12 +385,150 @@ void FirstOrderODE::SetTimestepper(const serac::TimestepMethod timestepper)
     case serac::TimestepMethod::SDIRK34:
       ode_solver_ = std::make_unique<mfem::SDIRK34Solver>();
       break;
+    case serac::TimestepMethod::IMEXEuler:
+      imex_implicit_ = {{0.0, 0.0}, {0.0, 1.0}};
+      imex_explicit_ = {{0.0, 0.0}, {1.0, 0.0}};
+      imex_times_    = {0.0, 1.0};
+      ode_solver_.reset();
+      return;
+    case serac::TimestepMethod::IMEXRK2: {
+      // ARS(2,2,2), which is L-stable and stiffly accurate
+      double gamma   = 1.0 - 1.0 / std::sqrt(2.0);
+      double delta   = 1.0 - 1.0 / (2.0 * gamma);
+      imex_implicit_ = {{0.0, 0.0, 0.0}, {0.0, gamma, 0.0}, {0.0, 1.0 - gamma, gamma}};
+      imex_explicit_ = {{0.0, 0.0, 0.0}, {gamma, 0.0, 0.0}, {delta, 1.0 - delta, 0.0}};
+      imex_times_    = {0.0, gamma, 1.0};
+      ode_solver_.reset();
+      return;
+    }
     default:
       SLIC_ERROR_ROOT("Timestep method was not a supported first-order ODE method");
   }
   ode_solver_->Init(*this);
 }
 
+void FirstOrderODE::SetTimestepControl(const TimesteppingOptions& options, MPI_Comm comm)
+{
+  comm_ = comm;
+  if (options.adaptive) {
+    controller_ = std::make_unique<TimestepController>(options, 1);
+  } else {
+    controller_.reset();
+  }
+  suggested_dt_ = 0.0;
+}
+
+void FirstOrderODE::Step(mfem::Vector& x, double& time, double& dt)
+{
+  if (IsIMEX(timestepper_)) {
+    SLIC_ERROR_ROOT_IF(controller_, "Adaptive time stepping is not supported by the implicit-explicit methods");
+    IMEXStep(x, time, dt);
+    return;
+  }
+
+  if (!ode_solver_) {
+    SLIC_ERROR("ode_solver_ unspecified");
+    return;
+  }
+
+  if (!controller_) {
+    ode_solver_->Step(x, time, dt);
+    return;
+  }
+
+  u_start_     = x;
+  du_dt_start_ = state_.du_dt;
+
+  const double time_start = time;
+  double       h          = std::min({dt, SuggestedTimestep(dt), controller_->options().max_dt});
+
+  for (int rejections = 0;; rejections++) {
+    converged_     = true;
+    time           = time_start;
+    double h_taken = h;
+    ode_solver_->Step(x, time, h_taken);
+
+    double error_norm = 0.0;
+    if (converged_) {
+      // error ~ (u_{n+1} - (u_n + h du_dt_n)) / 2
+      error_ = x;
+      error_ -= u_start_;
+      error_.Add(-h, du_dt_start_);
+      error_ *= 0.5;
+      error_.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+
+      error_norm = controller_->errorNorm(error_, u_start_, x, comm_);
+      if (error_norm <= 1.0) {
+        dt            = h;
+        suggested_dt_ = controller_->accept(h, error_norm);
+        return;
+      }
+    }
+
+    SLIC_ERROR_ROOT_IF(rejections >= controller_->options().max_rejections || h <= controller_->options().min_dt,
+                       axom::fmt::format("Adaptive time stepping failed at t = {} with dt = {}", time_start, h));
+
+    double retry = converged_ ? controller_->reject(h, error_norm) : controller_->rejectUnconverged(h);
+    SLIC_INFO_ROOT(axom::fmt::format("Rejected step at t = {} with dt = {} ({}), retrying with dt = {}", time_start,
+                                     h, converged_ ? "error too large" : "nonlinear solve failed", retry));
+    h = retry;
+
+    x            = u_start_;
+    state_.du_dt = du_dt_start_;
+    ode_solver_->Init(*this);
+  }
+}
+
+void FirstOrderODE::IMEXStep(mfem::Vector& x, double& time, double dt)
+{
+  SLIC_ERROR_ROOT_IF(!implicit_term_ || !explicit_term_,
+                     "SetIMEXTerms() must be called prior to stepping with an implicit-explicit method");
+
+  std::size_t num_stages = imex_times_.size();
+  imex_implicit_terms_.resize(num_stages);
+  imex_explicit_terms_.resize(num_stages);
+  for (std::size_t i = 0; i < num_stages; i++) {
+    imex_implicit_terms_[i].SetSize(x.Size());
+    imex_explicit_terms_[i].SetSize(x.Size());
+  }
+  imex_load_.SetSize(x.Size());
+
+  // the first stage is the start of the step
+  u_start_          = x;
+  imex_stage_value_ = x;
+
+  for (std::size_t i = 1; i < num_stages; i++) {
+    // the terms of the previous stage, the only new ones that this stage needs
+    double previous_time = time + imex_times_[i - 1] * dt;
+    explicit_term_(previous_time, imex_stage_value_, imex_explicit_terms_[i - 1]);
+    if (i > 1) {
+      implicit_term_(previous_time, imex_stage_value_, imex_implicit_terms_[i - 1]);
+    }
+
+    // M (U_i - u_n) / dt + a_ii r_I(U_i) + sum_{j < i} (a_ij r_I(U_j) + a_hat_ij r_E(U_j)) = 0, divided by a_ii
+    const double a_ii = imex_implicit_[i][i];
+    imex_load_        = 0.0;
+    for (std::size_t j = 0; j < i; j++) {
+      if (j > 0) {
+        imex_load_.Add(imex_implicit_[i][j] / a_ii, imex_implicit_terms_[j]);
+      }
+      imex_load_.Add(imex_explicit_[i][j] / a_ii, imex_explicit_terms_[j]);
+    }
+
+    // U_i = u_n + a_ii dt k_i, where k_i solves the residual equations with coefficient a_ii dt
+    imex_rate_  = state_.du_dt;
+    imex_stage_ = true;
+    Solve(time + imex_times_[i] * dt, a_ii * dt, u_start_, imex_rate_);
+    imex_stage_ = false;
+    add(state_.u, a_ii * dt, imex_rate_, imex_stage_value_);
+  }
+
+  // the methods are stiffly accurate, so the solution is the last stage
+  x = imex_stage_value_;
+  subtract(1.0 / dt, x, u_start_, state_.du_dt);
+  time += dt;
+}
+
 void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector& u, mfem::Vector& du_dt) const
 {
   // assign these values to variables with greater scope,
@@ -307,47 +537,31 @@ void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector
   state_.dt   = dt;
   state_.u    = u;
 
-  // evaluate the constraint functions at a 3-point
-  // stencil of times centered on the time of interest
-  // in order to compute finite-difference approximations
-  // to the time derivatives that appear in the residual
-  U_minus_ = 0.0;
-  U_       = 0.0;
-  U_plus_  = 0.0;
-  for (const auto& bc : bcs_.essentials()) {
-    bc.setDofs(U_minus_, time - epsilon);
-    bc.setDofs(U_, time);
-    bc.setDofs(U_plus_, time + epsilon);
-  }
-
+  // evaluate the constraint functions, and the time derivatives of
+  // them that appear in the residual (see evaluateEssentialBCs)
   bool implicit = (dt != 0.0);
-  if (implicit) {
-    if (enforcement_method_ == DirichletEnforcementMethod::DirectControl) {
-      // TODO: MFEM PR#3064 explicitly deleted the const vector operator-.  This
-      // is in active discusion and may be un-deleted. Original line commented.
-      // dU_dt_ = (U_ - u) / dt;
-      subtract(1.0 / dt, U_, u, dU_dt_);
-      U_ = u;
-    }
+  if (implicit && enforcement_method_ == DirichletEnforcementMethod::DirectControl) {
+    evaluateEssentialBCs(bcs_, time, epsilon, U_, nullptr, nullptr, U_minus_, U_plus_);
+
+    // TODO: MFEM PR#3064 explicitly deleted the const vector operator-.  This
+    // is in active discusion and may be un-deleted. Original line commented.
+    // dU_dt_ = (U_ - u) / dt;
+    subtract(1.0 / dt, U_, u, dU_dt_);
+    U_ = u;
+  } else {
+    evaluateEssentialBCs(bcs_, time, epsilon, U_, &dU_dt_, nullptr, U_minus_, U_plus_);
 
-    if (enforcement_method_ == DirichletEnforcementMethod::RateControl) {
-      // dU_dt_ = (U_plus_ - U_minus_) / (2.0 * epsilon);
-      subtract(1.0 / (2.0 * epsilon), U_plus_, U_minus_, dU_dt_);
+    if (implicit && enforcement_method_ == DirichletEnforcementMethod::RateControl) {
       U_ = u;
     }
 
-    if (enforcement_method_ == DirichletEnforcementMethod::FullControl) {
-      // dU_dt_ = (U_plus_ - U_minus_) / (2.0 * epsilon);
-      subtract(1.0 / (2.0 * epsilon), U_plus_, U_minus_, dU_dt_);
+    if (implicit && enforcement_method_ == DirichletEnforcementMethod::FullControl) {
       // U_     = U_ - dt * dU_dt_;
       U_.Add(-1.0 * dt, dU_dt_);
     }
-  } else {
-    // dU_dt_ = (U_plus_ - U_minus_) / (2.0 * epsilon);
-    subtract(1.0 / (2.0 * epsilon), U_plus_, U_minus_, dU_dt_);
   }
 
-  auto constrained_dofs = bcs_.allEssentialTrueDofs();
+  const auto& constrained_dofs = bcs_.allEssentialTrueDofs();
   state_.u.SetSubVector(constrained_dofs, 0.0);
   U_.SetSubVectorComplement(constrained_dofs, 0.0);
   state_.u += U_;
@@ -357,8 +571,13 @@ void FirstOrderODE::Solve(const double time, const double dt, const mfem::Vector
   dU_dt_.SetSubVectorComplement(constrained_dofs, 0.0);
   du_dt += dU_dt_;
 
-  solver_.solve(du_dt);
-  SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+  if (!implicit && explicit_rate_) {
+    explicit_rate_(state_.u, du_dt);
+  } else {
+    solver_.solve(du_dt);
+    SLIC_WARNING_ROOT_IF(!solver_.nonlinearSolver().GetConverged(), "Newton Solver did not converge.");
+    converged_ = converged_ && solver_.nonlinearSolver().GetConverged();
+  }
 
   state_.du_dt       = du_dt;
   state_.previous_dt = dt;
@@ -13,11 +13,15 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "mfem.hpp"
 
 #include "serac/physics/boundary_conditions/boundary_condition_manager.hpp"
 #include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/timestep_controller.hpp"
 
 namespace serac::mfem_ext {
 
@@ -35,7 +39,8 @@ class SecondOrderODE : public mfem::SecondOrderTimeDependentOperator {
 public:
   /**
    * @brief a small number used to compute finite difference approximations
-   * to time derivatives of boundary conditions.
+   * to time derivatives of boundary conditions, for the boundary conditions
+   * that don't provide them (see BoundaryCondition::hasTimeDerivatives).
    *
    * Note: this is intended to be temporary
    * Ideally, epsilon should be "small" relative to the characteristic
@@ -146,23 +151,64 @@ public:
    */
   void SetTimestepper(const serac::TimestepMethod timestepper);
 
+  /**
+   * @brief Enable adaptive time stepping, if requested by the options
+   *
+   * The local error of each step is estimated from the difference between its displacement and the Taylor
+   * predictor u + dt * du_dt + dt^2 / 2 * d2u_dt2 built from the start of the step. This difference is scaled by
+   * 1/3, which makes it the leading error term of the average acceleration (trapezoidal Newmark) method.
+   *
+   * @param[in] options The timestepping options
+   * @param[in] comm The MPI communicator of the solution vectors
+   */
+  void SetTimestepControl(const TimesteppingOptions& options, MPI_Comm comm);
+
+  /**
+   * @brief The step size chosen by adaptive time stepping for the next step
+   *
+   * @param[in] dt The step size to return if adaptive time stepping is disabled, or no step has been taken yet
+   */
+  double SuggestedTimestep(double dt) const { return (controller_ && suggested_dt_ > 0.0) ? suggested_dt_ : dt; }
+
   /**
    * @brief Performs a time step
    *
    * @param[inout] x The predicted solution
    * @param[inout] dxdt The predicted rate
    * @param[inout] time The current time
-   * @param[inout] dt The desired time step
+   * @param[inout] dt The desired time step. With adaptive time stepping, this is an upper bound on the step size,
+   * and on output it is the size of the step that was actually taken.
    *
    * @see mfem::SecondOrderODESolver::Step
    */
   void Step(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt);
 
+  /**
+   * @brief Discard the history of the underlying ODE solver, e.g. after the solution has been reset to a checkpoint
+   */
+  void Restart()
+  {
+    if (second_order_ode_solver_) {
+      second_order_ode_solver_->Init(*this);
+    } else if (first_order_system_ode_solver_) {
+      first_order_system_ode_solver_->Init(*this);
+    }
+  }
+
   /**
    * @brief Get a reference to the current state
    */
   const State& GetState() { return state_; }
 
+  /**
+   * @brief The coefficients (c0, c1) of the current implicit solve, see State
+   *
+   * The Jacobian of the residual is a combination of the mass, damping and stiffness operators weighted by these
+   * coefficients, so a physics module may cache that combination (and its preconditioner) for as long as they are
+   * unchanged, e.g. across the stages and steps of a linear problem with a constant step size.
+   */
+  std::pair<double, double> GetImplicitCoefficients() const { return {state_.c0, state_.c1}; }
+
   /**
    * @brief Query the timestep method for the ode solver
    *
@@ -171,6 +217,16 @@ public:
   TimestepMethod GetTimestepper() { return timestepper_; }
 
 private:
+  /**
+   * @brief Take one step of the underlying ODE solver, without error control
+   *
+   * @param[inout] x The predicted solution
+   * @param[inout] dxdt The predicted rate
+   * @param[inout] time The current time
+   * @param[inout] dt The desired time step
+   */
+  void StepOnce(mfem::Vector& x, mfem::Vector& dxdt, double& time, double& dt);
+
   /**
    * @brief Internal implementation used for mfem::SOTDO::Mult and mfem::SOTDO::ImplicitSolve
    *        Solves the equation d2u_dt2 = f(u + c0 * d2u_dt2, du_dt + c1 * d2u_dt2, t)
@@ -223,6 +279,26 @@ private:
   mutable mfem::Vector d2U_dt2_;
 
   serac::TimestepMethod timestepper_;
+
+  /// @brief The step size controller, if adaptive time stepping is enabled
+  std::unique_ptr<TimestepController> controller_;
+
+  /// @brief The MPI communicator used to compute error norms
+  MPI_Comm comm_ = MPI_COMM_WORLD;
+
+  /// @brief The step size chosen for the next step by adaptive time stepping
+  double suggested_dt_ = 0.0;
+
+  /// @brief Whether every nonlinear solve of the current step has converged
+  mutable bool converged_ = true;
+
+  /**
+   * @brief Working vectors for restarting rejected steps and estimating the local error
+   */
+  mfem::Vector u_start_;
+  mfem::Vector du_dt_start_;
+  mfem::Vector d2u_dt2_start_;
+  mfem::Vector error_;
 };
 
 /**
@@ -239,7 +315,8 @@ class FirstOrderODE : public mfem::TimeDependentOperator {
 public:
   /**
    * @brief a small number used to compute finite difference approximations
-   * to time derivatives of boundary conditions.
+   * to time derivatives of boundary conditions, for the boundary conditions
+   * that don't provide them (see BoundaryCondition::hasTimeDerivatives).
    *
    * Note: this is intended to be temporary
    * Ideally, epsilon should be "small" relative to the characteristic
@@ -329,21 +406,99 @@ public:
    */
   void SetTimestepper(const serac::TimestepMethod timestepper);
 
+  /**
+   * @brief Compute the rates of the explicit methods (ForwardEuler, RK2, RK3SSP and RK4) directly, e.g. with a lumped
+   * mass, rather than by solving the residual equations for them
+   *
+   * @param[in] rate Overwrites the rates of the unconstrained dofs of its second argument at the true DOFs of its first
+   * one (whose constrained dofs, and their rates, are already set from the boundary conditions)
+   */
+  void SetExplicitRate(std::function<void(const mfem::Vector& u, mfem::Vector& du_dt)> rate)
+  {
+    explicit_rate_ = std::move(rate);
+  }
+
+  /// @brief Whether @a timestepper is one of the explicit methods, see SetExplicitRate()
+  static bool IsExplicit(const serac::TimestepMethod timestepper)
+  {
+    return timestepper == TimestepMethod::ForwardEuler || timestepper == TimestepMethod::RK2 ||
+           timestepper == TimestepMethod::RK3SSP || timestepper == TimestepMethod::RK4;
+  }
+
+  /// @brief A term of the residual, evaluated at a time and the true DOFs (with a rate of zero), see SetIMEXTerms()
+  using Term = std::function<void(double time, const mfem::Vector& u, mfem::Vector& r)>;
+
+  /**
+   * @brief Set the two terms of the residual r(u, du_dt) = M du_dt + r_I(u) + r_E(u) that the implicit-explicit
+   * methods (IMEXEuler and IMEXRK2) treat implicitly and explicitly, respectively
+   *
+   * Each stage solves the residual equations (with the solver given to the constructor) for the implicit term, with
+   * the explicit term (and the implicit term of earlier stages) entering through GetIMEXLoad(). The methods are
+   * Ascher, Ruuth and Spiteri's ARS(1,1,1) and ARS(2,2,2), whose implicit stages all have the same coefficient, see
+   * GetImplicitCoefficient(). So with a linear implicit term and a constant step, the Jacobian (and its
+   * preconditioner) can be reused across stages and steps.
+   *
+   * @param[in] implicit_term r_I: the residual with the explicit term left out, at a rate of zero
+   * @param[in] explicit_term r_E: the explicit term, e.g. stiff-free nonlinear sources
+   *
+   * @note The residual operator of the solver must add GetIMEXLoad() to its residual, and leave r_E out of it
+   */
+  void SetIMEXTerms(Term implicit_term, Term explicit_term)
+  {
+    implicit_term_ = std::move(implicit_term);
+    explicit_term_ = std::move(explicit_term);
+  }
+
+  /// @brief Whether @a timestepper is one of the implicit-explicit methods, see SetIMEXTerms()
+  static bool IsIMEX(const serac::TimestepMethod timestepper)
+  {
+    return timestepper == TimestepMethod::IMEXEuler || timestepper == TimestepMethod::IMEXRK2;
+  }
+
+  /**
+   * @brief The load that the residual operator adds to its residual during the stage solves of the implicit-explicit
+   * methods, or nullptr outside of them, see SetIMEXTerms()
+   */
+  const mfem::Vector* GetIMEXLoad() const { return imex_stage_ ? &imex_load_ : nullptr; }
+
+  /**
+   * @brief Enable adaptive time stepping, if requested by the options
+   *
+   * The local error of each step is estimated from the difference between its solution and the linear
+   * predictor u + dt * du_dt built from the start of the step, scaled by 1/2. This is the leading error term
+   * of backward Euler, and a conservative (first order) estimate for the higher order methods.
+   *
+   * @param[in] options The timestepping options
+   * @param[in] comm The MPI communicator of the solution vectors
+   */
+  void SetTimestepControl(const TimesteppingOptions& options, MPI_Comm comm);
+
+  /**
+   * @brief The step size chosen by adaptive time stepping for the next step
+   *
+   * @param[in] dt The step size to return if adaptive time stepping is disabled, or no step has been taken yet
+   */
+  double SuggestedTimestep(double dt) const { return (controller_ && suggested_dt_ > 0.0) ? suggested_dt_ : dt; }
+
   /**
    * @brief Performs a time step
    *
    * @param[inout] x The predicted solution
    * @param[inout] time The current time
-   * @param[inout] dt The desired time step
+   * @param[inout] dt The desired time step. With adaptive time stepping, this is an upper bound on the step size,
+   * and on output it is the size of the step that was actually taken.
    *
    * @see mfem::ODESolver::Step
    */
-  void Step(mfem::Vector& x, double& time, double& dt)
+  void Step(mfem::Vector& x, double& time, double& dt);
+
+  /**
+   * @brief Discard the history of the underlying ODE solver, e.g. after the solution has been reset to a checkpoint
+   */
+  void Restart()
   {
     if (ode_solver_) {
-      ode_solver_->Step(x, time, dt);
-    } else {
-      SLIC_ERROR("ode_solver_ unspecified");
+      ode_solver_->Init(*this);
     }
   }
 
@@ -354,7 +509,23 @@ public:
    */
   TimestepMethod GetTimestepper() { return timestepper_; }
 
+  /**
+   * @brief The coefficient dt of the current implicit solve, see State
+   *
+   * The Jacobian of the residual is M + dt K, so a physics module may cache it (and its preconditioner) for as long
+   * as this coefficient is unchanged, e.g. across the stages and steps of a linear problem with a constant step size.
+   */
+  double GetImplicitCoefficient() const { return state_.dt; }
+
 private:
+  /**
+   * @brief Take a step of one of the implicit-explicit methods, see SetIMEXTerms()
+   * @param[inout] x The solution
+   * @param[inout] time The current time
+   * @param[in] dt The time step
+   */
+  void IMEXStep(mfem::Vector& x, double& time, double dt);
+
   /**
    * @brief Internal implementation used for mfem::TDO::Mult and mfem::TDO::ImplicitSolve\
    * @param[in] time The current time
@@ -381,6 +552,33 @@ private:
    * @brief MFEM solver object for first-order ODEs
    */
   std::unique_ptr<mfem::ODESolver> ode_solver_;
+
+  /// @brief The direct computation of the rates of the explicit methods, if any, see SetExplicitRate()
+  std::function<void(const mfem::Vector& u, mfem::Vector& du_dt)> explicit_rate_;
+
+  /// @brief The terms of the residual that the implicit-explicit methods treat implicitly and explicitly
+  Term implicit_term_, explicit_term_;
+
+  /**
+   * @brief The Butcher tableaus of the implicit-explicit method: the coefficients of the implicit and explicit terms
+   * of each stage (the first of which is the start of the step), and the times of the stages (as fractions of the
+   * step)
+   */
+  std::vector<std::vector<double>> imex_implicit_, imex_explicit_;
+  std::vector<double>              imex_times_;
+
+  /// @brief The implicit and explicit terms at each stage of the implicit-explicit method
+  std::vector<mfem::Vector> imex_implicit_terms_, imex_explicit_terms_;
+
+  /// @brief The stage values of the implicit-explicit method, and the rates solved for at each stage
+  mfem::Vector imex_stage_value_;
+  mfem::Vector imex_rate_;
+
+  /// @brief The load of the stage solve of the implicit-explicit method, see GetIMEXLoad()
+  mfem::Vector imex_load_;
+
+  /// @brief Whether a stage of an implicit-explicit method is being solved
+  bool imex_stage_ = false;
   /**
    * @brief Reference to boundary conditions used to constrain the solution
    */
@@ -396,6 +594,25 @@ private:
   mutable mfem::Vector dU_dt_;
 
   TimestepMethod timestepper_;
+
+  /// @brief The step size controller, if adaptive time stepping is enabled
+  std::unique_ptr<TimestepController> controller_;
+
+  /// @brief The MPI communicator used to compute error norms
+  MPI_Comm comm_ = MPI_COMM_WORLD;
+
+  /// @brief The step size chosen for the next step by adaptive time stepping
+  double suggested_dt_ = 0.0;
+
+  /// @brief Whether every nonlinear solve of the current step has converged
+  mutable bool converged_ = true;
+
+  /**
+   * @brief Working vectors for restarting rejected steps and estimating the local error
+   */
+  mfem::Vector u_start_;
+  mfem::Vector du_dt_start_;
+  mfem::Vector error_;
 };
 
 }  // namespace serac::mfem_ext
@@ -0,0 +1,436 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/reduced_order_model.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/**
+ * @brief the eigenvalues and eigenvectors (the columns of @a eigenvectors) of a symmetric matrix, computed with the
+ * cyclic Jacobi method, which is accurate and simple for the small matrices of inner products of snapshots
+ */
+void symmetricEigensystem(mfem::DenseMatrix A, mfem::Vector& eigenvalues, mfem::DenseMatrix& eigenvectors)
+{
+  constexpr int max_sweeps = 100;
+
+  const int n = A.Height();
+
+  eigenvectors.SetSize(n);
+  eigenvectors = 0.0;
+  for (int i = 0; i < n; i++) {
+    eigenvectors(i, i) = 1.0;
+  }
+
+  for (int sweep = 0; sweep < max_sweeps; sweep++) {
+    double off_diagonal = 0.0;
+    double total        = 0.0;
+    for (int i = 0; i < n; i++) {
+      for (int j = 0; j < n; j++) {
+        total += A(i, j) * A(i, j);
+        off_diagonal += (i != j) ? A(i, j) * A(i, j) : 0.0;
+      }
+    }
+    if (off_diagonal <= 1.0e-30 * total) {
+      break;
+    }
+
+    // each rotation zeroes the entries (p, q) and (q, p), see Golub and Van Loan, "Matrix Computations", section 8.5
+    for (int p = 0; p < n; p++) {
+      for (int q = p + 1; q < n; q++) {
+        if (A(p, q) == 0.0) {
+          continue;
+        }
+
+        const double theta = (A(q, q) - A(p, p)) / (2.0 * A(p, q));
+        const double t     = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+        const double c     = 1.0 / std::sqrt(t * t + 1.0);
+        const double s     = t * c;
+
+        for (int k = 0; k < n; k++) {
+          const double a_kp = A(k, p);
+          const double a_kq = A(k, q);
+          A(k, p)           = c * a_kp - s * a_kq;
+          A(k, q)           = s * a_kp + c * a_kq;
+        }
+        for (int k = 0; k < n; k++) {
+          const double a_pk = A(p, k);
+          const double a_qk = A(q, k);
+          A(p, k)           = c * a_pk - s * a_qk;
+          A(q, k)           = s * a_pk + c * a_qk;
+        }
+        for (int k = 0; k < n; k++) {
+          const double v_kp  = eigenvectors(k, p);
+          const double v_kq  = eigenvectors(k, q);
+          eigenvectors(k, p) = c * v_kp - s * v_kq;
+          eigenvectors(k, q) = s * v_kp + c * v_kq;
+        }
+      }
+    }
+  }
+
+  eigenvalues.SetSize(n);
+  for (int i = 0; i < n; i++) {
+    eigenvalues(i) = A(i, i);
+  }
+}
+
+/// @brief the least squares solution of min |C_P z - b| over the columns P of C, from the normal equations
+mfem::Vector passiveLeastSquares(const mfem::DenseMatrix& C, const std::vector<int>& passive, const mfem::Vector& b)
+{
+  const int m = C.Height();
+  const int p = static_cast<int>(passive.size());
+
+  mfem::DenseMatrix normal_matrix(p);
+  mfem::Vector      rhs(p);
+  for (int i = 0; i < p; i++) {
+    const int col_i = passive[static_cast<size_t>(i)];
+    for (int j = 0; j <= i; j++) {
+      const int col_j = passive[static_cast<size_t>(j)];
+      double    dot   = 0.0;
+      for (int r = 0; r < m; r++) {
+        dot += C(r, col_i) * C(r, col_j);
+      }
+      normal_matrix(i, j) = normal_matrix(j, i) = dot;
+    }
+    double dot = 0.0;
+    for (int r = 0; r < m; r++) {
+      dot += C(r, col_i) * b(r);
+    }
+    rhs(i) = dot;
+  }
+
+  mfem::Vector             z(p);
+  mfem::DenseMatrixInverse inverse(normal_matrix);
+  inverse.Mult(rhs, z);
+  return z;
+}
+
+}  // namespace
+
+ReducedBasis::ReducedBasis(const std::vector<mfem::Vector>& snapshots, MPI_Comm comm, double tolerance, int max_size,
+                           const mfem::Array<int>& constrained_dofs)
+    : comm_(comm)
+{
+  SLIC_ERROR_ROOT_IF(snapshots.empty(), "A reduced basis needs at least one snapshot");
+  SLIC_ERROR_ROOT_IF(tolerance < 0.0 || tolerance >= 1.0, "The POD tolerance must be in [0, 1)");
+  SLIC_ERROR_ROOT_IF(max_size < 0, "The maximum size of a reduced basis must be non-negative");
+
+  const int m = static_cast<int>(snapshots.size());
+  const int n = snapshots[0].Size();
+
+  std::vector<mfem::Vector> S(snapshots.begin(), snapshots.end());
+  for (auto& snapshot : S) {
+    SLIC_ERROR_ROOT_IF(snapshot.Size() != n, "The snapshots of a reduced basis must all have the same size");
+    snapshot.SetSubVector(constrained_dofs, 0.0);
+  }
+
+  // the matrix of inner products of the snapshots, reduced over the ranks in one message
+  mfem::DenseMatrix gram(m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j <= i; j++) {
+      gram(i, j) = gram(j, i) = S[static_cast<size_t>(i)] * S[static_cast<size_t>(j)];
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, gram.Data(), m * m, MPI_DOUBLE, MPI_SUM, comm_);
+
+  mfem::Vector      eigenvalues;
+  mfem::DenseMatrix eigenvectors;
+  symmetricEigensystem(gram, eigenvalues, eigenvectors);
+
+  std::vector<int> order(static_cast<size_t>(m));
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](int a, int b) { return eigenvalues(a) > eigenvalues(b); });
+
+  double total = 0.0;
+  for (int i = 0; i < m; i++) {
+    total += std::max(eigenvalues(i), 0.0);
+  }
+
+  // the eigenvalues below roundoff of the largest one belong to the null space of the snapshots
+  const double rank_tolerance = 1.0e-14 * eigenvalues(order[0]);
+
+  std::vector<double> singular_values;
+  double              kept = 0.0;
+  for (int i : order) {
+    const double lambda = eigenvalues(i);
+    if ((max_size > 0 && size() == max_size) || lambda <= rank_tolerance || total - kept <= tolerance * total) {
+      break;
+    }
+
+    mfem::Vector phi(n);
+    phi = 0.0;
+    for (int j = 0; j < m; j++) {
+      phi.Add(eigenvectors(j, i), S[static_cast<size_t>(j)]);
+    }
+
+    // the method of snapshots loses orthogonality in roundoff for small singular values, so restore it
+    for (const auto& previous : basis_) {
+      phi.Add(-mfem::InnerProduct(comm_, previous, phi), previous);
+    }
+    phi /= std::sqrt(mfem::InnerProduct(comm_, phi, phi));
+
+    basis_.push_back(std::move(phi));
+    singular_values.push_back(std::sqrt(lambda));
+    kept += lambda;
+  }
+
+  singular_values_.SetSize(size());
+  for (int k = 0; k < size(); k++) {
+    singular_values_(k) = singular_values[static_cast<size_t>(k)];
+  }
+}
+
+void ReducedBasis::project(const mfem::Vector& x, mfem::Vector& a) const
+{
+  a.SetSize(size());
+  for (int k = 0; k < size(); k++) {
+    a(k) = basis_[static_cast<size_t>(k)] * x;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, a.GetData(), size(), MPI_DOUBLE, MPI_SUM, comm_);
+}
+
+void ReducedBasis::expand(const mfem::Vector& a, mfem::Vector& x) const
+{
+  x.SetSize(vectorSize());
+  x = 0.0;
+  for (int k = 0; k < size(); k++) {
+    x.Add(a(k), basis_[static_cast<size_t>(k)]);
+  }
+}
+
+mfem::DenseMatrix ReducedBasis::projectOperator(const mfem::Operator& A) const
+{
+  mfem::DenseMatrix projected(size());
+  mfem::Vector      A_phi(A.Height());
+  for (int j = 0; j < size(); j++) {
+    A.Mult(basis_[static_cast<size_t>(j)], A_phi);
+    for (int i = 0; i < size(); i++) {
+      projected(i, j) = basis_[static_cast<size_t>(i)] * A_phi;
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, projected.Data(), size() * size(), MPI_DOUBLE, MPI_SUM, comm_);
+  return projected;
+}
+
+ReducedNewtonSolver::ReducedNewtonSolver(std::shared_ptr<const ReducedBasis> basis, MPI_Comm comm)
+    : mfem::NewtonSolver(comm), basis_(std::move(basis))
+{
+  SLIC_ERROR_ROOT_IF(!basis_, "A reduced Newton solver needs a basis");
+}
+
+void ReducedNewtonSolver::Mult(const mfem::Vector& b, mfem::Vector& x) const
+{
+  SLIC_ERROR_ROOT_IF(!oper, "The operator of a reduced Newton solver must be set (use SetOperator)");
+  SLIC_ERROR_ROOT_IF(basis_->size() > 0 && basis_->vectorSize() != x.Size(),
+                     "The basis of a reduced Newton solver does not match the size of the solution");
+
+  mfem::Vector r(oper->Height());
+  mfem::Vector r_reduced, da, dx;
+
+  // the norm of the reduced residual V^T (F(x) - b)
+  auto evaluate = [&]() {
+    oper->Mult(x, r);
+    if (b.Size() == r.Size()) {
+      r -= b;
+    }
+    basis_->project(r, r_reduced);
+    return r_reduced.Norml2();
+  };
+
+  double norm = initial_norm = evaluate();
+  double norm_goal           = std::max(rel_tol * initial_norm, abs_tol);
+
+  converged = false;
+
+  int it = 0;
+  for (; true; it++) {
+    if (print_options.iterations) {
+      mfem::out << "Reduced Newton iteration " << std::setw(3) << it << " : ||V^T r|| = " << std::setw(13) << norm
+                << '\n';
+    }
+
+    if (norm <= norm_goal) {
+      converged = true;
+      break;
+    } else if (it >= max_iter) {
+      break;
+    }
+
+    // the Galerkin projection of the Jacobian is a small dense matrix, which is solved directly
+    mfem::DenseMatrix        J_reduced = basis_->projectOperator(oper->GetGradient(x));
+    mfem::DenseMatrixInverse inverse(J_reduced);
+    inverse.Mult(r_reduced, da);
+
+    basis_->expand(da, dx);
+    x -= dx;
+
+    norm = evaluate();
+  }
+
+  final_iter = it;
+  final_norm = norm;
+}
+
+mfem::DenseMatrix elementContributions(const ReducedBasis&                                        basis,
+                                       const std::vector<std::unique_ptr<mfem::HypreParMatrix>>& gradients)
+{
+  SLIC_ERROR_ROOT_IF(gradients.empty(), "Element sampling needs the gradients of at least one snapshot");
+
+  const int k            = basis.size();
+  const int num_elements = gradients[0]->Width();
+
+  mfem::DenseMatrix contributions(static_cast<int>(gradients.size()) * k, num_elements);
+  mfem::Vector      column(num_elements);
+  for (size_t s = 0; s < gradients.size(); s++) {
+    for (int i = 0; i < k; i++) {
+      // row i of V^T dR/dw is the action of the transposed gradient on the basis vector
+      gradients[s]->MultTranspose(basis[i], column);
+      for (int e = 0; e < num_elements; e++) {
+        contributions(static_cast<int>(s) * k + i, e) = column(e);
+      }
+    }
+  }
+  return contributions;
+}
+
+ElementSample energyConservingSampling(const mfem::DenseMatrix& contributions, double tolerance)
+{
+  SLIC_ERROR_ROOT_IF(tolerance <= 0.0, "The ECSW tolerance must be positive");
+
+  const mfem::DenseMatrix& C = contributions;
+  const int                m = C.Height();
+  const int                n = C.Width();
+
+  // the reduced residuals integrated over every element, which the sample should reproduce
+  mfem::Vector ones(n);
+  ones = 1.0;
+  mfem::Vector target(m);
+  C.Mult(ones, target);
+
+  const double goal = tolerance * target.Norml2();
+
+  mfem::Vector w(n);
+  w = 0.0;
+  mfem::Vector residual(target);
+  mfem::Vector gradient(n);
+
+  std::vector<int>  passive;
+  std::vector<char> is_passive(static_cast<size_t>(n), false);
+  std::vector<char> excluded(static_cast<size_t>(n), false);
+
+  // one element per row of C can already reproduce the target exactly, so the passive set never needs to be larger
+  while (residual.Norml2() > goal && static_cast<int>(passive.size()) < std::min(m, n)) {
+    // add the element whose weight most decreases the residual
+    C.MultTranspose(residual, gradient);
+    int next = -1;
+    for (int e = 0; e < n; e++) {
+      if (!is_passive[static_cast<size_t>(e)] && !excluded[static_cast<size_t>(e)] &&
+          gradient(e) > (next < 0 ? 0.0 : gradient(next))) {
+        next = e;
+      }
+    }
+    if (next < 0) {
+      break;
+    }
+    passive.push_back(next);
+    is_passive[static_cast<size_t>(next)] = true;
+
+    // move towards the unconstrained solution on the passive set, dropping the elements whose weights reach zero
+    for (bool first = true; !passive.empty(); first = false) {
+      mfem::Vector z = passiveLeastSquares(C, passive, target);
+
+      if (first && z(static_cast<int>(passive.size()) - 1) <= 0.0) {
+        // only possible in roundoff, when the new element cannot decrease the residual after all
+        excluded[static_cast<size_t>(next)]   = true;
+        is_passive[static_cast<size_t>(next)] = false;
+        passive.pop_back();
+        break;
+      }
+
+      double alpha = 1.0;
+      for (size_t i = 0; i < passive.size(); i++) {
+        if (z(static_cast<int>(i)) <= 0.0) {
+          const double w_i = w(passive[i]);
+          alpha            = std::min(alpha, w_i / (w_i - z(static_cast<int>(i))));
+        }
+      }
+
+      for (size_t i = 0; i < passive.size(); i++) {
+        const double w_i = w(passive[i]);
+        w(passive[i])    = w_i + alpha * (z(static_cast<int>(i)) - w_i);
+      }
+
+      if (alpha == 1.0) {
+        break;
+      }
+
+      for (auto it = passive.begin(); it != passive.end();) {
+        if (w(*it) <= 0.0) {
+          w(*it)                               = 0.0;
+          is_passive[static_cast<size_t>(*it)] = false;
+          it                                   = passive.erase(it);
+        } else {
+          ++it;
+        }
+      }
+    }
+
+    C.Mult(w, residual);
+    subtract(target, residual, residual);
+  }
+
+  ElementSample sample;
+  for (int e = 0; e < n; e++) {
+    if (w(e) > 0.0) {
+      sample.elements.push_back(e);
+      sample.weights.push_back(w(e));
+    }
+  }
+  return sample;
+}
+
+Domain sampledDomain(const mfem::Mesh& mesh, const ElementSample& sample)
+{
+  Domain output{mesh, mesh.SpaceDimension()};
+
+  int    count[mfem::Geometry::NUM_GEOMETRIES]{};
+  size_t next = 0;
+  for (int i = 0; i < mesh.GetNE(); i++) {
+    auto geom = mesh.GetElementGeometry(i);
+    if (next < sample.elements.size() && sample.elements[next] == i) {
+      auto [ids, mfem_ids] = output.ids(geom);
+      ids.push_back(count[geom]);
+      mfem_ids.push_back(i);
+      next++;
+    }
+    count[geom]++;
+  }
+
+  SLIC_ERROR_ROOT_IF(next != sample.elements.size(), "The sampled elements must be local elements, in order");
+
+  return output;
+}
+
+mfem::Vector sampleWeights(const ElementSample& sample, int num_elements)
+{
+  mfem::Vector weights(num_elements);
+  weights = 0.0;
+  for (size_t i = 0; i < sample.elements.size(); i++) {
+    weights(sample.elements[i]) = sample.weights[i];
+  }
+  return weights;
+}
+
+}  // namespace serac
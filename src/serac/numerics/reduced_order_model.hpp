@@ -0,0 +1,177 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file reduced_order_model.hpp
+ *
+ * @brief Proper orthogonal decomposition bases, Galerkin-projected Newton solves and element sampling for
+ * hyper-reduced reduced-order models
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/functional/domain.hpp"
+
+namespace serac {
+
+/**
+ * @brief An orthonormal basis for the span of a set of snapshots, computed by proper orthogonal decomposition (POD)
+ *
+ * The basis is computed with the method of snapshots: the eigenvectors of the (small) matrix of inner products of
+ * the snapshots give the combinations of the snapshots that make up each basis vector. The snapshots are
+ * distributed vectors of true dofs, e.g. the states returned by BasePhysics::snapshots().
+ */
+class ReducedBasis {
+public:
+  /**
+   * @brief Compute the POD basis of a set of snapshots
+   *
+   * @param snapshots The snapshots, which must all have the same (local) size
+   * @param comm The MPI communicator of the snapshots
+   * @param tolerance The fraction of the snapshot energy (the sum of the squared singular values) that the basis may
+   * leave out
+   * @param max_size The maximum number of basis vectors, or 0 for no limit
+   * @param constrained_dofs Local dofs (e.g. essential boundary conditions) that are zeroed in every basis vector, so
+   * that reduced solves never change them
+   */
+  ReducedBasis(const std::vector<mfem::Vector>& snapshots, MPI_Comm comm, double tolerance = 1.0e-8,
+               int max_size = 0, const mfem::Array<int>& constrained_dofs = mfem::Array<int>());
+
+  /// @brief The number of basis vectors
+  int size() const { return static_cast<int>(basis_.size()); }
+
+  /// @brief The (local) size of each basis vector
+  int vectorSize() const { return basis_.empty() ? 0 : basis_[0].Size(); }
+
+  /// @brief The @a k-th basis vector
+  const mfem::Vector& operator[](int k) const { return basis_[static_cast<size_t>(k)]; }
+
+  /// @brief The singular values of the snapshots that correspond to each basis vector, in decreasing order
+  const mfem::Vector& singularValues() const { return singular_values_; }
+
+  /**
+   * @brief The coefficients of the projection of @a x onto the basis, a = V^T x
+   * @note @a a is the same on every rank
+   */
+  void project(const mfem::Vector& x, mfem::Vector& a) const;
+
+  /// @brief The combination of the basis vectors with coefficients @a a, x = V a
+  void expand(const mfem::Vector& a, mfem::Vector& x) const;
+
+  /**
+   * @brief The Galerkin projection V^T A V of an operator onto the basis, computed with one action of @a A for each
+   * basis vector
+   */
+  mfem::DenseMatrix projectOperator(const mfem::Operator& A) const;
+
+private:
+  /// The MPI communicator of the basis vectors
+  MPI_Comm comm_;
+
+  /// The orthonormal basis vectors
+  std::vector<mfem::Vector> basis_;
+
+  /// The singular values of the snapshots that correspond to each basis vector
+  mfem::Vector singular_values_;
+};
+
+/**
+ * @brief A Newton solver for the Galerkin projection of a nonlinear system onto a ReducedBasis
+ *
+ * The solution is sought in the form x = x_0 + V a, where x_0 is the initial guess, by solving V^T F(x) = 0 for the
+ * coefficients a. Each iteration evaluates the full residual and the action of its gradient on each basis vector, and
+ * solves the resulting dense system of the size of the basis, so the (unused) linear solver of an EquationSolver
+ * built with this solver is never called.
+ *
+ * To solve a physics module in the reduced space, construct it with an EquationSolver that uses this solver, e.g.
+ * @code{.cpp}
+ * auto basis = std::make_shared<ReducedBasis>(snapshots, comm, 1.0e-8, 0, essential_dofs);
+ * auto rom   = std::make_unique<EquationSolver>(std::make_unique<ReducedNewtonSolver>(basis, comm),
+ *                                               std::make_unique<mfem::CGSolver>(comm));
+ * @endcode
+ * Its essential boundary conditions are then set by the module in the initial guess, as usual.
+ *
+ * @note convergence is measured with the norm of the reduced residual V^T F(x)
+ */
+class ReducedNewtonSolver : public mfem::NewtonSolver {
+public:
+  /**
+   * @brief Construct a reduced Newton solver
+   *
+   * @param basis The basis of the reduced space
+   * @param comm The MPI communicator of the nonlinear system
+   */
+  ReducedNewtonSolver(std::shared_ptr<const ReducedBasis> basis, MPI_Comm comm);
+
+  /// @brief Solve F(x) = b in the reduced space, starting from (and keeping the constrained dofs of) @a x
+  void Mult(const mfem::Vector& b, mfem::Vector& x) const override;
+
+private:
+  /// The basis of the reduced space
+  std::shared_ptr<const ReducedBasis> basis_;
+};
+
+/**
+ * @brief A sample of the elements of a mesh and their weights, which approximates integrals over all of the elements
+ * (see energyConservingSampling())
+ */
+struct ElementSample {
+  /// The local indices of the sampled elements, in increasing order
+  std::vector<int> elements;
+
+  /// The weight of each sampled element
+  std::vector<double> weights;
+};
+
+/**
+ * @brief The contributions of each local element to the reduced residuals of a set of snapshots, for training an
+ * ElementSample with energyConservingSampling()
+ *
+ * The residual is expected to take a piecewise constant (L2<0>) field w of element weights, and scale its integrand
+ * by w, so that R(u, w) = sum_e w_e R_e(u). The contribution of element e to the reduced residual of snapshot s is
+ * then the column e of V^T dR/dw(u_s, 1).
+ *
+ * @param basis The basis of the reduced space
+ * @param gradients The assembled gradients dR/dw, evaluated at each snapshot with w = 1
+ * @return a matrix with one row for each (snapshot, basis vector) pair, and one column for each local element
+ */
+mfem::DenseMatrix elementContributions(const ReducedBasis&                                        basis,
+                                       const std::vector<std::unique_ptr<mfem::HypreParMatrix>>& gradients);
+
+/**
+ * @brief Select a sparse set of weighted elements with the energy-conserving sampling and weighting method (ECSW)
+ *
+ * The weights solve the non-negative least squares problem min |C w - C 1| for w >= 0 with the active set method of
+ * Lawson and Hanson, which is stopped early once |C w - C 1| <= tolerance |C 1|. Each rank samples its own elements,
+ * so that the sampled integrals of each rank reproduce its part of the reduced residuals.
+ *
+ * @param contributions The contributions of each element to the reduced residuals, see elementContributions()
+ * @param tolerance The relative error in the reduced residuals of the training snapshots
+ * @return the sampled elements and their weights
+ */
+ElementSample energyConservingSampling(const mfem::DenseMatrix& contributions, double tolerance);
+
+/**
+ * @brief The domain of the sampled elements of @a mesh, on which the hyper-reduced residual is integrated
+ * @note the integrand is weighted by passing the field returned by sampleWeights() as the L2<0> weight argument
+ */
+Domain sampledDomain(const mfem::Mesh& mesh, const ElementSample& sample);
+
+/**
+ * @brief The piecewise constant field of element weights for the hyper-reduced residual, which is zero away from
+ * the sampled elements
+ *
+ * @param sample The sampled elements and their weights
+ * @param num_elements The number of local elements
+ */
+mfem::Vector sampleWeights(const ElementSample& sample, int num_elements);
+
+}  // namespace serac
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <limits>
+#include <string>
 #include <variant>
 
 #include "mfem.hpp"
@@ -36,6 +38,8 @@ enum class TimestepMethod
   ImplicitMidpoint, /**< FirstOrderODE option */
   SDIRK23,          /**< FirstOrderODE option */
   SDIRK34,          /**< FirstOrderODE option */
+  IMEXEuler,        /**< FirstOrderODE option, implicit-explicit, see FirstOrderODE::SetIMEXTerms() */
+  IMEXRK2,          /**< FirstOrderODE option, implicit-explicit, see FirstOrderODE::SetIMEXTerms() */
 
   // options for second order ODEs
   //
@@ -87,6 +91,39 @@ enum class DirichletEnforcementMethod
   FullControl
 };
 
+/**
+ * @brief The initial guess used for the Newton solve of each quasi-static step
+ */
+enum class Predictor
+{
+  /**
+   * (default value)
+   * LinearizedBoundaryConditions for SolidMechanics and PreviousState for HeatTransfer
+   */
+  Default,
+
+  /// The solution of the previous step, with the essential boundary conditions of the new step
+  PreviousState,
+
+  /**
+   * The previous solution plus a linear solve for the response to the change in essential boundary conditions (and
+   * parameters), using a Jacobian reassembled at the beginning of the step
+   */
+  LinearizedBoundaryConditions,
+
+  /**
+   * As LinearizedBoundaryConditions, but reusing the Jacobian and preconditioner of the last Newton iteration of the
+   * previous step, so that no matrix is assembled or factored
+   */
+  PreviousJacobian,
+
+  /**
+   * Polynomial extrapolation in time through the last (extrapolation_order + 1) converged states, with the essential
+   * boundary conditions of the new step
+   */
+  Extrapolation
+};
+
 /// A timestep and boundary condition enforcement method for a dynamic solver
 struct TimesteppingOptions {
   /// The timestepping method to be applied
@@ -94,16 +131,77 @@ struct TimesteppingOptions {
 
   /// The essential boundary enforcement method to use
   DirichletEnforcementMethod enforcement_method = DirichletEnforcementMethod::RateControl;
+
+  /**
+   * @brief Whether to choose the step sizes of transient solves by controlling an estimate of the local error
+   *
+   * When enabled, each step is accepted only if its weighted error estimate is below one, and otherwise (or if its
+   * nonlinear solve fails) it is retried with a smaller step. The step size requested from a physics module is then
+   * an upper bound, and suggestedTimestep() gives the size chosen for the next step.
+   */
+  bool adaptive = false;
+
+  /// Relative tolerance on the local error estimate of adaptive time stepping
+  double error_relative_tol = 1.0e-4;
+
+  /// Absolute tolerance on the local error estimate of adaptive time stepping
+  double error_absolute_tol = 1.0e-8;
+
+  /// The smallest step that adaptive time stepping may take before giving up
+  double min_dt = 1.0e-12;
+
+  /// The largest step that adaptive time stepping may take
+  double max_dt = std::numeric_limits<double>::max();
+
+  /// The maximum number of times adaptive time stepping may retry a step with a smaller step size
+  int max_rejections = 10;
+
+  /// The maximum number of times a quasi-static step may be cut in half after its nonlinear solve fails to converge
+  int max_cutbacks = 0;
+
+  /**
+   * @brief When positive, quasi-static steps are taken as load increments sized to need about this many Newton
+   * iterations each
+   *
+   * Each increment is scaled by sqrt(target / iterations) of the previous one (by at most a factor of two either
+   * way), within [min_dt, max_dt], and halved whenever its nonlinear solve fails. The step size requested from a
+   * physics module is then the load increment to cover, e.g. a whole load ramp, and the increment size is carried
+   * over to the next request.
+   */
+  int target_nonlinear_iterations = 0;
+
+  /// The fraction of the estimated critical timestep suggested for explicit solid dynamics (CentralDifference) and
+  /// heat transfer (ForwardEuler, RK2, RK3SSP and RK4)
+  double cfl_number = 0.9;
+
+  /// The initial guess for the Newton solve of each quasi-static step
+  Predictor predictor = Predictor::Default;
+
+  /// The degree of the polynomial used by Predictor::Extrapolation (1 or 2)
+  int extrapolation_order = 2;
+
+  /**
+   * @brief Whether transient solves may reuse the Jacobian M + dt K and its preconditioner for as long as dt is
+   * unchanged, i.e. across the stages of an SDIRK method and across steps of the same size
+   *
+   * @note This is only valid for residuals that are linear in the solution and its rate, with coefficients that do
+   * not depend on time, and for fixed parameters and shape displacement
+   */
+  bool reuse_linear_jacobian = false;
 };
 
 // _linear_solvers_start
 /// Linear solution method indicator
 enum class LinearSolver
 {
-  CG,       /**< Conjugate gradient */
-  GMRES,    /**< Generalized minimal residual method */
-  SuperLU,  /**< SuperLU MPI-enabled direct nodal solver */
-  Strumpack /**< Strumpack MPI-enabled direct frontal solver*/
+  CG,          /**< Conjugate gradient */
+  PipelinedCG, /**< Pipelined conjugate gradient, which overlaps its single global reduction per iteration with the
+                    preconditioner and operator applications, for latency-bound solves on many ranks */
+  RecyclingCG, /**< Deflated conjugate gradient, which recycles approximate eigenvectors of the smallest eigenvalues
+                    from one solve to the next, see LinearSolverOptions::recycle_dimension */
+  GMRES,       /**< Generalized minimal residual method */
+  SuperLU,     /**< SuperLU MPI-enabled direct nodal solver */
+  Strumpack    /**< Strumpack MPI-enabled direct frontal solver*/
 };
 // _linear_solvers_end
 
@@ -119,12 +217,28 @@ enum class NonlinearSolver
   NewtonLineSearch, /**< Custom solver using preconditioned earch direction with backtracking line search */
   Nesterov,         /**< Custom solver using Nesterov dynamic (damped) dynamics for accelerating implicit solves */
   TrustRegion,      /**< Custom solver using a trust region solver */
+  AndersonNewton,   /**< Custom Newton solver with Anderson mixing of the Newton updates */
   KINFullStep,      /**< KINSOL Full Newton (Sundials must be enabled) */
   KINBacktrackingLineSearch, /**< KINSOL Newton with Backtracking Line Search (Sundials must be enabled) */
   KINPicard                  /**< KINSOL Picard (Sundials must be enabled) */
 };
 // _nonlinear_solvers_end
 
+/// How Newton-type solvers choose the relative tolerance of each linear solve (the "forcing term" of inexact Newton)
+enum class ForcingTerm
+{
+  Fixed,            /**< Always use LinearSolverOptions::relative_tol */
+  EisenstatWalker1, /**< Eisenstat-Walker choice 1: based on how well the last linear model predicted the residual */
+  EisenstatWalker2  /**< Eisenstat-Walker choice 2: based on the last reduction in the residual norm */
+};
+
+/// How the NewtonLineSearch solver chooses the next trial step after rejecting one
+enum class LineSearchMethod
+{
+  Backtracking, /**< Halve the step, and then try the opposite direction if that keeps failing */
+  Interpolation /**< Minimize a quadratic (then cubic) model of the merit function 0.5 ||r||^2 along the step */
+};
+
 /**
  * @brief Solver types supported by AMGX
  */
@@ -168,13 +282,35 @@ struct AMGXOptions {
 /// The type of preconditioner to be used
 enum class Preconditioner
 {
-  HypreJacobi,      /**< Hypre-based Jacobi */
-  HypreL1Jacobi,    /**< Hypre-based L1-scaled Jacobi */
-  HypreGaussSeidel, /**< Hypre-based Gauss-Seidel */
-  HypreAMG,         /**< Hypre's BoomerAMG algebraic multi-grid */
-  HypreILU,         /**< Hypre's Incomplete LU */
-  AMGX,             /**< NVIDIA's AMGX GPU-enabled algebraic multi-grid, GPU builds only */
-  None              /**< No preconditioner used */
+  HypreJacobi,        /**< Hypre-based Jacobi */
+  HypreL1Jacobi,      /**< Hypre-based L1-scaled Jacobi */
+  HypreGaussSeidel,   /**< Hypre-based Gauss-Seidel */
+  HypreAMG,           /**< Hypre's BoomerAMG algebraic multi-grid */
+  HypreILU,           /**< Hypre's Incomplete LU */
+  AMGX,               /**< NVIDIA's AMGX GPU-enabled algebraic multi-grid, GPU builds only */
+  Jacobi,             /**< Jacobi using the operator's diagonal, does not require an assembled matrix */
+  Chebyshev,          /**< Chebyshev smoother using the operator's diagonal, does not require an assembled matrix */
+  GeometricMultigrid, /**< Geometric multigrid over the levels of StateManager::setMeshHierarchy(), with Chebyshev
+                           smoothers and a BoomerAMG coarse solve, does not require an assembled matrix */
+  PMultigrid,         /**< Multigrid over the polynomial orders p, p/2, ..., 1 on the same mesh, with Chebyshev
+                           smoothers and a BoomerAMG solve of the assembled p = 1 operator, does not require an
+                           assembled matrix */
+  LOR,                /**< BoomerAMG on the p = 1 operator of the low-order refined mesh of the high-order space,
+                           does not require an assembled matrix */
+  BlockSchur,         /**< For 2x2 saddle-point block systems (e.g. Lagrange multiplier contact), BoomerAMG on the
+                           first block and Jacobi on a diagonally approximated Schur complement of the second, in
+                           a block lower triangular sweep. BoomerAMG for assembled matrices. */
+  SuperLU,            /**< A SuperLU factorization of the assembled matrix, so that the outer Krylov solver does
+                           iterative refinement. With max_preconditioner_reuse, the (symbolic and numeric)
+                           factorization is lagged over several Newton iterations. */
+  Strumpack,          /**< As SuperLU, with a Strumpack factorization (Strumpack must be enabled) */
+  PetscBDDC,          /**< PETSc's balancing domain decomposition by constraints, on the assembled matrix converted
+                           to PETSc's unassembled (MATIS) format, further configured by
+                           LinearSolverOptions::petsc_options (PETSc must be enabled) */
+  Petsc,              /**< A PETSc preconditioner (PC) of the assembled matrix, chosen and configured entirely by
+                           LinearSolverOptions::petsc_options, e.g. "-pc_type gamg" or "-pc_type fieldsplit ..."
+                           (PETSc must be enabled) */
+  None                /**< No preconditioner used */
 };
 // _preconditioners_end
 
@@ -201,6 +337,54 @@ struct LinearSolverOptions {
 
   /// Debugging print level for the preconditioner
   int preconditioner_print_level = 0;
+
+  /**
+   * Keep the linearized operator unassembled (matrix-free) when the physics module supports it.
+   * This requires an iterative linear solver and one of the Jacobi, Chebyshev, GeometricMultigrid,
+   * PMultigrid, LOR, or None preconditioners
+   */
+  bool matrix_free = false;
+
+  /**
+   * Eliminate the element-interior dofs (e.g. most of the dofs of high-order hexahedra), element by element, when the
+   * physics module supports it. The linear solver and preconditioner then act on the much smaller assembled Schur
+   * complement of the skeleton dofs, see StaticCondensation
+   */
+  bool static_condensation = false;
+
+  /**
+   * @brief Maximum number of times a preconditioner setup (e.g. the BoomerAMG hierarchy) is reused when the
+   * linear solver is given an operator whose values have changed in place.
+   *
+   * The default of 0 rebuilds the preconditioner for every new operator. With reuse, the Krylov solver still
+   * uses the exact operator, only the preconditioner lags behind. Operators that are replaced by a different
+   * object (rather than updated in place) always trigger a rebuild.
+   */
+  int max_preconditioner_reuse = 0;
+
+  /// Number of levels of aggressive coarsening used by BoomerAMG, which makes its setup cheaper but less effective
+  int amg_aggressive_coarsening_levels = 0;
+
+  /**
+   * @brief The number of approximate eigenvectors kept between solves by LinearSolver::RecyclingCG
+   *
+   * The subspace is owned by the linear solver, so it persists across the Newton iterations and timesteps of an
+   * EquationSolver. Each solve stores up to twice this many search directions to update it.
+   */
+  int recycle_dimension = 8;
+
+  /**
+   * @brief Options for the Petsc and PetscBDDC preconditioners, in PETSc's command line format
+   * (e.g. "-pc_type gamg -pc_gamg_threshold 0.02")
+   *
+   * They are added to PETSc's options database under petsc_prefix. The Krylov solver is still linear_solver, so
+   * KSP options only apply to nested solvers (e.g. the ones of a fieldsplit preconditioner).
+   */
+  std::string petsc_options = "";
+
+  /// @brief The prefix of petsc_options in PETSc's options database, which tells apart the solvers of different
+  /// physics modules
+  std::string petsc_prefix = "";
 };
 // _linear_options_end
 
@@ -225,9 +409,134 @@ struct NonlinearSolverOptions {
   /// Maximum line search cutbacks
   int max_line_search_iterations = 0;
 
+  /**
+   * @brief How the line search chooses each cutback
+   *
+   * Interpolation fits the merit function from its value and slope at the current iterate (one Jacobian-vector
+   * product) and its values at the rejected trial steps, so it usually needs far fewer residual evaluations than
+   * backtracking by halves. It requires a descent direction, falling back to halving otherwise.
+   */
+  LineSearchMethod line_search_method = LineSearchMethod::Backtracking;
+
   /// Debug print level
   int print_level = 0;
+
+  /**
+   * @brief Maximum number of Newton iterations that may share one Jacobian (and preconditioner).
+   *
+   * The default of 1 reassembles them on every iteration (full Newton), larger values give a
+   * "modified Newton" method that trades extra iterations for fewer assemblies and preconditioner setups.
+   * The residual is always evaluated exactly. Only used by the Newton and NewtonLineSearch solvers.
+   */
+  int max_jacobian_reuse = 1;
+
+  /**
+   * @brief When reusing a Jacobian, it is reassembled as soon as an iteration fails to reduce
+   * the residual norm by at least this factor (i.e. when ||r_{k+1}|| > jacobian_reuse_rate * ||r_k||)
+   */
+  double jacobian_reuse_rate = 0.5;
+
+  /// Whether the Jacobian and preconditioner from the end of one nonlinear solve may be reused by the next one
+  bool reuse_jacobian_across_solves = false;
+
+  /**
+   * @brief How the relative tolerance of each linear solve is chosen.
+   *
+   * The adaptive (Eisenstat-Walker) choices loosen the linear tolerance in early iterations, where solving
+   * the linearized system accurately is wasted effort, and tighten it again near convergence. They never go
+   * below LinearSolverOptions::relative_tol or above max_forcing_term. Only used by the Newton, NewtonLineSearch
+   * and TrustRegion solvers.
+   */
+  ForcingTerm forcing_term = ForcingTerm::Fixed;
+
+  /// The loosest relative linear solve tolerance that an adaptive forcing term may use
+  double max_forcing_term = 0.9;
+
+  /// The number of previous Newton updates mixed by the AndersonNewton solver
+  int anderson_depth = 5;
+
+  /**
+   * @brief Whether the residual is declared linear in the unknowns, e.g. LinearIsotropicConductor heat transfer or
+   * LinearIsotropic solid mechanics with GeometricNonlinearities::Off
+   *
+   * Each solve is then a single linear solve x = x0 - J^{-1} r(x0), without evaluating the residual again to check
+   * convergence, and the physics modules reuse the Jacobian and its preconditioner (e.g. a factorization or an AMG
+   * hierarchy) for every solve that has the same Jacobian, i.e. the whole run for quasi-static problems and every
+   * step of the same size for transient ones. Only used by the Newton and NewtonLineSearch solvers.
+   *
+   * @note The residual must also have coefficients that do not depend on time, and the parameters and shape
+   * displacement must not change between solves
+   */
+  bool linear = false;
 };
 // _nonlinear_options_end
 
+/// How the solves of coupled physics modules are combined within a timestep
+enum class CouplingScheme
+{
+  Staggered,  /**< One solve of each module in turn, without iterating between them */
+  Monolithic, /**< Newton's method on the fully coupled system, using the block Jacobian of all modules */
+  FixedPoint  /**< Staggered solves repeated until the exchanged fields converge */
+};
+
+/// Acceleration methods for the fixed-point iterations of a coupled solve
+enum class FixedPointAcceleration
+{
+  None,    /**< Constant relaxation */
+  Aitken,  /**< Dynamic Aitken relaxation */
+  Anderson /**< Anderson mixing over a window of previous iterates */
+};
+
+/// Block preconditioners for the Jacobian of a monolithic coupled solve
+enum class BlockPreconditioner
+{
+  BlockDiagonal,    /**< Precondition each field independently, ignoring the coupling blocks */
+  BlockGaussSeidel, /**< Block lower triangular (forward Gauss-Seidel) sweep over the fields */
+  SchurComplement   /**< Block lower triangular sweep using a diagonally approximated Schur complement */
+};
+
+/// Parameters for combining the solves of coupled physics modules
+struct CouplingOptions {
+  /// The coupling scheme
+  CouplingScheme scheme = CouplingScheme::Staggered;
+
+  /// The block preconditioner for the linearized monolithic system
+  BlockPreconditioner block_preconditioner = BlockPreconditioner::SchurComplement;
+
+  /// Relative tolerance on the norm of the coupled residual, or for the fixed-point scheme, on the change in the
+  /// exchanged field relative to its norm
+  double relative_tol = 1.0e-8;
+
+  /// Absolute tolerance on the norm of the coupled residual, or for the fixed-point scheme, on the change in the
+  /// exchanged field
+  double absolute_tol = 1.0e-12;
+
+  /// Maximum number of coupling iterations per timestep
+  int max_iterations = 20;
+
+  /// Relative tolerance for the (GMRES) solves of the linearized monolithic system
+  double linear_relative_tol = 1.0e-6;
+
+  /// Maximum number of iterations for the solves of the linearized monolithic system
+  int linear_max_iterations = 200;
+
+  /// Debug print level
+  int print_level = 0;
+
+  /// The acceleration method for the fixed-point coupling scheme
+  FixedPointAcceleration acceleration = FixedPointAcceleration::Aitken;
+
+  /// The relaxation factor of the first fixed-point iteration (and of every iteration for constant relaxation)
+  double relaxation = 0.5;
+
+  /// The number of previous iterates used by Anderson mixing
+  int anderson_depth = 5;
+
+  /// The number of thermal substeps taken in each timestep of a staggered multi-rate solve
+  int thermal_substeps = 1;
+
+  /// The number of solid mechanics substeps taken in each timestep of a staggered multi-rate solve
+  int solid_substeps = 1;
+};
+
 }  // namespace serac
@@ -0,0 +1,306 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/static_condensation.hpp"
+
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/numerics/functional/functional.hpp"
+
+namespace serac {
+
+StaticCondensation::StaticCondensation(const mfem::ParFiniteElementSpace& space)
+    : mfem::Operator(space.GetTrueVSize()), space_(space)
+{
+  bool h1 = space.FEColl()->GetContType() == mfem::FiniteElementCollection::CONTINUOUS;
+  SLIC_ERROR_ROOT_IF(space.Nonconforming() || !h1, "Static condensation requires a conforming H1 space");
+
+  const int vdim = space.GetVDim();
+
+  interior_.assign(std::size_t(space.GetVSize()), false);
+  mfem::Array<int> dofs;
+  for (int e = 0; e < space.GetNE(); e++) {
+    space.GetElementInteriorDofs(e, dofs);
+    for (int dof : dofs) {
+      for (int c = 0; c < vdim; c++) {
+        interior_[std::size_t(space.DofToVDof(dof, c))] = true;
+      }
+    }
+  }
+
+  // the interior dofs are never shared with other ranks, so every skeleton dof is a copy of a skeleton true dof
+  skeleton_index_.assign(std::size_t(space.GetTrueVSize()), -1);
+  for (int vdof = 0; vdof < space.GetVSize(); vdof++) {
+    int tdof = space.GetLocalTDofNumber(vdof);
+    if (tdof >= 0 && !interior_[std::size_t(vdof)]) {
+      skeleton_index_[std::size_t(tdof)] = 0;
+    }
+  }
+  for (int tdof = 0; tdof < space.GetTrueVSize(); tdof++) {
+    if (skeleton_index_[std::size_t(tdof)] == 0) {
+      skeleton_index_[std::size_t(tdof)] = skeleton_tdofs_.Size();
+      skeleton_tdofs_.Append(tdof);
+    }
+  }
+
+  HYPRE_BigInt num_skeleton_tdofs = skeleton_tdofs_.Size();
+  MPI_Scan(&num_skeleton_tdofs, &skeleton_offset_, 1, HYPRE_MPI_BIG_INT, MPI_SUM, space.GetComm());
+  skeleton_offset_ -= num_skeleton_tdofs;
+
+  // the global skeleton numbers of the local vdofs owned by other ranks are prolongated from their owners, and
+  // doubles represent them exactly
+  mfem::Vector numbers(space.GetTrueVSize()), local_numbers(space.GetVSize());
+  numbers = -1.0;
+  for (int k = 0; k < skeleton_tdofs_.Size(); k++) {
+    numbers(skeleton_tdofs_[k]) = double(skeleton_offset_ + k);
+  }
+  space.GetProlongationMatrix()->Mult(numbers, local_numbers);
+
+  skeleton_numbers_.resize(std::size_t(space.GetVSize()));
+  for (int vdof = 0; vdof < space.GetVSize(); vdof++) {
+    bool interior                        = interior_[std::size_t(vdof)];
+    skeleton_numbers_[std::size_t(vdof)] = interior ? -1 : HYPRE_BigInt(std::llround(local_numbers(vdof)));
+  }
+
+  // each skeleton dof of an element couples to (at most) all the skeleton dofs of that element
+  row_sizes_.assign(std::size_t(skeleton_tdofs_.Size()), 0);
+  mfem::Array<int> vdofs;
+  for (int e = 0; e < space.GetNE(); e++) {
+    space.GetElementVDofs(e, vdofs);
+
+    HYPRE_Int num_skeleton = 0;
+    for (int vdof : vdofs) {
+      num_skeleton += interior_[std::size_t(vdof)] ? 0 : 1;
+    }
+
+    for (int vdof : vdofs) {
+      HYPRE_BigInt row = skeleton_numbers_[std::size_t(vdof)];
+      if (row < 0) continue;
+
+      if (skeleton_offset_ <= row && row < skeleton_offset_ + num_skeleton_tdofs) {
+        row_sizes_[std::size_t(row - skeleton_offset_)] += num_skeleton;
+      } else {
+        off_rank_entries_ += num_skeleton;
+      }
+    }
+  }
+}
+
+void StaticCondensation::setEssentialTrueDofs(const mfem::Array<int>& ess_tdofs)
+{
+  essential_skeleton_dofs_.SetSize(0);
+  for (int tdof : ess_tdofs) {
+    int k = skeleton_index_[std::size_t(tdof)];
+    SLIC_ERROR_ROOT_IF(k < 0, "Essential boundary conditions can only constrain skeleton dofs");
+    essential_skeleton_dofs_.Append(k);
+  }
+}
+
+void StaticCondensation::beginAssembly()
+{
+  SLIC_ERROR_ROOT_IF(ij_, "The last assembly of the Schur complement hasn't been finished");
+
+  elements_.clear();
+
+  HYPRE_BigInt row_begin = skeleton_offset_;
+  HYPRE_BigInt row_end   = row_begin + skeleton_tdofs_.Size();
+  HYPRE_IJMatrixCreate(space_.GetComm(), row_begin, row_end - 1, row_begin, row_end - 1, &ij_);
+  HYPRE_IJMatrixSetObjectType(ij_, HYPRE_PARCSR);
+  HYPRE_IJMatrixSetRowSizes(ij_, row_sizes_.data());
+  HYPRE_IJMatrixSetMaxOffProcElmts(ij_, off_rank_entries_);
+  HYPRE_IJMatrixInitialize(ij_);
+}
+
+void StaticCondensation::addElementMatrix(const mfem::Array<int>& vdofs, const mfem::DenseMatrix& K_e)
+{
+  SLIC_ERROR_IF(!ij_, "beginAssembly() must be called before adding element matrices");
+  SLIC_ERROR_IF(K_e.Height() != vdofs.Size() || K_e.Width() != vdofs.Size(), "Element matrices must be square");
+
+  // the positions of the interior and skeleton dofs in the element matrix
+  mfem::Array<int> interior, skeleton;
+  for (int k = 0; k < vdofs.Size(); k++) {
+    (interior_[std::size_t(vdofs[k])] ? interior : skeleton).Append(k);
+  }
+
+  if (interior.Size() == 0) {
+    addToSchurComplement(vdofs, K_e);
+    return;
+  }
+
+  Element element;
+  element.interior_tdofs.SetSize(interior.Size());
+  element.skeleton_vdofs.SetSize(skeleton.Size());
+  for (int k = 0; k < interior.Size(); k++) {
+    element.interior_tdofs[k] = space_.GetLocalTDofNumber(vdofs[interior[k]]);
+  }
+  for (int k = 0; k < skeleton.Size(); k++) {
+    element.skeleton_vdofs[k] = vdofs[skeleton[k]];
+  }
+
+  mfem::DenseMatrix S_e;
+  K_e.GetSubMatrix(interior, interior, element.A_ii_inv);
+  K_e.GetSubMatrix(interior, skeleton, element.A_ib);
+  K_e.GetSubMatrix(skeleton, interior, element.A_bi);
+  K_e.GetSubMatrix(skeleton, skeleton, S_e);
+  element.A_ii_inv.Invert();
+
+  // S_e = A_bb - A_bi A_ii^{-1} A_ib
+  mfem::DenseMatrix A_ii_inv_A_ib(interior.Size(), skeleton.Size());
+  mfem::Mult(element.A_ii_inv, element.A_ib, A_ii_inv_A_ib);
+  mfem::AddMult_a(-1.0, element.A_bi, A_ii_inv_A_ib, S_e);
+
+  addToSchurComplement(element.skeleton_vdofs, S_e);
+  elements_.push_back(std::move(element));
+}
+
+void StaticCondensation::addToSchurComplement(const mfem::Array<int>& vdofs, const mfem::DenseMatrix& S_e)
+{
+  std::vector<HYPRE_BigInt> numbers(std::size_t(vdofs.Size()));
+  for (int k = 0; k < vdofs.Size(); k++) {
+    numbers[std::size_t(k)] = skeleton_numbers_[std::size_t(vdofs[k])];
+  }
+
+  // hypre takes the values by row, and mfem stores them by column
+  HYPRE_Int           ncols = vdofs.Size();
+  std::vector<double> row(std::size_t(ncols));
+  for (int i = 0; i < vdofs.Size(); i++) {
+    for (int j = 0; j < vdofs.Size(); j++) {
+      row[std::size_t(j)] = S_e(i, j);
+    }
+    HYPRE_IJMatrixAddToValues(ij_, 1, &ncols, &numbers[std::size_t(i)], numbers.data(), row.data());
+  }
+}
+
+void StaticCondensation::endAssembly()
+{
+  SERAC_MARK_FUNCTION;
+  SLIC_ERROR_IF(!ij_, "beginAssembly() must be called before endAssembly()");
+
+  HYPRE_IJMatrixAssemble(ij_);
+
+  // keep the ParCSR matrix when destroying the IJ interface to it, like mfem does
+  hypre_ParCSRMatrix* S;
+  HYPRE_IJMatrixGetObject(ij_, reinterpret_cast<void**>(&S));
+  HYPRE_IJMatrixSetObjectType(ij_, -1);
+  HYPRE_IJMatrixDestroy(ij_);
+  ij_ = nullptr;
+
+  // hypre's smoothers expect the diagonal entry of each row first
+  hypre_CSRMatrixReorder(hypre_ParCSRMatrixDiag(S));
+
+  auto S_new = std::make_unique<mfem::HypreParMatrix>(S);
+  std::unique_ptr<mfem::HypreParMatrix> eliminated(S_new->EliminateRowsCols(essential_skeleton_dofs_));
+
+  // the storage of S_ is kept when the pattern is unchanged, so that the solver of the condensed system sees the
+  // same operator (and may reuse its preconditioner)
+  refillOrReplace(S_, std::move(S_new));
+}
+
+mfem::HypreParMatrix& StaticCondensation::schurComplement() const
+{
+  SLIC_ERROR_ROOT_IF(!S_, "The Schur complement has not been assembled yet");
+  return *S_;
+}
+
+void StaticCondensation::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  SLIC_ERROR_ROOT_IF(!action_, "setAction() must be called before applying a StaticCondensation");
+  action_->Mult(x, y);
+}
+
+void StaticCondensation::condense(const mfem::Vector& r, mfem::Vector& r_b) const
+{
+  SERAC_MARK_FUNCTION;
+
+  // the corrections of the elements are added up at their local skeleton dofs, and then their true dofs
+  mfem::Vector correction(space_.GetVSize()), true_correction(space_.GetTrueVSize());
+  mfem::Vector r_i, w, A_bi_w;
+  correction = 0.0;
+  for (const auto& element : elements_) {
+    r.GetSubVector(element.interior_tdofs, r_i);
+    w.SetSize(r_i.Size());
+    A_bi_w.SetSize(element.skeleton_vdofs.Size());
+    element.A_ii_inv.Mult(r_i, w);
+    element.A_bi.Mult(w, A_bi_w);
+    correction.AddElementVector(element.skeleton_vdofs, -1.0, A_bi_w);
+  }
+  space_.GetProlongationMatrix()->MultTranspose(correction, true_correction);
+  true_correction += r;
+
+  true_correction.GetSubVector(skeleton_tdofs_, r_b);
+  r_b.SetSubVector(essential_skeleton_dofs_, 0.0);
+}
+
+void StaticCondensation::recover(const mfem::Vector& r, const mfem::Vector& du_b, mfem::Vector& du) const
+{
+  SERAC_MARK_FUNCTION;
+
+  du.SetSize(space_.GetTrueVSize());
+  du = 0.0;
+  du.SetSubVector(skeleton_tdofs_, du_b);
+
+  mfem::Vector du_local(space_.GetVSize());
+  space_.GetProlongationMatrix()->Mult(du, du_local);
+
+  // du_i = A_ii^{-1} (r_i - A_ib du_b)
+  mfem::Vector du_e, rhs, du_i;
+  for (const auto& element : elements_) {
+    du_local.GetSubVector(element.skeleton_vdofs, du_e);
+    r.GetSubVector(element.interior_tdofs, rhs);
+    element.A_ib.AddMult(du_e, rhs, -1.0);
+
+    du_i.SetSize(rhs.Size());
+    element.A_ii_inv.Mult(rhs, du_i);
+    du.SetSubVector(element.interior_tdofs, du_i);
+  }
+}
+
+StaticCondensationSolver::StaticCondensationSolver(std::unique_ptr<mfem::Solver> solver, MPI_Comm comm)
+    : mfem::IterativeSolver(comm), solver_(std::move(solver))
+{
+}
+
+void StaticCondensationSolver::SetOperator(const mfem::Operator& op)
+{
+  height = op.Height();
+  width  = op.Width();
+
+  condensation_ = dynamic_cast<const StaticCondensation*>(&op);
+  solver_->SetOperator(condensation_ ? condensation_->schurComplement() : op);
+}
+
+void StaticCondensationSolver::Mult(const mfem::Vector& r, mfem::Vector& du) const
+{
+  if (auto* iterative = dynamic_cast<mfem::IterativeSolver*>(solver_.get())) {
+    iterative->SetRelTol(rel_tol);
+    iterative->SetAbsTol(abs_tol);
+  }
+  solver_->iterative_mode = iterative_mode;
+
+  if (condensation_) {
+    condensation_->condense(r, r_b_);
+    if (iterative_mode) {
+      condensation_->restrictToSkeleton(du, du_b_);
+    } else {
+      du_b_.SetSize(r_b_.Size());
+      du_b_ = 0.0;
+    }
+    solver_->Mult(r_b_, du_b_);
+    condensation_->recover(r, du_b_, du);
+  } else {
+    solver_->Mult(r, du);
+  }
+
+  // direct solvers of the condensed systems always converge
+  auto* iterative = dynamic_cast<const mfem::IterativeSolver*>(solver_.get());
+  final_iter      = iterative ? iterative->GetNumIterations() : 1;
+  final_norm      = iterative ? iterative->GetFinalNorm() : 0.0;
+  converged       = iterative ? iterative->GetConverged() : true;
+}
+
+}  // namespace serac
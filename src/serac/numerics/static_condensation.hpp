@@ -0,0 +1,216 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file static_condensation.hpp
+ *
+ * @brief The elimination of element-interior dofs from linear systems assembled from element matrices
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/**
+ * @brief Eliminates the element-interior dofs of an H1 space from a linear system K du = r, element by element
+ *
+ * The interior dofs of an element (e.g. most of the dofs of high-order hexahedra) only couple to the dofs of that same
+ * element. So, with the element matrix split into its skeleton (b) and interior (i) dofs,
+ *
+ *     [ A_bb  A_bi ] [ du_b ]   [ r_b ]
+ *     [ A_ib  A_ii ] [ du_i ] = [ r_i ],
+ *
+ * the interior dofs of each element are eliminated on their own, and only the Schur complement
+ * S = sum_e (A_bb - A_bi A_ii^{-1} A_ib) of the skeleton dofs (the ones on the vertices, edges and faces of the
+ * elements) is assembled. After solving S du_b = r_b - sum_e A_bi A_ii^{-1} r_i, the interior dofs are recovered from
+ * du_i = A_ii^{-1} (r_i - A_ib du_b), element by element again.
+ *
+ * The Schur complement has far fewer rows and nonzero entries than K, which makes high-order systems much cheaper to
+ * store and to set up (e.g. algebraic multigrid) for. The skeleton dofs are numbered in the order of the true dofs
+ * they come from, so their blocks by component (and the ordering of a vector-valued space) are the same as in K.
+ *
+ * As an mfem::Operator, this is the action of K (see setAction()), so that it can be handed to nonlinear solvers as
+ * the Jacobian, with a StaticCondensationSolver as their linear solver.
+ */
+class StaticCondensation : public mfem::Operator {
+public:
+  /**
+   * @brief Prepare the condensation of the interior dofs of the elements of @a space
+   * @note @a space must be a conforming H1 space, and has to outlive this
+   */
+  explicit StaticCondensation(const mfem::ParFiniteElementSpace& space);
+
+  /// @brief the number of skeleton dofs owned by this rank, the size of the condensed system
+  int numSkeletonTrueDofs() const { return skeleton_tdofs_.Size(); }
+
+  /**
+   * @brief set the essential true dofs, whose rows and columns of the Schur complement are replaced by the identity,
+   * and whose entries of the condensed right hand side are 0
+   * @note essential dofs can only be skeleton dofs, and the rows and columns of the element matrices of any
+   * essential dofs must be the ones of K before eliminating them
+   */
+  void setEssentialTrueDofs(const mfem::Array<int>& ess_tdofs);
+
+  /**
+   * @brief compute the Schur complement from the element matrices of @a K, e.g. a Functional's gradient
+   * @tparam ElementMatrices a type with a member forEachElementMatrix(f), see Functional's Gradient
+   */
+  template <typename ElementMatrices>
+  void assemble(ElementMatrices& K)
+  {
+    beginAssembly();
+    K.forEachElementMatrix([this](const mfem::Array<int>& test_vdofs, const mfem::Array<int>&,
+                                  const mfem::DenseMatrix& K_e) { addElementMatrix(test_vdofs, K_e); });
+    endAssembly();
+  }
+
+  /// @brief start assembling the Schur complement of new element matrices
+  void beginAssembly();
+
+  /**
+   * @brief eliminate the interior dofs of the element matrix @a K_e, and add its Schur complement
+   * @param vdofs the local vdofs of the rows (and columns) of @a K_e
+   * @param K_e the element matrix, which must be square. All the element matrices of an element with interior dofs
+   * have to be added together before they are added here.
+   */
+  void addElementMatrix(const mfem::Array<int>& vdofs, const mfem::DenseMatrix& K_e);
+
+  /// @brief finish assembling the Schur complement, see schurComplement()
+  void endAssembly();
+
+  /// @brief the Schur complement of the skeleton dofs, with the essential dofs eliminated
+  mfem::HypreParMatrix& schurComplement() const;
+
+  /// @brief set the operator (e.g. a matrix-free Jacobian) that Mult() applies, which must outlive this
+  void setAction(const mfem::Operator& K) { action_ = &K; }
+
+  /// @brief apply the action of K given to setAction()
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /**
+   * @brief the skeleton right hand side of the condensed system, r_b - sum_e A_bi A_ii^{-1} r_i
+   * @param r the right hand side (as a true dof vector)
+   * @param r_b the condensed right hand side (as a skeleton true dof vector)
+   */
+  void condense(const mfem::Vector& r, mfem::Vector& r_b) const;
+
+  /**
+   * @brief recover the solution of K du = r from the solution of the condensed system
+   * @param r the right hand side (as a true dof vector)
+   * @param du_b the solution of the condensed system (as a skeleton true dof vector)
+   * @param du the solution (as a true dof vector)
+   */
+  void recover(const mfem::Vector& r, const mfem::Vector& du_b, mfem::Vector& du) const;
+
+  /// @brief the entries of a true dof vector @a x at the skeleton dofs
+  void restrictToSkeleton(const mfem::Vector& x, mfem::Vector& x_b) const
+  {
+    x.GetSubVector(skeleton_tdofs_, x_b);
+  }
+
+private:
+  /// @brief the parts of an element matrix with interior dofs that are needed to condense and recover
+  struct Element {
+    mfem::Array<int>  interior_tdofs;  ///< the (local) true dofs of the interior dofs
+    mfem::Array<int>  skeleton_vdofs;  ///< the local vdofs of the skeleton dofs
+    mfem::DenseMatrix A_ii_inv;        ///< the inverse of the interior block
+    mfem::DenseMatrix A_ib;            ///< the interior rows of the skeleton columns
+    mfem::DenseMatrix A_bi;            ///< the skeleton rows of the interior columns
+  };
+
+  /// @brief add the element Schur complement @a S_e of the skeleton dofs @a vdofs to the assembled one
+  void addToSchurComplement(const mfem::Array<int>& vdofs, const mfem::DenseMatrix& S_e);
+
+  /// the space of the dofs
+  const mfem::ParFiniteElementSpace& space_;
+
+  /// whether each local vdof is interior to an element
+  std::vector<bool> interior_;
+
+  /// the local true dofs of the skeleton dofs, by skeleton true dof
+  mfem::Array<int> skeleton_tdofs_;
+
+  /// the skeleton true dof of each local true dof, -1 for interior dofs
+  std::vector<int> skeleton_index_;
+
+  /// the global number of the skeleton dof of each local vdof, -1 for interior dofs
+  std::vector<HYPRE_BigInt> skeleton_numbers_;
+
+  /// the global number of the first skeleton dof owned by this rank
+  HYPRE_BigInt skeleton_offset_ = 0;
+
+  /// the (estimated) number of entries of each owned row of the Schur complement
+  std::vector<HYPRE_Int> row_sizes_;
+
+  /// the (estimated) number of entries of rows owned by other ranks added by this one
+  HYPRE_Int off_rank_entries_ = 0;
+
+  /// the skeleton true dofs that are essential
+  mfem::Array<int> essential_skeleton_dofs_;
+
+  /// the elements with interior dofs of the last assembly
+  std::vector<Element> elements_;
+
+  /// the Schur complement being assembled
+  HYPRE_IJMatrix ij_ = nullptr;
+
+  /// the assembled Schur complement
+  std::unique_ptr<mfem::HypreParMatrix> S_;
+
+  /// the operator that Mult() applies
+  const mfem::Operator* action_ = nullptr;
+};
+
+/**
+ * @brief Solves K du = r through the condensed system of a StaticCondensation given as the operator
+ *
+ * The condensed system is solved by another (e.g. Krylov) solver, and this reports its iteration counts and
+ * convergence as if they were its own, so that it can stand in for it in nonlinear solvers. Its tolerances are passed
+ * on to that solver for every solve. Operators other than a StaticCondensation (e.g. the assembled matrices of
+ * adjoint solves) go straight to the other solver.
+ */
+class StaticCondensationSolver : public mfem::IterativeSolver {
+public:
+  /**
+   * @brief Construct the solver
+   * @param[in] solver The solver of the condensed systems
+   * @param[in] comm The MPI communicator used by the vectors in the solve
+   */
+  StaticCondensationSolver(std::unique_ptr<mfem::Solver> solver, MPI_Comm comm);
+
+  /// @brief The solver of the condensed systems
+  mfem::Solver& underlying() { return *solver_; }
+
+  /**
+   * @brief Set the operator, handing its Schur complement to the solver of the condensed systems
+   * @param[in] op a StaticCondensation, whose Schur complement has been assembled, or any other operator
+   */
+  void SetOperator(const mfem::Operator& op) override;
+
+  /**
+   * @brief Solve K du = r
+   * @param[in] r the right hand side
+   * @param[inout] du the solution, and the initial guess if iterative_mode is set
+   */
+  void Mult(const mfem::Vector& r, mfem::Vector& du) const override;
+
+private:
+  /// @brief The solver of the condensed systems
+  std::unique_ptr<mfem::Solver> solver_;
+
+  /// @brief The condensation of the operator, if it is one
+  const StaticCondensation* condensation_ = nullptr;
+
+  /// @brief The skeleton right hand side and solution of the condensed system
+  mutable mfem::Vector r_b_, du_b_;
+};
+
+}  // namespace serac
@@ -112,7 +112,585 @@ TEST_P(EquationSolverSuite, All)
   }
 }
 
+/**
+ * @brief solve the same nonlinear problem as EquationSolverSuite with the given options, check the solution,
+ * and return the number of Jacobian evaluations
+ *
+ * @a check, if given, is called with the solver after the solve, e.g. to check its telemetry
+ */
+int solveSinProblem(const NonlinearSolverOptions& nonlin_opts, const LinearSolverOptions& lin_opts,
+                    int& num_iterations, const std::function<void(const EquationSolver&)>& check = {})
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(2, 2, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  pmesh.EnsureNodes();
+  pmesh.ExchangeFaceNbrData();
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  auto                        fec = mfem::H1_FECollection(p, dim);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::HypreParVector x_exact(&fes);
+  mfem::HypreParVector x_computed(&fes);
+
+  std::unique_ptr<mfem::HypreParMatrix> J;
+
+  Functional<H1<p>(H1<p>)> residual(&fes, {&fes});
+
+  x_exact.Randomize(0);
+
+  residual.AddDomainIntegral(
+      Dimension<dim>{}, DependsOn<0>{},
+      [&](double /*t*/, auto, auto scalar) {
+        auto [u, du_dx] = scalar;
+        auto source     = 0.5 * sin(u);
+        auto flux       = du_dx;
+        return serac::tuple{source, flux};
+      },
+      pmesh);
+
+  int num_jacobians = 0;
+
+  StdFunctionOperator residual_opr(
+      fes.TrueVSize(),
+      [&x_exact, &residual](const mfem::Vector& x, mfem::Vector& r) {
+        double dummy_time = 0.0;
+
+        const mfem::Vector res = residual(dummy_time, x);
+
+        r = res;
+        r -= residual(dummy_time, x_exact);
+      },
+      [&residual, &J, &num_jacobians](const mfem::Vector& x) -> mfem::Operator& {
+        double dummy_time = 0.0;
+        auto [val, grad]  = residual(dummy_time, differentiate_wrt(x));
+        // like the physics modules, the Jacobian is refilled in place, so reusable preconditioners see the same matrix
+        assemble(grad, J);
+        num_jacobians++;
+        return *J;
+      });
+
+  EquationSolver eq_solver(nonlin_opts, lin_opts);
+
+  eq_solver.setOperator(residual_opr);
+
+  eq_solver.solve(x_computed);
+
+  EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+
+  for (int i = 0; i < x_computed.Size(); ++i) {
+    EXPECT_LT(std::abs((x_computed(i) - x_exact(i))) / x_exact(i), 1.0e-6);
+  }
+
+  num_iterations = eq_solver.nonlinearSolver().GetNumIterations();
+  if (check) {
+    check(eq_solver);
+  }
+  return num_jacobians;
+}
+
+TEST(EquationSolver, ModifiedNewtonReusesJacobian)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-10,
+                                        .absolute_tol   = 1.0e-12,
+                                        .max_iterations = 500,
+                                        .print_level    = 1};
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver       = NonlinearSolver::Newton,
+                                              .relative_tol        = 1.0e-10,
+                                              .absolute_tol        = 1.0e-12,
+                                              .max_iterations      = 100,
+                                              .print_level         = 1,
+                                              .max_jacobian_reuse  = 5,
+                                              .jacobian_reuse_rate = 0.9};
+
+  int num_iterations = 0;
+  int num_jacobians  = solveSinProblem(nonlin_opts, lin_opts, num_iterations);
+  EXPECT_LT(num_jacobians, num_iterations);
+}
+
+TEST(EquationSolver, JacobianExpectedAtTheEvaluatedResidual)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::None,
+                                        .relative_tol   = 1.0e-10,
+                                        .absolute_tol   = 1.0e-12,
+                                        .max_iterations = 500,
+                                        .print_level    = 1};
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                              .relative_tol   = 1.0e-10,
+                                              .absolute_tol   = 1.0e-12,
+                                              .max_iterations = 100,
+                                              .print_level    = 1};
+
+  EquationSolver eq_solver(nonlin_opts, lin_opts);
+
+  // F(x) = x + x^3 - 1, which records whether each gradient was announced by the residual evaluation before it
+  mfem::Vector      expected_at;
+  int               num_jacobians = 0;
+  int               num_expected  = 0;
+  mfem::DenseMatrix J;
+
+  StdFunctionOperator residual_opr(
+      4,
+      [&](const mfem::Vector& x, mfem::Vector& r) {
+        for (int i = 0; i < x.Size(); i++) {
+          r(i) = x(i) + x(i) * x(i) * x(i) - 1.0;
+        }
+        expected_at.SetSize(0);
+        if (eq_solver.jacobianExpected()) {
+          expected_at = x;
+        }
+      },
+      [&](const mfem::Vector& x) -> mfem::Operator& {
+        J.SetSize(x.Size());
+        J = 0.0;
+        for (int i = 0; i < x.Size(); i++) {
+          J(i, i) = 1.0 + 3.0 * x(i) * x(i);
+        }
+        num_jacobians++;
+        if (expected_at.Size() == x.Size() && expected_at.DistanceSquaredTo(x) == 0.0) {
+          num_expected++;
+        }
+        return J;
+      });
+
+  eq_solver.setOperator(residual_opr);
+
+  mfem::Vector x(4);
+  x = 0.0;
+  eq_solver.solve(x);
+
+  EXPECT_TRUE(eq_solver.nonlinearSolver().GetConverged());
+  EXPECT_GT(num_jacobians, 1);
+  EXPECT_EQ(num_expected, num_jacobians);
+  EXPECT_FALSE(eq_solver.jacobianExpected());
+}
+
+TEST(EquationSolver, EisenstatWalkerForcingTerms)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-10,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 1};
+
+  // the total number of Krylov iterations of each solve, which converge to the same solution
+  auto linear_iterations = [&lin_opts](NonlinearSolver nonlin_solver, ForcingTerm forcing_term) {
+    const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = nonlin_solver,
+                                                .relative_tol   = 1.0e-10,
+                                                .absolute_tol   = 1.0e-12,
+                                                .max_iterations = 100,
+                                                .print_level    = 1,
+                                                .forcing_term   = forcing_term};
+
+    int num_iterations = 0;
+    int iterations     = 0;
+    solveSinProblem(nonlin_opts, lin_opts, num_iterations, [&iterations](const EquationSolver& eq_solver) {
+      iterations = eq_solver.telemetry().linear_iterations;
+    });
+    return iterations;
+  };
+
+  for (auto nonlin_solver : {NonlinearSolver::Newton, NonlinearSolver::NewtonLineSearch}) {
+    // the tight linear tolerance is only needed close to the solution
+    int fixed = linear_iterations(nonlin_solver, ForcingTerm::Fixed);
+    EXPECT_GT(fixed, 0);
+    for (auto forcing_term : {ForcingTerm::EisenstatWalker1, ForcingTerm::EisenstatWalker2}) {
+      EXPECT_LT(linear_iterations(nonlin_solver, forcing_term), fixed);
+    }
+  }
+}
+
+TEST(EquationSolver, AndersonAcceleratedNewton)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-10,
+                                        .absolute_tol   = 1.0e-12,
+                                        .max_iterations = 500,
+                                        .print_level    = 1};
+
+  // mixing recovers much of the convergence rate that reusing the Jacobian gives up
+  NonlinearSolverOptions nonlin_opts = {.nonlin_solver       = NonlinearSolver::Newton,
+                                        .relative_tol        = 1.0e-10,
+                                        .absolute_tol        = 1.0e-12,
+                                        .max_iterations      = 100,
+                                        .print_level         = 1,
+                                        .max_jacobian_reuse  = 5,
+                                        .jacobian_reuse_rate = 0.9};
+
+  int modified_newton_iterations = 0;
+  solveSinProblem(nonlin_opts, lin_opts, modified_newton_iterations);
+
+  nonlin_opts.nonlin_solver = NonlinearSolver::AndersonNewton;
+
+  int anderson_iterations = 0;
+  solveSinProblem(nonlin_opts, lin_opts, anderson_iterations);
+  EXPECT_LE(anderson_iterations, modified_newton_iterations);
+}
+
+TEST(EquationSolver, TrustRegionWithSmallerRadiusRetries)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::HypreJacobi,
+                                        .relative_tol   = 1.0e-10,
+                                        .absolute_tol   = 1.0e-12,
+                                        .max_iterations = 500,
+                                        .print_level    = 1};
+
+  // rejected steps are retried with smaller radii along the stored dogleg path
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver              = NonlinearSolver::TrustRegion,
+                                              .relative_tol               = 1.0e-10,
+                                              .absolute_tol               = 1.0e-12,
+                                              .max_iterations             = 100,
+                                              .max_line_search_iterations = 10,
+                                              .print_level                = 1};
+
+  int num_iterations = 0;
+  solveSinProblem(nonlin_opts, lin_opts, num_iterations);
+}
+
+TEST(EquationSolver, InterpolatingLineSearch)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::CG,
+                                        .preconditioner = Preconditioner::None,
+                                        .relative_tol   = 1.0e-12,
+                                        .absolute_tol   = 1.0e-14,
+                                        .max_iterations = 500,
+                                        .print_level    = 1};
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver              = NonlinearSolver::NewtonLineSearch,
+                                              .relative_tol               = 1.0e-10,
+                                              .absolute_tol               = 1.0e-12,
+                                              .max_iterations             = 100,
+                                              .max_line_search_iterations = 10,
+                                              .line_search_method         = LineSearchMethod::Interpolation,
+                                              .print_level                = 1};
+
+  EquationSolver eq_solver(nonlin_opts, lin_opts);
+
+  // F(x) = atan(x), for which full Newton steps from |x| > 1.39 overshoot the root by more and more
+  std::vector<mfem::Vector> iterates;
+  mfem::DenseMatrix         J;
+
+  StdFunctionOperator residual_opr(
+      4,
+      [](const mfem::Vector& x, mfem::Vector& r) {
+        for (int i = 0; i < x.Size(); i++) {
+          r(i) = std::atan(x(i));
+        }
+      },
+      [&](const mfem::Vector& x) -> mfem::Operator& {
+        J.SetSize(x.Size());
+        J = 0.0;
+        for (int i = 0; i < x.Size(); i++) {
+          J(i, i) = 1.0 / (1.0 + x(i) * x(i));
+        }
+        iterates.push_back(x);
+        return J;
+      });
+
+  eq_solver.setOperator(residual_opr);
+
+  mfem::Vector x(4);
+  x = 2.0;
+  eq_solver.solve(x);
+  iterates.push_back(x);
+
+  const auto& telemetry = eq_solver.telemetry();
+  EXPECT_TRUE(telemetry.converged);
+  EXPECT_LT(x.Normlinf(), 1.0e-10);
+  EXPECT_GT(telemetry.line_search_cutbacks, 0);
+
+  // each accepted step s (the Newton step c scaled by the line search) satisfies the sufficient decrease condition
+  // of the line search, 0.5 |F(x - s c)|^2 <= 0.5 |F(x)|^2 - 1e-4 s |F(x)|^2
+  constexpr double sufficient_decrease = 1.0e-4;
+  for (std::size_t k = 0; k + 1 < iterates.size(); k++) {
+    const mfem::Vector& x0 = iterates[k];
+    const mfem::Vector& x1 = iterates[k + 1];
+
+    double step_scale = (x0(0) - x1(0)) / (std::atan(x0(0)) * (1.0 + x0(0) * x0(0)));
+    EXPECT_GT(step_scale, 0.0);
+    EXPECT_LE(step_scale, 1.0 + 1.0e-8);
+
+    double phi0 = 0.0;
+    double phi1 = 0.0;
+    for (int i = 0; i < x0.Size(); i++) {
+      phi0 += 0.5 * std::atan(x0(i)) * std::atan(x0(i));
+      phi1 += 0.5 * std::atan(x1(i)) * std::atan(x1(i));
+    }
+    EXPECT_LE(phi1, phi0 * (1.0 - 2.0 * sufficient_decrease * step_scale) + 1.0e-12 * phi0);
+  }
+}
+
+TEST(EquationSolver, PipelinedCG)
+{
+  for (auto preconditioner : {Preconditioner::HypreJacobi, Preconditioner::HypreAMG, Preconditioner::None}) {
+    const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::PipelinedCG,
+                                          .preconditioner = preconditioner,
+                                          .relative_tol   = 1.0e-10,
+                                          .absolute_tol   = 1.0e-14,
+                                          .max_iterations = 500,
+                                          .print_level    = 1};
+
+    const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                                .relative_tol   = 1.0e-10,
+                                                .absolute_tol   = 1.0e-12,
+                                                .max_iterations = 100,
+                                                .print_level    = 1};
+
+    int num_iterations = 0;
+    solveSinProblem(nonlin_opts, lin_opts, num_iterations);
+  }
+}
+
+TEST(EquationSolver, IterativeRefinementWithDirectPreconditioner)
+{
+  const LinearSolverOptions lin_opts = {.linear_solver            = LinearSolver::GMRES,
+                                        .preconditioner           = Preconditioner::SuperLU,
+                                        .relative_tol             = 1.0e-10,
+                                        .absolute_tol             = 1.0e-14,
+                                        .max_iterations           = 20,
+                                        .print_level              = 1,
+                                        .max_preconditioner_reuse = 3};
+
+  const NonlinearSolverOptions nonlin_opts = {.nonlin_solver  = NonlinearSolver::Newton,
+                                              .relative_tol   = 1.0e-10,
+                                              .absolute_tol   = 1.0e-12,
+                                              .max_iterations = 100,
+                                              .print_level    = 1};
+
+  int num_iterations = 0;
+  solveSinProblem(nonlin_opts, lin_opts, num_iterations, [&lin_opts](const EquationSolver& eq_solver) {
+    const auto& telemetry     = eq_solver.telemetry();
+    const auto& factorization = dynamic_cast<const ReusablePreconditioner&>(eq_solver.preconditioner());
+
+    // the factorization is lagged across Newton iterations, and GMRES refines the solutions of the stale factors
+    ASSERT_GT(telemetry.nonlinear_iterations, 1);
+    EXPECT_LT(factorization.numSetups(), telemetry.nonlinear_iterations);
+    EXPECT_GT(telemetry.linear_solves, 0);
+    EXPECT_LT(telemetry.linear_iterations, lin_opts.max_iterations * telemetry.linear_solves);
+  });
+}
+
+// a mass matrix, which is symmetric positive definite
+std::unique_ptr<mfem::HypreParMatrix> mass_matrix(mfem::ParFiniteElementSpace& fes)
+{
+  mfem::ParBilinearForm form(&fes);
+  form.AddDomainIntegrator(new mfem::MassIntegrator());
+  form.Assemble();
+  form.Finalize();
+  return std::unique_ptr<mfem::HypreParMatrix>(form.ParallelAssemble());
+}
+
+TEST(SuperLU, RefactorsMatricesWithTheSamePattern)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  auto                        fec    = mfem::H1_FECollection(1, 2);
+  auto                        fec_p2 = mfem::H1_FECollection(2, 2);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+  mfem::ParFiniteElementSpace fes_p2(&pmesh, &fec_p2);
+
+  auto A    = mass_matrix(fes);
+  auto A_p2 = mass_matrix(fes_p2);
+
+  SparsityPattern pattern;
+  EXPECT_FALSE(pattern.matches(*A));
+
+  pattern = SparsityPattern(*A);
+  EXPECT_TRUE(pattern.matches(*A));
+  EXPECT_FALSE(pattern.matches(*A_p2));
+
+  mfem::Vector b(A->Height()), x(A->Height()), x_scaled(A->Height());
+  b.Randomize(0);
+
+  SuperLUSolver solver(0, MPI_COMM_WORLD);
+  solver.SetOperator(*A);
+  solver.Mult(b, x);
+
+  // the second factorization reuses the permutations and symbolic factorization of the first
+  *A *= 2.0;
+  EXPECT_TRUE(pattern.matches(*A));
+  solver.SetOperator(*A);
+  solver.Mult(b, x_scaled);
+
+  x_scaled *= 2.0;
+  x_scaled -= x;
+  EXPECT_LT(mfem::ParNormlp(x_scaled, 2, MPI_COMM_WORLD), 1.0e-10 * mfem::ParNormlp(x, 2, MPI_COMM_WORLD));
+}
+
+/// A preconditioner that only counts the number of times it is set up
+class CountingPreconditioner : public mfem::Solver {
+public:
+  explicit CountingPreconditioner(int& setups) : setups_(setups) {}
+
+  void Mult(const mfem::Vector& input, mfem::Vector& output) const override { output = input; }
+
+  void SetOperator(const mfem::Operator& op) override
+  {
+    height = op.Height();
+    width  = op.Width();
+    setups_++;
+  }
+
+private:
+  int& setups_;
+};
+
+TEST(ReusablePreconditioner, SkipsSetupForTheSameOperator)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(4, 4, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  auto                        fec = mfem::H1_FECollection(1, 2);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  auto A = mass_matrix(fes);
+  auto B = mass_matrix(fes);
+
+  int                    setups = 0;
+  ReusablePreconditioner preconditioner(std::make_unique<CountingPreconditioner>(setups), 2);
+
+  preconditioner.SetOperator(*A);
+  EXPECT_EQ(setups, 1);
+  EXPECT_EQ(preconditioner.Height(), A->Height());
+
+  // the same operator is reused max_reuse times, and set up again after that
+  preconditioner.SetOperator(*A);
+  preconditioner.SetOperator(*A);
+  EXPECT_EQ(setups, 1);
+  preconditioner.SetOperator(*A);
+  EXPECT_EQ(setups, 2);
+
+  // a new operator is always set up, and restarts the count of reuses
+  preconditioner.SetOperator(*B);
+  EXPECT_EQ(setups, 3);
+  preconditioner.SetOperator(*B);
+  preconditioner.SetOperator(*B);
+  EXPECT_EQ(setups, 3);
+
+  // as is the same operator after forceRebuild()
+  preconditioner.forceRebuild();
+  preconditioner.SetOperator(*B);
+  EXPECT_EQ(setups, 4);
+}
+
+TEST(RecyclingCG, ReusesSubspaceAcrossSolves)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(16, 16, mfem::Element::QUADRILATERAL);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  auto                        fec = mfem::H1_FECollection(1, 2);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  // a poorly conditioned, symmetric positive definite system
+  mfem::ParBilinearForm form(&fes);
+  mfem::ConstantCoefficient one(1.0), small(1.0e-4);
+  form.AddDomainIntegrator(new mfem::DiffusionIntegrator(one));
+  form.AddDomainIntegrator(new mfem::MassIntegrator(small));
+  form.Assemble();
+  form.Finalize();
+  std::unique_ptr<mfem::HypreParMatrix> A(form.ParallelAssemble());
+
+  RecyclingCGSolver solver(MPI_COMM_WORLD, 8);
+  solver.SetRelTol(1.0e-10);
+  solver.SetAbsTol(0.0);
+  solver.SetMaxIter(1000);
+  solver.SetOperator(*A);
+
+  mfem::Vector b(A->Height()), x(A->Height()), residual(A->Height());
+  b.Randomize(1);
+
+  x = 0.0;
+  solver.Mult(b, x);
+  EXPECT_TRUE(solver.GetConverged());
+  int first = solver.GetNumIterations();
+  EXPECT_EQ(solver.recycledDimension(), 8);
+
+  // a slightly different operator and right hand side, like the next Newton iteration or load step
+  *A *= 1.01;
+  solver.SetOperator(*A);
+  b.Randomize(2);
+  x = 0.0;
+  solver.Mult(b, x);
+  EXPECT_TRUE(solver.GetConverged());
+  EXPECT_LT(solver.GetNumIterations(), first);
+
+  A->Mult(x, residual);
+  residual -= b;
+  EXPECT_LT(mfem::ParNormlp(residual, 2, MPI_COMM_WORLD), 1.0e-6 * mfem::ParNormlp(b, 2, MPI_COMM_WORLD));
+}
+
 #ifdef SERAC_USE_SUNDIALS
+#ifdef MFEM_USE_PETSC
+TEST(EquationSolver, PetscPreconditioners)
+{
+  const NonlinearSolverOptions nonlin_opts = {
+      .nonlin_solver = NonlinearSolver::Newton, .relative_tol = 1.0e-10, .absolute_tol = 1.0e-12, .max_iterations = 20};
+
+  // BDDC, and a preconditioner chosen through the options passthrough
+  for (auto [preconditioner, options] : {std::pair{Preconditioner::PetscBDDC, ""},
+                                         std::pair{Preconditioner::Petsc, "-pc_type gamg"}}) {
+    const LinearSolverOptions lin_opts = {.linear_solver  = LinearSolver::GMRES,
+                                          .preconditioner = preconditioner,
+                                          .relative_tol   = 1.0e-12,
+                                          .absolute_tol   = 1.0e-14,
+                                          .max_iterations = 500,
+                                          .petsc_options  = options,
+                                          .petsc_prefix   = "test_"};
+
+    int num_iterations = 0;
+    solveSinProblem(nonlin_opts, lin_opts, num_iterations);
+    EXPECT_GT(num_iterations, 0);
+  }
+}
+#endif
+
+TEST(ElasticityAMG, RigidBodyModesHaveNoStrainEnergy)
+{
+  for (int ordering : {mfem::Ordering::byNODES, mfem::Ordering::byVDIM}) {
+    auto mesh  = mfem::Mesh::MakeCartesian3D(3, 3, 3, mfem::Element::HEXAHEDRON);
+    auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+    auto                        fec = mfem::H1_FECollection(2, 3);
+    mfem::ParFiniteElementSpace fes(&pmesh, &fec, 3, ordering);
+
+    mfem::ConstantCoefficient lambda(1.0), mu(1.0);
+    mfem::ParBilinearForm     stiffness(&fes);
+    stiffness.AddDomainIntegrator(new mfem::ElasticityIntegrator(lambda, mu));
+    stiffness.Assemble();
+    stiffness.Finalize();
+    std::unique_ptr<mfem::HypreParMatrix> K(stiffness.ParallelAssemble());
+
+    mfem::HypreBoomerAMG amg;
+    auto                 modes = setElasticityOptions(amg, fes);
+    ASSERT_EQ(modes->size(), 3);
+
+    mfem::Vector K_mode(K->Height());
+    for (int i = 0; i < modes->size(); i++) {
+      K->Mult((*modes)[i], K_mode);
+      EXPECT_LT(mfem::ParNormlp(K_mode, 2, MPI_COMM_WORLD), 1.0e-10 * mfem::ParNormlp((*modes)[i], 2, MPI_COMM_WORLD));
+    }
+
+    // the preconditioner still sets up and applies with the modes
+    amg.SetOperator(*K);
+    mfem::Vector b(K->Height()), x(K->Height());
+    b.Randomize(0);
+    amg.Mult(b, x);
+    EXPECT_GT(mfem::ParNormlp(x, 2, MPI_COMM_WORLD), 0.0);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     AllEquationSolverTests, EquationSolverSuite,
     testing::Combine(testing::Values(NonlinearSolver::Newton, NonlinearSolver::NewtonLineSearch,
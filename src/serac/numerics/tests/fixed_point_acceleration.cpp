@@ -0,0 +1,107 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/numerics/fixed_point_acceleration.hpp"
+
+using namespace serac;
+
+// g(x) = A x + b, where A has a spectral radius close to one, so that unaccelerated iterations converge slowly
+void applyContraction(const mfem::Vector& x, mfem::Vector& g)
+{
+  mfem::DenseMatrix A(3);
+  A(0, 0) = 0.9;
+  A(0, 1) = 0.05;
+  A(1, 1) = -0.6;
+  A(1, 2) = 0.1;
+  A(2, 0) = 0.05;
+  A(2, 2) = 0.3;
+
+  A.Mult(x, g);
+  g(0) += 1.0;
+  g(1) += 2.0;
+  g(2) -= 1.0;
+}
+
+int iterationsToConverge(FixedPointAcceleration method, double relaxation, mfem::Vector& x)
+{
+  FixedPointAccelerator accelerator(method, relaxation, 5, MPI_COMM_WORLD);
+
+  x.SetSize(3);
+  x = 0.0;
+
+  mfem::Vector g(3);
+  mfem::Vector r(3);
+  for (int iteration = 0; iteration < 500; iteration++) {
+    applyContraction(x, g);
+    subtract(g, x, r);
+    if (r.Norml2() < 1.0e-10) {
+      return iteration;
+    }
+    accelerator.update(x, g);
+  }
+  return 500;
+}
+
+TEST(FixedPointAcceleration, AllMethodsConvergeToTheFixedPoint)
+{
+  mfem::Vector x_plain, x_aitken, x_anderson;
+
+  int plain    = iterationsToConverge(FixedPointAcceleration::None, 1.0, x_plain);
+  int aitken   = iterationsToConverge(FixedPointAcceleration::Aitken, 0.5, x_aitken);
+  int anderson = iterationsToConverge(FixedPointAcceleration::Anderson, 0.5, x_anderson);
+
+  EXPECT_LT(plain, 500);
+  EXPECT_LT(aitken, plain / 2);
+  EXPECT_LE(anderson, 10);
+
+  x_aitken -= x_plain;
+  x_anderson -= x_plain;
+  EXPECT_LT(x_aitken.Normlinf(), 1.0e-8);
+  EXPECT_LT(x_anderson.Normlinf(), 1.0e-8);
+}
+
+TEST(FixedPointAcceleration, ResetForgetsPreviousIterates)
+{
+  FixedPointAccelerator accelerator(FixedPointAcceleration::Aitken, 0.5, 5, MPI_COMM_WORLD);
+
+  mfem::Vector x(3), g(3);
+  x = 0.0;
+  for (int i = 0; i < 3; i++) {
+    applyContraction(x, g);
+    accelerator.update(x, g);
+  }
+
+  // after a reset, the first update is a plain relaxation step with the initial factor
+  accelerator.reset();
+  x = 0.0;
+  applyContraction(x, g);
+  accelerator.update(x, g);
+
+  EXPECT_DOUBLE_EQ(x(0), 0.5);
+  EXPECT_DOUBLE_EQ(x(1), 1.0);
+  EXPECT_DOUBLE_EQ(x(2), -0.5);
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,117 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <cmath>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/numerics/modal_superposition.hpp"
+
+using namespace serac;
+
+// two unit modes, a vibrating one with eigenvalue 4 and a rigid one, under the load f(t) = {t, 2}
+TEST(ModalSuperposition, IntegratesLinearLoadsExactly)
+{
+  VibrationModes modes;
+  modes.eigenvalues = {0.0, 4.0};
+  modes.shapes.assign(2, mfem::Vector(2));
+  modes.shapes[0] = 0.0;
+  modes.shapes[1] = 0.0;
+  modes.shapes[0](1) = 1.0;
+  modes.shapes[1](0) = 1.0;
+
+  auto load = [](double t) {
+    mfem::Vector f(2);
+    f(0) = t;
+    f(1) = 2.0;
+    return f;
+  };
+
+  mfem::IdentityOperator M(2);
+  mfem::Vector           u(2), v(2);
+  u = 0.0;
+  v = 0.0;
+
+  ModalIntegrator integrator(modes, MPI_COMM_WORLD);
+  integrator.setState(M, u, v);
+  integrator.setLoad(load(0.0));
+
+  // the steps don't need to resolve the period (pi) of the vibrating mode
+  double t = 0.0;
+  for (double dt : {0.5, 1.5, 0.25, 2.0}) {
+    t += dt;
+    integrator.step(dt, load(t));
+  }
+
+  // q'' + 4 q = t gives q = t / 4 - sin(2 t) / 8, and q'' = 2 gives q = t^2, both from rest
+  integrator.displacement(u);
+  integrator.velocity(v);
+  EXPECT_NEAR(u(0), t / 4.0 - std::sin(2.0 * t) / 8.0, 1.0e-12);
+  EXPECT_NEAR(v(0), 0.25 - std::cos(2.0 * t) / 4.0, 1.0e-12);
+  EXPECT_NEAR(u(1), t * t, 1.0e-12);
+  EXPECT_NEAR(v(1), 2.0 * t, 1.0e-12);
+
+  mfem::Vector a(2);
+  integrator.acceleration(a);
+  EXPECT_NEAR(a(0), std::sin(2.0 * t) / 2.0, 1.0e-12);
+  EXPECT_NEAR(a(1), 2.0, 1.0e-12);
+}
+
+#ifdef MFEM_USE_SLEPC
+TEST(ModalSuperposition, LowestModesOfTheLaplacian)
+{
+  auto mesh  = mfem::Mesh::MakeCartesian2D(8, 8, mfem::Element::QUADRILATERAL, false, M_PI, M_PI);
+  auto pmesh = mfem::ParMesh(MPI_COMM_WORLD, mesh);
+
+  auto                        fec = mfem::H1_FECollection(2, 2);
+  mfem::ParFiniteElementSpace fes(&pmesh, &fec);
+
+  mfem::ParBilinearForm stiffness(&fes), mass(&fes);
+  stiffness.AddDomainIntegrator(new mfem::DiffusionIntegrator);
+  mass.AddDomainIntegrator(new mfem::MassIntegrator);
+  for (auto* form : {&stiffness, &mass}) {
+    form->Assemble();
+    form->Finalize();
+  }
+  std::unique_ptr<mfem::HypreParMatrix> K(stiffness.ParallelAssemble());
+  std::unique_ptr<mfem::HypreParMatrix> M(mass.ParallelAssemble());
+
+  auto modes = lowestVibrationModes(*K, *M, 4);
+
+  // the Neumann eigenvalues of the square [0, pi]^2 are i^2 + j^2
+  std::vector<double> expected = {0.0, 1.0, 1.0, 2.0};
+  mfem::Vector        K_phi(K->Height()), M_phi(M->Height());
+  for (std::size_t i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(modes.eigenvalues[i], expected[i], 1.0e-3);
+
+    M->Mult(modes.shapes[i], M_phi);
+    EXPECT_NEAR(mfem::InnerProduct(MPI_COMM_WORLD, modes.shapes[i], M_phi), 1.0, 1.0e-10);
+
+    K->Mult(modes.shapes[i], K_phi);
+    K_phi.Add(-modes.eigenvalues[i], M_phi);
+    EXPECT_LT(mfem::ParNormlp(K_phi, 2, MPI_COMM_WORLD), 1.0e-6);
+  }
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -162,6 +162,8 @@ std::string to_string(serac::TimestepMethod m)
   if (m == serac::TimestepMethod::ImplicitMidpoint) return "ImplicitMidpoint";
   if (m == serac::TimestepMethod::SDIRK23) return "SDIRK23";
   if (m == serac::TimestepMethod::SDIRK34) return "SDIRK34";
+  if (m == serac::TimestepMethod::IMEXEuler) return "IMEXEuler";
+  if (m == serac::TimestepMethod::IMEXRK2) return "IMEXRK2";
 
   // for second order odes
   if (m == serac::TimestepMethod::Newmark) return "Newmark";
@@ -196,6 +198,8 @@ int order_of_convergence(serac::TimestepMethod m)
   if (m == serac::TimestepMethod::ImplicitMidpoint) return 2;
   if (m == serac::TimestepMethod::SDIRK23) return 2;
   if (m == serac::TimestepMethod::SDIRK34) return 3;
+  if (m == serac::TimestepMethod::IMEXEuler) return 1;
+  if (m == serac::TimestepMethod::IMEXRK2) return 2;
 
   // for second order odes
   if (m == serac::TimestepMethod::Newmark) return 2;
@@ -223,6 +227,8 @@ int which_kind_of_ode(serac::TimestepMethod m)
   if (m == serac::TimestepMethod::ImplicitMidpoint) return 1;
   if (m == serac::TimestepMethod::SDIRK23) return 1;
   if (m == serac::TimestepMethod::SDIRK34) return 1;
+  if (m == serac::TimestepMethod::IMEXEuler) return 1;
+  if (m == serac::TimestepMethod::IMEXRK2) return 1;
 
   // for second order odes
   if (m == serac::TimestepMethod::Newmark) return 2;
@@ -237,7 +243,8 @@ int which_kind_of_ode(serac::TimestepMethod m)
 }
 
 double first_order_ode_test(int nsteps, ode_type type, constraint_type constraint, TimestepMethod timestepper,
-                            DirichletEnforcementMethod enforcement)
+                            DirichletEnforcementMethod enforcement, const TimesteppingOptions* adaptive = nullptr,
+                            int* steps_taken = nullptr)
 {
   double t                      = 0.0;
   double ode_residual_eval_time = 0.0;
@@ -280,6 +287,19 @@ double first_order_ode_test(int nsteps, ode_type type, constraint_type constrain
     K     = stiffness_nonlinear;
   }
 
+  // the implicit-explicit methods treat the linear part of the internal force implicitly, and the rest explicitly
+  bool                                             imex       = FirstOrderODE::IsIMEX(timestepper);
+  std::function<mfem::Vector(const mfem::Vector&)> f_explicit = [f_int](const mfem::Vector& u) {
+    mfem::Vector f = f_int(u);
+    f -= internal_force_linear(u);
+    return f;
+  };
+  if (imex) {
+    f_int = internal_force_linear;
+    K     = stiffness_linear;
+  }
+  const FirstOrderODE* imex_ode = nullptr;
+
   StdFunctionOperator residual(
       3,
       [&](const mfem::Vector& dx_dt, mfem::Vector& r) {
@@ -291,6 +311,9 @@ double first_order_ode_test(int nsteps, ode_type type, constraint_type constrain
         M.Mult(dx_dt, M_dx_dt);
         add(M_dx_dt, force_internal, r);
         r -= f_ext;
+        if (const mfem::Vector* load = imex_ode ? imex_ode->GetIMEXLoad() : nullptr) {
+          r += *load;
+        }
         if (constraint != UNCONSTRAINED) {
           r(0) = 0.0;
         }
@@ -320,14 +343,38 @@ double first_order_ode_test(int nsteps, ode_type type, constraint_type constrain
   ode.SetTimestepper(timestepper);
   ode.SetEnforcementMethod(enforcement);
 
+  if (imex) {
+    imex_ode = &ode;
+    ode.SetIMEXTerms(
+        [&](double, const mfem::Vector& u, mfem::Vector& r) {
+          r = f_int(u);
+          r -= f_ext;
+        },
+        [&](double, const mfem::Vector& u, mfem::Vector& r) { r = f_explicit(u); });
+  }
+
   mfem::Vector soln(3);
 
   soln[0] = 1.0;
   soln[1] = 2.0;
   soln[2] = 3.0;
 
-  for (int i = 0; i < nsteps; i++) {
-    ode.Step(soln, t, dt);
+  if (adaptive) {
+    // take steps of at most dt, as chosen by the error controller, until the final time
+    ode.SetTimestepControl(*adaptive, MPI_COMM_WORLD);
+    int steps = 0;
+    while (t < 1.0 - 1.0e-12) {
+      double step = std::min(ode.SuggestedTimestep(dt), 1.0 - t);
+      ode.Step(soln, t, step);
+      steps++;
+    }
+    if (steps_taken) {
+      *steps_taken = steps;
+    }
+  } else {
+    for (int i = 0; i < nsteps; i++) {
+      ode.Step(soln, t, dt);
+    }
   }
 
   // these solutions are computed to machine precision in
@@ -573,7 +620,9 @@ INSTANTIATE_TEST_SUITE_P(AllFirstOrderTests, FirstOrderODESuite,
       serac::TimestepMethod::GeneralizedAlpha,
       serac::TimestepMethod::ImplicitMidpoint,
       serac::TimestepMethod::SDIRK23,
-      serac::TimestepMethod::SDIRK34
+      serac::TimestepMethod::SDIRK34,
+      serac::TimestepMethod::IMEXEuler,
+      serac::TimestepMethod::IMEXRK2
     ),
     testing::Values(
       DirichletEnforcementMethod::DirectControl,       
@@ -584,6 +633,25 @@ INSTANTIATE_TEST_SUITE_P(AllFirstOrderTests, FirstOrderODESuite,
 );
 // clang-format on
 
+TEST(FirstOrderODE, AdaptiveTimestepping)
+{
+  TimesteppingOptions adaptive{.timestepper        = TimestepMethod::BackwardEuler,
+                               .enforcement_method = DirichletEnforcementMethod::RateControl,
+                               .adaptive           = true,
+                               .error_relative_tol = 1.0e-3,
+                               .error_absolute_tol = 1.0e-3};
+
+  // start from a small step, which the controller should grow as the transient decays
+  int    steps = 0;
+  double error = first_order_ode_test(1000, LINEAR, UNCONSTRAINED, TimestepMethod::BackwardEuler,
+                                      DirichletEnforcementMethod::RateControl, &adaptive, &steps);
+
+  SLIC_INFO(axom::fmt::format("adaptive time stepping took {} steps, with error {}", steps, error));
+
+  EXPECT_LT(steps, 100);
+  EXPECT_LT(error, 1.0e-2);
+}
+
 class SecondOrderODESuite : public testing::TestWithParam<param_t> {
 protected:
   void                       SetUp() override { std::tie(type, constraint, timestepper, enforcement) = GetParam(); }
@@ -0,0 +1,203 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <cmath>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/numerics/reduced_order_model.hpp"
+
+using namespace serac;
+
+constexpr int n = 30;
+
+// snapshots in the span of two random vectors, which all share the (boundary condition) value of dof 0
+std::vector<mfem::Vector> makeSnapshots()
+{
+  mfem::Vector a(n), b(n);
+  a.Randomize(1);
+  b.Randomize(2);
+
+  std::vector<mfem::Vector> snapshots;
+  for (int s = 0; s < 6; s++) {
+    mfem::Vector snapshot(n);
+    snapshot = 0.0;
+    snapshot.Add(std::sin(s + 1.0), a);
+    snapshot.Add(std::cos(2.0 * s), b);
+    snapshot(0) = 5.0;
+    snapshots.push_back(snapshot);
+  }
+  return snapshots;
+}
+
+// F(x) = A x + x^3, with a tridiagonal A
+class CubicOperator : public mfem::Operator {
+public:
+  CubicOperator() : mfem::Operator(n), A_(n), J_(n)
+  {
+    A_ = 0.0;
+    for (int i = 0; i < n; i++) {
+      A_(i, i) = 4.0;
+      if (i + 1 < n) {
+        A_(i, i + 1) = A_(i + 1, i) = -1.0;
+      }
+    }
+  }
+
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override
+  {
+    A_.Mult(x, y);
+    for (int i = 0; i < n; i++) {
+      y(i) += x(i) * x(i) * x(i);
+    }
+  }
+
+  mfem::Operator& GetGradient(const mfem::Vector& x) const override
+  {
+    J_ = A_;
+    for (int i = 0; i < n; i++) {
+      J_(i, i) += 3.0 * x(i) * x(i);
+    }
+    return J_;
+  }
+
+private:
+  mfem::DenseMatrix         A_;
+  mutable mfem::DenseMatrix J_;
+};
+
+TEST(ReducedOrderModel, BasisSpansTheSnapshots)
+{
+  auto snapshots = makeSnapshots();
+
+  mfem::Array<int> constrained_dofs;
+  constrained_dofs.Append(0);
+  ReducedBasis basis(snapshots, MPI_COMM_WORLD, 1.0e-10, 0, constrained_dofs);
+
+  ASSERT_EQ(basis.size(), 2);
+  EXPECT_GE(basis.singularValues()(0), basis.singularValues()(1));
+
+  for (int i = 0; i < basis.size(); i++) {
+    EXPECT_EQ(basis[i](0), 0.0);
+    for (int j = 0; j < basis.size(); j++) {
+      EXPECT_NEAR(basis[i] * basis[j], (i == j) ? 1.0 : 0.0, 1.0e-12);
+    }
+  }
+
+  // the snapshots (without their constrained dofs) are reproduced by their projections
+  for (auto snapshot : snapshots) {
+    snapshot(0) = 0.0;
+
+    mfem::Vector coefficients, projection;
+    basis.project(snapshot, coefficients);
+    basis.expand(coefficients, projection);
+    projection -= snapshot;
+    EXPECT_LT(projection.Norml2(), 1.0e-12 * snapshot.Norml2());
+  }
+
+  ReducedBasis truncated(snapshots, MPI_COMM_WORLD, 1.0e-10, 1, constrained_dofs);
+  EXPECT_EQ(truncated.size(), 1);
+}
+
+TEST(ReducedOrderModel, ReducedNewtonFindsSolutionsInTheBasis)
+{
+  mfem::Array<int> constrained_dofs;
+  constrained_dofs.Append(0);
+  auto basis = std::make_shared<ReducedBasis>(makeSnapshots(), MPI_COMM_WORLD, 1.0e-10, 0, constrained_dofs);
+
+  // a solution in the span of the basis, with a fixed value at the constrained dof
+  mfem::Vector solution(n);
+  solution = 0.0;
+  solution.Add(0.5, (*basis)[0]);
+  solution.Add(-0.3, (*basis)[1]);
+  solution(0) = 2.0;
+
+  CubicOperator F;
+  mfem::Vector  b;
+  F.Mult(solution, b);
+
+  ReducedNewtonSolver newton(basis, MPI_COMM_WORLD);
+  newton.SetOperator(F);
+  newton.SetRelTol(1.0e-12);
+  newton.SetAbsTol(1.0e-14);
+  newton.SetMaxIter(10);
+
+  mfem::Vector x(n);
+  x    = 0.0;
+  x(0) = 2.0;
+  newton.Mult(b, x);
+
+  EXPECT_TRUE(newton.GetConverged());
+  EXPECT_LE(newton.GetNumIterations(), 5);
+
+  x -= solution;
+  EXPECT_LT(x.Normlinf(), 1.0e-10);
+}
+
+TEST(ReducedOrderModel, SamplingReproducesTheReducedResiduals)
+{
+  constexpr int num_rows     = 6;
+  constexpr int num_elements = 80;
+
+  mfem::DenseMatrix contributions(num_rows, num_elements);
+  mfem::Vector      column(num_rows);
+  for (int e = 0; e < num_elements; e++) {
+    column.Randomize(e + 1);
+    for (int i = 0; i < num_rows; i++) {
+      contributions(i, e) = column(i) + (i == 0 ? 1.0 : 0.0);
+    }
+  }
+
+  mfem::Vector ones(num_elements), target(num_rows);
+  ones = 1.0;
+  contributions.Mult(ones, target);
+
+  for (double tolerance : {1.0e-1, 1.0e-8}) {
+    auto sample = energyConservingSampling(contributions, tolerance);
+
+    EXPECT_GT(sample.elements.size(), 0u);
+    EXPECT_LE(sample.elements.size(), std::size_t(num_rows));
+    for (double weight : sample.weights) {
+      EXPECT_GT(weight, 0.0);
+    }
+
+    mfem::Vector sampled(num_rows);
+    contributions.Mult(sampleWeights(sample, num_elements), sampled);
+    sampled -= target;
+    EXPECT_LE(sampled.Norml2(), tolerance * target.Norml2());
+  }
+}
+
+TEST(ReducedOrderModel, SampledDomainHasTheSampledElements)
+{
+  auto mesh = mfem::Mesh::MakeCartesian2D(3, 3, mfem::Element::QUADRILATERAL);
+
+  ElementSample sample{{1, 4, 7}, {2.0, 2.0, 2.0}};
+  Domain        domain = sampledDomain(mesh, sample);
+
+  EXPECT_EQ(domain.quad_ids_, std::vector<int>({1, 4, 7}));
+  EXPECT_EQ(domain.mfem_quad_ids_, std::vector<int>({1, 4, 7}));
+  EXPECT_TRUE(domain.tri_ids_.empty());
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/numerics/timestep_controller.hpp"
+
+using namespace serac;
+
+const TimesteppingOptions options{.timestepper        = TimestepMethod::BackwardEuler,
+                                  .adaptive           = true,
+                                  .error_relative_tol = 1.0e-2,
+                                  .error_absolute_tol = 1.0e-4,
+                                  .min_dt             = 1.0e-6,
+                                  .max_dt             = 10.0};
+
+TEST(TimestepController, ErrorNormIsWeightedByTheTolerances)
+{
+  TimestepController controller(options, 1);
+
+  mfem::Vector u_old(2), u_new(2), error(2);
+  u_old(0) = 1.0;
+  u_old(1) = 0.0;
+  u_new(0) = 2.0;
+  u_new(1) = 0.0;
+
+  // weights: 1 / (1e-4 + 1e-2 * 2) and 1 / 1e-4
+  error(0) = 1.0e-4 + 2.0e-2;
+  error(1) = 1.0e-4;
+  EXPECT_NEAR(controller.errorNorm(error, u_old, u_new, MPI_COMM_WORLD), 1.0, 1.0e-12);
+
+  error(1) = 0.0;
+  EXPECT_NEAR(controller.errorNorm(error, u_old, u_new, MPI_COMM_WORLD), std::sqrt(0.5), 1.0e-12);
+}
+
+TEST(TimestepController, StepSizesFollowTheError)
+{
+  TimestepController controller(options, 1);
+
+  // small errors grow the step, but by a bounded factor
+  double grown = controller.accept(1.0, 1.0e-3);
+  EXPECT_GT(grown, 1.0);
+  EXPECT_LE(grown, 5.0);
+
+  // errors slightly below one keep the step roughly the same
+  controller.reset();
+  EXPECT_NEAR(controller.accept(1.0, 0.9), 1.0, 0.1);
+
+  // rejected and failed steps always shrink
+  EXPECT_LT(controller.reject(1.0, 1.1), 1.0);
+  EXPECT_LT(controller.reject(1.0, 1.0e6), 1.0);
+  EXPECT_GE(controller.reject(1.0, 1.0e6), 0.2);
+  EXPECT_LT(controller.rejectUnconverged(1.0), 1.0);
+
+  // and the limits in the options are respected
+  EXPECT_DOUBLE_EQ(controller.accept(9.0, 1.0e-6), 10.0);
+  EXPECT_DOUBLE_EQ(controller.rejectUnconverged(2.0e-6), 1.0e-6);
+}
+
+int main(int argc, char* argv[])
+{
+  int result = 0;
+
+  ::testing::InitGoogleTest(&argc, argv);
+
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  result = RUN_ALL_TESTS();
+
+  MPI_Finalize();
+
+  return result;
+}
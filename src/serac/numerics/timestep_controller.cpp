@@ -0,0 +1,64 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/numerics/timestep_controller.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+TimestepController::TimestepController(const TimesteppingOptions& options, int error_order)
+    : options_(options), k_(error_order + 1.0)
+{
+  SLIC_ERROR_ROOT_IF(options.error_relative_tol <= 0.0 && options.error_absolute_tol <= 0.0,
+                     "Adaptive time stepping requires a positive relative or absolute error tolerance");
+  SLIC_ERROR_ROOT_IF(options.min_dt > options.max_dt, "Adaptive time stepping requires min_dt <= max_dt");
+}
+
+double TimestepController::errorNorm(const mfem::Vector& error, const mfem::Vector& u_old, const mfem::Vector& u_new,
+                                     MPI_Comm comm) const
+{
+  double local[2] = {0.0, static_cast<double>(error.Size())};
+  for (int i = 0; i < error.Size(); i++) {
+    double scale = options_.error_absolute_tol +
+                   options_.error_relative_tol * std::max(std::abs(u_old[i]), std::abs(u_new[i]));
+    double weighted = error[i] / scale;
+    local[0] += weighted * weighted;
+  }
+
+  double global[2];
+  MPI_Allreduce(local, global, 2, MPI_DOUBLE, MPI_SUM, comm);
+
+  return (global[1] > 0.0) ? std::sqrt(global[0] / global[1]) : 0.0;
+}
+
+double TimestepController::accept(double dt, double error_norm)
+{
+  // guard against a vanishing error estimate, e.g. at steady state
+  error_norm = std::max(error_norm, 1.0e-10);
+
+  double factor = safety_ * std::pow(error_norm, -0.7 / k_) * std::pow(previous_error_norm_, 0.4 / k_);
+  factor        = std::clamp(factor, max_shrink_, max_growth_);
+
+  previous_error_norm_ = error_norm;
+
+  return clamp(dt * factor);
+}
+
+double TimestepController::reject(double dt, double error_norm) const
+{
+  double factor = safety_ * std::pow(error_norm, -1.0 / k_);
+  return clamp(dt * std::clamp(factor, max_shrink_, safety_));
+}
+
+double TimestepController::rejectUnconverged(double dt) const { return clamp(dt * unconverged_shrink_); }
+
+double TimestepController::clamp(double dt) const { return std::clamp(dt, options_.min_dt, options_.max_dt); }
+
+}  // namespace serac
@@ -0,0 +1,114 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file timestep_controller.hpp
+ *
+ * @brief A step size controller for adaptive time integration
+ */
+
+#pragma once
+
+#include "mfem.hpp"
+
+#include "serac/numerics/solver_config.hpp"
+
+namespace serac {
+
+/**
+ * @brief Chooses time step sizes from local error estimates with a proportional-integral (PI) controller
+ *
+ * After an accepted step with weighted error norm err_n, the next step is
+ *   dt_{n+1} = dt_n * safety * err_n^{-0.7 / k} * err_{n-1}^{0.4 / k},
+ * where k is one more than the order of the error estimate, and the change in dt is bounded
+ * (see e.g. Hairer & Wanner, Solving Ordinary Differential Equations II, section IV.2).
+ * Using the previous error as well as the current one damps the oscillation in step sizes that a
+ * purely proportional controller shows when the step size is limited by stability.
+ */
+class TimestepController {
+public:
+  /**
+   * @brief Construct a step size controller
+   *
+   * @param options The tolerances and step size limits
+   * @param error_order The order of accuracy of the local error estimate, in powers of dt
+   */
+  TimestepController(const TimesteppingOptions& options, int error_order);
+
+  /**
+   * @brief The weighted root-mean-square norm of a local error estimate
+   *
+   * Each component of the error is weighted by 1 / (absolute_tol + relative_tol * max(|u_old|, |u_new|)),
+   * so that a step is acceptable when the norm is at most one.
+   *
+   * @param error The local error estimate
+   * @param u_old The solution at the beginning of the step
+   * @param u_new The solution at the end of the step
+   * @param comm The MPI communicator of the vectors
+   * @return The weighted error norm
+   */
+  double errorNorm(const mfem::Vector& error, const mfem::Vector& u_old, const mfem::Vector& u_new,
+                   MPI_Comm comm) const;
+
+  /**
+   * @brief Record an accepted step, and compute the size of the next one
+   *
+   * @param dt The size of the accepted step
+   * @param error_norm The weighted error norm of the accepted step
+   * @return The size of the next step
+   */
+  double accept(double dt, double error_norm);
+
+  /**
+   * @brief Compute the size of the retry of a step whose error was too large
+   *
+   * @param dt The size of the rejected step
+   * @param error_norm The weighted error norm of the rejected step
+   * @return The size of the retried step
+   */
+  double reject(double dt, double error_norm) const;
+
+  /**
+   * @brief Compute the size of the retry of a step whose nonlinear solve did not converge
+   *
+   * @param dt The size of the failed step
+   * @return The size of the retried step
+   */
+  double rejectUnconverged(double dt) const;
+
+  /// @brief Forget the error of the previous step, e.g. after a restart
+  void reset() { previous_error_norm_ = 1.0; }
+
+  /// @brief The tolerances and step size limits of this controller
+  const TimesteppingOptions& options() const { return options_; }
+
+private:
+  /// @brief Bound a proposed step size by the limits in the options
+  double clamp(double dt) const;
+
+  /// The tolerances and step size limits
+  TimesteppingOptions options_;
+
+  /// One more than the order of the error estimate
+  double k_;
+
+  /// The weighted error norm of the previous accepted step
+  double previous_error_norm_ = 1.0;
+
+  /// Safety factor applied to the theoretically optimal step size
+  static constexpr double safety_ = 0.9;
+
+  /// The largest factor by which the step size may grow after one step
+  static constexpr double max_growth_ = 5.0;
+
+  /// The smallest factor by which the step size may shrink after one rejection
+  static constexpr double max_shrink_ = 0.2;
+
+  /// The factor by which the step size shrinks after a failed nonlinear solve
+  static constexpr double unconverged_shrink_ = 0.25;
+};
+
+}  // namespace serac
@@ -6,12 +6,16 @@
 
 #include "serac/physics/base_physics.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include "axom/fmt.hpp"
 
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/output.hpp"
+#include "serac/infrastructure/profiling.hpp"
 #include "serac/infrastructure/terminator.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/state_manager.hpp"
@@ -62,6 +66,13 @@ std::vector<double> BasePhysics::timesteps() const { return timesteps_; }
 void BasePhysics::initializeBasePhysicsStates(int cycle, double time)
 {
   timesteps_.clear();
+  nonlinear_iterations_.clear();
+  solver_telemetry_.clear();
+  solver_telemetry_times_.clear();
+  summarized_telemetry_   = 0;
+  continuation_increment_ = 0.0;
+  converged_states_.clear();
+  converged_times_.clear();
 
   time_           = time;
   max_time_       = time;
@@ -76,6 +87,337 @@ void BasePhysics::initializeBasePhysicsStates(int cycle, double time)
   for (auto& p : parameters_) {
     *p.sensitivity = 0.0;
   }
+
+  batch_adjoint_states_.clear();
+}
+
+const std::vector<BasePhysics::TimestepSensitivities>& BasePhysics::reverseAdjointTimestepBatch(
+    const std::vector<AdjointLoads>& adjoint_loads)
+{
+  auto carried_states = adjointTimestepStates();
+
+  // a different number of quantities of interest starts a new reverse sweep, with zero adjoint states
+  if (batch_adjoint_states_.size() != adjoint_loads.size()) {
+    batch_adjoint_states_.assign(adjoint_loads.size(), {});
+    for (auto& states : batch_adjoint_states_) {
+      for (auto* state : carried_states) {
+        states.emplace_back(state->Size());
+        states.back() = 0.0;
+      }
+    }
+  }
+
+  prepareAdjointTimestep();
+
+  for (size_t qoi = 0; qoi < adjoint_loads.size(); qoi++) {
+    selectBatchedAdjoint(qoi);
+    setAdjointLoad(adjoint_loads[qoi]);
+    solveAdjointTimestep();
+    for (size_t i = 0; i < carried_states.size(); i++) {
+      batch_adjoint_states_[qoi][i] = *carried_states[i];
+    }
+  }
+
+  finishAdjointTimestep();
+
+  if (batch_sensitivities_.size() != adjoint_loads.size()) {
+    batch_sensitivities_.clear();
+    for (size_t qoi = 0; qoi < adjoint_loads.size(); qoi++) {
+      std::vector<FiniteElementDual> parameter_sensitivities;
+      for (auto& p : parameters_) {
+        parameter_sensitivities.emplace_back(*p.sensitivity);
+      }
+      batch_sensitivities_.push_back({std::move(parameter_sensitivities), *shape_displacement_sensitivity_});
+    }
+  }
+
+  computeBatchedTimestepSensitivities(batch_sensitivities_);
+
+  return batch_sensitivities_;
+}
+
+void BasePhysics::selectBatchedAdjoint(size_t qoi)
+{
+  SLIC_ERROR_ROOT_IF(qoi >= batch_adjoint_states_.size(),
+                     axom::fmt::format("No batched adjoint {} in physics module {}", qoi, name_));
+
+  auto carried_states = adjointTimestepStates();
+  for (size_t i = 0; i < carried_states.size(); i++) {
+    carried_states[i]->Set(1.0, batch_adjoint_states_[qoi][i]);
+  }
+}
+
+void BasePhysics::advanceWithCutbacks(double dt, int max_cutbacks, const std::function<bool(double)>& solve,
+                                      const std::function<void()>& abort, const std::function<void()>& commit)
+{
+  substep_start_previous_parameters_.resize(parameters_.size());
+
+  double remaining = dt;
+  double h         = dt;
+  int    cutbacks  = 0;
+
+  while (remaining > 0.0) {
+    // finish the increment exactly, rather than leaving a sliver of it behind due to roundoff
+    bool last = h >= remaining * (1.0 - 1.0e-12);
+    if (last) {
+      h = remaining;
+    }
+
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      substep_start_previous_parameters_[i] = *parameters_[i].previous_state;
+    }
+
+    if (solve(h)) {
+      commit();
+      remaining = last ? 0.0 : remaining - h;
+      h         = std::min(2.0 * h, dt);
+      continue;
+    }
+
+    abort();
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      *parameters_[i].previous_state = substep_start_previous_parameters_[i];
+    }
+
+    SLIC_ERROR_ROOT_IF(cutbacks >= max_cutbacks,
+                       axom::fmt::format("Nonlinear solve failed at t = {} with dt = {} after {} cutbacks", time_, h,
+                                         cutbacks));
+    cutbacks++;
+
+    SLIC_INFO_ROOT(axom::fmt::format("Nonlinear solve failed at t = {} with dt = {}, retrying with dt = {}", time_, h,
+                                     0.5 * h));
+    h *= 0.5;
+  }
+}
+
+void BasePhysics::advanceWithContinuation(double dt, const std::function<bool(double)>& solve,
+                                          const std::function<void()>& abort, const std::function<void()>& commit)
+{
+  substep_start_previous_parameters_.resize(parameters_.size());
+
+  double remaining = dt;
+  double h         = std::min(continuation_increment_ > 0.0 ? continuation_increment_ : dt, max_increment_);
+
+  while (remaining > 0.0) {
+    // finish the increment exactly, rather than leaving a sliver of it behind due to roundoff
+    bool   last = h >= remaining * (1.0 - 1.0e-12);
+    double step = last ? remaining : h;
+
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      substep_start_previous_parameters_[i] = *parameters_[i].previous_state;
+    }
+
+    if (solve(step)) {
+      commit();
+      remaining = last ? 0.0 : remaining - step;
+
+      // the usual continuation heuristic: the load increment that would have needed the target number of iterations
+      int    iterations = nonlinear_iterations_.back();
+      double factor     = iterations > 0 ? std::sqrt(double(target_nonlinear_iterations_) / iterations) : 2.0;
+      h                 = std::clamp(h * std::clamp(factor, 0.5, 2.0), min_increment_, max_increment_);
+
+      continuation_increment_ = h;
+      continue;
+    }
+
+    abort();
+    for (size_t i = 0; i < parameters_.size(); i++) {
+      *parameters_[i].previous_state = substep_start_previous_parameters_[i];
+    }
+
+    SLIC_ERROR_ROOT_IF(0.5 * step < min_increment_,
+                       axom::fmt::format("Nonlinear solve failed at t = {} with the smallest load increment {}", time_,
+                                         step));
+
+    SLIC_INFO_ROOT(axom::fmt::format("Nonlinear solve failed at t = {} with dt = {}, retrying with dt = {}", time_,
+                                     step, 0.5 * step));
+    h = 0.5 * step;
+  }
+}
+
+void BasePhysics::setLinearizationPoint(const mfem::Vector& u)
+{
+  linearization_point_     = u;
+  has_linearization_point_ = true;
+}
+
+bool BasePhysics::takeLinearizationPoint(const mfem::Vector& u)
+{
+  bool same                = identical(linearization_point_, u);
+  bool taken               = has_linearization_point_ && same;
+  has_linearization_point_ = false;
+  return taken;
+}
+
+bool BasePhysics::identical(const mfem::Vector& a, const mfem::Vector& b) const
+{
+  int same = a.Size() == b.Size() && a.DistanceSquaredTo(b) == 0.0;
+  MPI_Allreduce(MPI_IN_PLACE, &same, 1, MPI_INT, MPI_LAND, comm_);
+  return same != 0;
+}
+
+void BasePhysics::recordConvergedState(const mfem::Vector& state)
+{
+  constexpr size_t max_states = 3;
+
+  if (converged_states_.size() == max_states) {
+    converged_states_.erase(converged_states_.begin());
+    converged_times_.erase(converged_times_.begin());
+  }
+  converged_states_.push_back(state);
+  converged_times_.push_back(time_);
+}
+
+memory::Usage BasePhysics::memoryUsage() const
+{
+  memory::Usage usage;
+
+  auto add_vectors = [&usage](const std::string& name, const auto& vectors) {
+    for (const auto* vector : vectors) {
+      usage[name] += memory::bytes(*vector);
+    }
+  };
+  add_vectors("states", states_);
+  add_vectors("states", adjoints_);
+  add_vectors("duals", duals_);
+  add_vectors("duals", dual_adjoints_);
+
+  for (const auto& parameter : parameters_) {
+    usage["parameters"] += memory::bytes(*parameter.state) + memory::bytes(*parameter.previous_state) +
+                           memory::bytes(*parameter.sensitivity);
+  }
+
+  for (const auto* checkpoints : {&checkpoint_states_, &recomputed_checkpoint_states_}) {
+    for (const auto& [cycle, checkpoint] : *checkpoints) {
+      for (const auto& [name, state] : checkpoint.states) {
+        usage["checkpoints"] += state.bytes();
+      }
+    }
+  }
+  for (const auto& checkpoint : spare_checkpoints_) {
+    for (const auto& [name, state] : checkpoint.states) {
+      usage["checkpoints"] += state.bytes();
+    }
+  }
+  for (const auto& [name, state] : cached_checkpoint_states_) {
+    usage["checkpoints"] += memory::bytes(state);
+  }
+
+  for (const auto& state : converged_states_) {
+    usage["converged_states"] += memory::bytes(state);
+  }
+
+  return usage;
+}
+
+std::map<std::string, memory::Statistics> BasePhysics::memoryStatistics() const
+{
+  memory::Usage usage = memoryUsage();
+
+  usage["total"]         = memory::total(usage);
+  usage["resident"]      = memory::residentBytes();
+  usage["peak_resident"] = memory::peakResidentBytes();
+
+  return memory::reduce(usage, comm_);
+}
+
+RunPlan BasePhysics::plan(int num_cycles, const CostModel& /* model */) const
+{
+  SLIC_ERROR_ROOT_IF(num_cycles < 0, "The number of cycles to plan must be non-negative");
+
+  RunPlan run_plan;
+  run_plan.bytes = memoryUsage();
+
+  if (checkpoint_to_disk_) {
+    return run_plan;
+  }
+
+  // the bytes of one checkpoint, taking a byte per value for quantized states (i.e. smooth fields)
+  std::size_t checkpoint_bytes = 0;
+  for (const auto& state_name : stateNames()) {
+    auto size = static_cast<std::size_t>(state(state_name).Size());
+    switch (checkpointCompression(state_name).method) {
+      case CheckpointCompression::None:
+        checkpoint_bytes += size * sizeof(double);
+        break;
+      case CheckpointCompression::SinglePrecision:
+        checkpoint_bytes += size * sizeof(float);
+        break;
+      case CheckpointCompression::Quantized:
+        checkpoint_bytes += size;
+        break;
+    }
+  }
+
+  // every cycle (and the initial state) is checkpointed, unless a budget thins them out. In that case the reverse
+  // pass also recomputes the cycles between two of the kept checkpoints
+  std::size_t num_checkpoints = static_cast<std::size_t>(num_cycles) + 1;
+  if (max_checkpoints_ > 0 && num_cycles > max_checkpoints_) {
+    auto stride     = (num_cycles + max_checkpoints_ - 1) / max_checkpoints_;
+    num_checkpoints = static_cast<std::size_t>(max_checkpoints_ + 1 + stride);
+  }
+
+  auto& checkpoints = run_plan.bytes["checkpoints"];
+  checkpoints       = std::max(checkpoints, num_checkpoints * checkpoint_bytes);
+
+  return run_plan;
+}
+
+void BasePhysics::recordSolverTelemetry(const SolverTelemetry& telemetry)
+{
+  solver_telemetry_.push_back(telemetry);
+  solver_telemetry_times_.push_back(time_);
+
+  auto [_, rank] = getMPIInfo();
+  if (output_options_.solver_telemetry_file.empty() || rank != 0) {
+    return;
+  }
+
+  // non-finite residual norms (from a failed residual evaluation) are not valid JSON
+  auto number = [](double value) { return std::isfinite(value) ? axom::fmt::format("{}", value) : "null"; };
+
+  std::string residuals;
+  for (double norm : telemetry.residual_norms) {
+    residuals += (residuals.empty() ? "" : ", ") + number(norm);
+  }
+
+  std::ofstream file(output_options_.solver_telemetry_file, std::ios::app);
+  SLIC_ERROR_IF(!file, axom::fmt::format("Could not open '{}' to write the solver telemetry",
+                                         output_options_.solver_telemetry_file));
+  file << axom::fmt::format(
+      "{{\"physics\": \"{}\", \"cycle\": {}, \"time\": {}, \"nonlinear_iterations\": {}, \"converged\": {}, "
+      "\"line_search_cutbacks\": {}, \"jacobian_assemblies\": {}, \"preconditioner_setups\": {}, "
+      "\"linear_solves\": {}, \"linear_iterations\": {}, \"assembly_time\": {}, \"preconditioner_time\": {}, "
+      "\"linear_solve_time\": {}, \"solve_time\": {}, \"residual_norms\": [{}]}}\n",
+      name_, cycle_, time_, telemetry.nonlinear_iterations, telemetry.converged, telemetry.line_search_cutbacks,
+      telemetry.jacobian_assemblies, telemetry.preconditioner_setups, telemetry.linear_solves,
+      telemetry.linear_iterations, telemetry.assembly_time, telemetry.preconditioner_time, telemetry.linear_solve_time,
+      telemetry.solve_time, residuals);
+}
+
+void BasePhysics::extrapolateState(double t, int order, mfem::Vector& state) const
+{
+  SLIC_ERROR_ROOT_IF(order < 0 || order > 2, axom::fmt::format("Unsupported extrapolation order {}", order));
+
+  if (converged_states_.empty()) {
+    return;
+  }
+
+  // use the newest (order + 1) states
+  size_t n     = std::min(converged_states_.size(), size_t(order) + 1);
+  size_t first = converged_states_.size() - n;
+
+  state.SetSize(converged_states_.back().Size());
+  state = 0.0;
+  for (size_t i = first; i < converged_states_.size(); i++) {
+    double L = 1.0;
+    for (size_t j = first; j < converged_states_.size(); j++) {
+      if (j != i) {
+        L *= (t - converged_times_[j]) / (converged_times_[i] - converged_times_[j]);
+      }
+    }
+    state.Add(L, converged_states_[i]);
+  }
 }
 
 void BasePhysics::setParameter(const size_t parameter_index, const FiniteElementState& parameter_state)
@@ -95,7 +437,59 @@ void BasePhysics::setParameter(const size_t parameter_index, const FiniteElement
           "spaces are inconsistent.",
           parameter_index, parameters_[parameter_index].state->space().GetTrueVSize(),
           parameter_state.space().GetTrueVSize()));
-  *parameters_[parameter_index].state = parameter_state;
+
+  // a bound parameter gets its own storage back, rather than writing into the state it is a view of
+  auto& parameter = parameters_[parameter_index];
+  if (parameter.bound_to) {
+    parameter.state->Destroy();
+    parameter.state->SetSize(parameter_state.Size());
+    parameter.bound_to = nullptr;
+  }
+  *parameter.state = parameter_state;
+}
+
+void BasePhysics::bindParameter(const size_t parameter_index, const FiniteElementState& source)
+{
+  SLIC_ERROR_ROOT_IF(
+      parameter_index >= parameters_.size(),
+      axom::fmt::format("Parameter '{}' requested when only '{}' parameters exist in physics module '{}'",
+                        parameter_index, parameters_.size(), name_));
+
+  SLIC_ERROR_ROOT_IF(&source.mesh() != &mesh_,
+                     axom::fmt::format("Mesh of parameter '{}' is not the same as the physics mesh", parameter_index));
+
+  auto& parameter = parameters_[parameter_index];
+  SLIC_ERROR_ROOT_IF(source.space().GetTrueVSize() != parameter.state->space().GetTrueVSize(),
+                     axom::fmt::format("Physics module parameter '{}' has size '{}' while the bound state has size "
+                                       "'{}'. The finite element spaces are inconsistent.",
+                                       parameter_index, parameter.state->space().GetTrueVSize(),
+                                       source.space().GetTrueVSize()));
+
+  if (parameter.bound_to == &source) {
+    return;
+  }
+
+  // mfem only makes views of non-const vectors, but the parameters are never written to while they are bound
+  parameter.state->MakeRef(const_cast<FiniteElementState&>(source), 0, source.Size());
+  parameter.bound_to = &source;
+}
+
+bool BasePhysics::parameterChanged(const size_t parameter_index)
+{
+  auto& parameter = parameters_.at(parameter_index);
+
+  // the FNV-1a hash of the bytes of the local values
+  std::uint64_t        hash   = 14695981039346656037ull;
+  const double*        values = parameter.state->HostRead();
+  const unsigned char* bytes  = reinterpret_cast<const unsigned char*>(values);
+  for (std::size_t i = 0; i < std::size_t(parameter.state->Size()) * sizeof(double); i++) {
+    hash = (hash ^ bytes[i]) * 1099511628211ull;
+  }
+
+  int changed           = (hash != parameter.fingerprint);
+  parameter.fingerprint = hash;
+  MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_LOR, comm_);
+  return changed != 0;
 }
 
 void BasePhysics::setShapeDisplacement(const FiniteElementState& shape_displacement)
@@ -112,6 +506,23 @@ void BasePhysics::setShapeDisplacement(const FiniteElementState& shape_displacem
   shape_displacement_ = shape_displacement;
 }
 
+namespace {
+
+/// The background thread shared by the asynchronous output of all physics modules
+output::AsyncWriter& asynchronousOutputWriter()
+{
+  static output::AsyncWriter writer;
+  return writer;
+}
+
+}  // namespace
+
+BasePhysics::~BasePhysics()
+{
+  // the pending write may still read this module's paraview data collection
+  waitForOutput();
+}
+
 void BasePhysics::CreateParaviewDataCollection() const
 {
   std::string output_name = name_;
@@ -119,58 +530,127 @@ void BasePhysics::CreateParaviewDataCollection() const
     output_name = "default";
   }
 
-  paraview_dc_ =
-      std::make_unique<mfem::ParaViewDataCollection>(output_name, const_cast<mfem::ParMesh*>(&states_.front()->mesh()));
+  mfem::ParMesh* mesh = const_cast<mfem::ParMesh*>(&states_.front()->mesh());
+  if (!output_options_.element_attributes.empty()) {
+    mfem::Array<int> attributes(output_options_.element_attributes.data(),
+                                static_cast<int>(output_options_.element_attributes.size()));
+    paraview_submesh_ = std::make_unique<mfem::ParSubMesh>(mfem::ParSubMesh::CreateFromDomain(*mesh, attributes));
+    mesh              = paraview_submesh_.get();
+  }
+
+  paraview_dc_            = std::make_unique<mfem::ParaViewDataCollection>(output_name, mesh);
   int max_order_in_fields = 0;
 
-  // Find the maximum polynomial order in the physics module's states
+  const auto& fields = output_options_.fields;
+
+  // Register the grid function to write for a field, which is the field itself unless it has to be restricted to the
+  // mesh subset, interpolated to a lower order, or staged for an asynchronous write
+  auto add_field = [&](const std::string& name, const mfem::ParGridFunction& source,
+                       std::function<const mfem::ParGridFunction&()> update) {
+    if (!fields.empty() && std::find(fields.begin(), fields.end(), name) == fields.end()) {
+      return;
+    }
+
+    ParaviewField field{.update = std::move(update)};
+
+    const mfem::ParGridFunction* values          = &source;
+    auto*                        source_space    = source.ParFESpace();
+    int                          output_order    = source_space->GetMaxElementOrder();
+    const bool                   lower_order     = output_options_.visualization_order > 0 &&
+                                                   output_options_.visualization_order < output_order;
+    const bool                   copy_for_output = asynchronous_output_ && !paraview_submesh_ && !lower_order;
+
+    if (paraview_submesh_) {
+      field.submesh_space  = std::make_unique<mfem::ParFiniteElementSpace>(
+          paraview_submesh_.get(), source_space->FEColl(), source_space->GetVDim(), source_space->GetOrdering());
+      field.submesh_values = std::make_unique<mfem::ParGridFunction>(field.submesh_space.get());
+      values               = field.submesh_values.get();
+    }
+
+    if (lower_order) {
+      output_order = output_options_.visualization_order;
+      field.collection.reset(source_space->FEColl()->Clone(output_order));
+      field.space  = std::make_unique<mfem::ParFiniteElementSpace>(values->ParFESpace()->GetParMesh(),
+                                                                   field.collection.get(), source_space->GetVDim(),
+                                                                   source_space->GetOrdering());
+      field.values = std::make_unique<mfem::ParGridFunction>(field.space.get());
+      values       = field.values.get();
+    } else if (copy_for_output) {
+      field.values = std::make_unique<mfem::ParGridFunction>(source_space);
+      values       = field.values.get();
+    }
+
+    max_order_in_fields = std::max(max_order_in_fields, output_order);
+    paraview_dc_->RegisterField(name, const_cast<mfem::ParGridFunction*>(values));
+    paraview_fields_.push_back(std::move(field));
+  };
+
+  auto add_state = [&](const FiniteElementState& state) {
+    add_field(state.name(), state.gridFunction(), [&state]() -> const mfem::ParGridFunction& {
+      return state.gridFunction();  // update grid function values
+    });
+  };
+
+  auto add_dual = [&](const FiniteElementDual& dual, std::unique_ptr<mfem::ParGridFunction>& grid_function) {
+    grid_function =
+        std::make_unique<mfem::ParGridFunction>(const_cast<mfem::ParFiniteElementSpace*>(&dual.space()));
+    add_field(dual.name(), *grid_function, [&dual, gf = grid_function.get()]() -> const mfem::ParGridFunction& {
+      const_cast<FiniteElementDual&>(dual).linearForm().ParallelAssemble(gf->GetTrueVector());
+      gf->SetFromTrueVector();
+      return *gf;
+    });
+  };
+
   for (const FiniteElementState* state : states_) {
-    paraview_dc_->RegisterField(state->name(), &state->gridFunction());
-    max_order_in_fields = std::max(max_order_in_fields, state->space().GetOrder(0));
+    add_state(*state);
   }
 
   for (const FiniteElementDual* dual : duals_) {
-    paraview_dual_grid_functions_[dual->name()] =
-        std::make_unique<mfem::ParGridFunction>(const_cast<mfem::ParFiniteElementSpace*>(&dual->space()));
-    max_order_in_fields = std::max(max_order_in_fields, dual->space().GetOrder(0));
-    paraview_dc_->RegisterField(dual->name(), paraview_dual_grid_functions_[dual->name()].get());
+    add_dual(*dual, paraview_dual_grid_functions_[dual->name()]);
   }
 
   for (auto& parameter : parameters_) {
-    paraview_dc_->RegisterField(parameter.state->name(), &parameter.state->gridFunction());
-    max_order_in_fields = std::max(max_order_in_fields, parameter.state->space().GetOrder(0));
+    add_state(*parameter.state);
   }
 
-  paraview_dc_->RegisterField(shape_displacement_.name(), &shape_displacement_.gridFunction());
-  max_order_in_fields = std::max(max_order_in_fields, shape_displacement_.space().GetOrder(0));
+  add_state(shape_displacement_);
+  add_dual(*shape_displacement_sensitivity_, shape_sensitivity_grid_function_);
+
+  for (const auto& output : output_fields_) {
+    add_field(output.field->name(), output.field->gridFunction(),
+              [field = output.field, update = output.update]() -> const mfem::ParGridFunction& {
+                update();
+                return field->gridFunction();
+              });
+  }
 
-  shape_sensitivity_grid_function_ = std::make_unique<mfem::ParGridFunction>(&shape_displacement_sensitivity_->space());
-  max_order_in_fields = std::max(max_order_in_fields, shape_displacement_sensitivity_->space().GetOrder(0));
-  paraview_dc_->RegisterField(shape_displacement_sensitivity_->name(), shape_sensitivity_grid_function_.get());
+  SLIC_ERROR_ROOT_IF(paraview_fields_.empty(),
+                     axom::fmt::format("None of the requested output fields exist in physics module {}.", name_));
 
   // Set the options for the paraview output files
   paraview_dc_->SetLevelsOfDetail(max_order_in_fields);
   paraview_dc_->SetHighOrderOutput(true);
-  paraview_dc_->SetDataFormat(mfem::VTKFormat::BINARY);
+  paraview_dc_->SetDataFormat(output_options_.single_precision_visualization ? mfem::VTKFormat::BINARY32
+                                                                              : mfem::VTKFormat::BINARY);
   paraview_dc_->SetCompression(true);
 }
 
 void BasePhysics::UpdateParaviewDataCollection(const std::string& paraview_output_dir) const
 {
-  for (const FiniteElementState* state : states_) {
-    state->gridFunction();  // update grid function values
-  }
-  for (const FiniteElementDual* dual : duals_) {
-    serac::FiniteElementDual* non_const_dual = const_cast<serac::FiniteElementDual*>(dual);
-    non_const_dual->linearForm().ParallelAssemble(paraview_dual_grid_functions_[dual->name()]->GetTrueVector());
-    paraview_dual_grid_functions_[dual->name()]->SetFromTrueVector();
-  }
-  for (auto& parameter : parameters_) {
-    parameter.state->gridFunction();
+  for (auto& field : paraview_fields_) {
+    const mfem::ParGridFunction* values = &field.update();
+
+    if (field.submesh_values) {
+      mfem::ParSubMesh::Transfer(*values, *field.submesh_values);
+      values = field.submesh_values.get();
+    }
+
+    if (field.collection) {
+      field.values->ProjectGridFunction(*values);
+    } else if (field.values) {
+      *field.values = *values;
+    }
   }
-  shape_displacement_.gridFunction();
-  shape_displacement_sensitivity_->linearForm().ParallelAssemble(shape_sensitivity_grid_function_->GetTrueVector());
-  shape_sensitivity_grid_function_->SetFromTrueVector();
 
   // Set the current time, cycle, and requested paraview directory
   paraview_dc_->SetCycle(cycle_);
@@ -178,9 +658,8 @@ void BasePhysics::UpdateParaviewDataCollection(const std::string& paraview_outpu
   paraview_dc_->SetPrefixPath(paraview_output_dir);
 }
 
-void BasePhysics::outputStateToDisk(std::optional<std::string> paraview_output_dir) const
+void BasePhysics::updateStateManager() const
 {
-  // Update the states and duals in the state manager
   for (auto& state : states_) {
     StateManager::updateState(*state);
   }
@@ -197,8 +676,23 @@ void BasePhysics::outputStateToDisk(std::optional<std::string> paraview_output_d
   StateManager::updateState(shape_displacement_);
   StateManager::updateDual(*shape_displacement_sensitivity_);
 
+  for (auto& output : output_fields_) {
+    output.update();
+    StateManager::updateState(*output.field);
+  }
+}
+
+void BasePhysics::outputStateToDisk(std::optional<std::string> paraview_output_dir) const
+{
+  SERAC_MARK_FUNCTION;
+
+  // The previous asynchronous write may still be reading the staging buffers
+  waitForOutput();
+
+  updateStateManager();
+
   // Save the restart/Sidre file
-  StateManager::save(time_, cycle_, mesh_tag_);
+  auto save_sidre = StateManager::stageSave(time_, cycle_, mesh_tag_);
 
   // Optionally output a paraview datacollection for visualization
   if (paraview_output_dir) {
@@ -208,10 +702,135 @@ void BasePhysics::outputStateToDisk(std::optional<std::string> paraview_output_d
     }
 
     UpdateParaviewDataCollection(*paraview_output_dir);
+  }
+
+  auto write = [this, save_sidre, save_paraview = paraview_output_dir.has_value()]() {
+    save_sidre();
 
     // Write the paraview file
-    paraview_dc_->Save();
+    if (save_paraview) {
+      paraview_dc_->Save();
+    }
+  };
+
+  if (asynchronous_output_) {
+    asynchronousOutputWriter().submit(write);
+  } else {
+    write();
+  }
+}
+
+void BasePhysics::setAsynchronousOutput(bool asynchronous)
+{
+  waitForOutput();
+
+  if (asynchronous && checkpoint_to_disk_) {
+    SLIC_WARNING_ROOT(axom::fmt::format(
+        "Asynchronous output is not used with disk checkpointing, physics module {} writes synchronously.", name_));
+    asynchronous = false;
+  }
+
+  if (asynchronous && !output::supportsAsynchronousWrites()) {
+    SLIC_WARNING_ROOT(axom::fmt::format(
+        "MPI was not initialized with MPI_THREAD_MULTIPLE, physics module {} writes synchronously.", name_));
+    asynchronous = false;
+  }
+
+  // the paraview data collection registers different grid functions for asynchronous output
+  if (asynchronous != asynchronous_output_) {
+    resetParaviewDataCollection();
+  }
+
+  asynchronous_output_ = asynchronous;
+}
+
+void BasePhysics::waitForOutput() const
+{
+  if (asynchronous_output_) {
+    asynchronousOutputWriter().wait();
+  }
+}
+
+void BasePhysics::setOutputOptions(const OutputOptions& options)
+{
+  SLIC_ERROR_ROOT_IF(options.cycle_interval < 1, "The output cycle interval must be at least 1");
+  SLIC_ERROR_ROOT_IF(options.time_interval < 0.0, "The output time interval must be non-negative");
+  SLIC_ERROR_ROOT_IF(options.visualization_order < 0, "The visualization order must be non-negative");
+
+  waitForOutput();
+  output_options_ = options;
+  resetParaviewDataCollection();
+}
+
+bool BasePhysics::writeOutput(std::optional<std::string> paraview_output_dir, bool force)
+{
+  bool due = force || !last_output_cycle_;
+
+  if (!due && output_options_.time_interval > 0.0) {
+    // write once each time a multiple of the interval is crossed, with a small tolerance for roundoff in the time
+    constexpr double tolerance = 1.0e-8;
+    due = std::floor(time_ / output_options_.time_interval + tolerance) >
+          std::floor(last_output_time_ / output_options_.time_interval + tolerance);
+  } else if (!due) {
+    due = cycle_ - *last_output_cycle_ >= output_options_.cycle_interval;
+  }
+
+  if (due) {
+    // publish first, so that it does not wait for an asynchronous write started just before
+    if (in_situ_pipeline_) {
+      publishInSitu();
+    }
+    if (output_options_.write_to_disk) {
+      outputStateToDisk(paraview_output_dir);
+    }
+    last_output_cycle_ = cycle_;
+    last_output_time_  = time_;
+  }
+
+  return due;
+}
+
+void BasePhysics::publishInSitu() const
+{
+  SLIC_ERROR_ROOT_IF(!in_situ_pipeline_,
+                     axom::fmt::format("No in-situ pipeline was set for physics module '{}'", name_));
+
+  // The previous asynchronous write may still be reading the grid functions of the state manager
+  waitForOutput();
+  updateStateManager();
+
+  conduit::Node mesh;
+  StateManager::blueprintMesh(time_, cycle_, mesh_tag_, mesh);
+  in_situ_pipeline_(mesh);
+}
+
+void BasePhysics::resetParaviewDataCollection()
+{
+  paraview_dc_.reset();
+  paraview_fields_.clear();
+  paraview_submesh_.reset();
+}
+
+const FiniteElementState& BasePhysics::outputField(const std::string& field_name) const
+{
+  std::string name = detail::addPrefix(name_, field_name);
+  for (const auto& output : output_fields_) {
+    if (output.field->name() == name) {
+      output.update();
+      return *output.field;
+    }
   }
+  SLIC_ERROR_ROOT(axom::fmt::format("Output field '{}' does not exist in physics module '{}'", field_name, name_));
+  return *output_fields_.front().field;
+}
+
+void BasePhysics::addOutputField(const FiniteElementState& field, std::function<void()> update)
+{
+  output_fields_.push_back({&field, std::move(update)});
+
+  // an existing data collection is recreated with the new field
+  waitForOutput();
+  resetParaviewDataCollection();
 }
 
 void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_final, double dt) const
@@ -225,10 +844,23 @@ void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_
   //         ├── <FiniteElementState name>
   //         │    ├── l1norm : Sidre::Array<double>
   //         │    └── l2norm : Sidre::Array<double>
+  //         ├── <FiniteElementState name>
+  //         │    ├── l1norm : Sidre::Array<double>
+  //         │    └── l2norm : Sidre::Array<double>
   //         ...
-  //         └── <FiniteElementState name>
-  //              ├── l1norm : Sidre::Array<double>
-  //              └── l2norm : Sidre::Array<double>
+  //         ├── solver (one entry per committed nonlinear solve, see SolverTelemetry)
+  //         │    ├── t : Sidre::Array<double>
+  //         │    ├── nonlinear_iterations : Sidre::Array<int>
+  //         │    ...
+  //         │    ├── solve_time : Sidre::Array<double>
+  //         │    ├── residual_norms : Sidre::Array<double> (the residual histories of all solves, concatenated)
+  //         │    └── residual_offsets : Sidre::Array<int> (where the residual history of each solve starts)
+  //         └── memory (bytes over the ranks at each time step, see memoryStatistics())
+  //              ├── <component name>
+  //              │    ├── min : Sidre::Array<double>
+  //              │    ├── max : Sidre::Array<double>
+  //              │    └── avg : Sidre::Array<double>
+  //              ...
 
   auto [count, rank] = getMPIInfo();
   if (rank != 0) {
@@ -265,10 +897,33 @@ void BasePhysics::initializeSummary(axom::sidre::DataStore& datastore, double t_
       axom::sidre::Array<double> array(curr_array_view, 0, array_size);
     }
   }
+
+  axom::sidre::Group* solver_group = curves_group->createGroup("solver");
+  for (std::string stat_name : {"nonlinear_iterations", "converged", "line_search_cutbacks", "jacobian_assemblies",
+                                "preconditioner_setups", "linear_solves", "linear_iterations", "residual_offsets"}) {
+    axom::sidre::View*      curr_array_view = solver_group->createView(stat_name);
+    axom::sidre::Array<int> array(curr_array_view, 0, array_size);
+  }
+  for (std::string stat_name :
+       {"t", "assembly_time", "preconditioner_time", "linear_solve_time", "solve_time", "residual_norms"}) {
+    axom::sidre::View*         curr_array_view = solver_group->createView(stat_name);
+    axom::sidre::Array<double> array(curr_array_view, 0, array_size);
+  }
+
+  // the memory groups are created by saveSummary(), as components can appear during the run
+  curves_group->createGroup("memory");
+}
+
+void BasePhysics::addProbes(const std::string& name, std::vector<mfem::Vector> points)
+{
+  SLIC_ERROR_ROOT_IF(probes_.count(name), axom::fmt::format("Probes '{}' were already added", name));
+  probes_.emplace(name, Probes(mesh_, std::move(points)));
 }
 
 void BasePhysics::saveSummary(axom::sidre::DataStore& datastore, const double t) const
 {
+  SERAC_MARK_FUNCTION;
+
   auto [_, rank] = getMPIInfo();
 
   // Find curves sidre group
@@ -329,9 +984,109 @@ void BasePhysics::saveSummary(axom::sidre::DataStore& datastore, const double t)
       mins.push_back(min_value);
     }
   }
+
+  // Save the telemetry of the nonlinear solves committed since the last call, as there may have been several substeps
+  if (rank == 0) {
+    axom::sidre::Group* solver_group = curves_group->getGroup("solver");
+
+    auto push = [solver_group](const std::string& stat_name, auto value) {
+      axom::sidre::Array<decltype(value)> array(solver_group->getView(stat_name));
+      array.push_back(value);
+    };
+
+    axom::sidre::Array<double> residual_norms(solver_group->getView("residual_norms"));
+
+    for (size_t i = summarized_telemetry_; i < solver_telemetry_.size(); i++) {
+      const SolverTelemetry& telemetry = solver_telemetry_[i];
+
+      push("t", solver_telemetry_times_[i]);
+      push("nonlinear_iterations", telemetry.nonlinear_iterations);
+      push("converged", int(telemetry.converged));
+      push("line_search_cutbacks", telemetry.line_search_cutbacks);
+      push("jacobian_assemblies", telemetry.jacobian_assemblies);
+      push("preconditioner_setups", telemetry.preconditioner_setups);
+      push("linear_solves", telemetry.linear_solves);
+      push("linear_iterations", telemetry.linear_iterations);
+      push("assembly_time", telemetry.assembly_time);
+      push("preconditioner_time", telemetry.preconditioner_time);
+      push("linear_solve_time", telemetry.linear_solve_time);
+      push("solve_time", telemetry.solve_time);
+      push("residual_offsets", int(residual_norms.size()));
+      for (double norm : telemetry.residual_norms) {
+        residual_norms.push_back(norm);
+      }
+    }
+  }
+  summarized_telemetry_ = solver_telemetry_.size();
+
+  // Save the values of the states at each set of probes. Note: This is a collective operation.
+  for (const auto& [probes_name, probes] : probes_) {
+    std::vector<double> samples = probes.sample(states_);
+    if (rank != 0) continue;
+
+    if (!curves_group->hasGroup("probes/" + probes_name)) {
+      axom::sidre::Group* probes_group = curves_group->createGroup("probes/" + probes_name);
+
+      axom::sidre::Array<double> points(probes_group->createView("points"), 0,
+                                        probes.size() * mesh_.SpaceDimension());
+      for (const auto& point : probes.points()) {
+        for (int i = 0; i < point.Size(); i++) {
+          points.push_back(point(i));
+        }
+      }
+      axom::sidre::Array<double> ts(probes_group->createView("t"), 0, 1);
+      for (const FiniteElementState* state : states_) {
+        axom::sidre::Array<double> values(probes_group->createView(state->name()), 0,
+                                          probes.size() * state->space().GetVDim());
+      }
+    }
+    axom::sidre::Group* probes_group = curves_group->getGroup("probes/" + probes_name);
+
+    axom::sidre::Array<double> ts(probes_group->getView("t"));
+    ts.push_back(t);
+
+    size_t offset = 0;
+    for (const FiniteElementState* state : states_) {
+      axom::sidre::Array<double> values(probes_group->getView(state->name()));
+      size_t                     count = size_t(probes.size() * state->space().GetVDim());
+      for (size_t i = offset; i < offset + count; i++) {
+        values.push_back(samples[i]);
+      }
+      offset += count;
+    }
+  }
+
+  // Save the memory used by each component. Note: This is a collective operation.
+  auto memory_statistics = memoryStatistics();
+  if (rank == 0) {
+    axom::sidre::Group* memory_group = curves_group->getGroup("memory");
+    auto                num_saved    = axom::sidre::Array<double>(curves_group->getView("t")).size() - 1;
+
+    for (const auto& [component, statistics] : memory_statistics) {
+      std::string group_name = component;
+      std::replace(group_name.begin(), group_name.end(), '/', '.');
+
+      axom::sidre::Group* component_group = memory_group->hasGroup(group_name) ? memory_group->getGroup(group_name)
+                                                                               : memory_group->createGroup(group_name);
+
+      for (auto [stat_name, value] : {std::pair{"min", statistics.min}, std::pair{"max", statistics.max},
+                                      std::pair{"avg", statistics.avg}}) {
+        if (!component_group->hasView(stat_name)) {
+          axom::sidre::Array<double> created(component_group->createView(stat_name), 0, num_saved + 1);
+        }
+        axom::sidre::Array<double> array(component_group->getView(stat_name));
+
+        // components that appeared after the start of the run used no memory before
+        while (array.size() < num_saved) {
+          array.push_back(0.0);
+        }
+        array.push_back(value);
+      }
+    }
+  }
 }
 
-FiniteElementState BasePhysics::loadCheckpointedState(const std::string& state_name, int cycle) const
+FiniteElementState BasePhysics::loadCheckpointedState(const std::string& state_name, int cycle)
 {
   if (checkpoint_to_disk_) {
     // See if the requested cycle has been checkpointed previously
@@ -348,12 +1103,233 @@ FiniteElementState BasePhysics::loadCheckpointedState(const std::string& state_n
     return cached_checkpoint_states_.at(state_name);
   }
 
+  recomputeCheckpointedStates(cycle);
+  auto states = checkpointedStatesInMemory(cycle);
+
   // Ensure that the state name exists in this physics module
   SLIC_ERROR_ROOT_IF(
-      checkpoint_states_.find(state_name) == checkpoint_states_.end(),
+      states.find(state_name) == states.end(),
+      axom::fmt::format("Requested state name {} does not exist in physics module {}.", state_name, name_));
+
+  return states.at(state_name);
+}
+
+std::vector<mfem::Vector> BasePhysics::snapshots(const std::string& state_name) const
+{
+  SLIC_ERROR_ROOT_IF(checkpoint_to_disk_, "Snapshots are only available from checkpoints in memory");
+
+  std::vector<mfem::Vector> output;
+  for (const auto& [cycle, checkpoint] : checkpoint_states_) {
+    auto states = expandCheckpoint(checkpoint);
+    auto state  = states.find(state_name);
+    SLIC_ERROR_ROOT_IF(
+        state == states.end(),
+        axom::fmt::format("Requested state name {} does not exist in physics module {}.", state_name, name_));
+    output.emplace_back(state->second);
+  }
+  return output;
+}
+
+void BasePhysics::setCheckpointBudget(int max_checkpoints)
+{
+  SLIC_ERROR_ROOT_IF(max_checkpoints < 0, "The checkpoint budget must be non-negative");
+  max_checkpoints_ = max_checkpoints;
+}
+
+void BasePhysics::checkpointStates()
+{
+  if (checkpoint_to_disk_) {
+    outputStateToDisk();
+    return;
+  }
+
+  if ((cycle_ - min_cycle_) % checkpoint_stride_ != 0) {
+    return;
+  }
+
+  if (auto existing = checkpoint_states_.find(cycle_); existing != checkpoint_states_.end()) {
+    recycleCheckpoint(std::move(existing->second));
+  }
+  checkpoint_states_[cycle_] = makeCheckpoint();
+
+  // thin out the checkpoints when over budget, keeping cycles that are multiples of the (doubled) stride
+  while (max_checkpoints_ > 0 && static_cast<int>(checkpoint_states_.size()) > max_checkpoints_) {
+    checkpoint_stride_ *= 2;
+    for (auto it = checkpoint_states_.begin(); it != checkpoint_states_.end();) {
+      if ((it->first - min_cycle_) % checkpoint_stride_ != 0) {
+        recycleCheckpoint(std::move(it->second));
+        it = checkpoint_states_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void BasePhysics::setCheckpointCompression(const std::string& state_name, const CheckpointCompressionOptions& options)
+{
+  auto names = stateNames();
+  SLIC_ERROR_ROOT_IF(
+      std::find(names.begin(), names.end(), state_name) == names.end(),
       axom::fmt::format("Requested state name {} does not exist in physics module {}.", state_name, name_));
+  SLIC_ERROR_ROOT_IF(options.method == CheckpointCompression::Quantized && options.tolerance <= 0.0,
+                     "Quantized checkpoint compression requires a positive tolerance");
+  checkpoint_compression_[state_name] = options;
+}
+
+void BasePhysics::reserveCheckpoints(int num_cycles)
+{
+  SLIC_ERROR_ROOT_IF(num_cycles < 0, "The number of checkpoints to reserve must be non-negative");
+  if (checkpoint_to_disk_) {
+    return;
+  }
+
+  // the budget is only enforced after a checkpoint over it is taken
+  if (max_checkpoints_ > 0) {
+    num_cycles = std::min(num_cycles, max_checkpoints_ + 1);
+  }
+
+  while (static_cast<int>(spare_checkpoints_.size()) < num_cycles) {
+    Checkpoint checkpoint;
+    for (const auto& state_name : stateNames()) {
+      checkpoint.states[state_name].reserve(state(state_name).Size(), checkpointCompression(state_name));
+    }
+    spare_checkpoints_.push_back(std::move(checkpoint));
+  }
+}
+
+BasePhysics::Checkpoint BasePhysics::makeCheckpoint()
+{
+  Checkpoint checkpoint;
+  if (!spare_checkpoints_.empty()) {
+    checkpoint = std::move(spare_checkpoints_.back());
+    spare_checkpoints_.pop_back();
+  }
+
+  checkpoint.time = time_;
+  for (const auto& state_name : stateNames()) {
+    checkpoint.states[state_name].compress(state(state_name), checkpointCompression(state_name));
+  }
+  return checkpoint;
+}
+
+void BasePhysics::recycleCheckpoint(Checkpoint&& checkpoint) { spare_checkpoints_.push_back(std::move(checkpoint)); }
+
+CheckpointCompressionOptions BasePhysics::checkpointCompression(const std::string& state_name) const
+{
+  auto options = checkpoint_compression_.find(state_name);
+  return options != checkpoint_compression_.end() ? options->second : CheckpointCompressionOptions{};
+}
+
+std::unordered_map<std::string, FiniteElementState> BasePhysics::expandCheckpoint(const Checkpoint& checkpoint) const
+{
+  std::unordered_map<std::string, FiniteElementState> states;
+  for (const auto& [state_name, compressed] : checkpoint.states) {
+    // copy the current state for its space, then overwrite its values
+    auto entry = states.emplace(state_name, state(state_name)).first;
+    compressed.decompress(entry->second);
+  }
+  return states;
+}
+
+void BasePhysics::clearCheckpointedStates()
+{
+  for (auto* checkpoints : {&checkpoint_states_, &recomputed_checkpoint_states_}) {
+    for (auto& [cycle, checkpoint] : *checkpoints) {
+      recycleCheckpoint(std::move(checkpoint));
+    }
+    checkpoints->clear();
+  }
+  checkpoint_stride_ = 1;
+}
 
-  return checkpoint_states_.at(state_name)[static_cast<size_t>(cycle)];
+void BasePhysics::updateCheckpointedState(const std::string& state_name, const FiniteElementState& state)
+{
+  if (auto checkpoint = checkpoint_states_.find(cycle_); checkpoint != checkpoint_states_.end()) {
+    checkpoint->second.states.at(state_name).compress(state, checkpointCompression(state_name));
+  }
+}
+
+std::unordered_map<std::string, FiniteElementState> BasePhysics::checkpointedStatesInMemory(int cycle) const
+{
+  if (auto checkpoint = checkpoint_states_.find(cycle); checkpoint != checkpoint_states_.end()) {
+    return expandCheckpoint(checkpoint->second);
+  }
+
+  if (auto checkpoint = recomputed_checkpoint_states_.find(cycle); checkpoint != recomputed_checkpoint_states_.end()) {
+    return expandCheckpoint(checkpoint->second);
+  }
+
+  SLIC_ERROR_ROOT(axom::fmt::format(
+      "The states at cycle {} of physics module {} are not checkpointed. Cycles dropped by the checkpoint budget are "
+      "only available after recomputeCheckpointedStates().",
+      cycle, name_));
+  return {};
+}
+
+void BasePhysics::recomputeCheckpointedStates(int cycle)
+{
+  if (checkpoint_to_disk_ || checkpoint_states_.count(cycle) || recomputed_checkpoint_states_.count(cycle)) {
+    return;
+  }
+
+  SLIC_ERROR_ROOT_IF(cycle > max_cycle_,
+                     axom::fmt::format("States for cycle {} requested, but physics module has only reached cycle {}.",
+                                       cycle, max_cycle_));
+
+  // recompute from the closest kept checkpoint before the requested cycle, up to the next kept checkpoint
+  auto start = checkpoint_states_.upper_bound(cycle);
+  SLIC_ERROR_ROOT_IF(start == checkpoint_states_.begin(),
+                     axom::fmt::format("No checkpoint precedes cycle {} in physics module {}.", cycle, name_));
+  auto end = start;
+  --start;
+  int last_cycle = (end == checkpoint_states_.end()) ? max_cycle_ : end->first - 1;
+
+  for (auto& [recomputed_cycle, checkpoint] : recomputed_checkpoint_states_) {
+    recycleCheckpoint(std::move(checkpoint));
+  }
+  recomputed_checkpoint_states_.clear();
+
+  const double time           = time_;
+  const double ode_time_point = ode_time_point_;
+
+  std::unordered_map<std::string, FiniteElementState> current_states;
+  for (const auto& state_name : stateNames()) {
+    current_states.emplace(state_name, state(state_name));
+  }
+
+  time_ = start->second.time;
+  restoreCheckpoint(expandCheckpoint(start->second));
+
+  for (int c = start->first; c < last_cycle; c++) {
+    recomputeTimestep(getCheckpointedTimestep(c));
+
+    recomputed_checkpoint_states_[c + 1] = makeCheckpoint();
+  }
+
+  restoreCheckpoint(current_states);
+  time_           = time;
+  ode_time_point_ = ode_time_point;
+}
+
+void BasePhysics::loadTransferredStates()
+{
+  for (const auto& state_name : stateNames()) {
+    FiniteElementState moved(state(state_name));
+    if (StateManager::loadTransferredState(moved)) {
+      setState(state_name, moved);
+    }
+  }
+}
+
+void BasePhysics::restoreCheckpoint(const std::unordered_map<std::string, FiniteElementState>&)
+{
+  SLIC_ERROR_ROOT(axom::fmt::format("Recomputing checkpoints is not implemented for physics module {}.", name_));
+}
+
+void BasePhysics::recomputeTimestep(double)
+{
+  SLIC_ERROR_ROOT(axom::fmt::format("Recomputing checkpoints is not implemented for physics module {}.", name_));
 }
 
 std::unordered_map<std::string, FiniteElementState> BasePhysics::getCheckpointedStates(int /*cycle*/) const
@@ -373,6 +1349,21 @@ double BasePhysics::getCheckpointedTimestep(int cycle) const
   return timesteps_[static_cast<size_t>(cycle)];
 }
 
+std::string to_string(JacobianPolicy policy)
+{
+  switch (policy) {
+    case JacobianPolicy::Assembled:
+      return "assembled";
+    case JacobianPolicy::AssembledBinarySearch:
+      return "assembled with binary search lookups";
+    case JacobianPolicy::StoredDerivatives:
+      return "matrix-free with stored derivatives";
+    case JacobianPolicy::RecomputedDerivatives:
+      return "matrix-free with recomputed derivatives";
+  }
+  return "unknown";
+}
+
 namespace detail {
 std::string addPrefix(const std::string& prefix, const std::string& target)
 {
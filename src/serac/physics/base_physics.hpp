@@ -12,18 +12,30 @@
 
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <map>
 #include <memory>
 
 #include "mfem.hpp"
+#include "axom/fmt.hpp"
 #include "axom/sidre.hpp"
 
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
+#include "serac/infrastructure/run_plan.hpp"
 #include "serac/physics/boundary_conditions/boundary_condition_manager.hpp"
 #include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/functional/dof_numbering.hpp"
+#include "serac/physics/state/checkpoint_compression.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/finite_element_dual.hpp"
+#include "serac/physics/state/probes.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/common.hpp"
+#include "serac/physics/output_options.hpp"
 
 namespace serac {
 
@@ -45,6 +57,18 @@ std::string removePrefix(const std::string& prefix, const std::string& target);
 
 }  // namespace detail
 
+/// @brief How the gradient of a residual w.r.t. its primal unknown is formed, see automaticJacobianPolicy()
+enum class JacobianPolicy
+{
+  Assembled,              ///< assembled into a sparse matrix, with precomputed lookup tables (fastest assembly)
+  AssembledBinarySearch,  ///< assembled into a sparse matrix, finding each nonzero with a binary search (less memory)
+  StoredDerivatives,      ///< applied matrix-free with the q-function derivatives stored at every quadrature point
+  RecomputedDerivatives   ///< applied matrix-free, re-evaluating the q-functions in every application (least memory)
+};
+
+/// @brief The name of a Jacobian policy, e.g. for logging
+std::string to_string(JacobianPolicy policy);
+
 /**
  * @brief This is the abstract base class for a generic forward solver
  */
@@ -125,6 +149,64 @@ public:
    */
   virtual std::vector<double> timesteps() const;
 
+  /**
+   * @brief Get the number of Newton iterations taken by the nonlinear solve of each committed timestep
+   *
+   * For transient schemes with several implicit stages per step, this is the count of the last stage. Together with
+   * TimesteppingOptions::predictor, this shows how much work each initial guess saves.
+   *
+   * @return The Newton iteration counts, in the order of the committed timesteps
+   */
+  const std::vector<int>& nonlinearIterations() const { return nonlinear_iterations_; }
+
+  /**
+   * @brief Get the telemetry (iteration counts, timings and residual history) of the nonlinear solve of each committed
+   * timestep
+   *
+   * Explicit timesteps record an empty SolverTelemetry. See also OutputOptions::solver_telemetry_file.
+   *
+   * @return The solver telemetry, in the order of the committed timesteps
+   */
+  const std::vector<SolverTelemetry>& solverTelemetry() const { return solver_telemetry_; }
+
+  /**
+   * @brief Get the bytes of memory used on this rank by each component of the physics module
+   *
+   * The base implementation accounts for the finite element states, duals and parameters, the in-memory checkpoints
+   * and the converged states kept for extrapolation. Physics modules add their residuals, assembled matrices and
+   * quadrature data.
+   *
+   * @return The bytes used by each component, by name
+   */
+  virtual memory::Usage memoryUsage() const;
+
+  /**
+   * @brief Get the minimum, maximum and average over the ranks of the bytes used by each component of memoryUsage()
+   *
+   * The statistics also include the "total" of the components, and the "resident" and "peak_resident" set sizes of
+   * the processes. saveSummary() records them at every call, to track their growth over a run.
+   *
+   * @return The statistics of each component, by name
+   *
+   * @note This is a collective operation
+   */
+  std::map<std::string, memory::Statistics> memoryStatistics() const;
+
+  /**
+   * @brief Predict the bytes of memory each component will use on this rank, and the time of each phase, for a run of
+   * a number of cycles, before any of it is allocated or solved
+   *
+   * The base implementation plans the current memoryUsage() and the checkpoints of the primal states, given the
+   * checkpoint budget, compression and whether they go to disk. Physics modules add the residual and matrices they
+   * will have once a gradient is assembled, and time estimates for evaluating and assembling it. The time estimates
+   * are a roofline of the kernels' flops and bytes, and don't include the linear solves.
+   *
+   * @param num_cycles The number of cycles (i.e. time steps) of the run
+   * @param model The rates of each rank, and assumptions about the solve
+   * @return The planned bytes of each component (by the names of memoryUsage()) and seconds of each phase
+   */
+  virtual RunPlan plan(int num_cycles, const CostModel& model = {}) const;
+
   /**
    * @brief Base method to reset physics states to zero.  This does not reset design parameters or shape.
    *
@@ -161,6 +243,23 @@ public:
    */
   virtual std::vector<std::string> stateNames() const = 0;
 
+  /**
+   * @brief Accessor for the fields that are only computed when they are written, e.g. derived material quantities
+   *
+   * @param field_name The name of the field, without the prefix of this module
+   * @return The named field, updated to the current state of this module
+   */
+  const FiniteElementState& outputField(const std::string& field_name) const;
+
+  /**
+   * @brief Set the primal solution fields to the values transferred by StateManager::rebalance(),
+   * StateManager::refine() or StateManager::derefine()
+   *
+   * This is meant for physics modules constructed again on the new mesh. States that were not transferred are left
+   * unchanged.
+   */
+  void loadTransferredStates();
+
   /**
    * @brief Accessor for getting named finite element state adjoint solution from the physics modules
    *
@@ -288,6 +387,42 @@ public:
    */
   void setParameter(const size_t parameter_index, const FiniteElementState& parameter_state);
 
+  /**
+   * @brief Make a parameter a view of another finite element state (e.g. a primal state of another physics module),
+   * rather than a copy of it, so that the values of that state are used without copying them
+   *
+   * @param parameter_index the index of the parameter
+   * @param source the state whose values the parameter uses from now on, which must outlive the binding
+   *
+   * @pre The discretization space and mesh of @a source must be consistent with the arguments provided in the physics
+   * module constructor, as for setParameter()
+   *
+   * The parameter stays bound until setParameter() copies values into it, which gives it its own storage again. The
+   * physics module only reads its parameters, so @a source is never modified through the binding. Binding a parameter
+   * to the state it is already bound to does nothing.
+   */
+  void bindParameter(const size_t parameter_index, const FiniteElementState& source);
+
+  /// @brief Whether a parameter is a view of another state, see bindParameter()
+  bool parameterBound(const size_t parameter_index) const
+  {
+    return parameters_.at(parameter_index).bound_to != nullptr;
+  }
+
+  /**
+   * @brief Whether the values of a parameter changed since the last call to parameterChanged() for it (or since it was
+   * created), e.g. to skip the work that only depends on the parameter
+   *
+   * This compares a hash of the values on each rank, so it also notices the changes made to the state a parameter
+   * is bound to (see bindParameter()) without keeping a copy of it.
+   *
+   * @param parameter_index the index of the parameter
+   * @return true on every rank if the values of any rank changed
+   *
+   * @note This is a collective operation
+   */
+  bool parameterChanged(const size_t parameter_index);
+
   /**
    * @brief Set the current shape displacement for the underlying mesh
    *
@@ -402,10 +537,30 @@ public:
    */
   virtual void advanceTimestep(double dt) = 0;
 
+  /**
+   * @brief The size of the next timestep chosen by the module's adaptive time stepping
+   *
+   * @param dt The step size to return for modules without adaptive time stepping
+   * @return The suggested size of the next call to advanceTimestep()
+   */
+  virtual double suggestedTimestep(double dt) const { return dt; }
+
+  /// @brief The adjoint loads of one quantity of interest, by the name of the state they are the derivative for
+  using AdjointLoads = std::unordered_map<std::string, const serac::FiniteElementDual&>;
+
+  /// @brief The sensitivities of one quantity of interest at a reverse timestep, see reverseAdjointTimestepBatch()
+  struct TimestepSensitivities {
+    /// The sensitivity with respect to each parameter field
+    std::vector<FiniteElementDual> parameters;
+
+    /// The sensitivity with respect to the shape displacement field
+    FiniteElementDual shape;
+  };
+
   /**
    * @brief Set the loads for the adjoint reverse timestep solve
    */
-  virtual void setAdjointLoad(std::unordered_map<std::string, const serac::FiniteElementDual&>)
+  virtual void setAdjointLoad(AdjointLoads)
   {
     SLIC_ERROR_ROOT(axom::fmt::format("Adjoint analysis not defined for physics module {}", name_));
   }
@@ -420,6 +575,44 @@ public:
     SLIC_ERROR_ROOT(axom::fmt::format("Adjoint analysis not defined for physics module {}", name_));
   }
 
+  /**
+   * @brief Solve the adjoint reverse timestep problems of several quantities of interest together
+   *
+   * The adjoint operator (with the setup of its preconditioner) and the gradients of the residual with respect to
+   * the parameters and shape displacement are computed once, then shared by the solves and sensitivities of all the
+   * quantities of interest. The adjoint states carried between reverse timesteps are kept for each quantity of
+   * interest, so a reverse sweep calls this once per forward timestep, with the same number of adjoint loads.
+   *
+   * @param adjoint_loads The adjoint loads of each quantity of interest, as given to setAdjointLoad()
+   * @return The timestep sensitivities of each quantity of interest, in the order of @p adjoint_loads
+   *
+   * @pre It is expected that the forward analysis is complete and the current states are valid
+   * @note Afterwards, adjoint() and computeInitialConditionSensitivity() refer to the last quantity of interest,
+   * see selectBatchedAdjoint()
+   */
+  const std::vector<TimestepSensitivities>& reverseAdjointTimestepBatch(const std::vector<AdjointLoads>& adjoint_loads);
+
+  /**
+   * @brief Make the adjoint states of one quantity of interest of reverseAdjointTimestepBatch() the current ones, e.g.
+   * to query its adjoint() or computeInitialConditionSensitivity() after the reverse sweep
+   *
+   * @param qoi The index of the quantity of interest, in the order of the adjoint loads
+   */
+  void selectBatchedAdjoint(size_t qoi);
+
+  /**
+   * @brief Declare whether the linearized residual of this physics module is self-adjoint (i.e. its Jacobian is
+   * symmetric), as it is for hyperelastic materials with conservative loads
+   *
+   * The adjoint solves then reuse the forward Jacobian (and, with LinearSolverOptions::max_preconditioner_reuse, the
+   * setup of its preconditioner) instead of assembling its transpose.
+   *
+   * @param self_adjoint Whether the Jacobian is symmetric
+   *
+   * @warning The sensitivities are wrong if the Jacobian is not actually symmetric
+   */
+  void setSelfAdjoint(bool self_adjoint) { self_adjoint_ = self_adjoint; }
+
   /**
    * @brief Output the current state of the PDE fields in Sidre format and optionally in Paraview format
    *  if \p paraview_output_dir is given.
@@ -428,6 +621,73 @@ public:
    */
   virtual void outputStateToDisk(std::optional<std::string> paraview_output_dir = {}) const;
 
+  /**
+   * @brief Write the output of outputStateToDisk() on a background thread while the next timesteps compute
+   *
+   * The fields are copied into staging buffers (the StateManager grid functions and copies for paraview) before
+   * outputStateToDisk() returns, and the next call waits for the previous write to finish before restaging. Call
+   * waitForOutput() before reading the files or exiting.
+   *
+   * @param asynchronous Whether to write asynchronously
+   *
+   * @note All physics modules share one background thread, so that modules writing the same mesh's Sidre data
+   * collection never overlap.
+   * @note This requires MPI to be initialized with MPI_THREAD_MULTIPLE (as serac::initialize() requests), and is not
+   * used together with checkpointing to disk. Otherwise the output stays synchronous and a warning is issued.
+   */
+  void setAsynchronousOutput(bool asynchronous);
+
+  /// @brief Block until the asynchronous output started by outputStateToDisk(), if any, has been written
+  void waitForOutput() const;
+
+  /**
+   * @brief Set how often writeOutput() writes, and which fields on which part of the mesh are visualized
+   *
+   * @param options The output options
+   *
+   * @note The restart (Sidre) output always contains every field on the whole mesh, so that the simulation can be
+   * restarted from it. The field list, mesh subset and visualization order only apply to paraview output.
+   */
+  void setOutputOptions(const OutputOptions& options);
+
+  /**
+   * @brief Call outputStateToDisk() if the output cadence set by setOutputOptions() is due at the current cycle
+   *
+   * @param[in] paraview_output_dir Optional output directory for paraview visualization files
+   * @param[in] force Whether to write regardless of the cadence, e.g. at the last timestep
+   * @return Whether the output was written
+   */
+  bool writeOutput(std::optional<std::string> paraview_output_dir = {}, bool force = false);
+
+  /**
+   * @brief Set an in-situ visualization or analysis pipeline (e.g. Ascent or Catalyst), which writeOutput() gives the
+   * current fields to whenever output is due
+   *
+   * The pipeline is called with the Conduit Blueprint mesh of this rank's domain, whose fields refer to the
+   * StateManager's Sidre data without copying it (see StateManager::blueprintMesh()). With
+   * OutputOptions::write_to_disk turned off, images, extracts and reductions can then be produced without writing any
+   * fields to disk, e.g.
+   * @code{.cpp}
+   * ascent::Ascent ascent;
+   * ascent.open();
+   * physics.setInSituPipeline([&](const conduit::Node& mesh) {
+   *   ascent.publish(mesh);
+   *   ascent.execute(actions);
+   * });
+   * @endcode
+   *
+   * @param pipeline The pipeline, or an empty function for none
+   *
+   * @note The node (and the views of the fields in it) is only valid during the call
+   */
+  void setInSituPipeline(std::function<void(const conduit::Node&)> pipeline)
+  {
+    in_situ_pipeline_ = std::move(pipeline);
+  }
+
+  /// @brief Give the current states, duals, parameters and sensitivities to the pipeline set by setInSituPipeline()
+  void publishInSitu() const;
+
   /**
    * @brief Accessor for getting a single named finite element state primal solution from the physics modules at a given
    * checkpointed cycle index
@@ -435,8 +695,68 @@ public:
    * @param cycle The cycle to retrieve state from
    * @param state_name The name of the state to retrieve (e.g. "temperature", "displacement")
    * @return The named primal Finite Element State
+   *
+   * @note If the cycle was dropped by the checkpoint budget, its states are recomputed from the closest earlier
+   * checkpoint, see setCheckpointBudget()
+   */
+  FiniteElementState loadCheckpointedState(const std::string& state_name, int cycle);
+
+  /**
+   * @brief The true dofs of a primal state at every cycle checkpointed in memory, in order, e.g. as the snapshots of
+   * a ReducedBasis for reduced-order models
+   *
+   * @param state_name The name of the state (e.g. "temperature", "displacement")
+   * @return One snapshot for each checkpointed cycle
+   *
+   * @note only the kept checkpoints are returned if the checkpoint budget dropped some cycles, see
+   * setCheckpointBudget()
+   */
+  std::vector<mfem::Vector> snapshots(const std::string& state_name) const;
+
+  /**
+   * @brief Limit the number of cycles whose primal states are checkpointed in memory for transient adjoint solves
+   *
+   * Once the budget is exceeded during the forward pass, every other checkpoint is dropped and only every other
+   * cycle is checkpointed after that, so that the kept cycles stay evenly spaced. reverseAdjointTimestep() then
+   * recomputes the states between two kept checkpoints with forward timesteps from the earlier one. This bounds the
+   * memory to about max_checkpoints + 2 * (number of cycles) / max_checkpoints states, at the cost of about one
+   * extra forward solve per cycle.
+   *
+   * @param max_checkpoints The maximum number of in-memory checkpoints, or 0 for no limit
+   *
+   * @note The recomputed timesteps do not update history-dependent material state (quadrature data), so the budget
+   * should only be used for materials without internal variables.
+   * @note This has no effect when checkpointing to disk.
+   */
+  void setCheckpointBudget(int max_checkpoints);
+
+  /**
+   * @brief Set how a primal state is stored in the in-memory checkpoints for transient adjoint solves
+   *
+   * Lossy compression trades accuracy of the adjoint sensitivities for memory, e.g. a quantization tolerance a few
+   * orders of magnitude below the nonlinear solver tolerance usually stores smooth fields 4-8x smaller without a
+   * visible change in the sensitivities. States not given here are stored exactly.
+   *
+   * @param state_name The name of the primal state (e.g. "velocity", "acceleration")
+   * @param options How to store the state
+   *
+   * @note This only applies to checkpoints taken after the call, and has no effect when checkpointing to disk.
+   */
+  void setCheckpointCompression(const std::string& state_name, const CheckpointCompressionOptions& options);
+
+  /**
+   * @brief Allocate the storage of the in-memory checkpoints of the next cycles ahead of time
+   *
+   * The storage of dropped and cleared checkpoints is always reused for the next ones, so the forward passes after
+   * the first don't allocate. Reserving also takes the allocations out of the first forward pass.
+   *
+   * @param num_cycles The number of cycles to allocate checkpoints for, which is capped by the checkpoint budget
+   *
+   * @note The storage is sized for the current sizes and compression of the primal states, see
+   * setCheckpointCompression()
+   * @note This has no effect when checkpointing to disk.
    */
-  FiniteElementState loadCheckpointedState(const std::string& state_name, int cycle) const;
+  void reserveCheckpoints(int num_cycles);
 
   /**
    * @brief Get a timestep increment which has been previously checkpointed at the give cycle
@@ -462,10 +782,58 @@ public:
    */
   virtual void saveSummary(axom::sidre::DataStore& datastore, const double t) const;
 
+  /**
+   * @brief Record the values of the primal states at a set of points (e.g. sensor locations) with every
+   * saveSummary(), as time histories in the "probes/<name>" group of the summary curves
+   *
+   * The points are located once, here, so sampling them costs little more than a reduction of their values, much
+   * less than writing the whole states to disk. The group of the probes has the coordinates of their points
+   * ("points"), the times they were sampled at ("t"), and the values of each state at every sample, with the
+   * components of each point contiguous and the points of each sample contiguous.
+   *
+   * @param name The name of the set of probes
+   * @param points The physical coordinates of the points, the same on every rank
+   *
+   * @note The values of points outside of the mesh are NaN
+   */
+  void addProbes(const std::string& name, std::vector<mfem::Vector> points);
+
+  /// @brief The probes added by addProbes(), by name
+  const std::map<std::string, Probes>& probes() const { return probes_; }
+
+  /**
+   * @brief Choose the Jacobian policy of the residual in completeSetup(), given the memory available to each rank and
+   * a short timing of the candidates, rather than always storing the q-function derivatives and using the precomputed
+   * lookup tables of the assembly
+   *
+   * With an assembled linear solve, the precomputed lookup tables are used if the planned residual (see
+   * Functional::plannedMemoryUsage()) fits in half of the available memory of each rank, otherwise the smaller
+   * tables of GradientLookup::BinarySearch. With a matrix-free linear solve whose preconditioner doesn't use the
+   * diagonal of the gradient, the q-function derivatives are recomputed if storing them doesn't fit, otherwise both
+   * are timed (a linearization at the initial states and a few gradient applications, on every rank) and the faster
+   * is kept. Their size grows with the number of quadrature points (so with the polynomial order) and the size of the
+   * derivative of each q-function. The chosen policy is logged, and given by jacobianPolicy().
+   *
+   * @param automatic whether to choose the policy automatically
+   * @param gradient_actions the applications of the gradient assumed for each linearization (i.e. the Krylov
+   * iterations of each Newton iteration), to weigh the timings with
+   *
+   * @note This must be called before completeSetup(). Adjoint solves assemble the gradient, so they switch back to
+   * stored derivatives.
+   */
+  void automaticJacobianPolicy(bool automatic, int gradient_actions = 20)
+  {
+    automatic_jacobian_policy_ = automatic;
+    gradient_actions_          = gradient_actions;
+  }
+
+  /// @brief The Jacobian policy of the residual, as chosen by completeSetup(), see automaticJacobianPolicy()
+  JacobianPolicy jacobianPolicy() const { return jacobian_policy_; }
+
   /**
    * @brief Destroy the Base Solver object
    */
-  virtual ~BasePhysics() = default;
+  virtual ~BasePhysics();
 
   /**
    * @brief Returns a reference to the mesh object
@@ -475,11 +843,156 @@ public:
   mfem::ParMesh& mesh() { return mesh_; }
 
 protected:
+  /**
+   * @brief Add the residual of a physics module to a plan, as it will be once its gradient w.r.t. the primal unknown
+   * is assembled, with the matrix and preconditioner built from that gradient and the time of the Newton solves
+   *
+   * The gradient assembly is estimated as memory bound: the element matrices are written once, then gathered into the
+   * sparse matrix and copied for hypre.
+   *
+   * @param[inout] run_plan The plan of the base physics, see BasePhysics::plan()
+   * @param num_cycles The number of cycles of the run
+   * @param model The rates of each rank, and assumptions about the solve
+   * @param residual The residual, a ShapeAwareFunctional
+   * @param wrt The argument of the residual for the primal unknown
+   */
+  template <typename Residual>
+  static void planResidual(RunPlan& run_plan, int num_cycles, const CostModel& model, const Residual& residual,
+                           uint32_t wrt)
+  {
+    for (const auto& [name, nbytes] : residual.plannedMemoryUsage(wrt)) {
+      run_plan.bytes["residual/" + name] = nbytes;
+    }
+
+    // the matrix held by hypre, see memory::bytes(const mfem::HypreParMatrix&)
+    auto        gradient     = residual.plannedGradientSizes(wrt);
+    std::size_t matrix_bytes = (gradient.rows + 1 + gradient.nnz) * sizeof(HYPRE_Int) + gradient.nnz * sizeof(double);
+
+    run_plan.bytes["matrices"]       = std::max(run_plan.bytes["matrices"], matrix_bytes);
+    run_plan.bytes["preconditioner"] = static_cast<std::size_t>(model.preconditioner_complexity * double(matrix_bytes));
+
+    auto   counts         = residual.kernelCounts();
+    double assembly_bytes = double(gradient.element_entries) * 3.0 * sizeof(double) +
+                            double(gradient.nnz) * (3.0 * sizeof(double) + 2.0 * sizeof(int));
+    double evaluate       = model.seconds(counts.flops, counts.bytes);
+    double assemble       = model.seconds(0.0, assembly_bytes);
+
+    run_plan.seconds["residual_evaluation"] = evaluate;
+    run_plan.seconds["gradient_assembly"]   = assemble;
+    run_plan.seconds["forward_solve"]       = num_cycles * model.newton_iterations * (evaluate + assemble);
+  }
+
+  /**
+   * @brief Set the Jacobian policy of a residual, choosing it as described in automaticJacobianPolicy() if that was
+   * requested, and the default otherwise (stored derivatives, and the precomputed lookup tables if it is assembled)
+   *
+   * @param residual The residual, a ShapeAwareFunctional
+   * @param wrt The argument of the residual for the primal unknown
+   * @param solver The solver of the residual
+   * @param linearize Differentiates the residual w.r.t. argument @a wrt at the current states, returning its gradient
+   * @param matrix_free Whether the gradient is applied matrix-free, e.g. only when the solver is matrix-free and the
+   * physics quasistatic
+   *
+   * @note This is a collective operation
+   */
+  template <typename Residual>
+  void selectJacobianPolicy(Residual& residual, uint32_t wrt, const EquationSolver& solver,
+                            const std::function<mfem::Operator&()>& linearize, bool matrix_free)
+  {
+    jacobian_policy_ = matrix_free ? JacobianPolicy::StoredDerivatives : JacobianPolicy::Assembled;
+    if (!automatic_jacobian_policy_) {
+      return;
+    }
+
+    // an unknown amount of available memory (0) doesn't rule anything out, and the other half is left for the rest of
+    // the solve, e.g. the preconditioner
+    double budget = 0.5 * double(memory::availableBytes(comm_));
+    MPI_Allreduce(MPI_IN_PLACE, &budget, 1, MPI_DOUBLE, MPI_MIN, comm_);
+    auto fits = [this, budget](std::size_t nbytes) {
+      int fit = (budget == 0.0) || (double(nbytes) <= budget);
+      MPI_Allreduce(MPI_IN_PLACE, &fit, 1, MPI_INT, MPI_LAND, comm_);
+      return fit != 0;
+    };
+
+    // the gradient of a matrix-free solve is never assembled, so only its q-function derivatives are planned
+    memory::Usage current = residual.memoryUsage();
+    memory::Usage planned = residual.plannedMemoryUsage(wrt);
+    if (matrix_free) {
+      std::size_t derivatives          = planned["qfunction_derivatives"];
+      planned                          = current;
+      planned["qfunction_derivatives"] = derivatives;
+    }
+
+    std::string reason;
+
+    if (!matrix_free) {
+      residual.setGradientLookup(GradientLookup::Precomputed);
+      if (fits(memory::total(residual.plannedMemoryUsage(wrt)))) {
+        reason = "the planned residual fits in memory";
+      } else {
+        residual.setGradientLookup(GradientLookup::BinarySearch);
+        jacobian_policy_ = JacobianPolicy::AssembledBinarySearch;
+        planned          = residual.plannedMemoryUsage(wrt);
+        reason           = "the precomputed lookup tables don't fit in memory";
+      }
+    } else if (solver.preconditionerUsesDiagonal()) {
+      reason = "the preconditioner uses the diagonal of the gradient";
+    } else if (!fits(memory::total(planned))) {
+      jacobian_policy_ = JacobianPolicy::RecomputedDerivatives;
+      reason           = "the stored derivatives don't fit in memory";
+    } else {
+      // the time of a linearization and its gradient applications, over the ranks
+      auto time = [this, &linearize]() {
+        auto                  start    = std::chrono::steady_clock::now();
+        const mfem::Operator& gradient = linearize();
+        double linearization = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        constexpr int timed_actions = 3;
+        mfem::Vector  x(gradient.Width()), y(gradient.Height());
+        x     = 1.0;
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < timed_actions; i++) {
+          gradient.Mult(x, y);
+        }
+        double action  = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double seconds = linearization + gradient_actions_ * action / timed_actions;
+        MPI_Allreduce(MPI_IN_PLACE, &seconds, 1, MPI_DOUBLE, MPI_MAX, comm_);
+        return seconds;
+      };
+
+      double stored = time();
+      residual.recomputeDerivatives(true);
+      residual.releaseDerivatives(wrt);
+      double recomputed = time();
+
+      if (recomputed < stored) {
+        jacobian_policy_ = JacobianPolicy::RecomputedDerivatives;
+      } else {
+        residual.recomputeDerivatives(false);
+      }
+      reason = axom::fmt::format("a linearization and {} gradient applications take {:.3e}s with stored derivatives "
+                                 "and {:.3e}s with recomputed ones",
+                                 gradient_actions_, stored, recomputed);
+    }
+
+    if (jacobian_policy_ == JacobianPolicy::RecomputedDerivatives) {
+      residual.recomputeDerivatives(true);
+      planned["qfunction_derivatives"] = current["qfunction_derivatives"];
+    }
+
+    SLIC_INFO_ROOT(axom::fmt::format("Jacobian policy of '{}': {}, as {} (planned residual: {} bytes per rank, budget: "
+                                     "{:.0f} bytes per rank)",
+                                     name_, to_string(jacobian_policy_), reason, memory::total(planned), budget));
+  }
+
   /**
    * @brief Create a paraview data collection for the physics package if requested
    */
   void CreateParaviewDataCollection() const;
 
+  /// @brief Copy the states, duals, parameters and sensitivities into the grid functions of the state manager
+  void updateStateManager() const;
+
   /**
    * @brief Update the paraview states, duals, parameters, and metadata (cycle, time) in preparation for output
    *
@@ -487,6 +1000,17 @@ protected:
    */
   void UpdateParaviewDataCollection(const std::string& paraview_output_dir) const;
 
+  /// @brief Discard the paraview data collection, so that it is recreated with the current output options
+  void resetParaviewDataCollection();
+
+  /**
+   * @brief Add a field that is only computed when it is written, e.g. one projected from quadrature point values
+   *
+   * @param field The field, which must outlive this module
+   * @param update Refreshes the values of @a field before each output
+   */
+  void addOutputField(const FiniteElementState& field, std::function<void()> update);
+
   /**
    * @brief Protected, non-virtual method to reset physics states to zero.  This does not reset design parameters or
    * shape.
@@ -496,6 +1020,87 @@ protected:
    */
   void initializeBasePhysicsStates(int cycle, double time);
 
+  /**
+   * @brief Advance by dt as a sequence of substeps, cutting the substep in half whenever its nonlinear solve fails
+   *
+   * The previous values of the parameter fields are saved before each substep and restored along with the module's
+   * own state by @p abort when the substep fails, after which it is retried with half the step size. After each
+   * successful substep the step size is doubled again, up to dt. Each substep is committed as its own cycle. Material
+   * state (quadrature data) is only updated by @p commit, so failed substeps leave it untouched.
+   *
+   * @param dt The increment of simulation time to advance
+   * @param max_cutbacks The maximum number of times the step size may be cut in half over the increment
+   * @param solve Solves a substep of the given size, returning whether its nonlinear solve converged
+   * @param abort Restores the module to the state at the beginning of a failed substep
+   * @param commit Completes a converged substep
+   */
+  void advanceWithCutbacks(double dt, int max_cutbacks, const std::function<bool(double)>& solve,
+                           const std::function<void()>& abort, const std::function<void()>& commit);
+
+  /**
+   * @brief Advance by dt as a sequence of load increments sized by the Newton iterations of the previous increment
+   *
+   * This is the continuation driver of TimesteppingOptions::target_nonlinear_iterations. Failed increments are
+   * handled as in advanceWithCutbacks(), but are retried until the increment would drop below the minimum size.
+   *
+   * @param dt The increment of simulation time to advance
+   * @param solve Solves an increment of the given size, returning whether its nonlinear solve converged
+   * @param abort Restores the module to the state at the beginning of a failed increment
+   * @param commit Completes a converged increment, recording its Newton iterations in nonlinearIterations()
+   */
+  void advanceWithContinuation(double dt, const std::function<bool(double)>& solve,
+                               const std::function<void()>& abort, const std::function<void()>& commit);
+
+  /**
+   * @brief Record that the last residual evaluation also computed the derivatives of the residual at @a u, so that
+   * the Jacobian assembled next at the same point can reuse them (see EquationSolver::jacobianExpected())
+   */
+  void setLinearizationPoint(const mfem::Vector& u);
+
+  /// @brief Record that the last residual evaluation did not compute any derivatives
+  void clearLinearizationPoint() { has_linearization_point_ = false; }
+
+  /**
+   * @brief Whether the derivatives computed by the last residual evaluation are those at @a u, which can only be used
+   * once, as another residual evaluation may follow
+   *
+   * @note this is collective, so that every rank decides alike whether to differentiate the residual again
+   */
+  bool takeLinearizationPoint(const mfem::Vector& u);
+
+  /**
+   * @brief Whether @a a and @a b are exactly equal on every rank
+   * @note this is collective
+   */
+  bool identical(const mfem::Vector& a, const mfem::Vector& b) const;
+
+  /**
+   * @brief Record the primal solution of a committed timestep as a converged state for extrapolateState()
+   *
+   * Only the states needed by a quadratic extrapolation are kept.
+   *
+   * @param state The true dofs of the converged solution at the current time
+   */
+  void recordConvergedState(const mfem::Vector& state);
+
+  /**
+   * @brief Record the telemetry of the nonlinear solve of the timestep being committed
+   *
+   * The telemetry is also appended to OutputOptions::solver_telemetry_file, if one was given.
+   *
+   * @param telemetry The telemetry of the last nonlinear solve
+   */
+  void recordSolverTelemetry(const SolverTelemetry& telemetry);
+
+  /**
+   * @brief Extrapolate the recorded converged states to a later time with a Lagrange polynomial
+   *
+   * @param t The time to extrapolate to
+   * @param order The degree of the polynomial, which is reduced if fewer than order + 1 states have been recorded
+   * @param state The extrapolated true dofs, left unchanged if no state has been recorded
+   */
+  void extrapolateState(double t, int order, mfem::Vector& state) const;
+
   /**
    * @brief Accessor for getting all of the primal solutions from the physics modules at a given
    * checkpointed cycle index
@@ -505,6 +1110,117 @@ protected:
    */
   virtual std::unordered_map<std::string, FiniteElementState> getCheckpointedStates(int cycle) const;
 
+  /**
+   * @brief Record the primal states at the current cycle, either to disk or in memory if the checkpoint budget
+   * keeps this cycle
+   */
+  void checkpointStates();
+
+  /// @brief Discard all of the in-memory checkpoints, e.g. before starting a new forward pass
+  void clearCheckpointedStates();
+
+  /**
+   * @brief Update the in-memory checkpoint of a single primal state at the current cycle, if there is one
+   *
+   * @param state_name The name of the state
+   * @param state The new value of the state
+   */
+  void updateCheckpointedState(const std::string& state_name, const FiniteElementState& state);
+
+  /**
+   * @brief Get all of the primal states checkpointed in memory at a given cycle
+   *
+   * @param cycle The cycle to retrieve the states from, which must either have been kept by the checkpoint budget or
+   * recomputed by recomputeCheckpointedStates()
+   * @return A map containing the primal field names and their associated FiniteElementStates at the requested cycle
+   */
+  std::unordered_map<std::string, FiniteElementState> checkpointedStatesInMemory(int cycle) const;
+
+  /**
+   * @brief Recompute the primal states of the cycles between two kept in-memory checkpoints, if a cycle was dropped
+   * by the checkpoint budget
+   *
+   * The current primal states and time are unchanged.
+   *
+   * @param cycle The cycle whose states will be requested next
+   */
+  void recomputeCheckpointedStates(int cycle);
+
+  /**
+   * @brief Set the primal states to an in-memory checkpoint, before recomputing the timesteps that follow it
+   *
+   * @param states The primal states at the checkpointed cycle
+   */
+  virtual void restoreCheckpoint(const std::unordered_map<std::string, FiniteElementState>& states);
+
+  /**
+   * @brief Advance the primal states by one timestep without recording it, to recompute a dropped checkpoint
+   *
+   * @param dt The increment of simulation time, which must be the size of the step taken by the forward pass
+   */
+  virtual void recomputeTimestep(double dt);
+
+  /**
+   * @brief Assemble the adjoint operator of the current reverse timestep, and set up its linear solver
+   *
+   * @note reverseAdjointTimestep() is prepareAdjointTimestep(), solveAdjointTimestep() and finishAdjointTimestep(),
+   * and reverseAdjointTimestepBatch() calls solveAdjointTimestep() once for each quantity of interest
+   */
+  virtual void prepareAdjointTimestep()
+  {
+    SLIC_ERROR_ROOT(axom::fmt::format("Batched adjoint analysis not defined for physics module {}", name_));
+  }
+
+  /// @brief Solve the adjoint problem of the current reverse timestep for the loads given to setAdjointLoad()
+  virtual void solveAdjointTimestep()
+  {
+    SLIC_ERROR_ROOT(axom::fmt::format("Batched adjoint analysis not defined for physics module {}", name_));
+  }
+
+  /// @brief Move the time and cycle back to the beginning of the current reverse timestep
+  virtual void finishAdjointTimestep() {}
+
+  /**
+   * @brief The adjoint states that are carried from one reverse timestep to the next, starting with the adjoint
+   * solution of the current reverse timestep
+   */
+  virtual std::vector<FiniteElementVector*> adjointTimestepStates() { return {}; }
+
+  /**
+   * @brief Compute the timestep sensitivities of each quantity of interest of reverseAdjointTimestepBatch(), see
+   * computeTimestepSensitivity() and computeTimestepShapeSensitivity()
+   *
+   * @param[out] sensitivities The sensitivities of each quantity of interest
+   */
+  virtual void computeBatchedTimestepSensitivities(std::vector<TimestepSensitivities>& sensitivities)
+  {
+    (void)sensitivities;
+    SLIC_ERROR_ROOT(axom::fmt::format("Batched adjoint analysis not defined for physics module {}", name_));
+  }
+
+  /// @brief The adjoint solution of a quantity of interest at the last reverseAdjointTimestepBatch()
+  const mfem::Vector& batchedAdjointSolution(size_t qoi) const { return batch_adjoint_states_[qoi].front(); }
+
+  /**
+   * @brief Assemble the operator of an adjoint solve, i.e. the transpose of a gradient of the residual
+   *
+   * @param gradient The gradient of the residual, returned by a Functional
+   * @param[inout] K The matrix to overwrite. Its storage is kept while the sparsity pattern is unchanged, so that
+   * the adjoint operator is one object (with one transpose structure) across the reverse timesteps.
+   *
+   * @note The transpose is assembled directly from the element matrices, without mfem::HypreParMatrix::Transpose().
+   * If the physics module is self-adjoint (see setSelfAdjoint()), the gradient itself is assembled.
+   */
+  template <typename Gradient>
+  void assembleAdjointOperator(Gradient& gradient, std::unique_ptr<mfem::HypreParMatrix>& K) const
+  {
+    if (self_adjoint_) {
+      assemble(gradient, K);
+    } else {
+      assembleTranspose(gradient, K);
+    }
+  }
+
   /// @brief Name of the physics module
   std::string name_ = {};
 
@@ -573,6 +1289,12 @@ protected:
      * @note This quantity is also called the vector-Jacobian product during back propagation in data science.
      */
     std::unique_ptr<serac::FiniteElementDual> sensitivity;
+
+    /// The state whose values @a state is a view of, or null if it owns its values, see bindParameter()
+    const FiniteElementState* bound_to = nullptr;
+
+    /// The hash of the values of @a state when parameterChanged() last looked at them
+    std::uint64_t fingerprint = 0;
   };
 
   /// @brief A vector of the parameters associated with this physics module
@@ -588,8 +1310,52 @@ protected:
   /// physics module)
   std::unique_ptr<FiniteElementDual> shape_displacement_sensitivity_;
 
-  /// @brief A map containing optionally in-memory checkpointed primal states for transient adjoint solvers
-  mutable std::unordered_map<std::string, std::vector<serac::FiniteElementState>> checkpoint_states_;
+  /// @brief The adjoint states carried between reverse timesteps (see adjointTimestepStates()) of each quantity of
+  /// interest of reverseAdjointTimestepBatch()
+  std::vector<std::vector<mfem::Vector>> batch_adjoint_states_;
+
+  /// @brief The timestep sensitivities of each quantity of interest of reverseAdjointTimestepBatch()
+  std::vector<TimestepSensitivities> batch_sensitivities_;
+
+  /// @brief The primal states and simulation time at a checkpointed cycle
+  struct Checkpoint {
+    /// The simulation time at the checkpointed cycle
+    double time = 0.0;
+
+    /// The (possibly compressed) primal states at the checkpointed cycle, by name
+    std::unordered_map<std::string, CompressedVector> states;
+  };
+
+  /// @brief Store the current primal states and simulation time with the requested compression, in the storage of a
+  /// spare checkpoint if there is one
+  Checkpoint makeCheckpoint();
+
+  /// @brief Keep the storage of a checkpoint that is no longer needed for the next one
+  void recycleCheckpoint(Checkpoint&& checkpoint);
+
+  /// @brief How a primal state is stored in the in-memory checkpoints
+  CheckpointCompressionOptions checkpointCompression(const std::string& state_name) const;
+
+  /// @brief Decompress the primal states of a checkpoint
+  std::unordered_map<std::string, FiniteElementState> expandCheckpoint(const Checkpoint& checkpoint) const;
+
+  /// @brief How each primal state is stored in the in-memory checkpoints, by name
+  std::unordered_map<std::string, CheckpointCompressionOptions> checkpoint_compression_;
+
+  /// @brief The optionally in-memory checkpointed primal states for transient adjoint solvers, by cycle
+  std::map<int, Checkpoint> checkpoint_states_;
+
+  /// @brief The checkpoints recomputed between two kept checkpoints during the adjoint solve, by cycle
+  std::map<int, Checkpoint> recomputed_checkpoint_states_;
+
+  /// @brief The checkpoints whose storage is reused for the next ones, see reserveCheckpoints()
+  std::vector<Checkpoint> spare_checkpoints_;
+
+  /// @brief The maximum number of in-memory checkpoints, or 0 for no limit
+  int max_checkpoints_ = 0;
+
+  /// @brief The spacing between the cycles that are checkpointed in memory
+  int checkpoint_stride_ = 1;
 
   /**
    * @brief A container relating a checkpointed cycle and the associated finite element state fields
@@ -608,6 +1374,9 @@ protected:
    */
   bool is_quasistatic_ = true;
 
+  /// @brief Whether the Jacobian is symmetric, so that adjoint solves don't need its transpose, see setSelfAdjoint()
+  bool self_adjoint_ = false;
+
   /**
    * @brief Number of significant figures to output for floating-point
    */
@@ -633,6 +1402,36 @@ protected:
    */
   std::vector<double> timesteps_;
 
+  /// The number of Newton iterations taken by the nonlinear solve of each committed timestep
+  std::vector<int> nonlinear_iterations_;
+
+  /// The telemetry of the nonlinear solve of each committed timestep
+  std::vector<SolverTelemetry> solver_telemetry_;
+
+  /// The times of solver_telemetry_
+  std::vector<double> solver_telemetry_times_;
+
+  /// The sets of probes sampled by saveSummary(), by name
+  std::map<std::string, Probes> probes_;
+
+  /// Whether completeSetup() chooses the Jacobian policy, see automaticJacobianPolicy()
+  bool automatic_jacobian_policy_ = false;
+
+  /// The applications of the gradient assumed for each linearization, see automaticJacobianPolicy()
+  int gradient_actions_ = 20;
+
+  /// The Jacobian policy of the residual, see selectJacobianPolicy()
+  JacobianPolicy jacobian_policy_ = JacobianPolicy::Assembled;
+
+  /// The number of entries of solver_telemetry_ already written by saveSummary()
+  mutable size_t summarized_telemetry_ = 0;
+
+  /// The most recent converged primal solutions recorded by recordConvergedState(), oldest first
+  std::vector<mfem::Vector> converged_states_;
+
+  /// The times of converged_states_
+  std::vector<double> converged_times_;
+
   /**
    * @brief Current cycle (forward pass time iteration count)
    */
@@ -678,6 +1477,60 @@ protected:
    */
   mutable std::unique_ptr<mfem::ParGridFunction> shape_sensitivity_grid_function_;
 
+  /// @brief The mesh subset written for paraview output, if OutputOptions::element_attributes is given
+  mutable std::unique_ptr<mfem::ParSubMesh> paraview_submesh_;
+
+  /// @brief A field written for paraview output, and the grid functions it is transferred through on the way
+  struct ParaviewField {
+    /// Refreshes and returns the values of the field on the whole mesh, at its own order
+    std::function<const mfem::ParGridFunction&()> update;
+
+    /// The space of the field restricted to paraview_submesh_
+    std::unique_ptr<mfem::ParFiniteElementSpace> submesh_space;
+
+    /// The field restricted to paraview_submesh_
+    std::unique_ptr<mfem::ParGridFunction> submesh_values;
+
+    /// The lower order collection the field is interpolated to
+    std::unique_ptr<mfem::FiniteElementCollection> collection;
+
+    /// The lower order space the field is interpolated to
+    std::unique_ptr<mfem::ParFiniteElementSpace> space;
+
+    /// The interpolated field, or a staged copy of it for asynchronous output, if it is not written directly
+    std::unique_ptr<mfem::ParGridFunction> values;
+  };
+
+  /// @brief The fields registered for paraview output
+  mutable std::vector<ParaviewField> paraview_fields_;
+
+  /// @brief A field that is only computed when it is written, see addOutputField()
+  struct OutputField {
+    /// The field
+    const FiniteElementState* field;
+
+    /// Refreshes the values of the field
+    std::function<void()> update;
+  };
+
+  /// @brief The fields that are only computed when they are written
+  std::vector<OutputField> output_fields_;
+
+  /// @brief The output cadence and visualization controls used by writeOutput()
+  OutputOptions output_options_;
+
+  /// @brief The cycle of the last output written by writeOutput()
+  std::optional<int> last_output_cycle_;
+
+  /// @brief The simulation time of the last output written by writeOutput()
+  double last_output_time_ = 0.0;
+
+  /// @brief Whether outputStateToDisk() writes on the background thread shared by all physics modules
+  bool asynchronous_output_ = false;
+
+  /// @brief The in-situ visualization or analysis pipeline given the fields by writeOutput()
+  std::function<void(const conduit::Node&)> in_situ_pipeline_;
+
   /**
    * @brief Boundary condition manager instance
    */
@@ -685,6 +1538,30 @@ protected:
 
   /// A flag denoting whether to save the state to disk or memory as needed for dynamic adjoint solves
   bool checkpoint_to_disk_;
+
+  /// The maximum number of times a quasi-static step may be cut in half after a failed nonlinear solve
+  int max_cutbacks_ = 0;
+
+  /// The number of Newton iterations that advanceWithContinuation() sizes its load increments for, or 0 if disabled
+  int target_nonlinear_iterations_ = 0;
+
+  /// The smallest load increment that advanceWithContinuation() may take before giving up
+  double min_increment_ = 1.0e-12;
+
+  /// The largest load increment that advanceWithContinuation() may take
+  double max_increment_ = std::numeric_limits<double>::max();
+
+  /// The size of the next load increment of advanceWithContinuation(), or 0 before the first one
+  double continuation_increment_ = 0.0;
+
+  /// The previous parameter values at the beginning of the substep being attempted by advanceWithCutbacks()
+  std::vector<mfem::Vector> substep_start_previous_parameters_;
+
+  /// The point at which the last residual evaluation computed its derivatives, see setLinearizationPoint()
+  mfem::Vector linearization_point_;
+
+  /// Whether linearization_point_ holds the point of the last residual evaluation
+  bool has_linearization_point_ = false;
 };
 
 }  // namespace serac
@@ -0,0 +1,358 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_kernels.cpp
+ *
+ * @brief Microbenchmarks of the individual kernels that make up a Functional evaluation
+ *
+ * Each kernel is called repeatedly on the same data until a minimum time has elapsed, and its average time per call
+ * is reported per element and per quadrature point, together with its arithmetic and memory throughput. The flop
+ * counts are those of a dense interpolation/integration (2 flops per dof per quadrature point value), so the
+ * reported GFLOP/s of sum-factorized kernels are "effective" rates that can be compared across element types.
+ * The byte counts are the minimum traffic of each kernel's inputs and outputs, ignoring caches.
+ */
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "axom/fmt.hpp"
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/numerics/functional/dof_numbering.hpp"
+#include "serac/numerics/functional/functional.hpp"
+
+namespace {
+
+using namespace serac;
+
+/// @brief each kernel is repeated until it has run for at least this long, in seconds
+constexpr double min_seconds = 0.1;
+
+/// @brief the sizes of a kernel launch and the work it does, used to report its throughput
+struct KernelCost {
+  double elements;          ///< the number of elements processed per call
+  double qpts_per_element;  ///< the number of quadrature points per element, or 0 for kernels without them
+  double flops;             ///< the floating point operations per call
+  double bytes;             ///< the bytes read and written per call
+};
+
+/**
+ * @brief time a kernel, and report its time per element and per quadrature point, and its throughput
+ *
+ * @param name the name of the kernel, which is also the name of its Caliper region
+ * @param cost the sizes and work of one call to the kernel
+ * @param kernel a callable that runs the kernel once
+ */
+template <typename kernel_type>
+void benchmark(const std::string& name, const KernelCost& cost, kernel_type&& kernel)
+{
+  SERAC_MARK_SCOPE(name.c_str());
+
+  // the first call warms up the caches and any buffers that are allocated lazily
+  kernel();
+
+  double seconds = 0.0;
+  for (int repetitions = 1;; repetitions *= 2) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++) {
+      kernel();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    if (elapsed.count() >= min_seconds || repetitions >= (1 << 20)) {
+      seconds = elapsed.count() / repetitions;
+      break;
+    }
+  }
+
+  double ns_per_element = 1.0e9 * seconds / cost.elements;
+  double ns_per_qpt     = (cost.qpts_per_element > 0) ? ns_per_element / cost.qpts_per_element : 0.0;
+
+  SLIC_INFO_ROOT(axom::fmt::format("{:<48} {:>10.2f} ns/elem {:>9.3f} ns/qpt {:>8.2f} GFLOP/s {:>8.2f} GB/s", name,
+                                   ns_per_element, ns_per_qpt, 1.0e-9 * cost.flops / seconds,
+                                   1.0e-9 * cost.bytes / seconds));
+}
+
+/// @brief fill the entries of an array of tensors (or structs of tensors) with random values
+template <typename T>
+void randomize(std::vector<T>& values)
+{
+  std::mt19937                           generator(0);
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  double* ptr = reinterpret_cast<double*>(values.data());
+  for (std::size_t i = 0; i < values.size() * sizeof(T) / sizeof(double); i++) {
+    ptr[i] = distribution(generator);
+  }
+}
+
+/// @brief a short description of a function space, e.g. "H1<2, 3>"
+template <typename space>
+std::string space_name()
+{
+  std::string family = (space::family == Family::H1) ? "H1" : (space::family == Family::HCURL) ? "Hcurl" : "L2";
+  return axom::fmt::format("{}<{}, {}>", family, space::order, space::components);
+}
+
+/**
+ * @brief benchmark finite_element<geom, space>::interpolate() and ::integrate(), with Q points per dimension
+ *
+ * @param num_elements the number of elements in the E-vectors
+ */
+template <mfem::Geometry::Type geom, typename space, int Q = space::order + 1>
+void benchmark_element(uint32_t num_elements)
+{
+  if constexpr (has_finite_element<geom, space>::value) {
+    using element_type  = finite_element<geom, space>;
+    using dof_type      = typename element_type::dof_type;
+    using qf_input_type = decltype(element_type::interpolate(dof_type{}, TensorProductQuadratureRule<Q>{}));
+
+    constexpr double dofs    = sizeof(dof_type) / sizeof(double);
+    constexpr double qvalues = sizeof(qf_input_type) / sizeof(double);
+
+    TensorProductQuadratureRule<Q> rule{};
+
+    std::vector<dof_type>      X(num_elements);
+    std::vector<dof_type>      R(num_elements);
+    std::vector<qf_input_type> X_q(num_elements);
+    randomize(X);
+
+    std::string name     = axom::fmt::format("{} {}", mfem::Geometry::Name[geom], space_name<space>());
+    double      elements = num_elements;
+    double      qpts     = num_quadrature_points(geom, Q);
+
+    KernelCost interpolation{elements, qpts, 2.0 * elements * dofs * qvalues,
+                             sizeof(double) * elements * (dofs + qvalues)};
+    benchmark(name + " interpolate", interpolation, [&]() {
+      for (uint32_t e = 0; e < num_elements; e++) {
+        X_q[e] = element_type::interpolate(X[e], rule);
+      }
+    });
+
+    // integrating the interpolated values uses the same number of sources and fluxes as a typical q-function
+    KernelCost integration{elements, qpts, 2.0 * elements * dofs * qvalues,
+                           sizeof(double) * elements * (qvalues + 2 * dofs)};
+    benchmark(name + " integrate", integration, [&]() {
+      for (uint32_t e = 0; e < num_elements; e++) {
+        element_type::integrate(X_q[e], rule, &R[e]);
+      }
+    });
+  }
+}
+
+/// @brief benchmark the element kernels of every space implemented on a geometry, for orders 1 through 3
+template <mfem::Geometry::Type geom>
+void benchmark_elements(uint32_t num_elements)
+{
+  constexpr int dim = dimension_of(geom);
+
+  benchmark_element<geom, H1<1>>(num_elements);
+  benchmark_element<geom, H1<2>>(num_elements);
+  benchmark_element<geom, H1<3>>(num_elements);
+  benchmark_element<geom, H1<1, dim>>(num_elements);
+  benchmark_element<geom, H1<2, dim>>(num_elements);
+  benchmark_element<geom, H1<3, dim>>(num_elements);
+  if constexpr (geom != mfem::Geometry::SEGMENT) {
+    benchmark_element<geom, Hcurl<1>>(num_elements);
+    benchmark_element<geom, Hcurl<2>>(num_elements);
+    benchmark_element<geom, Hcurl<3>>(num_elements);
+  }
+  benchmark_element<geom, L2<1>>(num_elements);
+  benchmark_element<geom, L2<2>>(num_elements);
+  benchmark_element<geom, L2<3>>(num_elements);
+}
+
+/**
+ * @brief benchmark batch_apply_qf_no_qdata() on the q-function of a linear elastic material
+ *
+ * @param num_elements the number of elements to apply the q-function to
+ */
+template <mfem::Geometry::Type geom, int p>
+void benchmark_qfunction(uint32_t num_elements)
+{
+  constexpr int dim  = dimension_of(geom);
+  constexpr int qpts = num_quadrature_points(geom, p + 1);
+
+  using input_type = tuple<tensor<double, dim>, tensor<double, dim, dim>>;
+
+  auto qf = [](double, auto /* position */, auto displacement) {
+    auto strain = sym(get<1>(displacement));
+    return tuple{zero{}, 2.0 * strain + tr(strain) * Identity<dim>()};
+  };
+
+  using output_type = decltype(qf(0.0, tuple<tensor<double, dim>, tensor<double, dim, dim>>{}, input_type{}));
+
+  std::vector<tensor<double, dim, qpts>>      x(num_elements);
+  std::vector<tensor<double, dim, dim, qpts>> J(num_elements);
+  std::vector<tensor<input_type, qpts>>       inputs(num_elements);
+  std::vector<tensor<output_type, qpts>>      outputs(num_elements);
+  randomize(x);
+  randomize(J);
+  randomize(inputs);
+
+  // the strain, its trace and the stress
+  constexpr double flops_per_qpt = dim * dim + dim + 3 * dim * dim;
+  constexpr double bytes_per_qpt = sizeof(double) * (dim + 2 * dim * dim) + sizeof(output_type);
+
+  double     elements = num_elements;
+  KernelCost cost{elements, qpts, elements * qpts * flops_per_qpt, elements * qpts * bytes_per_qpt};
+  benchmark(axom::fmt::format("{} batch_apply_qf (p = {})", mfem::Geometry::Name[geom], p), cost, [&]() {
+    for (uint32_t e = 0; e < num_elements; e++) {
+      outputs[e] = batch_apply_qf_no_qdata(qf, 0.0, x[e], J[e], inputs[e]);
+    }
+  });
+}
+
+/**
+ * @brief benchmark the kernels of a vector-valued H1 integral that act on E-vectors, and the operators that
+ * move data between the L-vector and E-vectors: the gather and scatter-add, and the construction of the
+ * lookup tables used to assemble the sparse gradient
+ *
+ * @param mesh the mesh to integrate over
+ */
+template <int p, int dim>
+void benchmark_integral(mfem::ParMesh& mesh)
+{
+  using space = H1<p, dim>;
+
+  auto [fes, fec] = generateParFiniteElementSpace<space>(&mesh);
+
+  BlockElementRestriction G(fes.get());
+  BlockElementRestriction G_boundary;
+
+  std::vector<mfem::BlockVector> inputs;
+  inputs.emplace_back(G.bOffsets());
+  mfem::BlockVector outputs(G.bOffsets());
+  mfem::Vector      L(fes->GetVSize());
+  L.Randomize(0);
+  G.Gather(L, inputs[0]);
+
+  auto qf = [](double, auto /* position */, auto displacement) {
+    auto strain = sym(get<1>(displacement));
+    return tuple{zero{}, 2.0 * strain + tr(strain) * Identity<dim>()};
+  };
+
+  Integral integral = MakeDomainIntegral<space(space), p + 1, dim>(EntireDomain(mesh), qf, NoQData, {0});
+  integral.GenerateDerivativeKernels(0);
+
+  std::map<mfem::Geometry::Type, ExecArray<double, 3, ExecutionSpace::CPU>> K_e;
+  for (auto& [geom, restriction] : G.restrictions) {
+    auto dofs_per_element = restriction.nodes_per_elem * restriction.components;
+    K_e[geom]             = ExecArray<double, 3, ExecutionSpace::CPU>(restriction.num_elements, dofs_per_element,
+                                                                      dofs_per_element);
+  }
+
+  // note: structured bindings can't be captured by the lambdas below (before C++20)
+  for (auto& entry : G.restrictions) {
+    mfem::Geometry::Type      geom        = entry.first;
+    const ElementRestriction& restriction = entry.second;
+
+    KernelCounts counts = integral.counts(geom);
+    std::string  name   = axom::fmt::format("{} {}", mfem::Geometry::Name[geom], space_name<space>());
+
+    double   elements         = counts.elements;
+    double   qpts             = counts.quadrature_points;
+    double   esize            = double(restriction.esize);
+    double   dofs_per_element = double(restriction.nodes_per_elem * restriction.components);
+    uint32_t differentiate    = 0;
+
+    KernelCost evaluation{elements, qpts, counts.flops, counts.bytes};
+    benchmark(name + " evaluation_kernel", evaluation,
+              [&]() { integral.Mult(0.0, inputs, outputs, NO_DIFFERENTIATION, false); });
+
+    // the derivatives (of the stress w.r.t. the displacement gradient) are written once per quadrature point
+    KernelCost with_derivatives = evaluation;
+    with_derivatives.bytes += sizeof(double) * elements * qpts * dim * dim * dim * dim;
+    benchmark(name + " evaluation_kernel (with AD)", with_derivatives,
+              [&]() { integral.Mult(0.0, inputs, outputs, differentiate, false); });
+
+    // the action of the gradient reads those derivatives back, instead of evaluating the q-function
+    benchmark(name + " action_of_gradient_kernel", with_derivatives,
+              [&]() { integral.GradientMult(inputs[0], outputs, differentiate); });
+
+    // each column of an element matrix is a (dense) integration of the derivatives against one trial function
+    KernelCost element_gradient{elements, qpts, 2.0 * elements * qpts * (dim + 1) * dofs_per_element * dofs_per_element,
+                                sizeof(double) * elements * dofs_per_element * dofs_per_element};
+    benchmark(name + " element_gradient_kernel", element_gradient,
+              [&]() { integral.ComputeElementGradients(K_e, differentiate); });
+
+    // each E-vector entry reads its index and moves one value
+    KernelCost gather{elements, 0, 0.0, (sizeof(int) + 2 * sizeof(double)) * esize};
+    benchmark(name + " ElementRestriction::Gather", gather,
+              [&]() { restriction.Gather(L, inputs[0].GetBlock(geom)); });
+
+    KernelCost scatter{elements, 0, esize, (sizeof(int) + 3 * sizeof(double)) * esize};
+    benchmark(name + " ElementRestriction::ScatterAdd", scatter,
+              [&]() { restriction.ScatterAdd(outputs.GetBlock(geom), L); });
+  }
+
+  // the lookup tables are built once per gradient, so their cost is amortized over every assembly
+  KernelCost lookup_tables{double(mesh.GetNE()), 0, 0.0, (sizeof(int) + sizeof(double)) * double(G.ESize())};
+  benchmark(axom::fmt::format("{} GradientAssemblyLookupTables", space_name<space>()), lookup_tables,
+            [&]() { GradientAssemblyLookupTables tables(G, G, G_boundary, G_boundary); });
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  // Initialize profiling
+  serac::profiling::initialize();
+
+  // Add metadata
+  SERAC_SET_METADATA("test", "functional_kernels");
+
+  constexpr uint32_t num_elements = 4096;
+
+  SERAC_MARK_BEGIN("element kernels");
+  benchmark_elements<mfem::Geometry::SEGMENT>(num_elements);
+  benchmark_elements<mfem::Geometry::TRIANGLE>(num_elements);
+  benchmark_elements<mfem::Geometry::SQUARE>(num_elements);
+  benchmark_elements<mfem::Geometry::TETRAHEDRON>(num_elements);
+  benchmark_elements<mfem::Geometry::CUBE>(num_elements);
+  benchmark_element<mfem::Geometry::PRISM, serac::H1<1>>(num_elements);
+  benchmark_element<mfem::Geometry::PRISM, serac::H1<1, 3>>(num_elements);
+  SERAC_MARK_END("element kernels");
+
+  SERAC_MARK_BEGIN("q-functions");
+  benchmark_qfunction<mfem::Geometry::SQUARE, 2>(num_elements);
+  benchmark_qfunction<mfem::Geometry::CUBE, 1>(num_elements);
+  benchmark_qfunction<mfem::Geometry::CUBE, 2>(num_elements);
+  SERAC_MARK_END("q-functions");
+
+  SERAC_MARK_BEGIN("integral kernels");
+  {
+    auto mesh = serac::mesh::refineAndDistribute(serac::buildCuboidMesh(16, 16, 16), 0, 0);
+    benchmark_integral<1, 3>(*mesh);
+    benchmark_integral<2, 3>(*mesh);
+    benchmark_integral<3, 3>(*mesh);
+  }
+  {
+    auto mesh = serac::mesh::refineAndDistribute(serac::buildRectangleMesh(64, 64), 0, 0);
+    benchmark_integral<1, 2>(*mesh);
+    benchmark_integral<2, 2>(*mesh);
+    benchmark_integral<3, 2>(*mesh);
+  }
+  SERAC_MARK_END("integral kernels");
+
+  // Finalize profiling
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,373 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file benchmark_solid.cpp
+ *
+ * @brief Parameterized benchmarks of the solid mechanics physics modules
+ *
+ * Each run sweeps the given polynomial orders and mesh sizes for one of the cases below, timing the setup,
+ * forward and (where applicable) adjoint phases in separate Caliper regions. The sweep over rank counts is
+ * done by launching with different MPI job sizes, which Adiak records alongside the other parameters.
+ * Machine-readable output can be requested with e.g. `--caliper "hatchet-region-profile,output.format=json"`.
+ *
+ *   neohookean:      quasi-static, finite deformation bending of a Neo-Hookean beam
+ *   j2:              quasi-static bending of a beam with finite deformation J2 plasticity (3D only)
+ *   dynamic:         implicit Newmark dynamics of a Neo-Hookean beam
+ *   adjoint:         the neohookean case, followed by the reverse adjoint sweep and shape sensitivities
+ *   contact:         frictionless penalty contact between a beam and a block (p = 1, 3D hexahedra only)
+ *   thermomechanics: thermal expansion of a beam with a Green-Saint Venant thermoelastic material (3D only)
+ */
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "axom/CLI11.hpp"
+#include "axom/slic/core/SimpleLogger.hpp"
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/infrastructure/profiling.hpp"
+#include "serac/infrastructure/terminator.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/physics/materials/solid_material.hpp"
+#include "serac/physics/materials/green_saint_venant_thermoelastic.hpp"
+#include "serac/physics/state/state_manager.hpp"
+#include "serac/physics/solid_mechanics.hpp"
+#include "serac/physics/solid_mechanics_contact.hpp"
+#include "serac/physics/thermomechanics.hpp"
+
+namespace {
+
+/// @brief the parameters of a single benchmark run
+struct BenchmarkOptions {
+  std::string test_case   = "neohookean";  ///< which of the cases in the file description to run
+  std::string element     = "tensor";      ///< "tensor" (quadrilaterals/hexahedra) or "simplex" (triangles/tetrahedra)
+  int         dim         = 3;             ///< spatial dimension of the beam
+  int         elements    = 4;             ///< number of elements through the thickness of the beam
+  int         refinements = 0;             ///< number of uniform parallel refinements
+  int         steps       = 4;             ///< number of load or time steps
+};
+
+/// @brief the boundary attribute of the clamped end (x = 0) of the beams built by buildBeamMesh()
+int clampedEnd(int dim) { return (dim == 2) ? 4 : 5; }
+
+/// @brief the boundary attribute of the loaded end (x = length) of the beams built by buildBeamMesh()
+int loadedEnd(int dim) { return (dim == 2) ? 2 : 3; }
+
+/**
+ * @brief build a beam with an aspect ratio of 4 : 1 (: 1) and the requested element type
+ *
+ * @param options the element type, dimension and number of elements through the thickness
+ */
+mfem::Mesh buildBeamMesh(const BenchmarkOptions& options)
+{
+  constexpr double length  = 4.0;
+  bool             simplex = (options.element == "simplex");
+  int              n       = options.elements;
+
+  if (options.dim == 2) {
+    auto type = simplex ? mfem::Element::TRIANGLE : mfem::Element::QUADRILATERAL;
+    return mfem::Mesh::MakeCartesian2D(4 * n, n, type, true, length, 1.0);
+  }
+
+  auto type = simplex ? mfem::Element::TETRAHEDRON : mfem::Element::HEXAHEDRON;
+  return mfem::Mesh::MakeCartesian3D(4 * n, n, n, type, length, 1.0, 1.0);
+}
+
+/// @brief record the parameters of a run, so that runs can be told apart when their profiles are aggregated
+void setBenchmarkMetadata(const BenchmarkOptions& options, int p, int global_dofs)
+{
+  SERAC_SET_METADATA("case", options.test_case);
+  SERAC_SET_METADATA("element", options.element);
+  SERAC_SET_METADATA("order", p);
+  SERAC_SET_METADATA("dim", options.dim);
+  SERAC_SET_METADATA("elements", options.elements);
+  SERAC_SET_METADATA("refinements", options.refinements);
+  SERAC_SET_METADATA("steps", options.steps);
+  SERAC_SET_METADATA("global_dofs", global_dofs);
+}
+
+/// @brief clamp one end of a beam and push the other end down over the course of the loading
+template <int dim, typename SolidType>
+void applyBendingConditions(SolidType& solid, const BenchmarkOptions& options)
+{
+  auto zero = [](const mfem::Vector&, mfem::Vector& u) {
+    u.SetSize(dim);
+    u = 0.0;
+  };
+  auto tip_deflection = [](const mfem::Vector&, double t, mfem::Vector& u) {
+    u.SetSize(dim);
+    u          = 0.0;
+    u[dim - 1] = -0.5 * t;
+  };
+
+  solid.setDisplacementBCs({clampedEnd(options.dim)}, zero);
+  solid.setDisplacementBCs({loadedEnd(options.dim)}, tip_deflection);
+  solid.setDisplacement(zero);
+}
+
+/// @brief advance a physics module through the requested number of steps, in a single "forward" region
+void forwardSweep(serac::BasePhysics& physics, const BenchmarkOptions& options)
+{
+  SERAC_MARK_SCOPE("forward");
+  double dt = 1.0 / options.steps;
+  for (int i = 0; i < options.steps; i++) {
+    physics.advanceTimestep(dt);
+  }
+}
+
+/// @brief solve the adjoint problems of a completed forward sweep, with a unit load on the final displacement
+void adjointSweep(serac::BasePhysics& physics)
+{
+  SERAC_MARK_SCOPE("adjoint");
+
+  serac::FiniteElementDual adjoint_load(physics.state("displacement").space(), "adjoint_displacement_load");
+
+  while (physics.cycle() > 0) {
+    adjoint_load = 1.0;
+    physics.setAdjointLoad({{"displacement", adjoint_load}});
+    physics.reverseAdjointTimestep();
+    physics.computeTimestepShapeSensitivity();
+  }
+}
+
+/// @brief the solid mechanics cases on the beam: neohookean, j2, dynamic and adjoint
+template <int p, int dim>
+void solidBenchmark(const BenchmarkOptions& options)
+{
+  auto timestepping = serac::solid_mechanics::default_quasistatic_options;
+  if (options.test_case == "dynamic") {
+    timestepping = serac::solid_mechanics::default_timestepping_options;
+  }
+
+  SERAC_MARK_BEGIN("setup");
+
+  serac::SolidMechanics<p, dim> solid(serac::solid_mechanics::default_nonlinear_options,
+                                      serac::solid_mechanics::default_linear_options, timestepping,
+                                      serac::GeometricNonlinearities::On, "solid", "beam");
+
+  if (options.test_case == "j2") {
+    if constexpr (dim == 3) {
+      using Hardening = serac::solid_mechanics::PowerLawHardening;
+      using Material  = serac::solid_mechanics::J2<Hardening>;
+
+      Hardening hardening{.sigma_y = 0.01, .n = 2.0, .eps0 = 0.01};
+      Material  material{.E = 1.0, .nu = 0.25, .hardening = hardening, .density = 1.0};
+      solid.setMaterial(material, solid.createQuadratureDataBuffer(Material::State{}));
+    }
+  } else {
+    serac::solid_mechanics::NeoHookean material{.density = 1.0, .K = 1.0, .G = 0.25};
+    solid.setMaterial(material);
+  }
+
+  applyBendingConditions<dim>(solid, options);
+  solid.completeSetup();
+
+  SERAC_MARK_END("setup");
+
+  setBenchmarkMetadata(options, p, solid.displacement().GlobalSize());
+
+  forwardSweep(solid, options);
+
+  if (options.test_case == "adjoint") {
+    adjointSweep(solid);
+  }
+}
+
+/// @brief the contact case, a beam pressed down onto a block (see the contact_beam test)
+template <int p, int dim>
+void contactBenchmark(const BenchmarkOptions& options)
+{
+  SERAC_MARK_BEGIN("setup");
+
+  serac::ContactOptions contact_options{.method      = serac::ContactMethod::SingleMortar,
+                                        .enforcement = serac::ContactEnforcement::Penalty,
+                                        .type        = serac::ContactType::Frictionless,
+                                        .penalty     = 1.0e2};
+
+  serac::SolidMechanicsContact<p, dim> solid(
+      serac::solid_mechanics::default_nonlinear_options, serac::solid_mechanics::direct_linear_options,
+      serac::solid_mechanics::default_quasistatic_options, serac::GeometricNonlinearities::On, "contact", "beam");
+
+  serac::solid_mechanics::NeoHookean material{.density = 1.0, .K = 10.0, .G = 0.25};
+  solid.setMaterial(material);
+
+  solid.setDisplacementBCs({1}, [](const mfem::Vector&, mfem::Vector& u) {
+    u.SetSize(dim);
+    u = 0.0;
+  });
+  solid.setDisplacementBCs({6}, [](const mfem::Vector&, double t, mfem::Vector& u) {
+    u.SetSize(dim);
+    u    = 0.0;
+    u[2] = -0.15 * t;
+  });
+
+  solid.addContactInteraction(0, {7}, {5}, contact_options);
+  solid.completeSetup();
+
+  SERAC_MARK_END("setup");
+
+  setBenchmarkMetadata(options, p, solid.displacement().GlobalSize());
+
+  forwardSweep(solid, options);
+}
+
+/// @brief the thermomechanics case, a clamped beam heated nonuniformly along its length
+template <int p, int dim>
+void thermomechanicsBenchmark(const BenchmarkOptions& options)
+{
+  SERAC_MARK_BEGIN("setup");
+
+  serac::Thermomechanics<p, dim> thermal_solid(
+      serac::heat_transfer::default_nonlinear_options, serac::heat_transfer::default_linear_options,
+      serac::heat_transfer::default_static_options, serac::solid_mechanics::default_nonlinear_options,
+      serac::solid_mechanics::default_linear_options, serac::solid_mechanics::default_quasistatic_options,
+      serac::GeometricNonlinearities::On, "thermomechanics", "beam");
+
+  using Material = serac::GreenSaintVenantThermoelasticMaterial;
+
+  Material material{.density = 1.0, .E = 1.0, .nu = 0.25, .C_v = 1.0, .alpha = 1.0e-3, .theta_ref = 1.0, .k = 1.0};
+  thermal_solid.setMaterial(material, thermal_solid.createQuadratureDataBuffer(Material::State{}));
+
+  auto temperature = [](const mfem::Vector& x, double t) { return 1.0 + 10.0 * t * x[0]; };
+  thermal_solid.setTemperatureBCs({clampedEnd(dim), loadedEnd(dim)}, temperature);
+  thermal_solid.setTemperature([](const mfem::Vector&, double) { return 1.0; });
+
+  auto zero = [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; };
+  thermal_solid.setDisplacementBCs({clampedEnd(dim)}, zero);
+  thermal_solid.setDisplacement(zero);
+
+  thermal_solid.completeSetup();
+
+  SERAC_MARK_END("setup");
+
+  int global_dofs = thermal_solid.displacement().GlobalSize() + thermal_solid.temperature().GlobalSize();
+  setBenchmarkMetadata(options, p, global_dofs);
+
+  forwardSweep(thermal_solid, options);
+}
+
+/// @brief build the mesh for a run, and dispatch to the benchmark of its case
+template <int p, int dim>
+void runBenchmark(const BenchmarkOptions& options)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "benchmark_solid_" + options.test_case);
+
+  bool contact = (options.test_case == "contact");
+  auto mesh    = contact ? serac::buildMeshFromFile(SERAC_REPO_DIR "/data/meshes/beam-hex-with-contact-block.mesh")
+                         : buildBeamMesh(options);
+  serac::StateManager::setMesh(serac::mesh::refineAndDistribute(std::move(mesh), 0, options.refinements), "beam");
+
+  std::string region = serac::profiling::concat(options.test_case, " p=", p, " ", dim, "D ", options.element,
+                                                " n=", options.elements, " r=", options.refinements);
+  SERAC_MARK_BEGIN(region.c_str());
+
+  if (options.test_case == "contact") {
+    if constexpr (p == 1 && dim == 3) {
+      contactBenchmark<p, dim>(options);
+    }
+  } else if (options.test_case == "thermomechanics") {
+    if constexpr (dim == 3) {
+      thermomechanicsBenchmark<p, dim>(options);
+    }
+  } else {
+    solidBenchmark<p, dim>(options);
+  }
+
+  SERAC_MARK_END(region.c_str());
+
+  serac::StateManager::reset();
+}
+
+/// @brief instantiate the benchmarks for the requested polynomial order
+template <int dim>
+void runBenchmark(const BenchmarkOptions& options, int p)
+{
+  switch (p) {
+    case 1:
+      runBenchmark<1, dim>(options);
+      break;
+    case 2:
+      runBenchmark<2, dim>(options);
+      break;
+    case 3:
+      runBenchmark<3, dim>(options);
+      break;
+    case 4:
+      runBenchmark<4, dim>(options);
+      break;
+  }
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  BenchmarkOptions options;
+  std::vector<int> orders{1, 2};
+  std::vector<int> sizes{options.elements};
+  std::string      caliper_options;
+
+  const std::set<std::string> cases{"neohookean", "j2", "dynamic", "adjoint", "contact", "thermomechanics"};
+
+  axom::CLI::App app{"Solid mechanics benchmarks"};
+  app.add_option("--case", options.test_case, "Which problem to run")->check(axom::CLI::IsMember(cases));
+  app.add_option("--order", orders, "Polynomial orders to sweep over")->check(axom::CLI::Range(1, 4));
+  app.add_option("--dim", options.dim, "Spatial dimension")->check(axom::CLI::Range(2, 3));
+  app.add_option("--element", options.element, "Element type")->check(axom::CLI::IsMember({"tensor", "simplex"}));
+  app.add_option("--elements", sizes, "Numbers of elements through the beam thickness to sweep over")
+      ->check(axom::CLI::PositiveNumber);
+  app.add_option("--refinements", options.refinements, "Number of uniform parallel refinements");
+  app.add_option("--steps", options.steps, "Number of load or time steps")->check(axom::CLI::PositiveNumber);
+  app.add_option("--caliper", caliper_options, "Additional Caliper configuration, e.g. for JSON output");
+
+  try {
+    app.parse(argc, argv);
+  } catch (const axom::CLI::ParseError& e) {
+    serac::logger::flush();
+    if (e.get_name() == "CallForHelp") {
+      SLIC_INFO_ROOT(app.help());
+      serac::exitGracefully();
+    } else {
+      SLIC_ERROR_ROOT(axom::CLI::FailureMessage::simple(&app, e));
+    }
+  }
+
+  bool three_dimensional_only = (options.test_case == "j2" || options.test_case == "thermomechanics");
+  SLIC_ERROR_ROOT_IF(three_dimensional_only && options.dim != 3, "The j2 and thermomechanics cases are 3D only");
+  SLIC_ERROR_ROOT_IF(options.test_case == "contact" && (options.dim != 3 || orders != std::vector<int>{1}),
+                     "The contact case requires --dim 3 --order 1");
+
+  serac::profiling::initialize(MPI_COMM_WORLD, caliper_options);
+
+  SERAC_SET_METADATA("test", "solid_mechanics");
+
+  for (int p : orders) {
+    for (int n : sizes) {
+      options.elements = n;
+      if (options.dim == 2) {
+        runBenchmark<2>(options, p);
+      } else {
+        runBenchmark<3>(options, p);
+      }
+    }
+  }
+
+  serac::profiling::finalize();
+
+  MPI_Finalize();
+
+  return 0;
+}
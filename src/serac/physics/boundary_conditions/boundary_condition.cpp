@@ -8,6 +8,8 @@
 
 #include "serac/physics/boundary_conditions/boundary_condition.hpp"
 
+#include "serac/infrastructure/expression.hpp"
+
 namespace serac {
 
 BoundaryCondition::BoundaryCondition(GeneralCoefficient coef, const std::optional<int> component,
@@ -92,11 +94,219 @@ void BoundaryCondition::setDofListsFromAttributeMarkers()
   }
 }
 
+void BoundaryCondition::setSeparableInTime(std::function<double(double)> time_scaling,
+                                           std::function<double(double)> dscaling_dt,
+                                           std::function<double(double)> d2scaling_dt2)
+{
+  separable_in_time_   = true;
+  time_scaling_        = std::move(time_scaling);
+  dscaling_dt_         = std::move(dscaling_dt);
+  d2scaling_dt2_       = std::move(d2scaling_dt2);
+  node_values_current_ = false;
+}
+
+bool BoundaryCondition::hasTimeDerivatives(const int order) const
+{
+  if (!separable_in_time_) {
+    return false;
+  }
+
+  // values that don't depend on time have zero time derivatives
+  if (!time_scaling_) {
+    return true;
+  }
+
+  const bool provided = dscaling_dt_ && (order < 2 || d2scaling_dt2_);
+  if (!provided) {
+    return false;
+  }
+
+  if (!nodal_) {
+    cacheDofNodes();
+  }
+  return *nodal_;
+}
+
+void BoundaryCondition::setDofTimeDerivative(mfem::Vector& vector, const double time, const int order) const
+{
+  SLIC_ERROR_IF(space_.GetTrueVSize() != vector.Size(),
+                "State to project and boundary condition space are not compatible.");
+  SLIC_ERROR_IF(order < 1 || order > 2, "Only the first and second time derivatives of a BC are available.");
+  SLIC_ERROR_IF(!hasTimeDerivatives(order), "The time derivatives of this boundary condition are not known.");
+
+  if (!time_scaling_) {
+    for (int i : true_dofs_) {
+      vector(i) = 0.0;
+    }
+    return;
+  }
+
+  const auto& derivative = (order == 1) ? dscaling_dt_ : d2scaling_dt2_;
+  setNodalDofs(vector, time, derivative(time));
+}
+
+void BoundaryCondition::cacheDofNodes() const
+{
+  dof_nodes_.clear();
+  constrained_dofs_.clear();
+
+  const bool vector_valued = is_vector_valued(coef_);
+
+  // a scalar coefficient without a component is projected onto every component of the space,
+  // so it only reduces to one value per node for scalar-valued spaces
+  nodal_ = vector_valued || component_ || space_.GetVDim() == 1;
+
+  // scalar BCs on every component are projected from the boundary elements, so that those
+  // coefficients keep seeing the same transformations (e.g. boundary attributes) as before
+  on_boundary_ = !vector_valued && !component_ && attr_markers_.Size() > 0;
+
+  const int  ndofs    = space_.GetNDofs();
+  const int  vdim     = space_.GetVDim();
+  const bool by_nodes = space_.GetOrdering() == mfem::Ordering::byNODES;
+
+  // 0: not constrained, 1: constrained, 2: constrained and recorded
+  std::vector<int> true_dof_status(static_cast<std::size_t>(space_.GetTrueVSize()), 0);
+  for (int tdof : true_dofs_) {
+    true_dof_status[static_cast<std::size_t>(tdof)] = 1;
+  }
+
+  std::vector<int> node_of_dof(static_cast<std::size_t>(ndofs), -1);
+  for (int ldof : local_dofs_) {
+    const int tdof = space_.GetLocalTDofNumber(ldof);
+    if (tdof < 0 || true_dof_status[static_cast<std::size_t>(tdof)] != 1) {
+      continue;
+    }
+    true_dof_status[static_cast<std::size_t>(tdof)] = 2;
+
+    int& node = node_of_dof[static_cast<std::size_t>(space_.VDofToDof(ldof))];
+    if (node < 0) {
+      node = static_cast<int>(dof_nodes_.size());
+      dof_nodes_.push_back({-1, mfem::IntegrationPoint()});
+    }
+    constrained_dofs_.push_back({tdof, node, by_nodes ? ldof / ndofs : ldof % vdim});
+  }
+
+  for (int tdof : true_dofs_) {
+    if (true_dof_status[static_cast<std::size_t>(tdof)] != 2) {
+      nodal_ = false;
+    }
+  }
+
+  auto&            mesh = *space_.GetMesh();
+  mfem::Array<int> element_dofs;
+  const int        num_elements = on_boundary_ ? mesh.GetNBE() : mesh.GetNE();
+  for (int e = 0; e < num_elements && *nodal_; e++) {
+    if (on_boundary_ && attr_markers_[mesh.GetBdrAttribute(e) - 1] == 0) {
+      continue;
+    }
+
+    const mfem::FiniteElement* element = on_boundary_ ? space_.GetBE(e) : space_.GetFE(e);
+    if (dynamic_cast<const mfem::NodalFiniteElement*>(element) == nullptr) {
+      nodal_ = false;
+      break;
+    }
+
+    if (on_boundary_) {
+      space_.GetBdrElementDofs(e, element_dofs);
+    } else {
+      space_.GetElementDofs(e, element_dofs);
+    }
+
+    const mfem::IntegrationRule& nodes = element->GetNodes();
+    for (int k = 0; k < element_dofs.Size(); k++) {
+      const int dof  = element_dofs[k] >= 0 ? element_dofs[k] : -1 - element_dofs[k];
+      const int node = node_of_dof[static_cast<std::size_t>(dof)];
+      if (node >= 0 && dof_nodes_[static_cast<std::size_t>(node)].element < 0) {
+        dof_nodes_[static_cast<std::size_t>(node)] = {e, nodes.IntPoint(k)};
+      }
+    }
+  }
+
+  for (const auto& node : dof_nodes_) {
+    if (node.element < 0) {
+      nodal_ = false;
+    }
+  }
+
+  node_values_current_ = false;
+}
+
+void BoundaryCondition::evaluateAtDofNodes(const double time) const
+{
+  auto& mesh = *space_.GetMesh();
+
+  auto transformation = [&mesh, on_boundary = on_boundary_](const DofNode& node) {
+    mfem::ElementTransformation* T =
+        on_boundary ? mesh.GetBdrElementTransformation(node.element) : mesh.GetElementTransformation(node.element);
+    T->SetIntPoint(&node.point);
+    return T;
+  };
+
+  // expressions from input decks are evaluated for all the nodes at once, at their current (physical) coordinates
+  auto coordinates = [&]() {
+    const int           dim = mesh.SpaceDimension();
+    std::vector<double> x(dof_nodes_.size() * static_cast<std::size_t>(dim));
+    mfem::Vector        point;
+    for (std::size_t n = 0; n < dof_nodes_.size(); n++) {
+      point.SetDataAndSize(&x[n * static_cast<std::size_t>(dim)], dim);
+      transformation(dof_nodes_[n])->Transform(dof_nodes_[n].point, point);
+    }
+    return x;
+  };
+
+  if (is_vector_valued(coef_)) {
+    auto&     vec_coef = *get<std::shared_ptr<mfem::VectorCoefficient>>(coef_);
+    const int vdim     = vec_coef.GetVDim();
+    vec_coef.SetTime(time);
+    node_values_.resize(dof_nodes_.size() * static_cast<std::size_t>(vdim));
+
+    if (auto* expressions = dynamic_cast<VectorExpressionCoefficient*>(&vec_coef)) {
+      auto x = coordinates();
+      for (std::size_t i = 0; i < expressions->components().size(); i++) {
+        expressions->components()[i].evaluate(x.data(), mesh.SpaceDimension(), dof_nodes_.size(), time,
+                                               node_values_.data() + i, static_cast<std::size_t>(vdim));
+      }
+      return;
+    }
+
+    mfem::Vector value;
+    for (std::size_t n = 0; n < dof_nodes_.size(); n++) {
+      value.SetDataAndSize(&node_values_[n * static_cast<std::size_t>(vdim)], vdim);
+      vec_coef.Eval(value, *transformation(dof_nodes_[n]), dof_nodes_[n].point);
+    }
+  } else {
+    auto& scalar_coef = *get<std::shared_ptr<mfem::Coefficient>>(coef_);
+    scalar_coef.SetTime(time);
+    node_values_.resize(dof_nodes_.size());
+
+    if (auto* expression = dynamic_cast<ExpressionCoefficient*>(&scalar_coef)) {
+      auto x = coordinates();
+      expression->expression().evaluate(x.data(), mesh.SpaceDimension(), dof_nodes_.size(), time,
+                                        node_values_.data());
+      return;
+    }
+
+    for (std::size_t n = 0; n < dof_nodes_.size(); n++) {
+      node_values_[n] = scalar_coef.Eval(*transformation(dof_nodes_[n]), dof_nodes_[n].point);
+    }
+  }
+}
+
 void BoundaryCondition::setDofs(mfem::Vector& vector, const double time) const
 {
   SLIC_ERROR_IF(space_.GetTrueVSize() != vector.Size(),
                 "State to project and boundary condition space are not compatible.");
 
+  if (!nodal_) {
+    cacheDofNodes();
+  }
+
+  if (*nodal_) {
+    setNodalDofs(vector, time, (separable_in_time_ && time_scaling_) ? time_scaling_(time) : 1.0);
+    return;
+  }
+
+  // otherwise, project the coefficient over the whole space
   FiniteElementState state(space_);
 
   // Generate the scalar dof list from the vector dof list
@@ -127,6 +337,22 @@ void BoundaryCondition::setDofs(mfem::Vector& vector, const double time) const
   }
 }
 
+void BoundaryCondition::setNodalDofs(mfem::Vector& vector, const double time, const double scale) const
+{
+  if (!node_values_current_) {
+    evaluateAtDofNodes(time);
+    node_values_current_ = separable_in_time_;
+  }
+
+  // a scalar coefficient only has values for the constrained component
+  const bool        vector_valued  = is_vector_valued(coef_);
+  const std::size_t num_components = vector_valued ? static_cast<std::size_t>(vectorCoefficient().GetVDim()) : 1;
+  for (const auto& dof : constrained_dofs_) {
+    const std::size_t offset = vector_valued ? static_cast<std::size_t>(dof.component) : 0;
+    vector(dof.true_dof)     = scale * node_values_[static_cast<std::size_t>(dof.node) * num_components + offset];
+  }
+}
+
 void BoundaryCondition::apply(mfem::HypreParMatrix& k_mat, mfem::Vector& rhs, mfem::Vector& state) const
 {
   std::unique_ptr<mfem::HypreParMatrix> eliminated_entries(k_mat.EliminateRowsCols(true_dofs_));
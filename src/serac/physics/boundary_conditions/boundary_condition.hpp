@@ -12,12 +12,14 @@
 
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <optional>
 #include <set>
 #include <type_traits>
 #include <typeinfo>
 #include <utility>
+#include <vector>
 
 #include "serac/infrastructure/logger.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
@@ -93,6 +95,12 @@ public:
    */
   mfem::Array<int>& markers() { return attr_markers_; }
 
+  /**
+   * @brief Returns the vector component that the BC applies to
+   * @return The zero-indexed component, or null if the BC applies to all components
+   */
+  std::optional<int> component() const { return component_; }
+
   /**
    * @brief Accessor for the underlying vector coefficient
    *
@@ -156,6 +164,40 @@ public:
    */
   void setDofs(mfem::Vector& state, const double time = 0.0) const;
 
+  /**
+   * @brief Declares that the prescribed values are separable in time, i.e. that they are g(t) f(x), where f(x) is
+   * the coefficient of this boundary condition
+   *
+   * The coefficient is then only evaluated at the constrained dofs by the first call to setDofs, and later calls
+   * scale those values by g(t).
+   *
+   * @param[in] time_scaling The function g(t), or empty if the prescribed values don't depend on time
+   * @param[in] dscaling_dt The first time derivative of g(t), if known
+   * @param[in] d2scaling_dt2 The second time derivative of g(t), if known
+   *
+   * @note With the derivatives of g(t) (or when the values don't depend on time), the time derivatives of the
+   * prescribed values are available from setDofTimeDerivative, see hasTimeDerivatives
+   */
+  void setSeparableInTime(std::function<double(double)> time_scaling = {},
+                          std::function<double(double)> dscaling_dt = {},
+                          std::function<double(double)> d2scaling_dt2 = {});
+
+  /**
+   * @brief Whether setDofTimeDerivative can compute the time derivatives of the prescribed values, up to the
+   * given order, without finite differences
+   * @param[in] order The highest time derivative needed (1 or 2)
+   */
+  bool hasTimeDerivatives(const int order) const;
+
+  /**
+   * @brief Sets the DOFs constrained by the boundary condition to a time derivative of their prescribed values
+   * @param[inout] state The field to set the constrained DOFs of
+   * @param[in] time The time at which to evaluate the derivative
+   * @param[in] order Which time derivative to evaluate (1 or 2)
+   * @pre hasTimeDerivatives(order) must be true
+   */
+  void setDofTimeDerivative(mfem::Vector& state, const double time, const int order) const;
+
   /**
    * @brief Modify the system of equations \f$Ax=b\f$ by replacing equations that correspond to
    * essential boundary conditions with ones that prescribe the desired values. The rows of the matrix containing
@@ -210,6 +252,41 @@ private:
    */
   void setLocalDofList(const mfem::Array<int>& local_dofs);
 
+  /**
+   * @brief Finds the (boundary) element and the reference coordinates of the node of each constrained true dof,
+   * so that setDofs can evaluate the coefficient at just those points
+   *
+   * @note If the space isn't nodal, setDofs falls back to projecting the coefficient over the whole space
+   */
+  void cacheDofNodes() const;
+
+  /**
+   * @brief Evaluates the coefficient at the cached nodes of the constrained dofs
+   * @param[in] time The time at which to evaluate the coefficient
+   */
+  void evaluateAtDofNodes(const double time) const;
+
+  /**
+   * @brief Sets the constrained DOFs of a nodal space to the coefficient values at their nodes, times a scale factor
+   * @param[inout] vector The field to set the constrained DOFs of
+   * @param[in] time The time at which to evaluate the coefficient (unless the cached values are current)
+   * @param[in] scale The factor to multiply the coefficient values by
+   */
+  void setNodalDofs(mfem::Vector& vector, const double time, const double scale) const;
+
+  /// @brief the location of a node of the constrained dofs, in the reference space of a (boundary) element
+  struct DofNode {
+    int                    element;  ///< the index of the (boundary) element that contains the node
+    mfem::IntegrationPoint point;    ///< the reference coordinates of the node in that element
+  };
+
+  /// @brief a true dof constrained by this BC, and where its value comes from
+  struct ConstrainedDof {
+    int true_dof;   ///< the index of the true dof
+    int node;       ///< the index of its node, in dof_nodes_
+    int component;  ///< the vector component of the dof
+  };
+
   /**
    * @brief A coefficient containing either a mfem::Coefficient or an mfem::VectorCoefficient
    */
@@ -244,6 +321,49 @@ private:
    * The first element is the enum val, the second is the hash of the corresponding enum type
    */
   std::optional<std::pair<int, std::size_t>> tag_;
+
+  /**
+   * @brief Whether the prescribed values are g(t) f(x), see setSeparableInTime
+   */
+  bool separable_in_time_ = false;
+  /**
+   * @brief The time scaling g(t) of a BC that is separable in time (empty implies the values are constant in time)
+   */
+  std::function<double(double)> time_scaling_;
+  /**
+   * @brief The first time derivative of time_scaling_, if provided
+   */
+  std::function<double(double)> dscaling_dt_;
+  /**
+   * @brief The second time derivative of time_scaling_, if provided
+   */
+  std::function<double(double)> d2scaling_dt2_;
+
+  /**
+   * @brief Whether the nodes of the constrained dofs have been cached, and whether they could be (i.e. if the space is
+   * nodal). Empty until the first call to setDofs.
+   */
+  mutable std::optional<bool> nodal_;
+  /**
+   * @brief Whether dof_nodes_ refer to boundary elements rather than elements
+   */
+  mutable bool on_boundary_ = false;
+  /**
+   * @brief The nodes of the constrained dofs, one per scalar dof
+   */
+  mutable std::vector<DofNode> dof_nodes_;
+  /**
+   * @brief The constrained true dofs owned by this processor
+   */
+  mutable std::vector<ConstrainedDof> constrained_dofs_;
+  /**
+   * @brief The values of the coefficient at dof_nodes_ (all of the components of a vector coefficient, node by node)
+   */
+  mutable std::vector<double> node_values_;
+  /**
+   * @brief Whether node_values_ can be reused by the next call to setDofs
+   */
+  mutable bool node_values_current_ = false;
 };
 
 }  // namespace serac
@@ -8,11 +8,104 @@
 
 #include <algorithm>
 #include <iterator>
+#include <numeric>
 
 #include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/memory_usage.hpp"
 
 namespace serac {
 
+namespace {
+
+/// @brief the arrays that make up the storage of a hypre matrix, which are preserved when it is refilled in place
+std::array<const void*, 6> storage_of(hypre_ParCSRMatrix* A)
+{
+  hypre_CSRMatrix* diag = hypre_ParCSRMatrixDiag(A);
+  hypre_CSRMatrix* offd = hypre_ParCSRMatrixOffd(A);
+  return {A,
+          hypre_CSRMatrixI(diag),
+          hypre_CSRMatrixJ(diag),
+          hypre_CSRMatrixI(offd),
+          hypre_CSRMatrixJ(offd),
+          hypre_ParCSRMatrixColMapOffd(A)};
+}
+
+/**
+ * @brief find the positions in a block (diag or offd) of the matrix A of the entries in the same block of the
+ * eliminated entries E
+ *
+ * @param a the block of A, after elimination
+ * @param e the block of E
+ * @param a_original the values of the block of A before elimination
+ * @param a_cols the column of each (local) column of the block of A, in a numbering shared with e_cols
+ * @param e_cols the column of each (local) column of the block of E
+ * @param essential_rows the rows of A that were eliminated, which must all be in E
+ * @param block the positions and values of the eliminated entries
+ * @return false if an eliminated entry of A wasn't found
+ */
+bool find_eliminated_entries(hypre_CSRMatrix* a, hypre_CSRMatrix* e, const std::vector<double>& a_original,
+                             const std::vector<HYPRE_BigInt>& a_cols, const std::vector<HYPRE_BigInt>& e_cols,
+                             const std::vector<bool>& essential_rows, EliminatedEntries::Block& block)
+{
+  block.source.clear();
+  block.eliminated.clear();
+  block.remaining.clear();
+  block.offset.clear();
+
+  const HYPRE_Int* a_I    = hypre_CSRMatrixI(a);
+  const HYPRE_Int* a_J    = hypre_CSRMatrixJ(a);
+  const double*    a_data = hypre_CSRMatrixData(a);
+  const HYPRE_Int* e_I    = hypre_CSRMatrixI(e);
+  const HYPRE_Int* e_J    = hypre_CSRMatrixJ(e);
+  const double*    e_data = hypre_CSRMatrixData(e);
+
+  // the columns of E, in the local column numbering of A
+  std::vector<int> e_to_a(e_cols.size(), -1);
+  for (std::size_t j = 0; j < e_cols.size(); j++) {
+    auto it = std::lower_bound(a_cols.begin(), a_cols.end(), e_cols[j]);
+    if (it == a_cols.end() || *it != e_cols[j]) {
+      return false;
+    }
+    e_to_a[j] = static_cast<int>(it - a_cols.begin());
+  }
+
+  // the position in A of each column of the current row
+  std::vector<int> position(a_cols.size(), -1);
+
+  for (int row = 0; row < hypre_CSRMatrixNumRows(a); row++) {
+    for (int p = a_I[row]; p < a_I[row + 1]; p++) {
+      position[static_cast<std::size_t>(a_J[p])] = p;
+    }
+
+    for (int q = e_I[row]; q < e_I[row + 1]; q++) {
+      int& p = position[static_cast<std::size_t>(e_to_a[static_cast<std::size_t>(e_J[q])])];
+      if (p < 0) {
+        return false;
+      }
+      block.source.push_back(p);
+      block.eliminated.push_back(q);
+      block.remaining.push_back(a_data[p]);
+      block.offset.push_back(a_original[static_cast<std::size_t>(p)] - e_data[q]);
+      p = -1;
+    }
+
+    // every entry of an eliminated row must have been moved to E
+    bool complete = true;
+    for (int p = a_I[row]; p < a_I[row + 1]; p++) {
+      complete = complete && !(essential_rows[static_cast<std::size_t>(row)] &&
+                               position[static_cast<std::size_t>(a_J[p])] >= 0);
+      position[static_cast<std::size_t>(a_J[p])] = -1;
+    }
+    if (!complete) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
 void BoundaryConditionManager::addNatural(const std::set<int>& nat_bdr, serac::GeneralCoefficient nat_bdr_coef,
                                           mfem::ParFiniteElementSpace& space, const std::optional<int> component)
 {
@@ -35,6 +128,7 @@ void BoundaryConditionManager::addEssential(const std::set<int>& ess_bdr, serac:
   ess_bdr_.emplace_back(ess_bdr_coef, component, space, filtered_attrs);
   attrs_in_use_.insert(ess_bdr.begin(), ess_bdr.end());
   all_dofs_valid_ = false;
+  essential_dofs_version_++;
 }
 
 void BoundaryConditionManager::addEssential(const mfem::Array<int>&                  true_dofs,
@@ -43,6 +137,95 @@ void BoundaryConditionManager::addEssential(const mfem::Array<int>&
 {
   ess_bdr_.emplace_back(ess_bdr_coef, std::nullopt, space, true_dofs);
   all_dofs_valid_ = false;
+  essential_dofs_version_++;
+}
+
+std::size_t EliminatedEntries::bytes() const
+{
+  std::size_t total = matrix_ ? memory::bytes(*matrix_) : 0;
+  for (const auto& block : blocks_) {
+    total += memory::bytes(block.source) + memory::bytes(block.eliminated) + memory::bytes(block.remaining) +
+             memory::bytes(block.offset);
+  }
+  return total;
+}
+
+void BoundaryConditionManager::eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix,
+                                                                   EliminatedEntries&    eliminated) const
+{
+  hypre_ParCSRMatrix* A = matrix;
+
+  const bool same_source = eliminated.matrix_ && eliminated.source_storage_ == storage_of(A) &&
+                           eliminated.essential_dofs_version_ == essential_dofs_version_;
+
+  if (same_source && eliminated.reusable_) {
+    matrix.HostReadWrite();
+    eliminated.matrix_->HostReadWrite();
+
+    hypre_ParCSRMatrix* E = *eliminated.matrix_;
+    std::array a_blocks{hypre_ParCSRMatrixDiag(A), hypre_ParCSRMatrixOffd(A)};
+    std::array e_blocks{hypre_ParCSRMatrixDiag(E), hypre_ParCSRMatrixOffd(E)};
+    for (std::size_t b = 0; b < 2; b++) {
+      double*     a_data = hypre_CSRMatrixData(a_blocks[b]);
+      double*     e_data = hypre_CSRMatrixData(e_blocks[b]);
+      const auto& block  = eliminated.blocks_[b];
+      for (std::size_t k = 0; k < block.source.size(); k++) {
+        e_data[block.eliminated[k]] = a_data[block.source[k]] - block.offset[k];
+        a_data[block.source[k]]     = block.remaining[k];
+      }
+    }
+    return;
+  }
+
+  eliminated.eliminations_ = same_source ? eliminated.eliminations_ + 1 : 0;
+
+  // matrices that are replaced by every assembly never get here twice, so the positions of the
+  // eliminated entries are only looked for once the same matrix is eliminated from again
+  const bool find_entries = (eliminated.eliminations_ == 1);
+
+  std::array<std::vector<double>, 2> original;
+  if (find_entries) {
+    matrix.HostRead();
+    for (auto [values, block] : {std::pair{&original[0], hypre_ParCSRMatrixDiag(A)},
+                                 std::pair{&original[1], hypre_ParCSRMatrixOffd(A)}}) {
+      values->assign(hypre_CSRMatrixData(block), hypre_CSRMatrixData(block) + hypre_CSRMatrixNumNonzeros(block));
+    }
+  }
+
+  eliminated.matrix_                 = eliminateAllEssentialDofsFromMatrix(matrix);
+  eliminated.source_storage_         = storage_of(A);
+  eliminated.essential_dofs_version_ = essential_dofs_version_;
+  eliminated.reusable_               = false;
+
+  if (!find_entries) {
+    return;
+  }
+
+  matrix.HostRead();
+  eliminated.matrix_->HostRead();
+
+  hypre_ParCSRMatrix* E = *eliminated.matrix_;
+
+  std::vector<bool> essential_rows(static_cast<std::size_t>(matrix.Height()), false);
+  for (int row : allEssentialTrueDofs()) {
+    essential_rows[static_cast<std::size_t>(row)] = true;
+  }
+
+  // in the diag blocks, both matrices number the columns the same way,
+  // in the offd blocks, the columns are translated through the (sorted) global column maps
+  std::vector<HYPRE_BigInt> diag_cols(static_cast<std::size_t>(hypre_CSRMatrixNumCols(hypre_ParCSRMatrixDiag(A))));
+  std::iota(diag_cols.begin(), diag_cols.end(), HYPRE_BigInt{0});
+
+  auto offd_cols = [](hypre_ParCSRMatrix* M) {
+    auto num_cols = static_cast<std::size_t>(hypre_CSRMatrixNumCols(hypre_ParCSRMatrixOffd(M)));
+    return std::vector<HYPRE_BigInt>(hypre_ParCSRMatrixColMapOffd(M), hypre_ParCSRMatrixColMapOffd(M) + num_cols);
+  };
+
+  eliminated.reusable_ =
+      find_eliminated_entries(hypre_ParCSRMatrixDiag(A), hypre_ParCSRMatrixDiag(E), original[0], diag_cols, diag_cols,
+                              essential_rows, eliminated.blocks_[0]) &&
+      find_eliminated_entries(hypre_ParCSRMatrixOffd(A), hypre_ParCSRMatrixOffd(E), original[1], offd_cols(A),
+                              offd_cols(E), essential_rows, eliminated.blocks_[1]);
 }
 
 void BoundaryConditionManager::updateAllDofs() const
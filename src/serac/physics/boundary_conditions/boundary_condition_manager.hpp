@@ -12,8 +12,10 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "serac/physics/boundary_conditions/boundary_condition.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
@@ -150,6 +152,57 @@ private:
 template <class Iter, class Pred>
 FilterView(Iter, Iter, Pred&&) -> FilterView<Iter, Pred>;
 
+/**
+ * @brief The entries of a matrix eliminated by BoundaryConditionManager::eliminateAllEssentialDofsFromMatrix,
+ * along with where they came from
+ *
+ * Eliminating the essential dofs from a matrix with the same storage (e.g. one refilled in place by
+ * serac::refillOrReplace) again then only moves the values of those entries, rather than allocating a new matrix.
+ */
+class EliminatedEntries {
+public:
+  /// @brief Returns the matrix of eliminated entries
+  mfem::HypreParMatrix& operator*() const { return *matrix_; }
+
+  /// @brief Returns the matrix of eliminated entries, or null if nothing was eliminated yet
+  mfem::HypreParMatrix* get() const { return matrix_.get(); }
+
+  /// @brief Whether anything was eliminated yet
+  explicit operator bool() const { return matrix_ != nullptr; }
+
+  /// @brief The number of bytes allocated for the eliminated entries and their positions
+  std::size_t bytes() const;
+
+  /// @brief the eliminated entries of the diag or offd block of a matrix
+  struct Block {
+    std::vector<int>    source;      ///< the positions of the entries in the matrix they were eliminated from
+    std::vector<int>    eliminated;  ///< the positions of the entries in matrix_
+    std::vector<double> remaining;   ///< the values left at those positions after elimination (e.g. 1 on the diagonal)
+    std::vector<double> offset;      ///< the difference between the values before elimination and the eliminated ones
+  };
+
+private:
+  friend class BoundaryConditionManager;
+
+  /// @brief The eliminated entries
+  std::unique_ptr<mfem::HypreParMatrix> matrix_;
+
+  /// @brief The storage of the matrix the entries were eliminated from, to detect when it is replaced
+  std::array<const void*, 6> source_storage_{};
+
+  /// @brief The version of the essential dofs they were eliminated for, see BoundaryConditionManager
+  int essential_dofs_version_ = -1;
+
+  /// @brief The number of eliminations from the same matrix, the positions of the entries are found by the second one
+  int eliminations_ = 0;
+
+  /// @brief Whether the positions of the eliminated entries could be found, so that they can be moved again
+  bool reusable_ = false;
+
+  /// @brief The positions of the eliminated entries in the diag and offd blocks
+  std::array<Block, 2> blocks_;
+};
+
 /**
  * @brief A container for the boundary condition information relating to a specific physics module
  */
@@ -254,6 +307,20 @@ public:
     return std::unique_ptr<mfem::HypreParMatrix>(matrix.EliminateRowsCols(allEssentialTrueDofs()));
   }
 
+  /**
+   * @brief Eliminates all essential BCs from a matrix, reusing the eliminated entries of a previous elimination
+   *
+   * The first elimination from a matrix (or after its storage or the essential dofs change) allocates the
+   * eliminated entries and finds their positions. Later eliminations from the same, refilled, matrix
+   * only move the values at those positions.
+   *
+   * @param[inout] matrix The matrix to eliminate from, will be modified
+   * @param[inout] eliminated The eliminated matrix entries
+   * @note The sum of the eliminated matrix and the modified parameter is
+   * equal to the initial state of the parameter
+   */
+  void eliminateAllEssentialDofsFromMatrix(mfem::HypreParMatrix& matrix, EliminatedEntries& eliminated) const;
+
   /**
    * @brief Accessor for the essential BC objects
    */
@@ -342,6 +409,11 @@ private:
    * @brief Whether the set of stored total DOFs is valid
    */
   mutable bool all_dofs_valid_ = false;
+
+  /**
+   * @brief Incremented whenever an essential BC is added, so that stale EliminatedEntries can be detected
+   */
+  int essential_dofs_version_ = 0;
 };
 
 }  // namespace serac
@@ -4,6 +4,7 @@
 //
 // SPDX-License-Identifier: (BSD-3-Clause)
 
+#include <algorithm>
 #include <memory>
 
 #include "axom/slic/core/SimpleLogger.hpp"
@@ -86,6 +87,175 @@ TEST(BoundaryCond, DirectTrueDofs)
   }
 }
 
+TEST(BoundaryCond, SetDofsMatchesProjection)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int      N    = 8;
+  constexpr int      ATTR = 1;
+  auto               mesh = mfem::Mesh::MakeCartesian2D(N, N, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh, H1<2, 2>{});
+
+  for (int i = 0; i < par_mesh.GetNBE(); i++) {
+    par_mesh.GetBdrElement(i)->SetAttribute(ATTR);
+  }
+
+  auto f = [](const mfem::Vector& x, double t, mfem::Vector& u) {
+    u[0] = (1.0 + t) * x[0] * x[1];
+    u[1] = (1.0 + t) * (x[0] - 2.0 * x[1] * x[1]);
+  };
+  auto coef = std::make_shared<mfem::VectorFunctionCoefficient>(2, f);
+
+  BoundaryConditionManager bcs(par_mesh);
+  bcs.addEssential({ATTR}, coef, state.space());
+
+  // the same values, described as f(x) g(t)
+  BoundaryConditionManager separable_bcs(par_mesh);
+  separable_bcs.addEssential({ATTR}, std::make_shared<mfem::VectorFunctionCoefficient>(2, f), state.space());
+  separable_bcs.essentials().back().setSeparableInTime([](double t) { return 1.0 + t; });
+
+  for (double t : {0.0, 0.5, 2.0}) {
+    coef->SetTime(t);
+    FiniteElementState expected(state);
+    expected.project(*coef);
+
+    FiniteElementState u(state);
+    FiniteElementState separable_u(state);
+    u           = 0.0;
+    separable_u = 0.0;
+    bcs.essentials().front().setDofs(u, t);
+    separable_bcs.essentials().front().setDofs(separable_u, t);
+
+    for (int i : bcs.allEssentialTrueDofs()) {
+      EXPECT_NEAR(u(i), expected(i), 1.0e-12);
+      EXPECT_NEAR(separable_u(i), expected(i), 1.0e-12);
+    }
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(BoundaryCond, TimeDerivativesOfSeparableBCs)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int      N    = 8;
+  constexpr int      ATTR = 1;
+  auto               mesh = mfem::Mesh::MakeCartesian2D(N, N, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh, H1<2, 2>{});
+
+  for (int i = 0; i < par_mesh.GetNBE(); i++) {
+    par_mesh.GetBdrElement(i)->SetAttribute(ATTR);
+  }
+
+  auto f = [](const mfem::Vector& x, mfem::Vector& u) {
+    u[0] = x[0] * x[1];
+    u[1] = x[0] - 2.0 * x[1] * x[1];
+  };
+  auto coef = std::make_shared<mfem::VectorFunctionCoefficient>(2, f);
+
+  // f(x) (1 + t^2), with known time derivatives
+  BoundaryConditionManager bcs(par_mesh);
+  bcs.addEssential({ATTR}, coef, state.space());
+  bcs.essentials().back().setSeparableInTime([](double t) { return 1.0 + t * t; }, [](double t) { return 2.0 * t; },
+                                             [](double) { return 2.0; });
+
+  // f(x), which doesn't depend on time
+  BoundaryConditionManager constant_bcs(par_mesh);
+  constant_bcs.addEssential({ATTR}, coef, state.space());
+  constant_bcs.essentials().back().setSeparableInTime();
+
+  // the time derivatives of BCs that aren't known to be separable have to be approximated
+  BoundaryConditionManager general_bcs(par_mesh);
+  general_bcs.addEssential({ATTR}, coef, state.space());
+
+  const auto& bc          = bcs.essentials().front();
+  const auto& constant_bc = constant_bcs.essentials().front();
+  EXPECT_TRUE(bc.hasTimeDerivatives(2));
+  EXPECT_TRUE(constant_bc.hasTimeDerivatives(2));
+  EXPECT_FALSE(general_bcs.essentials().front().hasTimeDerivatives(1));
+
+  FiniteElementState expected(state);
+  expected.project(*coef);
+
+  double             t = 1.5;
+  FiniteElementState du_dt(state);
+  FiniteElementState d2u_dt2(state);
+  du_dt   = 1.0;
+  d2u_dt2 = 1.0;
+  bc.setDofTimeDerivative(du_dt, t, 1);
+  bc.setDofTimeDerivative(d2u_dt2, t, 2);
+  for (int i : bcs.allEssentialTrueDofs()) {
+    EXPECT_NEAR(du_dt(i), 2.0 * t * expected(i), 1.0e-12);
+    EXPECT_NEAR(d2u_dt2(i), 2.0 * expected(i), 1.0e-12);
+  }
+
+  constant_bc.setDofTimeDerivative(du_dt, t, 1);
+  for (int i : constant_bcs.allEssentialTrueDofs()) {
+    EXPECT_EQ(du_dt(i), 0.0);
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
+TEST(BoundaryCond, RepeatedEliminationFromRefilledMatrix)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+  constexpr int      N    = 8;
+  constexpr int      ATTR = 1;
+  auto               mesh = mfem::Mesh::MakeCartesian2D(N, N, mfem::Element::QUADRILATERAL);
+  mfem::ParMesh      par_mesh(MPI_COMM_WORLD, mesh);
+  FiniteElementState state(par_mesh, H1<2>{});
+
+  for (int i = 0; i < par_mesh.GetNBE(); i++) {
+    par_mesh.GetBdrElement(i)->SetAttribute(ATTR);
+  }
+
+  BoundaryConditionManager bcs(par_mesh);
+  bcs.addEssential({ATTR}, std::make_shared<mfem::ConstantCoefficient>(1.0), state.space());
+
+  mfem::ParBilinearForm form(&state.space());
+  form.AddDomainIntegrator(new mfem::DiffusionIntegrator);
+  form.AddDomainIntegrator(new mfem::MassIntegrator);
+  form.Assemble();
+  form.Finalize();
+
+  std::unique_ptr<mfem::HypreParMatrix> J(form.ParallelAssemble());
+  EliminatedEntries                     J_e;
+
+  mfem::Vector x(state.space().GetTrueVSize());
+  mfem::Vector expected(x.Size());
+  mfem::Vector actual(x.Size());
+
+  for (int i = 0; i < 4; i++) {
+    // overwrite the values of J (including the ones eliminated before), keeping its storage
+    std::unique_ptr<mfem::HypreParMatrix> values(form.ParallelAssemble());
+    *values *= 1.0 + i;
+    hypre_ParCSRMatrix* dst = *J;
+    hypre_ParCSRMatrix* src = *values;
+    for (auto [d, s] : {std::pair{hypre_ParCSRMatrixDiag(dst), hypre_ParCSRMatrixDiag(src)},
+                        std::pair{hypre_ParCSRMatrixOffd(dst), hypre_ParCSRMatrixOffd(src)}}) {
+      std::copy_n(hypre_CSRMatrixData(s), hypre_CSRMatrixNumNonzeros(s), hypre_CSRMatrixData(d));
+    }
+    bcs.eliminateAllEssentialDofsFromMatrix(*J, J_e);
+
+    auto reference_e = bcs.eliminateAllEssentialDofsFromMatrix(*values);
+
+    x.Randomize(i + 1);
+
+    values->Mult(x, expected);
+    J->Mult(x, actual);
+    for (int j = 0; j < x.Size(); j++) {
+      EXPECT_NEAR(actual(j), expected(j), 1.0e-12);
+    }
+
+    reference_e->Mult(x, expected);
+    (*J_e).Mult(x, actual);
+    for (int j = 0; j < x.Size(); j++) {
+      EXPECT_NEAR(actual(j), expected(j), 1.0e-12);
+    }
+  }
+  MPI_Barrier(MPI_COMM_WORLD);
+}
+
 enum TestTag
 {
   Tag1 = 0,
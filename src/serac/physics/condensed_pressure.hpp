@@ -0,0 +1,158 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file condensed_pressure.hpp
+ *
+ * @brief The discontinuous pressure of a mixed displacement-pressure formulation, condensed element by element
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/physics/common.hpp"
+
+namespace serac {
+
+/**
+ * @brief The pressure of a mixed displacement-pressure (u-p) formulation of nearly incompressible solids, in the
+ * discontinuous space L2<order - 1>, condensed out of the displacement equations
+ *
+ * The pressure p and its test functions q satisfy the constraint
+ *
+ *     integral q ((J - 1) - p / K) dX = 0,
+ *
+ * with the bulk modulus K, and replace the mean stress of the material in the equilibrium equations. As the pressure
+ * is discontinuous, its mass matrix M is block diagonal, and the pressure p = K M^{-1} g(u), with the dilatation
+ * g(u) = integral q (J - 1) dX, is found element by element. So the system of equations keeps only the displacement
+ * dofs: the pressure adds the work integral grad(v) : p J F^{-T} dX to the residual, and
+ *
+ *     dW/du + dW/dp K M^{-1} dg/du
+ *
+ * to its Jacobian. The pressure is local to each element, so this doesn't change the sparsity of the Jacobian. Unlike
+ * the mean stress of the material at every quadrature point, the lower-order pressure doesn't lock as the material
+ * becomes incompressible.
+ *
+ * @tparam order The polynomial order of the displacement
+ * @tparam dim The spatial dimension
+ */
+template <int order, int dim>
+class CondensedPressure {
+public:
+  static_assert(order >= 1, "The pressure of a mixed formulation is one order lower than the displacement");
+
+  /// @brief The space of the displacement
+  using displacement_space = H1<order, dim>;
+
+  /// @brief The space of the pressure
+  using pressure_space = L2<order - 1>;
+
+  /**
+   * @brief Build the integrals of the dilatation and of the work of the pressure
+   *
+   * @param[in] displacement The space of the displacement
+   * @param[in] pressure The space of the pressure
+   * @param[in] bulk_modulus The bulk modulus K of the material
+   * @param[in] geom_nonlin Whether J and F are those of finite deformations, or their small strain linearizations
+   */
+  CondensedPressure(const mfem::ParFiniteElementSpace& displacement, const mfem::ParFiniteElementSpace& pressure,
+                    double bulk_modulus, GeometricNonlinearities geom_nonlin)
+  {
+    auto& mesh = *displacement.GetParMesh();
+
+    std::array<const mfem::ParFiniteElementSpace*, 1> dilatation_trial_spaces{&displacement};
+    dilatation_ = std::make_unique<Functional<pressure_space(displacement_space)>>(&pressure, dilatation_trial_spaces);
+    dilatation_->AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0>{},
+        [geom_nonlin](double, auto, auto u) {
+          auto du_dX = get<DERIVATIVE>(u);
+          auto J     = (geom_nonlin == GeometricNonlinearities::On) ? det(du_dX + Identity<dim>()) : 1.0 + tr(du_dX);
+          return serac::tuple{J - 1.0, zero{}};
+        },
+        mesh);
+
+    std::array<const mfem::ParFiniteElementSpace*, 2> work_trial_spaces{&displacement, &pressure};
+    work_ = std::make_unique<Functional<displacement_space(displacement_space, pressure_space)>>(&displacement,
+                                                                                                 work_trial_spaces);
+    work_->AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0, 1>{},
+        [geom_nonlin](double, auto, auto u, auto p) {
+          auto du_dX = get<DERIVATIVE>(u);
+          auto dx_dX = 0.0 * du_dX + Identity<dim>();
+          if (geom_nonlin == GeometricNonlinearities::On) {
+            dx_dX += du_dX;
+          }
+          return serac::tuple{zero{}, get<VALUE>(p) * transpose(inv(dx_dX)) * det(dx_dX)};
+        },
+        mesh);
+
+    // the inverse of the block diagonal mass matrix is assembled element by element
+    mfem::ParBilinearForm inverse_mass(const_cast<mfem::ParFiniteElementSpace*>(&pressure));
+    inverse_mass.AddDomainIntegrator(new mfem::InverseIntegrator(new mfem::MassIntegrator()));
+    inverse_mass.Assemble();
+    inverse_mass.Finalize();
+    K_M_inv_.reset(inverse_mass.ParallelAssemble());
+    *K_M_inv_ *= bulk_modulus;
+  }
+
+  /**
+   * @brief Update the pressure for the displacement @a u, and add its work to the residual @a r
+   *
+   * @param[in] t The time
+   * @param[in] u The displacement
+   * @param[out] p The pressure K M^{-1} g(u)
+   * @param[inout] r The residual of the displacement equations
+   */
+  void addToResidual(double t, const mfem::Vector& u, mfem::Vector& p, mfem::Vector& r)
+  {
+    K_M_inv_->Mult((*dilatation_)(t, u), p);
+    r += (*work_)(t, u, p);
+  }
+
+  /**
+   * @brief Update the pressure for the displacement @a u, and add the condensed derivatives of its work to the
+   * Jacobian @a J of the displacement equations
+   *
+   * @param[in] t The time
+   * @param[in] u The displacement
+   * @param[out] p The pressure K M^{-1} g(u)
+   * @param[inout] J The Jacobian, before eliminating the essential dofs, see refillOrReplace()
+   */
+  void addToJacobian(double t, const mfem::Vector& u, mfem::Vector& p, std::unique_ptr<mfem::HypreParMatrix>& J)
+  {
+    auto [g, dg_du] = (*dilatation_)(t, differentiate_wrt(u));
+    K_M_inv_->Mult(g, p);
+    std::unique_ptr<mfem::HypreParMatrix> G(assemble(dg_du));
+
+    // each gradient is assembled before the work is differentiated with respect to the other argument
+    auto [w, dW_du] = (*work_)(t, differentiate_wrt(u), p);
+    std::unique_ptr<mfem::HypreParMatrix> W_u(assemble(dW_du));
+
+    auto [w_p, dW_dp] = (*work_)(t, u, differentiate_wrt(p));
+    std::unique_ptr<mfem::HypreParMatrix> W_p(assemble(dW_dp));
+
+    std::unique_ptr<mfem::HypreParMatrix> K_M_inv_G(mfem::ParMult(K_M_inv_.get(), G.get()));
+    std::unique_ptr<mfem::HypreParMatrix> condensed(mfem::ParMult(W_p.get(), K_M_inv_G.get()));
+    std::unique_ptr<mfem::HypreParMatrix> J_u(mfem::Add(1.0, *J, 1.0, *W_u));
+    refillOrReplace(J, std::unique_ptr<mfem::HypreParMatrix>(mfem::Add(1.0, *J_u, 1.0, *condensed)));
+  }
+
+private:
+  /// The dilatation g(u) = integral q (J - 1) dX
+  std::unique_ptr<Functional<pressure_space(displacement_space)>> dilatation_;
+
+  /// The work of the pressure, W(u, p) = integral grad(v) : p J F^{-T} dX
+  std::unique_ptr<Functional<displacement_space(displacement_space, pressure_space)>> work_;
+
+  /// The inverse of the pressure mass matrix, scaled by the bulk modulus
+  std::unique_ptr<mfem::HypreParMatrix> K_M_inv_;
+};
+
+}  // namespace serac
@@ -40,6 +40,16 @@ enum class ContactType
   Frictionless /**< Enforce gap >= 0, pressure <= 0, gap * pressure = 0 in the normal direction */
 };
 
+/**
+ * @brief How the penalty parameter of ContactEnforcement::Penalty is scaled
+ */
+enum class PenaltyScaling
+{
+  Constant, /**< The penalty parameter is applied as-is to all constrained dofs */
+  Stiffness /**< The penalty parameter is a factor on the stiffness of the elements at each constrained dof, divided
+               by the square of its face area, so it needs no tuning to the material and the mesh */
+};
+
 /**
  * @brief Stores the options for a contact pair
  */
@@ -55,6 +65,44 @@ struct ContactOptions {
 
   /// Penalty parameter (only used when enforcement == ContactEnforcement::Penalty)
   double penalty = 1.0e3;
+
+  /// How the penalty parameter is scaled (only used when enforcement == ContactEnforcement::Penalty)
+  PenaltyScaling penalty_scaling = PenaltyScaling::Constant;
+
+  /**
+   * @brief Whether the penalty pressures of each converged solve are accumulated as Lagrange multipliers, and the
+   * step solved again, until the penetration is below gap_tolerance (only used when enforcement ==
+   * ContactEnforcement::Penalty)
+   *
+   * This augmented Lagrangian method reaches the exact constraints of Lagrange multiplier enforcement with a modest
+   * penalty (and a well-conditioned system) and without the extra pressure unknowns.
+   */
+  bool augmented_lagrangian = false;
+
+  /**
+   * @brief Whether the active set of each solve is predicted from the gaps at its start and kept fixed during its
+   * Newton iterations (only used for ContactType::Frictionless with ContactEnforcement::Penalty)
+   *
+   * This keeps contact dofs from chattering between the active and inactive sets from one Newton iteration to the
+   * next. The step is solved again while the active set of its solution differs from the predicted one.
+   */
+  bool predict_active_set = false;
+
+  /// The largest penetration (in nodal gap) of the augmented Lagrangian method
+  double gap_tolerance = 1.0e-8;
+
+  /// The maximum number of extra solves of a step for the augmented Lagrangian method and active set prediction
+  int max_outer_iterations = 10;
+
+  /**
+   * @brief The distance within which the bounding boxes of the two surfaces must come for contact to be evaluated,
+   * or 0 to always evaluate it
+   *
+   * While the surfaces of every contact interaction are further apart than their windows, and were at the last
+   * evaluation, they have no contact pairs, so Tribol's update (including the redecomposition of the surfaces) is
+   * skipped. The window should cover the largest displacement increment of a Newton iteration.
+   */
+  double proximity_window = 0.0;
 };
 
 }  // namespace serac
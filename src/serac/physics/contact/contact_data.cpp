@@ -6,6 +6,8 @@
 
 #include "serac/physics/contact/contact_data.hpp"
 
+#include <algorithm>
+
 #include "axom/slic.hpp"
 
 #ifdef SERAC_USE_TRIBOL
@@ -15,6 +17,63 @@
 
 namespace serac {
 
+std::unique_ptr<mfem::HypreParMatrix> contact::squaredEntries(const mfem::HypreParMatrix& A)
+{
+  auto               A2 = std::make_unique<mfem::HypreParMatrix>(A);
+  mfem::SparseMatrix diag, offd;
+  HYPRE_BigInt*      cmap;
+  A2->GetDiag(diag);
+  A2->GetOffd(offd, cmap);
+  for (auto* block : {&diag, &offd}) {
+    double* entries = block->GetData();
+    for (int k = 0; k < block->NumNonZeroElems(); ++k) {
+      entries[k] *= entries[k];
+    }
+  }
+  return A2;
+}
+
+ContactJacobianOperator::ContactJacobianOperator(const mfem::Operator& J) : mfem::Operator(J.Height(), J.Width()), J_(J)
+{
+}
+
+void ContactJacobianOperator::addMatrix(std::unique_ptr<mfem::HypreParMatrix> A) { matrices_.push_back(std::move(A)); }
+
+void ContactJacobianOperator::addPenaltyConstraint(std::unique_ptr<mfem::HypreParMatrix> B,
+                                                   const mfem::Vector&                   penalties)
+{
+  constraints_.push_back(std::move(B));
+  penalties_.push_back(penalties);
+}
+
+void ContactJacobianOperator::Mult(const mfem::Vector& x, mfem::Vector& y) const
+{
+  J_.Mult(x, y);
+  for (const auto& A : matrices_) {
+    A->Mult(1.0, x, 1.0, y);
+  }
+  for (size_t i{0}; i < constraints_.size(); ++i) {
+    mfem::Vector Bx(constraints_[i]->Height());
+    constraints_[i]->Mult(x, Bx);
+    Bx *= penalties_[i];
+    constraints_[i]->MultTranspose(1.0, Bx, 1.0, y);
+  }
+}
+
+void ContactJacobianOperator::AssembleDiagonal(mfem::Vector& diag) const
+{
+  J_.AssembleDiagonal(diag);
+  for (const auto& A : matrices_) {
+    mfem::Vector A_diag;
+    A->GetDiag(A_diag);
+    diag += A_diag;
+  }
+  // the diagonal of B^T diag(penalty) B is (B o B)^T penalty
+  for (size_t i{0}; i < constraints_.size(); ++i) {
+    contact::squaredEntries(*constraints_[i])->MultTranspose(1.0, penalties_[i], 1.0, diag);
+  }
+}
+
 #ifdef SERAC_USE_TRIBOL
 
 ContactData::ContactData(const mfem::ParMesh& mesh)
@@ -39,13 +98,28 @@ void ContactData::addContactInteraction(int interaction_id, const std::set<int>&
     num_pressure_dofs_ += interactions_.back().numPressureDofs();
     offsets_up_to_date_ = false;
   }
+  // the new coupling scheme has no redecomposed surface mesh yet
+  search_coords_.Destroy();
+  apart_at_last_update_ = false;
 }
 
 void ContactData::update(int cycle, double time, double& dt)
 {
+  // surfaces that have stayed apart since the last update have no contact pairs, and nothing to update
+  bool apart = surfacesApart();
+  if (apart && apart_at_last_update_) {
+    return;
+  }
+  apart_at_last_update_ = apart;
+
   // This updates the redecomposed surface mesh based on the current displacement, then transfers field quantities to
-  // the updated mesh.
-  tribol::updateMfemParallelDecomposition();
+  // the updated mesh. The redecomposition (and the binning of the surfaces across ranks) is reused while the
+  // coordinates are unchanged, e.g. between the two calls in residualFunction() or across line search evaluations at
+  // the same displacement.
+  if (searchOutOfDate()) {
+    tribol::updateMfemParallelDecomposition();
+    search_coords_ = current_coords_;
+  }
   // This function computes forces, gaps, and Jacobian contributions based on the current field quantities. Note the
   // fields (with the exception of pressure) are stored on the redecomposed surface mesh until transferred by calling
   // forces(), mergedGaps(), etc.
@@ -142,19 +216,16 @@ std::unique_ptr<mfem::BlockOperator> ContactData::mergedJacobian() const
       // zero out rows not in the active set
       B->EliminateRows(interactions_[i].inactiveDofs());
       if (interactions_[i].getContactOptions().enforcement == ContactEnforcement::Penalty) {
-        // compute contribution to df_(contact)/dx (the 0, 0 block) for penalty
-        std::unique_ptr<mfem::HypreParMatrix> BTB(
-            mfem::ParMult(std::unique_ptr<mfem::HypreParMatrix>(B->Transpose()).get(), B, true));
+        // compute contribution to df_(contact)/dx (the 0, 0 block) for penalty, B^T diag(penalty) B
+        std::unique_ptr<mfem::HypreParMatrix> B_T(B->Transpose());
+        B->ScaleRows(interactions_[i].penalties());
+        std::unique_ptr<mfem::HypreParMatrix> BTB(mfem::ParMult(B_T.get(), B, true));
         delete &interaction_J->GetBlock(1, 0);
         if (block_J->IsZeroBlock(0, 0)) {
-          mfem::Vector penalty(reference_nodes_->ParFESpace()->GetTrueVSize());
-          penalty = interactions_[i].getContactOptions().penalty;
-          BTB->ScaleRows(penalty);
           block_J->SetBlock(0, 0, BTB.release());
         } else {
           block_J->SetBlock(0, 0,
-                            mfem::Add(1.0, static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(0, 0)),
-                                      interactions_[i].getContactOptions().penalty, *BTB));
+                            mfem::Add(1.0, static_cast<mfem::HypreParMatrix&>(block_J->GetBlock(0, 0)), 1.0, *BTB));
         }
         constraint_matrices(static_cast<int>(i), 0) = nullptr;
       } else  // enforcement == ContactEnforcement::LagrangeMultiplier
@@ -263,13 +334,47 @@ std::unique_ptr<mfem::BlockOperator> ContactData::jacobianFunction(const mfem::V
   if (J_contact->IsZeroBlock(0, 0)) {
     J_contact->SetBlock(0, 0, orig_J);
   } else {
-    J_contact->SetBlock(0, 0,
-                        mfem::Add(1.0, *orig_J, 1.0, static_cast<mfem::HypreParMatrix&>(J_contact->GetBlock(0, 0))));
+    // the sum replaces both matrices
+    auto& contact_block = static_cast<mfem::HypreParMatrix&>(J_contact->GetBlock(0, 0));
+    J_contact->SetBlock(0, 0, mfem::Add(1.0, *orig_J, 1.0, contact_block));
+    delete &contact_block;
+    delete orig_J;
   }
 
   return J_contact;
 }
 
+std::unique_ptr<ContactJacobianOperator> ContactData::jacobianOperator(const mfem::Operator& orig_J) const
+{
+  SLIC_ERROR_ROOT_IF(haveLagrangeMultipliers(),
+                     "The matrix-free contact Jacobian only supports penalty enforcement of the contact constraints");
+
+  auto J = std::make_unique<ContactJacobianOperator>(orig_J);
+  for (const auto& interaction : interactions_) {
+    auto interaction_J         = interaction.jacobian();
+    interaction_J->owns_blocks = false;  // the blocks that are used are handed to J, the others are deleted
+    if (!interaction_J->IsZeroBlock(0, 0)) {
+      auto A = dynamic_cast<mfem::HypreParMatrix*>(&interaction_J->GetBlock(0, 0));
+      SLIC_ERROR_ROOT_IF(!A, "Only HypreParMatrix constraint matrix blocks are currently supported.");
+      J->addMatrix(std::unique_ptr<mfem::HypreParMatrix>(A));
+    }
+    if (!interaction_J->IsZeroBlock(1, 0)) {
+      auto B = dynamic_cast<mfem::HypreParMatrix*>(&interaction_J->GetBlock(1, 0));
+      SLIC_ERROR_ROOT_IF(!B, "Only HypreParMatrix constraint matrix blocks are currently supported.");
+      // zero out rows not in the active set
+      B->EliminateRows(interaction.inactiveDofs());
+      J->addPenaltyConstraint(std::unique_ptr<mfem::HypreParMatrix>(B), interaction.penalties());
+      if (!interaction_J->IsZeroBlock(0, 1)) {
+        delete &interaction_J->GetBlock(0, 1);
+      }
+      if (!interaction_J->IsZeroBlock(1, 1)) {
+        delete &interaction_J->GetBlock(1, 1);
+      }
+    }
+  }
+  return J;
+}
+
 void ContactData::setPressures(const mfem::Vector& merged_pressures) const
 {
   updateDofOffsets();
@@ -284,7 +389,7 @@ void ContactData::setPressures(const mfem::Vector& merged_pressures) const
       p_interaction.Set(1.0, p_interaction_ref);
     } else  // enforcement == ContactEnforcement::Penalty
     {
-      p_interaction.Set(interactions_[i].getContactOptions().penalty, interactions_[i].gaps());
+      p_interaction = interactions_[i].penaltyPressure();
     }
     for (auto dof : interactions_[i].inactiveDofs()) {
       p_interaction[dof] = 0.0;
@@ -297,6 +402,103 @@ void ContactData::setDisplacements(const mfem::Vector& u)
 {
   reference_nodes_->ParFESpace()->GetProlongationMatrix()->Mult(u, current_coords_);
   current_coords_ += *reference_nodes_;
+  // Tribol is registered through its host mfem interface, so the coordinates must be up-to-date on the host even if
+  // u (and the prolongation above) is on the device
+  current_coords_.HostRead();
+}
+
+void ContactData::startOuterIterations(const mfem::Vector& u, const mfem::Vector& stiffness_diagonal)
+{
+  double dt = 1.0;
+  setDisplacements(u);
+  update(1, 1.0, dt);
+  for (auto& interaction : interactions_) {
+    const auto& options = interaction.getContactOptions();
+    if (options.enforcement != ContactEnforcement::Penalty) {
+      continue;
+    }
+    if (options.penalty_scaling == PenaltyScaling::Stiffness) {
+      interaction.updatePenalties(stiffness_diagonal);
+    }
+    if (options.predict_active_set) {
+      interaction.fixActiveSet(true);
+    }
+  }
+}
+
+bool ContactData::outerIterationConverged(const mfem::Vector& u)
+{
+  double dt = 1.0;
+  setDisplacements(u);
+  update(1, 1.0, dt);
+  // every interaction is updated (collectively), even once another one hasn't converged
+  bool converged = true;
+  for (auto& interaction : interactions_) {
+    const auto& options = interaction.getContactOptions();
+    if (options.enforcement != ContactEnforcement::Penalty) {
+      continue;
+    }
+    if (options.augmented_lagrangian) {
+      converged = interaction.updateMultipliers() && converged;
+    }
+    if (options.predict_active_set) {
+      converged = !interaction.fixActiveSet(true) && converged;
+    }
+  }
+  return converged;
+}
+
+void ContactData::endOuterIterations()
+{
+  for (auto& interaction : interactions_) {
+    interaction.fixActiveSet(false);
+  }
+}
+
+int ContactData::maxOuterIterations() const
+{
+  int max_iterations = 0;
+  for (const auto& interaction : interactions_) {
+    const auto& options = interaction.getContactOptions();
+    if (options.enforcement == ContactEnforcement::Penalty &&
+        (options.augmented_lagrangian || options.predict_active_set)) {
+      max_iterations = std::max(max_iterations, options.max_outer_iterations);
+    }
+  }
+  return max_iterations;
+}
+
+bool ContactData::havePenaltyScaling() const
+{
+  for (const auto& interaction : interactions_) {
+    const auto& options = interaction.getContactOptions();
+    if (options.enforcement == ContactEnforcement::Penalty && options.penalty_scaling == PenaltyScaling::Stiffness) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ContactData::surfacesApart() const
+{
+  for (const auto& interaction : interactions_) {
+    if (interaction.inProximity()) {
+      return false;
+    }
+  }
+  return !interactions_.empty();
+}
+
+bool ContactData::searchOutOfDate() const
+{
+  int out_of_date = search_coords_.Size() != current_coords_.Size();
+  for (int i{0}; !out_of_date && i < current_coords_.Size(); ++i) {
+    // any motion invalidates the transferred coordinates, so this is an exact comparison
+    out_of_date = search_coords_[i] != current_coords_[i];
+  }
+  // the redecomposition is collective
+  MPI_Allreduce(MPI_IN_PLACE, &out_of_date, 1, MPI_INT, MPI_MAX, mesh_.GetComm());
+  return out_of_date;
 }
 
 void ContactData::updateDofOffsets() const
@@ -391,15 +593,36 @@ std::unique_ptr<mfem::BlockOperator> ContactData::jacobianFunction(const mfem::V
   if (J_contact->IsZeroBlock(0, 0)) {
     J_contact->SetBlock(0, 0, orig_J);
   } else {
-    J_contact->SetBlock(0, 0,
-                        mfem::Add(1.0, *orig_J, 1.0, static_cast<mfem::HypreParMatrix&>(J_contact->GetBlock(0, 0))));
+    // the sum replaces both matrices
+    auto& contact_block = static_cast<mfem::HypreParMatrix&>(J_contact->GetBlock(0, 0));
+    J_contact->SetBlock(0, 0, mfem::Add(1.0, *orig_J, 1.0, contact_block));
+    delete &contact_block;
+    delete orig_J;
   }
 
   return J_contact;
 }
 
+std::unique_ptr<ContactJacobianOperator> ContactData::jacobianOperator(const mfem::Operator& orig_J) const
+{
+  return std::make_unique<ContactJacobianOperator>(orig_J);
+}
+
 void ContactData::setPressures([[maybe_unused]] const mfem::Vector& true_pressures) const {}
 
+void ContactData::startOuterIterations([[maybe_unused]] const mfem::Vector& u,
+                                       [[maybe_unused]] const mfem::Vector& stiffness_diagonal)
+{
+}
+
+bool ContactData::outerIterationConverged([[maybe_unused]] const mfem::Vector& u) { return true; }
+
+void ContactData::endOuterIterations() {}
+
+int ContactData::maxOuterIterations() const { return 0; }
+
+bool ContactData::havePenaltyScaling() const { return false; }
+
 void ContactData::setDisplacements([[maybe_unused]] const mfem::Vector& true_displacement) {}
 
 #endif
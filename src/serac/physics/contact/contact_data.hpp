@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include "mfem.hpp"
 
 #include "serac/serac_config.hpp"
@@ -34,11 +37,75 @@ const ContactOptions default_contact_options = {.method      = ContactMethod::Si
                                                 .type        = ContactType::Frictionless,
                                                 .penalty     = 1.0e3};
 
+/**
+ * @brief Copy a matrix with each of its entries squared
+ *
+ * @param A The matrix
+ * @return The matrix of the squares of the entries of A
+ */
+std::unique_ptr<mfem::HypreParMatrix> squaredEntries(const mfem::HypreParMatrix& A);
+
 }  // namespace contact
 
+/**
+ * @brief The action of a Jacobian with penalty contact terms, without assembling their products
+ *
+ * The penalty term B^T diag(penalty) B of each contact interaction is applied through its constraint matrix B, which
+ * only couples the pressure dofs to the displacements of their faces and the opposing faces, while the product
+ * couples every pair of those displacements. So the Jacobian of the rest of the problem can stay matrix-free too,
+ * e.g. a Functional gradient, and Jacobi-type preconditioners see the diagonal of the sum.
+ */
+class ContactJacobianOperator : public mfem::Operator {
+public:
+  /**
+   * @brief The contact terms plus the non-contact Jacobian @a J
+   *
+   * @param J The non-contact terms of the Jacobian, which must outlive this operator
+   */
+  explicit ContactJacobianOperator(const mfem::Operator& J);
+
+  /**
+   * @brief Add an assembled term of the Jacobian
+   *
+   * @param A The term, on the displacement true dofs
+   */
+  void addMatrix(std::unique_ptr<mfem::HypreParMatrix> A);
+
+  /**
+   * @brief Add a penalty term B^T diag(penalty) B
+   *
+   * @param B The constraint matrix, from the displacement to the pressure true dofs
+   * @param penalties The penalty of each pressure true dof
+   */
+  void addPenaltyConstraint(std::unique_ptr<mfem::HypreParMatrix> B, const mfem::Vector& penalties);
+
+  /// @brief y = J x plus the contact terms
+  void Mult(const mfem::Vector& x, mfem::Vector& y) const override;
+
+  /// @brief the diagonal of J plus that of the contact terms
+  void AssembleDiagonal(mfem::Vector& diag) const override;
+
+private:
+  /// The non-contact terms of the Jacobian
+  const mfem::Operator& J_;
+
+  /// The assembled terms of the Jacobian
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> matrices_;
+
+  /// The constraint matrices of the penalty terms
+  std::vector<std::unique_ptr<mfem::HypreParMatrix>> constraints_;
+
+  /// The penalties of the penalty terms
+  std::vector<mfem::Vector> penalties_;
+};
+
 /**
  * @brief This class stores all ContactInteractions for a problem, calls Tribol functions that act on all contact
  * interactions, and agglomerates fields that exist over different ContactInteractions.
+ *
+ * @note Contact is evaluated on the host, since Tribol is registered through its host mfem interface: the
+ * displacements are read there, and the forces, gaps and Jacobian blocks are returned there, whatever the execution
+ * space of the rest of the residual.
  */
 class ContactData {
 public:
@@ -136,6 +203,18 @@ public:
    */
   std::unique_ptr<mfem::BlockOperator> jacobianFunction(const mfem::Vector& u, mfem::HypreParMatrix* orig_J) const;
 
+  /**
+   * @brief Returns the Jacobian including contact terms as a matrix-free operator, given the non-contact Jacobian
+   *
+   * Only penalty enforcement is supported. The contact terms are those of mergedJacobian(), see
+   * ContactJacobianOperator.
+   *
+   * @param orig_J The non-contact terms of the Jacobian (e.g. a Functional gradient), not including essential boundary
+   * conditions, which must outlive the returned operator
+   * @return Jacobian with contact terms, not including essential boundary conditions
+   */
+  std::unique_ptr<ContactJacobianOperator> jacobianOperator(const mfem::Operator& orig_J) const;
+
   /**
    * @brief Set the pressure field
    *
@@ -149,6 +228,46 @@ public:
    */
   void setPressures(const mfem::Vector& merged_pressures) const;
 
+  /**
+   * @brief Start the solve of a step with penalty enforcement: scale the penalties by the stiffness (for
+   * PenaltyScaling::Stiffness) and predict the active sets from the gaps (for ContactOptions::predict_active_set) at
+   * the displacement the step starts from
+   *
+   * @param u Current displacement dof values
+   * @param stiffness_diagonal The diagonal of the (non-contact) stiffness matrix at @a u, only needed if
+   * havePenaltyScaling()
+   */
+  void startOuterIterations(const mfem::Vector& u, const mfem::Vector& stiffness_diagonal);
+
+  /**
+   * @brief Check a converged solve of a step with penalty enforcement, and update the augmented Lagrangian
+   * multipliers and predicted active sets for the next solve of the step if it isn't done
+   *
+   * @param u Converged displacement dof values
+   * @return true if the penetration is within tolerance and the active sets are as predicted, so the step is done
+   */
+  bool outerIterationConverged(const mfem::Vector& u);
+
+  /**
+   * @brief Finish the solve of a step with penalty enforcement, releasing the predicted active sets
+   */
+  void endOuterIterations();
+
+  /**
+   * @brief Get the largest number of extra solves of a step for the augmented Lagrangian method or active set
+   * prediction of any contact interaction
+   *
+   * @return The number of extra solves, 0 if no contact interaction uses either
+   */
+  int maxOuterIterations() const;
+
+  /**
+   * @brief Are any contact interaction penalties scaled by the stiffness?
+   *
+   * @return true if at least one contact interaction uses PenaltyScaling::Stiffness
+   */
+  bool havePenaltyScaling() const;
+
   /**
    * @brief Update the current coordinates based on the new displacement field
    *
@@ -195,6 +314,20 @@ private:
    */
   void updateDofOffsets() const;
 
+  /**
+   * @brief Are the surfaces of every contact interaction further apart than their proximity windows?
+   *
+   * @return true if no contact interaction can have contact pairs, see ContactOptions::proximity_window
+   */
+  bool surfacesApart() const;
+
+  /**
+   * @brief Have the current coordinates changed on any rank since the last parallel redecomposition?
+   *
+   * @return true if the redecomposition is out of date (or has not been built yet)
+   */
+  bool searchOutOfDate() const;
+
   /**
    * @brief The volume mesh for the problem
    */
@@ -212,10 +345,23 @@ private:
    */
   mfem::ParGridFunction current_coords_;
 
+  /**
+   * @brief Current coordinates of the mesh when the redecomposed surface mesh was last built
+   *
+   * Empty until the first redecomposition, and cleared when a contact interaction is added.
+   */
+  mfem::Vector search_coords_;
+
   /**
    * @brief The contact boundary condition information
    */
   std::vector<ContactInteraction> interactions_;
+
+  /**
+   * @brief True if the surfaces of every contact interaction were apart at the last Tribol update, so that its
+   * (zero) contact forces, gaps and Jacobian contributions stay valid while they remain apart
+   */
+  bool apart_at_last_update_ = false;
 #endif
 
   /**
@@ -8,9 +8,14 @@
 
 #ifdef SERAC_USE_TRIBOL
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "axom/slic.hpp"
 
 #include "serac/physics/contact/contact_config.hpp"
+#include "serac/physics/contact/contact_data.hpp"
 
 #include "tribol/interface/tribol.hpp"
 #include "tribol/interface/mfem_tribol.hpp"
@@ -62,6 +67,20 @@ ContactInteraction::ContactInteraction(int interaction_id, const mfem::ParMesh&
     pressure_space.GetRestrictionMatrix()->BooleanMult(dof_markers, tdof_markers);
     mfem::FiniteElementSpace::MarkerToList(tdof_markers, inactive_tdofs_);
   }
+
+  for (int be{0}; be < mesh.GetNBE(); ++be) {
+    if (bdry_attr_surf1.count(mesh.GetBdrAttribute(be))) {
+      surface_elements_[0].push_back(be);
+    }
+    if (bdry_attr_surf2.count(mesh.GetBdrAttribute(be))) {
+      surface_elements_[1].push_back(be);
+    }
+  }
+
+  penalties_.SetSize(pressureSpace().GetTrueVSize());
+  penalties_ = contact_opts.penalty;
+  multipliers_.SetSize(pressureSpace().GetTrueVSize());
+  multipliers_ = 0.0;
 }
 
 FiniteElementDual ContactInteraction::forces() const
@@ -114,7 +133,7 @@ void ContactInteraction::setPressure(const FiniteElementState& pressure) const
 
 const mfem::Array<int>& ContactInteraction::inactiveDofs() const
 {
-  if (getContactOptions().type == ContactType::Frictionless) {
+  if (getContactOptions().type == ContactType::Frictionless && !active_set_fixed_) {
     auto             p = pressure();
     auto             g = gaps();
     std::vector<int> inactive_tdofs_vector;
@@ -130,6 +149,129 @@ const mfem::Array<int>& ContactInteraction::inactiveDofs() const
   return inactive_tdofs_;
 }
 
+bool ContactInteraction::inProximity() const
+{
+  double window = getContactOptions().proximity_window;
+  if (window <= 0.0) {
+    return true;
+  }
+
+  // the bounding box of each surface, as the minima of its coordinates and of their negatives (i.e. the maxima)
+  const int           dim = current_coords_.ParFESpace()->GetMesh()->SpaceDimension();
+  std::vector<double> bounds(static_cast<size_t>(4 * dim), std::numeric_limits<double>::max());
+  mfem::Array<int>    vdofs;
+  mfem::Vector        coords;
+  for (size_t s{0}; s < 2; ++s) {
+    double* surface_bounds = &bounds[s * static_cast<size_t>(2 * dim)];
+    for (int be : surface_elements_[s]) {
+      current_coords_.ParFESpace()->GetBdrElementVDofs(be, vdofs);
+      current_coords_.GetSubVector(vdofs, coords);
+      // the vdofs are ordered by component
+      const int num_nodes = coords.Size() / dim;
+      for (int c{0}; c < dim; ++c) {
+        for (int k{0}; k < num_nodes; ++k) {
+          surface_bounds[c]       = std::min(surface_bounds[c], coords[c * num_nodes + k]);
+          surface_bounds[dim + c] = std::min(surface_bounds[dim + c], -coords[c * num_nodes + k]);
+        }
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, bounds.data(), static_cast<int>(bounds.size()), MPI_DOUBLE, MPI_MIN,
+                pressureSpace().GetComm());
+
+  // the boxes are apart if they are separated by more than the window in any direction
+  const double* first  = &bounds[0];
+  const double* second = &bounds[static_cast<size_t>(2 * dim)];
+  for (int c{0}; c < dim; ++c) {
+    if (first[c] - (-second[dim + c]) > window || second[c] - (-first[dim + c]) > window) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ContactInteraction::updatePenalties(const mfem::Vector& stiffness_diagonal)
+{
+  penalties_ = contact_opts_.penalty;
+
+  auto  J = jacobian();
+  auto* B = dynamic_cast<mfem::HypreParMatrix*>(&J->GetBlock(1, 0));
+  SLIC_ERROR_ROOT_IF(!B, "Only HypreParMatrix constraint matrix blocks are currently supported.");
+
+  auto B2 = contact::squaredEntries(*B);
+
+  mfem::Vector ones(B2->Width());
+  ones = 1.0;
+  mfem::Vector weights(B2->Height()), stiffness(B2->Height());
+  B2->Mult(ones, weights);
+  B2->Mult(stiffness_diagonal, stiffness);
+
+  // dofs that aren't coupled to the other surface (yet) keep the unscaled penalty
+  for (int i = 0; i < penalties_.Size(); ++i) {
+    if (weights[i] > 0.0) {
+      penalties_[i] *= stiffness[i] / (weights[i] * weights[i]);
+    }
+  }
+}
+
+FiniteElementState ContactInteraction::penaltyPressure() const
+{
+  FiniteElementState p(pressureSpace());
+  auto               g = gaps();
+  for (int d{0}; d < p.Size(); ++d) {
+    p[d] = multipliers_[d] + penalties_[d] * g[d];
+  }
+  return p;
+}
+
+bool ContactInteraction::updateMultipliers()
+{
+  auto p = penaltyPressure();
+  auto g = gaps();
+
+  // frictionless contact may separate, so only penetration counts
+  double penetration = 0.0;
+  for (int d{0}; d < g.Size(); ++d) {
+    penetration = std::max(penetration, getContactOptions().type == ContactType::TiedNormal ? std::abs(g[d]) : -g[d]);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &penetration, 1, MPI_DOUBLE, MPI_MAX, pressureSpace().GetComm());
+  if (penetration <= getContactOptions().gap_tolerance) {
+    return true;
+  }
+
+  for (int d{0}; d < p.Size(); ++d) {
+    multipliers_[d] = getContactOptions().type == ContactType::TiedNormal ? p[d] : std::min(p[d], 0.0);
+  }
+  return false;
+}
+
+bool ContactInteraction::fixActiveSet(bool fixed)
+{
+  active_set_fixed_ = false;
+  if (!fixed || getContactOptions().type != ContactType::Frictionless) {
+    return false;
+  }
+
+  // the dofs whose penalty pressures would pull the surfaces together are inactive
+  auto             p = penaltyPressure();
+  mfem::Array<int> inactive_tdofs;
+  for (int d{0}; d < p.Size(); ++d) {
+    if (p[d] >= 0.0) {
+      inactive_tdofs.Append(d);
+    }
+  }
+
+  int changed = inactive_tdofs.Size() != inactive_tdofs_.Size();
+  for (int i{0}; !changed && i < inactive_tdofs.Size(); ++i) {
+    changed = inactive_tdofs[i] != inactive_tdofs_[i];
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &changed, 1, MPI_INT, MPI_MAX, pressureSpace().GetComm());
+
+  inactive_tdofs_   = inactive_tdofs;
+  active_set_fixed_ = true;
+  return changed;
+}
+
 tribol::ContactMethod ContactInteraction::getMethod() const
 {
   switch (contact_opts_.method) {
@@ -16,6 +16,10 @@
 
 #ifdef SERAC_USE_TRIBOL
 
+#include <array>
+#include <set>
+#include <vector>
+
 #include "mfem.hpp"
 
 #include "serac/physics/contact/contact_config.hpp"
@@ -135,6 +139,60 @@ public:
    */
   const mfem::Array<int>& inactiveDofs() const;
 
+  /**
+   * @brief Are the bounding boxes of the two surfaces (at the current coordinates) within
+   * ContactOptions::proximity_window of each other?
+   *
+   * @return true if the surfaces are close enough to be in contact (on any rank), or if there is no window
+   */
+  bool inProximity() const;
+
+  /**
+   * @brief Get the penalty parameter of each pressure true degree of freedom (only used for penalty enforcement)
+   *
+   * @return The penalties, see ContactOptions::penalty_scaling
+   */
+  const mfem::Vector& penalties() const { return penalties_; }
+
+  /**
+   * @brief Scale the penalties by the stiffness of the elements at each pressure true degree of freedom, for
+   * PenaltyScaling::Stiffness
+   *
+   * With the rows b_i of the constraint matrix dg/dx, penalty_i = penalty * (b_i^2 . k) / (b_i . b_i)^2, i.e. the
+   * average of the stiffness diagonal k over the dofs that b_i couples, over the square of the face area in b_i. So
+   * the penalty term penalty_i b_i^T b_i is on the order of the stiffness of those dofs, times the penalty.
+   *
+   * @param stiffness_diagonal The diagonal of the (non-contact) stiffness matrix, on the displacement true dofs
+   *
+   * @note The Jacobian contributions must be up-to-date, see ContactData::update()
+   */
+  void updatePenalties(const mfem::Vector& stiffness_diagonal);
+
+  /**
+   * @brief Get the pressures of penalty enforcement, lambda + penalty * gap, with the augmented Lagrangian
+   * multipliers lambda
+   *
+   * @return The penalty pressures on the true degrees of freedom of the contact surface
+   */
+  FiniteElementState penaltyPressure() const;
+
+  /**
+   * @brief The augmented Lagrangian update of the multipliers lambda to the penalty pressures at the current gaps,
+   * unless the penetration is within ContactOptions::gap_tolerance already
+   *
+   * @return true if the penetration is within tolerance (on all ranks), and the multipliers are unchanged
+   */
+  bool updateMultipliers();
+
+  /**
+   * @brief Fix the active set to the dofs with compressive penalty pressures at the current gaps, or let it follow
+   * the current pressures and gaps again, see ContactOptions::predict_active_set
+   *
+   * @param fixed Whether the active set is fixed from now on
+   * @return true if fixing the active set changed it (on any rank)
+   */
+  bool fixActiveSet(bool fixed);
+
 private:
   /**
    * @brief Get the Tribol enforcement method given a serac enforcement method
@@ -162,6 +220,26 @@ private:
    * @brief List of true DOFs currently not in the active set
    */
   mutable mfem::Array<int> inactive_tdofs_;
+
+  /**
+   * @brief Boundary elements of the first and second surfaces on this rank
+   */
+  std::array<std::vector<int>, 2> surface_elements_;
+
+  /**
+   * @brief Penalty parameter of each pressure true DOF
+   */
+  mfem::Vector penalties_;
+
+  /**
+   * @brief Augmented Lagrangian multipliers on the pressure true DOFs
+   */
+  mfem::Vector multipliers_;
+
+  /**
+   * @brief True if the active set is fixed, rather than following the pressures and gaps
+   */
+  bool active_set_fixed_ = false;
 };
 
 }  // namespace serac
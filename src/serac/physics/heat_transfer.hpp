@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <limits>
+
 #include "mfem.hpp"
 
 #include "serac/infrastructure/initialize.hpp"
@@ -21,6 +23,8 @@
 #include "serac/numerics/odes.hpp"
 #include "serac/numerics/stdfunction_operator.hpp"
 #include "serac/numerics/functional/shape_aware_functional.hpp"
+#include "serac/physics/low_order_refined.hpp"
+#include "serac/physics/multigrid_levels.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/materials/thermal_material.hpp"
 
@@ -171,10 +175,27 @@ public:
     if (timestepping_opts.timestepper != TimestepMethod::QuasiStatic) {
       ode_.SetTimestepper(timestepping_opts.timestepper);
       ode_.SetEnforcementMethod(timestepping_opts.enforcement_method);
+      ode_.SetTimestepControl(timestepping_opts, mesh_.GetComm());
       is_quasistatic_ = false;
     } else {
       is_quasistatic_ = true;
     }
+    max_cutbacks_                = timestepping_opts.max_cutbacks;
+    target_nonlinear_iterations_ = timestepping_opts.target_nonlinear_iterations;
+    min_increment_               = timestepping_opts.min_dt;
+    max_increment_               = timestepping_opts.max_dt;
+
+    predictor_ =
+        timestepping_opts.predictor == Predictor::Default ? Predictor::PreviousState : timestepping_opts.predictor;
+    extrapolation_order_ = timestepping_opts.extrapolation_order;
+    reuse_linear_jacobian_ = timestepping_opts.reuse_linear_jacobian;
+
+    explicit_integration_ = mfem_ext::FirstOrderODE::IsExplicit(timestepping_opts.timestepper);
+    imex_integration_     = mfem_ext::FirstOrderODE::IsIMEX(timestepping_opts.timestepper);
+    cfl_number_           = timestepping_opts.cfl_number;
+    SLIC_ERROR_ROOT_IF(predictor_ == Predictor::Extrapolation && (extrapolation_order_ < 1 || extrapolation_order_ > 2),
+                       axom::fmt::format("Predictor::Extrapolation supports orders 1 and 2, but {} was requested",
+                                         extrapolation_order_));
 
     states_.push_back(&temperature_);
     if (!is_quasistatic_) {
@@ -209,11 +230,37 @@ public:
         std::make_unique<ShapeAwareFunctional<shape_trial, test(scalar_trial, scalar_trial, parameter_space...)>>(
             shape_space, test_space, trial_spaces);
 
+    // the terms that the implicit-explicit methods treat explicitly are kept out of the residual
+    if (!is_quasistatic_ && imex_integration_) {
+      explicit_terms_ =
+          std::make_unique<ShapeAwareFunctional<shape_trial, test(scalar_trial, scalar_trial, parameter_space...)>>(
+              shape_space, test_space, trial_spaces);
+    }
+
     nonlin_solver_->setOperator(residual_with_bcs_);
 
+    // the coarse levels of geometric multigrid come from the mesh hierarchy given to the StateManager, and those of
+    // p-multigrid from the lower polynomial orders on the same mesh. LOR builds its own low-order refined mesh.
+    mfem::Solver* prec = &nonlin_solver_->preconditioner();
+    if (auto* reusable = dynamic_cast<ReusablePreconditioner*>(prec)) {
+      prec = &reusable->underlying();
+    }
+    if (auto* p_multigrid = dynamic_cast<PMultigridPreconditioner*>(prec)) {
+      multigrid_          = p_multigrid;
+      p_multigrid_levels_ = std::make_unique<PMultigridLevels<order>>(mesh_);
+    } else if (auto* lor = dynamic_cast<LORPreconditioner*>(prec)) {
+      lor_preconditioner_ = lor;
+      low_order_refined_  = std::make_unique<LowOrderRefined<>>(temperature_.space());
+    } else if (auto* multigrid = dynamic_cast<GeometricMultigridPreconditioner*>(prec)) {
+      multigrid_        = multigrid;
+      multigrid_levels_ = std::make_unique<MultigridLevels<H1<order>>>(StateManager::coarseMeshes(mesh_tag_));
+    }
+
     int true_size = temperature_.space().TrueVSize();
     u_.SetSize(true_size);
     u_predicted_.SetSize(true_size);
+    du_.SetSize(true_size);
+    dr_.SetSize(true_size);
 
     shape_displacement_ = 0.0;
     initializeThermalStates();
@@ -277,6 +324,7 @@ public:
   {
     dt_          = 0.0;
     previous_dt_ = -1.0;
+    jacobian_dt_ = -1.0;
 
     u_                                              = 0.0;
     temperature_                                    = 0.0;
@@ -287,11 +335,8 @@ public:
     temperature_rate_adjoint_load_                  = 0.0;
 
     if (!checkpoint_to_disk_) {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+      clearCheckpointedStates();
+      checkpointStates();
     }
   }
 
@@ -332,8 +377,56 @@ public:
    */
   void advanceTimestep(double dt) override
   {
+    if (is_quasistatic_ && (max_cutbacks_ > 0 || target_nonlinear_iterations_ > 0)) {
+      auto solve = [this](double h) {
+        solveTimestep(h);
+        return nonlin_solver_->nonlinearSolver().GetConverged();
+      };
+      auto abort  = [this]() { abortTimestep(); };
+      auto commit = [this]() { commitTimestep(); };
+
+      if (target_nonlinear_iterations_ > 0) {
+        advanceWithContinuation(dt, solve, abort, commit);
+      } else {
+        advanceWithCutbacks(dt, max_cutbacks_, solve, abort, commit);
+      }
+      return;
+    }
+
+    solveTimestep(dt);
+    commitTimestep();
+  }
+
+  /**
+   * @brief Solve for the temperature at the end of a timestep without completing the step
+   *
+   * Calling this again before commitTimestep() re-solves the same step, e.g. after a coupled physics module has
+   * updated one of the parameter fields. Quasi-static solves restart from the most recent iterate, while transient
+   * solves restart from the temperature at the beginning of the step.
+   *
+   * @param dt The increment of simulation time to advance the underlying heat transfer problem. With adaptive time
+   * stepping, this is an upper bound and the step actually taken may be smaller.
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void solveTimestep(double dt)
+  {
+    bool new_step = !step_in_progress_;
+    if (new_step) {
+      step_in_progress_       = true;
+      step_start_time_        = time_;
+      step_start_temperature_ = temperature_;
+    }
+
+    step_dt_ = dt;
+
     if (is_quasistatic_) {
-      time_ += dt;
+      // re-solves of a step restart from the most recent iterate
+      if (new_step) {
+        predictTemperature(dt);
+      }
+
+      time_ = step_start_time_ + dt;
 
       // Set the ODE time point for the time-varying loads in quasi-static problems
       ode_time_point_ = time_;
@@ -342,31 +435,235 @@ public:
       for (auto& bc : bcs_.essentials()) {
         bc.setDofs(temperature_, time_);
       }
+      freezeResidualArguments(true);
       nonlin_solver_->solve(temperature_);
+      freezeResidualArguments(false);
     } else {
+      time_        = step_start_time_;
+      temperature_ = step_start_temperature_;
+
+      if (explicit_integration_) {
+        if (stable_dt_ == 0.0) {
+          stableTimestep();
+        }
+        SLIC_WARNING_ROOT_IF(step_dt_ > stable_dt_,
+                             axom::fmt::format("Explicit timestep dt = {} exceeds the estimated stable timestep {}",
+                                               step_dt_, stable_dt_));
+      }
+
       // Step the time integrator
       // Note that the ODE solver handles the essential boundary condition application itself
-      ode_.Step(temperature_, time_, dt);
+      ode_.Step(temperature_, time_, step_dt_);
+    }
+  }
+
+  /// @overload
+  double suggestedTimestep(double dt) const override
+  {
+    if (is_quasistatic_) {
+      return dt;
+    }
+    if (explicit_integration_ && stable_dt_ > 0.0) {
+      return std::min(ode_.SuggestedTimestep(dt), stable_dt_);
+    }
+    return ode_.SuggestedTimestep(dt);
+  }
+
+  /**
+   * @brief Estimate the largest stable step of explicit (ForwardEuler, RK2, RK3SSP or RK4) heat transfer
+   *
+   * The largest eigenvalue lambda_max of M_L^{-1} K, with the lumped capacity M_L and the conductance K linearized at
+   * the current temperature, is estimated by power iteration. The stable step is then cfl_number * R / lambda_max,
+   * where R is the extent of the stability region of the method along the negative real axis (2 for ForwardEuler and
+   * RK2, 2.51 for RK3SSP and 2.78 for RK4).
+   *
+   * @return The estimated stable step, which suggestedTimestep() doesn't exceed from then on
+   */
+  double stableTimestep()
+  {
+    SLIC_ERROR_ROOT_IF(!explicit_integration_, "Stable timesteps are only estimated for explicit heat transfer");
+    SLIC_ERROR_ROOT_IF(lumped_capacity_inverse_.Size() == 0,
+                       "completeSetup() must be called prior to stableTimestep()");
+
+    auto K = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(temperature_),
+                                                 temperature_rate_, *parameters_[parameter_indices].state...));
+
+    const auto&  constrained_dofs = bcs_.allEssentialTrueDofs();
+    MPI_Comm     comm             = temperature_.space().GetComm();
+    mfem::Vector x(temperature_.space().TrueVSize()), y(temperature_.space().TrueVSize());
+    x.Randomize(1);
+    x.SetSubVector(constrained_dofs, 0.0);
+
+    double lambda_max = 0.0;
+    for (int i = 0; i < 30; i++) {
+      double norm = mfem::ParNormlp(x, 2, comm);
+      if (norm == 0.0) break;
+      x /= norm;
+      K.Mult(x, y);
+      y *= lumped_capacity_inverse_;
+      y.SetSubVector(constrained_dofs, 0.0);
+      lambda_max = mfem::ParNormlp(y, 2, comm);
+      x          = y;
     }
 
+    // the extent of the stability region of each method along the negative real axis
+    double radius = 2.0;
+    if (ode_.GetTimestepper() == TimestepMethod::RK3SSP) {
+      radius = 2.5127;
+    } else if (ode_.GetTimestepper() == TimestepMethod::RK4) {
+      radius = 2.7853;
+    }
+
+    stable_dt_ = (lambda_max > 0.0) ? cfl_number_ * radius / lambda_max : std::numeric_limits<double>::max();
+    return stable_dt_;
+  }
+
+  /**
+   * @brief Discard the timestep started by solveTimestep(), restoring the temperature and time at its beginning
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void abortTimestep()
+  {
+    SLIC_ERROR_ROOT_IF(!step_in_progress_, "solveTimestep(dt) must be called prior to abortTimestep()");
+    time_             = step_start_time_;
+    temperature_      = step_start_temperature_;
+    step_in_progress_ = false;
+  }
+
+  /**
+   * @brief Complete the timestep started by solveTimestep(), recording the current temperature as its solution
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void commitTimestep()
+  {
+    SLIC_ERROR_ROOT_IF(!step_in_progress_, "solveTimestep(dt) must be called prior to commitTimestep()");
+    step_in_progress_ = false;
+
     cycle_ += 1;
 
-    if (checkpoint_to_disk_) {
-      outputStateToDisk();
-    } else {
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+    bool no_solves = !is_quasistatic_ && explicit_integration_;
+    nonlinear_iterations_.push_back(no_solves ? 0 : nonlin_solver_->nonlinearSolver().GetNumIterations());
+    recordSolverTelemetry(no_solves ? SolverTelemetry{} : nonlin_solver_->telemetry());
+    if (is_quasistatic_ && predictor_ == Predictor::Extrapolation) {
+      recordConvergedState(temperature_);
     }
 
+    checkpointStates();
+
     if (cycle_ > max_cycle_) {
-      timesteps_.push_back(dt);
+      timesteps_.push_back(step_dt_);
       max_cycle_ = cycle_;
       max_time_  = time_;
     }
   }
 
+  /**
+   * @brief Replace the temperature at the beginning of a quasi-static step by the initial guess of its Newton solve
+   *
+   * @param dt The size of the step
+   */
+  void predictTemperature(double dt)
+  {
+    if (predictor_ == Predictor::PreviousState) {
+      return;
+    }
+
+    if (predictor_ == Predictor::Extrapolation) {
+      if (converged_states_.empty()) {
+        recordConvergedState(temperature_);
+      }
+      extrapolateState(time_ + dt, extrapolation_order_, u_predicted_);
+      temperature_ = u_predicted_;
+      return;
+    }
+
+    SLIC_ERROR_ROOT_IF(nonlin_solver_->matrixFree(), "Linearized predictors require an assembled Jacobian");
+
+    // the Jacobian (and the preconditioner built from it) of the last Newton iteration are still held by the linear
+    // solver, unless no matrix has been assembled yet
+    bool reuse_jacobian = predictor_ == Predictor::PreviousJacobian && J_ && J_e_;
+    if (!reuse_jacobian) {
+      auto [r, drdu] = (*residual_)(time_, shape_displacement_, differentiate_wrt(temperature_), temperature_rate_,
+                                    *parameters_[parameter_indices].state...);
+      assemble(drdu, J_);
+      bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
+    }
+
+    // the change in the essential boundary values over the step, and the forces it implies on the other dofs
+    du_ = 0.0;
+    for (auto& bc : bcs_.essentials()) {
+      bc.setDofs(du_, time_ + dt);
+    }
+
+    auto& constrained_dofs = bcs_.allEssentialTrueDofs();
+    for (int i = 0; i < constrained_dofs.Size(); i++) {
+      int j = constrained_dofs[i];
+      du_[j] -= temperature_(j);
+    }
+
+    dr_ = 0.0;
+    mfem::EliminateBC(*J_, *J_e_, constrained_dofs, du_, dr_);
+    for (int i = 0; i < constrained_dofs.Size(); i++) {
+      int j  = constrained_dofs[i];
+      dr_[j] = du_[j];
+    }
+
+    auto& lin_solver = nonlin_solver_->linearSolver();
+    if (!reuse_jacobian) {
+      lin_solver.SetOperator(*J_);
+    }
+
+    lin_solver.Mult(dr_, du_);
+    temperature_ += du_;
+  }
+
+  /**
+   * @brief Get the operator whose root is the temperature at the end of a quasi-static step
+   *
+   * Its action is the residual with the essential rows zeroed, and its gradient is the assembled Jacobian with the
+   * essential rows and columns eliminated, at the current parameter fields. This is valid after solveTimestep().
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  const mfem::Operator& residualOperator() const { return residual_with_bcs_; }
+
+  /**
+   * @brief Assemble the derivative of the residual with respect to a parameter field at the current state
+   *
+   * @param parameter_index The index of the parameter field
+   * @return The assembled derivative, with the rows of the essential temperature dofs zeroed
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  std::unique_ptr<mfem::HypreParMatrix> parameterJacobian(size_t parameter_index)
+  {
+    SLIC_ERROR_ROOT_IF(parameter_index >= sizeof...(parameter_indices),
+                       axom::fmt::format("Invalid parameter index '{}' requested for the Jacobian", parameter_index));
+
+    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_index](ode_time_point_));
+    auto drdparam_mat = assemble(drdparam);
+    drdparam_mat->EliminateRows(bcs_.allEssentialTrueDofs());
+    return drdparam_mat;
+  }
+
+  /**
+   * @brief Subtract a correction from the temperature of the timestep currently being solved
+   *
+   * @param correction The true dof values to subtract from the temperature
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void correctTemperature(const mfem::Vector& correction) { temperature_ -= correction; }
+
+  /**
+   * @brief Get the solver for the residual equations
+   *
+   * @return A reference to the equation solver of this module
+   */
+  EquationSolver& equationSolver() { return *nonlin_solver_; }
+
   /**
    * @brief Functor representing the integrand of a thermal material.  Material type must be
    * a functor as well.
@@ -399,6 +696,35 @@ public:
     MaterialType material_;
   };
 
+  /**
+   * @brief Functor representing the integrand of a thermal material on the coarse levels of multigrid,
+   * where there is no temperature rate
+   */
+  template <typename MaterialType>
+  struct CoarseThermalMaterialIntegrand {
+    /**
+     * @brief Construct a CoarseThermalMaterialIntegrand functor with material model of type `MaterialType`.
+     * @param[in] material A functor representing the material model, as in ThermalMaterialIntegrand
+     */
+    CoarseThermalMaterialIntegrand(MaterialType material) : material_(material) {}
+
+    /**
+     * @brief Evaluate integrand
+     */
+    template <typename X, typename T>
+    auto operator()(double /*time*/, X x, T temperature) const
+    {
+      auto [u, du_dX] = temperature;
+
+      auto [heat_capacity, heat_flux] = material_(x, u, du_dX);
+
+      return serac::tuple{0.0 * u, -1.0 * heat_flux};
+    }
+
+  private:
+    MaterialType material_;
+  };
+
   /**
    * @brief Set the thermal material model for the physics solver
    *
@@ -427,6 +753,20 @@ public:
   {
     residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, NUM_STATE_VARS + active_parameters...>{},
                                  ThermalMaterialIntegrand<MaterialType>(material), mesh_);
+
+    if (multigrid_levels_ || p_multigrid_levels_ || low_order_refined_) {
+      SLIC_ERROR_ROOT_IF(sizeof...(active_parameters) > 0,
+                         "Multigrid and LOR preconditioners do not support materials that depend on parameters");
+    }
+    if (multigrid_levels_) {
+      multigrid_levels_->addDomainIntegral(Dimension<dim>{}, CoarseThermalMaterialIntegrand<MaterialType>(material));
+    }
+    if (p_multigrid_levels_) {
+      p_multigrid_levels_->addDomainIntegral(Dimension<dim>{}, CoarseThermalMaterialIntegrand<MaterialType>(material));
+    }
+    if (low_order_refined_) {
+      low_order_refined_->addDomainIntegral(Dimension<dim>{}, CoarseThermalMaterialIntegrand<MaterialType>(material));
+    }
   }
 
   /// @overload
@@ -482,27 +822,81 @@ public:
   void setSource(DependsOn<active_parameters...>, SourceType source_function,
                  const std::optional<Domain>& optional_domain = std::nullopt)
   {
-    Domain domain = (optional_domain) ? *optional_domain : EntireDomain(mesh_);
+    addSource(*residual_, DependsOn<active_parameters...>{}, source_function,
+              (optional_domain) ? *optional_domain : EntireDomain(mesh_));
+  }
 
-    residual_->AddDomainIntegral(
-        Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-        [source_function](double t, auto x, auto temperature, auto /* dtemp_dt */, auto... params) {
-          // Get the value and the gradient from the input tuple
-          auto [u, du_dX] = temperature;
+  /// @overload
+  template <typename SourceType>
+  void setSource(SourceType source_function, const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    setSource(DependsOn<>{}, source_function, optional_domain);
+  }
 
-          auto source = source_function(x, t, u, du_dX, params...);
+  /**
+   * @brief Set a thermal source that the implicit-explicit timestep methods (IMEXEuler and IMEXRK2) treat explicitly,
+   * e.g. a nonlinear but non-stiff reaction or radiation-like term
+   *
+   * The rest of the residual (e.g. linear conduction) is treated implicitly, so the steps of a linear conductor only
+   * need linear solves, whose Jacobian can be reused while the step size is unchanged (see
+   * TimesteppingOptions::reuse_linear_jacobian). Other timestep methods treat this source like setSource() does.
+   *
+   * @see setSource() for the arguments
+   */
+  template <int... active_parameters, typename SourceType>
+  void setExplicitSource(DependsOn<active_parameters...>, SourceType source_function,
+                         const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    addSource(explicit_terms_ ? *explicit_terms_ : *residual_, DependsOn<active_parameters...>{}, source_function,
+              (optional_domain) ? *optional_domain : EntireDomain(mesh_));
+  }
 
-          // Return the source and the flux as a tuple
-          return serac::tuple{-1.0 * source, serac::zero{}};
+  /// @overload
+  template <typename SourceType>
+  void setExplicitSource(SourceType source_function, const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    setExplicitSource(DependsOn<>{}, source_function, optional_domain);
+  }
+
+  /**
+   * @brief Add a separable thermal source f(x) g(t), which doesn't depend on the temperature, so that it is only
+   * integrated once while the parameters it depends on (and the shape displacement) don't change, and then scaled
+   * by g(t) in each residual evaluation, see Functional::AddSeparableDomainIntegral()
+   *
+   * @tparam SourceType The type of the source function
+   * @param source_function f, the distribution of the source
+   * @param time_scale g, the time function of the source
+   * @param optional_domain The domain over which the source is applied. If nothing is supplied the entire domain is
+   * used.
+   *
+   * @pre source_function must be a object that can be called with the following arguments:
+   *    1. `tensor<T,dim> x` the spatial coordinates for the quadrature point
+   *    2. `tuple{value, derivative}`, a variadic list of tuples (each with a values and derivative),
+   *            one tuple for each of the trial spaces specified in the `DependsOn<...>` argument.
+   *
+   * @note This method must be called prior to completeSetup()
+   */
+  template <int... active_parameters, typename SourceType>
+  void addSeparableSource(DependsOn<active_parameters...>, SourceType source_function,
+                          std::function<double(double)> time_scale,
+                          const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    Domain domain = (optional_domain) ? *optional_domain : EntireDomain(mesh_);
+
+    residual_->AddSeparableDomainIntegral(
+        Dimension<dim>{}, DependsOn<active_parameters + NUM_STATE_VARS...>{},
+        [source_function](double /* t */, auto x, auto... params) {
+          return serac::tuple{-1.0 * source_function(x, params...), serac::zero{}};
         },
-        domain);
+        std::move(time_scale), domain);
   }
 
   /// @overload
   template <typename SourceType>
-  void setSource(SourceType source_function, const std::optional<Domain>& optional_domain = std::nullopt)
+  void addSeparableSource(SourceType source_function, std::function<double(double)> time_scale,
+                          const std::optional<Domain>& optional_domain = std::nullopt)
   {
-    setSource(DependsOn<>{}, source_function, optional_domain);
+    addSeparableSource(DependsOn<>{}, source_function, std::move(time_scale), optional_domain);
   }
 
   /**
@@ -532,17 +926,8 @@ public:
   void setFluxBCs(DependsOn<active_parameters...>, FluxType flux_function,
                   const std::optional<Domain>& optional_domain = std::nullopt)
   {
-    Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
-
-    residual_->AddBoundaryIntegral(
-        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-        [flux_function](double t, auto X, auto u, auto /* dtemp_dt */, auto... params) {
-          auto temp = get<VALUE>(u);
-          auto n    = cross(get<DERIVATIVE>(X));
-
-          return flux_function(X, normalize(n), t, temp, params...);
-        },
-        domain);
+    addFlux(*residual_, DependsOn<active_parameters...>{}, flux_function,
+            (optional_domain) ? *optional_domain : EntireBoundary(mesh_));
   }
 
   /// @overload
@@ -552,6 +937,27 @@ public:
     setFluxBCs(DependsOn<>{}, flux_function, optional_domain);
   }
 
+  /**
+   * @brief Set a thermal flux boundary condition that the implicit-explicit timestep methods treat explicitly, see
+   * setExplicitSource()
+   *
+   * @see setFluxBCs() for the arguments
+   */
+  template <int... active_parameters, typename FluxType>
+  void setExplicitFluxBCs(DependsOn<active_parameters...>, FluxType flux_function,
+                          const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    addFlux(explicit_terms_ ? *explicit_terms_ : *residual_, DependsOn<active_parameters...>{}, flux_function,
+            (optional_domain) ? *optional_domain : EntireBoundary(mesh_));
+  }
+
+  /// @overload
+  template <typename FluxType>
+  void setExplicitFluxBCs(FluxType flux_function, const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    setExplicitFluxBCs(DependsOn<>{}, flux_function, optional_domain);
+  }
+
   /**
    * @brief Set the underlying finite element state to a prescribed shape displacement
    *
@@ -616,7 +1022,7 @@ public:
     if (state_name == "temperature") {
       temperature_ = state;
       if (!checkpoint_to_disk_) {
-        checkpoint_states_["temperature"][static_cast<size_t>(cycle_)] = temperature_;
+        updateCheckpointedState("temperature", temperature_);
       }
       return;
     }
@@ -703,21 +1109,47 @@ public:
           temperature_.space().TrueVSize(),
 
           [this](const mfem::Vector& u, mfem::Vector& r) {
-            const mfem::Vector res = (*residual_)(ode_time_point_, shape_displacement_, u, temperature_rate_,
-                                                  *parameters_[parameter_indices].state...);
-
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
+            // this is evaluated before the first Newton iteration decides whether to assemble J
+            bool current = nonlin_solver_->linear() && J_ && jacobian_dt_ == 0.0;
+            nonlin_solver_->setJacobianCurrent(current);
+
+            // when the Jacobian is about to be assembled at u, the q-function derivatives are computed along with the
+            // residual, rather than by evaluating the q-functions again in the gradient
+            if (nonlin_solver_->jacobianExpected() && !current) {
+              auto [value, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u),
+                                                temperature_rate_, *parameters_[parameter_indices].state...);
+              // copied into the memory of r, see below
+              r = value;
+              setLinearizationPoint(u);
+            } else {
+              // the residual is written directly into r (rather than assigned to it), which keeps the memory that
+              // the sundials solvers track, see https://github.com/mfem/mfem/issues/3531
+              residual_->evaluateInto(r, ode_time_point_, shape_displacement_, u, temperature_rate_,
+                                      *parameters_[parameter_indices].state...);
+              clearLinearizationPoint();
+            }
             r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
           },
 
           [this](const mfem::Vector& u) -> mfem::Operator& {
-            auto [r, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), temperature_rate_,
-                                          *parameters_[parameter_indices].state...);
-            J_             = assemble(drdu);
-            J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            // the derivatives at u may already have been computed by the residual evaluation
+            if (!takeLinearizationPoint(u)) {
+              (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), temperature_rate_,
+                           *parameters_[parameter_indices].state...);
+            }
+            auto& drdu = residual_->gradient(1);  // the temperature, after the shape displacement
+
+            // a matrix-free linear solver (and its preconditioner) only needs the action of the unassembled gradient
+            // (and its diagonal, for preconditioning), with the essential dofs constrained
+            if (nonlin_solver_->matrixFree()) {
+              J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+              jacobian_dt_   = -1.0;
+              return *J_matrix_free_;
+            }
+
+            assemble(drdu, J_);
+            bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
+            jacobian_dt_ = 0.0;
             return *J_;
           });
     } else {
@@ -725,14 +1157,18 @@ public:
           temperature_.space().TrueVSize(),
 
           [this](const mfem::Vector& du_dt, mfem::Vector& r) {
-            add(1.0, u_, dt_, du_dt, u_predicted_);
-            const mfem::Vector res = (*residual_)(ode_time_point_, shape_displacement_, u_predicted_, du_dt,
-                                                  *parameters_[parameter_indices].state...);
+            // this is evaluated before the first Newton iteration decides whether to assemble J
+            nonlin_solver_->setJacobianCurrent((reuse_linear_jacobian_ || nonlin_solver_->linear()) && J_ &&
+                                               jacobian_dt_ == ode_.GetImplicitCoefficient());
 
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
+            add(1.0, u_, dt_, du_dt, u_predicted_);
+            // the residual is written directly into r (rather than assigned to it), which keeps the memory that
+            // the sundials solvers track, see https://github.com/mfem/mfem/issues/3531
+            residual_->evaluateInto(r, ode_time_point_, shape_displacement_, u_predicted_, du_dt,
+                                    *parameters_[parameter_indices].state...);
+            if (const mfem::Vector* load = ode_.GetIMEXLoad()) {
+              r += *load;
+            }
             r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
           },
 
@@ -752,22 +1188,54 @@ public:
             std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
 
             // J := M + dt K
-            J_.reset(mfem::Add(1.0, *m_mat, dt_, *k_mat));
-            J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            refillOrReplace(J_, std::unique_ptr<mfem::HypreParMatrix>(mfem::Add(1.0, *m_mat, dt_, *k_mat)));
+            bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
+            jacobian_dt_ = dt_;
 
             return *J_;
           });
     }
 
-    if (checkpoint_to_disk_) {
-      outputStateToDisk();
-    } else {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+    // argument 1 of the residual is the temperature, after the shape displacement
+    if (is_quasistatic_ || !explicit_integration_) {
+      auto linearize = [this]() -> mfem::Operator& {
+        (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(temperature_), temperature_rate_,
+                     *parameters_[parameter_indices].state...);
+        return residual_->gradient(1);
+      };
+      selectJacobianPolicy(*residual_, 1, *nonlin_solver_, linearize, is_quasistatic_ && nonlin_solver_->matrixFree());
+    }
+
+    if (multigrid_levels_) {
+      multigrid_levels_->setup(*multigrid_, temperature_.space(), bcs_);
+    }
+    if (p_multigrid_levels_) {
+      p_multigrid_levels_->setup(*multigrid_, temperature_.space(), bcs_);
+    }
+    if (low_order_refined_) {
+      low_order_refined_->setup(*lor_preconditioner_, bcs_.allEssentialTrueDofs());
+    }
+
+    if (!is_quasistatic_ && explicit_integration_) {
+      computeLumpedCapacity();
+      ode_.SetExplicitRate([this](const mfem::Vector& u, mfem::Vector& du_dt) { explicitRate(u, du_dt); });
+    }
+
+    if (explicit_terms_) {
+      zero_rate_.SetSize(temperature_.space().TrueVSize());
+      zero_rate_ = 0.0;
+      ode_.SetIMEXTerms(
+          [this](double t, const mfem::Vector& u, mfem::Vector& r) {
+            residual_->evaluateInto(r, t, shape_displacement_, u, zero_rate_, *parameters_[parameter_indices].state...);
+          },
+          [this](double t, const mfem::Vector& u, mfem::Vector& r) {
+            explicit_terms_->evaluateInto(r, t, shape_displacement_, u, zero_rate_,
+                                          *parameters_[parameter_indices].state...);
+          });
     }
+
+    clearCheckpointedStates();
+    checkpointStates();
   }
 
   /**
@@ -836,90 +1304,9 @@ public:
    */
   void reverseAdjointTimestep() override
   {
-    auto& lin_solver = nonlin_solver_->linearSolver();
-
-    mfem::HypreParVector adjoint_essential(temperature_adjoint_load_);
-    adjoint_essential = 0.0;
-
-    if (is_quasistatic_) {
-      // We store the previous timestep's temperature as the current temperature for use in the lambdas computing the
-      // sensitivities.
-
-      auto [_, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(temperature_),
-                                    temperature_rate_, *parameters_[parameter_indices].state...);
-      auto jacobian  = assemble(drdu);
-      auto J_T       = std::unique_ptr<mfem::HypreParMatrix>(jacobian->Transpose());
-
-      for (const auto& bc : bcs_.essentials()) {
-        bc.apply(*J_T, temperature_adjoint_load_, adjoint_essential);
-      }
-
-      lin_solver.SetOperator(*J_T);
-      lin_solver.Mult(temperature_adjoint_load_, adjoint_temperature_);
-
-      return;
-    }
-
-    SLIC_ERROR_ROOT_IF(ode_.GetTimestepper() != TimestepMethod::BackwardEuler,
-                       "Only backward Euler implemented for transient adjoint heat conduction.");
-
-    SLIC_ERROR_ROOT_IF(cycle_ <= min_cycle_,
-                       "Maximum number of adjoint timesteps exceeded! The number of adjoint timesteps must equal the "
-                       "number of forward timesteps");
-
-    // Load the temperature from the previous cycle from disk
-    serac::FiniteElementState temperature_n_minus_1(temperature_);
-
-    {
-      auto previous_states_n         = getCheckpointedStates(cycle_);
-      auto previous_states_n_minus_1 = getCheckpointedStates(cycle_ - 1);
-
-      temperature_          = previous_states_n.at("temperature");
-      temperature_rate_     = previous_states_n.at("temperature_rate");
-      temperature_n_minus_1 = previous_states_n_minus_1.at("temperature");
-    }
-
-    double dt = getCheckpointedTimestep(cycle_ - 1);
-
-    // K := dR/du
-    auto K = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(temperature_),
-                                                 temperature_rate_, *parameters_[parameter_indices].state...));
-    std::unique_ptr<mfem::HypreParMatrix> k_mat(assemble(K));
-
-    // M := dR/du_dot
-    auto M = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, temperature_,
-                                                 differentiate_wrt(temperature_rate_),
-                                                 *parameters_[parameter_indices].state...));
-    std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
-
-    J_.reset(mfem::Add(1.0, *m_mat, dt, *k_mat));
-    auto J_T = std::unique_ptr<mfem::HypreParMatrix>(J_->Transpose());
-
-    // recall that temperature_adjoint_load_vector and d_temperature_dt_adjoint_load_vector were already multiplied by
-    // -1 above
-    mfem::HypreParVector modified_RHS(temperature_adjoint_load_);
-    modified_RHS *= dt;
-    modified_RHS.Add(1.0, temperature_rate_adjoint_load_);
-    modified_RHS.Add(-dt, implicit_sensitivity_temperature_start_of_step_);
-
-    for (const auto& bc : bcs_.essentials()) {
-      bc.apply(*J_T, modified_RHS, adjoint_essential);
-    }
-
-    lin_solver.SetOperator(*J_T);
-    lin_solver.Mult(modified_RHS, adjoint_temperature_);
-
-    // This multiply is technically on M transposed.  However, this matrix should be symmetric unless
-    // the thermal capacity is a function of the temperature rate of change, which is thermodynamically
-    // impossible, and fortunately not possible with our material interface.
-    // Not doing the transpose here to avoid doing unnecessary work.
-    m_mat->Mult(adjoint_temperature_, implicit_sensitivity_temperature_start_of_step_);
-    implicit_sensitivity_temperature_start_of_step_ *= -1.0 / dt;
-    implicit_sensitivity_temperature_start_of_step_.Add(1.0 / dt,
-                                                        temperature_rate_adjoint_load_);  // already multiplied by -1
-
-    time_ -= dt;
-    cycle_--;
+    prepareAdjointTimestep();
+    solveAdjointTimestep();
+    finishAdjointTimestep();
   }
 
   /**
@@ -931,21 +1318,32 @@ public:
    */
   std::unordered_map<std::string, FiniteElementState> getCheckpointedStates(int cycle_to_load) const override
   {
-    std::unordered_map<std::string, FiniteElementState> previous_states;
-
     if (checkpoint_to_disk_) {
+      std::unordered_map<std::string, FiniteElementState> previous_states;
       previous_states.emplace("temperature", temperature_);
       previous_states.emplace("temperature_rate", temperature_rate_);
       StateManager::loadCheckpointedStates(cycle_to_load,
                                            {previous_states.at("temperature"), previous_states.at("temperature_rate")});
       return previous_states;
-    } else {
-      previous_states.emplace("temperature", checkpoint_states_.at("temperature")[static_cast<size_t>(cycle_to_load)]);
-      previous_states.emplace("temperature_rate",
-                              checkpoint_states_.at("temperature_rate")[static_cast<size_t>(cycle_to_load)]);
     }
 
-    return previous_states;
+    return checkpointedStatesInMemory(cycle_to_load);
+  }
+
+  /// @overload
+  void restoreCheckpoint(const std::unordered_map<std::string, FiniteElementState>& states) override
+  {
+    temperature_      = states.at("temperature");
+    temperature_rate_ = states.at("temperature_rate");
+    ode_.Restart();
+  }
+
+  /// @overload
+  void recomputeTimestep(double dt) override
+  {
+    double dt_taken = dt;
+    ode_.Step(temperature_, time_, dt_taken);
+    SLIC_ERROR_ROOT_IF(dt_taken != dt, "Recomputing checkpoints is not supported with adaptive time stepping");
   }
 
   /**
@@ -961,10 +1359,9 @@ public:
   {
     // TODO: the time is likely not being handled correctly on the reverse pass, but we don't
     //       have tests to confirm.
-    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](ode_time_point_));
-    auto drdparam_mat = assemble(drdparam);
+    auto drdparam = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](ode_time_point_));
 
-    drdparam_mat->MultTranspose(adjoint_temperature_, *parameters_[parameter_field].sensitivity);
+    drdparam.MultTranspose(adjoint_temperature_, *parameters_[parameter_field].sensitivity);
 
     return *parameters_[parameter_field].sensitivity;
   }
@@ -983,9 +1380,7 @@ public:
         serac::get<DERIVATIVE>((*residual_)(ode_time_point_, differentiate_wrt(shape_displacement_), temperature_,
                                             temperature_rate_, *parameters_[parameter_indices].state...));
 
-    auto drdshape_mat = assemble(drdshape);
-
-    drdshape_mat->MultTranspose(adjoint_temperature_, *shape_displacement_sensitivity_);
+    drdshape.MultTranspose(adjoint_temperature_, *shape_displacement_sensitivity_);
 
     return *shape_displacement_sensitivity_;
   }
@@ -1002,10 +1397,277 @@ public:
     return {{"temperature", implicit_sensitivity_temperature_start_of_step_}};
   }
 
+  /// @copydoc BasePhysics::memoryUsage()
+  memory::Usage memoryUsage() const override
+  {
+    memory::Usage usage = BasePhysics::memoryUsage();
+    memory::add(usage, "residual", residual_->memoryUsage());
+    if (explicit_terms_) {
+      memory::add(usage, "explicit_terms", explicit_terms_->memoryUsage());
+    }
+
+    for (const auto* matrix : {M_.get(), J_.get(), J_T_.get(), k_adjoint_.get(), m_adjoint_.get()}) {
+      if (matrix) {
+        usage["matrices"] += memory::bytes(*matrix);
+      }
+    }
+    usage["eliminated_entries"] = J_e_.bytes() + J_T_e_.bytes();
+    return usage;
+  }
+
+  /// @copydoc BasePhysics::plan()
+  RunPlan plan(int num_cycles, const CostModel& model = {}) const override
+  {
+    RunPlan run_plan = BasePhysics::plan(num_cycles, model);
+
+    // argument 1 of the residual is the temperature, after the shape displacement
+    planResidual(run_plan, num_cycles, model, *residual_, 1);
+    return run_plan;
+  }
+
   /// Destroy the Thermal Solver object
   virtual ~HeatTransfer() = default;
 
 protected:
+  /**
+   * @brief freeze (or unfreeze) every argument of the residual other than the temperature, which is the only one
+   * that changes during the Newton iterations of a quasi-static solve, see Functional::freezeArgument()
+   */
+  void freezeResidualArguments(bool frozen)
+  {
+    residual_->freezeArgument(0, frozen);  // the shape displacement
+    for (uint32_t i = 2; i < NUM_STATE_VARS + 1 + sizeof...(parameter_space); i++) {
+      residual_->freezeArgument(i, frozen);
+    }
+  }
+
+  /// @brief add the domain integral of a source to @a residual, see setSource()
+  template <typename Residual, int... active_parameters, typename SourceType>
+  void addSource(Residual& residual, DependsOn<active_parameters...>, SourceType source_function, const Domain& domain)
+  {
+    residual.AddDomainIntegral(
+        Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+        [source_function](double t, auto x, auto temperature, auto /* dtemp_dt */, auto... params) {
+          // Get the value and the gradient from the input tuple
+          auto [u, du_dX] = temperature;
+
+          auto source = source_function(x, t, u, du_dX, params...);
+
+          // Return the source and the flux as a tuple
+          return serac::tuple{-1.0 * source, serac::zero{}};
+        },
+        domain);
+  }
+
+  /// @brief add the boundary integral of a flux to @a residual, see setFluxBCs()
+  template <typename Residual, int... active_parameters, typename FluxType>
+  void addFlux(Residual& residual, DependsOn<active_parameters...>, FluxType flux_function, const Domain& domain)
+  {
+    residual.AddBoundaryIntegral(
+        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+        [flux_function](double t, auto X, auto u, auto /* dtemp_dt */, auto... params) {
+          auto temp = get<VALUE>(u);
+          auto n    = cross(get<DERIVATIVE>(X));
+
+          return flux_function(X, normalize(n), t, temp, params...);
+        },
+        domain);
+  }
+
+  /**
+   * @brief Compute the lumped capacity of explicit heat transfer, once, at the current temperature
+   *
+   * The residual is linear in the temperature rate, so its derivative with respect to the rate is the consistent
+   * capacity matrix. Linear elements use its row sums, and higher order ones its HRZ lumping, since row-sum lumping
+   * can give them non-positive capacities.
+   */
+  void computeLumpedCapacity()
+  {
+    auto M = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, temperature_,
+                                                 differentiate_wrt(temperature_rate_),
+                                                 *parameters_[parameter_indices].state...));
+    lumped_capacity_inverse_ = M.lumpedDiagonal(order == 1 ? LumpingMethod::RowSum : LumpingMethod::HRZ);
+
+    double* m = lumped_capacity_inverse_.HostReadWrite();
+    for (int i = 0; i < lumped_capacity_inverse_.Size(); i++) {
+      SLIC_ERROR_ROOT_IF(m[i] <= 0.0, "Lumping the capacity matrix produced a non-positive capacity");
+      m[i] = 1.0 / m[i];
+    }
+
+    zero_rate_.SetSize(temperature_.space().TrueVSize());
+    zero_rate_ = 0.0;
+    explicit_residual_.SetSize(temperature_.space().TrueVSize());
+    stable_dt_ = 0.0;
+  }
+
+  /**
+   * @brief Compute the rates M_L du_dt = -r(u, 0) of the unconstrained dofs, for each stage of the explicit methods
+   *
+   * With the capacity lumped, this is one residual evaluation and a diagonal scale, with no linear solves. The rates
+   * of the constrained dofs come from their boundary conditions, and are kept.
+   *
+   * @param u The temperature of the stage
+   * @param du_dt The rates of the temperature
+   */
+  void explicitRate(const mfem::Vector& u, mfem::Vector& du_dt)
+  {
+    const auto& constrained_dofs = bcs_.allEssentialTrueDofs();
+    du_dt.GetSubVector(constrained_dofs, essential_rates_);
+
+    residual_->evaluateInto(explicit_residual_, ode_time_point_, shape_displacement_, u, zero_rate_,
+                            *parameters_[parameter_indices].state...);
+    du_dt = explicit_residual_;
+    du_dt *= lumped_capacity_inverse_;
+    du_dt.Neg();
+    du_dt.SetSubVector(constrained_dofs, essential_rates_);
+  }
+
+  /// @overload
+  void prepareAdjointTimestep() override
+  {
+    auto& lin_solver = nonlin_solver_->linearSolver();
+
+    // the adjoint operator is assembled, and transposed gradients need the stored derivatives
+    if (jacobian_policy_ == JacobianPolicy::RecomputedDerivatives) {
+      residual_->recomputeDerivatives(false);
+      jacobian_policy_ = JacobianPolicy::StoredDerivatives;
+    }
+
+    if (is_quasistatic_) {
+      // We store the previous timestep's temperature as the current temperature for use in the lambdas computing the
+      // sensitivities.
+
+      auto [_, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(temperature_),
+                                    temperature_rate_, *parameters_[parameter_indices].state...);
+
+      // a self-adjoint problem reuses the storage of the forward Jacobian (and so its preconditioner setup),
+      // otherwise the transpose is kept (and refilled) across the reverse timesteps
+      auto& J_adjoint   = self_adjoint_ ? J_ : J_T_;
+      auto& J_adjoint_e = self_adjoint_ ? J_e_ : J_T_e_;
+      assembleAdjointOperator(drdu, J_adjoint);
+      bcs_.eliminateAllEssentialDofsFromMatrix(*J_adjoint, J_adjoint_e);
+
+      // the preconditioner no longer corresponds to the forward Jacobian
+      lin_solver.SetOperator(*J_adjoint);
+      jacobian_dt_ = -1.0;
+      return;
+    }
+
+    SLIC_ERROR_ROOT_IF(ode_.GetTimestepper() != TimestepMethod::BackwardEuler,
+                       "Only backward Euler implemented for transient adjoint heat conduction.");
+
+    SLIC_ERROR_ROOT_IF(cycle_ <= min_cycle_,
+                       "Maximum number of adjoint timesteps exceeded! The number of adjoint timesteps must equal the "
+                       "number of forward timesteps");
+
+    // Load the temperature from the previous cycle from disk
+    serac::FiniteElementState temperature_n_minus_1(temperature_);
+
+    recomputeCheckpointedStates(cycle_ - 1);
+    recomputeCheckpointedStates(cycle_);
+
+    {
+      auto previous_states_n         = getCheckpointedStates(cycle_);
+      auto previous_states_n_minus_1 = getCheckpointedStates(cycle_ - 1);
+
+      temperature_          = previous_states_n.at("temperature");
+      temperature_rate_     = previous_states_n.at("temperature_rate");
+      temperature_n_minus_1 = previous_states_n_minus_1.at("temperature");
+    }
+
+    double dt = getCheckpointedTimestep(cycle_ - 1);
+
+    // K^T := (dR/du)^T
+    auto K = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(temperature_),
+                                                 temperature_rate_, *parameters_[parameter_indices].state...));
+    assembleAdjointOperator(K, k_adjoint_);
+
+    // M^T := (dR/du_dot)^T
+    auto M = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, temperature_,
+                                                 differentiate_wrt(temperature_rate_),
+                                                 *parameters_[parameter_indices].state...));
+    assembleAdjointOperator(M, m_adjoint_);
+
+    J_T_.reset(mfem::Add(1.0, *m_adjoint_, dt, *k_adjoint_));
+    bcs_.eliminateAllEssentialDofsFromMatrix(*J_T_, J_T_e_);
+
+    // the preconditioner no longer corresponds to J_, so a recomputed forward step has to assemble it again
+    lin_solver.SetOperator(*J_T_);
+    jacobian_dt_ = -1.0;
+  }
+
+  /// @overload
+  void solveAdjointTimestep() override
+  {
+    auto& lin_solver = nonlin_solver_->linearSolver();
+
+    mfem::HypreParVector adjoint_essential(temperature_adjoint_load_);
+    adjoint_essential = 0.0;
+
+    if (is_quasistatic_) {
+      auto& J_adjoint   = self_adjoint_ ? J_ : J_T_;
+      auto& J_adjoint_e = self_adjoint_ ? J_e_ : J_T_e_;
+      mfem::EliminateBC(*J_adjoint, *J_adjoint_e, bcs_.allEssentialTrueDofs(), adjoint_essential,
+                        temperature_adjoint_load_);
+
+      lin_solver.Mult(temperature_adjoint_load_, adjoint_temperature_);
+      return;
+    }
+
+    double dt = getCheckpointedTimestep(cycle_ - 1);
+
+    // recall that temperature_adjoint_load_vector and d_temperature_dt_adjoint_load_vector were already multiplied by
+    // -1 above
+    mfem::HypreParVector modified_RHS(temperature_adjoint_load_);
+    modified_RHS *= dt;
+    modified_RHS.Add(1.0, temperature_rate_adjoint_load_);
+    modified_RHS.Add(-dt, implicit_sensitivity_temperature_start_of_step_);
+
+    mfem::EliminateBC(*J_T_, *J_T_e_, bcs_.allEssentialTrueDofs(), adjoint_essential, modified_RHS);
+
+    lin_solver.Mult(modified_RHS, adjoint_temperature_);
+
+    m_adjoint_->Mult(adjoint_temperature_, implicit_sensitivity_temperature_start_of_step_);
+    implicit_sensitivity_temperature_start_of_step_ *= -1.0 / dt;
+    implicit_sensitivity_temperature_start_of_step_.Add(1.0 / dt,
+                                                        temperature_rate_adjoint_load_);  // already multiplied by -1
+  }
+
+  /// @overload
+  void finishAdjointTimestep() override
+  {
+    if (is_quasistatic_) {
+      return;
+    }
+
+    time_ -= getCheckpointedTimestep(cycle_ - 1);
+    cycle_--;
+  }
+
+  /// @overload
+  std::vector<FiniteElementVector*> adjointTimestepStates() override
+  {
+    return {&adjoint_temperature_, &implicit_sensitivity_temperature_start_of_step_};
+  }
+
+  /// @overload
+  void computeBatchedTimestepSensitivities(std::vector<TimestepSensitivities>& sensitivities) override
+  {
+    for (size_t i = 0; i < sizeof...(parameter_indices); i++) {
+      auto drdparam = serac::get<DERIVATIVE>(d_residual_d_[i](ode_time_point_));
+      for (size_t q = 0; q < sensitivities.size(); q++) {
+        drdparam.MultTranspose(batchedAdjointSolution(q), sensitivities[q].parameters[i]);
+      }
+    }
+
+    auto drdshape =
+        serac::get<DERIVATIVE>((*residual_)(ode_time_point_, differentiate_wrt(shape_displacement_), temperature_,
+                                            temperature_rate_, *parameters_[parameter_indices].state...));
+    for (size_t q = 0; q < sensitivities.size(); q++) {
+      drdshape.MultTranspose(batchedAdjointSolution(q), sensitivities[q].shape);
+    }
+  }
+
   /// The compile-time finite element trial space for heat transfer (H1 of order p)
   using scalar_trial = H1<order>;
 
@@ -1036,6 +1698,10 @@ protected:
   /// serac::Functional that is used to calculate the residual and its derivatives
   std::unique_ptr<ShapeAwareFunctional<shape_trial, test(scalar_trial, scalar_trial, parameter_space...)>> residual_;
 
+  /// @brief the terms of the residual that the implicit-explicit methods treat explicitly, see setExplicitSource()
+  std::unique_ptr<ShapeAwareFunctional<shape_trial, test(scalar_trial, scalar_trial, parameter_space...)>>
+      explicit_terms_;
+
   /// Assembled mass matrix
   std::unique_ptr<mfem::HypreParMatrix> M_;
 
@@ -1063,7 +1729,38 @@ protected:
 
   /// rows and columns of J_ that have been separated out
   /// because are associated with essential boundary conditions
-  std::unique_ptr<mfem::HypreParMatrix> J_e_;
+  EliminatedEntries J_e_;
+
+  /// @brief the operator of the adjoint solves: the transpose of J_ for quasi-static problems (unless the problem is
+  /// self-adjoint), or of the Newmark Jacobian for transient ones
+  std::unique_ptr<mfem::HypreParMatrix> J_T_;
+
+  /// @brief rows and columns of J_T_ that have been separated out because of essential boundary conditions
+  EliminatedEntries J_T_e_;
+
+  /// @brief the transpose of dR/du, used by the transient adjoint solves
+  std::unique_ptr<mfem::HypreParMatrix> k_adjoint_;
+
+  /// @brief the transpose of dR/du_dot, used by the transient adjoint solves
+  std::unique_ptr<mfem::HypreParMatrix> m_adjoint_;
+
+  /// @brief the unassembled Jacobian with essential dofs constrained, used when the linear solver is matrix-free
+  std::unique_ptr<mfem::ConstrainedOperator> J_matrix_free_;
+
+  /// @brief The geometric multigrid or p-multigrid preconditioner of the linear solver, if it is used
+  GeometricMultigridPreconditioner* multigrid_ = nullptr;
+
+  /// @brief The residuals on the coarse levels of the geometric multigrid preconditioner
+  std::unique_ptr<MultigridLevels<H1<order>>> multigrid_levels_;
+
+  /// @brief The residuals on the lower order levels of the p-multigrid preconditioner
+  std::unique_ptr<PMultigridLevels<order>> p_multigrid_levels_;
+
+  /// @brief The LOR preconditioner of the linear solver, if it is used
+  LORPreconditioner* lor_preconditioner_ = nullptr;
+
+  /// @brief The residual on the low-order refined discretization of the LOR preconditioner
+  std::unique_ptr<LowOrderRefined<>> low_order_refined_;
 
   /// The current timestep
   double dt_;
@@ -1071,12 +1768,69 @@ protected:
   /// The previous timestep
   double previous_dt_;
 
+  /// Whether J_ may be reused while dt is unchanged, see TimesteppingOptions::reuse_linear_jacobian
+  bool reuse_linear_jacobian_ = false;
+
+  /**
+   * @brief The timestep that J_ = M + dt K (and its preconditioner) was last assembled for, 0 for the J_ = K of
+   * quasi-static solves, or -1 if it is out of date
+   */
+  double jacobian_dt_ = -1.0;
+
+  /// Whether solveTimestep() has been called since the last committed timestep
+  bool step_in_progress_ = false;
+
+  /// The size of the timestep currently being solved
+  double step_dt_ = 0.0;
+
+  /// The simulation time at the beginning of the timestep currently being solved
+  double step_start_time_ = 0.0;
+
+  /// The temperature true dofs at the beginning of the timestep currently being solved
+  mfem::Vector step_start_temperature_;
+
   /// Predicted temperature true dofs
   mfem::Vector u_;
 
   /// Predicted temperature true dofs
   mfem::Vector u_predicted_;
 
+  /// The change in the temperature true dofs computed by the linearized predictors
+  mfem::Vector du_;
+
+  /// The right hand side of the linearized predictors
+  mfem::Vector dr_;
+
+  /// The initial guess for the Newton solve of each quasi-static step
+  Predictor predictor_ = Predictor::PreviousState;
+
+  /// The degree of the polynomial used by Predictor::Extrapolation
+  int extrapolation_order_ = 2;
+
+  /// Whether transient steps are taken with a lumped capacity, i.e. for ForwardEuler, RK2, RK3SSP and RK4
+  bool explicit_integration_ = false;
+
+  /// Whether transient steps treat the explicit sources and fluxes explicitly, i.e. for IMEXEuler and IMEXRK2
+  bool imex_integration_ = false;
+
+  /// The fraction of the estimated stable timestep suggested for explicit heat transfer
+  double cfl_number_ = 0.9;
+
+  /// The estimated stable timestep of explicit heat transfer (0 until it is estimated), see stableTimestep()
+  double stable_dt_ = 0.0;
+
+  /// The inverse of the lumped capacity matrix of explicit heat transfer
+  mfem::Vector lumped_capacity_inverse_;
+
+  /// The temperature rate of zero that the rates of explicit heat transfer (and the IMEX terms) are computed from
+  mfem::Vector zero_rate_;
+
+  /// The residual of each stage of explicit heat transfer
+  mfem::Vector explicit_residual_;
+
+  /// The rates of the constrained dofs of each stage of explicit heat transfer
+  mfem::Vector essential_rates_;
+
   /// @brief Array functions computing the derivative of the residual with respect to each given parameter
   /// @note This is needed so the user can ask for a specific sensitivity at runtime as opposed to it being a
   /// template parameter.
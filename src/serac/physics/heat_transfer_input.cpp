@@ -26,6 +26,11 @@ void HeatTransferInputOptions::defineInputFileSchema(axom::inlet::Container& con
   auto& dynamics_container = container.addStruct("dynamics", "Parameters for mass matrix inversion");
   dynamics_container.addString("timestepper", "Timestepper (ODE) method to use");
   dynamics_container.addString("enforcement_method", "Time-varying constraint enforcement method to use");
+  dynamics_container.addBool("adaptive", "Whether to choose step sizes by local error control");
+  dynamics_container.addDouble("error_relative_tol", "Relative tolerance on the local error of adaptive steps");
+  dynamics_container.addDouble("error_absolute_tol", "Absolute tolerance on the local error of adaptive steps");
+  dynamics_container.addDouble("min_dt", "Smallest step size of adaptive time stepping");
+  dynamics_container.addDouble("max_dt", "Largest step size of adaptive time stepping");
 
   auto& bc_container = container.addStructDictionary("boundary_conds", "Container of boundary conditions");
   input::BoundaryConditionInputOptions::defineInputFileSchema(bc_container);
@@ -70,6 +75,18 @@ serac::HeatTransferInputOptions FromInlet<serac::HeatTransferInputOptions>::oper
                        "Unrecognized enforcement method: " << enforcement_method);
     timestepping_options.enforcement_method = enforcement_methods.at(enforcement_method);
 
+    if (dynamics.contains("adaptive")) {
+      timestepping_options.adaptive = dynamics["adaptive"];
+    }
+    for (auto [name, value] : {std::pair{"error_relative_tol", &timestepping_options.error_relative_tol},
+                               std::pair{"error_absolute_tol", &timestepping_options.error_absolute_tol},
+                               std::pair{"min_dt", &timestepping_options.min_dt},
+                               std::pair{"max_dt", &timestepping_options.max_dt}}) {
+      if (dynamics.contains(name)) {
+        *value = dynamics[name];
+      }
+    }
+
     result.timestepping_options = timestepping_options;
   }
 
@@ -0,0 +1,99 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file low_order_refined.hpp
+ *
+ * @brief The low-order refined discretization used by the LOR preconditioner of a physics module
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/functional/functional.hpp"
+
+namespace serac {
+
+/**
+ * @brief The residual of a physics module on the low-order refined (LOR) discretization of its H1 space
+ *
+ * Every element of order p is split into p^dim elements of order 1 whose vertices are the Gauss-Lobatto nodes of the
+ * high-order element. The LOR space has the same true dofs as the high-order space, so its p = 1 operator preconditions
+ * the high-order one directly. As with the multigrid levels, the LOR residual only depends on the primal field and is
+ * linearized about a zero state.
+ *
+ * @tparam components The number of components of the primal field
+ */
+template <int components = 1>
+class LowOrderRefined {
+public:
+  /// @brief The space of the primal field on the LOR mesh
+  using low_order_space = H1<1, components>;
+
+  /**
+   * @brief Constructs the LOR mesh and space, and the residual on them
+   * @param[in] high_order_space The space of the primal field
+   */
+  explicit LowOrderRefined(mfem::ParFiniteElementSpace& high_order_space) : lor_(high_order_space)
+  {
+    auto& space = lor_.GetParFESpace();
+
+    // Functional needs the nodal grid function and neighbor data in the mesh
+    auto& mesh = *space.GetParMesh();
+    mesh.EnsureNodes();
+    mesh.ExchangeFaceNbrData();
+
+    std::array<const mfem::ParFiniteElementSpace*, 1> trial_spaces{&space};
+    residual_ = std::make_unique<Functional<low_order_space(low_order_space)>>(&space, trial_spaces);
+  }
+
+  /**
+   * @brief Adds a domain integral to the LOR residual
+   *
+   * @tparam dim The dimension of the elements
+   * @tparam QFunction The type of the quadrature function
+   * @param[in] qfunction A function of the time, the position and the primal field, see Functional
+   */
+  template <int dim, typename QFunction>
+  void addDomainIntegral(Dimension<dim>, const QFunction& qfunction)
+  {
+    residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qfunction, *lor_.GetParFESpace().GetParMesh());
+  }
+
+  /**
+   * @brief Gives the assembled LOR operator to a LOR preconditioner
+   *
+   * @param[inout] preconditioner The preconditioner of the physics module
+   * @param[in] essential_dofs The essential true dofs of the high-order space, which are also those of the LOR space
+   */
+  void setup(LORPreconditioner& preconditioner, const mfem::Array<int>& essential_dofs)
+  {
+    auto& space = lor_.GetParFESpace();
+
+    mfem::Vector zero(space.TrueVSize());
+    zero = 0.0;
+
+    auto [r, drdu] = (*residual_)(0.0, differentiate_wrt(zero));
+    auto low_order = assemble(drdu);
+    std::unique_ptr<mfem::HypreParMatrix> eliminated(low_order->EliminateRowsCols(essential_dofs));
+
+    preconditioner.setLowOrderOperator(std::move(low_order), components,
+                                       space.GetOrdering() == mfem::Ordering::byNODES);
+  }
+
+private:
+  /// @brief The LOR mesh and space, whose true dofs are permuted to match those of the high-order space
+  mfem::ParLORDiscretization lor_;
+
+  /// @brief The residual on the LOR space
+  std::unique_ptr<Functional<low_order_space(low_order_space)>> residual_;
+};
+
+}  // namespace serac
@@ -13,39 +13,27 @@
 #pragma once
 
 #include <functional>
+#include <vector>
 
+#include "serac/infrastructure/accelerator.hpp"
 #include "serac/numerics/functional/tensor.hpp"
 #include "serac/numerics/functional/tuple.hpp"
 
 namespace serac {
 
+namespace detail {
+
 /**
- * @brief Drive the material model thorugh a uniaxial tension experiment
- *
- * Drives material model through specified axial displacement gradient history.
- * The time elaspses from 0 up to t_max.
- * Currently only implemented for isotropic materials (or orthotropic materials with the
- * principal axes aligned with the coordinate directions).
- *
- * @param t_max upper limit of the time interval.
- * @param num_steps The number of discrete time points at which the response is sampled (uniformly spaced).
- *        This is inclusive of the point at time zero.
- * @param material The material model to use
- * @param initial_state The state variable collection for this material, set to the desired initial
- *        condition.
- * @param epsilon_xx A function describing the desired axial displacement gradient as a function of time.
- *        (NB axial displacement gradient is equivalent to engineering strain).
- * @param parameter_functions Pack of functions that return each parameter as a function of time. Leave
- *        empty if the material has no parameters.
+ * @brief Drive one material point through the uniaxial tension experiment of uniaxial_stress_test(), calling
+ * record(i, t, dudx, stress) after each step i (with @a state updated to the end of that step)
  */
-template <typename MaterialType, typename StateType, typename... parameter_types>
-auto uniaxial_stress_test(double t_max, size_t num_steps, const MaterialType material, const StateType initial_state,
-                          std::function<double(double)> epsilon_xx, const parameter_types... parameter_functions)
+template <typename MaterialType, typename StateType, typename Record, typename... parameter_types>
+void uniaxial_stress_steps(double t_max, size_t num_steps, const MaterialType& material, StateType& state,
+                           const std::function<double(double)>& epsilon_xx, Record&& record,
+                           const parameter_types&... parameter_functions)
 {
   double t = 0;
 
-  auto state = initial_state;
-
   auto sigma_yy_and_zz = [&](auto x) {
     auto epsilon_yy = x[0];
     auto epsilon_zz = x[1];
@@ -59,9 +47,6 @@ auto uniaxial_stress_test(double t_max, size_t num_steps, const MaterialType mat
     return tensor{{stress[1][1], stress[2][2]}};
   };
 
-  std::vector<tuple<double, tensor<double, 3, 3>, tensor<double, 3, 3>, StateType> > output_history;
-  output_history.reserve(num_steps);
-
   tensor<double, 3, 3> dudx{};
   const double         dt = t_max / double(num_steps - 1);
   for (size_t i = 0; i < num_steps; i++) {
@@ -72,14 +57,139 @@ auto uniaxial_stress_test(double t_max, size_t num_steps, const MaterialType mat
     dudx[2][2]             = epsilon_yy_and_zz[1];
 
     auto stress = material(state, dudx, parameter_functions(t)...);
-    output_history.push_back(tuple{t, dudx, stress, state});
+    record(i, t, dudx, stress);
 
     t += dt;
   }
+}
+
+/// @brief the times of the steps of the material point drivers, accumulated the same way as the drivers do
+inline std::vector<double> step_times(double t_max, size_t num_steps)
+{
+  std::vector<double> times(num_steps);
+  double              t  = 0;
+  const double        dt = t_max / double(num_steps - 1);
+  for (auto& time : times) {
+    time = t;
+    t += dt;
+  }
+  return times;
+}
+
+}  // namespace detail
+
+/**
+ * @brief The responses of many independent material points over the same time steps, see uniaxial_stress_test_batch()
+ * and single_quadrature_point_test_batch()
+ *
+ * Each kind of data is kept in its own array, with the steps of each point next to each other: the output of point p
+ * at step i is outputs[index(p, i)].
+ *
+ * @tparam OutputType the output of a material point at one step
+ * @tparam StateType the state variables of the material
+ */
+template <typename OutputType, typename StateType>
+struct MaterialPointHistories {
+  /// the number of steps of each point
+  size_t num_steps;
+
+  /// the time of each step
+  std::vector<double> times;
+
+  /// the outputs of every point at every step
+  std::vector<OutputType> outputs;
+
+  /// the state of each point after its last step
+  std::vector<StateType> final_states;
+
+  /// @brief the number of material points
+  size_t num_points() const { return final_states.size(); }
+
+  /// @brief where the output of point @a p at step @a i is
+  size_t index(size_t p, size_t i) const { return p * num_steps + i; }
+};
+
+/**
+ * @brief Drive the material model thorugh a uniaxial tension experiment
+ *
+ * Drives material model through specified axial displacement gradient history.
+ * The time elaspses from 0 up to t_max.
+ * Currently only implemented for isotropic materials (or orthotropic materials with the
+ * principal axes aligned with the coordinate directions).
+ *
+ * @param t_max upper limit of the time interval.
+ * @param num_steps The number of discrete time points at which the response is sampled (uniformly spaced).
+ *        This is inclusive of the point at time zero.
+ * @param material The material model to use
+ * @param initial_state The state variable collection for this material, set to the desired initial
+ *        condition.
+ * @param epsilon_xx A function describing the desired axial displacement gradient as a function of time.
+ *        (NB axial displacement gradient is equivalent to engineering strain).
+ * @param parameter_functions Pack of functions that return each parameter as a function of time. Leave
+ *        empty if the material has no parameters.
+ */
+template <typename MaterialType, typename StateType, typename... parameter_types>
+auto uniaxial_stress_test(double t_max, size_t num_steps, const MaterialType material, const StateType initial_state,
+                          std::function<double(double)> epsilon_xx, const parameter_types... parameter_functions)
+{
+  auto state = initial_state;
+
+  std::vector<tuple<double, tensor<double, 3, 3>, tensor<double, 3, 3>, StateType> > output_history;
+  output_history.reserve(num_steps);
+
+  detail::uniaxial_stress_steps(
+      t_max, num_steps, material, state, epsilon_xx,
+      [&](size_t, double t, const tensor<double, 3, 3>& dudx, const tensor<double, 3, 3>& stress) {
+        output_history.push_back(tuple{t, dudx, stress, state});
+      },
+      parameter_functions...);
 
   return output_history;
 }
 
+/**
+ * @brief Drive many independent material points through the same uniaxial tension experiment at once, e.g. the
+ * parameter samples of a calibration
+ *
+ * Each point has its own material model (of the same type), and is driven as in uniaxial_stress_test(). The points
+ * are distributed across the host threads (see forall_host()), so @a epsilon_xx, @a parameter_functions and the
+ * material models must be safe to call concurrently.
+ *
+ * @param t_max upper limit of the time interval.
+ * @param num_steps The number of discrete time points at which the response is sampled (uniformly spaced).
+ *        This is inclusive of the point at time zero.
+ * @param materials The material model of each point
+ * @param initial_state The initial state variables of every point
+ * @param epsilon_xx A function describing the desired axial displacement gradient as a function of time.
+ * @param parameter_functions Pack of functions that return each parameter as a function of time. Leave
+ *        empty if the material has no parameters.
+ * @return the MaterialPointHistories of the points, whose outputs are the (displacement gradient, stress) at each step
+ *
+ * @note Only the final states are kept, rather than the state at every step, since a calibration only compares the
+ * stresses
+ */
+template <typename MaterialType, typename StateType, typename... parameter_types>
+auto uniaxial_stress_test_batch(double t_max, size_t num_steps, const std::vector<MaterialType>& materials,
+                                const StateType initial_state, std::function<double(double)> epsilon_xx,
+                                const parameter_types... parameter_functions)
+{
+  using output_type = tuple<tensor<double, 3, 3>, tensor<double, 3, 3> >;
+  MaterialPointHistories<output_type, StateType> histories{num_steps, detail::step_times(t_max, num_steps),
+                                                           std::vector<output_type>(materials.size() * num_steps),
+                                                           std::vector<StateType>(materials.size(), initial_state)};
+
+  forall_host(materials.size(), [&](size_t p) {
+    detail::uniaxial_stress_steps(
+        t_max, num_steps, materials[p], histories.final_states[p], epsilon_xx,
+        [&](size_t i, double, const tensor<double, 3, 3>& dudx, const tensor<double, 3, 3>& stress) {
+          histories.outputs[histories.index(p, i)] = output_type{dudx, stress};
+        },
+        parameter_functions...);
+  });
+
+  return histories;
+}
+
 /**
  * @brief This function takes a material model (and associate state variables),
  *        subjects it to a time history of stimuli, described by `functions ... f`,
@@ -120,4 +230,39 @@ auto single_quadrature_point_test(double t_max, size_t num_steps, const Material
   return history;
 }
 
+/**
+ * @brief Subject many independent material points to the same time history of stimuli at once, as in
+ * single_quadrature_point_test()
+ *
+ * The points are distributed across the host threads (see forall_host()), so @a f and the material models must be
+ * safe to call concurrently.
+ *
+ * @param t_max the final time value
+ * @param num_steps the number of timesteps
+ * @param materials the material model of each point
+ * @param initial_state the initial state variables of every point
+ * @param f the functions that are used to generate the inputs to the material models at each timestep
+ * @return the MaterialPointHistories of the points, whose outputs are the material outputs at each step
+ */
+template <typename MaterialType, typename StateType, typename... functions>
+auto single_quadrature_point_test_batch(double t_max, size_t num_steps, const std::vector<MaterialType>& materials,
+                                        const StateType initial_state, const functions... f)
+{
+  auto state = initial_state;
+
+  using output_type = decltype(materials[0](state, f(0.0)...));
+  MaterialPointHistories<output_type, StateType> histories{num_steps, detail::step_times(t_max, num_steps),
+                                                           std::vector<output_type>(materials.size() * num_steps),
+                                                           std::vector<StateType>(materials.size(), initial_state)};
+
+  forall_host(materials.size(), [&](size_t p) {
+    auto& point_state = histories.final_states[p];
+    for (size_t i = 0; i < num_steps; i++) {
+      histories.outputs[histories.index(p, i)] = materials[p](point_state, f(histories.times[i])...);
+    }
+  });
+
+  return histories;
+}
+
 }  // namespace serac
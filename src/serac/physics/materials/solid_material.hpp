@@ -12,6 +12,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "serac/infrastructure/logger.hpp"
+#include "serac/infrastructure/shared_memory.hpp"
 #include "serac/numerics/functional/functional.hpp"
 
 /// SolidMechanics helper data types
@@ -44,6 +51,20 @@ struct LinearIsotropic {
     return lambda * tr(epsilon) * I + 2.0 * G * epsilon;
   }
 
+  /**
+   * @brief stress calculation, along with the (isotropic) tangent d(stress)/d(du_dX), see stressWithAnalyticTangent
+   *
+   * @tparam dim Dimensionality of space
+   * @param du_dX Displacement gradient with respect to the reference configuration
+   * @return The Cauchy stress and its derivative with respect to the displacement gradient
+   */
+  template <int dim>
+  SERAC_HOST_DEVICE auto stressAndTangent(State& state, const tensor<double, dim, dim>& du_dX) const
+  {
+    auto lambda = K - (2.0 / 3.0) * G;
+    return tuple{(*this)(state, du_dX), isotropic_tensor<double, dim, dim, dim, dim>{lambda, 2.0 * G, 0.0}};
+  }
+
   double density;  ///< mass density
   double K;        ///< bulk modulus
   double G;        ///< shear modulus
@@ -86,6 +107,48 @@ struct StVenantKirchhoff {
     return sigma;
   }
 
+  /**
+   * @brief stress calculation, along with the tangent d(stress)/d(grad_u), see stressWithAnalyticTangent
+   *
+   * @param[in] grad_u Displacement gradient
+   *
+   * @return The Cauchy stress and its derivative with respect to the displacement gradient
+   */
+  template <int dim>
+  auto stressAndTangent(State&, const tensor<double, dim, dim>& grad_u) const
+  {
+    static constexpr auto I      = Identity<dim>();
+    auto                  F      = grad_u + I;
+    const auto            E      = greenStrain(grad_u);
+    const double          lambda = K - (2.0 / 3.0) * G;
+
+    const auto   S     = K * tr(E) * I + 2.0 * G * dev(E);
+    const auto   P     = dot(F, S);
+    const double J     = det(F);
+    const auto   sigma = dot(P, transpose(F)) / J;
+
+    const auto B    = dot(F, transpose(F));
+    const auto SFt  = dot(S, transpose(F));
+    const auto Finv = inv(F);
+
+    // linearize P = F S and sigma = P F^T / J about F, with dF = e_k e_l^T
+    tensor<double, dim, dim, dim, dim> C{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            C[i][j][k][l] = ((i == k) * SFt[l][j] + lambda * F[k][l] * B[i][j] +
+                             G * (B[i][k] * F[j][l] + F[i][l] * B[k][j]) + (j == k) * P[i][l]) /
+                                J -
+                            sigma[i][j] * Finv[l][k];
+          }
+        }
+      }
+    }
+
+    return tuple{sigma, C};
+  }
+
   double density;  ///< density
   double K;        ///< Bulk modulus
   double G;        ///< Shear modulus
@@ -121,6 +184,39 @@ struct NeoHookean {
     return (lambda * log1p(J_minus_1) * I + G * B_minus_I) / J;
   }
 
+  /**
+   * @brief stress calculation, along with the tangent d(stress)/d(du_dX), see stressWithAnalyticTangent
+   *
+   * @tparam dim Dimensionality of space
+   * @param du_dX displacement gradient with respect to the reference configuration (displacement_grad)
+   * @return The Cauchy stress and its derivative with respect to the displacement gradient
+   */
+  template <int dim>
+  SERAC_HOST_DEVICE auto stressAndTangent(State& state, const tensor<double, dim, dim>& du_dX) const
+  {
+    constexpr auto I      = Identity<dim>();
+    auto           lambda = K - (2.0 / 3.0) * G;
+    auto           sigma  = (*this)(state, du_dX);
+    auto           F      = du_dX + I;
+    auto           Finv   = inv(F);
+    auto           J      = detApIm1(du_dX) + 1;
+
+    // d(log J) = tr(F^{-1} dF) and dB = dF F^T + F dF^T, with dF = e_k e_l^T
+    tensor<double, dim, dim, dim, dim> C{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            C[i][j][k][l] = (lambda * (i == j) * Finv[l][k] + G * ((i == k) * F[j][l] + F[i][l] * (j == k))) / J -
+                            sigma[i][j] * Finv[l][k];
+          }
+        }
+      }
+    }
+
+    return tuple{sigma, C};
+  }
+
   double density;  ///< mass density
   double K;        ///< bulk modulus
   double G;        ///< shear modulus
@@ -195,6 +291,277 @@ struct VoceHardening {
   };
 };
 
+/**
+ * @brief A hardening law that interpolates another one from a table, to save the evaluations of its transcendental
+ * functions (e.g. those of PowerLawHardening and VoceHardening) in the iterations of the return maps
+ *
+ * The flow stress and hardening modulus of the tabulated law are sampled at equally spaced plastic strains in
+ * [0, max_plastic_strain], and interpolated with monotone cubic Hermite splines (the sampled moduli, limited as in
+ * Fritsch & Carlson, Monotone Piecewise Cubic Interpolation, 1980). The number of intervals is doubled until the
+ * interpolation error at the quarter points of every interval is within the tolerance. Plastic strains outside of
+ * the table are evaluated with the tabulated law itself.
+ *
+ * Copies of a tabulated law (e.g. those captured by the q-functions of a residual) share the same table, and
+ * shareWithinNode() moves it to memory shared by all the ranks on a node.
+ *
+ * @tparam Hardening the tabulated hardening law, which must work with dual numbers
+ */
+template <typename Hardening>
+struct TabulatedHardening {
+  /**
+   * @brief Tabulate a hardening law
+   *
+   * @param law The hardening law
+   * @param max_plastic_strain The largest accumulated plastic strain in the table
+   * @param tolerance The largest interpolation error of the flow stress
+   * @param max_intervals The most intervals the table may have. It is an error for the tolerance to need more.
+   */
+  TabulatedHardening(Hardening law, double max_plastic_strain, double tolerance, size_t max_intervals = 1 << 16)
+      : sigma_y(law(0.0)), law_(law), max_plastic_strain_(max_plastic_strain)
+  {
+    SLIC_ERROR_IF(max_plastic_strain <= 0.0, "the table of a hardening law must have a positive range");
+    for (size_t intervals = 4;; intervals *= 2) {
+      SLIC_ERROR_IF(intervals > max_intervals,
+                    axom::fmt::format("tabulating the hardening law to within {} needs more than {} intervals",
+                                      tolerance, max_intervals));
+      tabulate(intervals);
+
+      double error = 0.0;
+      for (size_t i = 0; i < intervals; i++) {
+        for (double fraction : {0.25, 0.5, 0.75}) {
+          double eqps = (double(i) + fraction) * h_;
+          error       = std::max(error, std::abs(interpolate(eqps)[0] - law_(eqps)));
+        }
+      }
+      if (error <= tolerance) break;
+    }
+  }
+
+  double sigma_y;  ///< yield strength, the flow stress at zero plastic strain
+
+  /**
+   * @brief Keep a single copy of the table for all the ranks of @a comm on each node, in a shared memory window
+   *
+   * @param comm The communicator, whose ranks must all have tabulated the same law
+   *
+   * Only the copies made afterwards share the node's table, so this should be called before the material that holds
+   * this law is given to a physics module.
+   *
+   * @note This is a collective operation, and the shared memory is freed collectively once the last copy of
+   * the table is destroyed on every rank of the node
+   */
+  void shareWithinNode(MPI_Comm comm = MPI_COMM_WORLD)
+  {
+    NodeSharedArray<double> shared(2 * num_nodes_, comm);
+    if (shared.writer()) {
+      std::copy(table_, table_ + 2 * num_nodes_, shared.data());
+    }
+    shared.publish();
+
+    table_   = shared.data();
+    storage_ = std::make_shared<NodeSharedArray<double>>(std::move(shared));
+  }
+
+  /**
+   * @brief Computes the flow stress
+   *
+   * @tparam T Number-like type for the argument
+   * @param accumulated_plastic_strain The uniaxial equivalent accumulated plastic strain
+   * @return Flow stress value
+   */
+  template <typename T>
+  auto operator()(const T accumulated_plastic_strain) const
+  {
+    double eqps = get_value(accumulated_plastic_strain);
+    if (eqps < 0.0 || eqps > max_plastic_strain_) {
+      return T{law_(accumulated_plastic_strain)};
+    }
+
+    tensor<double, 2> interpolated = interpolate(eqps);
+    if constexpr (is_dual_number<T>::value) {
+      return T{interpolated[0], interpolated[1] * accumulated_plastic_strain.gradient};
+    } else {
+      return interpolated[0];
+    }
+  };
+
+private:
+  /// @brief sample the law at the nodes of @a intervals equal intervals, and limit the moduli to keep it monotone
+  void tabulate(size_t intervals)
+  {
+    h_         = max_plastic_strain_ / double(intervals);
+    num_nodes_ = intervals + 1;
+
+    // the flow stress and modulus of each node are next to each other, since they are always read together
+    auto  table         = std::make_shared<std::vector<double>>(2 * num_nodes_);
+    auto* flow_stresses = table->data();
+    auto* moduli        = table->data() + 1;
+    for (size_t i = 0; i <= intervals; i++) {
+      auto sample          = law_(make_dual(double(i) * h_));
+      flow_stresses[2 * i] = get_value(sample);
+      moduli[2 * i]        = get_gradient(sample);
+    }
+
+    for (size_t i = 0; i < intervals; i++) {
+      double secant = (flow_stresses[2 * (i + 1)] - flow_stresses[2 * i]) / h_;
+      if (secant == 0.0) {
+        moduli[2 * i] = moduli[2 * (i + 1)] = 0.0;
+        continue;
+      }
+      double alpha = moduli[2 * i] / secant;
+      double beta  = moduli[2 * (i + 1)] / secant;
+      if (alpha < 0.0) moduli[2 * i] = alpha = 0.0;
+      if (beta < 0.0) moduli[2 * (i + 1)] = beta = 0.0;
+      if (alpha * alpha + beta * beta > 9.0) {
+        double tau          = 3.0 / std::sqrt(alpha * alpha + beta * beta);
+        moduli[2 * i]       = tau * alpha * secant;
+        moduli[2 * (i + 1)] = tau * beta * secant;
+      }
+    }
+
+    table_   = table->data();
+    storage_ = std::move(table);
+  }
+
+  /// @brief the interpolated flow stress and hardening modulus at a plastic strain inside of the table
+  tensor<double, 2> interpolate(double eqps) const
+  {
+    size_t i = std::min(size_t(eqps / h_), num_nodes_ - 2);
+    double t = eqps / h_ - double(i);
+
+    double f0 = table_[2 * i];
+    double f1 = table_[2 * (i + 1)];
+    double m0 = table_[2 * i + 1] * h_;
+    double m1 = table_[2 * (i + 1) + 1] * h_;
+
+    double flow_stress = (1 + 2 * t) * (1 - t) * (1 - t) * f0 + t * (1 - t) * (1 - t) * m0 + t * t * (3 - 2 * t) * f1 +
+                         t * t * (t - 1) * m1;
+    double modulus = (6 * t * (t - 1) * (f0 - f1) + (1 - t) * (1 - 3 * t) * m0 + t * (3 * t - 2) * m1) / h_;
+    return {flow_stress, modulus};
+  }
+
+  Hardening                   law_;                 ///< the tabulated law
+  double                      max_plastic_strain_;  ///< the largest plastic strain in the table
+  double                      h_;                   ///< the spacing of the nodes of the table
+  size_t                      num_nodes_;           ///< the number of nodes of the table
+  const double*               table_;               ///< the flow stress and (limited) hardening modulus of each node
+  std::shared_ptr<const void> storage_;             ///< the owner of the table, shared by the copies of this law
+};
+
+namespace detail {
+
+/**
+ * @brief the initial guess and the bracket of the equivalent plastic strain increment of a J2 return map
+ *
+ * Without a warm start, the guess is 0 and the bracket is [0, maxPlasticStrainIncrement()]. With one, the guess is
+ * the increment of the most recent evaluation at this point (e.g. the previous Newton iteration of the global
+ * solve), which also splits the bracket: since the residual decreases with the increment, the root is on the side
+ * of the guess where the residual changes sign.
+ *
+ * @tparam Material J2SmallStrain or J2
+ * @param material The material model
+ * @param state The state of the material at the point
+ * @param trial The elastic predictor at the point
+ * @return the (guess, lower bound, upper bound)
+ */
+template <typename Material, typename Trial>
+tensor<double, 3> returnMapBracket(const Material& material, const typename Material::State& state,
+                                   const Trial& trial)
+{
+  double upper_bound = material.maxPlasticStrainIncrement(state, trial);
+  double guess       = state.delta_eqps_guess;
+  if (!material.warm_start || !(guess > 0.0 && guess < upper_bound)) {
+    return {0.0, 0.0, upper_bound};
+  }
+
+  if (material.returnMapResidual()(guess, get_value(get<3>(trial)), state.accumulated_plastic_strain) > 0.0) {
+    return {guess, guess, upper_bound};
+  }
+  return {guess, 0.0, guess};
+}
+
+/**
+ * @brief solve the return map of a J2 material at one point, and remember its increment for the next warm start
+ *
+ * @tparam Material J2SmallStrain or J2
+ * @param material The material model
+ * @param state The state of the material at the point, whose scratch guess is updated
+ * @param trial The elastic predictor at the point
+ * @return the equivalent plastic strain increment
+ */
+template <typename Material, typename Trial>
+auto returnMap(const Material& material, typename Material::State& state, const Trial& trial)
+{
+  tensor<double, 3> bracket = returnMapBracket(material, state, trial);
+  auto [delta_eqps, status] = solve_scalar_equation(material.returnMapResidual(), bracket[0], bracket[1], bracket[2],
+                                                    material.returnMapOptions(), get<3>(trial),
+                                                    state.accumulated_plastic_strain);
+  state.delta_eqps_guess    = get_value(delta_eqps);
+  return delta_eqps;
+}
+
+/**
+ * @brief calculate the Cauchy stress of a J2 material at several quadrature points at once
+ *
+ * The elastic predictor is evaluated at every point. The return maps of the yielding points are
+ * gathered into a compact work list, solved in lockstep with solve_scalar_equations, and their
+ * plastic corrections are scattered back to the points.
+ *
+ * @tparam Material J2SmallStrain or J2
+ * @param material The material model
+ * @param states The state of the material at each point, updated in place
+ * @param du_dX The displacement gradient at each point
+ * @return The Cauchy stress at each point
+ */
+template <typename Material, int n, typename T>
+auto batchedReturnMap(const Material& material, tensor<typename Material::State, n>& states, const tensor<T, n>& du_dX)
+{
+  using trial_type  = decltype(material.elasticPredictor(typename Material::State{}, T{}));
+  using stress_type = decltype(material.stress(std::declval<trial_type>()));
+  using q_type      = std::decay_t<decltype(get<3>(std::declval<trial_type>()))>;
+
+  tensor<trial_type, n> trials{};
+  tensor<int, n>        work_list{};
+  tensor<q_type, n>     q{};
+  tensor<double, n>     eqps_old{};
+  tensor<double, n>     guess{};
+  tensor<double, n>     lower_bound{};
+  tensor<double, n>     upper_bound{};
+  int                   num_yielding = 0;
+
+  for (int i = 0; i < n; i++) {
+    trials[i] = material.elasticPredictor(states[i], du_dX[i]);
+    if (material.yielding(states[i], trials[i])) {
+      tensor<double, 3> bracket = returnMapBracket(material, states[i], trials[i]);
+      work_list[num_yielding]   = i;
+      q[num_yielding]           = get<3>(trials[i]);
+      eqps_old[num_yielding]    = states[i].accumulated_plastic_strain;
+      guess[num_yielding]       = bracket[0];
+      lower_bound[num_yielding] = bracket[1];
+      upper_bound[num_yielding] = bracket[2];
+      num_yielding++;
+    }
+  }
+
+  if (num_yielding > 0) {
+    auto results = solve_scalar_equations(material.returnMapResidual(), guess, lower_bound, upper_bound,
+                                          material.returnMapOptions(), num_yielding, q, eqps_old);
+    for (int k = 0; k < num_yielding; k++) {
+      auto& state            = states[work_list[k]];
+      state.delta_eqps_guess = get_value(get<0>(results[k]));
+      material.plasticCorrector(state, trials[work_list[k]], get<0>(results[k]));
+    }
+  }
+
+  tensor<stress_type, n> stresses{};
+  for (int i = 0; i < n; i++) {
+    stresses[i] = material.stress(trials[i]);
+  }
+  return stresses;
+}
+
+}  // namespace detail
+
 /// @brief J2 material with nonlinear isotropic hardening and linear kinematic hardening
 template <typename HardeningType>
 struct J2SmallStrain {
@@ -207,54 +574,177 @@ struct J2SmallStrain {
   double        Hk;         ///< Kinematic hardening modulus
   double        density;    ///< Mass density
 
+  /**
+   * @brief whether each return map starts from the increment of the most recent evaluation at its point (e.g. the
+   * previous Newton iteration of the global solve), see detail::returnMapBracket
+   */
+  bool warm_start = false;
+
   /// @brief variables required to characterize the hysteresis response
   struct State {
     tensor<double, dim, dim> plastic_strain;              ///< plastic strain
     double                   accumulated_plastic_strain;  ///< uniaxial equivalent plastic strain
+    double                   delta_eqps_guess = 0.0;      ///< scratch: the last return map increment, see warm_start
+
+    /// @brief store each member in its own array, see serac::quadrature_data_layout
+    static constexpr auto quadrature_data_fields()
+    {
+      return std::tuple{&State::plastic_strain, &State::accumulated_plastic_strain, &State::delta_eqps_guess};
+    }
+
+    /// @brief the guess is kept between evaluations that don't update the state, see serac::quadrature_scratch_layout
+    static constexpr auto quadrature_scratch_fields() { return std::tuple{&State::delta_eqps_guess}; }
   };
 
+  /// @brief stress updates are evaluated at all of an element's quadrature points at once, see batch()
+  static constexpr bool batched = true;
+
   /** @brief calculate the Cauchy stress, given the displacement gradient and previous material state */
   template <typename T>
   auto operator()(State& state, const T du_dX) const
   {
-    using std::sqrt;
-    constexpr auto I = Identity<dim>();
-    const double   K = E / (3.0 * (1.0 - 2.0 * nu));
-    const double   G = 0.5 * E / (1.0 + nu);
-
     // (i) elastic predictor
+    auto trial = elasticPredictor(state, du_dX);
+
+    // (ii) admissibility
+    if (yielding(state, trial)) {
+      // (iii) return mapping
+      auto delta_eqps = detail::returnMap(*this, state, trial);
+      plasticCorrector(state, trial, delta_eqps);
+    }
+
+    return stress(trial);
+  }
+
+  /**
+   * @brief calculate the Cauchy stress, along with the consistent tangent d(stress)/d(du_dX) of the return map,
+   * see stressWithAnalyticTangent
+   */
+  auto stressAndTangent(State& state, const tensor<double, dim, dim>& du_dX) const
+  {
+    const double K     = bulkModulus();
+    const double G     = shearModulus();
+    auto         trial = elasticPredictor(state, du_dX);
+
+    // elastically, C = K I x I + 2G I_dev. The return map scales down the deviatoric part and adds a
+    // rank-one term along the flow direction n, see Simo & Hughes, Computational Inelasticity, Box 3.2
+    double                   c_dev = 2.0 * G;
+    double                   c_nn  = 0.0;
+    tensor<double, dim, dim> n{};
+
+    if (yielding(state, trial)) {
+      const double delta_eqps = detail::returnMap(*this, state, trial);
+      const double q          = get<3>(trial);
+      const double dh         = get_gradient(hardening(make_dual(state.accumulated_plastic_strain + delta_eqps)));
+      const double c_ret      = 6.0 * G * G * delta_eqps / q;
+
+      n     = std::sqrt(1.5) * get<2>(trial) / q;
+      c_dev = 2.0 * G - c_ret;
+      c_nn  = c_ret - 6.0 * G * G / (3.0 * G + Hk + dh);
+
+      plasticCorrector(state, trial, delta_eqps);
+    }
+
+    tensor<double, dim, dim, dim, dim> C{};
+    for (int i = 0; i < dim; i++) {
+      for (int j = 0; j < dim; j++) {
+        for (int k = 0; k < dim; k++) {
+          for (int l = 0; l < dim; l++) {
+            double I_sym  = 0.5 * ((i == k) * (j == l) + (i == l) * (j == k));
+            double I_vol  = (i == j) * (k == l);
+            C[i][j][k][l] = K * I_vol + c_dev * (I_sym - I_vol / 3.0) + c_nn * n[i][j] * n[k][l];
+          }
+        }
+      }
+    }
+
+    return tuple{stress(trial), C};
+  }
+
+  /**
+   * @brief calculate the Cauchy stress at several quadrature points at once
+   *
+   * The elastic predictor is evaluated at every point, then the return maps of the yielding points are
+   * gathered into a compact work list and solved in lockstep, see solve_scalar_equations.
+   */
+  template <int n, typename T>
+  auto batch(tensor<State, n>& states, const tensor<T, n>& du_dX) const
+  {
+    return detail::batchedReturnMap(*this, states, du_dX);
+  }
+
+  /// @brief the elastic predictor: the pressure, the deviatoric stress, the relative stress and the trial
+  /// equivalent stress
+  template <typename T>
+  auto elasticPredictor(const State& state, const T& du_dX) const
+  {
+    using std::sqrt;
     auto el_strain = sym(du_dX) - state.plastic_strain;
-    auto p         = K * tr(el_strain);
-    auto s         = 2.0 * G * dev(el_strain);
+    auto p         = bulkModulus() * tr(el_strain);
+    auto s         = 2.0 * shearModulus() * dev(el_strain);
     auto sigma_b   = 2.0 / 3.0 * Hk * state.plastic_strain;
     auto eta       = s - sigma_b;
     auto q         = sqrt(1.5) * norm(eta);
+    return tuple{p, s, eta, q};
+  }
 
-    // (ii) admissibility
-    const double eqps_old = state.accumulated_plastic_strain;
-    auto         residual = [eqps_old, G, *this](auto delta_eqps, auto trial_q) {
+  /// @brief the residual of the return map, as a function of the equivalent plastic strain increment
+  auto returnMapResidual() const
+  {
+    return [G = shearModulus(), *this](auto delta_eqps, auto trial_q, double eqps_old) {
       return trial_q - (3.0 * G + Hk) * delta_eqps - this->hardening(eqps_old + delta_eqps);
     };
-    if (residual(0.0, get_value(q)) > tol * hardening.sigma_y) {
-      // (iii) return mapping
+  }
+
+  /// @brief whether the elastic predictor is outside the yield surface
+  template <typename Trial>
+  bool yielding(const State& state, const Trial& trial) const
+  {
+    return returnMapResidual()(0.0, get_value(get<3>(trial)), state.accumulated_plastic_strain) >
+           tol * hardening.sigma_y;
+  }
 
-      // Note the tolerance for convergence is the same as the tolerance for entering the return map.
-      // This ensures that if the constitutive update is called again with the updated internal
-      // variables, the return map won't be repeated.
-      ScalarSolverOptions opts{.xtol = 0, .rtol = tol * hardening.sigma_y, .max_iter = 25};
-      double              lower_bound = 0.0;
-      double              upper_bound = (get_value(q) - hardening(eqps_old)) / (3.0 * G + Hk);
-      auto [delta_eqps, status]       = solve_scalar_equation(residual, 0.0, lower_bound, upper_bound, opts, q);
+  /// @brief the upper bound of the equivalent plastic strain increment of the return map
+  template <typename Trial>
+  double maxPlasticStrainIncrement(const State& state, const Trial& trial) const
+  {
+    return (get_value(get<3>(trial)) - hardening(state.accumulated_plastic_strain)) / (3.0 * shearModulus() + Hk);
+  }
 
-      auto Np = 1.5 * eta / q;
+  /// @brief the options of the return map solver
+  ScalarSolverOptions returnMapOptions() const
+  {
+    // Note the tolerance for convergence is the same as the tolerance for entering the return map.
+    // This ensures that if the constitutive update is called again with the updated internal
+    // variables, the return map won't be repeated.
+    return ScalarSolverOptions{.xtol = 0, .rtol = tol * hardening.sigma_y, .max_iter = 25};
+  }
 
-      s = s - 2.0 * G * delta_eqps * Np;
-      state.accumulated_plastic_strain += get_value(delta_eqps);
-      state.plastic_strain += get_value(delta_eqps) * get_value(Np);
-    }
+  /// @brief apply the plastic correction for the equivalent plastic strain increment to the trial stress and the state
+  template <typename Trial, typename S>
+  void plasticCorrector(State& state, Trial& trial, const S& delta_eqps) const
+  {
+    auto& s  = get<1>(trial);
+    auto  Np = 1.5 * get<2>(trial) / get<3>(trial);
 
-    return s + p * I;
+    s = s - 2.0 * shearModulus() * delta_eqps * Np;
+    state.accumulated_plastic_strain += get_value(delta_eqps);
+    state.plastic_strain += get_value(delta_eqps) * get_value(Np);
   }
+
+  /// @brief the Cauchy stress of the (corrected) trial stress
+  template <typename Trial>
+  auto stress(const Trial& trial) const
+  {
+    constexpr auto I = Identity<dim>();
+    return get<1>(trial) + get<0>(trial) * I;
+  }
+
+  /// @brief the bulk modulus
+  double bulkModulus() const { return E / (3.0 * (1.0 - 2.0 * nu)); }
+
+  /// @brief the shear modulus
+  double shearModulus() const { return 0.5 * E / (1.0 + nu); }
 };
 
 /// @brief Finite deformation version of J2 material with nonlinear isotropic hardening.
@@ -268,61 +758,143 @@ struct J2 {
   HardeningType hardening;  ///< Flow stress hardening model
   double        density;    ///< mass density
 
+  /**
+   * @brief whether each return map starts from the increment of the most recent evaluation at its point (e.g. the
+   * previous Newton iteration of the global solve), see detail::returnMapBracket
+   */
+  bool warm_start = false;
+
   /// @brief variables required to characterize the hysteresis response
   struct State {
     tensor<double, dim, dim> Fpinv = DenseIdentity<3>();  ///< inverse of plastic distortion tensor
     double                   accumulated_plastic_strain;  ///< uniaxial equivalent plastic strain
+    double                   delta_eqps_guess = 0.0;      ///< scratch: the last return map increment, see warm_start
+
+    /// @brief store each member in its own array, see serac::quadrature_data_layout
+    static constexpr auto quadrature_data_fields()
+    {
+      return std::tuple{&State::Fpinv, &State::accumulated_plastic_strain, &State::delta_eqps_guess};
+    }
+
+    /// @brief the guess is kept between evaluations that don't update the state, see serac::quadrature_scratch_layout
+    static constexpr auto quadrature_scratch_fields() { return std::tuple{&State::delta_eqps_guess}; }
   };
 
+  /// @brief stress updates are evaluated at all of an element's quadrature points at once, see batch()
+  static constexpr bool batched = true;
+
   /** @brief calculate the Cauchy stress, given the displacement gradient and previous material state */
   template <typename T>
   auto operator()(State& state, const T du_dX) const
+  {
+    // (i) elastic predictor
+    auto trial = elasticPredictor(state, du_dX);
+
+    // (ii) admissibility
+    if (yielding(state, trial)) {
+      // (iii) return mapping
+      auto delta_eqps = detail::returnMap(*this, state, trial);
+      plasticCorrector(state, trial, delta_eqps);
+    }
+
+    return stress(trial);
+  }
+
+  /**
+   * @brief calculate the Cauchy stress at several quadrature points at once
+   *
+   * The elastic predictor is evaluated at every point, then the return maps of the yielding points are
+   * gathered into a compact work list and solved in lockstep, see solve_scalar_equations.
+   */
+  template <int n, typename T>
+  auto batch(tensor<State, n>& states, const tensor<T, n>& du_dX) const
+  {
+    return detail::batchedReturnMap(*this, states, du_dX);
+  }
+
+  /// @brief the elastic predictor: the deformation gradient and its elastic part, the pressure, the deviatoric
+  /// stress and the trial equivalent stress
+  template <typename T>
+  auto elasticPredictor(const State& state, const T& du_dX) const
   {
     using std::sqrt;
     constexpr auto I = Identity<dim>();
-    const double   K = E / (3.0 * (1.0 - 2.0 * nu));
-    const double   G = 0.5 * E / (1.0 + nu);
 
-    // (i) elastic predictor
     auto F  = du_dX + I;
     auto Fe = dot(F, state.Fpinv);
     auto Ee = 0.5 * log_symm(dot(transpose(Fe), Fe));
     // From this point until the state variable update, the algorithm exactly coincides with the
     // small strain one.
-    auto p = K * tr(Ee);
-    auto s = 2.0 * G * dev(Ee);
+    auto p = bulkModulus() * tr(Ee);
+    auto s = 2.0 * shearModulus() * dev(Ee);
     auto q = sqrt(1.5) * norm(s);
+    return tuple{p, s, F, q, Fe};
+  }
 
-    // (ii) admissibility
-    const double eqps_old = state.accumulated_plastic_strain;
-    auto         residual = [eqps_old, G, *this](auto delta_eqps, auto trial_mises) {
+  /// @brief the residual of the return map, as a function of the equivalent plastic strain increment
+  auto returnMapResidual() const
+  {
+    return [G = shearModulus(), *this](auto delta_eqps, auto trial_mises, double eqps_old) {
       return trial_mises - 3.0 * G * delta_eqps - this->hardening(eqps_old + delta_eqps);
     };
-    if (residual(0.0, get_value(q)) > tol * hardening.sigma_y) {
-      // (iii) return mapping
+  }
 
-      // Note the tolerance for convergence is the same as the tolerance for entering the return map.
-      // This ensures that if the constitutive update is called again with the updated internal
-      // variables, the return map won't be repeated.
-      ScalarSolverOptions opts{.xtol = 0, .rtol = tol * hardening.sigma_y, .max_iter = 25};
-      double              lower_bound = 0.0;
-      double              upper_bound = (get_value(q) - hardening(eqps_old)) / (3.0 * G);
-      auto [delta_eqps, status]       = solve_scalar_equation(residual, 0.0, lower_bound, upper_bound, opts, q);
-
-      auto Np = 1.5 * s / q;
-
-      s      = s - 2.0 * G * delta_eqps * Np;
-      auto A = exp_symm(-delta_eqps * Np);
-      Fe     = dot(Fe, A);
-      state.accumulated_plastic_strain += get_value(delta_eqps);
-      state.Fpinv = dot(state.Fpinv, get_value(A));
-    }
+  /// @brief whether the elastic predictor is outside the yield surface
+  template <typename Trial>
+  bool yielding(const State& state, const Trial& trial) const
+  {
+    return returnMapResidual()(0.0, get_value(get<3>(trial)), state.accumulated_plastic_strain) >
+           tol * hardening.sigma_y;
+  }
+
+  /// @brief the upper bound of the equivalent plastic strain increment of the return map
+  template <typename Trial>
+  double maxPlasticStrainIncrement(const State& state, const Trial& trial) const
+  {
+    return (get_value(get<3>(trial)) - hardening(state.accumulated_plastic_strain)) / (3.0 * shearModulus());
+  }
+
+  /// @brief the options of the return map solver
+  ScalarSolverOptions returnMapOptions() const
+  {
+    // Note the tolerance for convergence is the same as the tolerance for entering the return map.
+    // This ensures that if the constitutive update is called again with the updated internal
+    // variables, the return map won't be repeated.
+    return ScalarSolverOptions{.xtol = 0, .rtol = tol * hardening.sigma_y, .max_iter = 25};
+  }
+
+  /// @brief apply the plastic correction for the equivalent plastic strain increment to the trial stress and the state
+  template <typename Trial, typename S>
+  void plasticCorrector(State& state, Trial& trial, const S& delta_eqps) const
+  {
+    auto& s  = get<1>(trial);
+    auto& Fe = get<4>(trial);
+    auto  Np = 1.5 * s / get<3>(trial);
+
+    s      = s - 2.0 * shearModulus() * delta_eqps * Np;
+    auto A = exp_symm(-delta_eqps * Np);
+    Fe     = dot(Fe, A);
+    state.accumulated_plastic_strain += get_value(delta_eqps);
+    state.Fpinv = dot(state.Fpinv, get_value(A));
+  }
+
+  /// @brief the Cauchy stress of the (corrected) trial stress
+  template <typename Trial>
+  auto stress(const Trial& trial) const
+  {
+    constexpr auto I = Identity<dim>();
     // Mandel stress
-    auto M = s + p * I;
+    auto M = get<1>(trial) + get<0>(trial) * I;
     // convert to Cauchy
-    auto FeT = transpose(Fe);
-    return dot(dot(inv(FeT), M), FeT) / det(F);
+    auto FeT = transpose(get<4>(trial));
+    return dot(dot(inv(FeT), M), FeT) / det(get<2>(trial));
   }
+
+  /// @brief the bulk modulus
+  double bulkModulus() const { return E / (3.0 * (1.0 - 2.0 * nu)); }
+
+  /// @brief the shear modulus
+  double shearModulus() const { return 0.5 * E / (1.0 + nu); }
 };
 
 /**
@@ -400,4 +972,71 @@ struct ConstantTraction {
   }
 };
 
+/**
+ * @brief whether a material implements stressAndTangent(), which returns the stress along with its derivative with
+ * respect to the displacement gradient, so the tangent doesn't have to come from differentiating operator()
+ */
+template <typename Material, int dim, typename = void>
+struct has_analytic_tangent : std::false_type {
+};
+
+/// @overload
+template <typename Material, int dim>
+struct has_analytic_tangent<Material, dim,
+                            std::void_t<decltype(std::declval<const Material&>().stressAndTangent(
+                                std::declval<typename Material::State&>(), tensor<double, dim, dim>{}))>>
+    : std::true_type {
+};
+
+namespace detail {
+
+/// @brief the (i,j) component of C : d(du_dX), for each of the partial derivatives carried by du_dX
+template <typename Gradient, int dim>
+SERAC_HOST_DEVICE auto chainTangent(const tensor<double, dim, dim, dim, dim>& C,
+                                    const tensor<dual<Gradient>, dim, dim>& du_dX, int i, int j)
+{
+  Gradient g{};
+  for (int k = 0; k < dim; k++) {
+    for (int l = 0; l < dim; l++) {
+      g += C[i][j][k][l] * du_dX[k][l].gradient;
+    }
+  }
+  return g;
+}
+
+/// @overload
+template <typename Gradient, int dim>
+SERAC_HOST_DEVICE auto chainTangent(const isotropic_tensor<double, dim, dim, dim, dim>& C,
+                                    const tensor<dual<Gradient>, dim, dim>& du_dX, int i, int j)
+{
+  Gradient g = (0.5 * (C.c2 + C.c3)) * du_dX[i][j].gradient + (0.5 * (C.c2 - C.c3)) * du_dX[j][i].gradient;
+  if (i == j) {
+    for (int k = 0; k < dim; k++) {
+      g += C.c1 * du_dX[k][k].gradient;
+    }
+  }
+  return g;
+}
+
+}  // namespace detail
+
+/**
+ * @brief calculate the stress of a material with an analytic tangent, see has_analytic_tangent
+ *
+ * The stress and tangent are evaluated with the values of the displacement gradient, then the tangent is contracted
+ * with the derivatives of the displacement gradient. Those are not identity seeds in general (e.g. they include the
+ * inverse Jacobian of the element), so this gives the same result as differentiating operator() with dual numbers,
+ * without propagating every one of those derivatives through the constitutive update.
+ */
+template <typename Material, typename State, typename Gradient, int dim>
+SERAC_HOST_DEVICE auto stressWithAnalyticTangent(const Material& material, State& state,
+                                                 const tensor<dual<Gradient>, dim, dim>& du_dX)
+{
+  auto        stress_and_tangent = material.stressAndTangent(state, get_value(du_dX));
+  const auto& stress             = get<0>(stress_and_tangent);
+  const auto& C                  = get<1>(stress_and_tangent);
+  return make_tensor<dim, dim>(
+      [&](int i, int j) { return dual<Gradient>{stress[i][j], detail::chainTangent(C, du_dX, i, j)}; });
+}
+
 }  // namespace serac::solid_mechanics
@@ -122,6 +122,50 @@ TEST(J2, PowerLawHardeningWorksWithDuals)
   EXPECT_GT(flow_stress.gradient, 0.0);
 };
 
+TEST(J2, TabulatedHardeningMatchesTheTabulatedLaw)
+{
+  solid_mechanics::PowerLawHardening law{.sigma_y = 1.0, .n = 2.0, .eps0 = 0.01};
+
+  double                                                                  tolerance = 1e-8;
+  solid_mechanics::TabulatedHardening<solid_mechanics::PowerLawHardening> table(law, 1.0, tolerance);
+  EXPECT_EQ(table.sigma_y, law.sigma_y);
+
+  for (double eqps : {0.0, 1e-4, 0.0123, 0.3, 0.77, 1.0, 2.0}) {
+    auto exact        = law(make_dual(eqps));
+    auto interpolated = table(make_dual(eqps));
+    EXPECT_NEAR(interpolated.value, exact.value, tolerance);
+    EXPECT_NEAR(interpolated.gradient, exact.gradient, 1e-3 * exact.gradient);
+    EXPECT_EQ(table(eqps), interpolated.value);
+  }
+
+  // the interpolant must not lose the monotonicity of the law
+  double previous = table(0.0);
+  for (int i = 1; i <= 1000; i++) {
+    double current = table(1e-3 * i);
+    EXPECT_GE(current, previous);
+    previous = current;
+  }
+}
+
+TEST(J2, TabulatedHardeningInTheReturnMap)
+{
+  using Hardening = solid_mechanics::VoceHardening;
+
+  Hardening law{.sigma_y = 1.0, .sigma_sat = 2.0, .strain_constant = 0.1};
+
+  solid_mechanics::J2<Hardening> exact{.E = 200.0, .nu = 0.25, .hardening = law, .density = 1.0};
+  solid_mechanics::J2<solid_mechanics::TabulatedHardening<Hardening>> tabulated{
+      .E = 200.0, .nu = 0.25, .hardening = {law, 1.0, 1e-10}, .density = 1.0};
+
+  auto strain             = [](double t) { return 0.05 * t; };
+  auto exact_response     = uniaxial_stress_test(1.0, 11, exact, decltype(exact)::State{}, strain);
+  auto tabulated_response = uniaxial_stress_test(1.0, 11, tabulated, decltype(tabulated)::State{}, strain);
+
+  for (size_t i = 0; i < exact_response.size(); i++) {
+    EXPECT_NEAR(get<2>(tabulated_response[i])[0][0], get<2>(exact_response[i])[0][0], 1e-8);
+  }
+}
+
 TEST(J2SmallStrain, SatisfiesConsistency)
 {
   // clang-format off
@@ -181,6 +225,36 @@ TEST(J2SmallStrain, Uniaxial)
   }
 };
 
+TEST(J2SmallStrain, UniaxialBatchMatchesSerial)
+{
+  using Hardening = solid_mechanics::LinearHardening;
+  using Material  = solid_mechanics::J2SmallStrain<Hardening>;
+
+  // a few samples of the yield strength, as in a calibration
+  std::vector<Material> materials;
+  for (double sigma_y : {0.005, 0.01, 0.02}) {
+    Hardening hardening{.sigma_y = sigma_y, .Hi = 0.01};
+    materials.push_back(Material{.E = 1.0, .nu = 0.25, .hardening = hardening, .Hk = 0.0, .density = 1.0});
+  }
+
+  auto internal_state = Material::State{};
+  auto strain         = [](double t) { return 0.01 * t; };
+  auto histories      = uniaxial_stress_test_batch(2.0, 6, materials, internal_state, strain);
+  ASSERT_EQ(histories.num_points(), materials.size());
+
+  for (size_t p = 0; p < materials.size(); p++) {
+    auto response_history = uniaxial_stress_test(2.0, 6, materials[p], internal_state, strain);
+    for (size_t i = 0; i < response_history.size(); i++) {
+      auto output = histories.outputs[histories.index(p, i)];
+      EXPECT_EQ(histories.times[i], get<0>(response_history[i]));
+      EXPECT_LT(norm(get<0>(output) - get<1>(response_history[i])), 1e-14);
+      EXPECT_LT(norm(get<1>(output) - get<2>(response_history[i])), 1e-14);
+    }
+    auto final_state = get<3>(response_history.back());
+    EXPECT_LT(norm(histories.final_states[p].plastic_strain - final_state.plastic_strain), 1e-14);
+  }
+}
+
 TEST(J2, Uniaxial)
 {
   /* Log strain J2 plasticity has the nice feature that the exact uniaxial stress solution from
@@ -274,6 +348,90 @@ TEST(J2, DerivativeCorrectness)
   EXPECT_LT(norm(dsig[0] - dsig[1]), 1e-5 * norm(dsig[1]));
 }
 
+TEST(J2, BatchMatchesPointwise)
+{
+  using Hardening = solid_mechanics::PowerLawHardening;
+  using Material  = solid_mechanics::J2<Hardening>;
+
+  Hardening hardening{.sigma_y = 350e6, .n = 3, .eps0 = 0.00175};
+  Material  material{.E = 200e9, .nu = 0.25, .hardening = hardening, .density = 1.0};
+
+  // clang-format off
+  const tensor<double, 3, 3> H{{
+    { 0.025, -0.008,  0.005},
+    {-0.008, -0.01,   0.003},
+    { 0.005,  0.003,  0.0}}};
+  // clang-format on
+
+  // a mix of elastic and yielding points, so the batch solves a compact subset of the return maps
+  constexpr int                     n = 4;
+  const tensor<double, n>           scale{{1.0, 1.0e-4, 0.5, 2.0}};
+  tensor<Material::State, n>        batch_states{};
+  tensor<decltype(make_dual(H)), n> du_dX{};
+  for (int i = 0; i < n; i++) {
+    du_dX[i] = make_dual(scale[i] * H);
+  }
+
+  auto batch_stresses = material.batch(batch_states, du_dX);
+
+  for (int i = 0; i < n; i++) {
+    auto state  = Material::State{};
+    auto stress = material(state, du_dX[i]);
+
+    EXPECT_LT(norm(get_value(batch_stresses[i]) - get_value(stress)), 1e-12 * norm(get_value(stress)));
+    EXPECT_LT(norm(get_gradient(batch_stresses[i]) - get_gradient(stress)), 1e-12 * norm(get_gradient(stress)));
+    EXPECT_NEAR(batch_states[i].accumulated_plastic_strain, state.accumulated_plastic_strain, 1e-15);
+    EXPECT_LT(norm(batch_states[i].Fpinv - state.Fpinv), 1e-14);
+  }
+
+  // make sure that the load cases include both elastic and yielding points
+  EXPECT_EQ(batch_states[1].accumulated_plastic_strain, 0.0);
+  EXPECT_GT(batch_states[3].accumulated_plastic_strain, 1e-3);
+}
+
+TEST(J2, WarmStartMatchesColdStart)
+{
+  using Hardening = solid_mechanics::PowerLawHardening;
+  using Material  = solid_mechanics::J2<Hardening>;
+
+  Hardening hardening{.sigma_y = 350e6, .n = 3, .eps0 = 0.00175};
+  Material  cold{.E = 200e9, .nu = 0.25, .hardening = hardening, .density = 1.0};
+  Material  warm = cold;
+
+  warm.warm_start = true;
+
+  // clang-format off
+  const tensor<double, 3, 3> H{{
+    { 0.025, -0.008,  0.005},
+    {-0.008, -0.01,   0.003},
+    { 0.005,  0.003,  0.0}}};
+  // clang-format on
+
+  // the guess of each state comes from a nearby "previous iteration", above and below the increment
+  for (double previous_scale : {0.9, 1.1}) {
+    Material::State state{};
+    warm(state, make_dual(previous_scale * H));
+    EXPECT_GT(state.delta_eqps_guess, 0.0);
+
+    Material::State warm_state{};
+    Material::State cold_state{};
+    warm_state.delta_eqps_guess = state.delta_eqps_guess;
+
+    auto warm_stress = warm(warm_state, make_dual(H));
+    auto cold_stress = cold(cold_state, make_dual(H));
+
+    EXPECT_LT(norm(get_value(warm_stress) - get_value(cold_stress)), 1e-10 * norm(get_value(cold_stress)));
+    EXPECT_LT(norm(get_gradient(warm_stress) - get_gradient(cold_stress)), 1e-8 * norm(get_gradient(cold_stress)));
+    EXPECT_NEAR(warm_state.accumulated_plastic_strain, cold_state.accumulated_plastic_strain, 1e-12);
+
+    tensor<Material::State, 1> batch_state{};
+    batch_state[0].delta_eqps_guess = state.delta_eqps_guess;
+    auto batch_stress               = warm.batch(batch_state, tensor<decltype(make_dual(H)), 1>{{make_dual(H)}});
+    EXPECT_LT(norm(get_value(batch_stress[0]) - get_value(cold_stress)), 1e-10 * norm(get_value(cold_stress)));
+    EXPECT_NEAR(batch_state[0].delta_eqps_guess, cold_state.accumulated_plastic_strain, 1e-12);
+  }
+}
+
 TEST(J2, FrameIndifference)
 {
   using Hardening = solid_mechanics::VoceHardening;
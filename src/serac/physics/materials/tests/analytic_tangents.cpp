@@ -0,0 +1,116 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file analytic_tangents.cpp
+ */
+
+#include "serac/physics/materials/solid_material.hpp"
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+
+#include "serac/numerics/functional/tensor.hpp"
+
+namespace serac {
+
+// clang-format off
+const tensor<double, 3, 3> H{{
+  { 0.025, -0.008,  0.005},
+  {-0.008, -0.01,   0.003},
+  { 0.005,  0.003,  0.0}}};
+
+const tensor<double, 3, 3> dH{{
+  {0.3, 0.4, 1.6},
+  {2.0, 0.2, 0.3},
+  {0.1, 1.7, 0.3}}};
+// clang-format on
+
+/**
+ * @brief compare the stress and tangent from stressWithAnalyticTangent against differentiating the material directly
+ *
+ * Both the full derivative (identity seeds) and a directional derivative (the kind of seeds that come out of
+ * the isoparametric map) are checked.
+ */
+template <typename Material, int dim>
+void check_analytic_tangent(const Material& material, const tensor<double, dim, dim>& du_dX,
+                            const tensor<double, dim, dim>& ddu_dX)
+{
+  static_assert(solid_mechanics::has_analytic_tangent<Material, dim>::value);
+
+  typename Material::State state_ad{};
+  typename Material::State state_analytic{};
+
+  auto stress_ad       = material(state_ad, make_dual(du_dX));
+  auto stress_analytic = solid_mechanics::stressWithAnalyticTangent(material, state_analytic, make_dual(du_dX));
+
+  EXPECT_LT(norm(get_value(stress_analytic) - get_value(stress_ad)), 1.0e-12 * norm(get_value(stress_ad)));
+  EXPECT_LT(norm(get_gradient(stress_analytic) - get_gradient(stress_ad)), 1.0e-10 * norm(get_gradient(stress_ad)));
+
+  auto directional = make_tensor<dim, dim>([&](int i, int j) { return dual<double>{du_dX[i][j], ddu_dX[i][j]}; });
+
+  state_ad       = typename Material::State{};
+  state_analytic = typename Material::State{};
+
+  auto dstress_ad       = get_gradient(material(state_ad, directional));
+  auto dstress_analytic = solid_mechanics::stressWithAnalyticTangent(material, state_analytic, directional);
+
+  EXPECT_LT(norm(get_gradient(dstress_analytic) - dstress_ad), 1.0e-10 * norm(dstress_ad));
+}
+
+TEST(AnalyticTangent, LinearIsotropic)
+{
+  solid_mechanics::LinearIsotropic material{.density = 1.0, .K = 100.0, .G = 40.0};
+  check_analytic_tangent(material, H, dH);
+}
+
+TEST(AnalyticTangent, StVenantKirchhoff)
+{
+  solid_mechanics::StVenantKirchhoff material{.density = 1.0, .K = 100.0, .G = 40.0};
+  check_analytic_tangent(material, H, dH);
+}
+
+TEST(AnalyticTangent, NeoHookean)
+{
+  solid_mechanics::NeoHookean material{.density = 1.0, .K = 100.0, .G = 40.0};
+  check_analytic_tangent(material, H, dH);
+
+  // plane strain
+  tensor<double, 2, 2> H2{{{0.025, -0.008}, {-0.004, -0.01}}};
+  tensor<double, 2, 2> dH2{{{0.3, 0.4}, {2.0, 0.2}}};
+  check_analytic_tangent(material, H2, dH2);
+}
+
+TEST(AnalyticTangent, J2SmallStrain)
+{
+  using Hardening = solid_mechanics::VoceHardening;
+  using Material  = solid_mechanics::J2SmallStrain<Hardening>;
+
+  Hardening hardening{.sigma_y = 350e6, .sigma_sat = 700e6, .strain_constant = 0.01};
+  Material  material{.E = 200.0e9, .nu = 0.25, .hardening = hardening, .Hk = 10.0e9, .density = 1.0};
+
+  // elastic
+  check_analytic_tangent(material, 1.0e-4 * H, dH);
+
+  // yielding, where the tangent is the consistent tangent of the return map
+  Material::State state{};
+  material(state, H);
+  ASSERT_GT(state.accumulated_plastic_strain, 1.0e-3);
+  check_analytic_tangent(material, H, dH);
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+
+  return result;
+}
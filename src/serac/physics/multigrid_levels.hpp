@@ -0,0 +1,280 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file multigrid_levels.hpp
+ *
+ * @brief The coarse levels of the multigrid preconditioners of a physics module
+ */
+
+#pragma once
+
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/numerics/equation_solver.hpp"
+#include "serac/numerics/functional/functional.hpp"
+#include "serac/physics/boundary_conditions/boundary_condition_manager.hpp"
+
+namespace serac {
+
+namespace detail {
+
+/// @brief The essential true dofs of the boundary conditions of a physics module on a coarse space
+inline mfem::Array<int> essentialTrueDofs(mfem::ParFiniteElementSpace& space, const BoundaryConditionManager& bcs)
+{
+  mfem::Array<int> all_dofs;
+  for (const auto& bc : bcs.essentials()) {
+    SLIC_ERROR_ROOT_IF(bc.markers().Size() == 0,
+                       "Multigrid preconditioners require boundary conditions defined by boundary attributes");
+
+    // a component of -1 constrains all of them
+    mfem::Array<int> dofs;
+    space.GetEssentialTrueDofs(bc.markers(), dofs, bc.component().value_or(-1));
+    all_dofs.Append(dofs);
+  }
+  all_dofs.Sort();
+  all_dofs.Unique();
+  return all_dofs;
+}
+
+}  // namespace detail
+
+/**
+ * @brief The residuals of a physics module on the coarse levels of a mesh hierarchy
+ *
+ * The coarse residuals only depend on the primal field. They are linearized once, about a zero state, to give the
+ * coarse operators of a GeometricMultigridPreconditioner, so they should describe the stiffness of the fine residual.
+ *
+ * @tparam function_space The space of the primal field, e.g. H1<order, dim>
+ */
+template <typename function_space>
+class MultigridLevels {
+public:
+  /**
+   * @brief Constructs the spaces and residuals of every coarse level
+   * @param[in] coarse_meshes The coarse meshes, coarsest first, e.g. from StateManager::coarseMeshes()
+   */
+  explicit MultigridLevels(const std::vector<std::unique_ptr<mfem::ParMesh>>& coarse_meshes)
+  {
+    for (auto& mesh : coarse_meshes) {
+      auto [space, fec] = generateParFiniteElementSpace<function_space>(mesh.get());
+
+      std::array<const mfem::ParFiniteElementSpace*, 1> trial_spaces{space.get()};
+      residuals_.push_back(std::make_unique<Functional<function_space(function_space)>>(space.get(), trial_spaces));
+
+      meshes_.push_back(mesh.get());
+      spaces_.push_back(std::move(space));
+      collections_.push_back(std::move(fec));
+    }
+  }
+
+  /**
+   * @brief Adds a domain integral to the residual of every coarse level
+   *
+   * @tparam dim The dimension of the elements
+   * @tparam QFunction The type of the quadrature function
+   * @param[in] qfunction A function of the time, the position and the primal field, see Functional
+   */
+  template <int dim, typename QFunction>
+  void addDomainIntegral(Dimension<dim>, const QFunction& qfunction)
+  {
+    for (std::size_t level = 0; level < residuals_.size(); level++) {
+      residuals_[level]->AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qfunction, *meshes_[level]);
+    }
+  }
+
+  /**
+   * @brief Gives the coarse levels to a geometric multigrid preconditioner
+   *
+   * @param[inout] preconditioner The preconditioner of the physics module
+   * @param[in] fine_space The space of the primal field on the mesh given to StateManager::setMeshHierarchy()
+   * @param[in] bcs The boundary conditions of the physics module, which must be defined by boundary attributes
+   */
+  void setup(GeometricMultigridPreconditioner& preconditioner, const mfem::ParFiniteElementSpace& fine_space,
+             const BoundaryConditionManager& bcs)
+  {
+    if (residuals_.empty()) {
+      return;
+    }
+
+    // the gradients (and the operators constrained from them) are owned by the residuals
+    std::vector<std::unique_ptr<mfem::Operator>> operators;
+    std::vector<std::unique_ptr<mfem::Operator>> prolongations;
+    std::vector<mfem::Array<int>>                essential_dofs;
+    std::unique_ptr<mfem::HypreParMatrix>        coarsest;
+
+    for (std::size_t level = 0; level < residuals_.size(); level++) {
+      auto& space = *spaces_[level];
+      essential_dofs.push_back(detail::essentialTrueDofs(space, bcs));
+
+      mfem::Vector zero(space.TrueVSize());
+      zero = 0.0;
+
+      auto [r, drdu] = (*residuals_[level])(0.0, differentiate_wrt(zero));
+      if (level == 0) {
+        coarsest = assemble(drdu);
+        std::unique_ptr<mfem::HypreParMatrix> eliminated(coarsest->EliminateRowsCols(essential_dofs.back()));
+      } else {
+        operators.push_back(std::make_unique<mfem::ConstrainedOperator>(&drdu, essential_dofs.back()));
+      }
+
+      const auto& finer = (level + 1 < residuals_.size()) ? *spaces_[level + 1] : fine_space;
+      prolongations.push_back(std::make_unique<mfem::TrueTransferOperator>(space, finer));
+    }
+
+    preconditioner.setCoarseLevels(std::move(coarsest), *spaces_[0], std::move(operators), std::move(prolongations),
+                                   std::move(essential_dofs));
+  }
+
+private:
+  /// @brief The coarse meshes, owned by the StateManager
+  std::vector<mfem::ParMesh*> meshes_;
+
+  /// @brief The finite element collections of the coarse spaces
+  std::vector<std::unique_ptr<mfem::FiniteElementCollection>> collections_;
+
+  /// @brief The space of the primal field on each coarse level
+  std::vector<std::unique_ptr<mfem::ParFiniteElementSpace>> spaces_;
+
+  /// @brief The residual on each coarse level
+  std::vector<std::unique_ptr<Functional<function_space(function_space)>>> residuals_;
+};
+
+/**
+ * @brief The residuals of a physics module for the lower polynomial orders of its H1 space, on the same mesh
+ *
+ * The coarse levels have the orders order / 2, order / 4, ..., 1, so only the p = 1 operator is assembled. As with
+ * MultigridLevels, the coarse residuals only depend on the primal field and are linearized about a zero state.
+ *
+ * @tparam order The polynomial order of the primal field
+ * @tparam components The number of components of the primal field
+ */
+template <int order, int components = 1>
+class PMultigridLevels {
+  /// @brief Returns the number of times the order can be halved before reaching 1
+  static constexpr int countCoarseLevels()
+  {
+    int levels = 0;
+    for (int p = order; p > 1; p /= 2) {
+      levels++;
+    }
+    return levels;
+  }
+
+public:
+  /// @brief The number of coarse levels
+  static constexpr int num_coarse_levels = countCoarseLevels();
+
+  /// @brief The space of the primal field on a coarse level, coarsest first
+  template <int level>
+  using coarse_space = H1<(order >> (num_coarse_levels - level)), components>;
+
+  /**
+   * @brief Constructs the spaces and residuals of every coarse level
+   * @param[in] mesh The mesh of the physics module
+   */
+  explicit PMultigridLevels(mfem::ParMesh& mesh) : mesh_(mesh)
+  {
+    for_constexpr<num_coarse_levels>([&](auto level) {
+      using space_type  = coarse_space<level>;
+      auto [space, fec] = generateParFiniteElementSpace<space_type>(&mesh_);
+
+      std::array<const mfem::ParFiniteElementSpace*, 1> trial_spaces{space.get()};
+      std::get<level>(residuals_) = std::make_unique<Functional<space_type(space_type)>>(space.get(), trial_spaces);
+
+      spaces_.push_back(std::move(space));
+      collections_.push_back(std::move(fec));
+    });
+  }
+
+  /**
+   * @brief Adds a domain integral to the residual of every coarse level
+   *
+   * @tparam dim The dimension of the elements
+   * @tparam QFunction The type of the quadrature function
+   * @param[in] qfunction A function of the time, the position and the primal field, see Functional
+   */
+  template <int dim, typename QFunction>
+  void addDomainIntegral(Dimension<dim>, const QFunction& qfunction)
+  {
+    for_constexpr<num_coarse_levels>([&](auto level) {
+      std::get<level>(residuals_)->AddDomainIntegral(Dimension<dim>{}, DependsOn<0>{}, qfunction, mesh_);
+    });
+  }
+
+  /**
+   * @brief Gives the coarse levels to a p-multigrid preconditioner
+   *
+   * @param[inout] preconditioner The preconditioner of the physics module
+   * @param[in] fine_space The space of the primal field, of order @p order
+   * @param[in] bcs The boundary conditions of the physics module, which must be defined by boundary attributes
+   */
+  void setup(GeometricMultigridPreconditioner& preconditioner, const mfem::ParFiniteElementSpace& fine_space,
+             const BoundaryConditionManager& bcs)
+  {
+    if constexpr (num_coarse_levels > 0) {
+      // the gradients (and the operators constrained from them) are owned by the residuals
+      std::vector<std::unique_ptr<mfem::Operator>> operators;
+      std::vector<std::unique_ptr<mfem::Operator>> prolongations;
+      std::vector<mfem::Array<int>>                essential_dofs;
+      std::unique_ptr<mfem::HypreParMatrix>        coarsest;
+
+      for_constexpr<num_coarse_levels>([&](auto level) {
+        auto& space = *spaces_[level];
+        essential_dofs.push_back(detail::essentialTrueDofs(space, bcs));
+
+        mfem::Vector zero(space.TrueVSize());
+        zero = 0.0;
+
+        auto [r, drdu] = (*std::get<level>(residuals_))(0.0, differentiate_wrt(zero));
+        if constexpr (level == 0) {
+          coarsest = assemble(drdu);
+          std::unique_ptr<mfem::HypreParMatrix> eliminated(coarsest->EliminateRowsCols(essential_dofs.back()));
+        } else {
+          operators.push_back(std::make_unique<mfem::ConstrainedOperator>(&drdu, essential_dofs.back()));
+        }
+
+        // on the same mesh, this is the interpolation from the lower order space
+        const auto& finer = (level + 1 < num_coarse_levels) ? *spaces_[level + 1] : fine_space;
+        prolongations.push_back(std::make_unique<mfem::TrueTransferOperator>(space, finer));
+      });
+
+      preconditioner.setCoarseLevels(std::move(coarsest), *spaces_[0], std::move(operators), std::move(prolongations),
+                                     std::move(essential_dofs));
+    }
+  }
+
+private:
+  /// @brief The types of the residuals of every coarse level
+  template <typename levels>
+  struct Residuals;
+
+  /// @cond
+  template <int... levels>
+  struct Residuals<std::integer_sequence<int, levels...>> {
+    using type = std::tuple<std::unique_ptr<Functional<coarse_space<levels>(coarse_space<levels>)>>...>;
+  };
+  /// @endcond
+
+  /// @brief The mesh of the physics module
+  mfem::ParMesh& mesh_;
+
+  /// @brief The finite element collections of the coarse spaces
+  std::vector<std::unique_ptr<mfem::FiniteElementCollection>> collections_;
+
+  /// @brief The space of the primal field on each coarse level
+  std::vector<std::unique_ptr<mfem::ParFiniteElementSpace>> spaces_;
+
+  /// @brief The residual on each coarse level
+  typename Residuals<std::make_integer_sequence<int, num_coarse_levels>>::type residuals_;
+};
+
+}  // namespace serac
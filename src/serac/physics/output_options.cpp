@@ -0,0 +1,63 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/output_options.hpp"
+
+namespace serac {
+
+void OutputOptions::defineInputFileSchema(axom::inlet::Container& container)
+{
+  container.addInt("cycle_interval", "Number of cycles between outputs").defaultValue(1).range(1, 1000000000);
+  container.addDouble("time_interval", "Simulation time between outputs, overrides cycle_interval if positive");
+  container.addStringArray("fields", "Names of the fields written for visualization (all of them if not given)");
+  container.addIntArray("element_attributes", "Element attributes of the mesh subset written for visualization");
+  container.addInt("visualization_order", "Lower polynomial order to interpolate the visualized fields to")
+      .range(1, 8);
+  container.addBool("single_precision_visualization", "Whether the visualized fields are written in single precision")
+      .defaultValue(false);
+  container.addString("solver_telemetry_file", "File to append the solver telemetry of each timestep to (JSON lines)");
+  container.addBool("write_to_disk", "Whether the output is written to disk, in addition to any in-situ pipeline")
+      .defaultValue(true);
+}
+
+}  // namespace serac
+
+serac::OutputOptions FromInlet<serac::OutputOptions>::operator()(const axom::inlet::Container& base)
+{
+  serac::OutputOptions result;
+
+  result.cycle_interval = base["cycle_interval"];
+
+  if (base.contains("time_interval")) {
+    result.time_interval = base["time_interval"];
+  }
+
+  if (base.contains("fields")) {
+    for (const auto& [_, name] : base["fields"].get<std::unordered_map<int, std::string>>()) {
+      result.fields.push_back(name);
+    }
+  }
+
+  if (base.contains("element_attributes")) {
+    for (const auto& [_, attribute] : base["element_attributes"].get<std::unordered_map<int, int>>()) {
+      result.element_attributes.push_back(attribute);
+    }
+  }
+
+  if (base.contains("visualization_order")) {
+    result.visualization_order = base["visualization_order"];
+  }
+
+  result.single_precision_visualization = base["single_precision_visualization"];
+
+  if (base.contains("solver_telemetry_file")) {
+    result.solver_telemetry_file = base["solver_telemetry_file"].get<std::string>();
+  }
+
+  result.write_to_disk = base["write_to_disk"];
+
+  return result;
+}
@@ -0,0 +1,69 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file output_options.hpp
+ *
+ * @brief An object containing the options controlling how often and which fields the physics modules output
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "serac/infrastructure/input.hpp"
+
+namespace serac {
+
+/**
+ * @brief Controls for the output written by BasePhysics::writeOutput()
+ */
+struct OutputOptions {
+  /**
+   * @brief Input file parameters for the output options
+   *
+   * @param[in] container Inlet's Container that input files will be added to
+   **/
+  static void defineInputFileSchema(axom::inlet::Container& container);
+
+  /// Write the output every this many cycles
+  int cycle_interval = 1;
+
+  /// If positive, write the output every time the simulation time crosses a multiple of this interval instead
+  double time_interval = 0.0;
+
+  /// The names of the states, duals, parameters and sensitivities written for visualization, or all of them if empty
+  std::vector<std::string> fields = {};
+
+  /// The element attributes of the part of the mesh written for visualization, or the whole mesh if empty
+  std::vector<int> element_attributes = {};
+
+  /// If positive, the fields are interpolated to this (lower) polynomial order for visualization
+  int visualization_order = 0;
+
+  /// Whether the fields are written for visualization in single precision, which halves the size of the (lossy)
+  /// visualization files without affecting the restart output
+  bool single_precision_visualization = false;
+
+  /// If not empty, the solver telemetry of each committed timestep is appended to this file as a line of JSON
+  std::string solver_telemetry_file = "";
+
+  /// Whether writeOutput() writes the Sidre (and paraview) files, which may be turned off when the output only goes to
+  /// an in-situ pipeline, see BasePhysics::setInSituPipeline()
+  bool write_to_disk = true;
+};
+
+}  // namespace serac
+
+/**
+ * @brief Prepare the output options from an input file
+ */
+template <>
+struct FromInlet<serac::OutputOptions> {
+  /// @brief Returns created object from Inlet container
+  serac::OutputOptions operator()(const axom::inlet::Container& base);
+};
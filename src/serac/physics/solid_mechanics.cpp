@@ -12,17 +12,27 @@ namespace solid_mechanics {
 
 namespace detail {
 
-void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix* m_mat, mfem::HypreParMatrix* k_mat,
-                       mfem::HypreParVector& disp_adjoint_load_vector, mfem::HypreParVector& velo_adjoint_load_vector,
-                       mfem::HypreParVector& accel_adjoint_load_vector, mfem::HypreParVector& adjoint_displacement_,
+// there are hard-coded here for now
+static constexpr double beta  = 0.25;
+static constexpr double gamma = 0.5;
+
+std::unique_ptr<mfem::HypreParMatrix> adjoint_operator(double dt_n, const mfem::HypreParMatrix& m_mat,
+                                                       const mfem::HypreParMatrix& k_mat)
+{
+  // J = M + c0 * K
+  // m_mat and k_mat are already transposed, so this is J^T
+  return std::unique_ptr<mfem::HypreParMatrix>(mfem::Add(1.0, m_mat, beta * dt_n * dt_n, k_mat));
+}
+
+void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix& J_T, mfem::HypreParMatrix& J_T_e,
+                       mfem::HypreParMatrix* k_mat, mfem::HypreParVector& disp_adjoint_load_vector,
+                       mfem::HypreParVector& velo_adjoint_load_vector, mfem::HypreParVector& accel_adjoint_load_vector,
+                       mfem::HypreParVector& adjoint_displacement_,
                        mfem::HypreParVector& implicit_sensitivity_displacement_start_of_step_,
                        mfem::HypreParVector& implicit_sensitivity_velocity_start_of_step_,
                        mfem::HypreParVector& adjoint_essential, BoundaryConditionManager& bcs_,
                        mfem::Solver& lin_solver)
 {
-  // there are hard-coded here for now
-  static constexpr double beta  = 0.25;
-  static constexpr double gamma = 0.5;
   // reminder, gathering info from the various layers of time integration
   // c0 = fac3 * dt * dt
   // c1 = fac4 * dt
@@ -32,10 +42,6 @@ void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix* m_mat,
   double fac3 = beta;
   double fac4 = gamma;
 
-  // J = M + c0 * K
-  auto J_  = std::unique_ptr<mfem::HypreParMatrix>(mfem::Add(1.0, *m_mat, fac3 * dt_n * dt_n, *k_mat));
-  auto J_T = std::unique_ptr<mfem::HypreParMatrix>(J_->Transpose());
-
   // recall that temperature_adjoint_load_vector and d_temperature_dt_adjoint_load_vector were already multiplied by
   // -1 above
 
@@ -47,11 +53,8 @@ void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix* m_mat,
   adjoint_rhs.Add(-dt_np1 * dt_np1 * fac1 - dt_n * dt_n * fac3 - dt_n * dt_np1 * fac4,
                   implicit_sensitivity_displacement_start_of_step_);
 
-  for (const auto& bc : bcs_.essentials()) {
-    bc.apply(*J_T, adjoint_rhs, adjoint_essential);
-  }
+  mfem::EliminateBC(J_T, J_T_e, bcs_.allEssentialTrueDofs(), adjoint_essential, adjoint_rhs);
 
-  lin_solver.SetOperator(*J_T);
   // really adjoint acceleration
   lin_solver.Mult(adjoint_rhs, adjoint_displacement_);
 
@@ -60,11 +63,21 @@ void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix* m_mat,
   implicit_sensitivity_velocity_start_of_step_.Add(dt_np1, implicit_sensitivity_displacement_start_of_step_);
 
   // the 1.0, 1.0 means += the implicit sensitivity
-  k_mat->MultTranspose(adjoint_displacement_, implicit_sensitivity_displacement_start_of_step_, 1.0, 1.0);
+  k_mat->Mult(adjoint_displacement_, implicit_sensitivity_displacement_start_of_step_, 1.0, 1.0);
 
   implicit_sensitivity_displacement_start_of_step_.Add(-1.0, disp_adjoint_load_vector);
 }
 
 }  // namespace detail
 }  // namespace solid_mechanics
+
+/// @cond
+template class SolidMechanics<1, 2>;
+template class SolidMechanics<1, 3>;
+template class SolidMechanics<2, 2>;
+template class SolidMechanics<2, 3>;
+template class SolidMechanics<3, 2>;
+template class SolidMechanics<3, 3>;
+/// @endcond
+
 }  // namespace serac
\ No newline at end of file
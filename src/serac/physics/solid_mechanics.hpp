@@ -12,15 +12,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 #include "mfem.hpp"
 
 #include "serac/infrastructure/initialize.hpp"
 #include "serac/physics/common.hpp"
 #include "serac/physics/solid_mechanics_input.hpp"
 #include "serac/physics/base_physics.hpp"
+#include "serac/numerics/modal_superposition.hpp"
 #include "serac/numerics/odes.hpp"
+#include "serac/numerics/static_condensation.hpp"
 #include "serac/numerics/stdfunction_operator.hpp"
 #include "serac/numerics/functional/shape_aware_functional.hpp"
+#include "serac/physics/condensed_pressure.hpp"
+#include "serac/physics/low_order_refined.hpp"
+#include "serac/physics/multigrid_levels.hpp"
 #include "serac/physics/state/state_manager.hpp"
 #include "serac/physics/materials/solid_material.hpp"
 
@@ -29,16 +39,68 @@ namespace serac {
 namespace solid_mechanics {
 
 namespace detail {
+/**
+ * @brief forms the operator of the transient adjoint solves, J^T = M^T + c0 K^T
+ *
+ * @note m_mat and k_mat are the transposes of the mass and stiffness matrices, see
+ * BasePhysics::assembleAdjointOperator()
+ */
+std::unique_ptr<mfem::HypreParMatrix> adjoint_operator(double dt_n, const mfem::HypreParMatrix& m_mat,
+                                                       const mfem::HypreParMatrix& k_mat);
+
 /**
  * @brief integrates part of the adjoint equations backward in time
+ *
+ * @note J_T is the operator from adjoint_operator(), with its essential rows and columns already eliminated into
+ * J_T_e, and is expected to be the operator of lin_solver. k_mat is the transpose of the stiffness matrix.
  */
-void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix* m_mat, mfem::HypreParMatrix* k_mat,
-                       mfem::HypreParVector& disp_adjoint_load_vector, mfem::HypreParVector& velo_adjoint_load_vector,
-                       mfem::HypreParVector& accel_adjoint_load_vector, mfem::HypreParVector& adjoint_displacement_,
+void adjoint_integrate(double dt_n, double dt_np1, mfem::HypreParMatrix& J_T, mfem::HypreParMatrix& J_T_e,
+                       mfem::HypreParMatrix* k_mat, mfem::HypreParVector& disp_adjoint_load_vector,
+                       mfem::HypreParVector& velo_adjoint_load_vector, mfem::HypreParVector& accel_adjoint_load_vector,
+                       mfem::HypreParVector& adjoint_displacement_,
                        mfem::HypreParVector& implicit_sensitivity_displacement_start_of_step_,
                        mfem::HypreParVector& implicit_sensitivity_velocity_start_of_step_,
                        mfem::HypreParVector& adjoint_essential, BoundaryConditionManager& bcs_,
                        mfem::Solver& lin_solver);
+
+/// @brief Whether a material type is described by a bulk and shear modulus
+template <typename MaterialType, typename = void>
+struct has_bulk_and_shear_moduli : std::false_type {};
+
+/// @overload
+template <typename MaterialType>
+struct has_bulk_and_shear_moduli<MaterialType, std::void_t<decltype(MaterialType::K), decltype(MaterialType::G)>>
+    : std::true_type {};
+
+/// @brief Whether a material type is described by a Young's modulus and Poisson ratio
+template <typename MaterialType, typename = void>
+struct has_youngs_modulus_and_poisson_ratio : std::false_type {};
+
+/// @overload
+template <typename MaterialType>
+struct has_youngs_modulus_and_poisson_ratio<MaterialType,
+                                            std::void_t<decltype(MaterialType::E), decltype(MaterialType::nu)>>
+    : std::true_type {};
+
+/**
+ * @brief The small strain dilatational (P-wave) speed of a material, sqrt((K + 4/3 G) / rho)
+ *
+ * @return The wave speed, or 0 if the material does not expose its elastic moduli
+ */
+template <typename MaterialType>
+double dilatationalWaveSpeed(const MaterialType& material)
+{
+  if constexpr (has_bulk_and_shear_moduli<MaterialType>::value) {
+    return std::sqrt((material.K + 4.0 / 3.0 * material.G) / material.density);
+  } else if constexpr (has_youngs_modulus_and_poisson_ratio<MaterialType>::value) {
+    double E  = material.E;
+    double nu = material.nu;
+    return std::sqrt(E * (1.0 - nu) / ((1.0 + nu) * (1.0 - 2.0 * nu) * material.density));
+  } else {
+    return 0.0;
+  }
+}
+
 }  // namespace detail
 
 /**
@@ -78,6 +140,50 @@ const TimesteppingOptions default_quasistatic_options = {TimestepMethod::QuasiSt
 const TimesteppingOptions default_timestepping_options = {TimestepMethod::Newmark,
                                                           DirichletEnforcementMethod::RateControl};
 
+/**
+ * @brief The internal variables of a material, along with the derived quantities that are recorded with them at each
+ * quadrature point, see SolidMechanics::setMaterialWithOutputs()
+ */
+template <typename State, int n>
+struct StateWithOutputs {
+  State             material_state{};  ///< the internal variables of the material
+  tensor<double, n> outputs{};         ///< the derived quantities, in the order they were registered
+};
+
+/// @brief The von Mises equivalent stress, sqrt(3/2 s : s) with s the deviator of the Cauchy stress
+struct VonMisesStress {
+  /// @brief the derived quantity at a quadrature point
+  template <typename State, int dim>
+  double operator()(const State&, const tensor<double, dim, dim>&, const tensor<double, dim, dim>& stress) const
+  {
+    auto s = dev(stress);
+    return std::sqrt(1.5 * inner(s, s));
+  }
+};
+
+/// @brief The accumulated (equivalent) plastic strain of a material whose state records it, e.g. J2
+struct EquivalentPlasticStrain {
+  /// @brief the derived quantity at a quadrature point
+  template <typename State, int dim>
+  double operator()(const State& state, const tensor<double, dim, dim>&, const tensor<double, dim, dim>&) const
+  {
+    return state.accumulated_plastic_strain;
+  }
+};
+
+/**
+ * @brief The strain energy density of linear elasticity, 1/2 sigma : epsilon
+ * @note it is only an estimate of the stored energy of nonlinear or inelastic materials
+ */
+struct StrainEnergyDensity {
+  /// @brief the derived quantity at a quadrature point
+  template <typename State, int dim>
+  double operator()(const State&, const tensor<double, dim, dim>& du_dX, const tensor<double, dim, dim>& stress) const
+  {
+    return 0.5 * inner(stress, sym(du_dX));
+  }
+};
+
 }  // namespace solid_mechanics
 
 template <int order, int dim, typename parameters = Parameters<>,
@@ -195,10 +301,27 @@ public:
     if (timestepping_opts.timestepper != TimestepMethod::QuasiStatic) {
       ode2_.SetTimestepper(timestepping_opts.timestepper);
       ode2_.SetEnforcementMethod(timestepping_opts.enforcement_method);
+      ode2_.SetTimestepControl(timestepping_opts, mesh_.GetComm());
       is_quasistatic_ = false;
     } else {
       is_quasistatic_ = true;
     }
+    max_cutbacks_                = timestepping_opts.max_cutbacks;
+    target_nonlinear_iterations_ = timestepping_opts.target_nonlinear_iterations;
+    min_increment_               = timestepping_opts.min_dt;
+    max_increment_               = timestepping_opts.max_dt;
+
+    predictor_ = timestepping_opts.predictor == Predictor::Default ? Predictor::LinearizedBoundaryConditions
+                                                                   : timestepping_opts.predictor;
+    extrapolation_order_ = timestepping_opts.extrapolation_order;
+    SLIC_ERROR_ROOT_IF(predictor_ == Predictor::Extrapolation && (extrapolation_order_ < 1 || extrapolation_order_ > 2),
+                       axom::fmt::format("Predictor::Extrapolation supports orders 1 and 2, but {} was requested",
+                                         extrapolation_order_));
+
+    explicit_dynamics_ = timestepping_opts.timestepper == TimestepMethod::CentralDifference;
+    cfl_number_        = timestepping_opts.cfl_number;
+    SLIC_ERROR_ROOT_IF(explicit_dynamics_ && timestepping_opts.adaptive,
+                       "Adaptive time stepping is not supported by explicit (CentralDifference) solid dynamics");
 
     states_.push_back(&displacement_);
     if (!is_quasistatic_) {
@@ -239,14 +362,31 @@ public:
 
     // If the user wants the AMG preconditioner with a linear solver, set the pfes
     // to be the displacement
-    auto* amg_prec = dynamic_cast<mfem::HypreBoomerAMG*>(&nonlin_solver_->preconditioner());
-    if (amg_prec) {
-      // amg_prec->SetElasticityOptions(&displacement_.space());
+    mfem::Solver* prec = &nonlin_solver_->preconditioner();
+    if (auto* reusable = dynamic_cast<ReusablePreconditioner*>(prec)) {
+      prec = &reusable->underlying();
+    }
+    if (auto* amg_prec = dynamic_cast<mfem::HypreBoomerAMG*>(prec)) {
+      // the rigid body modes have entries for all the true dofs, and statically condensed systems only the skeleton
+      // ones, so those only get the systems options
+      if (nonlin_solver_->staticCondensation()) {
+        amg_prec->SetSystemsOptions(dim, displacement_.space().GetOrdering() == mfem::Ordering::byNODES);
+      } else {
+        rigid_body_modes_ = setElasticityOptions(*amg_prec, displacement_.space());
+      }
+    }
 
-      // TODO: The above call was seg faulting in the HYPRE_BoomerAMGSetInterpRefine(amg_precond, interp_refine)
-      // method as of Hypre version v2.26.0. Instead, we just set the system size for Hypre. This is a temporary work
-      // around as it will decrease the effectiveness of the preconditioner.
-      amg_prec->SetSystemsOptions(dim, true);
+    // the coarse levels of geometric multigrid come from the mesh hierarchy given to the StateManager, and those of
+    // p-multigrid from the lower polynomial orders on the same mesh. LOR builds its own low-order refined mesh.
+    if (auto* p_multigrid = dynamic_cast<PMultigridPreconditioner*>(prec)) {
+      multigrid_          = p_multigrid;
+      p_multigrid_levels_ = std::make_unique<PMultigridLevels<order, dim>>(mesh_);
+    } else if (auto* lor = dynamic_cast<LORPreconditioner*>(prec)) {
+      lor_preconditioner_ = lor;
+      low_order_refined_  = std::make_unique<LowOrderRefined<dim>>(displacement_.space());
+    } else if (auto* multigrid = dynamic_cast<GeometricMultigridPreconditioner*>(prec)) {
+      multigrid_        = multigrid;
+      multigrid_levels_ = std::make_unique<MultigridLevels<H1<order, dim>>>(StateManager::coarseMeshes(mesh_tag_));
     }
 
     int true_size = velocity_.space().TrueVSize();
@@ -362,8 +502,9 @@ public:
    */
   void initializeSolidMechanicsStates()
   {
-    c0_ = 0.0;
-    c1_ = 0.0;
+    c0_          = 0.0;
+    c1_          = 0.0;
+    jacobian_c0_ = -1.0;
 
     displacement_ = 0.0;
     velocity_     = 0.0;
@@ -377,7 +518,8 @@ public:
     implicit_sensitivity_displacement_start_of_step_ = 0.0;
     implicit_sensitivity_velocity_start_of_step_     = 0.0;
 
-    reactions_ = 0.0;
+    reactions_         = 0.0;
+    has_staged_states_ = false;
 
     u_                      = 0.0;
     v_                      = 0.0;
@@ -385,15 +527,8 @@ public:
     dr_                     = 0.0;
     predicted_displacement_ = 0.0;
 
-    if (checkpoint_to_disk_) {
-      outputStateToDisk();
-    } else {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
-    }
+    clearCheckpointedStates();
+    checkpointStates();
   }
 
   /// @overload
@@ -422,7 +557,7 @@ public:
     if (dim == 2) {
       geometries = {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE};
     } else {
-      geometries = {mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE};
+      geometries = {mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM};
     }
 
     for (auto geom : geometries) {
@@ -449,6 +584,7 @@ public:
     disp_bdr_coef_ = std::make_shared<mfem::VectorFunctionCoefficient>(dim, disp);
 
     bcs_.addEssential(disp_bdr, disp_bdr_coef_, displacement_.space());
+    bcs_.essentials().back().setSeparableInTime();
   }
 
   /**
@@ -490,6 +626,7 @@ public:
     component_disp_bdr_coef_ = std::make_shared<mfem::FunctionCoefficient>(disp);
 
     bcs_.addEssential(disp_bdr, component_disp_bdr_coef_, displacement_.space(), component);
+    bcs_.essentials().back().setSeparableInTime();
   }
 
   /**
@@ -538,6 +675,7 @@ public:
     disp_bdr_coef_ = std::make_shared<mfem::VectorFunctionCoefficient>(dim, disp);
 
     bcs_.addEssential(true_dofs, disp_bdr_coef_, displacement_.space());
+    bcs_.essentials().back().setSeparableInTime();
   }
 
   /**
@@ -674,13 +812,19 @@ public:
     if (state_name == "displacement") {
       displacement_ = state;
       if (!checkpoint_to_disk_) {
-        checkpoint_states_["displacement"][static_cast<size_t>(cycle_)] = displacement_;
+        updateCheckpointedState("displacement", displacement_);
       }
       return;
     } else if (state_name == "velocity") {
       velocity_ = state;
       if (!checkpoint_to_disk_) {
-        checkpoint_states_["velocity"][static_cast<size_t>(cycle_)] = velocity_;
+        updateCheckpointedState("velocity", velocity_);
+      }
+      return;
+    } else if (state_name == "acceleration") {
+      acceleration_ = state;
+      if (!checkpoint_to_disk_) {
+        updateCheckpointedState("acceleration", acceleration_);
       }
       return;
     }
@@ -727,8 +871,11 @@ public:
   {
     Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
 
-    residual_->AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-                                   qfunction, domain);
+    addResidualIntegral([qfunction, domain](residual_type& residual, const std::optional<Domain>&) {
+      Domain boundary = domain;
+      residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                   qfunction, boundary);
+    });
   }
 
   /// @overload
@@ -806,8 +953,12 @@ public:
   void addCustomDomainIntegral(DependsOn<active_parameters...>, callable qfunction,
                                qdata_type<StateType> qdata = NoQData)
   {
-    residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{}, qfunction,
-                                 mesh_, qdata);
+    stageQuadratureData(qdata);
+    addResidualIntegral([this, qfunction, qdata](residual_type& residual, const std::optional<Domain>& band) {
+      Domain domain = restrictToBand<StateType>(EntireDomain(mesh_), band);
+      residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                 qfunction, domain, qdata);
+    });
   }
 
   /**
@@ -817,7 +968,10 @@ public:
   template <typename Material>
   struct MaterialStressFunctor {
     /// @brief Constructor for the functor
-    MaterialStressFunctor(Material material, GeometricNonlinearities gn) : material_(material), geom_nonlin_(gn) {}
+    MaterialStressFunctor(Material material, GeometricNonlinearities gn, bool deviatoric = false)
+        : material_(material), geom_nonlin_(gn), deviatoric_(deviatoric)
+    {
+    }
 
     /// @brief Material model
     Material material_;
@@ -825,6 +979,9 @@ public:
     /// @brief Enum value for geometric nonlinearities
     GeometricNonlinearities geom_nonlin_;
 
+    /// @brief Whether only the deviatoric part of the stress is kept, see setMixedMaterial()
+    bool deviatoric_;
+
     /**
      * @brief Material stress response call
      *
@@ -847,7 +1004,17 @@ public:
       auto du_dX   = get<DERIVATIVE>(displacement);
       auto d2u_dt2 = get<VALUE>(acceleration);
 
-      auto stress = material_(state, du_dX, params...);
+      auto stress = [&]() {
+        if constexpr (uses_analytic_tangent<decltype(du_dX), Params...>) {
+          return solid_mechanics::stressWithAnalyticTangent(material_, state, du_dX);
+        } else {
+          return material_(state, du_dX, params...);
+        }
+      }();
+
+      if (deviatoric_) {
+        stress = dev(stress);
+      }
 
       auto dx_dX = 0.0 * du_dX + I;
 
@@ -859,6 +1026,156 @@ public:
 
       return serac::tuple{material_.density * d2u_dt2, flux};
     }
+
+    /// @brief whether the derivatives of the stress come from the material's analytic tangent, see has_analytic_tangent
+    template <typename DisplacementGradient, typename... Params>
+    static constexpr bool uses_analytic_tangent = sizeof...(Params) == 0 &&
+                                                  is_tensor_of_dual_number<DisplacementGradient>::value &&
+                                                  solid_mechanics::has_analytic_tangent<Material, dim>::value;
+
+    /// @brief materials with a batched stress update are evaluated at all of an element's quadrature points at once
+    static constexpr bool batched = qfunction_is_batched<Material>::value;
+
+    /**
+     * @brief Material stress response at all of an element's quadrature points, see qfunction_is_batched
+     *
+     * @param[in] positions The spatial position at each quadrature point
+     * @param[inout] states The state at each quadrature point
+     * @param[in] displacement The displacement at each quadrature point
+     * @param[in] acceleration The acceleration at each quadrature point
+     * @param[in] params The parameters at each quadrature point
+     * @return The material response at each quadrature point
+     */
+    template <int n, typename X, typename State, typename Displacement, typename Acceleration, typename... Params>
+    auto batch(double t, const tensor<X, n>& positions, tensor<State, n>& states,
+               const tensor<Displacement, n>& displacement, const tensor<Acceleration, n>& acceleration,
+               const tensor<Params, n>&... params) const
+    {
+      using output_type = decltype((*this)(t, positions[0], states[0], displacement[0], acceleration[0], params[0]...));
+      tensor<output_type, n> outputs{};
+
+      using du_dX_type = std::decay_t<decltype(get<DERIVATIVE>(displacement[0]))>;
+      if constexpr (sizeof...(Params) > 0 || uses_analytic_tangent<du_dX_type>) {
+        // parameterized stress updates are not batched (yet), and analytic tangents are cheaper pointwise
+        for (int i = 0; i < n; i++) {
+          outputs[i] = (*this)(t, positions[i], states[i], displacement[i], acceleration[i], params[i]...);
+        }
+      } else {
+        tensor<du_dX_type, n> du_dX{};
+        for (int i = 0; i < n; i++) {
+          du_dX[i] = get<DERIVATIVE>(displacement[i]);
+        }
+
+        auto stresses = material_.batch(states, du_dX);
+
+        for (int i = 0; i < n; i++) {
+          auto d2u_dt2 = get<VALUE>(acceleration[i]);
+          auto dx_dX   = 0.0 * du_dX[i] + I;
+          if (geom_nonlin_ == GeometricNonlinearities::On) {
+            dx_dX += du_dX[i];
+          }
+          auto flux  = dot(stresses[i], transpose(inv(dx_dX))) * det(dx_dX);
+          outputs[i] = serac::tuple{material_.density * d2u_dt2, flux};
+        }
+      }
+
+      return outputs;
+    }
+  };
+
+  /**
+   * @brief Functor representing a material stress on the coarse levels of multigrid, where the internal
+   * variables keep their initial values and there is no acceleration
+   */
+  template <typename Material>
+  struct CoarseMaterialStressFunctor {
+    /// @brief Constructor for the functor
+    CoarseMaterialStressFunctor(Material material, GeometricNonlinearities gn) : material_(material), geom_nonlin_(gn)
+    {
+    }
+
+    /// @brief Material model
+    Material material_;
+
+    /// @brief Enum value for geometric nonlinearities
+    GeometricNonlinearities geom_nonlin_;
+
+    /**
+     * @brief Material stress response call
+     *
+     * @tparam X Spatial position type
+     * @tparam Displacement displacement
+     * @param[in] displacement displacement
+     * @return The calculated material response (tuple of zero source and stress flux)
+     */
+    template <typename X, typename Displacement>
+    auto SERAC_HOST_DEVICE operator()(double, X, Displacement displacement) const
+    {
+      auto du_dX = get<DERIVATIVE>(displacement);
+
+      typename Material::State state{};
+      auto                     stress = material_(state, du_dX);
+
+      auto dx_dX = 0.0 * du_dX + I;
+
+      if (geom_nonlin_ == GeometricNonlinearities::On) {
+        dx_dX += du_dX;
+      }
+
+      auto flux = dot(stress, transpose(inv(dx_dX))) * det(dx_dX);
+
+      return serac::tuple{0.0 * get<VALUE>(displacement), flux};
+    }
+
+    /**
+     * @brief the coarse levels are only linearized about the undeformed state, with the initial internal variables,
+     * where the tangent of a material is its (symmetric) small-strain elasticity tensor, see SymmetricDerivative
+     */
+    static constexpr bool symmetric_derivative(int) { return true; }
+  };
+
+  /**
+   * @brief The stress response of a material, which also records derived quantities along with the material state
+   * at each quadrature point, see setMaterialWithOutputs()
+   */
+  template <typename Material, typename... Outputs>
+  struct MaterialOutputsFunctor {
+    /// @brief Constructor for the functor
+    MaterialOutputsFunctor(Material material, GeometricNonlinearities gn, Outputs... outputs)
+        : stress_(material, gn), outputs_(outputs...)
+    {
+    }
+
+    /// @brief The stress response of the material
+    MaterialStressFunctor<Material> stress_;
+
+    /// @brief The derived quantities
+    std::tuple<Outputs...> outputs_;
+
+    /// @brief Material stress response call, which also updates the derived quantities in @a state
+    template <typename X, typename State, typename Displacement, typename Acceleration, typename... Params>
+    auto SERAC_HOST_DEVICE operator()(double t, X x, State& state, Displacement displacement,
+                                      Acceleration acceleration, Params... params) const
+    {
+      auto response = stress_(t, x, state.material_state, displacement, acceleration, params...);
+
+      // the Cauchy stress is recovered from the flux, sigma = P F^T / det(F)
+      auto du_dX = get_value(get<DERIVATIVE>(displacement));
+      auto dx_dX = I;
+      if (stress_.geom_nonlin_ == GeometricNonlinearities::On) {
+        dx_dX += du_dX;
+      }
+      auto stress = dot(get_value(get<1>(response)), transpose(dx_dX)) / det(dx_dX);
+
+      std::apply(
+          [&](const auto&... output) {
+            int j = 0;
+            ((state.outputs[j++] = output(state.material_state, du_dX, stress)), ...);
+          },
+          outputs_);
+
+      return response;
+    }
   };
 
   /**
@@ -891,15 +1208,8 @@ public:
   {
     static_assert(std::is_same_v<StateType, Empty> || std::is_same_v<StateType, typename MaterialType::State>,
                   "invalid quadrature data provided in setMaterial()");
-    MaterialStressFunctor<MaterialType> material_functor(material, geom_nonlin_);
-    residual_->AddDomainIntegral(
-        Dimension<dim>{},
-        DependsOn<0, 1,
-                  active_parameters + NUM_STATE_VARS...>{},  // the magic number "+ NUM_STATE_VARS" accounts for the
-                                                             // fact that the displacement, acceleration, and shape
-                                                             // fields are always-on and come first, so the `n`th
-                                                             // parameter will actually be argument `n + NUM_STATE_VARS`
-        std::move(material_functor), mesh_, qdata);
+    addMaterialIntegral(DependsOn<active_parameters...>{}, material,
+                        MaterialStressFunctor<MaterialType>(material, geom_nonlin_), qdata);
   }
 
   /// @overload
@@ -909,6 +1219,105 @@ public:
     setMaterial(DependsOn<>{}, material, qdata);
   }
 
+  /**
+   * @brief Set the material of a mixed displacement-pressure formulation, for nearly incompressible materials (e.g.
+   * neo-Hookean rubber with a Poisson ratio close to 1/2) that lock volumetrically with displacements alone
+   *
+   * The mean stress of the material is replaced by a discontinuous pressure of one order lower than the displacement
+   * (in L2<order - 1>), which is condensed element by element, so the equations to solve still only have the
+   * displacement dofs, see CondensedPressure. The pressure is written as an output field.
+   *
+   * @param material The material, as for setMaterial(), which must have a public member variable `K`, its bulk
+   * modulus
+   * @param qdata the buffer of material internal variables at each quadrature point
+   *
+   * @note This method must be called prior to completeSetup(), only once, and only for quasi-static solves with
+   * assembled Jacobians. Sensitivities and adjoint solves don't include the pressure.
+   */
+  template <int... active_parameters, typename MaterialType, typename StateType = Empty>
+  void setMixedMaterial(DependsOn<active_parameters...>, const MaterialType& material,
+                        qdata_type<StateType> qdata = EmptyQData)
+  {
+    static_assert(std::is_same_v<StateType, Empty> || std::is_same_v<StateType, typename MaterialType::State>,
+                  "invalid quadrature data provided in setMixedMaterial()");
+    SLIC_ERROR_ROOT_IF(!is_quasistatic_, "Mixed displacement-pressure formulations require quasi-static solves");
+    SLIC_ERROR_ROOT_IF(nonlin_solver_->matrixFree() || nonlin_solver_->staticCondensation(),
+                       "Mixed displacement-pressure formulations require assembled Jacobians");
+    SLIC_ERROR_ROOT_IF(condensed_pressure_, "Only one material can be mixed with the pressure");
+
+    pressure_ = std::make_unique<FiniteElementState>(
+        StateManager::newState(L2<order - 1>{}, detail::addPrefix(name_, "pressure"), mesh_tag_));
+    *pressure_          = 0.0;
+    condensed_pressure_ = std::make_unique<CondensedPressure<order, dim>>(displacement_.space(), pressure_->space(),
+                                                                          material.K, geom_nonlin_);
+
+    // the pressure is updated with every residual evaluation
+    addOutputField(*pressure_, []() {});
+
+    constexpr bool deviatoric = true;
+    addMaterialIntegral(DependsOn<active_parameters...>{}, material,
+                        MaterialStressFunctor<MaterialType>(material, geom_nonlin_, deviatoric), qdata);
+  }
+
+  /// @overload
+  template <typename MaterialType, typename StateType = Empty>
+  void setMixedMaterial(const MaterialType& material, std::shared_ptr<QuadratureData<StateType>> qdata = EmptyQData)
+  {
+    setMixedMaterial(DependsOn<>{}, material, qdata);
+  }
+
+  /// @brief The pressure of the mixed formulation, see setMixedMaterial()
+  const FiniteElementState& pressure() const
+  {
+    SLIC_ERROR_ROOT_IF(!pressure_, "setMixedMaterial() must be called prior to pressure()");
+    return *pressure_;
+  }
+
+  /**
+   * @brief Set the material stress response, along with derived quantities that are written as output fields
+   *
+   * The derived quantities (e.g. solid_mechanics::VonMisesStress or solid_mechanics::EquivalentPlasticStrain) are
+   * recorded with the material state at each quadrature point, by the same q-function evaluations that update it at
+   * the end of each step, so they don't take another pass over the mesh. They are only averaged over each element, into
+   * piecewise constant fields, when those fields are written (see outputStateToDisk()).
+   *
+   * @param material The material model, as for setMaterial()
+   * @param initial_state The initial internal variables of the material at each quadrature point
+   * @param names The names of the output fields, one for each derived quantity, which are prefixed with the name of
+   * this module
+   * @param outputs Callables that return a derived quantity as output(state, du_dX, stress), from the updated material
+   * state, the displacement gradient, and the Cauchy stress
+   * @return The quadrature data buffer of the material state and derived quantities
+   *
+   * @note This method must be called prior to completeSetup()
+   */
+  template <int... active_parameters, typename MaterialType, typename... Outputs>
+  auto setMaterialWithOutputs(DependsOn<active_parameters...>, const MaterialType& material,
+                              typename MaterialType::State initial_state, const std::vector<std::string>& names,
+                              Outputs... outputs)
+  {
+    constexpr int n = int(sizeof...(Outputs));
+    static_assert(n > 0, "setMaterialWithOutputs() needs at least one derived quantity");
+    SLIC_ERROR_ROOT_IF(names.size() != sizeof...(Outputs), "Each derived quantity needs the name of its output field");
+
+    using StateType = solid_mechanics::StateWithOutputs<typename MaterialType::State, n>;
+    auto qdata      = createQuadratureDataBuffer(StateType{initial_state, {}});
+
+    addMaterialIntegral(DependsOn<active_parameters...>{}, material,
+                        MaterialOutputsFunctor<MaterialType, Outputs...>(material, geom_nonlin_, outputs...), qdata);
+    addDerivedOutputs(qdata, names, std::make_integer_sequence<int, n>{});
+
+    return qdata;
+  }
+
+  /// @overload
+  template <typename MaterialType, typename... Outputs>
+  auto setMaterialWithOutputs(const MaterialType& material, typename MaterialType::State initial_state,
+                              const std::vector<std::string>& names, Outputs... outputs)
+  {
+    return setMaterialWithOutputs(DependsOn<>{}, material, initial_state, names, outputs...);
+  }
+
   /**
    * @brief Set the underlying finite element state to a prescribed displacement
    *
@@ -995,8 +1404,11 @@ public:
                     const std::optional<Domain>& optional_domain = std::nullopt)
   {
     Domain domain = (optional_domain) ? *optional_domain : EntireDomain(mesh_);
-    residual_->AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-                                 BodyForceIntegrand<BodyForceType>(body_force), domain);
+    addResidualIntegral([body_force, domain](residual_type& residual, const std::optional<Domain>& band) {
+      Domain restricted = restrictToBand<Nothing>(domain, band);
+      residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                 BodyForceIntegrand<BodyForceType>(body_force), restricted);
+    });
   }
 
   /// @overload
@@ -1006,6 +1418,48 @@ public:
     addBodyForce(DependsOn<>{}, body_force, optional_domain);
   }
 
+  /**
+   * @brief Add a separable body force f(x) g(t), e.g. gravity that is ramped up in time, which doesn't depend on the
+   * displacement, so that it is only integrated once while the parameters it depends on (and the shape displacement)
+   * don't change, and then scaled by g(t) in each residual evaluation, see Functional::AddSeparableDomainIntegral()
+   *
+   * @tparam BodyForceType The type of the body force load
+   * @param body_force f, the distribution of the body force
+   * @param time_scale g, the time function of the body force
+   * @param optional_domain The domain over which the body force is applied. If nothing is supplied the entire domain is
+   * used.
+   * @pre body_force must be a object that can be called with the following arguments:
+   *    1. `tensor<T,dim> x` the spatial coordinates for the quadrature point
+   *    2. `tuple{value, derivative}`, a variadic list of tuples (each with a values and derivative),
+   *            one tuple for each of the trial spaces specified in the `DependsOn<...>` argument.
+   *
+   * @note This method must be called prior to completeSetup()
+   */
+  template <int... active_parameters, typename BodyForceType>
+  void addSeparableBodyForce(DependsOn<active_parameters...>, BodyForceType body_force,
+                             std::function<double(double)> time_scale,
+                             const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    Domain domain = (optional_domain) ? *optional_domain : EntireDomain(mesh_);
+    addResidualIntegral([body_force, time_scale, domain](residual_type& residual, const std::optional<Domain>& band) {
+      Domain restricted = restrictToBand<Nothing>(domain, band);
+      residual.AddSeparableDomainIntegral(
+          Dimension<dim>{}, DependsOn<active_parameters + NUM_STATE_VARS...>{},
+          [body_force](double /* t */, auto X, auto... params) {
+            return serac::tuple{-1.0 * body_force(get<VALUE>(X), params...), zero{}};
+          },
+          time_scale, restricted);
+    });
+  }
+
+  /// @overload
+  template <typename BodyForceType>
+  void addSeparableBodyForce(BodyForceType body_force, std::function<double(double)> time_scale,
+                             const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    addSeparableBodyForce(DependsOn<>{}, body_force, std::move(time_scale), optional_domain);
+  }
+
   /**
    * @brief Set the traction boundary condition
    *
@@ -1035,14 +1489,18 @@ public:
   {
     Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
 
-    residual_->AddBoundaryIntegral(
-        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-        [traction_function](double t, auto X, auto /* displacement */, auto /* acceleration */, auto... params) {
-          auto n = cross(get<DERIVATIVE>(X));
+    auto traction = [traction_function](double t, auto X, auto /* displacement */, auto /* acceleration */,
+                                        auto... params) {
+      auto n = cross(get<DERIVATIVE>(X));
 
-          return -1.0 * traction_function(get<VALUE>(X), normalize(n), t, params...);
-        },
-        domain);
+      return -1.0 * traction_function(get<VALUE>(X), normalize(n), t, params...);
+    };
+
+    addResidualIntegral([traction, domain](residual_type& residual, const std::optional<Domain>&) {
+      Domain boundary = domain;
+      residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                   traction, boundary);
+    });
   }
 
   /// @overload
@@ -1052,6 +1510,53 @@ public:
     setTraction(DependsOn<>{}, traction_function, optional_domain);
   }
 
+  /**
+   * @brief Set a separable traction f(x, n) g(t) on a boundary, which is only integrated once while the parameters it
+   * depends on (and the shape displacement) don't change, and then scaled by g(t) in each residual evaluation, see
+   * setTraction() and Functional::AddSeparableBoundaryIntegral()
+   *
+   * @tparam TractionType The type of the traction load
+   * @param traction_function f, the distribution of the traction
+   * @param time_scale g, the time function of the traction
+   * @param optional_domain The domain over which the traction is applied. If nothing is supplied the entire boundary is
+   * used.
+   * @pre TractionType must be a object that can be called with the following arguments:
+   *    1. `tensor<T,dim> x` the spatial coordinates for the quadrature point
+   *    2. `tensor<T,dim> n` the outward-facing unit normal for the quadrature point
+   *    3. `tuple{value, derivative}`, a variadic list of tuples (each with a values and derivative),
+   *            one tuple for each of the trial spaces specified in the `DependsOn<...>` argument.
+   *
+   * @note This traction is applied in the reference (undeformed) configuration.
+   *
+   * @note This method must be called prior to completeSetup()
+   */
+  template <int... active_parameters, typename TractionType>
+  void setSeparableTraction(DependsOn<active_parameters...>, TractionType traction_function,
+                            std::function<double(double)> time_scale,
+                            const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
+
+    auto traction = [traction_function](double /* t */, auto X, auto... params) {
+      auto n = cross(get<DERIVATIVE>(X));
+
+      return -1.0 * traction_function(get<VALUE>(X), normalize(n), params...);
+    };
+
+    addResidualIntegral([traction, time_scale, domain](residual_type& residual, const std::optional<Domain>&) {
+      residual.AddSeparableBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<active_parameters + NUM_STATE_VARS...>{},
+                                            traction, time_scale, domain);
+    });
+  }
+
+  /// @overload
+  template <typename TractionType>
+  void setSeparableTraction(TractionType traction_function, std::function<double(double)> time_scale,
+                            const std::optional<Domain>& optional_domain = std::nullopt)
+  {
+    setSeparableTraction(DependsOn<>{}, traction_function, std::move(time_scale), optional_domain);
+  }
+
   /**
    * @brief Set the pressure boundary condition
    *
@@ -1080,34 +1585,37 @@ public:
   {
     Domain domain = (optional_domain) ? *optional_domain : EntireBoundary(mesh_);
 
-    residual_->AddBoundaryIntegral(
-        Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
-        [pressure_function, geom_nonlin = geom_nonlin_](double t, auto X, auto displacement, auto /* acceleration */,
-                                                        auto... params) {
-          // Calculate the position and normal in the shape perturbed deformed configuration
-          auto x = X + 0.0 * displacement;
+    auto pressure = [pressure_function, geom_nonlin = geom_nonlin_](double t, auto X, auto displacement,
+                                                                    auto /* acceleration */, auto... params) {
+      // Calculate the position and normal in the shape perturbed deformed configuration
+      auto x = X + 0.0 * displacement;
 
-          if (geom_nonlin == GeometricNonlinearities::On) {
-            x = x + displacement;
-          }
+      if (geom_nonlin == GeometricNonlinearities::On) {
+        x = x + displacement;
+      }
 
-          auto n = cross(get<DERIVATIVE>(x));
-
-          // serac::Functional's boundary integrals multiply the q-function output by
-          // norm(cross(dX_dxi)) at that quadrature point, but if we impose a shape displacement
-          // then that weight needs to be corrected. The new weight should be
-          // norm(cross(dX_dxi + du_dxi + dp_dxi)) where u is displacement and p is shape displacement. This implies:
-          //
-          //   pressure * normalize(normal_new) * w_new
-          // = pressure * normalize(normal_new) * (w_new / w_old) * w_old
-          // = pressure * normalize(normal_new) * (norm(normal_new) / norm(normal_old)) * w_old
-          // = pressure * (normal_new / norm(normal_new)) * (norm(normal_new) / norm(normal_old)) * w_old
-          // = pressure * (normal_new / norm(normal_old)) * w_old
-
-          // We always query the pressure function in the undeformed configuration
-          return pressure_function(get<VALUE>(X), t, params...) * (n / norm(cross(get<DERIVATIVE>(X))));
-        },
-        domain);
+      auto n = cross(get<DERIVATIVE>(x));
+
+      // serac::Functional's boundary integrals multiply the q-function output by
+      // norm(cross(dX_dxi)) at that quadrature point, but if we impose a shape displacement
+      // then that weight needs to be corrected. The new weight should be
+      // norm(cross(dX_dxi + du_dxi + dp_dxi)) where u is displacement and p is shape displacement. This implies:
+      //
+      //   pressure * normalize(normal_new) * w_new
+      // = pressure * normalize(normal_new) * (w_new / w_old) * w_old
+      // = pressure * normalize(normal_new) * (norm(normal_new) / norm(normal_old)) * w_old
+      // = pressure * (normal_new / norm(normal_new)) * (norm(normal_new) / norm(normal_old)) * w_old
+      // = pressure * (normal_new / norm(normal_old)) * w_old
+
+      // We always query the pressure function in the undeformed configuration
+      return pressure_function(get<VALUE>(X), t, params...) * (n / norm(cross(get<DERIVATIVE>(X))));
+    };
+
+    addResidualIntegral([pressure, domain](residual_type& residual, const std::optional<Domain>&) {
+      Domain boundary = domain;
+      residual.AddBoundaryIntegral(Dimension<dim - 1>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                   pressure, boundary);
+    });
   }
 
   /// @overload
@@ -1127,22 +1635,86 @@ public:
 
         // residual function
         [this](const mfem::Vector& u, mfem::Vector& r) {
-          const mfem::Vector res = (*residual_)(ode_time_point_, shape_displacement_, u, acceleration_,
-                                                *parameters_[parameter_indices].state...);
+          // this is evaluated before the first Newton iteration decides whether to assemble J
+          bool current = nonlin_solver_->linear() && J_ && jacobian_c0_ == 0.0;
+          nonlin_solver_->setJacobianCurrent(current);
+
+          // the material states at u are staged, so that they can be committed without evaluating the q-functions
+          // again if u turns out to be the solution, see commitTimestep()
+          for (auto& stage : qdata_staging_) {
+            stage(true);
+          }
+
+          // when the Jacobian is about to be assembled at u, the q-function derivatives are computed along with the
+          // residual, rather than by evaluating the q-functions again in the gradient
+          if (nonlin_solver_->jacobianExpected() && !current) {
+            auto [value, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), acceleration_,
+                                              *parameters_[parameter_indices].state...);
+            // copied into the memory of r, see below
+            r = value;
+            setLinearizationPoint(u);
+          } else {
+            // the residual is written directly into r (rather than assigned to it), which keeps the memory that
+            // the sundials solvers track, see https://github.com/mfem/mfem/issues/3531
+            residual_->evaluateInto(r, ode_time_point_, shape_displacement_, u, acceleration_,
+                                    *parameters_[parameter_indices].state...);
+            clearLinearizationPoint();
+          }
+
+          for (auto& stage : qdata_staging_) {
+            stage(false);
+          }
+
+          if (condensed_pressure_) {
+            condensed_pressure_->addToResidual(ode_time_point_, u, *pressure_, r);
+          }
+
+          // before its essential rows are zeroed, the residual at the solution is the reaction
+          staged_displacement_ = u;
+          staged_reactions_    = r;
+          has_staged_states_   = true;
 
-          // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-          // tracking strategy
-          // See https://github.com/mfem/mfem/issues/3531
-          r = res;
           r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
         },
 
         // gradient of residual function
         [this](const mfem::Vector& u) -> mfem::Operator& {
-          auto [r, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), acceleration_,
-                                        *parameters_[parameter_indices].state...);
-          J_             = assemble(drdu);
-          J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+          // the derivatives at u may already have been computed by the residual evaluation
+          if (!takeLinearizationPoint(u)) {
+            (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), acceleration_,
+                         *parameters_[parameter_indices].state...);
+          }
+          auto& drdu = residual_->gradient(1);  // the displacement, after the shape displacement
+
+          // in matrix-free mode, the linear solver only sees the action of the gradient
+          // (and its diagonal, for preconditioning), with the essential dofs constrained
+          if (nonlin_solver_->matrixFree()) {
+            J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+            jacobian_c0_   = -1.0;
+            return *J_matrix_free_;
+          }
+
+          // with static condensation, only the Schur complement of the skeleton dofs is assembled, and the action of
+          // the gradient stays matrix-free
+          if (nonlin_solver_->staticCondensation()) {
+            if (!condensation_) {
+              condensation_ = std::make_unique<StaticCondensation>(displacement_.space());
+            }
+            condensation_->setEssentialTrueDofs(bcs_.allEssentialTrueDofs());
+            condensation_->assemble(drdu);
+
+            J_matrix_free_ = std::make_unique<mfem::ConstrainedOperator>(&drdu, bcs_.allEssentialTrueDofs());
+            condensation_->setAction(*J_matrix_free_);
+            jacobian_c0_ = -1.0;
+            return *condensation_;
+          }
+
+          assemble(drdu, J_);
+          if (condensed_pressure_) {
+            condensed_pressure_->addToJacobian(ode_time_point_, u, *pressure_, J_);
+          }
+          bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
+          jacobian_c0_ = 0.0;
           return *J_;
         });
   }
@@ -1181,14 +1753,15 @@ public:
           displacement_.space().TrueVSize(),
 
           [this](const mfem::Vector& d2u_dt2, mfem::Vector& r) {
-            add(1.0, u_, c0_, d2u_dt2, predicted_displacement_);
-            const mfem::Vector res = (*residual_)(ode_time_point_, shape_displacement_, predicted_displacement_,
-                                                  d2u_dt2, *parameters_[parameter_indices].state...);
+            // this is evaluated before the first Newton iteration decides whether to assemble J
+            nonlin_solver_->setJacobianCurrent(nonlin_solver_->linear() && J_ &&
+                                               jacobian_c0_ == ode2_.GetImplicitCoefficients().first);
 
-            // TODO this copy is required as the sundials solvers do not allow move assignments because of their memory
-            // tracking strategy
-            // See https://github.com/mfem/mfem/issues/3531
-            r = res;
+            add(1.0, u_, c0_, d2u_dt2, predicted_displacement_);
+            // the residual is written directly into r (rather than assigned to it), which keeps the memory that
+            // the sundials solvers track, see https://github.com/mfem/mfem/issues/3531
+            residual_->evaluateInto(r, ode_time_point_, shape_displacement_, predicted_displacement_, d2u_dt2,
+                                    *parameters_[parameter_indices].state...);
             r.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
           },
 
@@ -1208,8 +1781,9 @@ public:
             std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
 
             // J = M + c0 * K
-            J_.reset(mfem::Add(1.0, *m_mat, c0_, *k_mat));
-            J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            refillOrReplace(J_, std::unique_ptr<mfem::HypreParMatrix>(mfem::Add(1.0, *m_mat, c0_, *k_mat)));
+            bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
+            jacobian_c0_ = c0_;
 
             return *J_;
           });
@@ -1217,15 +1791,32 @@ public:
 
     nonlin_solver_->setOperator(*residual_with_bcs_);
 
-    if (checkpoint_to_disk_) {
-      outputStateToDisk();
-    } else {
-      checkpoint_states_.clear();
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
-      }
+    // argument 1 of the residual is the displacement, after the shape displacement
+    if (!explicit_dynamics_) {
+      auto linearize = [this]() -> mfem::Operator& {
+        (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_), acceleration_,
+                     *parameters_[parameter_indices].state...);
+        return residual_->gradient(1);
+      };
+      selectJacobianPolicy(*residual_, 1, *nonlin_solver_, linearize, is_quasistatic_ && nonlin_solver_->matrixFree());
+    }
+
+    if (multigrid_levels_) {
+      multigrid_levels_->setup(*multigrid_, displacement_.space(), bcs_);
+    }
+    if (p_multigrid_levels_) {
+      p_multigrid_levels_->setup(*multigrid_, displacement_.space(), bcs_);
     }
+    if (low_order_refined_) {
+      low_order_refined_->setup(*lor_preconditioner_, bcs_.allEssentialTrueDofs());
+    }
+
+    if (explicit_dynamics_) {
+      computeLumpedMass();
+    }
+
+    clearCheckpointedStates();
+    checkpointStates();
   }
 
   /// @brief Set field to zero wherever their are essential boundary conditions applies
@@ -1239,33 +1830,273 @@ public:
   /// @overload
   void advanceTimestep(double dt) override
   {
-    SLIC_ERROR_ROOT_IF(!residual_, "completeSetup() must be called prior to advanceTimestep(dt) in SolidMechanics.");
-
-    // If this is the first call, initialize the previous parameter values as the initial values
-    if (cycle_ == 0) {
-      for (auto& parameter : parameters_) {
-        *parameter.previous_state = *parameter.state;
+    if (is_quasistatic_ && (max_cutbacks_ > 0 || target_nonlinear_iterations_ > 0)) {
+      auto solve = [this](double h) {
+        solveTimestep(h);
+        return nonlin_solver_->nonlinearSolver().GetConverged();
+      };
+      auto abort  = [this]() { abortTimestep(); };
+      auto commit = [this]() { commitTimestep(); };
+
+      if (target_nonlinear_iterations_ > 0) {
+        advanceWithContinuation(dt, solve, abort, commit);
+      } else {
+        advanceWithCutbacks(dt, max_cutbacks_, solve, abort, commit);
       }
+      return;
     }
 
-    if (is_quasistatic_) {
-      quasiStaticSolve(dt);
+    solveTimestep(dt);
+    commitTimestep();
+  }
+
+  /**
+   * @brief Solve for the displacement at the end of a timestep without completing the step
+   *
+   * Calling this again before commitTimestep() re-solves the same step, e.g. after a coupled physics module has
+   * updated one of the parameter fields. Quasi-static solves restart from the most recent iterate, while dynamic
+   * solves restart from the displacement and velocity at the beginning of the step.
+   *
+   * @param dt The increment of simulation time to advance the underlying solid mechanics problem. With adaptive time
+   * stepping, this is an upper bound and the step actually taken may be smaller.
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void solveTimestep(double dt)
+  {
+    SLIC_ERROR_ROOT_IF(!residual_, "completeSetup() must be called prior to advanceTimestep(dt) in SolidMechanics.");
+
+    if (!step_in_progress_) {
+      // If this is the first call, initialize the previous parameter values as the initial values
+      if (cycle_ == 0) {
+        for (auto& parameter : parameters_) {
+          *parameter.previous_state = *parameter.state;
+        }
+      }
+
+      step_in_progress_        = true;
+      step_start_time_         = time_;
+      step_start_displacement_ = displacement_;
+      step_start_velocity_     = velocity_;
+      step_start_acceleration_ = acceleration_;
+
+      // extrapolate only at the first solve of a step, so that re-solves restart from the most recent iterate
+      if (is_quasistatic_ && predictor_ == Predictor::Extrapolation) {
+        if (converged_states_.empty()) {
+          recordConvergedState(displacement_);
+        }
+        extrapolateState(time_ + dt, extrapolation_order_, predicted_displacement_);
+        displacement_ = predicted_displacement_;
+      }
     } else {
-      ode2_.Step(displacement_, velocity_, time_, dt);
+      time_ = step_start_time_;
     }
 
-    cycle_ += 1;
+    step_dt_ = dt;
 
-    if (checkpoint_to_disk_) {
-      outputStateToDisk();
+    if (is_quasistatic_) {
+      quasiStaticSolve(dt);
+    } else if (modal_) {
+      modal_->setState(*modal_mass_, step_start_displacement_, step_start_velocity_);
+      modalSolve(dt);
+    } else if (explicit_dynamics_) {
+      displacement_ = step_start_displacement_;
+      velocity_     = step_start_velocity_;
+      acceleration_ = step_start_acceleration_;
+      explicitSolve(dt);
     } else {
-      auto state_names = stateNames();
-      for (const auto& state_name : state_names) {
-        checkpoint_states_[state_name].push_back(state(state_name));
+      displacement_ = step_start_displacement_;
+      velocity_     = step_start_velocity_;
+      ode2_.Step(displacement_, velocity_, time_, step_dt_);
+    }
+  }
+
+  /// @overload
+  double suggestedTimestep(double dt) const override
+  {
+    if (modal_) {
+      return dt;
+    }
+    if (explicit_dynamics_) {
+      return std::min(dt, stableTimestep());
+    }
+    return is_quasistatic_ ? dt : ode2_.SuggestedTimestep(dt);
+  }
+
+  /**
+   * @brief Estimate the largest stable step of explicit (CentralDifference) dynamics
+   *
+   * This is the CFL condition cfl_number * min(h / c) / p, where h is the size of each element in the reference
+   * configuration, c is the dilatational wave speed of its material and p is the polynomial order.
+   *
+   * @return The estimated stable step, or the largest double if no material exposes its elastic moduli
+   */
+  double stableTimestep() const
+  {
+    double dt = residual_->stableTimestep(material_wave_speeds_);
+    if (dt == std::numeric_limits<double>::max()) {
+      return dt;
+    }
+    return cfl_number_ * dt / order;
+  }
+
+#ifdef MFEM_USE_SLEPC
+  /**
+   * @brief Take the following dynamic steps by modal superposition of the lowest @a num_modes vibration modes
+   *
+   * The modes of the stiffness (linearized at the current displacement) and consistent mass matrices are computed
+   * once, and the current displacement and velocity are projected onto them. Each step then costs two evaluations of
+   * the load (the residual at zero displacement and acceleration) and is exact for loads that vary linearly over it,
+   * so long vibration runs can take steps as large as their loads and output allow.
+   *
+   * @param num_modes The number of modes, see lowestVibrationModes()
+   *
+   * @pre The residual must be linear in the displacement (a linear elastic material) and the essential boundary
+   * conditions must be homogeneous. The dofs they constrain are given their own stiffness and mass, so their
+   * spurious modes are near the top of the spectrum, well above the lowest modes.
+   */
+  void useModalSuperposition(int num_modes)
+  {
+    SLIC_ERROR_ROOT_IF(!residual_with_bcs_, "completeSetup() must be called prior to useModalSuperposition()");
+    SLIC_ERROR_ROOT_IF(is_quasistatic_, "Modal superposition requires dynamic (not quasi-static) time stepping");
+
+    auto [K, M] = assembleStiffnessAndMass(mfem::Operator::DIAG_KEEP);
+
+    modal_mass_ = std::move(M);
+    modal_      = std::make_unique<ModalIntegrator>(lowestVibrationModes(*K, *modal_mass_, num_modes),
+                                                    displacement_.space().GetComm());
+    modal_->setState(*modal_mass_, displacement_, velocity_);
+  }
+
+  /// @brief The vibration modes of modal superposition, see useModalSuperposition()
+  const VibrationModes& vibrationModes() const
+  {
+    SLIC_ERROR_ROOT_IF(!modal_, "useModalSuperposition() must be called prior to vibrationModes()");
+    return modal_->modes();
+  }
+
+  /**
+   * @brief The largest stable step of the central difference method, from the largest eigenvalue of the stiffness
+   * (linearized at the current displacement) and mass matrices
+   *
+   * Unlike the element-by-element estimate of stableTimestep(), this is exact: 2 / omega_max. It uses the lumped
+   * mass of explicit (CentralDifference) dynamics, and the consistent mass otherwise.
+   */
+  double criticalTimestep()
+  {
+    SLIC_ERROR_ROOT_IF(!residual_with_bcs_, "completeSetup() must be called prior to criticalTimestep()");
+
+    // the constrained dofs are given no stiffness, so they don't limit the step
+    auto [K, M] = assembleStiffnessAndMass(mfem::Operator::DIAG_ZERO);
+    if (!explicit_dynamics_) {
+      return 2.0 / std::sqrt(largestEigenvalue(*K, *M));
+    }
+
+    mfem::Vector lumped_mass(lumped_mass_inverse_.Size());
+    for (int i = 0; i < lumped_mass.Size(); i++) {
+      lumped_mass(i) = 1.0 / lumped_mass_inverse_(i);
+    }
+    mfem::SparseMatrix   lumped_diagonal(lumped_mass);
+    mfem::HypreParMatrix M_lumped(displacement_.space().GetComm(), displacement_.space().GlobalTrueVSize(),
+                                  displacement_.space().GetTrueDofOffsets(), &lumped_diagonal);
+    return 2.0 / std::sqrt(largestEigenvalue(*K, M_lumped));
+  }
+#endif
+
+  /**
+   * @brief Start or stop timing the residual and Jacobian evaluations of each element
+   *
+   * @param enable Whether to time the elements from now on. The times recorded so far are discarded either way.
+   *
+   * @see elementCosts()
+   */
+  void recordElementCosts(bool enable) { residual_->recordElementCosts(enable); }
+
+  /**
+   * @brief The time (in seconds) spent evaluating each element of the mesh since recordElementCosts() was last called
+   *
+   * Elements with path-dependent materials, e.g. those undergoing a plastic return mapping, are usually much more
+   * expensive than the others. These costs can be passed to StateManager::rebalance() to even out the work of each
+   * rank.
+   */
+  mfem::Vector elementCosts() const { return residual_->elementCosts(); }
+
+  /// @copydoc BasePhysics::memoryUsage()
+  memory::Usage memoryUsage() const override
+  {
+    memory::Usage usage = BasePhysics::memoryUsage();
+    memory::add(usage, "residual", residual_->memoryUsage());
+
+    for (const auto* matrix : {J_.get(), J_T_.get(), k_adjoint_.get(), m_adjoint_.get()}) {
+      if (matrix) {
+        usage["matrices"] += memory::bytes(*matrix);
       }
     }
+    usage["eliminated_entries"] = J_e_.bytes() + J_T_e_.bytes();
 
-    {
+    for (const auto& qdata_bytes : qdata_bytes_) {
+      usage["quadrature_data"] += qdata_bytes();
+    }
+    return usage;
+  }
+
+  /// @copydoc BasePhysics::plan()
+  RunPlan plan(int num_cycles, const CostModel& model = {}) const override
+  {
+    RunPlan run_plan = BasePhysics::plan(num_cycles, model);
+
+    // argument 1 of the residual is the displacement, after the shape displacement
+    planResidual(run_plan, num_cycles, model, *residual_, 1);
+    return run_plan;
+  }
+
+  /**
+   * @brief Discard the timestep started by solveTimestep(), restoring the displacement and time at its beginning
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void abortTimestep()
+  {
+    SLIC_ERROR_ROOT_IF(!step_in_progress_, "solveTimestep(dt) must be called prior to abortTimestep()");
+    time_              = step_start_time_;
+    displacement_      = step_start_displacement_;
+    velocity_          = step_start_velocity_;
+    step_in_progress_  = false;
+    has_staged_states_ = false;
+  }
+
+  /**
+   * @brief Complete the timestep started by solveTimestep(), recording the current displacement as its solution
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void commitTimestep()
+  {
+    SLIC_ERROR_ROOT_IF(!step_in_progress_, "solveTimestep(dt) must be called prior to commitTimestep()");
+    step_in_progress_ = false;
+
+    cycle_ += 1;
+
+    bool no_solves = explicit_dynamics_ || modal_;
+    nonlinear_iterations_.push_back(no_solves ? 0 : nonlin_solver_->nonlinearSolver().GetNumIterations());
+    recordSolverTelemetry(no_solves ? SolverTelemetry{} : nonlin_solver_->telemetry());
+    if (is_quasistatic_ && predictor_ == Predictor::Extrapolation) {
+      recordConvergedState(displacement_);
+    }
+
+    checkpointStates();
+
+    // the last residual evaluation of a quasi-static solve is usually at the displacement it converged to, in which
+    // case the material states and reactions it staged are those of the solution
+    bool committed = is_quasistatic_ && has_staged_states_ && identical(staged_displacement_, displacement_);
+    for (auto& commit : qdata_commits_) {
+      committed = committed && commit();
+    }
+    has_staged_states_ = false;
+
+    if (committed) {
+      reactions_ = staged_reactions_;
+    } else {
       // after finding displacements that satisfy equilibrium,
       // compute the residual one more time, this time enabling
       // the material state buffers to be updated
@@ -1273,17 +2104,65 @@ public:
 
       reactions_ = (*residual_)(ode_time_point_, shape_displacement_, displacement_, acceleration_,
                                 *parameters_[parameter_indices].state...);
+      if (condensed_pressure_) {
+        condensed_pressure_->addToResidual(ode_time_point_, displacement_, *pressure_, reactions_);
+      }
 
       residual_->updateQdata(false);
     }
 
     if (cycle_ > max_cycle_) {
-      timesteps_.push_back(dt);
+      timesteps_.push_back(step_dt_);
       max_cycle_ = cycle_;
       max_time_  = time_;
     }
   }
 
+  /**
+   * @brief Get the operator whose root is the displacement at the end of a quasi-static step
+   *
+   * Its action is the residual with the essential rows zeroed, and its gradient is the assembled Jacobian with the
+   * essential rows and columns eliminated, at the current parameter fields. This is valid after solveTimestep().
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  const mfem::Operator& residualOperator() const { return *residual_with_bcs_; }
+
+  /**
+   * @brief Assemble the derivative of the residual with respect to a parameter field at the current state
+   *
+   * @param parameter_index The index of the parameter field
+   * @return The assembled derivative, with the rows of the essential displacement dofs zeroed
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  std::unique_ptr<mfem::HypreParMatrix> parameterJacobian(size_t parameter_index)
+  {
+    SLIC_ERROR_ROOT_IF(parameter_index >= sizeof...(parameter_indices),
+                       axom::fmt::format("Invalid parameter index '{}' requested for the Jacobian", parameter_index));
+
+    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_index](ode_time_point_));
+    auto drdparam_mat = assemble(drdparam);
+    drdparam_mat->EliminateRows(bcs_.allEssentialTrueDofs());
+    return drdparam_mat;
+  }
+
+  /**
+   * @brief Subtract a correction from the displacement of the timestep currently being solved
+   *
+   * @param correction The true dof values to subtract from the displacement
+   *
+   * @warning This interface is not stable and may change in the future.
+   */
+  void correctDisplacement(const mfem::Vector& correction) { displacement_ -= correction; }
+
+  /**
+   * @brief Get the solver for the residual equations
+   *
+   * @return A reference to the equation solver of this module
+   */
+  EquationSolver& equationSolver() { return *nonlin_solver_; }
+
   /**
    * @brief Set the loads for the adjoint reverse timestep solve
    *
@@ -1330,76 +2209,16 @@ public:
   /// @overload
   void reverseAdjointTimestep() override
   {
-    auto& lin_solver = nonlin_solver_->linearSolver();
-
-    // By default, use a homogeneous essential boundary condition
-    mfem::HypreParVector adjoint_essential(displacement_adjoint_load_);
-    adjoint_essential = 0.0;
-
-    if (is_quasistatic_) {
-      auto [_, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_),
-                                    acceleration_, *parameters_[parameter_indices].state...);
-      auto jacobian  = assemble(drdu);
-      auto J_T       = std::unique_ptr<mfem::HypreParMatrix>(jacobian->Transpose());
-
-      for (const auto& bc : bcs_.essentials()) {
-        bc.apply(*J_T, displacement_adjoint_load_, adjoint_essential);
-      }
-
-      lin_solver.SetOperator(*J_T);
-      lin_solver.Mult(displacement_adjoint_load_, adjoint_displacement_);
-
-      // Reset the equation solver to use the full nonlinear residual operator.  MRT, is this needed?
-      nonlin_solver_->setOperator(*residual_with_bcs_);
-
-      return;
-    }
-
-    SLIC_ERROR_ROOT_IF(ode2_.GetTimestepper() != TimestepMethod::Newmark,
-                       "Only Newmark implemented for transient adjoint solid mechanics.");
-
-    SLIC_ERROR_ROOT_IF(cycle_ <= min_cycle_,
-                       "Maximum number of adjoint timesteps exceeded! The number of adjoint timesteps must equal the "
-                       "number of forward timesteps");
-
-    // Load the end of step disp, velo, accel from the previous cycle
-    {
-      auto previous_states_n = getCheckpointedStates(cycle_);
-
-      displacement_ = previous_states_n.at("displacement");
-      velocity_     = previous_states_n.at("velocity");
-      acceleration_ = previous_states_n.at("acceleration");
-    }
-
-    double dt_np1 = getCheckpointedTimestep(cycle_);
-    double dt_n   = getCheckpointedTimestep(cycle_ - 1);
-
-    // K := dR/du
-    auto K = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_),
-                                                 acceleration_, *parameters_[parameter_indices].state...));
-    std::unique_ptr<mfem::HypreParMatrix> k_mat(assemble(K));
-
-    // M := dR/da
-    auto M = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, displacement_,
-                                                 differentiate_wrt(acceleration_),
-                                                 *parameters_[parameter_indices].state...));
-    std::unique_ptr<mfem::HypreParMatrix> m_mat(assemble(M));
-
-    solid_mechanics::detail::adjoint_integrate(
-        dt_n, dt_np1, m_mat.get(), k_mat.get(), displacement_adjoint_load_, velocity_adjoint_load_,
-        acceleration_adjoint_load_, adjoint_displacement_, implicit_sensitivity_displacement_start_of_step_,
-        implicit_sensitivity_velocity_start_of_step_, adjoint_essential, bcs_, lin_solver);
-
-    time_ -= dt_n;
-    cycle_--;
+    prepareAdjointTimestep();
+    solveAdjointTimestep();
+    finishAdjointTimestep();
   }
 
   /// @overload
   std::unordered_map<std::string, FiniteElementState> getCheckpointedStates(int cycle_to_load) const override
   {
-    std::unordered_map<std::string, FiniteElementState> previous_states;
-
     if (checkpoint_to_disk_) {
+      std::unordered_map<std::string, FiniteElementState> previous_states;
       previous_states.emplace("displacement", displacement_);
       previous_states.emplace("velocity", velocity_);
       previous_states.emplace("acceleration", acceleration_);
@@ -1407,15 +2226,32 @@ public:
           cycle_to_load,
           {previous_states.at("displacement"), previous_states.at("velocity"), previous_states.at("acceleration")});
       return previous_states;
-    } else {
-      previous_states.emplace("displacement",
-                              checkpoint_states_.at("displacement")[static_cast<size_t>(cycle_to_load)]);
-      previous_states.emplace("velocity", checkpoint_states_.at("velocity")[static_cast<size_t>(cycle_to_load)]);
-      previous_states.emplace("acceleration",
-                              checkpoint_states_.at("acceleration")[static_cast<size_t>(cycle_to_load)]);
     }
 
-    return previous_states;
+    return checkpointedStatesInMemory(cycle_to_load);
+  }
+
+  /// @overload
+  void restoreCheckpoint(const std::unordered_map<std::string, FiniteElementState>& states) override
+  {
+    displacement_ = states.at("displacement");
+    velocity_     = states.at("velocity");
+    acceleration_ = states.at("acceleration");
+    ode2_.Restart();
+  }
+
+  /// @overload
+  void recomputeTimestep(double dt) override
+  {
+    if (explicit_dynamics_) {
+      step_start_displacement_ = displacement_;
+      explicitSolve(dt);
+      return;
+    }
+
+    double dt_taken = dt;
+    ode2_.Step(displacement_, velocity_, time_, dt_taken);
+    SLIC_ERROR_ROOT_IF(dt_taken != dt, "Recomputing checkpoints is not supported with adaptive time stepping");
   }
 
   /// @overload
@@ -1424,10 +2260,9 @@ public:
     SLIC_ASSERT_MSG(parameter_field < sizeof...(parameter_indices),
                     axom::fmt::format("Invalid parameter index '{}' requested for sensitivity."));
 
-    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](ode_time_point_));
-    auto drdparam_mat = assemble(drdparam);
+    auto drdparam = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](ode_time_point_));
 
-    drdparam_mat->MultTranspose(adjoint_displacement_, *parameters_[parameter_field].sensitivity);
+    drdparam.MultTranspose(adjoint_displacement_, *parameters_[parameter_field].sensitivity);
 
     return *parameters_[parameter_field].sensitivity;
   }
@@ -1435,17 +2270,42 @@ public:
   /// @overload
   FiniteElementDual& computeTimestepShapeSensitivity() override
   {
-    auto drdshape =
-        serac::get<DERIVATIVE>((*residual_)(ode_time_point_, differentiate_wrt(shape_displacement_), displacement_,
-                                            acceleration_, *parameters_[parameter_indices].state...));
+    residual_type& residual = shape_sensitivity_domain_ ? shapeSensitivityResidual() : *residual_;
 
-    auto drdshape_mat = assemble(drdshape);
+    auto drdshape =
+        serac::get<DERIVATIVE>(residual(ode_time_point_, differentiate_wrt(shape_displacement_), displacement_,
+                                        acceleration_, *parameters_[parameter_indices].state...));
 
-    drdshape_mat->MultTranspose(adjoint_displacement_, *shape_displacement_sensitivity_);
+    drdshape.MultTranspose(adjoint_displacement_, *shape_displacement_sensitivity_);
 
     return *shape_displacement_sensitivity_;
   }
 
+  /**
+   * @brief integrate the residual over only a band of elements in computeTimestepShapeSensitivity()
+   *
+   * In shape optimization parameterized by a design surface only the nodes on that surface move, and their
+   * sensitivities only have contributions from the elements they belong to. So integrating the domain integrals over
+   * the elements touching the surface (see elementsTouching()) gives those sensitivities exactly, for the cost of the
+   * band rather than the whole mesh. The sensitivities of the other nodes are incomplete, and must not be used.
+   *
+   * @param band the elements to integrate the domain integrals over, or std::nullopt for the whole mesh
+   *
+   * @note The boundary integrals are still integrated over their whole boundary, and the materials with internal
+   * variables over the whole mesh, as their quadrature data is laid out by the elements of the whole mesh
+   */
+  void setShapeSensitivityDomain(const std::optional<Domain>& band)
+  {
+    SLIC_ERROR_ROOT_IF(band && band->type_ != Domain::Type::Elements,
+                       "Shape sensitivities can only be restricted to a domain of elements");
+
+    shape_sensitivity_residual_.reset();
+    shape_sensitivity_domain_.reset();
+    if (band) {
+      shape_sensitivity_domain_.emplace(*band);
+    }
+  }
+
   /// @overload
   const std::unordered_map<std::string, const serac::FiniteElementDual&> computeInitialConditionSensitivity() override
   {
@@ -1477,6 +2337,79 @@ public:
   /// @brief getter for nodal forces (before zeroing-out essential dofs)
   const serac::FiniteElementDual& reactions() const { return reactions_; };
 
+  /**
+   * @brief Name a boundary whose net reaction force is evaluated by reactionResultant()
+   *
+   * The reactions of the nodes of a boundary only have contributions from the elements they belong to, so the net
+   * reaction is integrated over the elements touching the boundary (see elementsTouching()) rather than the whole
+   * mesh. This makes it cheap enough to evaluate at every Newton iteration, e.g. for load control.
+   *
+   * @param name The name of the boundary
+   * @param boundary The boundary elements
+   *
+   * @note The boundary integrals are still integrated over their whole boundary, and the materials with internal
+   * variables over the whole mesh, as their quadrature data is laid out by the elements of the whole mesh
+   */
+  void addReactionBoundary(const std::string& name, const Domain& boundary)
+  {
+    SLIC_ERROR_ROOT_IF(boundary.type_ != Domain::Type::BoundaryElements,
+                       "Reaction resultants are evaluated on a domain of boundary elements");
+    SLIC_ERROR_ROOT_IF(reaction_boundaries_.count(name),
+                       axom::fmt::format("Reaction boundary '{}' was already added", name));
+
+    ReactionBoundary reaction_boundary{elementsTouching(boundary), {}, nullptr};
+
+    // the owned true dofs of each component of the displacement on the boundary
+    auto&            space = displacement_.space();
+    mfem::Array<int> dofs  = boundary.dof_list(const_cast<mfem::ParFiniteElementSpace*>(&space));
+    for (int dof : dofs) {
+      for (int c = 0; c < dim; c++) {
+        int true_dof = space.GetLocalTDofNumber(space.DofToVDof(dof, c));
+        if (true_dof >= 0) {
+          reaction_boundary.true_dofs[size_t(c)].push_back(true_dof);
+        }
+      }
+    }
+
+    reaction_boundaries_.emplace(name, std::move(reaction_boundary));
+  }
+
+  /**
+   * @brief The net reaction force on a boundary added by addReactionBoundary(), i.e. the sum of reactions() over its
+   * nodes, at the current displacement
+   *
+   * @param name The name of the boundary
+   * @return The components of the net reaction force
+   *
+   * @note This is a collective operation
+   */
+  tensor<double, dim> reactionResultant(const std::string& name)
+  {
+    auto found = reaction_boundaries_.find(name);
+    SLIC_ERROR_ROOT_IF(found == reaction_boundaries_.end(),
+                       axom::fmt::format("Reaction boundary '{}' was not added", name));
+    ReactionBoundary& boundary = found->second;
+
+    if (!boundary.residual) {
+      boundary.residual = restrictedResidual(boundary.elements);
+    }
+
+    mfem::Vector r = (*boundary.residual)(ode_time_point_, shape_displacement_, displacement_, acceleration_,
+                                          *parameters_[parameter_indices].state...);
+    if (condensed_pressure_) {
+      condensed_pressure_->addToResidual(ode_time_point_, displacement_, *pressure_, r);
+    }
+
+    tensor<double, dim> resultant{};
+    for (int c = 0; c < dim; c++) {
+      for (int true_dof : boundary.true_dofs[size_t(c)]) {
+        resultant[c] += r[true_dof];
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &resultant[0], dim, MPI_DOUBLE, MPI_SUM, mesh_.GetComm());
+    return resultant;
+  }
+
   /// @overload
   void computeDualAdjointLoad(const std::string&               dual_name,
                               const serac::FiniteElementState& reaction_direction) override
@@ -1485,9 +2418,7 @@ public:
 
     auto [_, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_), acceleration_,
                                   *parameters_[parameter_indices].state...);
-    std::unique_ptr<mfem::HypreParMatrix> jacobian = assemble(drdu);
-    reactions_adjoint_load_                        = 0.0;
-    jacobian->MultTranspose(reaction_direction, reactions_adjoint_load_);
+    drdu.MultTranspose(reaction_direction, reactions_adjoint_load_);
     setAdjointLoad({{"displacement", reactions_adjoint_load_}});
   }
 
@@ -1498,10 +2429,9 @@ public:
     SLIC_ASSERT_MSG(parameter_field < sizeof...(parameter_indices),
                     axom::fmt::format("Invalid parameter index '{}' requested for reaction sensitivity."));
 
-    auto drdparam     = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](ode_time_point_));
-    auto drdparam_mat = assemble(drdparam);
+    auto drdparam = serac::get<DERIVATIVE>(d_residual_d_[parameter_field](ode_time_point_));
 
-    drdparam_mat->MultTranspose(reaction_direction, *parameters_[parameter_field].sensitivity);
+    drdparam.MultTranspose(reaction_direction, *parameters_[parameter_field].sensitivity);
 
     return *parameters_[parameter_field].sensitivity;
   };
@@ -1513,8 +2443,7 @@ public:
     auto drdshape =
         serac::get<DERIVATIVE>((*residual_)(ode_time_point_, differentiate_wrt(shape_displacement_), displacement_,
                                             acceleration_, *parameters_[parameter_indices].state...));
-    auto drdshape_mat = assemble(drdshape);
-    drdshape_mat->MultTranspose(reaction_direction, *shape_displacement_sensitivity_);
+    drdshape.MultTranspose(reaction_direction, *shape_displacement_sensitivity_);
     return *shape_displacement_sensitivity_;
   };
 
@@ -1563,12 +2492,44 @@ protected:
   /// sensitivity of qoi with respect to reaction forces
   FiniteElementDual reactions_adjoint_load_;
 
+  /// the type of the residual
+  using residual_type = ShapeAwareFunctional<shape_trial, test(trial, trial, parameter_space...)>;
+
   /// serac::Functional that is used to calculate the residual and its derivatives
-  std::unique_ptr<ShapeAwareFunctional<shape_trial, test(trial, trial, parameter_space...)>> residual_;
+  std::unique_ptr<residual_type> residual_;
+
+  /// @brief the integrals of the residual, which add themselves to a residual (restricted to a band of elements, if
+  /// one is given), see addResidualIntegral()
+  std::vector<std::function<void(residual_type&, const std::optional<Domain>&)>> residual_integrals_;
+
+  /// the band of elements that the shape sensitivities are integrated over, see setShapeSensitivityDomain()
+  std::optional<Domain> shape_sensitivity_domain_;
+
+  /// the residual restricted to shape_sensitivity_domain_, which is built the first time it is used
+  std::unique_ptr<residual_type> shape_sensitivity_residual_;
+
+  /// @brief a boundary whose net reaction is evaluated by reactionResultant()
+  struct ReactionBoundary {
+    /// the elements touching the boundary
+    Domain elements;
+
+    /// the owned true dofs of each component of the displacement on the boundary
+    std::array<std::vector<int>, dim> true_dofs;
+
+    /// the residual restricted to the elements, which is built the first time it is used
+    std::unique_ptr<residual_type> residual;
+  };
+
+  /// the boundaries whose net reaction is evaluated by reactionResultant(), by name
+  std::map<std::string, ReactionBoundary> reaction_boundaries_;
 
   /// mfem::Operator that calculates the residual after applying essential boundary conditions
   std::unique_ptr<mfem_ext::StdFunctionOperator> residual_with_bcs_;
 
+  /// @brief The rigid body modes given to the AMG preconditioner of the linear solver, if it is used. hypre keeps
+  /// pointers to them, so they are declared before (and destroyed after) the solver.
+  std::unique_ptr<RigidBodyModes> rigid_body_modes_;
+
   /// the specific methods and tolerances specified to solve the nonlinear residual equations
   std::unique_ptr<EquationSolver> nonlin_solver_;
 
@@ -1584,7 +2545,42 @@ protected:
 
   /// rows and columns of J_ that have been separated out
   /// because are associated with essential boundary conditions
-  std::unique_ptr<mfem::HypreParMatrix> J_e_;
+  EliminatedEntries J_e_;
+
+  /// @brief the operator of the adjoint solves: the transpose of J_ for quasi-static problems (unless the problem is
+  /// self-adjoint), or of the Newmark Jacobian for transient ones
+  std::unique_ptr<mfem::HypreParMatrix> J_T_;
+
+  /// @brief rows and columns of J_T_ that have been separated out because of essential boundary conditions
+  EliminatedEntries J_T_e_;
+
+  /// @brief the transpose of dR/du, used by the transient adjoint solves
+  std::unique_ptr<mfem::HypreParMatrix> k_adjoint_;
+
+  /// @brief the transpose of dR/da, used by the transient adjoint solves
+  std::unique_ptr<mfem::HypreParMatrix> m_adjoint_;
+
+  /// @brief the unassembled Jacobian with essential dofs constrained, used when the linear solver is matrix-free
+  std::unique_ptr<mfem::ConstrainedOperator> J_matrix_free_;
+
+  /// @brief the elimination of the element-interior displacement dofs, used when the linear solver statically
+  /// condenses quasi-static Jacobians
+  std::unique_ptr<StaticCondensation> condensation_;
+
+  /// @brief The geometric multigrid or p-multigrid preconditioner of the linear solver, if it is used
+  GeometricMultigridPreconditioner* multigrid_ = nullptr;
+
+  /// @brief The residuals on the coarse levels of the geometric multigrid preconditioner
+  std::unique_ptr<MultigridLevels<H1<order, dim>>> multigrid_levels_;
+
+  /// @brief The residuals on the lower order levels of the p-multigrid preconditioner
+  std::unique_ptr<PMultigridLevels<order, dim>> p_multigrid_levels_;
+
+  /// @brief The LOR preconditioner of the linear solver, if it is used
+  LORPreconditioner* lor_preconditioner_ = nullptr;
+
+  /// @brief The residual on the low-order refined discretization of the LOR preconditioner
+  std::unique_ptr<LowOrderRefined<dim>> low_order_refined_;
 
   /// an intermediate variable used to store the predicted end-step displacement
   mfem::Vector predicted_displacement_;
@@ -1592,9 +2588,81 @@ protected:
   /// vector used to store the change in essential bcs between timesteps
   mfem::Vector du_;
 
+  /// Whether solveTimestep() has been called since the last committed timestep
+  bool step_in_progress_ = false;
+
+  /// The size of the timestep currently being solved
+  double step_dt_ = 0.0;
+
+  /// The simulation time at the beginning of the timestep currently being solved
+  double step_start_time_ = 0.0;
+
+  /// The displacement true dofs at the beginning of the timestep currently being solved
+  mfem::Vector step_start_displacement_;
+
+  /// The velocity true dofs at the beginning of the timestep currently being solved
+  mfem::Vector step_start_velocity_;
+
+  /// The acceleration true dofs at the beginning of the timestep currently being solved
+  mfem::Vector step_start_acceleration_;
+
+  /// Whether dynamic steps are taken explicitly with a lumped mass, i.e. for TimestepMethod::CentralDifference
+  bool explicit_dynamics_ = false;
+
+  /// The fraction of the estimated critical timestep suggested for explicit dynamics
+  double cfl_number_ = 0.9;
+
+  /// The initial guess for the Newton solve of each quasi-static step
+  Predictor predictor_ = Predictor::LinearizedBoundaryConditions;
+
+  /// The degree of the polynomial used by Predictor::Extrapolation
+  int extrapolation_order_ = 2;
+
+  /// The inverse of the row-summed (lumped) mass matrix of explicit dynamics
+  mfem::Vector lumped_mass_inverse_;
+
+  /// The integrator of modal superposition, see useModalSuperposition()
+  std::unique_ptr<ModalIntegrator> modal_;
+
+  /// The consistent mass matrix that the modes of modal superposition are orthonormal with
+  std::unique_ptr<mfem::HypreParMatrix> modal_mass_;
+
+  /// The dilatational wave speed of the material in each integral of the residual, or 0 for other integrals
+  std::vector<double> material_wave_speeds_;
+
+  /// The bytes used by the quadrature data of each material, see memoryUsage()
+  std::vector<std::function<std::size_t()>> qdata_bytes_;
+
+  /// The piecewise constant fields of the derived quantities of setMaterialWithOutputs()
+  std::vector<std::unique_ptr<FiniteElementState>> derived_outputs_;
+
+  /// @brief The pressure of the mixed formulation, see setMixedMaterial()
+  std::unique_ptr<FiniteElementState> pressure_;
+
+  /// @brief The condensation of the pressure of the mixed formulation, see setMixedMaterial()
+  std::unique_ptr<CondensedPressure<order, dim>> condensed_pressure_;
+
+  /// Starts or stops staging the material states of each quadrature data buffer, see stageQuadratureData()
+  std::vector<std::function<void(bool)>> qdata_staging_;
+
+  /// Commits the staged material states of each quadrature data buffer, returning whether any were staged
+  std::vector<std::function<bool()>> qdata_commits_;
+
+  /// The displacement of the last residual evaluation of a quasi-static solve, whose material states were staged
+  mfem::Vector staged_displacement_;
+
+  /// The residual at staged_displacement_, without the essential rows zeroed
+  mfem::Vector staged_reactions_;
+
+  /// Whether staged_displacement_ and staged_reactions_ are those of the current step
+  bool has_staged_states_ = false;
+
   /// vector used to store forces arising from du_ when applying time-dependent bcs
   mfem::Vector dr_;
 
+  /// vector used to store the change in a parameter between timesteps
+  mfem::Vector parameter_difference_;
+
   /// @brief used to communicate the ODE solver's predicted displacement to the residual operator
   mfem::Vector u_;
 
@@ -1607,6 +2675,12 @@ protected:
   /// coefficient used to calculate predicted velocity: dudt_p := dudt + c1 * d2u_dt2
   double c1_;
 
+  /**
+   * @brief The coefficient c0 that J_ = M + c0 K (and its preconditioner) was last assembled for, 0 for the J_ = K of
+   * quasi-static solves, or -1 if it is out of date. Only used when NonlinearSolverOptions::linear is set.
+   */
+  double jacobian_c0_ = -1.0;
+
   /// @brief A flag denoting whether to compute geometric nonlinearities in the residual
   GeometricNonlinearities geom_nonlin_;
 
@@ -1640,6 +2714,327 @@ protected:
                             displacement_, acceleration_, *parameters_[parameter_indices].previous_state...);
       }...};
 
+  /**
+   * @brief Compute the row-summed (lumped) mass of explicit dynamics
+   *
+   * The residual is linear in the acceleration, so its derivative with respect to the acceleration is the consistent
+   * mass matrix, and the action of that derivative on a vector of ones gives its row sums. Row-sum lumping is only
+   * guaranteed to give positive masses for linear elements.
+   */
+  void computeLumpedMass()
+  {
+    auto [r, M] = (*residual_)(ode_time_point_, shape_displacement_, displacement_, differentiate_wrt(acceleration_),
+                               *parameters_[parameter_indices].state...);
+    lumped_mass_inverse_ = M.lumpedDiagonal(LumpingMethod::RowSum);
+
+    double* m = lumped_mass_inverse_.HostReadWrite();
+    for (int i = 0; i < lumped_mass_inverse_.Size(); i++) {
+      SLIC_ERROR_ROOT_IF(m[i] <= 0.0, "Row-sum lumping of the mass matrix produced a non-positive mass");
+      m[i] = 1.0 / m[i];
+    }
+  }
+
+  /**
+   * @brief Assemble the stiffness dr/du (at the current displacement) and consistent mass dr/da, with the rows and
+   * columns of the essential dofs eliminated
+   *
+   * @param stiffness_diagonal What is left on the diagonal of the stiffness for the essential dofs. That of the mass
+   * is kept.
+   */
+  std::pair<std::unique_ptr<mfem::HypreParMatrix>, std::unique_ptr<mfem::HypreParMatrix>> assembleStiffnessAndMass(
+      mfem::Operator::DiagonalPolicy stiffness_diagonal)
+  {
+    auto [r, dr_du]  = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_),
+                                    acceleration_, *parameters_[parameter_indices].state...);
+    auto [r2, dr_da] = (*residual_)(ode_time_point_, shape_displacement_, displacement_,
+                                    differentiate_wrt(acceleration_), *parameters_[parameter_indices].state...);
+
+    std::unique_ptr<mfem::HypreParMatrix> K = assemble(dr_du);
+    std::unique_ptr<mfem::HypreParMatrix> M = assemble(dr_da);
+    K->EliminateBC(bcs_.allEssentialTrueDofs(), stiffness_diagonal);
+    M->EliminateBC(bcs_.allEssentialTrueDofs(), mfem::Operator::DIAG_KEEP);
+    return {std::move(K), std::move(M)};
+  }
+
+  /// @brief The load f(t) = -r(0, 0) of linear dynamics at the current time, with the essential dofs zeroed
+  mfem::Vector modalLoad()
+  {
+    mfem::Vector zero(displacement_.space().TrueVSize());
+    zero = 0.0;
+
+    // modal superposition only works with homogeneous essential boundary conditions
+    mfem::Vector prescribed = zero;
+    for (auto& bc : bcs_.essentials()) {
+      bc.setDofs(prescribed, time_);
+    }
+    SLIC_ERROR_ROOT_IF(mfem::ParNormlp(prescribed, 2, displacement_.space().GetComm()) > 0.0,
+                       "Modal superposition requires homogeneous essential boundary conditions");
+
+    mfem::Vector f = (*residual_)(time_, shape_displacement_, zero, zero, *parameters_[parameter_indices].state...);
+    f.Neg();
+    f.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+    return f;
+  }
+
+  /**
+   * @brief Take one step of modal superposition, see useModalSuperposition()
+   *
+   * @param dt The size of the step
+   */
+  void modalSolve(double dt)
+  {
+    modal_->setLoad(modalLoad());
+
+    time_ += dt;
+    ode_time_point_ = time_;
+    modal_->step(dt, modalLoad());
+
+    modal_->displacement(displacement_);
+    modal_->velocity(velocity_);
+    modal_->acceleration(acceleration_);
+  }
+
+  /// @brief Overwrite the acceleration with M_L^{-1} (-r(u, 0)), the explicit acceleration at the current displacement
+  void computeExplicitAcceleration()
+  {
+    acceleration_ = 0.0;
+    const mfem::Vector res = (*residual_)(ode_time_point_, shape_displacement_, displacement_, acceleration_,
+                                          *parameters_[parameter_indices].state...);
+    acceleration_ = res;
+    acceleration_ *= lumped_mass_inverse_;
+    acceleration_.Neg();
+    acceleration_.SetSubVector(bcs_.allEssentialTrueDofs(), 0.0);
+  }
+
+  /**
+   * @brief Take one explicit central difference (velocity Verlet) step with the lumped mass
+   *
+   * Each step costs one residual evaluation and a few vector updates, and is only stable for steps smaller than about
+   * stableTimestep(). Prescribed displacements are applied directly, with the velocity of the constrained dofs
+   * following from their change over the step.
+   *
+   * @param dt The size of the step
+   */
+  void explicitSolve(double dt)
+  {
+    // the acceleration is carried over from the end of the previous step, except on the first step
+    if (cycle_ == 0) {
+      ode_time_point_ = time_;
+      computeExplicitAcceleration();
+    }
+
+    const double stable_dt = stableTimestep();
+    SLIC_WARNING_ROOT_IF(dt > stable_dt,
+                         axom::fmt::format("Explicit timestep dt = {} exceeds the estimated stable timestep {}", dt,
+                                           stable_dt));
+
+    // v_{n+1/2} = v_n + dt / 2 a_n,  u_{n+1} = u_n + dt v_{n+1/2}
+    velocity_.Add(0.5 * dt, acceleration_);
+    displacement_.Add(dt, velocity_);
+
+    time_ += dt;
+    ode_time_point_ = time_;
+    for (auto& bc : bcs_.essentials()) {
+      bc.setDofs(displacement_, time_);
+    }
+
+    // v_{n+1} = v_{n+1/2} + dt / 2 a_{n+1}
+    computeExplicitAcceleration();
+    velocity_.Add(0.5 * dt, acceleration_);
+
+    const double* u  = displacement_.HostRead();
+    const double* u0 = step_start_displacement_.HostRead();
+    double*       v  = velocity_.HostReadWrite();
+    for (int dof : bcs_.allEssentialTrueDofs()) {
+      v[dof] = (u[dof] - u0[dof]) / dt;
+    }
+  }
+
+  /**
+   * @brief add an integral to the residual, and keep it to add again to the residual restricted to a band of
+   * elements, see setShapeSensitivityDomain()
+   *
+   * @param add adds the integral to the residual it is called with, restricting its domain to the band it is given
+   */
+  template <typename AddIntegral>
+  void addResidualIntegral(AddIntegral add)
+  {
+    add(*residual_, std::nullopt);
+    residual_integrals_.emplace_back(std::move(add));
+  }
+
+  /**
+   * @brief the part of @a domain in @a band, if there is one
+   *
+   * @tparam StateType the internal variables of the integral over @a domain, whose quadrature data is laid out for
+   * all of @a domain, so integrals with internal variables aren't restricted
+   */
+  template <typename StateType>
+  static Domain restrictToBand(const Domain& domain, const std::optional<Domain>& band)
+  {
+    if (band && (std::is_same_v<StateType, Nothing> || std::is_same_v<StateType, Empty>)) {
+      return domain & *band;
+    }
+    return domain;
+  }
+
+  /// @brief a residual with its domain integrals restricted to @a band
+  std::unique_ptr<residual_type> restrictedResidual(const std::optional<Domain>& band)
+  {
+    std::array<const mfem::ParFiniteElementSpace*, NUM_STATE_VARS + sizeof...(parameter_space)> trial_spaces{
+        &displacement_.space(), &displacement_.space(), &parameters_[parameter_indices].state->space()...};
+
+    auto residual = std::make_unique<residual_type>(&shape_displacement_.space(), &displacement_.space(), trial_spaces);
+    for (auto& add : residual_integrals_) {
+      add(*residual, band);
+    }
+    return residual;
+  }
+
+  /// @brief the residual with its domain integrals restricted to shape_sensitivity_domain_
+  residual_type& shapeSensitivityResidual()
+  {
+    if (!shape_sensitivity_residual_) {
+      shape_sensitivity_residual_ = restrictedResidual(shape_sensitivity_domain_);
+    }
+    return *shape_sensitivity_residual_;
+  }
+
+  /**
+   * @brief add the domain integral of a material's stress response to the residual, see setMaterial()
+   *
+   * @param material the material model, from which the wave speed and coarse operators are built
+   * @param material_functor the q-function of the integral
+   * @param qdata the buffer of material internal variables at each quadrature point
+   */
+  template <int... active_parameters, typename MaterialType, typename Functor, typename StateType>
+  void addMaterialIntegral(DependsOn<active_parameters...>, const MaterialType& material, Functor material_functor,
+                           qdata_type<StateType> qdata)
+  {
+    // record the wave speed of this material alongside the index of the integral it is added as
+    material_wave_speeds_.resize(residual_->numIntegrals(), 0.0);
+    material_wave_speeds_.push_back(solid_mechanics::detail::dilatationalWaveSpeed(material));
+
+    // the quadrature data is shared with the caller, so it is only counted while the caller keeps it alive
+    qdata_bytes_.push_back([weak_qdata = std::weak_ptr<QuadratureData<StateType>>(qdata)]() -> std::size_t {
+      auto current_qdata = weak_qdata.lock();
+      return current_qdata ? current_qdata->bytes() : 0;
+    });
+    stageQuadratureData(qdata);
+
+    // the material state is written to the restart files with the fields, and read back from them on restarts
+    StateManager::storeQuadratureData(
+        qdata, detail::addPrefix(name_, axom::fmt::format("material_state_{}", qdata_bytes_.size() - 1)), mesh_tag_);
+
+    addResidualIntegral([this, material_functor, qdata](residual_type& residual, const std::optional<Domain>& band) {
+      Domain domain = restrictToBand<StateType>(EntireDomain(mesh_), band);
+
+      // the magic number "+ NUM_STATE_VARS" accounts for the fact that the displacement, acceleration, and shape
+      // fields are always-on and come first, so the `n`th parameter will actually be argument `n + NUM_STATE_VARS`
+      residual.AddDomainIntegral(Dimension<dim>{}, DependsOn<0, 1, active_parameters + NUM_STATE_VARS...>{},
+                                 material_functor, domain, qdata);
+    });
+
+    if (multigrid_levels_ || p_multigrid_levels_ || low_order_refined_) {
+      SLIC_ERROR_ROOT_IF(sizeof...(active_parameters) > 0,
+                         "Multigrid and LOR preconditioners do not support materials that depend on parameters");
+    }
+    if (multigrid_levels_) {
+      multigrid_levels_->addDomainIntegral(Dimension<dim>{},
+                                           CoarseMaterialStressFunctor<MaterialType>(material, geom_nonlin_));
+    }
+    if (p_multigrid_levels_) {
+      p_multigrid_levels_->addDomainIntegral(Dimension<dim>{},
+                                             CoarseMaterialStressFunctor<MaterialType>(material, geom_nonlin_));
+    }
+    if (low_order_refined_) {
+      low_order_refined_->addDomainIntegral(Dimension<dim>{},
+                                            CoarseMaterialStressFunctor<MaterialType>(material, geom_nonlin_));
+    }
+  }
+
+  /**
+   * @brief create the piecewise constant output fields of the derived quantities recorded in @a qdata, see
+   * setMaterialWithOutputs()
+   *
+   * Each field is the average of its quantity over each element, which is computed (only when it is written) as the
+   * integral of its quadrature point values divided by the volume of the element.
+   */
+  template <typename StateType, int... j>
+  void addDerivedOutputs(const qdata_type<StateType>& qdata, const std::vector<std::string>& names,
+                         std::integer_sequence<int, j...>)
+  {
+    using averages_type = Functional<L2<0>(trial)>;
+
+    // the volume of each element, as integrated by the same quadrature rule
+    auto volumes = std::make_shared<mfem::Vector>();
+
+    auto add_output = [&](auto output_index, const std::string& name) {
+      constexpr int k = decltype(output_index)::value;
+
+      auto field = std::make_unique<FiniteElementState>(
+          StateManager::newState(L2<0>{}, detail::addPrefix(name_, name), mesh_tag_));
+
+      // the quadrature rule of the residual, see createQuadratureDataBuffer()
+      std::array<const mfem::ParFiniteElementSpace*, 1> trial_spaces{&displacement_.space()};
+      auto integrals = std::make_shared<averages_type>(&field->space(), trial_spaces);
+      integrals->AddDomainIntegral(
+          Dimension<dim>{}, DependsOn<0>{}, QuadratureOrder<order + 1>{},
+          [](double, auto, auto& state, auto) { return serac::tuple{state.outputs[k], zero{}}; }, mesh_, qdata);
+
+      auto update = [this, integrals, volumes, trial_spaces, output = field.get()]() {
+        if (volumes->Size() == 0) {
+          averages_type volume_integrals(&output->space(), trial_spaces);
+          volume_integrals.AddDomainIntegral(
+              Dimension<dim>{}, DependsOn<0>{}, QuadratureOrder<order + 1>{},
+              [](double, auto, auto) { return serac::tuple{1.0, zero{}}; }, mesh_);
+          *volumes = volume_integrals(time_, displacement_);
+        }
+        *output = (*integrals)(time_, displacement_);
+        for (int e = 0; e < output->Size(); e++) {
+          (*output)(e) /= (*volumes)(e);
+        }
+      };
+
+      addOutputField(*field, update);
+      derived_outputs_.push_back(std::move(field));
+    };
+    (add_output(std::integral_constant<int, j>{}, names[size_t(j)]), ...);
+  }
+
+  /**
+   * @brief stage the material states of @a qdata in the residual evaluations of quasi-static solves, so that
+   * commitTimestep() can keep those of the converged displacement, see QuadratureData::stageTrialStates()
+   */
+  template <typename StateType>
+  void stageQuadratureData(const qdata_type<StateType>& qdata)
+  {
+    if constexpr (!std::is_same_v<StateType, Empty> && !std::is_same_v<StateType, Nothing>) {
+      auto weak_qdata = std::weak_ptr<QuadratureData<StateType>>(qdata);
+      qdata_staging_.push_back([weak_qdata](bool stage) {
+        if (auto current_qdata = weak_qdata.lock()) {
+          current_qdata->stageTrialStates(stage);
+        }
+      });
+      qdata_commits_.push_back([weak_qdata]() {
+        auto current_qdata = weak_qdata.lock();
+        return !current_qdata || current_qdata->commitTrialStates();
+      });
+    }
+  }
+
+  /**
+   * @brief freeze (or unfreeze) every argument of the residual other than the displacement, which is the only one
+   * that changes during the Newton iterations of a quasi-static solve, see Functional::freezeArgument()
+   */
+  void freezeResidualArguments(bool frozen)
+  {
+    residual_->freezeArgument(0, frozen);  // the shape displacement
+    for (uint32_t i = 2; i < NUM_STATE_VARS + 1 + sizeof...(parameter_space); i++) {
+      residual_->freezeArgument(i, frozen);
+    }
+  }
+
   /// @brief Solve the Quasi-static Newton system
   virtual void quasiStaticSolve(double dt)
   {
@@ -1653,7 +3048,143 @@ protected:
 
     // this method is essentially equivalent to the 1-liner
     // u += dot(inv(J), dot(J_elim[:, dofs], (U(t + dt) - u)[dofs]));
+    freezeResidualArguments(true);
     nonlin_solver_->solve(displacement_);
+    freezeResidualArguments(false);
+  }
+
+  /// @overload
+  void prepareAdjointTimestep() override
+  {
+    SLIC_ERROR_ROOT_IF(condensed_pressure_, "Adjoint solves are not implemented for mixed materials");
+
+    auto& lin_solver = nonlin_solver_->linearSolver();
+
+    // the adjoint operator is assembled, and transposed gradients need the stored derivatives
+    if (jacobian_policy_ == JacobianPolicy::RecomputedDerivatives) {
+      residual_->recomputeDerivatives(false);
+      jacobian_policy_ = JacobianPolicy::StoredDerivatives;
+    }
+
+    if (is_quasistatic_) {
+      auto [_, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_),
+                                    acceleration_, *parameters_[parameter_indices].state...);
+
+      // a self-adjoint problem reuses the storage of the forward Jacobian (and so its preconditioner setup),
+      // otherwise the transpose is kept (and refilled) across the reverse timesteps
+      auto& J_adjoint   = self_adjoint_ ? J_ : J_T_;
+      auto& J_adjoint_e = self_adjoint_ ? J_e_ : J_T_e_;
+      assembleAdjointOperator(drdu, J_adjoint);
+      bcs_.eliminateAllEssentialDofsFromMatrix(*J_adjoint, J_adjoint_e);
+
+      // the preconditioner no longer corresponds to the forward Jacobian
+      lin_solver.SetOperator(*J_adjoint);
+      jacobian_c0_ = -1.0;
+      return;
+    }
+
+    SLIC_ERROR_ROOT_IF(ode2_.GetTimestepper() != TimestepMethod::Newmark,
+                       "Only Newmark implemented for transient adjoint solid mechanics.");
+
+    SLIC_ERROR_ROOT_IF(cycle_ <= min_cycle_,
+                       "Maximum number of adjoint timesteps exceeded! The number of adjoint timesteps must equal the "
+                       "number of forward timesteps");
+
+    // Load the end of step disp, velo, accel from the previous cycle
+    recomputeCheckpointedStates(cycle_);
+    {
+      auto previous_states_n = getCheckpointedStates(cycle_);
+
+      displacement_ = previous_states_n.at("displacement");
+      velocity_     = previous_states_n.at("velocity");
+      acceleration_ = previous_states_n.at("acceleration");
+    }
+
+    double dt_n = getCheckpointedTimestep(cycle_ - 1);
+
+    // K^T := (dR/du)^T
+    auto K = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_),
+                                                 acceleration_, *parameters_[parameter_indices].state...));
+    assembleAdjointOperator(K, k_adjoint_);
+
+    // M^T := (dR/da)^T
+    auto M = serac::get<DERIVATIVE>((*residual_)(ode_time_point_, shape_displacement_, displacement_,
+                                                 differentiate_wrt(acceleration_),
+                                                 *parameters_[parameter_indices].state...));
+    assembleAdjointOperator(M, m_adjoint_);
+
+    J_T_   = solid_mechanics::detail::adjoint_operator(dt_n, *m_adjoint_, *k_adjoint_);
+    bcs_.eliminateAllEssentialDofsFromMatrix(*J_T_, J_T_e_);
+
+    // the preconditioner no longer corresponds to J_, so a recomputed forward step has to assemble it again
+    lin_solver.SetOperator(*J_T_);
+    jacobian_c0_ = -1.0;
+  }
+
+  /// @overload
+  void solveAdjointTimestep() override
+  {
+    auto& lin_solver = nonlin_solver_->linearSolver();
+
+    // By default, use a homogeneous essential boundary condition
+    mfem::HypreParVector adjoint_essential(displacement_adjoint_load_);
+    adjoint_essential = 0.0;
+
+    if (is_quasistatic_) {
+      auto& J_adjoint   = self_adjoint_ ? J_ : J_T_;
+      auto& J_adjoint_e = self_adjoint_ ? J_e_ : J_T_e_;
+      mfem::EliminateBC(*J_adjoint, *J_adjoint_e, bcs_.allEssentialTrueDofs(), adjoint_essential,
+                        displacement_adjoint_load_);
+
+      lin_solver.Mult(displacement_adjoint_load_, adjoint_displacement_);
+      return;
+    }
+
+    double dt_np1 = getCheckpointedTimestep(cycle_);
+    double dt_n   = getCheckpointedTimestep(cycle_ - 1);
+
+    solid_mechanics::detail::adjoint_integrate(
+        dt_n, dt_np1, *J_T_, *J_T_e_, k_adjoint_.get(), displacement_adjoint_load_, velocity_adjoint_load_,
+        acceleration_adjoint_load_, adjoint_displacement_, implicit_sensitivity_displacement_start_of_step_,
+        implicit_sensitivity_velocity_start_of_step_, adjoint_essential, bcs_, lin_solver);
+  }
+
+  /// @overload
+  void finishAdjointTimestep() override
+  {
+    if (is_quasistatic_) {
+      // Reset the equation solver to use the full nonlinear residual operator.  MRT, is this needed?
+      nonlin_solver_->setOperator(*residual_with_bcs_);
+      return;
+    }
+
+    time_ -= getCheckpointedTimestep(cycle_ - 1);
+    cycle_--;
+  }
+
+  /// @overload
+  std::vector<FiniteElementVector*> adjointTimestepStates() override
+  {
+    return {&adjoint_displacement_, &implicit_sensitivity_displacement_start_of_step_,
+            &implicit_sensitivity_velocity_start_of_step_};
+  }
+
+  /// @overload
+  void computeBatchedTimestepSensitivities(std::vector<TimestepSensitivities>& sensitivities) override
+  {
+    for (size_t i = 0; i < sizeof...(parameter_indices); i++) {
+      auto drdparam = serac::get<DERIVATIVE>(d_residual_d_[i](ode_time_point_));
+      for (size_t q = 0; q < sensitivities.size(); q++) {
+        drdparam.MultTranspose(batchedAdjointSolution(q), sensitivities[q].parameters[i]);
+      }
+    }
+
+    auto drdshape =
+        serac::get<DERIVATIVE>((*residual_)(ode_time_point_, differentiate_wrt(shape_displacement_), displacement_,
+                                            acceleration_, *parameters_[parameter_indices].state...));
+    for (size_t q = 0; q < sensitivities.size(); q++) {
+      drdshape.MultTranspose(batchedAdjointSolution(q), sensitivities[q].shape);
+    }
   }
 
   /**
@@ -1684,8 +3215,7 @@ protected:
         mfem::Array<int> node_dofs;
         for (int d = 0; d < dim; d++) {
           // Get the local dof number for the prescribed component
-          int local_vector_dof = mfem::Ordering::Map<mfem::Ordering::byNODES>(
-              nodal_positions.FESpace()->GetNDofs(), nodal_positions.FESpace()->GetVDim(), i, d);
+          int local_vector_dof = nodal_positions.FESpace()->DofToVDof(i, d);
 
           // Save the spatial position for this coordinate dof
           node_coords(d) = nodal_positions(local_vector_dof);
@@ -1718,14 +3248,36 @@ protected:
 
   /**
    * @brief Sets the Dirichlet BCs for the current time and computes an initial guess for parameters and displacement
+   *
+   * The initial guess is chosen by the predictor of the TimesteppingOptions. Predictor::Extrapolation has already
+   * replaced the displacement by its extrapolation in solveTimestep(), so it only needs the new boundary conditions.
    */
   void warmStartDisplacement(double dt)
   {
-    // Update the linearized Jacobian matrix
-    auto [r, drdu] = (*residual_)(time_, shape_displacement_, differentiate_wrt(displacement_), acceleration_,
-                                  *parameters_[parameter_indices].previous_state...);
-    J_             = assemble(drdu);
-    J_e_           = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+    if (predictor_ == Predictor::PreviousState || predictor_ == Predictor::Extrapolation) {
+      for (auto& bc : bcs_.essentials()) {
+        bc.setDofs(displacement_, time_ + dt);
+      }
+      for (auto& parameter : parameters_) {
+        *parameter.previous_state = *parameter.state;
+      }
+      return;
+    }
+
+    // the Jacobian (and the preconditioner built from it) of the last Newton iteration are still held by the linear
+    // solver, unless no matrix has been assembled yet, e.g. before the first step or in matrix-free mode
+    bool reuse_jacobian = predictor_ == Predictor::PreviousJacobian && J_ && J_e_;
+
+    if (!reuse_jacobian) {
+      // Update the linearized Jacobian matrix
+      auto [r, drdu] = (*residual_)(time_, shape_displacement_, differentiate_wrt(displacement_), acceleration_,
+                                    *parameters_[parameter_indices].previous_state...);
+      assemble(drdu, J_);
+      if (condensed_pressure_) {
+        condensed_pressure_->addToJacobian(time_, displacement_, *pressure_, J_);
+      }
+      bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
+    }
 
     du_ = 0.0;
     for (auto& bc : bcs_.essentials()) {
@@ -1745,12 +3297,13 @@ protected:
     // Update the initial guess for changes in the parameters if this is not the first solve
     for (std::size_t parameter_index = 0; parameter_index < parameters_.size(); ++parameter_index) {
       // Compute the change in parameters parameter_diff = parameter_new - parameter_old
-      serac::FiniteElementState parameter_difference = *parameters_[parameter_index].state;
-      parameter_difference -= *parameters_[parameter_index].previous_state;
+      parameter_difference_.SetSize(parameters_[parameter_index].state->Size());
+      subtract(*parameters_[parameter_index].state, *parameters_[parameter_index].previous_state,
+               parameter_difference_);
 
       // Compute a linearized estimate of the residual forces due to this change in parameter
-      auto drdparam        = serac::get<DERIVATIVE>(d_residual_d_previous_[parameter_index](time_));
-      auto residual_update = drdparam(parameter_difference);
+      auto [_, drdparam]    = d_residual_d_previous_[parameter_index](time_);
+      auto& residual_update = drdparam(parameter_difference_);
 
       // Flip the sign to get the RHS of the Newton update system
       // J^-1 du = - residual
@@ -1767,11 +3320,24 @@ protected:
 
     auto& lin_solver = nonlin_solver_->linearSolver();
 
-    lin_solver.SetOperator(*J_);
+    if (!reuse_jacobian) {
+      lin_solver.SetOperator(*J_);
+    }
 
     lin_solver.Mult(dr_, du_);
     displacement_ += du_;
   }
 };
 
+/// @cond
+// the configurations created by the serac driver (see createPhysics() in drivers/serac.cpp) are compiled once,
+// in solid_mechanics.cpp, instead of in every translation unit that uses them
+extern template class SolidMechanics<1, 2>;
+extern template class SolidMechanics<1, 3>;
+extern template class SolidMechanics<2, 2>;
+extern template class SolidMechanics<2, 3>;
+extern template class SolidMechanics<3, 2>;
+extern template class SolidMechanics<3, 3>;
+/// @endcond
+
 }  // namespace serac
@@ -125,27 +125,38 @@ public:
           displacement_.space().TrueVSize() + contact_.numPressureDofs(), residual_fn,
           // gradient of residual function
           [this](const mfem::Vector& u) -> mfem::Operator& {
+            SLIC_ERROR_ROOT_IF(nonlin_solver_->matrixFree(),
+                               "Matrix-free Jacobians are not supported with Lagrange multiplier contact");
             const mfem::Vector u_blk(const_cast<mfem::Vector&>(u), 0, displacement_.Size());
             auto [r, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u_blk), acceleration_,
                                           *parameters_[parameter_indices].state...);
-            J_             = assemble(drdu);
 
             // create block operator holding jacobian contributions
-            J_constraint_ = contact_.jacobianFunction(u, J_.release());
-
-            // take ownership of blocks
-            J_constraint_->owns_blocks = false;
-            J_                         = std::unique_ptr<mfem::HypreParMatrix>(
-                static_cast<mfem::HypreParMatrix*>(&J_constraint_->GetBlock(0, 0)));
-            J_12_ = std::unique_ptr<mfem::HypreParMatrix>(
-                static_cast<mfem::HypreParMatrix*>(&J_constraint_->GetBlock(0, 1)));
-            J_21_ = std::unique_ptr<mfem::HypreParMatrix>(
-                static_cast<mfem::HypreParMatrix*>(&J_constraint_->GetBlock(1, 0)));
-            J_22_ = std::unique_ptr<mfem::HypreParMatrix>(
-                static_cast<mfem::HypreParMatrix*>(&J_constraint_->GetBlock(1, 1)));
+            auto J_constraint         = contact_.jacobianFunction(u, assemble(drdu).release());
+            J_constraint->owns_blocks = false;
+
+            // Tribol returns new contact blocks on every call. While their sparsity patterns are unchanged (i.e. the
+            // contact pairs and active set are the same), their values are copied into the previous blocks, so the
+            // Jacobian stays the same operator and the preconditioner setup can be reused.
+            auto refill = [&J_constraint](std::unique_ptr<mfem::HypreParMatrix>& block, int i, int j) {
+              return refillOrReplace(block, std::unique_ptr<mfem::HypreParMatrix>(
+                                                static_cast<mfem::HypreParMatrix*>(&J_constraint->GetBlock(i, j))));
+            };
+            bool refilled = refill(J_, 0, 0);
+            refilled      = refill(J_12_, 0, 1) && refilled;
+            refilled      = refill(J_21_, 1, 0) && refilled;
+            refilled      = refill(J_22_, 1, 1) && refilled;
+
+            if (!refilled || !J_constraint_) {
+              J_constraint_ = std::make_unique<mfem::BlockOperator>(J_offsets_);
+              J_constraint_->SetBlock(0, 0, J_.get());
+              J_constraint_->SetBlock(0, 1, J_12_.get());
+              J_constraint_->SetBlock(1, 0, J_21_.get());
+              J_constraint_->SetBlock(1, 1, J_22_.get());
+            }
 
             // eliminate bcs and compute eliminated blocks
-            J_e_    = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
             J_e_21_ = std::unique_ptr<mfem::HypreParMatrix>(J_21_->EliminateCols(bcs_.allEssentialTrueDofs()));
             J_12_->EliminateRows(bcs_.allEssentialTrueDofs());
 
@@ -162,16 +173,28 @@ public:
       // mfem::HypreParMatrix
       return std::make_unique<mfem_ext::StdFunctionOperator>(
           displacement_.space().TrueVSize(), residual_fn, [this](const mfem::Vector& u) -> mfem::Operator& {
+            // in matrix-free mode, neither the gradient nor the penalty terms are assembled, see
+            // ContactJacobianOperator
+            if (nonlin_solver_->matrixFree()) {
+              (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), acceleration_,
+                           *parameters_[parameter_indices].state...);
+              J_contact_matrix_free_ = contact_.jacobianOperator(residual_->gradient(1));
+              J_matrix_free_         = std::make_unique<mfem::ConstrainedOperator>(J_contact_matrix_free_.get(),
+                                                                                   bcs_.allEssentialTrueDofs());
+              J_operator_            = J_matrix_free_.get();
+              return *J_matrix_free_;
+            }
+
             auto [r, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(u), acceleration_,
                                           *parameters_[parameter_indices].state...);
-            J_             = assemble(drdu);
 
-            // get 11-block holding jacobian contributions
-            auto block_J         = contact_.jacobianFunction(u, J_.release());
+            // get 11-block holding jacobian contributions, refilling the previous matrix if its sparsity is unchanged
+            auto block_J         = contact_.jacobianFunction(u, assemble(drdu).release());
             block_J->owns_blocks = false;
-            J_ = std::unique_ptr<mfem::HypreParMatrix>(static_cast<mfem::HypreParMatrix*>(&block_J->GetBlock(0, 0)));
+            refillOrReplace(J_, std::unique_ptr<mfem::HypreParMatrix>(
+                                    static_cast<mfem::HypreParMatrix*>(&block_J->GetBlock(0, 0))));
 
-            J_e_ = bcs_.eliminateAllEssentialDofsFromMatrix(*J_);
+            bcs_.eliminateAllEssentialDofsFromMatrix(*J_, J_e_);
 
             J_operator_ = J_.get();
             return *J_;
@@ -214,10 +237,39 @@ protected:
   {
     // we can use the base class method if we don't have Lagrange multipliers
     if (!contact_.haveLagrangeMultipliers()) {
+      int max_outer_iterations = contact_.maxOuterIterations();
+      if (max_outer_iterations == 0 && !contact_.havePenaltyScaling()) {
+        SolidMechanicsBase::quasiStaticSolve(dt);
+        return;
+      }
+
+      // the penalties and the predicted active sets come from the (converged) displacement at the start of the step
+      mfem::Vector stiffness_diagonal;
+      if (contact_.havePenaltyScaling()) {
+        auto [r, drdu] = (*residual_)(ode_time_point_, shape_displacement_, differentiate_wrt(displacement_),
+                                      acceleration_, *parameters_[parameter_indices].state...);
+        stiffness_diagonal.SetSize(displacement_.Size());
+        drdu.AssembleDiagonal(stiffness_diagonal);
+      }
+      contact_.startOuterIterations(displacement_, stiffness_diagonal);
+
       SolidMechanicsBase::quasiStaticSolve(dt);
+
+      // solve the step again with the updated multipliers and active sets, until the contact constraints are met
+      freezeResidualArguments(true);
+      for (int i = 0; i < max_outer_iterations && !contact_.outerIterationConverged(displacement_); ++i) {
+        nonlin_solver_->solve(displacement_);
+      }
+      freezeResidualArguments(false);
+
+      contact_.endOuterIterations();
       return;
     }
 
+    // the linear solver holds the Jacobian of the block system with the contact constraints, not J_
+    SLIC_ERROR_ROOT_IF(predictor_ == Predictor::PreviousJacobian,
+                       "Predictor::PreviousJacobian is not supported with Lagrange multiplier contact");
+
     // this method is essentially equivalent to the 1-liner
     // u += dot(inv(J), dot(J_elim[:, dofs], (U(t + dt) - u)[dofs]));
     // warm start for contact needs to include the previous stiffness terms associated with contact
@@ -255,10 +307,13 @@ protected:
   using SolidMechanicsBase::displacement_;
   using SolidMechanicsBase::dr_;
   using SolidMechanicsBase::du_;
+  using SolidMechanicsBase::freezeResidualArguments;
   using SolidMechanicsBase::J_;
   using SolidMechanicsBase::J_e_;
+  using SolidMechanicsBase::J_matrix_free_;
   using SolidMechanicsBase::nonlin_solver_;
   using SolidMechanicsBase::ode_time_point_;
+  using SolidMechanicsBase::predictor_;
   using SolidMechanicsBase::residual_;
   using SolidMechanicsBase::residual_with_bcs_;
   using SolidMechanicsBase::warmStartDisplacement;
@@ -288,6 +343,10 @@ protected:
   /// because are associated with essential boundary conditions
   std::unique_ptr<mfem::BlockOperator> J_constraint_e_;
 
+  /// The Jacobian with the contact terms, before its essential dofs are constrained in J_matrix_free_ (matrix-free
+  /// mode only)
+  std::unique_ptr<ContactJacobianOperator> J_contact_matrix_free_;
+
   /// @brief Class holding contact constraint data
   ContactData contact_;
 };
@@ -0,0 +1,148 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/checkpoint_compression.hpp"
+
+#include <cmath>
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// the largest quantized value, chosen so that differences of quantized values do not overflow
+constexpr double max_quantized_value = 2305843009213693952.0;  // 2^61
+
+void encodeVarint(std::uint64_t value, std::vector<std::uint8_t>& bytes)
+{
+  while (value >= 0x80) {
+    bytes.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  bytes.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::uint64_t decodeVarint(const std::uint8_t*& bytes)
+{
+  std::uint64_t value = 0;
+  int           shift = 0;
+  while (*bytes & 0x80) {
+    value |= static_cast<std::uint64_t>(*bytes++ & 0x7f) << shift;
+    shift += 7;
+  }
+  value |= static_cast<std::uint64_t>(*bytes++) << shift;
+  return value;
+}
+
+}  // namespace
+
+CompressedVector::CompressedVector(const mfem::Vector& v, const CheckpointCompressionOptions& options)
+{
+  compress(v, options);
+}
+
+void CompressedVector::compress(const mfem::Vector& v, const CheckpointCompressionOptions& options)
+{
+  options_ = options;
+  size_    = v.Size();
+
+  const double* values = v.HostRead();
+
+  // the buffers keep their capacity, so recompressing vectors of the same size doesn't allocate
+  doubles_.clear();
+  floats_.clear();
+  bytes_.clear();
+
+  switch (options_.method) {
+    case CheckpointCompression::None:
+      doubles_.assign(values, values + size_);
+      break;
+
+    case CheckpointCompression::SinglePrecision:
+      floats_.resize(static_cast<std::size_t>(size_));
+      for (int i = 0; i < size_; i++) {
+        floats_[static_cast<std::size_t>(i)] = static_cast<float>(values[i]);
+      }
+      break;
+
+    case CheckpointCompression::Quantized: {
+      SLIC_ERROR_ROOT_IF(options_.tolerance <= 0.0, "Quantized checkpoint compression requires a positive tolerance");
+      const double quantum  = 2.0 * options_.tolerance;
+      std::int64_t previous = 0;
+      bytes_.reserve(static_cast<std::size_t>(size_));
+      for (int i = 0; i < size_; i++) {
+        double scaled = std::round(values[i] / quantum);
+        SLIC_ERROR_ROOT_IF(!(std::abs(scaled) <= max_quantized_value),
+                           "Checkpointed value cannot be quantized with the requested tolerance");
+        auto quantized  = static_cast<std::int64_t>(scaled);
+        auto difference = quantized - previous;
+        previous        = quantized;
+
+        // zigzag encoding, so that small negative differences also take few bytes
+        encodeVarint((static_cast<std::uint64_t>(difference) << 1) ^ static_cast<std::uint64_t>(difference >> 63),
+                     bytes_);
+      }
+      break;
+    }
+  }
+}
+
+void CompressedVector::reserve(int size, const CheckpointCompressionOptions& options)
+{
+  auto n = static_cast<std::size_t>(size);
+  switch (options.method) {
+    case CheckpointCompression::None:
+      doubles_.reserve(n);
+      break;
+    case CheckpointCompression::SinglePrecision:
+      floats_.reserve(n);
+      break;
+    case CheckpointCompression::Quantized:
+      bytes_.reserve(n);
+      break;
+  }
+}
+
+void CompressedVector::decompress(mfem::Vector& v) const
+{
+  SLIC_ERROR_ROOT_IF(v.Size() != size_, "Vector size does not match the size of the compressed checkpoint");
+
+  double* values = v.HostWrite();
+
+  switch (options_.method) {
+    case CheckpointCompression::None:
+      for (int i = 0; i < size_; i++) {
+        values[i] = doubles_[static_cast<std::size_t>(i)];
+      }
+      break;
+
+    case CheckpointCompression::SinglePrecision:
+      for (int i = 0; i < size_; i++) {
+        values[i] = static_cast<double>(floats_[static_cast<std::size_t>(i)]);
+      }
+      break;
+
+    case CheckpointCompression::Quantized: {
+      const double        quantum   = 2.0 * options_.tolerance;
+      const std::uint8_t* bytes     = bytes_.data();
+      std::int64_t        quantized = 0;
+      for (int i = 0; i < size_; i++) {
+        std::uint64_t zigzag = decodeVarint(bytes);
+        quantized += static_cast<std::int64_t>(zigzag >> 1) ^ -static_cast<std::int64_t>(zigzag & 1);
+        values[i] = static_cast<double>(quantized) * quantum;
+      }
+      break;
+    }
+  }
+}
+
+std::size_t CompressedVector::bytes() const
+{
+  return doubles_.capacity() * sizeof(double) + floats_.capacity() * sizeof(float) + bytes_.capacity();
+}
+
+}  // namespace serac
@@ -0,0 +1,108 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file checkpoint_compression.hpp
+ *
+ * @brief Compressed storage for the in-memory checkpoints of transient adjoint solves
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "mfem.hpp"
+
+namespace serac {
+
+/// @brief The ways a checkpointed state can be stored in memory
+enum class CheckpointCompression
+{
+  None,             ///< Full double precision copy
+  SinglePrecision,  ///< Lossy, rounds every value to single precision (2x smaller)
+  Quantized         ///< Lossy with a bounded absolute error, quantizes and entropy codes the values
+};
+
+/// @brief How a single checkpointed state is stored in memory
+struct CheckpointCompressionOptions {
+  /// The compression method
+  CheckpointCompression method = CheckpointCompression::None;
+
+  /// The maximum absolute error of every value for CheckpointCompression::Quantized
+  double tolerance = 0.0;
+};
+
+/**
+ * @brief The values of a vector, stored with one of the CheckpointCompression methods
+ *
+ * For CheckpointCompression::Quantized, each value is rounded to the closest multiple of twice the tolerance.
+ * The differences between consecutive quantized values are then stored as zigzag variable length integers, which
+ * take a single byte for smooth fields whose neighbouring dofs vary by less than about 64 quanta.
+ */
+class CompressedVector {
+public:
+  /// @brief Construct an empty compressed vector
+  CompressedVector() = default;
+
+  /**
+   * @brief Compress the values of a vector
+   *
+   * @param v The vector to compress
+   * @param options How to compress it
+   */
+  CompressedVector(const mfem::Vector& v, const CheckpointCompressionOptions& options);
+
+  /**
+   * @brief Compress the values of a vector, reusing the storage of the values compressed before
+   *
+   * @param v The vector to compress
+   * @param options How to compress it
+   */
+  void compress(const mfem::Vector& v, const CheckpointCompressionOptions& options);
+
+  /**
+   * @brief Allocate the storage for compressing a vector ahead of time, so that compress() doesn't allocate
+   *
+   * @param size The number of values to store
+   * @param options How they will be compressed
+   *
+   * @note For CheckpointCompression::Quantized this assumes one byte per value, so vectors that compress less well
+   * still grow their storage
+   */
+  void reserve(int size, const CheckpointCompressionOptions& options);
+
+  /**
+   * @brief Decompress the stored values
+   *
+   * @param v The vector to overwrite, which must have the size of the compressed vector
+   */
+  void decompress(mfem::Vector& v) const;
+
+  /// @brief The number of values stored
+  int size() const { return size_; }
+
+  /// @brief The approximate number of bytes allocated to store the values, including storage kept for reuse
+  std::size_t bytes() const;
+
+private:
+  /// @brief How the values are stored
+  CheckpointCompressionOptions options_;
+
+  /// @brief The number of values stored
+  int size_ = 0;
+
+  /// @brief The values for CheckpointCompression::None
+  std::vector<double> doubles_;
+
+  /// @brief The values for CheckpointCompression::SinglePrecision
+  std::vector<float> floats_;
+
+  /// @brief The encoded quantized differences for CheckpointCompression::Quantized
+  std::vector<std::uint8_t> bytes_;
+};
+
+}  // namespace serac
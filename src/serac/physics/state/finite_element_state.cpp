@@ -89,6 +89,49 @@ void FiniteElementState::project(mfem::VectorCoefficient& coef, const Domain& do
   setFromGridFunction(grid_function);
 }
 
+void FiniteElementState::domainNodes(const Domain& domain, std::vector<int>& dofs,
+                                     std::vector<double>& coordinates) const
+{
+  const mfem::ParFiniteElementSpace& fes = space();
+  mfem::ParMesh&                     msh = mesh_;
+  const int                          dim = msh.SpaceDimension();
+
+  // a node shared by several elements of the domain is kept with the first of them
+  std::vector<bool> visited(std::size_t(fes.GetNDofs()), false);
+  mfem::Array<int>  element_dofs;
+  mfem::DenseMatrix x;
+
+  auto gather = [&](const mfem::FiniteElement* fe, mfem::ElementTransformation* T) {
+    SLIC_ERROR_ROOT_IF(dynamic_cast<const mfem::NodalFiniteElement*>(fe) == nullptr,
+                       "Projecting functions requires a nodal finite element space, e.g. H1 or L2");
+    T->Transform(fe->GetNodes(), x);
+    for (int j = 0; j < element_dofs.Size(); j++) {
+      int dof = element_dofs[j];
+      if (visited[std::size_t(dof)]) continue;
+
+      visited[std::size_t(dof)] = true;
+      dofs.push_back(dof);
+      for (int k = 0; k < dim; k++) {
+        coordinates.push_back(x(k, j));
+      }
+    }
+  };
+
+  for (const auto* ids : {&domain.mfem_edge_ids_, &domain.mfem_tri_ids_, &domain.mfem_quad_ids_,
+                          &domain.mfem_tet_ids_, &domain.mfem_hex_ids_, &domain.mfem_prism_ids_}) {
+    for (int id : *ids) {
+      // as in Domain::dof_list(), the boundary domains are made of faces
+      if (domain.type_ == Domain::Type::Elements) {
+        fes.GetElementDofs(id, element_dofs);
+        gather(fes.GetFE(id), msh.GetElementTransformation(id));
+      } else {
+        fes.GetFaceDofs(id, element_dofs);
+        gather(fes.GetFaceElement(id), msh.GetFaceTransformation(id));
+      }
+    }
+  }
+}
+
 mfem::ParGridFunction& FiniteElementState::gridFunction() const
 {
   if (!grid_func_) {
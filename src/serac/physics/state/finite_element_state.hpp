@@ -16,7 +16,10 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
+#include "axom/fmt.hpp"
 #include "mfem.hpp"
 
 #include "serac/infrastructure/variant.hpp"
@@ -206,6 +209,62 @@ public:
   /// \overload
   void project(mfem::VectorCoefficient& coef, const Domain& d);
 
+  /**
+   * @brief Project a function of the physical coordinates onto the nodes of a domain
+   *
+   * Unlike the coefficient overloads, which evaluate a virtual function at every node of every element, this gathers
+   * the coordinates of the unique nodes of @a domain into a flat array, then evaluates @a f once at each of them,
+   * distributing the nodes across the host threads (see accelerator::forall_host()).
+   *
+   * @tparam dim The spatial dimension of the mesh
+   * @param f The function, `f(const tensor<double, dim>& x)`, which returns the value at the point x: a double, or a
+   * `tensor<double, n>` with the vector dimension n of the state
+   * @param domain The domain whose nodes are set
+   *
+   * @note @a f may be called concurrently. As with the other overloads, this only sets nodal values, so it requires a
+   * nodal finite element space (e.g. H1 or L2).
+   */
+  template <int dim, typename Function>
+  void project(const Function& f, const Domain& domain)
+  {
+    SLIC_ERROR_ROOT_IF(mesh().SpaceDimension() != dim,
+                       axom::fmt::format("Projecting a function of {}D points onto a state on a {}D mesh", dim,
+                                         mesh().SpaceDimension()));
+
+    using value_type = decltype(f(tensor<double, dim>{}));
+    const int vdim   = space().GetVDim();
+    SLIC_ERROR_ROOT_IF(serac::size(value_type{}) != vdim,
+                       axom::fmt::format("Projecting a function with {} components onto a state with {}",
+                                         serac::size(value_type{}), vdim));
+
+    std::vector<int>    dofs;
+    std::vector<double> coordinates;
+    domainNodes(domain, dofs, coordinates);
+
+    mfem::ParGridFunction& grid_function = gridFunction();
+    double*                values        = grid_function.HostReadWrite();
+    const bool             by_nodes      = space().GetOrdering() == mfem::Ordering::byNODES;
+    const int              num_nodes     = space().GetNDofs();
+
+    accelerator::forall_host(dofs.size(), [&](std::size_t i) {
+      tensor<double, dim> x;
+      for (int j = 0; j < dim; j++) {
+        x[j] = coordinates[i * dim + std::size_t(j)];
+      }
+
+      value_type value = f(x);
+      if constexpr (std::is_same_v<value_type, double>) {
+        values[dofs[i]] = value;
+      } else {
+        for (int c = 0; c < vdim; c++) {
+          values[by_nodes ? c * num_nodes + dofs[i] : dofs[i] * vdim + c] = value[c];
+        }
+      }
+    });
+
+    setFromGridFunction(grid_function);
+  }
+
   /**
    * @brief Construct a grid function from the finite element state true vector
    *
@@ -214,6 +273,15 @@ public:
   mfem::ParGridFunction& gridFunction() const;
 
 protected:
+  /**
+   * @brief Gather the unique nodes of a domain, see project(const Function&, const Domain&)
+   *
+   * @param domain The domain of the nodes
+   * @param[out] dofs The local scalar dof of each node
+   * @param[out] coordinates The physical coordinates of each node, contiguous
+   */
+  void domainNodes(const Domain& domain, std::vector<int>& dofs, std::vector<double>& coordinates) const;
+
   /**
    * @brief An optional container for a grid function (L-vector) view of the finite element state.
    *
@@ -61,14 +61,15 @@ public:
    * @tparam FunctionSpace what kind of interpolating functions to use
    * @param mesh The mesh used to construct the finite element state
    * @param name The name of the new finite element state field
+   * @param ordering how the components of a vector-valued field are laid out, see generateParFiniteElementSpace()
    */
   template <typename FunctionSpace>
-  FiniteElementVector(mfem::ParMesh& mesh, FunctionSpace, const std::string& name = "") : mesh_(mesh), name_(name)
+  FiniteElementVector(mfem::ParMesh& mesh, FunctionSpace, const std::string& name = "",
+                      mfem::Ordering::Type ordering = mfem::Ordering::byNODES)
+      : mesh_(mesh), name_(name)
   {
     const int dim = mesh.Dimension();
 
-    const auto ordering = mfem::Ordering::byNODES;
-
     switch (FunctionSpace::family) {
       case Family::H1:
         coll_ = std::make_unique<mfem::H1_FECollection>(FunctionSpace::order, dim);
@@ -0,0 +1,263 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include "serac/physics/state/probes.hpp"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+#include "axom/fmt.hpp"
+
+#include "serac/infrastructure/logger.hpp"
+
+namespace serac {
+
+namespace {
+
+/// @brief An axis-aligned bounding box
+struct Box {
+  /// The lower corner
+  std::array<double, 3> min = {0.0, 0.0, 0.0};
+
+  /// The upper corner
+  std::array<double, 3> max = {0.0, 0.0, 0.0};
+
+  /// @brief whether @a x (of dimension @a dim) is inside of the box
+  bool contains(const mfem::Vector& x, int dim) const
+  {
+    for (int i = 0; i < dim; i++) {
+      if (x(i) < min[size_t(i)] || x(i) > max[size_t(i)]) return false;
+    }
+    return true;
+  }
+};
+
+/// @brief A bounding box tree of the elements of a mesh
+class ElementTree {
+public:
+  /// @brief the tree of the local elements of @a mesh
+  explicit ElementTree(mfem::Mesh& mesh) : dim_(mesh.SpaceDimension())
+  {
+    int num_elements = mesh.GetNE();
+
+    // the elements may be curved, so their boxes are those of a lattice of points in each of them, padded a little
+    boxes_.resize(size_t(num_elements));
+    mfem::DenseMatrix coordinates;
+    for (int e = 0; e < num_elements; e++) {
+      const auto* lattice = mfem::GlobGeometryRefiner.Refine(mesh.GetElementBaseGeometry(e), 3);
+      mesh.GetElementTransformation(e)->Transform(lattice->RefPts, coordinates);
+
+      Box& box = boxes_[size_t(e)];
+      for (int i = 0; i < dim_; i++) {
+        box.min[size_t(i)] = std::numeric_limits<double>::max();
+        box.max[size_t(i)] = std::numeric_limits<double>::lowest();
+        for (int j = 0; j < coordinates.Width(); j++) {
+          box.min[size_t(i)] = std::min(box.min[size_t(i)], coordinates(i, j));
+          box.max[size_t(i)] = std::max(box.max[size_t(i)], coordinates(i, j));
+        }
+      }
+      double padding = 0.0;
+      for (int i = 0; i < dim_; i++) {
+        padding = std::max(padding, 0.05 * (box.max[size_t(i)] - box.min[size_t(i)]));
+      }
+      for (int i = 0; i < dim_; i++) {
+        box.min[size_t(i)] -= padding;
+        box.max[size_t(i)] += padding;
+      }
+    }
+
+    elements_.resize(size_t(num_elements));
+    std::iota(elements_.begin(), elements_.end(), 0);
+    if (num_elements > 0) {
+      nodes_.resize(1);
+      build(0, 0, size_t(num_elements));
+    }
+  }
+
+  /// @brief the elements whose boxes contain @a x
+  std::vector<int> candidates(const mfem::Vector& x) const
+  {
+    std::vector<int> found;
+    if (nodes_.empty()) return found;
+
+    std::vector<size_t> stack = {0};
+    while (!stack.empty()) {
+      const Node& node = nodes_[stack.back()];
+      stack.pop_back();
+      if (!node.box.contains(x, dim_)) continue;
+
+      if (node.left == 0) {
+        for (size_t i = node.first; i < node.first + node.count; i++) {
+          if (boxes_[size_t(elements_[i])].contains(x, dim_)) {
+            found.push_back(elements_[i]);
+          }
+        }
+      } else {
+        stack.push_back(node.left);
+        stack.push_back(node.left + 1);
+      }
+    }
+    return found;
+  }
+
+private:
+  /// @brief the number of elements below which a node is not split
+  static constexpr size_t leaf_size = 8;
+
+  /// @brief a node of the tree, which is either split in two (its children) or a leaf with a range of elements_
+  struct Node {
+    /// the box containing the boxes of all of the elements below the node
+    Box box;
+
+    /// the index of the first child, the second one comes right after it, or 0 for leaves
+    size_t left = 0;
+
+    /// the first of the elements of a leaf
+    size_t first = 0;
+
+    /// the number of elements of a leaf
+    size_t count = 0;
+  };
+
+  /// @brief fill in node @a index with the elements [first, first + count), and create the nodes below it
+  void build(size_t index, size_t first, size_t count)
+  {
+    Box box = boxes_[size_t(elements_[first])];
+    for (size_t i = first + 1; i < first + count; i++) {
+      const Box& element_box = boxes_[size_t(elements_[i])];
+      for (size_t j = 0; j < 3; j++) {
+        box.min[j] = std::min(box.min[j], element_box.min[j]);
+        box.max[j] = std::max(box.max[j], element_box.max[j]);
+      }
+    }
+    nodes_[index].box = box;
+
+    if (count <= leaf_size) {
+      nodes_[index].first = first;
+      nodes_[index].count = count;
+      return;
+    }
+
+    // split at the median of the element centers along the longest side of the box
+    size_t axis = 0;
+    for (size_t j = 1; j < size_t(dim_); j++) {
+      if (box.max[j] - box.min[j] > box.max[axis] - box.min[axis]) axis = j;
+    }
+    auto begin = elements_.begin() + std::ptrdiff_t(first);
+    auto end   = begin + std::ptrdiff_t(count);
+    std::nth_element(begin, begin + std::ptrdiff_t(count / 2), end, [&](int a, int b) {
+      const Box& box_a = boxes_[size_t(a)];
+      const Box& box_b = boxes_[size_t(b)];
+      return box_a.min[axis] + box_a.max[axis] < box_b.min[axis] + box_b.max[axis];
+    });
+
+    size_t left = nodes_.size();
+    nodes_.resize(left + 2);
+    nodes_[index].left = left;
+    build(left, first, count / 2);
+    build(left + 1, first + count / 2, count - count / 2);
+  }
+
+  /// the spatial dimension of the mesh
+  int dim_;
+
+  /// the bounding box of each element
+  std::vector<Box> boxes_;
+
+  /// the elements, ordered so that the elements of each leaf are contiguous
+  std::vector<int> elements_;
+
+  /// the nodes of the tree, the root first
+  std::vector<Node> nodes_;
+};
+
+}  // namespace
+
+Probes::Probes(mfem::ParMesh& mesh, std::vector<mfem::Vector> points)
+    : comm_(mesh.GetComm()), points_(std::move(points)), owners_(points_.size())
+{
+  int rank = 0;
+  MPI_Comm_rank(comm_, &rank);
+
+  ElementTree tree(mesh);
+
+  // every rank finds the points of its own elements, and the lowest of those ranks keeps each point
+  std::vector<Location> candidates;
+  for (size_t i = 0; i < points_.size(); i++) {
+    SLIC_ERROR_ROOT_IF(points_[i].Size() != mesh.SpaceDimension(),
+                       axom::fmt::format("Probe {} has {} coordinates in a mesh of dimension {}", i, points_[i].Size(),
+                                         mesh.SpaceDimension()));
+    owners_[i] = std::numeric_limits<int>::max();
+    for (int e : tree.candidates(points_[i])) {
+      mfem::InverseElementTransformation inverse(mesh.GetElementTransformation(e));
+      mfem::IntegrationPoint             ip;
+      if (inverse.Transform(points_[i], ip) == mfem::InverseElementTransformation::Inside) {
+        candidates.push_back({int(i), e, ip});
+        owners_[i] = rank;
+        break;
+      }
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, owners_.data(), int(owners_.size()), MPI_INT, MPI_MIN, comm_);
+
+  for (const auto& candidate : candidates) {
+    if (owners_[size_t(candidate.point)] == rank) {
+      locations_.push_back(candidate);
+    }
+  }
+
+  for (size_t i = 0; i < owners_.size(); i++) {
+    if (owners_[i] == std::numeric_limits<int>::max()) {
+      owners_[i] = -1;
+      SLIC_WARNING_ROOT(axom::fmt::format("Probe {} is outside of the mesh", i));
+    }
+  }
+}
+
+std::vector<double> Probes::sample(const std::vector<const FiniteElementState*>& states) const
+{
+  // the offsets of the values of each state in the samples
+  std::vector<size_t> offsets = {0};
+  for (const auto* state : states) {
+    offsets.push_back(offsets.back() + points_.size() * size_t(state->space().GetVDim()));
+  }
+
+  std::vector<double> samples(offsets.back(), 0.0);
+  mfem::Vector        value;
+  for (size_t s = 0; s < states.size(); s++) {
+    // note: this is collective, so it happens on every rank, even those without any points
+    const mfem::ParGridFunction& grid_function = states[s]->gridFunction();
+    size_t                       vdim          = size_t(states[s]->space().GetVDim());
+
+    for (const auto& location : locations_) {
+      grid_function.GetVectorValue(location.element, location.ip, value);
+      for (size_t c = 0; c < vdim; c++) {
+        samples[offsets[s] + size_t(location.point) * vdim + c] = value(int(c));
+      }
+    }
+  }
+
+  int rank = 0;
+  MPI_Comm_rank(comm_, &rank);
+  MPI_Reduce(rank == 0 ? MPI_IN_PLACE : samples.data(), samples.data(), int(samples.size()), MPI_DOUBLE, MPI_SUM, 0,
+             comm_);
+  if (rank != 0) return {};
+
+  for (size_t s = 0; s < states.size(); s++) {
+    size_t vdim = size_t(states[s]->space().GetVDim());
+    for (size_t i = 0; i < points_.size(); i++) {
+      if (owners_[i] >= 0) continue;
+      for (size_t c = 0; c < vdim; c++) {
+        samples[offsets[s] + i * vdim + c] = std::numeric_limits<double>::quiet_NaN();
+      }
+    }
+  }
+  return samples;
+}
+
+}  // namespace serac
@@ -0,0 +1,89 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+/**
+ * @file probes.hpp
+ *
+ * @brief Sampling finite element states at a fixed set of points, e.g. the locations of sensors
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "mfem.hpp"
+
+#include "serac/physics/state/finite_element_state.hpp"
+
+namespace serac {
+
+/**
+ * @brief The values of finite element states at a fixed set of points of a mesh
+ *
+ * The points are located once, when the probes are created, with a bounding box tree of the local elements of each
+ * rank. Each point is owned by the lowest rank that has an element containing it, which keeps the element and the
+ * reference coordinates of the point, so sampling only evaluates the states in those elements, followed by a single
+ * reduction to the root rank.
+ */
+class Probes {
+public:
+  /**
+   * @brief Locate @a points in @a mesh
+   *
+   * @param mesh The mesh of the states to sample
+   * @param points The physical coordinates of the points, the same on every rank
+   *
+   * @note Points that are outside of the mesh are reported with a warning, and their values are NaN
+   */
+  Probes(mfem::ParMesh& mesh, std::vector<mfem::Vector> points);
+
+  /// @brief The number of points
+  int size() const { return static_cast<int>(points_.size()); }
+
+  /// @brief The physical coordinates of each point
+  const std::vector<mfem::Vector>& points() const { return points_; }
+
+  /// @brief Whether point @a i is inside of the mesh
+  bool found(int i) const { return owners_[static_cast<std::size_t>(i)] >= 0; }
+
+  /**
+   * @brief Evaluate @a states at every point
+   *
+   * @param states The states to sample, which must be defined on the mesh of the probes
+   * @return On the root rank, the values of each state in turn, with the components of each point contiguous:
+   * @a states[0] at points 0, 1, ... then @a states[1] at points 0, 1, ... On the other ranks, nothing.
+   *
+   * @note This is a collective operation
+   */
+  std::vector<double> sample(const std::vector<const FiniteElementState*>& states) const;
+
+private:
+  /// @brief A point in one of the local elements
+  struct Location {
+    /// The index of the point
+    int point;
+
+    /// The local element which contains the point
+    int element;
+
+    /// The reference coordinates of the point in its element
+    mfem::IntegrationPoint ip;
+  };
+
+  /// The communicator of the mesh
+  MPI_Comm comm_;
+
+  /// The physical coordinates of each point
+  std::vector<mfem::Vector> points_;
+
+  /// The rank which owns each point, or -1 for points outside of the mesh
+  std::vector<int> owners_;
+
+  /// The points owned by this rank
+  std::vector<Location> locations_;
+};
+
+}  // namespace serac
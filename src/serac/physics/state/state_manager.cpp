@@ -6,20 +6,34 @@
 
 #include "serac/physics/state/state_manager.hpp"
 
+#include <algorithm>
+
 #include "axom/core.hpp"
+#include "axom/sidre.hpp"
+#include "conduit_relay_config.h"
+#ifdef CONDUIT_RELAY_IO_HDF5_ENABLED
+#include "conduit_relay_io_hdf5.hpp"
+#endif
 
 namespace serac {
 
 // Initialize StateManager's static members - these will be fully initialized in StateManager::initialize
 std::unordered_map<std::string, axom::sidre::MFEMSidreDataCollection> StateManager::datacolls_;
 std::unordered_map<std::string, std::unique_ptr<FiniteElementState>>  StateManager::shape_displacements_;
+std::list<StateManager::LoadedCheckpoint>                             StateManager::loaded_checkpoints_;
 bool                                                                  StateManager::is_restart_ = false;
 axom::sidre::DataStore*                                               StateManager::ds_         = nullptr;
 std::string                                                           StateManager::output_dir_ = "";
+SaveOptions                                                           StateManager::save_options_;
 std::unordered_map<std::string, mfem::ParGridFunction*>               StateManager::named_states_;
 std::unordered_map<std::string, mfem::ParGridFunction*>               StateManager::named_duals_;
+std::unordered_map<std::string, StateManager::StoredQuadratureData>   StateManager::named_quadrature_data_;
+
+std::unordered_map<std::string, std::unique_ptr<mfem::ParGridFunction>>      StateManager::transferred_states_;
+std::unordered_map<std::string, std::vector<std::unique_ptr<mfem::ParMesh>>> StateManager::coarse_meshes_;
 
-double StateManager::newDataCollection(const std::string& name, const std::optional<int> cycle_to_load)
+double StateManager::newDataCollection(const std::string& name, const std::optional<int> cycle_to_load,
+                                       MPI_Comm comm)
 {
   SLIC_ERROR_ROOT_IF(!ds_, "Cannot construct a DataCollection without a DataStore");
   std::string coll_name = name + "_datacoll";
@@ -33,7 +47,7 @@ double StateManager::newDataCollection(const std::string& name, const std::optio
   auto [iter, _]                = datacolls_.emplace(std::piecewise_construct, std::forward_as_tuple(name),
                                                      std::forward_as_tuple(coll_name, bp_index_grp, domain_grp, owns_mesh_data));
   auto& datacoll                = iter->second;
-  datacoll.SetComm(MPI_COMM_WORLD);
+  datacoll.SetComm(comm);
 
   datacoll.SetPrefixPath(output_dir_);
 
@@ -90,18 +104,38 @@ double StateManager::newDataCollection(const std::string& name, const std::optio
   return datacoll.GetTime();
 }
 
+axom::sidre::MFEMSidreDataCollection& StateManager::loadedCheckpoint(const std::string& mesh_tag, int cycle_to_load,
+                                                                     MPI_Comm comm)
+{
+  auto loaded = std::find_if(loaded_checkpoints_.begin(), loaded_checkpoints_.end(), [&](const auto& checkpoint) {
+    return checkpoint.mesh_tag == mesh_tag && checkpoint.cycle == cycle_to_load;
+  });
+
+  if (loaded == loaded_checkpoints_.end()) {
+    std::string coll_name = mesh_tag + "_datacoll";
+
+    auto datacoll = std::make_unique<axom::sidre::MFEMSidreDataCollection>(coll_name);
+    datacoll->SetComm(comm);
+    datacoll->SetPrefixPath(output_dir_);
+    datacoll->Load(cycle_to_load);
+
+    loaded_checkpoints_.push_front({mesh_tag, cycle_to_load, std::move(datacoll)});
+    if (loaded_checkpoints_.size() > max_loaded_checkpoints_) {
+      loaded_checkpoints_.pop_back();
+    }
+  } else {
+    loaded_checkpoints_.splice(loaded_checkpoints_.begin(), loaded_checkpoints_, loaded);
+  }
+
+  return *loaded_checkpoints_.front().datacoll;
+}
+
 void StateManager::loadCheckpointedStates(int                                                     cycle_to_load,
                                           std::vector<std::reference_wrapper<FiniteElementState>> states_to_load)
 {
   std::string mesh_name = collectionID(&states_to_load.begin()->get().mesh());
 
-  std::string coll_name = mesh_name + "_datacoll";
-
-  axom::sidre::MFEMSidreDataCollection previous_datacoll(coll_name);
-
-  previous_datacoll.SetComm(states_to_load.begin()->get().mesh().GetComm());
-  previous_datacoll.SetPrefixPath(output_dir_);
-  previous_datacoll.Load(cycle_to_load);
+  auto& previous_datacoll = loadedCheckpoint(mesh_name, cycle_to_load, states_to_load.begin()->get().mesh().GetComm());
 
   for (auto state : states_to_load) {
     SLIC_ERROR_ROOT_IF(collectionID(&state.get().mesh()) != mesh_name,
@@ -141,7 +175,8 @@ void StateManager::storeState(FiniteElementState& state)
   auto&                  datacoll = datacolls_.at(mesh_tag);
   const std::string      name     = state.name();
   mfem::ParGridFunction* grid_function;
-  if (is_restart_) {
+  // the data collection of a mesh replaced after a restart starts without any fields
+  if (is_restart_ && datacoll.HasField(name)) {
     grid_function = datacoll.GetParField(name);
     state.setFromGridFunction(*grid_function);
   } else {
@@ -179,7 +214,8 @@ void StateManager::storeDual(FiniteElementDual& dual)
   auto&                  datacoll = datacolls_.at(mesh_tag);
   const std::string      name     = dual.name();
   mfem::ParGridFunction* grid_function;
-  if (is_restart_) {
+  // the data collection of a mesh replaced after a restart starts without any fields
+  if (is_restart_ && datacoll.HasField(name)) {
     grid_function = datacoll.GetParField(name);
     std::unique_ptr<mfem::HypreParVector> true_dofs(grid_function->GetTrueDofs());
     dual = *true_dofs;
@@ -211,6 +247,11 @@ FiniteElementDual StateManager::newDual(const mfem::ParFiniteElementSpace& space
 }
 
 void StateManager::save(const double t, const int cycle, const std::string& mesh_tag)
+{
+  stageSave(t, cycle, mesh_tag)();
+}
+
+std::function<void()> StateManager::stageSave(const double t, const int cycle, const std::string& mesh_tag)
 {
   SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
   SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
@@ -220,9 +261,90 @@ void StateManager::save(const double t, const int cycle, const std::string& mesh
   SLIC_INFO_ROOT(
       axom::fmt::format("Saving data collection at time: '{}' and cycle: '{}' to path: '{}'", t, cycle, file_path));
 
+  // the files of this cycle are about to be overwritten
+  loaded_checkpoints_.remove_if(
+      [&](const auto& checkpoint) { return checkpoint.mesh_tag == mesh_tag && checkpoint.cycle == cycle; });
+
   datacoll.SetTime(t);
   datacoll.SetCycle(cycle);
-  datacoll.Save();
+
+  // the quadrature data isn't synced like the fields, so it is copied into the data store now
+  for (auto& [name, qdata] : named_quadrature_data_) {
+    if (qdata.mesh_tag == mesh_tag) {
+      qdata.save();
+    }
+  }
+
+  if (save_options_.num_files == 0) {
+    return [&datacoll]() { datacoll.Save(); };
+  }
+
+  // the same files as MFEMSidreDataCollection::Save(), but written by fewer ranks
+  return [&datacoll, num_files = save_options_.num_files]() {
+    auto [num_procs, rank] = getMPIInfo(datacoll.GetComm());
+
+    const std::string name      = datacoll.GetCollectionName();
+    const std::string file_path = axom::utilities::filesystem::joinPath(
+        datacoll.GetPrefixPath(), axom::fmt::format("{}_{:06}", name, datacoll.GetCycle()));
+    if (rank == 0) {
+      axom::utilities::filesystem::makeDirsForPath(datacoll.GetPrefixPath());
+    }
+    MPI_Barrier(datacoll.GetComm());
+
+    datacoll.UpdateStateToDS();
+
+    axom::sidre::IOManager writer(datacoll.GetComm());
+    writer.write(ds_->getRoot(), std::min(num_files, num_procs), file_path, "sidre_hdf5");
+    if (rank == 0) {
+      writer.writeGroupToRootFile(ds_->getRoot()->getGroup(name + "_global/blueprint_index"), file_path + ".root");
+    }
+  };
+}
+
+void StateManager::setSaveOptions(const SaveOptions& options)
+{
+  SLIC_ERROR_ROOT_IF(options.num_files < 0, "The number of files must be non-negative");
+  SLIC_ERROR_ROOT_IF(options.compression_level < 0 || options.compression_level > 9,
+                     "The compression level must be between 0 and 9");
+  SLIC_ERROR_ROOT_IF(options.chunk_size < 1, "The chunk size must be positive");
+
+#ifdef CONDUIT_RELAY_IO_HDF5_ENABLED
+  conduit::Node hdf5_options;
+  conduit::relay::io::hdf5_options(hdf5_options);
+  if (options.compression_level > 0) {
+    hdf5_options["chunking/enabled"]            = "true";
+    hdf5_options["chunking/threshold"]          = options.chunk_size;
+    hdf5_options["chunking/chunk_size"]         = options.chunk_size;
+    hdf5_options["chunking/compression/method"] = "gzip";
+    hdf5_options["chunking/compression/level"]  = options.compression_level;
+  } else {
+    hdf5_options["chunking/enabled"] = "false";
+  }
+  conduit::relay::io::hdf5_set_options(hdf5_options);
+#else
+  SLIC_WARNING_ROOT_IF(options.compression_level > 0, "Conduit was built without HDF5, the output is not compressed");
+#endif
+
+  save_options_ = options;
+}
+
+void StateManager::blueprintMesh(const double t, const int cycle, const std::string& mesh_tag, conduit::Node& node)
+{
+  SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+  SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
+                     axom::fmt::format("Mesh tag '{}' not found in the data store", mesh_tag));
+  auto& datacoll = datacolls_.at(mesh_tag);
+
+  node.reset();
+  datacoll.GetBPGroup()->createNativeLayout(node);
+
+  // the state in the datastore is only updated when the data collection is saved
+  if (node.has_child("state")) {
+    node.remove("state");
+  }
+  node["state/time"]      = t;
+  node["state/cycle"]     = cycle;
+  node["state/domain_id"] = mesh(mesh_tag).GetMyRank();
 }
 
 mfem::ParMesh& StateManager::setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const std::string& mesh_tag)
@@ -251,7 +373,8 @@ mfem::ParMesh& StateManager::setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const
   // Sidre will destruct the nodal grid function instead of the mesh
   pmesh->SetNodesOwner(false);
 
-  newDataCollection(mesh_tag);
+  // the mesh may be on a subset of the ranks, e.g. those of one of several concurrent physics modules
+  newDataCollection(mesh_tag, {}, pmesh->GetComm());
   auto& datacoll = datacolls_.at(mesh_tag);
   datacoll.SetMesh(pmesh.release());
   datacoll.SetOwnData(true);
@@ -270,6 +393,147 @@ mfem::ParMesh& StateManager::setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const
   return new_pmesh;
 }
 
+mfem::ParMesh& StateManager::setMeshHierarchy(std::vector<std::unique_ptr<mfem::ParMesh>> levels,
+                                              const std::string&                          mesh_tag)
+{
+  SLIC_ERROR_ROOT_IF(levels.empty(), "A mesh hierarchy needs at least one level");
+
+  auto finest = std::move(levels.back());
+  levels.pop_back();
+  coarse_meshes_[mesh_tag] = std::move(levels);
+
+  return setMesh(std::move(finest), mesh_tag);
+}
+
+const std::vector<std::unique_ptr<mfem::ParMesh>>& StateManager::coarseMeshes(const std::string& mesh_tag)
+{
+  static const std::vector<std::unique_ptr<mfem::ParMesh>> no_coarse_meshes;
+  auto iter = coarse_meshes_.find(mesh_tag);
+  return (iter != coarse_meshes_.end()) ? iter->second : no_coarse_meshes;
+}
+
+std::vector<std::string> StateManager::sortedStateNames(const mfem::ParMesh& pmesh)
+{
+  std::vector<std::string> state_names;
+  for (auto& [name, grid_function] : named_states_) {
+    if (grid_function->ParFESpace()->GetParMesh() == &pmesh) {
+      state_names.push_back(name);
+    }
+  }
+  std::sort(state_names.begin(), state_names.end());
+  return state_names;
+}
+
+void StateManager::replaceMesh(const std::string& mesh_tag, std::unique_ptr<mfem::ParMesh> pmesh)
+{
+  auto&  previous_mesh = mesh(mesh_tag);
+  auto&  datacoll      = datacolls_.at(mesh_tag);
+  int    current_cycle = datacoll.GetCycle();
+  double current_time  = datacoll.GetTime();
+
+  for (auto iter = named_states_.begin(); iter != named_states_.end();) {
+    iter = (iter->second->ParFESpace()->GetParMesh() == &previous_mesh) ? named_states_.erase(iter) : std::next(iter);
+  }
+  for (auto iter = named_duals_.begin(); iter != named_duals_.end();) {
+    iter = (iter->second->ParFESpace()->GetParMesh() == &previous_mesh) ? named_duals_.erase(iter) : std::next(iter);
+  }
+
+  // the data collection owns the previous mesh and its grid functions
+  loaded_checkpoints_.remove_if([&](const auto& checkpoint) { return checkpoint.mesh_tag == mesh_tag; });
+  shape_displacements_.erase(mesh_tag);
+  datacolls_.erase(mesh_tag);
+
+  // the replacement is not a refinement of the coarse levels
+  coarse_meshes_.erase(mesh_tag);
+
+  std::string coll_name = mesh_tag + "_datacoll";
+  ds_->getRoot()->destroyGroupAndData(coll_name + "_global");
+  ds_->getRoot()->destroyGroupAndData(coll_name);
+
+  // the shape displacement is constructed again (as zero) by setMesh()
+  setMesh(std::move(pmesh), mesh_tag);
+  datacolls_.at(mesh_tag).SetCycle(current_cycle);
+  datacolls_.at(mesh_tag).SetTime(current_time);
+  loadTransferredState(shapeDisplacement(mesh_tag));
+}
+
+mesh::Redistribution StateManager::rebalance(const std::string& mesh_tag, const mfem::Vector& element_costs)
+{
+  SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+  auto& previous_mesh = mesh(mesh_tag);
+
+  auto [rebalanced_mesh, redistribution] = mesh::rebalance(previous_mesh, element_costs);
+
+  // the states are moved in the same order on every rank, as each move is collective
+  for (auto& name : sortedStateNames(previous_mesh)) {
+    transferred_states_[name] = mesh::redistributeField(*named_states_.at(name), *rebalanced_mesh, redistribution);
+  }
+
+  replaceMesh(mesh_tag, std::move(rebalanced_mesh));
+
+  return std::move(redistribution);
+}
+
+mesh::Adaptation StateManager::refine(const std::string& mesh_tag, const mfem::Vector& element_errors, double threshold,
+                                      int nc_limit)
+{
+  SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+  auto& previous_mesh = mesh(mesh_tag);
+  auto  state_names   = sortedStateNames(previous_mesh);
+
+  auto adaptation = mesh::refine(previous_mesh, element_errors, threshold, stateFields(state_names), nc_limit);
+  transferStates(state_names, adaptation);
+  replaceMesh(mesh_tag, std::move(adaptation.mesh));
+
+  return adaptation;
+}
+
+mesh::Adaptation StateManager::derefine(const std::string& mesh_tag, const mfem::Vector& element_errors,
+                                        double threshold, int nc_limit)
+{
+  SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+  auto& previous_mesh = mesh(mesh_tag);
+  auto  state_names   = sortedStateNames(previous_mesh);
+
+  auto adaptation = mesh::derefine(previous_mesh, element_errors, threshold, stateFields(state_names), nc_limit);
+  transferStates(state_names, adaptation);
+  replaceMesh(mesh_tag, std::move(adaptation.mesh));
+
+  return adaptation;
+}
+
+std::vector<const mfem::ParGridFunction*> StateManager::stateFields(const std::vector<std::string>& state_names)
+{
+  std::vector<const mfem::ParGridFunction*> fields;
+  for (auto& name : state_names) {
+    fields.push_back(named_states_.at(name));
+  }
+  return fields;
+}
+
+void StateManager::transferStates(const std::vector<std::string>& state_names, mesh::Adaptation& adaptation)
+{
+  for (std::size_t i = 0; i < state_names.size(); i++) {
+    transferred_states_[state_names[i]] = std::move(adaptation.fields[i]);
+  }
+  adaptation.fields.clear();
+}
+
+bool StateManager::loadTransferredState(FiniteElementState& state)
+{
+  auto transferred = transferred_states_.find(state.name());
+  if (transferred == transferred_states_.end()) {
+    return false;
+  }
+
+  state.setFromGridFunction(*transferred->second);
+  if (named_states_.find(state.name()) != named_states_.end()) {
+    updateState(state);
+  }
+  transferred_states_.erase(transferred);
+  return true;
+}
+
 void StateManager::constructShapeFields(const std::string& mesh_tag)
 {
   // Construct the shape displacement field associated with this mesh
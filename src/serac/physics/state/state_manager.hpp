@@ -12,16 +12,29 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <list>
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "mfem.hpp"
 #include "axom/sidre/core/MFEMSidreDataCollection.hpp"
 
+#include "serac/infrastructure/initialize.hpp"
 #include "serac/infrastructure/logger.hpp"
+#include "serac/mesh/mesh_utils_base.hpp"
 #include "serac/physics/state/finite_element_state.hpp"
 #include "serac/physics/state/finite_element_dual.hpp"
+#include "serac/numerics/functional/quadrature.hpp"
 #include "serac/numerics/functional/quadrature_data.hpp"
+#include "serac/numerics/functional/shared_setup.hpp"
 
 namespace serac {
 
@@ -34,6 +47,20 @@ constexpr H1<SHAPE_ORDER, 2> SHAPE_DIM_2;
 /// Function space for shape displacement on dimension 2 meshes
 constexpr H1<SHAPE_ORDER, 3> SHAPE_DIM_3;
 
+/**
+ * @brief How StateManager::save() writes the Sidre data collections, which are always written with the HDF5 protocol
+ */
+struct SaveOptions {
+  /// The number of files written by each save, each aggregating the data of a group of ranks, or 0 for one per rank
+  int num_files = 0;
+
+  /// The gzip compression level (1 to 9) of the chunked HDF5 datasets, or 0 for uncompressed contiguous datasets
+  int compression_level = 0;
+
+  /// The size in bytes of the chunks of compressed datasets, and the smallest dataset that is chunked and compressed
+  int chunk_size = 1 << 20;
+};
+
 /**
  * @brief Manages the lifetimes of FEState objects such that restarts are abstracted
  * from physics modules
@@ -54,12 +81,14 @@ public:
    * @param space The function space (e.g. H1<1>) to build the finite element state on
    * @param state_name The name of the new finite element state field
    * @param mesh_tag The tag for the stored mesh used to construct the finite element state
+   * @param ordering how the components of a vector-valued state are laid out, see generateParFiniteElementSpace()
    *
    * @see FiniteElementState::FiniteElementState
    * @note If this is a restart then the options (except for the name) will be ignored
    */
   template <typename FunctionSpace>
-  static FiniteElementState newState(FunctionSpace space, const std::string& state_name, const std::string& mesh_tag)
+  static FiniteElementState newState(FunctionSpace space, const std::string& state_name, const std::string& mesh_tag,
+                                     mfem::Ordering::Type ordering = mfem::Ordering::byNODES)
   {
     SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
     SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
@@ -67,7 +96,7 @@ public:
     SLIC_ERROR_ROOT_IF(named_states_.find(state_name) != named_states_.end(),
                        axom::fmt::format("StateManager already contains a state named '{}'", state_name));
 
-    auto state = FiniteElementState(mesh(mesh_tag), space, state_name);
+    auto state = FiniteElementState(mesh(mesh_tag), space, state_name, ordering);
 
     storeState(state);
     return state;
@@ -96,12 +125,14 @@ public:
    * @param space The function space (e.g. H1<1>) to build the finite element dual on
    * @param dual_name The name of the new finite element dual field
    * @param mesh_tag The tag for the stored mesh used to construct the finite element state
+   * @param ordering how the components of a vector-valued dual are laid out, see generateParFiniteElementSpace()
    *
    * @see FiniteElementDual::FiniteElementDual
    * @note If this is a restart then the options (except for the name) will be ignored
    */
   template <typename FunctionSpace>
-  static FiniteElementDual newDual(FunctionSpace space, const std::string& dual_name, const std::string& mesh_tag)
+  static FiniteElementDual newDual(FunctionSpace space, const std::string& dual_name, const std::string& mesh_tag,
+                                   mfem::Ordering::Type ordering = mfem::Ordering::byNODES)
   {
     SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
     SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
@@ -109,7 +140,7 @@ public:
     SLIC_ERROR_ROOT_IF(named_states_.find(dual_name) != named_duals_.end(),
                        axom::fmt::format("StateManager already contains a dual named '{}'", dual_name));
 
-    auto dual = FiniteElementDual(mesh(mesh_tag), space, dual_name);
+    auto dual = FiniteElementDual(mesh(mesh_tag), space, dual_name, ordering);
 
     storeDual(dual);
     return dual;
@@ -162,6 +193,48 @@ public:
     dual.space().GetRestrictionMatrix()->MultTranspose(dual, *named_duals_[dual.name()]);
   }
 
+  /**
+   * @brief Registers a quadrature data buffer, e.g. the internal variables of a material, to be written by save()
+   * alongside the fields of a mesh
+   *
+   * Unlike the stored states, its values don't need to be updated before a save: every save() copies them into the
+   * data store. On a restart, the buffer is instead set to the values saved with the loaded cycle (if it was saved
+   * then), so path dependent materials resume from their state at that cycle.
+   *
+   * @tparam T The type stored at each quadrature point, which must be trivially copyable
+   * @param[in] data The buffer, of the same size as the one that was saved, which StateManager doesn't keep alive
+   * @param[in] name A name that uniquely identifies the buffer. A buffer registered again with the same name replaces
+   * the previous one, e.g. when a physics module is constructed again after its mesh was rebalanced.
+   * @param[in] mesh_tag The mesh whose data collection the buffer is written with
+   */
+  template <typename T>
+  static void storeQuadratureData(const std::shared_ptr<QuadratureData<T>>& data, const std::string& name,
+                                  const std::string& mesh_tag)
+  {
+    if constexpr (!std::is_same_v<T, Nothing> && !std::is_same_v<T, Empty>) {
+      static_assert(std::is_trivially_copyable_v<T>, "Quadrature data must be trivially copyable to be saved");
+      SLIC_ERROR_ROOT_IF(!ds_, "Serac's data store was not initialized - call StateManager::initialize first");
+      SLIC_ERROR_ROOT_IF(datacolls_.find(mesh_tag) == datacolls_.end(),
+                         axom::fmt::format("Mesh tag '{}' not found in the data store", mesh_tag));
+
+      // only the first buffer with this name is restarted, since the ones that replace it are on changed meshes
+      const std::string group_name = quadratureDataGroupName(mesh_tag, name);
+      const bool        first      = named_quadrature_data_.find(name) == named_quadrature_data_.end();
+      if (is_restart_ && first && ds_->getRoot()->hasGroup(group_name)) {
+        copyQuadratureData(*data, *ds_->getRoot()->getGroup(group_name), false);
+      }
+
+      auto save = [weak_data = std::weak_ptr<QuadratureData<T>>(data), group_name]() {
+        if (auto current_data = weak_data.lock()) {
+          auto root  = ds_->getRoot();
+          auto group = root->hasGroup(group_name) ? root->getGroup(group_name) : root->createGroup(group_name);
+          copyQuadratureData(*current_data, *group, true);
+        }
+      };
+      named_quadrature_data_[name] = {mesh_tag, save};
+    }
+  }
+
   /**
    * @brief Updates the Conduit Blueprint state in the datastore and saves to a file
    * @param[in] t The current sim time
@@ -170,17 +243,57 @@ public:
    */
   static void save(const double t, const int cycle, const std::string& mesh_tag);
 
+  /**
+   * @brief Updates the Conduit Blueprint state in the datastore, and returns the file write to perform later
+   *
+   * This splits save() so that the write can run on a background thread, see output::AsyncWriter. The datastore must
+   * not be modified until the returned write has finished.
+   *
+   * @param[in] t The current sim time
+   * @param[in] cycle The current iteration number of the simulation
+   * @param[in] mesh_tag A string that uniquely identifies the mesh (and accompanying fields) to save
+   * @return The write of the data collection to a file
+   */
+  static std::function<void()> stageSave(const double t, const int cycle, const std::string& mesh_tag);
+
+  /**
+   * @brief Set the number of files and the compression of the data collections written by save()
+   *
+   * The files are read back by load() whatever options they were written with, and the options are kept until they
+   * are set again.
+   *
+   * @param[in] options The save options
+   *
+   * @note The HDF5 compression options apply to every HDF5 file written through Conduit by this process
+   */
+  static void setSaveOptions(const SaveOptions& options);
+
+  /**
+   * @brief Describes the mesh and fields of a data collection as a Conduit Blueprint mesh, e.g. for in-situ
+   * visualization
+   *
+   * The views in @a node refer to the Sidre data of the data collection without copying it, so the fields hold the
+   * values of the last updateState() and updateDual() calls.
+   *
+   * @param[in] t The current sim time
+   * @param[in] cycle The current iteration number of the simulation
+   * @param[in] mesh_tag A string that uniquely identifies the mesh (and accompanying fields) to describe
+   * @param[out] node The Blueprint mesh of this rank's domain
+   */
+  static void blueprintMesh(const double t, const int cycle, const std::string& mesh_tag, conduit::Node& node);
+
   /**
    * @brief Loads an existing DataCollection
    * @param[in] cycle_to_load What cycle to load the DataCollection from
    * @param[in] mesh_tag The mesh_tag associated with the DataCollection when it was saved
+   * @param[in] comm The communicator of the mesh, e.g. that of its group of PhysicsGroups
    * @return The time from specified restart cycle. Otherwise zero.
    */
-  static double load(const int cycle_to_load, const std::string& mesh_tag)
+  static double load(const int cycle_to_load, const std::string& mesh_tag, MPI_Comm comm = MPI_COMM_WORLD)
   {
     // FIXME: Assumes that if one DataCollection is going to be reloaded all DataCollections will be
     is_restart_ = true;
-    return newDataCollection(mesh_tag, cycle_to_load);
+    return newDataCollection(mesh_tag, cycle_to_load, comm);
   }
 
   /**
@@ -190,17 +303,26 @@ public:
    * that it would be after the program started and before any
    * StateManager methods have been called. If the client wants to use
    * StateManager after a call to reset(), the initialize() method
-   * must be called.
+   * must be called. The element restrictions, geometric factors and
+   * lookup tables shared between Functionals (see shared_setup) are
+   * also forgotten.
    */
   static void reset()
   {
     named_states_.clear();
     named_duals_.clear();
+    named_quadrature_data_.clear();
     shape_displacements_.clear();
     datacolls_.clear();
+    loaded_checkpoints_.clear();
+    transferred_states_.clear();
+    coarse_meshes_.clear();
     output_dir_.clear();
     is_restart_ = false;
     ds_         = nullptr;
+
+    // the meshes that the shared Functional setup was built on have been released
+    shared_setup::clear();
   };
 
   /**
@@ -211,6 +333,251 @@ public:
    */
   static mfem::ParMesh& setMesh(std::unique_ptr<mfem::ParMesh> pmesh, const std::string& mesh_tag);
 
+  /**
+   * @brief Gives ownership of a hierarchy of uniformly refined meshes to StateManager
+   *
+   * The finest level is registered as with setMesh(), and the coarser ones are kept for the geometric multigrid
+   * preconditioner of the physics modules on that mesh.
+   *
+   * @param[in] levels The meshes of every level, coarsest first, e.g. from mesh::refineAndDistributeHierarchy()
+   * @param[in] mesh_tag A string that uniquely identifies the mesh
+   * @return A reference to the stored finest mesh
+   */
+  static mfem::ParMesh& setMeshHierarchy(std::vector<std::unique_ptr<mfem::ParMesh>> levels,
+                                         const std::string&                          mesh_tag);
+
+  /**
+   * @brief Returns the levels coarser than a stored mesh given to setMeshHierarchy()
+   * @param[in] mesh_tag A string that uniquely identifies the mesh
+   * @return The coarse meshes, coarsest first, or none if the mesh is not part of a hierarchy
+   */
+  static const std::vector<std::unique_ptr<mfem::ParMesh>>& coarseMeshes(const std::string& mesh_tag);
+
+  /**
+   * @brief Repartitions a stored mesh so that the total cost of the elements of each rank is about the same
+   *
+   * The stored states of the mesh are moved onto the rebalanced mesh, which replaces the previous one under the
+   * same tag, and its shape displacement is restored. The physics modules built on the previous mesh refer to
+   * objects that no longer exist, so they must only be destroyed afterwards, and constructed again on
+   * mesh(mesh_tag). Their states can then be set to the moved values with BasePhysics::loadTransferredStates(),
+   * and their quadrature data with redistributeQuadratureData(). Duals are not moved.
+   *
+   * @param[in] mesh_tag A string that uniquely identifies the mesh
+   * @param[in] element_costs The cost of each local element, e.g. from SolidMechanics::elementCosts()
+   * @return How the elements were moved between the ranks
+   *
+   * @note This is a collective function. The disk checkpoints written before the rebalance can no longer be loaded.
+   */
+  static mesh::Redistribution rebalance(const std::string& mesh_tag, const mfem::Vector& element_costs);
+
+  /**
+   * @brief Refines the elements of a stored mesh whose error exceeds a threshold
+   *
+   * Like rebalance(), the stored states are interpolated onto the refined mesh, which replaces the previous one under
+   * the same tag. The physics modules must then be constructed again, which rebuilds their restriction operators and
+   * geometric factors, and their states set with BasePhysics::loadTransferredStates(). Their quadrature data can be
+   * transferred with transferQuadratureData().
+   *
+   * @param[in] mesh_tag A string that uniquely identifies the mesh
+   * @param[in] element_errors The error indicator of each local element
+   * @param[in] threshold The elements with a larger error are refined
+   * @param[in] nc_limit The largest number of refinement levels between neighbouring elements, or 0 for no limit
+   * @return Where each element of the refined mesh came from. Its mesh and fields have been moved to the StateManager.
+   *
+   * @see mesh::refine() for the meshes that can be refined
+   * @note This is a collective function. The disk checkpoints written before the refinement can no longer be loaded.
+   */
+  static mesh::Adaptation refine(const std::string& mesh_tag, const mfem::Vector& element_errors, double threshold,
+                                 int nc_limit = 0);
+
+  /**
+   * @brief Coarsens the groups of refined elements of a stored nonconforming mesh whose error is below a threshold
+   *
+   * The stored states are interpolated onto the coarsened mesh as in refine(). Quadrature data cannot be transferred.
+   *
+   * @param[in] mesh_tag A string that uniquely identifies the mesh
+   * @param[in] element_errors The error indicator of each local element
+   * @param[in] threshold The largest error of a coarsened group of elements
+   * @param[in] nc_limit The largest number of refinement levels between neighbouring elements, or 0 for no limit
+   * @return The (empty) description of the coarsening, for symmetry with refine()
+   *
+   * @note This is a collective function. The disk checkpoints written before the coarsening can no longer be loaded.
+   */
+  static mesh::Adaptation derefine(const std::string& mesh_tag, const mfem::Vector& element_errors, double threshold,
+                                   int nc_limit = 0);
+
+  /**
+   * @brief Sets a state on a replaced mesh to the values that rebalance(), refine() or derefine() transferred for the
+   * state of the same name
+   *
+   * @param[inout] state The state on the new mesh
+   * @return Whether a state with this name was transferred. Each transferred state can only be loaded once.
+   */
+  static bool loadTransferredState(FiniteElementState& state);
+
+  /**
+   * @brief Transfers quadrature point values onto a mesh refined by refine()
+   *
+   * Each quadrature point of a refined element takes the value of the closest quadrature point of its parent, so
+   * the values are copied rather than interpolated and stay admissible, e.g. for internal variables of a material.
+   *
+   * @tparam T The type stored at each quadrature point
+   * @param[in] data The values on the previous mesh
+   * @param[out] refined The buffer to overwrite on the refined mesh, e.g. from
+   * BasePhysics::createQuadratureDataBuffer() of a physics module constructed again
+   * @param[in] adaptation The adaptation returned by refine()
+   * @param[in] refined_mesh The refined mesh
+   */
+  template <typename T>
+  static void transferQuadratureData(QuadratureData<T>& data, QuadratureData<T>& refined,
+                                     const mesh::Adaptation& adaptation, const mfem::Mesh& refined_mesh)
+  {
+    if constexpr (!std::is_same_v<T, Nothing> && !std::is_same_v<T, Empty>) {
+      SLIC_ERROR_ROOT_IF(static_cast<int>(adaptation.parents.size()) != refined_mesh.GetNE(),
+                         "Quadrature data can only be transferred onto the mesh returned by StateManager::refine()");
+
+      constexpr std::array geometries = {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
+                                         mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM};
+
+      for (auto geom : geometries) {
+        auto shape = [](auto& array) {
+          if constexpr (is_structure_of_arrays_v<T>) {
+            return std::get<0>(array).shape();
+          } else {
+            return array.shape();
+          }
+        };
+        int qpts = static_cast<int>(shape(refined.data[geom])[1]);
+        if (qpts == 0) continue;
+
+        mfem::IntegrationRule points = quadrature_points(geom, qpts);
+        SLIC_ERROR_ROOT_IF(points.GetNPoints() != qpts,
+                           axom::fmt::format("Unsupported number of quadrature points: {}", qpts));
+
+        mfem::IsoparametricTransformation embedding;
+        embedding.SetIdentityTransformation(geom);
+
+        auto     parent_view = data[geom];
+        auto     view        = refined[geom];
+        uint32_t child       = 0;
+        for (int e = 0; e < refined_mesh.GetNE(); e++) {
+          if (refined_mesh.GetElementGeometry(e) != geom) continue;
+
+          auto parent = static_cast<uint32_t>(adaptation.parents[static_cast<std::size_t>(e)]);
+          embedding.SetPointMat(adaptation.embeddings[static_cast<std::size_t>(e)]);
+          for (int q = 0; q < qpts; q++) {
+            mfem::Vector xi, xi_parent(mfem::Geometry::Dimension[geom]);
+            embedding.Transform(points.IntPoint(q), xi);
+
+            int    closest  = 0;
+            double distance = std::numeric_limits<double>::max();
+            for (int p = 0; p < qpts; p++) {
+              points.IntPoint(p).Get(xi_parent.GetData(), xi_parent.Size());
+              if (xi_parent.DistanceTo(xi) < distance) {
+                distance = xi_parent.DistanceTo(xi);
+                closest  = p;
+              }
+            }
+            view.store(child, uint32_t(q), parent_view.load(parent, uint32_t(closest)));
+          }
+          child++;
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Moves quadrature point values onto a mesh rebalanced by rebalance()
+   *
+   * @tparam T The trivially copyable type stored at each quadrature point
+   * @param[in] data The values on the previous mesh
+   * @param[out] rebalanced The buffer to overwrite on the rebalanced mesh, e.g. from
+   * BasePhysics::createQuadratureDataBuffer() of a physics module constructed again
+   * @param[in] redistribution The redistribution returned by rebalance()
+   * @param[in] comm The MPI communicator of the mesh
+   *
+   * @note This is a collective function.
+   */
+  template <typename T>
+  static void redistributeQuadratureData(QuadratureData<T>& data, QuadratureData<T>& rebalanced,
+                                         const mesh::Redistribution& redistribution, MPI_Comm comm)
+  {
+    if constexpr (!std::is_same_v<T, Nothing> && !std::is_same_v<T, Empty>) {
+      static_assert(std::is_trivially_copyable_v<T>, "Quadrature data must be trivially copyable to be moved");
+
+      auto [num_procs, rank]        = getMPIInfo(comm);
+      const mfem::Mesh& serial_mesh = *redistribution.serial_mesh;
+
+      constexpr std::array geometries = {mfem::Geometry::TRIANGLE, mfem::Geometry::SQUARE,
+                                         mfem::Geometry::TETRAHEDRON, mfem::Geometry::CUBE, mfem::Geometry::PRISM};
+
+      for (auto geom : geometries) {
+        // the elements of this geometry, in the global order of the redistribution
+        std::vector<int> previous_ranks, ranks;
+        for (int e = 0; e < serial_mesh.GetNE(); e++) {
+          if (serial_mesh.GetElementGeometry(e) == geom) {
+            previous_ranks.push_back(redistribution.previous_ranks[static_cast<std::size_t>(e)]);
+            ranks.push_back(redistribution.ranks[static_cast<std::size_t>(e)]);
+          }
+        }
+        if (previous_ranks.empty()) continue;
+
+        auto shape = [](auto& array) {
+          if constexpr (is_structure_of_arrays_v<T>) {
+            return std::get<0>(array).shape();
+          } else {
+            return array.shape();
+          }
+        };
+        int local_qpts = static_cast<int>(std::max(shape(data.data[geom])[1], shape(rebalanced.data[geom])[1]));
+        int qpts       = 0;
+        MPI_Allreduce(&local_qpts, &qpts, 1, MPI_INT, MPI_MAX, comm);
+
+        // every rank sends the values of its elements of this geometry, in their local order
+        const std::size_t        bytes_per_element = std::size_t(qpts) * sizeof(T);
+        std::vector<std::size_t> num_elements(static_cast<std::size_t>(num_procs), 0);
+        for (int p : previous_ranks) {
+          num_elements[static_cast<std::size_t>(p)]++;
+        }
+        SLIC_ERROR_IF(previous_ranks.size() * bytes_per_element > std::size_t(std::numeric_limits<int>::max()),
+                      "Quadrature data is too large to redistribute");
+
+        std::vector<int> counts(static_cast<std::size_t>(num_procs), 0);
+        std::vector<int> offsets(static_cast<std::size_t>(num_procs), 0);
+        for (std::size_t p = 0; p < counts.size(); p++) {
+          counts[p] = static_cast<int>(num_elements[p] * bytes_per_element);
+          if (p > 0) offsets[p] = offsets[p - 1] + counts[p - 1];
+        }
+
+        auto           view      = data[geom];
+        const uint32_t num_local = uint32_t(num_elements[static_cast<std::size_t>(rank)]);
+        std::vector<T> local_values(num_local * uint32_t(qpts));
+        for (uint32_t e = 0; e < num_local; e++) {
+          for (uint32_t q = 0; q < uint32_t(qpts); q++) {
+            local_values[e * uint32_t(qpts) + q] = view.load(e, q);
+          }
+        }
+
+        std::vector<char> values(previous_ranks.size() * bytes_per_element);
+        MPI_Allgatherv(local_values.data(), counts[static_cast<std::size_t>(rank)], MPI_CHAR, values.data(),
+                       counts.data(), offsets.data(), MPI_CHAR, comm);
+
+        // the rebalanced mesh numbers the elements of each rank in their global order
+        auto     rebalanced_view = rebalanced[geom];
+        uint32_t new_e           = 0;
+        for (std::size_t i = 0; i < ranks.size(); i++) {
+          if (ranks[i] != rank) continue;
+          for (uint32_t q = 0; q < uint32_t(qpts); q++) {
+            T value;
+            std::memcpy(&value, values.data() + i * bytes_per_element + q * sizeof(T), sizeof(T));
+            rebalanced_view.store(new_e, q, value);
+          }
+          new_e++;
+        }
+      }
+    }
+  }
+
   /**
    * @brief Returns a non-owning reference to mesh held by StateManager
    * @param[in] mesh_tag A string that uniquely identifies the mesh
@@ -232,12 +599,40 @@ public:
   /**
    * @brief loads the finite element states from a previously checkpointed cycle
    *
+   * The files of the most recently loaded cycles are kept in memory, since an adjoint timestep reads the cycle that
+   * the previous adjoint timestep also read.
+   *
    * @param cycle_to_load
    * @param states_to_load
    */
   static void loadCheckpointedStates(int                                                     cycle_to_load,
                                      std::vector<std::reference_wrapper<FiniteElementState>> states_to_load);
 
+  /**
+   * @brief loads the values of a quadrature data buffer registered with storeQuadratureData() from a previously
+   * checkpointed cycle, e.g. the material state of that cycle for an adjoint timestep
+   *
+   * @tparam T The type stored at each quadrature point
+   * @param[in] cycle_to_load The cycle to load
+   * @param[in] mesh_tag The mesh whose data collection the buffer was written with
+   * @param[in] name The name the buffer was registered with
+   * @param[out] data The buffer to overwrite, of the same size as the saved one
+   */
+  template <typename T>
+  static void loadCheckpointedQuadratureData(int cycle_to_load, const std::string& mesh_tag, const std::string& name,
+                                             QuadratureData<T>& data)
+  {
+    if constexpr (!std::is_same_v<T, Nothing> && !std::is_same_v<T, Empty>) {
+      auto& datacoll = loadedCheckpoint(mesh_tag, cycle_to_load, mesh(mesh_tag).GetComm());
+      auto  root     = datacoll.GetBPGroup()->getDataStore()->getRoot();
+
+      const std::string group_name = quadratureDataGroupName(mesh_tag, name);
+      SLIC_ERROR_ROOT_IF(!root->hasGroup(group_name),
+                         axom::fmt::format("No quadrature data named '{}' was saved at cycle {}", name, cycle_to_load));
+      copyQuadratureData(data, *root->getGroup(group_name), false);
+    }
+  }
+
   /**
    * @brief Get the shape displacement sensitivity finite element dual
    *
@@ -287,9 +682,74 @@ private:
    * @brief Creates a new datacollection based on a registered mesh
    * @param[in] name The name of the new datacollection
    * @param[in] cycle_to_load What cycle to load the DataCollection from, if applicable
+   * @param[in] comm The communicator of the mesh
    * @return The time from specified restart cycle. Otherwise zero.
    */
-  static double newDataCollection(const std::string& name, const std::optional<int> cycle_to_load = {});
+  static double newDataCollection(const std::string& name, const std::optional<int> cycle_to_load = {},
+                                  MPI_Comm comm = MPI_COMM_WORLD);
+
+  /**
+   * @brief The data collection of a previously checkpointed cycle, loaded from its files unless it is one of the most
+   * recently loaded ones
+   *
+   * @param[in] mesh_tag The mesh of the data collection
+   * @param[in] cycle_to_load The cycle to load
+   * @param[in] comm The communicator of the mesh
+   */
+  static axom::sidre::MFEMSidreDataCollection& loadedCheckpoint(const std::string& mesh_tag, int cycle_to_load,
+                                                                MPI_Comm comm);
+
+  /// @brief The path of the Sidre group that a quadrature data buffer registered with storeQuadratureData() is in
+  static std::string quadratureDataGroupName(const std::string& mesh_tag, const std::string& name)
+  {
+    return mesh_tag + "_datacoll_quadrature_data/" + name;
+  }
+
+  /**
+   * @brief Copies the values of a quadrature data buffer to (or from) the views of a Sidre group, with one view of
+   * raw bytes for each array of each element geometry
+   *
+   * @param[inout] data The buffer
+   * @param[inout] group The Sidre group
+   * @param[in] to_group Whether to copy the buffer to the group, rather than the group to the buffer
+   */
+  template <typename T>
+  static void copyQuadratureData(QuadratureData<T>& data, axom::sidre::Group& group, bool to_group)
+  {
+    for (std::size_t geom = 0; geom < data.data.size(); geom++) {
+      int  field = 0;
+      auto copy  = [&](auto& array) {
+        const std::string view_name = axom::fmt::format("{}_{}", geom, field++);
+        const std::size_t bytes     = std::size_t(array.size()) * sizeof(*array.data());
+        if (bytes == 0) {
+          return;
+        }
+
+        if (to_group) {
+          if (!group.hasView(view_name)) {
+            group.createViewAndAllocate(view_name, axom::sidre::UINT8_ID, axom::sidre::IndexType(bytes));
+          }
+          auto view = group.getView(view_name);
+          if (std::size_t(view->getNumElements()) != bytes) {
+            view->reallocate(axom::sidre::IndexType(bytes));
+          }
+          std::memcpy(view->getVoidPtr(), array.data(), bytes);
+        } else {
+          auto view = group.hasView(view_name) ? group.getView(view_name) : nullptr;
+          SLIC_ERROR_ROOT_IF(!view || std::size_t(view->getNumElements()) != bytes,
+                             axom::fmt::format("The saved quadrature data in '{}' doesn't match the size of the buffer",
+                                               group.getPathName()));
+          std::memcpy(array.data(), view->getVoidPtr(), bytes);
+        }
+      };
+
+      if constexpr (is_structure_of_arrays_v<T>) {
+        std::apply([&](auto&... arrays) { (copy(arrays), ...); }, data.data[geom]);
+      } else {
+        copy(data.data[geom]);
+      }
+    }
+  }
 
   /**
    * @brief Construct the shape displacement field for the requested mesh
@@ -298,12 +758,56 @@ private:
    */
   static void constructShapeFields(const std::string& mesh_tag);
 
+  /// @brief The names of the stored states on a mesh, in the same order on every rank
+  static std::vector<std::string> sortedStateNames(const mfem::ParMesh& pmesh);
+
+  /// @brief The grid functions of the stored states with the given names
+  static std::vector<const mfem::ParGridFunction*> stateFields(const std::vector<std::string>& state_names);
+
+  /// @brief Keeps the fields interpolated by an adaptation until they are loaded with loadTransferredState()
+  static void transferStates(const std::vector<std::string>& state_names, mesh::Adaptation& adaptation);
+
+  /**
+   * @brief Replaces a stored mesh, discarding its stored states, duals and loaded checkpoints
+   *
+   * The cycle and time of the data collection are kept, and the shape displacement is loaded from the transferred
+   * states.
+   *
+   * @param[in] mesh_tag A string that uniquely identifies the mesh
+   * @param[in] pmesh The new mesh
+   */
+  static void replaceMesh(const std::string& mesh_tag, std::unique_ptr<mfem::ParMesh> pmesh);
+
   /**
    * @brief The datacollection instances
    * The object is constructed when the user calls StateManager::initialize.
    */
   static std::unordered_map<std::string, axom::sidre::MFEMSidreDataCollection> datacolls_;
 
+  /// @brief A data collection read back from the files saved at a previous cycle
+  struct LoadedCheckpoint {
+    /// The mesh tag of the data collection
+    std::string mesh_tag;
+
+    /// The cycle the files were saved at
+    int cycle;
+
+    /// The loaded data collection
+    std::unique_ptr<axom::sidre::MFEMSidreDataCollection> datacoll;
+  };
+
+  /// @brief The data collections loaded by loadCheckpointedStates(), most recently used first
+  static std::list<LoadedCheckpoint> loaded_checkpoints_;
+
+  /// @brief The number of loaded data collections kept by loadCheckpointedStates()
+  static constexpr std::size_t max_loaded_checkpoints_ = 2;
+
+  /// @brief The states transferred onto a replaced mesh, until they are loaded with loadTransferredState()
+  static std::unordered_map<std::string, std::unique_ptr<mfem::ParGridFunction>> transferred_states_;
+
+  /// @brief The levels coarser than each stored mesh given to setMeshHierarchy(), coarsest first
+  static std::unordered_map<std::string, std::vector<std::unique_ptr<mfem::ParMesh>>> coarse_meshes_;
+
   /// @brief A map of the shape displacement fields for each stored mesh ID
   static std::unordered_map<std::string, std::unique_ptr<FiniteElementState>> shape_displacements_;
 
@@ -316,11 +820,25 @@ private:
   static axom::sidre::DataStore* ds_;
   /// @brief Output directory to which all datacollections are saved
   static std::string output_dir_;
+  /// @brief How the data collections are written by save()
+  static SaveOptions save_options_;
 
   /// @brief A collection of FiniteElementState names and their corresponding Sidre-owned grid function pointers
   static std::unordered_map<std::string, mfem::ParGridFunction*> named_states_;
   /// @brief A collection of FiniteElementDual names and their corresponding Sidre-owned grid function pointers
   static std::unordered_map<std::string, mfem::ParGridFunction*> named_duals_;
+
+  /// @brief A quadrature data buffer registered with storeQuadratureData()
+  struct StoredQuadratureData {
+    /// The mesh whose data collection the buffer is written with
+    std::string mesh_tag;
+
+    /// Copies the values of the buffer into the data store
+    std::function<void()> save;
+  };
+
+  /// @brief The quadrature data buffers registered with storeQuadratureData(), by name
+  static std::unordered_map<std::string, StoredQuadratureData> named_quadrature_data_;
 };
 
 }  // namespace serac
@@ -21,7 +21,9 @@
 
 namespace serac {
 
-class ContactTest : public testing::TestWithParam<std::tuple<ContactEnforcement, ContactType, std::string>> {};
+// the last parameter turns on the stiffness-scaled penalty, augmented Lagrangian updates, active set prediction and
+// the proximity prefilter
+class ContactTest : public testing::TestWithParam<std::tuple<ContactEnforcement, ContactType, std::string, bool>> {};
 
 TEST_P(ContactTest, beam)
 {
@@ -64,6 +66,15 @@ TEST_P(ContactTest, beam)
                                  .enforcement = std::get<0>(GetParam()),
                                  .type        = std::get<1>(GetParam()),
                                  .penalty     = 1.0e2};
+  if (std::get<3>(GetParam())) {
+    // the penalty is relative to the stiffness of the beam, and a small one is enough with the augmented Lagrangian
+    contact_options.penalty              = 10.0;
+    contact_options.penalty_scaling      = PenaltyScaling::Stiffness;
+    contact_options.augmented_lagrangian = true;
+    contact_options.predict_active_set   = true;
+    contact_options.gap_tolerance        = 1.0e-6;
+    contact_options.proximity_window     = 0.5;
+  }
 
   SolidMechanicsContact<p, dim> solid_solver(nonlinear_options, linear_options,
                                              solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
@@ -113,12 +124,15 @@ TEST_P(ContactTest, beam)
 // NOTE: if Penalty is first and Lagrange Multiplier is second, SuperLU gives a zero diagonal error
 INSTANTIATE_TEST_SUITE_P(
     tribol, ContactTest,
-    testing::Values(std::make_tuple(ContactEnforcement::Penalty, ContactType::TiedNormal, "penalty_tiednormal"),
-                    std::make_tuple(ContactEnforcement::Penalty, ContactType::Frictionless, "penalty_frictionless"),
-                    std::make_tuple(ContactEnforcement::LagrangeMultiplier, ContactType::TiedNormal,
-                                    "lagrange_multiplier_tiednormal"),
-                    std::make_tuple(ContactEnforcement::LagrangeMultiplier, ContactType::Frictionless,
-                                    "lagrange_multiplier_frictionless")));
+    testing::Values(
+        std::make_tuple(ContactEnforcement::Penalty, ContactType::TiedNormal, "penalty_tiednormal", false),
+        std::make_tuple(ContactEnforcement::Penalty, ContactType::Frictionless, "penalty_frictionless", false),
+        std::make_tuple(ContactEnforcement::LagrangeMultiplier, ContactType::TiedNormal,
+                        "lagrange_multiplier_tiednormal", false),
+        std::make_tuple(ContactEnforcement::LagrangeMultiplier, ContactType::Frictionless,
+                        "lagrange_multiplier_frictionless", false),
+        std::make_tuple(ContactEnforcement::Penalty, ContactType::Frictionless, "augmented_lagrangian_frictionless",
+                        true)));
 
 }  // namespace serac
 
@@ -9,6 +9,7 @@
 #include <functional>
 #include <set>
 #include <string>
+#include <tuple>
 
 #include "axom/slic/core/SimpleLogger.hpp"
 #include <gtest/gtest.h>
@@ -21,7 +22,7 @@
 
 namespace serac {
 
-class ContactTest : public testing::TestWithParam<std::pair<ContactEnforcement, std::string>> {};
+class ContactTest : public testing::TestWithParam<std::tuple<ContactEnforcement, LinearSolver, std::string>> {};
 
 TEST_P(ContactTest, patch)
 {
@@ -32,7 +33,7 @@ TEST_P(ContactTest, patch)
   MPI_Barrier(MPI_COMM_WORLD);
 
   // Create DataStore
-  std::string            name = "contact_patch_" + GetParam().second;
+  std::string            name = "contact_patch_" + std::get<2>(GetParam());
   axom::sidre::DataStore datastore;
   StateManager::initialize(datastore, name + "_data");
 
@@ -43,9 +44,30 @@ TEST_P(ContactTest, patch)
   StateManager::setMesh(std::move(mesh), "patch_mesh");
 
   LinearSolverOptions linear_options{.linear_solver = LinearSolver::Strumpack, .print_level = 1};
+  if (std::get<1>(GetParam()) == LinearSolver::GMRES) {
+    // AMG on the displacement block and an approximate Schur complement on the pressure block
+    linear_options = {.linear_solver  = LinearSolver::GMRES,
+                      .preconditioner = Preconditioner::BlockSchur,
+                      .relative_tol   = 1.0e-12,
+                      .absolute_tol   = 1.0e-14,
+                      .max_iterations = 1000,
+                      .print_level    = 1};
+  }
+  if (std::get<1>(GetParam()) == LinearSolver::CG) {
+    // neither the stiffness nor the penalty terms are assembled, see ContactJacobianOperator
+    linear_options = {.linear_solver  = LinearSolver::CG,
+                      .preconditioner = Preconditioner::Jacobi,
+                      .relative_tol   = 1.0e-12,
+                      .absolute_tol   = 1.0e-14,
+                      .max_iterations = 5000,
+                      .print_level    = 1,
+                      .matrix_free    = true};
+  }
 #ifndef MFEM_USE_STRUMPACK
-  SLIC_INFO_ROOT("Contact requires MFEM built with strumpack.");
-  return;
+  if (linear_options.linear_solver == LinearSolver::Strumpack) {
+    SLIC_INFO_ROOT("Contact requires MFEM built with strumpack.");
+    return;
+  }
 #endif
 
   NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
@@ -55,7 +77,7 @@ TEST_P(ContactTest, patch)
                                            .print_level    = 1};
 
   ContactOptions contact_options{.method      = ContactMethod::SingleMortar,
-                                 .enforcement = GetParam().first,
+                                 .enforcement = std::get<0>(GetParam()),
                                  .type        = ContactType::Frictionless,
                                  .penalty     = 1.0e4};
 
@@ -111,9 +133,14 @@ TEST_P(ContactTest, patch)
 }
 
 INSTANTIATE_TEST_SUITE_P(tribol, ContactTest,
-                         testing::Values(std::make_pair(ContactEnforcement::Penalty, "penalty"),
-                                         std::make_pair(ContactEnforcement::LagrangeMultiplier,
-                                                        "lagrange_multiplier")));
+                         testing::Values(std::make_tuple(ContactEnforcement::Penalty, LinearSolver::Strumpack,
+                                                         "penalty"),
+                                         std::make_tuple(ContactEnforcement::LagrangeMultiplier,
+                                                         LinearSolver::Strumpack, "lagrange_multiplier"),
+                                         std::make_tuple(ContactEnforcement::LagrangeMultiplier,
+                                                         LinearSolver::GMRES, "lagrange_multiplier_block_schur"),
+                                         std::make_tuple(ContactEnforcement::Penalty, LinearSolver::CG,
+                                                         "penalty_matrix_free")));
 
 }  // namespace serac
 
@@ -295,6 +295,26 @@ TEST_F(SolidMechanicsSensitivityFixture, ShapeSensitivities)
   EXPECT_NEAR(directional_deriv, (qoi_plus - qoi_base) / eps, eps);
 }
 
+TEST_F(SolidMechanicsSensitivityFixture, ShapeSensitivitiesWithCompressedCheckpoints)
+{
+  auto solid_solver = createNonlinearSolidMechanicsSolver(dataStore, nonlinear_opts, dyn_opts, mat);
+  solid_solver->setCheckpointCompression("velocity",
+                                         {.method = CheckpointCompression::Quantized, .tolerance = 1.0e-10});
+  solid_solver->setCheckpointCompression("acceleration", {.method = CheckpointCompression::SinglePrecision});
+  auto [qoi_base, _, __, shape_sensitivity] = computeSolidMechanicsQoiSensitivities(*solid_solver, tsInfo);
+
+  solid_solver->resetStates();
+  applyInitialAndBoundaryConditions(*solid_solver);
+  FiniteElementState derivative_direction(shape_sensitivity.space(), "derivative_direction");
+  fillDirection(derivative_direction);
+
+  double qoi_plus = computeSolidMechanicsQoiAdjustingShape(*solid_solver, tsInfo, derivative_direction, eps);
+
+  // the lossy checkpoints perturb the gradient, but only well below the finite difference error
+  double directional_deriv = innerProduct(derivative_direction, shape_sensitivity);
+  EXPECT_NEAR(directional_deriv, (qoi_plus - qoi_base) / eps, 16 * eps);
+}
+
 TEST_F(SolidMechanicsSensitivityFixture, WhenShapeSensitivitiesCalledTwice_GetSameObjectiveAndGradient)
 {
   auto solid_solver = createNonlinearSolidMechanicsSolver(dataStore, nonlinear_opts, dyn_opts, mat);
@@ -309,6 +309,88 @@ TEST_F(HeatTransferSensitivityFixture, ConductivityParameterSensitivities)
   EXPECT_NEAR(directional_deriv, (qoi_plus - qoi_base) / eps, eps);
 }
 
+TEST_F(HeatTransferSensitivityFixture, ConductivityParameterSensitivitiesWithCheckpointBudget)
+{
+  auto thermal_solver = createParameterizedHeatTransfer(data_store, nonlinear_opts, dyn_opts, parameterizedMat);
+  auto [qoi_base, conductivity_sensitivity] = computeThermalConductivitySensitivity(*thermal_solver, tsInfo);
+
+  // keep at most two checkpoints in memory, so the dropped cycles are recomputed during the reverse pass
+  auto budgeted_solver = createParameterizedHeatTransfer(data_store, nonlinear_opts, dyn_opts, parameterizedMat);
+  budgeted_solver->setCheckpointBudget(2);
+  auto [budgeted_qoi, budgeted_sensitivity] = computeThermalConductivitySensitivity(*budgeted_solver, tsInfo);
+
+  EXPECT_NEAR(qoi_base, budgeted_qoi, 1.0e-12);
+
+  budgeted_sensitivity -= conductivity_sensitivity;
+  EXPECT_NEAR(0.0, mfem::ParNormlp(budgeted_sensitivity, 2, MPI_COMM_WORLD), 1.0e-10);
+}
+
+TEST_F(HeatTransferSensitivityFixture, ConductivityParameterSensitivitiesWithReservedCheckpoints)
+{
+  auto thermal_solver = createParameterizedHeatTransfer(data_store, nonlinear_opts, dyn_opts, parameterizedMat);
+  auto [qoi_base, conductivity_sensitivity] = computeThermalConductivitySensitivity(*thermal_solver, tsInfo);
+
+  // with the checkpoints of every cycle allocated up front, the forward and reverse passes don't allocate any more
+  auto reserved_solver = createParameterizedHeatTransfer(data_store, nonlinear_opts, dyn_opts, parameterizedMat);
+  reserved_solver->reserveCheckpoints(tsInfo.numTimesteps());
+  auto reserved_bytes = reserved_solver->memoryUsage().at("checkpoints");
+
+  auto [reserved_qoi, reserved_sensitivity] = computeThermalConductivitySensitivity(*reserved_solver, tsInfo);
+  EXPECT_EQ(reserved_bytes, reserved_solver->memoryUsage().at("checkpoints"));
+
+  // and a second forward pass reuses the storage of the first one
+  reserved_solver->resetStates();
+  computeThermalQoi(*reserved_solver, tsInfo);
+  EXPECT_EQ(reserved_bytes, reserved_solver->memoryUsage().at("checkpoints"));
+
+  EXPECT_NEAR(qoi_base, reserved_qoi, 1.0e-12);
+
+  reserved_sensitivity -= conductivity_sensitivity;
+  EXPECT_NEAR(0.0, mfem::ParNormlp(reserved_sensitivity, 2, MPI_COMM_WORLD), 1.0e-10);
+}
+
+TEST_F(HeatTransferSensitivityFixture, BatchedConductivityParameterSensitivities)
+{
+  auto thermal_solver = createParameterizedHeatTransfer(data_store, nonlinear_opts, dyn_opts, parameterizedMat);
+  auto [qoi_base, conductivity_sensitivity] = computeThermalConductivitySensitivity(*thermal_solver, tsInfo);
+
+  // the same quantity of interest, and three times it, in one reverse sweep
+  thermal_solver->resetStates();
+  computeThermalQoi(*thermal_solver, tsInfo);
+
+  FiniteElementDual batched_sensitivity(conductivity_sensitivity.space(), "batched_sensitivity");
+  FiniteElementDual scaled_sensitivity(conductivity_sensitivity.space(), "scaled_sensitivity");
+  batched_sensitivity = 0.0;
+  scaled_sensitivity  = 0.0;
+
+  FiniteElementDual adjoint_load(thermal_solver->state("temperature").space(), "adjoint_load");
+  FiniteElementDual scaled_adjoint_load(thermal_solver->state("temperature").space(), "scaled_adjoint_load");
+
+  std::vector<BasePhysics::AdjointLoads> adjoint_loads(2);
+  adjoint_loads[0].emplace("temperature", adjoint_load);
+  adjoint_loads[1].emplace("temperature", scaled_adjoint_load);
+
+  for (int i = thermal_solver->cycle(); i > 0; --i) {
+    double dt            = thermal_solver->getCheckpointedTimestep(i - 1);
+    auto   previous_temp = thermal_solver->loadCheckpointedState("temperature", thermal_solver->cycle());
+    computeStepAdjointLoad(previous_temp, adjoint_load, dt);
+    scaled_adjoint_load = adjoint_load;
+    scaled_adjoint_load *= 3.0;
+
+    auto& sensitivities = thermal_solver->reverseAdjointTimestepBatch(adjoint_loads);
+    batched_sensitivity += sensitivities[0].parameters[0];
+    scaled_sensitivity += sensitivities[1].parameters[0];
+  }
+
+  EXPECT_EQ(0, thermal_solver->cycle());
+
+  batched_sensitivity -= conductivity_sensitivity;
+  EXPECT_NEAR(0.0, mfem::ParNormlp(batched_sensitivity, 2, MPI_COMM_WORLD), 1.0e-10);
+
+  scaled_sensitivity.Add(-3.0, conductivity_sensitivity);
+  EXPECT_NEAR(0.0, mfem::ParNormlp(scaled_sensitivity, 2, MPI_COMM_WORLD), 1.0e-10);
+}
+
 TEST_F(HeatTransferSensitivityFixture, NonlinearConductivityParameterSensitivities)
 {
   auto thermal_solver =
@@ -113,6 +113,54 @@ TEST(FiniteElementVector, SetVectorFieldOver2DDomain)
   }
 }
 
+// the nodes of each element are set by the first element of the domain that has them, so they match the coefficients
+TEST(FiniteElementVector, ProjectFunctionOver3DDomain)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "project_function_over_3d_domain");
+
+  auto pmesh = mesh::refineAndDistribute(buildCuboidMesh(4, 4, 4, 1.0, 1.0, 1.0), 0, 0);
+
+  Domain left_half = Domain::ofElements(*pmesh, [](std::vector<serac::vec3> x, int /*attr*/) {
+    return average(x)[0] < 0.5;
+  });
+  Domain bottom = Domain::ofBoundaryElements(*pmesh, [](std::vector<serac::vec3> x, int /*attr*/) {
+    return average(x)[2] < 0.1;
+  });
+
+  FiniteElementState temperature(*pmesh, H1<p, 1>{});
+  FiniteElementState expected_temperature(*pmesh, H1<p, 1>{});
+  temperature          = -1.0;
+  expected_temperature = -1.0;
+
+  temperature.project<dim>([](const vec3& x) { return x[0] * x[1] + x[2]; }, left_half);
+  mfem::FunctionCoefficient temperature_coef([](const mfem::Vector& x) { return x[0] * x[1] + x[2]; });
+  expected_temperature.project(temperature_coef, left_half);
+
+  temperature -= expected_temperature;
+  EXPECT_LT(temperature.Normlinf(), 1.0e-14);
+
+  FiniteElementState displacement(*pmesh, H1<p, dim>{});
+  FiniteElementState expected_displacement(*pmesh, H1<p, dim>{});
+  displacement          = 0.0;
+  expected_displacement = 0.0;
+
+  displacement.project<dim>([](const vec3& x) { return vec3{x[0] * x[0], x[1] - x[2], 2.0}; }, bottom);
+  mfem::VectorFunctionCoefficient displacement_coef(dim, [](const mfem::Vector& x, mfem::Vector& u) {
+    u[0] = x[0] * x[0];
+    u[1] = x[1] - x[2];
+    u[2] = 2.0;
+  });
+  expected_displacement.project(displacement_coef, bottom);
+
+  displacement -= expected_displacement;
+  EXPECT_LT(displacement.Normlinf(), 1.0e-14);
+  EXPECT_GT(expected_displacement.Normlinf(), 1.0);
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -116,6 +116,46 @@ TEST(Thermal, ParameterizedMaterial)
   EXPECT_NEAR(1.7890782925134845, mfem::ParNormlp(sensitivity, 2, MPI_COMM_WORLD), 1.0e-6);
 }
 
+TEST(Thermal, BoundParameter)
+{
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_bound_parameter");
+
+  std::string mesh_tag{"mesh"};
+  auto&       pmesh = serac::StateManager::setMesh(mesh::refineAndDistribute(buildRectangleMesh(4, 4), 0, 0), mesh_tag);
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  HeatTransfer<p, dim, Parameters<H1<1>>> thermal_solver(
+      heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options,
+      heat_transfer::default_static_options, "thermal_bound_parameter", mesh_tag, {"conductivity"});
+
+  FiniteElementState conductivity(pmesh, H1<1>{}, "bound_conductivity");
+  conductivity = 1.0;
+
+  // the parameter uses the values of the bound state, without a copy of them
+  thermal_solver.bindParameter(0, conductivity);
+  EXPECT_TRUE(thermal_solver.parameterBound(0));
+  EXPECT_EQ(thermal_solver.parameter(0).GetData(), conductivity.GetData());
+  EXPECT_TRUE(thermal_solver.parameterChanged(0));
+  EXPECT_FALSE(thermal_solver.parameterChanged(0));
+
+  conductivity = 2.0;
+  EXPECT_EQ(thermal_solver.parameter(0)(0), 2.0);
+  EXPECT_TRUE(thermal_solver.parameterChanged(0));
+
+  // copying values into it gives the parameter its own storage back
+  FiniteElementState other_conductivity(pmesh, H1<1>{}, "other_conductivity");
+  other_conductivity = 3.0;
+  thermal_solver.setParameter(0, other_conductivity);
+  EXPECT_FALSE(thermal_solver.parameterBound(0));
+  EXPECT_NE(thermal_solver.parameter(0).GetData(), conductivity.GetData());
+  EXPECT_EQ(thermal_solver.parameter(0)(0), 3.0);
+  EXPECT_EQ(conductivity(0), 2.0);
+  EXPECT_TRUE(thermal_solver.parameterChanged(0));
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -0,0 +1,97 @@
+// Copyright (c) 2019-2024, Lawrence Livermore National Security, LLC and
+// other Serac Project Developers. See the top-level LICENSE file for
+// details.
+//
+// SPDX-License-Identifier: (BSD-3-Clause)
+
+#include <array>
+#include <cmath>
+
+#include "axom/slic/core/SimpleLogger.hpp"
+#include <gtest/gtest.h>
+#include "mfem.hpp"
+
+#include "serac/serac_config.hpp"
+#include "serac/mesh/mesh_utils.hpp"
+#include "serac/physics/state/finite_element_state.hpp"
+#include "serac/physics/state/probes.hpp"
+#include "serac/physics/state/state_manager.hpp"
+
+namespace serac {
+
+TEST(Probes, SampleQuadraticFields)
+{
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "probes_test");
+
+  auto pmesh = mesh::refineAndDistribute(buildCuboidMesh(4, 4, 4, 1.0, 1.0, 1.0), 0, 0);
+
+  // quadratic fields are interpolated exactly by quadratic elements
+  constexpr int      p = 2;
+  FiniteElementState temperature(*pmesh, H1<p, 1>{}, "temperature");
+  FiniteElementState displacement(*pmesh, H1<p, 3>{}, "displacement");
+
+  auto exact_temperature  = [](const mfem::Vector& x) { return x(0) * x(1) + x(2) * x(2); };
+  auto exact_displacement = [](const mfem::Vector& x, mfem::Vector& u) {
+    u(0) = x(0) * x(0);
+    u(1) = x(1) - x(2);
+    u(2) = 2.0 * x(0) * x(2);
+  };
+
+  mfem::FunctionCoefficient       temperature_coef(exact_temperature);
+  mfem::VectorFunctionCoefficient displacement_coef(3, exact_displacement);
+  temperature.project(temperature_coef);
+  displacement.project(displacement_coef);
+
+  // points inside of elements, on shared faces and vertices, and one outside of the mesh
+  std::vector<mfem::Vector> points;
+  for (auto [x, y, z] : {std::array{0.1, 0.2, 0.3}, std::array{0.5, 0.5, 0.5}, std::array{0.75, 0.3, 0.99},
+                         std::array{0.0, 1.0, 0.25}, std::array{1.5, 0.5, 0.5}}) {
+    points.emplace_back(3);
+    points.back()(0) = x;
+    points.back()(1) = y;
+    points.back()(2) = z;
+  }
+
+  Probes probes(*pmesh, points);
+  EXPECT_EQ(probes.size(), 5);
+  EXPECT_TRUE(probes.found(3));
+  EXPECT_FALSE(probes.found(4));
+
+  auto samples = probes.sample({&temperature, &displacement});
+
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank != 0) {
+    EXPECT_TRUE(samples.empty());
+    return;
+  }
+
+  ASSERT_EQ(samples.size(), size_t(5 * (1 + 3)));
+  mfem::Vector u(3);
+  for (size_t i = 0; i < 4; i++) {
+    EXPECT_NEAR(samples[i], exact_temperature(points[i]), 1.0e-12);
+
+    exact_displacement(points[i], u);
+    for (size_t c = 0; c < 3; c++) {
+      EXPECT_NEAR(samples[5 + 3 * i + c], u(int(c)), 1.0e-12);
+    }
+  }
+  EXPECT_TRUE(std::isnan(samples[4]));
+  EXPECT_TRUE(std::isnan(samples[5 + 3 * 4]));
+}
+
+}  // namespace serac
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  MPI_Init(&argc, &argv);
+
+  axom::slic::SimpleLogger logger;
+
+  int result = RUN_ALL_TESTS();
+  MPI_Finalize();
+
+  return result;
+}
@@ -392,6 +392,581 @@ void functional_parameterized_solid_test(double expected_disp_norm)
   EXPECT_NEAR(expected_disp_norm, norm(solid_solver.displacement()), 1.0e-6);
 }
 
+TEST(SolidMechanics, RebalanceWithElementCosts)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_rebalance_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+  using Hardening = solid_mechanics::LinearHardening;
+  using Material  = solid_mechanics::J2SmallStrain<Hardening>;
+
+  Material mat{.E = 10000, .nu = 0.25, .hardening = Hardening{.sigma_y = 50.0, .Hi = 50.0}, .Hk = 5.0, .density = 1.0};
+
+  serac::LinearSolverOptions    linear_options{.linear_solver = LinearSolver::SuperLU};
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-12,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 50};
+
+  std::set<int> support           = {1};
+  auto          zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  std::set<int> tip               = {2};
+  auto          translated_in_z   = [](const mfem::Vector&, double t, mfem::Vector& u) -> void {
+    u    = 0.0;
+    u[2] = -t;
+  };
+
+  auto build = [&](std::shared_ptr<QuadratureData<Material::State>>& state) {
+    auto solid = std::make_unique<SolidMechanics<p, dim>>(nonlinear_options, linear_options,
+                                                          solid_mechanics::default_quasistatic_options,
+                                                          GeometricNonlinearities::Off, "solid_mechanics", mesh_tag);
+    state      = solid->createQuadratureDataBuffer(Material::State{});
+    solid->setMaterial(mat, state);
+    solid->setDisplacementBCs(support, zero_displacement);
+    solid->setDisplacementBCs(tip, translated_in_z);
+    solid->completeSetup();
+    return solid;
+  };
+
+  auto total_plastic_strain = [](QuadratureData<Material::State>& state, int num_elements) {
+    auto   view  = state[mfem::Geometry::CUBE];
+    double local = 0.0;
+    for (uint32_t e = 0; e < uint32_t(num_elements); e++) {
+      for (uint32_t q = 0; q < 8; q++) {
+        local += view.load(e, q).accumulated_plastic_strain;
+      }
+    }
+    double total = 0.0;
+    MPI_Allreduce(&local, &total, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    return total;
+  };
+
+  std::shared_ptr<QuadratureData<Material::State>> state;
+
+  auto solid = build(state);
+  solid->recordElementCosts(true);
+  for (int i = 0; i < 2; i++) {
+    solid->advanceTimestep(0.25);
+  }
+
+  double displacement_norm = norm(solid->displacement());
+  double plastic_strain    = total_plastic_strain(*state, StateManager::mesh(mesh_tag).GetNE());
+  EXPECT_GT(plastic_strain, 0.0);
+
+  mfem::Vector costs          = solid->elementCosts();
+  auto         redistribution = StateManager::rebalance(mesh_tag, costs);
+
+  // construct the physics module again on the rebalanced mesh
+  solid.reset();
+  auto previous_state = state;
+  solid               = build(state);
+  solid->loadTransferredStates();
+  StateManager::redistributeQuadratureData(*previous_state, *state, redistribution, MPI_COMM_WORLD);
+
+  EXPECT_NEAR(norm(solid->displacement()), displacement_norm, 1.0e-12 * displacement_norm);
+  EXPECT_NEAR(total_plastic_strain(*state, StateManager::mesh(mesh_tag).GetNE()), plastic_strain,
+              1.0e-12 * plastic_strain);
+}
+
+TEST(SolidMechanics, QuadratureDataCheckpoints)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_qdata_checkpoint_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+  using Hardening = solid_mechanics::LinearHardening;
+  using Material  = solid_mechanics::J2SmallStrain<Hardening>;
+
+  Material mat{.E = 10000, .nu = 0.25, .hardening = Hardening{.sigma_y = 50.0, .Hi = 50.0}, .Hk = 5.0, .density = 1.0};
+
+  SolidMechanics<p, dim> solid(solid_mechanics::default_nonlinear_options, solid_mechanics::direct_linear_options,
+                               solid_mechanics::default_quasistatic_options, GeometricNonlinearities::Off,
+                               "solid_mechanics", mesh_tag);
+  auto state = solid.createQuadratureDataBuffer(Material::State{});
+  solid.setMaterial(mat, state);
+  solid.setDisplacementBCs({1}, [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; });
+  solid.setDisplacementBCs({2}, [](const mfem::Vector&, double t, mfem::Vector& u) {
+    u    = 0.0;
+    u[2] = -t;
+  });
+  solid.completeSetup();
+
+  for (int i = 0; i < 2; i++) {
+    solid.advanceTimestep(0.25);
+  }
+  solid.outputStateToDisk();
+
+  // the material state registered by setMaterial() is written with the fields
+  auto loaded = solid.createQuadratureDataBuffer(Material::State{});
+  StateManager::loadCheckpointedQuadratureData(solid.cycle(), mesh_tag, "solid_mechanics_material_state_0", *loaded);
+
+  auto   view         = (*state)[mfem::Geometry::CUBE];
+  auto   loaded_view  = (*loaded)[mfem::Geometry::CUBE];
+  double max_strain   = 0.0;
+  double max_mismatch = 0.0;
+  for (uint32_t e = 0; e < uint32_t(StateManager::mesh(mesh_tag).GetNE()); e++) {
+    for (uint32_t q = 0; q < 8; q++) {
+      auto saved   = view.load(e, q);
+      max_strain   = std::max(max_strain, saved.accumulated_plastic_strain);
+      max_mismatch = std::max(max_mismatch, norm(saved.plastic_strain - loaded_view.load(e, q).plastic_strain));
+    }
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &max_strain, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  EXPECT_GT(max_strain, 0.0);
+  EXPECT_EQ(max_mismatch, 0.0);
+}
+
+TEST(SolidMechanics, DerivedOutputs)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_derived_outputs_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+  using Hardening = solid_mechanics::LinearHardening;
+  using Material  = solid_mechanics::J2SmallStrain<Hardening>;
+
+  Material mat{.E = 10000, .nu = 0.25, .hardening = Hardening{.sigma_y = 50.0, .Hi = 50.0}, .Hk = 5.0, .density = 1.0};
+
+  serac::LinearSolverOptions    linear_options{.linear_solver = LinearSolver::SuperLU};
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-12,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 50};
+
+  SolidMechanics<p, dim> solid(nonlinear_options, linear_options, solid_mechanics::default_quasistatic_options,
+                               GeometricNonlinearities::Off, "solid_mechanics", mesh_tag);
+
+  auto state = solid.setMaterialWithOutputs(mat, Material::State{}, {"von_mises", "eqps"},
+                                            solid_mechanics::VonMisesStress{},
+                                            solid_mechanics::EquivalentPlasticStrain{});
+
+  solid.setDisplacementBCs({1}, [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; });
+  solid.setDisplacementBCs({2}, [](const mfem::Vector&, double t, mfem::Vector& u) {
+    u    = 0.0;
+    u[2] = -t;
+  });
+  solid.completeSetup();
+
+  for (int i = 0; i < 2; i++) {
+    solid.advanceTimestep(0.25);
+  }
+
+  // the element averages of the recorded quantities match those of the committed material states
+  auto   view         = (*state)[mfem::Geometry::CUBE];
+  auto&  von_mises    = solid.outputField("von_mises");
+  auto&  eqps         = solid.outputField("eqps");
+  double max_eqps     = 0.0;
+  double max_stress   = 0.0;
+  int    num_elements = StateManager::mesh(mesh_tag).GetNE();
+  for (uint32_t e = 0; e < uint32_t(num_elements); e++) {
+    double average = 0.0;
+    for (uint32_t q = 0; q < 8; q++) {
+      average += view.load(e, q).material_state.accumulated_plastic_strain / 8.0;
+    }
+    EXPECT_NEAR(eqps(int(e)), average, 1.0e-10);
+    EXPECT_GE(von_mises(int(e)), 0.0);
+    max_eqps   = std::max(max_eqps, eqps(int(e)));
+    max_stress = std::max(max_stress, von_mises(int(e)));
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &max_eqps, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &max_stress, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  EXPECT_GT(max_eqps, 0.0);
+  EXPECT_GT(max_stress, 50.0);
+}
+
+TEST(SolidMechanics, RefineWithQuadratureData)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_refine_test");
+
+  // hexahedral meshes are refined nonconformingly
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  auto        serial_mesh = buildMeshFromFile(filename);
+  serial_mesh.EnsureNCMesh();
+  serac::StateManager::setMesh(mesh::refineAndDistribute(std::move(serial_mesh)), mesh_tag);
+
+  using Hardening = solid_mechanics::LinearHardening;
+  using Material  = solid_mechanics::J2SmallStrain<Hardening>;
+
+  Material mat{.E = 10000, .nu = 0.25, .hardening = Hardening{.sigma_y = 50.0, .Hi = 50.0}, .Hk = 5.0, .density = 1.0};
+
+  serac::LinearSolverOptions    linear_options{.linear_solver = LinearSolver::SuperLU};
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-12,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 50};
+
+  std::set<int> support           = {1};
+  auto          zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  std::set<int> tip               = {2};
+  auto          translated_in_z   = [](const mfem::Vector&, double t, mfem::Vector& u) -> void {
+    u    = 0.0;
+    u[2] = -t;
+  };
+
+  auto build = [&](std::shared_ptr<QuadratureData<Material::State>>& state) {
+    auto solid = std::make_unique<SolidMechanics<p, dim>>(nonlinear_options, linear_options,
+                                                          solid_mechanics::default_quasistatic_options,
+                                                          GeometricNonlinearities::Off, "solid_mechanics", mesh_tag);
+    state      = solid->createQuadratureDataBuffer(Material::State{});
+    solid->setMaterial(mat, state);
+    solid->setDisplacementBCs(support, zero_displacement);
+    solid->setDisplacementBCs(tip, translated_in_z);
+    solid->completeSetup();
+    return solid;
+  };
+
+  auto max_plastic_strain = [](QuadratureData<Material::State>& state, int num_elements) {
+    auto   view  = state[mfem::Geometry::CUBE];
+    double local = 0.0;
+    for (uint32_t e = 0; e < uint32_t(num_elements); e++) {
+      for (uint32_t q = 0; q < 8; q++) {
+        local = std::max(local, view.load(e, q).accumulated_plastic_strain);
+      }
+    }
+    double max = 0.0;
+    MPI_Allreduce(&local, &max, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+    return max;
+  };
+
+  std::shared_ptr<QuadratureData<Material::State>> state;
+
+  auto solid = build(state);
+  for (int i = 0; i < 2; i++) {
+    solid->advanceTimestep(0.25);
+  }
+
+  mfem::Vector zero_vector(dim);
+  zero_vector = 0.0;
+  mfem::VectorConstantCoefficient zero(zero_vector);
+
+  double displacement_norm = solid->displacement().gridFunction().ComputeL2Error(zero);
+  double plastic_strain    = max_plastic_strain(*state, StateManager::mesh(mesh_tag).GetNE());
+  EXPECT_GT(plastic_strain, 0.0);
+
+  // refine the elements that yielded
+  auto&        mesh = StateManager::mesh(mesh_tag);
+  mfem::Vector errors(mesh.GetNE());
+  auto         view = (*state)[mfem::Geometry::CUBE];
+  for (int e = 0; e < mesh.GetNE(); e++) {
+    errors[e] = 0.0;
+    for (uint32_t q = 0; q < 8; q++) {
+      errors[e] += view.load(uint32_t(e), q).accumulated_plastic_strain;
+    }
+  }
+  int num_elements = mesh.GetGlobalNE();
+
+  auto adaptation = StateManager::refine(mesh_tag, errors, 0.0);
+  EXPECT_GT(StateManager::mesh(mesh_tag).GetGlobalNE(), num_elements);
+
+  // construct the physics module again on the refined mesh
+  solid.reset();
+  auto previous_state = state;
+  solid               = build(state);
+  solid->loadTransferredStates();
+  StateManager::transferQuadratureData(*previous_state, *state, adaptation, StateManager::mesh(mesh_tag));
+
+  // linear displacements are interpolated exactly, and the internal variables are copied
+  EXPECT_NEAR(solid->displacement().gridFunction().ComputeL2Error(zero), displacement_norm,
+              1.0e-10 * displacement_norm);
+  EXPECT_NEAR(max_plastic_strain(*state, StateManager::mesh(mesh_tag).GetNE()), plastic_strain,
+              1.0e-14 * plastic_strain);
+
+  solid->advanceTimestep(0.25);
+  EXPECT_GT(max_plastic_strain(*state, StateManager::mesh(mesh_tag).GetNE()), plastic_strain);
+}
+
+/**
+ * @brief Checks a matrix-free CG solve of a cantilever with one of the preconditioners that never assemble the
+ * high-order Jacobian against a direct solve
+ *
+ * @tparam p The polynomial order of the displacement
+ * @param preconditioner The preconditioner of the CG solve
+ * @param parallel_refinement The number of uniform refinements, kept as a mesh hierarchy
+ */
+template <int p>
+void matrix_free_preconditioner_test(Preconditioner preconditioner, int parallel_refinement = 0)
+{
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_matrix_free_preconditioner_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMeshHierarchy(
+      mesh::refineAndDistributeHierarchy(buildMeshFromFile(filename), 0, parallel_refinement), mesh_tag);
+  EXPECT_EQ(StateManager::coarseMeshes(mesh_tag).size(), static_cast<std::size_t>(parallel_refinement));
+
+  solid_mechanics::LinearIsotropic mat{.density = 1.0, .K = 1.0, .G = 1.0};
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-10,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 10};
+
+  std::set<int> support           = {1};
+  auto          zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  std::set<int> tip               = {2};
+  auto          translated_in_z   = [](const mfem::Vector&, double, mfem::Vector& u) -> void {
+    u    = 0.0;
+    u[2] = -0.1;
+  };
+
+  auto solve = [&](const LinearSolverOptions& linear_options, const std::string& physics_name) {
+    SolidMechanics<p, dim> solid(nonlinear_options, linear_options, solid_mechanics::default_quasistatic_options,
+                                 GeometricNonlinearities::Off, physics_name, mesh_tag);
+    solid.setMaterial(mat);
+    solid.setDisplacementBCs(support, zero_displacement);
+    solid.setDisplacementBCs(tip, translated_in_z);
+    solid.completeSetup();
+    solid.advanceTimestep(1.0);
+    return mfem::Vector(solid.displacement());
+  };
+
+  auto reference = solve({.linear_solver = LinearSolver::SuperLU}, "direct");
+
+  auto preconditioned = solve({.linear_solver  = LinearSolver::CG,
+                               .preconditioner = preconditioner,
+                               .relative_tol   = 1.0e-12,
+                               .absolute_tol   = 1.0e-14,
+                               .max_iterations = 500,
+                               .matrix_free    = true},
+                              "preconditioned");
+
+  preconditioned -= reference;
+  EXPECT_LT(mfem::ParNormlp(preconditioned, 2, MPI_COMM_WORLD),
+            1.0e-8 * mfem::ParNormlp(reference, 2, MPI_COMM_WORLD));
+}
+
+TEST(SolidMechanics, GeometricMultigrid) { matrix_free_preconditioner_test<2>(Preconditioner::GeometricMultigrid, 1); }
+
+// only the p = 1 level is assembled
+TEST(SolidMechanics, PMultigrid) { matrix_free_preconditioner_test<3>(Preconditioner::PMultigrid); }
+
+TEST(SolidMechanics, LowOrderRefined) { matrix_free_preconditioner_test<2>(Preconditioner::LOR); }
+
+// a small problem fits in memory either way, so the matrix-free policy is the faster of the two in this run
+TEST(SolidMechanics, AutomaticJacobianPolicy)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_automatic_jacobian_policy");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 0), mesh_tag);
+
+  solid_mechanics::NeoHookean mat{.density = 1.0, .K = 1.0, .G = 1.0};
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-10,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 10};
+
+  auto solve = [&](const LinearSolverOptions& linear_options, const std::string& physics_name) {
+    SolidMechanics<p, dim> solid(nonlinear_options, linear_options, solid_mechanics::default_quasistatic_options,
+                                 GeometricNonlinearities::On, physics_name, mesh_tag);
+    solid.setMaterial(mat);
+    solid.setDisplacementBCs(std::set<int>{1}, [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; });
+    solid.setDisplacementBCs(std::set<int>{2}, [](const mfem::Vector&, double, mfem::Vector& u) {
+      u    = 0.0;
+      u[2] = -0.1;
+    });
+    solid.automaticJacobianPolicy(true);
+    solid.completeSetup();
+    solid.advanceTimestep(1.0);
+    return std::pair{mfem::Vector(solid.displacement()), solid.jacobianPolicy()};
+  };
+
+  auto [reference, assembled_policy] = solve({.linear_solver = LinearSolver::SuperLU}, "direct");
+  EXPECT_EQ(assembled_policy, JacobianPolicy::Assembled);
+
+  auto [matrix_free, matrix_free_policy] = solve({.linear_solver  = LinearSolver::CG,
+                                                  .preconditioner = Preconditioner::LOR,
+                                                  .relative_tol   = 1.0e-12,
+                                                  .absolute_tol   = 1.0e-14,
+                                                  .max_iterations = 500,
+                                                  .matrix_free    = true},
+                                                 "matrix_free");
+  EXPECT_TRUE(matrix_free_policy == JacobianPolicy::StoredDerivatives ||
+              matrix_free_policy == JacobianPolicy::RecomputedDerivatives);
+
+  matrix_free -= reference;
+  EXPECT_LT(mfem::ParNormlp(matrix_free, 2, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(reference, 2, MPI_COMM_WORLD));
+}
+
+// the interior dofs of the p = 3 hexes are eliminated, and the skeleton dofs solved for with CG and AMG
+TEST(SolidMechanics, StaticCondensation)
+{
+  constexpr int p   = 3;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_static_condensation_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0), mesh_tag);
+
+  solid_mechanics::LinearIsotropic mat{.density = 1.0, .K = 1.0, .G = 1.0};
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-10,
+                                                  .absolute_tol   = 1.0e-12,
+                                                  .max_iterations = 10};
+
+  std::set<int> support           = {1};
+  auto          zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+  std::set<int> tip               = {2};
+  auto          translated_in_z   = [](const mfem::Vector&, double, mfem::Vector& u) -> void {
+    u    = 0.0;
+    u[2] = -0.1;
+  };
+
+  auto solve = [&](const LinearSolverOptions& linear_options, const std::string& physics_name) {
+    SolidMechanics<p, dim> solid(nonlinear_options, linear_options, solid_mechanics::default_quasistatic_options,
+                                 GeometricNonlinearities::Off, physics_name, mesh_tag);
+    solid.setMaterial(mat);
+    solid.setDisplacementBCs(support, zero_displacement);
+    solid.setDisplacementBCs(tip, translated_in_z);
+    solid.completeSetup();
+    solid.advanceTimestep(1.0);
+    return mfem::Vector(solid.displacement());
+  };
+
+  auto reference = solve({.linear_solver = LinearSolver::SuperLU}, "direct");
+
+  auto condensed = solve({.linear_solver       = LinearSolver::CG,
+                          .preconditioner      = Preconditioner::HypreAMG,
+                          .relative_tol        = 1.0e-12,
+                          .absolute_tol        = 1.0e-14,
+                          .max_iterations      = 500,
+                          .static_condensation = true},
+                         "condensed");
+
+  condensed -= reference;
+  EXPECT_LT(mfem::ParNormlp(condensed, 2, MPI_COMM_WORLD), 1.0e-8 * mfem::ParNormlp(reference, 2, MPI_COMM_WORLD));
+}
+
+TEST(SolidMechanics, MixedPressureRelievesLocking)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_mixed_pressure_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  auto&       pmesh =
+      serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 0, 0), mesh_tag);
+
+  // nearly incompressible, with a Poisson ratio of about 0.4995
+  solid_mechanics::LinearIsotropic mat{.density = 1.0, .K = 1000.0, .G = 1.0};
+
+  std::set<int> support           = {1};
+  auto          zero_displacement = [](const mfem::Vector&, mfem::Vector& u) -> void { u = 0.0; };
+
+  solid_mechanics::ConstantBodyForce<dim> force{{0.0, 0.0, -1.0e-3}};
+
+  auto solve = [&](bool mixed, const std::string& physics_name) {
+    SolidMechanics<p, dim> solid(solid_mechanics::default_nonlinear_options, {.linear_solver = LinearSolver::SuperLU},
+                                 solid_mechanics::default_quasistatic_options, GeometricNonlinearities::Off,
+                                 physics_name, mesh_tag);
+    if (mixed) {
+      solid.setMixedMaterial(mat);
+    } else {
+      solid.setMaterial(mat);
+    }
+    solid.setDisplacementBCs(support, zero_displacement);
+    solid.addBodyForce(force, EntireDomain(pmesh));
+    solid.completeSetup();
+    solid.advanceTimestep(1.0);
+
+    if (mixed) {
+      EXPECT_GT(norm(solid.pressure()), 0.0);
+    }
+    return norm(solid.displacement());
+  };
+
+  // the volumetric locking of the displacement-only formulation stiffens the beam
+  EXPECT_GT(solve(true, "mixed"), solve(false, "displacement"));
+}
+
+TEST(SolidMechanics, ReactionResultantBalancesBodyForce)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_mechanics_reaction_resultant_test");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/beam-hex.mesh";
+  std::string mesh_tag{"mesh"};
+  auto&       pmesh =
+      serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 1, 0), mesh_tag);
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-12,
+                                                  .absolute_tol   = 1.0e-14,
+                                                  .max_iterations = 10};
+
+  SolidMechanics<p, dim> solid(nonlinear_options, {.linear_solver = LinearSolver::SuperLU},
+                               solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
+                               "reaction_resultant", mesh_tag);
+
+  solid_mechanics::NeoHookean mat{.density = 1.0, .K = 1.0, .G = 0.25};
+  solid.setMaterial(mat);
+
+  std::set<int> support = {1};
+  solid.setDisplacementBCs(support, [](const mfem::Vector&, mfem::Vector& u) { u = 0.0; });
+
+  tensor<double, dim> body_force{{0.0, 1.0e-3, -2.0e-3}};
+  solid.addBodyForce(solid_mechanics::ConstantBodyForce<dim>{body_force}, EntireDomain(pmesh));
+
+  solid.addReactionBoundary("support", Domain::ofBoundaryElements(pmesh, by_attr<dim>(1)));
+  solid.completeSetup();
+  solid.advanceTimestep(1.0);
+
+  double volume = 0.0;
+  for (int e = 0; e < pmesh.GetNE(); e++) {
+    volume += pmesh.GetElementVolume(e);
+  }
+  MPI_Allreduce(MPI_IN_PLACE, &volume, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+
+  // the support holds up the whole body force, which enters the residual with a minus sign
+  auto resultant = solid.reactionResultant("support");
+  for (int i = 0; i < dim; i++) {
+    EXPECT_NEAR(resultant[i], -body_force[i] * volume, 1.0e-10);
+  }
+}
+
 TEST(SolidMechanics, 2DQuadParameterizedStatic) { functional_parameterized_solid_test<2, 2>(2.1773851975471392); }
 
 TEST(SolidMechanics, 3DQuadStaticJ2) { functional_solid_test_static_J2(); }
@@ -6,6 +6,7 @@
 
 #include "serac/physics/solid_mechanics.hpp"
 
+#include <algorithm>
 #include <functional>
 #include <set>
 #include <string>
@@ -251,6 +252,7 @@ private:
  *
  * @param exact_solution Exact solution of problem
  * @param bc Specifier for boundary condition type to test
+ * @param method The time integration method
  * @return double L2 norm (continuous) of error in computed solution
  * *
  * @pre exact_solution must implement operator() that is an MFEM
@@ -263,7 +265,8 @@ private:
  * solid functional that should lead to the exact solution
  */
 template <typename element_type, typename solution_type>
-double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
+double solution_error(solution_type exact_solution, PatchBoundaryCondition bc,
+                      TimestepMethod method = TimestepMethod::Newmark)
 {
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -308,7 +311,7 @@ double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
   serac::NonlinearSolverOptions nonlin_opts{.relative_tol = 1.0e-13, .absolute_tol = 1.0e-13};
 
   SolidMechanics<p, dim> solid(nonlin_opts, serac::solid_mechanics::default_linear_options,
-                               TimesteppingOptions{TimestepMethod::Newmark, DirichletEnforcementMethod::DirectControl},
+                               TimesteppingOptions{method, DirichletEnforcementMethod::DirectControl},
                                GeometricNonlinearities::On, "solid_dynamics", mesh_tag);
 
   solid_mechanics::NeoHookean mat{.density = 1.0, .K = 1.0, .G = 1.0};
@@ -325,9 +328,10 @@ double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
   // Finalize the data structures
   solid.completeSetup();
 
-  // Integrate in time
-  for (int i = 0; i < 3; i++) {
-    solid.advanceTimestep(1.0);
+  // Integrate in time, with explicit dynamics limited by its stable timestep estimate
+  const double t_final = 3.0;
+  for (int i = 0; t_final - solid.time() > 1.0e-12; i++) {
+    solid.advanceTimestep(std::min(solid.suggestedTimestep(1.0), t_final - solid.time()));
 
     // Output solution for debugging
     // solid.outputStateToDisk("paraview_output");
@@ -354,10 +358,10 @@ double solution_error(solution_type exact_solution, PatchBoundaryCondition bc)
 }
 
 template <typename element_type>
-double affine_velocity_test(PatchBoundaryCondition bc)
+double affine_velocity_test(PatchBoundaryCondition bc, TimestepMethod method = TimestepMethod::Newmark)
 {
   constexpr int dim = dimension_of(element_type::geometry);
-  return solution_error<element_type>(AffineSolution<dim>(), bc);
+  return solution_error<element_type>(AffineSolution<dim>(), bc, method);
 }
 
 template <typename element_type>
@@ -390,6 +394,22 @@ TEST(SolidMechanicsDynamic, PatchTestQuadQ1EssentialBcs)
   EXPECT_LT(error, tol);
 }
 
+TEST(SolidMechanicsDynamic, PatchTestTriQ1EssentialBcsExplicit)
+{
+  using element_type = finite_element<mfem::Geometry::TRIANGLE, H1<LINEAR> >;
+  double error       =
+      affine_velocity_test<element_type>(PatchBoundaryCondition::Essential, TimestepMethod::CentralDifference);
+  EXPECT_LT(error, tol);
+}
+
+TEST(SolidMechanicsDynamic, PatchTestQuadQ1EssentialBcsExplicit)
+{
+  using element_type = finite_element<mfem::Geometry::SQUARE, H1<LINEAR> >;
+  double error       =
+      affine_velocity_test<element_type>(PatchBoundaryCondition::Essential, TimestepMethod::CentralDifference);
+  EXPECT_LT(error, tol);
+}
+
 TEST(SolidMechanicsDynamic, PatchTestTriQ2EssentialBcs)
 {
   using element_type = finite_element<mfem::Geometry::TRIANGLE, H1<QUADRATIC> >;
@@ -340,6 +340,77 @@ TEST(SolidMechanicsShape, BodyForce) { finite_difference_shape_test(LoadingType:
 TEST(SolidMechanicsShape, Pressure) { finite_difference_shape_test(LoadingType::Pressure); }
 TEST(SolidMechanicsShape, Traction) { finite_difference_shape_test(LoadingType::Traction); }
 
+TEST(SolidMechanicsShape, BandSensitivitiesMatchOnTheSurface)
+{
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "solid_functional_band_shape_sensitivities");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/patch2D_tris.mesh";
+  auto        mesh     = mesh::refineAndDistribute(buildMeshFromFile(filename), 2, 0);
+
+  std::string mesh_tag{"mesh"};
+  auto&       pmesh = serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  serac::NonlinearSolverOptions nonlin_options{
+      .relative_tol = 1.0e-10, .absolute_tol = 1.0e-14, .max_iterations = 10, .print_level = 1};
+
+  SolidMechanics<p, dim> solid_solver(nonlin_options, solid_mechanics::direct_linear_options,
+                                      solid_mechanics::default_quasistatic_options, GeometricNonlinearities::On,
+                                      "solid_functional", mesh_tag);
+
+  solid_mechanics::NeoHookean mat{1.0, 1.0, 1.0};
+  solid_solver.setMaterial(mat);
+
+  std::set<int> ess_bdr = {1};
+  auto          bc      = [](const mfem::Vector&, mfem::Vector& bc_vec) -> void { bc_vec = 0.0; };
+  solid_solver.setDisplacementBCs(ess_bdr, bc);
+
+  // the design surface is the top of the patch, which is loaded by a pressure
+  auto top =
+      Domain::ofBoundaryElements(pmesh, [](std::vector<vec2> X, int) { return X[0][1] > 0.99 && X[1][1] > 0.99; });
+  solid_solver.setPressure([](auto, double) { return 0.1; }, top);
+  solid_solver.addBodyForce(solid_mechanics::ConstantBodyForce<dim>{{0.0, 1.0e-1}});
+
+  solid_solver.completeSetup();
+  solid_solver.advanceTimestep(1.0);
+
+  FiniteElementDual adjoint_load(solid_solver.displacement().space(), "adjoint_load");
+  adjoint_load = 1.0;
+  solid_solver.setAdjointLoad({{"displacement", adjoint_load}});
+  solid_solver.reverseAdjointTimestep();
+
+  mfem::Vector full_sensitivity(solid_solver.computeTimestepShapeSensitivity());
+
+  Domain band = elementsTouching(top);
+  EXPECT_LT(static_cast<int>(band.get(mfem::Geometry::TRIANGLE).size()), pmesh.GetNE());
+
+  solid_solver.setShapeSensitivityDomain(band);
+  mfem::Vector band_sensitivity(solid_solver.computeTimestepShapeSensitivity());
+
+  // the sensitivities of the nodes on the design surface only depend on the elements in the band
+  auto&            shape_space  = solid_solver.shapeDisplacement().space();
+  mfem::Array<int> surface_dofs = top.dof_list(const_cast<mfem::ParFiniteElementSpace*>(&shape_space));
+  for (int dof : surface_dofs) {
+    for (int c = 0; c < dim; c++) {
+      int tdof = shape_space.GetLocalTDofNumber(shape_space.DofToVDof(dof, c));
+      if (tdof >= 0) {
+        EXPECT_NEAR(band_sensitivity(tdof), full_sensitivity(tdof), 1.0e-12 * (1.0 + std::abs(full_sensitivity(tdof))));
+      }
+    }
+  }
+
+  // and without a band, the sensitivities are integrated over the whole mesh again
+  solid_solver.setShapeSensitivityDomain(std::nullopt);
+  mfem::Vector difference(solid_solver.computeTimestepShapeSensitivity());
+  difference -= full_sensitivity;
+  EXPECT_LT(difference.Normlinf(), 1.0e-14 * (1.0 + full_sensitivity.Normlinf()));
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
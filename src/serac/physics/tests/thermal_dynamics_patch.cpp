@@ -289,6 +289,180 @@ TEST(HeatTransferDynamic, PatchTest3dQ2FluxBcs)
   EXPECT_LT(error, tol);
 }
 
+// with a lumped capacity, the explicit methods reproduce a temperature that rises at the same rate everywhere
+TEST(HeatTransferDynamic, ExplicitLumpedCapacity)
+{
+  constexpr int p    = 1;
+  constexpr int dim  = 2;
+  double        rate = 3.0;
+
+  for (auto method : {TimestepMethod::ForwardEuler, TimestepMethod::RK2, TimestepMethod::RK3SSP, TimestepMethod::RK4}) {
+    axom::sidre::DataStore datastore;
+    serac::StateManager::initialize(datastore, "thermal_explicit");
+
+    std::string filename = std::string(SERAC_REPO_DIR) + "/data/meshes/patch2D.mesh";
+    std::string mesh_tag{"mesh"};
+    serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+    TimesteppingOptions dyn_opts{.timestepper = method};
+
+    HeatTransfer<p, dim> thermal(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options,
+                                 dyn_opts, "thermal_explicit", mesh_tag);
+    thermal.setMaterial(heat_transfer::LinearIsotropicConductor(1.0, 1.0, 1.0));
+
+    auto exact = [rate](const mfem::Vector&, double t) { return 2.0 + rate * t; };
+    thermal.setTemperature(exact);
+    thermal.setTemperatureBCs(essentialBoundaryAttributes<dim>(PatchBoundaryCondition::Essential), exact);
+    thermal.setSource([rate](auto, auto, auto, auto) { return rate; }, EntireDomain(thermal.mesh()));
+    thermal.completeSetup();
+
+    double dt = thermal.stableTimestep();
+    EXPECT_GT(dt, 0.0);
+    EXPECT_LE(thermal.suggestedTimestep(1.0), dt);
+
+    for (int i = 0; i < 10; i++) {
+      thermal.advanceTimestep(dt);
+    }
+
+    // each step costs residual evaluations only
+    EXPECT_EQ(thermal.nonlinearIterations().back(), 0);
+
+    mfem::FunctionCoefficient exact_coef(exact);
+    exact_coef.SetTime(thermal.time());
+    EXPECT_LT(computeL2Error(thermal.temperature(), exact_coef), tol);
+  }
+}
+
+TEST(HeatTransferDynamic, OutputCadence)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_output_cadence");
+
+  std::string filename = std::string(SERAC_REPO_DIR) + "/data/meshes/patch2D.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+  TimesteppingOptions dyn_opts{.timestepper        = TimestepMethod::BackwardEuler,
+                               .enforcement_method = DirichletEnforcementMethod::DirectControl};
+
+  HeatTransfer<p, dim> thermal(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options, dyn_opts,
+                               "thermal_output_cadence", mesh_tag);
+  thermal.setMaterial(heat_transfer::LinearIsotropicConductor(1.0, 1.0, 1.0));
+  thermal.setTemperature([](const mfem::Vector& x, double) { return x[0]; });
+  thermal.completeSetup();
+
+  // write the temperature only, interpolated to linears, every other cycle
+  thermal.setOutputOptions({.cycle_interval = 2, .fields = {"temperature"}, .visualization_order = 1});
+
+  std::vector<int> written_cycles;
+  for (int i = 0; i < 5; i++) {
+    thermal.advanceTimestep(0.5);
+    if (thermal.writeOutput("thermal_output_cadence_paraview")) {
+      written_cycles.push_back(thermal.cycle());
+    }
+  }
+  EXPECT_EQ(written_cycles, (std::vector<int>{1, 3, 5}));
+
+  // then every unit of simulation time, starting from t = 2.5
+  thermal.setOutputOptions({.time_interval = 1.0});
+
+  written_cycles.clear();
+  for (int i = 0; i < 4; i++) {
+    thermal.advanceTimestep(0.5);
+    if (thermal.writeOutput()) {
+      written_cycles.push_back(thermal.cycle());
+    }
+  }
+  EXPECT_EQ(written_cycles, (std::vector<int>{6, 8}));
+}
+
+TEST(HeatTransferDynamic, CompressedAggregatedSave)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_compressed_save");
+
+  std::string filename = std::string(SERAC_REPO_DIR) + "/data/meshes/patch2D.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename), 1), mesh_tag);
+
+  TimesteppingOptions dyn_opts{.timestepper        = TimestepMethod::BackwardEuler,
+                               .enforcement_method = DirichletEnforcementMethod::DirectControl};
+
+  HeatTransfer<p, dim> thermal(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options, dyn_opts,
+                               "thermal_compressed_save", mesh_tag);
+  thermal.setMaterial(heat_transfer::LinearIsotropicConductor(1.0, 1.0, 1.0));
+  thermal.setTemperature([](const mfem::Vector& x, double) { return x[0] * x[1]; });
+  thermal.completeSetup();
+  thermal.advanceTimestep(0.1);
+
+  // every rank's data goes into a single compressed file
+  StateManager::setSaveOptions({.num_files = 1, .compression_level = 6, .chunk_size = 1024});
+  thermal.outputStateToDisk();
+
+  FiniteElementState loaded(thermal.temperature());
+  loaded = 0.0;
+  StateManager::loadCheckpointedStates(thermal.cycle(), {loaded});
+
+  loaded -= thermal.temperature();
+  EXPECT_EQ(mfem::ParNormlp(loaded, mfem::infinity(), MPI_COMM_WORLD), 0.0);
+
+  StateManager::setSaveOptions({});
+}
+
+TEST(HeatTransferDynamic, InSituPipeline)
+{
+  constexpr int p   = 2;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "thermal_in_situ");
+
+  std::string filename = std::string(SERAC_REPO_DIR) + "/data/meshes/patch2D.mesh";
+  std::string mesh_tag{"mesh"};
+  serac::StateManager::setMesh(mesh::refineAndDistribute(buildMeshFromFile(filename)), mesh_tag);
+
+  TimesteppingOptions dyn_opts{.timestepper        = TimestepMethod::BackwardEuler,
+                               .enforcement_method = DirichletEnforcementMethod::DirectControl};
+
+  HeatTransfer<p, dim> thermal(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options, dyn_opts,
+                               "thermal_in_situ", mesh_tag);
+  thermal.setMaterial(heat_transfer::LinearIsotropicConductor(1.0, 1.0, 1.0));
+  thermal.setTemperature([](const mfem::Vector& x, double) { return x[0]; });
+  thermal.completeSetup();
+
+  // publish every other cycle, without writing anything to disk
+  thermal.setOutputOptions({.cycle_interval = 2, .write_to_disk = false});
+
+  std::vector<int> published_cycles;
+  thermal.setInSituPipeline([&](const conduit::Node& mesh) {
+    published_cycles.push_back(mesh["state/cycle"].to_int());
+    EXPECT_DOUBLE_EQ(mesh["state/time"].to_double(), thermal.time());
+
+    ASSERT_TRUE(mesh.has_path("coordsets"));
+    ASSERT_TRUE(mesh.has_path("topologies"));
+    ASSERT_TRUE(mesh.has_path("fields/temperature/values"));
+
+    const auto&            values      = mesh["fields/temperature/values"];
+    mfem::ParGridFunction& temperature = thermal.temperature().gridFunction();
+    ASSERT_EQ(values.dtype().number_of_elements(), temperature.Size());
+    for (int i = 0; i < temperature.Size(); i++) {
+      EXPECT_DOUBLE_EQ(values.as_double_ptr()[i], temperature(i));
+    }
+  });
+
+  for (int i = 0; i < 5; i++) {
+    thermal.advanceTimestep(0.5);
+    thermal.writeOutput();
+  }
+  EXPECT_EQ(published_cycles, (std::vector<int>{1, 3, 5}));
+}
+
 }  // namespace serac
 
 int main(int argc, char* argv[])
@@ -102,8 +102,10 @@ void functional_test_static_3D(double expected_norm)
   EXPECT_NEAR(temperature_norm_exact, norm(thermal_solid_solver.temperature()), 1.0e-6);
 }
 
+/// @return the true dofs of the displacement and temperature at the end of the step
 template <int p>
-void functional_test_shrinking_3D(double expected_norm)
+std::pair<mfem::Vector, mfem::Vector> functional_test_shrinking_3D(
+    double expected_norm, const CouplingOptions& coupling_options = CouplingOptions{})
 {
   MPI_Barrier(MPI_COMM_WORLD);
 
@@ -156,6 +158,7 @@ void functional_test_shrinking_3D(double expected_norm)
   GreenSaintVenantThermoelasticMaterial::State initial_state{};
   auto                                         qdata = thermal_solid_solver.createQuadratureDataBuffer(initial_state);
   thermal_solid_solver.setMaterial(material, qdata);
+  thermal_solid_solver.setCouplingOptions(coupling_options);
 
   // Define the function for the initial temperature
   double theta_0                   = 1.0;
@@ -183,6 +186,17 @@ void functional_test_shrinking_3D(double expected_norm)
 
   // Check the final displacement norm
   EXPECT_NEAR(expected_norm, norm(thermal_solid_solver.displacement()), 1.0e-4);
+
+  return {mfem::Vector(thermal_solid_solver.displacement()), mfem::Vector(thermal_solid_solver.temperature())};
+}
+
+/// @brief the largest entry of the difference `a - b`, relative to the largest entry of `b`, over all ranks
+double relative_difference(const mfem::Vector& a, const mfem::Vector& b)
+{
+  mfem::Vector difference(a);
+  difference -= b;
+  return mfem::ParNormlp(difference, mfem::infinity(), MPI_COMM_WORLD) /
+         mfem::ParNormlp(b, mfem::infinity(), MPI_COMM_WORLD);
 }
 
 // TODO: investigate this failing test
@@ -339,6 +353,52 @@ TEST(Thermomechanics, thermalContraction)
   serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta);
 }
 
+TEST(Thermomechanics, thermalContractionSubcycled)
+{
+  constexpr int p           = 2;
+  double        alpha       = 1e-3;
+  double        L           = 8;
+  double        delta_theta = 1.0;
+
+  serac::CouplingOptions thermal_subcycling{.thermal_substeps = 3};
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, thermal_subcycling);
+
+  serac::CouplingOptions solid_subcycling{.solid_substeps = 2};
+  serac::functional_test_shrinking_3D<p>(std::sqrt(L * L * L / 3.0) * alpha * delta_theta, solid_subcycling);
+}
+
+TEST(Thermomechanics, thermalContractionMonolithic)
+{
+  constexpr int p             = 2;
+  double        alpha         = 1e-3;
+  double        L             = 8;
+  double        delta_theta   = 1.0;
+  double        expected_norm = std::sqrt(L * L * L / 3.0) * alpha * delta_theta;
+
+  auto [staggered_displacement, staggered_temperature] = serac::functional_test_shrinking_3D<p>(expected_norm);
+
+  // every block preconditioner converges the coupled step to the same solution, which only differs from the
+  // staggered one by the (weak) effect of the deformation on the temperature
+  std::vector<mfem::Vector> monolithic_displacements;
+  for (auto preconditioner : {serac::BlockPreconditioner::BlockDiagonal, serac::BlockPreconditioner::BlockGaussSeidel,
+                              serac::BlockPreconditioner::SchurComplement}) {
+    serac::CouplingOptions monolithic{.scheme               = serac::CouplingScheme::Monolithic,
+                                      .block_preconditioner = preconditioner,
+                                      .relative_tol         = 1.0e-10,
+                                      .absolute_tol         = 1.0e-14};
+    auto [displacement, temperature] = serac::functional_test_shrinking_3D<p>(expected_norm, monolithic);
+
+    EXPECT_LT(serac::relative_difference(displacement, staggered_displacement), 1.0e-4);
+    EXPECT_LT(serac::relative_difference(temperature, staggered_temperature), 1.0e-4);
+
+    monolithic_displacements.push_back(displacement);
+  }
+
+  for (std::size_t i = 1; i < monolithic_displacements.size(); i++) {
+    EXPECT_LT(serac::relative_difference(monolithic_displacements[i], monolithic_displacements[0]), 1.0e-8);
+  }
+}
+
 TEST(Thermomechanics, parameterized)
 {
   // this is the small strain solution, which works with a loose enought tolerance
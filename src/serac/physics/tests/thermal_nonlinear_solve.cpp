@@ -6,9 +6,11 @@
 
 #include "serac/physics/heat_transfer.hpp"
 
+#include <cstdio>
 #include <functional>
 #include <fstream>
 #include <set>
+#include <vector>
 #include <string>
 
 #include "axom/slic/core/SimpleLogger.hpp"
@@ -97,6 +99,435 @@ void functional_thermal_test_nonlinear()
 
 TEST(HeatTransfer, robin_condition) { functional_thermal_test_nonlinear(); }
 
+/// Solve a quasi-static problem whose solution grows linearly in time, returning the Newton iterations of each step
+std::vector<int> load_ramp_test(const TimesteppingOptions& timestepping_options, int num_steps,
+                                mfem::Vector& final_temperature)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "heat_transfer_predictor");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/square.mesh";
+
+  std::string mesh_tag{"mesh"};
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(filename), 2, 0);
+  serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 1.0e-10,
+                                                  .absolute_tol   = 1.0e-10,
+                                                  .max_iterations = 10,
+                                                  .print_level    = 0};
+
+  HeatTransfer<p, dim> thermal_solver(nonlinear_options, heat_transfer::direct_linear_options, timestepping_options,
+                                      "heat_transfer", mesh_tag);
+
+  thermal_solver.setMaterial(heat_transfer::LinearIsotropicConductor{1.0, 1.0, 1.0});
+  thermal_solver.setTemperatureBCs({1}, [](const mfem::Vector&, double t) { return 3.0 * t; });
+  thermal_solver.setSource([](auto, auto t, auto, auto) { return 2.0 * t; });
+  thermal_solver.completeSetup();
+
+  for (int i = 0; i < num_steps; i++) {
+    thermal_solver.advanceTimestep(1.0 / num_steps);
+  }
+
+  final_temperature = thermal_solver.temperature();
+  return thermal_solver.nonlinearIterations();
+}
+
+TEST(HeatTransfer, Predictors)
+{
+  mfem::Vector previous_state, extrapolated, linearized, previous_jacobian;
+
+  auto options = [](Predictor predictor) {
+    return TimesteppingOptions{.timestepper = TimestepMethod::QuasiStatic, .predictor = predictor};
+  };
+
+  auto previous_state_iterations = load_ramp_test(options(Predictor::PreviousState), 4, previous_state);
+  auto extrapolated_iterations   = load_ramp_test(options(Predictor::Extrapolation), 4, extrapolated);
+  load_ramp_test(options(Predictor::LinearizedBoundaryConditions), 4, linearized);
+  load_ramp_test(options(Predictor::PreviousJacobian), 4, previous_jacobian);
+
+  ASSERT_EQ(previous_state_iterations.size(), size_t(4));
+  ASSERT_EQ(extrapolated_iterations.size(), size_t(4));
+
+  // the solution is linear in time, so extrapolating it from the two previous steps needs no Newton iterations
+  for (size_t i = 1; i < 4; i++) {
+    EXPECT_EQ(extrapolated_iterations[i], 0);
+    EXPECT_GT(previous_state_iterations[i], 0);
+  }
+
+  // the initial guess does not change the solution
+  for (auto* temperature : {&extrapolated, &linearized, &previous_jacobian}) {
+    mfem::Vector difference(*temperature);
+    difference -= previous_state;
+    EXPECT_LT(difference.Normlinf(), 1.0e-8);
+  }
+}
+
+TEST(HeatTransfer, LoadIncrementContinuation)
+{
+  mfem::Vector single_step, continuation;
+
+  load_ramp_test(heat_transfer::default_static_options, 1, single_step);
+
+  // a single request covering the whole ramp is split into load increments no larger than max_dt
+  auto iterations = load_ramp_test(
+      {.timestepper = TimestepMethod::QuasiStatic, .max_dt = 0.25, .target_nonlinear_iterations = 4}, 1, continuation);
+
+  EXPECT_EQ(iterations.size(), size_t(4));
+
+  mfem::Vector difference(continuation);
+  difference -= single_step;
+  EXPECT_LT(difference.Normlinf(), 1.0e-8);
+}
+
+TEST(HeatTransfer, NewtonFailureCutback)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "heat_transfer_cutback");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/square.mesh";
+
+  std::string mesh_tag{"mesh"};
+
+  auto  mesh  = mesh::refineAndDistribute(buildMeshFromFile(filename), 1, 0);
+  auto& pmesh = serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  // a single Newton iteration only meets this tolerance for small enough steps, see below
+  serac::NonlinearSolverOptions nonlinear_options{.nonlin_solver  = NonlinearSolver::Newton,
+                                                  .relative_tol   = 0.3,
+                                                  .absolute_tol   = 1.0e-14,
+                                                  .max_iterations = 1,
+                                                  .print_level    = 0};
+
+  HeatTransfer<p, dim> thermal_solver(nonlinear_options, heat_transfer::direct_linear_options,
+                                      {.timestepper = TimestepMethod::QuasiStatic, .max_cutbacks = 4}, "heat_transfer",
+                                      mesh_tag);
+
+  // without boundary conditions, a uniform temperature stays uniform, and its residual is (u + u^3 - t) times the
+  // integral of each basis function, so each step is Newton's method on the scalar equation u + u^3 = t:
+  //
+  //   t: 0 -> 1, from u = 0: one iteration gives u = 1, with |u + u^3 - t| / |0 - t| = 1 > 0.3, so the step is cut
+  //   t: 0 -> 1/2, from u = 0: one iteration gives u = 1/2, with a reduction of 0.125 / 0.5 = 0.25
+  //   t: 1/2 -> 1, from u = 1/2: one iteration gives u = 5/7, with a reduction of (5/7 + 125/343 - 1) / 0.375 < 0.3
+  thermal_solver.setMaterial(heat_transfer::LinearIsotropicConductor{1.0, 1.0, 1.0});
+  thermal_solver.setSource([](auto, auto t, auto u, auto) { return t - u - u * u * u; });
+  thermal_solver.setTemperature([](const mfem::Vector&, double) { return 0.0; });
+  thermal_solver.completeSetup();
+
+  thermal_solver.advanceTimestep(1.0);
+
+  // the step was cut in half once, and both halves are committed as their own cycles
+  EXPECT_DOUBLE_EQ(thermal_solver.time(), 1.0);
+  EXPECT_EQ(thermal_solver.cycle(), 2);
+  ASSERT_EQ(thermal_solver.solverTelemetry().size(), size_t(2));
+
+  // the first half restarts from the temperature at t = 0 rather than the failed iterate, so its initial residual
+  // is (0 + 0 - 1/2) times the integral of each basis function
+  mfem::H1_FECollection       fec(p, dim);
+  mfem::ParFiniteElementSpace space(&pmesh, &fec);
+  mfem::ParLinearForm         basis_integrals(&space);
+  mfem::ConstantCoefficient   one(1.0);
+  basis_integrals.AddDomainIntegrator(new mfem::DomainLFIntegrator(one));
+  basis_integrals.Assemble();
+  std::unique_ptr<mfem::HypreParVector> b(basis_integrals.ParallelAssemble());
+  double b_norm = mfem::ParNormlp(*b, 2.0, MPI_COMM_WORLD);
+
+  EXPECT_NEAR(thermal_solver.solverTelemetry()[0].residual_norms[0], 0.5 * b_norm, 1.0e-10 * b_norm);
+  for (const auto& telemetry : thermal_solver.solverTelemetry()) {
+    EXPECT_TRUE(telemetry.converged);
+  }
+
+  mfem::Vector error(thermal_solver.temperature());
+  error -= 5.0 / 7.0;
+  EXPECT_LT(mfem::ParNormlp(error, mfem::infinity(), MPI_COMM_WORLD), 1.0e-10);
+}
+
+/// A heat transfer module whose substeps can be driven with scripted solves, to observe the parameters in between
+class ScriptedHeatTransfer : public HeatTransfer<1, 2, Parameters<H1<1>>> {
+public:
+  using HeatTransfer<1, 2, Parameters<H1<1>>>::HeatTransfer;
+  using BasePhysics::advanceWithCutbacks;
+
+  /// the previous values of the parameter, which the warm start of a quasi-static substep overwrites
+  FiniteElementState& previousParameter() { return *parameters_[0].previous_state; }
+};
+
+TEST(HeatTransfer, CutbacksRestoreParameters)
+{
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "heat_transfer_cutback_parameters");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/square.mesh";
+
+  std::string mesh_tag{"mesh"};
+
+  auto  mesh  = mesh::refineAndDistribute(buildMeshFromFile(filename), 1, 0);
+  auto& pmesh = serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  ScriptedHeatTransfer thermal_solver(heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
+                                      heat_transfer::default_static_options, "heat_transfer", mesh_tag, {"parameter"});
+
+  FiniteElementState parameter(pmesh, H1<1>{}, "parameter");
+  parameter = 0.0;
+  thermal_solver.setParameter(0, parameter);
+  thermal_solver.previousParameter() = 0.0;
+
+  // substeps longer than 1/4 fail, so the step of 1 becomes four substeps of 1/4, after four cutbacks:
+  // 1 (fails), 1/2 (fails), 1/4, 1/2 (fails), 1/4, 1/2 (fails), 1/4, 1/4
+  std::vector<double> attempts;
+  std::vector<double> committed;
+  double              committed_parameter = 0.0;
+  int                 aborts              = 0;
+
+  auto solve = [&](double h) {
+    // every attempt starts from the previous parameter values of the last committed substep
+    EXPECT_DOUBLE_EQ(thermal_solver.previousParameter().Max(), committed_parameter);
+    EXPECT_DOUBLE_EQ(thermal_solver.previousParameter().Min(), committed_parameter);
+
+    thermal_solver.previousParameter() = committed_parameter + 1.0;
+    attempts.push_back(h);
+    return h <= 0.25;
+  };
+  auto abort  = [&]() { aborts++; };
+  auto commit = [&]() {
+    committed.push_back(attempts.back());
+    committed_parameter += 1.0;
+  };
+
+  thermal_solver.advanceWithCutbacks(1.0, 4, solve, abort, commit);
+
+  EXPECT_EQ(aborts, 4);
+  EXPECT_EQ(attempts, (std::vector<double>{1.0, 0.5, 0.25, 0.5, 0.25, 0.5, 0.25, 0.25}));
+  EXPECT_EQ(committed, (std::vector<double>{0.25, 0.25, 0.25, 0.25}));
+  EXPECT_DOUBLE_EQ(thermal_solver.previousParameter().Max(), 4.0);
+}
+
+TEST(HeatTransfer, SolverTelemetry)
+{
+  constexpr int p         = 1;
+  constexpr int dim       = 2;
+  constexpr int num_steps = 3;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "heat_transfer_telemetry");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/square.mesh";
+
+  std::string mesh_tag{"mesh"};
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(filename), 2, 0);
+  serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  HeatTransfer<p, dim> thermal_solver(heat_transfer::default_nonlinear_options, heat_transfer::default_linear_options,
+                                      heat_transfer::default_static_options, "heat_transfer", mesh_tag);
+
+  thermal_solver.setMaterial(heat_transfer::LinearIsotropicConductor{1.0, 1.0, 1.0});
+  thermal_solver.setTemperatureBCs({1}, [](const mfem::Vector&, double t) { return 3.0 * t; });
+  thermal_solver.setSource([](auto, auto t, auto, auto) { return 2.0 * t; });
+  thermal_solver.completeSetup();
+
+  const std::string telemetry_file = "heat_transfer_telemetry.jsonl";
+  std::remove(telemetry_file.c_str());
+  thermal_solver.setOutputOptions({.solver_telemetry_file = telemetry_file});
+
+  axom::sidre::DataStore summary;
+  thermal_solver.initializeSummary(summary, 1.0, 1.0 / num_steps);
+  for (int i = 0; i < num_steps; i++) {
+    thermal_solver.advanceTimestep(1.0 / num_steps);
+    thermal_solver.saveSummary(summary, thermal_solver.time());
+  }
+
+  const auto& telemetry = thermal_solver.solverTelemetry();
+  ASSERT_EQ(telemetry.size(), size_t(num_steps));
+  for (size_t i = 0; i < telemetry.size(); i++) {
+    EXPECT_EQ(telemetry[i].nonlinear_iterations, thermal_solver.nonlinearIterations()[i]);
+    EXPECT_TRUE(telemetry[i].converged);
+    EXPECT_EQ(telemetry[i].residual_norms.size(), size_t(telemetry[i].nonlinear_iterations + 1));
+    EXPECT_EQ(telemetry[i].linear_solves, telemetry[i].nonlinear_iterations);
+    EXPECT_GE(telemetry[i].jacobian_assemblies, 1);
+    EXPECT_GT(telemetry[i].linear_iterations, 0);
+    EXPECT_GE(telemetry[i].solve_time,
+              telemetry[i].assembly_time + telemetry[i].preconditioner_time + telemetry[i].linear_solve_time);
+  }
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    axom::sidre::Group* solver_group = summary.getRoot()->getGroup("serac_summary/curves/solver");
+    ASSERT_NE(solver_group, nullptr);
+    axom::sidre::Array<int> iterations(solver_group->getView("nonlinear_iterations"));
+    EXPECT_EQ(iterations.size(), num_steps);
+
+    // the telemetry file has one line per timestep
+    std::ifstream file(telemetry_file);
+    std::string   line;
+    int           lines = 0;
+    while (std::getline(file, line)) {
+      EXPECT_NE(line.find("\"linear_iterations\""), std::string::npos);
+      lines++;
+    }
+    EXPECT_EQ(lines, num_steps);
+  }
+}
+
+/// Take steps of a linear problem, returning the telemetry of each step
+std::vector<SolverTelemetry> linear_problem_test(const NonlinearSolverOptions& nonlinear_options,
+                                                 const TimesteppingOptions& timestepping_options,
+                                                 mfem::Vector&              final_temperature)
+{
+  constexpr int p         = 1;
+  constexpr int dim       = 2;
+  constexpr int num_steps = 4;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "heat_transfer_jacobian_reuse");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/square.mesh";
+
+  std::string mesh_tag{"mesh"};
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(filename), 2, 0);
+  serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  HeatTransfer<p, dim> thermal_solver(nonlinear_options, heat_transfer::direct_linear_options, timestepping_options,
+                                      "heat_transfer", mesh_tag);
+
+  thermal_solver.setMaterial(heat_transfer::LinearIsotropicConductor{1.0, 1.0, 1.0});
+  thermal_solver.setTemperatureBCs({1}, [](const mfem::Vector&, double t) { return 3.0 * t; });
+  thermal_solver.setSource([](auto, auto t, auto, auto) { return 2.0 * t; });
+  thermal_solver.completeSetup();
+
+  for (int i = 0; i < num_steps; i++) {
+    thermal_solver.advanceTimestep(0.25);
+  }
+
+  final_temperature = thermal_solver.temperature();
+  return thermal_solver.solverTelemetry();
+}
+
+TEST(HeatTransfer, LinearJacobianReuse)
+{
+  mfem::Vector assembled, reused;
+
+  auto options = [](bool reuse_linear_jacobian) {
+    return TimesteppingOptions{.timestepper           = TimestepMethod::BackwardEuler,
+                               .enforcement_method    = DirichletEnforcementMethod::RateControl,
+                               .reuse_linear_jacobian = reuse_linear_jacobian};
+  };
+
+  auto assembled_telemetry = linear_problem_test(heat_transfer::default_nonlinear_options, options(false), assembled);
+  auto reused_telemetry    = linear_problem_test(heat_transfer::default_nonlinear_options, options(true), reused);
+
+  ASSERT_EQ(reused_telemetry.size(), assembled_telemetry.size());
+
+  // with a constant step size, only the first step assembles M + dt K and sets up its preconditioner
+  for (size_t i = 0; i < reused_telemetry.size(); i++) {
+    EXPECT_GE(assembled_telemetry[i].jacobian_assemblies, 1);
+    EXPECT_EQ(reused_telemetry[i].jacobian_assemblies, i == 0 ? 1 : 0);
+    EXPECT_EQ(reused_telemetry[i].preconditioner_setups, i == 0 ? 1 : 0);
+    EXPECT_TRUE(reused_telemetry[i].converged);
+  }
+
+  mfem::Vector difference(reused);
+  difference -= assembled;
+  EXPECT_LT(difference.Normlinf(), 1.0e-8);
+}
+
+TEST(HeatTransfer, DeclaredLinear)
+{
+  mfem::Vector newton, linear;
+
+  auto linear_options   = heat_transfer::default_nonlinear_options;
+  linear_options.linear = true;
+
+  for (auto timestepper : {TimestepMethod::QuasiStatic, TimestepMethod::BackwardEuler}) {
+    TimesteppingOptions timestepping_options{.timestepper = timestepper};
+
+    auto newton_telemetry = linear_problem_test(heat_transfer::default_nonlinear_options, timestepping_options, newton);
+    auto linear_telemetry = linear_problem_test(linear_options, timestepping_options, linear);
+
+    // each step is a single linear solve, with the Jacobian assembled and factored only once for the whole run
+    ASSERT_EQ(linear_telemetry.size(), newton_telemetry.size());
+    for (size_t i = 0; i < linear_telemetry.size(); i++) {
+      EXPECT_EQ(linear_telemetry[i].nonlinear_iterations, 1);
+      EXPECT_EQ(linear_telemetry[i].linear_solves, 1);
+      EXPECT_EQ(linear_telemetry[i].jacobian_assemblies, i == 0 ? 1 : 0);
+      EXPECT_TRUE(linear_telemetry[i].converged);
+    }
+
+    mfem::Vector difference(linear);
+    difference -= newton;
+    EXPECT_LT(difference.Normlinf(), 1.0e-8);
+  }
+}
+
+TEST(HeatTransfer, MemoryUsage)
+{
+  constexpr int p   = 1;
+  constexpr int dim = 2;
+
+  axom::sidre::DataStore datastore;
+  serac::StateManager::initialize(datastore, "heat_transfer_memory");
+
+  std::string filename = SERAC_REPO_DIR "/data/meshes/square.mesh";
+
+  std::string mesh_tag{"mesh"};
+
+  auto mesh = mesh::refineAndDistribute(buildMeshFromFile(filename), 2, 0);
+  serac::StateManager::setMesh(std::move(mesh), mesh_tag);
+
+  HeatTransfer<p, dim> thermal_solver(heat_transfer::default_nonlinear_options, heat_transfer::direct_linear_options,
+                                      heat_transfer::default_static_options, "heat_transfer", mesh_tag);
+
+  thermal_solver.setMaterial(heat_transfer::LinearIsotropicConductor{1.0, 1.0, 1.0});
+  thermal_solver.setTemperatureBCs({1}, [](const mfem::Vector&, double) { return 1.0; });
+  thermal_solver.completeSetup();
+
+  // nothing is differentiated or assembled before the first step
+  auto run_plan = thermal_solver.plan(1);
+  EXPECT_EQ(thermal_solver.memoryUsage()["residual/gradient_lookup_tables"], size_t(0));
+
+  axom::sidre::DataStore summary;
+  thermal_solver.initializeSummary(summary, 1.0, 0.5);
+  thermal_solver.advanceTimestep(0.5);
+  thermal_solver.saveSummary(summary, thermal_solver.time());
+
+  auto usage = thermal_solver.memoryUsage();
+  EXPECT_GT(usage["states"], size_t(0));
+  EXPECT_GT(usage["residual/geometric_factors"], size_t(0));
+  EXPECT_GT(usage["matrices"], size_t(0));
+
+  // the sparsity pattern is planned exactly, but its vectors may have grown with some spare capacity
+  EXPECT_EQ(run_plan.bytes["residual/qfunction_derivatives"], usage["residual/qfunction_derivatives"]);
+  EXPECT_LE(run_plan.bytes["residual/gradient_lookup_tables"], usage["residual/gradient_lookup_tables"]);
+  EXPECT_GT(run_plan.bytes["residual/gradient_lookup_tables"], usage["residual/gradient_lookup_tables"] * 9 / 10);
+  EXPECT_GE(run_plan.bytes["checkpoints"], usage["checkpoints"]);
+  EXPECT_GT(run_plan.seconds["forward_solve"], 0.0);
+
+  auto statistics = thermal_solver.memoryStatistics();
+  ASSERT_EQ(statistics.count("total"), size_t(1));
+  EXPECT_GE(statistics["total"].max, statistics["total"].avg);
+  EXPECT_GE(statistics["total"].avg, statistics["total"].min);
+  EXPECT_GT(statistics["total"].min, 0.0);
+
+  int rank;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (rank == 0) {
+    axom::sidre::Group* total_group = summary.getRoot()->getGroup("serac_summary/curves/memory/total");
+    ASSERT_NE(total_group, nullptr);
+    axom::sidre::Array<double> max(total_group->getView("max"));
+    EXPECT_EQ(max.size(), 1);
+  }
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
@@ -12,8 +12,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "mfem.hpp"
 
+#include "serac/numerics/fixed_point_acceleration.hpp"
 #include "serac/physics/base_physics.hpp"
 #include "serac/physics/thermomechanics_input.hpp"
 #include "serac/physics/solid_mechanics.hpp"
@@ -85,6 +89,8 @@ public:
   {
     SLIC_ERROR_ROOT_IF(mesh_.Dimension() != dim,
                        axom::fmt::format("Compile time dimension and runtime mesh dimension mismatch"));
+    SLIC_ERROR_ROOT_IF(thermal_timestepping.adaptive || solid_timestepping.adaptive,
+                       "Adaptive time stepping is not supported by the coupled thermomechanics solver");
 
     states_.push_back(&thermal_.temperature());
     states_.push_back(&solid_.velocity());
@@ -240,16 +246,57 @@ public:
    */
   void advanceTimestep(double dt) override
   {
-    thermal_.setParameter(0, solid_.displacement());
-    thermal_.advanceTimestep(dt);
+    if (coupling_options_.thermal_substeps > 1 || coupling_options_.solid_substeps > 1) {
+      multirateSolve(dt);
+
+      cycle_ += 1;
+      time_ += dt;
+      return;
+    }
+
+    FiniteElementState exchanged_displacement(solid_.displacement());
+
+    thermal_.setParameter(0, exchanged_displacement);
+    thermal_.solveTimestep(dt);
+
+    solid_.bindParameter(0, thermal_.temperature());
+    solid_.solveTimestep(dt);
+
+    if (coupling_options_.scheme == CouplingScheme::Monolithic) {
+      monolithicSolve();
+    } else if (coupling_options_.scheme == CouplingScheme::FixedPoint) {
+      fixedPointSolve(dt, exchanged_displacement);
+    }
 
-    solid_.setParameter(0, thermal_.temperature());
-    solid_.advanceTimestep(dt);
+    thermal_.commitTimestep();
+    solid_.commitTimestep();
 
     cycle_ += 1;
     time_ += dt;
   }
 
+  /**
+   * @brief Set how the thermal and solid mechanics solves are coupled within each timestep
+   *
+   * @param options The coupling options
+   *
+   * @note The monolithic scheme currently requires quasi-static thermal and solid mechanics modules with assembled
+   * Jacobians. The fixed-point scheme supports transient thermal solves, which are restarted from the beginning
+   * of the step on every iteration. Multi-rate solves (with more than one thermal or solid mechanics substep per
+   * timestep) require the staggered scheme, and only one of the two modules may be subcycled.
+   */
+  void setCouplingOptions(const CouplingOptions& options)
+  {
+    SLIC_ERROR_ROOT_IF(options.thermal_substeps < 1 || options.solid_substeps < 1,
+                       "The number of thermal and solid mechanics substeps must be positive");
+    SLIC_ERROR_ROOT_IF(options.thermal_substeps > 1 && options.solid_substeps > 1,
+                       "Only one of the thermal and solid mechanics modules can be subcycled");
+    SLIC_ERROR_ROOT_IF(
+        (options.thermal_substeps > 1 || options.solid_substeps > 1) && options.scheme != CouplingScheme::Staggered,
+        "Multi-rate thermomechanics solves require the staggered coupling scheme");
+    coupling_options_ = options;
+  }
+
   /**
    * @brief Create a shared ptr to a quadrature data buffer for the given material type
    *
@@ -446,6 +493,19 @@ public:
     thermal_.setFluxBCs(flux_function);
   }
 
+  /**
+   * @brief Set the thermal flux boundary condition that the implicit-explicit thermal timestep methods treat
+   * explicitly, see HeatTransfer::setExplicitFluxBCs()
+   *
+   * @tparam FluxType The type of the thermal flux object
+   * @param flux_function A function describing the flux applied to a boundary, see setHeatFluxBCs()
+   */
+  template <typename FluxType>
+  void setExplicitHeatFluxBCs(FluxType flux_function)
+  {
+    thermal_.setExplicitFluxBCs(flux_function);
+  }
+
   /**
    * @brief Set the underlying finite element state to a prescribed displacement
    *
@@ -512,6 +572,19 @@ public:
     thermal_.setSource(source_function);
   }
 
+  /**
+   * @brief Add a thermal source that the implicit-explicit thermal timestep methods treat explicitly, see
+   * HeatTransfer::setExplicitSource()
+   *
+   * @tparam HeatSourceType The type of the source function
+   * @param source_function A source function for a prescribed thermal load, see addHeatSource()
+   */
+  template <typename HeatSourceType>
+  void addExplicitHeatSource(HeatSourceType source_function)
+  {
+    thermal_.setExplicitSource(source_function);
+  }
+
   /**
    * @brief Get the displacement state
    *
@@ -535,6 +608,235 @@ protected:
 
   /// Submodule to compute the mechanics
   SolidMechanics<order, dim, Parameters<temperature_field, parameter_space...>> solid_;
+
+  /// How the thermal and solid mechanics solves are coupled within each timestep
+  CouplingOptions coupling_options_;
+
+  /**
+   * @brief Advance the timestep with one step of the slower module followed by several substeps of the faster one
+   *
+   * The module with one step per timestep is solved first, with the field of the other module at the beginning of the
+   * step. Each substep of the subcycled module is then given the field of the other module linearly interpolated
+   * between the beginning and the end of the step, at the end of the substep.
+   *
+   * @param dt The increment of simulation time of the current step
+   */
+  void multirateSolve(double dt)
+  {
+    auto substep = [dt](auto& fast, const FiniteElementState& start, const FiniteElementState& end, int substeps) {
+      FiniteElementState interpolated(start);
+      for (int k = 1; k <= substeps; k++) {
+        const double s = double(k) / substeps;
+        add(1.0 - s, start, s, end, interpolated);
+
+        fast.setParameter(0, interpolated);
+        fast.solveTimestep(dt / substeps);
+        fast.commitTimestep();
+      }
+    };
+
+    if (coupling_options_.thermal_substeps > 1) {
+      FiniteElementState start_displacement(solid_.displacement());
+
+      solid_.bindParameter(0, thermal_.temperature());
+      solid_.solveTimestep(dt);
+      solid_.commitTimestep();
+
+      substep(thermal_, start_displacement, solid_.displacement(), coupling_options_.thermal_substeps);
+    } else {
+      FiniteElementState start_temperature(thermal_.temperature());
+
+      thermal_.bindParameter(0, solid_.displacement());
+      thermal_.solveTimestep(dt);
+      thermal_.commitTimestep();
+
+      substep(solid_, start_temperature, thermal_.temperature(), coupling_options_.solid_substeps);
+    }
+  }
+
+  /**
+   * @brief Converge the current timestep by repeating the staggered solves
+   *
+   * Each iteration re-solves the thermal step with the displacement field given to it, and then the solid mechanics
+   * step with the resulting temperature. The displacement given to the next thermal solve is computed from the
+   * previous ones with the acceleration method in the coupling options, until it agrees with the solid mechanics
+   * displacement.
+   *
+   * @param dt The increment of simulation time of the current step
+   * @param exchanged_displacement The displacement given to the thermal solve of the staggered pass
+   */
+  void fixedPointSolve(double dt, FiniteElementState& exchanged_displacement)
+  {
+    const auto& opts = coupling_options_;
+    MPI_Comm    comm = mesh_.GetComm();
+
+    FixedPointAccelerator accelerator(opts.acceleration, opts.relaxation, opts.anderson_depth, comm);
+
+    mfem::Vector change(exchanged_displacement.Size());
+    bool         converged = false;
+
+    for (int iteration = 1; iteration <= opts.max_iterations; ++iteration) {
+      const auto& displacement = solid_.displacement();
+
+      subtract(displacement, exchanged_displacement, change);
+      const double change_norm = mfem::ParNormlp(change, 2, comm);
+      const double norm        = mfem::ParNormlp(displacement, 2, comm);
+
+      if (opts.print_level > 0) {
+        SLIC_INFO_ROOT(axom::fmt::format("Fixed-point thermomechanics iteration {}: ||du|| = {:e}, ||u|| = {:e}",
+                                         iteration, change_norm, norm));
+      }
+
+      if (change_norm <= std::max(opts.relative_tol * norm, opts.absolute_tol)) {
+        converged = true;
+        break;
+      }
+
+      if (iteration == opts.max_iterations) {
+        break;
+      }
+
+      accelerator.update(exchanged_displacement, displacement);
+
+      thermal_.setParameter(0, exchanged_displacement);
+      thermal_.solveTimestep(dt);
+
+      solid_.bindParameter(0, thermal_.temperature());
+      solid_.solveTimestep(dt);
+    }
+
+    SLIC_WARNING_ROOT_IF(!converged,
+                         axom::fmt::format("Fixed-point thermomechanics solve did not converge in {} iterations",
+                                           opts.max_iterations));
+  }
+
+  /**
+   * @brief Converge the current timestep with Newton's method on the coupled thermal-solid system
+   *
+   * The staggered solves of the timestep are used as the initial guess. Each iteration solves the block system
+   * | dR_T/dT  dR_T/du | | dT |   | R_T |
+   * | dR_u/dT  dR_u/du | | du | = | R_u |
+   * with flexible GMRES, where the off-diagonal blocks are the derivatives of each residual with respect to the
+   * parameter field that the other module provides. The diagonal blocks of the block preconditioner are inverted
+   * with the linear solvers of the thermal and solid mechanics modules.
+   */
+  void monolithicSolve()
+  {
+    SLIC_ERROR_ROOT_IF(!thermal_.isQuasistatic() || !solid_.isQuasistatic(),
+                       "The monolithic coupling scheme requires quasi-static thermal and solid mechanics solves");
+
+    const auto& opts = coupling_options_;
+    MPI_Comm    comm = mesh_.GetComm();
+
+    mfem::Array<int> offsets(3);
+    offsets[0] = 0;
+    offsets[1] = thermal_.temperature().Size();
+    offsets[2] = offsets[1] + solid_.displacement().Size();
+
+    mfem::BlockVector residual(offsets);
+    mfem::BlockVector correction(offsets);
+
+    auto& thermal_linear_solver = thermal_.equationSolver().linearSolver();
+    auto& solid_linear_solver   = solid_.equationSolver().linearSolver();
+
+    double initial_norm = 0.0;
+    bool   converged    = false;
+
+    // the parameters of each module are views of the state of the other one, so they follow its corrections
+    thermal_.bindParameter(0, solid_.displacement());
+    solid_.bindParameter(0, thermal_.temperature());
+
+    for (int iteration = 0; iteration <= opts.max_iterations; ++iteration) {
+      thermal_.residualOperator().Mult(thermal_.temperature(), residual.GetBlock(0));
+      solid_.residualOperator().Mult(solid_.displacement(), residual.GetBlock(1));
+
+      const double norm = std::sqrt(mfem::InnerProduct(comm, residual, residual));
+      if (iteration == 0) {
+        initial_norm = norm;
+      }
+
+      if (opts.print_level > 0) {
+        SLIC_INFO_ROOT(axom::fmt::format("Monolithic thermomechanics iteration {}: ||r|| = {:e}", iteration, norm));
+      }
+
+      if (norm <= std::max(opts.relative_tol * initial_norm, opts.absolute_tol)) {
+        converged = true;
+        break;
+      }
+
+      if (iteration == opts.max_iterations) {
+        break;
+      }
+
+      auto* J_TT = dynamic_cast<mfem::HypreParMatrix*>(
+          &thermal_.residualOperator().GetGradient(thermal_.temperature()));
+      auto* J_uu =
+          dynamic_cast<mfem::HypreParMatrix*>(&solid_.residualOperator().GetGradient(solid_.displacement()));
+      SLIC_ERROR_ROOT_IF(!J_TT || !J_uu, "The monolithic coupling scheme requires assembled Jacobians");
+
+      auto J_Tu = thermal_.parameterJacobian(0);
+      auto J_uT = solid_.parameterJacobian(0);
+
+      mfem::BlockOperator J(offsets);
+      J.SetBlock(0, 0, J_TT);
+      J.SetBlock(0, 1, J_Tu.get());
+      J.SetBlock(1, 0, J_uT.get());
+      J.SetBlock(1, 1, J_uu);
+
+      thermal_linear_solver.SetOperator(*J_TT);
+
+      std::unique_ptr<mfem::HypreParMatrix> schur_complement;
+      std::unique_ptr<mfem::Solver>         preconditioner;
+
+      if (opts.block_preconditioner == BlockPreconditioner::BlockDiagonal) {
+        solid_linear_solver.SetOperator(*J_uu);
+
+        auto block_diagonal = std::make_unique<mfem::BlockDiagonalPreconditioner>(offsets);
+        block_diagonal->SetDiagonalBlock(0, &thermal_linear_solver);
+        block_diagonal->SetDiagonalBlock(1, &solid_linear_solver);
+        preconditioner = std::move(block_diagonal);
+      } else {
+        if (opts.block_preconditioner == BlockPreconditioner::SchurComplement) {
+          // S = J_uu - J_uT diag(J_TT)^{-1} J_Tu
+          mfem::Vector diagonal;
+          J_TT->GetDiag(diagonal);
+
+          mfem::HypreParMatrix scaled_J_Tu(*J_Tu);
+          scaled_J_Tu.InvScaleRows(diagonal);
+
+          std::unique_ptr<mfem::HypreParMatrix> coupling(mfem::ParMult(J_uT.get(), &scaled_J_Tu, true));
+          schur_complement.reset(mfem::Add(1.0, *J_uu, -1.0, *coupling));
+          solid_linear_solver.SetOperator(*schur_complement);
+        } else {
+          solid_linear_solver.SetOperator(*J_uu);
+        }
+
+        auto block_lower = std::make_unique<mfem::BlockLowerTriangularPreconditioner>(offsets);
+        block_lower->SetDiagonalBlock(0, &thermal_linear_solver);
+        block_lower->SetDiagonalBlock(1, &solid_linear_solver);
+        block_lower->SetBlock(1, 0, J_uT.get());
+        preconditioner = std::move(block_lower);
+      }
+
+      mfem::FGMRESSolver linear_solver(comm);
+      linear_solver.SetRelTol(opts.linear_relative_tol);
+      linear_solver.SetAbsTol(0.0);
+      linear_solver.SetMaxIter(opts.linear_max_iterations);
+      linear_solver.SetPrintLevel(opts.print_level - 1);
+      linear_solver.SetOperator(J);
+      linear_solver.SetPreconditioner(*preconditioner);
+
+      correction = 0.0;
+      linear_solver.Mult(residual, correction);
+
+      thermal_.correctTemperature(correction.GetBlock(0));
+      solid_.correctDisplacement(correction.GetBlock(1));
+    }
+
+    SLIC_WARNING_ROOT_IF(!converged,
+                         axom::fmt::format("Monolithic thermomechanics solve did not converge in {} iterations",
+                                           opts.max_iterations));
+  }
 };
 
 }  // namespace serac